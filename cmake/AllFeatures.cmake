@@ -23,6 +23,7 @@ set(
 		ATTESTATION_SUPPORT_RSA_UNSEAL
 		ATTESTATION_SUPPORT_SPDM
 		CMD_ENABLE_DEBUG_LOG
+		CMD_ENABLE_DEBUG_LOG_FILTER
 		CMD_ENABLE_HEAP_STATS
 		CMD_ENABLE_INTRUSION
 		CMD_ENABLE_ISSUE_REQUEST
@@ -37,6 +38,7 @@ set(
 		HASH_ENABLE_SHA384
 		HASH_ENABLE_SHA512
 		LOGGING_SUPPORT_DEBUG_LOG
+		LOGGING_SUPPORT_DEBUG_LOG_FILTER
 		RSA_ENABLE_DER_PUBLIC_KEY
 		RSA_ENABLE_PRIVATE_KEY
 		X509_ENABLE_AUTHENTICATION
@@ -0,0 +1,799 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "x509_cache.h"
+#include "x509_cache_static.h"
+#include "asn1/asn1_util.h"
+#include "common/type_cast.h"
+#include "common/unused.h"
+
+
+/**
+ * Types of identifiers generated for the cache.  Each identifier is the SHA-256 digest of the type
+ * followed by the data being identified, so identical data used in different roles will never
+ * produce the same identifier.
+ */
+enum {
+	X509_CACHE_ID_ROOT_CA = 1,			/**< Identifier for a trusted root CA. */
+	X509_CACHE_ID_INTERMEDIATE_CA,		/**< Identifier for an intermediate CA. */
+	X509_CACHE_ID_LEAF,					/**< Identifier for an end entity certificate. */
+	X509_CACHE_ID_CHAIN,				/**< Identifier for an ordered list of certificates. */
+};
+
+/**
+ * Context for a certificate managed by the cache.
+ */
+struct x509_cache_certificate {
+	struct x509_certificate cert;		/**< The certificate loaded by the target engine. */
+	uint8_t id[KEY_CACHE_ID_LENGTH];	/**< Identifier for the certificate. */
+	bool cacheable;						/**< Flag indicating the certificate has a valid identifier. */
+};
+
+/**
+ * A CA certificate added to a certificate store.
+ */
+struct x509_cache_ca {
+	struct x509_cache_ca *next;			/**< The next CA added to the store. */
+	uint8_t id[KEY_CACHE_ID_LENGTH];	/**< Identifier for the CA certificate. */
+	uint8_t type;						/**< The type of CA certificate. */
+	const uint8_t *der;					/**< Certificate DER that has not been added to the target store. */
+	size_t length;						/**< Length of the certificate DER.  0 if already in the target store. */
+};
+
+/**
+ * Context for a certificate store managed by the cache.
+ */
+struct x509_cache_ca_certs {
+	struct x509_ca_certs store;			/**< The certificate store for the target engine. */
+	struct x509_cache_ca *cas;			/**< List of CAs added to the store. */
+	struct x509_cache_ca **tail;		/**< Location to add the next CA to the list. */
+	uint8_t chain[KEY_CACHE_ID_LENGTH];	/**< Identifier for the ordered list of CAs in the store. */
+	bool cacheable;						/**< Flag indicating the store has a valid identifier. */
+};
+
+
+/**
+ * Generate an identifier for data tracked by the cache.  The caller must hold the cache lock.
+ *
+ * @param x509 The cache generating the identifier.
+ * @param type The type of identifier to generate.
+ * @param prefix Optional identifier to include before the data.  Null to only use the data.
+ * @param data The data to identify.
+ * @param length Length of the data.
+ * @param id Output for the identifier.  This can be the same buffer as the prefix.
+ *
+ * @return 0 if the identifier was generated successfully or an error code.
+ */
+static int x509_cache_generate_id (const struct x509_engine_cache *x509, uint8_t type,
+	const uint8_t *prefix, const uint8_t *data, size_t length, uint8_t *id)
+{
+	int status;
+
+	status = x509->hash->start_sha256 (x509->hash);
+	if (status != 0) {
+		return status;
+	}
+
+	status = x509->hash->update (x509->hash, &type, sizeof (type));
+	if (status != 0) {
+		goto error;
+	}
+
+	if (prefix != NULL) {
+		status = x509->hash->update (x509->hash, prefix, KEY_CACHE_ID_LENGTH);
+		if (status != 0) {
+			goto error;
+		}
+	}
+
+	status = x509->hash->update (x509->hash, data, length);
+	if (status != 0) {
+		goto error;
+	}
+
+	status = x509->hash->finish (x509->hash, id, KEY_CACHE_ID_LENGTH);
+	if (status != 0) {
+		goto error;
+	}
+
+	return 0;
+
+error:
+	x509->hash->cancel (x509->hash);
+	return status;
+}
+
+/**
+ * Get the length of a certificate from a DER buffer that may contain additional data.
+ *
+ * @param der The buffer containing the certificate.
+ * @param length Length of the buffer.
+ *
+ * @return The length of the certificate or 0 if the length could not be determined.
+ */
+static size_t x509_cache_get_cert_length (const uint8_t *der, size_t length)
+{
+	int cert_length;
+
+	cert_length = asn1_get_der_item_len (der, length);
+	if (ROT_IS_ERROR (cert_length) || ((size_t) cert_length > length)) {
+		return 0;
+	}
+
+	return cert_length;
+}
+
+#if defined X509_ENABLE_CREATE_CERTIFICATES || defined X509_ENABLE_AUTHENTICATION
+/**
+ * Get the target certificate from a certificate managed by the cache.
+ *
+ * @param cert The certificate managed by the cache.
+ *
+ * @return The target certificate or null if there is no valid certificate.
+ */
+static const struct x509_certificate* x509_cache_get_target_cert (
+	const struct x509_certificate *cert)
+{
+	if ((cert == NULL) || (cert->context == NULL)) {
+		return NULL;
+	}
+
+	return &((struct x509_cache_certificate*) cert->context)->cert;
+}
+#endif
+
+#ifdef X509_ENABLE_CREATE_CERTIFICATES
+int x509_cache_create_csr (struct x509_engine *engine, const uint8_t *priv_key, size_t key_length,
+	enum hash_type sig_hash, const char *name, int type, const uint8_t *eku, size_t eku_length,
+	const struct x509_extension_builder *const *extra_extensions, size_t ext_count, uint8_t **csr,
+	size_t *csr_length)
+{
+	const struct x509_engine_cache *x509 = (const struct x509_engine_cache*) engine;
+
+	if (engine == NULL) {
+		return X509_ENGINE_INVALID_ARGUMENT;
+	}
+
+	return x509->target->create_csr (x509->target, priv_key, key_length, sig_hash, name, type, eku,
+		eku_length, extra_extensions, ext_count, csr, csr_length);
+}
+
+int x509_cache_create_self_signed_certificate (struct x509_engine *engine,
+	struct x509_certificate *cert, const uint8_t *priv_key, size_t key_length,
+	enum hash_type sig_hash, const uint8_t *serial_num, size_t serial_length, const char *name,
+	int type, const struct x509_extension_builder *const *extra_extensions, size_t ext_count)
+{
+	const struct x509_engine_cache *x509 = (const struct x509_engine_cache*) engine;
+	struct x509_cache_certificate *created;
+	int status;
+
+	if ((engine == NULL) || (cert == NULL)) {
+		return X509_ENGINE_INVALID_ARGUMENT;
+	}
+
+	created = platform_calloc (1, sizeof (struct x509_cache_certificate));
+	if (created == NULL) {
+		return X509_ENGINE_NO_MEMORY;
+	}
+
+	status = x509->target->create_self_signed_certificate (x509->target, &created->cert, priv_key,
+		key_length, sig_hash, serial_num, serial_length, name, type, extra_extensions, ext_count);
+	if (status != 0) {
+		platform_free (created);
+		return status;
+	}
+
+	cert->context = created;
+
+	return 0;
+}
+
+int x509_cache_create_ca_signed_certificate (struct x509_engine *engine,
+	struct x509_certificate *cert, const uint8_t *key, size_t key_length, const uint8_t *serial_num,
+	size_t serial_length, const char *name, int type, const uint8_t* ca_priv_key,
+	size_t ca_key_length, enum hash_type sig_hash, const struct x509_certificate *ca_cert,
+	const struct x509_extension_builder *const *extra_extensions, size_t ext_count)
+{
+	const struct x509_engine_cache *x509 = (const struct x509_engine_cache*) engine;
+	struct x509_cache_certificate *created;
+	int status;
+
+	if ((engine == NULL) || (cert == NULL)) {
+		return X509_ENGINE_INVALID_ARGUMENT;
+	}
+
+	created = platform_calloc (1, sizeof (struct x509_cache_certificate));
+	if (created == NULL) {
+		return X509_ENGINE_NO_MEMORY;
+	}
+
+	status = x509->target->create_ca_signed_certificate (x509->target, &created->cert, key,
+		key_length, serial_num, serial_length, name, type, ca_priv_key, ca_key_length, sig_hash,
+		x509_cache_get_target_cert (ca_cert), extra_extensions, ext_count);
+	if (status != 0) {
+		platform_free (created);
+		return status;
+	}
+
+	cert->context = created;
+
+	return 0;
+}
+#endif
+
+int x509_cache_load_certificate (struct x509_engine *engine, struct x509_certificate *cert,
+	const uint8_t *der, size_t length)
+{
+	const struct x509_engine_cache *x509 = (const struct x509_engine_cache*) engine;
+	struct x509_cache_certificate *loaded;
+	size_t cert_length;
+	int status = 0;
+
+	if ((engine == NULL) || (cert == NULL) || (der == NULL) || (length == 0)) {
+		return X509_ENGINE_INVALID_ARGUMENT;
+	}
+
+	loaded = platform_calloc (1, sizeof (struct x509_cache_certificate));
+	if (loaded == NULL) {
+		return X509_ENGINE_NO_MEMORY;
+	}
+
+	cert_length = x509_cache_get_cert_length (der, length);
+	if (cert_length != 0) {
+		platform_mutex_lock (&x509->state->lock);
+		status = x509_cache_generate_id (x509, X509_CACHE_ID_LEAF, NULL, der, cert_length,
+			loaded->id);
+		platform_mutex_unlock (&x509->state->lock);
+
+		loaded->cacheable = (status == 0);
+	}
+
+	if (status == 0) {
+		status = x509->target->load_certificate (x509->target, &loaded->cert, der, length);
+	}
+
+	if (status != 0) {
+		platform_free (loaded);
+		return status;
+	}
+
+	cert->context = loaded;
+
+	return 0;
+}
+
+void x509_cache_release_certificate (struct x509_engine *engine, struct x509_certificate *cert)
+{
+	const struct x509_engine_cache *x509 = (const struct x509_engine_cache*) engine;
+	struct x509_cache_certificate *loaded;
+
+	if ((engine == NULL) || (cert == NULL) || (cert->context == NULL)) {
+		return;
+	}
+
+	loaded = cert->context;
+	x509->target->release_certificate (x509->target, &loaded->cert);
+
+	platform_free (loaded);
+	cert->context = NULL;
+}
+
+#ifdef X509_ENABLE_CREATE_CERTIFICATES
+int x509_cache_get_certificate_der (struct x509_engine *engine,
+	const struct x509_certificate *cert, uint8_t **der, size_t *length)
+{
+	const struct x509_engine_cache *x509 = (const struct x509_engine_cache*) engine;
+
+	if (engine == NULL) {
+		return X509_ENGINE_INVALID_ARGUMENT;
+	}
+
+	return x509->target->get_certificate_der (x509->target, x509_cache_get_target_cert (cert), der,
+		length);
+}
+#endif
+
+#ifdef X509_ENABLE_AUTHENTICATION
+int x509_cache_get_certificate_version (struct x509_engine *engine,
+	const struct x509_certificate *cert)
+{
+	const struct x509_engine_cache *x509 = (const struct x509_engine_cache*) engine;
+
+	if (engine == NULL) {
+		return X509_ENGINE_INVALID_ARGUMENT;
+	}
+
+	return x509->target->get_certificate_version (x509->target, x509_cache_get_target_cert (cert));
+}
+
+int x509_cache_get_serial_number (struct x509_engine *engine, const struct x509_certificate *cert,
+	uint8_t *serial_num, size_t length)
+{
+	const struct x509_engine_cache *x509 = (const struct x509_engine_cache*) engine;
+
+	if (engine == NULL) {
+		return X509_ENGINE_INVALID_ARGUMENT;
+	}
+
+	return x509->target->get_serial_number (x509->target, x509_cache_get_target_cert (cert),
+		serial_num, length);
+}
+
+int x509_cache_get_public_key_type (struct x509_engine *engine, const struct x509_certificate *cert)
+{
+	const struct x509_engine_cache *x509 = (const struct x509_engine_cache*) engine;
+
+	if (engine == NULL) {
+		return X509_ENGINE_INVALID_ARGUMENT;
+	}
+
+	return x509->target->get_public_key_type (x509->target, x509_cache_get_target_cert (cert));
+}
+
+int x509_cache_get_public_key_length (struct x509_engine *engine,
+	const struct x509_certificate *cert)
+{
+	const struct x509_engine_cache *x509 = (const struct x509_engine_cache*) engine;
+
+	if (engine == NULL) {
+		return X509_ENGINE_INVALID_ARGUMENT;
+	}
+
+	return x509->target->get_public_key_length (x509->target, x509_cache_get_target_cert (cert));
+}
+
+int x509_cache_get_public_key (struct x509_engine *engine, const struct x509_certificate *cert,
+	uint8_t **key, size_t *key_length)
+{
+	const struct x509_engine_cache *x509 = (const struct x509_engine_cache*) engine;
+
+	if (engine == NULL) {
+		return X509_ENGINE_INVALID_ARGUMENT;
+	}
+
+	return x509->target->get_public_key (x509->target, x509_cache_get_target_cert (cert), key,
+		key_length);
+}
+
+int x509_cache_init_ca_cert_store (struct x509_engine *engine, struct x509_ca_certs *store)
+{
+	const struct x509_engine_cache *x509 = (const struct x509_engine_cache*) engine;
+	struct x509_cache_ca_certs *certs;
+	int status;
+
+	if ((engine == NULL) || (store == NULL)) {
+		return X509_ENGINE_INVALID_ARGUMENT;
+	}
+
+	certs = platform_calloc (1, sizeof (struct x509_cache_ca_certs));
+	if (certs == NULL) {
+		return X509_ENGINE_NO_MEMORY;
+	}
+
+	status = x509->target->init_ca_cert_store (x509->target, &certs->store);
+	if (status != 0) {
+		platform_free (certs);
+		return status;
+	}
+
+	certs->tail = &certs->cas;
+	certs->cacheable = true;
+
+	store->context = certs;
+
+	return 0;
+}
+
+void x509_cache_release_ca_cert_store (struct x509_engine *engine, struct x509_ca_certs *store)
+{
+	const struct x509_engine_cache *x509 = (const struct x509_engine_cache*) engine;
+	struct x509_cache_ca_certs *certs;
+	struct x509_cache_ca *ca;
+
+	if ((engine == NULL) || (store == NULL) || (store->context == NULL)) {
+		return;
+	}
+
+	certs = store->context;
+	while (certs->cas != NULL) {
+		ca = certs->cas;
+		certs->cas = ca->next;
+
+		platform_free (ca);
+	}
+
+	x509->target->release_ca_cert_store (x509->target, &certs->store);
+
+	platform_free (certs);
+	store->context = NULL;
+}
+
+/**
+ * Add an identifier to the cache, if it is not already present.  The caller must hold the cache
+ * lock.
+ *
+ * @param x509 The cache to update.
+ * @param id The identifier to add.
+ */
+static void x509_cache_add_id (const struct x509_engine_cache *x509, const uint8_t *id)
+{
+	bool evicted;
+	int index;
+
+	index = key_cache_find (&x509->cache, id);
+	if (ROT_IS_ERROR (index)) {
+		key_cache_add (&x509->cache, id, &evicted);
+	}
+}
+
+/**
+ * Add a CA certificate to the target certificate store.
+ *
+ * @param x509 The cache that manages the store.
+ * @param certs The certificate store to update.
+ * @param type The type of CA to add.
+ * @param der The DER encoded certificate to add.
+ * @param length Length of the certificate DER.
+ *
+ * @return 0 if the certificate was added successfully or an error code.
+ */
+static int x509_cache_add_target_ca (const struct x509_engine_cache *x509,
+	struct x509_cache_ca_certs *certs, uint8_t type, const uint8_t *der, size_t length)
+{
+	if (type == X509_CACHE_ID_ROOT_CA) {
+		return x509->target->add_root_ca (x509->target, &certs->store, der, length);
+	}
+	else {
+		return x509->target->add_intermediate_ca (x509->target, &certs->store, der, length);
+	}
+}
+
+/**
+ * Add a CA certificate to a certificate store.  CAs that have already been authenticated are not
+ * provided to the target engine until they are needed for path validation.
+ *
+ * @param engine The cache that manages the store.
+ * @param store The certificate store to update.
+ * @param type The type of CA to add.
+ * @param der The DER encoded certificate to add.
+ * @param length Length of the certificate DER.
+ *
+ * @return 0 if the certificate was added successfully or an error code.
+ */
+static int x509_cache_add_ca (struct x509_engine *engine, struct x509_ca_certs *store,
+	uint8_t type, const uint8_t *der, size_t length)
+{
+	const struct x509_engine_cache *x509 = (const struct x509_engine_cache*) engine;
+	struct x509_cache_ca_certs *certs;
+	struct x509_cache_ca *ca;
+	uint8_t id[KEY_CACHE_ID_LENGTH];
+	uint8_t chain[KEY_CACHE_ID_LENGTH];
+	size_t cert_length;
+	bool cached = false;
+	int index;
+	int status;
+
+	if ((engine == NULL) || (store == NULL) || (store->context == NULL) || (der == NULL) ||
+		(length == 0)) {
+		return X509_ENGINE_INVALID_ARGUMENT;
+	}
+
+	certs = store->context;
+	if (!certs->cacheable) {
+		return x509_cache_add_target_ca (x509, certs, type, der, length);
+	}
+
+	cert_length = x509_cache_get_cert_length (der, length);
+	if (cert_length == 0) {
+		/* The certificate can't be identified, so authentication with this store can't be
+		 * cached. */
+		certs->cacheable = false;
+		return x509_cache_add_target_ca (x509, certs, type, der, length);
+	}
+
+	platform_mutex_lock (&x509->state->lock);
+
+	status = x509_cache_generate_id (x509, type, NULL, der, cert_length, id);
+	if (status == 0) {
+		status = x509_cache_generate_id (x509, X509_CACHE_ID_CHAIN, certs->chain, id, sizeof (id),
+			chain);
+	}
+
+	if (status == 0) {
+		index = key_cache_find (&x509->cache, id);
+		cached = !ROT_IS_ERROR (index);
+	}
+
+	platform_mutex_unlock (&x509->state->lock);
+
+	if (status != 0) {
+		return status;
+	}
+
+	ca = platform_malloc (sizeof (struct x509_cache_ca) + ((cached) ? cert_length : 0));
+	if (ca == NULL) {
+		return X509_ENGINE_NO_MEMORY;
+	}
+
+	if (cached) {
+		memcpy ((uint8_t*) &ca[1], der, cert_length);
+		ca->der = (uint8_t*) &ca[1];
+		ca->length = cert_length;
+	}
+	else {
+		status = x509_cache_add_target_ca (x509, certs, type, der, length);
+		if (status != 0) {
+			platform_free (ca);
+			return status;
+		}
+
+		ca->der = NULL;
+		ca->length = 0;
+	}
+
+	memcpy (ca->id, id, sizeof (id));
+	ca->type = type;
+	ca->next = NULL;
+
+	*certs->tail = ca;
+	certs->tail = &ca->next;
+	memcpy (certs->chain, chain, sizeof (chain));
+
+	return 0;
+}
+
+int x509_cache_add_root_ca (struct x509_engine *engine, struct x509_ca_certs *store,
+	const uint8_t *der, size_t length)
+{
+	return x509_cache_add_ca (engine, store, X509_CACHE_ID_ROOT_CA, der, length);
+}
+
+int x509_cache_add_intermediate_ca (struct x509_engine *engine, struct x509_ca_certs *store,
+	const uint8_t *der, size_t length)
+{
+	return x509_cache_add_ca (engine, store, X509_CACHE_ID_INTERMEDIATE_CA, der, length);
+}
+
+int x509_cache_authenticate (struct x509_engine *engine, const struct x509_certificate *cert,
+	const struct x509_ca_certs *store)
+{
+	const struct x509_engine_cache *x509 = (const struct x509_engine_cache*) engine;
+	struct x509_cache_certificate *leaf;
+	struct x509_cache_ca_certs *certs;
+	struct x509_cache_ca *ca;
+	uint8_t id[KEY_CACHE_ID_LENGTH];
+	bool cacheable;
+	int index;
+	int status;
+
+	if ((engine == NULL) || (cert == NULL) || (store == NULL) || (cert->context == NULL) ||
+		(store->context == NULL)) {
+		return X509_ENGINE_INVALID_ARGUMENT;
+	}
+
+	leaf = cert->context;
+	certs = store->context;
+	cacheable = leaf->cacheable && certs->cacheable;
+
+	if (cacheable) {
+		platform_mutex_lock (&x509->state->lock);
+
+		status = x509_cache_generate_id (x509, X509_CACHE_ID_CHAIN, certs->chain, leaf->id,
+			sizeof (leaf->id), id);
+		if (status == 0) {
+			index = key_cache_find (&x509->cache, id);
+			if (!ROT_IS_ERROR (index)) {
+				platform_mutex_unlock (&x509->state->lock);
+				return 0;
+			}
+		}
+
+		platform_mutex_unlock (&x509->state->lock);
+
+		if (status != 0) {
+			return status;
+		}
+	}
+
+	/* Provide any CAs that were skipped to the target engine for path validation. */
+	for (ca = certs->cas; ca != NULL; ca = ca->next) {
+		if (ca->length != 0) {
+			status = x509_cache_add_target_ca (x509, certs, ca->type, ca->der, ca->length);
+			if (status != 0) {
+				return status;
+			}
+
+			ca->length = 0;
+		}
+	}
+
+	status = x509->target->authenticate (x509->target, &leaf->cert, &certs->store);
+	if ((status == 0) && cacheable) {
+		platform_mutex_lock (&x509->state->lock);
+
+		x509_cache_add_id (x509, id);
+		for (ca = certs->cas; ca != NULL; ca = ca->next) {
+			x509_cache_add_id (x509, ca->id);
+		}
+
+		platform_mutex_unlock (&x509->state->lock);
+	}
+
+	return status;
+}
+#endif
+
+void x509_cache_on_cfm_activated (const struct cfm_observer *observer, struct cfm *active)
+{
+	const struct x509_engine_cache *x509 =
+		TO_DERIVED_TYPE (observer, const struct x509_engine_cache, base_cfm);
+
+	UNUSED (active);
+
+	x509_cache_flush (x509);
+}
+
+void x509_cache_on_clear_active (const struct cfm_observer *observer)
+{
+	const struct x509_engine_cache *x509 =
+		TO_DERIVED_TYPE (observer, const struct x509_engine_cache, base_cfm);
+
+	x509_cache_flush (x509);
+}
+
+/**
+ * Initialize an X.509 engine that caches authenticated certificates.
+ *
+ * @param engine The X.509 cache to initialize.
+ * @param state Variable context for the cache.  This must be uninitialized.
+ * @param target The target engine that will be used to execute certificate operations.
+ * @param hash The hash engine to use for generating certificate identifiers.
+ * @param entries Storage for tracking cached certificates.  Each authenticated chain uses one entry
+ * for the chain and one entry for each CA in the chain that is not already cached.
+ * @param count The number of entries in the cache.
+ *
+ * @return 0 if the engine was successfully initialized or an error code.
+ */
+int x509_cache_init (struct x509_engine_cache *engine, struct x509_engine_cache_state *state,
+	struct x509_engine *target, struct hash_engine *hash, struct key_cache_entry *entries,
+	size_t count)
+{
+	if (engine == NULL) {
+		return X509_ENGINE_INVALID_ARGUMENT;
+	}
+
+	memset (engine, 0, sizeof (struct x509_engine_cache));
+
+#ifdef X509_ENABLE_CREATE_CERTIFICATES
+	engine->base.create_csr = x509_cache_create_csr;
+	engine->base.create_self_signed_certificate = x509_cache_create_self_signed_certificate;
+	engine->base.create_ca_signed_certificate = x509_cache_create_ca_signed_certificate;
+#endif
+	engine->base.load_certificate = x509_cache_load_certificate;
+	engine->base.release_certificate = x509_cache_release_certificate;
+#ifdef X509_ENABLE_CREATE_CERTIFICATES
+	engine->base.get_certificate_der = x509_cache_get_certificate_der;
+#endif
+#ifdef X509_ENABLE_AUTHENTICATION
+	engine->base.get_certificate_version = x509_cache_get_certificate_version;
+	engine->base.get_serial_number = x509_cache_get_serial_number;
+	engine->base.get_public_key_type = x509_cache_get_public_key_type;
+	engine->base.get_public_key_length = x509_cache_get_public_key_length;
+	engine->base.get_public_key = x509_cache_get_public_key;
+	engine->base.init_ca_cert_store = x509_cache_init_ca_cert_store;
+	engine->base.release_ca_cert_store = x509_cache_release_ca_cert_store;
+	engine->base.add_root_ca = x509_cache_add_root_ca;
+	engine->base.add_intermediate_ca = x509_cache_add_intermediate_ca;
+	engine->base.authenticate = x509_cache_authenticate;
+#endif
+
+	engine->base_cfm.on_cfm_activated = x509_cache_on_cfm_activated;
+	engine->base_cfm.on_clear_active = x509_cache_on_clear_active;
+
+	engine->state = state;
+	engine->target = target;
+	engine->hash = hash;
+
+	engine->cache.state = (state != NULL) ? &state->cache : NULL;
+	engine->cache.entries = entries;
+	engine->cache.count = count;
+
+	return x509_cache_init_state (engine);
+}
+
+/**
+ * Initialize only the variable state for an X.509 certificate cache.  The rest of the instance is
+ * assumed to have already been initialized.
+ *
+ * This would generally be used with a statically initialized instance.
+ *
+ * @param engine The X.509 cache that contains the state to initialize.
+ *
+ * @return 0 if the state was successfully initialized or an error code.
+ */
+int x509_cache_init_state (const struct x509_engine_cache *engine)
+{
+	int status;
+
+	if ((engine == NULL) || (engine->state == NULL) || (engine->target == NULL) ||
+		(engine->hash == NULL)) {
+		return X509_ENGINE_INVALID_ARGUMENT;
+	}
+
+	memset (engine->state, 0, sizeof (struct x509_engine_cache_state));
+
+	status = key_cache_init_state (&engine->cache);
+	if (status != 0) {
+		return X509_ENGINE_INVALID_ARGUMENT;
+	}
+
+	return platform_mutex_init (&engine->state->lock);
+}
+
+/**
+ * Release the resources used by an X.509 certificate cache.
+ *
+ * @param engine The X.509 cache to release.
+ */
+void x509_cache_release (const struct x509_engine_cache *engine)
+{
+	if (engine != NULL) {
+		key_cache_release (&engine->cache);
+		platform_mutex_free (&engine->state->lock);
+	}
+}
+
+/**
+ * Remove all certificates and chains from the cache.  This must be called whenever the trusted root
+ * CAs change, such as when a new root CA is provisioned.  Changes to the active CFM are handled by
+ * registering the cache as a CFM observer, but other changes to trusted root CAs must be handled
+ * by calling this function directly.
+ *
+ * @param engine The X.509 cache to flush.
+ *
+ * @return 0 if the cache was flushed or an error code.
+ */
+int x509_cache_flush (const struct x509_engine_cache *engine)
+{
+	size_t i;
+
+	if (engine == NULL) {
+		return X509_ENGINE_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&engine->state->lock);
+
+	for (i = 0; i < engine->cache.count; i++) {
+		key_cache_remove (&engine->cache, i);
+	}
+
+	platform_mutex_unlock (&engine->state->lock);
+
+	return 0;
+}
+
+/**
+ * Get the usage counters for an X.509 certificate cache.
+ *
+ * @param engine The X.509 cache to query.
+ * @param stats Output for the cache counters.
+ *
+ * @return 0 if the counters were retrieved or an error code.
+ */
+int x509_cache_get_stats (const struct x509_engine_cache *engine, struct key_cache_stats *stats)
+{
+	int status;
+
+	if ((engine == NULL) || (stats == NULL)) {
+		return X509_ENGINE_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&engine->state->lock);
+	status = key_cache_get_stats (&engine->cache, stats);
+	platform_mutex_unlock (&engine->state->lock);
+
+	return status;
+}
@@ -0,0 +1,63 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef X509_CACHE_H_
+#define X509_CACHE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include "platform_api.h"
+#include "asn1/x509.h"
+#include "crypto/hash.h"
+#include "crypto/key_cache.h"
+#include "manifest/cfm/cfm_observer.h"
+
+
+/**
+ * Variable context for the X.509 certificate cache.
+ */
+struct x509_engine_cache_state {
+	struct key_cache_state cache;		/**< Replacement state for the cached certificates. */
+	platform_mutex lock;				/**< Synchronization for cache accesses. */
+};
+
+/**
+ * An X.509 engine that remembers certificates and certificate chains that have been successfully
+ * authenticated, allowing repeated authentication of the same chain to skip path validation.
+ * Certificates are identified by the SHA-256 digest of their DER encoding.  All certificate
+ * operations are executed by a target X.509 engine.
+ *
+ * Root and intermediate CAs that are part of an authenticated chain are remembered so that adding
+ * them to a certificate store again does not require parsing or verifying them.  If the chain is
+ * not in the cache, these certificates are provided to the target engine before authentication.
+ *
+ * The cache must be flushed whenever the set of trusted root CAs changes.  The cache does not
+ * register for any notifications on its own, so the platform integrating it is responsible for
+ * this:
+ *   - Register base_cfm with cfm_manager_add_observer for every CFM manager whose CFMs provide
+ *     root CA digests to an attestation requester using the cache.  This flushes the cache when
+ *     a new CFM is activated or the active CFM is cleared.
+ *   - Call x509_cache_flush after storing a new root or intermediate CA with the RIoT key
+ *     manager, or after changing the root CA provided to an attestation requester.
+ */
+struct x509_engine_cache {
+	struct x509_engine base;				/**< Base API implementation. */
+	struct cfm_observer base_cfm;			/**< Observer for CFM changes. */
+	struct x509_engine_cache_state *state;	/**< Variable context for the cache. */
+	struct x509_engine *target;				/**< X.509 instance to use for certificate operations. */
+	struct hash_engine *hash;				/**< Hash engine for generating certificate digests. */
+	struct key_cache cache;					/**< Tracking for authenticated certificates and chains. */
+};
+
+
+int x509_cache_init (struct x509_engine_cache *engine, struct x509_engine_cache_state *state,
+	struct x509_engine *target, struct hash_engine *hash, struct key_cache_entry *entries,
+	size_t count);
+int x509_cache_init_state (const struct x509_engine_cache *engine);
+void x509_cache_release (const struct x509_engine_cache *engine);
+
+int x509_cache_flush (const struct x509_engine_cache *engine);
+int x509_cache_get_stats (const struct x509_engine_cache *engine, struct key_cache_stats *stats);
+
+
+#endif /* X509_CACHE_H_ */
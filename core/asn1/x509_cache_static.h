@@ -0,0 +1,132 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef X509_CACHE_STATIC_H_
+#define X509_CACHE_STATIC_H_
+
+#include "x509_cache.h"
+#include "crypto/key_cache_static.h"
+
+
+/* Internal functions declared to allow for static initialization. */
+int x509_cache_create_csr (struct x509_engine *engine, const uint8_t *priv_key, size_t key_length,
+	enum hash_type sig_hash, const char *name, int type, const uint8_t *eku, size_t eku_length,
+	const struct x509_extension_builder *const *extra_extensions, size_t ext_count, uint8_t **csr,
+	size_t *csr_length);
+int x509_cache_create_self_signed_certificate (struct x509_engine *engine,
+	struct x509_certificate *cert, const uint8_t *priv_key, size_t key_length,
+	enum hash_type sig_hash, const uint8_t *serial_num, size_t serial_length, const char *name,
+	int type, const struct x509_extension_builder *const *extra_extensions, size_t ext_count);
+int x509_cache_create_ca_signed_certificate (struct x509_engine *engine,
+	struct x509_certificate *cert, const uint8_t *key, size_t key_length, const uint8_t *serial_num,
+	size_t serial_length, const char *name, int type, const uint8_t* ca_priv_key,
+	size_t ca_key_length, enum hash_type sig_hash, const struct x509_certificate *ca_cert,
+	const struct x509_extension_builder *const *extra_extensions, size_t ext_count);
+int x509_cache_load_certificate (struct x509_engine *engine, struct x509_certificate *cert,
+	const uint8_t *der, size_t length);
+void x509_cache_release_certificate (struct x509_engine *engine, struct x509_certificate *cert);
+int x509_cache_get_certificate_der (struct x509_engine *engine,
+	const struct x509_certificate *cert, uint8_t **der, size_t *length);
+int x509_cache_get_certificate_version (struct x509_engine *engine,
+	const struct x509_certificate *cert);
+int x509_cache_get_serial_number (struct x509_engine *engine, const struct x509_certificate *cert,
+	uint8_t *serial_num, size_t length);
+int x509_cache_get_public_key_type (struct x509_engine *engine,
+	const struct x509_certificate *cert);
+int x509_cache_get_public_key_length (struct x509_engine *engine,
+	const struct x509_certificate *cert);
+int x509_cache_get_public_key (struct x509_engine *engine, const struct x509_certificate *cert,
+	uint8_t **key, size_t *key_length);
+int x509_cache_init_ca_cert_store (struct x509_engine *engine, struct x509_ca_certs *store);
+void x509_cache_release_ca_cert_store (struct x509_engine *engine, struct x509_ca_certs *store);
+int x509_cache_add_root_ca (struct x509_engine *engine, struct x509_ca_certs *store,
+	const uint8_t *der, size_t length);
+int x509_cache_add_intermediate_ca (struct x509_engine *engine, struct x509_ca_certs *store,
+	const uint8_t *der, size_t length);
+int x509_cache_authenticate (struct x509_engine *engine, const struct x509_certificate *cert,
+	const struct x509_ca_certs *store);
+
+void x509_cache_on_cfm_activated (const struct cfm_observer *observer, struct cfm *active);
+void x509_cache_on_clear_active (const struct cfm_observer *observer);
+
+
+/**
+ * Constant initializer for certificate generation APIs.
+ */
+#ifdef X509_ENABLE_CREATE_CERTIFICATES
+#define	X509_CACHE_CREATE_CERTIFICATES_API \
+	.create_csr = x509_cache_create_csr, \
+	.create_self_signed_certificate = x509_cache_create_self_signed_certificate, \
+	.create_ca_signed_certificate = x509_cache_create_ca_signed_certificate,
+
+#define	X509_CACHE_DER_API \
+	.get_certificate_der = x509_cache_get_certificate_der,
+#else
+#define	X509_CACHE_CREATE_CERTIFICATES_API
+#define	X509_CACHE_DER_API
+#endif
+
+/**
+ * Constant initializer for certificate authentication APIs.
+ */
+#ifdef X509_ENABLE_AUTHENTICATION
+#define	X509_CACHE_AUTHENTICATION_API \
+	.get_certificate_version = x509_cache_get_certificate_version, \
+	.get_serial_number = x509_cache_get_serial_number, \
+	.get_public_key_type = x509_cache_get_public_key_type, \
+	.get_public_key_length = x509_cache_get_public_key_length, \
+	.get_public_key = x509_cache_get_public_key, \
+	.init_ca_cert_store = x509_cache_init_ca_cert_store, \
+	.release_ca_cert_store = x509_cache_release_ca_cert_store, \
+	.add_root_ca = x509_cache_add_root_ca, \
+	.add_intermediate_ca = x509_cache_add_intermediate_ca, \
+	.authenticate = x509_cache_authenticate,
+#else
+#define	X509_CACHE_AUTHENTICATION_API
+#endif
+
+/**
+ * Constant initializer for the X.509 API.
+ */
+#define	X509_CACHE_API_INIT  { \
+		X509_CACHE_CREATE_CERTIFICATES_API \
+		.load_certificate = x509_cache_load_certificate, \
+		.release_certificate = x509_cache_release_certificate, \
+		X509_CACHE_DER_API \
+		X509_CACHE_AUTHENTICATION_API \
+	}
+
+/**
+ * Constant initializer for the CFM event handlers.
+ */
+#define	X509_CACHE_CFM_OBSERVER_API_INIT  { \
+		.on_cfm_verified = NULL, \
+		.on_cfm_activated = x509_cache_on_cfm_activated, \
+		.on_clear_active = x509_cache_on_clear_active, \
+		.on_cfm_activation_request = NULL \
+	}
+
+
+/**
+ * Initialize a static instance of an X.509 engine that caches authenticated certificates.  This
+ * does not initialize the cache state.  This can be a constant instance.
+ *
+ * There is no validation done on the arguments.
+ *
+ * @param state_ptr Variable context for the cache.
+ * @param target_ptr The target engine that will be used to execute certificate operations.
+ * @param hash_ptr The hash engine to use for generating certificate identifiers.
+ * @param entries_ptr Storage for tracking cached certificates.
+ * @param entry_cnt The number of entries in the cache.
+ */
+#define	x509_cache_static_init(state_ptr, target_ptr, hash_ptr, entries_ptr, entry_cnt)	{ \
+		.base = X509_CACHE_API_INIT, \
+		.base_cfm = X509_CACHE_CFM_OBSERVER_API_INIT, \
+		.state = state_ptr, \
+		.target = target_ptr, \
+		.hash = hash_ptr, \
+		.cache = key_cache_static_init (&(state_ptr)->cache, entries_ptr, entry_cnt), \
+	}
+
+
+#endif /* X509_CACHE_STATIC_H_ */
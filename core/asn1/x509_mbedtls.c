@@ -18,15 +18,6 @@
 #include "common/unused.h"
 
 
-/**
- * mbedTLS data for managing CA certificates.
- */
-struct x509_mbedtls_ca_store_context {
-	mbedtls_x509_crt *root_ca;			/**< The chain of trusted root certificates. */
-	mbedtls_x509_crt *intermediate;		/**< The chain of intermediate CAs. */
-};
-
-
 /**
  * Create a new mbedTLS certificate instance.
  *
@@ -943,7 +934,9 @@ static int x509_mbedtls_init_ca_cert_store (struct x509_engine *engine, struct x
 		return X509_ENGINE_INVALID_ARGUMENT;
 	}
 
-	store_ctx = platform_malloc (sizeof (struct x509_mbedtls_ca_store_context));
+	store_ctx = object_pool_acquire_or_allocate (
+		((struct x509_engine_mbedtls*) engine)->ca_store_pool,
+		sizeof (struct x509_mbedtls_ca_store_context));
 	if (store_ctx == NULL) {
 		return X509_ENGINE_NO_MEMORY;
 	}
@@ -957,9 +950,9 @@ static int x509_mbedtls_init_ca_cert_store (struct x509_engine *engine, struct x
 static void x509_mbedtls_release_ca_cert_store (struct x509_engine *engine,
 	struct x509_ca_certs *store)
 {
-	UNUSED (engine);
+	struct x509_engine_mbedtls *mbedtls = (struct x509_engine_mbedtls*) engine;
 
-	if (store && store->context) {
+	if (mbedtls && store && store->context) {
 		struct x509_mbedtls_ca_store_context *store_ctx = store->context;
 
 		mbedtls_x509_crt_free (store_ctx->root_ca);
@@ -968,7 +961,7 @@ static void x509_mbedtls_release_ca_cert_store (struct x509_engine *engine,
 		mbedtls_x509_crt_free (store_ctx->intermediate);
 		platform_free (store_ctx->intermediate);
 
-		platform_free (store_ctx);
+		object_pool_release_or_free (mbedtls->ca_store_pool, store_ctx);
 		memset (store, 0, sizeof (struct x509_ca_certs));
 	}
 }
@@ -1154,6 +1147,36 @@ exit:
 	return status;
 }
 
+/**
+ * Provide a pool of buffers to use for CA certificate store contexts.  Without a pool, every
+ * certificate store context is allocated from the heap.  Contexts requested when the pool is empty
+ * will still be allocated from the heap.
+ *
+ * Only the store context is taken from the pool.  Certificates added to the store are owned by
+ * mbedTLS, which frees chained certificates through its own allocator, so they are always
+ * allocated from the heap.
+ *
+ * This must be called before any certificate stores are initialized.
+ *
+ * @param engine The X.509 engine to update.
+ * @param ca_store_pool The pool to use for certificate store contexts.  The pool slot size must be
+ * at least sizeof (struct x509_mbedtls_ca_store_context).  Set to null to always allocate from the
+ * heap.
+ *
+ * @return 0 if the pool was set successfully or an error code.
+ */
+int x509_mbedtls_set_ca_store_pool (struct x509_engine_mbedtls *engine,
+	const struct object_pool *ca_store_pool)
+{
+	if (engine == NULL) {
+		return X509_ENGINE_INVALID_ARGUMENT;
+	}
+
+	engine->ca_store_pool = ca_store_pool;
+
+	return 0;
+}
+
 /**
  * Release an mbedTLS X.509 engine.
  *
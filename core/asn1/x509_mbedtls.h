@@ -8,6 +8,7 @@
 #include "mbedtls/ctr_drbg.h"
 #include "mbedtls/entropy.h"
 #include "mbedtls/x509_crt.h"
+#include "memory_mgmt/object_pool.h"
 
 
 /**
@@ -16,6 +17,14 @@
 #define	X509_MAX_SIZE		1024
 
 
+/**
+ * mbedTLS data for managing CA certificates.
+ */
+struct x509_mbedtls_ca_store_context {
+	mbedtls_x509_crt *root_ca;			/**< The chain of trusted root certificates. */
+	mbedtls_x509_crt *intermediate;		/**< The chain of intermediate CAs. */
+};
+
 /**
  * An mbedTLS context for X.509 operations.
  */
@@ -24,12 +33,16 @@ struct x509_engine_mbedtls {
 	mbedtls_ctr_drbg_context ctr_drbg;	/**< A random number generator for the engine. */
 	mbedtls_entropy_context entropy;	/**< Entropy source for the random number generator. */
 	uint8_t der_buf[X509_MAX_SIZE];		/**< Temp buffer for building certificate DER data. */
+	const struct object_pool *ca_store_pool;	/**< Optional pool for CA certificate store contexts. */
 };
 
 
 int x509_mbedtls_init (struct x509_engine_mbedtls *engine);
 void x509_mbedtls_release (struct x509_engine_mbedtls *engine);
 
+int x509_mbedtls_set_ca_store_pool (struct x509_engine_mbedtls *engine,
+	const struct object_pool *ca_store_pool);
+
 /* ASN.1 encoding helper functions. */
 int x509_mbedtls_close_asn1_object (uint8_t **pos, uint8_t *start, uint8_t tag, int *length);
 
@@ -368,7 +368,8 @@ static int attestation_requester_verify_and_load_leaf_key (
 		goto release_leaf_cert;
 	}
 
-	platform_free (attestation->state->txn.cert_buffer);
+	object_pool_release_or_free (attestation->cert_pool,
+		attestation->state->txn.cert_buffer);
 	attestation->state->txn.cert_buffer = NULL;
 	attestation->state->txn.cert_buffer_len = 0;
 
@@ -409,7 +410,8 @@ release_cert_store:
 	attestation->x509->release_ca_cert_store (attestation->x509, &certs_chain);
 
 release_cert_buffer:
-	platform_free (attestation->state->txn.cert_buffer);
+	object_pool_release_or_free (attestation->cert_pool,
+		attestation->state->txn.cert_buffer);
 	attestation->state->txn.cert_buffer_len = 0;
 
 	return status;
@@ -835,8 +837,8 @@ static int attestation_requester_get_certificate_rsp_post_processing (
 		 * TODO: Optimize cert chain retrieval, get one cert at a time. */
 		if (attestation->state->txn.cert_buffer_len == 0) {
 			attestation->state->txn.cert_total_len = rsp->portion_len + rsp->remainder_len;
-			attestation->state->txn.cert_buffer =
-				platform_malloc (attestation->state->txn.cert_total_len);
+			attestation->state->txn.cert_buffer = object_pool_acquire_or_allocate (
+				attestation->cert_pool, attestation->state->txn.cert_total_len);
 			if (attestation->state->txn.cert_buffer == NULL) {
 				return ATTESTATION_NO_MEMORY;
 			}
@@ -845,7 +847,8 @@ static int attestation_requester_get_certificate_rsp_post_processing (
 		if ((rsp->portion_len + attestation->state->txn.cert_buffer_len) >
 			attestation->state->txn.cert_total_len) {
 			if (attestation->state->txn.cert_buffer != NULL) {
-				platform_free (attestation->state->txn.cert_buffer);
+				object_pool_release_or_free (attestation->cert_pool,
+					attestation->state->txn.cert_buffer);
 				attestation->state->txn.cert_buffer = NULL;
 			}
 
@@ -1315,8 +1318,8 @@ void attestation_requester_on_cerberus_get_certificate_response (
 	}
 	else {
 		if (attestation->state->txn.cert_buffer_len == 0) {
-			attestation->state->txn.cert_buffer =
-				platform_malloc (CERBERUS_PROTOCOL_MAX_CERT_CHAIN_LEN);
+			attestation->state->txn.cert_buffer = object_pool_acquire_or_allocate (
+				attestation->cert_pool, CERBERUS_PROTOCOL_MAX_CERT_CHAIN_LEN);
 			if (attestation->state->txn.cert_buffer == NULL) {
 				goto fail;
 			}
@@ -1628,6 +1631,31 @@ int attestation_requester_init_state (const struct attestation_requester *attest
 	return platform_semaphore_init (&attestation->state->next_action);
 }
 
+/**
+ * Provide a pool of buffers to use for certificate chains retrieved from devices.  Without a pool,
+ * each certificate chain is allocated from the heap.  Certificate chains larger than the pool slot
+ * size, or requested when the pool is empty, will still be allocated from the heap.
+ *
+ * This must be called before any device attestation is started.
+ *
+ * @param attestation Attestation requester instance to update.
+ * @param cert_pool The pool to use for certificate chain buffers.  Set to null to always allocate
+ * from the heap.
+ *
+ * @return 0 if the pool was set successfully or an error code.
+ */
+int attestation_requester_set_cert_pool (struct attestation_requester *attestation,
+	const struct object_pool *cert_pool)
+{
+	if (attestation == NULL) {
+		return ATTESTATION_INVALID_ARGUMENT;
+	}
+
+	attestation->cert_pool = cert_pool;
+
+	return 0;
+}
+
 /**
  * Release an attestation requester instance.
  *
@@ -2655,7 +2683,8 @@ static int attestation_requester_attest_device_spdm (
 			status = attestation_requester_send_spdm_request_and_get_response (attestation, rq_len,
 				device_addr, eid, true, SPDM_REQUEST_GET_CERTIFICATE);
 			if (status != 0) {
-				platform_free (attestation->state->txn.cert_buffer);
+				object_pool_release_or_free (attestation->cert_pool,
+					attestation->state->txn.cert_buffer);
 				goto clear_cert_chain;
 			}
 		}
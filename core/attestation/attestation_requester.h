@@ -10,6 +10,7 @@
 #include "crypto/ecc.h"
 #include "crypto/rsa.h"
 #include "crypto/rng.h"
+#include "memory_mgmt/object_pool.h"
 #include "cmd_interface/cerberus_protocol_observer.h"
 #include "cmd_interface/device_manager.h"
 #include "manifest/cfm/cfm_manager.h"
@@ -95,6 +96,7 @@ struct attestation_requester {
 	struct riot_key_manager *riot;								/**< RIoT key manager. */
 	struct device_manager *device_mgr;							/**< Device manager instance to utilize. */
 	struct cfm_manager *cfm_manager;							/**< CFM manager instance */
+	const struct object_pool *cert_pool;						/**< Optional pool for certificate chain buffers. */
 };
 
 
@@ -105,6 +107,8 @@ int attestation_requester_init (struct attestation_requester *attestation,
 	struct x509_engine *x509, struct rng_engine *rng, struct riot_key_manager *riot,
 	struct device_manager *device_mgr, struct cfm_manager *cfm_manager);
 int attestation_requester_init_state (const struct attestation_requester *attestation);
+int attestation_requester_set_cert_pool (struct attestation_requester *attestation,
+	const struct object_pool *cert_pool);
 void attestation_requester_deinit (const struct attestation_requester *ctrl);
 
 int attestation_requester_attest_device (const struct attestation_requester *attestation,
@@ -118,7 +118,34 @@ void attestation_requester_on_mctp_get_routing_table_entries_response (
  */
 #define attestation_requester_static_init(state_ptr, mctp_ptr, channel_ptr, primary_hash_ptr, \
 	secondary_hash_ptr, ecc_ptr, rsa_ptr, x509_ptr, rng_ptr, riot_ptr, device_mgr_ptr, \
-	cfm_manager_ptr) { \
+	cfm_manager_ptr) \
+	attestation_requester_static_init_with_cert_pool (state_ptr, mctp_ptr, channel_ptr, \
+		primary_hash_ptr, secondary_hash_ptr, ecc_ptr, rsa_ptr, x509_ptr, rng_ptr, riot_ptr, \
+		device_mgr_ptr, cfm_manager_ptr, NULL)
+
+/**
+ * Initialize a static attestation requester instance that uses a pool of buffers for certificate
+ * chains retrieved from devices.
+ * There is no validation done on the arguments.
+ *
+ * @param state_ptr The variable context for the attestation requester instance.
+ * @param mctp_ptr MCTP interface instance to utilize.
+ * @param channel_ptr Command channel instance to utilize.
+ * @param primary_hash_ptr The primary hash engine to utilize.
+ * @param secondary_hash_ptr The secondary hash engine to utilize for SPDM operations.
+ * @param ecc_ptr The ECC engine to utilize.
+ * @param rsa_ptr The RSA engine to utilize. Optional, can be set to NULL if not utilized.
+ * @param x509_ptr The x509 engine to utilize.
+ * @param rng_ptr The RNG engine to utilize.
+ * @param riot_ptr RIoT key manager.
+ * @param device_mgr_ptr Device manager instance to utilize.
+ * @param cfm_manager_ptr CFM manager to utilize.
+ * @param cert_pool_ptr Pool to use for certificate chain buffers.  Set to NULL to always allocate
+ * from the heap.
+ */
+#define attestation_requester_static_init_with_cert_pool(state_ptr, mctp_ptr, channel_ptr, \
+	primary_hash_ptr, secondary_hash_ptr, ecc_ptr, rsa_ptr, x509_ptr, rng_ptr, riot_ptr, \
+	device_mgr_ptr, cfm_manager_ptr, cert_pool_ptr) { \
 		.mctp = mctp_ptr, \
 		.channel = channel_ptr, \
 		.primary_hash = primary_hash_ptr, \
@@ -130,6 +157,7 @@ void attestation_requester_on_mctp_get_routing_table_entries_response (
 		.riot = riot_ptr, \
 		.device_mgr = device_mgr_ptr, \
 		.cfm_manager = cfm_manager_ptr, \
+		.cert_pool = cert_pool_ptr, \
 		.state = state_ptr, \
 		.mctp_rsp_observer = ATTESTATION_REQUESTER_MCTP_RSP_OBSERVER_API_INIT, \
 		.cerberus_rsp_observer = ATTESTATION_REQUESTER_CERBERUS_RSP_OBSERVER_API_INIT, \
@@ -10,6 +10,13 @@
 #include "pcr.h"
 
 
+/**
+ * The maximum number of PCR banks that will have measurements computed together in a single
+ * multi-buffer hash request.
+ */
+#define	PCR_COMPUTE_BANKS_BATCH			8
+
+
 /**
  * Common function to update digest in PCR bank's list of measurements
  *
@@ -429,6 +436,81 @@ exit:
 	return status;
 }
 
+/**
+ * Compute aggregate of all measurements for multiple PCR banks.  The measurement chain in each bank
+ * is independent of the other banks, so the next measurement for every bank is calculated together
+ * using a single multi-buffer hash request.
+ *
+ * The caller must hold the lock for every bank being computed.
+ *
+ * @param banks The list of PCR banks to compute aggregate measurements of.
+ * @param count The number of PCR banks in the list.
+ * @param hash Hashing engine to utilize.  This should support multi-buffer hashing to get any
+ * benefit over computing each bank individually.
+ *
+ * @return 0 if the measurements for all banks were computed successfully or an error code.
+ */
+int pcr_compute_banks (struct pcr_bank *banks, size_t count, struct hash_engine *hash)
+{
+	struct hash_multi_buffer buffers[PCR_COMPUTE_BANKS_BATCH];
+	uint8_t extend[PCR_COMPUTE_BANKS_BATCH][PCR_DIGEST_LENGTH * 2];
+	struct pcr_bank *pcr;
+	size_t first;
+	size_t batch;
+	size_t i_bank;
+	size_t i_measurement;
+	size_t num_buffers;
+	int status;
+
+	if ((banks == NULL) || (hash == NULL)) {
+		return PCR_INVALID_ARGUMENT;
+	}
+
+	for (first = 0; first < count; first += batch) {
+		batch = min (count - first, PCR_COMPUTE_BANKS_BATCH);
+		i_measurement = 0;
+
+		do {
+			num_buffers = 0;
+
+			for (i_bank = 0; i_bank < batch; i_bank++) {
+				pcr = &banks[first + i_bank];
+				if (pcr->explicit_measurement || (i_measurement >= pcr->num_measurements)) {
+					continue;
+				}
+
+				if (i_measurement == 0) {
+					memset (extend[num_buffers], 0, PCR_DIGEST_LENGTH);
+				}
+				else {
+					memcpy (extend[num_buffers],
+						pcr->measurement_list[i_measurement - 1].measurement, PCR_DIGEST_LENGTH);
+				}
+
+				memcpy (&extend[num_buffers][PCR_DIGEST_LENGTH],
+					pcr->measurement_list[i_measurement].digest, PCR_DIGEST_LENGTH);
+
+				buffers[num_buffers].data = extend[num_buffers];
+				buffers[num_buffers].length = sizeof (extend[num_buffers]);
+				buffers[num_buffers].hash = pcr->measurement_list[i_measurement].measurement;
+				buffers[num_buffers].hash_length = PCR_DIGEST_LENGTH;
+				num_buffers++;
+			}
+
+			if (num_buffers != 0) {
+				status = hash_calculate_sha256_multi (hash, buffers, num_buffers);
+				if (status != 0) {
+					return status;
+				}
+			}
+
+			i_measurement++;
+		} while (num_buffers != 0);
+	}
+
+	return 0;
+}
+
 /**
  * Set the measured data for PCR bank
  *
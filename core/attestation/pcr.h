@@ -115,6 +115,7 @@ int pcr_update_event_type (struct pcr_bank *pcr, uint8_t measurement_index, uint
 int pcr_get_event_type (struct pcr_bank *pcr, uint8_t measurement_index, uint32_t *event_type);
 
 int pcr_compute (struct pcr_bank *pcr, struct hash_engine *hash, uint8_t *measurement, bool lock);
+int pcr_compute_banks (struct pcr_bank *banks, size_t count, struct hash_engine *hash);
 int pcr_get_measurement (struct pcr_bank *pcr, uint8_t measurement_index,
 	struct pcr_measurement *measurement);
 int pcr_get_all_measurements (struct pcr_bank *pcr, const uint8_t **measurement_list);
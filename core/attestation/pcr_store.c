@@ -411,6 +411,22 @@ int pcr_store_get_attestation_log_size (struct pcr_store *store)
 	return (status * sizeof (struct pcr_store_attestation_log_entry));
 }
 
+/**
+ * Release the locks for a range of PCR banks.
+ *
+ * @param store PCR store containing the locked banks.
+ * @param first The first locked bank.
+ * @param end The bank after the last locked bank.
+ */
+static void pcr_store_unlock_banks (struct pcr_store *store, uint8_t first, uint8_t end)
+{
+	uint8_t i_bank;
+
+	for (i_bank = first; i_bank < end; i_bank++) {
+		pcr_unlock (&store->banks[i_bank]);
+	}
+}
+
 /**
  * Generate attestation log from PCR banks.
  *
@@ -433,6 +449,7 @@ int pcr_store_get_attestation_log (struct pcr_store *store, struct hash_engine *
 	uint32_t i_entry = 0;
 	uint8_t i_bank;
 	int starting_measurement;
+	uint8_t locked_end = 0;
 	uint32_t total_log_size = 0;
 	int num_measurements;
 	int i_measurement;
@@ -442,21 +459,43 @@ int pcr_store_get_attestation_log (struct pcr_store *store, struct hash_engine *
 		return PCR_INVALID_ARGUMENT;
 	}
 
-	for (i_bank = 0; i_bank < store->num_pcr_banks; ++i_bank) {
-		status = pcr_lock (&store->banks[i_bank]);
+	if (hash_is_sha256_multi_supported (hash)) {
+		/* Lock every bank up front so the measurements for all banks can be computed together.
+		 * Each bank is still unlocked as soon as its log entries have been generated. */
+		for (locked_end = 0; locked_end < store->num_pcr_banks; locked_end++) {
+			status = pcr_lock (&store->banks[locked_end]);
+			if (status != 0) {
+				pcr_store_unlock_banks (store, 0, locked_end);
+				return status;
+			}
+		}
+
+		status = pcr_compute_banks (store->banks, store->num_pcr_banks, hash);
 		if (status != 0) {
+			pcr_store_unlock_banks (store, 0, locked_end);
 			return status;
 		}
+	}
 
-		status = pcr_compute (&store->banks[i_bank], hash, NULL, false);
-		if (ROT_IS_ERROR (status)) {
-			pcr_unlock (&store->banks[i_bank]);
-			return status;
+	for (i_bank = 0; i_bank < store->num_pcr_banks; ++i_bank) {
+		if (i_bank >= locked_end) {
+			status = pcr_lock (&store->banks[i_bank]);
+			if (status != 0) {
+				return status;
+			}
+
+			locked_end = i_bank + 1;
+
+			status = pcr_compute (&store->banks[i_bank], hash, NULL, false);
+			if (ROT_IS_ERROR (status)) {
+				pcr_unlock (&store->banks[i_bank]);
+				return status;
+			}
 		}
 
 		num_measurements = pcr_get_num_measurements (&store->banks[i_bank]);
 		if (ROT_IS_ERROR (num_measurements)) {
-			pcr_unlock (&store->banks[i_bank]);
+			pcr_store_unlock_banks (store, i_bank, locked_end);
 			return num_measurements;
 		}
 
@@ -468,7 +507,7 @@ int pcr_store_get_attestation_log (struct pcr_store *store, struct hash_engine *
 		num_measurements = pcr_get_all_measurements (&store->banks[i_bank],
 			(const uint8_t**) &measurements);
 		if (ROT_IS_ERROR (num_measurements)) {
-			pcr_unlock (&store->banks[i_bank]);
+			pcr_store_unlock_banks (store, i_bank, locked_end);
 			return num_measurements;
 		}
 
@@ -521,7 +560,7 @@ int pcr_store_get_attestation_log (struct pcr_store *store, struct hash_engine *
 
 			contents_offset += entry_length;
 			if (contents_offset >= length) {
-				pcr_unlock (&store->banks[i_bank]);
+				pcr_store_unlock_banks (store, i_bank, locked_end);
 				return contents_offset;
 			}
 
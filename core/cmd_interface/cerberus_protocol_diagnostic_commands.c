@@ -36,3 +36,67 @@ int cerberus_protocol_heap_stats (const struct cmd_device *device,
 	return CMD_HANDLER_UNSUPPORTED_COMMAND;
 #endif
 }
+
+/**
+ * Process request to configure the severity threshold used by the debug log filter.  The current
+ * filter counters are also reported.
+ *
+ * @param filter The debug log filter to configure.
+ * @param request Debug log filter request to process.
+ *
+ * @return 0 if request completed successfully or an error code.
+ */
+int cerberus_protocol_debug_log_filter (const struct debug_log_filter *filter,
+	struct cmd_interface_msg *request)
+{
+#ifdef CMD_ENABLE_DEBUG_LOG_FILTER
+	struct cerberus_protocol_debug_log_filter *rq =
+		(struct cerberus_protocol_debug_log_filter*) request->data;
+	struct cerberus_protocol_debug_log_filter_response *rsp =
+		(struct cerberus_protocol_debug_log_filter_response*) request->data;
+	struct debug_log_filter_stats stats;
+	int threshold;
+	int status;
+
+	if (request->length != sizeof (struct cerberus_protocol_debug_log_filter)) {
+		return CMD_HANDLER_BAD_LENGTH;
+	}
+
+	if (filter == NULL) {
+		return CMD_HANDLER_UNSUPPORTED_COMMAND;
+	}
+
+	if (rq->threshold != CERBERUS_PROTOCOL_DEBUG_LOG_FILTER_QUERY) {
+		if (rq->threshold > DEBUG_LOG_FILTER_LOG_ALL) {
+			return CMD_HANDLER_OUT_OF_RANGE;
+		}
+
+		status = debug_log_filter_set_threshold (filter, rq->component, rq->threshold);
+		if (status != 0) {
+			return status;
+		}
+	}
+
+	threshold = debug_log_filter_get_threshold (filter, rq->component);
+	if (ROT_IS_ERROR (threshold)) {
+		return threshold;
+	}
+
+	status = debug_log_filter_get_stats (filter, &stats);
+	if (status != 0) {
+		return status;
+	}
+
+	rsp->threshold = threshold;
+	rsp->filtered = stats.filtered;
+	rsp->suppressed = stats.suppressed;
+
+	request->length = sizeof (struct cerberus_protocol_debug_log_filter_response);
+	return 0;
+#else
+	UNUSED (filter);
+	UNUSED (request);
+
+	return CMD_HANDLER_UNSUPPORTED_COMMAND;
+#endif
+}
@@ -7,6 +7,7 @@
 #include "cmd_interface/cerberus_protocol.h"
 #include "cmd_interface/cmd_device.h"
 #include "cmd_interface/cmd_interface.h"
+#include "logging/debug_log_filter.h"
 
 
 #pragma pack(push, 1)
@@ -24,11 +25,38 @@ struct cerberus_protocol_heap_stats_response {
 	struct cerberus_protocol_header header;					/**< Message header */
 	struct cmd_device_heap_stats heap;						/**< Current heap statistics */
 };
+
+/**
+ * Cerberus protocol debug log filter diagnostic request format
+ */
+struct cerberus_protocol_debug_log_filter {
+	struct cerberus_protocol_header header;					/**< Message header */
+	uint8_t component;										/**< Component ID to configure */
+	uint8_t threshold;										/**< New severity threshold for the component */
+};
+
+/**
+ * Threshold value in a debug log filter request that will not change the current threshold.
+ */
+#define	CERBERUS_PROTOCOL_DEBUG_LOG_FILTER_QUERY			0xff
+
+/**
+ * Cerberus protocol debug log filter diagnostic response format
+ */
+struct cerberus_protocol_debug_log_filter_response {
+	struct cerberus_protocol_header header;					/**< Message header */
+	uint8_t component;										/**< Component ID that was configured */
+	uint8_t threshold;										/**< Current severity threshold for the component */
+	uint32_t filtered;										/**< Total entries dropped by severity thresholds */
+	uint32_t suppressed;									/**< Total entries dropped by rate limiting */
+};
 #pragma pack(pop)
 
 
 int cerberus_protocol_heap_stats (const struct cmd_device *device,
 	struct cmd_interface_msg *request);
+int cerberus_protocol_debug_log_filter (const struct debug_log_filter *filter,
+	struct cmd_interface_msg *request);
 
 
 #endif /* CERBERUS_PROTOCOL_DIAGNOSTIC_COMMANDS_H_ */
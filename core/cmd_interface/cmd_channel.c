@@ -98,6 +98,9 @@ int cmd_channel_validate_packet_for_send (const struct cmd_packet *packet)
  * be interrupted by a different sequence of packets.  This ensures no interleaving of different
  * messages over the channel.
  *
+ * If the channel supports sending multiple packets at once, all packets will be passed to the
+ * channel in a single call.  Otherwise, each packet is sent individually.
+ *
  * @param channel The channel to send the packets on.
  * @param message The message container with the packets that should be sent.
  * @param packet A packet buffer to use for sending the packets.  Once access to the channel is
@@ -117,22 +120,27 @@ static int cmd_channel_send_packets (struct cmd_channel *channel, struct cmd_mes
 	platform_mutex_lock (&channel->lock);
 
 	if (!packet->timeout_valid || !platform_has_timeout_expired (&packet->pkt_timeout)) {
-		pkt_pos = message->data;
-		msg_len = message->msg_size;
+		if ((channel->send_packets != NULL) && (message->msg_size != 0)) {
+			status = channel->send_packets (channel, message);
+		}
+		else {
+			pkt_pos = message->data;
+			msg_len = message->msg_size;
 
-		memset (packet, 0, sizeof (*packet));
-		packet->state = CMD_VALID_PACKET;
-		packet->dest_addr = message->dest_addr;
+			memset (packet, 0, sizeof (*packet));
+			packet->state = CMD_VALID_PACKET;
+			packet->dest_addr = message->dest_addr;
 
-		while ((msg_len > 0) && (status == 0)) {
-			pkt_len = min (message->pkt_size, msg_len);
-			memcpy (packet->data, pkt_pos, pkt_len);
+			while ((msg_len > 0) && (status == 0)) {
+				pkt_len = min (message->pkt_size, msg_len);
+				memcpy (packet->data, pkt_pos, pkt_len);
 
-			packet->pkt_size = pkt_len;
-			status = channel->send_packet (channel, packet);
+				packet->pkt_size = pkt_len;
+				status = channel->send_packet (channel, packet);
 
-			pkt_pos += pkt_len;
-			msg_len -= pkt_len;
+				pkt_pos += pkt_len;
+				msg_len -= pkt_len;
+			}
 		}
 	}
 	else {
@@ -142,6 +150,7 @@ static int cmd_channel_send_packets (struct cmd_channel *channel, struct cmd_mes
 	platform_mutex_unlock (&channel->lock);
 	return status;
 }
+
 /**
  * Receive a single packet from the command channel and process it.  Errors will be logged.
  *
@@ -247,3 +256,50 @@ int cmd_channel_send_message (struct cmd_channel *channel, struct cmd_message *m
 	packet.timeout_valid = false;
 	return cmd_channel_send_packets (channel, message, &packet);
 }
+
+/**
+ * Get the number of packets contained in a packetized message.
+ *
+ * @param message The message to query.
+ *
+ * @return The number of packets in the message.
+ */
+size_t cmd_channel_get_packet_count (const struct cmd_message *message)
+{
+	if ((message == NULL) || (message->pkt_size == 0)) {
+		return 0;
+	}
+
+	return (message->msg_size + message->pkt_size - 1) / message->pkt_size;
+}
+
+/**
+ * Get the location of a single packet within a packetized message.
+ *
+ * @param message The message that contains the packet.
+ * @param index Index of the packet in the message.
+ * @param packet Output for the start of the packet data.
+ * @param length Output for the length of the packet.
+ *
+ * @return 0 if the packet was found or an error code.
+ */
+int cmd_channel_get_packet (const struct cmd_message *message, size_t index,
+	const uint8_t **packet, size_t *length)
+{
+	size_t offset;
+
+	if ((message == NULL) || (packet == NULL) || (length == NULL)) {
+		return CMD_CHANNEL_INVALID_ARGUMENT;
+	}
+
+	if (index >= cmd_channel_get_packet_count (message)) {
+		return CMD_CHANNEL_INVALID_ARGUMENT;
+	}
+
+	offset = index * message->pkt_size;
+
+	*packet = &message->data[offset];
+	*length = min (message->pkt_size, message->msg_size - offset);
+
+	return 0;
+}
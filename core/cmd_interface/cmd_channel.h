@@ -43,6 +43,9 @@ struct cmd_packet {
 
 /**
  * Information for a single command message.
+ *
+ * The message data is a contiguous array of packets.  Every packet is the same size, except for
+ * the last packet, which contains the remaining message data.
  */
 struct cmd_message {
 	uint8_t *data;						/**< Buffer for the message data. */
@@ -89,6 +92,26 @@ struct cmd_channel {
 	 */
 	int (*send_packet) (struct cmd_channel *channel, struct cmd_packet *packet);
 
+	/**
+	 * Send all packets for a message over a communication channel in a single operation.  This
+	 * allows channels that can queue multiple packets, such as DMA-capable drivers, to avoid a
+	 * round trip for each packet in the message.
+	 *
+	 * This is optional and can be set to null.  If it is not provided, each packet in the message
+	 * will be copied and sent separately using send_packet.
+	 *
+	 * Packets in the message buffer must be sent in order without modification.  Use
+	 * {@link cmd_channel_get_packet_count} and {@link cmd_channel_get_packet} to find the packets
+	 * in the message.  The same postconditions as send_packet apply to the last packet sent.
+	 *
+	 * @param channel The channel to send the packets on.
+	 * @param message The packetized message to send.  This will never be null and will always
+	 * contain at least one packet.
+	 *
+	 * @return 0 if all packets were successfully sent or an error code.
+	 */
+	int (*send_packets) (struct cmd_channel *channel, const struct cmd_message *message);
+
 	int id;					/**< ID for the command channel. */
 	bool overflow;			/**< Flag if the channel is in an overflow condition. */
 	platform_mutex lock;	/**< Synchronization for message transmission. */
@@ -102,6 +125,10 @@ int cmd_channel_receive_and_process (struct cmd_channel *channel, struct mctp_in
 	int ms_timeout);
 int cmd_channel_send_message (struct cmd_channel *channel, struct cmd_message *message);
 
+size_t cmd_channel_get_packet_count (const struct cmd_message *message);
+int cmd_channel_get_packet (const struct cmd_message *message, size_t index,
+	const uint8_t **packet, size_t *length);
+
 /* Internal functions for use by derived types. */
 int cmd_channel_init (struct cmd_channel *channel, int id);
 void cmd_channel_release (struct cmd_channel *channel);
@@ -243,6 +243,11 @@ int cmd_interface_system_process_request (struct cmd_interface *intf,
 			return cerberus_protocol_heap_stats (interface->cmd_device, request);
 #endif
 
+#ifdef CMD_ENABLE_DEBUG_LOG_FILTER
+		case CERBERUS_PROTOCOL_DIAG_DEBUG_LOG_FILTER:
+			return cerberus_protocol_debug_log_filter (debug_log_filter, request);
+#endif
+
 #ifdef CMD_SUPPORT_ENCRYPTED_SESSIONS
 		case CERBERUS_PROTOCOL_EXCHANGE_KEYS:
 			status = cerberus_protocol_key_exchange (interface->base.session, request,
@@ -32,6 +32,22 @@ int observable_init (struct observable *observable)
 	return 0;
 }
 
+/**
+ * Free a list of observer entries.
+ *
+ * @param head The first entry in the list.
+ */
+static void observable_free_list (struct observable_observer *head)
+{
+	struct observable_observer *temp;
+
+	while (head) {
+		temp = head;
+		head = head->next;
+		platform_free (temp);
+	}
+}
+
 /**
  * Release the resources used by an observer manager.
  *
@@ -42,12 +58,112 @@ void observable_release (struct observable *observable)
 	if (observable) {
 		platform_mutex_free (&observable->lock);
 
-		while (observable->observer_head) {
-			struct observable_observer *temp = observable->observer_head;
-			observable->observer_head = observable->observer_head->next;
-			platform_free (temp);
+		observable_free_list (observable->observer_head);
+		observable_free_list (observable->retired);
+
+		platform_free (observable->snapshot[0].entries);
+		platform_free (observable->snapshot[1].entries);
+	}
+}
+
+/**
+ * Wait for all notifications using a snapshot to complete.  The wait is limited, since the snapshot
+ * will never be released if the update is being made from an observer handling a notification.
+ *
+ * @param observable The observable being updated.
+ * @param index Index of the snapshot to wait for.
+ *
+ * @return 0 if no notifications are using the snapshot or OBSERVABLE_NOTIFICATION_BUSY if the
+ * notifications did not complete in time.
+ */
+static int observable_wait_for_readers (struct observable *observable, uint32_t index)
+{
+	platform_clock timeout;
+	int status;
+
+	status = platform_init_timeout (OBSERVABLE_UPDATE_WAIT_MS, &timeout);
+	if (status != 0) {
+		return status;
+	}
+
+	/* Use an atomic exchange to check for readers.  This ensures any notification that starts after
+	 * the check will see the most recent active snapshot and not start using this one. */
+	while (!platform_atomic_compare_exchange (&observable->readers[index], 0, 0)) {
+		if (platform_has_timeout_expired (&timeout) != 0) {
+			return OBSERVABLE_NOTIFICATION_BUSY;
 		}
+
+		platform_msleep (1);
 	}
+
+	return 0;
+}
+
+/**
+ * Get the inactive snapshot ready to be updated.  This will wait for any notifications still using
+ * the snapshot to complete.  Once there are no notifications using the snapshot, removed observers
+ * are no longer referenced by either snapshot and can be freed.
+ *
+ * This must be called while holding the observable lock.
+ *
+ * @param observable The observable being updated.
+ * @param count The number of observers that will be in the updated snapshot.
+ *
+ * @return Index of the snapshot to update or an error code.  Use ROT_IS_ERROR to check the return
+ * value.
+ */
+static int observable_prepare_snapshot (struct observable *observable, size_t count)
+{
+	struct observable_snapshot *snapshot;
+	struct observable_observer **entries;
+	uint32_t next = !platform_atomic_load (&observable->active);
+	int status;
+
+	status = observable_wait_for_readers (observable, next);
+	if (status != 0) {
+		return status;
+	}
+
+	observable_free_list (observable->retired);
+	observable->retired = NULL;
+
+	snapshot = &observable->snapshot[next];
+	if (count > snapshot->capacity) {
+		entries = platform_malloc (sizeof (struct observable_observer*) * count);
+		if (entries == NULL) {
+			return OBSERVABLE_NO_MEMORY;
+		}
+
+		platform_free (snapshot->entries);
+		snapshot->entries = entries;
+		snapshot->capacity = count;
+	}
+
+	return next;
+}
+
+/**
+ * Fill a snapshot from the list of registered observers and make it the active snapshot for
+ * notifications.
+ *
+ * This must be called while holding the observable lock.
+ *
+ * @param observable The observable being updated.
+ * @param index Index of the snapshot to publish.
+ */
+static void observable_publish_snapshot (struct observable *observable, int index)
+{
+	struct observable_snapshot *snapshot = &observable->snapshot[index];
+	struct observable_observer *pos;
+
+	snapshot->count = 0;
+	pos = observable->observer_head;
+	while (pos) {
+		snapshot->entries[snapshot->count++] = pos;
+		pos = pos->next;
+	}
+
+	platform_atomic_store (&observable->active, index);
 }
 
 /**
@@ -65,12 +181,16 @@ void observable_release (struct observable *observable)
  * @param observer The observer to add.
  *
  * @return 0 if the observer was added for notifications or an error code.
+ * OBSERVABLE_NOTIFICATION_BUSY indicates a notification in progress prevented the update, which can
+ * happen when called from an observer that is handling a notification.
  */
 int observable_add_observer (struct observable *observable, void *observer)
 {
 	struct observable_observer *entry;
 	struct observable_observer *pos;
-	struct observable_observer *prev;
+	struct observable_observer *prev = NULL;
+	size_t count = 1;
+	int index;
 
 	if ((observable == NULL) || (observer == NULL)) {
 		return OBSERVABLE_INVALID_ARGUMENT;
@@ -81,31 +201,42 @@ int observable_add_observer (struct observable *observable, void *observer)
 		return OBSERVABLE_NO_MEMORY;
 	}
 
+	memset (entry, 0, sizeof (struct observable_observer));
 	entry->observer = observer;
-	entry->next = NULL;
 
 	platform_mutex_lock (&observable->lock);
 
-	if (!observable->observer_head) {
+	pos = observable->observer_head;
+	while (pos) {
+		if (observer == pos->observer) {
+			platform_mutex_unlock (&observable->lock);
+			platform_free (entry);
+
+			return 0;
+		}
+
+		prev = pos;
+		pos = pos->next;
+		count++;
+	}
+
+	index = observable_prepare_snapshot (observable, count);
+	if (ROT_IS_ERROR (index)) {
+		platform_mutex_unlock (&observable->lock);
+		platform_free (entry);
+
+		return index;
+	}
+
+	if (prev == NULL) {
 		observable->observer_head = entry;
 	}
 	else {
-		pos = observable->observer_head;
-		while (pos) {
-			if (observer == pos->observer) {
-				platform_free (entry);
-				break;
-			}
-
-			prev = pos;
-			pos = pos->next;
-		}
-
-		if (!pos) {
-			prev->next = entry;
-		}
+		prev->next = entry;
 	}
 
+	observable_publish_snapshot (observable, index);
+
 	platform_mutex_unlock (&observable->lock);
 
 	return 0;
@@ -114,15 +245,25 @@ int observable_add_observer (struct observable *observable, void *observer)
 /**
  * Remove an observer so it will no longer be notified of events.
  *
+ * A notification that is in progress when the observer is removed may still be sent to the
+ * observer, so this waits for those notifications to complete.  Once this returns successfully, the
+ * observer will not be called again and can be released.
+ *
  * @param observable The observable module to update.
  * @param observer The observer to remove.
  *
- * @return 0 if the observer was removed from future notifications or an error code.
+ * @return 0 if the observer was removed or an error code.  OBSERVABLE_NOTIFICATION_BUSY indicates
+ * the observer could not be removed.  OBSERVABLE_OBSERVER_IN_USE indicates the observer has been
+ * removed from future notifications, but a notification in progress may still call it, so the
+ * observer must not be released.  These errors are reported when called from an observer that is
+ * handling a notification.
  */
 int observable_remove_observer (struct observable *observable, void *observer)
 {
 	struct observable_observer *pos;
 	struct observable_observer *prev;
+	int index;
+	int status = 0;
 
 	if ((observable == NULL) || (observer == NULL)) {
 		return OBSERVABLE_INVALID_ARGUMENT;
@@ -132,26 +273,105 @@ int observable_remove_observer (struct observable *observable, void *observer)
 
 	pos = observable->observer_head;
 	prev = NULL;
-	while (pos) {
-		if (pos->observer == observer) {
-			if (prev == NULL) {
-				observable->observer_head = pos->next;
-			}
-			else {
-				prev->next = pos->next;
-			}
+	while (pos && (pos->observer != observer)) {
+		prev = pos;
+		pos = pos->next;
+	}
 
-			platform_free (pos);
-			break;
+	if (pos) {
+		index = observable_prepare_snapshot (observable, 0);
+		if (ROT_IS_ERROR (index)) {
+			platform_mutex_unlock (&observable->lock);
+			return index;
 		}
 
-		prev = pos;
-		pos = pos->next;
+		if (prev == NULL) {
+			observable->observer_head = pos->next;
+		}
+		else {
+			prev->next = pos->next;
+		}
+
+		observable_publish_snapshot (observable, index);
+
+		/* The entry is still referenced by the previous snapshot.  If notifications using that
+		 * snapshot don't complete, the entry will be freed during the next update instead. */
+		if (observable_wait_for_readers (observable, !index) == 0) {
+			platform_free (pos);
+		}
+		else {
+			pos->next = observable->retired;
+			observable->retired = pos;
+			status = OBSERVABLE_OBSERVER_IN_USE;
+		}
 	}
 
 	platform_mutex_unlock (&observable->lock);
 
-	return 0;
+	return status;
+}
+
+/**
+ * Start using the active snapshot for notification.
+ *
+ * @param observable The observable sending the notification.
+ *
+ * @return Index of the snapshot to use.
+ */
+static uint32_t observable_enter_snapshot (struct observable *observable)
+{
+	uint32_t index;
+
+	/* Check that the snapshot is still active after marking it as being used.  If it's not, an
+	 * update may have already started to modify it, so try again with the new active snapshot. */
+	do {
+		index = platform_atomic_load (&observable->active);
+		platform_atomic_fetch_add (&observable->readers[index], 1);
+
+		if (platform_atomic_load (&observable->active) == index) {
+			break;
+		}
+
+		platform_atomic_fetch_add (&observable->readers[index], -1);
+	} while (1);
+
+	return index;
+}
+
+/**
+ * Indicate that notification has finished using a snapshot.
+ *
+ * @param observable The observable that sent the notification.
+ * @param index Index of the snapshot that was used.
+ */
+static void observable_exit_snapshot (struct observable *observable, uint32_t index)
+{
+	platform_atomic_fetch_add (&observable->readers[index], -1);
+}
+
+/**
+ * Update the timing information for an observer after a notification.
+ *
+ * @param entry The observer that was notified.
+ * @param start The time the notification started.
+ */
+static void observable_record_timing (struct observable_observer *entry,
+	const platform_clock *start)
+{
+	platform_clock end;
+	uint32_t duration;
+	uint32_t max;
+
+	platform_init_current_tick (&end);
+	duration = platform_get_duration (start, &end);
+
+	platform_atomic_fetch_add (&entry->notifications, 1);
+	platform_atomic_fetch_add (&entry->total_ms, duration);
+
+	max = platform_atomic_load (&entry->max_ms);
+	while ((duration > max) && !platform_atomic_compare_exchange (&entry->max_ms, max, duration)) {
+		max = platform_atomic_load (&entry->max_ms);
+	}
 }
 
 /**
@@ -165,24 +385,38 @@ int observable_remove_observer (struct observable *observable, void *observer)
  */
 #define	FOR_EACH_OBSERVER(observable, type, notify, ...) \
 	do { \
-		struct observable_observer *pos; \
+		struct observable_snapshot *snapshot; \
+		struct observable_observer *entry; \
+		platform_clock start; \
+		uint32_t timing; \
+		uint32_t index; \
+		size_t i; \
 		\
 		if (observable == NULL) { \
 			return OBSERVABLE_INVALID_ARGUMENT; \
 		} \
 		\
-		platform_mutex_lock (&observable->lock); \
+		index = observable_enter_snapshot (observable); \
+		snapshot = &observable->snapshot[index]; \
+		timing = platform_atomic_load (&observable->timing); \
 		\
-		pos = observable->observer_head; \
-		while (pos) { \
-			notify = (type) (*((uintptr_t*) ((uintptr_t) pos->observer + callback_offset))); \
+		for (i = 0; i < snapshot->count; i++) { \
+			entry = snapshot->entries[i]; \
+			notify = (type) (*((uintptr_t*) ((uintptr_t) entry->observer + callback_offset))); \
 			if (notify) { \
-				notify (pos->__VA_ARGS__); \
+				if (timing) { \
+					platform_init_current_tick (&start); \
+				} \
+				\
+				notify (entry->__VA_ARGS__); \
+				\
+				if (timing) { \
+					observable_record_timing (entry, &start); \
+				} \
 			} \
-			pos = pos->next; \
 		} \
 		\
-		platform_mutex_unlock (&observable->lock); \
+		observable_exit_snapshot (observable, index); \
 		\
 		return 0; \
 	} while (0)
@@ -220,3 +454,58 @@ int observable_notify_observers_with_ptr (struct observable *observable, size_t
 
 	FOR_EACH_OBSERVER (observable, void (*) (void*, void*), notify, observer, arg);
 }
+
+/**
+ * Enable or disable timing of observer notifications.  Timing adds overhead to every notification,
+ * so it should only be enabled when investigating slow observers.
+ *
+ * @param observable The observable to configure.
+ * @param enable true to time each notification callback or false to stop timing.
+ */
+void observable_enable_timing (struct observable *observable, bool enable)
+{
+	if (observable) {
+		platform_atomic_store (&observable->timing, enable);
+	}
+}
+
+/**
+ * Get the timing information for notifications sent to an observer.  Only notifications sent
+ * while timing was enabled are included.
+ *
+ * @param observable The observable to query.
+ * @param observer The observer to get timing information for.
+ * @param stats Output for the observer timing information.
+ *
+ * @return 0 if the timing information was retrieved or an error code.
+ */
+int observable_get_observer_stats (struct observable *observable, void *observer,
+	struct observable_observer_stats *stats)
+{
+	struct observable_observer *pos;
+	int status = OBSERVABLE_UNKNOWN_OBSERVER;
+
+	if ((observable == NULL) || (observer == NULL) || (stats == NULL)) {
+		return OBSERVABLE_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&observable->lock);
+
+	pos = observable->observer_head;
+	while (pos) {
+		if (pos->observer == observer) {
+			stats->notifications = platform_atomic_load (&pos->notifications);
+			stats->total_ms = platform_atomic_load (&pos->total_ms);
+			stats->max_ms = platform_atomic_load (&pos->max_ms);
+
+			status = 0;
+			break;
+		}
+
+		pos = pos->next;
+	}
+
+	platform_mutex_unlock (&observable->lock);
+
+	return status;
+}
@@ -4,26 +4,75 @@
 #ifndef OBSERVABLE_H_
 #define OBSERVABLE_H_
 
+#include <stdint.h>
 #include <stddef.h>
+#include <stdbool.h>
 #include "status/rot_status.h"
 #include "platform_api.h"
 
 
+/**
+ * The maximum amount of time, in milliseconds, that adding or removing an observer will wait for
+ * notifications in progress to complete.
+ */
+#ifndef OBSERVABLE_UPDATE_WAIT_MS
+#define	OBSERVABLE_UPDATE_WAIT_MS		1000
+#endif
+
+
+/**
+ * Timing information for the notifications sent to a single observer.
+ */
+struct observable_observer_stats {
+	uint32_t notifications;				/**< Number of notifications that were timed. */
+	uint32_t total_ms;					/**< Total time spent in notification callbacks. */
+	uint32_t max_ms;					/**< The longest time spent in a single callback. */
+};
+
 /**
  * A single observer in the observers list.
  */
 struct observable_observer {
 	void *observer;						/**< The registered observer. */
 	struct observable_observer *next;	/**< The next entry in the list. */
+	volatile uint32_t notifications;	/**< Number of timed notifications for the observer. */
+	volatile uint32_t total_ms;			/**< Total time spent in timed notifications. */
+	volatile uint32_t max_ms;			/**< The longest time spent in a timed notification. */
+};
+
+/**
+ * An immutable view of the registered observers used during notification.
+ */
+struct observable_snapshot {
+	struct observable_observer **entries;	/**< The observers to notify. */
+	size_t count;							/**< The number of observers in the snapshot. */
+	size_t capacity;						/**< The number of entries that have been allocated. */
 };
 
 
 /**
  * Manager for observer registration and notification.
+ *
+ * Notifications do not take any locks.  Two snapshots of the observer list are maintained.  Events
+ * are sent to the observers in the active snapshot, while changes to the registered observers are
+ * applied to the inactive snapshot, which is then made active.  Before an inactive snapshot is
+ * modified, any notifications still using it must complete.  Removing an observer also waits for
+ * notifications using the previous snapshot to complete, so the observer will not be called after
+ * it has been removed.  This means that adding or removing an observer may need to wait for a
+ * notification, but a notification never waits for anything.
+ *
+ * An observer that adds or removes observers while handling a notification is itself a notification
+ * that would need to complete.  The wait for notifications is limited to OBSERVABLE_UPDATE_WAIT_MS
+ * to detect this, in which case the update will fail.
  */
 struct observable {
-	platform_mutex lock;						/**< Synchronization for the observer list. */
+	platform_mutex lock;						/**< Synchronization for observer registration. */
 	struct observable_observer *observer_head;	/**< Head of the observers list. */
+	struct observable_observer *retired;		/**< Removed observers that may still be in use. */
+	struct observable_snapshot snapshot[2];		/**< Observer lists used for notification. */
+	volatile uint32_t active;					/**< Index of the snapshot used for notification. */
+	volatile uint32_t readers[2];				/**< Number of notifications using each snapshot. */
+	volatile uint32_t timing;					/**< Flag to indicate notifications should be timed. */
 };
 
 
@@ -37,6 +86,10 @@ int observable_notify_observers (struct observable *observable, size_t callback_
 int observable_notify_observers_with_ptr (struct observable *observable, size_t callback_offset,
 	void *arg);
 
+void observable_enable_timing (struct observable *observable, bool enable);
+int observable_get_observer_stats (struct observable *observable, void *observer,
+	struct observable_observer_stats *stats);
+
 
 #define	OBSERVABLE_ERROR(code)		ROT_ERROR (ROT_MODULE_OBSERVABLE, code)
 
@@ -44,8 +97,11 @@ int observable_notify_observers_with_ptr (struct observable *observable, size_t
  * Error codes that can be generated by an observer manager.
  */
 enum {
-	OBSERVABLE_INVALID_ARGUMENT = OBSERVABLE_ERROR (0x00),	/**< Input parameter is null or not valid. */
-	OBSERVABLE_NO_MEMORY = OBSERVABLE_ERROR (0x01),			/**< Memory allocation failed. */
+	OBSERVABLE_INVALID_ARGUMENT = OBSERVABLE_ERROR (0x00),		/**< Input parameter is null or not valid. */
+	OBSERVABLE_NO_MEMORY = OBSERVABLE_ERROR (0x01),				/**< Memory allocation failed. */
+	OBSERVABLE_UNKNOWN_OBSERVER = OBSERVABLE_ERROR (0x02),		/**< The observer is not registered. */
+	OBSERVABLE_NOTIFICATION_BUSY = OBSERVABLE_ERROR (0x03),		/**< A notification in progress prevented the update. */
+	OBSERVABLE_OBSERVER_IN_USE = OBSERVABLE_ERROR (0x04),		/**< The removed observer may still be in use by a notification. */
 };
 
 
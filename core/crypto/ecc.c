@@ -0,0 +1,62 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdlib.h>
+#include <stddef.h>
+#include "ecc.h"
+
+
+/**
+ * Verify a set of ECDSA signatures.  If the ECC engine is able to verify the signatures more
+ * efficiently as a group, it will do so.  Otherwise, each signature will be verified in turn.
+ *
+ * Every entry in the list is checked, even after a failure has been detected.  The result for each
+ * signature is stored in the status field of the entry.
+ *
+ * @param engine The ECC engine to use for signature verification.
+ * @param entries The list of signatures to verify.
+ * @param count The number of entries in the list.
+ *
+ * @return 0 if all signatures are valid, ECC_ENGINE_BAD_SIGNATURE if any signature did not match
+ * its digest, or an error code if any entry could not be checked.  If there are multiple errors,
+ * the first error that was not a bad signature is reported.
+ */
+int ecc_verify_batch (struct ecc_engine *engine, struct ecc_verify_batch_entry *entries,
+	size_t count)
+{
+	size_t i;
+	int status = 0;
+
+	if ((engine == NULL) || ((entries == NULL) && (count != 0))) {
+		return ECC_ENGINE_INVALID_ARGUMENT;
+	}
+
+	if (engine->verify_batch != NULL) {
+		return engine->verify_batch (engine, entries, count);
+	}
+
+	for (i = 0; i < count; i++) {
+		entries[i].status = engine->verify (engine, entries[i].key, entries[i].digest,
+			entries[i].length, entries[i].signature, entries[i].sig_length);
+
+		if ((entries[i].status != 0) &&
+			((status == 0) || (status == ECC_ENGINE_BAD_SIGNATURE))) {
+			status = entries[i].status;
+		}
+	}
+
+	return status;
+}
+
+/**
+ * Determine if an ECC engine is able to verify multiple signatures more efficiently than verifying
+ * each signature individually.
+ *
+ * @param engine The ECC engine to query.
+ *
+ * @return true if the ECC engine supports batch verification or false if not.
+ */
+bool ecc_is_verify_batch_supported (const struct ecc_engine *engine)
+{
+	return ((engine != NULL) && (engine->verify_batch != NULL));
+}
@@ -6,6 +6,7 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include <stdbool.h>
 #include "status/rot_status.h"
 
 
@@ -71,6 +72,18 @@ struct ecc_ecdsa_signature {
 };
 #pragma pack(pop)
 
+/**
+ * A single ECDSA signature to check as part of a batch verification request.
+ */
+struct ecc_verify_batch_entry {
+	struct ecc_public_key *key;				/**< The public key to verify the signature with. */
+	const uint8_t *digest;					/**< The digest to use for signature verification. */
+	size_t length;							/**< The length of the digest. */
+	const uint8_t *signature;				/**< The DER encoded ECDSA signature to verify. */
+	size_t sig_length;						/**< The length of the signature. */
+	int status;								/**< Output for the verification result of this entry. */
+};
+
 /**
  * A platform-independent API for generating and using ECC key pairs.  ECC engine instances are not
  * guaranteed to be thread-safe.
@@ -239,6 +252,24 @@ struct ecc_engine {
 	int (*verify) (struct ecc_engine *engine, struct ecc_public_key *key, const uint8_t *digest,
 		size_t length, const uint8_t *signature, size_t sig_length);
 
+	/**
+	 * Verify a set of ECDSA signatures, sharing work between the signatures where possible.  Each
+	 * entry is checked with the same rules as the single signature verify call, and the result for
+	 * each entry is reported in the status field of that entry.
+	 *
+	 * This is optional and will be null for engines that do not gain anything from verifying
+	 * signatures together.  Use ecc_verify_batch to verify a batch of signatures with any engine.
+	 *
+	 * @param engine The ECC engine to use for signature verification.
+	 * @param entries The list of signatures to verify.
+	 * @param count The number of entries in the list.
+	 *
+	 * @return 0 if all signatures are valid, ECC_ENGINE_BAD_SIGNATURE if any signature did not
+	 * match its digest, or an error code if any entry could not be checked.
+	 */
+	int (*verify_batch) (struct ecc_engine *engine, struct ecc_verify_batch_entry *entries,
+		size_t count);
+
 #ifdef ECC_ENABLE_ECDH
 	/**
 	 * Get the maximum length for an ECDH shared secret generated using a given key.
@@ -270,6 +301,11 @@ struct ecc_engine {
 };
 
 
+int ecc_verify_batch (struct ecc_engine *engine, struct ecc_verify_batch_entry *entries,
+	size_t count);
+bool ecc_is_verify_batch_supported (const struct ecc_engine *engine);
+
+
 #define	ECC_ENGINE_ERROR(code)		ROT_ERROR (ROT_MODULE_ECC_ENGINE, code)
 
 /**
@@ -13,6 +13,7 @@
 #include "mbedtls/ecdsa.h"
 #include "mbedtls/ecdh.h"
 #include "mbedtls/bignum.h"
+#include "mbedtls/asn1.h"
 #include "crypto/crypto_logging.h"
 #include "crypto/hash.h"
 #include "common/unused.h"
@@ -606,6 +607,313 @@ static int ecc_mbedtls_verify (struct ecc_engine *engine, struct ecc_public_key
 	return status;
 }
 
+/**
+ * The maximum number of signatures that will be verified together.  Larger batches are split into
+ * groups of this size.
+ */
+#define	ECC_MBEDTLS_VERIFY_BATCH_MAX		16
+
+/**
+ * Context for a single signature that is being verified as part of a batch.
+ */
+struct ecc_mbedtls_batch_item {
+	struct ecc_verify_batch_entry *entry;	/**< The batch entry being verified. */
+	mbedtls_ecp_keypair *ec;				/**< The public key for the signature. */
+	mbedtls_mpi r;							/**< The r value from the signature. */
+	mbedtls_mpi s;							/**< The s value from the signature. */
+	mbedtls_mpi e;							/**< The digest converted to an integer. */
+};
+
+/**
+ * Convert an mbedTLS error encountered during batch verification to an ECC error code.
+ *
+ * @param status The mbedTLS error code.
+ *
+ * @return The ECC error code.
+ */
+static int ecc_mbedtls_batch_error (int status)
+{
+	debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+		CRYPTO_LOG_MSG_MBEDTLS_PK_VERIFY_EC, status, 0);
+
+	if (status == MBEDTLS_ERR_MPI_ALLOC_FAILED) {
+		return ECC_ENGINE_NO_MEMORY;
+	}
+	else {
+		return ECC_ENGINE_BAD_SIGNATURE;
+	}
+}
+
+/**
+ * Parse a signature in a batch and prepare it for verification.  This applies the same checks as
+ * mbedtls_ecdsa_read_signature, so the signature encoding and digest are handled identically to
+ * single signature verification.
+ *
+ * @param item The batch item to prepare.  The entry and key fields must already be assigned.
+ *
+ * @return 0 if the signature is ready for verification or an error code.
+ */
+static int ecc_mbedtls_batch_prepare (struct ecc_mbedtls_batch_item *item)
+{
+	struct ecc_verify_batch_entry *entry = item->entry;
+	mbedtls_ecp_group *grp = &item->ec->grp;
+	unsigned char *pos = (unsigned char*) entry->signature;
+	const unsigned char *end;
+	size_t seq_length;
+	size_t length;
+	int status;
+
+	end = pos + ecc_der_get_ecdsa_signature_length (entry->signature, entry->sig_length);
+
+	status = mbedtls_asn1_get_tag (&pos, end, &seq_length,
+		MBEDTLS_ASN1_CONSTRUCTED | MBEDTLS_ASN1_SEQUENCE);
+	if ((status != 0) || ((pos + seq_length) != end)) {
+		return ECC_ENGINE_BAD_SIGNATURE;
+	}
+
+	status = mbedtls_asn1_get_mpi (&pos, end, &item->r);
+	if (status == 0) {
+		status = mbedtls_asn1_get_mpi (&pos, end, &item->s);
+	}
+
+	if (status == MBEDTLS_ERR_MPI_ALLOC_FAILED) {
+		return ECC_ENGINE_NO_MEMORY;
+	}
+	else if ((status != 0) || (pos != end)) {
+		return ECC_ENGINE_BAD_SIGNATURE;
+	}
+
+	if ((mbedtls_mpi_cmp_int (&item->r, 1) < 0) ||
+		(mbedtls_mpi_cmp_mpi (&item->r, &grp->N) >= 0) ||
+		(mbedtls_mpi_cmp_int (&item->s, 1) < 0) ||
+		(mbedtls_mpi_cmp_mpi (&item->s, &grp->N) >= 0)) {
+		return ECC_ENGINE_BAD_SIGNATURE;
+	}
+
+	/* Use only the left-most bits of the digest that fit in the curve order. */
+	length = entry->length;
+	if (length > ((grp->nbits + 7) / 8)) {
+		length = (grp->nbits + 7) / 8;
+	}
+
+	status = mbedtls_mpi_read_binary (&item->e, entry->digest, length);
+	if ((status == 0) && ((length * 8) > grp->nbits)) {
+		status = mbedtls_mpi_shift_r (&item->e, (length * 8) - grp->nbits);
+	}
+	if ((status == 0) && (mbedtls_mpi_cmp_mpi (&item->e, &grp->N) >= 0)) {
+		status = mbedtls_mpi_sub_mpi (&item->e, &item->e, &grp->N);
+	}
+
+	if (status != 0) {
+		return ecc_mbedtls_batch_error (status);
+	}
+
+	return 0;
+}
+
+/**
+ * Finish verification of a single signature in a batch.
+ *
+ * @param item The signature to verify.
+ * @param w The inverse of s for the signature.
+ * @param point Temporary point to use for the calculation.
+ *
+ * @return 0 if the signature is valid or an error code.
+ */
+static int ecc_mbedtls_batch_check (struct ecc_mbedtls_batch_item *item, const mbedtls_mpi *w,
+	mbedtls_ecp_point *point)
+{
+	mbedtls_ecp_group *grp = &item->ec->grp;
+	int status;
+
+	/* u1 = e * w is stored in e and u2 = r * w is stored in s. */
+	status = mbedtls_mpi_mul_mpi (&item->e, &item->e, w);
+	if (status == 0) {
+		status = mbedtls_mpi_mod_mpi (&item->e, &item->e, &grp->N);
+	}
+	if (status == 0) {
+		status = mbedtls_mpi_mul_mpi (&item->s, &item->r, w);
+	}
+	if (status == 0) {
+		status = mbedtls_mpi_mod_mpi (&item->s, &item->s, &grp->N);
+	}
+	if (status == 0) {
+		status = mbedtls_ecp_muladd (grp, point, &item->e, &grp->G, &item->s, &item->ec->Q);
+	}
+	if (status != 0) {
+		return ecc_mbedtls_batch_error (status);
+	}
+
+	if (mbedtls_ecp_is_zero (point)) {
+		return ECC_ENGINE_BAD_SIGNATURE;
+	}
+
+	status = mbedtls_mpi_mod_mpi (&point->X, &point->X, &grp->N);
+	if (status != 0) {
+		return ecc_mbedtls_batch_error (status);
+	}
+
+	if (mbedtls_mpi_cmp_mpi (&point->X, &item->r) != 0) {
+		return ECC_ENGINE_BAD_SIGNATURE;
+	}
+
+	return 0;
+}
+
+/**
+ * Verify a group of signatures that all use the same curve.  A single modular inversion is shared
+ * by all signatures in the group.
+ *
+ * @param items The signatures to verify.  The result for each signature will be stored in the
+ * batch entry.
+ * @param count The number of signatures in the group.
+ */
+static void ecc_mbedtls_batch_verify_group (struct ecc_mbedtls_batch_item *items, size_t count)
+{
+	const mbedtls_mpi *order = &items[0].ec->grp.N;
+	mbedtls_mpi acc[ECC_MBEDTLS_VERIFY_BATCH_MAX];
+	mbedtls_mpi inv;
+	mbedtls_ecp_point point;
+	size_t i;
+	int status;
+
+	for (i = 0; i < count; i++) {
+		mbedtls_mpi_init (&acc[i]);
+	}
+	mbedtls_mpi_init (&inv);
+	mbedtls_ecp_point_init (&point);
+
+	/* Accumulate the products of the s values so only one inversion is needed. */
+	status = mbedtls_mpi_copy (&acc[0], &items[0].s);
+	for (i = 1; (i < count) && (status == 0); i++) {
+		status = mbedtls_mpi_mul_mpi (&acc[i], &acc[i - 1], &items[i].s);
+		if (status == 0) {
+			status = mbedtls_mpi_mod_mpi (&acc[i], &acc[i], order);
+		}
+	}
+
+	if (status == 0) {
+		status = mbedtls_mpi_inv_mod (&inv, &acc[count - 1], order);
+	}
+
+	/* Unwind the products to get the inverse of each s value. */
+	for (i = count - 1; (i > 0) && (status == 0); i--) {
+		status = mbedtls_mpi_mul_mpi (&acc[i], &inv, &acc[i - 1]);
+		if (status == 0) {
+			status = mbedtls_mpi_mod_mpi (&acc[i], &acc[i], order);
+		}
+		if (status == 0) {
+			status = mbedtls_mpi_mul_mpi (&inv, &inv, &items[i].s);
+		}
+		if (status == 0) {
+			status = mbedtls_mpi_mod_mpi (&inv, &inv, order);
+		}
+	}
+
+	if (status == 0) {
+		status = mbedtls_mpi_copy (&acc[0], &inv);
+	}
+
+	if (status == 0) {
+		for (i = 0; i < count; i++) {
+			items[i].entry->status = ecc_mbedtls_batch_check (&items[i], &acc[i], &point);
+		}
+	}
+	else {
+		status = ecc_mbedtls_batch_error (status);
+		for (i = 0; i < count; i++) {
+			items[i].entry->status = status;
+		}
+	}
+
+	for (i = 0; i < count; i++) {
+		mbedtls_mpi_free (&acc[i]);
+	}
+	mbedtls_mpi_free (&inv);
+	mbedtls_ecp_point_free (&point);
+}
+
+static int ecc_mbedtls_verify_batch (struct ecc_engine *engine,
+	struct ecc_verify_batch_entry *entries, size_t count)
+{
+	struct ecc_mbedtls_batch_item items[ECC_MBEDTLS_VERIFY_BATCH_MAX];
+	struct ecc_verify_batch_entry *entry;
+	mbedtls_pk_context *pk;
+	mbedtls_ecp_group_id curve;
+	size_t pending;
+	size_t i;
+	size_t j;
+	int status = 0;
+
+	if ((engine == NULL) || ((entries == NULL) && (count != 0))) {
+		return ECC_ENGINE_INVALID_ARGUMENT;
+	}
+
+	for (j = 0; j < ECC_MBEDTLS_VERIFY_BATCH_MAX; j++) {
+		mbedtls_mpi_init (&items[j].r);
+		mbedtls_mpi_init (&items[j].s);
+		mbedtls_mpi_init (&items[j].e);
+	}
+
+	i = 0;
+	while (i < count) {
+		/* Collect consecutive signatures on the same curve.  Any signature that can't be processed
+		 * is failed immediately. */
+		curve = MBEDTLS_ECP_DP_NONE;
+		pending = 0;
+		while ((i < count) && (pending < ECC_MBEDTLS_VERIFY_BATCH_MAX)) {
+			entry = &entries[i];
+			if ((entry->key == NULL) || (entry->digest == NULL) || (entry->signature == NULL) ||
+				(entry->length == 0) || (entry->sig_length == 0)) {
+				entry->status = ECC_ENGINE_INVALID_ARGUMENT;
+				i++;
+				continue;
+			}
+
+			pk = (mbedtls_pk_context*) entry->key->context;
+			if ((pk == NULL) || !mbedtls_pk_can_do (pk, MBEDTLS_PK_ECDSA)) {
+				entry->status = ECC_ENGINE_BAD_SIGNATURE;
+				i++;
+				continue;
+			}
+
+			items[pending].ec = ecc_mbedtls_get_ec_key_pair (entry->key);
+			if (curve == MBEDTLS_ECP_DP_NONE) {
+				curve = items[pending].ec->grp.id;
+			}
+			else if (items[pending].ec->grp.id != curve) {
+				break;
+			}
+
+			items[pending].entry = entry;
+			entry->status = ecc_mbedtls_batch_prepare (&items[pending]);
+			if (entry->status == 0) {
+				pending++;
+			}
+
+			i++;
+		}
+
+		if (pending != 0) {
+			ecc_mbedtls_batch_verify_group (items, pending);
+		}
+	}
+
+	for (j = 0; j < ECC_MBEDTLS_VERIFY_BATCH_MAX; j++) {
+		mbedtls_mpi_free (&items[j].r);
+		mbedtls_mpi_free (&items[j].s);
+		mbedtls_mpi_free (&items[j].e);
+	}
+
+	for (j = 0; j < count; j++) {
+		if ((entries[j].status != 0) && ((status == 0) || (status == ECC_ENGINE_BAD_SIGNATURE))) {
+			status = entries[j].status;
+		}
+	}
+
+	return status;
+}
+
 #ifdef ECC_ENABLE_ECDH
 static int ecc_mbedtls_get_shared_secret_max_length (struct ecc_engine *engine,
 	struct ecc_private_key *key)
@@ -722,6 +1030,7 @@ int ecc_mbedtls_init (struct ecc_engine_mbedtls *engine)
 #endif
 	engine->base.sign = ecc_mbedtls_sign;
 	engine->base.verify = ecc_mbedtls_verify;
+	engine->base.verify_batch = ecc_mbedtls_verify_batch;
 #ifdef ECC_ENABLE_ECDH
 	engine->base.get_shared_secret_max_length = ecc_mbedtls_get_shared_secret_max_length;
 	engine->base.compute_shared_secret = ecc_mbedtls_compute_shared_secret;
@@ -180,6 +180,23 @@ static int ecc_thread_safe_verify (struct ecc_engine *engine, struct ecc_public_
 	return status;
 }
 
+static int ecc_thread_safe_verify_batch (struct ecc_engine *engine,
+	struct ecc_verify_batch_entry *entries, size_t count)
+{
+	struct ecc_engine_thread_safe *ecc = (struct ecc_engine_thread_safe*) engine;
+	int status;
+
+	if (engine == NULL) {
+		return ECC_ENGINE_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&ecc->lock);
+	status = ecc->engine->verify_batch (ecc->engine, entries, count);
+	platform_mutex_unlock (&ecc->lock);
+
+	return status;
+}
+
 #ifdef ECC_ENABLE_ECDH
 static int ecc_thread_safe_get_shared_secret_max_length (struct ecc_engine *engine,
 	struct ecc_private_key *key)
@@ -247,6 +264,12 @@ int ecc_thread_safe_init (struct ecc_engine_thread_safe *engine, struct ecc_engi
 #endif
 	engine->base.sign = ecc_thread_safe_sign;
 	engine->base.verify = ecc_thread_safe_verify;
+
+	/* Batch verification is only exposed if the target engine provides it. */
+	if (ecc_is_verify_batch_supported (target)) {
+		engine->base.verify_batch = ecc_thread_safe_verify_batch;
+	}
+
 #ifdef ECC_ENABLE_ECDH
 	engine->base.get_shared_secret_max_length = ecc_thread_safe_get_shared_secret_max_length;
 	engine->base.compute_shared_secret = ecc_thread_safe_compute_shared_secret;
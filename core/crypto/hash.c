@@ -4,6 +4,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include "hash.h"
+#include "common/buffer_util.h"
 
 
 /**
@@ -189,6 +190,68 @@ bool hash_is_alg_supported (enum hash_type type)
 	}
 }
 
+/**
+ * Determine if a hash engine supports saving and restoring the state of in-progress hash
+ * operations.
+ *
+ * @param engine The hash engine to query.
+ *
+ * @return true if the hash engine can save and restore hash state or false if not.
+ */
+bool hash_is_save_state_supported (const struct hash_engine *engine)
+{
+	return ((engine != NULL) && (engine->save_state != NULL) && (engine->restore_state != NULL));
+}
+
+/**
+ * Calculate the SHA-256 hash for several independent buffers of data.  If the hash engine is able
+ * to hash the buffers in parallel, it will do so.  Otherwise, each buffer will be hashed in turn.
+ *
+ * @param engine The hash engine to use to calculate the hashes.
+ * @param buffers The list of buffers to hash.  The hash for each buffer will be stored in the
+ * output buffer contained in the list entry.
+ * @param count The number of buffers in the list.
+ *
+ * @return 0 if all the hashes were calculated successfully or an error code.
+ */
+int hash_calculate_sha256_multi (struct hash_engine *engine,
+	const struct hash_multi_buffer *buffers, size_t count)
+{
+	size_t i;
+	int status;
+
+	if ((engine == NULL) || ((buffers == NULL) && (count != 0))) {
+		return HASH_ENGINE_INVALID_ARGUMENT;
+	}
+
+	if (engine->calculate_sha256_multi != NULL) {
+		return engine->calculate_sha256_multi (engine, buffers, count);
+	}
+
+	for (i = 0; i < count; i++) {
+		status = engine->calculate_sha256 (engine, buffers[i].data, buffers[i].length,
+			buffers[i].hash, buffers[i].hash_length);
+		if (status != 0) {
+			return status;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * Determine if a hash engine is able to calculate SHA-256 hashes for multiple buffers more
+ * efficiently than hashing each buffer individually.
+ *
+ * @param engine The hash engine to query.
+ *
+ * @return true if the hash engine supports multi-buffer hashing or false if not.
+ */
+bool hash_is_sha256_multi_supported (const struct hash_engine *engine)
+{
+	return ((engine != NULL) && (engine->calculate_sha256_multi != NULL));
+}
+
 /**
  * Generate an HMAC for a block of data.
  *
@@ -233,34 +296,31 @@ fail:
 }
 
 /**
- * Initialize an engine for generating an HMAC.
- *
- * An initialized HMAC engine must be released by either finishing or canceling the operation.
+ * Prepare the key for an HMAC operation.  Keys longer than the block size of the hash algorithm
+ * will be hashed.
  *
- * @param engine The HMAC engine to initialize.
- * @param hash The hash engine to use to generate the HMAC.
+ * @param hash The hash engine to use for hashing the key.
  * @param hash_type The type of hashing algorithm to use.
- * @param key The key to use with the HMAC.
+ * @param key The key to prepare.
  * @param key_length The length of the key.
+ * @param prepared Output for the prepared key.  This must be at least SHA512_BLOCK_SIZE bytes.
+ * @param prepared_length Output for the length of the prepared key.
+ * @param block_size Output for the block size of the hash algorithm.
+ * @param hash_length Output for the digest length of the hash algorithm.
  *
- * @return 0 if the HMAC engine was successfully initialized or an error code.
+ * @return 0 if the key was prepared successfully or an error code.
  */
-int hash_hmac_init (struct hmac_engine *engine, struct hash_engine *hash, enum hmac_hash hash_type,
-	const uint8_t *key, size_t key_length)
+static int hash_hmac_prepare_key (struct hash_engine *hash, enum hmac_hash hash_type,
+	const uint8_t *key, size_t key_length, uint8_t *prepared, size_t *prepared_length,
+	uint8_t *block_size, uint8_t *hash_length)
 {
 	int status;
-	size_t i;
-
-	if ((engine == NULL) || (hash == NULL) || (key == NULL) || (key_length == 0)) {
-		return HASH_ENGINE_INVALID_ARGUMENT;
-	}
 
 	switch (hash_type) {
 		case HMAC_SHA1:
 #ifdef HASH_ENABLE_SHA1
 			if (key_length > SHA1_BLOCK_SIZE) {
-				status = hash->calculate_sha1 (hash, key, key_length, engine->key,
-					sizeof (engine->key));
+				status = hash->calculate_sha1 (hash, key, key_length, prepared, SHA512_BLOCK_SIZE);
 				if (status != 0) {
 					return status;
 				}
@@ -268,11 +328,11 @@ int hash_hmac_init (struct hmac_engine *engine, struct hash_engine *hash, enum h
 				key_length = SHA1_HASH_LENGTH;
 			}
 			else {
-				memcpy (engine->key, key, key_length);
+				memcpy (prepared, key, key_length);
 			}
 
-			engine->block_size = SHA1_BLOCK_SIZE;
-			engine->hash_length = SHA1_HASH_LENGTH;
+			*block_size = SHA1_BLOCK_SIZE;
+			*hash_length = SHA1_HASH_LENGTH;
 			break;
 #else
 			return HASH_ENGINE_UNSUPPORTED_HASH;
@@ -280,8 +340,8 @@ int hash_hmac_init (struct hmac_engine *engine, struct hash_engine *hash, enum h
 
 		case HMAC_SHA256:
 			if (key_length > SHA256_BLOCK_SIZE) {
-				status = hash->calculate_sha256 (hash, key, key_length, engine->key,
-					sizeof (engine->key));
+				status = hash->calculate_sha256 (hash, key, key_length, prepared,
+					SHA512_BLOCK_SIZE);
 				if (status != 0) {
 					return status;
 				}
@@ -289,18 +349,18 @@ int hash_hmac_init (struct hmac_engine *engine, struct hash_engine *hash, enum h
 				key_length = SHA256_HASH_LENGTH;
 			}
 			else {
-				memcpy (engine->key, key, key_length);
+				memcpy (prepared, key, key_length);
 			}
 
-			engine->block_size = SHA256_BLOCK_SIZE;
-			engine->hash_length = SHA256_HASH_LENGTH;
+			*block_size = SHA256_BLOCK_SIZE;
+			*hash_length = SHA256_HASH_LENGTH;
 			break;
 
 		case HMAC_SHA384:
 #ifdef HASH_ENABLE_SHA384
 			if (key_length > SHA384_BLOCK_SIZE) {
-				status = hash->calculate_sha384 (hash, key, key_length, engine->key,
-					sizeof (engine->key));
+				status = hash->calculate_sha384 (hash, key, key_length, prepared,
+					SHA512_BLOCK_SIZE);
 				if (status != 0) {
 					return status;
 				}
@@ -308,11 +368,11 @@ int hash_hmac_init (struct hmac_engine *engine, struct hash_engine *hash, enum h
 				key_length = SHA384_HASH_LENGTH;
 			}
 			else {
-				memcpy (engine->key, key, key_length);
+				memcpy (prepared, key, key_length);
 			}
 
-			engine->block_size = SHA384_BLOCK_SIZE;
-			engine->hash_length = SHA384_HASH_LENGTH;
+			*block_size = SHA384_BLOCK_SIZE;
+			*hash_length = SHA384_HASH_LENGTH;
 			break;
 #else
 			return HASH_ENGINE_UNSUPPORTED_HASH;
@@ -321,8 +381,8 @@ int hash_hmac_init (struct hmac_engine *engine, struct hash_engine *hash, enum h
 		case HMAC_SHA512:
 #ifdef HASH_ENABLE_SHA512
 			if (key_length > SHA512_BLOCK_SIZE) {
-				status = hash->calculate_sha512 (hash, key, key_length, engine->key,
-					sizeof (engine->key));
+				status = hash->calculate_sha512 (hash, key, key_length, prepared,
+					SHA512_BLOCK_SIZE);
 				if (status != 0) {
 					return status;
 				}
@@ -330,11 +390,11 @@ int hash_hmac_init (struct hmac_engine *engine, struct hash_engine *hash, enum h
 				key_length = SHA512_HASH_LENGTH;
 			}
 			else {
-				memcpy (engine->key, key, key_length);
+				memcpy (prepared, key, key_length);
 			}
 
-			engine->block_size = SHA512_BLOCK_SIZE;
-			engine->hash_length = SHA512_HASH_LENGTH;
+			*block_size = SHA512_BLOCK_SIZE;
+			*hash_length = SHA512_HASH_LENGTH;
 			break;
 #else
 			return HASH_ENGINE_UNSUPPORTED_HASH;
@@ -344,38 +404,157 @@ int hash_hmac_init (struct hmac_engine *engine, struct hash_engine *hash, enum h
 			return HASH_ENGINE_UNKNOWN_HASH;
 	}
 
-	status = hash_start_new_hash (hash, (enum hash_type) hash_type);
-	if (status != 0) {
-		return status;
-	}
+	*prepared_length = key_length;
 
-	engine->hash = hash;
-	engine->type = hash_type;
+	return 0;
+}
 
-	/* Transform the key for the inner hash. */
-	for (i = 0; i < engine->block_size; i++) {
+/**
+ * Pad a prepared HMAC key to the block size of the hash algorithm and apply the inner key mask.
+ *
+ * @param key The prepared key to pad.  This must be at least block_size bytes.
+ * @param key_length Length of the prepared key.
+ * @param block_size Block size of the hash algorithm.
+ */
+static void hash_hmac_pad_inner_key (uint8_t *key, size_t key_length, size_t block_size)
+{
+	size_t i;
+
+	for (i = 0; i < block_size; i++) {
 		if (i < key_length) {
-			engine->key[i] ^= 0x36;
+			key[i] ^= 0x36;
 		}
 		else {
-			engine->key[i] = 0x36;
+			key[i] = 0x36;
 		}
 	}
+}
+
+/**
+ * Convert a padded inner HMAC key to the padded outer key.
+ *
+ * @param key The padded inner key to convert.
+ * @param block_size Block size of the hash algorithm.
+ */
+static void hash_hmac_pad_outer_key (uint8_t *key, size_t block_size)
+{
+	size_t i;
+
+	for (i = 0; i < block_size; i++) {
+		key[i] ^= (0x5c ^ 0x36);
+	}
+}
 
-	status = hash->update (hash, engine->key, engine->block_size);
+/**
+ * Start the inner hash for an HMAC operation using the prepared key stored in the HMAC engine.
+ * On success, the engine key will contain the padded outer key.
+ *
+ * @param engine The HMAC engine to start.
+ * @param key_length Length of the prepared key.
+ *
+ * @return 0 if the inner hash was started successfully or an error code.
+ */
+static int hash_hmac_start_inner (struct hmac_engine *engine, size_t key_length)
+{
+	int status;
+
+	status = hash_start_new_hash (engine->hash, (enum hash_type) engine->type);
 	if (status != 0) {
-		hash->cancel (hash);
 		return status;
 	}
 
-	/* We've already hashed the inner key, so transform it for use in the outer hash. */
-	for (i = 0; i < engine->block_size; i++) {
-		engine->key[i] ^= (0x5c ^ 0x36);
+	/* Transform the key for the inner hash. */
+	hash_hmac_pad_inner_key (engine->key, key_length, engine->block_size);
+
+	status = engine->hash->update (engine->hash, engine->key, engine->block_size);
+	if (status != 0) {
+		engine->hash->cancel (engine->hash);
+		return status;
 	}
 
+	/* We've already hashed the inner key, so transform it for use in the outer hash. */
+	hash_hmac_pad_outer_key (engine->key, engine->block_size);
+
 	return 0;
 }
 
+/**
+ * Initialize an engine for generating an HMAC.
+ *
+ * An initialized HMAC engine must be released by either finishing or canceling the operation.
+ *
+ * @param engine The HMAC engine to initialize.
+ * @param hash The hash engine to use to generate the HMAC.
+ * @param hash_type The type of hashing algorithm to use.
+ * @param key The key to use with the HMAC.
+ * @param key_length The length of the key.
+ *
+ * @return 0 if the HMAC engine was successfully initialized or an error code.
+ */
+int hash_hmac_init (struct hmac_engine *engine, struct hash_engine *hash, enum hmac_hash hash_type,
+	const uint8_t *key, size_t key_length)
+{
+	int status;
+
+	if ((engine == NULL) || (hash == NULL) || (key == NULL) || (key_length == 0)) {
+		return HASH_ENGINE_INVALID_ARGUMENT;
+	}
+
+	status = hash_hmac_prepare_key (hash, hash_type, key, key_length, engine->key, &key_length,
+		&engine->block_size, &engine->hash_length);
+	if (status != 0) {
+		return status;
+	}
+
+	engine->hash = hash;
+	engine->type = hash_type;
+	engine->outer = NULL;
+
+	return hash_hmac_start_inner (engine, key_length);
+}
+
+/**
+ * Initialize an engine for generating an HMAC using a prepared HMAC key.  If the padded key hash
+ * states have been saved, the HMAC will resume from the saved states without hashing the key.
+ *
+ * An initialized HMAC engine must be released by either finishing or canceling the operation.
+ *
+ * @param engine The HMAC engine to initialize.
+ * @param keyed The prepared HMAC key to use.  This must not be released until the HMAC operation
+ * has been finished or canceled.
+ *
+ * @return 0 if the HMAC engine was successfully initialized or an error code.
+ */
+int hash_hmac_init_keyed (struct hmac_engine *engine, const struct hmac_keyed_context *keyed)
+{
+	int status;
+
+	if ((engine == NULL) || (keyed == NULL) || (keyed->hash == NULL)) {
+		return HASH_ENGINE_INVALID_ARGUMENT;
+	}
+
+	engine->hash = keyed->hash;
+	engine->type = keyed->type;
+	engine->block_size = keyed->block_size;
+	engine->hash_length = keyed->hash_length;
+
+	if (keyed->has_state) {
+		status = engine->hash->restore_state (engine->hash, &keyed->prepared.pad.inner);
+		if (status != 0) {
+			return status;
+		}
+
+		engine->outer = &keyed->prepared.pad.outer;
+
+		return 0;
+	}
+
+	memcpy (engine->key, keyed->prepared.key.data, keyed->prepared.key.length);
+	engine->outer = NULL;
+
+	return hash_hmac_start_inner (engine, keyed->prepared.key.length);
+}
+
 /**
  * Add message data to the HMAC calculation.
  *
@@ -425,14 +604,22 @@ int hash_hmac_finish (struct hmac_engine *engine, uint8_t *hmac, size_t hmac_len
 		goto fail;
 	}
 
-	status = hash_start_new_hash (engine->hash, (enum hash_type) engine->type);
-	if (status != 0) {
-		goto fail;
+	if (engine->outer != NULL) {
+		status = engine->hash->restore_state (engine->hash, engine->outer);
+		if (status != 0) {
+			goto fail;
+		}
 	}
+	else {
+		status = hash_start_new_hash (engine->hash, (enum hash_type) engine->type);
+		if (status != 0) {
+			goto fail;
+		}
 
-	status = engine->hash->update (engine->hash, engine->key, engine->block_size);
-	if (status != 0) {
-		goto fail;
+		status = engine->hash->update (engine->hash, engine->key, engine->block_size);
+		if (status != 0) {
+			goto fail;
+		}
 	}
 
 	status = engine->hash->update (engine->hash, inner_hash, engine->hash_length);
@@ -463,3 +650,152 @@ void hash_hmac_cancel (struct hmac_engine *engine)
 		engine->hash->cancel (engine->hash);
 	}
 }
+
+/**
+ * Save the hash state after processing a padded HMAC key.
+ *
+ * @param hash The hash engine to use.
+ * @param hash_type The type of hashing algorithm to use.
+ * @param pad The padded key to hash.
+ * @param block_size Length of the padded key.
+ * @param state Output for the saved hash state.
+ *
+ * @return 0 if the hash state was saved successfully or an error code.
+ */
+static int hash_hmac_save_pad_state (struct hash_engine *hash, enum hmac_hash hash_type,
+	const uint8_t *pad, size_t block_size, struct hash_saved_state *state)
+{
+	int status;
+
+	status = hash_start_new_hash (hash, (enum hash_type) hash_type);
+	if (status != 0) {
+		return status;
+	}
+
+	status = hash->update (hash, pad, block_size);
+	if (status == 0) {
+		status = hash->save_state (hash, state);
+	}
+
+	hash->cancel (hash);
+	return status;
+}
+
+/**
+ * Prepare an HMAC key for generating multiple HMACs.  If the hash engine supports saving hash
+ * state, the inner and outer padded keys are hashed once and the resulting hash states are saved.
+ * Each HMAC generated with the prepared key will resume from these states, saving two hash blocks
+ * of processing for every HMAC.
+ *
+ * No hash operation is left active on the hash engine after the key has been prepared.
+ *
+ * @param keyed The keyed context to initialize.
+ * @param hash The hash engine to use to generate the HMACs.
+ * @param hash_type The type of hashing algorithm to use.
+ * @param key The key to use with the HMAC.
+ * @param key_length The length of the key.
+ *
+ * @return 0 if the HMAC key was successfully prepared or an error code.
+ */
+int hash_hmac_keyed_init (struct hmac_keyed_context *keyed, struct hash_engine *hash,
+	enum hmac_hash hash_type, const uint8_t *key, size_t key_length)
+{
+	uint8_t pad[SHA512_BLOCK_SIZE];
+	int status;
+
+	if ((keyed == NULL) || (hash == NULL) || (key == NULL) || (key_length == 0)) {
+		return HASH_ENGINE_INVALID_ARGUMENT;
+	}
+
+	memset (keyed, 0, sizeof (struct hmac_keyed_context));
+
+	status = hash_hmac_prepare_key (hash, hash_type, key, key_length, pad, &key_length,
+		&keyed->block_size, &keyed->hash_length);
+	if (status != 0) {
+		return status;
+	}
+
+	keyed->hash = hash;
+	keyed->type = hash_type;
+
+	if (!hash_is_save_state_supported (hash)) {
+		memcpy (keyed->prepared.key.data, pad, key_length);
+		keyed->prepared.key.length = key_length;
+
+		goto exit;
+	}
+
+	hash_hmac_pad_inner_key (pad, key_length, keyed->block_size);
+
+	status = hash_hmac_save_pad_state (hash, hash_type, pad, keyed->block_size,
+		&keyed->prepared.pad.inner);
+	if (status != 0) {
+		goto exit;
+	}
+
+	hash_hmac_pad_outer_key (pad, keyed->block_size);
+
+	status = hash_hmac_save_pad_state (hash, hash_type, pad, keyed->block_size,
+		&keyed->prepared.pad.outer);
+	if (status != 0) {
+		goto exit;
+	}
+
+	keyed->has_state = true;
+
+exit:
+	buffer_zeroize (pad, sizeof (pad));
+	return status;
+}
+
+/**
+ * Generate an HMAC for a complete set of data using a prepared HMAC key.
+ *
+ * @param keyed The prepared HMAC key to use.
+ * @param data The data to generate an HMAC for.
+ * @param length The length of the data.
+ * @param hmac The output buffer that will hold the HMAC.  It must be the right size for the hashing
+ * algorithm being used.
+ * @param hmac_length The size of the HMAC buffer.
+ *
+ * @return 0 if the HMAC was successfully generated or an error code.
+ */
+int hash_hmac_keyed_generate (const struct hmac_keyed_context *keyed, const uint8_t *data,
+	size_t length, uint8_t *hmac, size_t hmac_length)
+{
+	struct hmac_engine hmac_engine;
+	int status;
+
+	if ((keyed == NULL) || (hmac == NULL)) {
+		return HASH_ENGINE_INVALID_ARGUMENT;
+	}
+
+	if (hmac_length < keyed->hash_length) {
+		return HASH_ENGINE_HASH_BUFFER_TOO_SMALL;
+	}
+
+	status = hash_hmac_init_keyed (&hmac_engine, keyed);
+	if (status != 0) {
+		return status;
+	}
+
+	status = hash_hmac_update (&hmac_engine, data, length);
+	if (status != 0) {
+		hash_hmac_cancel (&hmac_engine);
+		return status;
+	}
+
+	return hash_hmac_finish (&hmac_engine, hmac, hmac_length);
+}
+
+/**
+ * Release a prepared HMAC key.  All key material is cleared from the context.
+ *
+ * @param keyed The prepared HMAC key to release.
+ */
+void hash_hmac_keyed_release (struct hmac_keyed_context *keyed)
+{
+	if (keyed != NULL) {
+		buffer_zeroize (keyed, sizeof (struct hmac_keyed_context));
+	}
+}
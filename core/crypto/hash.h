@@ -51,6 +51,34 @@ enum {
 	HASH_ACTIVE_NONE = 0xff,			/**< No hash context is active. */
 };
 
+/**
+ * Maximum size of the hash context that can be saved from an in-progress hash operation.
+ */
+#define	HASH_SAVED_STATE_MAX_LENGTH		256
+
+/**
+ * The intermediate state of an in-progress hash operation.  A saved state can be used to resume
+ * the hash operation at the point the state was saved.  The contents are specific to the hash
+ * engine that saved the state and can only be restored by the same type of hash engine.
+ *
+ * The context is stored as 64-bit words so engines can store their native context structures
+ * without alignment issues.
+ */
+struct hash_saved_state {
+	uint64_t context[HASH_SAVED_STATE_MAX_LENGTH / sizeof (uint64_t)];	/**< Engine-specific context for the hash. */
+	uint8_t active;						/**< The type of hash that was saved. */
+};
+
+/**
+ * One of several independent buffers to hash as part of a single multi-buffer hash request.
+ */
+struct hash_multi_buffer {
+	const uint8_t *data;				/**< The data to hash. */
+	size_t length;						/**< The length of the data. */
+	uint8_t *hash;						/**< Output buffer for the hash of the data. */
+	size_t hash_length;					/**< The length of the output buffer. */
+};
+
 
 /**
  * A platform-independent API for calculating hashes.  Hash engine instances are not guaranteed to
@@ -203,6 +231,54 @@ struct hash_engine {
 	 * @param engine The hash engine to cancel.
 	 */
 	void (*cancel) (struct hash_engine *engine);
+
+	/**
+	 * Save the intermediate state of the active hash operation.  The hash operation remains active
+	 * and can continue to be updated.  This allows data common to multiple hashes to be processed
+	 * once, with each hash resuming from the saved state.
+	 *
+	 * This is optional and will be null if the hash engine does not support saving hash state.
+	 *
+	 * @param engine The hash engine with the active hash to save.
+	 * @param state Output for the saved hash state.
+	 *
+	 * @return 0 if the hash state was saved successfully or an error code.
+	 */
+	int (*save_state) (struct hash_engine *engine, struct hash_saved_state *state);
+
+	/**
+	 * Start a new hash operation from a previously saved hash state.  The hash will be in the same
+	 * state as when it was saved, and subsequent updates will continue from that point.
+	 *
+	 * Every successful call to restore MUST be followed by either a call to finish or cancel.
+	 *
+	 * This is optional and will be null if the hash engine does not support saving hash state.
+	 *
+	 * @param engine The hash engine to configure.
+	 * @param state The saved hash state to restore.
+	 *
+	 * @return 0 if the hash state was restored successfully or an error code.
+	 */
+	int (*restore_state) (struct hash_engine *engine, const struct hash_saved_state *state);
+
+	/**
+	 * Calculate the SHA-256 hash for several independent buffers of data.  The hash engine may
+	 * process the buffers in parallel, so the order in which the hashes are generated is not
+	 * defined.  No hash can be in progress when this is called.
+	 *
+	 * This is optional and will be null if the hash engine does not provide any benefit over
+	 * hashing each buffer individually.  Use hash_calculate_sha256_multi to hash multiple buffers
+	 * on any engine.
+	 *
+	 * @param engine The hash engine to use to calculate the hashes.
+	 * @param buffers The list of buffers to hash.  The hash for each buffer will be stored in the
+	 * output buffer contained in the list entry.
+	 * @param count The number of buffers in the list.
+	 *
+	 * @return 0 if all the hashes were calculated successfully or an error code.
+	 */
+	int (*calculate_sha256_multi) (struct hash_engine *engine,
+		const struct hash_multi_buffer *buffers, size_t count);
 };
 
 
@@ -214,6 +290,11 @@ int hash_calculate (struct hash_engine *engine, enum hash_type type, const uint8
 int hash_get_hash_length (enum hash_type hash_type);
 
 bool hash_is_alg_supported (enum hash_type type);
+bool hash_is_save_state_supported (const struct hash_engine *engine);
+
+int hash_calculate_sha256_multi (struct hash_engine *engine,
+	const struct hash_multi_buffer *buffers, size_t count);
+bool hash_is_sha256_multi_supported (const struct hash_engine *engine);
 
 
 
@@ -238,6 +319,31 @@ struct hmac_engine {
 	uint8_t key[SHA512_BLOCK_SIZE];		/**< The key for the HMAC operation. */
 	uint8_t block_size;					/**< The block size for the hash algorithm. */
 	uint8_t hash_length;				/**< The digest length for the hash algorithm. */
+	const struct hash_saved_state *outer;	/**< Saved state for the outer hash, if available. */
+};
+
+/**
+ * An HMAC key that has been prepared for generating multiple HMACs.  If the hash engine supports
+ * saving hash state, the states after hashing the inner and outer padded keys are saved so each
+ * HMAC only needs to process the message.  Otherwise, the key is saved so it doesn't need to be
+ * processed again for each HMAC.
+ */
+struct hmac_keyed_context {
+	struct hash_engine *hash;			/**< The hash engine to use when generating HMACs. */
+	enum hmac_hash type;				/**< The type of hash being used for the HMAC. */
+	union {
+		struct {
+			struct hash_saved_state inner;	/**< Hash state after processing the inner padded key. */
+			struct hash_saved_state outer;	/**< Hash state after processing the outer padded key. */
+		} pad;							/**< Saved hash states for the padded keys. */
+		struct {
+			uint8_t data[SHA512_BLOCK_SIZE];	/**< The HMAC key. */
+			size_t length;					/**< Length of the HMAC key. */
+		} key;							/**< The HMAC key, if hash state can't be saved. */
+	} prepared;							/**< The prepared HMAC key. */
+	uint8_t block_size;					/**< The block size for the hash algorithm. */
+	uint8_t hash_length;				/**< The digest length for the hash algorithm. */
+	bool has_state;						/**< Flag indicating the padded key hash states are saved. */
 };
 
 
@@ -246,10 +352,17 @@ int hash_generate_hmac (struct hash_engine *engine, const uint8_t *key, size_t k
 
 int hash_hmac_init (struct hmac_engine *engine, struct hash_engine *hash, enum hmac_hash hash_type,
 	const uint8_t *key, size_t key_length);
+int hash_hmac_init_keyed (struct hmac_engine *engine, const struct hmac_keyed_context *keyed);
 int hash_hmac_update (struct hmac_engine *engine, const uint8_t *data, size_t length);
 int hash_hmac_finish (struct hmac_engine *engine, uint8_t *hmac, size_t hmac_length);
 void hash_hmac_cancel (struct hmac_engine *engine);
 
+int hash_hmac_keyed_init (struct hmac_keyed_context *keyed, struct hash_engine *hash,
+	enum hmac_hash hash_type, const uint8_t *key, size_t key_length);
+int hash_hmac_keyed_generate (const struct hmac_keyed_context *keyed, const uint8_t *data,
+	size_t length, uint8_t *hmac, size_t hmac_length);
+void hash_hmac_keyed_release (struct hmac_keyed_context *keyed);
+
 /**
  * Determine the output length for an HMAC.
  *
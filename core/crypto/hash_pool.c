@@ -0,0 +1,598 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "hash_pool.h"
+
+
+/**
+ * Get a free engine from the pool.  If all engines are in use, this will block until one is
+ * released.
+ *
+ * @param pool The pool to get the engine from.
+ * @param preferred Index of the engine to use if it is free.
+ *
+ * @return Index of the engine that was assigned to the caller.
+ */
+static size_t hash_pool_acquire (const struct hash_pool *pool, size_t preferred)
+{
+	struct hash_pool_state *state = pool->state;
+	platform_clock start;
+	platform_clock now;
+	uint32_t wait_ms;
+	uint32_t in_use;
+	bool waited = false;
+	size_t index;
+	size_t i;
+
+	platform_mutex_lock (&state->lock);
+
+	while (1) {
+		index = pool->count;
+		if ((preferred < pool->count) && !(state->busy & (1U << preferred))) {
+			index = preferred;
+		}
+		else {
+			for (i = 0; i < pool->count; i++) {
+				if (!(state->busy & (1U << i))) {
+					index = i;
+					break;
+				}
+			}
+		}
+
+		if (index < pool->count) {
+			break;
+		}
+
+		if (!waited) {
+			platform_init_current_tick (&start);
+			state->stats.contended++;
+			waited = true;
+		}
+
+		state->waiters++;
+		platform_mutex_unlock (&state->lock);
+
+		platform_semaphore_wait (&state->released, 0);
+
+		platform_mutex_lock (&state->lock);
+		state->waiters--;
+	}
+
+	state->busy |= (1U << index);
+	state->stats.acquired++;
+
+	in_use = 0;
+	for (i = 0; i < pool->count; i++) {
+		if (state->busy & (1U << i)) {
+			in_use++;
+		}
+	}
+	if (in_use > state->stats.max_in_use) {
+		state->stats.max_in_use = in_use;
+	}
+
+	if (waited) {
+		platform_init_current_tick (&now);
+		wait_ms = platform_get_duration (&start, &now);
+
+		state->stats.total_wait_ms += wait_ms;
+		if (wait_ms > state->stats.max_wait_ms) {
+			state->stats.max_wait_ms = wait_ms;
+		}
+	}
+
+	/* The platform semaphore may not count signals, so multiple engines released at the same time
+	 * may only wake a single waiter.  Pass the signal along if there are more engines available. */
+	if ((state->waiters != 0) && (in_use < pool->count)) {
+		platform_semaphore_post (&state->released);
+	}
+
+	platform_mutex_unlock (&state->lock);
+
+	return index;
+}
+
+/**
+ * Return an engine to the pool.
+ *
+ * @param pool The pool that owns the engine.
+ * @param index Index of the engine being released.
+ * @param owner The pooled engine that had reserved the engine for a hash operation.  This will be
+ * null if the engine was not used for a hash operation.
+ */
+static void hash_pool_return (const struct hash_pool *pool, size_t index,
+	struct hash_engine_pooled *owner)
+{
+	platform_mutex_lock (&pool->state->lock);
+
+	if (owner != NULL) {
+		owner->active = NULL;
+		owner->started = false;
+	}
+
+	pool->state->busy &= ~(1U << index);
+	if (pool->state->waiters != 0) {
+		platform_semaphore_post (&pool->state->released);
+	}
+
+	platform_mutex_unlock (&pool->state->lock);
+}
+
+/**
+ * Calculate a hash using any free engine from the pool.
+ *
+ * @param pooled The pooled engine handling the request.
+ * @param type The type of hash to calculate.
+ * @param data The data to hash.
+ * @param length The length of the data.
+ * @param hash Output buffer for the hash.
+ * @param hash_length The length of the hash buffer.
+ *
+ * @return 0 if the hash was calculated successfully or an error code.
+ */
+static int hash_pool_engine_calculate (struct hash_engine_pooled *pooled, enum hash_type type,
+	const uint8_t *data, size_t length, uint8_t *hash, size_t hash_length)
+{
+	size_t index;
+	int status;
+
+	if (pooled == NULL) {
+		return HASH_ENGINE_INVALID_ARGUMENT;
+	}
+
+	index = hash_pool_acquire (pooled->pool, pooled->preferred);
+	status = hash_calculate (pooled->pool->engines[index], type, data, length, hash, hash_length);
+	hash_pool_return (pooled->pool, index, NULL);
+
+	pooled->preferred = index;
+
+	return (ROT_IS_ERROR (status)) ? status : 0;
+}
+
+/**
+ * Reserve a pooled engine for a new hash operation.  Only a single hash operation can be active on
+ * a pooled engine, even if the pooled engine is shared by multiple tasks.
+ *
+ * @param pooled The pooled engine to reserve.
+ *
+ * @return 0 if the pooled engine was reserved or HASH_ENGINE_HASH_IN_PROGRESS if there is already
+ * an active hash operation.
+ */
+static int hash_pool_engine_reserve (struct hash_engine_pooled *pooled)
+{
+	int status = 0;
+
+	platform_mutex_lock (&pooled->pool->state->lock);
+
+	if (pooled->started) {
+		status = HASH_ENGINE_HASH_IN_PROGRESS;
+	}
+	else {
+		pooled->started = true;
+	}
+
+	platform_mutex_unlock (&pooled->pool->state->lock);
+
+	return status;
+}
+
+/**
+ * Start a new hash operation on an engine from the pool.  The engine will remain assigned to the
+ * pooled engine until the hash is finished or canceled.
+ *
+ * @param pooled The pooled engine handling the request.
+ * @param type The type of hash to start.
+ *
+ * @return 0 if the hash was started successfully or an error code.
+ */
+static int hash_pool_engine_start (struct hash_engine_pooled *pooled, enum hash_type type)
+{
+	size_t index;
+	int status;
+
+	if (pooled == NULL) {
+		return HASH_ENGINE_INVALID_ARGUMENT;
+	}
+
+	status = hash_pool_engine_reserve (pooled);
+	if (status != 0) {
+		return status;
+	}
+
+	index = hash_pool_acquire (pooled->pool, pooled->preferred);
+	status = hash_start_new_hash (pooled->pool->engines[index], type);
+	if (status != 0) {
+		hash_pool_return (pooled->pool, index, pooled);
+		return status;
+	}
+
+	pooled->active = pooled->pool->engines[index];
+	pooled->active_index = index;
+	pooled->preferred = index;
+
+	return 0;
+}
+
+static int hash_pool_engine_calculate_sha256_multi (struct hash_engine *engine,
+	const struct hash_multi_buffer *buffers, size_t count)
+{
+	struct hash_engine_pooled *pooled = (struct hash_engine_pooled*) engine;
+	size_t index;
+	int status;
+
+	if (pooled == NULL) {
+		return HASH_ENGINE_INVALID_ARGUMENT;
+	}
+
+	index = hash_pool_acquire (pooled->pool, pooled->preferred);
+	status = pooled->pool->engines[index]->calculate_sha256_multi (pooled->pool->engines[index],
+		buffers, count);
+	hash_pool_return (pooled->pool, index, NULL);
+
+	pooled->preferred = index;
+
+	return status;
+}
+
+/**
+ * Return the engine assigned to the active hash operation back to the pool.
+ *
+ * @param pooled The pooled engine that is done with the hash operation.
+ */
+static void hash_pool_engine_return_active (struct hash_engine_pooled *pooled)
+{
+	hash_pool_return (pooled->pool, pooled->active_index, pooled);
+}
+
+#ifdef HASH_ENABLE_SHA1
+static int hash_pool_engine_calculate_sha1 (struct hash_engine *engine, const uint8_t *data,
+	size_t length, uint8_t *hash, size_t hash_length)
+{
+	return hash_pool_engine_calculate ((struct hash_engine_pooled*) engine, HASH_TYPE_SHA1, data,
+		length, hash, hash_length);
+}
+
+static int hash_pool_engine_start_sha1 (struct hash_engine *engine)
+{
+	return hash_pool_engine_start ((struct hash_engine_pooled*) engine, HASH_TYPE_SHA1);
+}
+#endif
+
+static int hash_pool_engine_calculate_sha256 (struct hash_engine *engine, const uint8_t *data,
+	size_t length, uint8_t *hash, size_t hash_length)
+{
+	return hash_pool_engine_calculate ((struct hash_engine_pooled*) engine, HASH_TYPE_SHA256, data,
+		length, hash, hash_length);
+}
+
+static int hash_pool_engine_start_sha256 (struct hash_engine *engine)
+{
+	return hash_pool_engine_start ((struct hash_engine_pooled*) engine, HASH_TYPE_SHA256);
+}
+
+#ifdef HASH_ENABLE_SHA384
+static int hash_pool_engine_calculate_sha384 (struct hash_engine *engine, const uint8_t *data,
+	size_t length, uint8_t *hash, size_t hash_length)
+{
+	return hash_pool_engine_calculate ((struct hash_engine_pooled*) engine, HASH_TYPE_SHA384, data,
+		length, hash, hash_length);
+}
+
+static int hash_pool_engine_start_sha384 (struct hash_engine *engine)
+{
+	return hash_pool_engine_start ((struct hash_engine_pooled*) engine, HASH_TYPE_SHA384);
+}
+#endif
+
+#ifdef HASH_ENABLE_SHA512
+static int hash_pool_engine_calculate_sha512 (struct hash_engine *engine, const uint8_t *data,
+	size_t length, uint8_t *hash, size_t hash_length)
+{
+	return hash_pool_engine_calculate ((struct hash_engine_pooled*) engine, HASH_TYPE_SHA512, data,
+		length, hash, hash_length);
+}
+
+static int hash_pool_engine_start_sha512 (struct hash_engine *engine)
+{
+	return hash_pool_engine_start ((struct hash_engine_pooled*) engine, HASH_TYPE_SHA512);
+}
+#endif
+
+static int hash_pool_engine_update (struct hash_engine *engine, const uint8_t *data,
+	size_t length)
+{
+	struct hash_engine_pooled *pooled = (struct hash_engine_pooled*) engine;
+
+	if (pooled == NULL) {
+		return HASH_ENGINE_INVALID_ARGUMENT;
+	}
+
+	if (pooled->active == NULL) {
+		return HASH_ENGINE_NO_ACTIVE_HASH;
+	}
+
+	return pooled->active->update (pooled->active, data, length);
+}
+
+static int hash_pool_engine_finish (struct hash_engine *engine, uint8_t *hash, size_t hash_length)
+{
+	struct hash_engine_pooled *pooled = (struct hash_engine_pooled*) engine;
+	int status;
+
+	if (pooled == NULL) {
+		return HASH_ENGINE_INVALID_ARGUMENT;
+	}
+
+	if (pooled->active == NULL) {
+		return HASH_ENGINE_NO_ACTIVE_HASH;
+	}
+
+	status = pooled->active->finish (pooled->active, hash, hash_length);
+	if (status == 0) {
+		/* Only release the engine if finish is successful.  Unsuccessful calls require retry or
+		 * cancel. */
+		hash_pool_engine_return_active (pooled);
+	}
+
+	return status;
+}
+
+static void hash_pool_engine_cancel (struct hash_engine *engine)
+{
+	struct hash_engine_pooled *pooled = (struct hash_engine_pooled*) engine;
+
+	if ((pooled == NULL) || (pooled->active == NULL)) {
+		return;
+	}
+
+	pooled->active->cancel (pooled->active);
+	hash_pool_engine_return_active (pooled);
+}
+
+static int hash_pool_engine_save_state (struct hash_engine *engine,
+	struct hash_saved_state *state)
+{
+	struct hash_engine_pooled *pooled = (struct hash_engine_pooled*) engine;
+
+	if (pooled == NULL) {
+		return HASH_ENGINE_INVALID_ARGUMENT;
+	}
+
+	if (pooled->active == NULL) {
+		return HASH_ENGINE_NO_ACTIVE_HASH;
+	}
+
+	return pooled->active->save_state (pooled->active, state);
+}
+
+static int hash_pool_engine_restore_state (struct hash_engine *engine,
+	const struct hash_saved_state *state)
+{
+	struct hash_engine_pooled *pooled = (struct hash_engine_pooled*) engine;
+	size_t index;
+	int status;
+
+	if ((pooled == NULL) || (state == NULL)) {
+		return HASH_ENGINE_INVALID_ARGUMENT;
+	}
+
+	status = hash_pool_engine_reserve (pooled);
+	if (status != 0) {
+		return status;
+	}
+
+	/* Since all engines in the pool are the same type, the state can be restored to any engine. */
+	index = hash_pool_acquire (pooled->pool, pooled->preferred);
+	status = pooled->pool->engines[index]->restore_state (pooled->pool->engines[index], state);
+	if (status != 0) {
+		hash_pool_return (pooled->pool, index, pooled);
+		return status;
+	}
+
+	pooled->active = pooled->pool->engines[index];
+	pooled->active_index = index;
+	pooled->preferred = index;
+
+	return 0;
+}
+
+/**
+ * Initialize a pool of hash engines.
+ *
+ * @param pool The pool to initialize.
+ * @param state Variable context for the pool.  This must be uninitialized.
+ * @param engines The list of hash engines to manage.  Each engine must be independent of the others
+ * in the list and must not be used outside of the pool.  Saved hash state from one engine may be
+ * restored on another, so all engines should be the same type.
+ * @param count The number of engines in the list.  This cannot be more than HASH_POOL_MAX_ENGINES.
+ *
+ * @return 0 if the pool was initialized successfully or an error code.
+ */
+int hash_pool_init (struct hash_pool *pool, struct hash_pool_state *state,
+	struct hash_engine *const *engines, size_t count)
+{
+	if (pool == NULL) {
+		return HASH_ENGINE_INVALID_ARGUMENT;
+	}
+
+	memset (pool, 0, sizeof (struct hash_pool));
+
+	pool->state = state;
+	pool->engines = engines;
+	pool->count = count;
+
+	return hash_pool_init_state (pool);
+}
+
+/**
+ * Initialize only the variable state for a pool of hash engines.  The rest of the pool is assumed
+ * to have already been initialized.
+ *
+ * This would generally be used with a statically initialized instance.
+ *
+ * @param pool The pool that contains the state to initialize.
+ *
+ * @return 0 if the state was successfully initialized or an error code.
+ */
+int hash_pool_init_state (const struct hash_pool *pool)
+{
+	size_t i;
+	int status;
+
+	if ((pool == NULL) || (pool->state == NULL) || (pool->engines == NULL) ||
+		(pool->count == 0) || (pool->count > HASH_POOL_MAX_ENGINES)) {
+		return HASH_ENGINE_INVALID_ARGUMENT;
+	}
+
+	for (i = 0; i < pool->count; i++) {
+		if (pool->engines[i] == NULL) {
+			return HASH_ENGINE_INVALID_ARGUMENT;
+		}
+	}
+
+	memset (pool->state, 0, sizeof (struct hash_pool_state));
+
+	status = platform_semaphore_init (&pool->state->released);
+	if (status != 0) {
+		return status;
+	}
+
+	status = platform_mutex_init (&pool->state->lock);
+	if (status != 0) {
+		platform_semaphore_free (&pool->state->released);
+	}
+
+	return status;
+}
+
+/**
+ * Release the resources used by a pool of hash engines.
+ *
+ * @param pool The pool to release.
+ */
+void hash_pool_release (const struct hash_pool *pool)
+{
+	if (pool) {
+		platform_mutex_free (&pool->state->lock);
+		platform_semaphore_free (&pool->state->released);
+	}
+}
+
+/**
+ * Get the usage statistics for a pool of hash engines.
+ *
+ * @param pool The pool to query.
+ * @param stats Output for the pool statistics.
+ *
+ * @return 0 if the statistics were retrieved or an error code.
+ */
+int hash_pool_get_stats (const struct hash_pool *pool, struct hash_pool_stats *stats)
+{
+	if ((pool == NULL) || (stats == NULL)) {
+		return HASH_ENGINE_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&pool->state->lock);
+	*stats = pool->state->stats;
+	platform_mutex_unlock (&pool->state->lock);
+
+	return 0;
+}
+
+/**
+ * Clear the usage statistics for a pool of hash engines.
+ *
+ * @param pool The pool to update.
+ *
+ * @return 0 if the statistics were cleared or an error code.
+ */
+int hash_pool_reset_stats (const struct hash_pool *pool)
+{
+	if (pool == NULL) {
+		return HASH_ENGINE_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&pool->state->lock);
+	memset (&pool->state->stats, 0, sizeof (pool->state->stats));
+	platform_mutex_unlock (&pool->state->lock);
+
+	return 0;
+}
+
+/**
+ * Initialize a hash engine that executes requests using engines from a pool.
+ *
+ * @param engine The pooled engine to initialize.
+ * @param pool The pool that will provide hash engines.
+ *
+ * @return 0 if the engine was successfully initialized or an error code.
+ */
+int hash_pool_engine_init (struct hash_engine_pooled *engine, const struct hash_pool *pool)
+{
+	size_t i;
+
+	if ((engine == NULL) || (pool == NULL)) {
+		return HASH_ENGINE_INVALID_ARGUMENT;
+	}
+
+	memset (engine, 0, sizeof (struct hash_engine_pooled));
+
+#ifdef HASH_ENABLE_SHA1
+	engine->base.calculate_sha1 = hash_pool_engine_calculate_sha1;
+	engine->base.start_sha1 = hash_pool_engine_start_sha1;
+#endif
+	engine->base.calculate_sha256 = hash_pool_engine_calculate_sha256;
+	engine->base.start_sha256 = hash_pool_engine_start_sha256;
+#ifdef HASH_ENABLE_SHA384
+	engine->base.calculate_sha384 = hash_pool_engine_calculate_sha384;
+	engine->base.start_sha384 = hash_pool_engine_start_sha384;
+#endif
+#ifdef HASH_ENABLE_SHA512
+	engine->base.calculate_sha512 = hash_pool_engine_calculate_sha512;
+	engine->base.start_sha512 = hash_pool_engine_start_sha512;
+#endif
+	engine->base.update = hash_pool_engine_update;
+	engine->base.finish = hash_pool_engine_finish;
+	engine->base.cancel = hash_pool_engine_cancel;
+
+	/* Hash state can be restored on any engine, so every engine must be able to save state. */
+	for (i = 0; i < pool->count; i++) {
+		if (!hash_is_save_state_supported (pool->engines[i])) {
+			break;
+		}
+	}
+
+	if (i == pool->count) {
+		engine->base.save_state = hash_pool_engine_save_state;
+		engine->base.restore_state = hash_pool_engine_restore_state;
+	}
+
+	/* Multi-buffer hashing can be assigned to any engine, so every engine must support it. */
+	for (i = 0; i < pool->count; i++) {
+		if (!hash_is_sha256_multi_supported (pool->engines[i])) {
+			break;
+		}
+	}
+
+	if (i == pool->count) {
+		engine->base.calculate_sha256_multi = hash_pool_engine_calculate_sha256_multi;
+	}
+
+	engine->pool = pool;
+
+	return 0;
+}
+
+/**
+ * Release the resources used by a pooled hash engine.  Any active hash operation will be canceled.
+ *
+ * @param engine The pooled engine to release.
+ */
+void hash_pool_engine_release (struct hash_engine_pooled *engine)
+{
+	hash_pool_engine_cancel ((struct hash_engine*) engine);
+}
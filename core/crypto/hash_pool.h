@@ -0,0 +1,88 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef HASH_POOL_H_
+#define HASH_POOL_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "platform_api.h"
+#include "crypto/hash.h"
+
+
+/**
+ * The maximum number of hash engines that can be managed by a single pool.
+ */
+#define	HASH_POOL_MAX_ENGINES			32
+
+
+/**
+ * Usage statistics for a pool of hash engines.
+ */
+struct hash_pool_stats {
+	uint32_t acquired;					/**< Number of times an engine was assigned to a request. */
+	uint32_t contended;					/**< Number of requests that had to wait for a free engine. */
+	uint32_t total_wait_ms;				/**< Total time requests spent waiting for a free engine. */
+	uint32_t max_wait_ms;				/**< The longest time a request waited for a free engine. */
+	uint32_t max_in_use;				/**< The most engines that were in use at the same time. */
+};
+
+/**
+ * Variable context for a pool of hash engines.
+ */
+struct hash_pool_state {
+	platform_mutex lock;				/**< Synchronization for engine assignment. */
+	platform_semaphore released;		/**< Signal to waiting requests that an engine is free. */
+	uint32_t busy;						/**< Bitmap of engines that are currently in use. */
+	size_t waiters;						/**< Number of requests waiting for a free engine. */
+	struct hash_pool_stats stats;		/**< Usage statistics for the pool. */
+};
+
+/**
+ * A pool of independent hash engines that can be shared by multiple tasks.  Unlike a single
+ * engine protected by a mutex, requests are only serialized when every engine in the pool is in
+ * use.
+ *
+ * Engines from the pool are accessed through a {@link struct hash_engine_pooled} instance.
+ */
+struct hash_pool {
+	struct hash_pool_state *state;		/**< Variable context for the pool. */
+	struct hash_engine *const *engines;	/**< The list of hash engines managed by the pool. */
+	size_t count;						/**< The number of engines in the pool. */
+};
+
+/**
+ * A hash engine that executes requests on an engine from a pool.  Single hash calculations use
+ * any free engine only for the duration of the call.  Hash operations that are started use the
+ * same engine until the hash is finished or canceled.
+ *
+ * Single hash calculations can be requested by multiple tasks using the same pooled engine.  Only
+ * one hash operation can be active on a pooled engine at a time, so starting a hash while another
+ * task has a hash active on the same instance will fail with HASH_ENGINE_HASH_IN_PROGRESS.  The
+ * rest of the hash operation must be handled by the task that started it.  Tasks that need to run
+ * hash operations concurrently must each use their own pooled engine instance.
+ */
+struct hash_engine_pooled {
+	struct hash_engine base;			/**< Base API implementation. */
+	const struct hash_pool *pool;		/**< The pool that provides hash engines. */
+	struct hash_engine *active;			/**< The engine assigned to the active hash operation. */
+	size_t active_index;				/**< Index of the engine assigned to the active hash operation. */
+	size_t preferred;					/**< Index of the engine last used by this instance. */
+	bool started;						/**< Flag indicating a hash operation is active.  Protected by the pool lock. */
+};
+
+
+int hash_pool_init (struct hash_pool *pool, struct hash_pool_state *state,
+	struct hash_engine *const *engines, size_t count);
+int hash_pool_init_state (const struct hash_pool *pool);
+void hash_pool_release (const struct hash_pool *pool);
+
+int hash_pool_get_stats (const struct hash_pool *pool, struct hash_pool_stats *stats);
+int hash_pool_reset_stats (const struct hash_pool *pool);
+
+int hash_pool_engine_init (struct hash_engine_pooled *engine, const struct hash_pool *pool);
+void hash_pool_engine_release (struct hash_engine_pooled *engine);
+
+
+#endif /* HASH_POOL_H_ */
@@ -0,0 +1,27 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef HASH_POOL_STATIC_H_
+#define HASH_POOL_STATIC_H_
+
+#include "crypto/hash_pool.h"
+
+
+/**
+ * Initialize a static instance of a hash engine pool.  This does not initialize the pool state.
+ * This can be a constant instance.
+ *
+ * There is no validation done on the arguments.
+ *
+ * @param state_ptr Variable context for the pool.
+ * @param engines_ptr The list of hash engines to manage.
+ * @param engine_cnt The number of engines in the list.
+ */
+#define	hash_pool_static_init(state_ptr, engines_ptr, engine_cnt)	{ \
+		.state = state_ptr, \
+		.engines = engines_ptr, \
+		.count = engine_cnt \
+	}
+
+
+#endif /* HASH_POOL_STATIC_H_ */
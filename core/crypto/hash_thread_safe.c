@@ -195,6 +195,54 @@ static void hash_thread_safe_cancel (struct hash_engine *engine)
 	platform_mutex_unlock (&sha->lock);
 }
 
+static int hash_thread_safe_save_state (struct hash_engine *engine,
+	struct hash_saved_state *state)
+{
+	struct hash_engine_thread_safe *sha = (struct hash_engine_thread_safe*) engine;
+
+	if (sha == NULL) {
+		return HASH_ENGINE_INVALID_ARGUMENT;
+	}
+
+	return sha->engine->save_state (sha->engine, state);
+}
+
+static int hash_thread_safe_restore_state (struct hash_engine *engine,
+	const struct hash_saved_state *state)
+{
+	struct hash_engine_thread_safe *sha = (struct hash_engine_thread_safe*) engine;
+	int status;
+
+	if (sha == NULL) {
+		return HASH_ENGINE_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&sha->lock);
+	status = sha->engine->restore_state (sha->engine, state);
+	if (status != 0) {
+		platform_mutex_unlock (&sha->lock);
+	}
+
+	return status;
+}
+
+static int hash_thread_safe_calculate_sha256_multi (struct hash_engine *engine,
+	const struct hash_multi_buffer *buffers, size_t count)
+{
+	struct hash_engine_thread_safe *sha = (struct hash_engine_thread_safe*) engine;
+	int status;
+
+	if (sha == NULL) {
+		return HASH_ENGINE_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&sha->lock);
+	status = sha->engine->calculate_sha256_multi (sha->engine, buffers, count);
+	platform_mutex_unlock (&sha->lock);
+
+	return status;
+}
+
 /**
  * Initialize a thread-safe wrapper for a hash engine.
  *
@@ -229,6 +277,17 @@ int hash_thread_safe_init (struct hash_engine_thread_safe *engine, struct hash_e
 	engine->base.finish = hash_thread_safe_finish;
 	engine->base.cancel = hash_thread_safe_cancel;
 
+	/* Saving hash state is only available if the target engine supports it. */
+	if (hash_is_save_state_supported (target)) {
+		engine->base.save_state = hash_thread_safe_save_state;
+		engine->base.restore_state = hash_thread_safe_restore_state;
+	}
+
+	/* Multi-buffer hashing is only exposed if the target engine provides it. */
+	if (hash_is_sha256_multi_supported (target)) {
+		engine->base.calculate_sha256_multi = hash_thread_safe_calculate_sha256_multi;
+	}
+
 	engine->engine = target;
 
 	return platform_mutex_init (&engine->lock);
@@ -9,6 +9,14 @@
 /**
  * Generate key using NIST SP800-108 counter mode
  *
+ * The key derivation key is prepared once for all rounds of the KDF.  If the hash engine supports
+ * saving hash state, each round only needs to hash the KDF input data.
+ *
+ * The prepared key is kept on the stack for the duration of the call, which requires
+ * sizeof (struct hmac_keyed_context) bytes, more than 500 bytes, in addition to the HMAC context.
+ * Callers with limited stack space, or that derive multiple keys from the same key derivation key,
+ * can prepare the key themselves and use kdf_nist800_108_counter_mode_keyed.
+ *
  * @param hash Hash engine to utilize.
  * @param hash_type HMAC hash type to utilize.
  * @param key_derivation_key Key used to derive keying material.
@@ -25,6 +33,49 @@
 int kdf_nist800_108_counter_mode (struct hash_engine *hash, enum hmac_hash hash_type,
 	const uint8_t *key_derivation_key, size_t key_derivation_key_len, const uint8_t *label,
 	size_t label_len, const uint8_t *context, size_t context_len, uint8_t *key, uint32_t key_len)
+{
+	struct hmac_keyed_context keyed;
+	int status;
+
+	if ((hash == NULL) || (key_derivation_key == NULL) || (label == NULL) || (key == NULL)) {
+		return KDF_INVALID_ARGUMENT;
+	}
+
+	if (hash_hmac_get_hmac_length (hash_type) == HASH_ENGINE_UNKNOWN_HASH) {
+		return KDF_OPERATION_UNSUPPORTED;
+	}
+
+	status = hash_hmac_keyed_init (&keyed, hash, hash_type, key_derivation_key,
+		key_derivation_key_len);
+	if (status != 0) {
+		return status;
+	}
+
+	status = kdf_nist800_108_counter_mode_keyed (&keyed, label, label_len, context, context_len,
+		key, key_len);
+
+	hash_hmac_keyed_release (&keyed);
+	return status;
+}
+
+/**
+ * Generate key using NIST SP800-108 counter mode with a key derivation key that has already been
+ * prepared for HMAC operations.
+ *
+ * @param keyed The prepared key derivation key.  This also determines the hash engine and HMAC
+ * hash type to use.
+ * @param label Buffer containing label used as input to the KDF.
+ * @param label_len Label length.
+ * @param context Buffer containing context used as input to the KDF. Set to NULL if not used.
+ * @param context_len Context length.
+ * @param key Buffer to store generated key.
+ * @param key_len Output key length.
+ *
+ * @return Completion status, 0 if success or an error code.
+ */
+int kdf_nist800_108_counter_mode_keyed (const struct hmac_keyed_context *keyed,
+	const uint8_t *label, size_t label_len, const uint8_t *context, size_t context_len,
+	uint8_t *key, uint32_t key_len)
 {
 	struct hmac_engine hmac;
 	uint32_t i_key = 0;
@@ -38,11 +89,11 @@ int kdf_nist800_108_counter_mode (struct hash_engine *hash, enum hmac_hash hash_
 	uint8_t separator = 0x00;
 	int status;
 
-	if ((hash == NULL) || (key_derivation_key == NULL) || (label == NULL) || (key == NULL)) {
+	if ((keyed == NULL) || (label == NULL) || (key == NULL)) {
 		return KDF_INVALID_ARGUMENT;
 	}
 
-	hash_len = hash_hmac_get_hmac_length (hash_type);
+	hash_len = hash_hmac_get_hmac_length (keyed->type);
 	if (hash_len == HASH_ENGINE_UNKNOWN_HASH) {
 		return KDF_OPERATION_UNSUPPORTED;
 	}
@@ -55,8 +106,7 @@ int kdf_nist800_108_counter_mode (struct hash_engine *hash, enum hmac_hash hash_
 	memset (key, 0, key_len);
 
 	for (i = 1; i <= rounds; ++i) {
-		status = hash_hmac_init (&hmac, hash, hash_type, key_derivation_key,
-			key_derivation_key_len);
+		status = hash_hmac_init_keyed (&hmac, keyed);
 		if (status != 0) {
 			return status;
 		}
@@ -104,10 +154,9 @@ int kdf_nist800_108_counter_mode (struct hash_engine *hash, enum hmac_hash hash_
 		i_key += copy_len;
 	}
 
-	return status;
+	return 0;
 
 fail:
 	hash_hmac_cancel (&hmac);
-
 	return status;
 }
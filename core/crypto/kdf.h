@@ -14,6 +14,9 @@
 int kdf_nist800_108_counter_mode (struct hash_engine *hash, enum hmac_hash hash_type, 
 	const uint8_t *key_derivation_key, size_t key_derivation_key_len, const uint8_t *label, 
 	size_t label_len, const uint8_t *context, size_t context_len, uint8_t *key, uint32_t key_len);
+int kdf_nist800_108_counter_mode_keyed (const struct hmac_keyed_context *keyed,
+	const uint8_t *label, size_t label_len, const uint8_t *context, size_t context_len,
+	uint8_t *key, uint32_t key_len);
 
 
 #define	KDF_ERROR(code)		ROT_ERROR (ROT_MODULE_KDF, code)
@@ -0,0 +1,212 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "key_cache.h"
+#include "common/unused.h"
+
+
+/**
+ * Initialize a cache for prepared public keys.
+ *
+ * @param cache The cache to initialize.
+ * @param state Variable context for the cache.  This must be uninitialized.
+ * @param entries Storage for tracking cached keys.
+ * @param count The number of entries in the cache.
+ *
+ * @return 0 if the cache was initialized successfully or an error code.
+ */
+int key_cache_init (struct key_cache *cache, struct key_cache_state *state,
+	struct key_cache_entry *entries, size_t count)
+{
+	if (cache == NULL) {
+		return KEY_CACHE_INVALID_ARGUMENT;
+	}
+
+	memset (cache, 0, sizeof (struct key_cache));
+
+	cache->state = state;
+	cache->entries = entries;
+	cache->count = count;
+
+	return key_cache_init_state (cache);
+}
+
+/**
+ * Initialize only the variable state for a key cache.  The rest of the cache is assumed to have
+ * already been initialized.  All entries in the cache will be empty.
+ *
+ * This would generally be used with a statically initialized instance.
+ *
+ * @param cache The cache that contains the state to initialize.
+ *
+ * @return 0 if the state was successfully initialized or an error code.
+ */
+int key_cache_init_state (const struct key_cache *cache)
+{
+	if ((cache == NULL) || (cache->state == NULL) || (cache->entries == NULL) ||
+		(cache->count == 0)) {
+		return KEY_CACHE_INVALID_ARGUMENT;
+	}
+
+	memset (cache->state, 0, sizeof (struct key_cache_state));
+	memset (cache->entries, 0, sizeof (struct key_cache_entry) * cache->count);
+
+	return 0;
+}
+
+/**
+ * Release the resources used by a key cache.  Prepared keys managed by the user of the cache must
+ * be released separately.
+ *
+ * @param cache The cache to release.
+ */
+void key_cache_release (const struct key_cache *cache)
+{
+	UNUSED (cache);
+}
+
+/**
+ * Find a prepared key in the cache.  A successful lookup marks the entry as the most recently used.
+ *
+ * @param cache The cache to search.
+ * @param id Identifier for the key.  This must be KEY_CACHE_ID_LENGTH bytes.
+ *
+ * @return Index of the cache entry for the key or an error code.  KEY_CACHE_NOT_CACHED is returned
+ * if the key is not in the cache.  Use ROT_IS_ERROR to check the return value.
+ */
+int key_cache_find (const struct key_cache *cache, const uint8_t *id)
+{
+	size_t i;
+
+	if ((cache == NULL) || (id == NULL)) {
+		return KEY_CACHE_INVALID_ARGUMENT;
+	}
+
+	for (i = 0; i < cache->count; i++) {
+		if (cache->entries[i].valid &&
+			(memcmp (cache->entries[i].id, id, KEY_CACHE_ID_LENGTH) == 0)) {
+			cache->entries[i].last_use = ++cache->state->access_count;
+			cache->state->stats.hits++;
+
+			return i;
+		}
+	}
+
+	cache->state->stats.misses++;
+
+	return KEY_CACHE_NOT_CACHED;
+}
+
+/**
+ * Assign a cache entry to a new key.  An empty entry will be used if there is one.  Otherwise, the
+ * least recently used entry will be replaced.
+ *
+ * The caller must prepare the key in the storage for the returned entry.  If the key cannot be
+ * prepared, the entry must be removed with key_cache_remove.
+ *
+ * A key that is already in the cache will not be added again.  This can happen when multiple tasks
+ * prepare the same key at the same time.
+ *
+ * @param cache The cache to update.
+ * @param id Identifier for the new key.  This must be KEY_CACHE_ID_LENGTH bytes.
+ * @param evicted Output indicating if the entry contained a different key.  If true, the caller
+ * must release the prepared key in the entry storage before using it for the new key.
+ *
+ * @return Index of the cache entry assigned to the key or an error code.  KEY_CACHE_ALREADY_CACHED
+ * is returned if the key is already in the cache.  Use ROT_IS_ERROR to check the return value.
+ */
+int key_cache_add (const struct key_cache *cache, const uint8_t *id, bool *evicted)
+{
+	size_t index = 0;
+	uint32_t age = 0;
+	size_t i;
+
+	if ((cache == NULL) || (id == NULL) || (evicted == NULL)) {
+		return KEY_CACHE_INVALID_ARGUMENT;
+	}
+
+	for (i = 0; i < cache->count; i++) {
+		if (cache->entries[i].valid &&
+			(memcmp (cache->entries[i].id, id, KEY_CACHE_ID_LENGTH) == 0)) {
+			return KEY_CACHE_ALREADY_CACHED;
+		}
+	}
+
+	*evicted = true;
+	for (i = 0; i < cache->count; i++) {
+		if (!cache->entries[i].valid) {
+			index = i;
+			*evicted = false;
+			break;
+		}
+
+		/* Compare relative age so replacement order is preserved if the access count wraps. */
+		if ((cache->state->access_count - cache->entries[i].last_use) >= age) {
+			age = cache->state->access_count - cache->entries[i].last_use;
+			index = i;
+		}
+	}
+
+	if (*evicted) {
+		cache->state->stats.evictions++;
+	}
+
+	memcpy (cache->entries[index].id, id, KEY_CACHE_ID_LENGTH);
+	cache->entries[index].last_use = ++cache->state->access_count;
+	cache->entries[index].valid = true;
+
+	return index;
+}
+
+/**
+ * Remove a key from the cache.  The caller is responsible for releasing any prepared key stored for
+ * the entry.
+ *
+ * @param cache The cache to update.
+ * @param index Index of the cache entry to remove.
+ */
+void key_cache_remove (const struct key_cache *cache, size_t index)
+{
+	if ((cache != NULL) && (index < cache->count)) {
+		cache->entries[index].valid = false;
+	}
+}
+
+/**
+ * Determine if a cache entry contains a key.
+ *
+ * @param cache The cache to query.
+ * @param index Index of the cache entry to check.
+ *
+ * @return true if the entry contains a key or false if not.
+ */
+bool key_cache_is_entry_valid (const struct key_cache *cache, size_t index)
+{
+	if ((cache == NULL) || (index >= cache->count)) {
+		return false;
+	}
+
+	return cache->entries[index].valid;
+}
+
+/**
+ * Get the usage counters for a key cache.
+ *
+ * @param cache The cache to query.
+ * @param stats Output for the cache counters.
+ *
+ * @return 0 if the counters were retrieved or an error code.
+ */
+int key_cache_get_stats (const struct key_cache *cache, struct key_cache_stats *stats)
+{
+	if ((cache == NULL) || (stats == NULL)) {
+		return KEY_CACHE_INVALID_ARGUMENT;
+	}
+
+	*stats = cache->state->stats;
+
+	return 0;
+}
@@ -0,0 +1,91 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef KEY_CACHE_H_
+#define KEY_CACHE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "status/rot_status.h"
+#include "crypto/hash.h"
+
+
+/**
+ * Length of the identifier for a cached key.  Keys are identified by the SHA-256 digest of the key
+ * material.
+ */
+#define	KEY_CACHE_ID_LENGTH			SHA256_HASH_LENGTH
+
+
+/**
+ * Tracking information for a single key in the cache.
+ */
+struct key_cache_entry {
+	uint8_t id[KEY_CACHE_ID_LENGTH];	/**< Digest of the key material stored in the entry. */
+	uint32_t last_use;					/**< Cache access count when the entry was last used. */
+	bool valid;							/**< Flag indicating the entry contains a prepared key. */
+};
+
+/**
+ * Counters for key cache usage.
+ */
+struct key_cache_stats {
+	uint32_t hits;						/**< Number of lookups that found a prepared key. */
+	uint32_t misses;					/**< Number of lookups that required preparing a key. */
+	uint32_t evictions;					/**< Number of prepared keys discarded to make room. */
+};
+
+/**
+ * Variable context for a key cache.
+ */
+struct key_cache_state {
+	uint32_t access_count;				/**< Counter used to order entries by last use. */
+	struct key_cache_stats stats;		/**< Usage counters for the cache. */
+};
+
+/**
+ * A bounded cache that tracks prepared public keys, such as parsed key structures or precomputed
+ * arithmetic contexts, so that repeated operations with the same key can skip key setup.
+ *
+ * The cache only manages key identifiers and replacement order.  Storage for the prepared keys is
+ * owned by the user of the cache, which keeps one prepared key for each cache entry.  When the
+ * cache is full, the least recently used entry is replaced.
+ *
+ * The cache provides no synchronization.  Users that can be called from multiple tasks must
+ * protect access to the cache.
+ */
+struct key_cache {
+	struct key_cache_state *state;		/**< Variable context for the cache. */
+	struct key_cache_entry *entries;	/**< Tracking information for each cached key. */
+	size_t count;						/**< The maximum number of keys in the cache. */
+};
+
+
+int key_cache_init (struct key_cache *cache, struct key_cache_state *state,
+	struct key_cache_entry *entries, size_t count);
+int key_cache_init_state (const struct key_cache *cache);
+void key_cache_release (const struct key_cache *cache);
+
+int key_cache_find (const struct key_cache *cache, const uint8_t *id);
+int key_cache_add (const struct key_cache *cache, const uint8_t *id, bool *evicted);
+void key_cache_remove (const struct key_cache *cache, size_t index);
+bool key_cache_is_entry_valid (const struct key_cache *cache, size_t index);
+
+int key_cache_get_stats (const struct key_cache *cache, struct key_cache_stats *stats);
+
+
+#define	KEY_CACHE_ERROR(code)		ROT_ERROR (ROT_MODULE_KEY_CACHE, code)
+
+/**
+ * Error codes that can be generated by a key cache.
+ */
+enum {
+	KEY_CACHE_INVALID_ARGUMENT = KEY_CACHE_ERROR (0x00),	/**< Input parameter is null or not valid. */
+	KEY_CACHE_NO_MEMORY = KEY_CACHE_ERROR (0x01),			/**< Memory allocation failed. */
+	KEY_CACHE_NOT_CACHED = KEY_CACHE_ERROR (0x02),			/**< The key is not in the cache. */
+	KEY_CACHE_ALREADY_CACHED = KEY_CACHE_ERROR (0x03),		/**< The key is already in the cache. */
+};
+
+
+#endif /* KEY_CACHE_H_ */
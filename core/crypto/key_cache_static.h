@@ -0,0 +1,27 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef KEY_CACHE_STATIC_H_
+#define KEY_CACHE_STATIC_H_
+
+#include "crypto/key_cache.h"
+
+
+/**
+ * Initialize a static instance of a key cache.  This does not initialize the cache state.  This
+ * can be a constant instance.
+ *
+ * There is no validation done on the arguments.
+ *
+ * @param state_ptr Variable context for the cache.
+ * @param entries_ptr Storage for tracking cached keys.
+ * @param entry_cnt The number of entries in the cache.
+ */
+#define	key_cache_static_init(state_ptr, entries_ptr, entry_cnt)	{ \
+		.state = state_ptr, \
+		.entries = entries_ptr, \
+		.count = entry_cnt \
+	}
+
+
+#endif /* KEY_CACHE_STATIC_H_ */
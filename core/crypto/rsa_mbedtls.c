@@ -8,6 +8,7 @@
 #include "mbedtls/pk.h"
 #include "mbedtls/pk_internal.h"
 #include "mbedtls/rsa.h"
+#include "mbedtls/sha256.h"
 #include "logging/debug_log.h"
 #include "crypto_logging.h"
 
@@ -394,10 +395,191 @@ exit:
 	return status;
 }
 
+/**
+ * Verify a PKCS #1 v1.5 signature using a loaded public key.
+ *
+ * @param rsa The public key to use for verification.
+ * @param signature The signature to verify.  This must be the same length as the key modulus.
+ * @param match_type The hash algorithm used to generate the signature.
+ * @param match The digest to compare against the signature.
+ * @param match_length Length of the digest.
+ *
+ * @return 0 if the signature matches the digest or an error code.
+ */
+static int rsa_mbedtls_pkcs1_verify (mbedtls_rsa_context *rsa, const uint8_t *signature,
+	mbedtls_md_type_t match_type, const uint8_t *match, size_t match_length)
+{
+	int status;
+
+	status = mbedtls_rsa_pkcs1_verify (rsa, NULL, NULL, MBEDTLS_RSA_PUBLIC, match_type,
+		match_length, match, signature);
+	if (status != 0) {
+		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+			CRYPTO_LOG_MSG_MBEDTLS_RSA_PKCS1_VERIFY_EC, status, 0);
+
+		if ((status == MBEDTLS_ERR_MPI_ALLOC_FAILED) ||
+			(status == (MBEDTLS_ERR_MPI_ALLOC_FAILED + MBEDTLS_ERR_RSA_PUBLIC_FAILED))) {
+			status = RSA_ENGINE_NO_MEMORY;
+		}
+		else {
+			status = RSA_ENGINE_BAD_SIGNATURE;
+		}
+	}
+
+	return status;
+}
+
+/**
+ * Generate the identifier used to find a public key in the key cache.
+ *
+ * @param key The public key to identify.
+ * @param id Output for the key identifier.  This must be KEY_CACHE_ID_LENGTH bytes.
+ *
+ * @return 0 if the identifier was generated successfully or an error code.
+ */
+static int rsa_mbedtls_get_key_id (const struct rsa_public_key *key, uint8_t *id)
+{
+	mbedtls_sha256_context sha256;
+	uint8_t exp[4];
+	int status;
+
+	exp[0] = key->exponent >> 24;
+	exp[1] = key->exponent >> 16;
+	exp[2] = key->exponent >> 8;
+	exp[3] = key->exponent;
+
+	mbedtls_sha256_init (&sha256);
+
+	status = mbedtls_sha256_starts_ret (&sha256, 0);
+	if (status != 0) {
+		goto exit;
+	}
+
+	status = mbedtls_sha256_update_ret (&sha256, key->modulus, key->mod_length);
+	if (status != 0) {
+		goto exit;
+	}
+
+	status = mbedtls_sha256_update_ret (&sha256, exp, sizeof (exp));
+	if (status != 0) {
+		goto exit;
+	}
+
+	status = mbedtls_sha256_finish_ret (&sha256, id);
+
+exit:
+	mbedtls_sha256_free (&sha256);
+	return status;
+}
+
+/**
+ * Add a prepared public key to the engine key cache.  The key is not added if it is already in the
+ * cache.  Failing to add the key does not prevent verification, so errors are not reported.
+ *
+ * @param mbedtls The RSA engine with the key cache.
+ * @param id Identifier for the public key.
+ * @param rsa The prepared public key to add to the cache.
+ */
+static void rsa_mbedtls_add_cached_key (struct rsa_engine_mbedtls *mbedtls, const uint8_t *id,
+	const mbedtls_rsa_context *rsa)
+{
+	bool evicted;
+	int index;
+
+	platform_mutex_lock (&mbedtls->cache_lock);
+
+	index = key_cache_add (mbedtls->key_cache, id, &evicted);
+	if (!ROT_IS_ERROR (index)) {
+		if (evicted) {
+			mbedtls_rsa_free (&mbedtls->prepared[index]);
+		}
+
+		mbedtls_rsa_init (&mbedtls->prepared[index], MBEDTLS_RSA_PKCS_V15, 0);
+		if (mbedtls_rsa_copy (&mbedtls->prepared[index], rsa) != 0) {
+			mbedtls_rsa_free (&mbedtls->prepared[index]);
+			key_cache_remove (mbedtls->key_cache, index);
+		}
+	}
+
+	platform_mutex_unlock (&mbedtls->cache_lock);
+}
+
+/**
+ * Verify a signature using a public key from the engine key cache.  If the key is not already in
+ * the cache, it will be loaded and added.
+ *
+ * The cache lock is only held while looking up or adding the key.  Verification uses a copy of the
+ * prepared key, so other tasks can use the cache while the signature is being checked.
+ *
+ * @param mbedtls The RSA engine with the key cache.
+ * @param key The public key to use for verification.
+ * @param signature The signature to verify.  This must be the same length as the key modulus.
+ * @param match_type The hash algorithm used to generate the signature.
+ * @param match The digest to compare against the signature.
+ * @param match_length Length of the digest.
+ *
+ * @return 0 if the signature matches the digest or an error code.
+ */
+static int rsa_mbedtls_sig_verify_cached_key (struct rsa_engine_mbedtls *mbedtls,
+	const struct rsa_public_key *key, const uint8_t *signature, mbedtls_md_type_t match_type,
+	const uint8_t *match, size_t match_length)
+{
+	mbedtls_rsa_context rsa;
+	uint8_t id[KEY_CACHE_ID_LENGTH];
+	int index;
+	int status;
+
+	status = rsa_mbedtls_get_key_id (key, id);
+	if (status != 0) {
+		return status;
+	}
+
+	mbedtls_rsa_init (&rsa, MBEDTLS_RSA_PKCS_V15, 0);
+
+	platform_mutex_lock (&mbedtls->cache_lock);
+
+	index = key_cache_find (mbedtls->key_cache, id);
+	if (!ROT_IS_ERROR (index)) {
+		/* The copy keeps the Montgomery constants computed by the first verification with the
+		 * key, so only the first use pays for that setup. */
+		status = mbedtls_rsa_copy (&rsa, &mbedtls->prepared[index]);
+	}
+
+	platform_mutex_unlock (&mbedtls->cache_lock);
+
+	if (index == KEY_CACHE_NOT_CACHED) {
+		status = rsa_mbedtls_load_pubkey (&rsa, key);
+		if (status != 0) {
+			debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
+				CRYPTO_LOG_MSG_MBEDTLS_RSA_PUBKEY_LOAD_EC, status, 0);
+			return status;
+		}
+	}
+	else if (ROT_IS_ERROR (index)) {
+		mbedtls_rsa_free (&rsa);
+		return index;
+	}
+	else if (status != 0) {
+		mbedtls_rsa_free (&rsa);
+		return RSA_ENGINE_NO_MEMORY;
+	}
+
+	status = rsa_mbedtls_pkcs1_verify (&rsa, signature, match_type, match, match_length);
+
+	if (index == KEY_CACHE_NOT_CACHED) {
+		/* Add the key after verification so the cached copy includes the Montgomery constants. */
+		rsa_mbedtls_add_cached_key (mbedtls, id, &rsa);
+	}
+
+	mbedtls_rsa_free (&rsa);
+	return status;
+}
+
 static int rsa_mbedtls_sig_verify (struct rsa_engine *engine, const struct rsa_public_key *key,
 	const uint8_t *signature, size_t sig_length, enum hash_type sig_hash, const uint8_t *match,
 	size_t match_length)
 {
+	struct rsa_engine_mbedtls *mbedtls = (struct rsa_engine_mbedtls*) engine;
 	mbedtls_rsa_context rsa;
 	mbedtls_md_type_t match_type;
 	int status;
@@ -428,6 +610,11 @@ static int rsa_mbedtls_sig_verify (struct rsa_engine *engine, const struct rsa_p
 		return RSA_ENGINE_BAD_SIGNATURE;
 	}
 
+	if (mbedtls->key_cache != NULL) {
+		return rsa_mbedtls_sig_verify_cached_key (mbedtls, key, signature, match_type, match,
+			match_length);
+	}
+
 	status = rsa_mbedtls_load_pubkey (&rsa, key);
 	if (status != 0) {
 		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
@@ -435,20 +622,7 @@ static int rsa_mbedtls_sig_verify (struct rsa_engine *engine, const struct rsa_p
 		return status;
 	}
 
-	status = mbedtls_rsa_pkcs1_verify (&rsa, NULL, NULL, MBEDTLS_RSA_PUBLIC, match_type,
-		match_length, match, signature);
-	if (status != 0) {
-		debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_CRYPTO,
-			CRYPTO_LOG_MSG_MBEDTLS_RSA_PKCS1_VERIFY_EC, status, 0);
-
-		if ((status == MBEDTLS_ERR_MPI_ALLOC_FAILED) ||
-			(status == (MBEDTLS_ERR_MPI_ALLOC_FAILED + MBEDTLS_ERR_RSA_PUBLIC_FAILED))) {
-			status = RSA_ENGINE_NO_MEMORY;
-		}
-		else {
-			status = RSA_ENGINE_BAD_SIGNATURE;
-		}
-	}
+	status = rsa_mbedtls_pkcs1_verify (&rsa, signature, match_type, match, match_length);
 
 	mbedtls_rsa_free (&rsa);
 	return status;
@@ -495,6 +669,11 @@ int rsa_mbedtls_init (struct rsa_engine_mbedtls *engine)
 #endif
 	engine->base.sig_verify = rsa_mbedtls_sig_verify;
 
+	status = platform_mutex_init (&engine->cache_lock);
+	if (status != 0) {
+		goto exit;
+	}
+
 	return 0;
 
 exit:
@@ -503,6 +682,43 @@ exit:
 	return status;
 }
 
+/**
+ * Initialize an mbedTLS RSA engine that caches prepared public keys.  Signature verification with a
+ * key that is in the cache does not need to parse and validate the key again.
+ *
+ * @param engine The RSA engine to initialize.
+ * @param cache The cache to use for tracking prepared keys.  The cache state will be initialized
+ * by the engine and the cache must not be shared with any other component.
+ * @param prepared Storage for the prepared keys.  There must be one entry for each entry in the key
+ * cache.
+ *
+ * @return 0 if the RSA engine was successfully initialize or an error code.
+ */
+int rsa_mbedtls_init_with_key_cache (struct rsa_engine_mbedtls *engine,
+	const struct key_cache *cache, mbedtls_rsa_context *prepared)
+{
+	int status;
+
+	if ((cache == NULL) || (prepared == NULL)) {
+		return RSA_ENGINE_INVALID_ARGUMENT;
+	}
+
+	status = key_cache_init_state (cache);
+	if (status != 0) {
+		return status;
+	}
+
+	status = rsa_mbedtls_init (engine);
+	if (status != 0) {
+		return status;
+	}
+
+	engine->key_cache = cache;
+	engine->prepared = prepared;
+
+	return 0;
+}
+
 /**
  * Release the resources used by an mbedTLS RSA engine.
  *
@@ -510,7 +726,20 @@ exit:
  */
 void rsa_mbedtls_release (struct rsa_engine_mbedtls *engine)
 {
+	size_t i;
+
 	if (engine) {
+		if (engine->key_cache != NULL) {
+			for (i = 0; i < engine->key_cache->count; i++) {
+				if (key_cache_is_entry_valid (engine->key_cache, i)) {
+					mbedtls_rsa_free (&engine->prepared[i]);
+				}
+			}
+
+			key_cache_release (engine->key_cache);
+		}
+
+		platform_mutex_free (&engine->cache_lock);
 		mbedtls_entropy_free (&engine->entropy);
 		mbedtls_ctr_drbg_free (&engine->ctr_drbg);
 	}
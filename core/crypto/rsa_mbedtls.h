@@ -5,8 +5,11 @@
 #define RSA_MBEDTLS_H_
 
 #include "rsa.h"
+#include "platform_api.h"
+#include "crypto/key_cache.h"
 #include "mbedtls/ctr_drbg.h"
 #include "mbedtls/entropy.h"
+#include "mbedtls/rsa.h"
 
 
 /**
@@ -16,10 +19,15 @@ struct rsa_engine_mbedtls {
 	struct rsa_engine base;				/**< The base RSA engine. */
 	mbedtls_ctr_drbg_context ctr_drbg;	/**< A random number generator for the engine. */
 	mbedtls_entropy_context entropy;	/**< Entropy source for the random number generator. */
+	const struct key_cache *key_cache;	/**< Optional cache of prepared public keys. */
+	mbedtls_rsa_context *prepared;		/**< Prepared public key context for each cache entry. */
+	platform_mutex cache_lock;			/**< Synchronization for the key cache. */
 };
 
 
 int rsa_mbedtls_init (struct rsa_engine_mbedtls *engine);
+int rsa_mbedtls_init_with_key_cache (struct rsa_engine_mbedtls *engine,
+	const struct key_cache *cache, mbedtls_rsa_context *prepared);
 void rsa_mbedtls_release (struct rsa_engine_mbedtls *engine);
 
 
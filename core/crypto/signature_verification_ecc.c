@@ -64,6 +64,58 @@ static int signature_verification_ecc_load_key (const struct signature_verificat
 	return status;
 }
 
+/**
+ * Get a prepared key from the key cache, loading it into the cache if necessary.
+ *
+ * @param ecdsa The verification context with the key cache.
+ * @param key The DER encoded key to load.  This can represent either a public or private key.
+ * @param length Length of the key.
+ * @param pub_key Output for the prepared public key.  This key is owned by the cache and must not
+ * be released by the caller.
+ *
+ * @return 0 if the key was loaded successfully or an error code.
+ */
+static int signature_verification_ecc_load_cached_key (
+	const struct signature_verification_ecc *ecdsa, const uint8_t *key, size_t length,
+	struct ecc_public_key *pub_key)
+{
+	uint8_t id[KEY_CACHE_ID_LENGTH];
+	bool evicted;
+	int index;
+	int status;
+
+	status = hash_calculate (ecdsa->hash, HASH_TYPE_SHA256, key, length, id, sizeof (id));
+	if (ROT_IS_ERROR (status)) {
+		return status;
+	}
+
+	index = key_cache_find (ecdsa->key_cache, id);
+	if (index == KEY_CACHE_NOT_CACHED) {
+		index = key_cache_add (ecdsa->key_cache, id, &evicted);
+		if (ROT_IS_ERROR (index)) {
+			return index;
+		}
+
+		if (evicted) {
+			ecdsa->ecc->release_key_pair (ecdsa->ecc, NULL, &ecdsa->cached_keys[index]);
+		}
+
+		status = signature_verification_ecc_load_key (ecdsa, key, length,
+			&ecdsa->cached_keys[index]);
+		if (status != 0) {
+			key_cache_remove (ecdsa->key_cache, index);
+			return status;
+		}
+	}
+	else if (ROT_IS_ERROR (index)) {
+		return index;
+	}
+
+	*pub_key = ecdsa->cached_keys[index];
+
+	return 0;
+}
+
 int signature_verification_ecc_set_verification_key (
 	const struct signature_verification *verification, const uint8_t *key, size_t length)
 {
@@ -76,12 +128,24 @@ int signature_verification_ecc_set_verification_key (
 	}
 
 	if (ecdsa->state->key_valid) {
-		ecdsa->ecc->release_key_pair (ecdsa->ecc, NULL, &ecdsa->state->key);
+		if (!ecdsa->state->key_cached) {
+			ecdsa->ecc->release_key_pair (ecdsa->ecc, NULL, &ecdsa->state->key);
+		}
+
 		ecdsa->state->key_valid = false;
+		ecdsa->state->key_cached = false;
 	}
 
 	if (key != NULL) {
-		status = signature_verification_ecc_load_key (ecdsa, key, length, &ecdsa->state->key);
+		if (ecdsa->key_cache != NULL) {
+			status = signature_verification_ecc_load_cached_key (ecdsa, key, length,
+				&ecdsa->state->key);
+			ecdsa->state->key_cached = (status == 0);
+		}
+		else {
+			status = signature_verification_ecc_load_key (ecdsa, key, length, &ecdsa->state->key);
+		}
+
 		if (status == 0) {
 			ecdsa->state->key_valid = true;
 		}
@@ -96,12 +160,25 @@ int signature_verification_ecc_is_key_valid (const struct signature_verification
 	const struct signature_verification_ecc *ecdsa =
 		(const struct signature_verification_ecc*) verification;
 	struct ecc_public_key pub_key;
+	uint8_t id[KEY_CACHE_ID_LENGTH];
 	int status;
 
 	if ((ecdsa == NULL) || (key == NULL) || (length == 0)) {
 		return SIG_VERIFICATION_INVALID_ARGUMENT;
 	}
 
+	if (ecdsa->key_cache != NULL) {
+		/* A key in the cache has already been successfully loaded. */
+		status = hash_calculate (ecdsa->hash, HASH_TYPE_SHA256, key, length, id, sizeof (id));
+		if (ROT_IS_ERROR (status)) {
+			return status;
+		}
+
+		if (!ROT_IS_ERROR (key_cache_find (ecdsa->key_cache, id))) {
+			return 0;
+		}
+	}
+
 	status = signature_verification_ecc_load_key (ecdsa, key, length, &pub_key);
 	if (status == 0) {
 		ecdsa->ecc->release_key_pair (ecdsa->ecc, NULL, &pub_key);
@@ -137,6 +214,48 @@ int signature_verification_ecc_init (struct signature_verification_ecc *verifica
 	return signature_verification_ecc_init_state (verification, key, length);
 }
 
+/**
+ * Initialize ECDSA signature verification that caches prepared verification keys.  Setting a key
+ * that is already in the cache does not require the key to be decoded again.
+ *
+ * @param verification The verification instance to initialize.
+ * @param state Variable context for verification.  This must be uninitialized.
+ * @param ecc The ECC engine to use for ECDSA verification.
+ * @param cache The cache to use for tracking prepared keys.  The cache state will be initialized
+ * by the verification instance and the cache must not be shared with any other component.
+ * @param cached_keys Storage for the prepared keys.  There must be one entry for each entry in the
+ * key cache.
+ * @param hash The hash engine to use for identifying cached keys.
+ * @param key An optional key to use for verification operations.  If provided, this must be a DER
+ * encoded ECC public or private key.  Set this to null if no key should be configured.
+ * @param length The length of the ECC key, if one is provided.  This argument is ignored if the key
+ * is null.
+ *
+ * @return 0 if the verification instance was successfully initialized or an error code.
+ */
+int signature_verification_ecc_init_with_key_cache (struct signature_verification_ecc *verification,
+	struct signature_verification_ecc_state *state, struct ecc_engine *ecc,
+	const struct key_cache *cache, struct ecc_public_key *cached_keys, struct hash_engine *hash,
+	const uint8_t *key, size_t length)
+{
+	int status;
+
+	if ((cache == NULL) || (cached_keys == NULL) || (hash == NULL)) {
+		return SIG_VERIFICATION_INVALID_ARGUMENT;
+	}
+
+	status = signature_verification_ecc_init_api (verification, state, ecc);
+	if (status != 0) {
+		return status;
+	}
+
+	verification->key_cache = cache;
+	verification->cached_keys = cached_keys;
+	verification->hash = hash;
+
+	return signature_verification_ecc_init_state (verification, key, length);
+}
+
 /**
  * Initialize the API and static contents of an ECDSA signature verification instance.  The result
  * of the call is the same as static initialization, except parameter validation is performed.
@@ -187,12 +306,26 @@ int signature_verification_ecc_init_api (struct signature_verification_ecc *veri
 int signature_verification_ecc_init_state (const struct signature_verification_ecc *verification,
 	const uint8_t *key, size_t length)
 {
+	int status;
+
 	if ((verification == NULL) || (verification->state == NULL) || (verification->ecc == NULL)) {
 		return SIG_VERIFICATION_INVALID_ARGUMENT;
 	}
 
+	if ((verification->key_cache != NULL) &&
+		((verification->cached_keys == NULL) || (verification->hash == NULL))) {
+		return SIG_VERIFICATION_INVALID_ARGUMENT;
+	}
+
 	memset (verification->state, 0, sizeof (struct signature_verification_ecc_state));
 
+	if (verification->key_cache != NULL) {
+		status = key_cache_init_state (verification->key_cache);
+		if (status != 0) {
+			return status;
+		}
+	}
+
 	return signature_verification_ecc_set_verification_key (&verification->base, key, length);
 }
 
@@ -203,7 +336,23 @@ int signature_verification_ecc_init_state (const struct signature_verification_e
  */
 void signature_verification_ecc_release (const struct signature_verification_ecc *verification)
 {
-	if (verification && verification->state->key_valid) {
-		verification->ecc->release_key_pair (verification->ecc, NULL, &verification->state->key);
+	size_t i;
+
+	if (verification) {
+		if (verification->state->key_valid && !verification->state->key_cached) {
+			verification->ecc->release_key_pair (verification->ecc, NULL,
+				&verification->state->key);
+		}
+
+		if (verification->key_cache != NULL) {
+			for (i = 0; i < verification->key_cache->count; i++) {
+				if (key_cache_is_entry_valid (verification->key_cache, i)) {
+					verification->ecc->release_key_pair (verification->ecc, NULL,
+						&verification->cached_keys[i]);
+				}
+			}
+
+			key_cache_release (verification->key_cache);
+		}
 	}
 }
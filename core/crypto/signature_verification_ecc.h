@@ -8,6 +8,8 @@
 #include <stddef.h>
 #include <stdbool.h>
 #include "ecc.h"
+#include "hash.h"
+#include "key_cache.h"
 #include "signature_verification.h"
 
 
@@ -17,6 +19,7 @@
 struct signature_verification_ecc_state {
 	struct ecc_public_key key;				/**< Public key for signature verification. */
 	bool key_valid;							/**< Indication that there is a key for verification. */
+	bool key_cached;						/**< Indication that the key is owned by the key cache. */
 };
 
 /**
@@ -26,12 +29,19 @@ struct signature_verification_ecc {
 	struct signature_verification base;				/**< Base verification instance. */
 	struct signature_verification_ecc_state *state;	/**< Variable context for verification. */
 	struct ecc_engine *ecc;							/**< ECC engine to use for verification. */
+	const struct key_cache *key_cache;				/**< Optional cache of prepared verification keys. */
+	struct ecc_public_key *cached_keys;				/**< Prepared key for each cache entry. */
+	struct hash_engine *hash;						/**< Hash engine to identify cached keys. */
 };
 
 
 int signature_verification_ecc_init (struct signature_verification_ecc *verification,
 	struct signature_verification_ecc_state *state, struct ecc_engine *ecc, const uint8_t *key,
 	size_t length);
+int signature_verification_ecc_init_with_key_cache (struct signature_verification_ecc *verification,
+	struct signature_verification_ecc_state *state, struct ecc_engine *ecc,
+	const struct key_cache *cache, struct ecc_public_key *cached_keys, struct hash_engine *hash,
+	const uint8_t *key, size_t length);
 int signature_verification_ecc_init_api (struct signature_verification_ecc *verification,
 	struct signature_verification_ecc_state *state, struct ecc_engine *ecc);
 int signature_verification_ecc_init_state (const struct signature_verification_ecc *verification,
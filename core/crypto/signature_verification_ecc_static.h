@@ -40,5 +40,28 @@ int signature_verification_ecc_is_key_valid (const struct signature_verification
 		.ecc = ecc_ptr \
 	}
 
+/**
+ * Initialize a static instance for ECDSA signature verification that caches prepared verification
+ * keys.  This can be a constant instance.
+ *
+ * There is no validation done on the arguments.
+ *
+ * @param state_ptr Variable context for the verification.
+ * @param ecc_ptr The ECC engine to use for ECDSA verification.
+ * @param cache_ptr The cache to use for tracking prepared keys.  This must not be shared with any
+ * other component.
+ * @param keys_ptr Storage for the prepared keys, one for each entry in the key cache.
+ * @param hash_ptr The hash engine to use for identifying cached keys.
+ */
+#define	signature_verification_ecc_static_init_with_key_cache(state_ptr, ecc_ptr, cache_ptr, \
+	keys_ptr, hash_ptr)	{ \
+		.base = SIGNATURE_VERIFICATION_ECC_API_INIT, \
+		.state = state_ptr, \
+		.ecc = ecc_ptr, \
+		.key_cache = cache_ptr, \
+		.cached_keys = keys_ptr, \
+		.hash = hash_ptr \
+	}
+
 
 #endif /* SIGNATURE_VERIFICATION_ECC_STATIC_H_ */
@@ -26,6 +26,7 @@ enum {
 	FLASH_CMD_RDSR3 = 0x15,				/**< Read status register 3 (configuration register) */
 	FLASH_CMD_4K_ERASE = 0x20,			/**< Sector erase 4kB */
 	FLASH_CMD_4BYTE_4K_ERASE = 0x21,	/**< Sector erase 4kB with 4 byte address */
+	FLASH_CMD_RDSCUR = 0x2b,			/**< Read security register */
 	FLASH_CMD_WRSR2 = 0x31,				/**< Write status register 2 */
 	FLASH_CMD_RDSR2 = 0x35,				/**< Read status register 2 */
 	FLASH_CMD_DUAL_READ = 0x3b,			/**< Dual output read */
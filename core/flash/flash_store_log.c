@@ -0,0 +1,1094 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include "flash_store_log.h"
+#include "flash_util.h"
+
+
+/**
+ * Index address indicating there is no record stored for a block ID.
+ */
+#define	FLASH_STORE_LOG_NO_RECORD			0xffffffff
+
+/**
+ * Maximum value for the block count or data length, limited by the record header.
+ */
+#define	FLASH_STORE_LOG_MAX_FIELD			0xffff
+
+/**
+ * Number of free sectors that background garbage collection will try to maintain.
+ */
+#define	FLASH_STORE_LOG_MIN_FREE_SECTORS	2
+
+/**
+ * Size of the buffer used to relocate records during garbage collection.
+ */
+#define	FLASH_STORE_LOG_COPY_BUFFER			64
+
+
+/**
+ * Get the flash address of a sector managed by the log.
+ *
+ * @param store The log storage.
+ * @param sector The sector index.
+ *
+ * @return The sector address.
+ */
+static uint32_t flash_store_log_sector_addr (const struct flash_store_log *store, uint32_t sector)
+{
+	return store->base_addr + (sector * store->state->sector_size);
+}
+
+/**
+ * Get the sector that contains a flash address.
+ *
+ * @param store The log storage.
+ * @param addr The flash address.
+ *
+ * @return The sector index.
+ */
+static uint32_t flash_store_log_get_sector (const struct flash_store_log *store, uint32_t addr)
+{
+	return (addr - store->base_addr) / store->state->sector_size;
+}
+
+/**
+ * Get the total flash space needed for a record.
+ *
+ * @param store The log storage.
+ * @param type The type of record.
+ * @param length Length of the record data.
+ *
+ * @return The length of the record.
+ */
+static uint32_t flash_store_log_record_length (const struct flash_store_log *store, uint8_t type,
+	size_t length)
+{
+	uint32_t rec_len = sizeof (struct flash_store_log_record_header);
+
+	if (type == FLASH_STORE_LOG_RECORD_DATA) {
+		rec_len += length;
+		if (store->hash) {
+			rec_len += SHA256_HASH_LENGTH;
+		}
+	}
+
+	return rec_len;
+}
+
+/**
+ * Determine if a block ID has data stored.
+ *
+ * @param entry The index entry for the block ID.
+ *
+ * @return true if there is data for the block or false if not.
+ */
+static bool flash_store_log_has_data (const struct flash_store_log_index *entry)
+{
+	return ((entry->addr != FLASH_STORE_LOG_NO_RECORD) && !entry->erased);
+}
+
+/**
+ * Determine if a sector is the oldest sector in the log.
+ *
+ * @param store The log storage.
+ * @param sector The sector to check.
+ *
+ * @return true if no other sector has older records.
+ */
+static bool flash_store_log_is_oldest (const struct flash_store_log *store, uint32_t sector)
+{
+	uint32_t i;
+
+	for (i = 0; i < store->sector_count; i++) {
+		if ((store->sectors[i].sequence != 0) &&
+			(store->sectors[i].sequence < store->sectors[sector].sequence)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * Determine the amount of flash space needed to preserve the current records in a sector.
+ *
+ * @param store The log storage.
+ * @param sector The sector to check.
+ * @param drop_erased Flag indicating if records marking data as erased can be discarded.
+ *
+ * @return The total length of records that need to be preserved.
+ */
+static uint32_t flash_store_log_get_live_length (const struct flash_store_log *store,
+	uint32_t sector, bool drop_erased)
+{
+	const struct flash_store_log_index *entry;
+	uint32_t live = 0;
+	uint32_t i;
+
+	for (i = 0; i < store->block_count; i++) {
+		entry = &store->index[i];
+		if ((entry->addr != FLASH_STORE_LOG_NO_RECORD) &&
+			(flash_store_log_get_sector (store, entry->addr) == sector)) {
+			if (!entry->erased) {
+				live += flash_store_log_record_length (store, FLASH_STORE_LOG_RECORD_DATA,
+					entry->length);
+			}
+			else if (!drop_erased) {
+				live += flash_store_log_record_length (store, FLASH_STORE_LOG_RECORD_ERASE, 0);
+			}
+		}
+	}
+
+	return live;
+}
+
+/**
+ * Start using a free sector as the head of the log.  The sector will be erased, if necessary, and
+ * given a sequence number newer than any other sector.
+ *
+ * @param store The log storage.
+ * @param sector The free sector to start using.
+ *
+ * @return 0 if the sector is ready for new records or an error code.
+ */
+static int flash_store_log_start_sector (const struct flash_store_log *store, uint32_t sector)
+{
+	struct flash_store_log_sector_header header;
+	uint32_t addr = flash_store_log_sector_addr (store, sector);
+	int status;
+
+	if (!store->sectors[sector].blank) {
+		status = flash_sector_erase_region (store->flash, addr, store->state->sector_size);
+		if (status != 0) {
+			return status;
+		}
+	}
+
+	store->sectors[sector].blank = false;
+
+	header.sequence = store->state->next_sequence;
+	header.magic = FLASH_STORE_LOG_SECTOR_MAGIC;
+
+	status = flash_write_and_verify (store->flash, addr, (uint8_t*) &header, sizeof (header));
+	if (status != 0) {
+		return status;
+	}
+
+	store->sectors[sector].sequence = store->state->next_sequence++;
+	store->sectors[sector].used = 0;
+	store->state->head = sector;
+	store->state->write_offset = sizeof (header);
+
+	return 0;
+}
+
+/**
+ * Mark a record as completely written and update the index to point to it.
+ *
+ * @param store The log storage.
+ * @param addr Address of the record header.
+ * @param header The record header.
+ *
+ * @return 0 if the record was committed or an error code.
+ */
+static int flash_store_log_commit_record (const struct flash_store_log *store, uint32_t addr,
+	const struct flash_store_log_record_header *header)
+{
+	uint8_t commit = FLASH_STORE_LOG_RECORD_COMMITTED;
+	int status;
+
+	status = flash_write_and_verify (store->flash,
+		addr + offsetof (struct flash_store_log_record_header, commit), &commit, sizeof (commit));
+	if (status != 0) {
+		return status;
+	}
+
+	store->index[header->id].addr = addr;
+	store->index[header->id].length = header->length;
+	store->index[header->id].erased = (header->type == FLASH_STORE_LOG_RECORD_ERASE);
+
+	return 0;
+}
+
+/**
+ * Start a new record at the head of the log.  Space for the entire record is consumed by this
+ * call, even if the header cannot be written.  The caller must ensure there is enough space.
+ *
+ * @param store The log storage.
+ * @param header The record header to write.
+ * @param addr Output for the address of the record.
+ *
+ * @return 0 if the record header was written or an error code.
+ */
+static int flash_store_log_start_record (const struct flash_store_log *store,
+	const struct flash_store_log_record_header *header, uint32_t *addr)
+{
+	uint32_t rec_len = flash_store_log_record_length (store, header->type, header->length);
+
+	*addr = flash_store_log_sector_addr (store, store->state->head) + store->state->write_offset;
+	store->state->write_offset += rec_len;
+	store->sectors[store->state->head].used += rec_len;
+
+	return flash_write_and_verify (store->flash, *addr, (const uint8_t*) header,
+		sizeof (*header));
+}
+
+/**
+ * Append a new record to the head of the log.  The caller must ensure there is enough space.
+ *
+ * @param store The log storage.
+ * @param type The type of record to write.
+ * @param id Block ID for the record.
+ * @param data Data to store in the record.  Null for records with no data.
+ * @param length Length of the record data.
+ * @param hash Digest of the record data.  Null if no digest is stored.
+ *
+ * @return 0 if the record was written or an error code.
+ */
+static int flash_store_log_append_record (const struct flash_store_log *store, uint8_t type,
+	int id, const uint8_t *data, size_t length, const uint8_t *hash)
+{
+	struct flash_store_log_record_header header;
+	uint32_t addr;
+	int status;
+
+	memset (&header, 0xff, sizeof (header));
+	header.marker = FLASH_STORE_LOG_RECORD_MARKER;
+	header.type = type;
+	header.id = id;
+	header.length = length;
+
+	status = flash_store_log_start_record (store, &header, &addr);
+	if (status != 0) {
+		return status;
+	}
+
+	if (data) {
+		status = flash_write_and_verify (store->flash, addr + sizeof (header), data, length);
+		if (status != 0) {
+			return status;
+		}
+	}
+
+	if (hash) {
+		status = flash_write_and_verify (store->flash, addr + sizeof (header) + length, hash,
+			SHA256_HASH_LENGTH);
+		if (status != 0) {
+			return status;
+		}
+	}
+
+	return flash_store_log_commit_record (store, addr, &header);
+}
+
+/**
+ * Copy the current record for a block ID to the head of the log.  The caller must ensure there is
+ * enough space.
+ *
+ * @param store The log storage.
+ * @param id The block ID to relocate.
+ *
+ * @return 0 if the record was copied or an error code.
+ */
+static int flash_store_log_relocate_record (const struct flash_store_log *store, int id)
+{
+	const struct flash_store_log_index *entry = &store->index[id];
+	struct flash_store_log_record_header header;
+	uint8_t buffer[FLASH_STORE_LOG_COPY_BUFFER];
+	uint32_t addr;
+	uint32_t src;
+	uint32_t dest;
+	size_t remain;
+	size_t copy;
+	int status;
+
+	memset (&header, 0xff, sizeof (header));
+	header.marker = FLASH_STORE_LOG_RECORD_MARKER;
+	header.type = (entry->erased) ? FLASH_STORE_LOG_RECORD_ERASE : FLASH_STORE_LOG_RECORD_DATA;
+	header.id = id;
+	header.length = entry->length;
+
+	src = entry->addr + sizeof (header);
+	remain = flash_store_log_record_length (store, header.type, header.length) - sizeof (header);
+
+	status = flash_store_log_start_record (store, &header, &addr);
+	if (status != 0) {
+		return status;
+	}
+
+	dest = addr + sizeof (header);
+	while (remain != 0) {
+		copy = (remain > sizeof (buffer)) ? sizeof (buffer) : remain;
+
+		status = store->flash->read (store->flash, src, buffer, copy);
+		if (status != 0) {
+			return status;
+		}
+
+		status = flash_write_and_verify (store->flash, dest, buffer, copy);
+		if (status != 0) {
+			return status;
+		}
+
+		src += copy;
+		dest += copy;
+		remain -= copy;
+	}
+
+	store->state->stats.records_relocated++;
+
+	return flash_store_log_commit_record (store, addr, &header);
+}
+
+/**
+ * Reclaim a sector by copying any current records to the head of the log and erasing it.
+ *
+ * @param store The log storage.
+ * @param sector The sector to reclaim.  This cannot be the head of the log.
+ *
+ * @return 0 if the sector was reclaimed or an error code.
+ */
+static int flash_store_log_collect_sector (const struct flash_store_log *store, uint32_t sector)
+{
+	struct flash_store_log_index *entry;
+	bool drop_erased = flash_store_log_is_oldest (store, sector);
+	uint32_t live;
+	uint32_t i;
+	int status;
+
+	live = flash_store_log_get_live_length (store, sector, drop_erased);
+	if ((store->state->write_offset + live) > store->state->sector_size) {
+		return FLASH_STORE_INSUFFICIENT_STORAGE;
+	}
+
+	for (i = 0; i < store->block_count; i++) {
+		entry = &store->index[i];
+		if ((entry->addr != FLASH_STORE_LOG_NO_RECORD) &&
+			(flash_store_log_get_sector (store, entry->addr) == sector)) {
+			if (entry->erased && drop_erased) {
+				/* There are no older sectors, so there is no data this record needs to hide. */
+				entry->addr = FLASH_STORE_LOG_NO_RECORD;
+			}
+			else {
+				status = flash_store_log_relocate_record (store, i);
+				if (status != 0) {
+					return status;
+				}
+			}
+		}
+	}
+
+	status = flash_sector_erase_region (store->flash, flash_store_log_sector_addr (store, sector),
+		store->state->sector_size);
+	if (status != 0) {
+		return status;
+	}
+
+	store->sectors[sector].sequence = 0;
+	store->sectors[sector].used = 0;
+	store->sectors[sector].blank = true;
+	store->state->stats.sectors_collected++;
+
+	return 0;
+}
+
+/**
+ * Ensure there is enough space in the head sector for a new record.  If necessary, the head of the
+ * log will move to the next sector, and the sector after that will be reclaimed so that there is
+ * always a free sector available.
+ *
+ * @param store The log storage.
+ * @param rec_len Length of the record that needs to be written.
+ *
+ * @return 0 if there is space for the record or an error code.
+ */
+static int flash_store_log_reserve (const struct flash_store_log *store, uint32_t rec_len)
+{
+	uint32_t next;
+	uint32_t attempts = 0;
+	int status;
+
+	while ((store->state->write_offset + rec_len) > store->state->sector_size) {
+		if (attempts++ > store->sector_count) {
+			return FLASH_STORE_INSUFFICIENT_STORAGE;
+		}
+
+		next = (store->state->head + 1) % store->sector_count;
+		if (store->sectors[next].sequence != 0) {
+			status = flash_store_log_collect_sector (store, next);
+			if (status != 0) {
+				return status;
+			}
+		}
+
+		status = flash_store_log_start_sector (store, next);
+		if (status != 0) {
+			return status;
+		}
+
+		next = (next + 1) % store->sector_count;
+		if (store->sectors[next].sequence != 0) {
+			status = flash_store_log_collect_sector (store, next);
+			if (status != 0) {
+				return status;
+			}
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * Scan all records in a sector and update the index with any committed records.
+ *
+ * @param store The log storage.
+ * @param sector The sector to scan.
+ *
+ * @return 0 if the sector was scanned successfully or an error code.
+ */
+static int flash_store_log_scan_sector (const struct flash_store_log *store, uint32_t sector)
+{
+	struct flash_store_log_record_header header;
+	uint32_t addr = flash_store_log_sector_addr (store, sector);
+	uint32_t offset = sizeof (struct flash_store_log_sector_header);
+	uint32_t rec_len;
+	int status;
+
+	while ((offset + sizeof (header)) <= store->state->sector_size) {
+		status = store->flash->read (store->flash, addr + offset, (uint8_t*) &header,
+			sizeof (header));
+		if (status != 0) {
+			return status;
+		}
+
+		if (header.marker == 0xff) {
+			break;
+		}
+
+		if ((header.marker != FLASH_STORE_LOG_RECORD_MARKER) ||
+			((header.type != FLASH_STORE_LOG_RECORD_DATA) &&
+				(header.type != FLASH_STORE_LOG_RECORD_ERASE)) ||
+			(header.length > store->max_length)) {
+			/* The header was not completely written, so the end of the record is not known.  Don't
+			 * use the rest of the sector. */
+			offset = store->state->sector_size;
+			break;
+		}
+
+		rec_len = flash_store_log_record_length (store, header.type, header.length);
+		if ((offset + rec_len) > store->state->sector_size) {
+			offset = store->state->sector_size;
+			break;
+		}
+
+		/* Records that were not completely written are skipped, leaving the previous record for the
+		 * block ID as the current data. */
+		if ((header.commit == FLASH_STORE_LOG_RECORD_COMMITTED) && (header.id < store->block_count)) {
+			store->index[header.id].addr = addr + offset;
+			store->index[header.id].length = header.length;
+			store->index[header.id].erased = (header.type == FLASH_STORE_LOG_RECORD_ERASE);
+		}
+
+		offset += rec_len;
+	}
+
+	store->sectors[sector].used = offset - sizeof (struct flash_store_log_sector_header);
+	if (sector == store->state->head) {
+		store->state->write_offset = offset;
+	}
+
+	return 0;
+}
+
+/**
+ * Rebuild the index for all data stored in the log.
+ *
+ * @param store The log storage.
+ *
+ * @return 0 if the log was loaded successfully or an error code.
+ */
+static int flash_store_log_mount (const struct flash_store_log *store)
+{
+	struct flash_store_log_sector_header header;
+	uint32_t last = 0;
+	uint32_t next;
+	uint32_t i;
+	int status;
+
+	for (i = 0; i < store->block_count; i++) {
+		store->index[i].addr = FLASH_STORE_LOG_NO_RECORD;
+	}
+
+	for (i = 0; i < store->sector_count; i++) {
+		status = store->flash->read (store->flash, flash_store_log_sector_addr (store, i),
+			(uint8_t*) &header, sizeof (header));
+		if (status != 0) {
+			return status;
+		}
+
+		if ((header.magic == FLASH_STORE_LOG_SECTOR_MAGIC) && (header.sequence != 0) &&
+			(header.sequence != 0xffffffff)) {
+			store->sectors[i].sequence = header.sequence;
+			if (header.sequence >= store->state->next_sequence) {
+				store->state->next_sequence = header.sequence + 1;
+				store->state->head = i;
+			}
+		}
+	}
+
+	if (store->state->next_sequence == 0) {
+		store->state->next_sequence = 1;
+
+		return flash_store_log_start_sector (store, 0);
+	}
+
+	/* Replay the sectors from oldest to newest so the index references the latest records. */
+	do {
+		next = store->sector_count;
+		for (i = 0; i < store->sector_count; i++) {
+			if ((store->sectors[i].sequence > last) &&
+				((next == store->sector_count) ||
+					(store->sectors[i].sequence < store->sectors[next].sequence))) {
+				next = i;
+			}
+		}
+
+		if (next != store->sector_count) {
+			status = flash_store_log_scan_sector (store, next);
+			if (status != 0) {
+				return status;
+			}
+
+			last = store->sectors[next].sequence;
+		}
+	} while (next != store->sector_count);
+
+	/* If power was lost while reclaiming a sector, finish the operation so a free sector is
+	 * available for the log to move into. */
+	next = (store->state->head + 1) % store->sector_count;
+	if (store->sectors[next].sequence != 0) {
+		return flash_store_log_collect_sector (store, next);
+	}
+
+	return 0;
+}
+
+/**
+ * Check that a block ID is valid for the log.
+ *
+ * @param store The log storage.
+ * @param id The block ID to check.
+ *
+ * @return 0 if the ID is valid or an error code.
+ */
+static int flash_store_log_check_id (const struct flash_store_log *store, int id)
+{
+	if ((id < 0) || ((uint32_t) id >= store->block_count)) {
+		return FLASH_STORE_UNSUPPORTED_ID;
+	}
+
+	return 0;
+}
+
+int flash_store_log_write (const struct flash_store *flash_store, int id, const uint8_t *data,
+	size_t length)
+{
+	const struct flash_store_log *store = (const struct flash_store_log*) flash_store;
+	uint8_t hash[SHA256_HASH_LENGTH];
+	uint8_t *digest = NULL;
+	int status;
+
+	if ((store == NULL) || (data == NULL) || (length == 0)) {
+		return FLASH_STORE_INVALID_ARGUMENT;
+	}
+
+	status = flash_store_log_check_id (store, id);
+	if (status != 0) {
+		return status;
+	}
+
+	if (length > store->max_length) {
+		return FLASH_STORE_BAD_DATA_LENGTH;
+	}
+
+	if (store->hash) {
+		status = store->hash->calculate_sha256 (store->hash, data, length, hash, sizeof (hash));
+		if (status != 0) {
+			return status;
+		}
+
+		digest = hash;
+	}
+
+	platform_mutex_lock (&store->state->lock);
+
+	status = flash_store_log_reserve (store,
+		flash_store_log_record_length (store, FLASH_STORE_LOG_RECORD_DATA, length));
+	if (status == 0) {
+		status = flash_store_log_append_record (store, FLASH_STORE_LOG_RECORD_DATA, id, data,
+			length, digest);
+	}
+
+	platform_mutex_unlock (&store->state->lock);
+
+	return status;
+}
+
+int flash_store_log_read (const struct flash_store *flash_store, int id, uint8_t *data,
+	size_t length)
+{
+	const struct flash_store_log *store = (const struct flash_store_log*) flash_store;
+	struct flash_store_log_index entry;
+	uint8_t hash_flash[SHA256_HASH_LENGTH];
+	uint8_t hash_mem[SHA256_HASH_LENGTH];
+	int status;
+
+	if ((store == NULL) || (data == NULL)) {
+		return FLASH_STORE_INVALID_ARGUMENT;
+	}
+
+	status = flash_store_log_check_id (store, id);
+	if (status != 0) {
+		return status;
+	}
+
+	platform_mutex_lock (&store->state->lock);
+
+	entry = store->index[id];
+	if (!flash_store_log_has_data (&entry)) {
+		status = FLASH_STORE_NO_DATA;
+		goto exit;
+	}
+
+	if (length < entry.length) {
+		status = FLASH_STORE_BUFFER_TOO_SMALL;
+		goto exit;
+	}
+
+	entry.addr += sizeof (struct flash_store_log_record_header);
+	status = store->flash->read (store->flash, entry.addr, data, entry.length);
+	if (status != 0) {
+		goto exit;
+	}
+
+	if (store->hash) {
+		status = store->flash->read (store->flash, entry.addr + entry.length, hash_flash,
+			sizeof (hash_flash));
+		if (status != 0) {
+			goto exit;
+		}
+
+		status = store->hash->calculate_sha256 (store->hash, data, entry.length, hash_mem,
+			sizeof (hash_mem));
+		if (status != 0) {
+			goto exit;
+		}
+
+		if (memcmp (hash_mem, hash_flash, SHA256_HASH_LENGTH) != 0) {
+			status = FLASH_STORE_CORRUPT_DATA;
+			goto exit;
+		}
+	}
+
+	status = entry.length;
+
+exit:
+	platform_mutex_unlock (&store->state->lock);
+	return status;
+}
+
+int flash_store_log_erase (const struct flash_store *flash_store, int id)
+{
+	const struct flash_store_log *store = (const struct flash_store_log*) flash_store;
+	int status;
+
+	if (store == NULL) {
+		return FLASH_STORE_INVALID_ARGUMENT;
+	}
+
+	status = flash_store_log_check_id (store, id);
+	if (status != 0) {
+		return status;
+	}
+
+	platform_mutex_lock (&store->state->lock);
+
+	if (flash_store_log_has_data (&store->index[id])) {
+		status = flash_store_log_reserve (store,
+			flash_store_log_record_length (store, FLASH_STORE_LOG_RECORD_ERASE, 0));
+		if (status == 0) {
+			status = flash_store_log_append_record (store, FLASH_STORE_LOG_RECORD_ERASE, id, NULL,
+				0, NULL);
+		}
+	}
+
+	platform_mutex_unlock (&store->state->lock);
+
+	return status;
+}
+
+int flash_store_log_erase_all (const struct flash_store *flash_store)
+{
+	const struct flash_store_log *store = (const struct flash_store_log*) flash_store;
+	uint32_t i;
+	int status;
+
+	if (store == NULL) {
+		return FLASH_STORE_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&store->state->lock);
+
+	status = flash_sector_erase_region_and_verify (store->flash, store->base_addr,
+		store->state->sector_size * store->sector_count);
+
+	for (i = 0; i < store->block_count; i++) {
+		store->index[i].addr = FLASH_STORE_LOG_NO_RECORD;
+	}
+
+	for (i = 0; i < store->sector_count; i++) {
+		store->sectors[i].sequence = 0;
+		store->sectors[i].used = 0;
+		store->sectors[i].blank = (status == 0);
+	}
+
+	if (status == 0) {
+		/* Continue from the next sector in the rotation to avoid repeatedly using the first. */
+		status = flash_store_log_start_sector (store,
+			(store->state->head + 1) % store->sector_count);
+	}
+
+	platform_mutex_unlock (&store->state->lock);
+
+	return status;
+}
+
+int flash_store_log_get_data_length (const struct flash_store *flash_store, int id)
+{
+	const struct flash_store_log *store = (const struct flash_store_log*) flash_store;
+	int status;
+
+	if (store == NULL) {
+		return FLASH_STORE_INVALID_ARGUMENT;
+	}
+
+	status = flash_store_log_check_id (store, id);
+	if (status != 0) {
+		return status;
+	}
+
+	platform_mutex_lock (&store->state->lock);
+
+	if (flash_store_log_has_data (&store->index[id])) {
+		status = store->index[id].length;
+	}
+	else {
+		status = FLASH_STORE_NO_DATA;
+	}
+
+	platform_mutex_unlock (&store->state->lock);
+
+	return status;
+}
+
+int flash_store_log_has_data_stored (const struct flash_store *flash_store, int id)
+{
+	const struct flash_store_log *store = (const struct flash_store_log*) flash_store;
+	int status;
+
+	if (store == NULL) {
+		return FLASH_STORE_INVALID_ARGUMENT;
+	}
+
+	status = flash_store_log_check_id (store, id);
+	if (status != 0) {
+		return status;
+	}
+
+	platform_mutex_lock (&store->state->lock);
+	status = (flash_store_log_has_data (&store->index[id])) ? 1 : 0;
+	platform_mutex_unlock (&store->state->lock);
+
+	return status;
+}
+
+int flash_store_log_get_max_data_length (const struct flash_store *flash_store)
+{
+	const struct flash_store_log *store = (const struct flash_store_log*) flash_store;
+
+	if (store == NULL) {
+		return FLASH_STORE_INVALID_ARGUMENT;
+	}
+
+	return store->max_length;
+}
+
+int flash_store_log_get_flash_size (const struct flash_store *flash_store)
+{
+	const struct flash_store_log *store = (const struct flash_store_log*) flash_store;
+
+	if (store == NULL) {
+		return FLASH_STORE_INVALID_ARGUMENT;
+	}
+
+	return store->state->sector_size * store->sector_count;
+}
+
+int flash_store_log_get_num_blocks (const struct flash_store *flash_store)
+{
+	const struct flash_store_log *store = (const struct flash_store_log*) flash_store;
+
+	if (store == NULL) {
+		return FLASH_STORE_INVALID_ARGUMENT;
+	}
+
+	return store->block_count;
+}
+
+/**
+ * Initialize log-structured flash storage for variable length data blocks.
+ *
+ * @param store The flash storage to initialize.
+ * @param state Variable context for the flash storage.  This must be uninitialized.
+ * @param index Storage for the index of current records.  This must have block_count entries.
+ * @param sectors Storage for tracking the state of each sector.  This must have sector_count
+ * entries.
+ * @param flash The flash device used for storage.
+ * @param base_addr The address of the first sector used for the log.  This must be aligned to a
+ * flash sector.
+ * @param sector_count The number of flash sectors to use for the log.  At least two sectors are
+ * required.
+ * @param block_count The number of data blocks that can be stored.
+ * @param max_length The maximum length of data that can be stored in a single block.
+ * @param hash Optional hash engine to use for data validation.  If a hash engine is provided, data
+ * integrity is checked when reading.
+ *
+ * @return 0 if the flash storage was successfully initialized or an error code.
+ */
+int flash_store_log_init (struct flash_store_log *store, struct flash_store_log_state *state,
+	struct flash_store_log_index *index, struct flash_store_log_sector *sectors,
+	const struct flash *flash, uint32_t base_addr, size_t sector_count, size_t block_count,
+	size_t max_length, struct hash_engine *hash)
+{
+	if ((store == NULL) || (state == NULL) || (index == NULL) || (sectors == NULL) ||
+		(flash == NULL)) {
+		return FLASH_STORE_INVALID_ARGUMENT;
+	}
+
+	memset (store, 0, sizeof (struct flash_store_log));
+
+	store->base.write = flash_store_log_write;
+	store->base.read = flash_store_log_read;
+	store->base.erase = flash_store_log_erase;
+	store->base.erase_all = flash_store_log_erase_all;
+	store->base.get_data_length = flash_store_log_get_data_length;
+	store->base.has_data_stored = flash_store_log_has_data_stored;
+	store->base.get_max_data_length = flash_store_log_get_max_data_length;
+	store->base.get_flash_size = flash_store_log_get_flash_size;
+	store->base.get_num_blocks = flash_store_log_get_num_blocks;
+
+	store->state = state;
+	store->index = index;
+	store->sectors = sectors;
+	store->flash = flash;
+	store->hash = hash;
+	store->base_addr = base_addr;
+	store->sector_count = sector_count;
+	store->block_count = block_count;
+	store->max_length = max_length;
+
+	return flash_store_log_init_state (store);
+}
+
+/**
+ * Initialize only the variable state for log-structured flash storage.  The rest of the instance is
+ * assumed to have already been initialized.  The contents of flash will be scanned to find the
+ * current data for each block.
+ *
+ * This would generally be used with a statically initialized instance.
+ *
+ * @param store The flash storage that contains the state to initialize.
+ *
+ * @return 0 if the state was successfully initialized or an error code.
+ */
+int flash_store_log_init_state (const struct flash_store_log *store)
+{
+	uint32_t device_size;
+	uint32_t usable;
+	uint32_t max_record;
+	int status;
+
+	if ((store == NULL) || (store->state == NULL) || (store->index == NULL) ||
+		(store->sectors == NULL) || (store->flash == NULL)) {
+		return FLASH_STORE_INVALID_ARGUMENT;
+	}
+
+	if ((store->block_count == 0) || (store->max_length == 0)) {
+		return FLASH_STORE_NO_STORAGE;
+	}
+
+	if ((store->block_count > FLASH_STORE_LOG_MAX_FIELD) ||
+		(store->max_length > FLASH_STORE_LOG_MAX_FIELD)) {
+		return FLASH_STORE_BLOCK_TOO_LARGE;
+	}
+
+	if (store->sector_count < 2) {
+		return FLASH_STORE_INSUFFICIENT_STORAGE;
+	}
+
+	memset (store->state, 0, sizeof (struct flash_store_log_state));
+
+	status = store->flash->get_sector_size (store->flash, &store->state->sector_size);
+	if (status != 0) {
+		return status;
+	}
+
+	if (FLASH_REGION_OFFSET (store->base_addr, store->state->sector_size) != 0) {
+		return FLASH_STORE_STORAGE_NOT_ALIGNED;
+	}
+
+	status = store->flash->get_device_size (store->flash, &device_size);
+	if (status != 0) {
+		return status;
+	}
+
+	if (store->base_addr >= device_size) {
+		return FLASH_STORE_BAD_BASE_ADDRESS;
+	}
+
+	if ((store->state->sector_size * store->sector_count) > (device_size - store->base_addr)) {
+		return FLASH_STORE_INSUFFICIENT_STORAGE;
+	}
+
+	usable = store->state->sector_size - sizeof (struct flash_store_log_sector_header);
+	max_record = flash_store_log_record_length (store, FLASH_STORE_LOG_RECORD_DATA,
+		store->max_length);
+	if (max_record > usable) {
+		return FLASH_STORE_BLOCK_TOO_LARGE;
+	}
+
+	/* Every block must be able to hold maximum length data with one sector left free to reclaim
+	 * space, accounting for space at the end of each sector that is too small for a record. */
+	if (((uint64_t) store->block_count * max_record) >
+		((uint64_t) (store->sector_count - 1) * (usable - max_record))) {
+		return FLASH_STORE_INSUFFICIENT_STORAGE;
+	}
+
+	memset (store->index, 0, sizeof (struct flash_store_log_index) * store->block_count);
+	memset (store->sectors, 0, sizeof (struct flash_store_log_sector) * store->sector_count);
+
+	status = platform_mutex_init (&store->state->lock);
+	if (status != 0) {
+		return status;
+	}
+
+	status = flash_store_log_mount (store);
+	if (status != 0) {
+		goto free_lock;
+	}
+
+	return 0;
+
+free_lock:
+	platform_mutex_free (&store->state->lock);
+	return status;
+}
+
+/**
+ * Release the resources used for log-structured flash storage.
+ *
+ * @param store The flash storage to release.
+ */
+void flash_store_log_release (const struct flash_store_log *store)
+{
+	if (store) {
+		platform_mutex_free (&store->state->lock);
+	}
+}
+
+/**
+ * Reclaim space used by stale records in the log.  This is intended to be called periodically from
+ * a background context so that writes rarely need to wait for sectors to be reclaimed.  At most one
+ * sector will be reclaimed by each call.
+ *
+ * The oldest sector is only reclaimed when the log is running low on free sectors, the sector
+ * contains stale records, and all current records in the sector fit into the active sector.
+ *
+ * @param store The flash storage to maintain.
+ *
+ * @return 0 if garbage collection completed successfully or an error code.  No reclaimed sector is
+ * not an error.
+ */
+int flash_store_log_collect_garbage (const struct flash_store_log *store)
+{
+	uint32_t free_sectors = 0;
+	uint32_t oldest = 0;
+	uint32_t live;
+	uint32_t i;
+	int status = 0;
+
+	if (store == NULL) {
+		return FLASH_STORE_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&store->state->lock);
+
+	for (i = 0; i < store->sector_count; i++) {
+		if (store->sectors[i].sequence == 0) {
+			free_sectors++;
+		}
+		else if ((store->sectors[oldest].sequence == 0) ||
+			(store->sectors[i].sequence < store->sectors[oldest].sequence)) {
+			oldest = i;
+		}
+	}
+
+	if ((free_sectors < FLASH_STORE_LOG_MIN_FREE_SECTORS) && (oldest != store->state->head)) {
+		live = flash_store_log_get_live_length (store, oldest, true);
+		if ((live < store->sectors[oldest].used) &&
+			((store->state->write_offset + live) <= store->state->sector_size)) {
+			status = flash_store_log_collect_sector (store, oldest);
+		}
+	}
+
+	platform_mutex_unlock (&store->state->lock);
+
+	return status;
+}
+
+/**
+ * Get statistics about the log storage.
+ *
+ * @param store The flash storage to query.
+ * @param stats Output for the log statistics.
+ *
+ * @return 0 if the statistics were retrieved or an error code.
+ */
+int flash_store_log_get_stats (const struct flash_store_log *store,
+	struct flash_store_log_stats *stats)
+{
+	uint32_t i;
+
+	if ((store == NULL) || (stats == NULL)) {
+		return FLASH_STORE_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&store->state->lock);
+
+	*stats = store->state->stats;
+
+	stats->free_sectors = 0;
+	for (i = 0; i < store->sector_count; i++) {
+		if (store->sectors[i].sequence == 0) {
+			stats->free_sectors++;
+		}
+	}
+
+	platform_mutex_unlock (&store->state->lock);
+
+	return 0;
+}
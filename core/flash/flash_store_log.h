@@ -0,0 +1,120 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef FLASH_STORE_LOG_H_
+#define FLASH_STORE_LOG_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "platform_api.h"
+#include "flash/flash.h"
+#include "crypto/hash.h"
+#include "flash_store.h"
+
+
+/**
+ * Header at the start of each flash sector that is part of the log.
+ */
+struct flash_store_log_sector_header {
+	uint32_t sequence;				/**< Order in which the sector was added to the log. */
+	uint32_t magic;					/**< Marker indicating the sector is part of the log. */
+} __attribute__((__packed__));
+
+#define	FLASH_STORE_LOG_SECTOR_MAGIC			0x4c4f4753
+
+/**
+ * Header on each record appended to the log.
+ */
+struct flash_store_log_record_header {
+	uint8_t marker;					/**< Marker byte indicating the start of a record. */
+	uint8_t type;					/**< The type of record. */
+	uint16_t id;					/**< Block ID the record applies to. */
+	uint16_t length;				/**< Length of the data in the record. */
+	uint8_t reserved;				/**< Unused.  Left in the erased state. */
+	uint8_t commit;					/**< Marker indicating the record was completely written. */
+} __attribute__((__packed__));
+
+#define	FLASH_STORE_LOG_RECORD_MARKER			0xa5
+#define	FLASH_STORE_LOG_RECORD_COMMITTED		0x00
+#define	FLASH_STORE_LOG_RECORD_DATA				0x3c
+#define	FLASH_STORE_LOG_RECORD_ERASE			0xc3
+
+/**
+ * Location of the most recent record for a single block ID.
+ */
+struct flash_store_log_index {
+	uint32_t addr;					/**< Flash address of the record header. */
+	uint16_t length;				/**< Length of the data in the record. */
+	bool erased;					/**< Flag indicating the record marks the data as erased. */
+};
+
+/**
+ * Information about a single flash sector managed by the log.
+ */
+struct flash_store_log_sector {
+	uint32_t sequence;				/**< Sequence number of the sector, or 0 if the sector is free. */
+	uint32_t used;					/**< Number of bytes used by records in the sector. */
+	bool blank;						/**< Flag indicating a free sector is known to be erased. */
+};
+
+/**
+ * Statistics for log storage.
+ */
+struct flash_store_log_stats {
+	uint32_t free_sectors;			/**< Number of sectors not currently in use by the log. */
+	uint32_t sectors_collected;		/**< Number of sectors reclaimed by garbage collection. */
+	uint32_t records_relocated;		/**< Number of records copied during garbage collection. */
+};
+
+/**
+ * Variable context for log-structured flash storage.
+ */
+struct flash_store_log_state {
+	uint32_t sector_size;						/**< Size of each flash sector. */
+	uint32_t head;								/**< Sector currently being written. */
+	uint32_t write_offset;						/**< Offset in the head sector for the next record. */
+	uint32_t next_sequence;						/**< Sequence number to assign to the next sector. */
+	struct flash_store_log_stats stats;			/**< Statistics for the log. */
+	platform_mutex lock;						/**< Synchronization for log updates. */
+};
+
+/**
+ * Manage storage of indexed data blocks in flash as an append-only log.  Every write appends a new
+ * record to the end of the log rather than erasing and reprogramming a fixed location.  Sectors are
+ * used in a circular order, which spreads erase cycles across all sectors.  Space used by stale
+ * records is reclaimed by copying any current data out of the oldest sector and erasing it.
+ *
+ * An index of the current record for each block ID is kept in RAM and rebuilt from flash during
+ * initialization.  Records are only considered valid after they have been completely written, so a
+ * power loss during any update will leave the previous data intact.
+ *
+ * This storage requires that flash pages can be programmed more than once between erase cycles.
+ */
+struct flash_store_log {
+	struct flash_store base;					/**< Base flash_store. */
+	struct flash_store_log_state *state;		/**< Variable context for the flash store instance. */
+	struct flash_store_log_index *index;		/**< Location of the current data for each block ID. */
+	struct flash_store_log_sector *sectors;		/**< Information about each managed sector. */
+	const struct flash *flash;					/**< Flash device used for storage. */
+	struct hash_engine *hash;					/**< Hash engine for integrity checking. */
+	uint32_t base_addr;							/**< Base flash address for the log. */
+	uint32_t sector_count;						/**< Number of flash sectors used for the log. */
+	uint32_t block_count;						/**< Number of data blocks that can be stored. */
+	uint32_t max_length;						/**< Maximum length of data for each block. */
+};
+
+
+int flash_store_log_init (struct flash_store_log *store, struct flash_store_log_state *state,
+	struct flash_store_log_index *index, struct flash_store_log_sector *sectors,
+	const struct flash *flash, uint32_t base_addr, size_t sector_count, size_t block_count,
+	size_t max_length, struct hash_engine *hash);
+int flash_store_log_init_state (const struct flash_store_log *store);
+void flash_store_log_release (const struct flash_store_log *store);
+
+int flash_store_log_collect_garbage (const struct flash_store_log *store);
+int flash_store_log_get_stats (const struct flash_store_log *store,
+	struct flash_store_log_stats *stats);
+
+
+#endif /* FLASH_STORE_LOG_H_ */
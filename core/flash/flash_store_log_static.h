@@ -0,0 +1,75 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef FLASH_STORE_LOG_STATIC_H_
+#define FLASH_STORE_LOG_STATIC_H_
+
+#include "flash/flash_store_log.h"
+
+
+/* Internal functions declared to allow for static initialization. */
+int flash_store_log_write (const struct flash_store *flash_store, int id, const uint8_t *data,
+	size_t length);
+int flash_store_log_read (const struct flash_store *flash_store, int id, uint8_t *data,
+	size_t length);
+int flash_store_log_erase (const struct flash_store *flash_store, int id);
+int flash_store_log_erase_all (const struct flash_store *flash_store);
+int flash_store_log_get_data_length (const struct flash_store *flash_store, int id);
+int flash_store_log_has_data_stored (const struct flash_store *flash_store, int id);
+int flash_store_log_get_max_data_length (const struct flash_store *flash_store);
+int flash_store_log_get_flash_size (const struct flash_store *flash_store);
+int flash_store_log_get_num_blocks (const struct flash_store *flash_store);
+
+
+/**
+ * Constant initializer for the flash store API.
+ */
+#define	FLASH_STORE_LOG_API_INIT  { \
+		.write = flash_store_log_write, \
+		.read = flash_store_log_read, \
+		.erase = flash_store_log_erase, \
+		.erase_all = flash_store_log_erase_all, \
+		.get_data_length = flash_store_log_get_data_length, \
+		.has_data_stored = flash_store_log_has_data_stored, \
+		.get_max_data_length = flash_store_log_get_max_data_length, \
+		.get_flash_size = flash_store_log_get_flash_size, \
+		.get_num_blocks = flash_store_log_get_num_blocks \
+	}
+
+
+/**
+ * Initialize a static instance of log-structured flash storage for variable length data blocks.
+ *
+ * There is no validation done on the arguments.
+ *
+ * @param state_ptr Variable context for the flash store.
+ * @param index_ptr Storage for the index of current records.  This must be an array of
+ * struct flash_store_log_index with one entry for each data block.
+ * @param sectors_ptr Storage for tracking the state of each sector.  This must be an array of
+ * struct flash_store_log_sector with one entry for each log sector.
+ * @param flash_ptr The flash device that is managed by the store.
+ * @param flash_addr The address of the first sector used for the log.  This must be aligned to a
+ * flash sector.
+ * @param num_sectors The number of flash sectors to use for the log.  At least two sectors are
+ * required.
+ * @param blocks The number of data blocks that can be stored.
+ * @param max_len The maximum length of data that can be stored in a single block.
+ * @param hash_ptr Optional hash engine instance for integrity checking.  Set to null for no
+ * integrity checking.
+ */
+#define	flash_store_log_static_init(state_ptr, index_ptr, sectors_ptr, flash_ptr, flash_addr, \
+	num_sectors, blocks, max_len, hash_ptr) { \
+		.base = FLASH_STORE_LOG_API_INIT, \
+		.state = state_ptr, \
+		.index = index_ptr, \
+		.sectors = sectors_ptr, \
+		.flash = flash_ptr, \
+		.hash = hash_ptr, \
+		.base_addr = flash_addr, \
+		.sector_count = num_sectors, \
+		.block_count = blocks, \
+		.max_length = max_len, \
+	}
+
+
+#endif /* FLASH_STORE_LOG_STATIC_H_ */
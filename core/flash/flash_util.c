@@ -356,6 +356,110 @@ fail:
 	return status;
 }
 
+/**
+ * Generate independent hashes for multiple contiguous blocks of data stored in a flash device.
+ *
+ * If the hash engine is able to calculate multiple SHA-256 hashes in parallel, the regions will be
+ * read into the provided buffer and hashed together.  Any region that does not fit in the buffer,
+ * or any other type of hash, will be hashed directly from flash one region at a time.
+ *
+ * @param flash The flash device that contains the data to hash.
+ * @param regions The list of regions to hash.  Each region generates a separate hash.
+ * @param count The number of regions in the list.
+ * @param hash The hashing engine to use to generate the hashes.
+ * @param type The type of hash to generate.
+ * @param buffer Scratch space for holding flash data being hashed.  This can be null if multiple
+ * regions should not be hashed together.
+ * @param buffer_length The length of the scratch buffer.
+ * @param hash_out The buffer to hold the generated hash values.  The hash for each region will be
+ * stored sequentially, in the same order as the list of regions.
+ * @param hash_length The length of the hash output buffer.
+ *
+ * @return 0 if the hashes were generated successfully or an error code.
+ */
+int flash_hash_multiple_contents (const struct flash *flash, const struct flash_region *regions,
+	size_t count, struct hash_engine *hash, enum hash_type type, uint8_t *buffer,
+	size_t buffer_length, uint8_t *hash_out, size_t hash_length)
+{
+	struct hash_multi_buffer buffers[FLASH_MULTI_HASH_BATCH];
+	int digest_length;
+	size_t used;
+	size_t batch;
+	size_t i;
+	int status;
+
+	if ((flash == NULL) || (regions == NULL) || (hash == NULL) || (hash_out == NULL) ||
+		(count == 0)) {
+		return FLASH_UTIL_INVALID_ARGUMENT;
+	}
+
+	for (i = 0; i < count; i++) {
+		if (regions[i].length == 0) {
+			return FLASH_UTIL_INVALID_ARGUMENT;
+		}
+	}
+
+	digest_length = hash_get_hash_length (type);
+	if (ROT_IS_ERROR (digest_length)) {
+		return digest_length;
+	}
+
+	if (hash_length < (count * digest_length)) {
+		return FLASH_UTIL_HASH_BUFFER_TOO_SMALL;
+	}
+
+	if ((type != HASH_TYPE_SHA256) || (buffer == NULL) || !hash_is_sha256_multi_supported (hash)) {
+		for (i = 0; i < count; i++) {
+			status = flash_hash_contents (flash, regions[i].start_addr, regions[i].length, hash,
+				type, &hash_out[i * digest_length], digest_length);
+			if (status != 0) {
+				return status;
+			}
+		}
+
+		return 0;
+	}
+
+	i = 0;
+	while (i < count) {
+		used = 0;
+		batch = 0;
+
+		while ((i < count) && (batch < FLASH_MULTI_HASH_BATCH) &&
+			(regions[i].length <= (buffer_length - used))) {
+			status = flash->read (flash, regions[i].start_addr, &buffer[used], regions[i].length);
+			if (status != 0) {
+				return status;
+			}
+
+			buffers[batch].data = &buffer[used];
+			buffers[batch].length = regions[i].length;
+			buffers[batch].hash = &hash_out[i * SHA256_HASH_LENGTH];
+			buffers[batch].hash_length = SHA256_HASH_LENGTH;
+
+			used += regions[i].length;
+			batch++;
+			i++;
+		}
+
+		if (batch != 0) {
+			status = hash_calculate_sha256_multi (hash, buffers, batch);
+		}
+		else {
+			/* The region is too large for the buffer, so hash it directly from flash. */
+			status = flash_hash_contents (flash, regions[i].start_addr, regions[i].length, hash,
+				type, &hash_out[i * SHA256_HASH_LENGTH], SHA256_HASH_LENGTH);
+			i++;
+		}
+
+		if (status != 0) {
+			return status;
+		}
+	}
+
+	return 0;
+}
+
 /**
  * Update a hash for a contiguous block of data stored in a flash device.
  *
@@ -23,6 +23,12 @@
  */
 #define	FLASH_MAX_COPY_BLOCK		512
 
+/**
+ * The maximum number of flash regions that will be hashed together in a single multi-buffer hash
+ * request.
+ */
+#define	FLASH_MULTI_HASH_BATCH		8
+
 
 /**
  * Defines a single region of flash memory.
@@ -66,6 +72,9 @@ int flash_hash_noncontiguous_contents (const struct flash *flash,
 int flash_hash_noncontiguous_contents_at_offset (const struct flash *flash, uint32_t offset,
 	const struct flash_region *regions, size_t count, struct hash_engine *hash, enum hash_type type,
 	uint8_t *hash_out, size_t hash_length);
+int flash_hash_multiple_contents (const struct flash *flash, const struct flash_region *regions,
+	size_t count, struct hash_engine *hash, enum hash_type type, uint8_t *buffer,
+	size_t buffer_length, uint8_t *hash_out, size_t hash_length);
 
 int flash_hash_update_contents (const struct flash *flash, uint32_t start_addr, size_t length,
 	struct hash_engine *hash);
@@ -26,6 +26,16 @@
 #define	QSPI_ENABLE_BIT6			(1U << 6)
 #define	QSPI_ENABLE_BIT7			(1U << 7)
 
+/* Status bits indicating when a write operation is suspended. */
+#define	MACRONIX_PROGRAM_SUSPENDED	(1U << 2)
+#define	MACRONIX_ERASE_SUSPENDED	(1U << 3)
+#define	WINBOND_WRITE_SUSPENDED		(1U << 7)
+#define	MICRON_PROGRAM_SUSPENDED	(1U << 2)
+#define	MICRON_ERASE_SUSPENDED		(1U << 6)
+
+/* Number of times a resume command will be sent before failing a suspended write. */
+#define	SPI_FLASH_RESUME_RETRIES	3
+
 /* Flag bits for controlling flash reset during initialization. */
 #define	SPI_FLASH_DO_RESET			(1U << 0)
 #define	SPI_FLASH_RESET_IS_REQUIRED	(1U << 1)
@@ -139,6 +149,7 @@ static void spi_flash_set_device_commands (const struct spi_flash *flash,
 		spi_flash_sfdp_get_reset_command (sfdp, &flash->state->command.reset);
 		spi_flash_sfdp_get_deep_powerdown_commands (sfdp, &flash->state->command.enter_pwrdown,
 			&flash->state->command.release_pwrdown);
+		spi_flash_sfdp_get_suspend_info (sfdp, &flash->state->suspend);
 	}
 }
 
@@ -654,6 +665,21 @@ int spi_flash_save_device_info (const struct spi_flash *flash, struct spi_flash_
 	return 0;
 }
 
+/**
+ * Send a single SPI transaction to the flash device.
+ *
+ * @param flash The flash instance to use to send the transaction.
+ * @param xfer The transaction to send.
+ *
+ * @return 0 if the transaction was successful or an error code.
+ */
+static int spi_flash_xfer (const struct spi_flash *flash, const struct flash_xfer *xfer)
+{
+	flash->state->stats.xfers++;
+
+	return flash->spi->xfer (flash->spi, xfer);
+}
+
 /**
  * Send a write command to the flash that only sends the command code.
  *
@@ -667,7 +693,7 @@ static int spi_flash_simple_command (const struct spi_flash *flash, uint8_t cmd)
 	struct flash_xfer xfer;
 
 	FLASH_XFER_INIT_CMD_ONLY (xfer, cmd, 0);
-	return flash->spi->xfer (flash->spi, &xfer);
+	return spi_flash_xfer (flash, &xfer);
 }
 
 /**
@@ -679,6 +705,9 @@ static int spi_flash_simple_command (const struct spi_flash *flash, uint8_t cmd)
  */
 static int spi_flash_write_enable (const struct spi_flash *flash)
 {
+	/* Any command that follows write enable can start a program or erase cycle. */
+	flash->state->wip_idle = false;
+
 	return spi_flash_simple_command (flash, FLASH_CMD_WREN);
 }
 
@@ -691,6 +720,8 @@ static int spi_flash_write_enable (const struct spi_flash *flash)
  */
 static int spi_flash_volatile_write_enable (const struct spi_flash *flash)
 {
+	flash->state->wip_idle = false;
+
 	return spi_flash_simple_command (flash, FLASH_CMD_VOLATILE_WREN);
 }
 
@@ -714,18 +745,45 @@ static int spi_flash_is_wip_set (const struct spi_flash *flash)
 		FLASH_XFER_INIT_READ_REG (xfer, FLASH_CMD_RDSR_FLAG, &reg, 1, 0);
 	}
 
-	status = flash->spi->xfer (flash->spi, &xfer);
+	flash->state->stats.status_polls++;
+
+	status = spi_flash_xfer (flash, &xfer);
 	if (status == 0) {
 		if (!flash->state->use_busy_flag) {
-			return ((reg & FLASH_STATUS_WIP) != 0);
+			status = ((reg & FLASH_STATUS_WIP) != 0);
 		}
 		else {
-			return ((reg & FLASH_FLAG_STATUS_READY) == 0);
+			status = ((reg & FLASH_FLAG_STATUS_READY) == 0);
 		}
+
+		flash->state->wip_idle = (status == 0);
 	}
-	else {
-		return status;
+
+	return status;
+}
+
+/**
+ * Check that the flash is not executing a write command before starting a new operation.  If WIP
+ * tracking is enabled and no write has been started since the device was last seen to be idle, the
+ * status register will not be read.
+ *
+ * @param flash The flash instance to check.
+ *
+ * @return 0 if no write is in progress or an error code.
+ */
+static int spi_flash_check_no_wip (const struct spi_flash *flash)
+{
+	int status;
+
+	if (flash->state->track_wip && flash->state->wip_idle) {
+		flash->state->stats.status_polls_skipped++;
+
+		return 0;
 	}
+
+	status = spi_flash_is_wip_set (flash);
+
+	return (status == 1) ? SPI_FLASH_WRITE_IN_PROGRESS : status;
 }
 
 /**
@@ -796,9 +854,9 @@ static int spi_flash_write_register (const struct spi_flash *flash, uint8_t cmd,
 	struct flash_xfer xfer;
 	int status;
 
-	status = spi_flash_is_wip_set (flash);
+	status = spi_flash_check_no_wip (flash);
 	if (status != 0) {
-		return (status == 1) ? SPI_FLASH_WRITE_IN_PROGRESS : status;
+		return status;
 	}
 
 	if (volatile_wren) {
@@ -812,7 +870,7 @@ static int spi_flash_write_register (const struct spi_flash *flash, uint8_t cmd,
 	}
 
 	FLASH_XFER_INIT_WRITE_REG (xfer, cmd, data, length, 0);
-	status = flash->spi->xfer (flash->spi, &xfer);
+	status = spi_flash_xfer (flash, &xfer);
 	if (status != 0) {
 		return status;
 	}
@@ -820,6 +878,250 @@ static int spi_flash_write_register (const struct spi_flash *flash, uint8_t cmd,
 	return spi_flash_wait_for_write_completion (flash, -1, 1);
 }
 
+/**
+ * Determine the register that reports when a write operation is suspended.  The location of the
+ * suspend status is vendor dependent.
+ *
+ * @param vendor The vendor ID of the flash device.
+ * @param operation The type of write operation that will be suspended.
+ * @param cmd Output for the command to read the status register.
+ * @param mask Output for the status bit that indicates the operation is suspended.
+ *
+ * @return 0 if the suspend status is available for the device or an error code.
+ */
+static int spi_flash_get_suspend_status_reg (uint8_t vendor, uint8_t operation, uint8_t *cmd,
+	uint8_t *mask)
+{
+	switch (vendor) {
+		case FLASH_ID_MACRONIX:
+			*cmd = FLASH_CMD_RDSCUR;
+			*mask = (operation == SPI_FLASH_SUSPEND_ERASE) ?
+				MACRONIX_ERASE_SUSPENDED : MACRONIX_PROGRAM_SUSPENDED;
+			break;
+
+		case FLASH_ID_WINBOND:
+			*cmd = FLASH_CMD_RDSR2;
+			*mask = WINBOND_WRITE_SUSPENDED;
+			break;
+
+		case FLASH_ID_MICRON:
+		case FLASH_ID_MICRON_X:
+			*cmd = FLASH_CMD_RDSR_FLAG;
+			*mask = (operation == SPI_FLASH_SUSPEND_ERASE) ?
+				MICRON_ERASE_SUSPENDED : MICRON_PROGRAM_SUSPENDED;
+			break;
+
+		default:
+			return SPI_FLASH_SUSPEND_NOT_SUPPORTED;
+	}
+
+	return 0;
+}
+
+/**
+ * Check if the active write operation is currently suspended.  The flash lock must be held.
+ *
+ * @param flash The flash instance to check.
+ *
+ * @return 1 if the write is suspended, 0 if it is not, or an error code.
+ */
+static int spi_flash_is_write_suspended (const struct spi_flash *flash)
+{
+	struct flash_xfer xfer;
+	uint8_t cmd;
+	uint8_t mask;
+	uint8_t reg;
+	int status;
+
+	status = spi_flash_get_suspend_status_reg (flash->state->device_id[0],
+		flash->state->active_op, &cmd, &mask);
+	if (status != 0) {
+		return status;
+	}
+
+	FLASH_XFER_INIT_READ_REG (xfer, cmd, &reg, 1, 0);
+	status = spi_flash_xfer (flash, &xfer);
+	if (status != 0) {
+		return status;
+	}
+
+	return !!(reg & mask);
+}
+
+/**
+ * Acquire exclusive access to the flash device.  If a suspendable write operation is executing, this
+ * will wait until that operation has completed.  Only reads are allowed to proceed while a
+ * suspendable write is in progress.
+ *
+ * @param flash The flash instance to acquire.
+ */
+static void spi_flash_acquire (const struct spi_flash *flash)
+{
+	platform_mutex_lock (&flash->state->lock);
+
+	while (flash->state->active_op != 0) {
+		platform_mutex_unlock (&flash->state->lock);
+		platform_msleep (1);
+		platform_mutex_lock (&flash->state->lock);
+	}
+}
+
+/**
+ * Wait for a write operation to complete.  If the operation is allowed to be suspended, the flash
+ * lock will be released between status checks so reads can be serviced while the write is in
+ * progress.  The lock must be held when calling this function and will be held when it returns.
+ *
+ * @param flash The flash instance that is executing a write operation.
+ * @param operation The type of write operation that is executing.
+ * @param address The first address modified by the operation.
+ * @param length The number of bytes modified by the operation.
+ *
+ * @return 0 if the write was completed or an error code.
+ */
+static int spi_flash_wait_for_suspendable_write (const struct spi_flash *flash, uint8_t operation,
+	uint32_t address, uint32_t length)
+{
+	int status;
+
+	if (!(flash->state->suspend_ops & operation)) {
+		return spi_flash_wait_for_write_completion (flash, -1,
+			(operation == SPI_FLASH_SUSPEND_PROGRAM));
+	}
+
+	flash->state->active_op = operation;
+	flash->state->active_addr = address;
+	flash->state->active_length = length;
+
+	flash->state->resume_failed = false;
+
+	do {
+		status = spi_flash_is_wip_set (flash);
+		if (status == 1) {
+			platform_mutex_unlock (&flash->state->lock);
+			platform_msleep ((operation == SPI_FLASH_SUSPEND_ERASE) ? 10 : 1);
+			platform_mutex_lock (&flash->state->lock);
+		}
+	} while (status == 1);
+
+	/* A suspended write also reports the device as idle, so the write can't be reported as complete
+	 * if a read was not able to resume it. */
+	if ((status == 0) && flash->state->resume_failed) {
+		status = SPI_FLASH_RESUME_FAILED;
+	}
+
+	flash->state->active_op = 0;
+	flash->state->resume_failed = false;
+
+	return status;
+}
+
+/**
+ * Resume a write operation that was suspended to execute a read.  This will block for the minimum
+ * time the device requires before the operation can be suspended again, which ensures the write
+ * continues to make progress when there are many back-to-back reads.
+ *
+ * The suspend status is checked after each resume command.  If the write remains suspended after
+ * all attempts, the write operation will be reported as failed.
+ *
+ * @param flash The flash instance that has a suspended write.
+ *
+ * @return 0 if the write was resumed or an error code.
+ */
+static int spi_flash_resume_after_read (const struct spi_flash *flash)
+{
+	uint8_t command;
+	uint32_t interval;
+	int retries = SPI_FLASH_RESUME_RETRIES;
+	int status;
+
+	if (flash->state->active_op == SPI_FLASH_SUSPEND_ERASE) {
+		command = flash->state->suspend.erase_resume;
+		interval = flash->state->suspend.erase_resume_us;
+	}
+	else {
+		command = flash->state->suspend.program_resume;
+		interval = flash->state->suspend.program_resume_us;
+	}
+
+	flash->state->wip_idle = false;
+
+	do {
+		status = spi_flash_simple_command (flash, command);
+		if (status == 0) {
+			status = spi_flash_is_write_suspended (flash);
+			if (status == 1) {
+				status = SPI_FLASH_RESUME_FAILED;
+			}
+		}
+	} while ((status != 0) && (--retries > 0));
+
+	if (status != 0) {
+		flash->state->resume_failed = true;
+
+		return status;
+	}
+
+	platform_msleep ((interval + 999) / 1000);
+
+	return 0;
+}
+
+/**
+ * Prepare the flash for a read.  If a suspendable write is in progress in another context, it will
+ * be suspended so the read can be executed without waiting for the write to complete.  A read of
+ * the region being modified will instead wait for the write to complete.
+ *
+ * @param flash The flash instance that will be read.
+ * @param address The first address that will be read.
+ * @param length The number of bytes that will be read.
+ *
+ * @return 0 if the flash is ready for the read, 1 if the flash is ready but a write operation was
+ * suspended, or an error code.  Use ROT_IS_ERROR to check the return value.
+ */
+static int spi_flash_suspend_for_read (const struct spi_flash *flash, uint32_t address,
+	size_t length)
+{
+	uint8_t command;
+	uint32_t latency;
+	int status;
+
+	status = spi_flash_check_no_wip (flash);
+	if ((status != SPI_FLASH_WRITE_IN_PROGRESS) || (flash->state->active_op == 0)) {
+		return status;
+	}
+
+	if ((address < (flash->state->active_addr + flash->state->active_length)) &&
+		(flash->state->active_addr < (address + length))) {
+		return spi_flash_wait_for_write_completion (flash, -1,
+			(flash->state->active_op == SPI_FLASH_SUSPEND_PROGRAM));
+	}
+
+	if (flash->state->active_op == SPI_FLASH_SUSPEND_ERASE) {
+		command = flash->state->suspend.erase_suspend;
+		latency = flash->state->suspend.erase_suspend_us;
+	}
+	else {
+		command = flash->state->suspend.program_suspend;
+		latency = flash->state->suspend.program_suspend_us;
+	}
+
+	status = spi_flash_simple_command (flash, command);
+	if (status != 0) {
+		return status;
+	}
+
+	flash->state->stats.suspends++;
+
+	status = spi_flash_wait_for_write_completion (flash, (latency / 1000) + 1, 1);
+	if (status != 0) {
+		spi_flash_resume_after_read (flash);
+
+		return status;
+	}
+
+	return 1;
+}
+
 /**
  * Discover device properties necessary for operation through SFDP.  This must be done prior to
  * using the interface to the device.
@@ -851,7 +1153,7 @@ int spi_flash_discover_device_properties (const struct spi_flash *flash,
 		return status;
 	}
 
-	platform_mutex_lock (&flash->state->lock);
+	spi_flash_acquire (flash);
 
 	spi_flash_sfdp_get_device_capabilities (&parameters, &flash->state->capabilities);
 	spi_flash_sfdp_get_read_commands (&parameters, &read);
@@ -938,7 +1240,7 @@ int spi_flash_set_device_size (const struct spi_flash *flash, uint32_t bytes)
 		return SPI_FLASH_INVALID_ARGUMENT;
 	}
 
-	platform_mutex_lock (&flash->state->lock);
+	spi_flash_acquire (flash);
 
 	flash->state->device_size = bytes;
 	if (bytes > 0x1000000) {
@@ -981,7 +1283,7 @@ int spi_flash_set_read_command (const struct spi_flash *flash,
 		return SPI_FLASH_INVALID_ARGUMENT;
 	}
 
-	platform_mutex_lock (&flash->state->lock);
+	spi_flash_acquire (flash);
 	spi_flash_configure_read_command (flash, command, 0, false, flags);
 	platform_mutex_unlock (&flash->state->lock);
 
@@ -1012,7 +1314,7 @@ int spi_flash_set_write_command (const struct spi_flash *flash, uint8_t opcode,
 		return SPI_FLASH_INVALID_ARGUMENT;
 	}
 
-	platform_mutex_lock (&flash->state->lock);
+	spi_flash_acquire (flash);
 
 	flash->state->command.write = opcode;
 	flash->state->command.write_flags = flags;
@@ -1040,13 +1342,13 @@ int spi_flash_get_device_id (const struct spi_flash *flash, uint8_t *vendor, uin
 		return SPI_FLASH_INVALID_ARGUMENT;
 	}
 
-	platform_mutex_lock (&flash->state->lock);
+	spi_flash_acquire (flash);
 
 	if ((flash->state->device_id[0] == 0xff) || (flash->state->device_id[0] == 0)) {
 		FLASH_XFER_INIT_READ_REG (xfer, FLASH_CMD_RDID, flash->state->device_id,
 			sizeof (flash->state->device_id), 0);
 
-		status = flash->spi->xfer (flash->spi, &xfer);
+		status = spi_flash_xfer (flash, &xfer);
 		if (status != 0) {
 			flash->state->device_id[0] = 0xff;
 			goto exit;
@@ -1102,6 +1404,9 @@ static int spi_flash_execute_reset_device (const struct spi_flash *flash, uint32
 		}
 	}
 
+	/* The device state is not known after a reset, even if the command fails. */
+	flash->state->wip_idle = false;
+
 	status = spi_flash_simple_command (flash, flash->state->command.reset);
 	if (status == 0) {
 		platform_msleep (wait_ms);
@@ -1148,7 +1453,7 @@ int spi_flash_reset_device (const struct spi_flash *flash)
 		rst_addr_mode = flash->state->addr_mode;
 	}
 
-	platform_mutex_lock (&flash->state->lock);
+	spi_flash_acquire (flash);
 
 	/* Block the reset if there is a write in progress.  Issuing a reset in this case can cause data
 	 * corruption and cause an indeterminate delay after the reset.  In some cases, the reset will
@@ -1202,7 +1507,7 @@ int spi_flash_force_reset_device (const struct spi_flash *flash, uint32_t wait_m
 		return SPI_FLASH_RESET_NOT_SUPPORTED;
 	}
 
-	platform_mutex_lock (&flash->state->lock);
+	spi_flash_acquire (flash);
 
 	/* No effort is being made to determine a reasonable wait time after issuing the device reset.
 	 * It will vary based on device and current state.  Leave it to the caller to decide. */
@@ -1237,7 +1542,7 @@ int spi_flash_clear_block_protect (const struct spi_flash *flash)
 		return status;
 	}
 
-	platform_mutex_lock (&flash->state->lock);
+	spi_flash_acquire (flash);
 
 	if (vendor != FLASH_ID_MICROCHIP) {
 		/* Depending on the quad enable bit, the block clear needs to be handled differently:
@@ -1256,7 +1561,7 @@ int spi_flash_clear_block_protect (const struct spi_flash *flash)
 
 			case SPI_FLASH_SFDP_QUAD_QE_BIT1_SR2_35:
 				FLASH_XFER_INIT_READ_REG (xfer, FLASH_CMD_RDSR2, &reg[1], 1, 0);
-				status = flash->spi->xfer (flash->spi, &xfer);
+				status = spi_flash_xfer (flash, &xfer);
 				if (status != 0) {
 					goto exit;
 				}
@@ -1267,7 +1572,7 @@ int spi_flash_clear_block_protect (const struct spi_flash *flash)
 		}
 
 		FLASH_XFER_INIT_READ_REG (xfer, FLASH_CMD_RDSR, reg, cmd_len, 0);
-		status = flash->spi->xfer (flash->spi, &xfer);
+		status = spi_flash_xfer (flash, &xfer);
 		if (status != 0) {
 			goto exit;
 		}
@@ -1288,7 +1593,7 @@ int spi_flash_clear_block_protect (const struct spi_flash *flash)
 		 * cycle before any erase or program operations can be performed. */
 
 		FLASH_XFER_INIT_CMD_ONLY (xfer, FLASH_CMD_GBULK, 0);
-		status = flash->spi->xfer (flash->spi, &xfer);
+		status = spi_flash_xfer (flash, &xfer);
 	}
 
 exit:
@@ -1318,7 +1623,9 @@ int spi_flash_deep_power_down (const struct spi_flash *flash, uint8_t enable)
 		return (enable) ? SPI_FLASH_PWRDOWN_NOT_SUPPORTED : 0;
 	}
 
-	platform_mutex_lock (&flash->state->lock);
+	spi_flash_acquire (flash);
+
+	flash->state->wip_idle = false;
 
 	if (enable) {
 		status = spi_flash_simple_command (flash, flash->state->command.enter_pwrdown);
@@ -1431,10 +1738,10 @@ int spi_flash_is_4byte_address_mode_on_reset (const struct spi_flash *flash)
 	}
 
 	if (cmd) {
-		platform_mutex_lock (&flash->state->lock);
+		spi_flash_acquire (flash);
 
 		FLASH_XFER_INIT_READ_REG (xfer, cmd, &reg, 1, 0);
-		status = flash->spi->xfer (flash->spi, &xfer);
+		status = spi_flash_xfer (flash, &xfer);
 
 		platform_mutex_unlock (&flash->state->lock);
 		if (status != 0) {
@@ -1483,7 +1790,7 @@ int spi_flash_enable_4byte_address_mode (const struct spi_flash *flash, uint8_t
 		return SPI_FLASH_INVALID_ARGUMENT;
 	}
 
-	platform_mutex_lock (&flash->state->lock);
+	spi_flash_acquire (flash);
 
 	status = spi_flash_supports_address_mode (flash, enable);
 	if (status != 0) {
@@ -1588,10 +1895,10 @@ int spi_flash_detect_4byte_address_mode (const struct spi_flash *flash)
 			return SPI_FLASH_UNSUPPORTED_DEVICE;
 	}
 
-	platform_mutex_lock (&flash->state->lock);
+	spi_flash_acquire (flash);
 
 	FLASH_XFER_INIT_READ_REG (xfer, cmd, &reg, 1, 0);
-	status = flash->spi->xfer (flash->spi, &xfer);
+	status = spi_flash_xfer (flash, &xfer);
 	if (status != 0) {
 		goto exit;
 	}
@@ -1625,7 +1932,7 @@ int spi_flash_force_4byte_address_mode (const struct spi_flash *flash, uint8_t e
 		return SPI_FLASH_INVALID_ARGUMENT;
 	}
 
-	platform_mutex_lock (&flash->state->lock);
+	spi_flash_acquire (flash);
 
 	status = spi_flash_supports_address_mode (flash, enable);
 	if (status != 0) {
@@ -1668,7 +1975,7 @@ int spi_flash_enable_quad_spi (const struct spi_flash *flash, uint8_t enable)
 		return SPI_FLASH_INVALID_ARGUMENT;
 	}
 
-	platform_mutex_lock (&flash->state->lock);
+	spi_flash_acquire (flash);
 
 	switch (flash->state->quad_enable) {
 		case SPI_FLASH_SFDP_QUAD_NO_QE_BIT:
@@ -1681,7 +1988,7 @@ int spi_flash_enable_quad_spi (const struct spi_flash *flash, uint8_t enable)
 
 		case SPI_FLASH_SFDP_QUAD_QE_BIT1_SR2_35:
 			FLASH_XFER_INIT_READ_REG (xfer, FLASH_CMD_RDSR2, &reg[1], 1, 0);
-			status = flash->spi->xfer (flash->spi, &xfer);
+			status = spi_flash_xfer (flash, &xfer);
 			if (status != 0) {
 				goto exit;
 			}
@@ -1703,7 +2010,7 @@ int spi_flash_enable_quad_spi (const struct spi_flash *flash, uint8_t enable)
 	}
 
 	FLASH_XFER_INIT_READ_REG (xfer, cmd, reg, cmd_len, 0);
-	status = flash->spi->xfer (flash->spi, &xfer);
+	status = spi_flash_xfer (flash, &xfer);
 	if (status != 0) {
 		goto exit;
 	}
@@ -1788,7 +2095,7 @@ int spi_flash_is_quad_spi_enabled (const struct spi_flash *flash)
 		return SPI_FLASH_INVALID_ARGUMENT;
 	}
 
-	platform_mutex_lock (&flash->state->lock);
+	spi_flash_acquire (flash);
 
 	switch (flash->state->quad_enable) {
 		case SPI_FLASH_SFDP_QUAD_NO_QE_BIT:
@@ -1818,7 +2125,7 @@ int spi_flash_is_quad_spi_enabled (const struct spi_flash *flash)
 	}
 
 	FLASH_XFER_INIT_READ_REG (xfer, cmd, reg, cmd_len, 0);
-	status = flash->spi->xfer (flash->spi, &xfer);
+	status = spi_flash_xfer (flash, &xfer);
 	if (status != 0) {
 		goto exit;
 	}
@@ -1875,12 +2182,12 @@ int spi_flash_configure_drive_strength (const struct spi_flash *flash)
 		return status;
 	}
 
-	platform_mutex_lock (&flash->state->lock);
+	spi_flash_acquire (flash);
 
 	switch (vendor) {
 		case FLASH_ID_WINBOND:
 			FLASH_XFER_INIT_READ_REG (xfer, FLASH_CMD_RDSR3, &reg, 1, 0);
-			status = flash->spi->xfer (flash->spi, &xfer);
+			status = spi_flash_xfer (flash, &xfer);
 			if (status != 0) {
 				break;
 			}
@@ -1893,7 +2200,7 @@ int spi_flash_configure_drive_strength (const struct spi_flash *flash)
 				}
 
 				FLASH_XFER_INIT_READ_REG (xfer, FLASH_CMD_RDSR3, &reg, 1, 0);
-				status = flash->spi->xfer (flash->spi, &xfer);
+				status = spi_flash_xfer (flash, &xfer);
 				if (status != 0) {
 					break;
 				}
@@ -1922,6 +2229,8 @@ int spi_flash_configure_drive_strength (const struct spi_flash *flash)
 int spi_flash_read (const struct spi_flash *flash, uint32_t address, uint8_t *data, size_t length)
 {
 	struct flash_xfer xfer;
+	int suspended;
+	int resume;
 	int status;
 
 	if ((flash == NULL) || (data == NULL)) {
@@ -1932,16 +2241,23 @@ int spi_flash_read (const struct spi_flash *flash, uint32_t address, uint8_t *da
 
 	platform_mutex_lock (&flash->state->lock);
 
-	status = spi_flash_is_wip_set (flash);
-	if (status != 0) {
-		status = (status == 1) ? SPI_FLASH_WRITE_IN_PROGRESS : status;
+	suspended = spi_flash_suspend_for_read (flash, address, length);
+	if (ROT_IS_ERROR (suspended)) {
+		status = suspended;
 		goto exit;
 	}
 
 	FLASH_XFER_INIT_READ (xfer, flash->state->command.read, address,
 		flash->state->command.read_dummy, flash->state->command.read_mode, data, length,
 		flash->state->command.read_flags | flash->state->addr_mode);
-	status = flash->spi->xfer (flash->spi, &xfer);
+	status = spi_flash_xfer (flash, &xfer);
+
+	if (suspended) {
+		resume = spi_flash_resume_after_read (flash);
+		if (status == 0) {
+			status = resume;
+		}
+	}
 
 exit:
 	platform_mutex_unlock (&flash->state->lock);
@@ -2024,11 +2340,10 @@ int spi_flash_write (const struct spi_flash *flash, uint32_t address, const uint
 
 	SPI_FLASH_BOUNDS_CHECK (flash->state->device_size, address, length);
 
-	platform_mutex_lock (&flash->state->lock);
+	spi_flash_acquire (flash);
 
-	status = spi_flash_is_wip_set (flash);
+	status = spi_flash_check_no_wip (flash);
 	if (status != 0) {
-		status = (status == 1) ? SPI_FLASH_WRITE_IN_PROGRESS : status;
 		goto exit;
 	}
 
@@ -2051,9 +2366,10 @@ int spi_flash_write (const struct spi_flash *flash, uint32_t address, const uint
 		FLASH_XFER_INIT_WRITE (xfer, flash->state->command.write, address, 0, (uint8_t*) data,
 			write_len, flash->state->command.write_flags | flash->state->addr_mode);
 
-		status = flash->spi->xfer (flash->spi, &xfer);
+		status = spi_flash_xfer (flash, &xfer);
 		if (status == 0) {
-			status = spi_flash_wait_for_write_completion (flash, -1, 1);
+			status = spi_flash_wait_for_suspendable_write (flash, SPI_FLASH_SUSPEND_PROGRAM,
+				address, write_len);
 			if (status == 0) {
 				remaining -= write_len;
 				data += write_len;
@@ -2096,14 +2412,15 @@ int spi_flash_write_read_only (const struct flash *flash, uint32_t address, cons
  * Erase a region of flash.
  *
  * @param flash The flash to erase.
- * @param address An address within the region to erase.
+ * @param address The base address of the region to erase.
+ * @param region_size The number of bytes erased by the command.
  * @param erase_cmd The erase command to use.
  * @param erase_flags Transfer flags for the command.
  *
  * @return 0 if the region was erased or an error code.
  */
 static int spi_flash_erase_region (const struct spi_flash *flash, uint32_t address,
-	uint8_t erase_cmd, uint16_t erase_flags)
+	uint32_t region_size, uint8_t erase_cmd, uint16_t erase_flags)
 {
 	struct flash_xfer xfer;
 	int status;
@@ -2112,11 +2429,10 @@ static int spi_flash_erase_region (const struct spi_flash *flash, uint32_t addre
 		return SPI_FLASH_ADDRESS_OUT_OF_RANGE;
 	}
 
-	platform_mutex_lock (&flash->state->lock);
+	spi_flash_acquire (flash);
 
-	status = spi_flash_is_wip_set (flash);
+	status = spi_flash_check_no_wip (flash);
 	if (status != 0) {
-		status = (status == 1) ? SPI_FLASH_WRITE_IN_PROGRESS : status;
 		goto exit;
 	}
 
@@ -2127,12 +2443,13 @@ static int spi_flash_erase_region (const struct spi_flash *flash, uint32_t addre
 
 	FLASH_XFER_INIT_NO_DATA (xfer, erase_cmd, address, erase_flags | flash->state->addr_mode);
 
-	status = flash->spi->xfer (flash->spi, &xfer);
+	status = spi_flash_xfer (flash, &xfer);
 	if (status != 0) {
 		goto exit;
 	}
 
-	status = spi_flash_wait_for_write_completion (flash, -1, 0);
+	status = spi_flash_wait_for_suspendable_write (flash, SPI_FLASH_SUSPEND_ERASE,
+		address, region_size);
 
 exit:
 	platform_mutex_unlock (&flash->state->lock);
@@ -2173,7 +2490,7 @@ int spi_flash_sector_erase (const struct spi_flash *flash, uint32_t sector_addr)
 		return SPI_FLASH_INVALID_ARGUMENT;
 	}
 
-	return spi_flash_erase_region (flash, FLASH_SECTOR_BASE (sector_addr),
+	return spi_flash_erase_region (flash, FLASH_SECTOR_BASE (sector_addr), FLASH_SECTOR_SIZE,
 		flash->state->command.erase_sector, flash->state->command.sector_flags);
 }
 
@@ -2220,7 +2537,7 @@ int spi_flash_block_erase (const struct spi_flash *flash, uint32_t block_addr)
 		return SPI_FLASH_INVALID_ARGUMENT;
 	}
 
-	return spi_flash_erase_region (flash, FLASH_BLOCK_BASE (block_addr),
+	return spi_flash_erase_region (flash, FLASH_BLOCK_BASE (block_addr), FLASH_BLOCK_SIZE,
 		flash->state->command.erase_block, flash->state->command.block_flags);
 }
 
@@ -2239,11 +2556,10 @@ int spi_flash_chip_erase (const struct spi_flash *flash)
 		return SPI_FLASH_INVALID_ARGUMENT;
 	}
 
-	platform_mutex_lock (&flash->state->lock);
+	spi_flash_acquire (flash);
 
-	status = spi_flash_is_wip_set (flash);
+	status = spi_flash_check_no_wip (flash);
 	if (status != 0) {
-		status = (status == 1) ? SPI_FLASH_WRITE_IN_PROGRESS : status;
 		goto exit;
 	}
 
@@ -2317,3 +2633,135 @@ int spi_flash_wait_for_write (const struct spi_flash *flash, int32_t timeout)
 
 	return status;
 }
+
+/**
+ * Enable or disable tracking of write operations to avoid reading the status register before every
+ * flash operation.  When enabled, the driver will only check for a write in progress if it has
+ * started a program or erase that has not yet been seen to complete.  Reads following a completed
+ * write will be issued without any status check.
+ *
+ * Tracking must only be enabled when this driver is the only master that can issue commands to the
+ * device.  If another master may have accessed the flash, disable and re-enable tracking to force
+ * the next operation to check the device status.
+ *
+ * @param flash The flash instance to configure.
+ * @param enable true to enable WIP tracking or false to check the status before every operation.
+ *
+ * @return 0 if WIP tracking was configured or an error code.
+ */
+int spi_flash_enable_wip_tracking (const struct spi_flash *flash, bool enable)
+{
+	if (flash == NULL) {
+		return SPI_FLASH_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&flash->state->lock);
+
+	flash->state->track_wip = enable;
+	flash->state->wip_idle = false;
+
+	platform_mutex_unlock (&flash->state->lock);
+
+	return 0;
+}
+
+/**
+ * Get the SPI transaction counters for the flash device.
+ *
+ * @param flash The flash instance to query.
+ * @param stats Output for the transaction counters.
+ *
+ * @return 0 if the counters were retrieved or an error code.
+ */
+int spi_flash_get_xfer_stats (const struct spi_flash *flash, struct spi_flash_xfer_stats *stats)
+{
+	if ((flash == NULL) || (stats == NULL)) {
+		return SPI_FLASH_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&flash->state->lock);
+	*stats = flash->state->stats;
+	platform_mutex_unlock (&flash->state->lock);
+
+	return 0;
+}
+
+/**
+ * Clear the SPI transaction counters for the flash device.
+ *
+ * @param flash The flash instance to update.
+ *
+ * @return 0 if the counters were cleared or an error code.
+ */
+int spi_flash_reset_xfer_stats (const struct spi_flash *flash)
+{
+	if (flash == NULL) {
+		return SPI_FLASH_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&flash->state->lock);
+	memset (&flash->state->stats, 0, sizeof (flash->state->stats));
+	platform_mutex_unlock (&flash->state->lock);
+
+	return 0;
+}
+
+/**
+ * Configure which write operations can be suspended to service reads from other contexts.  When a
+ * write operation is suspendable, the driver will not hold exclusive access to the flash while
+ * waiting for the write to complete.  A read during this time will suspend the write, read the
+ * data, and resume the write.  All other flash operations will wait for the write to complete.
+ *
+ * Chip erase is never suspended.  The commands and timing requirements are determined from SFDP
+ * during device discovery, so suspend is only available after device properties have been detected.
+ * Suspend is also only supported on devices with a known location for the suspend status, which is
+ * used to confirm that suspended writes have been resumed.
+ *
+ * @param flash The flash instance to configure.
+ * @param operations A bitmask of SPI_FLASH_SUSPEND_* operations that can be suspended.  Set this to
+ * 0 to disable write suspend.
+ *
+ * @return 0 if write suspend was configured or an error code.
+ */
+int spi_flash_enable_suspend (const struct spi_flash *flash, uint8_t operations)
+{
+	const struct spi_flash_sfdp_suspend *suspend;
+	uint8_t vendor;
+	uint8_t cmd;
+	uint8_t mask;
+	int status = 0;
+
+	if (flash == NULL) {
+		return SPI_FLASH_INVALID_ARGUMENT;
+	}
+
+	if (operations) {
+		status = spi_flash_get_device_id (flash, &vendor, NULL);
+		if (status != 0) {
+			return status;
+		}
+
+		status = spi_flash_get_suspend_status_reg (vendor, SPI_FLASH_SUSPEND_ERASE, &cmd, &mask);
+		if (status != 0) {
+			return status;
+		}
+	}
+
+	spi_flash_acquire (flash);
+
+	suspend = &flash->state->suspend;
+	if (((operations & SPI_FLASH_SUSPEND_ERASE) &&
+			((suspend->erase_suspend == 0) || (suspend->erase_resume == 0))) ||
+		((operations & SPI_FLASH_SUSPEND_PROGRAM) &&
+			((suspend->program_suspend == 0) || (suspend->program_resume == 0)))) {
+		status = SPI_FLASH_SUSPEND_NOT_SUPPORTED;
+	}
+	else {
+		flash->state->suspend_ops = operations & (SPI_FLASH_SUSPEND_ERASE |
+			SPI_FLASH_SUSPEND_PROGRAM);
+	}
+
+	platform_mutex_unlock (&flash->state->lock);
+
+	return status;
+}
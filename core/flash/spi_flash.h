@@ -33,6 +33,22 @@ struct spi_flash_commands {
 	uint8_t release_pwrdown;			/**< The command to release deep power down. */
 };
 
+/**
+ * Counters for SPI transactions issued by a flash driver instance.
+ */
+struct spi_flash_xfer_stats {
+	uint32_t xfers;						/**< Total number of SPI transactions sent to the device. */
+	uint32_t status_polls;				/**< Number of status register reads to check for a write in progress. */
+	uint32_t status_polls_skipped;		/**< Number of status checks skipped because the device was known to be idle. */
+	uint32_t suspends;					/**< Number of write operations suspended to allow a read. */
+};
+
+/**
+ * Write operations that can be suspended to service reads.
+ */
+#define	SPI_FLASH_SUSPEND_ERASE			(1U << 0)
+#define	SPI_FLASH_SUSPEND_PROGRAM		(1U << 1)
+
 /**
  * Variable context for a SPI flash driver instance.
  */
@@ -49,6 +65,15 @@ struct spi_flash_state {
 	bool reset_3byte;									/**< Flag to switch to 3-byte mode on reset. */
 	enum spi_flash_sfdp_quad_enable quad_enable;		/**< Method to enable QSPI. */
 	bool sr1_volatile;									/**< Flag to use volatile write enable for status register 1. */
+	bool track_wip;										/**< Flag to skip status checks when the device is known to be idle. */
+	bool wip_idle;										/**< Flag indicating the device is known to have no write in progress. */
+	struct spi_flash_xfer_stats stats;					/**< SPI transaction counters. */
+	struct spi_flash_sfdp_suspend suspend;				/**< Commands and timing for write suspend. */
+	uint8_t suspend_ops;								/**< Write operations that can be suspended for reads. */
+	uint8_t active_op;									/**< Suspendable write operation currently executing. */
+	uint32_t active_addr;								/**< Start of the region modified by the active operation. */
+	uint32_t active_length;								/**< Length of the region modified by the active operation. */
+	bool resume_failed;									/**< Flag indicating the active operation could not be resumed. */
 };
 
 /**
@@ -170,6 +195,12 @@ int spi_flash_chip_erase (const struct spi_flash *flash);
 int spi_flash_is_write_in_progress (const struct spi_flash *flash);
 int spi_flash_wait_for_write (const struct spi_flash *flash, int32_t timeout);
 
+int spi_flash_enable_wip_tracking (const struct spi_flash *flash, bool enable);
+int spi_flash_get_xfer_stats (const struct spi_flash *flash, struct spi_flash_xfer_stats *stats);
+int spi_flash_reset_xfer_stats (const struct spi_flash *flash);
+
+int spi_flash_enable_suspend (const struct spi_flash *flash, uint8_t operations);
+
 
 #define	SPI_FLASH_ERROR(code)		ROT_ERROR (ROT_MODULE_SPI_FLASH, code)
 
@@ -193,6 +224,8 @@ enum {
 	SPI_FLASH_RESET_NOT_SUPPORTED = SPI_FLASH_ERROR (0x0d),		/**< Soft reset is not supported by the device. */
 	SPI_FLASH_PWRDOWN_NOT_SUPPORTED = SPI_FLASH_ERROR (0x0e),	/**< Deep power down is not supported by the device. */
 	SPI_FLASH_READ_ONLY_INTERFACE = SPI_FLASH_ERROR (0x0f),		/**< The interface is only configured to allow read access. */
+	SPI_FLASH_SUSPEND_NOT_SUPPORTED = SPI_FLASH_ERROR (0x10),	/**< Suspending write operations is not supported by the device. */
+	SPI_FLASH_RESUME_FAILED = SPI_FLASH_ERROR (0x11),			/**< A suspended write operation could not be resumed. */
 };
 
 
@@ -91,6 +91,13 @@ struct spi_flash_sfdp_basic_parameter_table_1_5 {
 	uint16_t program_time;			/**< 11th DWORD: Page programming typical timing. */
 	uint8_t chip_erase_time;		/**< 11th DWORD: Chip erase typical timing. */
 	uint32_t suspend_attr;			/**< 12th DWORD: Suspend/Resume attributes. */
+#define	SPI_FLASH_SFDP_NO_SUSPEND(x)			((x) & (1U << 31))
+#define	SPI_FLASH_SFDP_ERASE_SUSPEND_UNITS(x)	(((x) >> 29) & 0x3)
+#define	SPI_FLASH_SFDP_ERASE_SUSPEND_COUNT(x)	(((x) >> 24) & 0x1f)
+#define	SPI_FLASH_SFDP_ERASE_RESUME_COUNT(x)	(((x) >> 20) & 0xf)
+#define	SPI_FLASH_SFDP_PROGRAM_SUSPEND_UNITS(x)	(((x) >> 18) & 0x3)
+#define	SPI_FLASH_SFDP_PROGRAM_SUSPEND_COUNT(x)	(((x) >> 13) & 0x1f)
+#define	SPI_FLASH_SFDP_PROGRAM_RESUME_COUNT(x)	(((x) >> 9) & 0xf)
 	uint8_t program_resume;			/**< 13th DWORD: Program Resume instruction. */
 	uint8_t program_suspend;		/**< 13th DWORD: Program Suspend instruction. */
 	uint8_t resume;					/**< 13th DWORD: Resume instruction. */
@@ -823,6 +830,71 @@ int spi_flash_sfdp_get_deep_powerdown_commands (const struct spi_flash_sfdp_basi
 	return status;
 }
 
+/**
+ * Convert an SFDP suspend latency into microseconds.
+ *
+ * @param units The encoded units for the latency.
+ * @param count The encoded count for the latency.
+ *
+ * @return The latency in microseconds, rounded up.
+ */
+static uint32_t spi_flash_sfdp_suspend_latency_us (uint32_t units, uint32_t count)
+{
+	/* Latency units, in nanoseconds:  128ns, 1us, 8us, 64us */
+	const uint32_t unit_ns[] = {128, 1000, 8000, 64000};
+
+	return ((unit_ns[units] * (count + 1)) + 999) / 1000;
+}
+
+/**
+ * Get the commands and timing requirements for suspending and resuming erase and program
+ * operations.
+ *
+ * @param table The basic parameters table that will be queried.
+ * @param suspend Output for the suspend and resume information.  If suspend is not supported by the
+ * device, this will be zeroed.
+ *
+ * @return 0 if the suspend information was retrieved successfully or an error code.
+ */
+int spi_flash_sfdp_get_suspend_info (const struct spi_flash_sfdp_basic_table *table,
+	struct spi_flash_sfdp_suspend *suspend)
+{
+	struct spi_flash_sfdp_basic_parameter_table_1_5 *params;
+
+	if ((table == NULL) || (suspend == NULL)) {
+		return SPI_FLASH_SFDP_INVALID_ARGUMENT;
+	}
+
+	memset (suspend, 0, sizeof (*suspend));
+
+	if (table->sfdp->sfdp_header.parameter0.minor_revision < 5) {
+		return SPI_FLASH_SFDP_SUSPEND_NOT_SUPPORTED;
+	}
+
+	params = (struct spi_flash_sfdp_basic_parameter_table_1_5*) table->data;
+	if (SPI_FLASH_SFDP_NO_SUSPEND (params->suspend_attr)) {
+		return SPI_FLASH_SFDP_SUSPEND_NOT_SUPPORTED;
+	}
+
+	suspend->erase_suspend = params->suspend;
+	suspend->erase_resume = params->resume;
+	suspend->program_suspend = params->program_suspend;
+	suspend->program_resume = params->program_resume;
+
+	suspend->erase_suspend_us = spi_flash_sfdp_suspend_latency_us (
+		SPI_FLASH_SFDP_ERASE_SUSPEND_UNITS (params->suspend_attr),
+		SPI_FLASH_SFDP_ERASE_SUSPEND_COUNT (params->suspend_attr));
+	suspend->erase_resume_us =
+		(SPI_FLASH_SFDP_ERASE_RESUME_COUNT (params->suspend_attr) + 1) * 64;
+	suspend->program_suspend_us = spi_flash_sfdp_suspend_latency_us (
+		SPI_FLASH_SFDP_PROGRAM_SUSPEND_UNITS (params->suspend_attr),
+		SPI_FLASH_SFDP_PROGRAM_SUSPEND_COUNT (params->suspend_attr));
+	suspend->program_resume_us =
+		(SPI_FLASH_SFDP_PROGRAM_RESUME_COUNT (params->suspend_attr) + 1) * 64;
+
+	return 0;
+}
+
 /**
  * Print the contents of the basic parameters table.
  *
@@ -110,6 +110,20 @@ enum spi_flash_sfdp_quad_enable {
 	SPI_FLASH_SFDP_QUAD_NO_QE_HOLD_DISABLE = 8,		/**< No quad enable bit, but HOLD/RESET can be disabled. */
 };
 
+/**
+ * Commands and timing requirements for suspending write operations.
+ */
+struct spi_flash_sfdp_suspend {
+	uint8_t erase_suspend;						/**< Command to suspend an erase operation. */
+	uint8_t erase_resume;						/**< Command to resume a suspended erase operation. */
+	uint8_t program_suspend;					/**< Command to suspend a program operation. */
+	uint8_t program_resume;						/**< Command to resume a suspended program operation. */
+	uint32_t erase_suspend_us;					/**< Maximum time for an erase to suspend, in microseconds. */
+	uint32_t erase_resume_us;					/**< Minimum time after resuming an erase before it can be suspended again. */
+	uint32_t program_suspend_us;				/**< Maximum time for a program to suspend, in microseconds. */
+	uint32_t program_resume_us;					/**< Minimum time after resuming a program before it can be suspended again. */
+};
+
 
 int spi_flash_sfdp_basic_table_init (struct spi_flash_sfdp_basic_table *table,
 	const struct spi_flash_sfdp *sfdp);
@@ -138,6 +152,8 @@ int spi_flash_sfdp_get_reset_command (const struct spi_flash_sfdp_basic_table *t
 	uint8_t *reset);
 int spi_flash_sfdp_get_deep_powerdown_commands (const struct spi_flash_sfdp_basic_table *table,
 	uint8_t *enter, uint8_t *exit);
+int spi_flash_sfdp_get_suspend_info (const struct spi_flash_sfdp_basic_table *table,
+	struct spi_flash_sfdp_suspend *suspend);
 
 void spi_flash_sfdp_dump_basic_table (const struct spi_flash_sfdp_basic_table *table);
 
@@ -157,6 +173,7 @@ enum {
 	SPI_FLASH_SFDP_QUAD_ENABLE_UNKNOWN = SPI_FLASH_SFDP_ERROR (0x06),	/**< QSPI enabled method cannot be determined. */
 	SPI_FLASH_SFDP_RESET_NOT_SUPPORTED = SPI_FLASH_SFDP_ERROR (0x07),	/**< Soft reset is not supported by the device. */
 	SPI_FLASH_SFDP_PWRDOWN_NOT_SUPPORTED = SPI_FLASH_SFDP_ERROR (0x08),	/**< Deep power down is not supported by the device. */
+	SPI_FLASH_SFDP_SUSPEND_NOT_SUPPORTED = SPI_FLASH_SFDP_ERROR (0x09),	/**< Suspending write operations is not supported by the device. */
 };
 
 
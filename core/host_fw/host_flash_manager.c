@@ -179,13 +179,17 @@ int host_flash_manager_validate_flash (struct pfm *pfm, struct hash_engine *hash
  * @param flash The flash device to validate.
  * @param offset An offset in flash for images that will be validated.  Ignored if full_validation
  * is set.
+ * @param cache Optional cache of verified flash contents.  The cache is not used for images at an
+ * offset.
+ * @param cs The chip select of the flash device.  Ignored if there is no cache.
  * @param host_rw Output for the read/write regions of the validated flash.  This will only be
  * valid if the flash is successfully validated.  This can be null if full_validation is false.
  *
  * @return 0 if the validation was successful or an error code.
  */
-int host_flash_manager_validate_offset_flash (struct pfm *pfm, struct hash_engine *hash,
+static int host_flash_manager_validate_flash_on_device (struct pfm *pfm, struct hash_engine *hash,
 	struct rsa_engine *rsa, bool full_validation, const struct spi_flash *flash, uint32_t offset,
+	struct host_flash_verify_cache *cache, spi_filter_cs cs,
 	struct host_flash_manager_rw_regions *host_rw)
 {
 	struct pfm_firmware host_fw;
@@ -216,8 +220,19 @@ int host_flash_manager_validate_offset_flash (struct pfm *pfm, struct hash_engin
 	}
 
 	if (full_validation) {
-		status = host_fw_full_flash_verification_multiple_fw (flash, host_img.fw_images,
-			host_rw->writable, host_fw.count, version->blank_byte, hash, rsa);
+		if (cache) {
+			status = host_fw_full_flash_verification_multiple_fw_with_cache (flash,
+				host_img.fw_images, host_rw->writable, host_fw.count, version->blank_byte, hash,
+				rsa, cache, cs);
+		}
+		else {
+			status = host_fw_full_flash_verification_multiple_fw (flash, host_img.fw_images,
+				host_rw->writable, host_fw.count, version->blank_byte, hash, rsa);
+		}
+	}
+	else if (cache && (offset == 0)) {
+		status = host_fw_verify_images_multiple_fw_with_cache (flash, host_img.fw_images,
+			host_img.count, hash, rsa, cache, cs);
 	}
 	else {
 		status = host_fw_verify_offset_images_multiple_fw (flash, host_img.fw_images,
@@ -234,6 +249,55 @@ free_host:
 	return status;
 }
 
+/**
+ * Validate the image on a flash device.
+ *
+ * @param pfm The PFM to use for validation.
+ * @param hash The hash to use for image validation.
+ * @param rsa The RSA engine to use for signature verification.
+ * @param full_validation Flag to control level of flash validation.
+ * @param flash The flash device to validate.
+ * @param offset An offset in flash for images that will be validated.  Ignored if full_validation
+ * is set.
+ * @param host_rw Output for the read/write regions of the validated flash.  This will only be
+ * valid if the flash is successfully validated.  This can be null if full_validation is false.
+ *
+ * @return 0 if the validation was successful or an error code.
+ */
+int host_flash_manager_validate_offset_flash (struct pfm *pfm, struct hash_engine *hash,
+	struct rsa_engine *rsa, bool full_validation, const struct spi_flash *flash, uint32_t offset,
+	struct host_flash_manager_rw_regions *host_rw)
+{
+	return host_flash_manager_validate_flash_on_device (pfm, hash, rsa, full_validation, flash,
+		offset, NULL, SPI_FILTER_CS_0, host_rw);
+}
+
+/**
+ * Validate the image on a flash device.  Only the parts of flash that have been written by the
+ * host since the last validation of the device will be read.
+ *
+ * @param pfm The PFM to use for validation.
+ * @param hash The hash to use for image validation.
+ * @param rsa The RSA engine to use for signature verification.
+ * @param full_validation Flag to control level of flash validation.
+ * @param flash The flash device to validate.
+ * @param cache The cache of verified flash contents.  If this is null, the entire flash will be
+ * validated.
+ * @param cs The chip select of the flash device.
+ * @param host_rw Output for the read/write regions of the validated flash.  This will only be
+ * valid if the flash is successfully validated.  This can be null if full_validation is false.
+ *
+ * @return 0 if the validation was successful or an error code.
+ */
+int host_flash_manager_validate_flash_with_cache (struct pfm *pfm, struct hash_engine *hash,
+	struct rsa_engine *rsa, bool full_validation, const struct spi_flash *flash,
+	struct host_flash_verify_cache *cache, spi_filter_cs cs,
+	struct host_flash_manager_rw_regions *host_rw)
+{
+	return host_flash_manager_validate_flash_on_device (pfm, hash, rsa, full_validation, flash, 0,
+		cache, cs, host_rw);
+}
+
 /**
  * Validate a PFM against the image on flash using a different PFM that is known to validate that
  * image.
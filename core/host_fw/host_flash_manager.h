@@ -15,6 +15,7 @@
 #include "manifest/pfm/pfm_manager.h"
 #include "crypto/hash.h"
 #include "crypto/rsa.h"
+#include "host_flash_verify_cache.h"
 
 
 /**
@@ -230,6 +231,18 @@ struct host_flash_manager {
 	 * @return 0 if the flash was successfully reset or an error code.
 	 */
 	int (*reset_flash) (struct host_flash_manager *manager);
+
+	/**
+	 * Discard any information about flash contents that have already been verified.  This must be
+	 * called before the RoT modifies the protected flash devices outside of the other flash
+	 * management functions, since these writes are not tracked by the SPI filter.
+	 *
+	 * This is optional and will be null for managers that don't keep any information about
+	 * verified flash contents.
+	 *
+	 * @param manager The manager for the flash devices being modified.
+	 */
+	void (*invalidate_verified_flash) (struct host_flash_manager *manager);
 };
 
 
@@ -247,6 +260,10 @@ int host_flash_manager_validate_flash (struct pfm *pfm, struct hash_engine *hash
 int host_flash_manager_validate_offset_flash (struct pfm *pfm, struct hash_engine *hash,
 	struct rsa_engine *rsa, bool full_validation, const struct spi_flash *flash, uint32_t offset,
 	struct host_flash_manager_rw_regions *host_rw);
+int host_flash_manager_validate_flash_with_cache (struct pfm *pfm, struct hash_engine *hash,
+	struct rsa_engine *rsa, bool full_validation, const struct spi_flash *flash,
+	struct host_flash_verify_cache *cache, spi_filter_cs cs,
+	struct host_flash_manager_rw_regions *host_rw);
 int host_flash_manager_validate_pfm (struct pfm *pfm, struct pfm *good_pfm,
 	struct hash_engine *hash, struct rsa_engine *rsa, const struct spi_flash *flash,
 	struct host_flash_manager_rw_regions *host_rw);
@@ -43,10 +43,72 @@ static const struct spi_flash* host_flash_manager_dual_get_read_write_flash (
 	}
 }
 
+/**
+ * Get the cache of verified contents for one of the flash devices.
+ *
+ * @param dual The flash manager for the flash devices.
+ * @param cs The chip select of the flash device.
+ *
+ * @return The cache for the flash device or null if there is no cache.
+ */
+static struct host_flash_verify_cache* host_flash_manager_dual_get_verify_cache (
+	struct host_flash_manager_dual *dual, spi_filter_cs cs)
+{
+	return (cs == SPI_FILTER_CS_0) ? dual->verify_cache_cs0 : dual->verify_cache_cs1;
+}
+
+/**
+ * Discard all cached information about both flash devices.
+ *
+ * @param dual The flash manager for the flash devices.
+ */
+static void host_flash_manager_dual_invalidate_verify_cache (struct host_flash_manager_dual *dual)
+{
+	host_flash_verify_cache_invalidate (dual->verify_cache_cs0);
+	host_flash_verify_cache_invalidate (dual->verify_cache_cs1);
+}
+
+/**
+ * Validate one of the flash devices.  If a cache of verified flash contents is available, it will
+ * be used to limit the amount of flash that needs to be read.  Both devices can be validated at
+ * the same time from different tasks.  If both devices share one cache, only one of them will use
+ * the cache.
+ *
+ * @param dual The flash manager to use for validation.
+ * @param pfm The PFM to validate the flash against.
+ * @param hash The hash engine to use for validation.
+ * @param rsa The RSA engine to use for signature verification.
+ * @param full_validation Flag indicating if a full flash validation should be run.
+ * @param cs The chip select of the flash device to validate.
+ * @param host_rw Output for the read/write regions of the validated flash.
+ *
+ * @return 0 if the flash was successfully validated or an error code.
+ */
+static int host_flash_manager_dual_validate_flash (struct host_flash_manager_dual *dual,
+	struct pfm *pfm, struct hash_engine *hash, struct rsa_engine *rsa, bool full_validation,
+	spi_filter_cs cs, struct host_flash_manager_rw_regions *host_rw)
+{
+	const struct spi_flash *flash = (cs == SPI_FILTER_CS_0) ? dual->flash_cs0 : dual->flash_cs1;
+	struct host_flash_verify_cache *cache = host_flash_manager_dual_get_verify_cache (dual, cs);
+	int status;
+
+	if (!host_flash_verify_cache_claim (cache)) {
+		cache = NULL;
+	}
+
+	status = host_flash_manager_validate_flash_with_cache (pfm, hash, rsa, full_validation, flash,
+		cache, cs, host_rw);
+
+	host_flash_verify_cache_unclaim (cache);
+
+	return status;
+}
+
 static int host_flash_manager_dual_validate_read_only_flash (struct host_flash_manager *manager,
 	struct pfm *pfm, struct pfm *good_pfm, struct hash_engine *hash, struct rsa_engine *rsa,
 	bool full_validation, struct host_flash_manager_rw_regions *host_rw)
 {
+	struct host_flash_manager_dual *dual = (struct host_flash_manager_dual*) manager;
 	int status;
 
 	if ((manager == NULL) || (pfm == NULL) || (hash == NULL) || (rsa == NULL) ||
@@ -59,8 +121,8 @@ static int host_flash_manager_dual_validate_read_only_flash (struct host_flash_m
 			host_flash_manager_dual_get_read_only_flash (manager), host_rw);
 	}
 	else {
-		status = host_flash_manager_validate_flash (pfm, hash, rsa, full_validation,
-			host_flash_manager_dual_get_read_only_flash (manager), host_rw);
+		status = host_flash_manager_dual_validate_flash (dual, pfm, hash, rsa, full_validation,
+			host_state_manager_get_read_only_flash (dual->host_state), host_rw);
 	}
 
 	return status;
@@ -70,13 +132,17 @@ static int host_flash_manager_dual_validate_read_write_flash (struct host_flash_
 	struct pfm *pfm, struct hash_engine *hash, struct rsa_engine *rsa,
 	struct host_flash_manager_rw_regions *host_rw)
 {
+	struct host_flash_manager_dual *dual = (struct host_flash_manager_dual*) manager;
+
 	if ((manager == NULL) || (pfm == NULL) || (hash == NULL) || (rsa == NULL) ||
 		(host_rw == NULL)) {
 		return HOST_FLASH_MGR_INVALID_ARGUMENT;
 	}
 
-	return host_flash_manager_validate_flash (pfm, hash, rsa, true,
-		host_flash_manager_dual_get_read_write_flash (manager), host_rw);
+	return host_flash_manager_dual_validate_flash (dual, pfm, hash, rsa, true,
+		(host_state_manager_get_read_only_flash (dual->host_state) == SPI_FILTER_CS_0) ?
+			SPI_FILTER_CS_1 : SPI_FILTER_CS_0,
+		host_rw);
 }
 
 static int host_flash_manager_dual_get_flash_read_write_regions (struct host_flash_manager *manager,
@@ -115,6 +181,10 @@ static int host_flash_manager_dual_config_spi_filter_flash_devices (
 		return HOST_FLASH_MGR_INVALID_ARGUMENT;
 	}
 
+	/* The flash devices are configured after the RoT has programmed them, which is not tracked by
+	 * the SPI filter. */
+	host_flash_manager_dual_invalidate_verify_cache (dual);
+
 	ro = host_state_manager_get_read_only_flash (dual->host_state);
 	return dual->filter->set_ro_cs (dual->filter, ro);
 }
@@ -134,10 +204,16 @@ static int host_flash_manager_dual_migrate_rw_data (struct host_flash_manager_du
 	int status;
 
 	if (from == SPI_FILTER_CS_0) {
+		host_flash_verify_cache_invalidate_read_write_regions (manager->verify_cache_cs1,
+			SPI_FILTER_CS_1, host_rw->writable, host_rw->count);
+
 		status = host_fw_migrate_read_write_data_multiple_fw (manager->flash_cs1, host_rw->writable,
 			host_rw->count, manager->flash_cs0, NULL, 0);
 	}
 	else {
+		host_flash_verify_cache_invalidate_read_write_regions (manager->verify_cache_cs0,
+			SPI_FILTER_CS_0, host_rw->writable, host_rw->count);
+
 		status = host_fw_migrate_read_write_data_multiple_fw (manager->flash_cs0, host_rw->writable,
 			host_rw->count, manager->flash_cs1, NULL, 0);
 	}
@@ -262,10 +338,19 @@ static int host_flash_manager_dual_initialize_flash_protection (struct host_flas
 static int host_flash_manager_dual_restore_flash_read_write_regions (
 	struct host_flash_manager *manager, struct host_flash_manager_rw_regions *host_rw)
 {
+	struct host_flash_manager_dual *dual = (struct host_flash_manager_dual*) manager;
+	spi_filter_cs rw_cs;
+
 	if ((manager == NULL) || (host_rw == NULL)) {
 		return HOST_FLASH_MGR_INVALID_ARGUMENT;
 	}
 
+	rw_cs = (host_state_manager_get_read_only_flash (dual->host_state) == SPI_FILTER_CS_0) ?
+		SPI_FILTER_CS_1 : SPI_FILTER_CS_0;
+	host_flash_verify_cache_invalidate_read_write_regions (
+		host_flash_manager_dual_get_verify_cache (dual, rw_cs), rw_cs, host_rw->writable,
+		host_rw->count);
+
 	return host_fw_restore_read_write_data_multiple_fw (
 		host_flash_manager_dual_get_read_write_flash (manager),
 		host_flash_manager_dual_get_read_only_flash (manager), host_rw->writable, host_rw->count);
@@ -325,6 +410,16 @@ static int host_flash_manager_dual_reset_flash (struct host_flash_manager *manag
 	return spi_flash_reset_device (dual->flash_cs1);
 }
 
+static void host_flash_manager_dual_invalidate_verified_flash (
+	struct host_flash_manager *manager)
+{
+	struct host_flash_manager_dual *dual = (struct host_flash_manager_dual*) manager;
+
+	if (dual != NULL) {
+		host_flash_manager_dual_invalidate_verify_cache (dual);
+	}
+}
+
 /**
  * Initialize the manager for dual host flash devices.
  *
@@ -367,6 +462,7 @@ int host_flash_manager_dual_init (struct host_flash_manager_dual *manager,
 	manager->base.set_flash_for_host_access = host_flash_manager_dual_set_flash_for_host_access;
 	manager->base.host_has_flash_access = host_flash_manager_dual_host_has_flash_access;
 	manager->base.reset_flash = host_flash_manager_dual_reset_flash;
+	manager->base.invalidate_verified_flash = host_flash_manager_dual_invalidate_verified_flash;
 
 	manager->flash_cs0 = cs0;
 	manager->flash_cs1 = cs1;
@@ -414,6 +510,38 @@ int host_flash_manager_dual_init_with_managed_flash_initialization (
 	return 0;
 }
 
+/**
+ * Use a cache of verified flash contents to reduce the amount of flash that must be read when
+ * validating the flash devices.  Only flash written by the host since the last validation of a
+ * device will be read.  This requires a SPI filter that supports dirty block tracking.  Otherwise,
+ * every validation will read the entire flash.
+ *
+ * The same cache can be used for both flash devices.  In that case, only one device can use the
+ * cache at a time, so a device validated in parallel with the other will be fully read.  Separate
+ * caches allow both devices to use a cache when they are validated at the same time.
+ *
+ * @param manager The flash manager to update.
+ * @param cache_cs0 The cache to use for validation of the CS0 flash.  Set this to null to validate
+ * the entire flash every time.
+ * @param cache_cs1 The cache to use for validation of the CS1 flash.  Set this to null to validate
+ * the entire flash every time.
+ *
+ * @return 0 if the caches were configured successfully or an error code.
+ */
+int host_flash_manager_dual_set_verify_cache (struct host_flash_manager_dual *manager,
+	struct host_flash_verify_cache *cache_cs0, struct host_flash_verify_cache *cache_cs1)
+{
+	if (manager == NULL) {
+		return HOST_FLASH_MGR_INVALID_ARGUMENT;
+	}
+
+	manager->verify_cache_cs0 = cache_cs0;
+	manager->verify_cache_cs1 = cache_cs1;
+	host_flash_manager_dual_invalidate_verify_cache (manager);
+
+	return 0;
+}
+
 /**
  * Release the resources used for dual host flash management.
  *
@@ -19,6 +19,8 @@ struct host_flash_manager_dual {
 	const struct spi_filter_interface *filter;			/**< The SPI filter connected to the flash devices. */
 	const struct flash_mfg_filter_handler *mfg_handler;	/**< The filter handler for flash device types. */
 	struct host_flash_initialization *flash_init;		/**< Host flash initialization manager. */
+	struct host_flash_verify_cache *verify_cache_cs0;	/**< Cache of verified contents for the CS0 flash. */
+	struct host_flash_verify_cache *verify_cache_cs1;	/**< Cache of verified contents for the CS1 flash. */
 };
 
 
@@ -32,5 +34,8 @@ int host_flash_manager_dual_init_with_managed_flash_initialization (
 	struct host_flash_initialization *flash_init);
 void host_flash_manager_dual_release (struct host_flash_manager_dual *manager);
 
+int host_flash_manager_dual_set_verify_cache (struct host_flash_manager_dual *manager,
+	struct host_flash_verify_cache *cache_cs0, struct host_flash_verify_cache *cache_cs1);
+
 
 #endif /* HOST_FLASH_MANAGER_DUAL_H_ */
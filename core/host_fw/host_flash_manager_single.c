@@ -47,8 +47,8 @@ static int host_flash_manager_single_validate_read_only_flash (struct host_flash
 		status = host_flash_manager_validate_pfm (pfm, good_pfm, hash, rsa, single->flash, host_rw);
 	}
 	else {
-		status = host_flash_manager_validate_flash (pfm, hash, rsa, full_validation, single->flash,
-			host_rw);
+		status = host_flash_manager_validate_flash_with_cache (pfm, hash, rsa, full_validation,
+			single->flash, single->verify_cache, SPI_FILTER_CS_0, host_rw);
 	}
 
 	return status;
@@ -64,7 +64,8 @@ static int host_flash_manager_single_validate_read_write_flash (struct host_flas
 		return HOST_FLASH_MGR_INVALID_ARGUMENT;
 	}
 
-	return host_flash_manager_validate_flash (pfm, hash, rsa, true, single->flash, host_rw);
+	return host_flash_manager_validate_flash_with_cache (pfm, hash, rsa, true, single->flash,
+		single->verify_cache, SPI_FILTER_CS_0, host_rw);
 }
 
 static int host_flash_manager_single_get_flash_read_write_regions (
@@ -105,6 +106,10 @@ static int host_flash_manager_single_config_spi_filter_flash_devices (
 		return HOST_FLASH_MGR_INVALID_ARGUMENT;
 	}
 
+	/* The flash device is configured after the RoT has programmed it, which is not tracked by the
+	 * SPI filter. */
+	host_flash_verify_cache_invalidate (single->verify_cache);
+
 	status = single->filter->allow_all_single_flash_writes (single->filter, true);
 	if (status != 0) {
 		return status;
@@ -255,6 +260,16 @@ static int host_flash_manager_single_reset_flash (struct host_flash_manager *man
 	return spi_flash_reset_device (single->flash);
 }
 
+static void host_flash_manager_single_invalidate_verified_flash (
+	struct host_flash_manager *manager)
+{
+	struct host_flash_manager_single *single = (struct host_flash_manager_single*) manager;
+
+	if (single != NULL) {
+		host_flash_verify_cache_invalidate (single->verify_cache);
+	}
+}
+
 /**
  * Initialize the manager for a single host flash device.
  *
@@ -297,6 +312,7 @@ int host_flash_manager_single_init (struct host_flash_manager_single *manager,
 	manager->base.set_flash_for_host_access = host_flash_manager_single_set_flash_for_host_access;
 	manager->base.host_has_flash_access = host_flash_manager_single_host_has_flash_access;
 	manager->base.reset_flash = host_flash_manager_single_reset_flash;
+	manager->base.invalidate_verified_flash = host_flash_manager_single_invalidate_verified_flash;
 
 	manager->flash = flash;
 	manager->host_state = host_state;
@@ -342,6 +358,31 @@ int host_flash_manager_single_init_with_managed_flash_initialization (
 	return 0;
 }
 
+/**
+ * Use a cache of verified flash contents to reduce the amount of flash that must be read when
+ * validating the flash device.  Only flash written by the host since the last validation will be
+ * read.  This requires a SPI filter that supports dirty block tracking.  Otherwise, every
+ * validation will read the entire flash.
+ *
+ * @param manager The flash manager to update.
+ * @param cache The cache to use for flash validation.  Set this to null to validate the entire
+ * flash every time.
+ *
+ * @return 0 if the cache was configured successfully or an error code.
+ */
+int host_flash_manager_single_set_verify_cache (struct host_flash_manager_single *manager,
+	struct host_flash_verify_cache *cache)
+{
+	if (manager == NULL) {
+		return HOST_FLASH_MGR_INVALID_ARGUMENT;
+	}
+
+	host_flash_verify_cache_invalidate (cache);
+	manager->verify_cache = cache;
+
+	return 0;
+}
+
 /**
  * Release the resources used for single host flash management.
  *
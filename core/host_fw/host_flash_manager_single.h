@@ -20,6 +20,7 @@ struct host_flash_manager_single {
 	const struct spi_filter_interface *filter;			/**< The SPI filter connected to the flash devices. */
 	const struct flash_mfg_filter_handler *mfg_handler;	/**< The filter handler for flash device types. */
 	struct host_flash_initialization *flash_init;		/**< Host flash initialization manager. */
+	struct host_flash_verify_cache *verify_cache;		/**< Cache of verified flash contents. */
 };
 
 
@@ -33,5 +34,8 @@ int host_flash_manager_single_init_with_managed_flash_initialization (
 	struct host_flash_initialization *flash_init);
 void host_flash_manager_single_release (struct host_flash_manager_single *manager);
 
+int host_flash_manager_single_set_verify_cache (struct host_flash_manager_single *manager,
+	struct host_flash_verify_cache *cache);
+
 
 #endif /* HOST_FLASH_MANAGER_SINGLE_H_ */
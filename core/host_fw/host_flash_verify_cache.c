@@ -0,0 +1,509 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdlib.h>
+#include <string.h>
+#include "host_flash_verify_cache.h"
+
+
+/**
+ * Initialize a cache of verified host flash contents.
+ *
+ * @param cache The cache to initialize.
+ * @param filter The SPI filter that will report host writes to flash.  If the filter does not
+ * support dirty block tracking, nothing will be cached.
+ * @param entries Storage for cached image digests.
+ * @param entry_count The number of image digests that can be cached.
+ * @param bitmap Buffer to use for dirty block information from the SPI filter.  This must be large
+ * enough to hold the bitmap for an entire flash device.
+ * @param length Length of the bitmap buffer.
+ *
+ * @return 0 if the cache was initialized successfully or an error code.
+ */
+int host_flash_verify_cache_init (struct host_flash_verify_cache *cache,
+	const struct spi_filter_interface *filter, struct host_flash_verify_cache_entry *entries,
+	size_t entry_count, uint8_t *bitmap, size_t length)
+{
+	if ((cache == NULL) || (filter == NULL) || (entries == NULL) || (entry_count == 0) ||
+		(bitmap == NULL) || (length == 0)) {
+		return HOST_FLASH_VERIFY_CACHE_INVALID_ARGUMENT;
+	}
+
+	memset (cache, 0, sizeof (struct host_flash_verify_cache));
+	memset (entries, 0, sizeof (struct host_flash_verify_cache_entry) * entry_count);
+
+	cache->filter = filter;
+	cache->entries = entries;
+	cache->entry_count = entry_count;
+	cache->bitmap = bitmap;
+	cache->length = length;
+
+	return platform_mutex_init (&cache->lock);
+}
+
+/**
+ * Release the resources used by a host flash verification cache.
+ *
+ * @param cache The cache to release.
+ */
+void host_flash_verify_cache_release (struct host_flash_verify_cache *cache)
+{
+	if (cache) {
+		platform_mutex_free (&cache->lock);
+	}
+}
+
+/**
+ * Claim exclusive use of the cache for a verification.  This must be released with
+ * host_flash_verify_cache_unclaim when verification has completed.
+ *
+ * @param cache The cache to claim.
+ *
+ * @return true if the cache was claimed or false if the cache is null or already in use.
+ */
+bool host_flash_verify_cache_claim (struct host_flash_verify_cache *cache)
+{
+	bool claimed = false;
+
+	if (cache) {
+		platform_mutex_lock (&cache->lock);
+
+		if (!cache->claimed) {
+			cache->claimed = true;
+			claimed = true;
+		}
+
+		platform_mutex_unlock (&cache->lock);
+	}
+
+	return claimed;
+}
+
+/**
+ * Release a claim on the cache for a completed verification.
+ *
+ * @param cache The cache to release.
+ */
+void host_flash_verify_cache_unclaim (struct host_flash_verify_cache *cache)
+{
+	if (cache) {
+		platform_mutex_lock (&cache->lock);
+		cache->claimed = false;
+		platform_mutex_unlock (&cache->lock);
+	}
+}
+
+/**
+ * Discard all cached information about host flash.  The next verification of each flash device
+ * will check the entire device.
+ *
+ * @param cache The cache to invalidate.
+ */
+void host_flash_verify_cache_invalidate (struct host_flash_verify_cache *cache)
+{
+	size_t i;
+
+	if (cache == NULL) {
+		return;
+	}
+
+	for (i = 0; i < cache->entry_count; i++) {
+		cache->entries[i].count = 0;
+	}
+
+	for (i = 0; i < HOST_FLASH_VERIFY_CACHE_MAX_DEVICES; i++) {
+		cache->layout_valid[i] = false;
+	}
+
+	cache->tracking = false;
+	cache->layout_checked = false;
+}
+
+/**
+ * Determine if two address ranges overlap.
+ *
+ * @param region The first address range.
+ * @param addr The start of the second address range.
+ * @param length The length of the second address range.
+ *
+ * @return true if the ranges overlap.
+ */
+static bool host_flash_verify_cache_is_overlapping (const struct flash_region *region,
+	uint32_t addr, size_t length)
+{
+	return (((uint64_t) region->start_addr < ((uint64_t) addr + length)) &&
+		((uint64_t) addr < ((uint64_t) region->start_addr + region->length)));
+}
+
+/**
+ * Discard cached information for a region of flash that has been modified by the RoT.
+ *
+ * @param cache The cache to update.
+ * @param cs The flash device that was modified.
+ * @param addr The first address that was modified.
+ * @param length The number of bytes that were modified.
+ */
+void host_flash_verify_cache_invalidate_region (struct host_flash_verify_cache *cache,
+	spi_filter_cs cs, uint32_t addr, size_t length)
+{
+	struct host_flash_verify_cache_entry *entry;
+	size_t i;
+	size_t j;
+
+	if ((cache == NULL) || (cs >= HOST_FLASH_VERIFY_CACHE_MAX_DEVICES)) {
+		return;
+	}
+
+	for (i = 0; i < cache->entry_count; i++) {
+		entry = &cache->entries[i];
+
+		if (entry->cs == cs) {
+			for (j = 0; j < entry->count; j++) {
+				if (host_flash_verify_cache_is_overlapping (&entry->regions[j], addr, length)) {
+					entry->count = 0;
+				}
+			}
+		}
+	}
+
+	/* The layout digest does not identify which parts of flash were checked, so any modification
+	 * requires unused flash to be checked again. */
+	cache->layout_valid[cs] = false;
+}
+
+/**
+ * Discard cached information for the read/write regions of flash after the RoT has modified the
+ * read/write data.
+ *
+ * @param cache The cache to update.
+ * @param cs The flash device that was modified.
+ * @param writable An array of read/write regions for each firmware component.
+ * @param fw_count The number of firmware components in the list.
+ */
+void host_flash_verify_cache_invalidate_read_write_regions (struct host_flash_verify_cache *cache,
+	spi_filter_cs cs, const struct pfm_read_write_regions *writable, size_t fw_count)
+{
+	size_t i;
+	size_t j;
+
+	if ((cache == NULL) || (writable == NULL)) {
+		return;
+	}
+
+	for (i = 0; i < fw_count; i++) {
+		for (j = 0; j < writable[i].count; j++) {
+			host_flash_verify_cache_invalidate_region (cache, cs, writable[i].regions[j].start_addr,
+				writable[i].regions[j].length);
+		}
+	}
+}
+
+/**
+ * Determine if any block in a region of flash has been written by the host.
+ *
+ * @param cache The cache to query.
+ * @param addr The first address in the region.
+ * @param length The length of the region.
+ *
+ * @return true if any part of the region is dirty.
+ */
+static bool host_flash_verify_cache_is_region_dirty (struct host_flash_verify_cache *cache,
+	uint64_t addr, uint64_t length)
+{
+	uint64_t block;
+	uint64_t last;
+
+	if (length == 0) {
+		return false;
+	}
+
+	block = addr / cache->block_size;
+	last = (addr + length - 1) / cache->block_size;
+
+	for (; block <= last; block++) {
+		/* Blocks not covered by the bitmap are unknown and must be treated as written. */
+		if ((block >= (cache->length * 8)) ||
+			(cache->bitmap[block / 8] & (1U << (block % 8)))) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/**
+ * Start verification of a flash device.  The blocks written by the host since the last
+ * verification are retrieved from the SPI filter and write tracking is restarted, so writes that
+ * happen during verification will be detected by the next verification.  Cached information that
+ * is no longer valid due to host writes is discarded.
+ *
+ * If write tracking information is not available, all cached information for the device is
+ * discarded and the entire device must be verified.
+ *
+ * @param cache The cache to update for verification.
+ * @param cs The flash device that will be verified.
+ *
+ * @return 0 if the cache can be used for verification or an error code.
+ */
+int host_flash_verify_cache_start_verification (struct host_flash_verify_cache *cache,
+	spi_filter_cs cs)
+{
+	struct host_flash_verify_cache_entry *entry;
+	uint32_t block_size;
+	size_t i;
+	size_t j;
+	int status;
+
+	if ((cache == NULL) || (cs >= HOST_FLASH_VERIFY_CACHE_MAX_DEVICES)) {
+		return HOST_FLASH_VERIFY_CACHE_INVALID_ARGUMENT;
+	}
+
+	cache->cs = cs;
+	cache->tracking = false;
+
+	/* Unused flash will not be known good again until it has been checked as part of this
+	 * verification. */
+	cache->layout_checked = cache->layout_valid[cs];
+	cache->layout_valid[cs] = false;
+
+	status = spi_filter_get_dirty_block_bitmap (cache->filter, cs, true, cache->bitmap,
+		cache->length, &block_size);
+	if ((status == 0) && ((block_size == 0) || ((block_size & (block_size - 1)) != 0))) {
+		status = HOST_FLASH_VERIFY_CACHE_BAD_BLOCK_SIZE;
+	}
+
+	if (status != 0) {
+		host_flash_verify_cache_invalidate_region (cache, cs, 0, SIZE_MAX);
+		cache->layout_checked = false;
+		return status;
+	}
+
+	cache->block_size = block_size;
+	cache->tracking = true;
+
+	for (i = 0; i < cache->entry_count; i++) {
+		entry = &cache->entries[i];
+
+		if (entry->cs == cs) {
+			for (j = 0; j < entry->count; j++) {
+				if (host_flash_verify_cache_is_region_dirty (cache, entry->regions[j].start_addr,
+					entry->regions[j].length)) {
+					entry->count = 0;
+				}
+			}
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * Find the cache entry for an image on the device being verified.
+ *
+ * @param cache The cache to search.
+ * @param regions The flash regions that make up the image.
+ * @param count The number of regions in the image.
+ * @param type The algorithm used to calculate the image digest.
+ *
+ * @return The cache entry for the image or null if the image is not cached.
+ */
+static struct host_flash_verify_cache_entry* host_flash_verify_cache_find_entry (
+	struct host_flash_verify_cache *cache, const struct flash_region *regions, size_t count,
+	enum hash_type type)
+{
+	struct host_flash_verify_cache_entry *entry;
+	size_t i;
+	size_t j;
+
+	for (i = 0; i < cache->entry_count; i++) {
+		entry = &cache->entries[i];
+
+		if ((entry->count == count) && (entry->cs == cache->cs) && (entry->type == type)) {
+			for (j = 0; j < count; j++) {
+				if ((entry->regions[j].start_addr != regions[j].start_addr) ||
+					(entry->regions[j].length != regions[j].length)) {
+					break;
+				}
+			}
+
+			if (j == count) {
+				return entry;
+			}
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * Get the digest of an image that has not been modified since it was last verified.
+ *
+ * @param cache The cache to query.
+ * @param regions The flash regions that make up the image.
+ * @param count The number of regions in the image.
+ * @param type The algorithm used to calculate the image digest.
+ * @param digest Output for the image digest.
+ * @param length Length of the digest buffer.
+ *
+ * @return true if a valid digest was found for the image.  If false, the image must be hashed.
+ */
+bool host_flash_verify_cache_get_digest (struct host_flash_verify_cache *cache,
+	const struct flash_region *regions, size_t count, enum hash_type type, uint8_t *digest,
+	size_t length)
+{
+	struct host_flash_verify_cache_entry *entry;
+	int hash_length;
+
+	if ((cache == NULL) || (regions == NULL) || (count == 0) || (digest == NULL) ||
+		!cache->tracking) {
+		return false;
+	}
+
+	hash_length = hash_get_hash_length (type);
+	if (ROT_IS_ERROR (hash_length) || (length < (size_t) hash_length)) {
+		return false;
+	}
+
+	entry = host_flash_verify_cache_find_entry (cache, regions, count, type);
+	if (entry == NULL) {
+		return false;
+	}
+
+	memcpy (digest, entry->digest, hash_length);
+	return true;
+}
+
+/**
+ * Save the digest of an image on the device being verified.  The digest must have been calculated
+ * after verification of the device was started.
+ *
+ * @param cache The cache to update.
+ * @param regions The flash regions that make up the image.
+ * @param count The number of regions in the image.
+ * @param type The algorithm used to calculate the image digest.
+ * @param digest The image digest.
+ * @param length Length of the digest.
+ */
+void host_flash_verify_cache_update_digest (struct host_flash_verify_cache *cache,
+	const struct flash_region *regions, size_t count, enum hash_type type, const uint8_t *digest,
+	size_t length)
+{
+	struct host_flash_verify_cache_entry *entry;
+	size_t i;
+
+	if ((cache == NULL) || (regions == NULL) || (count == 0) ||
+		(count > HOST_FLASH_VERIFY_CACHE_MAX_REGIONS) || (digest == NULL) || !cache->tracking) {
+		return;
+	}
+
+	if (length != (size_t) hash_get_hash_length (type)) {
+		return;
+	}
+
+	entry = host_flash_verify_cache_find_entry (cache, regions, count, type);
+	for (i = 0; (entry == NULL) && (i < cache->entry_count); i++) {
+		if (cache->entries[i].count == 0) {
+			entry = &cache->entries[i];
+		}
+	}
+
+	if (entry == NULL) {
+		entry = &cache->entries[cache->next];
+		cache->next = (cache->next + 1) % cache->entry_count;
+	}
+
+	memcpy (entry->regions, regions, sizeof (struct flash_region) * count);
+	entry->count = count;
+	entry->cs = cache->cs;
+	entry->type = type;
+	memcpy (entry->digest, digest, length);
+}
+
+/**
+ * Determine if the unused regions of the device being verified have already been checked for the
+ * current flash layout.  If so, only the dirty parts of the unused regions need to be checked.
+ *
+ * @param cache The cache to query.
+ * @param layout SHA-256 digest that identifies the flash layout.
+ *
+ * @return true if the unused regions had been checked.
+ */
+bool host_flash_verify_cache_is_layout_checked (struct host_flash_verify_cache *cache,
+	const uint8_t *layout)
+{
+	if ((cache == NULL) || (layout == NULL) || !cache->tracking || !cache->layout_checked) {
+		return false;
+	}
+
+	return (memcmp (cache->layout[cache->cs], layout, SHA256_HASH_LENGTH) == 0);
+}
+
+/**
+ * Indicate that all unused regions of the device being verified have been checked.
+ *
+ * @param cache The cache to update.
+ * @param layout SHA-256 digest that identifies the flash layout.
+ */
+void host_flash_verify_cache_set_layout_checked (struct host_flash_verify_cache *cache,
+	const uint8_t *layout)
+{
+	if ((cache == NULL) || (layout == NULL) || !cache->tracking) {
+		return;
+	}
+
+	memcpy (cache->layout[cache->cs], layout, SHA256_HASH_LENGTH);
+	cache->layout_valid[cache->cs] = true;
+}
+
+/**
+ * Find the first part of a region of flash that has been written by the host.
+ *
+ * @param cache The cache to query.
+ * @param addr The first address of the region to search.  On return, this will be the first dirty
+ * address in the region.
+ * @param length The length of the region to search.  On return, this will be the length of the
+ * dirty range, which may be followed by additional dirty ranges.
+ *
+ * @return true if a dirty range was found or false if the rest of the region is clean.  If write
+ * tracking is not available, the entire region will be reported as dirty.
+ */
+bool host_flash_verify_cache_find_dirty_range (struct host_flash_verify_cache *cache,
+	uint32_t *addr, uint32_t *length)
+{
+	uint64_t start;
+	uint64_t end;
+	uint64_t dirty_end;
+
+	if ((cache == NULL) || (addr == NULL) || (length == NULL) || (*length == 0)) {
+		return false;
+	}
+
+	if (!cache->tracking) {
+		return true;
+	}
+
+	start = *addr;
+	end = start + *length;
+
+	while ((start < end) && !host_flash_verify_cache_is_region_dirty (cache, start, 1)) {
+		start = ((start / cache->block_size) + 1) * cache->block_size;
+	}
+
+	if (start >= end) {
+		return false;
+	}
+
+	dirty_end = start;
+	while ((dirty_end < end) && host_flash_verify_cache_is_region_dirty (cache, dirty_end, 1)) {
+		dirty_end = ((dirty_end / cache->block_size) + 1) * cache->block_size;
+	}
+
+	if (dirty_end > end) {
+		dirty_end = end;
+	}
+
+	*addr = start;
+	*length = dirty_end - start;
+
+	return true;
+}
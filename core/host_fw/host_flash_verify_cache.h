@@ -0,0 +1,117 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef HOST_FLASH_VERIFY_CACHE_H_
+#define HOST_FLASH_VERIFY_CACHE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "platform_api.h"
+#include "status/rot_status.h"
+#include "crypto/hash.h"
+#include "flash/flash_util.h"
+#include "manifest/pfm/pfm.h"
+#include "spi_filter/spi_filter_interface.h"
+
+
+/**
+ * The maximum number of flash regions in an image that can be cached.  Images with more regions
+ * will always be hashed during verification.
+ */
+#ifndef HOST_FLASH_VERIFY_CACHE_MAX_REGIONS
+#define	HOST_FLASH_VERIFY_CACHE_MAX_REGIONS		8
+#endif
+
+/**
+ * The number of flash devices that can be tracked by the cache.
+ */
+#define	HOST_FLASH_VERIFY_CACHE_MAX_DEVICES		2
+
+
+/**
+ * The digest of a firmware image on a host flash device.
+ */
+struct host_flash_verify_cache_entry {
+	struct flash_region regions[HOST_FLASH_VERIFY_CACHE_MAX_REGIONS];	/**< The image regions. */
+	size_t count;								/**< The number of image regions.  0 if the entry is unused. */
+	spi_filter_cs cs;							/**< The flash device containing the image. */
+	enum hash_type type;						/**< The algorithm used to calculate the digest. */
+	uint8_t digest[SHA512_HASH_LENGTH];			/**< The digest of the image data. */
+};
+
+/**
+ * Tracks the contents of host flash that have already been checked so that verification of the
+ * flash only needs to read the blocks written by the host since the last verification.  Host
+ * writes are reported by a SPI filter that supports dirty block tracking.
+ *
+ * Only host writes are reported by the SPI filter.  Any time the RoT modifies host flash, the
+ * affected regions must be invalidated in the cache.
+ *
+ * Only one verification can use the cache at a time.  A verification running concurrently with
+ * another must claim the cache first and fall back to checking the entire device if the cache is
+ * already in use.  Devices that are verified at the same time should each have a separate cache.
+ */
+struct host_flash_verify_cache {
+	const struct spi_filter_interface *filter;				/**< The SPI filter tracking host writes. */
+	struct host_flash_verify_cache_entry *entries;			/**< Storage for image digests. */
+	size_t entry_count;										/**< The number of entries available. */
+	size_t next;											/**< The next entry to replace. */
+	uint8_t *bitmap;										/**< Blocks written since the last verification. */
+	size_t length;											/**< Length of the bitmap buffer. */
+	uint32_t block_size;									/**< The number of bytes tracked by each bit. */
+	spi_filter_cs cs;										/**< The device currently being verified. */
+	bool tracking;											/**< Flag indicating the dirty blocks are known. */
+	bool layout_checked;									/**< Flag indicating unused flash had been checked. */
+	uint8_t layout[HOST_FLASH_VERIFY_CACHE_MAX_DEVICES][SHA256_HASH_LENGTH];	/**< Digest of the checked flash layout. */
+	bool layout_valid[HOST_FLASH_VERIFY_CACHE_MAX_DEVICES];	/**< Flag indicating the unused flash is known good. */
+	bool claimed;											/**< Flag indicating a verification is using the cache. */
+	platform_mutex lock;									/**< Synchronization for claiming the cache. */
+};
+
+
+int host_flash_verify_cache_init (struct host_flash_verify_cache *cache,
+	const struct spi_filter_interface *filter, struct host_flash_verify_cache_entry *entries,
+	size_t entry_count, uint8_t *bitmap, size_t length);
+void host_flash_verify_cache_release (struct host_flash_verify_cache *cache);
+
+bool host_flash_verify_cache_claim (struct host_flash_verify_cache *cache);
+void host_flash_verify_cache_unclaim (struct host_flash_verify_cache *cache);
+
+void host_flash_verify_cache_invalidate (struct host_flash_verify_cache *cache);
+void host_flash_verify_cache_invalidate_region (struct host_flash_verify_cache *cache,
+	spi_filter_cs cs, uint32_t addr, size_t length);
+void host_flash_verify_cache_invalidate_read_write_regions (struct host_flash_verify_cache *cache,
+	spi_filter_cs cs, const struct pfm_read_write_regions *writable, size_t fw_count);
+
+int host_flash_verify_cache_start_verification (struct host_flash_verify_cache *cache,
+	spi_filter_cs cs);
+
+bool host_flash_verify_cache_get_digest (struct host_flash_verify_cache *cache,
+	const struct flash_region *regions, size_t count, enum hash_type type, uint8_t *digest,
+	size_t length);
+void host_flash_verify_cache_update_digest (struct host_flash_verify_cache *cache,
+	const struct flash_region *regions, size_t count, enum hash_type type, const uint8_t *digest,
+	size_t length);
+
+bool host_flash_verify_cache_is_layout_checked (struct host_flash_verify_cache *cache,
+	const uint8_t *layout);
+void host_flash_verify_cache_set_layout_checked (struct host_flash_verify_cache *cache,
+	const uint8_t *layout);
+bool host_flash_verify_cache_find_dirty_range (struct host_flash_verify_cache *cache,
+	uint32_t *addr, uint32_t *length);
+
+
+#define	HOST_FLASH_VERIFY_CACHE_ERROR(code)		ROT_ERROR (ROT_MODULE_HOST_FLASH_VERIFY_CACHE, code)
+
+/**
+ * Error codes that can be generated by the host flash verification cache.
+ */
+enum {
+	HOST_FLASH_VERIFY_CACHE_INVALID_ARGUMENT = HOST_FLASH_VERIFY_CACHE_ERROR (0x00),	/**< Input parameter is null or not valid. */
+	HOST_FLASH_VERIFY_CACHE_NO_MEMORY = HOST_FLASH_VERIFY_CACHE_ERROR (0x01),			/**< Memory allocation failed. */
+	HOST_FLASH_VERIFY_CACHE_BAD_BLOCK_SIZE = HOST_FLASH_VERIFY_CACHE_ERROR (0x02),		/**< The filter reported an unusable block size. */
+};
+
+
+#endif /* HOST_FLASH_VERIFY_CACHE_H_ */
@@ -0,0 +1,184 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include "host_flash_verify_worker.h"
+#include "common/type_cast.h"
+#include "common/unused.h"
+
+
+/**
+ * Parameters for a validation request sent to the worker task.
+ */
+struct host_flash_verify_worker_request {
+	struct host_flash_manager *flash;	/**< The manager for the flash to validate. */
+	struct pfm *pfm;					/**< The PFM to validate the flash against. */
+	struct pfm *good_pfm;				/**< A PFM that previously validated the flash. */
+	bool full_validation;				/**< Flag to force a full validation of the flash. */
+};
+
+
+static void host_flash_verify_worker_execute (const struct event_task_handler *handler,
+	struct event_task_context *context, bool *reset)
+{
+	const struct host_flash_verify_worker *worker = TO_DERIVED_TYPE (handler,
+		const struct host_flash_verify_worker, base);
+	struct host_flash_verify_worker_request request;
+
+	UNUSED (reset);
+
+	if ((context->action == HOST_FLASH_VERIFY_WORKER_ACTION_VALIDATE_RO) &&
+		(context->buffer_length == sizeof (request))) {
+		/* The event buffer has no alignment guarantees, so copy the request out. */
+		memcpy (&request, context->event_buffer, sizeof (request));
+
+		worker->state->status = request.flash->validate_read_only_flash (request.flash,
+			request.pfm, request.good_pfm, worker->hash, worker->rsa, request.full_validation,
+			&worker->state->host_rw);
+	}
+	else {
+		worker->state->status = HOST_FLASH_VERIFY_WORKER_UNKNOWN_ACTION;
+	}
+
+	platform_semaphore_post (&worker->state->complete);
+}
+
+/**
+ * Initialize a worker for validating host flash from a separate task.
+ *
+ * @param worker The verification worker to initialize.
+ * @param state Variable context for the worker.  This must be uninitialized.
+ * @param hash The hash engine to use for validation.  This must not be used by any other task
+ * while a validation is running.
+ * @param rsa The RSA engine to use for signature verification.  This must not be used by any
+ * other task while a validation is running.
+ * @param task The task that will execute validation requests.
+ *
+ * @return 0 if the worker was successfully initialized or an error code.
+ */
+int host_flash_verify_worker_init (struct host_flash_verify_worker *worker,
+	struct host_flash_verify_worker_state *state, struct hash_engine *hash, struct rsa_engine *rsa,
+	const struct event_task *task)
+{
+	if (worker == NULL) {
+		return HOST_FLASH_VERIFY_WORKER_INVALID_ARGUMENT;
+	}
+
+	memset (worker, 0, sizeof (struct host_flash_verify_worker));
+
+	worker->base.execute = host_flash_verify_worker_execute;
+
+	worker->state = state;
+	worker->hash = hash;
+	worker->rsa = rsa;
+	worker->task = task;
+
+	return host_flash_verify_worker_init_state (worker);
+}
+
+/**
+ * Initialize only the variable state for a verification worker.  The rest of the worker is assumed
+ * to have already been initialized.
+ *
+ * This would generally be used with a statically initialized instance.
+ *
+ * @param worker The verification worker that contains the state to initialize.
+ *
+ * @return 0 if the state was successfully initialized or an error code.
+ */
+int host_flash_verify_worker_init_state (const struct host_flash_verify_worker *worker)
+{
+	if ((worker == NULL) || (worker->state == NULL) || (worker->hash == NULL) ||
+		(worker->rsa == NULL) || (worker->task == NULL)) {
+		return HOST_FLASH_VERIFY_WORKER_INVALID_ARGUMENT;
+	}
+
+	memset (worker->state, 0, sizeof (struct host_flash_verify_worker_state));
+
+	return platform_semaphore_init (&worker->state->complete);
+}
+
+/**
+ * Release the resources used by a verification worker.
+ *
+ * @param worker The verification worker to release.
+ */
+void host_flash_verify_worker_release (const struct host_flash_verify_worker *worker)
+{
+	if (worker) {
+		platform_semaphore_free (&worker->state->complete);
+	}
+}
+
+/**
+ * Request validation of the read-only flash device from the worker task.  This call does not wait
+ * for validation to complete.  Every successful request must be followed by a call to
+ * host_flash_verify_worker_get_read_only_result, which provides the result of the validation.
+ *
+ * The PFMs must remain valid and the flash device roles must not change until the result has been
+ * retrieved.  The PFMs can be read by the calling task while validation is running, which requires
+ * the hash engines used by the PFMs to be thread-safe.
+ *
+ * @param worker The verification worker to use.
+ * @param flash The manager for the host flash devices.
+ * @param pfm The PFM to validate the flash against.
+ * @param good_pfm A PFM that has previously validated the read-only flash.  Can be null.
+ * @param full_validation Flag indicating if a full flash validation should be run.
+ *
+ * @return 0 if validation was successfully started or an error code.  If the worker task is not
+ * available, validation will not be started and the request will fail.
+ */
+int host_flash_verify_worker_start_read_only_validation (
+	const struct host_flash_verify_worker *worker, struct host_flash_manager *flash,
+	struct pfm *pfm, struct pfm *good_pfm, bool full_validation)
+{
+	struct host_flash_verify_worker_request request;
+
+	if ((worker == NULL) || (flash == NULL) || (pfm == NULL)) {
+		return HOST_FLASH_VERIFY_WORKER_INVALID_ARGUMENT;
+	}
+
+	memset (&request, 0, sizeof (request));
+	request.flash = flash;
+	request.pfm = pfm;
+	request.good_pfm = good_pfm;
+	request.full_validation = full_validation;
+
+	platform_semaphore_reset (&worker->state->complete);
+
+	return event_task_submit_event (worker->task, &worker->base,
+		HOST_FLASH_VERIFY_WORKER_ACTION_VALIDATE_RO, (uint8_t*) &request, sizeof (request), 0,
+		NULL);
+}
+
+/**
+ * Wait for a validation request to complete and get the result.
+ *
+ * @param worker The verification worker that is running the validation.
+ * @param host_rw Output for the read/write regions of the validated flash.  This is only updated
+ * if validation was successful, in which case the regions must be freed by the flash manager.
+ *
+ * @return The status of the flash validation.  0 if the flash was successfully validated.
+ */
+int host_flash_verify_worker_get_read_only_result (const struct host_flash_verify_worker *worker,
+	struct host_flash_manager_rw_regions *host_rw)
+{
+	int status;
+
+	if ((worker == NULL) || (host_rw == NULL)) {
+		return HOST_FLASH_VERIFY_WORKER_INVALID_ARGUMENT;
+	}
+
+	status = platform_semaphore_wait (&worker->state->complete, 0);
+	if (status != 0) {
+		return HOST_FLASH_VERIFY_WORKER_WAIT_FAILED;
+	}
+
+	if (worker->state->status == 0) {
+		memcpy (host_rw, &worker->state->host_rw, sizeof (struct host_flash_manager_rw_regions));
+	}
+
+	return worker->state->status;
+}
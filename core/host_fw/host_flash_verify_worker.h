@@ -0,0 +1,78 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef HOST_FLASH_VERIFY_WORKER_H_
+#define HOST_FLASH_VERIFY_WORKER_H_
+
+#include <stdbool.h>
+#include "platform_api.h"
+#include "status/rot_status.h"
+#include "host_flash_manager.h"
+#include "crypto/hash.h"
+#include "crypto/rsa.h"
+#include "manifest/pfm/pfm.h"
+#include "system/event_task.h"
+
+
+/**
+ * Action identifiers for the host flash verification worker.
+ */
+enum {
+	HOST_FLASH_VERIFY_WORKER_ACTION_VALIDATE_RO = 1,	/**< Validate the read-only flash device. */
+};
+
+
+/**
+ * Variable context for a host flash verification worker.
+ */
+struct host_flash_verify_worker_state {
+	platform_semaphore complete;						/**< Signaled when a validation has finished. */
+	int status;											/**< The result of the last validation. */
+	struct host_flash_manager_rw_regions host_rw;		/**< Read/write regions of the validated flash. */
+};
+
+/**
+ * Handler for validating a host flash device from a separate task.  This allows validation of one
+ * flash device to run while the other device is being validated by the host processor task.
+ *
+ * The worker uses its own hash and RSA engines, which must not be shared with the task requesting
+ * validation.  The PFMs are not copied and will be read by both tasks, so the hash engine used
+ * internally by each PFM must be thread-safe.  A single worker can only be used by one host
+ * processor.
+ */
+struct host_flash_verify_worker {
+	struct event_task_handler base;						/**< The base interface for task integration. */
+	struct host_flash_verify_worker_state *state;		/**< Variable context for the worker. */
+	const struct event_task *task;						/**< The task context executing the worker. */
+	struct hash_engine *hash;							/**< Hash engine for validation in the worker task. */
+	struct rsa_engine *rsa;								/**< RSA engine for validation in the worker task. */
+};
+
+
+int host_flash_verify_worker_init (struct host_flash_verify_worker *worker,
+	struct host_flash_verify_worker_state *state, struct hash_engine *hash, struct rsa_engine *rsa,
+	const struct event_task *task);
+int host_flash_verify_worker_init_state (const struct host_flash_verify_worker *worker);
+void host_flash_verify_worker_release (const struct host_flash_verify_worker *worker);
+
+int host_flash_verify_worker_start_read_only_validation (
+	const struct host_flash_verify_worker *worker, struct host_flash_manager *flash,
+	struct pfm *pfm, struct pfm *good_pfm, bool full_validation);
+int host_flash_verify_worker_get_read_only_result (const struct host_flash_verify_worker *worker,
+	struct host_flash_manager_rw_regions *host_rw);
+
+
+#define	HOST_FLASH_VERIFY_WORKER_ERROR(code)		ROT_ERROR (ROT_MODULE_HOST_FLASH_VERIFY_WORKER, code)
+
+/**
+ * Error codes that can be generated by the host flash verification worker.
+ */
+enum {
+	HOST_FLASH_VERIFY_WORKER_INVALID_ARGUMENT = HOST_FLASH_VERIFY_WORKER_ERROR (0x00),	/**< Input parameter is null or not valid. */
+	HOST_FLASH_VERIFY_WORKER_NO_MEMORY = HOST_FLASH_VERIFY_WORKER_ERROR (0x01),			/**< Memory allocation failed. */
+	HOST_FLASH_VERIFY_WORKER_UNKNOWN_ACTION = HOST_FLASH_VERIFY_WORKER_ERROR (0x02),	/**< The worker received an unsupported action. */
+	HOST_FLASH_VERIFY_WORKER_WAIT_FAILED = HOST_FLASH_VERIFY_WORKER_ERROR (0x03),		/**< Failed waiting for validation to complete. */
+};
+
+
+#endif /* HOST_FLASH_VERIFY_WORKER_H_ */
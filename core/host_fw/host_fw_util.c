@@ -6,7 +6,9 @@
 #include <string.h>
 #include "platform_api.h"
 #include "host_fw_util.h"
+#include "host_logging.h"
 #include "flash/flash_util.h"
+#include "logging/debug_log.h"
 
 
 /**
@@ -316,6 +318,75 @@ bool host_fw_are_images_different (const struct pfm_image_list *img_list1,
 	return false;
 }
 
+/**
+ * Calculate the digest of an image on flash.  If the image has not been modified since the digest
+ * was last calculated, the cached digest will be used instead of reading the image from flash.
+ *
+ * @param flash The flash that contains the image.
+ * @param offset The offset to apply to image addresses.  This must be 0 if a cache is used.
+ * @param regions The flash regions that make up the image.
+ * @param count The number of regions in the image.
+ * @param hash The hashing engine to use for calculating the digest.
+ * @param type The type of digest to calculate.
+ * @param digest Output for the image digest.
+ * @param length Length of the digest buffer.
+ * @param cache Optional cache of image digests.
+ *
+ * @return 0 if the digest was calculated successfully or an error code.
+ */
+static int host_fw_hash_image (const struct spi_flash *flash, uint32_t offset,
+	const struct flash_region *regions, size_t count, struct hash_engine *hash,
+	enum hash_type type, uint8_t *digest, size_t length, struct host_flash_verify_cache *cache)
+{
+	int status;
+
+	if (host_flash_verify_cache_get_digest (cache, regions, count, type, digest, length)) {
+		return 0;
+	}
+
+	status = flash_hash_noncontiguous_contents_at_offset (&flash->base, offset, regions, count,
+		hash, type, digest, length);
+	if (status == 0) {
+		host_flash_verify_cache_update_digest (cache, regions, count, type, digest,
+			hash_get_hash_length (type));
+	}
+
+	return status;
+}
+
+/**
+ * Verify the signature of an image on flash, using a cached digest of the image if the image has
+ * not been modified since it was last hashed.
+ *
+ * @param flash The flash that contains the image.
+ * @param image The signed image to verify.
+ * @param hash The hashing engine to use for validation.
+ * @param rsa The RSA engine to use for signature checking.
+ * @param cache The cache of image digests.
+ *
+ * @return 0 if the image is valid or an error code.
+ */
+static int host_fw_verify_signed_image_with_cache (const struct spi_flash *flash,
+	const struct pfm_image_signature *image, struct hash_engine *hash, struct rsa_engine *rsa,
+	struct host_flash_verify_cache *cache)
+{
+	uint8_t digest[SHA256_HASH_LENGTH];
+	int status;
+
+	if ((image->regions == NULL) || (image->count == 0) || (image->sig_length == 0)) {
+		return FLASH_UTIL_INVALID_ARGUMENT;
+	}
+
+	status = host_fw_hash_image (flash, 0, image->regions, image->count, hash, HASH_TYPE_SHA256,
+		digest, sizeof (digest), cache);
+	if (status != 0) {
+		return status;
+	}
+
+	return rsa->sig_verify (rsa, &image->key, image->signature, image->sig_length,
+		HASH_TYPE_SHA256, digest, sizeof (digest));
+}
+
 /**
  * Verify that images on the flash are valid.  All image addresses specified in the PFM will be
  * offset by a fixed amount.
@@ -326,12 +397,14 @@ bool host_fw_are_images_different (const struct pfm_image_list *img_list1,
  * @param offset The offset to apply to image addresses.
  * @param hash The hashing engine to use for validation.
  * @param rsa The RSA engine to use for signature checking.
+ * @param cache Optional cache of image digests for images that have not been modified since they
+ * were last hashed.  Set to null to hash every image.
  *
  * @return 0 if all images that should be validated are good or an error code.
  */
 static int host_fw_verify_images_on_flash (const struct spi_flash *flash,
 	const struct pfm_image_list *img_list, bool validate_all, uint32_t offset,
-	struct hash_engine *hash, struct rsa_engine *rsa)
+	struct hash_engine *hash, struct rsa_engine *rsa, struct host_flash_verify_cache *cache)
 {
 	size_t i;
 	int status = 0;
@@ -339,10 +412,16 @@ static int host_fw_verify_images_on_flash (const struct spi_flash *flash,
 	for (i = 0; i < img_list->count; i++) {
 		if (img_list->images_sig) {
 			if (validate_all || img_list->images_sig[i].always_validate) {
-				status = flash_verify_noncontiguous_contents_at_offset (&flash->base, offset,
-					img_list->images_sig[i].regions, img_list->images_sig[i].count, hash,
-					HASH_TYPE_SHA256, rsa, img_list->images_sig[i].signature,
-					img_list->images_sig[i].sig_length, &img_list->images_sig[i].key, NULL, 0);
+				if (cache) {
+					status = host_fw_verify_signed_image_with_cache (flash,
+						&img_list->images_sig[i], hash, rsa, cache);
+				}
+				else {
+					status = flash_verify_noncontiguous_contents_at_offset (&flash->base, offset,
+						img_list->images_sig[i].regions, img_list->images_sig[i].count, hash,
+						HASH_TYPE_SHA256, rsa, img_list->images_sig[i].signature,
+						img_list->images_sig[i].sig_length, &img_list->images_sig[i].key, NULL, 0);
+				}
 				if (status != 0) {
 					return status;
 				}
@@ -351,9 +430,9 @@ static int host_fw_verify_images_on_flash (const struct spi_flash *flash,
 		else if (validate_all || img_list->images_hash[i].always_validate) {
 			uint8_t img_hash[SHA512_HASH_LENGTH];
 
-			status = flash_hash_noncontiguous_contents_at_offset (&flash->base, offset,
-				img_list->images_hash[i].regions, img_list->images_hash[i].count, hash,
-				img_list->images_hash[i].hash_type, img_hash, sizeof (img_hash));
+			status = host_fw_hash_image (flash, offset, img_list->images_hash[i].regions,
+				img_list->images_hash[i].count, hash, img_list->images_hash[i].hash_type, img_hash,
+				sizeof (img_hash), cache);
 			if (status != 0) {
 				return status;
 			}
@@ -450,7 +529,75 @@ int host_fw_verify_offset_images_multiple_fw (const struct spi_flash *flash,
 	}
 
 	for (i = 0; i < fw_count; i++) {
-		status = host_fw_verify_images_on_flash (flash, &img_list[i], false, offset, hash, rsa);
+		status = host_fw_verify_images_on_flash (flash, &img_list[i], false, offset, hash, rsa,
+			NULL);
+		if (status != 0) {
+			return status;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * Prepare the cache of verified flash contents for verification of a flash device.  If the cache
+ * cannot be used, the failure is logged and the flash will be verified without the cache.
+ *
+ * @param cache The cache of verified flash contents.
+ * @param cs The chip select of the flash device being validated.
+ *
+ * @return The cache to use for verification or null if the entire flash must be verified without
+ * using the cache.
+ */
+static struct host_flash_verify_cache* host_fw_start_cached_verification (
+	struct host_flash_verify_cache *cache, spi_filter_cs cs)
+{
+	int status;
+
+	status = host_flash_verify_cache_start_verification (cache, cs);
+	if (status != 0) {
+		debug_log_create_entry (DEBUG_LOG_SEVERITY_WARNING, DEBUG_LOG_COMPONENT_HOST_FW,
+			HOST_LOGGING_VERIFY_CACHE_UNAVAILABLE, status, cs);
+		return NULL;
+	}
+
+	return cache;
+}
+
+/**
+ * Verify that images from multiple different firmware components on the flash are valid.  Only
+ * images flagged for validation will be checked.
+ *
+ * Images that have not been written by the host since they were last hashed will be verified using
+ * the cached digest of the image instead of reading the image from flash.
+ *
+ * @param flash The flash that contains the images to validate.
+ * @param img_list An array of firmware images that should be validated.
+ * @param fw_count The number of firmware components in the list.
+ * @param hash The hashing engine to use for validation.
+ * @param rsa The RSA engine to use for signature checking.
+ * @param cache The cache of verified flash contents.  If write tracking is not available for the
+ * device, every image will be hashed.
+ * @param cs The chip select of the flash device being validated.
+ *
+ * @return 0 if all images that should be validated are good or an error code.
+ */
+int host_fw_verify_images_multiple_fw_with_cache (const struct spi_flash *flash,
+	const struct pfm_image_list *img_list, size_t fw_count, struct hash_engine *hash,
+	struct rsa_engine *rsa, struct host_flash_verify_cache *cache, spi_filter_cs cs)
+{
+	size_t i;
+	int status;
+
+	if ((flash == NULL) || (img_list == NULL) || (hash == NULL) || (rsa == NULL) ||
+		(cache == NULL)) {
+		return HOST_FW_UTIL_INVALID_ARGUMENT;
+	}
+
+	cache = host_fw_start_cached_verification (cache, cs);
+
+	for (i = 0; i < fw_count; i++) {
+		status = host_fw_verify_images_on_flash (flash, &img_list[i], false, 0, hash, rsa, cache);
 		if (status != 0) {
 			return status;
 		}
@@ -571,6 +718,182 @@ static const struct flash_region* host_fw_find_next_flash_region (uint32_t last_
 	return next;
 }
 
+/**
+ * Calculate a digest that identifies the layout of used and unused regions of flash.
+ *
+ * @param img_list An array of firmware images in the flash.
+ * @param writable An array of writable regions for each firmware component.
+ * @param fw_count The number of firmware components in the list.
+ * @param flash_size The size of the flash device.
+ * @param unused_byte The byte value expected in unused flash regions.
+ * @param hash The hashing engine to use to calculate the digest.
+ * @param layout Output for the layout digest.  This must be SHA256_HASH_LENGTH bytes.
+ *
+ * @return 0 if the layout digest was calculated successfully or an error code.
+ */
+static int host_fw_calculate_flash_layout (const struct pfm_image_list *img_list,
+	const struct pfm_read_write_regions *writable, size_t fw_count, uint32_t flash_size,
+	uint8_t unused_byte, struct hash_engine *hash, uint8_t *layout)
+{
+	const struct flash_region *pos;
+	uint32_t last_addr;
+	uint32_t region[2];
+	int status;
+
+	status = hash->start_sha256 (hash);
+	if (status != 0) {
+		return status;
+	}
+
+	region[0] = flash_size;
+	region[1] = unused_byte;
+	status = hash->update (hash, (uint8_t*) region, sizeof (region));
+	if (status != 0) {
+		goto fail;
+	}
+
+	last_addr = 0;
+	pos = host_fw_find_next_flash_region (last_addr, img_list, writable, fw_count);
+	while (pos) {
+		region[0] = pos->start_addr;
+		region[1] = pos->length;
+		status = hash->update (hash, (uint8_t*) region, sizeof (region));
+		if (status != 0) {
+			goto fail;
+		}
+
+		last_addr = pos->start_addr + pos->length;
+		pos = host_fw_find_next_flash_region (last_addr, img_list, writable, fw_count);
+	}
+
+	status = hash->finish (hash, layout, SHA256_HASH_LENGTH);
+	if (status != 0) {
+		goto fail;
+	}
+
+	return 0;
+
+fail:
+	hash->cancel (hash);
+	return status;
+}
+
+/**
+ * Check that an unused region of flash is empty.
+ *
+ * @param flash The flash that should be checked.
+ * @param addr The first address of the unused region.
+ * @param length The length of the unused region.
+ * @param unused_byte The byte value to check for in the region.
+ * @param cache Optional cache of verified flash contents.  If the region had already been
+ * checked, only the parts of the region written by the host since the last check will be read.
+ * @param checked Flag indicating if the cache has previously checked the unused regions.
+ *
+ * @return 0 if the region is empty or an error code.
+ */
+static int host_fw_check_unused_flash (const struct spi_flash *flash, uint32_t addr,
+	uint32_t length, uint8_t unused_byte, struct host_flash_verify_cache *cache, bool checked)
+{
+	uint32_t end = addr + length;
+	uint32_t dirty_addr;
+	uint32_t dirty_length;
+	int status;
+
+	if (!checked) {
+		return flash_value_check (&flash->base, addr, length, unused_byte);
+	}
+
+	while (addr < end) {
+		dirty_addr = addr;
+		dirty_length = end - addr;
+		if (!host_flash_verify_cache_find_dirty_range (cache, &dirty_addr, &dirty_length)) {
+			break;
+		}
+
+		status = flash_value_check (&flash->base, dirty_addr, dirty_length, unused_byte);
+		if (status != 0) {
+			return status;
+		}
+
+		addr = dirty_addr + dirty_length;
+	}
+
+	return 0;
+}
+
+/**
+ * Verify that the entire flash contents are good.  All images will be verified and unused regions
+ * of read-only flash will be verified to be empty.
+ *
+ * @param flash The flash that should be validated.
+ * @param img_list An array of firmware images that should be validated.
+ * @param writable An array of writable regions for each firmware component.
+ * @param fw_count The number of firmware components in the list.
+ * @param unused_byte The byte value to check for in unused flash regions.
+ * @param hash The hashing engine to use for validation.
+ * @param rsa The RSA engine to use for signature checking.
+ * @param cache Optional cache of verified flash contents.  If this is null, the entire flash will
+ * be read.
+ *
+ * @return 0 if the flash contents are good or an error code.
+ */
+static int host_fw_full_flash_verification_on_flash (const struct spi_flash *flash,
+	const struct pfm_image_list *img_list, const struct pfm_read_write_regions *writable,
+	size_t fw_count, uint8_t unused_byte, struct hash_engine *hash, struct rsa_engine *rsa,
+	struct host_flash_verify_cache *cache)
+{
+	const struct flash_region *pos;
+	uint8_t layout[SHA256_HASH_LENGTH];
+	bool checked = false;
+	uint32_t flash_size;
+	uint32_t last_addr;
+	int status;
+	size_t i;
+
+	status = spi_flash_get_device_size (flash, &flash_size);
+	if (status != 0) {
+		return status;
+	}
+
+	for (i = 0; i < fw_count; i++) {
+		status = host_fw_verify_images_on_flash (flash, &img_list[i], true, 0, hash, rsa, cache);
+		if (status != 0) {
+			return status;
+		}
+	}
+
+	if (cache) {
+		status = host_fw_calculate_flash_layout (img_list, writable, fw_count, flash_size,
+			unused_byte, hash, layout);
+		if (status != 0) {
+			return status;
+		}
+
+		checked = host_flash_verify_cache_is_layout_checked (cache, layout);
+	}
+
+	last_addr = 0;
+	pos = host_fw_find_next_flash_region (last_addr, img_list, writable, fw_count);
+	while (pos) {
+		status = host_fw_check_unused_flash (flash, last_addr, pos->start_addr - last_addr,
+			unused_byte, cache, checked);
+		if (status != 0) {
+			return status;
+		}
+
+		last_addr = pos->start_addr + pos->length;
+		pos = host_fw_find_next_flash_region (last_addr, img_list, writable, fw_count);
+	}
+
+	status = host_fw_check_unused_flash (flash, last_addr, flash_size - last_addr, unused_byte,
+		cache, checked);
+	if ((status == 0) && cache) {
+		host_flash_verify_cache_set_layout_checked (cache, layout);
+	}
+
+	return status;
+}
+
 /**
  * Verify that the entire flash contents are good.  All images will be verified and unused regions
  * of read-only flash will be verified to be empty.
@@ -615,43 +938,53 @@ int host_fw_full_flash_verification_multiple_fw (const struct spi_flash *flash,
 	const struct pfm_image_list *img_list, const struct pfm_read_write_regions *writable,
 	size_t fw_count, uint8_t unused_byte, struct hash_engine *hash, struct rsa_engine *rsa)
 {
-	const struct flash_region *pos;
-	uint32_t flash_size;
-	uint32_t last_addr;
-	int status;
-	size_t i;
-
 	if ((flash == NULL) || (img_list == NULL) || (writable == NULL) || (hash == NULL) ||
 		(rsa == NULL)) {
 		return HOST_FW_UTIL_INVALID_ARGUMENT;
 	}
 
-	status = spi_flash_get_device_size (flash, &flash_size);
-	if (status != 0) {
-		return status;
-	}
+	return host_fw_full_flash_verification_on_flash (flash, img_list, writable, fw_count,
+		unused_byte, hash, rsa, NULL);
+}
 
-	for (i = 0; i < fw_count; i++) {
-		status = host_fw_verify_images_on_flash (flash, &img_list[i], true, 0, hash, rsa);
-		if (status != 0) {
-			return status;
-		}
+/**
+ * Verify that the entire flash contents are good.  All images will be verified and unused regions
+ * of read-only flash will be verified to be empty.
+ *
+ * Only the parts of flash written by the host since the last verification will be read from
+ * flash.  Images that have not been written will be verified using the cached digest of the
+ * image, and unused regions that have not been written will not be checked again as long as the
+ * flash layout has not changed.  If the SPI filter is not able to report host writes, the entire
+ * flash will be verified.
+ *
+ * @param flash The flash that should be validated.
+ * @param img_list An array of firmware images that should be validated.
+ * @param writable An array of writable regions for each firmware component.
+ * @param fw_count The number of firmware components in the list.  Both arrays of firmware
+ * information must be the same length.
+ * @param unused_byte The byte value to check for in unused flash regions.
+ * @param hash The hashing engine to use for validation.
+ * @param rsa The RSA engine to use for signature checking.
+ * @param cache The cache of verified flash contents.  If write tracking is not available for the
+ * device, the entire flash will be checked.
+ * @param cs The chip select of the flash device being validated.
+ *
+ * @return 0 if the flash contents are good or an error code.
+ */
+int host_fw_full_flash_verification_multiple_fw_with_cache (const struct spi_flash *flash,
+	const struct pfm_image_list *img_list, const struct pfm_read_write_regions *writable,
+	size_t fw_count, uint8_t unused_byte, struct hash_engine *hash, struct rsa_engine *rsa,
+	struct host_flash_verify_cache *cache, spi_filter_cs cs)
+{
+	if ((flash == NULL) || (img_list == NULL) || (writable == NULL) || (hash == NULL) ||
+		(rsa == NULL) || (cache == NULL)) {
+		return HOST_FW_UTIL_INVALID_ARGUMENT;
 	}
 
-	last_addr = 0;
-	pos = host_fw_find_next_flash_region (last_addr, img_list, writable, fw_count);
-	while (pos) {
-		status = flash_value_check (&flash->base, last_addr, pos->start_addr - last_addr,
-			unused_byte);
-		if (status != 0) {
-			return status;
-		}
-
-		last_addr = pos->start_addr + pos->length;
-		pos = host_fw_find_next_flash_region (last_addr, img_list, writable, fw_count);
-	}
+	cache = host_fw_start_cached_verification (cache, cs);
 
-	return flash_value_check (&flash->base, last_addr, flash_size - last_addr, unused_byte);
+	return host_fw_full_flash_verification_on_flash (flash, img_list, writable, fw_count,
+		unused_byte, hash, rsa, cache);
 }
 
 /**
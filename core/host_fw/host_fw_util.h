@@ -12,6 +12,7 @@
 #include "spi_filter/spi_filter_interface.h"
 #include "crypto/hash.h"
 #include "crypto/rsa.h"
+#include "host_flash_verify_cache.h"
 
 
 int host_fw_determine_version (const struct spi_flash *flash,
@@ -33,6 +34,9 @@ int host_fw_verify_images_multiple_fw (const struct spi_flash *flash,
 int host_fw_verify_offset_images_multiple_fw (const struct spi_flash *flash,
 	const struct pfm_image_list *img_list, size_t fw_count, uint32_t offset,
 	struct hash_engine *hash, struct rsa_engine *rsa);
+int host_fw_verify_images_multiple_fw_with_cache (const struct spi_flash *flash,
+	const struct pfm_image_list *img_list, size_t fw_count, struct hash_engine *hash,
+	struct rsa_engine *rsa, struct host_flash_verify_cache *cache, spi_filter_cs cs);
 
 int host_fw_full_flash_verification (const struct spi_flash *flash,
 	const struct pfm_image_list *img_list, const struct pfm_read_write_regions *writable,
@@ -40,6 +44,10 @@ int host_fw_full_flash_verification (const struct spi_flash *flash,
 int host_fw_full_flash_verification_multiple_fw (const struct spi_flash *flash,
 	const struct pfm_image_list *img_list, const struct pfm_read_write_regions *writable,
 	size_t fw_count, uint8_t unused_byte, struct hash_engine *hash, struct rsa_engine *rsa);
+int host_fw_full_flash_verification_multiple_fw_with_cache (const struct spi_flash *flash,
+	const struct pfm_image_list *img_list, const struct pfm_read_write_regions *writable,
+	size_t fw_count, uint8_t unused_byte, struct hash_engine *hash, struct rsa_engine *rsa,
+	struct host_flash_verify_cache *cache, spi_filter_cs cs);
 
 bool host_fw_are_read_write_regions_different (const struct pfm_read_write_regions *rw1,
 	const struct pfm_read_write_regions *rw2);
@@ -70,6 +70,7 @@ enum {
 	HOST_LOGGING_FLASH_RESET,					/**< Host flash was reset. */
 	HOST_LOGGING_FORCE_RESET,					/**< Forced reset issued to host. */
 	HOST_LOGGING_HOST_BOOTING_TIME,				/**< Time taken in ms for host to boot. */
+	HOST_LOGGING_VERIFY_CACHE_UNAVAILABLE,		/**< Host flash verified without the verification cache. */
 };
 
 
@@ -203,6 +203,7 @@ enum {
 	HOST_PROCESSOR_RW_RECOVERY_FAILED = HOST_PROCESSOR_ERROR (0x11),		/**< Failed to recover active read/write data. */
 	HOST_PROCESSOR_RW_RECOVERY_UNSUPPORTED = HOST_PROCESSOR_ERROR (0x12),	/**< Recovery of active read/write data is not supported. */
 	HOST_PROCESSOR_NO_ACTIVE_RW_DATA = HOST_PROCESSOR_ERROR (0x13),			/**< There is no active image for read/write recovery. */
+	HOST_PROCESSOR_SHARED_FLASH_MASTER = HOST_PROCESSOR_ERROR (0x14),		/**< The flash devices cannot be accessed at the same time. */
 };
 
 
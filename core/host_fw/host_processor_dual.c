@@ -143,6 +143,11 @@ static int host_processor_dual_flash_rollback (struct host_processor *host,
 			rw_flash = dual->flash->get_read_write_flash (dual->flash);
 			spi_flash_get_device_size (ro_flash, &dev_size);
 
+			/* The flash is being written by the RoT, which is not tracked by the SPI filter. */
+			if (dual->flash->invalidate_verified_flash) {
+				dual->flash->invalidate_verified_flash (dual->flash);
+			}
+
 			status = spi_flash_chip_erase (ro_flash);
 			if (status != 0) {
 				goto return_flash;
@@ -437,3 +442,45 @@ void host_processor_dual_release (struct host_processor_filtered *host)
 {
 	host_processor_filtered_release (host);
 }
+
+/**
+ * Set a worker that will be used to validate both flash devices at the same time.  When the
+ * read/write flash needs to be validated, the read-only flash will be validated by the worker task
+ * in parallel so that the result is available if the read/write flash is not good.
+ *
+ * The worker must use a hash engine and RSA engine that are separate from those provided for host
+ * verification.  Each flash device must be connected to a separate SPI master, since the two tasks
+ * will access the flash devices at the same time.  The PFMs are also read by both tasks at the same
+ * time, so the hash engine used by each PFM must be thread-safe.  If the flash manager uses a
+ * verification cache, each device should have its own cache so both validations can use one.
+ *
+ * @param host The host processor instance to update.
+ * @param worker The worker to use for parallel validation.  Set this to null to validate the flash
+ * devices sequentially.
+ *
+ * @return 0 if the worker was set successfully or an error code.  If both flash devices share the
+ * same SPI master, the worker will not be used.
+ */
+int host_processor_dual_set_verify_worker (struct host_processor_filtered *host,
+	const struct host_flash_verify_worker *worker)
+{
+	struct host_flash_manager_dual *flash;
+
+	if (host == NULL) {
+		return HOST_PROCESSOR_INVALID_ARGUMENT;
+	}
+
+	if (worker) {
+		flash = (struct host_flash_manager_dual*) host->flash;
+		if ((flash->flash_cs0 == NULL) || (flash->flash_cs1 == NULL) ||
+			(flash->flash_cs0->spi == flash->flash_cs1->spi)) {
+			return HOST_PROCESSOR_SHARED_FLASH_MASTER;
+		}
+	}
+
+	platform_mutex_lock (&host->lock);
+	host->verify_worker = worker;
+	platform_mutex_unlock (&host->lock);
+
+	return 0;
+}
@@ -8,6 +8,7 @@
 #include "host_processor.h"
 #include "host_processor_filtered.h"
 #include "host_flash_manager_dual.h"
+#include "host_flash_verify_worker.h"
 
 
 /**
@@ -36,6 +37,9 @@ int host_processor_dual_init_reset_flash_pulse_reset (struct host_processor_filt
 	struct pfm_manager *pfm, struct recovery_image_manager *recovery, int pulse_width);
 void host_processor_dual_release (struct host_processor_filtered *host);
 
+int host_processor_dual_set_verify_worker (struct host_processor_filtered *host,
+	const struct host_flash_verify_worker *worker);
+
 /* Internal functions for use by derived types. */
 int host_processor_dual_init_internal (struct host_processor_filtered *host,
 	const struct host_control *control, struct host_flash_manager_dual *flash,
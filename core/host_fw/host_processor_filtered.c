@@ -415,6 +415,10 @@ int host_processor_filtered_restore_read_write_data (struct host_processor_filte
 /**
  * Validate the flash against a single PFM.
  *
+ * If a verification worker is available and a failure of the read/write flash would require the
+ * read-only flash to be checked, both flash devices are validated at the same time.  The read-only
+ * result is only used if the read/write flash fails validation.
+ *
  * @param host The host processor instance to use for validation.
  * @param hash The hash engine to use for validation.
  * @param rsa The RSA engine to use for signature verification.
@@ -442,16 +446,37 @@ static int host_processor_filtered_validate_flash (struct host_processor_filtere
 	bool is_validated, bool single, bool *config_fail)
 {
 	struct host_flash_manager_rw_regions rw_list;
+	struct host_flash_manager_rw_regions ro_list;
 	int status = HOST_PROCESSOR_RW_SKIPPED;
+	int ro_status = 0;
 	int dirty_fail = 0;
 	bool checked_rw = true;
 	bool failed_rw = false;
+	bool ro_started = false;
 	bool pfm_dirty = host_state_manager_is_pfm_dirty (host->state);
 
 	if (!is_bypass && host_state_manager_is_inactive_dirty (host->state)) {
 		if (!is_validated) {
 			host_state_manager_set_run_time_validation (host->state, HOST_STATE_PREVALIDATED_NONE);
+
+			if (host->verify_worker && !single && !skip_ro && (!is_pending || pfm_dirty)) {
+				/* The read-only flash will be checked if the read/write flash fails validation.
+				 * Start that check now so it runs alongside read/write validation.  If the worker
+				 * is not available, the read-only flash will be checked afterwards. */
+				ro_started = (host_flash_verify_worker_start_read_only_validation (
+					host->verify_worker, host->flash, pfm, active, is_bypass) == 0);
+			}
+
 			status = host->flash->validate_read_write_flash (host->flash, pfm, hash, rsa, &rw_list);
+
+			if (ro_started) {
+				/* Wait for both validations to finish before making any state changes. */
+				ro_status = host_flash_verify_worker_get_read_only_result (host->verify_worker,
+					&ro_list);
+				if ((status == 0) && (ro_status == 0)) {
+					host->flash->free_read_write_regions (host->flash, &ro_list);
+				}
+			}
 		}
 		else {
 			status = host->flash->get_flash_read_write_regions (host->flash, pfm, true, &rw_list);
@@ -542,8 +567,16 @@ static int host_processor_filtered_validate_flash (struct host_processor_filtere
 
 	if (!skip_ro && (status != 0) && (!is_pending || is_bypass || pfm_dirty) &&
 		(!single || !checked_rw)) {
-		status = host->flash->validate_read_only_flash (host->flash, pfm, active, hash, rsa,
-			is_bypass, &rw_list);
+		if (ro_started) {
+			status = ro_status;
+			if (status == 0) {
+				memcpy (&rw_list, &ro_list, sizeof (rw_list));
+			}
+		}
+		else {
+			status = host->flash->validate_read_only_flash (host->flash, pfm, active, hash, rsa,
+				is_bypass, &rw_list);
+		}
 
 		if (is_pending) {
 			debug_log_create_entry (
@@ -1171,6 +1204,13 @@ int host_processor_filtered_apply_recovery_image (struct host_processor *host, b
 	observable_notify_observers (&filtered->base.observable,
 		offsetof (struct host_processor_observer, on_recovery));
 
+	/* The flash is being written by the RoT, which is not tracked by the SPI filter.  In bypass
+	 * mode, the flash configuration that would normally discard verified flash contents is not
+	 * run, so this must be done explicitly. */
+	if (filtered->flash->invalidate_verified_flash) {
+		filtered->flash->invalidate_verified_flash (filtered->flash);
+	}
+
 	status = spi_flash_chip_erase (ro_flash);
 	if (status != 0) {
 		goto return_flash;
@@ -8,6 +8,7 @@
 #include "host_processor.h"
 #include "host_control.h"
 #include "host_flash_manager.h"
+#include "host_flash_verify_worker.h"
 #include "host_state_manager.h"
 #include "spi_filter/spi_filter_interface.h"
 #include "manifest/pfm/pfm_manager.h"
@@ -32,6 +33,7 @@ struct host_processor_filtered {
 	int reset_pulse;							/**< The length of the reset pulse for the host. */
 	bool reset_flash;							/**< The flag to indicate that the host flash should bereset based on every host processor reset. */
 	platform_mutex lock;						/**< Synchronization for verification routines. */
+	const struct host_flash_verify_worker *verify_worker;	/**< Optional worker for parallel flash validation. */
 
 	/**
 	 * Private functions for customizing internal flows.
@@ -6,6 +6,11 @@
 #include "platform_api.h"
 #include "common/unused.h"
 
+#ifdef LOGGING_SUPPORT_DEBUG_LOG_FILTER
+#include "debug_log_filter.h"
+#include "system/system_logging.h"
+#endif
+
 
 /* By default, the global singleton for the debug log is defined here.  However, if the target
  * project wants to define this to be a constant instance, it needs to be defined and initialized
@@ -15,9 +20,60 @@ const struct logging *debug_log = NULL;
 #endif
 
 
+#ifdef LOGGING_SUPPORT_DEBUG_LOG
+/**
+ * Add an entry to the debug log without applying any filtering.
+ *
+ * @param severity Severity level of the new entry.
+ * @param component Component that is generating the entry.
+ * @param msg_index Identifier code for the log entry message.
+ * @param arg1 Log entry optional message specific argument.
+ * @param arg2 Log entry optional message specific argument.
+ * @param time Timestamp for the entry.
+ *
+ * @return Completion status, 0 if success or an error code.
+ */
+static int debug_log_write_entry (uint8_t severity, uint8_t component, uint8_t msg_index,
+	uint32_t arg1, uint32_t arg2, uint64_t time)
+{
+	struct debug_log_entry_info entry;
+
+	entry.format = DEBUG_LOG_ENTRY_FORMAT;
+	entry.severity = severity;
+	entry.component = component;
+	entry.msg_index = msg_index;
+	entry.arg1 = arg1;
+	entry.arg2 = arg2;
+	entry.time = time;
+
+	return debug_log->create_entry (debug_log, (uint8_t*) &entry, sizeof (entry));
+}
+
+#ifdef LOGGING_SUPPORT_DEBUG_LOG_FILTER
+/**
+ * Add a single entry to the debug log to report repeated entries that were dropped by the filter.
+ *
+ * @param summary Information about the dropped entries.
+ * @param time Timestamp for the entry.
+ *
+ * @return Completion status, 0 if success or an error code.
+ */
+static int debug_log_write_suppressed (const struct debug_log_filter_summary *summary,
+	uint64_t time)
+{
+	return debug_log_write_entry (summary->severity, DEBUG_LOG_COMPONENT_SYSTEM,
+		SYSTEM_LOGGING_ENTRIES_SUPPRESSED, ((uint32_t) summary->component << 8) | summary->msg_index,
+		summary->count, time);
+}
+#endif
+#endif
+
 /**
  * Create a new entry in the debug log.
  *
+ * If a debug log filter has been registered, the entry will only be added to the log if it passes
+ * the filter.  Entries that are dropped by the filter are not reported as a failure.
+ *
  * @param severity Severity level of the new entry.
  * @param component Component that is generating the entry.
  * @param msg_index Identifier code for the log entry message.
@@ -30,7 +86,10 @@ int debug_log_create_entry (uint8_t severity, uint8_t component, uint8_t msg_ind
 	uint32_t arg2)
 {
 #ifdef LOGGING_SUPPORT_DEBUG_LOG
-	struct debug_log_entry_info entry;
+	uint64_t time;
+#ifdef LOGGING_SUPPORT_DEBUG_LOG_FILTER
+	struct debug_log_filter_summary summary;
+#endif
 
 	if (debug_log == NULL) {
 		return LOGGING_NO_LOG_AVAILABLE;
@@ -40,15 +99,22 @@ int debug_log_create_entry (uint8_t severity, uint8_t component, uint8_t msg_ind
 		return LOGGING_UNSUPPORTED_SEVERITY;
 	}
 
-	entry.format = DEBUG_LOG_ENTRY_FORMAT;
-	entry.severity = severity;
-	entry.component = component;
-	entry.msg_index = msg_index;
-	entry.arg1 = arg1;
-	entry.arg2 = arg2;
-	entry.time = platform_get_time ();
+	time = platform_get_time ();
 
-	return debug_log->create_entry (debug_log, (uint8_t*) &entry, sizeof (entry));
+#ifdef LOGGING_SUPPORT_DEBUG_LOG_FILTER
+	if (debug_log_filter != NULL) {
+		if (!debug_log_filter_allow_entry (debug_log_filter, severity, component, msg_index, time,
+			&summary)) {
+			return 0;
+		}
+
+		if (summary.count != 0) {
+			debug_log_write_suppressed (&summary, time);
+		}
+	}
+#endif
+
+	return debug_log_write_entry (severity, component, msg_index, arg1, arg2, time);
 #else
 	UNUSED (severity);
 	UNUSED (component);
@@ -62,17 +128,29 @@ int debug_log_create_entry (uint8_t severity, uint8_t component, uint8_t msg_ind
 
 #ifndef LOGGING_DISABLE_FLUSH
 /**
- * Flush any buffered contents of the debug log.
+ * Flush any buffered contents of the debug log.  Entries that have been suppressed by the debug log
+ * filter will be reported before flushing.
  *
  * @return Completion status, 0 if success or an error code.
  */
 int debug_log_flush ()
 {
 #ifdef LOGGING_SUPPORT_DEBUG_LOG
+#ifdef LOGGING_SUPPORT_DEBUG_LOG_FILTER
+	struct debug_log_filter_summary summary;
+#endif
+
 	if (debug_log == NULL) {
 		return LOGGING_NO_LOG_AVAILABLE;
 	}
 
+#ifdef LOGGING_SUPPORT_DEBUG_LOG_FILTER
+	/* Report any entries still being suppressed so the counts are not lost. */
+	while (debug_log_filter_get_suppressed (debug_log_filter, &summary)) {
+		debug_log_write_suppressed (&summary, platform_get_time ());
+	}
+#endif
+
 	return debug_log->flush (debug_log);
 #else
 	return LOGGING_NO_LOG_AVAILABLE;
@@ -0,0 +1,344 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "debug_log_filter.h"
+
+
+/* By default, the global singleton for the debug log filter is defined here.  However, if the
+ * target project wants to define this to be a constant instance, it needs to be defined and
+ * initialized in that scope. */
+#ifndef LOGGING_DEBUG_LOG_FILTER_CONST_INSTANCE
+const struct debug_log_filter *debug_log_filter = NULL;
+#endif
+
+
+/**
+ * Initialize a filter for debug log entries.  All components will start with a threshold that
+ * allows every entry to be logged.
+ *
+ * @param filter The filter to initialize.
+ * @param state Variable context for the filter.  This must be uninitialized.
+ * @param buckets Storage for rate limiting state.  This can be null to disable rate limiting.
+ * @param bucket_count The number of rate limiting buckets.  This is the number of different
+ * entry types that can be tracked at the same time.
+ * @param burst The maximum number of entries of a single type that can be logged without being
+ * rate limited.  Set this to 0 to disable rate limiting.
+ * @param refill_ms The amount of time, in milliseconds, needed to allow one more entry of a type
+ * that has been rate limited.
+ *
+ * @return 0 if the filter was initialized successfully or an error code.
+ */
+int debug_log_filter_init (struct debug_log_filter *filter, struct debug_log_filter_state *state,
+	struct debug_log_filter_bucket *buckets, size_t bucket_count, uint16_t burst,
+	uint32_t refill_ms)
+{
+	if (filter == NULL) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	memset (filter, 0, sizeof (struct debug_log_filter));
+
+	filter->state = state;
+	filter->buckets = buckets;
+	filter->bucket_count = bucket_count;
+	filter->burst = burst;
+	filter->refill_ms = refill_ms;
+
+	return debug_log_filter_init_state (filter);
+}
+
+/**
+ * Initialize only the variable state for a debug log filter.  The rest of the filter is assumed to
+ * have already been initialized.
+ *
+ * This would generally be used with a statically initialized instance.
+ *
+ * @param filter The filter that contains the state to initialize.
+ *
+ * @return 0 if the state was successfully initialized or an error code.
+ */
+int debug_log_filter_init_state (const struct debug_log_filter *filter)
+{
+	if ((filter == NULL) || (filter->state == NULL)) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	if ((filter->burst != 0) &&
+		((filter->buckets == NULL) || (filter->bucket_count == 0) || (filter->refill_ms == 0))) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	memset (filter->state, 0, sizeof (struct debug_log_filter_state));
+	memset (filter->state->threshold, DEBUG_LOG_FILTER_LOG_ALL,
+		sizeof (filter->state->threshold));
+
+	if (filter->buckets) {
+		memset (filter->buckets, 0, sizeof (struct debug_log_filter_bucket) * filter->bucket_count);
+	}
+
+	return platform_mutex_init (&filter->state->lock);
+}
+
+/**
+ * Release the resources used by a debug log filter.
+ *
+ * @param filter The filter to release.
+ */
+void debug_log_filter_release (const struct debug_log_filter *filter)
+{
+	if (filter) {
+		platform_mutex_free (&filter->state->lock);
+	}
+}
+
+/**
+ * Set the severity threshold for a single component.  Only entries with a severity level less than
+ * the threshold will be logged.  For example, a threshold of DEBUG_LOG_SEVERITY_INFO will log
+ * errors and warnings, but not informational entries.
+ *
+ * @param filter The filter to update.
+ * @param component The component ID to configure.
+ * @param threshold The severity threshold for the component.  Use DEBUG_LOG_FILTER_LOG_ALL to log
+ * every entry or DEBUG_LOG_FILTER_LOG_NONE to drop every entry.
+ *
+ * @return 0 if the threshold was updated or an error code.
+ */
+int debug_log_filter_set_threshold (const struct debug_log_filter *filter, uint8_t component,
+	uint8_t threshold)
+{
+	if ((filter == NULL) || (threshold > DEBUG_LOG_FILTER_LOG_ALL)) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	filter->state->threshold[component] = threshold;
+
+	return 0;
+}
+
+/**
+ * Set the same severity threshold for every component.
+ *
+ * @param filter The filter to update.
+ * @param threshold The severity threshold to apply.  Use DEBUG_LOG_FILTER_LOG_ALL to log every
+ * entry or DEBUG_LOG_FILTER_LOG_NONE to drop every entry.
+ *
+ * @return 0 if the thresholds were updated or an error code.
+ */
+int debug_log_filter_set_all_thresholds (const struct debug_log_filter *filter, uint8_t threshold)
+{
+	if ((filter == NULL) || (threshold > DEBUG_LOG_FILTER_LOG_ALL)) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	memset (filter->state->threshold, threshold, sizeof (filter->state->threshold));
+
+	return 0;
+}
+
+/**
+ * Get the current severity threshold for a component.
+ *
+ * @param filter The filter to query.
+ * @param component The component ID to query.
+ *
+ * @return The severity threshold for the component or an error code.  Use ROT_IS_ERROR to check
+ * the return value.
+ */
+int debug_log_filter_get_threshold (const struct debug_log_filter *filter, uint8_t component)
+{
+	if (filter == NULL) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	return filter->state->threshold[component];
+}
+
+/**
+ * Find the rate limiting bucket for a type of log entry.
+ *
+ * @param filter The filter to search.
+ * @param component Component ID for the entry.
+ * @param msg_index Message ID for the entry.
+ *
+ * @return The bucket assigned to the entry type.
+ */
+static struct debug_log_filter_bucket* debug_log_filter_find_bucket (
+	const struct debug_log_filter *filter, uint8_t component, uint8_t msg_index)
+{
+	uint32_t key = ((uint32_t) component << 8) | msg_index;
+
+	/* Multiplicative hash to spread sequential message IDs across the table. */
+	return &filter->buckets[((key * 2654435761U) >> 16) % filter->bucket_count];
+}
+
+/**
+ * Report the entries that have been suppressed for a rate limiting bucket.  The bucket suppression
+ * count will be cleared.
+ *
+ * @param bucket The bucket to report.
+ * @param summary Output for the suppression information.
+ */
+static void debug_log_filter_report_bucket (struct debug_log_filter_bucket *bucket,
+	struct debug_log_filter_summary *summary)
+{
+	summary->count = bucket->suppressed;
+	summary->severity = bucket->severity;
+	summary->component = bucket->component;
+	summary->msg_index = bucket->msg_index;
+
+	bucket->suppressed = 0;
+}
+
+/**
+ * Determine if a new entry should be added to the debug log.
+ *
+ * If entries of the same type were previously suppressed, or if a different type of entry needs to
+ * be evicted from the rate limiting bucket, a summary of the suppressed entries will be provided.
+ * This summary should be logged before the new entry.
+ *
+ * @param filter The filter to check against.
+ * @param severity Severity level of the new entry.
+ * @param component Component ID of the new entry.
+ * @param msg_index Message ID of the new entry.
+ * @param time The current time, in milliseconds.
+ * @param summary Output for suppressed entries that need to be reported.  The count will be 0 if
+ * there is nothing to report.
+ *
+ * @return true if the entry should be logged or false if it should be dropped.
+ */
+bool debug_log_filter_allow_entry (const struct debug_log_filter *filter, uint8_t severity,
+	uint8_t component, uint8_t msg_index, uint64_t time, struct debug_log_filter_summary *summary)
+{
+	struct debug_log_filter_bucket *bucket;
+	uint64_t refills;
+	bool allow = true;
+
+	if ((filter == NULL) || (summary == NULL)) {
+		return true;
+	}
+
+	summary->count = 0;
+
+	/* Threshold checks don't need the lock, so entries that are filtered out are dropped with as
+	 * little overhead as possible.  A concurrent threshold update only changes which side of the
+	 * update a single entry falls on. */
+	if (severity >= filter->state->threshold[component]) {
+		platform_atomic_fetch_add (&filter->state->filtered, 1);
+
+		return false;
+	}
+
+	if (filter->burst == 0) {
+		return true;
+	}
+
+	platform_mutex_lock (&filter->state->lock);
+
+	bucket = debug_log_filter_find_bucket (filter, component, msg_index);
+	if (!bucket->valid || (bucket->component != component) || (bucket->msg_index != msg_index)) {
+		if (bucket->valid && (bucket->suppressed != 0)) {
+			debug_log_filter_report_bucket (bucket, summary);
+		}
+
+		bucket->valid = true;
+		bucket->component = component;
+		bucket->msg_index = msg_index;
+		bucket->tokens = filter->burst;
+		bucket->refill_time = time;
+		bucket->suppressed = 0;
+	}
+	else if (time > bucket->refill_time) {
+		refills = (time - bucket->refill_time) / filter->refill_ms;
+		if ((bucket->tokens + refills) >= filter->burst) {
+			bucket->tokens = filter->burst;
+			bucket->refill_time = time;
+		}
+		else {
+			bucket->tokens += refills;
+			bucket->refill_time += refills * filter->refill_ms;
+		}
+	}
+
+	if (bucket->tokens != 0) {
+		bucket->tokens--;
+
+		if (bucket->suppressed != 0) {
+			debug_log_filter_report_bucket (bucket, summary);
+		}
+	}
+	else {
+		if ((bucket->suppressed == 0) || (severity < bucket->severity)) {
+			bucket->severity = severity;
+		}
+
+		bucket->suppressed++;
+		filter->state->suppressed++;
+		allow = false;
+	}
+
+	platform_mutex_unlock (&filter->state->lock);
+
+	return allow;
+}
+
+/**
+ * Get a summary for entries that have been suppressed by the rate limiter but not yet reported.
+ * The suppression count for the reported entry type is cleared.
+ *
+ * This should be called repeatedly until it returns false to report every suppressed entry type.
+ *
+ * @param filter The filter to query.
+ * @param summary Output for the suppressed entry information.
+ *
+ * @return true if there were suppressed entries to report or false if there were none.
+ */
+bool debug_log_filter_get_suppressed (const struct debug_log_filter *filter,
+	struct debug_log_filter_summary *summary)
+{
+	size_t i;
+	bool found = false;
+
+	if ((filter == NULL) || (summary == NULL) || (filter->buckets == NULL)) {
+		return false;
+	}
+
+	platform_mutex_lock (&filter->state->lock);
+
+	for (i = 0; i < filter->bucket_count; i++) {
+		if (filter->buckets[i].valid && (filter->buckets[i].suppressed != 0)) {
+			debug_log_filter_report_bucket (&filter->buckets[i], summary);
+			found = true;
+			break;
+		}
+	}
+
+	platform_mutex_unlock (&filter->state->lock);
+
+	return found;
+}
+
+/**
+ * Get the counters for entries dropped by the filter.
+ *
+ * @param filter The filter to query.
+ * @param stats Output for the filter counters.
+ *
+ * @return 0 if the counters were retrieved or an error code.
+ */
+int debug_log_filter_get_stats (const struct debug_log_filter *filter,
+	struct debug_log_filter_stats *stats)
+{
+	if ((filter == NULL) || (stats == NULL)) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&filter->state->lock);
+	stats->filtered = platform_atomic_load (&filter->state->filtered);
+	stats->suppressed = filter->state->suppressed;
+	platform_mutex_unlock (&filter->state->lock);
+
+	return 0;
+}
@@ -0,0 +1,125 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef DEBUG_LOG_FILTER_H_
+#define DEBUG_LOG_FILTER_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "platform_api.h"
+#include "logging/debug_log.h"
+
+
+/**
+ * The number of component IDs that can be configured in the filter.  This covers every possible
+ * component ID in a debug log entry.
+ */
+#define	DEBUG_LOG_FILTER_NUM_COMPONENTS		256
+
+/**
+ * Severity threshold that will allow entries at every severity level to be logged.
+ */
+#define	DEBUG_LOG_FILTER_LOG_ALL			DEBUG_LOG_NUM_SEVERITY
+
+/**
+ * Severity threshold that will prevent any entries from being logged.
+ */
+#define	DEBUG_LOG_FILTER_LOG_NONE			0
+
+
+/**
+ * Rate limiting state for a single type of log entry.
+ */
+struct debug_log_filter_bucket {
+	uint64_t refill_time;					/**< Last time tokens were added to the bucket. */
+	uint32_t suppressed;					/**< Number of entries dropped since the last summary. */
+	uint16_t tokens;						/**< Number of entries that can currently be logged. */
+	uint8_t component;						/**< Component ID for entries using this bucket. */
+	uint8_t msg_index;						/**< Message ID for entries using this bucket. */
+	uint8_t severity;						/**< Most severe level of any suppressed entry. */
+	bool valid;								/**< Flag indicating the bucket is assigned to an entry. */
+};
+
+/**
+ * Information about entries that were suppressed by the rate limiter.
+ */
+struct debug_log_filter_summary {
+	uint32_t count;							/**< The number of entries that were suppressed. */
+	uint8_t severity;						/**< Most severe level of any suppressed entry. */
+	uint8_t component;						/**< Component ID for the suppressed entries. */
+	uint8_t msg_index;						/**< Message ID for the suppressed entries. */
+};
+
+/**
+ * Counters for entries dropped by the filter.
+ */
+struct debug_log_filter_stats {
+	uint32_t filtered;						/**< Number of entries dropped by severity thresholds. */
+	uint32_t suppressed;					/**< Number of entries dropped by the rate limiter. */
+};
+
+/**
+ * Variable context for a debug log filter.
+ */
+struct debug_log_filter_state {
+	platform_mutex lock;					/**< Synchronization for rate limiting. */
+	uint8_t threshold[DEBUG_LOG_FILTER_NUM_COMPONENTS];	/**< Severity threshold for each component. */
+	volatile uint32_t filtered;				/**< Number of entries dropped by severity thresholds. */
+	uint32_t suppressed;					/**< Number of entries dropped by the rate limiter. */
+};
+
+/**
+ * Filter to limit the entries that get added to the debug log.
+ *
+ * Each component has a severity threshold.  Only entries that are more severe than the threshold
+ * for the component will be logged.  The thresholds can be changed at run-time.
+ *
+ * Entries that pass the severity check are then rate limited by a token bucket keyed by the
+ * component and message ID.  Each bucket can hold a small burst of entries and refills at a fixed
+ * rate.  Entries that arrive while the bucket is empty are dropped and counted.  The count is
+ * reported in a single summary entry the next time that entry is logged or the log is flushed.
+ *
+ * Buckets are assigned to message types by a hash of the component and message ID.  If two message
+ * types share a bucket, the older one is reported and replaced.
+ */
+struct debug_log_filter {
+	struct debug_log_filter_state *state;	/**< Variable context for the filter. */
+	struct debug_log_filter_bucket *buckets;	/**< Storage for rate limiting state. */
+	size_t bucket_count;					/**< Number of rate limiting buckets. */
+	uint16_t burst;							/**< Maximum number of entries that can be logged at once. */
+	uint32_t refill_ms;						/**< Time to add one entry to a rate limiting bucket. */
+};
+
+
+/**
+ * Global singleton for the debug log filter.
+ */
+#ifndef LOGGING_DEBUG_LOG_FILTER_CONST_INSTANCE
+extern const struct debug_log_filter *debug_log_filter;
+#else
+extern const struct debug_log_filter *const debug_log_filter;
+#endif
+
+
+int debug_log_filter_init (struct debug_log_filter *filter, struct debug_log_filter_state *state,
+	struct debug_log_filter_bucket *buckets, size_t bucket_count, uint16_t burst,
+	uint32_t refill_ms);
+int debug_log_filter_init_state (const struct debug_log_filter *filter);
+void debug_log_filter_release (const struct debug_log_filter *filter);
+
+int debug_log_filter_set_threshold (const struct debug_log_filter *filter, uint8_t component,
+	uint8_t threshold);
+int debug_log_filter_set_all_thresholds (const struct debug_log_filter *filter, uint8_t threshold);
+int debug_log_filter_get_threshold (const struct debug_log_filter *filter, uint8_t component);
+
+bool debug_log_filter_allow_entry (const struct debug_log_filter *filter, uint8_t severity,
+	uint8_t component, uint8_t msg_index, uint64_t time, struct debug_log_filter_summary *summary);
+bool debug_log_filter_get_suppressed (const struct debug_log_filter *filter,
+	struct debug_log_filter_summary *summary);
+
+int debug_log_filter_get_stats (const struct debug_log_filter *filter,
+	struct debug_log_filter_stats *stats);
+
+
+#endif /* DEBUG_LOG_FILTER_H_ */
@@ -0,0 +1,34 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef DEBUG_LOG_FILTER_STATIC_H_
+#define DEBUG_LOG_FILTER_STATIC_H_
+
+#include "logging/debug_log_filter.h"
+
+
+/**
+ * Initialize a static instance of a debug log filter.  This does not initialize the filter state.
+ * This can be a constant instance.
+ *
+ * There is no validation done on the arguments.
+ *
+ * @param state_ptr Variable context for the filter.
+ * @param buckets_ptr Storage for rate limiting state.  This can be null to disable rate limiting.
+ * @param bucket_cnt The number of rate limiting buckets.
+ * @param burst_len The maximum number of entries of a single type that can be logged without being
+ * rate limited.  Set this to 0 to disable rate limiting.
+ * @param refill_time_ms The amount of time needed to allow one more entry of a type that has been
+ * rate limited.
+ */
+#define	debug_log_filter_static_init(state_ptr, buckets_ptr, bucket_cnt, burst_len, \
+	refill_time_ms)	{ \
+		.state = state_ptr, \
+		.buckets = buckets_ptr, \
+		.bucket_count = bucket_cnt, \
+		.burst = burst_len, \
+		.refill_ms = refill_time_ms \
+	}
+
+
+#endif /* DEBUG_LOG_FILTER_STATIC_H_ */
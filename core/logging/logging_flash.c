@@ -14,6 +14,67 @@
 #define	LOGGING_FLASH_TERMINATOR	(1U << 15)
 
 
+/**
+ * Rebuild the index used to find the sector for a log offset.  This must be called any time the
+ * amount of data stored in a sector or the starting sector of the log changes.
+ *
+ * Any cached read position is reset.
+ *
+ * @param logging The log to update.
+ */
+static void logging_flash_update_read_index (const struct logging_flash *logging)
+{
+	struct logging_flash_state *state = logging->state;
+	int sector = state->log_start;
+	int count = 0;
+
+	state->read_offset[0] = 0;
+	while ((count < LOGGING_FLASH_SECTORS) && (state->flash_used[sector] != 0)) {
+		state->read_offset[count + 1] = state->read_offset[count] + state->flash_used[sector];
+
+		sector = (sector + 1) % LOGGING_FLASH_SECTORS;
+		count++;
+	}
+
+	state->read_sectors = count;
+	state->cursor_offset = 0;
+	state->cursor_index = 0;
+}
+
+/**
+ * Find the sector that contains a log offset.  The offset must be less than the total amount of
+ * data stored on flash.
+ *
+ * @param logging The log to search.
+ * @param offset The log offset to find.
+ *
+ * @return The index, in log order, of the sector containing the offset.
+ */
+static int logging_flash_find_read_sector (const struct logging_flash *logging, uint32_t offset)
+{
+	const struct logging_flash_state *state = logging->state;
+	int low = 0;
+	int high = state->read_sectors - 1;
+	int mid;
+
+	/* Sequential reads pick up where the last read stopped without needing to search. */
+	if ((offset == state->cursor_offset) && (state->cursor_index < state->read_sectors)) {
+		return state->cursor_index;
+	}
+
+	while (low < high) {
+		mid = (low + high + 1) / 2;
+		if (state->read_offset[mid] <= offset) {
+			low = mid;
+		}
+		else {
+			high = mid - 1;
+		}
+	}
+
+	return low;
+}
+
 /**
  * Save the entry buffer to flash.
  *
@@ -46,6 +107,8 @@ static int logging_flash_save_buffer (const struct logging_flash *logging)
 					logging->state->log_start = next_sector;
 				}
 			}
+
+			logging_flash_update_read_index (logging);
 		}
 
 		status = spi_flash_write (logging->flash, logging->state->next_addr,
@@ -91,6 +154,8 @@ static int logging_flash_save_buffer (const struct logging_flash *logging)
 				logging->state->next_write - logging->state->entry_buffer - write_len);
 			logging->state->next_write -= write_len;
 		}
+
+		logging_flash_update_read_index (logging);
 	}
 
 	return status;
@@ -194,6 +259,7 @@ int logging_flash_clear (const struct logging *logging)
 
 	memset (flash_log->state->flash_used, 0, sizeof (flash_log->state->flash_used));
 	flash_log->state->log_start = 0;
+	logging_flash_update_read_index (flash_log);
 
 	flash_log->state->next_addr = flash_log->base_addr;
 	flash_log->state->next_write = flash_log->state->entry_buffer;
@@ -235,60 +301,68 @@ int logging_flash_read_contents (const struct logging *logging, uint32_t offset,
 	size_t length)
 {
 	const struct logging_flash *flash_log = (const struct logging_flash*) logging;
+	struct logging_flash_state *state;
 	int bytes_read = 0;
 	int i;
-	int sectors;
+	int sector;
 	size_t read_len;
 	uint32_t read_offset;
+	uint32_t flash_len;
 	int status;
 
 	if ((flash_log == NULL) || (contents == NULL)) {
 		return LOGGING_INVALID_ARGUMENT;
 	}
 
-	platform_mutex_lock (&flash_log->state->lock);
+	state = flash_log->state;
+	platform_mutex_lock (&state->lock);
 
-	i = flash_log->state->log_start;
-	sectors = 0;
+	flash_len = state->read_offset[state->read_sectors];
+	if ((offset < flash_len) && (length != 0)) {
+		i = logging_flash_find_read_sector (flash_log, offset);
 
-	while ((length != 0) && (sectors < LOGGING_FLASH_SECTORS) &&
-		(flash_log->state->flash_used[i] != 0)) {
-
-		read_offset = (offset < flash_log->state->flash_used[i]) ?
-			offset : flash_log->state->flash_used[i];
-		read_len = (length < (flash_log->state->flash_used[i] - read_offset)) ?
-			length : (flash_log->state->flash_used[i] - read_offset);
+		while ((length != 0) && (i < state->read_sectors)) {
+			sector = (state->log_start + i) % LOGGING_FLASH_SECTORS;
+			read_offset = offset - state->read_offset[i];
+			read_len = state->flash_used[sector] - read_offset;
+			if (length < read_len) {
+				read_len = length;
+			}
+			else {
+				i++;
+			}
 
-		if (read_len != 0) {
 			status = spi_flash_read (flash_log->flash,
-				flash_log->base_addr + (FLASH_SECTOR_SIZE * i) + read_offset, contents, read_len);
+				flash_log->base_addr + (FLASH_SECTOR_SIZE * sector) + read_offset, contents,
+				read_len);
 			if (status != 0) {
-				platform_mutex_unlock (&flash_log->state->lock);
+				platform_mutex_unlock (&state->lock);
 				return status;
 			}
-		}
 
-		bytes_read += read_len;
-		contents += read_len;
-		length -= read_len;
-		offset -= read_offset;
+			bytes_read += read_len;
+			contents += read_len;
+			length -= read_len;
+			offset += read_len;
+		}
 
-		i = (i + 1) % LOGGING_FLASH_SECTORS;
-		sectors++;
+		state->cursor_offset = offset;
+		state->cursor_index = i;
 	}
 
 	/* After reading all data from flash, read buffered entries that haven't been flushed yet. */
-	read_len = flash_log->state->next_write - flash_log->state->entry_buffer;
-	if (flash_log->state->terminated) {
+	read_len = state->next_write - state->entry_buffer;
+	if (state->terminated) {
 		read_len -= sizeof (struct logging_entry_header);
 	}
-	read_offset = (offset < read_len) ? offset : read_len;
+	read_offset = (offset > flash_len) ? (offset - flash_len) : 0;
+	read_offset = (read_offset < read_len) ? read_offset : read_len;
 	read_len = (length < (read_len - read_offset)) ? length : (read_len - read_offset);
 
-	memcpy (contents, flash_log->state->entry_buffer + read_offset, read_len);
+	memcpy (contents, state->entry_buffer + read_offset, read_len);
 	bytes_read += read_len;
 
-	platform_mutex_unlock (&flash_log->state->lock);
+	platform_mutex_unlock (&state->lock);
 
 	return bytes_read;
 }
@@ -455,6 +529,8 @@ int logging_flash_init_state (const struct logging_flash *logging)
 		return status;
 	}
 
+	logging_flash_update_read_index (logging);
+
 	logging->state->next_addr = flash_addr;
 	logging->state->next_entry_id = entry_id;
 	logging->state->next_write = logging->state->entry_buffer;
@@ -32,6 +32,10 @@ struct logging_flash_state {
 	uint32_t flash_used[LOGGING_FLASH_SECTORS];	/**< Number of valid bytes stored in each sector. */
 	uint32_t next_addr;							/**< Next flash address to write to. */
 	int log_start;								/**< The sector that contains the first entries. */
+	uint32_t read_offset[LOGGING_FLASH_SECTORS + 1];	/**< Log offset for the start of each sector, in log order. */
+	int read_sectors;							/**< The number of sectors, from the start, with log data. */
+	uint32_t cursor_offset;						/**< Log offset following the last read. */
+	int cursor_index;							/**< Sector index, in log order, for the cursor offset. */
 };
 
 /**
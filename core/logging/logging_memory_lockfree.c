@@ -0,0 +1,475 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include "logging_memory_lockfree.h"
+#include "common/unused.h"
+
+
+/**
+ * Flag in a slot sequence number indicating the entry is being written.
+ */
+#define	LOGGING_MEMORY_LOCKFREE_BUSY			1
+
+/**
+ * Flag in a slot sequence number indicating the entry was dropped.  The slot does not contain data
+ * for the entry, so readers skip over it.  The busy flag remains set on a dropped entry until the
+ * older entry that was using the slot has been written.
+ */
+#define	LOGGING_MEMORY_LOCKFREE_SKIP			2
+
+/**
+ * Mask of all flags in a slot sequence number.
+ */
+#define	LOGGING_MEMORY_LOCKFREE_FLAGS			\
+	(LOGGING_MEMORY_LOCKFREE_BUSY | LOGGING_MEMORY_LOCKFREE_SKIP)
+
+/**
+ * Get the sequence number for a slot that contains a complete entry.  A sequence number of 0
+ * indicates a slot that has never been written.
+ *
+ * @param id The ID of the entry in the slot.
+ */
+#define	LOGGING_MEMORY_LOCKFREE_SEQUENCE(id)	((uint32_t) (((id) + 1) << 2))
+
+/**
+ * The number of times a read will be restarted because the log wrapped around while it was being
+ * read before the read fails.
+ */
+#define	LOGGING_MEMORY_LOCKFREE_MAX_RETRIES		8
+
+
+int logging_memory_lockfree_create_entry (const struct logging *logging, uint8_t *entry,
+	size_t length)
+{
+	const struct logging_memory_lockfree *mem_log = (const struct logging_memory_lockfree*) logging;
+	struct logging_entry_header header;
+	volatile uint32_t *sequence;
+	uint32_t current;
+	uint32_t claim;
+	uint32_t entry_id;
+	uint8_t *slot;
+
+	if ((mem_log == NULL) || (entry == NULL)) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	if (length != (mem_log->entry_size - sizeof (struct logging_entry_header))) {
+		return LOGGING_BAD_ENTRY_LENGTH;
+	}
+
+	entry_id = platform_atomic_fetch_add (&mem_log->state->next_entry_id, 1);
+	sequence = &mem_log->sequence[entry_id % mem_log->entry_count];
+
+	/* Claim the slot for the new entry.  If the slot already holds a newer entry, the log has
+	 * wrapped around while this entry was being added.  There is no room for the entry, so it gets
+	 * dropped.
+	 *
+	 * If an older entry is still being written to the slot, this entry also gets dropped.  In this
+	 * case, the entry is marked as skipped so readers don't wait for an entry that will never be
+	 * written. */
+	do {
+		current = platform_atomic_load (sequence);
+		if ((int32_t) (current - LOGGING_MEMORY_LOCKFREE_SEQUENCE (entry_id)) >= 0) {
+			platform_atomic_fetch_add (&mem_log->state->dropped, 1);
+			return 0;
+		}
+
+		claim = LOGGING_MEMORY_LOCKFREE_SEQUENCE (entry_id) | LOGGING_MEMORY_LOCKFREE_BUSY;
+		if (current & LOGGING_MEMORY_LOCKFREE_BUSY) {
+			claim |= LOGGING_MEMORY_LOCKFREE_SKIP;
+		}
+	} while (!platform_atomic_compare_exchange (sequence, current, claim));
+
+	if (claim & LOGGING_MEMORY_LOCKFREE_SKIP) {
+		platform_atomic_fetch_add (&mem_log->state->dropped, 1);
+		return 0;
+	}
+
+	header.log_magic = LOGGING_MAGIC_START;
+	header.length = sizeof (header) + length;
+	header.entry_id = entry_id;
+
+	slot = &mem_log->log_buffer[(entry_id % mem_log->entry_count) * mem_log->entry_size];
+	memcpy (slot, (uint8_t*) &header, sizeof (header));
+	memcpy (&slot[sizeof (header)], entry, length);
+
+	/* Publish the entry.  If a newer entry was dropped while this one was being written, the slot
+	 * now marks the newer entry as skipped and this entry is no longer part of the log.  Only
+	 * release the slot so it can be used again. */
+	if (!platform_atomic_compare_exchange (sequence,
+		LOGGING_MEMORY_LOCKFREE_SEQUENCE (entry_id) | LOGGING_MEMORY_LOCKFREE_BUSY,
+		LOGGING_MEMORY_LOCKFREE_SEQUENCE (entry_id))) {
+		do {
+			current = platform_atomic_load (sequence);
+		} while (!platform_atomic_compare_exchange (sequence, current,
+			current & ~LOGGING_MEMORY_LOCKFREE_BUSY));
+	}
+
+	return 0;
+}
+
+#ifndef LOGGING_DISABLE_FLUSH
+int logging_memory_lockfree_flush (const struct logging *logging)
+{
+	UNUSED (logging);
+
+	return 0;
+}
+#endif
+
+int logging_memory_lockfree_clear (const struct logging *logging)
+{
+	const struct logging_memory_lockfree *mem_log = (const struct logging_memory_lockfree*) logging;
+
+	if (mem_log == NULL) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	platform_atomic_store (&mem_log->state->first_entry_id,
+		platform_atomic_load (&mem_log->state->next_entry_id));
+
+	return 0;
+}
+
+/**
+ * Determine the range of entry IDs that could currently be stored in the log.
+ *
+ * @param mem_log The log to query.
+ * @param first Output for the oldest entry ID that could be in the log.
+ *
+ * @return The number of entry IDs in the range.
+ */
+static uint32_t logging_memory_lockfree_get_range (const struct logging_memory_lockfree *mem_log,
+	uint32_t *first)
+{
+	uint32_t start = platform_atomic_load (&mem_log->state->first_entry_id);
+	uint32_t end = platform_atomic_load (&mem_log->state->next_entry_id);
+	uint32_t count = end - start;
+
+	if (count > mem_log->entry_count) {
+		count = mem_log->entry_count;
+	}
+
+	*first = end - count;
+
+	return count;
+}
+
+/**
+ * Determine if a slot sequence number marks an entry that was dropped.
+ *
+ * @param current The sequence number of the slot.
+ * @param entry_id The ID of the entry to check.
+ *
+ * @return true if the entry was dropped.
+ */
+static bool logging_memory_lockfree_is_skipped (uint32_t current, uint32_t entry_id)
+{
+	return ((current & ~LOGGING_MEMORY_LOCKFREE_BUSY) ==
+		(LOGGING_MEMORY_LOCKFREE_SEQUENCE (entry_id) | LOGGING_MEMORY_LOCKFREE_SKIP));
+}
+
+/**
+ * Find the complete entries that can be read from the log.  Only the contiguous run of complete
+ * entries starting from the oldest entry is readable, so an entry that is still being written hides
+ * all newer entries until it is complete.  This keeps the offset of each readable entry fixed as
+ * more entries are completed, allowing the log to be read in multiple pieces.  Entries that were
+ * dropped are part of the run, but they are not readable.
+ *
+ * If the log wraps around while the entries are being checked, the check is restarted.
+ *
+ * @param mem_log The log to query.
+ * @param first Output for the ID of the oldest entry in the run.
+ * @param count Output for the number of entries in the run, including dropped entries.
+ * @param readable Output for the number of readable entries in the run.
+ *
+ * @return true if the readable entries were determined or false if the log kept changing.
+ */
+static bool logging_memory_lockfree_get_committed (const struct logging_memory_lockfree *mem_log,
+	uint32_t *first, uint32_t *count, uint32_t *readable)
+{
+	uint32_t entry_id;
+	uint32_t range;
+	uint32_t current;
+	int retries;
+
+	for (retries = 0; retries < LOGGING_MEMORY_LOCKFREE_MAX_RETRIES; retries++) {
+		range = logging_memory_lockfree_get_range (mem_log, first);
+		entry_id = *first;
+		*readable = 0;
+
+		for (*count = 0; *count < range; (*count)++, entry_id++) {
+			current = platform_atomic_load (&mem_log->sequence[entry_id % mem_log->entry_count]);
+			if (current == LOGGING_MEMORY_LOCKFREE_SEQUENCE (entry_id)) {
+				(*readable)++;
+			}
+			else if (!logging_memory_lockfree_is_skipped (current, entry_id)) {
+				break;
+			}
+		}
+
+		/* The run of complete entries ends at the first entry that has not been written or is still
+		 * being written.  If the slot already holds a newer entry, the log wrapped around. */
+		if ((*count == range) ||
+			((int32_t) (current - LOGGING_MEMORY_LOCKFREE_SEQUENCE (entry_id)) <=
+				LOGGING_MEMORY_LOCKFREE_FLAGS)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+int logging_memory_lockfree_get_size (const struct logging *logging)
+{
+	const struct logging_memory_lockfree *mem_log = (const struct logging_memory_lockfree*) logging;
+	uint32_t first;
+	uint32_t count;
+	uint32_t readable;
+
+	if (mem_log == NULL) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	if (!logging_memory_lockfree_get_committed (mem_log, &first, &count, &readable)) {
+		return LOGGING_GET_SIZE_FAILED;
+	}
+
+	return readable * mem_log->entry_size;
+}
+
+int logging_memory_lockfree_read_contents (const struct logging *logging, uint32_t offset,
+	uint8_t *contents, size_t length)
+{
+	const struct logging_memory_lockfree *mem_log = (const struct logging_memory_lockfree*) logging;
+	volatile uint32_t *sequence;
+	uint32_t current;
+	uint32_t expected;
+	uint32_t entry_id;
+	uint32_t first;
+	uint32_t count;
+	uint32_t readable;
+	uint32_t skip;
+	size_t entry_offset;
+	size_t copy_len;
+	size_t bytes_read;
+	int retries = 0;
+
+	if ((mem_log == NULL) || (contents == NULL)) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+retry:
+	if ((retries++ == LOGGING_MEMORY_LOCKFREE_MAX_RETRIES) ||
+		!logging_memory_lockfree_get_committed (mem_log, &first, &count, &readable)) {
+		return LOGGING_READ_CONTENTS_FAILED;
+	}
+
+	bytes_read = 0;
+	skip = offset / mem_log->entry_size;
+	entry_offset = offset % mem_log->entry_size;
+
+	for (entry_id = first; ((entry_id - first) < count) && (bytes_read < length); entry_id++) {
+		sequence = &mem_log->sequence[entry_id % mem_log->entry_count];
+		expected = LOGGING_MEMORY_LOCKFREE_SEQUENCE (entry_id);
+
+		/* Dropped entries don't take up any space in the log contents.  If the slot no longer
+		 * holds the same entry, the log wrapped around during the read. */
+		current = platform_atomic_load (sequence);
+		if (logging_memory_lockfree_is_skipped (current, entry_id)) {
+			continue;
+		}
+		else if (current != expected) {
+			goto retry;
+		}
+
+		if (skip != 0) {
+			skip--;
+			continue;
+		}
+
+		copy_len = mem_log->entry_size - entry_offset;
+		if (copy_len > (length - bytes_read)) {
+			copy_len = length - bytes_read;
+		}
+
+		memcpy (&contents[bytes_read],
+			&mem_log->log_buffer[((entry_id % mem_log->entry_count) * mem_log->entry_size) +
+				entry_offset], copy_len);
+
+		/* If the entry was replaced while it was being copied, the log wrapped around during the
+		 * read.  Start over to get a consistent view of the log. */
+		if (!platform_atomic_compare_exchange (sequence, expected, expected)) {
+			goto retry;
+		}
+
+		bytes_read += copy_len;
+		entry_offset = 0;
+	}
+
+	return bytes_read;
+}
+
+/**
+ * Initialize a lock-free log that stores contents in volatile memory.  The memory for the log will
+ * be dynamically allocated to the necessary size.
+ *
+ * @param logging The log to initialize.
+ * @param state Variable context for the log.  This must be uninitialized.
+ * @param entry_count The maximum number of entries the log should be able to hold.
+ * @param entry_length The length of a single log entry.  This does not include the length of
+ * standard logging overhead.
+ *
+ * @return 0 if the log was successfully initialized or an error code.
+ */
+int logging_memory_lockfree_init (struct logging_memory_lockfree *logging,
+	struct logging_memory_lockfree_state *state, size_t entry_count, size_t entry_length)
+{
+	size_t entry_size = entry_length + sizeof (struct logging_entry_header);
+	size_t log_size = entry_size * entry_count;
+	uint8_t *log_buffer;
+	uint32_t *sequence;
+	int status;
+
+	if ((logging == NULL) || (state == NULL) || (entry_count == 0) || (entry_length == 0)) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	log_buffer = platform_malloc (log_size);
+	if (log_buffer == NULL) {
+		return LOGGING_NO_MEMORY;
+	}
+
+	sequence = platform_malloc (sizeof (uint32_t) * entry_count);
+	if (sequence == NULL) {
+		platform_free (log_buffer);
+		return LOGGING_NO_MEMORY;
+	}
+
+	status = logging_memory_lockfree_init_from_buffer (logging, state, log_buffer, log_size,
+		sequence, entry_length);
+	if (status == 0) {
+		logging->alloc_buffer = true;
+	}
+	else {
+		platform_free (log_buffer);
+		platform_free (sequence);
+	}
+
+	return status;
+}
+
+/**
+ * Initialize a lock-free log that stores contents in volatile memory.  The memory for the log will
+ * be preallocated by the caller and not managed by the log instance.
+ *
+ * If the provided buffer is not aligned to the size of the entry, including the logging header,
+ * the usable buffer will be truncated to generate this alignment.
+ *
+ * @param logging The log to initialize.
+ * @param state Variable context for the log.  This must be uninitialized.
+ * @param log_buffer The buffer to use for log entries.
+ * @param log_size Length of the provided log buffer.
+ * @param sequence Storage for the sequence number of each entry.  This must have enough space for
+ * every entry that fits in the log buffer.
+ * @param entry_length The length of a single log entry.  This does not include the length of
+ * standard logging overhead.
+ *
+ * @return 0 if the log was successfully initialized or an error code.
+ */
+int logging_memory_lockfree_init_from_buffer (struct logging_memory_lockfree *logging,
+	struct logging_memory_lockfree_state *state, uint8_t *log_buffer, size_t log_size,
+	volatile uint32_t *sequence, size_t entry_length)
+{
+	size_t entry_size = entry_length + sizeof (struct logging_entry_header);
+
+	if ((logging == NULL) || (state == NULL) || (log_buffer == NULL) || (sequence == NULL) ||
+		(entry_length == 0)) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	memset (logging, 0, sizeof (struct logging_memory_lockfree));
+
+	logging->log_buffer = log_buffer;
+	logging->sequence = sequence;
+	logging->entry_count = log_size / entry_size;
+	logging->entry_size = entry_size;
+
+	logging->base.create_entry = logging_memory_lockfree_create_entry;
+#ifndef LOGGING_DISABLE_FLUSH
+	logging->base.flush = logging_memory_lockfree_flush;
+#endif
+	logging->base.clear = logging_memory_lockfree_clear;
+	logging->base.get_size = logging_memory_lockfree_get_size;
+	logging->base.read_contents = logging_memory_lockfree_read_contents;
+
+	logging->state = state;
+
+	return logging_memory_lockfree_init_state (logging);
+}
+
+/**
+ * Initialize only the variable state for a lock-free log in memory.  The rest of the log instance
+ * is assumed to have already been initialized.
+ *
+ * This would generally be used with a statically initialized instance.
+ *
+ * @param logging The log instance that contains the state to initialize.
+ *
+ * @return 0 if the state was successfully initialized or an error code.
+ */
+int logging_memory_lockfree_init_state (const struct logging_memory_lockfree *logging)
+{
+	size_t i;
+
+	if ((logging == NULL) || (logging->state == NULL) || (logging->log_buffer == NULL) ||
+		(logging->sequence == NULL)) {
+		return LOGGING_INVALID_ARGUMENT;
+	}
+
+	if (logging->entry_count == 0) {
+		return LOGGING_INSUFFICIENT_STORAGE;
+	}
+
+	memset (logging->state, 0, sizeof (struct logging_memory_lockfree_state));
+
+	for (i = 0; i < logging->entry_count; i++) {
+		logging->sequence[i] = 0;
+	}
+
+	return 0;
+}
+
+/**
+ * Release the resources used by a lock-free log in memory.
+ *
+ * @param logging The log to release.
+ */
+void logging_memory_lockfree_release (struct logging_memory_lockfree *logging)
+{
+	if (logging && logging->alloc_buffer) {
+		platform_free (logging->log_buffer);
+		platform_free ((void*) logging->sequence);
+	}
+}
+
+/**
+ * Get the number of entries that were discarded because the log wrapped around while an older
+ * entry in the same location was still being written.  A non-zero count indicates the log is too
+ * small for the rate at which entries are being added.
+ *
+ * @param logging The log to query.
+ *
+ * @return The number of discarded entries.
+ */
+uint32_t logging_memory_lockfree_get_dropped_count (const struct logging_memory_lockfree *logging)
+{
+	if (logging == NULL) {
+		return 0;
+	}
+
+	return platform_atomic_load (&logging->state->dropped);
+}
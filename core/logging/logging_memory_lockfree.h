@@ -0,0 +1,60 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef LOGGING_MEMORY_LOCKFREE_H_
+#define LOGGING_MEMORY_LOCKFREE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "logging.h"
+#include "platform_api.h"
+
+
+/**
+ * Variable context for a lock-free log that stores data in volatile memory.
+ */
+struct logging_memory_lockfree_state {
+	volatile uint32_t next_entry_id;			/**< Next ID to assign to a log entry. */
+	volatile uint32_t first_entry_id;			/**< ID of the oldest entry that has not been cleared. */
+	volatile uint32_t dropped;					/**< Number of entries discarded due to a full log. */
+};
+
+/**
+ * A log that will store entries in volatile memory without using any locks.
+ *
+ * Each new entry is assigned the next entry ID, which determines the slot in the log buffer that
+ * will hold the entry.  Every slot has a sequence number that indicates which entry it contains and
+ * whether that entry is being written.  Any number of tasks can add entries at the same time.
+ * Readers use the sequence numbers to only return complete entries and to detect entries that were
+ * overwritten while being read.  Only the complete entries up to the oldest entry still being
+ * written are readable, so the offset of an entry does not change when an older entry completes.
+ *
+ * If the log wraps around completely while an entry is still being written, the new entry for the
+ * same slot will be discarded rather than waiting for the slot to become available.  The slot is
+ * marked to indicate the new entry was discarded, so readers skip over it instead of hiding all
+ * newer entries.
+ */
+struct logging_memory_lockfree {
+	struct logging base;						/**< The base logging instance. */
+	struct logging_memory_lockfree_state *state;	/**< Variable context for the log instance. */
+	uint8_t *log_buffer;						/**< The buffer used for log entries. */
+	volatile uint32_t *sequence;				/**< Sequence number for each entry in the log. */
+	size_t entry_count;							/**< The maximum number of entries in the log. */
+	size_t entry_size;							/**< The length of a single log entry. */
+	bool alloc_buffer;							/**< Flag indicating if the buffers were allocated by the log. */
+};
+
+
+int logging_memory_lockfree_init (struct logging_memory_lockfree *logging,
+	struct logging_memory_lockfree_state *state, size_t entry_count, size_t entry_length);
+int logging_memory_lockfree_init_from_buffer (struct logging_memory_lockfree *logging,
+	struct logging_memory_lockfree_state *state, uint8_t *log_buffer, size_t log_size,
+	volatile uint32_t *sequence, size_t entry_length);
+int logging_memory_lockfree_init_state (const struct logging_memory_lockfree *logging);
+void logging_memory_lockfree_release (struct logging_memory_lockfree *logging);
+
+uint32_t logging_memory_lockfree_get_dropped_count (const struct logging_memory_lockfree *logging);
+
+
+#endif /* LOGGING_MEMORY_LOCKFREE_H_ */
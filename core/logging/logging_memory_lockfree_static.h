@@ -0,0 +1,66 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef LOGGING_MEMORY_LOCKFREE_STATIC_H_
+#define LOGGING_MEMORY_LOCKFREE_STATIC_H_
+
+#include "logging/logging_memory_lockfree.h"
+
+
+/* Internal functions declared to allow for static initialization. */
+int logging_memory_lockfree_create_entry (const struct logging *logging, uint8_t *entry,
+	size_t length);
+int logging_memory_lockfree_flush (const struct logging *logging);
+int logging_memory_lockfree_clear (const struct logging *logging);
+int logging_memory_lockfree_get_size (const struct logging *logging);
+int logging_memory_lockfree_read_contents (const struct logging *logging, uint32_t offset,
+	uint8_t *contents, size_t length);
+
+
+/**
+ * Constant initializer for the flush operation.
+ */
+#ifndef LOGGING_DISABLE_FLUSH
+#define	LOGGING_MEMORY_LOCKFREE_FLUSH_API	.flush = logging_memory_lockfree_flush,
+#else
+#define	LOGGING_MEMORY_LOCKFREE_FLUSH_API
+#endif
+
+/**
+ * Constant initializer for the logging API.
+ */
+#define	LOGGING_MEMORY_LOCKFREE_API_INIT  { \
+		.create_entry = logging_memory_lockfree_create_entry, \
+		LOGGING_MEMORY_LOCKFREE_FLUSH_API \
+		.clear = logging_memory_lockfree_clear, \
+		.get_size = logging_memory_lockfree_get_size, \
+		.read_contents = logging_memory_lockfree_read_contents \
+	}
+
+
+/**
+ * Initialize a static instance of a lock-free log that uses volatile memory.  This does not
+ * initialize the log state.  This can be a constant instance.
+ *
+ * There is no validation done on the arguments.
+ *
+ * @param state_ptr Variable context for the log.
+ * @param buffer_ptr The buffer to use for log entries.
+ * @param buffer_len Length of the provided log buffer.
+ * @param sequence_ptr Storage for the sequence number of each entry.
+ * @param entry_len The length of a single log entry.  This does not include the length of standard
+ * logging overhead.
+ */
+#define	logging_memory_lockfree_static_init(state_ptr, buffer_ptr, buffer_len, sequence_ptr, \
+	entry_len)	{ \
+		.base = LOGGING_MEMORY_LOCKFREE_API_INIT, \
+		.state = state_ptr, \
+		.log_buffer = buffer_ptr, \
+		.sequence = sequence_ptr, \
+		.entry_count = buffer_len / (entry_len + sizeof (struct logging_entry_header)), \
+		.entry_size = entry_len + sizeof (struct logging_entry_header), \
+		.alloc_buffer = false \
+	}
+
+
+#endif /* LOGGING_MEMORY_LOCKFREE_STATIC_H_ */
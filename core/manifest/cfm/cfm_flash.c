@@ -463,9 +463,7 @@ static int cfm_flash_get_component_pmr (struct cfm *cfm, uint32_t component_id,
  */
 static void cfm_flash_free_cfm_digests (struct cfm_flash *cfm_flash, struct cfm_digests *digests)
 {
-	UNUSED (cfm_flash);
-
-	platform_free ((void*) digests->digests);
+	object_pool_release_or_free (cfm_flash->digests_pool, (void*) digests->digests);
 	digests->digests = NULL;
 }
 
@@ -519,7 +517,7 @@ static int cfm_flash_populate_digests (struct cfm_flash *cfm_flash, struct cfm_d
 
 	digests_len = hash_len * digest_count;
 
-	digests->digests = platform_malloc (digests_len);
+	digests->digests = object_pool_acquire_or_allocate (cfm_flash->digests_pool, digests_len);
 	if (digests->digests == NULL) {
 		return CFM_NO_MEMORY;
 	}
@@ -606,7 +604,8 @@ static int cfm_flash_populate_allowable_digests (struct cfm_flash *cfm_flash,
 		offset += sizeof (struct cfm_allowable_digest_element);
 
 		// Allocate space for digests list
-		curr_allowable_digest->digests.digests = platform_malloc (digests_len);
+		curr_allowable_digest->digests.digests =
+			object_pool_acquire_or_allocate (cfm_flash->digests_pool, digests_len);
 		if (curr_allowable_digest->digests.digests == NULL) {
 			return CFM_NO_MEMORY;
 		}
@@ -1474,6 +1473,30 @@ int cfm_flash_init (struct cfm_flash *cfm, const struct flash *flash, struct has
 	return 0;
 }
 
+/**
+ * Provide a pool of buffers to use for digest lists read from the CFM.  Without a pool, every digest
+ * list is allocated from the heap.  Digest lists larger than the pool slot size, or requested when
+ * the pool is empty, will still be allocated from the heap.
+ *
+ * This must be called before any digest lists are retrieved from the CFM.
+ *
+ * @param cfm The CFM instance to update.
+ * @param digests_pool The pool to use for digest lists.  Set to null to always allocate from the
+ * heap.
+ *
+ * @return 0 if the pool was set successfully or an error code.
+ */
+int cfm_flash_set_digests_pool (struct cfm_flash *cfm, const struct object_pool *digests_pool)
+{
+	if (cfm == NULL) {
+		return CFM_INVALID_ARGUMENT;
+	}
+
+	cfm->digests_pool = digests_pool;
+
+	return 0;
+}
+
 /**
  * Release the resources used by the CFM interface.
  *
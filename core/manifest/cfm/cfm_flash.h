@@ -8,6 +8,7 @@
 #include "cfm.h"
 #include "manifest/manifest_flash.h"
 #include "flash/flash.h"
+#include "memory_mgmt/object_pool.h"
 
 
 /**
@@ -16,6 +17,7 @@
 struct cfm_flash {
 	struct cfm base;							/**< The base CFM instance. */
 	struct manifest_flash base_flash;			/**< The base CFM flash instance. */
+	const struct object_pool *digests_pool;		/**< Optional pool for digest lists. */
 };
 
 
@@ -24,5 +26,7 @@ int cfm_flash_init (struct cfm_flash *cfm, const struct flash *flash, struct has
 	size_t max_platform_id);
 void cfm_flash_release (struct cfm_flash *cfm);
 
+int cfm_flash_set_digests_pool (struct cfm_flash *cfm, const struct object_pool *digests_pool);
+
 
 #endif //CFM_FLASH_H
@@ -114,6 +114,38 @@ void manifest_flash_release (struct manifest_flash *manifest)
 	}
 }
 
+/**
+ * Enable saving the intermediate hash of the manifest table of contents.  Element reads that use the
+ * hash engine for the manifest will save the TOC hash state before the first entry that is read.
+ * Subsequent reads starting at the same or a later entry will resume from the saved state instead
+ * of hashing all preceding TOC data again.
+ *
+ * This has no effect if the hash engine for the manifest does not support saving hash state.
+ *
+ * The saved state is only accessed while the manifest hash engine is in use for an element read.
+ * If the manifest will be read from multiple tasks, the manifest hash engine must be thread-safe
+ * and hold exclusive access from the start of a hash until it is finished, as provided by
+ * hash_thread_safe.
+ *
+ * @param manifest The manifest to update.
+ * @param state Storage for the saved TOC hash state.  This must remain valid for the lifetime of
+ * the manifest and must not be shared with other manifests.
+ *
+ * @return 0 if saving the TOC hash state was enabled or an error code.
+ */
+int manifest_flash_enable_toc_hash_state (struct manifest_flash *manifest,
+	struct hash_saved_state *state)
+{
+	if ((manifest == NULL) || (state == NULL)) {
+		return MANIFEST_INVALID_ARGUMENT;
+	}
+
+	manifest->toc_state = state;
+	manifest->toc_state_valid = false;
+
+	return 0;
+}
+
 /**
  * Read the manifest header and run validity checking on the contents:
  * - Check the magic number.
@@ -389,6 +421,7 @@ int manifest_flash_verify (struct manifest_flash *manifest, struct hash_engine *
 
 	manifest->manifest_valid = false;
 	manifest->cache_valid = false;
+	manifest->toc_state_valid = false;
 	if (hash_out != NULL) {
 		/* Clear the output hash buffer to indicate no hash was calculated. */
 		memset (hash_out, 0, hash_length);
@@ -634,6 +667,89 @@ int manifest_flash_get_signature (struct manifest_flash *manifest, uint8_t *sign
 	}
 }
 
+/**
+ * Start a hash of the manifest table of contents and hash all TOC data before a specified entry.
+ *
+ * If saving the TOC hash state has been enabled and the hash engine for the manifest is being used,
+ * the TOC hash state at the requested entry will be saved.  Later requests for the same or a
+ * subsequent entry will resume from the saved state rather than hashing the preceding TOC data
+ * again.
+ *
+ * @param manifest The manifest being read.
+ * @param hash The hash engine to use for TOC validation.
+ * @param entry Index of the first TOC entry that should not be included in the hash.
+ *
+ * @return 0 if the TOC hash was started successfully or an error code.  The hash will be canceled
+ * on failure.
+ */
+static int manifest_flash_start_toc_hash (struct manifest_flash *manifest,
+	struct hash_engine *hash, int entry)
+{
+	uint32_t entry_addr;
+	int hashed = 0;
+	bool resumed = false;
+	int status;
+
+	entry_addr = manifest->addr + sizeof (struct manifest_header) +
+		sizeof (struct manifest_toc_header);
+
+	if ((hash == manifest->hash) && manifest->toc_state_valid &&
+		(entry >= manifest->toc_state_entry)) {
+		/* A failed save from another request can leave incomplete state, so a failure to restore
+		 * the state is not an error.  The TOC will be hashed from the beginning instead. */
+		status = hash->restore_state (hash, manifest->toc_state);
+		if (status == 0) {
+			/* Check the saved state again now that the hash engine is held by this request, since
+			 * another request could have saved a new state or failed to save one. */
+			hashed = manifest->toc_state_entry;
+			if (manifest->toc_state_valid && (entry >= hashed)) {
+				resumed = true;
+			}
+			else {
+				hash->cancel (hash);
+				hashed = 0;
+			}
+		}
+	}
+
+	if (!resumed) {
+		status = hash_start_new_hash (hash, manifest->toc_hash_type);
+		if (status != 0) {
+			return status;
+		}
+
+		status = hash->update (hash, (uint8_t*) &manifest->toc_header,
+			sizeof (struct manifest_toc_header));
+		if (status != 0) {
+			goto error;
+		}
+	}
+
+	status = flash_hash_update_contents (manifest->flash,
+		entry_addr + (sizeof (struct manifest_toc_entry) * hashed),
+		sizeof (struct manifest_toc_entry) * (entry - hashed), hash);
+	if (status != 0) {
+		goto error;
+	}
+
+	if ((manifest->toc_state != NULL) && (hash == manifest->hash) &&
+		hash_is_save_state_supported (hash) &&
+		!(manifest->toc_state_valid && (entry == manifest->toc_state_entry))) {
+		/* Failing to save the state doesn't prevent the TOC from being validated. */
+		manifest->toc_state_valid = false;
+		if (hash->save_state (hash, manifest->toc_state) == 0) {
+			manifest->toc_state_entry = entry;
+			manifest->toc_state_valid = true;
+		}
+	}
+
+	return 0;
+
+error:
+	hash->cancel (hash);
+	return status;
+}
+
 /**
  * Find the first element of a specified type in the manifest and read the element data.
  * Everything about the operation will be validated, as appropriate.  This includes table of
@@ -693,22 +809,11 @@ int manifest_flash_read_element_data (struct manifest_flash *manifest, struct ha
 	toc_end = hash_addr + (manifest->toc_hash_length * manifest->toc_header.hash_count);
 
 	/* Start hashing to verify the TOC contents. */
-	status = hash_start_new_hash (hash, manifest->toc_hash_type);
+	status = manifest_flash_start_toc_hash (manifest, hash, start);
 	if (status != 0) {
 		return status;
 	}
 
-	status = hash->update (hash, (uint8_t*) &manifest->toc_header, sizeof (manifest->toc_header));
-	if (status != 0) {
-		goto error;
-	}
-
-	/* Hash the TOC data before the first entry that will be read. */
-	status = flash_hash_update_contents (manifest->flash, entry_addr, sizeof (entry) * start, hash);
-	if (status != 0) {
-		goto error;
-	}
-
 	/* Find the TOC entry for the requested element. */
 	entry_addr += sizeof (entry) * start;
 	i = start;
@@ -941,24 +1046,11 @@ int manifest_flash_get_child_elements_info (struct manifest_flash *manifest,
 		manifest->toc_header.entry_count);
 
 	/* Start hashing to verify the TOC contents. */
-	status = hash_start_new_hash (hash, manifest->toc_hash_type);
+	status = manifest_flash_start_toc_hash (manifest, hash, entry);
 	if (status != 0) {
 		return status;
 	}
 
-	status = hash->update (hash, (uint8_t*) &manifest->toc_header,
-		sizeof (struct manifest_toc_header));
-	if (status != 0) {
-		goto error;
-	}
-
-	/* Hash the TOC data before the first entry that will be read. */
-	status = flash_hash_update_contents (manifest->flash, entry_addr,
-		sizeof (struct manifest_toc_entry) * entry, hash);
-	if (status != 0) {
-		goto error;
-	}
-
 	entry_addr += (sizeof (struct manifest_toc_entry) * entry);
 
 	for (; entry < manifest->toc_header.entry_count;
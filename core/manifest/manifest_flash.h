@@ -39,6 +39,9 @@ struct manifest_flash {
 	bool cache_valid;							/**< Flag indicating if the cached hash is valid. */
 	bool free_signature;						/**< Flag indicating the signature buffer should be freed. */
 	bool manifest_valid;						/**< Flag indicating there is a validated manifest. */
+	struct hash_saved_state *toc_state;			/**< Optional storage for the saved TOC hash state. */
+	int toc_state_entry;						/**< The TOC entry where the hash state was saved. */
+	bool toc_state_valid;						/**< Flag indicating the saved TOC hash state is valid. */
 };
 
 
@@ -50,6 +53,9 @@ int manifest_flash_v2_init (struct manifest_flash *manifest, const struct flash
 	size_t max_platform_id);
 void manifest_flash_release (struct manifest_flash *manifest);
 
+int manifest_flash_enable_toc_hash_state (struct manifest_flash *manifest,
+	struct hash_saved_state *state);
+
 int manifest_flash_read_header (struct manifest_flash *manifest, struct manifest_header *header);
 
 int manifest_flash_verify (struct manifest_flash *manifest, struct hash_engine *hash,
@@ -108,6 +108,10 @@ int mctp_interface_set_channel_id (struct mctp_interface *mctp, int channel_id)
 /**
  * Generate packets for full MCTP message from payload
  *
+ * Packets are written back to back in the output buffer.  Every packet except the last is
+ * max_packet_len bytes, so the buffer can be passed directly to a command channel as a single
+ * message.
+ *
  * @param device_mgr Device manager instance to utilize
  * @param payload Buffer with payload bytes
  * @param payload_len Length of payload bytes
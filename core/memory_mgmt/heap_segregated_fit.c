@@ -0,0 +1,757 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdbool.h>
+#include <string.h>
+#include "platform_api.h"
+#include "common/common_math.h"
+#include "heap_segregated_fit.h"
+
+
+/**
+ * Flag in the block size indicating the block is allocated.
+ */
+#define	HEAP_SEGREGATED_FIT_BLOCK_USED				0x1
+
+/**
+ * Mask for the block flags stored in the block size.
+ */
+#define	HEAP_SEGREGATED_FIT_BLOCK_FLAGS				(HEAP_SEGREGATED_FIT_ALIGNMENT - 1)
+
+/**
+ * Alignment of blocks, expressed as a power of 2.
+ */
+#define	HEAP_SEGREGATED_FIT_ALIGNMENT_LOG2			((HEAP_SEGREGATED_FIT_ALIGNMENT == 8) ? 3 : 2)
+
+/**
+ * Number of second-level size classes in each first-level class.
+ */
+#define	HEAP_SEGREGATED_FIT_SL_INDEX_COUNT			(1U << HEAP_SEGREGATED_FIT_SL_INDEX_COUNT_LOG2)
+
+/**
+ * Shift applied to block sizes to determine the first-level class.  All blocks smaller than
+ * 1 << HEAP_SEGREGATED_FIT_FL_INDEX_SHIFT are in the first first-level class and are binned
+ * linearly by size.
+ */
+#define	HEAP_SEGREGATED_FIT_FL_INDEX_SHIFT			\
+	(HEAP_SEGREGATED_FIT_SL_INDEX_COUNT_LOG2 + HEAP_SEGREGATED_FIT_ALIGNMENT_LOG2)
+
+/**
+ * Number of first-level size classes.
+ */
+#define	HEAP_SEGREGATED_FIT_FL_INDEX_COUNT			\
+	(HEAP_SEGREGATED_FIT_MAX_BLOCK_SIZE_LOG2 - HEAP_SEGREGATED_FIT_FL_INDEX_SHIFT + 1)
+
+/**
+ * Size of the blocks that are binned linearly instead of logarithmically.
+ */
+#define	HEAP_SEGREGATED_FIT_SMALL_BLOCK_SIZE		(1U << HEAP_SEGREGATED_FIT_FL_INDEX_SHIFT)
+
+/**
+ * Largest block size that can be tracked by the allocator.
+ */
+#define	HEAP_SEGREGATED_FIT_MAX_BLOCK_SIZE			\
+	((((size_t) 1) << HEAP_SEGREGATED_FIT_MAX_BLOCK_SIZE_LOG2) - 1)
+
+/**
+ * Get address of block contents from block header address.
+ *
+ * @param ptr Pointer to block header of type struct heap_segregated_fit_block
+ */
+#define HEAP_SEGREGATED_FIT_BLOCK_CONTENTS(ptr)		\
+	(((uint8_t*) ptr) + HEAP_SEGREGATED_FIT_BLOCK_HEADER_LEN)
+
+/**
+ * Get the usable size of a block, without any flags.
+ *
+ * @param ptr Pointer to block header of type struct heap_segregated_fit_block
+ */
+#define	HEAP_SEGREGATED_FIT_BLOCK_SIZE(ptr)			((ptr)->size & ~HEAP_SEGREGATED_FIT_BLOCK_FLAGS)
+
+/**
+ * Check if a block is currently allocated.
+ *
+ * @param ptr Pointer to block header of type struct heap_segregated_fit_block
+ */
+#define	HEAP_SEGREGATED_FIT_BLOCK_IS_USED(ptr)		((ptr)->size & HEAP_SEGREGATED_FIT_BLOCK_USED)
+
+/**
+ * Get the block physically after a block in memory.
+ *
+ * @param ptr Pointer to block header of type struct heap_segregated_fit_block
+ */
+#define HEAP_SEGREGATED_FIT_BLOCK_NEXT(ptr)			\
+	((struct heap_segregated_fit_block*) (HEAP_SEGREGATED_FIT_BLOCK_CONTENTS (ptr) + \
+		HEAP_SEGREGATED_FIT_BLOCK_SIZE (ptr)))
+
+/**
+ * Round up input size so it meets the allocation alignment.
+ *
+ * @param size Input size
+ *
+ * @return Size rounded up to the nearest alignment boundary
+ */
+#define heap_segregated_fit_round_to_alignment(size)	\
+	(((size) + HEAP_SEGREGATED_FIT_BLOCK_FLAGS) & ~((size_t) HEAP_SEGREGATED_FIT_BLOCK_FLAGS))
+
+
+/* Bitmap of first-level size classes that have at least one free block. */
+static uint32_t fl_bitmap = 0;
+
+/* Bitmaps of second-level size classes that have at least one free block, one for each first-level
+ * class. */
+static uint32_t sl_bitmap[HEAP_SEGREGATED_FIT_FL_INDEX_COUNT];
+
+/* Heads of the free lists for each size class.  Blocks are added to and removed from the head of
+ * each list, so no list is ever traversed. */
+static struct heap_segregated_fit_block
+	*free_lists[HEAP_SEGREGATED_FIT_FL_INDEX_COUNT][HEAP_SEGREGATED_FIT_SL_INDEX_COUNT];
+
+/* First block in the heap memory. */
+static struct heap_segregated_fit_block *heap_first = NULL;
+
+/* Zero length allocated block that marks the end of the heap memory.  This prevents merging free
+ * blocks past the end of the heap. */
+static struct heap_segregated_fit_block *heap_sentinel = NULL;
+
+/* Lock for heap access when the heap has been initialized to be thread-safe. */
+static platform_mutex heap_lock;
+
+/* Flag indicating if the heap lock should be used. */
+static bool heap_lock_enabled = false;
+
+
+/**
+ * Find the index of the most significant bit set in a non-zero value.
+ *
+ * @param word The value to check.
+ *
+ * @return The bit index.
+ */
+static int heap_segregated_fit_fls (uint32_t word)
+{
+	int bit = 0;
+
+	if (word & 0xffff0000) {
+		word >>= 16;
+		bit += 16;
+	}
+	if (word & 0xff00) {
+		word >>= 8;
+		bit += 8;
+	}
+	if (word & 0xf0) {
+		word >>= 4;
+		bit += 4;
+	}
+	if (word & 0xc) {
+		word >>= 2;
+		bit += 2;
+	}
+	if (word & 0x2) {
+		bit += 1;
+	}
+
+	return bit;
+}
+
+/**
+ * Find the index of the least significant bit set in a non-zero value.
+ *
+ * @param word The value to check.
+ *
+ * @return The bit index.
+ */
+static int heap_segregated_fit_ffs (uint32_t word)
+{
+	return heap_segregated_fit_fls (word & (~word + 1));
+}
+
+/**
+ * Determine the size class that contains blocks of a specific size.
+ *
+ * @param size The block size.
+ * @param fl Output for the first-level index.
+ * @param sl Output for the second-level index.
+ */
+static void heap_segregated_fit_mapping_insert (size_t size, int *fl, int *sl)
+{
+	if (size < HEAP_SEGREGATED_FIT_SMALL_BLOCK_SIZE) {
+		*fl = 0;
+		*sl = size >> HEAP_SEGREGATED_FIT_ALIGNMENT_LOG2;
+	}
+	else {
+		int msb = heap_segregated_fit_fls (size);
+
+		*sl = (size >> (msb - HEAP_SEGREGATED_FIT_SL_INDEX_COUNT_LOG2)) ^
+			HEAP_SEGREGATED_FIT_SL_INDEX_COUNT;
+		*fl = msb - HEAP_SEGREGATED_FIT_FL_INDEX_SHIFT + 1;
+	}
+}
+
+/**
+ * Determine the smallest size class where every block is guaranteed to satisfy a request.
+ *
+ * @param size The requested block size.
+ * @param fl Output for the first-level index.
+ * @param sl Output for the second-level index.
+ */
+static void heap_segregated_fit_mapping_search (size_t size, int *fl, int *sl)
+{
+	if (size >= HEAP_SEGREGATED_FIT_SMALL_BLOCK_SIZE) {
+		size += (1U << (heap_segregated_fit_fls (size) - HEAP_SEGREGATED_FIT_SL_INDEX_COUNT_LOG2)) -
+			1;
+	}
+
+	heap_segregated_fit_mapping_insert (size, fl, sl);
+}
+
+/**
+ * Find a free block in the smallest non-empty size class at least as large as the requested class.
+ *
+ * @param fl The first-level index to start searching.  This will be updated with the class of the
+ * block that was found.
+ * @param sl The second-level index to start searching.  This will be updated with the class of the
+ * block that was found.
+ *
+ * @return The free block or null if no block is available.
+ */
+static struct heap_segregated_fit_block* heap_segregated_fit_search_suitable_block (int *fl,
+	int *sl)
+{
+	uint32_t sl_map = sl_bitmap[*fl] & (~((uint32_t) 0) << *sl);
+
+	if (sl_map == 0) {
+		uint32_t fl_map = fl_bitmap & (~((uint32_t) 0) << (*fl + 1));
+
+		if (fl_map == 0) {
+			return NULL;
+		}
+
+		*fl = heap_segregated_fit_ffs (fl_map);
+		sl_map = sl_bitmap[*fl];
+	}
+
+	*sl = heap_segregated_fit_ffs (sl_map);
+
+	return free_lists[*fl][*sl];
+}
+
+/**
+ * Add a block to the free list for its size class.
+ *
+ * @param block The free block to add.
+ */
+static void heap_segregated_fit_insert_free_block (struct heap_segregated_fit_block *block)
+{
+	int fl;
+	int sl;
+
+	heap_segregated_fit_mapping_insert (HEAP_SEGREGATED_FIT_BLOCK_SIZE (block), &fl, &sl);
+
+	block->prev_free = NULL;
+	block->next_free = free_lists[fl][sl];
+	if (block->next_free != NULL) {
+		block->next_free->prev_free = block;
+	}
+
+	free_lists[fl][sl] = block;
+	fl_bitmap |= (1U << fl);
+	sl_bitmap[fl] |= (1U << sl);
+}
+
+/**
+ * Remove a block from the free list for its size class.
+ *
+ * @param block The free block to remove.
+ */
+static void heap_segregated_fit_remove_free_block (struct heap_segregated_fit_block *block)
+{
+	int fl;
+	int sl;
+
+	heap_segregated_fit_mapping_insert (HEAP_SEGREGATED_FIT_BLOCK_SIZE (block), &fl, &sl);
+
+	if (block->prev_free != NULL) {
+		block->prev_free->next_free = block->next_free;
+	}
+	else {
+		free_lists[fl][sl] = block->next_free;
+		if (block->next_free == NULL) {
+			sl_bitmap[fl] &= ~(1U << sl);
+			if (sl_bitmap[fl] == 0) {
+				fl_bitmap &= ~(1U << fl);
+			}
+		}
+	}
+
+	if (block->next_free != NULL) {
+		block->next_free->prev_free = block->prev_free;
+	}
+
+	block->next_free = NULL;
+	block->prev_free = NULL;
+}
+
+/**
+ * Absorb the block physically following a block into it.  The next block must be free and must
+ * already have been removed from the free lists.
+ *
+ * @param block The block that will be expanded.
+ * @param next The block following it in memory.
+ */
+static void heap_segregated_fit_merge_next (struct heap_segregated_fit_block *block,
+	struct heap_segregated_fit_block *next)
+{
+	block->size += HEAP_SEGREGATED_FIT_BLOCK_SIZE (next) + HEAP_SEGREGATED_FIT_BLOCK_HEADER_LEN;
+	HEAP_SEGREGATED_FIT_BLOCK_NEXT (block)->prev_phys = block;
+
+	next->size = 0;
+	next->prev_phys = NULL;
+}
+
+/**
+ * Trim excess space from the end of an allocated block and return it to the free lists.  Nothing
+ * is done if the excess space is not large enough to create a new block.
+ *
+ * @param block The allocated block to trim.
+ * @param size The usable size the block should have after trimming.
+ */
+static void heap_segregated_fit_trim_block (struct heap_segregated_fit_block *block, size_t size)
+{
+	struct heap_segregated_fit_block *remain;
+	struct heap_segregated_fit_block *next;
+	size_t block_size = HEAP_SEGREGATED_FIT_BLOCK_SIZE (block);
+
+	if (block_size < (size + HEAP_SEGREGATED_FIT_BLOCK_HEADER_LEN +
+		HEAP_SEGREGATED_FIT_MIN_BLOCK_SIZE)) {
+		return;
+	}
+
+	remain = (struct heap_segregated_fit_block*) (HEAP_SEGREGATED_FIT_BLOCK_CONTENTS (block) + size);
+	remain->size = block_size - size - HEAP_SEGREGATED_FIT_BLOCK_HEADER_LEN;
+	remain->prev_phys = block;
+	block->size = size | HEAP_SEGREGATED_FIT_BLOCK_USED;
+
+	next = HEAP_SEGREGATED_FIT_BLOCK_NEXT (remain);
+	next->prev_phys = remain;
+
+	/* The trimmed block could be followed by a free block when shrinking a block in place. */
+	if (!HEAP_SEGREGATED_FIT_BLOCK_IS_USED (next)) {
+		heap_segregated_fit_remove_free_block (next);
+		heap_segregated_fit_merge_next (remain, next);
+	}
+
+	heap_segregated_fit_insert_free_block (remain);
+}
+
+/**
+ * Determine the block size needed to satisfy an allocation request.
+ *
+ * @param size The requested allocation size.
+ *
+ * @return The aligned block size or 0 if the request is too large.
+ */
+static size_t heap_segregated_fit_adjust_size (size_t size)
+{
+	if (size > HEAP_SEGREGATED_FIT_MAX_BLOCK_SIZE) {
+		return 0;
+	}
+
+	if (size < HEAP_SEGREGATED_FIT_MIN_BLOCK_SIZE) {
+		size = HEAP_SEGREGATED_FIT_MIN_BLOCK_SIZE;
+	}
+
+	return heap_segregated_fit_round_to_alignment (size);
+}
+
+/**
+ * Acquire the heap lock, if the heap is thread-safe.
+ */
+static void heap_segregated_fit_lock (void)
+{
+	if (heap_lock_enabled) {
+		platform_mutex_lock (&heap_lock);
+	}
+}
+
+/**
+ * Release the heap lock, if the heap is thread-safe.
+ */
+static void heap_segregated_fit_unlock (void)
+{
+	if (heap_lock_enabled) {
+		platform_mutex_unlock (&heap_lock);
+	}
+}
+
+/**
+ * Set up the heap allocator
+ *
+ * @param heap_addr Address of heap memory to utilize
+ * @param heap_len Length of heap memory.
+ *
+ * @return 0 if completed successfully, or an error code if not.
+ */
+int heap_segregated_fit_init (const void *heap_addr, size_t heap_len)
+{
+	uintptr_t start;
+	size_t offset;
+	size_t block_size;
+
+	if (heap_addr == NULL) {
+		return HEAP_SEGREGATED_FIT_INVALID_ARGUMENT;
+	}
+
+	heap_segregated_fit_release ();
+
+	/* Align the start of the heap so all block contents will be aligned. */
+	start = heap_segregated_fit_round_to_alignment ((uintptr_t) heap_addr);
+	offset = start - (uintptr_t) heap_addr;
+	if (heap_len <= (offset + (HEAP_SEGREGATED_FIT_BLOCK_HEADER_LEN * 2) +
+		HEAP_SEGREGATED_FIT_MIN_BLOCK_SIZE)) {
+		return HEAP_SEGREGATED_FIT_INVALID_ARGUMENT;
+	}
+
+	block_size = (heap_len - offset) & ~((size_t) HEAP_SEGREGATED_FIT_BLOCK_FLAGS);
+	block_size -= (HEAP_SEGREGATED_FIT_BLOCK_HEADER_LEN * 2);
+	if (block_size > HEAP_SEGREGATED_FIT_MAX_BLOCK_SIZE) {
+		return HEAP_SEGREGATED_FIT_HEAP_TOO_LARGE;
+	}
+
+	fl_bitmap = 0;
+	memset (sl_bitmap, 0, sizeof (sl_bitmap));
+	memset (free_lists, 0, sizeof (free_lists));
+
+	heap_first = (struct heap_segregated_fit_block*) start;
+	heap_first->prev_phys = NULL;
+	heap_first->size = block_size;
+
+	heap_sentinel = HEAP_SEGREGATED_FIT_BLOCK_NEXT (heap_first);
+	heap_sentinel->prev_phys = heap_first;
+	heap_sentinel->size = HEAP_SEGREGATED_FIT_BLOCK_USED;
+
+	heap_segregated_fit_insert_free_block (heap_first);
+
+	return 0;
+}
+
+/**
+ * Set up the heap allocator with a lock to allow heap access from multiple tasks.  The lock must be
+ * freed with {@link heap_segregated_fit_release} when the heap is no longer used.
+ *
+ * @param heap_addr Address of heap memory to utilize
+ * @param heap_len Length of heap memory.
+ *
+ * @return 0 if completed successfully, or an error code if not.
+ */
+int heap_segregated_fit_init_thread_safe (const void *heap_addr, size_t heap_len)
+{
+	int status;
+
+	status = heap_segregated_fit_init (heap_addr, heap_len);
+	if (status != 0) {
+		return status;
+	}
+
+	status = platform_mutex_init (&heap_lock);
+	if (status != 0) {
+		return status;
+	}
+
+	heap_lock_enabled = true;
+
+	return 0;
+}
+
+/**
+ * Release any resources used by the heap allocator.  The heap will need to be initialized again
+ * before it can be used.
+ */
+void heap_segregated_fit_release (void)
+{
+	if (heap_lock_enabled) {
+		heap_lock_enabled = false;
+		platform_mutex_free (&heap_lock);
+	}
+
+	heap_first = NULL;
+	heap_sentinel = NULL;
+}
+
+/**
+ * Allocate a block from the heap.  The heap must already be locked.
+ *
+ * @param size Size of block to allocate
+ *
+ * @return The header for the allocated block, or NULL if there is no suitable free block.
+ */
+static struct heap_segregated_fit_block* heap_segregated_fit_allocate_block (size_t size)
+{
+	struct heap_segregated_fit_block *block = NULL;
+	int fl;
+	int sl;
+
+	size = heap_segregated_fit_adjust_size (size);
+	if ((size == 0) || (heap_first == NULL)) {
+		return NULL;
+	}
+
+	heap_segregated_fit_mapping_search (size, &fl, &sl);
+	if (fl < HEAP_SEGREGATED_FIT_FL_INDEX_COUNT) {
+		block = heap_segregated_fit_search_suitable_block (&fl, &sl);
+	}
+
+	if (block == NULL) {
+		/* There are no free blocks in any size class guaranteed to fit the request, but the head
+		 * of the size class containing the requested size may still be large enough.  This is
+		 * always the case for requests that need the largest free block in the heap. */
+		heap_segregated_fit_mapping_insert (size, &fl, &sl);
+
+		block = free_lists[fl][sl];
+		if ((block == NULL) || (HEAP_SEGREGATED_FIT_BLOCK_SIZE (block) < size)) {
+			return NULL;
+		}
+	}
+
+	heap_segregated_fit_remove_free_block (block);
+	block->size |= HEAP_SEGREGATED_FIT_BLOCK_USED;
+	heap_segregated_fit_trim_block (block, size);
+
+	return block;
+}
+
+/**
+ * Free an allocated block, merging it with any free neighbors.  The heap must already be locked.
+ *
+ * @param block The block to free.
+ */
+static void heap_segregated_fit_free_block (struct heap_segregated_fit_block *block)
+{
+	struct heap_segregated_fit_block *neighbor;
+
+	block->size &= ~HEAP_SEGREGATED_FIT_BLOCK_FLAGS;
+
+	neighbor = block->prev_phys;
+	if ((neighbor != NULL) && !HEAP_SEGREGATED_FIT_BLOCK_IS_USED (neighbor)) {
+		heap_segregated_fit_remove_free_block (neighbor);
+		heap_segregated_fit_merge_next (neighbor, block);
+		block = neighbor;
+	}
+
+	neighbor = HEAP_SEGREGATED_FIT_BLOCK_NEXT (block);
+	if (!HEAP_SEGREGATED_FIT_BLOCK_IS_USED (neighbor)) {
+		heap_segregated_fit_remove_free_block (neighbor);
+		heap_segregated_fit_merge_next (block, neighbor);
+	}
+
+	heap_segregated_fit_insert_free_block (block);
+}
+
+/**
+ * Get the block header for an allocated block, if the block is valid.
+ *
+ * @param addr Address of the block contents.
+ *
+ * @return The block header or null if the address is not an allocated block in the heap.
+ */
+static struct heap_segregated_fit_block* heap_segregated_fit_get_allocated_block (void *addr)
+{
+	struct heap_segregated_fit_block *block;
+
+	if ((heap_first == NULL) || (addr == NULL) ||
+		((uint8_t*) addr < HEAP_SEGREGATED_FIT_BLOCK_CONTENTS (heap_first)) ||
+		((uint8_t*) addr > (uint8_t*) heap_sentinel) ||
+		(((uintptr_t) addr & HEAP_SEGREGATED_FIT_BLOCK_FLAGS) != 0)) {
+		return NULL;
+	}
+
+	block = heap_segregated_fit_get_block_header (addr);
+	if (!HEAP_SEGREGATED_FIT_BLOCK_IS_USED (block)) {
+		return NULL;
+	}
+
+	return block;
+}
+
+/**
+ * Allocate memory of requested size
+ *
+ * @param size Size of block to allocate
+ *
+ * @return pointer to memory location allocated of at least requested size, or NULL if it fails
+ */
+void* heap_segregated_fit_allocate (size_t size)
+{
+	struct heap_segregated_fit_block *block;
+
+	heap_segregated_fit_lock ();
+	block = heap_segregated_fit_allocate_block (size);
+	heap_segregated_fit_unlock ();
+
+	return (block != NULL) ? HEAP_SEGREGATED_FIT_BLOCK_CONTENTS (block) : NULL;
+}
+
+/**
+ * Allocate then zeroize memory of requested size
+ *
+ * @param num_items Number of elements to allocate
+ * @param size Size each element to allocate
+ *
+ * @return pointer to memory location allocated of at least requested size, or NULL if it fails
+ */
+void* heap_segregated_fit_allocate_zeroize (size_t num_items, size_t size)
+{
+	size_t total_size = num_items * size;
+	void *block;
+
+	if ((size != 0) && ((total_size / size) != num_items)) {
+		return NULL;
+	}
+
+	block = heap_segregated_fit_allocate (total_size);
+	if (block != NULL) {
+		memset (block, 0, total_size);
+	}
+
+	return block;
+}
+
+/**
+ * Resize a previously allocated block while preserving contents up to new size.  Blocks are
+ * resized in place when possible.
+ *
+ * @param addr Pointer to previously allocated block, or NULL to allocate new block
+ * @param size Size of new block to allocate.
+ *
+ * @return pointer to memory location allocated of at least requested size, or NULL if it fails
+ */
+void* heap_segregated_fit_reallocate (void *addr, size_t size)
+{
+	struct heap_segregated_fit_block *block;
+	struct heap_segregated_fit_block *next;
+	struct heap_segregated_fit_block *new_block;
+	size_t adjusted;
+	size_t old_size;
+
+	if (addr == NULL) {
+		return heap_segregated_fit_allocate (size);
+	}
+
+	adjusted = heap_segregated_fit_adjust_size (size);
+	if (adjusted == 0) {
+		return NULL;
+	}
+
+	heap_segregated_fit_lock ();
+
+	block = heap_segregated_fit_get_allocated_block (addr);
+	if (block == NULL) {
+		heap_segregated_fit_unlock ();
+		return NULL;
+	}
+
+	old_size = HEAP_SEGREGATED_FIT_BLOCK_SIZE (block);
+	if (adjusted > old_size) {
+		/* Try to grow the block into the following free block before moving it. */
+		next = HEAP_SEGREGATED_FIT_BLOCK_NEXT (block);
+		if (!HEAP_SEGREGATED_FIT_BLOCK_IS_USED (next) &&
+			((old_size + HEAP_SEGREGATED_FIT_BLOCK_HEADER_LEN +
+				HEAP_SEGREGATED_FIT_BLOCK_SIZE (next)) >= adjusted)) {
+			heap_segregated_fit_remove_free_block (next);
+			heap_segregated_fit_merge_next (block, next);
+		}
+		else {
+			new_block = heap_segregated_fit_allocate_block (size);
+			if (new_block == NULL) {
+				heap_segregated_fit_unlock ();
+				return NULL;
+			}
+
+			memcpy (HEAP_SEGREGATED_FIT_BLOCK_CONTENTS (new_block), addr, min (size, old_size));
+			heap_segregated_fit_free_block (block);
+
+			heap_segregated_fit_unlock ();
+			return HEAP_SEGREGATED_FIT_BLOCK_CONTENTS (new_block);
+		}
+	}
+
+	heap_segregated_fit_trim_block (block, adjusted);
+
+	heap_segregated_fit_unlock ();
+	return addr;
+}
+
+/**
+ * Free allocated block
+ *
+ * @param addr Address of allocated block to free
+ */
+void heap_segregated_fit_free (void *addr)
+{
+	struct heap_segregated_fit_block *block;
+
+	if (addr == NULL) {
+		return;
+	}
+
+	heap_segregated_fit_lock ();
+
+	block = heap_segregated_fit_get_allocated_block (addr);
+	if (block != NULL) {
+		heap_segregated_fit_free_block (block);
+	}
+
+	heap_segregated_fit_unlock ();
+}
+
+/**
+ * Get heap allocator statistics
+ *
+ * @param stats Container to fill up with statistics
+ *
+ * @return 0 if completed successfully, or an error code if not.
+ */
+int heap_segregated_fit_get_stats (struct heap_segregated_fit_stats *stats)
+{
+	struct heap_segregated_fit_block *runner;
+	size_t size;
+
+	if (stats == NULL) {
+		return HEAP_SEGREGATED_FIT_INVALID_ARGUMENT;
+	}
+
+	if (heap_first == NULL) {
+		return HEAP_SEGREGATED_FIT_NOT_INITIALIZED;
+	}
+
+	memset (stats, 0, sizeof (struct heap_segregated_fit_stats));
+
+	heap_segregated_fit_lock ();
+
+	runner = heap_first;
+	while (runner != heap_sentinel) {
+		size = HEAP_SEGREGATED_FIT_BLOCK_SIZE (runner);
+
+		if (HEAP_SEGREGATED_FIT_BLOCK_IS_USED (runner)) {
+			stats->total_allocated_size += size;
+			stats->total_allocated_size_w_overhead += (size + HEAP_SEGREGATED_FIT_BLOCK_HEADER_LEN);
+			++stats->num_allocated_blocks;
+		}
+		else {
+			stats->total_free_size += size;
+			stats->total_free_size_w_overhead += (size + HEAP_SEGREGATED_FIT_BLOCK_HEADER_LEN);
+			++stats->num_free_blocks;
+
+			if (size > stats->largest_free_block) {
+				stats->largest_free_block = size;
+			}
+		}
+
+		runner = HEAP_SEGREGATED_FIT_BLOCK_NEXT (runner);
+	}
+
+	heap_segregated_fit_unlock ();
+
+	return 0;
+}
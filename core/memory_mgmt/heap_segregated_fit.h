@@ -0,0 +1,115 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef HEAP_SEGREGATED_FIT_H_
+#define HEAP_SEGREGATED_FIT_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include "status/rot_status.h"
+
+/* Module for a two-level segregated fit heap memory allocator.  Allocator supports stdlib malloc,
+ * calloc, realloc, and free equivalents with the same API as heap_with_defrag.  Free blocks are
+ * binned into size classes with a two-level bitmap index, so finding a free block that satisfies a
+ * request is a constant time operation independent of the number of free blocks in the heap.
+ * Freed blocks are immediately merged with any free neighbors, so no two adjacent blocks are ever
+ * free.
+ *
+ * The allocator can optionally be initialized with a lock to make it safe to use from multiple
+ * tasks. */
+
+/**
+ * Number of second-level size classes in each first-level class, expressed as a power of 2.
+ */
+#define	HEAP_SEGREGATED_FIT_SL_INDEX_COUNT_LOG2					4
+
+#ifndef HEAP_SEGREGATED_FIT_MAX_BLOCK_SIZE_LOG2
+/**
+ * Largest free block the allocator can manage, expressed as a power of 2.  This determines the
+ * maximum heap size that can be used with the allocator.  It can be overridden at build time, but
+ * must not be larger than 31.
+ */
+#define	HEAP_SEGREGATED_FIT_MAX_BLOCK_SIZE_LOG2					24
+#endif
+
+/**
+ * Heap block header
+ *
+ * Every block in the heap, both allocated and free, is preceded by a block header that contains the
+ * size of the block and a pointer to the block physically preceding it in memory.  The free list
+ * pointers are only valid for free blocks and share storage with the contents of the block, so
+ * they do not add overhead to allocated blocks.
+ */
+struct heap_segregated_fit_block {
+	struct heap_segregated_fit_block *prev_phys;				/**< Pointer to block physically before this one. */
+	size_t size;												/**< Size of block, not including header.  The lower bits are block flags. */
+	struct heap_segregated_fit_block *next_free;				/**< Pointer to next block in the same free list. */
+	struct heap_segregated_fit_block *prev_free;				/**< Pointer to previous block in the same free list. */
+};
+
+/**
+ * Overhead added to each block in the heap.
+ */
+#define HEAP_SEGREGATED_FIT_BLOCK_HEADER_LEN					\
+	(offsetof (struct heap_segregated_fit_block, next_free))
+
+/**
+ * Minimum usable size of any block in the heap.  Smaller allocations will be rounded up to this
+ * size.
+ */
+#define	HEAP_SEGREGATED_FIT_MIN_BLOCK_SIZE						\
+	(sizeof (struct heap_segregated_fit_block) - HEAP_SEGREGATED_FIT_BLOCK_HEADER_LEN)
+
+/**
+ * Alignment of all allocations and block sizes.
+ */
+#define	HEAP_SEGREGATED_FIT_ALIGNMENT							(sizeof (void*))
+
+/**
+ * Get address of block header from block contents.
+ *
+ * @param ptr Pointer to block contents
+ */
+#define heap_segregated_fit_get_block_header(ptr)				\
+	((struct heap_segregated_fit_block*) (((uint8_t*) ptr) - HEAP_SEGREGATED_FIT_BLOCK_HEADER_LEN))
+
+/**
+ * A container for memory allocator statistics.
+ */
+struct heap_segregated_fit_stats {
+	int num_allocated_blocks;									/**< Number of allocated blocks. */
+	size_t total_allocated_size;								/**< Total usable size of allocated blocks. */
+	size_t total_allocated_size_w_overhead;						/**< Total size of allocated blocks including overhead. */
+	int num_free_blocks;										/**< Number of free blocks. */
+	size_t total_free_size;										/**< Total usable size of free blocks. */
+	size_t total_free_size_w_overhead;							/**< Total size of free blocks including overhead. */
+	size_t largest_free_block;									/**< Usable size of the largest free block. */
+};
+
+
+int heap_segregated_fit_init (const void *heap_addr, size_t heap_len);
+int heap_segregated_fit_init_thread_safe (const void *heap_addr, size_t heap_len);
+void heap_segregated_fit_release (void);
+
+void* heap_segregated_fit_allocate (size_t size);
+void* heap_segregated_fit_allocate_zeroize (size_t num_items, size_t size);
+void* heap_segregated_fit_reallocate (void *addr, size_t size);
+void heap_segregated_fit_free (void *addr);
+
+int heap_segregated_fit_get_stats (struct heap_segregated_fit_stats *stats);
+
+
+#define	HEAP_SEGREGATED_FIT_ERROR(code)									ROT_ERROR (ROT_MODULE_HEAP_SEGREGATED_FIT, code)
+
+/**
+ * Error codes that can be generated by heap management.
+ */
+enum {
+	HEAP_SEGREGATED_FIT_INVALID_ARGUMENT = HEAP_SEGREGATED_FIT_ERROR (0x00),	/**< Input parameter is null or not valid. */
+	HEAP_SEGREGATED_FIT_NO_MEMORY = HEAP_SEGREGATED_FIT_ERROR (0x01),			/**< Memory allocation failed. */
+	HEAP_SEGREGATED_FIT_HEAP_TOO_LARGE = HEAP_SEGREGATED_FIT_ERROR (0x02),		/**< The heap is larger than the allocator can manage. */
+	HEAP_SEGREGATED_FIT_NOT_INITIALIZED = HEAP_SEGREGATED_FIT_ERROR (0x03),		/**< The heap has not been initialized. */
+};
+
+
+#endif /* HEAP_SEGREGATED_FIT_H_ */
@@ -0,0 +1,313 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdlib.h>
+#include <string.h>
+#include "platform_api.h"
+#include "object_pool.h"
+#include "common/unused.h"
+
+
+/**
+ * Slot index used to indicate there are no free slots.
+ */
+#define	OBJECT_POOL_EMPTY						0xffff
+
+/**
+ * Marker in a slot link indicating the slot is currently free.
+ */
+#define	OBJECT_POOL_LINK_FREE					0x80000000
+
+/**
+ * Get the slot index from the free list head.
+ *
+ * @param head The free list head.
+ */
+#define	OBJECT_POOL_HEAD_INDEX(head)			((head) & 0xffff)
+
+/**
+ * Generate a new value for the free list head.  Every update to the head increments a tag in the
+ * upper bits of the head to protect against ABA races between concurrent acquire and release
+ * calls.
+ *
+ * @param prev The previous free list head.
+ * @param index The slot index that is now at the head of the list.
+ */
+#define	OBJECT_POOL_NEXT_HEAD(prev, index)		((((prev) + 0x10000) & 0xffff0000) | (index))
+
+
+/**
+ * Initialize a pool of fixed-size objects.
+ *
+ * @param pool The object pool to initialize.
+ * @param state Variable context for the pool.  This must be uninitialized.
+ * @param slots Storage for the objects.  This must be at least
+ * OBJECT_POOL_STORAGE_LEN (obj_size, obj_count) entries.
+ * @param links Storage for the free list.  This must be at least obj_count entries.
+ * @param obj_size Size of the objects stored in the pool.
+ * @param obj_count Number of objects in the pool.
+ *
+ * @return 0 if the pool was successfully initialized or an error code.
+ */
+int object_pool_init (struct object_pool *pool, struct object_pool_state *state, uint64_t *slots,
+	volatile uint32_t *links, size_t obj_size, size_t obj_count)
+{
+	if ((pool == NULL) || (state == NULL) || (slots == NULL) || (links == NULL) ||
+		(obj_size == 0) || (obj_count == 0)) {
+		return OBJECT_POOL_INVALID_ARGUMENT;
+	}
+
+	memset (pool, 0, sizeof (struct object_pool));
+
+	pool->state = state;
+	pool->slots = (uint8_t*) slots;
+	pool->links = links;
+	pool->slot_size = OBJECT_POOL_SLOT_SIZE (obj_size);
+	pool->slot_count = obj_count;
+
+	return object_pool_init_state (pool);
+}
+
+/**
+ * Initialize only the variable state for an object pool.  The rest of the pool instance is assumed
+ * to have already been initialized.  All objects in the pool will be free.
+ *
+ * This would generally be used with a statically initialized instance.
+ *
+ * @param pool The object pool that contains the state to initialize.
+ *
+ * @return 0 if the state was successfully initialized or an error code.
+ */
+int object_pool_init_state (const struct object_pool *pool)
+{
+	size_t i;
+
+	if ((pool == NULL) || (pool->state == NULL) || (pool->slots == NULL) ||
+		(pool->links == NULL) || (pool->slot_size == 0) || (pool->slot_count == 0)) {
+		return OBJECT_POOL_INVALID_ARGUMENT;
+	}
+
+	if (pool->slot_count > OBJECT_POOL_MAX_SLOTS) {
+		return OBJECT_POOL_TOO_MANY_SLOTS;
+	}
+
+	memset (pool->state, 0, sizeof (struct object_pool_state));
+
+	for (i = 0; i < (pool->slot_count - 1); i++) {
+		pool->links[i] = OBJECT_POOL_LINK_FREE | (i + 1);
+	}
+	pool->links[i] = OBJECT_POOL_LINK_FREE | OBJECT_POOL_EMPTY;
+
+	platform_atomic_store (&pool->state->free_head, 0);
+
+	return 0;
+}
+
+/**
+ * Release the resources used by an object pool.  Any objects that are still acquired must no longer
+ * be used.
+ *
+ * @param pool The object pool to release.
+ */
+void object_pool_release (const struct object_pool *pool)
+{
+	UNUSED (pool);
+}
+
+/**
+ * Get the slot index for an object in the pool.
+ *
+ * @param pool The object pool.
+ * @param obj The object to query.
+ *
+ * @return The slot index or OBJECT_POOL_EMPTY if the object is not a valid slot in the pool.
+ */
+static uint32_t object_pool_get_slot_index (const struct object_pool *pool, const void *obj)
+{
+	const uint8_t *slot = obj;
+	size_t offset;
+
+	if ((slot < pool->slots) || (slot >= (pool->slots + (pool->slot_size * pool->slot_count)))) {
+		return OBJECT_POOL_EMPTY;
+	}
+
+	offset = slot - pool->slots;
+	if ((offset % pool->slot_size) != 0) {
+		return OBJECT_POOL_EMPTY;
+	}
+
+	return offset / pool->slot_size;
+}
+
+/**
+ * Acquire a free object from the pool.  This is safe to call concurrently from multiple tasks and
+ * from interrupt context.
+ *
+ * @param pool The object pool to acquire from.
+ *
+ * @return The acquired object or null if there are no free objects.  The contents of the object are
+ * not initialized.
+ */
+void* object_pool_acquire_object (const struct object_pool *pool)
+{
+	uint32_t head;
+	uint32_t index;
+	uint32_t next;
+	uint32_t in_use;
+	uint32_t high_water;
+
+	if (pool == NULL) {
+		return NULL;
+	}
+
+	do {
+		head = platform_atomic_load (&pool->state->free_head);
+		index = OBJECT_POOL_HEAD_INDEX (head);
+		if (index == OBJECT_POOL_EMPTY) {
+			platform_atomic_fetch_add (&pool->state->failures, 1);
+			return NULL;
+		}
+
+		/* If another context acquires this slot before the head is updated, the link read here
+		 * could be stale.  The tag in the head will cause the exchange to fail in that case. */
+		next = OBJECT_POOL_HEAD_INDEX (platform_atomic_load (&pool->links[index]));
+	} while (!platform_atomic_compare_exchange (&pool->state->free_head, head,
+		OBJECT_POOL_NEXT_HEAD (head, next)));
+
+	platform_atomic_store (&pool->links[index], OBJECT_POOL_EMPTY);
+
+	in_use = platform_atomic_fetch_add (&pool->state->in_use, 1) + 1;
+	do {
+		high_water = platform_atomic_load (&pool->state->high_water);
+	} while ((in_use > high_water) &&
+		!platform_atomic_compare_exchange (&pool->state->high_water, high_water, in_use));
+
+	return &pool->slots[index * pool->slot_size];
+}
+
+/**
+ * Return an object to the pool.  This is safe to call concurrently from multiple tasks and from
+ * interrupt context.
+ *
+ * @param pool The object pool the object was acquired from.
+ * @param obj The object to release.
+ *
+ * @return 0 if the object was released or an error code.
+ */
+int object_pool_release_object (const struct object_pool *pool, void *obj)
+{
+	uint32_t head;
+	uint32_t index;
+
+	if ((pool == NULL) || (obj == NULL)) {
+		return OBJECT_POOL_INVALID_ARGUMENT;
+	}
+
+	index = object_pool_get_slot_index (pool, obj);
+	if (index == OBJECT_POOL_EMPTY) {
+		return OBJECT_POOL_NOT_POOL_OBJECT;
+	}
+
+	if (platform_atomic_load (&pool->links[index]) & OBJECT_POOL_LINK_FREE) {
+		return OBJECT_POOL_ALREADY_FREE;
+	}
+
+	do {
+		head = platform_atomic_load (&pool->state->free_head);
+		platform_atomic_store (&pool->links[index],
+			OBJECT_POOL_LINK_FREE | OBJECT_POOL_HEAD_INDEX (head));
+	} while (!platform_atomic_compare_exchange (&pool->state->free_head, head,
+		OBJECT_POOL_NEXT_HEAD (head, index)));
+
+	platform_atomic_fetch_add (&pool->state->in_use, -1);
+
+	return 0;
+}
+
+/**
+ * Determine if an object is owned by a pool.
+ *
+ * @param pool The object pool to check.
+ * @param obj The object to check.
+ *
+ * @return true if the object is one of the pool slots or false if not.
+ */
+bool object_pool_contains (const struct object_pool *pool, const void *obj)
+{
+	if ((pool == NULL) || (obj == NULL)) {
+		return false;
+	}
+
+	return (object_pool_get_slot_index (pool, obj) != OBJECT_POOL_EMPTY);
+}
+
+/**
+ * Get usage statistics for an object pool.
+ *
+ * @param pool The object pool to query.
+ * @param stats Output for the pool statistics.
+ *
+ * @return 0 if the statistics were retrieved or an error code.
+ */
+int object_pool_get_stats (const struct object_pool *pool, struct object_pool_stats *stats)
+{
+	if ((pool == NULL) || (stats == NULL)) {
+		return OBJECT_POOL_INVALID_ARGUMENT;
+	}
+
+	stats->slot_size = pool->slot_size;
+	stats->slot_count = pool->slot_count;
+	stats->in_use = platform_atomic_load (&pool->state->in_use);
+	stats->high_water = platform_atomic_load (&pool->state->high_water);
+	stats->failures = platform_atomic_load (&pool->state->failures);
+
+	return 0;
+}
+
+/**
+ * Get a buffer from an object pool, if possible, falling back to heap allocation when the pool is
+ * not available or can't satisfy the request.  This allows modules to optionally use a pool for
+ * frequently allocated buffers.
+ *
+ * Buffers returned by this call must be freed with {@link object_pool_release_or_free}.
+ *
+ * @param pool The object pool to use.  This can be null to always allocate from the heap.
+ * @param length The size of the buffer needed.
+ *
+ * @return The buffer or null if no memory is available.
+ */
+void* object_pool_acquire_or_allocate (const struct object_pool *pool, size_t length)
+{
+	void *obj = NULL;
+
+	if ((pool != NULL) && (length <= pool->slot_size)) {
+		obj = object_pool_acquire_object (pool);
+	}
+
+	if (obj == NULL) {
+		obj = platform_malloc (length);
+	}
+
+	return obj;
+}
+
+/**
+ * Free a buffer that was acquired with {@link object_pool_acquire_or_allocate}.
+ *
+ * @param pool The object pool the buffer was acquired from.  This can be null if the pool was null
+ * when the buffer was acquired.
+ * @param obj The buffer to free.  Null is ignored.
+ */
+void object_pool_release_or_free (const struct object_pool *pool, void *obj)
+{
+	if (obj == NULL) {
+		return;
+	}
+
+	if (object_pool_contains (pool, obj)) {
+		object_pool_release_object (pool, obj);
+	}
+	else {
+		platform_free (obj);
+	}
+}
@@ -0,0 +1,104 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef OBJECT_POOL_H_
+#define OBJECT_POOL_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "status/rot_status.h"
+
+
+/**
+ * Variable context for a pool of fixed-size objects.
+ */
+struct object_pool_state {
+	volatile uint32_t free_head;		/**< Index of the first free slot, tagged with an update count. */
+	volatile uint32_t in_use;			/**< Number of slots currently acquired. */
+	volatile uint32_t high_water;		/**< Maximum number of slots acquired at the same time. */
+	volatile uint32_t failures;			/**< Number of acquire requests that failed due to an empty pool. */
+};
+
+/**
+ * A pool of preallocated, fixed-size objects.  Objects can be acquired and released from any task
+ * in constant time without taking any locks.
+ *
+ * Acquiring and releasing pool objects only uses the platform atomic operations, so it can also be
+ * done from interrupt context.  This does not apply to object_pool_acquire_or_allocate and
+ * object_pool_release_or_free, which can use the heap.
+ */
+struct object_pool {
+	struct object_pool_state *state;	/**< Variable context for the pool. */
+	uint8_t *slots;						/**< Storage for all objects in the pool. */
+	volatile uint32_t *links;			/**< Free list links for each slot. */
+	size_t slot_size;					/**< Size of each object slot. */
+	size_t slot_count;					/**< Number of object slots in the pool. */
+};
+
+/**
+ * Statistics for object pool usage.
+ */
+struct object_pool_stats {
+	size_t slot_size;					/**< Size of each object slot. */
+	size_t slot_count;					/**< Total number of object slots. */
+	uint32_t in_use;					/**< Number of slots currently acquired. */
+	uint32_t high_water;				/**< Maximum number of slots acquired at the same time. */
+	uint32_t failures;					/**< Number of acquire requests that failed. */
+};
+
+/**
+ * Maximum number of object slots that can be managed by a single pool.
+ */
+#define	OBJECT_POOL_MAX_SLOTS					0xfffe
+
+/**
+ * Size of each slot for objects of a specific size.  Slots are padded to keep every object 64-bit
+ * aligned.
+ *
+ * @param obj_size Size of the objects that will be stored in the pool.
+ */
+#define	OBJECT_POOL_SLOT_SIZE(obj_size)			\
+	(((obj_size) + sizeof (uint64_t) - 1) & ~(sizeof (uint64_t) - 1))
+
+/**
+ * Number of 64-bit words needed to provide storage for an object pool.  Storage for the pool
+ * should be declared as a uint64_t array of this length to ensure proper alignment.
+ *
+ * @param obj_size Size of the objects that will be stored in the pool.
+ * @param obj_count The number of objects in the pool.
+ */
+#define	OBJECT_POOL_STORAGE_LEN(obj_size, obj_count)	\
+	((OBJECT_POOL_SLOT_SIZE (obj_size) / sizeof (uint64_t)) * (obj_count))
+
+
+int object_pool_init (struct object_pool *pool, struct object_pool_state *state, uint64_t *slots,
+	volatile uint32_t *links, size_t obj_size, size_t obj_count);
+int object_pool_init_state (const struct object_pool *pool);
+void object_pool_release (const struct object_pool *pool);
+
+void* object_pool_acquire_object (const struct object_pool *pool);
+int object_pool_release_object (const struct object_pool *pool, void *obj);
+bool object_pool_contains (const struct object_pool *pool, const void *obj);
+
+int object_pool_get_stats (const struct object_pool *pool, struct object_pool_stats *stats);
+
+void* object_pool_acquire_or_allocate (const struct object_pool *pool, size_t length);
+void object_pool_release_or_free (const struct object_pool *pool, void *obj);
+
+
+#define	OBJECT_POOL_ERROR(code)		ROT_ERROR (ROT_MODULE_OBJECT_POOL, code)
+
+/**
+ * Error codes that can be generated by an object pool.
+ */
+enum {
+	OBJECT_POOL_INVALID_ARGUMENT = OBJECT_POOL_ERROR (0x00),	/**< Input parameter is null or not valid. */
+	OBJECT_POOL_NO_MEMORY = OBJECT_POOL_ERROR (0x01),			/**< Memory allocation failed. */
+	OBJECT_POOL_TOO_MANY_SLOTS = OBJECT_POOL_ERROR (0x02),		/**< The pool has more slots than can be managed. */
+	OBJECT_POOL_NOT_POOL_OBJECT = OBJECT_POOL_ERROR (0x03),		/**< The object does not belong to the pool. */
+	OBJECT_POOL_ALREADY_FREE = OBJECT_POOL_ERROR (0x04),		/**< The object has already been released. */
+};
+
+
+#endif /* OBJECT_POOL_H_ */
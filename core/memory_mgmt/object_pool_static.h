@@ -0,0 +1,33 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef OBJECT_POOL_STATIC_H_
+#define OBJECT_POOL_STATIC_H_
+
+#include "memory_mgmt/object_pool.h"
+
+
+/**
+ * Initialize a static instance of an object pool.  Since all storage for the pool is provided at
+ * build time, this can be a constant instance.
+ *
+ * There is no validation done on the arguments.
+ *
+ * @param state_ptr Variable context for the pool.
+ * @param slots_ptr Storage for the objects.  This must be a uint64_t array of at least
+ * OBJECT_POOL_STORAGE_LEN (obj_size, obj_count) entries.
+ * @param links_ptr Storage for the free list.  This must be a uint32_t array of obj_count
+ * entries.
+ * @param obj_size Size of the objects stored in the pool.
+ * @param obj_count Number of objects in the pool.
+ */
+#define	object_pool_static_init(state_ptr, slots_ptr, links_ptr, obj_size, obj_count)	{ \
+		.state = state_ptr, \
+		.slots = (uint8_t*) slots_ptr, \
+		.links = links_ptr, \
+		.slot_size = OBJECT_POOL_SLOT_SIZE (obj_size), \
+		.slot_count = obj_count \
+	}
+
+
+#endif /* OBJECT_POOL_STATIC_H_ */
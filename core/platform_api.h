@@ -6,6 +6,7 @@
 
 #include <stdlib.h>
 #include <stdint.h>
+#include <stdbool.h>
 #include "status/rot_status.h"
 
 
@@ -597,4 +598,60 @@ int platform_os_suspend_scheduler (void);
 int platform_os_resume_scheduler (void);
 #endif
 
+
+/*************************
+ * Atomic operations
+ *************************/
+
+/* Atomic operations must be safe to call from both task and interrupt context. */
+
+#ifndef platform_atomic_load
+/**
+ * Read a 32-bit value that is shared between tasks or interrupt contexts.  The read is atomic and
+ * no memory accesses following it will be reordered before it.
+ *
+ * @param value The value to read.
+ *
+ * @return The current value.
+ */
+uint32_t platform_atomic_load (volatile uint32_t *value);
+#endif
+
+#ifndef platform_atomic_store
+/**
+ * Write a 32-bit value that is shared between tasks or interrupt contexts.  The write is atomic and
+ * no memory accesses preceding it will be reordered after it.
+ *
+ * @param value The value to write.
+ * @param new_value The data to store.
+ */
+void platform_atomic_store (volatile uint32_t *value, uint32_t new_value);
+#endif
+
+#ifndef platform_atomic_fetch_add
+/**
+ * Atomically add to a 32-bit value.
+ *
+ * @param value The value to update.
+ * @param add The amount to add to the value.  Subtraction is done by adding the two's complement.
+ *
+ * @return The value before the addition.
+ */
+uint32_t platform_atomic_fetch_add (volatile uint32_t *value, uint32_t add);
+#endif
+
+#ifndef platform_atomic_compare_exchange
+/**
+ * Atomically replace a 32-bit value only if it has not been changed from an expected value.
+ *
+ * @param value The value to update.
+ * @param expected The value that must currently be stored for the update to be applied.
+ * @param desired The new value to store.
+ *
+ * @return true if the value was updated or false if it did not contain the expected value.
+ */
+bool platform_atomic_compare_exchange (volatile uint32_t *value, uint32_t expected,
+	uint32_t desired);
+#endif
+
 #endif /* PLATFORM_API_H_ */
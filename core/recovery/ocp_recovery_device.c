@@ -115,6 +115,40 @@ void ocp_recovery_device_release (const struct ocp_recovery_device *device)
 	UNUSED (device);
 }
 
+/**
+ * Provide a read-ahead buffer to use for reads from any variable CMS.  Instead of reading the CMS
+ * separately for each INDIRECT_DATA request, a full buffer of data will be read at once and
+ * sequential requests will be served from the buffer.
+ *
+ * The buffer must be set after the handler state has been initialized.  Initializing the state
+ * again will remove the buffer.
+ *
+ * @param device The recovery handler that will use the buffer.
+ * @param buffer The buffer to use for read-ahead data.  Set this to null to read directly from the
+ * CMS for every request.
+ * @param length Size of the buffer.  This must be large enough to hold the data for a single
+ * INDIRECT_DATA request.
+ *
+ * @return 0 if the buffer was set successfully or an error code.
+ */
+int ocp_recovery_device_set_cms_read_buffer (const struct ocp_recovery_device *device,
+	uint8_t *buffer, size_t length)
+{
+	if (device == NULL) {
+		return OCP_RECOVERY_DEVICE_INVALID_ARGUMENT;
+	}
+
+	if ((buffer != NULL) && (length < OCP_RECOVERY_DEVICE_MAX_INDIRECT_READ)) {
+		return OCP_RECOVERY_DEVICE_CMS_CACHE_TOO_SMALL;
+	}
+
+	device->state->cache.buffer = buffer;
+	device->state->cache.length = length;
+	device->state->cache.valid = 0;
+
+	return 0;
+}
+
 /**
  * Notify the device handler that a new recovery command has been received.  This must be called as
  * soon as the command code is known.  The final direction of the command is not known at this
@@ -287,6 +321,9 @@ static int ocp_recovery_device_write_indirect_ctrl (const struct ocp_recovery_de
 	/* Address offset must be 4-byte aligned.  Move to the next aligned address. */
 	device->state->indirect_ctrl.offset = (device->state->indirect_ctrl.offset + 3) & ~0x3ull;
 
+	/* Selecting a CMS starts a new access, so make sure the host gets current data. */
+	device->state->cache.valid = 0;
+
 	return 0;
 }
 
@@ -566,6 +603,54 @@ static int ocp_recovery_device_read_indirect_status (const struct ocp_recovery_d
 	return sizeof (struct ocp_recovery_indirect_status);
 }
 
+/**
+ * Read data from a variable CMS.  If the handler has a read-ahead buffer, the data will be provided
+ * from the buffer when possible.
+ *
+ * @param device The recovery handler reading the CMS.
+ * @param cms The CMS to read.
+ * @param size The current size of the CMS data.
+ * @param offset The offset within the CMS to start reading.  This must be less than the CMS size.
+ * @param data Output buffer for the CMS data.
+ * @param length The maximum amount of data to read.  This must not be larger than the read-ahead
+ * buffer.
+ *
+ * @return The number of bytes read from the CMS or an error code.
+ */
+static int ocp_recovery_device_read_variable_cms (const struct ocp_recovery_device *device,
+	const struct ocp_recovery_device_cms *cms, size_t size, size_t offset, uint8_t *data,
+	size_t length)
+{
+	struct ocp_recovery_device_cms_cache *cache = &device->state->cache;
+	size_t cache_offset;
+	int status;
+
+	if (cache->buffer == NULL) {
+		return cms->variable->get_data (cms->variable, offset, data, length);
+	}
+
+	/* Only use the buffer if it has all the data the CMS could provide for this read.  A CMS that
+	 * has grown since the buffer was filled will be read again. */
+	if ((cache->valid == 0) || (offset < cache->offset) ||
+		((offset + min (length, size - offset)) > (cache->offset + cache->valid))) {
+		cache->valid = 0;
+
+		status = cms->variable->get_data (cms->variable, offset, cache->buffer, cache->length);
+		if (ROT_IS_ERROR (status)) {
+			return status;
+		}
+
+		cache->offset = offset;
+		cache->valid = status;
+	}
+
+	cache_offset = offset - cache->offset;
+	length = min (length, cache->valid - cache_offset);
+	memcpy (data, &cache->buffer[cache_offset], length);
+
+	return length;
+}
+
 /**
  * Read the data to respond to an INDIRECT_DATA recovery command.
  *
@@ -605,14 +690,16 @@ static int ocp_recovery_device_read_indirect_data (const struct ocp_recovery_dev
 	if (device->state->indirect_ctrl.offset >= read_len) {
 		device->state->indirect_ctrl.offset = 0;
 		device->state->indirect_status |= OCP_RECOVERY_INDIRECT_STATUS_OVERLFLOW;
+		device->state->cache.valid = 0;
 	}
 
 	/* Read the data from the memory region. */
 	memset (indirect_data->data, 0, sizeof (indirect_data->data));
 
 	if (cms->length == OCP_RECOVERY_DEVICE_CMS_LENGTH_VARIABLE) {
-		read_len = cms->variable->get_data (cms->variable, device->state->indirect_ctrl.offset,
-			indirect_data->data, OCP_RECOVERY_DEVICE_MAX_INDIRECT_READ);
+		read_len = ocp_recovery_device_read_variable_cms (device, cms, read_len,
+			device->state->indirect_ctrl.offset, indirect_data->data,
+			OCP_RECOVERY_DEVICE_MAX_INDIRECT_READ);
 		if (ROT_IS_ERROR ((int) read_len)) {
 			return read_len;
 		}
@@ -49,6 +49,22 @@ struct ocp_recovery_device_variable_cms {
 		uint8_t *data, size_t length);
 };
 
+/**
+ * Read-ahead buffer for variable CMS.  When a read is not already in the buffer, a full buffer of
+ * data is read from the CMS starting at the requested offset.  Subsequent sequential reads are
+ * served from the buffer without accessing the CMS.
+ *
+ * Buffered data is discarded whenever INDIRECT_CTRL is written or when reads wrap back to the
+ * beginning of the region.  Changes to the CMS data made between those events may not be seen by
+ * the host.
+ */
+struct ocp_recovery_device_cms_cache {
+	uint8_t *buffer;						/**< Buffer for data read from the CMS. */
+	size_t length;							/**< Size of the buffer.  Must be at least 252 bytes. */
+	size_t offset;							/**< CMS offset of the first byte in the buffer. */
+	size_t valid;							/**< The number of valid bytes in the buffer. */
+};
+
 /**
  * Defines a region of memory that is accessible through the recovery interface.  The OCP Recovery
  * spec refers to these regions as Component Memory Spaces (CMS).
@@ -189,6 +205,7 @@ struct ocp_recovery_device_state {
 	struct ocp_recovery_reset reset;					/**< Current state of reset control data. */
 	struct ocp_recovery_recovery_ctrl recovery_ctrl;	/**< Current state of recovery control data. */
 	struct ocp_recovery_indirect_ctrl indirect_ctrl;	/**< Current state of the indirect control data. */
+	struct ocp_recovery_device_cms_cache cache;			/**< Read-ahead buffer for variable CMS reads. */
 };
 
 /**
@@ -228,6 +245,9 @@ int ocp_recovery_device_init (struct ocp_recovery_device *device,
 int ocp_recovery_device_init_state (const struct ocp_recovery_device *device);
 void ocp_recovery_device_release (const struct ocp_recovery_device *device);
 
+int ocp_recovery_device_set_cms_read_buffer (const struct ocp_recovery_device *device,
+	uint8_t *buffer, size_t length);
+
 int ocp_recovery_device_start_new_command (const struct ocp_recovery_device *device,
 	uint8_t command_code);
 
@@ -265,6 +285,7 @@ enum {
 	OCP_RECOVERY_DEVICE_EXTRA_CMD_BYTES = OCP_RECOVERY_DEVICE_ERROR (0x0f),		/**< Too much data was sent for the command. */
 	OCP_RECOVERY_DEVICE_CMS_SIZE_FAILED = OCP_RECOVERY_DEVICE_ERROR (0x10),		/**< Could not determine the size of a variable CMS. */
 	OCP_RECOVERY_DEVICE_CMS_DATA_FAILED = OCP_RECOVERY_DEVICE_ERROR (0x11),		/**< Failed to read data from a variable CMS. */
+	OCP_RECOVERY_DEVICE_CMS_CACHE_TOO_SMALL = OCP_RECOVERY_DEVICE_ERROR (0x12),	/**< The CMS read-ahead buffer is smaller than a single read. */
 };
 
 
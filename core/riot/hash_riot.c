@@ -184,6 +184,65 @@ static void hash_riot_cancel (struct hash_engine *engine)
 	}
 }
 
+static int hash_riot_save_state (struct hash_engine *engine, struct hash_saved_state *state)
+{
+	struct hash_engine_riot *riot = (struct hash_engine_riot*) engine;
+
+	if ((riot == NULL) || (state == NULL)) {
+		return HASH_ENGINE_INVALID_ARGUMENT;
+	}
+
+	if (sizeof (riot->context) > sizeof (state->context)) {
+		return HASH_ENGINE_NO_MEMORY;
+	}
+
+	switch (riot->active) {
+#ifdef HASH_ENABLE_SHA1
+		case HASH_ACTIVE_SHA1:
+#endif
+		case HASH_ACTIVE_SHA256:
+			memcpy (state->context, &riot->context, sizeof (riot->context));
+			break;
+
+		default:
+			return HASH_ENGINE_NO_ACTIVE_HASH;
+	}
+
+	state->active = riot->active;
+
+	return 0;
+}
+
+static int hash_riot_restore_state (struct hash_engine *engine,
+	const struct hash_saved_state *state)
+{
+	struct hash_engine_riot *riot = (struct hash_engine_riot*) engine;
+
+	if ((riot == NULL) || (state == NULL)) {
+		return HASH_ENGINE_INVALID_ARGUMENT;
+	}
+
+	if (riot->active != HASH_ACTIVE_NONE) {
+		return HASH_ENGINE_HASH_IN_PROGRESS;
+	}
+
+	switch (state->active) {
+#ifdef HASH_ENABLE_SHA1
+		case HASH_ACTIVE_SHA1:
+#endif
+		case HASH_ACTIVE_SHA256:
+			memcpy (&riot->context, state->context, sizeof (riot->context));
+			break;
+
+		default:
+			return HASH_ENGINE_UNSUPPORTED_HASH;
+	}
+
+	riot->active = state->active;
+
+	return 0;
+}
+
 /**
  * Initialize a riot hash engine.
  *
@@ -216,6 +275,8 @@ int hash_riot_init (struct hash_engine_riot *engine)
 	engine->base.update = hash_riot_update;
 	engine->base.finish = hash_riot_finish;
 	engine->base.cancel = hash_riot_cancel;
+	engine->base.save_state = hash_riot_save_state;
+	engine->base.restore_state = hash_riot_restore_state;
 
 	engine->active = HASH_ACTIVE_NONE;
 
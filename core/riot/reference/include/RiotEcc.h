@@ -162,6 +162,19 @@ RIOT_STATUS
 RIOT_DeriveDsaKeyPair(ecc_publickey *publicKey, ecc_privatekey *privateKey,
                       const uint8_t *srcVal, size_t srcSize);
 
+//
+// Multiplies the P-256 base point by a scalar.  This is the operation used
+// to generate DSA public keys and signatures.
+//
+// @param tgt       OUT: The resulting point
+// @param k         IN:  The scalar multiplier
+// @param fixedBase IN:  Use the precomputed fixed-base table, if the table is
+//                       enabled.  Otherwise, use the generic point multiplication.
+//                       This allows the two methods to be compared.
+//
+void
+RIOT_BasePointMultiply(ecc_publickey *tgt, const ecc_privatekey *k, bool fixedBase);
+
 //
 // Sign a digest using the DSA key
 // @param digest The digest to sign
@@ -115,3 +115,43 @@ void spi_filter_log_filter_config (int port, uint8_t mfg, bool enabled, spi_filt
 			(((i + 1) << 24) | (region_end[i] >> 8)));
 	}
 }
+
+/**
+ * Get the set of flash blocks that have been written by the host since write tracking was last
+ * cleared.
+ *
+ * @param filter The SPI filter to query.
+ * @param cs The flash device to get the write tracking information for.
+ * @param clear Flag indicating if write tracking for the device should be cleared.
+ * @param bitmap Output for the dirty block bitmap.
+ * @param length Length of the bitmap buffer.
+ * @param block_size Output for the number of bytes represented by each bit in the bitmap.
+ *
+ * @return 0 if the bitmap was retrieved successfully or an error code.  If the filter does not
+ * track writes at block granularity, SPI_FILTER_UNSUPPORTED_OPERATION will be returned.
+ */
+int spi_filter_get_dirty_block_bitmap (const struct spi_filter_interface *filter,
+	spi_filter_cs cs, bool clear, uint8_t *bitmap, size_t length, uint32_t *block_size)
+{
+	if ((filter == NULL) || (bitmap == NULL) || (block_size == NULL)) {
+		return SPI_FILTER_INVALID_ARGUMENT;
+	}
+
+	if (filter->get_dirty_block_bitmap == NULL) {
+		return SPI_FILTER_UNSUPPORTED_OPERATION;
+	}
+
+	return filter->get_dirty_block_bitmap (filter, cs, clear, bitmap, length, block_size);
+}
+
+/**
+ * Determine if a SPI filter is able to report host writes at block granularity.
+ *
+ * @param filter The SPI filter to query.
+ *
+ * @return true if the filter supports dirty block tracking or false if not.
+ */
+bool spi_filter_is_dirty_block_tracking_supported (const struct spi_filter_interface *filter)
+{
+	return ((filter != NULL) && (filter->get_dirty_block_bitmap != NULL));
+}
@@ -5,6 +5,7 @@
 #define SPI_FILTER_INTERFACE_H_
 
 #include <stdint.h>
+#include <stddef.h>
 #include <stdbool.h>
 #include "status/rot_status.h"
 
@@ -354,6 +355,35 @@ struct spi_filter_interface {
 	 * @return 0 if the regions were cleared successfully or an error code.
 	 */
 	int (*clear_filter_rw_regions) (const struct spi_filter_interface *filter);
+
+	/**
+	 * Get the set of flash blocks that have been written since write tracking was last cleared.
+	 * Write tracking is independent of the flash dirty state and is not affected by
+	 * clear_flash_dirty_state.
+	 *
+	 * Each bit in the bitmap represents one block of flash, starting with the LSB of the first
+	 * byte for the block at address 0.  A set bit indicates the block may have been modified by
+	 * the host.  Any time the filter is unable to track host writes to a device, such as while
+	 * running in bypass mode, every block of that device must be reported as written.
+	 *
+	 * This is optional and will be null for filters that only report the flash dirty state.  Use
+	 * spi_filter_get_dirty_block_bitmap to call this with any filter.
+	 *
+	 * @param filter The SPI filter to query.
+	 * @param cs The flash device to get the write tracking information for.
+	 * @param clear Flag indicating if write tracking for the device should be cleared.  Clearing
+	 * is atomic with reading the bitmap, so no write will be missed between the two operations.
+	 * @param bitmap Output for the dirty block bitmap.
+	 * @param length Length of the bitmap buffer.  If the buffer is larger than necessary, bits
+	 * for blocks beyond the end of the device will be cleared.
+	 * @param block_size Output for the number of bytes represented by each bit in the bitmap.
+	 *
+	 * @return 0 if the bitmap was retrieved successfully or an error code.  If the buffer is not
+	 * large enough to hold the bitmap for the entire device, SPI_FILTER_DIRTY_BITMAP_TOO_SMALL
+	 * will be returned and write tracking will not be cleared.
+	 */
+	int (*get_dirty_block_bitmap) (const struct spi_filter_interface *filter, spi_filter_cs cs,
+		bool clear, uint8_t *bitmap, size_t length, uint32_t *block_size);
 };
 
 
@@ -364,6 +394,10 @@ void spi_filter_log_filter_config (int port, uint8_t mfg, bool enabled, spi_filt
 	bool write_allow, uint32_t *region_start, uint32_t *region_end, int regions,
 	uint32_t device_size);
 
+int spi_filter_get_dirty_block_bitmap (const struct spi_filter_interface *filter,
+	spi_filter_cs cs, bool clear, uint8_t *bitmap, size_t length, uint32_t *block_size);
+bool spi_filter_is_dirty_block_tracking_supported (const struct spi_filter_interface *filter);
+
 
 #define	SPI_FILTER_ERROR(code)		ROT_ERROR (ROT_MODULE_SPI_FILTER, code)
 
@@ -414,6 +448,9 @@ enum {
 	SPI_FILTER_SET_ALLOW_WRITE_FAILED = SPI_FILTER_ERROR (0x26),	/**< Failed to set single chip write permissions. */
 	SPI_FILTER_INVALID_ADDR_RANGE = SPI_FILTER_ERROR (0x27),		/**< The specified R/W region address range is not valid. */
 	SPI_FILTER_OPCODE_CFG_FAILED = SPI_FILTER_ERROR (0x28),			/**< Failed to configure flash opcode information in the filter. */
+	SPI_FILTER_GET_DIRTY_BLOCKS_FAILED = SPI_FILTER_ERROR (0x29),	/**< Could not get the dirty block bitmap. */
+	SPI_FILTER_DIRTY_BITMAP_TOO_SMALL = SPI_FILTER_ERROR (0x2a),	/**< The buffer for the dirty block bitmap is too small. */
+	SPI_FILTER_INVALID_BLOCK_SIZE = SPI_FILTER_ERROR (0x2b),		/**< The write tracking block size is not valid. */
 };
 
 
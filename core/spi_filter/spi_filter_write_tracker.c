@@ -0,0 +1,190 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdlib.h>
+#include <string.h>
+#include "spi_filter_write_tracker.h"
+#include "spi_filter_interface.h"
+
+
+/**
+ * Initialize tracking of host writes to a flash device.  All blocks start out clean.
+ *
+ * @param tracker The write tracker to initialize.
+ * @param bitmap Storage for the bitmap of written blocks.  This must contain at least one bit for
+ * each block in the device.
+ * @param length Length of the bitmap storage.
+ * @param block_size The number of bytes represented by each block.  This must be a power of two.
+ * @param device_size The total size of the flash device.
+ *
+ * @return 0 if the write tracker was initialized successfully or an error code.
+ */
+int spi_filter_write_tracker_init (struct spi_filter_write_tracker *tracker, uint8_t *bitmap,
+	size_t length, uint32_t block_size, uint32_t device_size)
+{
+	uint32_t block_count;
+
+	if ((tracker == NULL) || (bitmap == NULL) || (device_size == 0)) {
+		return SPI_FILTER_INVALID_ARGUMENT;
+	}
+
+	if ((block_size == 0) || ((block_size & (block_size - 1)) != 0)) {
+		return SPI_FILTER_INVALID_BLOCK_SIZE;
+	}
+
+	block_count = (device_size / block_size) + ((device_size % block_size) ? 1 : 0);
+	if (length < ((block_count + 7) / 8)) {
+		return SPI_FILTER_DIRTY_BITMAP_TOO_SMALL;
+	}
+
+	memset (tracker, 0, sizeof (struct spi_filter_write_tracker));
+	memset (bitmap, 0, length);
+
+	tracker->bitmap = bitmap;
+	tracker->length = length;
+	tracker->block_size = block_size;
+	tracker->block_count = block_count;
+
+	return platform_mutex_init (&tracker->lock);
+}
+
+/**
+ * Release the resources used for tracking host writes.
+ *
+ * @param tracker The write tracker to release.
+ */
+void spi_filter_write_tracker_release (struct spi_filter_write_tracker *tracker)
+{
+	if (tracker) {
+		platform_mutex_free (&tracker->lock);
+	}
+}
+
+/**
+ * Mark a range of blocks as written.  The tracker must be locked by the caller.
+ *
+ * @param tracker The write tracker to update.
+ * @param first The first block to mark.
+ * @param last The last block to mark.
+ */
+static void spi_filter_write_tracker_mark_blocks (struct spi_filter_write_tracker *tracker,
+	uint32_t first, uint32_t last)
+{
+	while ((first <= last) && (first % 8)) {
+		tracker->bitmap[first / 8] |= (1U << (first % 8));
+		first++;
+	}
+
+	while ((first + 7) <= last) {
+		tracker->bitmap[first / 8] = 0xff;
+		first += 8;
+	}
+
+	while (first <= last) {
+		tracker->bitmap[first / 8] |= (1U << (first % 8));
+		first++;
+	}
+}
+
+/**
+ * Record a host write or erase to the flash device.  Any operation that extends beyond the end of
+ * the device is treated as having modified the entire device, since the flash will wrap the
+ * address.
+ *
+ * @param tracker The write tracker to update.
+ * @param addr The first address modified by the operation.
+ * @param length The number of bytes modified by the operation.
+ *
+ * @return 0 if the write was recorded or an error code.
+ */
+int spi_filter_write_tracker_record_write (struct spi_filter_write_tracker *tracker, uint32_t addr,
+	size_t length)
+{
+	uint64_t end;
+	uint32_t first;
+	uint32_t last;
+
+	if (tracker == NULL) {
+		return SPI_FILTER_INVALID_ARGUMENT;
+	}
+
+	if (length == 0) {
+		return 0;
+	}
+
+	end = (uint64_t) addr + length - 1;
+	first = addr / tracker->block_size;
+	last = end / tracker->block_size;
+	if (last >= tracker->block_count) {
+		first = 0;
+		last = tracker->block_count - 1;
+	}
+
+	platform_mutex_lock (&tracker->lock);
+	spi_filter_write_tracker_mark_blocks (tracker, first, last);
+	platform_mutex_unlock (&tracker->lock);
+
+	return 0;
+}
+
+/**
+ * Mark the entire flash device as written.  This must be called whenever host writes to the device
+ * could have happened without being recorded, such as when the SPI filter is in bypass mode.
+ *
+ * @param tracker The write tracker to update.
+ *
+ * @return 0 if the device was marked as written or an error code.
+ */
+int spi_filter_write_tracker_mark_all_dirty (struct spi_filter_write_tracker *tracker)
+{
+	if (tracker == NULL) {
+		return SPI_FILTER_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&tracker->lock);
+	spi_filter_write_tracker_mark_blocks (tracker, 0, tracker->block_count - 1);
+	platform_mutex_unlock (&tracker->lock);
+
+	return 0;
+}
+
+/**
+ * Get the bitmap of blocks written by the host.  This follows the requirements for the SPI filter
+ * get_dirty_block_bitmap call.
+ *
+ * @param tracker The write tracker to query.
+ * @param clear Flag indicating if write tracking should be cleared after reading the bitmap.
+ * @param bitmap Output for the dirty block bitmap.
+ * @param length Length of the bitmap buffer.
+ * @param block_size Output for the number of bytes represented by each bit in the bitmap.
+ *
+ * @return 0 if the bitmap was retrieved successfully or an error code.
+ */
+int spi_filter_write_tracker_get_dirty_block_bitmap (struct spi_filter_write_tracker *tracker,
+	bool clear, uint8_t *bitmap, size_t length, uint32_t *block_size)
+{
+	size_t bytes;
+
+	if ((tracker == NULL) || (bitmap == NULL) || (block_size == NULL)) {
+		return SPI_FILTER_INVALID_ARGUMENT;
+	}
+
+	bytes = (tracker->block_count + 7) / 8;
+	if (length < bytes) {
+		return SPI_FILTER_DIRTY_BITMAP_TOO_SMALL;
+	}
+
+	platform_mutex_lock (&tracker->lock);
+
+	memcpy (bitmap, tracker->bitmap, bytes);
+	if (clear) {
+		memset (tracker->bitmap, 0, tracker->length);
+	}
+
+	platform_mutex_unlock (&tracker->lock);
+
+	memset (&bitmap[bytes], 0, length - bytes);
+	*block_size = tracker->block_size;
+
+	return 0;
+}
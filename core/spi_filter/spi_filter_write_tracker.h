@@ -0,0 +1,41 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef SPI_FILTER_WRITE_TRACKER_H_
+#define SPI_FILTER_WRITE_TRACKER_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "platform_api.h"
+
+
+/**
+ * Software tracking of host writes to a single flash device at block granularity.  This provides a
+ * reference implementation of dirty block tracking for SPI filters that can report each write or
+ * erase command from the host, such as a simulated filter or a filter that raises an interrupt on
+ * host writes.  A filter would use one tracker for each chip select to implement
+ * get_dirty_block_bitmap.
+ */
+struct spi_filter_write_tracker {
+	platform_mutex lock;				/**< Synchronization between tracking and reporting writes. */
+	uint8_t *bitmap;					/**< Bitmap of blocks written by the host. */
+	size_t length;						/**< Length of the bitmap buffer. */
+	uint32_t block_size;				/**< Number of bytes tracked by each bit. */
+	uint32_t block_count;				/**< Number of blocks in the flash device. */
+};
+
+
+int spi_filter_write_tracker_init (struct spi_filter_write_tracker *tracker, uint8_t *bitmap,
+	size_t length, uint32_t block_size, uint32_t device_size);
+void spi_filter_write_tracker_release (struct spi_filter_write_tracker *tracker);
+
+int spi_filter_write_tracker_record_write (struct spi_filter_write_tracker *tracker, uint32_t addr,
+	size_t length);
+int spi_filter_write_tracker_mark_all_dirty (struct spi_filter_write_tracker *tracker);
+
+int spi_filter_write_tracker_get_dirty_block_bitmap (struct spi_filter_write_tracker *tracker,
+	bool clear, uint8_t *bitmap, size_t length, uint32_t *block_size);
+
+
+#endif /* SPI_FILTER_WRITE_TRACKER_H_ */
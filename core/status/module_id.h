@@ -126,7 +126,12 @@ enum {
 	ROT_MODULE_DME_STRUCTURE = 0x0072,					/**< Parsing and management of the DME structure. */
     ROT_MODULE_PLDM_FWUP_MANAGER = 0x0072,              /**< Manager for a PLDM-based Firmware Update. */
     ROT_MODULE_CMD_HANDLER_PLDM = 0x0073,               /**< Handler for received PLDM protocol messages. */
-    ROT_MODULE_PLDM_FWUP_HANDLER = 0x0074               /**< Handler for executing PLDM-based firmware updates. */
+    ROT_MODULE_PLDM_FWUP_HANDLER = 0x0074,              /**< Handler for executing PLDM-based firmware updates. */
+	ROT_MODULE_HEAP_SEGREGATED_FIT = 0x0075,			/**< Heap allocator with segregated free lists. */
+	ROT_MODULE_OBJECT_POOL = 0x0076,					/**< Pool of fixed-size objects. */
+	ROT_MODULE_KEY_CACHE = 0x0077,						/**< Cache of prepared public keys. */
+	ROT_MODULE_HOST_FLASH_VERIFY_CACHE = 0x0078,		/**< Cache of verified host flash contents. */
+	ROT_MODULE_HOST_FLASH_VERIFY_WORKER = 0x0079,		/**< Task for parallel validation of host flash. */
 };
 
 
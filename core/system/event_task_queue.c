@@ -0,0 +1,318 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stddef.h>
+#include <string.h>
+#include "event_task_queue.h"
+#include "common/unused.h"
+
+
+/**
+ * Initialize a queue for event task notifications.
+ *
+ * @param queue The event queue to initialize.
+ * @param state Variable context for the queue.  This must be uninitialized.
+ * @param slots Storage for events that are waiting to be processed.
+ * @param slot_count The number of events that can be queued.  This includes the event that is
+ * currently being processed.
+ *
+ * @return 0 if the queue was initialized successfully or an error code.
+ */
+int event_task_queue_init (struct event_task_queue *queue, struct event_task_queue_state *state,
+	struct event_task_queue_slot *slots, size_t slot_count)
+{
+	if (queue == NULL) {
+		return EVENT_TASK_INVALID_ARGUMENT;
+	}
+
+	memset (queue, 0, sizeof (struct event_task_queue));
+
+	queue->state = state;
+	queue->slots = slots;
+	queue->slot_count = slot_count;
+
+	return event_task_queue_init_state (queue);
+}
+
+/**
+ * Initialize only the variable state for an event queue.  The rest of the queue is assumed to have
+ * already been initialized.
+ *
+ * This would generally be used with a statically initialized instance.
+ *
+ * @param queue The event queue that contains the state to initialize.
+ *
+ * @return 0 if the state was successfully initialized or an error code.
+ */
+int event_task_queue_init_state (const struct event_task_queue *queue)
+{
+	size_t i;
+
+	if ((queue == NULL) || (queue->state == NULL) || (queue->slots == NULL) ||
+		(queue->slot_count == 0)) {
+		return EVENT_TASK_INVALID_ARGUMENT;
+	}
+
+	memset (queue->state, 0, sizeof (struct event_task_queue_state));
+
+	for (i = 0; i < queue->slot_count; i++) {
+		queue->slots[i].next = i + 1;
+	}
+	queue->slots[queue->slot_count - 1].next = -1;
+
+	for (i = 0; i < EVENT_TASK_QUEUE_PRIORITY_LEVELS; i++) {
+		queue->state->head[i] = -1;
+		queue->state->tail[i] = -1;
+	}
+
+	queue->state->free = 0;
+	queue->state->reserved = -1;
+	queue->state->running = -1;
+
+	return 0;
+}
+
+/**
+ * Release the resources used by an event queue.
+ *
+ * @param queue The event queue to release.
+ */
+void event_task_queue_release (const struct event_task_queue *queue)
+{
+	UNUSED (queue);
+}
+
+/**
+ * Reserve an unused slot in the queue for a new event.  The event will not be queued for processing
+ * until {@link event_task_queue_push} is called.
+ *
+ * Only a single slot can be reserved at a time.
+ *
+ * @param queue The event queue to reserve a slot from.
+ * @param context Output for the event context to populate for the new event.
+ *
+ * @return 0 if an event slot was reserved or an error code.  If the queue is full or another slot
+ * is already reserved, EVENT_TASK_BUSY will be returned.
+ */
+int event_task_queue_reserve (const struct event_task_queue *queue,
+	struct event_task_context **context)
+{
+	int slot;
+
+	if ((queue == NULL) || (context == NULL)) {
+		return EVENT_TASK_INVALID_ARGUMENT;
+	}
+
+	*context = NULL;
+
+	if (queue->state->reserved >= 0) {
+		queue->state->stats.rejected_reserved++;
+		return EVENT_TASK_BUSY;
+	}
+
+	if (queue->state->free < 0) {
+		queue->state->stats.rejected_full++;
+		return EVENT_TASK_BUSY;
+	}
+
+	slot = queue->state->free;
+	queue->state->free = queue->slots[slot].next;
+	queue->state->reserved = slot;
+
+	*context = &queue->slots[slot].context;
+
+	return 0;
+}
+
+/**
+ * Add a slot to the list of unused slots.
+ *
+ * @param queue The event queue to update.
+ * @param slot The slot that is no longer in use.
+ */
+static void event_task_queue_free_slot (const struct event_task_queue *queue, int slot)
+{
+	queue->slots[slot].next = queue->state->free;
+	queue->state->free = slot;
+}
+
+/**
+ * Release a reserved slot without queuing an event.
+ *
+ * @param queue The event queue that has a reserved slot.
+ *
+ * @return 0 if the reserved slot was released or an error code.
+ */
+int event_task_queue_cancel (const struct event_task_queue *queue)
+{
+	if (queue == NULL) {
+		return EVENT_TASK_INVALID_ARGUMENT;
+	}
+
+	if (queue->state->reserved < 0) {
+		return EVENT_TASK_NOT_READY;
+	}
+
+	event_task_queue_free_slot (queue, queue->state->reserved);
+	queue->state->reserved = -1;
+
+	return 0;
+}
+
+/**
+ * Queue the event in the reserved slot for processing.
+ *
+ * @param queue The event queue that has a reserved slot.
+ * @param handler Index of the handler that will process the event.
+ * @param priority Priority level for the event.
+ *
+ * @return 0 if the event was queued or an error code.
+ */
+int event_task_queue_push (const struct event_task_queue *queue, int handler, uint8_t priority)
+{
+	struct event_task_queue_state *state;
+	int slot;
+
+	if ((queue == NULL) || (handler < 0) || (priority >= EVENT_TASK_QUEUE_PRIORITY_LEVELS)) {
+		return EVENT_TASK_INVALID_ARGUMENT;
+	}
+
+	state = queue->state;
+	if (state->reserved < 0) {
+		return EVENT_TASK_NOT_READY;
+	}
+
+	slot = state->reserved;
+	state->reserved = -1;
+
+	queue->slots[slot].handler = handler;
+	queue->slots[slot].next = -1;
+	platform_init_current_tick (&queue->slots[slot].queued);
+
+	if (state->tail[priority] >= 0) {
+		queue->slots[state->tail[priority]].next = slot;
+	}
+	else {
+		state->head[priority] = slot;
+	}
+	state->tail[priority] = slot;
+
+	state->stats.queued++;
+	state->stats.depth++;
+	if (state->stats.depth > state->stats.max_depth) {
+		state->stats.max_depth = state->stats.depth;
+	}
+
+	return 0;
+}
+
+/**
+ * Remove the next event from the queue for processing.  Events are removed in priority order.
+ * Events with the same priority are removed in the order they were queued.
+ *
+ * The event slot will remain in use until {@link event_task_queue_complete} is called.  Only one
+ * event can be processed at a time.
+ *
+ * @param queue The event queue to remove an event from.
+ * @param context Output for the context of the event to process.
+ *
+ * @return The index of the handler that will process the event or an error code.  If there are no
+ * events waiting, EVENT_TASK_QUEUE_EMPTY will be returned.  Use ROT_IS_ERROR to check the return
+ * value.
+ */
+int event_task_queue_pop (const struct event_task_queue *queue,
+	struct event_task_context **context)
+{
+	struct event_task_queue_state *state;
+	platform_clock now;
+	uint32_t latency;
+	int priority;
+	int slot;
+
+	if ((queue == NULL) || (context == NULL)) {
+		return EVENT_TASK_INVALID_ARGUMENT;
+	}
+
+	*context = NULL;
+
+	state = queue->state;
+	if (state->running >= 0) {
+		return EVENT_TASK_BUSY;
+	}
+
+	for (priority = EVENT_TASK_QUEUE_PRIORITY_HIGHEST; priority >= 0; priority--) {
+		if (state->head[priority] >= 0) {
+			break;
+		}
+	}
+
+	if (priority < 0) {
+		return EVENT_TASK_QUEUE_EMPTY;
+	}
+
+	slot = state->head[priority];
+	state->head[priority] = queue->slots[slot].next;
+	if (state->head[priority] < 0) {
+		state->tail[priority] = -1;
+	}
+
+	state->running = slot;
+
+	platform_init_current_tick (&now);
+	latency = platform_get_duration (&queue->slots[slot].queued, &now);
+
+	state->stats.depth--;
+	state->stats.dispatched++;
+	state->stats.total_latency_ms += latency;
+	if (latency > state->stats.max_latency_ms) {
+		state->stats.max_latency_ms = latency;
+	}
+
+	*context = &queue->slots[slot].context;
+
+	return queue->slots[slot].handler;
+}
+
+/**
+ * Indicate that processing has completed for the event most recently removed from the queue.  This
+ * makes the event slot available for new events.
+ *
+ * @param queue The event queue that has an event being processed.
+ *
+ * @return 0 if the event slot was released or an error code.
+ */
+int event_task_queue_complete (const struct event_task_queue *queue)
+{
+	if (queue == NULL) {
+		return EVENT_TASK_INVALID_ARGUMENT;
+	}
+
+	if (queue->state->running < 0) {
+		return EVENT_TASK_NOT_READY;
+	}
+
+	event_task_queue_free_slot (queue, queue->state->running);
+	queue->state->running = -1;
+
+	return 0;
+}
+
+/**
+ * Get the current counters for event queue activity.
+ *
+ * @param queue The event queue to query.
+ * @param stats Output for the queue counters.
+ *
+ * @return 0 if the counters were retrieved or an error code.
+ */
+int event_task_queue_get_stats (const struct event_task_queue *queue,
+	struct event_task_queue_stats *stats)
+{
+	if ((queue == NULL) || (stats == NULL)) {
+		return EVENT_TASK_INVALID_ARGUMENT;
+	}
+
+	*stats = queue->state->stats;
+
+	return 0;
+}
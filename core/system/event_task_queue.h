@@ -0,0 +1,103 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef EVENT_TASK_QUEUE_H_
+#define EVENT_TASK_QUEUE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include "platform_api.h"
+#include "system/event_task.h"
+
+
+/**
+ * The number of priority levels supported by the event queue.  Events at a higher priority level
+ * will be dispatched before any events at a lower level.  Events at the same level are dispatched
+ * in the order they were queued.
+ */
+#ifndef EVENT_TASK_QUEUE_PRIORITY_LEVELS
+#define	EVENT_TASK_QUEUE_PRIORITY_LEVELS		4
+#endif
+
+/**
+ * Lowest priority level for queued events.
+ */
+#define	EVENT_TASK_QUEUE_PRIORITY_NORMAL		0
+
+/**
+ * Highest priority level for queued events.
+ */
+#define	EVENT_TASK_QUEUE_PRIORITY_HIGHEST		(EVENT_TASK_QUEUE_PRIORITY_LEVELS - 1)
+
+
+/**
+ * Storage for a single event waiting in the queue.
+ */
+struct event_task_queue_slot {
+	struct event_task_context context;			/**< Context for the event handler. */
+	int handler;								/**< Index of the handler that will process the event. */
+	int next;									/**< Index of the next slot in the same list. */
+	platform_clock queued;						/**< Time the event was added to the queue. */
+};
+
+/**
+ * Counters for event queue activity.
+ */
+struct event_task_queue_stats {
+	uint32_t depth;								/**< Number of events currently waiting for dispatch. */
+	uint32_t max_depth;							/**< The largest number of events that have been waiting. */
+	uint32_t queued;							/**< Total number of events added to the queue. */
+	uint32_t rejected_full;						/**< Number of events rejected because the queue was full. */
+	uint32_t rejected_reserved;					/**< Number of events rejected because a slot was already reserved. */
+	uint32_t dispatched;						/**< Total number of events removed for processing. */
+	uint32_t max_latency_ms;					/**< Longest time an event waited before dispatch. */
+	uint32_t total_latency_ms;					/**< Sum of the wait time for all dispatched events. */
+};
+
+/**
+ * Variable context for an event queue.
+ */
+struct event_task_queue_state {
+	int free;									/**< First slot in the list of unused slots. */
+	int head[EVENT_TASK_QUEUE_PRIORITY_LEVELS];	/**< First queued slot at each priority level. */
+	int tail[EVENT_TASK_QUEUE_PRIORITY_LEVELS];	/**< Last queued slot at each priority level. */
+	int reserved;								/**< Slot provided for a new event notification. */
+	int running;								/**< Slot currently being processed by a handler. */
+	struct event_task_queue_stats stats;		/**< Counters for queue activity. */
+};
+
+/**
+ * A bounded queue of event contexts waiting to be processed by an event task.  This allows an
+ * event task to accept new notifications while a handler is executing, rather than rejecting them
+ * until the task is idle again.
+ *
+ * All storage for queued events is provided by the caller, so no memory is allocated after
+ * initialization.  The queue provides no synchronization.  The event task using the queue is
+ * responsible for serializing access, which is generally done using the task lock.
+ */
+struct event_task_queue {
+	struct event_task_queue_state *state;		/**< Variable context for the queue. */
+	struct event_task_queue_slot *slots;		/**< Storage for queued events. */
+	size_t slot_count;							/**< Number of events that can be queued. */
+};
+
+
+int event_task_queue_init (struct event_task_queue *queue, struct event_task_queue_state *state,
+	struct event_task_queue_slot *slots, size_t slot_count);
+int event_task_queue_init_state (const struct event_task_queue *queue);
+void event_task_queue_release (const struct event_task_queue *queue);
+
+int event_task_queue_reserve (const struct event_task_queue *queue,
+	struct event_task_context **context);
+int event_task_queue_cancel (const struct event_task_queue *queue);
+int event_task_queue_push (const struct event_task_queue *queue, int handler, uint8_t priority);
+
+int event_task_queue_pop (const struct event_task_queue *queue,
+	struct event_task_context **context);
+int event_task_queue_complete (const struct event_task_queue *queue);
+
+int event_task_queue_get_stats (const struct event_task_queue *queue,
+	struct event_task_queue_stats *stats);
+
+
+#endif /* EVENT_TASK_QUEUE_H_ */
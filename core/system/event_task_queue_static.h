@@ -0,0 +1,27 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef EVENT_TASK_QUEUE_STATIC_H_
+#define EVENT_TASK_QUEUE_STATIC_H_
+
+#include "system/event_task_queue.h"
+
+
+/**
+ * Initialize a static instance of an event queue.  This does not initialize the queue state.  This
+ * can be a constant instance.
+ *
+ * There is no validation done on the arguments.
+ *
+ * @param state_ptr Variable context for the queue.
+ * @param slots_ptr Storage for the events that can be queued.
+ * @param count The number of slots available for queued events.
+ */
+#define	event_task_queue_static_init(state_ptr, slots_ptr, count)	{ \
+		.state = state_ptr, \
+		.slots = slots_ptr, \
+		.slot_count = count \
+	}
+
+
+#endif /* EVENT_TASK_QUEUE_STATIC_H_ */
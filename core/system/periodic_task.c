@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT license.
 
+#include <string.h>
 #include "periodic_task.h"
 #include "system_logging.h"
 
@@ -87,3 +88,436 @@ int periodic_task_execute_next_handler (const struct periodic_task_handler **han
 
 	return 0;
 }
+
+/**
+ * Initialize a scheduler for executing periodic handlers.
+ *
+ * @param scheduler The scheduler to initialize.
+ * @param state Variable context for the scheduler.  This must be uninitialized.
+ * @param handlers The list of handlers that will be executed.  Null entries in the list are
+ * allowed and will be ignored.
+ * @param num_handlers The number of handlers in the list.
+ * @param schedule Storage for the handler schedule.  This must contain an entry for every handler.
+ * @param stats Optional storage for handler timing statistics.  If this is not null, it must
+ * contain an entry for every handler.  Set to null to not collect statistics.
+ *
+ * @return 0 if the scheduler was initialized successfully or an error code.
+ */
+int periodic_task_scheduler_init (struct periodic_task_scheduler *scheduler,
+	struct periodic_task_scheduler_state *state, const struct periodic_task_handler **handlers,
+	size_t num_handlers, struct periodic_task_schedule_entry *schedule,
+	struct periodic_task_handler_stats *stats)
+{
+	if (scheduler == NULL) {
+		return PERIODIC_TASK_INVALID_ARGUMENT;
+	}
+
+	memset (scheduler, 0, sizeof (struct periodic_task_scheduler));
+
+	scheduler->state = state;
+	scheduler->handlers = handlers;
+	scheduler->num_handlers = num_handlers;
+	scheduler->schedule = schedule;
+	scheduler->stats = stats;
+
+	return periodic_task_scheduler_init_state (scheduler);
+}
+
+/**
+ * Initialize only the variable state for a periodic task scheduler.  The rest of the scheduler is
+ * assumed to have already been initialized.
+ *
+ * This would generally be used with a statically initialized instance.
+ *
+ * @param scheduler The scheduler that contains the state to initialize.
+ *
+ * @return 0 if the state was successfully initialized or an error code.
+ */
+int periodic_task_scheduler_init_state (const struct periodic_task_scheduler *scheduler)
+{
+	int status;
+
+	if ((scheduler == NULL) || (scheduler->state == NULL) || (scheduler->handlers == NULL) ||
+		(scheduler->num_handlers == 0) || (scheduler->schedule == NULL)) {
+		return PERIODIC_TASK_INVALID_ARGUMENT;
+	}
+
+	memset (scheduler->state, 0, sizeof (struct periodic_task_scheduler_state));
+	if (scheduler->stats) {
+		memset (scheduler->stats, 0,
+			sizeof (struct periodic_task_handler_stats) * scheduler->num_handlers);
+	}
+
+	scheduler->state->resync = true;
+
+	status = platform_semaphore_init (&scheduler->state->wake);
+	if (status != 0) {
+		return status;
+	}
+
+	status = platform_mutex_init (&scheduler->state->lock);
+	if (status != 0) {
+		platform_semaphore_free (&scheduler->state->wake);
+	}
+
+	return status;
+}
+
+/**
+ * Release the resources used by a periodic task scheduler.  No handlers will be released.
+ *
+ * @param scheduler The scheduler to release.
+ */
+void periodic_task_scheduler_release (const struct periodic_task_scheduler *scheduler)
+{
+	if (scheduler) {
+		platform_semaphore_free (&scheduler->state->wake);
+		platform_mutex_free (&scheduler->state->lock);
+	}
+}
+
+/**
+ * Determine the histogram bucket for a duration.
+ *
+ * @param duration_ms The duration to categorize.
+ *
+ * @return The histogram bucket that should count the duration.
+ */
+static size_t periodic_task_histogram_bucket (uint32_t duration_ms)
+{
+	size_t bucket = 0;
+
+	while ((duration_ms != 0) && (bucket < (PERIODIC_TASK_HISTOGRAM_BUCKETS - 1))) {
+		duration_ms >>= 1;
+		bucket++;
+	}
+
+	return bucket;
+}
+
+/**
+ * Add an entry to the handler schedule.  The entry will be placed after all existing entries with
+ * the same or earlier deadline, so handlers that are ready at the same time are executed in turn.
+ *
+ * @param scheduler The scheduler to update.
+ * @param handler Index of the handler to add.
+ * @param deadline Time the handler needs to run, relative to the schedule base time.
+ */
+static void periodic_task_scheduler_insert (const struct periodic_task_scheduler *scheduler,
+	size_t handler, uint32_t deadline)
+{
+	size_t pos = scheduler->state->active;
+
+	while ((pos > 0) && (scheduler->schedule[pos - 1].deadline > deadline)) {
+		scheduler->schedule[pos] = scheduler->schedule[pos - 1];
+		pos--;
+	}
+
+	scheduler->schedule[pos].deadline = deadline;
+	scheduler->schedule[pos].handler = handler;
+	scheduler->state->active++;
+}
+
+/**
+ * Determine the deadline for a handler, relative to the schedule base time.
+ *
+ * @param handler The handler to query.
+ * @param elapsed The current time, relative to the schedule base time.
+ * @param deadline Output for the handler deadline.
+ *
+ * @return 0 if the deadline was determined successfully or an error code.
+ */
+static int periodic_task_scheduler_get_deadline (const struct periodic_task_handler *handler,
+	uint32_t elapsed, uint32_t *deadline)
+{
+	const platform_clock *next_time = handler->get_next_execution (handler);
+	uint32_t remaining = 0;
+	int status;
+
+	if (next_time != NULL) {
+		status = platform_get_timeout_remaining (next_time, &remaining);
+		if (status != 0) {
+			return status;
+		}
+	}
+
+	if (remaining > (UINT32_MAX - elapsed)) {
+		*deadline = UINT32_MAX;
+	}
+	else {
+		*deadline = elapsed + remaining;
+	}
+
+	return 0;
+}
+
+/**
+ * Rebuild the schedule by querying the next execution time for every handler.
+ *
+ * @param scheduler The scheduler to update.
+ *
+ * @return 0 if the schedule was rebuilt successfully or an error code.
+ */
+static int periodic_task_scheduler_resync (const struct periodic_task_scheduler *scheduler)
+{
+	uint32_t deadline;
+	size_t i;
+	int status;
+
+	/* Clear any pending wake requests before querying the handlers.  Any request received after
+	 * this point will trigger another resync. */
+	platform_semaphore_reset (&scheduler->state->wake);
+
+	platform_init_current_tick (&scheduler->state->base);
+	scheduler->state->active = 0;
+	scheduler->state->resync = true;
+
+	for (i = 0; i < scheduler->num_handlers; i++) {
+		if (scheduler->handlers[i] != NULL) {
+			status = periodic_task_scheduler_get_deadline (scheduler->handlers[i], 0, &deadline);
+			if (status != 0) {
+				return status;
+			}
+
+			periodic_task_scheduler_insert (scheduler, i, deadline);
+		}
+	}
+
+	if (scheduler->state->active == 0) {
+		return PERIODIC_TASK_NO_HANDLERS;
+	}
+
+	scheduler->state->resync = false;
+
+	return 0;
+}
+
+/**
+ * Get the amount of time since the schedule base time.
+ *
+ * @param scheduler The scheduler to query.
+ *
+ * @return The elapsed time, in milliseconds.
+ */
+static uint32_t periodic_task_scheduler_get_elapsed (const struct periodic_task_scheduler *scheduler)
+{
+	platform_clock now;
+
+	platform_init_current_tick (&now);
+
+	return platform_get_duration (&scheduler->state->base, &now);
+}
+
+/**
+ * Update the timing statistics for a handler that was executed.
+ *
+ * @param scheduler The scheduler that executed the handler.
+ * @param handler Index of the handler that was executed.
+ * @param lateness_ms The time between when the handler was due and when it was executed.
+ * @param execution_ms The time spent executing the handler.
+ */
+static void periodic_task_scheduler_update_stats (const struct periodic_task_scheduler *scheduler,
+	size_t handler, uint32_t lateness_ms, uint32_t execution_ms)
+{
+	struct periodic_task_handler_stats *stats = &scheduler->stats[handler];
+
+	platform_mutex_lock (&scheduler->state->lock);
+
+	stats->executions++;
+	stats->execution_ms[periodic_task_histogram_bucket (execution_ms)]++;
+	stats->lateness_ms[periodic_task_histogram_bucket (lateness_ms)]++;
+
+	if (execution_ms > stats->max_execution_ms) {
+		stats->max_execution_ms = execution_ms;
+	}
+	if (lateness_ms > stats->max_lateness_ms) {
+		stats->max_lateness_ms = lateness_ms;
+	}
+
+	platform_mutex_unlock (&scheduler->state->lock);
+}
+
+/**
+ * Wait for the next handler to be ready for execution, then execute it.  Handlers that are ready at
+ * the same time will be executed in turn.
+ *
+ * While waiting, the scheduler can be woken by {@link periodic_task_wake}, which will cause the
+ * next execution time for all handlers to be queried again.  The same will happen periodically,
+ * based on PERIODIC_TASK_RESYNC_MS.  Otherwise, only the handler that was executed will be queried
+ * for its next execution time.
+ *
+ * @param scheduler The scheduler to use for handler execution.
+ *
+ * @return 0 if the next handler was executed or an error code.  This does not report status of the
+ * handler, just whether a handler was executed or not.
+ */
+int periodic_task_scheduler_execute_next (const struct periodic_task_scheduler *scheduler)
+{
+	struct periodic_task_scheduler_state *state;
+	const struct periodic_task_handler *next;
+	platform_clock start;
+	platform_clock end;
+	uint32_t elapsed;
+	uint32_t deadline;
+	size_t index;
+	size_t i;
+	int status;
+
+	if (scheduler == NULL) {
+		return PERIODIC_TASK_INVALID_ARGUMENT;
+	}
+
+	state = scheduler->state;
+
+	while (1) {
+		if (state->resync || (platform_semaphore_try_wait (&state->wake) == 0)) {
+			status = periodic_task_scheduler_resync (scheduler);
+			if (status != 0) {
+				return status;
+			}
+		}
+
+		elapsed = periodic_task_scheduler_get_elapsed (scheduler);
+		if (scheduler->schedule[0].deadline <= elapsed) {
+			break;
+		}
+		else if (elapsed >= PERIODIC_TASK_RESYNC_MS) {
+			state->resync = true;
+			continue;
+		}
+
+		/* Don't wait past the next resync so handler changes that didn't wake the scheduler will
+		 * still be picked up. */
+		deadline = scheduler->schedule[0].deadline;
+		if (deadline > PERIODIC_TASK_RESYNC_MS) {
+			deadline = PERIODIC_TASK_RESYNC_MS;
+		}
+
+		status = platform_semaphore_wait (&state->wake, deadline - elapsed);
+		if (status == 0) {
+			state->resync = true;
+		}
+		else if (status != 1) {
+			return status;
+		}
+	}
+
+	index = scheduler->schedule[0].handler;
+	next = scheduler->handlers[index];
+
+	platform_init_current_tick (&start);
+	next->execute (next);
+	platform_init_current_tick (&end);
+
+	if (scheduler->stats) {
+		periodic_task_scheduler_update_stats (scheduler, index,
+			elapsed - scheduler->schedule[0].deadline, platform_get_duration (&start, &end));
+	}
+
+	/* Remove the executed handler from the schedule and add it back based on its new deadline. */
+	state->active--;
+	for (i = 0; i < state->active; i++) {
+		scheduler->schedule[i] = scheduler->schedule[i + 1];
+	}
+
+	elapsed = periodic_task_scheduler_get_elapsed (scheduler);
+	status = periodic_task_scheduler_get_deadline (next, elapsed, &deadline);
+	if (status != 0) {
+		state->resync = true;
+		return status;
+	}
+
+	periodic_task_scheduler_insert (scheduler, index, deadline);
+
+	return 0;
+}
+
+/**
+ * Wake a scheduler that is waiting for the next handler to be ready.  This will cause the next
+ * execution time for every handler to be queried again.  If the scheduler is not currently waiting,
+ * the schedule will be rebuilt before the next handler is selected.
+ *
+ * This must not be called from an interrupt context.
+ *
+ * @param scheduler The scheduler to wake.
+ *
+ * @return 0 if the scheduler was woken successfully or an error code.
+ */
+int periodic_task_wake (const struct periodic_task_scheduler *scheduler)
+{
+	if (scheduler == NULL) {
+		return PERIODIC_TASK_INVALID_ARGUMENT;
+	}
+
+	return platform_semaphore_post (&scheduler->state->wake);
+}
+
+/**
+ * Wake a scheduler that is waiting for the next handler to be ready.  This is the same as
+ * {@link periodic_task_wake}, but can be called from an interrupt context.
+ *
+ * @param scheduler The scheduler to wake.
+ *
+ * @return 0 if the scheduler was woken successfully or an error code.
+ */
+int periodic_task_wake_from_isr (const struct periodic_task_scheduler *scheduler)
+{
+	if (scheduler == NULL) {
+		return PERIODIC_TASK_INVALID_ARGUMENT;
+	}
+
+	return platform_semaphore_post_from_isr (&scheduler->state->wake);
+}
+
+/**
+ * Get the timing statistics for a single handler.  These can be used to tune handler execution
+ * intervals and task priorities.
+ *
+ * @param scheduler The scheduler to query.
+ * @param handler Index of the handler in the scheduler's handler list.
+ * @param stats Output for the handler statistics.
+ *
+ * @return 0 if the statistics were retrieved or an error code.
+ */
+int periodic_task_scheduler_get_stats (const struct periodic_task_scheduler *scheduler,
+	size_t handler, struct periodic_task_handler_stats *stats)
+{
+	if ((scheduler == NULL) || (stats == NULL) || (handler >= scheduler->num_handlers)) {
+		return PERIODIC_TASK_INVALID_ARGUMENT;
+	}
+
+	if (scheduler->stats == NULL) {
+		return PERIODIC_TASK_NO_STATS;
+	}
+
+	platform_mutex_lock (&scheduler->state->lock);
+	*stats = scheduler->stats[handler];
+	platform_mutex_unlock (&scheduler->state->lock);
+
+	return 0;
+}
+
+/**
+ * Clear the timing statistics for all handlers.
+ *
+ * @param scheduler The scheduler to update.
+ *
+ * @return 0 if the statistics were cleared or an error code.
+ */
+int periodic_task_scheduler_reset_stats (const struct periodic_task_scheduler *scheduler)
+{
+	if (scheduler == NULL) {
+		return PERIODIC_TASK_INVALID_ARGUMENT;
+	}
+
+	if (scheduler->stats == NULL) {
+		return PERIODIC_TASK_NO_STATS;
+	}
+
+	platform_mutex_lock (&scheduler->state->lock);
+	memset (scheduler->stats, 0,
+		sizeof (struct periodic_task_handler_stats) * scheduler->num_handlers);
+	platform_mutex_unlock (&scheduler->state->lock);
+
+	return 0;
+}
@@ -6,6 +6,7 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include <stdbool.h>
 #include "status/rot_status.h"
 #include "platform_api.h"
 
@@ -45,10 +46,91 @@ struct periodic_task_handler {
 };
 
 
+/**
+ * The number of buckets in each timing histogram.  Bucket 0 counts durations less than 1ms.  Each
+ * following bucket n counts durations from 2^(n-1) to (2^n)-1 ms, with the last bucket counting all
+ * longer durations.
+ */
+#define	PERIODIC_TASK_HISTOGRAM_BUCKETS		10
+
+/**
+ * The maximum amount of time the scheduler will use a cached handler schedule.  After this time,
+ * the execution time for every handler will be queried again.
+ */
+#ifndef PERIODIC_TASK_RESYNC_MS
+#define	PERIODIC_TASK_RESYNC_MS				1000
+#endif
+
+/**
+ * Timing statistics for a single handler executed by a scheduler.
+ */
+struct periodic_task_handler_stats {
+	uint32_t executions;									/**< Number of times the handler was executed. */
+	uint32_t max_execution_ms;								/**< The longest execution time for the handler. */
+	uint32_t max_lateness_ms;								/**< The longest delay after the handler was due to run. */
+	uint32_t execution_ms[PERIODIC_TASK_HISTOGRAM_BUCKETS];	/**< Histogram of handler execution times. */
+	uint32_t lateness_ms[PERIODIC_TASK_HISTOGRAM_BUCKETS];	/**< Histogram of delays after the handler was due. */
+};
+
+/**
+ * An entry in the schedule of handler execution.
+ */
+struct periodic_task_schedule_entry {
+	uint32_t deadline;				/**< Time the handler needs to run, relative to the schedule base time. */
+	size_t handler;					/**< Index of the handler in the list. */
+};
+
+/**
+ * Variable context for a periodic task scheduler.
+ */
+struct periodic_task_scheduler_state {
+	platform_semaphore wake;		/**< Signal to interrupt the scheduler while waiting. */
+	platform_mutex lock;			/**< Synchronization for handler statistics. */
+	platform_clock base;			/**< Reference time for the handler schedule. */
+	size_t active;					/**< The number of handlers in the schedule. */
+	bool resync;					/**< Flag to indicate the schedule must be rebuilt. */
+};
+
+/**
+ * Scheduler for executing a list of periodic handlers.  Handlers are kept ordered by the time they
+ * next need to run, so only the handler that was executed needs to be queried after each
+ * execution.  While waiting for the next handler, the scheduler can be woken to rebuild the
+ * schedule.
+ *
+ * A handler whose execution time changes for any reason other than its own execution, such as a
+ * handler that is triggered by an external event, must call {@link periodic_task_wake} to make the
+ * scheduler aware of the change.  Otherwise, the change will not be seen until the next periodic
+ * resync of the schedule.
+ */
+struct periodic_task_scheduler {
+	struct periodic_task_scheduler_state *state;		/**< Variable context for the scheduler. */
+	const struct periodic_task_handler **handlers;		/**< List of handlers to execute. */
+	size_t num_handlers;								/**< Number of handlers in the list. */
+	struct periodic_task_schedule_entry *schedule;		/**< Schedule storage, one entry per handler. */
+	struct periodic_task_handler_stats *stats;			/**< Optional timing statistics, one entry per handler. */
+};
+
+
 void periodic_task_prepare_handlers (const struct periodic_task_handler **handlers, size_t count);
 int periodic_task_execute_next_handler (const struct periodic_task_handler **handlers,
 	size_t count);
 
+int periodic_task_scheduler_init (struct periodic_task_scheduler *scheduler,
+	struct periodic_task_scheduler_state *state, const struct periodic_task_handler **handlers,
+	size_t num_handlers, struct periodic_task_schedule_entry *schedule,
+	struct periodic_task_handler_stats *stats);
+int periodic_task_scheduler_init_state (const struct periodic_task_scheduler *scheduler);
+void periodic_task_scheduler_release (const struct periodic_task_scheduler *scheduler);
+
+int periodic_task_scheduler_execute_next (const struct periodic_task_scheduler *scheduler);
+
+int periodic_task_wake (const struct periodic_task_scheduler *scheduler);
+int periodic_task_wake_from_isr (const struct periodic_task_scheduler *scheduler);
+
+int periodic_task_scheduler_get_stats (const struct periodic_task_scheduler *scheduler,
+	size_t handler, struct periodic_task_handler_stats *stats);
+int periodic_task_scheduler_reset_stats (const struct periodic_task_scheduler *scheduler);
+
 
 #define	PERIODIC_TASK_ERROR(code)		ROT_ERROR (ROT_MODULE_PERIODIC_TASK, code)
 
@@ -59,6 +141,7 @@ enum {
 	PERIODIC_TASK_INVALID_ARGUMENT = PERIODIC_TASK_ERROR (0x00),	/**< Input parameter is null or not valid. */
 	PERIODIC_TASK_NO_MEMORY = PERIODIC_TASK_ERROR (0x01),			/**< Memory allocation failed. */
 	PERIODIC_TASK_NO_HANDLERS = PERIODIC_TASK_ERROR (0x02),			/**< A list of handlers only contains null pointers. */
+	PERIODIC_TASK_NO_STATS = PERIODIC_TASK_ERROR (0x03),			/**< Handler statistics are not being collected. */
 };
 
 
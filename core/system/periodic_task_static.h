@@ -0,0 +1,34 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef PERIODIC_TASK_STATIC_H_
+#define PERIODIC_TASK_STATIC_H_
+
+#include "system/periodic_task.h"
+
+
+/**
+ * Initialize a static instance of a periodic task scheduler.  This does not initialize the
+ * scheduler state.  This can be a constant instance.
+ *
+ * There is no validation done on the arguments.
+ *
+ * @param state_ptr Variable context for the scheduler.
+ * @param handlers_list The list of handlers that will be executed.
+ * @param count The number of handlers in the list.
+ * @param schedule_ptr Storage for the handler schedule.  This must contain an entry for every
+ * handler.
+ * @param stats_ptr Optional storage for handler timing statistics.  This must contain an entry for
+ * every handler or be null.
+ */
+#define	periodic_task_scheduler_static_init(state_ptr, handlers_list, count, schedule_ptr, \
+	stats_ptr)	{ \
+		.state = state_ptr, \
+		.handlers = handlers_list, \
+		.num_handlers = count, \
+		.schedule = schedule_ptr, \
+		.stats = stats_ptr \
+	}
+
+
+#endif /* PERIODIC_TASK_STATIC_H_ */
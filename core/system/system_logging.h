@@ -14,6 +14,7 @@ enum {
 	SYSTEM_LOGGING_RESET_NOT_EXECUTED,		/**< Failed to schedule a device reset. */
 	SYSTEM_LOGGING_RESET_FAIL,				/**< Failed to reset the device. */
 	SYSTEM_LOGGING_PERIODIC_FAILED,			/**< A periodic task failed to execute a handler. */
+	SYSTEM_LOGGING_ENTRIES_SUPPRESSED,		/**< Repeated debug log entries were dropped by the rate limiter. */
 };
 
 
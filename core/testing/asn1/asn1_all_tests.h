@@ -54,6 +54,12 @@ static void add_all_asn1_tests (CuSuite *suite)
 	!defined TESTING_SKIP_ECC_DER_UTIL_SUITE
 	TESTING_RUN_SUITE (ecc_der_util);
 #endif
+#if (defined TESTING_RUN_X509_CACHE_SUITE || \
+		defined TESTING_RUN_ALL_TESTS || defined TESTING_RUN_ALL_CORE_TESTS || \
+		(!defined TESTING_SKIP_ALL_TESTS && !defined TESTING_SKIP_ALL_CORE_TESTS)) && \
+	!defined TESTING_SKIP_X509_CACHE_SUITE
+	TESTING_RUN_SUITE (x509_cache);
+#endif
 #if (defined TESTING_RUN_X509_CERT_BUILD_SUITE || \
 		defined TESTING_RUN_ALL_TESTS || defined TESTING_RUN_ALL_CORE_TESTS || \
 		(!defined TESTING_SKIP_ALL_TESTS && !defined TESTING_SKIP_ALL_CORE_TESTS)) && \
@@ -0,0 +1,1205 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "testing.h"
+#include "asn1/x509_cache.h"
+#include "asn1/x509_cache_static.h"
+#include "testing/engines/hash_testing_engine.h"
+#include "testing/mock/asn1/x509_mock.h"
+#include "testing/mock/crypto/hash_mock.h"
+#include "testing/asn1/x509_testing.h"
+
+
+TEST_SUITE_LABEL ("x509_cache");
+
+
+/**
+ * Number of entries in the cache used for testing.
+ */
+#define	X509_CACHE_TESTING_ENTRIES		8
+
+
+/**
+ * Dependencies for testing the X.509 certificate cache.
+ */
+struct x509_cache_testing {
+	HASH_TESTING_ENGINE hash;										/**< Hash engine for certificate identifiers. */
+	struct x509_engine_mock x509;									/**< Mock for the target X.509 engine. */
+	struct key_cache_entry entries[X509_CACHE_TESTING_ENTRIES];		/**< Storage for cache entries. */
+	struct x509_engine_cache_state state;							/**< Variable context for the cache. */
+	struct x509_engine_cache test;									/**< X.509 cache under test. */
+};
+
+
+/**
+ * Initialize all dependencies for testing.
+ *
+ * @param test The testing framework.
+ * @param cache Testing dependencies to initialize.
+ */
+static void x509_cache_testing_init_dependencies (CuTest *test, struct x509_cache_testing *cache)
+{
+	int status;
+
+	status = HASH_TESTING_ENGINE_INIT (&cache->hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = x509_mock_init (&cache->x509);
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Initialize an X.509 cache for testing.
+ *
+ * @param test The testing framework.
+ * @param cache Testing components to initialize.
+ * @param count The number of cache entries to use.
+ */
+static void x509_cache_testing_init (CuTest *test, struct x509_cache_testing *cache, size_t count)
+{
+	int status;
+
+	x509_cache_testing_init_dependencies (test, cache);
+
+	status = x509_cache_init (&cache->test, &cache->state, &cache->x509.base, &cache->hash.base,
+		cache->entries, count);
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Release all testing dependencies and validate all mocks.
+ *
+ * @param test The testing framework.
+ * @param cache Testing dependencies to release.
+ */
+static void x509_cache_testing_release_dependencies (CuTest *test,
+	struct x509_cache_testing *cache)
+{
+	int status;
+
+	status = x509_mock_validate_and_release (&cache->x509);
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&cache->hash);
+}
+
+/**
+ * Release an X.509 cache and all testing dependencies.
+ *
+ * @param test The testing framework.
+ * @param cache Testing components to release.
+ */
+static void x509_cache_testing_release (CuTest *test, struct x509_cache_testing *cache)
+{
+	x509_cache_testing_release_dependencies (test, cache);
+	x509_cache_release (&cache->test);
+}
+
+/**
+ * Create a certificate store containing a root CA and intermediate CA and load an end entity
+ * certificate.
+ *
+ * @param test The testing framework.
+ * @param cache Testing components.
+ * @param store Output for the certificate store.
+ * @param cert Output for the end entity certificate.
+ * @param leaf The DER end entity certificate to load.
+ * @param leaf_length Length of the end entity certificate.
+ * @param cas_cached Flag indicating if the CAs are expected to be in the cache.
+ */
+static void x509_cache_testing_load_chain (CuTest *test, struct x509_cache_testing *cache,
+	struct x509_ca_certs *store, struct x509_certificate *cert, const uint8_t *leaf,
+	size_t leaf_length, bool cas_cached)
+{
+	int status;
+
+	status = mock_expect (&cache->x509.mock, cache->x509.base.init_ca_cert_store, &cache->x509, 0,
+		MOCK_ARG_NOT_NULL);
+
+	if (!cas_cached) {
+		status |= mock_expect (&cache->x509.mock, cache->x509.base.add_root_ca, &cache->x509, 0,
+			MOCK_ARG_NOT_NULL, MOCK_ARG_PTR (X509_CERTSS_ECC_CA_DER),
+			MOCK_ARG (X509_CERTSS_ECC_CA_DER_LEN));
+		status |= mock_expect (&cache->x509.mock, cache->x509.base.add_intermediate_ca,
+			&cache->x509, 0, MOCK_ARG_NOT_NULL, MOCK_ARG_PTR (X509_CERTCA_ECC_CA_DER),
+			MOCK_ARG (X509_CERTCA_ECC_CA_DER_LEN));
+	}
+
+	status |= mock_expect (&cache->x509.mock, cache->x509.base.load_certificate, &cache->x509, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG_PTR (leaf), MOCK_ARG (leaf_length));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = cache->test.base.init_ca_cert_store (&cache->test.base, store);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrNotNull (test, store->context);
+
+	status = cache->test.base.add_root_ca (&cache->test.base, store, X509_CERTSS_ECC_CA_DER,
+		X509_CERTSS_ECC_CA_DER_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cache->test.base.add_intermediate_ca (&cache->test.base, store,
+		X509_CERTCA_ECC_CA_DER, X509_CERTCA_ECC_CA_DER_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cache->test.base.load_certificate (&cache->test.base, cert, leaf, leaf_length);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrNotNull (test, cert->context);
+
+	status = mock_validate (&cache->x509.mock);
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Set expectations for the cached CAs to be provided to the target engine.
+ *
+ * @param test The testing framework.
+ * @param cache Testing components.
+ */
+static void x509_cache_testing_expect_cached_cas (CuTest *test, struct x509_cache_testing *cache)
+{
+	int status;
+
+	status = mock_expect (&cache->x509.mock, cache->x509.base.add_root_ca, &cache->x509, 0,
+		MOCK_ARG_NOT_NULL,
+		MOCK_ARG_PTR_CONTAINS (X509_CERTSS_ECC_CA_DER, X509_CERTSS_ECC_CA_DER_LEN),
+		MOCK_ARG (X509_CERTSS_ECC_CA_DER_LEN));
+	status |= mock_expect (&cache->x509.mock, cache->x509.base.add_intermediate_ca, &cache->x509,
+		0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG_PTR_CONTAINS (X509_CERTCA_ECC_CA_DER, X509_CERTCA_ECC_CA_DER_LEN),
+		MOCK_ARG (X509_CERTCA_ECC_CA_DER_LEN));
+
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Release a certificate store and end entity certificate.
+ *
+ * @param test The testing framework.
+ * @param cache Testing components.
+ * @param store The certificate store to release.
+ * @param cert The end entity certificate to release.
+ */
+static void x509_cache_testing_release_chain (CuTest *test, struct x509_cache_testing *cache,
+	struct x509_ca_certs *store, struct x509_certificate *cert)
+{
+	int status;
+
+	status = mock_expect (&cache->x509.mock, cache->x509.base.release_certificate, &cache->x509, 0,
+		MOCK_ARG_PTR (cert->context));
+	status |= mock_expect (&cache->x509.mock, cache->x509.base.release_ca_cert_store,
+		&cache->x509, 0, MOCK_ARG_PTR (store->context));
+
+	CuAssertIntEquals (test, 0, status);
+
+	cache->test.base.release_certificate (&cache->test.base, cert);
+	CuAssertPtrEquals (test, NULL, cert->context);
+
+	cache->test.base.release_ca_cert_store (&cache->test.base, store);
+	CuAssertPtrEquals (test, NULL, store->context);
+
+	status = mock_validate (&cache->x509.mock);
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Authenticate a chain that is not in the cache.
+ *
+ * @param test The testing framework.
+ * @param cache Testing components.
+ * @param leaf The DER end entity certificate to authenticate.
+ * @param leaf_length Length of the end entity certificate.
+ * @param cas_cached Flag indicating if the CAs are expected to be in the cache.
+ */
+static void x509_cache_testing_authenticate_not_cached (CuTest *test,
+	struct x509_cache_testing *cache, const uint8_t *leaf, size_t leaf_length, bool cas_cached)
+{
+	struct x509_ca_certs store;
+	struct x509_certificate cert;
+	int status;
+
+	x509_cache_testing_load_chain (test, cache, &store, &cert, leaf, leaf_length, cas_cached);
+
+	if (cas_cached) {
+		x509_cache_testing_expect_cached_cas (test, cache);
+	}
+
+	status = mock_expect (&cache->x509.mock, cache->x509.base.authenticate, &cache->x509, 0,
+		MOCK_ARG_PTR (cert.context), MOCK_ARG_PTR (store.context));
+	CuAssertIntEquals (test, 0, status);
+
+	status = cache->test.base.authenticate (&cache->test.base, &cert, &store);
+	CuAssertIntEquals (test, 0, status);
+
+	x509_cache_testing_release_chain (test, cache, &store, &cert);
+}
+
+/**
+ * Authenticate a chain that is in the cache.
+ *
+ * @param test The testing framework.
+ * @param cache Testing components.
+ * @param leaf The DER end entity certificate to authenticate.
+ * @param leaf_length Length of the end entity certificate.
+ */
+static void x509_cache_testing_authenticate_cached (CuTest *test,
+	struct x509_cache_testing *cache, const uint8_t *leaf, size_t leaf_length)
+{
+	struct x509_ca_certs store;
+	struct x509_certificate cert;
+	int status;
+
+	x509_cache_testing_load_chain (test, cache, &store, &cert, leaf, leaf_length, true);
+
+	status = cache->test.base.authenticate (&cache->test.base, &cert, &store);
+	CuAssertIntEquals (test, 0, status);
+
+	x509_cache_testing_release_chain (test, cache, &store, &cert);
+}
+
+
+/*******************
+ * Test cases
+ *******************/
+
+static void x509_cache_test_init (CuTest *test)
+{
+	struct x509_cache_testing cache;
+	int status;
+
+	TEST_START;
+
+	x509_cache_testing_init_dependencies (test, &cache);
+
+	status = x509_cache_init (&cache.test, &cache.state, &cache.x509.base, &cache.hash.base,
+		cache.entries, X509_CACHE_TESTING_ENTRIES);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrNotNull (test, cache.test.base.create_csr);
+	CuAssertPtrNotNull (test, cache.test.base.create_self_signed_certificate);
+	CuAssertPtrNotNull (test, cache.test.base.create_ca_signed_certificate);
+	CuAssertPtrNotNull (test, cache.test.base.load_certificate);
+	CuAssertPtrNotNull (test, cache.test.base.release_certificate);
+	CuAssertPtrNotNull (test, cache.test.base.get_certificate_der);
+	CuAssertPtrNotNull (test, cache.test.base.get_certificate_version);
+	CuAssertPtrNotNull (test, cache.test.base.get_serial_number);
+	CuAssertPtrNotNull (test, cache.test.base.get_public_key_type);
+	CuAssertPtrNotNull (test, cache.test.base.get_public_key_length);
+	CuAssertPtrNotNull (test, cache.test.base.get_public_key);
+	CuAssertPtrNotNull (test, cache.test.base.add_root_ca);
+	CuAssertPtrNotNull (test, cache.test.base.init_ca_cert_store);
+	CuAssertPtrNotNull (test, cache.test.base.release_ca_cert_store);
+	CuAssertPtrNotNull (test, cache.test.base.add_intermediate_ca);
+	CuAssertPtrNotNull (test, cache.test.base.authenticate);
+
+	CuAssertPtrEquals (test, NULL, cache.test.base_cfm.on_cfm_verified);
+	CuAssertPtrNotNull (test, cache.test.base_cfm.on_cfm_activated);
+	CuAssertPtrNotNull (test, cache.test.base_cfm.on_clear_active);
+	CuAssertPtrEquals (test, NULL, cache.test.base_cfm.on_cfm_activation_request);
+
+	x509_cache_testing_release (test, &cache);
+}
+
+static void x509_cache_test_init_null (CuTest *test)
+{
+	struct x509_cache_testing cache;
+	int status;
+
+	TEST_START;
+
+	x509_cache_testing_init_dependencies (test, &cache);
+
+	status = x509_cache_init (NULL, &cache.state, &cache.x509.base, &cache.hash.base,
+		cache.entries, X509_CACHE_TESTING_ENTRIES);
+	CuAssertIntEquals (test, X509_ENGINE_INVALID_ARGUMENT, status);
+
+	status = x509_cache_init (&cache.test, NULL, &cache.x509.base, &cache.hash.base,
+		cache.entries, X509_CACHE_TESTING_ENTRIES);
+	CuAssertIntEquals (test, X509_ENGINE_INVALID_ARGUMENT, status);
+
+	status = x509_cache_init (&cache.test, &cache.state, NULL, &cache.hash.base,
+		cache.entries, X509_CACHE_TESTING_ENTRIES);
+	CuAssertIntEquals (test, X509_ENGINE_INVALID_ARGUMENT, status);
+
+	status = x509_cache_init (&cache.test, &cache.state, &cache.x509.base, NULL,
+		cache.entries, X509_CACHE_TESTING_ENTRIES);
+	CuAssertIntEquals (test, X509_ENGINE_INVALID_ARGUMENT, status);
+
+	status = x509_cache_init (&cache.test, &cache.state, &cache.x509.base, &cache.hash.base,
+		NULL, X509_CACHE_TESTING_ENTRIES);
+	CuAssertIntEquals (test, X509_ENGINE_INVALID_ARGUMENT, status);
+
+	status = x509_cache_init (&cache.test, &cache.state, &cache.x509.base, &cache.hash.base,
+		cache.entries, 0);
+	CuAssertIntEquals (test, X509_ENGINE_INVALID_ARGUMENT, status);
+
+	x509_cache_testing_release_dependencies (test, &cache);
+}
+
+static void x509_cache_test_static_init (CuTest *test)
+{
+	struct x509_cache_testing cache;
+	struct x509_engine_cache test_static = x509_cache_static_init (&cache.state,
+		&cache.x509.base, &cache.hash.base, cache.entries, X509_CACHE_TESTING_ENTRIES);
+	int status;
+
+	TEST_START;
+
+	CuAssertPtrNotNull (test, test_static.base.create_csr);
+	CuAssertPtrNotNull (test, test_static.base.create_self_signed_certificate);
+	CuAssertPtrNotNull (test, test_static.base.create_ca_signed_certificate);
+	CuAssertPtrNotNull (test, test_static.base.load_certificate);
+	CuAssertPtrNotNull (test, test_static.base.release_certificate);
+	CuAssertPtrNotNull (test, test_static.base.get_certificate_der);
+	CuAssertPtrNotNull (test, test_static.base.get_certificate_version);
+	CuAssertPtrNotNull (test, test_static.base.get_serial_number);
+	CuAssertPtrNotNull (test, test_static.base.get_public_key_type);
+	CuAssertPtrNotNull (test, test_static.base.get_public_key_length);
+	CuAssertPtrNotNull (test, test_static.base.get_public_key);
+	CuAssertPtrNotNull (test, test_static.base.add_root_ca);
+	CuAssertPtrNotNull (test, test_static.base.init_ca_cert_store);
+	CuAssertPtrNotNull (test, test_static.base.release_ca_cert_store);
+	CuAssertPtrNotNull (test, test_static.base.add_intermediate_ca);
+	CuAssertPtrNotNull (test, test_static.base.authenticate);
+
+	CuAssertPtrEquals (test, NULL, test_static.base_cfm.on_cfm_verified);
+	CuAssertPtrNotNull (test, test_static.base_cfm.on_cfm_activated);
+	CuAssertPtrNotNull (test, test_static.base_cfm.on_clear_active);
+	CuAssertPtrEquals (test, NULL, test_static.base_cfm.on_cfm_activation_request);
+
+	x509_cache_testing_init_dependencies (test, &cache);
+
+	status = x509_cache_init_state (&test_static);
+	CuAssertIntEquals (test, 0, status);
+
+	cache.test = test_static;
+
+	x509_cache_testing_authenticate_not_cached (test, &cache, X509_CERTCA_ECC_EE_DER,
+		X509_CERTCA_ECC_EE_DER_LEN, false);
+	x509_cache_testing_authenticate_cached (test, &cache, X509_CERTCA_ECC_EE_DER,
+		X509_CERTCA_ECC_EE_DER_LEN);
+
+	x509_cache_testing_release (test, &cache);
+}
+
+static void x509_cache_test_static_init_null (CuTest *test)
+{
+	struct x509_cache_testing cache;
+	struct x509_engine_cache null_state = x509_cache_static_init ((struct x509_engine_cache_state*) NULL,
+		&cache.x509.base, &cache.hash.base, cache.entries, X509_CACHE_TESTING_ENTRIES);
+	struct x509_engine_cache null_target = x509_cache_static_init (&cache.state, NULL,
+		&cache.hash.base, cache.entries, X509_CACHE_TESTING_ENTRIES);
+	struct x509_engine_cache null_hash = x509_cache_static_init (&cache.state, &cache.x509.base,
+		NULL, cache.entries, X509_CACHE_TESTING_ENTRIES);
+	struct x509_engine_cache null_entries = x509_cache_static_init (&cache.state,
+		&cache.x509.base, &cache.hash.base, NULL, X509_CACHE_TESTING_ENTRIES);
+	struct x509_engine_cache no_entries = x509_cache_static_init (&cache.state,
+		&cache.x509.base, &cache.hash.base, cache.entries, 0);
+	int status;
+
+	TEST_START;
+
+	x509_cache_testing_init_dependencies (test, &cache);
+
+	status = x509_cache_init_state (NULL);
+	CuAssertIntEquals (test, X509_ENGINE_INVALID_ARGUMENT, status);
+
+	status = x509_cache_init_state (&null_state);
+	CuAssertIntEquals (test, X509_ENGINE_INVALID_ARGUMENT, status);
+
+	status = x509_cache_init_state (&null_target);
+	CuAssertIntEquals (test, X509_ENGINE_INVALID_ARGUMENT, status);
+
+	status = x509_cache_init_state (&null_hash);
+	CuAssertIntEquals (test, X509_ENGINE_INVALID_ARGUMENT, status);
+
+	status = x509_cache_init_state (&null_entries);
+	CuAssertIntEquals (test, X509_ENGINE_INVALID_ARGUMENT, status);
+
+	status = x509_cache_init_state (&no_entries);
+	CuAssertIntEquals (test, X509_ENGINE_INVALID_ARGUMENT, status);
+
+	x509_cache_testing_release_dependencies (test, &cache);
+}
+
+static void x509_cache_test_release_null (CuTest *test)
+{
+	TEST_START;
+
+	x509_cache_release (NULL);
+}
+
+static void x509_cache_test_load_certificate (CuTest *test)
+{
+	struct x509_cache_testing cache;
+	struct x509_certificate cert;
+	int status;
+
+	TEST_START;
+
+	x509_cache_testing_init (test, &cache, X509_CACHE_TESTING_ENTRIES);
+
+	status = mock_expect (&cache.x509.mock, cache.x509.base.load_certificate, &cache.x509, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG_PTR (X509_CERTCA_ECC_EE_DER),
+		MOCK_ARG (X509_CERTCA_ECC_EE_DER_LEN));
+	CuAssertIntEquals (test, 0, status);
+
+	status = cache.test.base.load_certificate (&cache.test.base, &cert, X509_CERTCA_ECC_EE_DER,
+		X509_CERTCA_ECC_EE_DER_LEN);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrNotNull (test, cert.context);
+
+	status = mock_validate (&cache.x509.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&cache.x509.mock, cache.x509.base.release_certificate, &cache.x509, 0,
+		MOCK_ARG_PTR (cert.context));
+	CuAssertIntEquals (test, 0, status);
+
+	cache.test.base.release_certificate (&cache.test.base, &cert);
+	CuAssertPtrEquals (test, NULL, cert.context);
+
+	x509_cache_testing_release (test, &cache);
+}
+
+static void x509_cache_test_load_certificate_null (CuTest *test)
+{
+	struct x509_cache_testing cache;
+	struct x509_certificate cert;
+	int status;
+
+	TEST_START;
+
+	x509_cache_testing_init (test, &cache, X509_CACHE_TESTING_ENTRIES);
+
+	status = cache.test.base.load_certificate (NULL, &cert, X509_CERTCA_ECC_EE_DER,
+		X509_CERTCA_ECC_EE_DER_LEN);
+	CuAssertIntEquals (test, X509_ENGINE_INVALID_ARGUMENT, status);
+
+	status = cache.test.base.load_certificate (&cache.test.base, NULL, X509_CERTCA_ECC_EE_DER,
+		X509_CERTCA_ECC_EE_DER_LEN);
+	CuAssertIntEquals (test, X509_ENGINE_INVALID_ARGUMENT, status);
+
+	status = cache.test.base.load_certificate (&cache.test.base, &cert, NULL,
+		X509_CERTCA_ECC_EE_DER_LEN);
+	CuAssertIntEquals (test, X509_ENGINE_INVALID_ARGUMENT, status);
+
+	status = cache.test.base.load_certificate (&cache.test.base, &cert, X509_CERTCA_ECC_EE_DER,
+		0);
+	CuAssertIntEquals (test, X509_ENGINE_INVALID_ARGUMENT, status);
+
+	x509_cache_testing_release (test, &cache);
+}
+
+static void x509_cache_test_load_certificate_error (CuTest *test)
+{
+	struct x509_cache_testing cache;
+	struct x509_certificate cert;
+	int status;
+
+	TEST_START;
+
+	x509_cache_testing_init (test, &cache, X509_CACHE_TESTING_ENTRIES);
+
+	status = mock_expect (&cache.x509.mock, cache.x509.base.load_certificate, &cache.x509,
+		X509_ENGINE_LOAD_FAILED, MOCK_ARG_NOT_NULL, MOCK_ARG_PTR (X509_CERTCA_ECC_EE_DER),
+		MOCK_ARG (X509_CERTCA_ECC_EE_DER_LEN));
+	CuAssertIntEquals (test, 0, status);
+
+	status = cache.test.base.load_certificate (&cache.test.base, &cert, X509_CERTCA_ECC_EE_DER,
+		X509_CERTCA_ECC_EE_DER_LEN);
+	CuAssertIntEquals (test, X509_ENGINE_LOAD_FAILED, status);
+
+	x509_cache_testing_release (test, &cache);
+}
+
+static void x509_cache_test_load_certificate_hash_error (CuTest *test)
+{
+	struct x509_cache_testing cache;
+	struct hash_engine_mock hash;
+	struct x509_certificate cert;
+	int status;
+
+	TEST_START;
+
+	x509_cache_testing_init_dependencies (test, &cache);
+
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = x509_cache_init (&cache.test, &cache.state, &cache.x509.base, &hash.base,
+		cache.entries, X509_CACHE_TESTING_ENTRIES);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, HASH_ENGINE_START_SHA256_FAILED);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cache.test.base.load_certificate (&cache.test.base, &cert, X509_CERTCA_ECC_EE_DER,
+		X509_CERTCA_ECC_EE_DER_LEN);
+	CuAssertIntEquals (test, HASH_ENGINE_START_SHA256_FAILED, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	x509_cache_testing_release (test, &cache);
+}
+
+static void x509_cache_test_release_certificate_null (CuTest *test)
+{
+	struct x509_cache_testing cache;
+	struct x509_certificate cert = {0};
+
+	TEST_START;
+
+	x509_cache_testing_init (test, &cache, X509_CACHE_TESTING_ENTRIES);
+
+	cache.test.base.release_certificate (NULL, &cert);
+	cache.test.base.release_certificate (&cache.test.base, NULL);
+	cache.test.base.release_certificate (&cache.test.base, &cert);
+
+	x509_cache_testing_release (test, &cache);
+}
+
+static void x509_cache_test_create_csr (CuTest *test)
+{
+	struct x509_cache_testing cache;
+	uint8_t *csr = NULL;
+	size_t length;
+	int status;
+
+	TEST_START;
+
+	x509_cache_testing_init (test, &cache, X509_CACHE_TESTING_ENTRIES);
+
+	status = mock_expect (&cache.x509.mock, cache.x509.base.create_csr, &cache.x509, 0,
+		MOCK_ARG_PTR (ECC_PRIVKEY_DER), MOCK_ARG (ECC_PRIVKEY_DER_LEN), MOCK_ARG (HASH_TYPE_SHA256),
+		MOCK_ARG_PTR (X509_SUBJECT_NAME), MOCK_ARG (X509_CERT_CA), MOCK_ARG_PTR (X509_EKU_OID),
+		MOCK_ARG (X509_EKU_OID_LEN), MOCK_ARG_PTR (NULL), MOCK_ARG (0), MOCK_ARG_PTR (&csr),
+		MOCK_ARG_PTR (&length));
+	CuAssertIntEquals (test, 0, status);
+
+	status = cache.test.base.create_csr (&cache.test.base, ECC_PRIVKEY_DER, ECC_PRIVKEY_DER_LEN,
+		HASH_TYPE_SHA256, X509_SUBJECT_NAME, X509_CERT_CA, X509_EKU_OID, X509_EKU_OID_LEN, NULL, 0,
+		&csr, &length);
+	CuAssertIntEquals (test, 0, status);
+
+	x509_cache_testing_release (test, &cache);
+}
+
+static void x509_cache_test_create_ca_signed_certificate (CuTest *test)
+{
+	struct x509_cache_testing cache;
+	struct x509_certificate ca_cert;
+	struct x509_certificate cert;
+	int status;
+
+	TEST_START;
+
+	x509_cache_testing_init (test, &cache, X509_CACHE_TESTING_ENTRIES);
+
+	status = mock_expect (&cache.x509.mock, cache.x509.base.create_self_signed_certificate,
+		&cache.x509, 0, MOCK_ARG_NOT_NULL, MOCK_ARG_PTR (ECC_PRIVKEY_DER),
+		MOCK_ARG (ECC_PRIVKEY_DER_LEN), MOCK_ARG (HASH_TYPE_SHA256), MOCK_ARG_PTR (X509_SERIAL_NUM),
+		MOCK_ARG (X509_SERIAL_NUM_LEN), MOCK_ARG_PTR (X509_CA2_SUBJECT_NAME), MOCK_ARG (X509_CERT_CA),
+		MOCK_ARG_PTR (NULL), MOCK_ARG (0));
+	CuAssertIntEquals (test, 0, status);
+
+	status = cache.test.base.create_self_signed_certificate (&cache.test.base, &ca_cert,
+		ECC_PRIVKEY_DER, ECC_PRIVKEY_DER_LEN, HASH_TYPE_SHA256, X509_SERIAL_NUM,
+		X509_SERIAL_NUM_LEN, X509_CA2_SUBJECT_NAME, X509_CERT_CA, NULL, 0);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrNotNull (test, ca_cert.context);
+
+	status = mock_expect (&cache.x509.mock, cache.x509.base.create_ca_signed_certificate,
+		&cache.x509, 0, MOCK_ARG_NOT_NULL, MOCK_ARG_PTR (ECC_PUBKEY2_DER),
+		MOCK_ARG (ECC_PUBKEY2_DER_LEN), MOCK_ARG_PTR (X509_SERIAL_NUM),
+		MOCK_ARG (X509_SERIAL_NUM_LEN), MOCK_ARG_PTR (X509_SUBJECT_NAME),
+		MOCK_ARG (X509_CERT_END_ENTITY), MOCK_ARG_PTR (ECC_PRIVKEY_DER),
+		MOCK_ARG (ECC_PRIVKEY_DER_LEN), MOCK_ARG (HASH_TYPE_SHA256), MOCK_ARG_PTR (ca_cert.context),
+		MOCK_ARG_PTR (NULL), MOCK_ARG (0));
+	CuAssertIntEquals (test, 0, status);
+
+	status = cache.test.base.create_ca_signed_certificate (&cache.test.base, &cert,
+		ECC_PUBKEY2_DER, ECC_PUBKEY2_DER_LEN, X509_SERIAL_NUM, X509_SERIAL_NUM_LEN,
+		X509_SUBJECT_NAME, X509_CERT_END_ENTITY, ECC_PRIVKEY_DER, ECC_PRIVKEY_DER_LEN,
+		HASH_TYPE_SHA256, &ca_cert, NULL, 0);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrNotNull (test, cert.context);
+
+	status = mock_expect (&cache.x509.mock, cache.x509.base.release_certificate, &cache.x509, 0,
+		MOCK_ARG_PTR (cert.context));
+	status |= mock_expect (&cache.x509.mock, cache.x509.base.release_certificate, &cache.x509, 0,
+		MOCK_ARG_PTR (ca_cert.context));
+	CuAssertIntEquals (test, 0, status);
+
+	cache.test.base.release_certificate (&cache.test.base, &cert);
+	cache.test.base.release_certificate (&cache.test.base, &ca_cert);
+
+	x509_cache_testing_release (test, &cache);
+}
+
+static void x509_cache_test_get_public_key (CuTest *test)
+{
+	struct x509_cache_testing cache;
+	struct x509_certificate cert;
+	uint8_t *key = NULL;
+	size_t length;
+	int status;
+
+	TEST_START;
+
+	x509_cache_testing_init (test, &cache, X509_CACHE_TESTING_ENTRIES);
+
+	status = mock_expect (&cache.x509.mock, cache.x509.base.load_certificate, &cache.x509, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG_PTR (X509_CERTCA_ECC_EE_DER),
+		MOCK_ARG (X509_CERTCA_ECC_EE_DER_LEN));
+	CuAssertIntEquals (test, 0, status);
+
+	status = cache.test.base.load_certificate (&cache.test.base, &cert, X509_CERTCA_ECC_EE_DER,
+		X509_CERTCA_ECC_EE_DER_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&cache.x509.mock, cache.x509.base.get_public_key_type, &cache.x509,
+		X509_PUBLIC_KEY_ECC, MOCK_ARG_PTR (cert.context));
+	status |= mock_expect (&cache.x509.mock, cache.x509.base.get_public_key_length, &cache.x509,
+		256, MOCK_ARG_PTR (cert.context));
+	status |= mock_expect (&cache.x509.mock, cache.x509.base.get_public_key, &cache.x509, 0,
+		MOCK_ARG_PTR (cert.context), MOCK_ARG_PTR (&key), MOCK_ARG_PTR (&length));
+	status |= mock_expect (&cache.x509.mock, cache.x509.base.get_certificate_version, &cache.x509,
+		X509_VERSION_3, MOCK_ARG_PTR (cert.context));
+	CuAssertIntEquals (test, 0, status);
+
+	status = cache.test.base.get_public_key_type (&cache.test.base, &cert);
+	CuAssertIntEquals (test, X509_PUBLIC_KEY_ECC, status);
+
+	status = cache.test.base.get_public_key_length (&cache.test.base, &cert);
+	CuAssertIntEquals (test, 256, status);
+
+	status = cache.test.base.get_public_key (&cache.test.base, &cert, &key, &length);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cache.test.base.get_certificate_version (&cache.test.base, &cert);
+	CuAssertIntEquals (test, X509_VERSION_3, status);
+
+	status = mock_expect (&cache.x509.mock, cache.x509.base.release_certificate, &cache.x509, 0,
+		MOCK_ARG_PTR (cert.context));
+	CuAssertIntEquals (test, 0, status);
+
+	cache.test.base.release_certificate (&cache.test.base, &cert);
+
+	x509_cache_testing_release (test, &cache);
+}
+
+static void x509_cache_test_init_ca_cert_store_error (CuTest *test)
+{
+	struct x509_cache_testing cache;
+	struct x509_ca_certs store;
+	int status;
+
+	TEST_START;
+
+	x509_cache_testing_init (test, &cache, X509_CACHE_TESTING_ENTRIES);
+
+	status = mock_expect (&cache.x509.mock, cache.x509.base.init_ca_cert_store, &cache.x509,
+		X509_ENGINE_INIT_STORE_FAILED, MOCK_ARG_NOT_NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cache.test.base.init_ca_cert_store (&cache.test.base, &store);
+	CuAssertIntEquals (test, X509_ENGINE_INIT_STORE_FAILED, status);
+
+	status = cache.test.base.init_ca_cert_store (NULL, &store);
+	CuAssertIntEquals (test, X509_ENGINE_INVALID_ARGUMENT, status);
+
+	status = cache.test.base.init_ca_cert_store (&cache.test.base, NULL);
+	CuAssertIntEquals (test, X509_ENGINE_INVALID_ARGUMENT, status);
+
+	x509_cache_testing_release (test, &cache);
+}
+
+static void x509_cache_test_authenticate (CuTest *test)
+{
+	struct x509_cache_testing cache;
+	struct key_cache_stats stats;
+	int status;
+
+	TEST_START;
+
+	x509_cache_testing_init (test, &cache, X509_CACHE_TESTING_ENTRIES);
+
+	x509_cache_testing_authenticate_not_cached (test, &cache, X509_CERTCA_ECC_EE_DER,
+		X509_CERTCA_ECC_EE_DER_LEN, false);
+	x509_cache_testing_authenticate_cached (test, &cache, X509_CERTCA_ECC_EE_DER,
+		X509_CERTCA_ECC_EE_DER_LEN);
+	x509_cache_testing_authenticate_cached (test, &cache, X509_CERTCA_ECC_EE_DER,
+		X509_CERTCA_ECC_EE_DER_LEN);
+
+	status = x509_cache_get_stats (&cache.test, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 6, stats.hits);
+	CuAssertIntEquals (test, 0, stats.evictions);
+
+	x509_cache_testing_release (test, &cache);
+}
+
+static void x509_cache_test_authenticate_different_leaf (CuTest *test)
+{
+	struct x509_cache_testing cache;
+
+	TEST_START;
+
+	x509_cache_testing_init (test, &cache, X509_CACHE_TESTING_ENTRIES);
+
+	x509_cache_testing_authenticate_not_cached (test, &cache, X509_CERTCA_ECC_EE_DER,
+		X509_CERTCA_ECC_EE_DER_LEN, false);
+
+	/* The CAs are known, but the chain must still be validated by the target engine. */
+	x509_cache_testing_authenticate_not_cached (test, &cache, X509_CERTCA_RSA_EE_DER,
+		X509_CERTCA_RSA_EE_DER_LEN, true);
+
+	x509_cache_testing_authenticate_cached (test, &cache, X509_CERTCA_ECC_EE_DER,
+		X509_CERTCA_ECC_EE_DER_LEN);
+	x509_cache_testing_authenticate_cached (test, &cache, X509_CERTCA_RSA_EE_DER,
+		X509_CERTCA_RSA_EE_DER_LEN);
+
+	x509_cache_testing_release (test, &cache);
+}
+
+static void x509_cache_test_authenticate_extra_data_after_certificate (CuTest *test)
+{
+	struct x509_cache_testing cache;
+	struct x509_ca_certs store;
+	struct x509_certificate cert;
+	uint8_t chain[X509_CERTSS_ECC_CA_DER_LEN + X509_CERTCA_ECC_CA_DER_LEN];
+	int status;
+
+	TEST_START;
+
+	memcpy (chain, X509_CERTSS_ECC_CA_DER, X509_CERTSS_ECC_CA_DER_LEN);
+	memcpy (&chain[X509_CERTSS_ECC_CA_DER_LEN], X509_CERTCA_ECC_CA_DER,
+		X509_CERTCA_ECC_CA_DER_LEN);
+
+	x509_cache_testing_init (test, &cache, X509_CACHE_TESTING_ENTRIES);
+
+	x509_cache_testing_authenticate_not_cached (test, &cache, X509_CERTCA_ECC_EE_DER,
+		X509_CERTCA_ECC_EE_DER_LEN, false);
+
+	/* The root CA is identified by the certificate, not the buffer length. */
+	status = mock_expect (&cache.x509.mock, cache.x509.base.init_ca_cert_store, &cache.x509, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect (&cache.x509.mock, cache.x509.base.load_certificate, &cache.x509, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG_PTR (X509_CERTCA_ECC_EE_DER),
+		MOCK_ARG (X509_CERTCA_ECC_EE_DER_LEN));
+	CuAssertIntEquals (test, 0, status);
+
+	status = cache.test.base.init_ca_cert_store (&cache.test.base, &store);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cache.test.base.add_root_ca (&cache.test.base, &store, chain, sizeof (chain));
+	CuAssertIntEquals (test, 0, status);
+
+	status = cache.test.base.add_intermediate_ca (&cache.test.base, &store,
+		&chain[X509_CERTSS_ECC_CA_DER_LEN], X509_CERTCA_ECC_CA_DER_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cache.test.base.load_certificate (&cache.test.base, &cert, X509_CERTCA_ECC_EE_DER,
+		X509_CERTCA_ECC_EE_DER_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	/* The source buffer is not needed after it has been added to the store. */
+	memset (chain, 0, sizeof (chain));
+
+	status = cache.test.base.authenticate (&cache.test.base, &cert, &store);
+	CuAssertIntEquals (test, 0, status);
+
+	x509_cache_testing_release_chain (test, &cache, &store, &cert);
+
+	x509_cache_testing_release (test, &cache);
+}
+
+static void x509_cache_test_authenticate_root_as_intermediate (CuTest *test)
+{
+	struct x509_cache_testing cache;
+	struct x509_ca_certs store;
+	int status;
+
+	TEST_START;
+
+	x509_cache_testing_init (test, &cache, X509_CACHE_TESTING_ENTRIES);
+
+	x509_cache_testing_authenticate_not_cached (test, &cache, X509_CERTCA_ECC_EE_DER,
+		X509_CERTCA_ECC_EE_DER_LEN, false);
+
+	/* A certificate cached as a root CA is not trusted in a different role. */
+	status = mock_expect (&cache.x509.mock, cache.x509.base.init_ca_cert_store, &cache.x509, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect (&cache.x509.mock, cache.x509.base.add_intermediate_ca, &cache.x509,
+		X509_ENGINE_IS_SELF_SIGNED, MOCK_ARG_NOT_NULL, MOCK_ARG_PTR (X509_CERTSS_ECC_CA_DER),
+		MOCK_ARG (X509_CERTSS_ECC_CA_DER_LEN));
+	status |= mock_expect (&cache.x509.mock, cache.x509.base.release_ca_cert_store, &cache.x509,
+		0, MOCK_ARG_NOT_NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cache.test.base.init_ca_cert_store (&cache.test.base, &store);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cache.test.base.add_intermediate_ca (&cache.test.base, &store,
+		X509_CERTSS_ECC_CA_DER, X509_CERTSS_ECC_CA_DER_LEN);
+	CuAssertIntEquals (test, X509_ENGINE_IS_SELF_SIGNED, status);
+
+	cache.test.base.release_ca_cert_store (&cache.test.base, &store);
+
+	/* A known intermediate CA presented as the root CA must be verified as a root. */
+	status = mock_expect (&cache.x509.mock, cache.x509.base.init_ca_cert_store, &cache.x509, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect (&cache.x509.mock, cache.x509.base.add_root_ca, &cache.x509,
+		X509_ENGINE_NOT_SELF_SIGNED, MOCK_ARG_NOT_NULL, MOCK_ARG_PTR (X509_CERTCA_ECC_CA_DER),
+		MOCK_ARG (X509_CERTCA_ECC_CA_DER_LEN));
+	status |= mock_expect (&cache.x509.mock, cache.x509.base.release_ca_cert_store, &cache.x509,
+		0, MOCK_ARG_NOT_NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cache.test.base.init_ca_cert_store (&cache.test.base, &store);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cache.test.base.add_root_ca (&cache.test.base, &store, X509_CERTCA_ECC_CA_DER,
+		X509_CERTCA_ECC_CA_DER_LEN);
+	CuAssertIntEquals (test, X509_ENGINE_NOT_SELF_SIGNED, status);
+
+	cache.test.base.release_ca_cert_store (&cache.test.base, &store);
+
+	x509_cache_testing_release (test, &cache);
+}
+
+static void x509_cache_test_authenticate_failure_not_cached (CuTest *test)
+{
+	struct x509_cache_testing cache;
+	struct x509_ca_certs store;
+	struct x509_certificate cert;
+	int status;
+
+	TEST_START;
+
+	x509_cache_testing_init (test, &cache, X509_CACHE_TESTING_ENTRIES);
+
+	x509_cache_testing_load_chain (test, &cache, &store, &cert, X509_CERTCA_ECC_EE_DER,
+		X509_CERTCA_ECC_EE_DER_LEN, false);
+
+	status = mock_expect (&cache.x509.mock, cache.x509.base.authenticate, &cache.x509,
+		X509_ENGINE_CERT_NOT_VALID, MOCK_ARG_PTR (cert.context), MOCK_ARG_PTR (store.context));
+	CuAssertIntEquals (test, 0, status);
+
+	status = cache.test.base.authenticate (&cache.test.base, &cert, &store);
+	CuAssertIntEquals (test, X509_ENGINE_CERT_NOT_VALID, status);
+
+	x509_cache_testing_release_chain (test, &cache, &store, &cert);
+
+	/* Neither the chain nor the CAs were cached. */
+	x509_cache_testing_authenticate_not_cached (test, &cache, X509_CERTCA_ECC_EE_DER,
+		X509_CERTCA_ECC_EE_DER_LEN, false);
+
+	x509_cache_testing_release (test, &cache);
+}
+
+static void x509_cache_test_authenticate_cached_ca_error (CuTest *test)
+{
+	struct x509_cache_testing cache;
+	struct x509_ca_certs store;
+	struct x509_certificate cert;
+	int status;
+
+	TEST_START;
+
+	x509_cache_testing_init (test, &cache, X509_CACHE_TESTING_ENTRIES);
+
+	x509_cache_testing_authenticate_not_cached (test, &cache, X509_CERTCA_ECC_EE_DER,
+		X509_CERTCA_ECC_EE_DER_LEN, false);
+
+	x509_cache_testing_load_chain (test, &cache, &store, &cert, X509_CERTCA_RSA_EE_DER,
+		X509_CERTCA_RSA_EE_DER_LEN, true);
+
+	status = mock_expect (&cache.x509.mock, cache.x509.base.add_root_ca, &cache.x509,
+		X509_ENGINE_ROOT_CA_FAILED, MOCK_ARG_NOT_NULL,
+		MOCK_ARG_PTR_CONTAINS (X509_CERTSS_ECC_CA_DER, X509_CERTSS_ECC_CA_DER_LEN),
+		MOCK_ARG (X509_CERTSS_ECC_CA_DER_LEN));
+	CuAssertIntEquals (test, 0, status);
+
+	status = cache.test.base.authenticate (&cache.test.base, &cert, &store);
+	CuAssertIntEquals (test, X509_ENGINE_ROOT_CA_FAILED, status);
+
+	x509_cache_testing_release_chain (test, &cache, &store, &cert);
+
+	x509_cache_testing_release (test, &cache);
+}
+
+static void x509_cache_test_authenticate_unknown_certificate_length (CuTest *test)
+{
+	struct x509_cache_testing cache;
+	struct x509_ca_certs store;
+	struct x509_certificate cert;
+	int status;
+
+	TEST_START;
+
+	x509_cache_testing_init (test, &cache, X509_CACHE_TESTING_ENTRIES);
+
+	/* A root CA with a truncated length can't be identified, so the store is never cached. */
+	status = mock_expect (&cache.x509.mock, cache.x509.base.init_ca_cert_store, &cache.x509, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect (&cache.x509.mock, cache.x509.base.add_root_ca, &cache.x509, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG_PTR (X509_CERTSS_ECC_CA_DER),
+		MOCK_ARG (X509_CERTSS_ECC_CA_DER_LEN - 1));
+	status |= mock_expect (&cache.x509.mock, cache.x509.base.add_intermediate_ca, &cache.x509, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG_PTR (X509_CERTCA_ECC_CA_DER),
+		MOCK_ARG (X509_CERTCA_ECC_CA_DER_LEN));
+	status |= mock_expect (&cache.x509.mock, cache.x509.base.load_certificate, &cache.x509, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG_PTR (X509_CERTCA_ECC_EE_DER),
+		MOCK_ARG (X509_CERTCA_ECC_EE_DER_LEN));
+	CuAssertIntEquals (test, 0, status);
+
+	status = cache.test.base.init_ca_cert_store (&cache.test.base, &store);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cache.test.base.add_root_ca (&cache.test.base, &store, X509_CERTSS_ECC_CA_DER,
+		X509_CERTSS_ECC_CA_DER_LEN - 1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cache.test.base.add_intermediate_ca (&cache.test.base, &store,
+		X509_CERTCA_ECC_CA_DER, X509_CERTCA_ECC_CA_DER_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cache.test.base.load_certificate (&cache.test.base, &cert, X509_CERTCA_ECC_EE_DER,
+		X509_CERTCA_ECC_EE_DER_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&cache.x509.mock, cache.x509.base.authenticate, &cache.x509, 0,
+		MOCK_ARG_PTR (cert.context), MOCK_ARG_PTR (store.context));
+	CuAssertIntEquals (test, 0, status);
+
+	status = cache.test.base.authenticate (&cache.test.base, &cert, &store);
+	CuAssertIntEquals (test, 0, status);
+
+	x509_cache_testing_release_chain (test, &cache, &store, &cert);
+
+	/* Nothing was cached from the failed attempt. */
+	x509_cache_testing_authenticate_not_cached (test, &cache, X509_CERTCA_ECC_EE_DER,
+		X509_CERTCA_ECC_EE_DER_LEN, false);
+
+	x509_cache_testing_release (test, &cache);
+}
+
+static void x509_cache_test_authenticate_eviction (CuTest *test)
+{
+	struct x509_cache_testing cache;
+	struct key_cache_stats stats;
+	int status;
+
+	TEST_START;
+
+	/* Each chain needs one entry for each CA and one for the chain. */
+	x509_cache_testing_init (test, &cache, 3);
+
+	x509_cache_testing_authenticate_not_cached (test, &cache, X509_CERTCA_ECC_EE_DER,
+		X509_CERTCA_ECC_EE_DER_LEN, false);
+	x509_cache_testing_authenticate_not_cached (test, &cache, X509_CERTCA_RSA_EE_DER,
+		X509_CERTCA_RSA_EE_DER_LEN, true);
+	x509_cache_testing_authenticate_cached (test, &cache, X509_CERTCA_RSA_EE_DER,
+		X509_CERTCA_RSA_EE_DER_LEN);
+
+	/* The first chain was the least recently used entry. */
+	x509_cache_testing_authenticate_not_cached (test, &cache, X509_CERTCA_ECC_EE_DER,
+		X509_CERTCA_ECC_EE_DER_LEN, true);
+
+	status = x509_cache_get_stats (&cache.test, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 2, stats.evictions);
+
+	x509_cache_testing_release (test, &cache);
+}
+
+static void x509_cache_test_authenticate_null (CuTest *test)
+{
+	struct x509_cache_testing cache;
+	struct x509_ca_certs store;
+	struct x509_certificate cert;
+	struct x509_ca_certs empty_store = {0};
+	struct x509_certificate empty_cert = {0};
+	int status;
+
+	TEST_START;
+
+	x509_cache_testing_init (test, &cache, X509_CACHE_TESTING_ENTRIES);
+
+	x509_cache_testing_load_chain (test, &cache, &store, &cert, X509_CERTCA_ECC_EE_DER,
+		X509_CERTCA_ECC_EE_DER_LEN, false);
+
+	status = cache.test.base.authenticate (NULL, &cert, &store);
+	CuAssertIntEquals (test, X509_ENGINE_INVALID_ARGUMENT, status);
+
+	status = cache.test.base.authenticate (&cache.test.base, NULL, &store);
+	CuAssertIntEquals (test, X509_ENGINE_INVALID_ARGUMENT, status);
+
+	status = cache.test.base.authenticate (&cache.test.base, &cert, NULL);
+	CuAssertIntEquals (test, X509_ENGINE_INVALID_ARGUMENT, status);
+
+	status = cache.test.base.authenticate (&cache.test.base, &empty_cert, &store);
+	CuAssertIntEquals (test, X509_ENGINE_INVALID_ARGUMENT, status);
+
+	status = cache.test.base.authenticate (&cache.test.base, &cert, &empty_store);
+	CuAssertIntEquals (test, X509_ENGINE_INVALID_ARGUMENT, status);
+
+	status = cache.test.base.add_root_ca (NULL, &store, X509_CERTSS_ECC_CA_DER,
+		X509_CERTSS_ECC_CA_DER_LEN);
+	CuAssertIntEquals (test, X509_ENGINE_INVALID_ARGUMENT, status);
+
+	status = cache.test.base.add_root_ca (&cache.test.base, NULL, X509_CERTSS_ECC_CA_DER,
+		X509_CERTSS_ECC_CA_DER_LEN);
+	CuAssertIntEquals (test, X509_ENGINE_INVALID_ARGUMENT, status);
+
+	status = cache.test.base.add_root_ca (&cache.test.base, &empty_store, X509_CERTSS_ECC_CA_DER,
+		X509_CERTSS_ECC_CA_DER_LEN);
+	CuAssertIntEquals (test, X509_ENGINE_INVALID_ARGUMENT, status);
+
+	status = cache.test.base.add_root_ca (&cache.test.base, &store, NULL,
+		X509_CERTSS_ECC_CA_DER_LEN);
+	CuAssertIntEquals (test, X509_ENGINE_INVALID_ARGUMENT, status);
+
+	status = cache.test.base.add_intermediate_ca (&cache.test.base, &store,
+		X509_CERTCA_ECC_CA_DER, 0);
+	CuAssertIntEquals (test, X509_ENGINE_INVALID_ARGUMENT, status);
+
+	x509_cache_testing_release_chain (test, &cache, &store, &cert);
+
+	cache.test.base.release_ca_cert_store (NULL, &store);
+	cache.test.base.release_ca_cert_store (&cache.test.base, NULL);
+	cache.test.base.release_ca_cert_store (&cache.test.base, &empty_store);
+
+	x509_cache_testing_release (test, &cache);
+}
+
+static void x509_cache_test_flush (CuTest *test)
+{
+	struct x509_cache_testing cache;
+	int status;
+
+	TEST_START;
+
+	x509_cache_testing_init (test, &cache, X509_CACHE_TESTING_ENTRIES);
+
+	x509_cache_testing_authenticate_not_cached (test, &cache, X509_CERTCA_ECC_EE_DER,
+		X509_CERTCA_ECC_EE_DER_LEN, false);
+
+	status = x509_cache_flush (&cache.test);
+	CuAssertIntEquals (test, 0, status);
+
+	x509_cache_testing_authenticate_not_cached (test, &cache, X509_CERTCA_ECC_EE_DER,
+		X509_CERTCA_ECC_EE_DER_LEN, false);
+	x509_cache_testing_authenticate_cached (test, &cache, X509_CERTCA_ECC_EE_DER,
+		X509_CERTCA_ECC_EE_DER_LEN);
+
+	x509_cache_testing_release (test, &cache);
+}
+
+static void x509_cache_test_flush_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = x509_cache_flush (NULL);
+	CuAssertIntEquals (test, X509_ENGINE_INVALID_ARGUMENT, status);
+}
+
+static void x509_cache_test_on_cfm_activated (CuTest *test)
+{
+	struct x509_cache_testing cache;
+
+	TEST_START;
+
+	x509_cache_testing_init (test, &cache, X509_CACHE_TESTING_ENTRIES);
+
+	x509_cache_testing_authenticate_not_cached (test, &cache, X509_CERTCA_ECC_EE_DER,
+		X509_CERTCA_ECC_EE_DER_LEN, false);
+
+	cache.test.base_cfm.on_cfm_activated (&cache.test.base_cfm, (struct cfm*) &cache);
+
+	x509_cache_testing_authenticate_not_cached (test, &cache, X509_CERTCA_ECC_EE_DER,
+		X509_CERTCA_ECC_EE_DER_LEN, false);
+
+	x509_cache_testing_release (test, &cache);
+}
+
+static void x509_cache_test_on_clear_active (CuTest *test)
+{
+	struct x509_cache_testing cache;
+
+	TEST_START;
+
+	x509_cache_testing_init (test, &cache, X509_CACHE_TESTING_ENTRIES);
+
+	x509_cache_testing_authenticate_not_cached (test, &cache, X509_CERTCA_ECC_EE_DER,
+		X509_CERTCA_ECC_EE_DER_LEN, false);
+
+	cache.test.base_cfm.on_clear_active (&cache.test.base_cfm);
+
+	x509_cache_testing_authenticate_not_cached (test, &cache, X509_CERTCA_ECC_EE_DER,
+		X509_CERTCA_ECC_EE_DER_LEN, false);
+
+	x509_cache_testing_release (test, &cache);
+}
+
+static void x509_cache_test_get_stats_null (CuTest *test)
+{
+	struct x509_cache_testing cache;
+	struct key_cache_stats stats;
+	int status;
+
+	TEST_START;
+
+	x509_cache_testing_init (test, &cache, X509_CACHE_TESTING_ENTRIES);
+
+	status = x509_cache_get_stats (NULL, &stats);
+	CuAssertIntEquals (test, X509_ENGINE_INVALID_ARGUMENT, status);
+
+	status = x509_cache_get_stats (&cache.test, NULL);
+	CuAssertIntEquals (test, X509_ENGINE_INVALID_ARGUMENT, status);
+
+	x509_cache_testing_release (test, &cache);
+}
+
+
+TEST_SUITE_START (x509_cache);
+
+TEST (x509_cache_test_init);
+TEST (x509_cache_test_init_null);
+TEST (x509_cache_test_static_init);
+TEST (x509_cache_test_static_init_null);
+TEST (x509_cache_test_release_null);
+TEST (x509_cache_test_load_certificate);
+TEST (x509_cache_test_load_certificate_null);
+TEST (x509_cache_test_load_certificate_error);
+TEST (x509_cache_test_load_certificate_hash_error);
+TEST (x509_cache_test_release_certificate_null);
+TEST (x509_cache_test_create_csr);
+TEST (x509_cache_test_create_ca_signed_certificate);
+TEST (x509_cache_test_get_public_key);
+TEST (x509_cache_test_init_ca_cert_store_error);
+TEST (x509_cache_test_authenticate);
+TEST (x509_cache_test_authenticate_different_leaf);
+TEST (x509_cache_test_authenticate_extra_data_after_certificate);
+TEST (x509_cache_test_authenticate_root_as_intermediate);
+TEST (x509_cache_test_authenticate_failure_not_cached);
+TEST (x509_cache_test_authenticate_cached_ca_error);
+TEST (x509_cache_test_authenticate_unknown_certificate_length);
+TEST (x509_cache_test_authenticate_eviction);
+TEST (x509_cache_test_authenticate_null);
+TEST (x509_cache_test_flush);
+TEST (x509_cache_test_flush_null);
+TEST (x509_cache_test_on_cfm_activated);
+TEST (x509_cache_test_on_clear_active);
+TEST (x509_cache_test_get_stats_null);
+
+TEST_SUITE_END;
@@ -5628,6 +5628,75 @@ static void x509_mbedtls_test_release_ca_cert_store_null (CuTest *test)
 	x509_mbedtls_release (&engine);
 }
 
+static void x509_mbedtls_test_init_ca_cert_store_pool (CuTest *test)
+{
+	struct x509_engine_mbedtls engine;
+	struct x509_ca_certs store;
+	struct x509_ca_certs heap_store;
+	uint64_t store_slots[OBJECT_POOL_STORAGE_LEN (sizeof (struct x509_mbedtls_ca_store_context),
+		1)];
+	volatile uint32_t store_links[1];
+	struct object_pool_state store_pool_state;
+	struct object_pool store_pool;
+	struct object_pool_stats stats;
+	int status;
+
+	TEST_START;
+
+	status = object_pool_init (&store_pool, &store_pool_state, store_slots, store_links,
+		sizeof (struct x509_mbedtls_ca_store_context), 1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = x509_mbedtls_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrEquals (test, NULL, (void*) engine.ca_store_pool);
+
+	status = x509_mbedtls_set_ca_store_pool (&engine, &store_pool);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, &store_pool, (void*) engine.ca_store_pool);
+
+	status = engine.base.init_ca_cert_store (&engine.base, &store);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, true, object_pool_contains (&store_pool, store.context));
+
+	status = engine.base.add_root_ca (&engine.base, &store, X509_CERTSS_ECC_CA_DER,
+		X509_CERTSS_ECC_CA_DER_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	/* The pool is empty, so the next store is allocated from the heap. */
+	status = engine.base.init_ca_cert_store (&engine.base, &heap_store);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, false, object_pool_contains (&store_pool, heap_store.context));
+
+	status = object_pool_get_stats (&store_pool, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, stats.in_use);
+	CuAssertIntEquals (test, 1, stats.failures);
+
+	engine.base.release_ca_cert_store (&engine.base, &heap_store);
+	engine.base.release_ca_cert_store (&engine.base, &store);
+
+	status = object_pool_get_stats (&store_pool, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, stats.in_use);
+	CuAssertIntEquals (test, 1, stats.high_water);
+
+	x509_mbedtls_release (&engine);
+	object_pool_release (&store_pool);
+}
+
+static void x509_mbedtls_test_set_ca_store_pool_null (CuTest *test)
+{
+	struct object_pool store_pool;
+	int status;
+
+	TEST_START;
+
+	status = x509_mbedtls_set_ca_store_pool (NULL, &store_pool);
+	CuAssertIntEquals (test, X509_ENGINE_INVALID_ARGUMENT, status);
+}
+
 static void x509_mbedtls_test_add_root_ca_ecc (CuTest *test)
 {
 	struct x509_engine_mbedtls engine;
@@ -7666,6 +7735,8 @@ TEST (x509_mbedtls_test_get_public_key_null);
 TEST (x509_mbedtls_test_init_ca_cert_store);
 TEST (x509_mbedtls_test_init_ca_cert_store_null);
 TEST (x509_mbedtls_test_release_ca_cert_store_null);
+TEST (x509_mbedtls_test_init_ca_cert_store_pool);
+TEST (x509_mbedtls_test_set_ca_store_pool_null);
 TEST (x509_mbedtls_test_add_root_ca_ecc);
 TEST (x509_mbedtls_test_add_root_ca_ecc_bad_signature);
 TEST (x509_mbedtls_test_add_root_ca_rsa);
@@ -4767,6 +4767,56 @@ static void attestation_requester_test_deinit_null (CuTest *test)
 	attestation_requester_deinit (NULL);
 }
 
+static void attestation_requester_test_set_cert_pool (CuTest *test)
+{
+	struct attestation_requester_testing testing;
+	uint64_t cert_slots[OBJECT_POOL_STORAGE_LEN (CERBERUS_PROTOCOL_MAX_CERT_CHAIN_LEN, 1)];
+	volatile uint32_t cert_links[1];
+	struct object_pool_state cert_pool_state;
+	struct object_pool cert_pool;
+	int status;
+
+	TEST_START;
+
+	status = object_pool_init (&cert_pool, &cert_pool_state, cert_slots, cert_links,
+		CERBERUS_PROTOCOL_MAX_CERT_CHAIN_LEN, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	setup_attestation_requester_mock_attestation_test (test, &testing, false, false, true, true,
+		HASH_TYPE_SHA256, CFM_ATTESTATION_DMTF_SPDM, 0, 0);
+
+	status = attestation_requester_init (&testing.test, &testing.state, &testing.mctp,
+		&testing.channel.base, &testing.primary_hash.base, &testing.secondary_hash.base,
+		&testing.ecc.base, &testing.rsa.base, &testing.x509_mock.base, &testing.rng.base,
+		&testing.riot, &testing.device_mgr, &testing.cfm_manager.base);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrEquals (test, NULL, (void*) testing.test.cert_pool);
+
+	status = attestation_requester_set_cert_pool (&testing.test, &cert_pool);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, &cert_pool, (void*) testing.test.cert_pool);
+
+	status = attestation_requester_set_cert_pool (&testing.test, NULL);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, NULL, (void*) testing.test.cert_pool);
+
+	complete_attestation_requester_mock_test (test, &testing, true);
+
+	object_pool_release (&cert_pool);
+}
+
+static void attestation_requester_test_set_cert_pool_null (CuTest *test)
+{
+	struct object_pool cert_pool;
+	int status;
+
+	TEST_START;
+
+	status = attestation_requester_set_cert_pool (NULL, &cert_pool);
+	CuAssertIntEquals (test, ATTESTATION_INVALID_ARGUMENT, status);
+}
+
 static void attestation_requester_test_attest_device_cerberus_ecc (CuTest *test)
 {
 	struct attestation_requester_testing testing;
@@ -4821,6 +4871,80 @@ static void attestation_requester_test_attest_device_cerberus_ecc (CuTest *test)
 	complete_attestation_requester_mock_test (test, &testing, true);
 }
 
+static void attestation_requester_test_attest_device_cerberus_ecc_cert_pool (CuTest *test)
+{
+	struct attestation_requester_testing testing;
+	uint32_t component_id = 50;
+	uint8_t digest[SHA256_HASH_LENGTH];
+	struct cfm_pmr_digest pmr_digest;
+	uint64_t cert_slots[OBJECT_POOL_STORAGE_LEN (CERBERUS_PROTOCOL_MAX_CERT_CHAIN_LEN, 1)];
+	volatile uint32_t cert_links[1];
+	struct object_pool_state cert_pool_state;
+	struct object_pool cert_pool;
+	struct object_pool_stats stats;
+	int status;
+	int i;
+
+	for (i = 0; i < SHA256_HASH_LENGTH; ++i) {
+		digest[i] = i * 3;
+	}
+
+	pmr_digest.pmr_id = 0;
+	pmr_digest.digests.hash_type = HASH_TYPE_SHA256;
+	pmr_digest.digests.digest_count = 1;
+	pmr_digest.digests.digests = digest;
+
+	TEST_START;
+
+	status = object_pool_init (&cert_pool, &cert_pool_state, cert_slots, cert_links,
+		CERBERUS_PROTOCOL_MAX_CERT_CHAIN_LEN, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	setup_attestation_requester_mock_attestation_test (test, &testing, true, true, true, true,
+		HASH_TYPE_SHA256, CFM_ATTESTATION_CERBERUS_PROTOCOL, ATTESTATION_RIOT_SLOT_NUM,
+		component_id);
+
+	status = attestation_requester_set_cert_pool (&testing.test, &cert_pool);
+	CuAssertIntEquals (test, 0, status);
+
+	attestation_requester_testing_send_and_receive_cerberus_device_capabilities (test, true, false,
+		false, 0, &testing);
+
+	attestation_requester_testing_send_and_receive_cerberus_get_digest_with_mocks (test, &testing,
+		1);
+
+	attestation_requester_testing_send_and_receive_cerberus_get_certificate_with_mocks (test,
+		&testing, true, true, 2, true, false, NULL, component_id);
+
+	attestation_requester_testing_send_and_receive_cerberus_challenge (test, true, false, false,
+		false, false, false, false, 5, 0, 0, 0, 0, 0, 0, true, false, &testing);
+
+	status = mock_expect (&testing.cfm.mock, testing.cfm.base.get_component_pmr_digest,
+		&testing.cfm, 0, MOCK_ARG (component_id), MOCK_ARG (0), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output_tmp (&testing.cfm.mock, 2, &pmr_digest,
+		sizeof (struct cfm_pmr_digest), -1);
+	status |= mock_expect_save_arg (&testing.cfm.mock, 2, 1);
+	status |= mock_expect (&testing.cfm.mock, testing.cfm.base.free_component_pmr_digest,
+		&testing.cfm, 0, MOCK_ARG_SAVED_ARG (1));
+	CuAssertIntEquals (test, 0, status);
+
+	status = attestation_requester_attest_device (&testing.test, 0x0A);
+	CuAssertIntEquals (test, 0, status);
+
+	status = device_manager_get_device_state_by_eid (&testing.device_mgr, 0x0A);
+	CuAssertIntEquals (test, DEVICE_MANAGER_AUTHENTICATED, status);
+
+	status = object_pool_get_stats (&cert_pool, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, stats.in_use);
+	CuAssertIntEquals (test, 1, stats.high_water);
+	CuAssertIntEquals (test, 0, stats.failures);
+
+	complete_attestation_requester_mock_test (test, &testing, true);
+
+	object_pool_release (&cert_pool);
+}
+
 static void attestation_requester_test_attest_device_cerberus_ecc_vendor_root_ca (CuTest *test)
 {
 	struct attestation_requester_testing testing;
@@ -30508,7 +30632,10 @@ TEST (attestation_requester_test_init_invalid_arg);
 TEST (attestation_requester_test_init_state);
 TEST (attestation_requester_test_init_state_invalid_arg);
 TEST (attestation_requester_test_deinit_null);
+TEST (attestation_requester_test_set_cert_pool);
+TEST (attestation_requester_test_set_cert_pool_null);
 TEST (attestation_requester_test_attest_device_cerberus_ecc);
+TEST (attestation_requester_test_attest_device_cerberus_ecc_cert_pool);
 TEST (attestation_requester_test_attest_device_cerberus_ecc_vendor_root_ca);
 TEST (attestation_requester_test_attest_device_cerberus_ecc_untrusted_root_ca);
 TEST (attestation_requester_test_attest_device_cerberus_rsa);
@@ -2466,6 +2466,148 @@ static void pcr_store_test_get_attestation_log_compute_fail (CuTest *test)
 	complete_pcr_store_mock_test (test, &store, &hash);
 }
 
+static void pcr_store_test_get_attestation_log_sha256_multi (CuTest *test)
+{
+	struct pcr_store store;
+	struct hash_engine_mock hash;
+	struct pcr_store_attestation_log_entry buf[6];
+	struct pcr_store_attestation_log_entry exp_buf[6];
+	uint8_t digests[6][PCR_DIGEST_LENGTH];
+	int i_measurement;
+	int status;
+
+	TEST_START;
+
+	for (i_measurement = 0; i_measurement < 6; ++i_measurement) {
+		memset (digests[i_measurement], i_measurement + 1, PCR_DIGEST_LENGTH);
+
+		exp_buf[i_measurement].header.log_magic = 0xCB;
+		exp_buf[i_measurement].header.length = sizeof (struct pcr_store_attestation_log_entry);
+		exp_buf[i_measurement].header.entry_id = i_measurement;
+		exp_buf[i_measurement].entry.digest_algorithm_id = 0x0B;
+		exp_buf[i_measurement].entry.digest_count = 1;
+		exp_buf[i_measurement].entry.measurement_size = 32;
+		exp_buf[i_measurement].entry.event_type = 0x0A + i_measurement;
+
+		memcpy (exp_buf[i_measurement].entry.digest, digests[i_measurement],
+			sizeof (exp_buf[i_measurement].entry.digest));
+
+		/* The mock does not generate any measurement output. */
+		memset (exp_buf[i_measurement].entry.measurement, 0,
+			sizeof (exp_buf[i_measurement].entry.measurement));
+
+		if (i_measurement >= 3) {
+			exp_buf[i_measurement].entry.measurement_type =
+				PCR_MEASUREMENT (1, (i_measurement - 3));
+		}
+		else {
+			exp_buf[i_measurement].entry.measurement_type = PCR_MEASUREMENT (0, i_measurement);
+		}
+	}
+
+	setup_pcr_store_mock_test (test, &store, &hash, 3, 3);
+	hash_mock_enable_sha256_multi (&hash);
+
+	/* Both banks are computed together. */
+	status = mock_expect (&hash.mock, hash.base.calculate_sha256_multi, &hash, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG (2));
+	status |= mock_expect (&hash.mock, hash.base.calculate_sha256_multi, &hash, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG (2));
+	status |= mock_expect (&hash.mock, hash.base.calculate_sha256_multi, &hash, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG (2));
+	CuAssertIntEquals (test, 0, status);
+
+	for (i_measurement = 0; i_measurement < 6; ++i_measurement) {
+		pcr_store_update_digest (&store, PCR_MEASUREMENT (i_measurement / 3, i_measurement % 3),
+			digests[i_measurement], PCR_DIGEST_LENGTH);
+		pcr_store_update_event_type (&store,
+			PCR_MEASUREMENT (i_measurement / 3, i_measurement % 3), 0x0A + i_measurement);
+	}
+
+	status = pcr_store_get_attestation_log (&store, &hash.base, 0, (uint8_t*) buf, sizeof (buf));
+	CuAssertIntEquals (test, 6 * sizeof (struct pcr_store_attestation_log_entry), status);
+
+	status = testing_validate_array ((uint8_t*) exp_buf, (uint8_t*) buf, status);
+	CuAssertIntEquals (test, 0, status);
+
+	complete_pcr_store_mock_test (test, &store, &hash);
+}
+
+static void pcr_store_test_get_attestation_log_sha256_multi_small_buffer (CuTest *test)
+{
+	struct pcr_store store;
+	struct hash_engine_mock hash;
+	struct pcr_store_attestation_log_entry buf[6];
+	uint8_t digest[PCR_DIGEST_LENGTH];
+	int i_measurement;
+	int status;
+
+	TEST_START;
+
+	memset (digest, 0x55, sizeof (digest));
+
+	setup_pcr_store_mock_test (test, &store, &hash, 3, 3);
+	hash_mock_enable_sha256_multi (&hash);
+
+	for (i_measurement = 0; i_measurement < 6; ++i_measurement) {
+		status = mock_expect (&hash.mock, hash.base.calculate_sha256_multi, &hash, 0,
+			MOCK_ARG_NOT_NULL, MOCK_ARG (2));
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	for (i_measurement = 0; i_measurement < 6; ++i_measurement) {
+		pcr_store_update_digest (&store, PCR_MEASUREMENT (i_measurement / 3, i_measurement % 3),
+			digest, PCR_DIGEST_LENGTH);
+	}
+
+	status = pcr_store_get_attestation_log (&store, &hash.base, 0, (uint8_t*) buf,
+		sizeof (struct pcr_store_attestation_log_entry));
+	CuAssertIntEquals (test, sizeof (struct pcr_store_attestation_log_entry), status);
+
+	/* All banks must be unlocked when the log is read again. */
+	status = pcr_store_get_attestation_log (&store, &hash.base, 0, (uint8_t*) buf, sizeof (buf));
+	CuAssertIntEquals (test, 6 * sizeof (struct pcr_store_attestation_log_entry), status);
+
+	complete_pcr_store_mock_test (test, &store, &hash);
+}
+
+static void pcr_store_test_get_attestation_log_sha256_multi_compute_fail (CuTest *test)
+{
+	struct pcr_store store;
+	struct hash_engine_mock hash;
+	struct pcr_store_attestation_log_entry buf[6];
+	uint8_t digest[PCR_DIGEST_LENGTH];
+	int status;
+
+	TEST_START;
+
+	memset (digest, 0x55, sizeof (digest));
+
+	setup_pcr_store_mock_test (test, &store, &hash, 3, 3);
+	hash_mock_enable_sha256_multi (&hash);
+
+	status = mock_expect (&hash.mock, hash.base.calculate_sha256_multi, &hash,
+		HASH_ENGINE_NO_MEMORY, MOCK_ARG_NOT_NULL, MOCK_ARG (2));
+	status |= mock_expect (&hash.mock, hash.base.calculate_sha256_multi, &hash, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG (2));
+	status |= mock_expect (&hash.mock, hash.base.calculate_sha256_multi, &hash, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG (2));
+	status |= mock_expect (&hash.mock, hash.base.calculate_sha256_multi, &hash, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG (2));
+	CuAssertIntEquals (test, 0, status);
+
+	pcr_store_update_digest (&store, PCR_MEASUREMENT (0, 0), digest, PCR_DIGEST_LENGTH);
+
+	status = pcr_store_get_attestation_log (&store, &hash.base, 0, (uint8_t*) buf, sizeof (buf));
+	CuAssertIntEquals (test, HASH_ENGINE_NO_MEMORY, status);
+
+	/* All banks must be unlocked after the failure. */
+	status = pcr_store_get_attestation_log (&store, &hash.base, 0, (uint8_t*) buf, sizeof (buf));
+	CuAssertIntEquals (test, 6 * sizeof (struct pcr_store_attestation_log_entry), status);
+
+	complete_pcr_store_mock_test (test, &store, &hash);
+}
+
 static void pcr_store_test_invalidate_measurement (CuTest *test)
 {
 	struct pcr_store store;
@@ -3883,6 +4025,9 @@ TEST (pcr_store_test_get_attestation_log_small_buffer_nonzero_offset);
 TEST (pcr_store_test_get_attestation_log_invalid_offset);
 TEST (pcr_store_test_get_attestation_log_invalid_arg);
 TEST (pcr_store_test_get_attestation_log_compute_fail);
+TEST (pcr_store_test_get_attestation_log_sha256_multi);
+TEST (pcr_store_test_get_attestation_log_sha256_multi_small_buffer);
+TEST (pcr_store_test_get_attestation_log_sha256_multi_compute_fail);
 TEST (pcr_store_test_invalidate_measurement);
 TEST (pcr_store_test_invalidate_measurement_explicit);
 TEST (pcr_store_test_invalidate_measurement_null);
@@ -14,6 +14,7 @@
 #include "testing/mock/crypto/hash_mock.h"
 #include "testing/mock/flash/flash_mock.h"
 #include "testing/mock/logging/logging_mock.h"
+#include "testing/engines/hash_testing_engine.h"
 
 
 TEST_SUITE_LABEL ("pcr");
@@ -1777,6 +1778,219 @@ static void pcr_test_compute_finish_hash_fail (CuTest *test)
 	complete_pcr_mock_test (test, &pcr, &hash);
 }
 
+static void pcr_test_compute_banks (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct pcr_bank banks[3];
+	struct pcr_bank expected[2];
+	uint8_t num_measurements[3] = {2, 3, 0};
+	uint8_t digest[PCR_DIGEST_LENGTH];
+	uint8_t measurement[PCR_DIGEST_LENGTH];
+	const struct pcr_measurement *actual;
+	size_t i_bank;
+	size_t i_measurement;
+	int status;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i_bank = 0; i_bank < 3; i_bank++) {
+		status = pcr_init (&banks[i_bank], num_measurements[i_bank]);
+		CuAssertIntEquals (test, 0, status);
+
+		if (i_bank < 2) {
+			status = pcr_init (&expected[i_bank], num_measurements[i_bank]);
+			CuAssertIntEquals (test, 0, status);
+		}
+
+		for (i_measurement = 0; i_measurement < banks[i_bank].num_measurements;
+			i_measurement++) {
+			memset (digest, (i_bank * 0x10) + i_measurement + 1, sizeof (digest));
+
+			status = pcr_update_digest (&banks[i_bank], i_measurement, digest, sizeof (digest));
+			CuAssertIntEquals (test, 0, status);
+
+			if (i_bank < 2) {
+				status = pcr_update_digest (&expected[i_bank], i_measurement, digest,
+					sizeof (digest));
+				CuAssertIntEquals (test, 0, status);
+			}
+		}
+	}
+
+	status = pcr_compute_banks (banks, 3, &hash.base);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i_bank = 0; i_bank < 2; i_bank++) {
+		status = pcr_compute (&expected[i_bank], &hash.base, measurement, true);
+		CuAssertIntEquals (test, num_measurements[i_bank], status);
+
+		status = pcr_get_all_measurements (&banks[i_bank], (const uint8_t**) &actual);
+		CuAssertIntEquals (test, num_measurements[i_bank], status);
+
+		for (i_measurement = 0; i_measurement < num_measurements[i_bank]; i_measurement++) {
+			status = testing_validate_array (
+				expected[i_bank].measurement_list[i_measurement].measurement,
+				actual[i_measurement].measurement, PCR_DIGEST_LENGTH);
+			CuAssertIntEquals (test, 0, status);
+		}
+
+		status = testing_validate_array (measurement,
+			actual[num_measurements[i_bank] - 1].measurement, PCR_DIGEST_LENGTH);
+		CuAssertIntEquals (test, 0, status);
+
+		pcr_release (&expected[i_bank]);
+	}
+
+	/* The explicit measurement is not changed. */
+	memset (measurement, 0, sizeof (measurement));
+	status = testing_validate_array (measurement, banks[2].measurement_list[0].measurement,
+		PCR_DIGEST_LENGTH);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i_bank = 0; i_bank < 3; i_bank++) {
+		pcr_release (&banks[i_bank]);
+	}
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void pcr_test_compute_banks_sha256_multi (CuTest *test)
+{
+	struct pcr_bank banks[3];
+	struct hash_engine_mock hash;
+	uint8_t num_measurements[3] = {2, 3, 0};
+	size_t i_bank;
+	int status;
+
+	TEST_START;
+
+	setup_pcr_mock_test (test, &banks[0], &hash, num_measurements[0]);
+	hash_mock_enable_sha256_multi (&hash);
+
+	for (i_bank = 1; i_bank < 3; i_bank++) {
+		status = pcr_init (&banks[i_bank], num_measurements[i_bank]);
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	/* Each step in the measurement chains is calculated for all banks in a single request. */
+	status = mock_expect (&hash.mock, hash.base.calculate_sha256_multi, &hash, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG (2));
+	status |= mock_expect (&hash.mock, hash.base.calculate_sha256_multi, &hash, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG (2));
+	status |= mock_expect (&hash.mock, hash.base.calculate_sha256_multi, &hash, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_compute_banks (banks, 3, &hash.base);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i_bank = 1; i_bank < 3; i_bank++) {
+		pcr_release (&banks[i_bank]);
+	}
+
+	complete_pcr_mock_test (test, &banks[0], &hash);
+}
+
+static void pcr_test_compute_banks_multiple_batches (CuTest *test)
+{
+	struct pcr_bank banks[10];
+	struct hash_engine_mock hash;
+	size_t i_bank;
+	int status;
+
+	TEST_START;
+
+	setup_pcr_mock_test (test, &banks[0], &hash, 1);
+	hash_mock_enable_sha256_multi (&hash);
+
+	for (i_bank = 1; i_bank < 10; i_bank++) {
+		status = pcr_init (&banks[i_bank], 1);
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	status = mock_expect (&hash.mock, hash.base.calculate_sha256_multi, &hash, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG (8));
+	status |= mock_expect (&hash.mock, hash.base.calculate_sha256_multi, &hash, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG (2));
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_compute_banks (banks, 10, &hash.base);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i_bank = 1; i_bank < 10; i_bank++) {
+		pcr_release (&banks[i_bank]);
+	}
+
+	complete_pcr_mock_test (test, &banks[0], &hash);
+}
+
+static void pcr_test_compute_banks_no_banks (CuTest *test)
+{
+	struct pcr_bank pcr;
+	struct hash_engine_mock hash;
+	int status;
+
+	TEST_START;
+
+	setup_pcr_mock_test (test, &pcr, &hash, 1);
+	hash_mock_enable_sha256_multi (&hash);
+
+	status = pcr_compute_banks (&pcr, 0, &hash.base);
+	CuAssertIntEquals (test, 0, status);
+
+	complete_pcr_mock_test (test, &pcr, &hash);
+}
+
+static void pcr_test_compute_banks_invalid_arg (CuTest *test)
+{
+	struct pcr_bank pcr;
+	struct hash_engine_mock hash;
+	int status;
+
+	TEST_START;
+
+	setup_pcr_mock_test (test, &pcr, &hash, 1);
+	hash_mock_enable_sha256_multi (&hash);
+
+	status = pcr_compute_banks (NULL, 1, &hash.base);
+	CuAssertIntEquals (test, PCR_INVALID_ARGUMENT, status);
+
+	status = pcr_compute_banks (&pcr, 1, NULL);
+	CuAssertIntEquals (test, PCR_INVALID_ARGUMENT, status);
+
+	complete_pcr_mock_test (test, &pcr, &hash);
+}
+
+static void pcr_test_compute_banks_hash_fail (CuTest *test)
+{
+	struct pcr_bank banks[2];
+	struct hash_engine_mock hash;
+	int status;
+
+	TEST_START;
+
+	setup_pcr_mock_test (test, &banks[0], &hash, 3);
+	hash_mock_enable_sha256_multi (&hash);
+
+	status = pcr_init (&banks[1], 3);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&hash.mock, hash.base.calculate_sha256_multi, &hash, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG (2));
+	status |= mock_expect (&hash.mock, hash.base.calculate_sha256_multi, &hash,
+		HASH_ENGINE_SHA256_FAILED, MOCK_ARG_NOT_NULL, MOCK_ARG (2));
+	CuAssertIntEquals (test, 0, status);
+
+	status = pcr_compute_banks (banks, 2, &hash.base);
+	CuAssertIntEquals (test, HASH_ENGINE_SHA256_FAILED, status);
+
+	pcr_release (&banks[1]);
+	complete_pcr_mock_test (test, &banks[0], &hash);
+}
+
 static void pcr_test_get_measurement (CuTest *test)
 {
 	struct pcr_bank pcr;
@@ -16577,6 +16791,12 @@ TEST (pcr_test_compute_start_hash_fail);
 TEST (pcr_test_compute_hash_fail);
 TEST (pcr_test_compute_extend_hash_fail);
 TEST (pcr_test_compute_finish_hash_fail);
+TEST (pcr_test_compute_banks);
+TEST (pcr_test_compute_banks_sha256_multi);
+TEST (pcr_test_compute_banks_multiple_batches);
+TEST (pcr_test_compute_banks_no_banks);
+TEST (pcr_test_compute_banks_invalid_arg);
+TEST (pcr_test_compute_banks_hash_fail);
 TEST (pcr_test_get_measurement);
 TEST (pcr_test_get_measurement_explicit);
 TEST (pcr_test_get_measurement_invalid_arg);
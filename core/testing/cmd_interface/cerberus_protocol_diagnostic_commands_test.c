@@ -137,6 +137,193 @@ void cerberus_protocol_diagnostic_commands_testing_process_heap_stats_fail (CuTe
 	CuAssertIntEquals (test, 0, status);
 }
 
+/**
+ * Build a request to configure the debug log filter.
+ *
+ * @param data Buffer for the request.
+ * @param request The request message to initialize.
+ * @param component The component ID for the request.
+ * @param threshold The threshold value for the request.
+ */
+static void cerberus_protocol_diagnostic_commands_testing_build_debug_log_filter (uint8_t *data,
+	struct cmd_interface_msg *request, uint8_t component, uint8_t threshold)
+{
+	struct cerberus_protocol_debug_log_filter *req =
+		(struct cerberus_protocol_debug_log_filter*) data;
+
+	memset (request, 0, sizeof (*request));
+	memset (data, 0, MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY);
+	request->data = data;
+	req->header.msg_type = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	req->header.pci_vendor_id = CERBERUS_PROTOCOL_MSFT_PCI_VID;
+	req->header.command = CERBERUS_PROTOCOL_DIAG_DEBUG_LOG_FILTER;
+
+	req->component = component;
+	req->threshold = threshold;
+
+	request->length = sizeof (struct cerberus_protocol_debug_log_filter);
+	request->max_response = MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY;
+	request->source_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	request->target_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+}
+
+void cerberus_protocol_diagnostic_commands_testing_process_debug_log_filter (CuTest *test,
+	struct cmd_interface *cmd, const struct debug_log_filter *filter)
+{
+	uint8_t data[MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY];
+	struct cmd_interface_msg request;
+	struct cerberus_protocol_debug_log_filter_response *resp =
+		(struct cerberus_protocol_debug_log_filter_response*) data;
+	struct debug_log_filter_summary summary;
+	int status;
+
+	debug_log_filter = filter;
+
+	/* Generate some filtered entries. */
+	debug_log_filter_set_threshold (filter, DEBUG_LOG_COMPONENT_TPM, DEBUG_LOG_FILTER_LOG_NONE);
+	debug_log_filter_allow_entry (filter, DEBUG_LOG_SEVERITY_ERROR, DEBUG_LOG_COMPONENT_TPM, 1, 0,
+		&summary);
+	debug_log_filter_allow_entry (filter, DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_TPM, 1, 0,
+		&summary);
+
+	cerberus_protocol_diagnostic_commands_testing_build_debug_log_filter (data, &request,
+		DEBUG_LOG_COMPONENT_MCTP, DEBUG_LOG_SEVERITY_INFO);
+
+	request.crypto_timeout = true;
+	status = cmd->process_request (cmd, &request);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, sizeof (struct cerberus_protocol_debug_log_filter_response),
+		request.length);
+	CuAssertIntEquals (test, MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF, resp->header.msg_type);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_MSFT_PCI_VID, resp->header.pci_vendor_id);
+	CuAssertIntEquals (test, 0, resp->header.crypt);
+	CuAssertIntEquals (test, 0, resp->header.reserved2);
+	CuAssertIntEquals (test, 0, resp->header.integrity_check);
+	CuAssertIntEquals (test, 0, resp->header.reserved1);
+	CuAssertIntEquals (test, 0, resp->header.rq);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_DIAG_DEBUG_LOG_FILTER, resp->header.command);
+	CuAssertIntEquals (test, false, request.crypto_timeout);
+
+	CuAssertIntEquals (test, DEBUG_LOG_COMPONENT_MCTP, resp->component);
+	CuAssertIntEquals (test, DEBUG_LOG_SEVERITY_INFO, resp->threshold);
+	CuAssertIntEquals (test, 2, resp->filtered);
+	CuAssertIntEquals (test, 0, resp->suppressed);
+
+	status = debug_log_filter_get_threshold (filter, DEBUG_LOG_COMPONENT_MCTP);
+	CuAssertIntEquals (test, DEBUG_LOG_SEVERITY_INFO, status);
+
+	debug_log_filter = NULL;
+}
+
+void cerberus_protocol_diagnostic_commands_testing_process_debug_log_filter_query (CuTest *test,
+	struct cmd_interface *cmd, const struct debug_log_filter *filter)
+{
+	uint8_t data[MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY];
+	struct cmd_interface_msg request;
+	struct cerberus_protocol_debug_log_filter_response *resp =
+		(struct cerberus_protocol_debug_log_filter_response*) data;
+	int status;
+
+	debug_log_filter = filter;
+
+	debug_log_filter_set_threshold (filter, DEBUG_LOG_COMPONENT_SPDM, DEBUG_LOG_SEVERITY_WARNING);
+
+	cerberus_protocol_diagnostic_commands_testing_build_debug_log_filter (data, &request,
+		DEBUG_LOG_COMPONENT_SPDM, CERBERUS_PROTOCOL_DEBUG_LOG_FILTER_QUERY);
+
+	request.crypto_timeout = true;
+	status = cmd->process_request (cmd, &request);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, sizeof (struct cerberus_protocol_debug_log_filter_response),
+		request.length);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_DIAG_DEBUG_LOG_FILTER, resp->header.command);
+	CuAssertIntEquals (test, false, request.crypto_timeout);
+
+	CuAssertIntEquals (test, DEBUG_LOG_COMPONENT_SPDM, resp->component);
+	CuAssertIntEquals (test, DEBUG_LOG_SEVERITY_WARNING, resp->threshold);
+	CuAssertIntEquals (test, 0, resp->filtered);
+	CuAssertIntEquals (test, 0, resp->suppressed);
+
+	status = debug_log_filter_get_threshold (filter, DEBUG_LOG_COMPONENT_SPDM);
+	CuAssertIntEquals (test, DEBUG_LOG_SEVERITY_WARNING, status);
+
+	debug_log_filter = NULL;
+}
+
+void cerberus_protocol_diagnostic_commands_testing_process_debug_log_filter_invalid_len (
+	CuTest *test, struct cmd_interface *cmd, const struct debug_log_filter *filter)
+{
+	uint8_t data[MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY];
+	struct cmd_interface_msg request;
+	int status;
+
+	debug_log_filter = filter;
+
+	cerberus_protocol_diagnostic_commands_testing_build_debug_log_filter (data, &request,
+		DEBUG_LOG_COMPONENT_MCTP, DEBUG_LOG_SEVERITY_INFO);
+	request.length = sizeof (struct cerberus_protocol_debug_log_filter) + 1;
+
+	request.crypto_timeout = true;
+	status = cmd->process_request (cmd, &request);
+	CuAssertIntEquals (test, CMD_HANDLER_BAD_LENGTH, status);
+	CuAssertIntEquals (test, false, request.crypto_timeout);
+
+	cerberus_protocol_diagnostic_commands_testing_build_debug_log_filter (data, &request,
+		DEBUG_LOG_COMPONENT_MCTP, DEBUG_LOG_SEVERITY_INFO);
+	request.length = sizeof (struct cerberus_protocol_debug_log_filter) - 1;
+
+	request.crypto_timeout = true;
+	status = cmd->process_request (cmd, &request);
+	CuAssertIntEquals (test, CMD_HANDLER_BAD_LENGTH, status);
+	CuAssertIntEquals (test, false, request.crypto_timeout);
+
+	status = debug_log_filter_get_threshold (filter, DEBUG_LOG_COMPONENT_MCTP);
+	CuAssertIntEquals (test, DEBUG_LOG_FILTER_LOG_ALL, status);
+
+	debug_log_filter = NULL;
+}
+
+void cerberus_protocol_diagnostic_commands_testing_process_debug_log_filter_invalid_threshold (
+	CuTest *test, struct cmd_interface *cmd, const struct debug_log_filter *filter)
+{
+	uint8_t data[MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY];
+	struct cmd_interface_msg request;
+	int status;
+
+	debug_log_filter = filter;
+
+	cerberus_protocol_diagnostic_commands_testing_build_debug_log_filter (data, &request,
+		DEBUG_LOG_COMPONENT_MCTP, DEBUG_LOG_FILTER_LOG_ALL + 1);
+
+	request.crypto_timeout = true;
+	status = cmd->process_request (cmd, &request);
+	CuAssertIntEquals (test, CMD_HANDLER_OUT_OF_RANGE, status);
+	CuAssertIntEquals (test, false, request.crypto_timeout);
+
+	status = debug_log_filter_get_threshold (filter, DEBUG_LOG_COMPONENT_MCTP);
+	CuAssertIntEquals (test, DEBUG_LOG_FILTER_LOG_ALL, status);
+
+	debug_log_filter = NULL;
+}
+
+void cerberus_protocol_diagnostic_commands_testing_process_debug_log_filter_no_filter (
+	CuTest *test, struct cmd_interface *cmd)
+{
+	uint8_t data[MCTP_BASE_PROTOCOL_MAX_MESSAGE_BODY];
+	struct cmd_interface_msg request;
+	int status;
+
+	debug_log_filter = NULL;
+
+	cerberus_protocol_diagnostic_commands_testing_build_debug_log_filter (data, &request,
+		DEBUG_LOG_COMPONENT_MCTP, DEBUG_LOG_SEVERITY_INFO);
+
+	request.crypto_timeout = true;
+	status = cmd->process_request (cmd, &request);
+	CuAssertIntEquals (test, CMD_HANDLER_UNSUPPORTED_COMMAND, status);
+	CuAssertIntEquals (test, false, request.crypto_timeout);
+}
+
 /*******************
  * Test cases
  *******************/
@@ -194,9 +381,62 @@ static void cerberus_protocol_diagnostic_commands_test_heap_stats_format (CuTest
 	CuAssertIntEquals (test, 0x18171615, resp->heap.min_block);
 }
 
+static void cerberus_protocol_diagnostic_commands_test_debug_log_filter_format (CuTest *test)
+{
+	uint8_t raw_buffer_req[] = {
+		0x7e,0x14,0x13,0x03,0xd1,
+		0x0d,0x02
+	};
+	uint8_t raw_buffer_resp[] = {
+		0x7e,0x14,0x13,0x03,0xd1,
+		0x0d,0x02,
+		0x01,0x02,0x03,0x04,
+		0x05,0x06,0x07,0x08
+	};
+	struct cerberus_protocol_debug_log_filter *req;
+	struct cerberus_protocol_debug_log_filter_response *resp;
+
+	TEST_START;
+
+	CuAssertIntEquals (test, sizeof (raw_buffer_req),
+		sizeof (struct cerberus_protocol_debug_log_filter));
+
+	req = (struct cerberus_protocol_debug_log_filter*) raw_buffer_req;
+	CuAssertIntEquals (test, 0, req->header.integrity_check);
+	CuAssertIntEquals (test, 0x7e, req->header.msg_type);
+	CuAssertIntEquals (test, 0x1314, req->header.pci_vendor_id);
+	CuAssertIntEquals (test, 0, req->header.rq);
+	CuAssertIntEquals (test, 0, req->header.reserved2);
+	CuAssertIntEquals (test, 0, req->header.crypt);
+	CuAssertIntEquals (test, 0x03, req->header.reserved1);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_DIAG_DEBUG_LOG_FILTER, req->header.command);
+
+	CuAssertIntEquals (test, 0x0d, req->component);
+	CuAssertIntEquals (test, 0x02, req->threshold);
+
+	CuAssertIntEquals (test, sizeof (raw_buffer_resp),
+		sizeof (struct cerberus_protocol_debug_log_filter_response));
+
+	resp = (struct cerberus_protocol_debug_log_filter_response*) raw_buffer_resp;
+	CuAssertIntEquals (test, 0, resp->header.integrity_check);
+	CuAssertIntEquals (test, 0x7e, resp->header.msg_type);
+	CuAssertIntEquals (test, 0x1314, resp->header.pci_vendor_id);
+	CuAssertIntEquals (test, 0, resp->header.rq);
+	CuAssertIntEquals (test, 0, resp->header.reserved2);
+	CuAssertIntEquals (test, 0, resp->header.crypt);
+	CuAssertIntEquals (test, 0x03, resp->header.reserved1);
+	CuAssertIntEquals (test, CERBERUS_PROTOCOL_DIAG_DEBUG_LOG_FILTER, resp->header.command);
+
+	CuAssertIntEquals (test, 0x0d, resp->component);
+	CuAssertIntEquals (test, 0x02, resp->threshold);
+	CuAssertIntEquals (test, 0x04030201, resp->filtered);
+	CuAssertIntEquals (test, 0x08070605, resp->suppressed);
+}
+
 
 TEST_SUITE_START (cerberus_protocol_diagnostic_commands);
 
 TEST (cerberus_protocol_diagnostic_commands_test_heap_stats_format);
+TEST (cerberus_protocol_diagnostic_commands_test_debug_log_filter_format);
 
 TEST_SUITE_END;
@@ -7,6 +7,7 @@
 #include "testing.h"
 #include "cmd_interface/cmd_interface.h"
 #include "testing/mock/cmd_interface/cmd_device_mock.h"
+#include "logging/debug_log_filter.h"
 
 
 void cerberus_protocol_diagnostic_commands_testing_process_heap_stats (CuTest *test,
@@ -16,5 +17,16 @@ void cerberus_protocol_diagnostic_commands_testing_process_heap_stats_invalid_le
 void cerberus_protocol_diagnostic_commands_testing_process_heap_stats_fail (CuTest *test,
 	struct cmd_interface *cmd, struct cmd_device_mock *device);
 
+void cerberus_protocol_diagnostic_commands_testing_process_debug_log_filter (CuTest *test,
+	struct cmd_interface *cmd, const struct debug_log_filter *filter);
+void cerberus_protocol_diagnostic_commands_testing_process_debug_log_filter_query (CuTest *test,
+	struct cmd_interface *cmd, const struct debug_log_filter *filter);
+void cerberus_protocol_diagnostic_commands_testing_process_debug_log_filter_invalid_len (
+	CuTest *test, struct cmd_interface *cmd, const struct debug_log_filter *filter);
+void cerberus_protocol_diagnostic_commands_testing_process_debug_log_filter_invalid_threshold (
+	CuTest *test, struct cmd_interface *cmd, const struct debug_log_filter *filter);
+void cerberus_protocol_diagnostic_commands_testing_process_debug_log_filter_no_filter (
+	CuTest *test, struct cmd_interface *cmd);
+
 
 #endif /* CERBERUS_PROTOCOL_DIAGNOSTIC_COMMANDS_TESTING_H_ */
@@ -3107,6 +3107,365 @@ static void cmd_channel_test_send_message_multiple_packets_send_failure (CuTest
 	CuAssertIntEquals (test, 0, status);
 }
 
+static void cmd_channel_test_send_message_send_packets_single_packet (CuTest *test)
+{
+	struct cmd_channel_mock channel;
+	struct cmd_packet tx_packet;
+	struct cmd_message tx_message;
+	struct mctp_base_protocol_transport_header *header;
+	int status;
+
+	TEST_START;
+
+	memset (&tx_packet, 0, sizeof (tx_packet));
+
+	header = (struct mctp_base_protocol_transport_header*) tx_packet.data;
+
+	header->cmd_code = SMBUS_CMD_CODE_MCTP;
+	header->byte_count = 11;
+	header->source_addr = 0xBB;
+	header->rsvd = 0;
+	header->header_version = 1;
+	header->destination_eid = MCTP_BASE_PROTOCOL_BMC_EID;
+	header->source_eid = MCTP_BASE_PROTOCOL_PA_ROT_CTRL_EID;
+	header->som = 1;
+	header->eom = 1;
+	header->tag_owner = 0;
+	header->msg_tag = 0x00;
+	header->packet_seq = 0;
+
+	tx_packet.data[7] = MCTP_BASE_PROTOCOL_MSG_TYPE_VENDOR_DEF;
+	tx_packet.data[8] = 0x00;
+	tx_packet.data[9] = 0x00;
+	tx_packet.data[10] = 0x00;
+	tx_packet.data[11] = 0x0B;
+	tx_packet.data[12] = 0x0A;
+	tx_packet.data[13] = checksum_crc8 (0xAA, tx_packet.data, 13);
+	tx_packet.pkt_size = 14;
+
+	tx_message.data = tx_packet.data;
+	tx_message.msg_size = tx_packet.pkt_size;
+	tx_message.pkt_size = tx_packet.pkt_size;
+	tx_message.dest_addr = 0x55;
+
+	status = cmd_channel_mock_init_with_send_packets (&channel, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&channel.mock, channel.base.send_packets, &channel, 0,
+		MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_message, &tx_message, sizeof (tx_message)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_send_message (&channel.base, &tx_message);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_mock_validate_and_release (&channel);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void cmd_channel_test_send_message_send_packets_multiple_packets (CuTest *test)
+{
+	struct cmd_channel_mock channel;
+	struct cmd_message tx_message;
+	uint8_t msg_data[255 * 3 + 20];
+	int status;
+	int i;
+
+	TEST_START;
+
+	for (i = 0; i < (int) sizeof (msg_data); i++) {
+		msg_data[i] = i;
+	}
+
+	tx_message.data = msg_data;
+	tx_message.msg_size = sizeof (msg_data);
+	tx_message.pkt_size = 255;
+	tx_message.dest_addr = 0x55;
+
+	status = cmd_channel_mock_init_with_send_packets (&channel, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&channel.mock, channel.base.send_packets, &channel, 0,
+		MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_message, &tx_message, sizeof (tx_message)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_send_message (&channel.base, &tx_message);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_mock_validate_and_release (&channel);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void cmd_channel_test_send_message_send_packets_multiple_messages (CuTest *test)
+{
+	struct cmd_channel_mock channel;
+	struct cmd_message tx_message[2];
+	uint8_t msg_data[2][255 * 2];
+	int status;
+	int i;
+
+	TEST_START;
+
+	for (i = 0; i < (int) sizeof (msg_data[0]); i++) {
+		msg_data[0][i] = i;
+		msg_data[1][i] = ~i;
+	}
+
+	tx_message[0].data = msg_data[0];
+	tx_message[0].msg_size = sizeof (msg_data[0]);
+	tx_message[0].pkt_size = 255;
+	tx_message[0].dest_addr = 0x55;
+
+	tx_message[1].data = msg_data[1];
+	tx_message[1].msg_size = 300;
+	tx_message[1].pkt_size = 64;
+	tx_message[1].dest_addr = 0x41;
+
+	status = cmd_channel_mock_init_with_send_packets (&channel, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&channel.mock, channel.base.send_packets, &channel, 0,
+		MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_message, &tx_message[0],
+			sizeof (tx_message[0])));
+	status |= mock_expect (&channel.mock, channel.base.send_packets, &channel, 0,
+		MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_message, &tx_message[1],
+			sizeof (tx_message[1])));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_send_message (&channel.base, &tx_message[0]);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_send_message (&channel.base, &tx_message[1]);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_mock_validate_and_release (&channel);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void cmd_channel_test_send_message_send_packets_empty_message (CuTest *test)
+{
+	struct cmd_channel_mock channel;
+	struct cmd_message tx_message;
+	uint8_t msg_data[16];
+	int status;
+
+	TEST_START;
+
+	tx_message.data = msg_data;
+	tx_message.msg_size = 0;
+	tx_message.pkt_size = 255;
+	tx_message.dest_addr = 0x55;
+
+	status = cmd_channel_mock_init_with_send_packets (&channel, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_send_message (&channel.base, &tx_message);
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_mock_validate_and_release (&channel);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void cmd_channel_test_send_message_send_packets_send_failure (CuTest *test)
+{
+	struct cmd_channel_mock channel;
+	struct cmd_message tx_message;
+	uint8_t msg_data[255 * 2];
+	int status;
+	int i;
+
+	TEST_START;
+
+	for (i = 0; i < (int) sizeof (msg_data); i++) {
+		msg_data[i] = i;
+	}
+
+	tx_message.data = msg_data;
+	tx_message.msg_size = sizeof (msg_data);
+	tx_message.pkt_size = 255;
+	tx_message.dest_addr = 0x55;
+
+	status = cmd_channel_mock_init_with_send_packets (&channel, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&channel.mock, channel.base.send_packets, &channel,
+		CMD_CHANNEL_TX_FAILED,
+		MOCK_ARG_VALIDATOR (cmd_channel_mock_validate_message, &tx_message, sizeof (tx_message)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = cmd_channel_send_message (&channel.base, &tx_message);
+	CuAssertIntEquals (test, CMD_CHANNEL_TX_FAILED, status);
+
+	status = cmd_channel_mock_validate_and_release (&channel);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void cmd_channel_test_get_packet_count (CuTest *test)
+{
+	struct cmd_message message;
+	uint8_t msg_data[255 * 3];
+	size_t count;
+
+	TEST_START;
+
+	message.data = msg_data;
+	message.pkt_size = 255;
+	message.dest_addr = 0x55;
+
+	message.msg_size = 1;
+	count = cmd_channel_get_packet_count (&message);
+	CuAssertIntEquals (test, 1, count);
+
+	message.msg_size = 255;
+	count = cmd_channel_get_packet_count (&message);
+	CuAssertIntEquals (test, 1, count);
+
+	message.msg_size = 256;
+	count = cmd_channel_get_packet_count (&message);
+	CuAssertIntEquals (test, 2, count);
+
+	message.msg_size = sizeof (msg_data);
+	count = cmd_channel_get_packet_count (&message);
+	CuAssertIntEquals (test, 3, count);
+}
+
+static void cmd_channel_test_get_packet_count_empty (CuTest *test)
+{
+	struct cmd_message message;
+	uint8_t msg_data[255];
+	size_t count;
+
+	TEST_START;
+
+	message.data = msg_data;
+	message.msg_size = 0;
+	message.pkt_size = 255;
+	message.dest_addr = 0x55;
+
+	count = cmd_channel_get_packet_count (&message);
+	CuAssertIntEquals (test, 0, count);
+
+	message.msg_size = sizeof (msg_data);
+	message.pkt_size = 0;
+
+	count = cmd_channel_get_packet_count (&message);
+	CuAssertIntEquals (test, 0, count);
+}
+
+static void cmd_channel_test_get_packet_count_null (CuTest *test)
+{
+	size_t count;
+
+	TEST_START;
+
+	count = cmd_channel_get_packet_count (NULL);
+	CuAssertIntEquals (test, 0, count);
+}
+
+static void cmd_channel_test_get_packet (CuTest *test)
+{
+	struct cmd_message message;
+	uint8_t msg_data[255 * 2 + 20];
+	const uint8_t *packet;
+	size_t length;
+	int status;
+
+	TEST_START;
+
+	message.data = msg_data;
+	message.msg_size = sizeof (msg_data);
+	message.pkt_size = 255;
+	message.dest_addr = 0x55;
+
+	status = cmd_channel_get_packet (&message, 0, &packet, &length);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, msg_data, (void*) packet);
+	CuAssertIntEquals (test, 255, length);
+
+	status = cmd_channel_get_packet (&message, 1, &packet, &length);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, &msg_data[255], (void*) packet);
+	CuAssertIntEquals (test, 255, length);
+
+	status = cmd_channel_get_packet (&message, 2, &packet, &length);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, &msg_data[255 * 2], (void*) packet);
+	CuAssertIntEquals (test, 20, length);
+}
+
+static void cmd_channel_test_get_packet_single_packet (CuTest *test)
+{
+	struct cmd_message message;
+	uint8_t msg_data[14];
+	const uint8_t *packet;
+	size_t length;
+	int status;
+
+	TEST_START;
+
+	message.data = msg_data;
+	message.msg_size = sizeof (msg_data);
+	message.pkt_size = sizeof (msg_data);
+	message.dest_addr = 0x55;
+
+	status = cmd_channel_get_packet (&message, 0, &packet, &length);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, msg_data, (void*) packet);
+	CuAssertIntEquals (test, sizeof (msg_data), length);
+}
+
+static void cmd_channel_test_get_packet_null (CuTest *test)
+{
+	struct cmd_message message;
+	uint8_t msg_data[255];
+	const uint8_t *packet;
+	size_t length;
+	int status;
+
+	TEST_START;
+
+	message.data = msg_data;
+	message.msg_size = sizeof (msg_data);
+	message.pkt_size = 255;
+	message.dest_addr = 0x55;
+
+	status = cmd_channel_get_packet (NULL, 0, &packet, &length);
+	CuAssertIntEquals (test, CMD_CHANNEL_INVALID_ARGUMENT, status);
+
+	status = cmd_channel_get_packet (&message, 0, NULL, &length);
+	CuAssertIntEquals (test, CMD_CHANNEL_INVALID_ARGUMENT, status);
+
+	status = cmd_channel_get_packet (&message, 0, &packet, NULL);
+	CuAssertIntEquals (test, CMD_CHANNEL_INVALID_ARGUMENT, status);
+}
+
+static void cmd_channel_test_get_packet_out_of_range (CuTest *test)
+{
+	struct cmd_message message;
+	uint8_t msg_data[255 + 20];
+	const uint8_t *packet;
+	size_t length;
+	int status;
+
+	TEST_START;
+
+	message.data = msg_data;
+	message.msg_size = sizeof (msg_data);
+	message.pkt_size = 255;
+	message.dest_addr = 0x55;
+
+	status = cmd_channel_get_packet (&message, 2, &packet, &length);
+	CuAssertIntEquals (test, CMD_CHANNEL_INVALID_ARGUMENT, status);
+
+	message.msg_size = 0;
+
+	status = cmd_channel_get_packet (&message, 0, &packet, &length);
+	CuAssertIntEquals (test, CMD_CHANNEL_INVALID_ARGUMENT, status);
+}
+
 
 TEST_SUITE_START (cmd_channel);
 
@@ -3141,5 +3500,17 @@ TEST (cmd_channel_test_send_message_max_message);
 TEST (cmd_channel_test_send_message_null);
 TEST (cmd_channel_test_send_message_send_failure);
 TEST (cmd_channel_test_send_message_multiple_packets_send_failure);
+TEST (cmd_channel_test_send_message_send_packets_single_packet);
+TEST (cmd_channel_test_send_message_send_packets_multiple_packets);
+TEST (cmd_channel_test_send_message_send_packets_multiple_messages);
+TEST (cmd_channel_test_send_message_send_packets_empty_message);
+TEST (cmd_channel_test_send_message_send_packets_send_failure);
+TEST (cmd_channel_test_get_packet_count);
+TEST (cmd_channel_test_get_packet_count_empty);
+TEST (cmd_channel_test_get_packet_count_null);
+TEST (cmd_channel_test_get_packet);
+TEST (cmd_channel_test_get_packet_single_packet);
+TEST (cmd_channel_test_get_packet_null);
+TEST (cmd_channel_test_get_packet_out_of_range);
 
 TEST_SUITE_END;
@@ -7386,6 +7386,104 @@ static void cmd_interface_system_test_process_heap_stats_fail (CuTest *test)
 	complete_cmd_interface_system_mock_test (test, &cmd);
 }
 
+static void cmd_interface_system_test_process_debug_log_filter (CuTest *test)
+{
+	struct cmd_interface_system_testing cmd;
+	struct debug_log_filter filter;
+	struct debug_log_filter_state state;
+	int status;
+
+	TEST_START;
+
+	setup_cmd_interface_system_mock_test (test, &cmd, true, true, true, true, false, false, true,
+		true, true, true);
+
+	status = debug_log_filter_init (&filter, &state, NULL, 0, 0, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	cerberus_protocol_diagnostic_commands_testing_process_debug_log_filter (test,
+		&cmd.handler.base, &filter);
+	debug_log_filter_release (&filter);
+	complete_cmd_interface_system_mock_test (test, &cmd);
+}
+
+static void cmd_interface_system_test_process_debug_log_filter_query (CuTest *test)
+{
+	struct cmd_interface_system_testing cmd;
+	struct debug_log_filter filter;
+	struct debug_log_filter_state state;
+	int status;
+
+	TEST_START;
+
+	setup_cmd_interface_system_mock_test (test, &cmd, true, true, true, true, false, false, true,
+		true, true, true);
+
+	status = debug_log_filter_init (&filter, &state, NULL, 0, 0, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	cerberus_protocol_diagnostic_commands_testing_process_debug_log_filter_query (test,
+		&cmd.handler.base, &filter);
+	debug_log_filter_release (&filter);
+	complete_cmd_interface_system_mock_test (test, &cmd);
+}
+
+static void cmd_interface_system_test_process_debug_log_filter_invalid_len (CuTest *test)
+{
+	struct cmd_interface_system_testing cmd;
+	struct debug_log_filter filter;
+	struct debug_log_filter_state state;
+	int status;
+
+	TEST_START;
+
+	setup_cmd_interface_system_mock_test (test, &cmd, true, true, true, true, false, false, true,
+		true, true, true);
+
+	status = debug_log_filter_init (&filter, &state, NULL, 0, 0, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	cerberus_protocol_diagnostic_commands_testing_process_debug_log_filter_invalid_len (test,
+		&cmd.handler.base, &filter);
+	debug_log_filter_release (&filter);
+	complete_cmd_interface_system_mock_test (test, &cmd);
+}
+
+static void cmd_interface_system_test_process_debug_log_filter_invalid_threshold (CuTest *test)
+{
+	struct cmd_interface_system_testing cmd;
+	struct debug_log_filter filter;
+	struct debug_log_filter_state state;
+	int status;
+
+	TEST_START;
+
+	setup_cmd_interface_system_mock_test (test, &cmd, true, true, true, true, false, false, true,
+		true, true, true);
+
+	status = debug_log_filter_init (&filter, &state, NULL, 0, 0, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	cerberus_protocol_diagnostic_commands_testing_process_debug_log_filter_invalid_threshold (test,
+		&cmd.handler.base, &filter);
+	debug_log_filter_release (&filter);
+	complete_cmd_interface_system_mock_test (test, &cmd);
+}
+
+static void cmd_interface_system_test_process_debug_log_filter_no_filter (CuTest *test)
+{
+	struct cmd_interface_system_testing cmd;
+
+	TEST_START;
+
+	setup_cmd_interface_system_mock_test (test, &cmd, true, true, true, true, false, false, true,
+		true, true, true);
+
+	cerberus_protocol_diagnostic_commands_testing_process_debug_log_filter_no_filter (test,
+		&cmd.handler.base);
+	complete_cmd_interface_system_mock_test (test, &cmd);
+}
+
 static void cmd_interface_system_test_supports_all_required_commands (CuTest *test)
 {
 	struct cmd_interface_system_testing cmd;
@@ -8625,6 +8723,11 @@ TEST (cmd_interface_system_test_process_session_sync_invalid_len);
 TEST (cmd_interface_system_test_process_heap_stats);
 TEST (cmd_interface_system_test_process_heap_stats_invalid_len);
 TEST (cmd_interface_system_test_process_heap_stats_fail);
+TEST (cmd_interface_system_test_process_debug_log_filter);
+TEST (cmd_interface_system_test_process_debug_log_filter_query);
+TEST (cmd_interface_system_test_process_debug_log_filter_invalid_len);
+TEST (cmd_interface_system_test_process_debug_log_filter_invalid_threshold);
+TEST (cmd_interface_system_test_process_debug_log_filter_no_filter);
 TEST (cmd_interface_system_test_supports_all_required_commands);
 TEST (cmd_interface_system_test_process_response_null);
 TEST (cmd_interface_system_test_process_response_payload_too_short);
@@ -7,11 +7,167 @@
 #include "testing.h"
 #include "common/observable.h"
 #include "testing/mock/common/observer_mock.h"
+#include "common/unused.h"
 
 
 TEST_SUITE_LABEL ("observable");
 
 
+/**
+ * Context for sending a notification from an observer callback.
+ */
+struct observable_testing_nested {
+	CuTest *test;						/**< The testing framework. */
+	struct observable *observable;		/**< The observable to send the notification. */
+	void *arg;							/**< Argument for the notification. */
+};
+
+/**
+ * Mock action to send a notification to observers while handling a notification.
+ *
+ * @param expected The expectation for the observer call.
+ * @param called The actual observer call.
+ *
+ * @return 0 always.
+ */
+static int64_t observable_testing_notify_nested (const struct mock_call *expected,
+	const struct mock_call *called)
+{
+	struct observable_testing_nested *nested = expected->context;
+	int status;
+
+	UNUSED (called);
+
+	status = observable_notify_observers_with_ptr (nested->observable,
+		offsetof (struct observer_mock, event_ptr_arg), nested->arg);
+	CuAssertIntEquals (nested->test, 0, status);
+
+	return 0;
+}
+
+/**
+ * Mock action to simulate an observer that takes time to handle a notification.
+ *
+ * @param expected The expectation for the observer call.
+ * @param called The actual observer call.
+ *
+ * @return 0 always.
+ */
+static int64_t observable_testing_slow_observer (const struct mock_call *expected,
+	const struct mock_call *called)
+{
+	UNUSED (expected);
+	UNUSED (called);
+
+	platform_msleep (10);
+
+	return 0;
+}
+
+
+/**
+ * Context for changing the registered observers from an observer callback.
+ */
+struct observable_testing_update {
+	CuTest *test;						/**< The testing framework. */
+	struct observable *observable;		/**< The observable to update. */
+	void *observer;						/**< The observer to add or remove. */
+	void *second;						/**< A second observer to add. */
+};
+
+/**
+ * Mock action to remove an observer while handling a notification.
+ *
+ * @param expected The expectation for the observer call.
+ * @param called The actual observer call.
+ *
+ * @return 0 always.
+ */
+static int64_t observable_testing_remove_nested (const struct mock_call *expected,
+	const struct mock_call *called)
+{
+	struct observable_testing_update *update = expected->context;
+	int status;
+
+	UNUSED (called);
+
+	/* The notification calling this function is still using the previous snapshot. */
+	status = observable_remove_observer (update->observable, update->observer);
+	CuAssertIntEquals (update->test, OBSERVABLE_OBSERVER_IN_USE, status);
+
+	return 0;
+}
+
+/**
+ * Mock action to add two observers while handling a notification.
+ *
+ * @param expected The expectation for the observer call.
+ * @param called The actual observer call.
+ *
+ * @return 0 always.
+ */
+static int64_t observable_testing_add_nested (const struct mock_call *expected,
+	const struct mock_call *called)
+{
+	struct observable_testing_update *update = expected->context;
+	int status;
+
+	UNUSED (called);
+
+	status = observable_add_observer (update->observable, update->observer);
+	CuAssertIntEquals (update->test, 0, status);
+
+	/* The first update made the snapshot used by this notification inactive, so it can't be
+	 * updated again until the notification completes. */
+	status = observable_add_observer (update->observable, update->second);
+	CuAssertIntEquals (update->test, OBSERVABLE_NOTIFICATION_BUSY, status);
+
+	return 0;
+}
+
+/**
+ * Context for a notification sent from a separate thread.
+ */
+struct observable_testing_background {
+	struct observable *observable;		/**< The observable to send the notification. */
+	volatile uint32_t started;			/**< Flag indicating the observer has been called. */
+	volatile uint32_t done;				/**< Flag indicating the observer has finished. */
+};
+
+/**
+ * Mock action to simulate a slow observer and track when it is running.
+ *
+ * @param expected The expectation for the observer call.
+ * @param called The actual observer call.
+ *
+ * @return 0 always.
+ */
+static int64_t observable_testing_tracked_observer (const struct mock_call *expected,
+	const struct mock_call *called)
+{
+	struct observable_testing_background *background = expected->context;
+
+	UNUSED (called);
+
+	platform_atomic_store (&background->started, 1);
+	platform_msleep (50);
+	platform_atomic_store (&background->done, 1);
+
+	return 0;
+}
+
+/**
+ * Timer callback to send a notification from a separate thread.
+ *
+ * @param context The notification context.
+ */
+static void observable_testing_notify_background (void *context)
+{
+	struct observable_testing_background *background = context;
+
+	observable_notify_observers (background->observable, offsetof (struct observer_mock, event));
+}
+
 /*******************
  * Test cases
  *******************/
@@ -830,6 +986,461 @@ static void observable_test_remove_observer_null (CuTest *test)
 	observable_release (&observable);
 }
 
+static void observable_test_remove_observer_add_again (CuTest *test)
+{
+	struct observer_mock observer1;
+	struct observer_mock observer2;
+	struct observable observable;
+	int status;
+
+	TEST_START;
+
+	status = observer_mock_init (&observer1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = observer_mock_init (&observer2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = observable_init (&observable);
+	CuAssertIntEquals (test, 0, status);
+
+	status = observable_add_observer (&observable, &observer1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = observable_add_observer (&observable, &observer2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = observable_remove_observer (&observable, &observer1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = observable_remove_observer (&observable, &observer2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = observable_add_observer (&observable, &observer1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&observer1.mock, observer1.event, &observer1, 0);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = observable_notify_observers (&observable, offsetof (struct observer_mock, event));
+	CuAssertIntEquals (test, 0, status);
+
+	status = observer_mock_validate_and_release (&observer1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = observer_mock_validate_and_release (&observer2);
+	CuAssertIntEquals (test, 0, status);
+
+	observable_release (&observable);
+}
+
+static void observable_test_notify_observers_from_observer (CuTest *test)
+{
+	struct observer_mock observer1;
+	struct observer_mock observer2;
+	struct observable observable;
+	struct observable_testing_nested nested;
+	int status;
+	void *arg = &status;
+
+	TEST_START;
+
+	status = observer_mock_init (&observer1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = observer_mock_init (&observer2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = observable_init (&observable);
+	CuAssertIntEquals (test, 0, status);
+
+	status = observable_add_observer (&observable, &observer1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = observable_add_observer (&observable, &observer2);
+	CuAssertIntEquals (test, 0, status);
+
+	nested.test = test;
+	nested.observable = &observable;
+	nested.arg = arg;
+
+	/* Notifications don't hold a lock, so an observer can generate a new event. */
+	status = mock_expect (&observer1.mock, observer1.event, &observer1, 0);
+	status |= mock_expect_external_action (&observer1.mock, observable_testing_notify_nested,
+		&nested);
+	status |= mock_expect (&observer1.mock, observer1.event_ptr_arg, &observer1, 0,
+		MOCK_ARG_PTR (arg));
+	status |= mock_expect (&observer2.mock, observer2.event_ptr_arg, &observer2, 0,
+		MOCK_ARG_PTR (arg));
+	status |= mock_expect (&observer2.mock, observer2.event, &observer2, 0);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = observable_notify_observers (&observable, offsetof (struct observer_mock, event));
+	CuAssertIntEquals (test, 0, status);
+
+	status = observer_mock_validate_and_release (&observer1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = observer_mock_validate_and_release (&observer2);
+	CuAssertIntEquals (test, 0, status);
+
+	observable_release (&observable);
+}
+
+static void observable_test_remove_observer_notification_in_progress (CuTest *test)
+{
+	struct observer_mock observer;
+	struct observable observable;
+	struct observable_testing_background background;
+	platform_timer timer;
+	int status;
+
+	TEST_START;
+
+	status = observer_mock_init (&observer);
+	CuAssertIntEquals (test, 0, status);
+
+	status = observable_init (&observable);
+	CuAssertIntEquals (test, 0, status);
+
+	status = observable_add_observer (&observable, &observer);
+	CuAssertIntEquals (test, 0, status);
+
+	background.observable = &observable;
+	background.started = 0;
+	background.done = 0;
+
+	status = platform_timer_create (&timer, observable_testing_notify_background, &background);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&observer.mock, observer.event, &observer, 0);
+	status |= mock_expect_external_action (&observer.mock, observable_testing_tracked_observer,
+		&background);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = platform_timer_arm_one_shot (&timer, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	while (!platform_atomic_load (&background.started)) {
+		platform_msleep (1);
+	}
+
+	/* The observer must not be in use once it has been removed. */
+	status = observable_remove_observer (&observable, &observer);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, platform_atomic_load (&background.done));
+
+	platform_timer_delete (&timer);
+
+	status = observable_notify_observers (&observable, offsetof (struct observer_mock, event));
+	CuAssertIntEquals (test, 0, status);
+
+	status = observer_mock_validate_and_release (&observer);
+	CuAssertIntEquals (test, 0, status);
+
+	observable_release (&observable);
+}
+
+static void observable_test_remove_observer_from_observer (CuTest *test)
+{
+	struct observer_mock observer1;
+	struct observer_mock observer2;
+	struct observable observable;
+	struct observable_testing_update update;
+	int status;
+
+	TEST_START;
+
+	status = observer_mock_init (&observer1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = observer_mock_init (&observer2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = observable_init (&observable);
+	CuAssertIntEquals (test, 0, status);
+
+	status = observable_add_observer (&observable, &observer1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = observable_add_observer (&observable, &observer2);
+	CuAssertIntEquals (test, 0, status);
+
+	update.test = test;
+	update.observable = &observable;
+	update.observer = &observer2;
+	update.second = NULL;
+
+	/* The notification in progress still calls the removed observer. */
+	status = mock_expect (&observer1.mock, observer1.event, &observer1, 0);
+	status |= mock_expect_external_action (&observer1.mock, observable_testing_remove_nested,
+		&update);
+	status |= mock_expect (&observer2.mock, observer2.event, &observer2, 0);
+
+	status |= mock_expect (&observer1.mock, observer1.event, &observer1, 0);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = observable_notify_observers (&observable, offsetof (struct observer_mock, event));
+	CuAssertIntEquals (test, 0, status);
+
+	status = observable_notify_observers (&observable, offsetof (struct observer_mock, event));
+	CuAssertIntEquals (test, 0, status);
+
+	/* Once no notifications are running, the registered observers can be updated. */
+	status = observable_remove_observer (&observable, &observer1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = observable_notify_observers (&observable, offsetof (struct observer_mock, event));
+	CuAssertIntEquals (test, 0, status);
+
+	status = observer_mock_validate_and_release (&observer1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = observer_mock_validate_and_release (&observer2);
+	CuAssertIntEquals (test, 0, status);
+
+	observable_release (&observable);
+}
+
+static void observable_test_add_observer_from_observer (CuTest *test)
+{
+	struct observer_mock observer1;
+	struct observer_mock observer2;
+	struct observer_mock observer3;
+	struct observable observable;
+	struct observable_testing_update update;
+	int status;
+
+	TEST_START;
+
+	status = observer_mock_init (&observer1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = observer_mock_init (&observer2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = observer_mock_init (&observer3);
+	CuAssertIntEquals (test, 0, status);
+
+	status = observable_init (&observable);
+	CuAssertIntEquals (test, 0, status);
+
+	status = observable_add_observer (&observable, &observer1);
+	CuAssertIntEquals (test, 0, status);
+
+	update.test = test;
+	update.observable = &observable;
+	update.observer = &observer2;
+	update.second = &observer3;
+
+	status = mock_expect (&observer1.mock, observer1.event, &observer1, 0);
+	status |= mock_expect_external_action (&observer1.mock, observable_testing_add_nested,
+		&update);
+
+	status |= mock_expect (&observer1.mock, observer1.event, &observer1, 0);
+	status |= mock_expect (&observer2.mock, observer2.event, &observer2, 0);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = observable_notify_observers (&observable, offsetof (struct observer_mock, event));
+	CuAssertIntEquals (test, 0, status);
+
+	status = observable_notify_observers (&observable, offsetof (struct observer_mock, event));
+	CuAssertIntEquals (test, 0, status);
+
+	status = observer_mock_validate_and_release (&observer1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = observer_mock_validate_and_release (&observer2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = observer_mock_validate_and_release (&observer3);
+	CuAssertIntEquals (test, 0, status);
+
+	observable_release (&observable);
+}
+
+static void observable_test_get_observer_stats (CuTest *test)
+{
+	struct observer_mock observer1;
+	struct observer_mock observer2;
+	struct observable observable;
+	struct observable_observer_stats stats;
+	int status;
+
+	TEST_START;
+
+	status = observer_mock_init (&observer1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = observer_mock_init (&observer2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = observable_init (&observable);
+	CuAssertIntEquals (test, 0, status);
+
+	status = observable_add_observer (&observable, &observer1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = observable_add_observer (&observable, &observer2);
+	CuAssertIntEquals (test, 0, status);
+
+	observable_enable_timing (&observable, true);
+
+	status = mock_expect (&observer1.mock, observer1.event, &observer1, 0);
+	status |= mock_expect_external_action (&observer1.mock, observable_testing_slow_observer,
+		NULL);
+	status |= mock_expect (&observer2.mock, observer2.event, &observer2, 0);
+
+	status |= mock_expect (&observer1.mock, observer1.event, &observer1, 0);
+	status |= mock_expect (&observer2.mock, observer2.event, &observer2, 0);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = observable_notify_observers (&observable, offsetof (struct observer_mock, event));
+	CuAssertIntEquals (test, 0, status);
+
+	status = observable_notify_observers (&observable, offsetof (struct observer_mock, event));
+	CuAssertIntEquals (test, 0, status);
+
+	status = observable_get_observer_stats (&observable, &observer1, &stats);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 2, stats.notifications);
+	CuAssertTrue (test, (stats.max_ms >= 10));
+	CuAssertTrue (test, (stats.total_ms >= stats.max_ms));
+
+	status = observable_get_observer_stats (&observable, &observer2, &stats);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 2, stats.notifications);
+	CuAssertTrue (test, (stats.max_ms < 10));
+
+	status = observer_mock_validate_and_release (&observer1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = observer_mock_validate_and_release (&observer2);
+	CuAssertIntEquals (test, 0, status);
+
+	observable_release (&observable);
+}
+
+static void observable_test_get_observer_stats_timing_disabled (CuTest *test)
+{
+	struct observer_mock observer;
+	struct observable observable;
+	struct observable_observer_stats stats;
+	int status;
+
+	TEST_START;
+
+	status = observer_mock_init (&observer);
+	CuAssertIntEquals (test, 0, status);
+
+	status = observable_init (&observable);
+	CuAssertIntEquals (test, 0, status);
+
+	status = observable_add_observer (&observable, &observer);
+	CuAssertIntEquals (test, 0, status);
+
+	observable_enable_timing (&observable, true);
+	observable_enable_timing (&observable, false);
+
+	status = mock_expect (&observer.mock, observer.event, &observer, 0);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = observable_notify_observers (&observable, offsetof (struct observer_mock, event));
+	CuAssertIntEquals (test, 0, status);
+
+	status = observable_get_observer_stats (&observable, &observer, &stats);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 0, stats.notifications);
+	CuAssertIntEquals (test, 0, stats.total_ms);
+	CuAssertIntEquals (test, 0, stats.max_ms);
+
+	status = observer_mock_validate_and_release (&observer);
+	CuAssertIntEquals (test, 0, status);
+
+	observable_release (&observable);
+}
+
+static void observable_test_get_observer_stats_not_registered (CuTest *test)
+{
+	struct observer_mock observer1;
+	struct observer_mock observer2;
+	struct observable observable;
+	struct observable_observer_stats stats;
+	int status;
+
+	TEST_START;
+
+	status = observer_mock_init (&observer1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = observer_mock_init (&observer2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = observable_init (&observable);
+	CuAssertIntEquals (test, 0, status);
+
+	status = observable_get_observer_stats (&observable, &observer1, &stats);
+	CuAssertIntEquals (test, OBSERVABLE_UNKNOWN_OBSERVER, status);
+
+	status = observable_add_observer (&observable, &observer1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = observable_get_observer_stats (&observable, &observer2, &stats);
+	CuAssertIntEquals (test, OBSERVABLE_UNKNOWN_OBSERVER, status);
+
+	status = observer_mock_validate_and_release (&observer1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = observer_mock_validate_and_release (&observer2);
+	CuAssertIntEquals (test, 0, status);
+
+	observable_release (&observable);
+}
+
+static void observable_test_get_observer_stats_null (CuTest *test)
+{
+	struct observer_mock observer;
+	struct observable observable;
+	struct observable_observer_stats stats;
+	int status;
+
+	TEST_START;
+
+	status = observer_mock_init (&observer);
+	CuAssertIntEquals (test, 0, status);
+
+	status = observable_init (&observable);
+	CuAssertIntEquals (test, 0, status);
+
+	status = observable_add_observer (&observable, &observer);
+	CuAssertIntEquals (test, 0, status);
+
+	observable_enable_timing (NULL, true);
+
+	status = observable_get_observer_stats (NULL, &observer, &stats);
+	CuAssertIntEquals (test, OBSERVABLE_INVALID_ARGUMENT, status);
+
+	status = observable_get_observer_stats (&observable, NULL, &stats);
+	CuAssertIntEquals (test, OBSERVABLE_INVALID_ARGUMENT, status);
+
+	status = observable_get_observer_stats (&observable, &observer, NULL);
+	CuAssertIntEquals (test, OBSERVABLE_INVALID_ARGUMENT, status);
+
+	status = observer_mock_validate_and_release (&observer);
+	CuAssertIntEquals (test, 0, status);
+
+	observable_release (&observable);
+}
 
 TEST_SUITE_START (observable);
 
@@ -856,5 +1467,14 @@ TEST (observable_test_remove_observer_only_one);
 TEST (observable_test_remove_observer_none);
 TEST (observable_test_remove_observer_not_registered);
 TEST (observable_test_remove_observer_null);
+TEST (observable_test_remove_observer_add_again);
+TEST (observable_test_notify_observers_from_observer);
+TEST (observable_test_remove_observer_notification_in_progress);
+TEST (observable_test_remove_observer_from_observer);
+TEST (observable_test_add_observer_from_observer);
+TEST (observable_test_get_observer_stats);
+TEST (observable_test_get_observer_stats_timing_disabled);
+TEST (observable_test_get_observer_stats_not_registered);
+TEST (observable_test_get_observer_stats_null);
 
 TEST_SUITE_END;
@@ -62,6 +62,12 @@ void add_all_core_tests (CuSuite *suite)
 	
 	/* Test coverage for platform abstractions. */
 
+#if (defined TESTING_RUN_PLATFORM_ATOMIC_SUITE || \
+		defined TESTING_RUN_ALL_TESTS || defined TESTING_RUN_ALL_CORE_TESTS || \
+		(!defined TESTING_SKIP_ALL_TESTS && !defined TESTING_SKIP_ALL_CORE_TESTS)) && \
+	!defined TESTING_SKIP_PLATFORM_ATOMIC_SUITE
+	TESTING_RUN_SUITE (platform_atomic);
+#endif
 #if (defined TESTING_RUN_PLATFORM_CLOCK_SUITE || \
 		defined TESTING_RUN_ALL_TESTS || defined TESTING_RUN_ALL_CORE_TESTS || \
 		(!defined TESTING_SKIP_ALL_TESTS && !defined TESTING_SKIP_ALL_CORE_TESTS)) && \
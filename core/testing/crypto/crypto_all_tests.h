@@ -33,6 +33,12 @@ static void add_all_crypto_tests (CuSuite *suite)
 	!defined TESTING_SKIP_CHECKSUM_SUITE
 	TESTING_RUN_SUITE (checksum);
 #endif
+#if (defined TESTING_RUN_ECC_SUITE || \
+		defined TESTING_RUN_ALL_TESTS || defined TESTING_RUN_ALL_CORE_TESTS || \
+		(!defined TESTING_SKIP_ALL_TESTS && !defined TESTING_SKIP_ALL_CORE_TESTS)) && \
+	!defined TESTING_SKIP_ECC_SUITE
+	TESTING_RUN_SUITE (ecc);
+#endif
 #if (defined TESTING_RUN_ECC_ECC_HW_SUITE || \
 		defined TESTING_RUN_ALL_TESTS || defined TESTING_RUN_ALL_CORE_TESTS || \
 		(!defined TESTING_SKIP_ALL_TESTS && !defined TESTING_SKIP_ALL_CORE_TESTS)) && \
@@ -63,6 +69,12 @@ static void add_all_crypto_tests (CuSuite *suite)
 	!defined TESTING_SKIP_HASH_MBEDTLS_SUITE
 	TESTING_RUN_SUITE (hash_mbedtls);
 #endif
+#if (defined TESTING_RUN_HASH_POOL_SUITE || \
+		defined TESTING_RUN_ALL_TESTS || defined TESTING_RUN_ALL_CORE_TESTS || \
+		(!defined TESTING_SKIP_ALL_TESTS && !defined TESTING_SKIP_ALL_CORE_TESTS)) && \
+	!defined TESTING_SKIP_HASH_POOL_SUITE
+	TESTING_RUN_SUITE (hash_pool);
+#endif
 #if (defined TESTING_RUN_HASH_THREAD_SAFE_SUITE || \
 		defined TESTING_RUN_ALL_TESTS || defined TESTING_RUN_ALL_CORE_TESTS || \
 		(!defined TESTING_SKIP_ALL_TESTS && !defined TESTING_SKIP_ALL_CORE_TESTS)) && \
@@ -75,6 +87,12 @@ static void add_all_crypto_tests (CuSuite *suite)
 	!defined TESTING_SKIP_KDF_SUITE
 	TESTING_RUN_SUITE (kdf);
 #endif
+#if (defined TESTING_RUN_KEY_CACHE_SUITE || \
+		defined TESTING_RUN_ALL_TESTS || defined TESTING_RUN_ALL_CORE_TESTS || \
+		(!defined TESTING_SKIP_ALL_TESTS && !defined TESTING_SKIP_ALL_CORE_TESTS)) && \
+	!defined TESTING_SKIP_KEY_CACHE_SUITE
+	TESTING_RUN_SUITE (key_cache);
+#endif
 #if (defined TESTING_RUN_RNG_DUMMY_SUITE || \
 		defined TESTING_RUN_ALL_TESTS || defined TESTING_RUN_ALL_CORE_TESTS || \
 		(!defined TESTING_SKIP_ALL_TESTS && !defined TESTING_SKIP_ALL_CORE_TESTS)) && \
@@ -1,7 +1,17 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT license.
 
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "testing.h"
+#include "crypto/ecc.h"
+#include "testing/mock/crypto/ecc_mock.h"
 #include "testing/crypto/ecc_testing.h"
+#include "testing/crypto/signature_testing.h"
+
+
+TEST_SUITE_LABEL ("ecc");
 
 
 const uint8_t ECC_PRIVKEY[] = {
@@ -3292,3 +3302,275 @@ const uint8_t ECC521_PRIVKEY2_NO_PUBKEY_DER[] = {
 };
 
 const size_t ECC521_PRIVKEY2_NO_PUBKEY_DER_LEN = sizeof (ECC521_PRIVKEY2_NO_PUBKEY_DER);
+
+
+/*******************
+ * Test cases
+ *******************/
+
+static void ecc_test_verify_batch (CuTest *test)
+{
+	struct ecc_engine_mock mock;
+	struct ecc_public_key pub_key;
+	struct ecc_verify_batch_entry entries[3];
+	int status;
+
+	TEST_START;
+
+	status = ecc_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	entries[0].key = &pub_key;
+	entries[0].digest = SIG_HASH_TEST;
+	entries[0].length = SIG_HASH_LEN;
+	entries[0].signature = ECC_SIGNATURE_TEST;
+	entries[0].sig_length = ECC_SIG_TEST_LEN;
+	entries[0].status = -1;
+
+	entries[1].key = &pub_key;
+	entries[1].digest = SIG_HASH_TEST2;
+	entries[1].length = SIG_HASH_LEN;
+	entries[1].signature = ECC_SIGNATURE_TEST2;
+	entries[1].sig_length = ECC_SIG_TEST2_LEN;
+	entries[1].status = -1;
+
+	entries[2].key = &pub_key;
+	entries[2].digest = SHA384_TEST_HASH;
+	entries[2].length = SHA384_HASH_LENGTH;
+	entries[2].signature = ECC384_SIGNATURE_TEST;
+	entries[2].sig_length = ECC384_SIG_TEST_LEN;
+	entries[2].status = -1;
+
+	status = mock_expect (&mock.mock, mock.base.verify, &mock, 0, MOCK_ARG_PTR (&pub_key),
+		MOCK_ARG_PTR (SIG_HASH_TEST), MOCK_ARG (SIG_HASH_LEN), MOCK_ARG_PTR (ECC_SIGNATURE_TEST),
+		MOCK_ARG (ECC_SIG_TEST_LEN));
+	status |= mock_expect (&mock.mock, mock.base.verify, &mock, 0, MOCK_ARG_PTR (&pub_key),
+		MOCK_ARG_PTR (SIG_HASH_TEST2), MOCK_ARG (SIG_HASH_LEN),
+		MOCK_ARG_PTR (ECC_SIGNATURE_TEST2), MOCK_ARG (ECC_SIG_TEST2_LEN));
+	status |= mock_expect (&mock.mock, mock.base.verify, &mock, 0, MOCK_ARG_PTR (&pub_key),
+		MOCK_ARG_PTR (SHA384_TEST_HASH), MOCK_ARG (SHA384_HASH_LENGTH),
+		MOCK_ARG_PTR (ECC384_SIGNATURE_TEST), MOCK_ARG (ECC384_SIG_TEST_LEN));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = ecc_verify_batch (&mock.base, entries, 3);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, entries[0].status);
+	CuAssertIntEquals (test, 0, entries[1].status);
+	CuAssertIntEquals (test, 0, entries[2].status);
+
+	status = ecc_mock_validate_and_release (&mock);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void ecc_test_verify_batch_bad_signature (CuTest *test)
+{
+	struct ecc_engine_mock mock;
+	struct ecc_public_key pub_key;
+	struct ecc_verify_batch_entry entries[3];
+	int status;
+
+	TEST_START;
+
+	status = ecc_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	entries[0].key = &pub_key;
+	entries[0].digest = SIG_HASH_TEST;
+	entries[0].length = SIG_HASH_LEN;
+	entries[0].signature = ECC_SIGNATURE_TEST;
+	entries[0].sig_length = ECC_SIG_TEST_LEN;
+	entries[0].status = -1;
+
+	entries[1].key = &pub_key;
+	entries[1].digest = SIG_HASH_TEST2;
+	entries[1].length = SIG_HASH_LEN;
+	entries[1].signature = ECC_SIGNATURE_TEST2;
+	entries[1].sig_length = ECC_SIG_TEST2_LEN;
+	entries[1].status = -1;
+
+	entries[2].key = &pub_key;
+	entries[2].digest = SHA384_TEST_HASH;
+	entries[2].length = SHA384_HASH_LENGTH;
+	entries[2].signature = ECC384_SIGNATURE_TEST;
+	entries[2].sig_length = ECC384_SIG_TEST_LEN;
+	entries[2].status = -1;
+
+	status = mock_expect (&mock.mock, mock.base.verify, &mock, 0, MOCK_ARG_PTR (&pub_key),
+		MOCK_ARG_PTR (SIG_HASH_TEST), MOCK_ARG (SIG_HASH_LEN), MOCK_ARG_PTR (ECC_SIGNATURE_TEST),
+		MOCK_ARG (ECC_SIG_TEST_LEN));
+	status |= mock_expect (&mock.mock, mock.base.verify, &mock, ECC_ENGINE_BAD_SIGNATURE,
+		MOCK_ARG_PTR (&pub_key), MOCK_ARG_PTR (SIG_HASH_TEST2), MOCK_ARG (SIG_HASH_LEN),
+		MOCK_ARG_PTR (ECC_SIGNATURE_TEST2), MOCK_ARG (ECC_SIG_TEST2_LEN));
+	status |= mock_expect (&mock.mock, mock.base.verify, &mock, 0, MOCK_ARG_PTR (&pub_key),
+		MOCK_ARG_PTR (SHA384_TEST_HASH), MOCK_ARG (SHA384_HASH_LENGTH),
+		MOCK_ARG_PTR (ECC384_SIGNATURE_TEST), MOCK_ARG (ECC384_SIG_TEST_LEN));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = ecc_verify_batch (&mock.base, entries, 3);
+	CuAssertIntEquals (test, ECC_ENGINE_BAD_SIGNATURE, status);
+	CuAssertIntEquals (test, 0, entries[0].status);
+	CuAssertIntEquals (test, ECC_ENGINE_BAD_SIGNATURE, entries[1].status);
+	CuAssertIntEquals (test, 0, entries[2].status);
+
+	status = ecc_mock_validate_and_release (&mock);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void ecc_test_verify_batch_engine_support (CuTest *test)
+{
+	struct ecc_engine_mock mock;
+	struct ecc_verify_batch_entry entries[3];
+	int status;
+
+	TEST_START;
+
+	status = ecc_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	ecc_mock_enable_verify_batch (&mock);
+
+	status = mock_expect (&mock.mock, mock.base.verify_batch, &mock, 0, MOCK_ARG_PTR (entries),
+		MOCK_ARG (3));
+	CuAssertIntEquals (test, 0, status);
+
+	status = ecc_verify_batch (&mock.base, entries, 3);
+	CuAssertIntEquals (test, 0, status);
+
+	status = ecc_mock_validate_and_release (&mock);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void ecc_test_verify_batch_no_entries (CuTest *test)
+{
+	struct ecc_engine_mock mock;
+	int status;
+
+	TEST_START;
+
+	status = ecc_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = ecc_verify_batch (&mock.base, NULL, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = ecc_mock_validate_and_release (&mock);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void ecc_test_verify_batch_null (CuTest *test)
+{
+	struct ecc_engine_mock mock;
+	struct ecc_verify_batch_entry entries[3];
+	int status;
+
+	TEST_START;
+
+	status = ecc_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = ecc_verify_batch (NULL, entries, 3);
+	CuAssertIntEquals (test, ECC_ENGINE_INVALID_ARGUMENT, status);
+
+	status = ecc_verify_batch (&mock.base, NULL, 3);
+	CuAssertIntEquals (test, ECC_ENGINE_INVALID_ARGUMENT, status);
+
+	status = ecc_mock_validate_and_release (&mock);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void ecc_test_verify_batch_error (CuTest *test)
+{
+	struct ecc_engine_mock mock;
+	struct ecc_public_key pub_key;
+	struct ecc_verify_batch_entry entries[3];
+	int status;
+
+	TEST_START;
+
+	status = ecc_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	entries[0].key = &pub_key;
+	entries[0].digest = SIG_HASH_TEST;
+	entries[0].length = SIG_HASH_LEN;
+	entries[0].signature = ECC_SIGNATURE_TEST;
+	entries[0].sig_length = ECC_SIG_TEST_LEN;
+	entries[0].status = -1;
+
+	entries[1].key = &pub_key;
+	entries[1].digest = SIG_HASH_TEST2;
+	entries[1].length = SIG_HASH_LEN;
+	entries[1].signature = ECC_SIGNATURE_TEST2;
+	entries[1].sig_length = ECC_SIG_TEST2_LEN;
+	entries[1].status = -1;
+
+	entries[2].key = &pub_key;
+	entries[2].digest = SHA384_TEST_HASH;
+	entries[2].length = SHA384_HASH_LENGTH;
+	entries[2].signature = ECC384_SIGNATURE_TEST;
+	entries[2].sig_length = ECC384_SIG_TEST_LEN;
+	entries[2].status = -1;
+
+	status = mock_expect (&mock.mock, mock.base.verify, &mock, ECC_ENGINE_BAD_SIGNATURE,
+		MOCK_ARG_PTR (&pub_key), MOCK_ARG_PTR (SIG_HASH_TEST), MOCK_ARG (SIG_HASH_LEN),
+		MOCK_ARG_PTR (ECC_SIGNATURE_TEST), MOCK_ARG (ECC_SIG_TEST_LEN));
+	status |= mock_expect (&mock.mock, mock.base.verify, &mock, ECC_ENGINE_VERIFY_FAILED,
+		MOCK_ARG_PTR (&pub_key), MOCK_ARG_PTR (SIG_HASH_TEST2), MOCK_ARG (SIG_HASH_LEN),
+		MOCK_ARG_PTR (ECC_SIGNATURE_TEST2), MOCK_ARG (ECC_SIG_TEST2_LEN));
+	status |= mock_expect (&mock.mock, mock.base.verify, &mock, ECC_ENGINE_NO_MEMORY,
+		MOCK_ARG_PTR (&pub_key), MOCK_ARG_PTR (SHA384_TEST_HASH), MOCK_ARG (SHA384_HASH_LENGTH),
+		MOCK_ARG_PTR (ECC384_SIGNATURE_TEST), MOCK_ARG (ECC384_SIG_TEST_LEN));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = ecc_verify_batch (&mock.base, entries, 3);
+	CuAssertIntEquals (test, ECC_ENGINE_VERIFY_FAILED, status);
+	CuAssertIntEquals (test, ECC_ENGINE_BAD_SIGNATURE, entries[0].status);
+	CuAssertIntEquals (test, ECC_ENGINE_VERIFY_FAILED, entries[1].status);
+	CuAssertIntEquals (test, ECC_ENGINE_NO_MEMORY, entries[2].status);
+
+	status = ecc_mock_validate_and_release (&mock);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void ecc_test_is_verify_batch_supported (CuTest *test)
+{
+	struct ecc_engine_mock mock;
+	int status;
+
+	TEST_START;
+
+	status = ecc_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, false, ecc_is_verify_batch_supported (&mock.base));
+
+	ecc_mock_enable_verify_batch (&mock);
+	CuAssertIntEquals (test, true, ecc_is_verify_batch_supported (&mock.base));
+
+	status = ecc_mock_validate_and_release (&mock);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void ecc_test_is_verify_batch_supported_null (CuTest *test)
+{
+	TEST_START;
+
+	CuAssertIntEquals (test, false, ecc_is_verify_batch_supported (NULL));
+}
+
+
+TEST_SUITE_START (ecc);
+
+TEST (ecc_test_verify_batch);
+TEST (ecc_test_verify_batch_bad_signature);
+TEST (ecc_test_verify_batch_engine_support);
+TEST (ecc_test_verify_batch_no_entries);
+TEST (ecc_test_verify_batch_null);
+TEST (ecc_test_verify_batch_error);
+TEST (ecc_test_is_verify_batch_supported);
+TEST (ecc_test_is_verify_batch_supported_null);
+
+TEST_SUITE_END;
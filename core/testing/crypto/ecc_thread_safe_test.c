@@ -43,6 +43,7 @@ static void ecc_thread_safe_test_init (CuTest *test)
 	CuAssertPtrNotNull (test, engine.base.get_public_key_der);
 	CuAssertPtrNotNull (test, engine.base.sign);
 	CuAssertPtrNotNull (test, engine.base.verify);
+	CuAssertPtrEquals (test, NULL, engine.base.verify_batch);
 	CuAssertPtrNotNull (test, engine.base.get_shared_secret_max_length);
 	CuAssertPtrNotNull (test, engine.base.compute_shared_secret);
 
@@ -52,6 +53,30 @@ static void ecc_thread_safe_test_init (CuTest *test)
 	ecc_thread_safe_release (&engine);
 }
 
+static void ecc_thread_safe_test_init_verify_batch (CuTest *test)
+{
+	struct ecc_engine_thread_safe engine;
+	struct ecc_engine_mock mock;
+	int status;
+
+	TEST_START;
+
+	status = ecc_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	ecc_mock_enable_verify_batch (&mock);
+
+	status = ecc_thread_safe_init (&engine, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrNotNull (test, engine.base.verify_batch);
+
+	status = ecc_mock_validate_and_release (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	ecc_thread_safe_release (&engine);
+}
+
 static void ecc_thread_safe_test_init_null (CuTest *test)
 {
 	struct ecc_engine_thread_safe engine;
@@ -1057,6 +1082,110 @@ static void ecc_thread_safe_test_verify_null (CuTest *test)
 	ecc_thread_safe_release (&engine);
 }
 
+static void ecc_thread_safe_test_verify_batch (CuTest *test)
+{
+	struct ecc_engine_thread_safe engine;
+	struct ecc_engine_mock mock;
+	struct ecc_public_key pub_key;
+	struct ecc_verify_batch_entry entries[2];
+	int status;
+
+	TEST_START;
+
+	status = ecc_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	ecc_mock_enable_verify_batch (&mock);
+
+	status = ecc_thread_safe_init (&engine, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&mock.mock, mock.base.verify_batch, &mock, 0, MOCK_ARG_PTR (entries),
+		MOCK_ARG (2));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.verify_batch (&engine.base, entries, 2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Check lock has been released. */
+	engine.base.init_key_pair (&engine.base, (const uint8_t*) ECC_PRIVKEY_DER, ECC_PRIVKEY_DER_LEN,
+		NULL, &pub_key);
+
+	ecc_mock_release (&mock);
+	ecc_thread_safe_release (&engine);
+}
+
+static void ecc_thread_safe_test_verify_batch_error (CuTest *test)
+{
+	struct ecc_engine_thread_safe engine;
+	struct ecc_engine_mock mock;
+	struct ecc_public_key pub_key;
+	struct ecc_verify_batch_entry entries[2];
+	int status;
+
+	TEST_START;
+
+	status = ecc_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	ecc_mock_enable_verify_batch (&mock);
+
+	status = ecc_thread_safe_init (&engine, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&mock.mock, mock.base.verify_batch, &mock, ECC_ENGINE_BAD_SIGNATURE,
+		MOCK_ARG_PTR (entries), MOCK_ARG (2));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.verify_batch (&engine.base, entries, 2);
+	CuAssertIntEquals (test, ECC_ENGINE_BAD_SIGNATURE, status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Check lock has been released. */
+	engine.base.init_key_pair (&engine.base, (const uint8_t*) ECC_PRIVKEY_DER, ECC_PRIVKEY_DER_LEN,
+		NULL, &pub_key);
+
+	ecc_mock_release (&mock);
+	ecc_thread_safe_release (&engine);
+}
+
+static void ecc_thread_safe_test_verify_batch_null (CuTest *test)
+{
+	struct ecc_engine_thread_safe engine;
+	struct ecc_engine_mock mock;
+	struct ecc_public_key pub_key;
+	struct ecc_verify_batch_entry entries[2];
+	int status;
+
+	TEST_START;
+
+	status = ecc_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	ecc_mock_enable_verify_batch (&mock);
+
+	status = ecc_thread_safe_init (&engine, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.verify_batch (NULL, entries, 2);
+	CuAssertIntEquals (test, ECC_ENGINE_INVALID_ARGUMENT, status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Check lock has been released. */
+	engine.base.init_key_pair (&engine.base, (const uint8_t*) ECC_PRIVKEY_DER, ECC_PRIVKEY_DER_LEN,
+		NULL, &pub_key);
+
+	ecc_mock_release (&mock);
+	ecc_thread_safe_release (&engine);
+}
+
 static void ecc_thread_safe_test_get_shared_secret_max_length (CuTest *test)
 {
 	struct ecc_engine_thread_safe engine;
@@ -1265,6 +1394,7 @@ static void ecc_thread_safe_test_compute_shared_secret_null (CuTest *test)
 TEST_SUITE_START (ecc_thread_safe);
 
 TEST (ecc_thread_safe_test_init);
+TEST (ecc_thread_safe_test_init_verify_batch);
 TEST (ecc_thread_safe_test_init_null);
 TEST (ecc_thread_safe_test_release_null);
 TEST (ecc_thread_safe_test_init_key_pair);
@@ -1296,6 +1426,9 @@ TEST (ecc_thread_safe_test_sign_null);
 TEST (ecc_thread_safe_test_verify);
 TEST (ecc_thread_safe_test_verify_error);
 TEST (ecc_thread_safe_test_verify_null);
+TEST (ecc_thread_safe_test_verify_batch);
+TEST (ecc_thread_safe_test_verify_batch_error);
+TEST (ecc_thread_safe_test_verify_batch_null);
 TEST (ecc_thread_safe_test_get_shared_secret_max_length);
 TEST (ecc_thread_safe_test_get_shared_secret_max_length_error);
 TEST (ecc_thread_safe_test_get_shared_secret_max_length_null);
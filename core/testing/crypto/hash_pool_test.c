@@ -0,0 +1,1465 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "testing.h"
+#include "crypto/hash_pool.h"
+#include "crypto/hash_pool_static.h"
+#include "testing/mock/crypto/hash_mock.h"
+
+
+TEST_SUITE_LABEL ("hash_pool");
+
+
+/**
+ * Number of hash engines in the pool used for testing.
+ */
+#define	HASH_POOL_TESTING_ENGINES		2
+
+
+/**
+ * Dependencies for testing a pool of hash engines.
+ */
+struct hash_pool_testing {
+	struct hash_engine_mock mock[HASH_POOL_TESTING_ENGINES];	/**< Mocks for the pooled engines. */
+	struct hash_engine *engines[HASH_POOL_TESTING_ENGINES];		/**< List of engines in the pool. */
+	struct hash_pool_state state;								/**< Variable context for the pool. */
+	struct hash_pool test;										/**< Pool under test. */
+	struct hash_engine_pooled pooled[2];						/**< Pooled engines for the tests. */
+};
+
+
+/**
+ * Initialize the hash engine mocks for testing.
+ *
+ * @param test The testing framework.
+ * @param pool Testing dependencies to initialize.
+ */
+static void hash_pool_testing_init_dependencies (CuTest *test, struct hash_pool_testing *pool)
+{
+	int status;
+	int i;
+
+	for (i = 0; i < HASH_POOL_TESTING_ENGINES; i++) {
+		status = hash_mock_init (&pool->mock[i]);
+		CuAssertIntEquals (test, 0, status);
+
+		pool->engines[i] = &pool->mock[i].base;
+	}
+}
+
+/**
+ * Initialize a hash pool and two pooled engines for testing.
+ *
+ * @param test The testing framework.
+ * @param pool Testing components to initialize.
+ */
+static void hash_pool_testing_init (CuTest *test, struct hash_pool_testing *pool)
+{
+	int status;
+
+	hash_pool_testing_init_dependencies (test, pool);
+
+	status = hash_pool_init (&pool->test, &pool->state, pool->engines, HASH_POOL_TESTING_ENGINES);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_pool_engine_init (&pool->pooled[0], &pool->test);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_pool_engine_init (&pool->pooled[1], &pool->test);
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Initialize a hash pool and two pooled engines for testing.  All engines in the pool support saving
+ * hash state.
+ *
+ * @param test The testing framework.
+ * @param pool Testing components to initialize.
+ */
+static void hash_pool_testing_init_save_state (CuTest *test, struct hash_pool_testing *pool)
+{
+	int status;
+	int i;
+
+	hash_pool_testing_init_dependencies (test, pool);
+
+	for (i = 0; i < HASH_POOL_TESTING_ENGINES; i++) {
+		hash_mock_enable_save_state (&pool->mock[i]);
+	}
+
+	status = hash_pool_init (&pool->test, &pool->state, pool->engines, HASH_POOL_TESTING_ENGINES);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_pool_engine_init (&pool->pooled[0], &pool->test);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_pool_engine_init (&pool->pooled[1], &pool->test);
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Release test components and validate all mocks.
+ *
+ * @param test The testing framework.
+ * @param pool Testing components to release.
+ */
+static void hash_pool_testing_release (CuTest *test, struct hash_pool_testing *pool)
+{
+	int status = 0;
+	int i;
+
+	for (i = 0; i < HASH_POOL_TESTING_ENGINES; i++) {
+		status |= hash_mock_validate_and_release (&pool->mock[i]);
+	}
+
+	CuAssertIntEquals (test, 0, status);
+
+	hash_pool_engine_release (&pool->pooled[0]);
+	hash_pool_engine_release (&pool->pooled[1]);
+	hash_pool_release (&pool->test);
+}
+
+
+/*******************
+ * Test cases
+ *******************/
+
+static void hash_pool_test_init (CuTest *test)
+{
+	struct hash_pool_testing pool;
+	int status;
+
+	TEST_START;
+
+	hash_pool_testing_init_dependencies (test, &pool);
+
+	status = hash_pool_init (&pool.test, &pool.state, pool.engines, HASH_POOL_TESTING_ENGINES);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_pool_engine_init (&pool.pooled[0], &pool.test);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrNotNull (test, pool.pooled[0].base.calculate_sha1);
+	CuAssertPtrNotNull (test, pool.pooled[0].base.start_sha1);
+	CuAssertPtrNotNull (test, pool.pooled[0].base.calculate_sha256);
+	CuAssertPtrNotNull (test, pool.pooled[0].base.start_sha256);
+	CuAssertPtrNotNull (test, pool.pooled[0].base.calculate_sha384);
+	CuAssertPtrNotNull (test, pool.pooled[0].base.start_sha384);
+	CuAssertPtrNotNull (test, pool.pooled[0].base.calculate_sha512);
+	CuAssertPtrNotNull (test, pool.pooled[0].base.start_sha512);
+	CuAssertPtrNotNull (test, pool.pooled[0].base.update);
+	CuAssertPtrNotNull (test, pool.pooled[0].base.finish);
+	CuAssertPtrNotNull (test, pool.pooled[0].base.cancel);
+	CuAssertPtrEquals (test, NULL, pool.pooled[0].base.save_state);
+	CuAssertPtrEquals (test, NULL, pool.pooled[0].base.restore_state);
+
+	status = hash_pool_engine_init (&pool.pooled[1], &pool.test);
+	CuAssertIntEquals (test, 0, status);
+
+	hash_pool_testing_release (test, &pool);
+}
+
+static void hash_pool_test_init_save_state (CuTest *test)
+{
+	struct hash_pool_testing pool;
+
+	TEST_START;
+
+	hash_pool_testing_init_save_state (test, &pool);
+
+	CuAssertPtrNotNull (test, pool.pooled[0].base.save_state);
+	CuAssertPtrNotNull (test, pool.pooled[0].base.restore_state);
+
+	CuAssertPtrNotNull (test, pool.pooled[1].base.save_state);
+	CuAssertPtrNotNull (test, pool.pooled[1].base.restore_state);
+
+	hash_pool_testing_release (test, &pool);
+}
+
+static void hash_pool_test_init_save_state_not_all_engines (CuTest *test)
+{
+	struct hash_pool_testing pool;
+	int status;
+
+	TEST_START;
+
+	hash_pool_testing_init_dependencies (test, &pool);
+
+	hash_mock_enable_save_state (&pool.mock[0]);
+
+	status = hash_pool_init (&pool.test, &pool.state, pool.engines, HASH_POOL_TESTING_ENGINES);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_pool_engine_init (&pool.pooled[0], &pool.test);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrEquals (test, NULL, pool.pooled[0].base.save_state);
+	CuAssertPtrEquals (test, NULL, pool.pooled[0].base.restore_state);
+
+	status = hash_pool_engine_init (&pool.pooled[1], &pool.test);
+	CuAssertIntEquals (test, 0, status);
+
+	hash_pool_testing_release (test, &pool);
+}
+
+static void hash_pool_test_init_sha256_multi (CuTest *test)
+{
+	struct hash_pool_testing pool;
+	int status;
+	int i;
+
+	TEST_START;
+
+	hash_pool_testing_init_dependencies (test, &pool);
+
+	for (i = 0; i < HASH_POOL_TESTING_ENGINES; i++) {
+		hash_mock_enable_sha256_multi (&pool.mock[i]);
+	}
+
+	status = hash_pool_init (&pool.test, &pool.state, pool.engines, HASH_POOL_TESTING_ENGINES);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_pool_engine_init (&pool.pooled[0], &pool.test);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrNotNull (test, pool.pooled[0].base.calculate_sha256_multi);
+
+	status = hash_pool_engine_init (&pool.pooled[1], &pool.test);
+	CuAssertIntEquals (test, 0, status);
+
+	hash_pool_testing_release (test, &pool);
+}
+
+static void hash_pool_test_init_sha256_multi_not_all_engines (CuTest *test)
+{
+	struct hash_pool_testing pool;
+	int status;
+
+	TEST_START;
+
+	hash_pool_testing_init_dependencies (test, &pool);
+
+	hash_mock_enable_sha256_multi (&pool.mock[0]);
+
+	status = hash_pool_init (&pool.test, &pool.state, pool.engines, HASH_POOL_TESTING_ENGINES);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_pool_engine_init (&pool.pooled[0], &pool.test);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrEquals (test, NULL, pool.pooled[0].base.calculate_sha256_multi);
+
+	status = hash_pool_engine_init (&pool.pooled[1], &pool.test);
+	CuAssertIntEquals (test, 0, status);
+
+	hash_pool_testing_release (test, &pool);
+}
+
+static void hash_pool_test_init_null (CuTest *test)
+{
+	struct hash_pool_testing pool;
+	int status;
+
+	TEST_START;
+
+	hash_pool_testing_init_dependencies (test, &pool);
+
+	status = hash_pool_init (NULL, &pool.state, pool.engines, HASH_POOL_TESTING_ENGINES);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	status = hash_pool_init (&pool.test, NULL, pool.engines, HASH_POOL_TESTING_ENGINES);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	status = hash_pool_init (&pool.test, &pool.state, NULL, HASH_POOL_TESTING_ENGINES);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	status = hash_pool_init (&pool.test, &pool.state, pool.engines, 0);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	pool.engines[1] = NULL;
+	status = hash_pool_init (&pool.test, &pool.state, pool.engines, HASH_POOL_TESTING_ENGINES);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	status = hash_mock_validate_and_release (&pool.mock[0]);
+	status |= hash_mock_validate_and_release (&pool.mock[1]);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void hash_pool_test_init_too_many_engines (CuTest *test)
+{
+	struct hash_pool_testing pool;
+	struct hash_engine *engines[HASH_POOL_MAX_ENGINES + 1];
+	int status;
+	int i;
+
+	TEST_START;
+
+	hash_pool_testing_init_dependencies (test, &pool);
+
+	for (i = 0; i < HASH_POOL_MAX_ENGINES + 1; i++) {
+		engines[i] = &pool.mock[0].base;
+	}
+
+	status = hash_pool_init (&pool.test, &pool.state, engines, HASH_POOL_MAX_ENGINES + 1);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	status = hash_mock_validate_and_release (&pool.mock[0]);
+	status |= hash_mock_validate_and_release (&pool.mock[1]);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void hash_pool_test_static_init (CuTest *test)
+{
+	struct hash_pool_testing pool;
+	struct hash_pool test_static = hash_pool_static_init (&pool.state, pool.engines,
+		HASH_POOL_TESTING_ENGINES);
+	struct hash_engine_pooled pooled;
+	char *message = "Test";
+	uint8_t hash[SHA256_HASH_LENGTH];
+	int status;
+
+	TEST_START;
+
+	hash_pool_testing_init_dependencies (test, &pool);
+
+	status = hash_pool_init_state (&test_static);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_pool_engine_init (&pooled, &test_static);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&pool.mock[0].mock, pool.mock[0].base.calculate_sha256, &pool.mock[0],
+		0, MOCK_ARG_PTR (message), MOCK_ARG (strlen (message)), MOCK_ARG_PTR (hash),
+		MOCK_ARG (sizeof (hash)));
+	CuAssertIntEquals (test, 0, status);
+
+	status = pooled.base.calculate_sha256 (&pooled.base, (uint8_t*) message, strlen (message), hash,
+		sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&pool.mock[0]);
+	status |= hash_mock_validate_and_release (&pool.mock[1]);
+	CuAssertIntEquals (test, 0, status);
+
+	hash_pool_engine_release (&pooled);
+	hash_pool_release (&test_static);
+}
+
+static void hash_pool_test_static_init_null (CuTest *test)
+{
+	struct hash_pool_testing pool;
+	struct hash_pool test_static = hash_pool_static_init (&pool.state, pool.engines,
+		HASH_POOL_TESTING_ENGINES);
+	struct hash_pool null_state = hash_pool_static_init (NULL, pool.engines,
+		HASH_POOL_TESTING_ENGINES);
+	struct hash_pool null_engines = hash_pool_static_init (&pool.state, NULL,
+		HASH_POOL_TESTING_ENGINES);
+	struct hash_pool no_engines = hash_pool_static_init (&pool.state, pool.engines, 0);
+	int status;
+
+	TEST_START;
+
+	hash_pool_testing_init_dependencies (test, &pool);
+
+	status = hash_pool_init_state (NULL);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	status = hash_pool_init_state (&null_state);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	status = hash_pool_init_state (&null_engines);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	status = hash_pool_init_state (&no_engines);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	pool.engines[0] = NULL;
+	status = hash_pool_init_state (&test_static);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	status = hash_mock_validate_and_release (&pool.mock[0]);
+	status |= hash_mock_validate_and_release (&pool.mock[1]);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void hash_pool_test_release_null (CuTest *test)
+{
+	TEST_START;
+
+	hash_pool_release (NULL);
+	hash_pool_engine_release (NULL);
+}
+
+static void hash_pool_test_engine_init_null (CuTest *test)
+{
+	struct hash_pool_testing pool;
+	int status;
+
+	TEST_START;
+
+	hash_pool_testing_init_dependencies (test, &pool);
+
+	status = hash_pool_init (&pool.test, &pool.state, pool.engines, HASH_POOL_TESTING_ENGINES);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_pool_engine_init (NULL, &pool.test);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	status = hash_pool_engine_init (&pool.pooled[0], NULL);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	status = hash_mock_validate_and_release (&pool.mock[0]);
+	status |= hash_mock_validate_and_release (&pool.mock[1]);
+	CuAssertIntEquals (test, 0, status);
+
+	hash_pool_release (&pool.test);
+}
+
+static void hash_pool_test_calculate_sha1 (CuTest *test)
+{
+	struct hash_pool_testing pool;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA1_HASH_LENGTH];
+
+	TEST_START;
+
+	hash_pool_testing_init (test, &pool);
+
+	status = mock_expect (&pool.mock[0].mock, pool.mock[0].base.calculate_sha1, &pool.mock[0], 0,
+		MOCK_ARG_PTR (message), MOCK_ARG (strlen (message)), MOCK_ARG_PTR (hash),
+		MOCK_ARG (sizeof (hash)));
+	CuAssertIntEquals (test, 0, status);
+
+	status = pool.pooled[0].base.calculate_sha1 (&pool.pooled[0].base, (uint8_t*) message,
+		strlen (message), hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_pool_testing_release (test, &pool);
+}
+
+static void hash_pool_test_calculate_sha256 (CuTest *test)
+{
+	struct hash_pool_testing pool;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	hash_pool_testing_init (test, &pool);
+
+	status = mock_expect (&pool.mock[0].mock, pool.mock[0].base.calculate_sha256, &pool.mock[0],
+		0, MOCK_ARG_PTR (message), MOCK_ARG (strlen (message)), MOCK_ARG_PTR (hash),
+		MOCK_ARG (sizeof (hash)));
+	status |= mock_expect (&pool.mock[0].mock, pool.mock[0].base.calculate_sha256, &pool.mock[0],
+		0, MOCK_ARG_PTR (message), MOCK_ARG (strlen (message)), MOCK_ARG_PTR (hash),
+		MOCK_ARG (sizeof (hash)));
+	CuAssertIntEquals (test, 0, status);
+
+	status = pool.pooled[0].base.calculate_sha256 (&pool.pooled[0].base, (uint8_t*) message,
+		strlen (message), hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	/* The engine is free again once the calculation completes. */
+	status = pool.pooled[1].base.calculate_sha256 (&pool.pooled[1].base, (uint8_t*) message,
+		strlen (message), hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_pool_testing_release (test, &pool);
+}
+
+static void hash_pool_test_calculate_sha256_error (CuTest *test)
+{
+	struct hash_pool_testing pool;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	hash_pool_testing_init (test, &pool);
+
+	status = mock_expect (&pool.mock[0].mock, pool.mock[0].base.calculate_sha256, &pool.mock[0],
+		HASH_ENGINE_SHA256_FAILED, MOCK_ARG_PTR (message), MOCK_ARG (strlen (message)),
+		MOCK_ARG_PTR (hash), MOCK_ARG (sizeof (hash)));
+	status |= mock_expect (&pool.mock[0].mock, pool.mock[0].base.calculate_sha256, &pool.mock[0],
+		0, MOCK_ARG_PTR (message), MOCK_ARG (strlen (message)), MOCK_ARG_PTR (hash),
+		MOCK_ARG (sizeof (hash)));
+	CuAssertIntEquals (test, 0, status);
+
+	status = pool.pooled[0].base.calculate_sha256 (&pool.pooled[0].base, (uint8_t*) message,
+		strlen (message), hash, sizeof (hash));
+	CuAssertIntEquals (test, HASH_ENGINE_SHA256_FAILED, status);
+
+	/* Check the engine has been released. */
+	status = pool.pooled[0].base.calculate_sha256 (&pool.pooled[0].base, (uint8_t*) message,
+		strlen (message), hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_pool_testing_release (test, &pool);
+}
+
+static void hash_pool_test_calculate_sha256_null (CuTest *test)
+{
+	struct hash_pool_testing pool;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	hash_pool_testing_init (test, &pool);
+
+	status = pool.pooled[0].base.calculate_sha256 (NULL, (uint8_t*) message, strlen (message),
+		hash, sizeof (hash));
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	hash_pool_testing_release (test, &pool);
+}
+
+static void hash_pool_test_calculate_sha384 (CuTest *test)
+{
+	struct hash_pool_testing pool;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA384_HASH_LENGTH];
+
+	TEST_START;
+
+	hash_pool_testing_init (test, &pool);
+
+	status = mock_expect (&pool.mock[0].mock, pool.mock[0].base.calculate_sha384, &pool.mock[0],
+		0, MOCK_ARG_PTR (message), MOCK_ARG (strlen (message)), MOCK_ARG_PTR (hash),
+		MOCK_ARG (sizeof (hash)));
+	CuAssertIntEquals (test, 0, status);
+
+	status = pool.pooled[0].base.calculate_sha384 (&pool.pooled[0].base, (uint8_t*) message,
+		strlen (message), hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_pool_testing_release (test, &pool);
+}
+
+static void hash_pool_test_calculate_sha512 (CuTest *test)
+{
+	struct hash_pool_testing pool;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA512_HASH_LENGTH];
+
+	TEST_START;
+
+	hash_pool_testing_init (test, &pool);
+
+	status = mock_expect (&pool.mock[0].mock, pool.mock[0].base.calculate_sha512, &pool.mock[0],
+		0, MOCK_ARG_PTR (message), MOCK_ARG (strlen (message)), MOCK_ARG_PTR (hash),
+		MOCK_ARG (sizeof (hash)));
+	CuAssertIntEquals (test, 0, status);
+
+	status = pool.pooled[0].base.calculate_sha512 (&pool.pooled[0].base, (uint8_t*) message,
+		strlen (message), hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_pool_testing_release (test, &pool);
+}
+
+static void hash_pool_test_start_sha1 (CuTest *test)
+{
+	struct hash_pool_testing pool;
+	int status;
+
+	TEST_START;
+
+	hash_pool_testing_init (test, &pool);
+
+	status = mock_expect (&pool.mock[0].mock, pool.mock[0].base.start_sha1, &pool.mock[0], 0);
+	status |= mock_expect (&pool.mock[0].mock, pool.mock[0].base.cancel, &pool.mock[0], 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pool.pooled[0].base.start_sha1 (&pool.pooled[0].base);
+	CuAssertIntEquals (test, 0, status);
+
+	pool.pooled[0].base.cancel (&pool.pooled[0].base);
+
+	hash_pool_testing_release (test, &pool);
+}
+
+static void hash_pool_test_start_sha256 (CuTest *test)
+{
+	struct hash_pool_testing pool;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	hash_pool_testing_init (test, &pool);
+
+	status = mock_expect (&pool.mock[0].mock, pool.mock[0].base.start_sha256, &pool.mock[0], 0);
+	status |= mock_expect (&pool.mock[0].mock, pool.mock[0].base.update, &pool.mock[0], 0,
+		MOCK_ARG_PTR (message), MOCK_ARG (strlen (message)));
+	status |= mock_expect (&pool.mock[0].mock, pool.mock[0].base.finish, &pool.mock[0], 0,
+		MOCK_ARG_PTR (hash), MOCK_ARG (sizeof (hash)));
+	CuAssertIntEquals (test, 0, status);
+
+	status = pool.pooled[0].base.start_sha256 (&pool.pooled[0].base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pool.pooled[0].base.update (&pool.pooled[0].base, (uint8_t*) message,
+		strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = pool.pooled[0].base.finish (&pool.pooled[0].base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrEquals (test, NULL, pool.pooled[0].active);
+
+	hash_pool_testing_release (test, &pool);
+}
+
+static void hash_pool_test_start_sha256_error (CuTest *test)
+{
+	struct hash_pool_testing pool;
+	int status;
+
+	TEST_START;
+
+	hash_pool_testing_init (test, &pool);
+
+	status = mock_expect (&pool.mock[0].mock, pool.mock[0].base.start_sha256, &pool.mock[0],
+		HASH_ENGINE_START_SHA256_FAILED);
+	status |= mock_expect (&pool.mock[0].mock, pool.mock[0].base.start_sha256, &pool.mock[0], 0);
+	status |= mock_expect (&pool.mock[0].mock, pool.mock[0].base.cancel, &pool.mock[0], 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pool.pooled[0].base.start_sha256 (&pool.pooled[0].base);
+	CuAssertIntEquals (test, HASH_ENGINE_START_SHA256_FAILED, status);
+
+	CuAssertPtrEquals (test, NULL, pool.pooled[0].active);
+
+	/* Check the engine has been released. */
+	status = pool.pooled[1].base.start_sha256 (&pool.pooled[1].base);
+	CuAssertIntEquals (test, 0, status);
+
+	pool.pooled[1].base.cancel (&pool.pooled[1].base);
+
+	hash_pool_testing_release (test, &pool);
+}
+
+static void hash_pool_test_start_sha256_null (CuTest *test)
+{
+	struct hash_pool_testing pool;
+	int status;
+
+	TEST_START;
+
+	hash_pool_testing_init (test, &pool);
+
+	status = pool.pooled[0].base.start_sha256 (NULL);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	hash_pool_testing_release (test, &pool);
+}
+
+static void hash_pool_test_start_sha256_in_progress (CuTest *test)
+{
+	struct hash_pool_testing pool;
+	int status;
+
+	TEST_START;
+
+	hash_pool_testing_init (test, &pool);
+
+	status = mock_expect (&pool.mock[0].mock, pool.mock[0].base.start_sha256, &pool.mock[0], 0);
+	status |= mock_expect (&pool.mock[0].mock, pool.mock[0].base.cancel, &pool.mock[0], 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pool.pooled[0].base.start_sha256 (&pool.pooled[0].base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pool.pooled[0].base.start_sha256 (&pool.pooled[0].base);
+	CuAssertIntEquals (test, HASH_ENGINE_HASH_IN_PROGRESS, status);
+
+	pool.pooled[0].base.cancel (&pool.pooled[0].base);
+
+	hash_pool_testing_release (test, &pool);
+}
+
+static void hash_pool_test_start_sha384 (CuTest *test)
+{
+	struct hash_pool_testing pool;
+	int status;
+
+	TEST_START;
+
+	hash_pool_testing_init (test, &pool);
+
+	status = mock_expect (&pool.mock[0].mock, pool.mock[0].base.start_sha384, &pool.mock[0], 0);
+	status |= mock_expect (&pool.mock[0].mock, pool.mock[0].base.cancel, &pool.mock[0], 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pool.pooled[0].base.start_sha384 (&pool.pooled[0].base);
+	CuAssertIntEquals (test, 0, status);
+
+	pool.pooled[0].base.cancel (&pool.pooled[0].base);
+
+	hash_pool_testing_release (test, &pool);
+}
+
+static void hash_pool_test_start_sha512 (CuTest *test)
+{
+	struct hash_pool_testing pool;
+	int status;
+
+	TEST_START;
+
+	hash_pool_testing_init (test, &pool);
+
+	status = mock_expect (&pool.mock[0].mock, pool.mock[0].base.start_sha512, &pool.mock[0], 0);
+	status |= mock_expect (&pool.mock[0].mock, pool.mock[0].base.cancel, &pool.mock[0], 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pool.pooled[0].base.start_sha512 (&pool.pooled[0].base);
+	CuAssertIntEquals (test, 0, status);
+
+	pool.pooled[0].base.cancel (&pool.pooled[0].base);
+
+	hash_pool_testing_release (test, &pool);
+}
+
+static void hash_pool_test_concurrent_hashes (CuTest *test)
+{
+	struct hash_pool_testing pool;
+	int status;
+	char *message = "Test";
+	char *message2 = "Test2";
+	uint8_t hash[SHA256_HASH_LENGTH];
+	uint8_t hash2[SHA384_HASH_LENGTH];
+
+	TEST_START;
+
+	hash_pool_testing_init (test, &pool);
+
+	status = mock_expect (&pool.mock[0].mock, pool.mock[0].base.start_sha256, &pool.mock[0], 0);
+	status |= mock_expect (&pool.mock[0].mock, pool.mock[0].base.update, &pool.mock[0], 0,
+		MOCK_ARG_PTR (message), MOCK_ARG (strlen (message)));
+	status |= mock_expect (&pool.mock[0].mock, pool.mock[0].base.finish, &pool.mock[0], 0,
+		MOCK_ARG_PTR (hash), MOCK_ARG (sizeof (hash)));
+
+	status |= mock_expect (&pool.mock[1].mock, pool.mock[1].base.start_sha384, &pool.mock[1], 0);
+	status |= mock_expect (&pool.mock[1].mock, pool.mock[1].base.update, &pool.mock[1], 0,
+		MOCK_ARG_PTR (message2), MOCK_ARG (strlen (message2)));
+	status |= mock_expect (&pool.mock[1].mock, pool.mock[1].base.finish, &pool.mock[1], 0,
+		MOCK_ARG_PTR (hash2), MOCK_ARG (sizeof (hash2)));
+	CuAssertIntEquals (test, 0, status);
+
+	status = pool.pooled[0].base.start_sha256 (&pool.pooled[0].base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pool.pooled[1].base.start_sha384 (&pool.pooled[1].base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pool.pooled[1].base.update (&pool.pooled[1].base, (uint8_t*) message2,
+		strlen (message2));
+	CuAssertIntEquals (test, 0, status);
+
+	status = pool.pooled[0].base.update (&pool.pooled[0].base, (uint8_t*) message,
+		strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = pool.pooled[0].base.finish (&pool.pooled[0].base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = pool.pooled[1].base.finish (&pool.pooled[1].base, hash2, sizeof (hash2));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_pool_testing_release (test, &pool);
+}
+
+static void hash_pool_test_calculate_while_hash_active (CuTest *test)
+{
+	struct hash_pool_testing pool;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	hash_pool_testing_init (test, &pool);
+
+	status = mock_expect (&pool.mock[0].mock, pool.mock[0].base.start_sha256, &pool.mock[0], 0);
+	status |= mock_expect (&pool.mock[0].mock, pool.mock[0].base.cancel, &pool.mock[0], 0);
+
+	status |= mock_expect (&pool.mock[1].mock, pool.mock[1].base.calculate_sha256, &pool.mock[1],
+		0, MOCK_ARG_PTR (message), MOCK_ARG (strlen (message)), MOCK_ARG_PTR (hash),
+		MOCK_ARG (sizeof (hash)));
+	CuAssertIntEquals (test, 0, status);
+
+	status = pool.pooled[0].base.start_sha256 (&pool.pooled[0].base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pool.pooled[1].base.calculate_sha256 (&pool.pooled[1].base, (uint8_t*) message,
+		strlen (message), hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	pool.pooled[0].base.cancel (&pool.pooled[0].base);
+
+	hash_pool_testing_release (test, &pool);
+}
+
+static void hash_pool_test_calculate_while_hash_active_same_instance (CuTest *test)
+{
+	struct hash_pool_testing pool;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	hash_pool_testing_init (test, &pool);
+
+	status = mock_expect (&pool.mock[0].mock, pool.mock[0].base.start_sha256, &pool.mock[0], 0);
+	status |= mock_expect (&pool.mock[0].mock, pool.mock[0].base.cancel, &pool.mock[0], 0);
+	status |= mock_expect (&pool.mock[0].mock, pool.mock[0].base.start_sha256, &pool.mock[0], 0);
+	status |= mock_expect (&pool.mock[0].mock, pool.mock[0].base.cancel, &pool.mock[0], 0);
+
+	status |= mock_expect (&pool.mock[1].mock, pool.mock[1].base.calculate_sha256, &pool.mock[1],
+		0, MOCK_ARG_PTR (message), MOCK_ARG (strlen (message)), MOCK_ARG_PTR (hash),
+		MOCK_ARG (sizeof (hash)));
+	CuAssertIntEquals (test, 0, status);
+
+	status = pool.pooled[0].base.start_sha256 (&pool.pooled[0].base);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Another task uses the same instance for a single hash calculation. */
+	status = pool.pooled[0].base.calculate_sha256 (&pool.pooled[0].base, (uint8_t*) message,
+		strlen (message), hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = pool.pooled[0].base.start_sha256 (&pool.pooled[0].base);
+	CuAssertIntEquals (test, HASH_ENGINE_HASH_IN_PROGRESS, status);
+
+	pool.pooled[0].base.cancel (&pool.pooled[0].base);
+
+	/* The engine used for the active hash was returned to the pool. */
+	status = pool.pooled[1].base.start_sha256 (&pool.pooled[1].base);
+	CuAssertIntEquals (test, 0, status);
+
+	pool.pooled[1].base.cancel (&pool.pooled[1].base);
+
+	hash_pool_testing_release (test, &pool);
+}
+
+static void hash_pool_test_engine_affinity (CuTest *test)
+{
+	struct hash_pool_testing pool;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	hash_pool_testing_init (test, &pool);
+
+	status = mock_expect (&pool.mock[0].mock, pool.mock[0].base.start_sha256, &pool.mock[0], 0);
+	status |= mock_expect (&pool.mock[0].mock, pool.mock[0].base.cancel, &pool.mock[0], 0);
+
+	status |= mock_expect (&pool.mock[1].mock, pool.mock[1].base.start_sha256, &pool.mock[1], 0);
+	status |= mock_expect (&pool.mock[1].mock, pool.mock[1].base.cancel, &pool.mock[1], 0);
+	status |= mock_expect (&pool.mock[1].mock, pool.mock[1].base.calculate_sha256, &pool.mock[1],
+		0, MOCK_ARG_PTR (message), MOCK_ARG (strlen (message)), MOCK_ARG_PTR (hash),
+		MOCK_ARG (sizeof (hash)));
+	CuAssertIntEquals (test, 0, status);
+
+	status = pool.pooled[0].base.start_sha256 (&pool.pooled[0].base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pool.pooled[1].base.start_sha256 (&pool.pooled[1].base);
+	CuAssertIntEquals (test, 0, status);
+
+	pool.pooled[0].base.cancel (&pool.pooled[0].base);
+	pool.pooled[1].base.cancel (&pool.pooled[1].base);
+
+	/* Both engines are free, but the second instance will go back to the engine it last used. */
+	status = pool.pooled[1].base.calculate_sha256 (&pool.pooled[1].base, (uint8_t*) message,
+		strlen (message), hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_pool_testing_release (test, &pool);
+}
+
+static void hash_pool_test_update_no_active_hash (CuTest *test)
+{
+	struct hash_pool_testing pool;
+	int status;
+	char *message = "Test";
+
+	TEST_START;
+
+	hash_pool_testing_init (test, &pool);
+
+	status = pool.pooled[0].base.update (&pool.pooled[0].base, (uint8_t*) message,
+		strlen (message));
+	CuAssertIntEquals (test, HASH_ENGINE_NO_ACTIVE_HASH, status);
+
+	hash_pool_testing_release (test, &pool);
+}
+
+static void hash_pool_test_update_error (CuTest *test)
+{
+	struct hash_pool_testing pool;
+	int status;
+	char *message = "Test";
+
+	TEST_START;
+
+	hash_pool_testing_init (test, &pool);
+
+	status = mock_expect (&pool.mock[0].mock, pool.mock[0].base.start_sha256, &pool.mock[0], 0);
+	status |= mock_expect (&pool.mock[0].mock, pool.mock[0].base.update, &pool.mock[0],
+		HASH_ENGINE_UPDATE_FAILED, MOCK_ARG_PTR (message), MOCK_ARG (strlen (message)));
+	status |= mock_expect (&pool.mock[0].mock, pool.mock[0].base.cancel, &pool.mock[0], 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pool.pooled[0].base.start_sha256 (&pool.pooled[0].base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pool.pooled[0].base.update (&pool.pooled[0].base, (uint8_t*) message,
+		strlen (message));
+	CuAssertIntEquals (test, HASH_ENGINE_UPDATE_FAILED, status);
+
+	pool.pooled[0].base.cancel (&pool.pooled[0].base);
+
+	hash_pool_testing_release (test, &pool);
+}
+
+static void hash_pool_test_update_null (CuTest *test)
+{
+	struct hash_pool_testing pool;
+	int status;
+	char *message = "Test";
+
+	TEST_START;
+
+	hash_pool_testing_init (test, &pool);
+
+	status = pool.pooled[0].base.update (NULL, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	hash_pool_testing_release (test, &pool);
+}
+
+static void hash_pool_test_finish_no_active_hash (CuTest *test)
+{
+	struct hash_pool_testing pool;
+	int status;
+	uint8_t hash[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	hash_pool_testing_init (test, &pool);
+
+	status = pool.pooled[0].base.finish (&pool.pooled[0].base, hash, sizeof (hash));
+	CuAssertIntEquals (test, HASH_ENGINE_NO_ACTIVE_HASH, status);
+
+	hash_pool_testing_release (test, &pool);
+}
+
+static void hash_pool_test_finish_error (CuTest *test)
+{
+	struct hash_pool_testing pool;
+	int status;
+	uint8_t hash[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	hash_pool_testing_init (test, &pool);
+
+	status = mock_expect (&pool.mock[0].mock, pool.mock[0].base.start_sha256, &pool.mock[0], 0);
+	status |= mock_expect (&pool.mock[0].mock, pool.mock[0].base.finish, &pool.mock[0],
+		HASH_ENGINE_FINISH_FAILED, MOCK_ARG_PTR (hash), MOCK_ARG (sizeof (hash)));
+	status |= mock_expect (&pool.mock[0].mock, pool.mock[0].base.finish, &pool.mock[0], 0,
+		MOCK_ARG_PTR (hash), MOCK_ARG (sizeof (hash)));
+	CuAssertIntEquals (test, 0, status);
+
+	status = pool.pooled[0].base.start_sha256 (&pool.pooled[0].base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pool.pooled[0].base.finish (&pool.pooled[0].base, hash, sizeof (hash));
+	CuAssertIntEquals (test, HASH_ENGINE_FINISH_FAILED, status);
+
+	/* The engine stays assigned to the hash after a failure. */
+	CuAssertPtrEquals (test, &pool.mock[0].base, pool.pooled[0].active);
+
+	status = pool.pooled[0].base.finish (&pool.pooled[0].base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrEquals (test, NULL, pool.pooled[0].active);
+
+	hash_pool_testing_release (test, &pool);
+}
+
+static void hash_pool_test_finish_null (CuTest *test)
+{
+	struct hash_pool_testing pool;
+	int status;
+	uint8_t hash[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	hash_pool_testing_init (test, &pool);
+
+	status = pool.pooled[0].base.finish (NULL, hash, sizeof (hash));
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	hash_pool_testing_release (test, &pool);
+}
+
+static void hash_pool_test_cancel_no_active_hash (CuTest *test)
+{
+	struct hash_pool_testing pool;
+
+	TEST_START;
+
+	hash_pool_testing_init (test, &pool);
+
+	pool.pooled[0].base.cancel (&pool.pooled[0].base);
+
+	hash_pool_testing_release (test, &pool);
+}
+
+static void hash_pool_test_cancel_null (CuTest *test)
+{
+	struct hash_pool_testing pool;
+
+	TEST_START;
+
+	hash_pool_testing_init (test, &pool);
+
+	pool.pooled[0].base.cancel (NULL);
+
+	hash_pool_testing_release (test, &pool);
+}
+
+static void hash_pool_test_save_state (CuTest *test)
+{
+	struct hash_pool_testing pool;
+	struct hash_saved_state state;
+	int status;
+
+	TEST_START;
+
+	hash_pool_testing_init_save_state (test, &pool);
+
+	status = mock_expect (&pool.mock[0].mock, pool.mock[0].base.start_sha256, &pool.mock[0], 0);
+	status |= mock_expect (&pool.mock[0].mock, pool.mock[0].base.save_state, &pool.mock[0], 0,
+		MOCK_ARG_PTR (&state));
+	status |= mock_expect (&pool.mock[0].mock, pool.mock[0].base.cancel, &pool.mock[0], 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pool.pooled[0].base.start_sha256 (&pool.pooled[0].base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pool.pooled[0].base.save_state (&pool.pooled[0].base, &state);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Saving the state does not end the hash. */
+	CuAssertPtrEquals (test, &pool.mock[0].base, pool.pooled[0].active);
+
+	pool.pooled[0].base.cancel (&pool.pooled[0].base);
+
+	hash_pool_testing_release (test, &pool);
+}
+
+static void hash_pool_test_save_state_no_active_hash (CuTest *test)
+{
+	struct hash_pool_testing pool;
+	struct hash_saved_state state;
+	int status;
+
+	TEST_START;
+
+	hash_pool_testing_init_save_state (test, &pool);
+
+	status = pool.pooled[0].base.save_state (&pool.pooled[0].base, &state);
+	CuAssertIntEquals (test, HASH_ENGINE_NO_ACTIVE_HASH, status);
+
+	hash_pool_testing_release (test, &pool);
+}
+
+static void hash_pool_test_save_state_error (CuTest *test)
+{
+	struct hash_pool_testing pool;
+	struct hash_saved_state state;
+	int status;
+
+	TEST_START;
+
+	hash_pool_testing_init_save_state (test, &pool);
+
+	status = mock_expect (&pool.mock[0].mock, pool.mock[0].base.start_sha256, &pool.mock[0], 0);
+	status |= mock_expect (&pool.mock[0].mock, pool.mock[0].base.save_state, &pool.mock[0],
+		HASH_ENGINE_NO_MEMORY, MOCK_ARG_PTR (&state));
+	status |= mock_expect (&pool.mock[0].mock, pool.mock[0].base.cancel, &pool.mock[0], 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pool.pooled[0].base.start_sha256 (&pool.pooled[0].base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pool.pooled[0].base.save_state (&pool.pooled[0].base, &state);
+	CuAssertIntEquals (test, HASH_ENGINE_NO_MEMORY, status);
+
+	pool.pooled[0].base.cancel (&pool.pooled[0].base);
+
+	hash_pool_testing_release (test, &pool);
+}
+
+static void hash_pool_test_save_state_null (CuTest *test)
+{
+	struct hash_pool_testing pool;
+	struct hash_saved_state state;
+	int status;
+
+	TEST_START;
+
+	hash_pool_testing_init_save_state (test, &pool);
+
+	status = pool.pooled[0].base.save_state (NULL, &state);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	hash_pool_testing_release (test, &pool);
+}
+
+static void hash_pool_test_restore_state (CuTest *test)
+{
+	struct hash_pool_testing pool;
+	struct hash_saved_state state;
+	int status;
+	uint8_t hash[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	hash_pool_testing_init_save_state (test, &pool);
+
+	status = mock_expect (&pool.mock[0].mock, pool.mock[0].base.start_sha256, &pool.mock[0], 0);
+
+	status |= mock_expect (&pool.mock[1].mock, pool.mock[1].base.restore_state, &pool.mock[1], 0,
+		MOCK_ARG_PTR (&state));
+	status |= mock_expect (&pool.mock[1].mock, pool.mock[1].base.finish, &pool.mock[1], 0,
+		MOCK_ARG_PTR (hash), MOCK_ARG (sizeof (hash)));
+
+	status |= mock_expect (&pool.mock[0].mock, pool.mock[0].base.cancel, &pool.mock[0], 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pool.pooled[0].base.start_sha256 (&pool.pooled[0].base);
+	CuAssertIntEquals (test, 0, status);
+
+	/* The first engine is busy, so the state is restored to the second engine. */
+	status = pool.pooled[1].base.restore_state (&pool.pooled[1].base, &state);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrEquals (test, &pool.mock[1].base, pool.pooled[1].active);
+
+	status = pool.pooled[1].base.finish (&pool.pooled[1].base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrEquals (test, NULL, pool.pooled[1].active);
+
+	pool.pooled[0].base.cancel (&pool.pooled[0].base);
+
+	hash_pool_testing_release (test, &pool);
+}
+
+static void hash_pool_test_restore_state_error (CuTest *test)
+{
+	struct hash_pool_testing pool;
+	struct hash_saved_state state;
+	int status;
+
+	TEST_START;
+
+	hash_pool_testing_init_save_state (test, &pool);
+
+	status = mock_expect (&pool.mock[0].mock, pool.mock[0].base.restore_state, &pool.mock[0],
+		HASH_ENGINE_UNSUPPORTED_HASH, MOCK_ARG_PTR (&state));
+
+	status |= mock_expect (&pool.mock[0].mock, pool.mock[0].base.start_sha256, &pool.mock[0], 0);
+	status |= mock_expect (&pool.mock[0].mock, pool.mock[0].base.cancel, &pool.mock[0], 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pool.pooled[0].base.restore_state (&pool.pooled[0].base, &state);
+	CuAssertIntEquals (test, HASH_ENGINE_UNSUPPORTED_HASH, status);
+
+	CuAssertPtrEquals (test, NULL, pool.pooled[0].active);
+
+	/* The engine was returned to the pool. */
+	status = pool.pooled[0].base.start_sha256 (&pool.pooled[0].base);
+	CuAssertIntEquals (test, 0, status);
+
+	pool.pooled[0].base.cancel (&pool.pooled[0].base);
+
+	hash_pool_testing_release (test, &pool);
+}
+
+static void hash_pool_test_restore_state_in_progress (CuTest *test)
+{
+	struct hash_pool_testing pool;
+	struct hash_saved_state state;
+	int status;
+
+	TEST_START;
+
+	hash_pool_testing_init_save_state (test, &pool);
+
+	status = mock_expect (&pool.mock[0].mock, pool.mock[0].base.start_sha256, &pool.mock[0], 0);
+	status |= mock_expect (&pool.mock[0].mock, pool.mock[0].base.cancel, &pool.mock[0], 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pool.pooled[0].base.start_sha256 (&pool.pooled[0].base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pool.pooled[0].base.restore_state (&pool.pooled[0].base, &state);
+	CuAssertIntEquals (test, HASH_ENGINE_HASH_IN_PROGRESS, status);
+
+	pool.pooled[0].base.cancel (&pool.pooled[0].base);
+
+	hash_pool_testing_release (test, &pool);
+}
+
+static void hash_pool_test_restore_state_null (CuTest *test)
+{
+	struct hash_pool_testing pool;
+	struct hash_saved_state state;
+	int status;
+
+	TEST_START;
+
+	hash_pool_testing_init_save_state (test, &pool);
+
+	status = pool.pooled[0].base.restore_state (NULL, &state);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	status = pool.pooled[0].base.restore_state (&pool.pooled[0].base, NULL);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	hash_pool_testing_release (test, &pool);
+}
+
+static void hash_pool_test_calculate_sha256_multi (CuTest *test)
+{
+	struct hash_pool_testing pool;
+	struct hash_multi_buffer buffers[2];
+	int status;
+	int i;
+
+	TEST_START;
+
+	hash_pool_testing_init_dependencies (test, &pool);
+
+	for (i = 0; i < HASH_POOL_TESTING_ENGINES; i++) {
+		hash_mock_enable_sha256_multi (&pool.mock[i]);
+	}
+
+	status = hash_pool_init (&pool.test, &pool.state, pool.engines, HASH_POOL_TESTING_ENGINES);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_pool_engine_init (&pool.pooled[0], &pool.test);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_pool_engine_init (&pool.pooled[1], &pool.test);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&pool.mock[0].mock, pool.mock[0].base.calculate_sha256_multi,
+		&pool.mock[0], 0, MOCK_ARG_PTR (buffers), MOCK_ARG (2));
+	status |= mock_expect (&pool.mock[0].mock, pool.mock[0].base.calculate_sha256_multi,
+		&pool.mock[0], HASH_ENGINE_SHA256_FAILED, MOCK_ARG_PTR (buffers), MOCK_ARG (2));
+	CuAssertIntEquals (test, 0, status);
+
+	status = pool.pooled[0].base.calculate_sha256_multi (&pool.pooled[0].base, buffers, 2);
+	CuAssertIntEquals (test, 0, status);
+
+	/* The engine is free again once the calculation completes, even on failure. */
+	status = pool.pooled[1].base.calculate_sha256_multi (&pool.pooled[1].base, buffers, 2);
+	CuAssertIntEquals (test, HASH_ENGINE_SHA256_FAILED, status);
+
+	CuAssertIntEquals (test, 0, pool.state.busy);
+
+	status = pool.pooled[0].base.calculate_sha256_multi (NULL, buffers, 2);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	hash_pool_testing_release (test, &pool);
+}
+
+static void hash_pool_test_engine_release_active_hash (CuTest *test)
+{
+	struct hash_pool_testing pool;
+	int status;
+
+	TEST_START;
+
+	hash_pool_testing_init (test, &pool);
+
+	status = mock_expect (&pool.mock[0].mock, pool.mock[0].base.start_sha256, &pool.mock[0], 0);
+	status |= mock_expect (&pool.mock[0].mock, pool.mock[0].base.cancel, &pool.mock[0], 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pool.pooled[0].base.start_sha256 (&pool.pooled[0].base);
+	CuAssertIntEquals (test, 0, status);
+
+	hash_pool_engine_release (&pool.pooled[0]);
+
+	CuAssertPtrEquals (test, NULL, pool.pooled[0].active);
+	CuAssertIntEquals (test, 0, pool.state.busy);
+
+	hash_pool_testing_release (test, &pool);
+}
+
+static void hash_pool_test_get_stats (CuTest *test)
+{
+	struct hash_pool_testing pool;
+	struct hash_pool_stats stats;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	hash_pool_testing_init (test, &pool);
+
+	status = hash_pool_get_stats (&pool.test, &stats);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 0, stats.acquired);
+	CuAssertIntEquals (test, 0, stats.contended);
+	CuAssertIntEquals (test, 0, stats.total_wait_ms);
+	CuAssertIntEquals (test, 0, stats.max_wait_ms);
+	CuAssertIntEquals (test, 0, stats.max_in_use);
+
+	status = mock_expect (&pool.mock[0].mock, pool.mock[0].base.start_sha256, &pool.mock[0], 0);
+	status |= mock_expect (&pool.mock[0].mock, pool.mock[0].base.cancel, &pool.mock[0], 0);
+
+	status |= mock_expect (&pool.mock[1].mock, pool.mock[1].base.calculate_sha256, &pool.mock[1],
+		0, MOCK_ARG_PTR (message), MOCK_ARG (strlen (message)), MOCK_ARG_PTR (hash),
+		MOCK_ARG (sizeof (hash)));
+	status |= mock_expect (&pool.mock[1].mock, pool.mock[1].base.calculate_sha256, &pool.mock[1],
+		0, MOCK_ARG_PTR (message), MOCK_ARG (strlen (message)), MOCK_ARG_PTR (hash),
+		MOCK_ARG (sizeof (hash)));
+	CuAssertIntEquals (test, 0, status);
+
+	status = pool.pooled[0].base.start_sha256 (&pool.pooled[0].base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pool.pooled[1].base.calculate_sha256 (&pool.pooled[1].base, (uint8_t*) message,
+		strlen (message), hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = pool.pooled[1].base.calculate_sha256 (&pool.pooled[1].base, (uint8_t*) message,
+		strlen (message), hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	pool.pooled[0].base.cancel (&pool.pooled[0].base);
+
+	status = hash_pool_get_stats (&pool.test, &stats);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 3, stats.acquired);
+	CuAssertIntEquals (test, 0, stats.contended);
+	CuAssertIntEquals (test, 0, stats.total_wait_ms);
+	CuAssertIntEquals (test, 0, stats.max_wait_ms);
+	CuAssertIntEquals (test, 2, stats.max_in_use);
+
+	status = hash_pool_reset_stats (&pool.test);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_pool_get_stats (&pool.test, &stats);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 0, stats.acquired);
+	CuAssertIntEquals (test, 0, stats.contended);
+	CuAssertIntEquals (test, 0, stats.total_wait_ms);
+	CuAssertIntEquals (test, 0, stats.max_wait_ms);
+	CuAssertIntEquals (test, 0, stats.max_in_use);
+
+	hash_pool_testing_release (test, &pool);
+}
+
+static void hash_pool_test_get_stats_null (CuTest *test)
+{
+	struct hash_pool_testing pool;
+	struct hash_pool_stats stats;
+	int status;
+
+	TEST_START;
+
+	hash_pool_testing_init (test, &pool);
+
+	status = hash_pool_get_stats (NULL, &stats);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	status = hash_pool_get_stats (&pool.test, NULL);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	status = hash_pool_reset_stats (NULL);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	hash_pool_testing_release (test, &pool);
+}
+
+
+TEST_SUITE_START (hash_pool);
+
+TEST (hash_pool_test_init);
+TEST (hash_pool_test_init_save_state);
+TEST (hash_pool_test_init_save_state_not_all_engines);
+TEST (hash_pool_test_init_sha256_multi);
+TEST (hash_pool_test_init_sha256_multi_not_all_engines);
+TEST (hash_pool_test_init_null);
+TEST (hash_pool_test_init_too_many_engines);
+TEST (hash_pool_test_static_init);
+TEST (hash_pool_test_static_init_null);
+TEST (hash_pool_test_release_null);
+TEST (hash_pool_test_engine_init_null);
+TEST (hash_pool_test_calculate_sha1);
+TEST (hash_pool_test_calculate_sha256);
+TEST (hash_pool_test_calculate_sha256_error);
+TEST (hash_pool_test_calculate_sha256_null);
+TEST (hash_pool_test_calculate_sha384);
+TEST (hash_pool_test_calculate_sha512);
+TEST (hash_pool_test_start_sha1);
+TEST (hash_pool_test_start_sha256);
+TEST (hash_pool_test_start_sha256_error);
+TEST (hash_pool_test_start_sha256_null);
+TEST (hash_pool_test_start_sha256_in_progress);
+TEST (hash_pool_test_start_sha384);
+TEST (hash_pool_test_start_sha512);
+TEST (hash_pool_test_concurrent_hashes);
+TEST (hash_pool_test_calculate_while_hash_active);
+TEST (hash_pool_test_calculate_while_hash_active_same_instance);
+TEST (hash_pool_test_engine_affinity);
+TEST (hash_pool_test_update_no_active_hash);
+TEST (hash_pool_test_update_error);
+TEST (hash_pool_test_update_null);
+TEST (hash_pool_test_finish_no_active_hash);
+TEST (hash_pool_test_finish_error);
+TEST (hash_pool_test_finish_null);
+TEST (hash_pool_test_cancel_no_active_hash);
+TEST (hash_pool_test_cancel_null);
+TEST (hash_pool_test_save_state);
+TEST (hash_pool_test_save_state_no_active_hash);
+TEST (hash_pool_test_save_state_error);
+TEST (hash_pool_test_save_state_null);
+TEST (hash_pool_test_restore_state);
+TEST (hash_pool_test_restore_state_error);
+TEST (hash_pool_test_restore_state_in_progress);
+TEST (hash_pool_test_restore_state_null);
+TEST (hash_pool_test_calculate_sha256_multi);
+TEST (hash_pool_test_engine_release_active_hash);
+TEST (hash_pool_test_get_stats);
+TEST (hash_pool_test_get_stats_null);
+
+TEST_SUITE_END;
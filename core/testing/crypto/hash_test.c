@@ -2617,6 +2617,820 @@ static void hash_test_hash_generate_hmac_sha512_small_buffer (CuTest *test)
 }
 #endif
 
+#ifdef HASH_ENABLE_SHA1
+static void hash_test_hmac_keyed_sha1 (CuTest *test)
+{
+	HASH_TESTING_ENGINE engine;
+	int status;
+	char *message = "Test";
+	uint8_t key[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t hmac[SHA1_HASH_LENGTH];
+	uint8_t expected[] = {
+		0xfc,0x3d,0x91,0xe6,0xc1,0x13,0xd6,0x82,0x18,0x33,0xf6,0x5b,0x12,0xc7,0xe7,0x6e,
+		0x7f,0x38,0x9c,0x4f
+	};
+	struct hmac_keyed_context keyed;
+	int i;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_hmac_keyed_init (&keyed, &engine.base, HMAC_SHA1, key, sizeof (key));
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 2; i++) {
+		memset (hmac, 0, sizeof (hmac));
+
+		status = hash_hmac_keyed_generate (&keyed, (uint8_t*) message, strlen (message), hmac,
+			sizeof (hmac));
+		CuAssertIntEquals (test, 0, status);
+
+		status = testing_validate_array (expected, hmac, sizeof (hmac));
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	hash_hmac_keyed_release (&keyed);
+	HASH_TESTING_ENGINE_RELEASE (&engine);
+}
+#endif
+
+static void hash_test_hmac_keyed_sha256 (CuTest *test)
+{
+	HASH_TESTING_ENGINE engine;
+	int status;
+	char *message = "Test";
+	uint8_t key[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t hmac[SHA256_HASH_LENGTH];
+	uint8_t expected[] = {
+		0x88,0x69,0xde,0x57,0x9d,0xd0,0xe9,0x05,0xe0,0xa7,0x11,0x24,0x57,0x55,0x94,0xf5,
+		0x0a,0x03,0xd3,0xd9,0xcd,0xf1,0x6e,0x9a,0x3f,0x9d,0x6c,0x60,0xc0,0x32,0x4b,0x54
+	};
+	struct hmac_keyed_context keyed;
+	int i;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_hmac_keyed_init (&keyed, &engine.base, HMAC_SHA256, key, sizeof (key));
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 2; i++) {
+		memset (hmac, 0, sizeof (hmac));
+
+		status = hash_hmac_keyed_generate (&keyed, (uint8_t*) message, strlen (message), hmac,
+			sizeof (hmac));
+		CuAssertIntEquals (test, 0, status);
+
+		status = testing_validate_array (expected, hmac, sizeof (hmac));
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	hash_hmac_keyed_release (&keyed);
+	HASH_TESTING_ENGINE_RELEASE (&engine);
+}
+
+#ifdef HASH_ENABLE_SHA384
+static void hash_test_hmac_keyed_sha384 (CuTest *test)
+{
+	HASH_TESTING_ENGINE engine;
+	int status;
+	char *message = "Test";
+	uint8_t key[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t hmac[SHA384_HASH_LENGTH];
+	uint8_t expected[] = {
+		0xd3,0x31,0xf1,0x53,0x07,0x7e,0xfb,0xad,0x73,0x8e,0xea,0x4f,0x3e,0x0c,0x5d,0x3f,
+		0x6b,0x60,0x4d,0x7b,0x32,0xb6,0xa2,0xe8,0xb0,0xeb,0x4e,0x4e,0x7f,0xc9,0x52,0x7b,
+		0xc6,0x04,0x44,0xf2,0x04,0x7e,0xac,0xc1,0xec,0x88,0x0b,0xff,0xd0,0xb1,0xc1,0xf2
+	};
+	struct hmac_keyed_context keyed;
+	int i;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_hmac_keyed_init (&keyed, &engine.base, HMAC_SHA384, key, sizeof (key));
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 2; i++) {
+		memset (hmac, 0, sizeof (hmac));
+
+		status = hash_hmac_keyed_generate (&keyed, (uint8_t*) message, strlen (message), hmac,
+			sizeof (hmac));
+		CuAssertIntEquals (test, 0, status);
+
+		status = testing_validate_array (expected, hmac, sizeof (hmac));
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	hash_hmac_keyed_release (&keyed);
+	HASH_TESTING_ENGINE_RELEASE (&engine);
+}
+#endif
+
+#ifdef HASH_ENABLE_SHA512
+static void hash_test_hmac_keyed_sha512 (CuTest *test)
+{
+	HASH_TESTING_ENGINE engine;
+	int status;
+	char *message = "Test";
+	uint8_t key[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t hmac[SHA512_HASH_LENGTH];
+	uint8_t expected[] = {
+		0x39,0xb8,0x29,0x9b,0x43,0x30,0xcb,0x1e,0x8b,0x51,0xfa,0xcb,0x76,0x79,0xaf,0x47,
+		0xea,0x35,0xbf,0xea,0xb9,0x1b,0x34,0xd0,0x9e,0x0a,0xac,0xc9,0xde,0x64,0x80,0x60,
+		0x29,0x8d,0x86,0xd5,0x47,0x9d,0x4e,0xb5,0x68,0xdf,0xe0,0xea,0xb6,0x2c,0x0e,0x4a,
+		0x47,0x90,0x7e,0x28,0x09,0xb8,0x4b,0x21,0xdd,0x6b,0xc7,0x41,0xca,0x09,0x00,0x3a
+	};
+	struct hmac_keyed_context keyed;
+	int i;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_hmac_keyed_init (&keyed, &engine.base, HMAC_SHA512, key, sizeof (key));
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 2; i++) {
+		memset (hmac, 0, sizeof (hmac));
+
+		status = hash_hmac_keyed_generate (&keyed, (uint8_t*) message, strlen (message), hmac,
+			sizeof (hmac));
+		CuAssertIntEquals (test, 0, status);
+
+		status = testing_validate_array (expected, hmac, sizeof (hmac));
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	hash_hmac_keyed_release (&keyed);
+	HASH_TESTING_ENGINE_RELEASE (&engine);
+}
+#endif
+
+static void hash_test_hmac_keyed_sha256_large_key (CuTest *test)
+{
+	HASH_TESTING_ENGINE engine;
+	int status;
+	char *message = "Test";
+	uint8_t key[SHA256_BLOCK_SIZE + 1];
+	uint8_t hmac[SHA256_HASH_LENGTH];
+	uint8_t expected[] = {
+		0xf1,0x3b,0x43,0x16,0x2c,0xe4,0x05,0x75,0x73,0xc5,0x54,0x10,0xad,0xd5,0xc5,0xc6,
+		0x0e,0x9a,0x37,0xff,0x3e,0xa0,0x02,0x34,0xd6,0x41,0x80,0xfa,0x1a,0x0e,0x0a,0x04
+	};
+	struct hmac_keyed_context keyed;
+	int i;
+
+	TEST_START;
+
+	for (i = 0; i < (int) sizeof (key); i++) {
+		key[i] = i;
+	}
+
+	status = HASH_TESTING_ENGINE_INIT (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_hmac_keyed_init (&keyed, &engine.base, HMAC_SHA256, key, sizeof (key));
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_hmac_keyed_generate (&keyed, (uint8_t*) message, strlen (message), hmac,
+		sizeof (hmac));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (expected, hmac, sizeof (hmac));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_hmac_keyed_release (&keyed);
+	HASH_TESTING_ENGINE_RELEASE (&engine);
+}
+
+static void hash_test_hmac_keyed_sha256_incremental (CuTest *test)
+{
+	HASH_TESTING_ENGINE engine;
+	int status;
+	char *message = "Test";
+	uint8_t key[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t hmac[SHA256_HASH_LENGTH];
+	uint8_t expected[] = {
+		0x88,0x69,0xde,0x57,0x9d,0xd0,0xe9,0x05,0xe0,0xa7,0x11,0x24,0x57,0x55,0x94,0xf5,
+		0x0a,0x03,0xd3,0xd9,0xcd,0xf1,0x6e,0x9a,0x3f,0x9d,0x6c,0x60,0xc0,0x32,0x4b,0x54
+	};
+	struct hmac_keyed_context keyed;
+	struct hmac_engine hmac_engine;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_hmac_keyed_init (&keyed, &engine.base, HMAC_SHA256, key, sizeof (key));
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_hmac_init_keyed (&hmac_engine, &keyed);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_hmac_update (&hmac_engine, (uint8_t*) message, 2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_hmac_update (&hmac_engine, (uint8_t*) &message[2], strlen (message) - 2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_hmac_finish (&hmac_engine, hmac, sizeof (hmac));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (expected, hmac, sizeof (hmac));
+	CuAssertIntEquals (test, 0, status);
+
+	/* The key can be used again after canceling an HMAC. */
+	status = hash_hmac_init_keyed (&hmac_engine, &keyed);
+	CuAssertIntEquals (test, 0, status);
+
+	hash_hmac_cancel (&hmac_engine);
+
+	status = hash_hmac_keyed_generate (&keyed, (uint8_t*) message, strlen (message), hmac,
+		sizeof (hmac));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (expected, hmac, sizeof (hmac));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_hmac_keyed_release (&keyed);
+	HASH_TESTING_ENGINE_RELEASE (&engine);
+}
+
+static void hash_test_hmac_keyed_sha256_no_saved_state (CuTest *test)
+{
+	HASH_TESTING_ENGINE engine;
+	int status;
+	char *message = "Test";
+	uint8_t key[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t hmac[SHA256_HASH_LENGTH];
+	uint8_t expected[] = {
+		0x88,0x69,0xde,0x57,0x9d,0xd0,0xe9,0x05,0xe0,0xa7,0x11,0x24,0x57,0x55,0x94,0xf5,
+		0x0a,0x03,0xd3,0xd9,0xcd,0xf1,0x6e,0x9a,0x3f,0x9d,0x6c,0x60,0xc0,0x32,0x4b,0x54
+	};
+	struct hmac_keyed_context keyed;
+	int i;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	engine.base.save_state = NULL;
+	engine.base.restore_state = NULL;
+
+	status = hash_hmac_keyed_init (&keyed, &engine.base, HMAC_SHA256, key, sizeof (key));
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, false, keyed.has_state);
+
+	for (i = 0; i < 2; i++) {
+		memset (hmac, 0, sizeof (hmac));
+
+		status = hash_hmac_keyed_generate (&keyed, (uint8_t*) message, strlen (message), hmac,
+			sizeof (hmac));
+		CuAssertIntEquals (test, 0, status);
+
+		status = testing_validate_array (expected, hmac, sizeof (hmac));
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	hash_hmac_keyed_release (&keyed);
+	HASH_TESTING_ENGINE_RELEASE (&engine);
+}
+
+static void hash_test_hmac_keyed_saved_state (CuTest *test)
+{
+	struct hash_engine_mock engine;
+	int status;
+	char *message = "Test";
+	uint8_t key[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t hmac[SHA256_HASH_LENGTH];
+	struct hmac_keyed_context keyed;
+
+	TEST_START;
+
+	status = hash_mock_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	hash_mock_enable_save_state (&engine);
+
+	status = mock_expect (&engine.mock, engine.base.start_sha256, &engine, 0);
+	status |= mock_expect (&engine.mock, engine.base.update, &engine, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (SHA256_BLOCK_SIZE));
+	status |= mock_expect (&engine.mock, engine.base.save_state, &engine, 0,
+		MOCK_ARG_PTR (&keyed.prepared.pad.inner));
+	status |= mock_expect (&engine.mock, engine.base.cancel, &engine, 0);
+
+	status |= mock_expect (&engine.mock, engine.base.start_sha256, &engine, 0);
+	status |= mock_expect (&engine.mock, engine.base.update, &engine, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (SHA256_BLOCK_SIZE));
+	status |= mock_expect (&engine.mock, engine.base.save_state, &engine, 0,
+		MOCK_ARG_PTR (&keyed.prepared.pad.outer));
+	status |= mock_expect (&engine.mock, engine.base.cancel, &engine, 0);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_hmac_keyed_init (&keyed, &engine.base, HMAC_SHA256, key, sizeof (key));
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, true, keyed.has_state);
+
+	status = mock_validate (&engine.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Each HMAC only hashes the message and inner digest. */
+	status = mock_expect (&engine.mock, engine.base.restore_state, &engine, 0,
+		MOCK_ARG_PTR (&keyed.prepared.pad.inner));
+	status |= mock_expect (&engine.mock, engine.base.update, &engine, 0, MOCK_ARG_PTR (message),
+		MOCK_ARG (strlen (message)));
+	status |= mock_expect (&engine.mock, engine.base.finish, &engine, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (SHA512_HASH_LENGTH));
+	status |= mock_expect (&engine.mock, engine.base.restore_state, &engine, 0,
+		MOCK_ARG_PTR (&keyed.prepared.pad.outer));
+	status |= mock_expect (&engine.mock, engine.base.update, &engine, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (SHA256_HASH_LENGTH));
+	status |= mock_expect (&engine.mock, engine.base.finish, &engine, 0, MOCK_ARG_PTR (hmac),
+		MOCK_ARG (sizeof (hmac)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_hmac_keyed_generate (&keyed, (uint8_t*) message, strlen (message), hmac,
+		sizeof (hmac));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_hmac_keyed_release (&keyed);
+
+	status = hash_mock_validate_and_release (&engine);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void hash_test_hmac_keyed_no_saved_state_mock (CuTest *test)
+{
+	struct hash_engine_mock engine;
+	int status;
+	char *message = "Test";
+	uint8_t key[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t hmac[SHA256_HASH_LENGTH];
+	struct hmac_keyed_context keyed;
+
+	TEST_START;
+
+	status = hash_mock_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	/* No hash operations are needed to prepare a short key. */
+	status = hash_hmac_keyed_init (&keyed, &engine.base, HMAC_SHA256, key, sizeof (key));
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, false, keyed.has_state);
+
+	status = hash_mock_expect_hmac (&engine, key, sizeof (key), (uint8_t*) message,
+		strlen (message), hmac, sizeof (hmac), HASH_TYPE_SHA256, SHA256_TEST_HASH,
+		SHA256_HASH_LENGTH);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_hmac_keyed_generate (&keyed, (uint8_t*) message, strlen (message), hmac,
+		sizeof (hmac));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA256_TEST_HASH, hmac, sizeof (hmac));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_hmac_keyed_release (&keyed);
+
+	status = hash_mock_validate_and_release (&engine);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void hash_test_hmac_keyed_init_null (CuTest *test)
+{
+	struct hash_engine_mock engine;
+	int status;
+	uint8_t key[] = {0x31, 0x32, 0x33, 0x34};
+	struct hmac_keyed_context keyed;
+
+	TEST_START;
+
+	status = hash_mock_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_hmac_keyed_init (NULL, &engine.base, HMAC_SHA256, key, sizeof (key));
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	status = hash_hmac_keyed_init (&keyed, NULL, HMAC_SHA256, key, sizeof (key));
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	status = hash_hmac_keyed_init (&keyed, &engine.base, HMAC_SHA256, NULL, sizeof (key));
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	status = hash_hmac_keyed_init (&keyed, &engine.base, HMAC_SHA256, key, 0);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	status = hash_mock_validate_and_release (&engine);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void hash_test_hmac_keyed_init_unknown (CuTest *test)
+{
+	struct hash_engine_mock engine;
+	int status;
+	uint8_t key[] = {0x31, 0x32, 0x33, 0x34};
+	struct hmac_keyed_context keyed;
+
+	TEST_START;
+
+	status = hash_mock_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_hmac_keyed_init (&keyed, &engine.base, (enum hmac_hash) 10, key, sizeof (key));
+	CuAssertIntEquals (test, HASH_ENGINE_UNKNOWN_HASH, status);
+
+	status = hash_mock_validate_and_release (&engine);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void hash_test_hmac_keyed_init_large_key_error (CuTest *test)
+{
+	struct hash_engine_mock engine;
+	int status;
+	uint8_t key[SHA256_BLOCK_SIZE + 1];
+	struct hmac_keyed_context keyed;
+
+	TEST_START;
+
+	memset (key, 0x55, sizeof (key));
+
+	status = hash_mock_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	hash_mock_enable_save_state (&engine);
+
+	status = mock_expect (&engine.mock, engine.base.calculate_sha256, &engine,
+		HASH_ENGINE_SHA256_FAILED, MOCK_ARG_PTR (key), MOCK_ARG (sizeof (key)), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (SHA512_BLOCK_SIZE));
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_hmac_keyed_init (&keyed, &engine.base, HMAC_SHA256, key, sizeof (key));
+	CuAssertIntEquals (test, HASH_ENGINE_SHA256_FAILED, status);
+
+	status = hash_mock_validate_and_release (&engine);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void hash_test_hmac_keyed_init_start_error (CuTest *test)
+{
+	struct hash_engine_mock engine;
+	int status;
+	uint8_t key[] = {0x31, 0x32, 0x33, 0x34};
+	struct hmac_keyed_context keyed;
+
+	TEST_START;
+
+	status = hash_mock_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	hash_mock_enable_save_state (&engine);
+
+	status = mock_expect (&engine.mock, engine.base.start_sha256, &engine,
+		HASH_ENGINE_START_SHA256_FAILED);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_hmac_keyed_init (&keyed, &engine.base, HMAC_SHA256, key, sizeof (key));
+	CuAssertIntEquals (test, HASH_ENGINE_START_SHA256_FAILED, status);
+
+	status = hash_mock_validate_and_release (&engine);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void hash_test_hmac_keyed_init_inner_key_error (CuTest *test)
+{
+	struct hash_engine_mock engine;
+	int status;
+	uint8_t key[] = {0x31, 0x32, 0x33, 0x34};
+	struct hmac_keyed_context keyed;
+
+	TEST_START;
+
+	status = hash_mock_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	hash_mock_enable_save_state (&engine);
+
+	status = mock_expect (&engine.mock, engine.base.start_sha256, &engine, 0);
+	status |= mock_expect (&engine.mock, engine.base.update, &engine, HASH_ENGINE_UPDATE_FAILED,
+		MOCK_ARG_NOT_NULL, MOCK_ARG (SHA256_BLOCK_SIZE));
+	status |= mock_expect (&engine.mock, engine.base.cancel, &engine, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_hmac_keyed_init (&keyed, &engine.base, HMAC_SHA256, key, sizeof (key));
+	CuAssertIntEquals (test, HASH_ENGINE_UPDATE_FAILED, status);
+
+	status = hash_mock_validate_and_release (&engine);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void hash_test_hmac_keyed_init_save_inner_error (CuTest *test)
+{
+	struct hash_engine_mock engine;
+	int status;
+	uint8_t key[] = {0x31, 0x32, 0x33, 0x34};
+	struct hmac_keyed_context keyed;
+
+	TEST_START;
+
+	status = hash_mock_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	hash_mock_enable_save_state (&engine);
+
+	status = mock_expect (&engine.mock, engine.base.start_sha256, &engine, 0);
+	status |= mock_expect (&engine.mock, engine.base.update, &engine, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (SHA256_BLOCK_SIZE));
+	status |= mock_expect (&engine.mock, engine.base.save_state, &engine, HASH_ENGINE_NO_MEMORY,
+		MOCK_ARG_PTR (&keyed.prepared.pad.inner));
+	status |= mock_expect (&engine.mock, engine.base.cancel, &engine, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_hmac_keyed_init (&keyed, &engine.base, HMAC_SHA256, key, sizeof (key));
+	CuAssertIntEquals (test, HASH_ENGINE_NO_MEMORY, status);
+
+	status = hash_mock_validate_and_release (&engine);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void hash_test_hmac_keyed_init_save_outer_error (CuTest *test)
+{
+	struct hash_engine_mock engine;
+	int status;
+	uint8_t key[] = {0x31, 0x32, 0x33, 0x34};
+	struct hmac_keyed_context keyed;
+
+	TEST_START;
+
+	status = hash_mock_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	hash_mock_enable_save_state (&engine);
+
+	status = mock_expect (&engine.mock, engine.base.start_sha256, &engine, 0);
+	status |= mock_expect (&engine.mock, engine.base.update, &engine, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (SHA256_BLOCK_SIZE));
+	status |= mock_expect (&engine.mock, engine.base.save_state, &engine, 0,
+		MOCK_ARG_PTR (&keyed.prepared.pad.inner));
+	status |= mock_expect (&engine.mock, engine.base.cancel, &engine, 0);
+
+	status |= mock_expect (&engine.mock, engine.base.start_sha256, &engine, 0);
+	status |= mock_expect (&engine.mock, engine.base.update, &engine, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (SHA256_BLOCK_SIZE));
+	status |= mock_expect (&engine.mock, engine.base.save_state, &engine, HASH_ENGINE_NO_MEMORY,
+		MOCK_ARG_PTR (&keyed.prepared.pad.outer));
+	status |= mock_expect (&engine.mock, engine.base.cancel, &engine, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_hmac_keyed_init (&keyed, &engine.base, HMAC_SHA256, key, sizeof (key));
+	CuAssertIntEquals (test, HASH_ENGINE_NO_MEMORY, status);
+
+	status = hash_mock_validate_and_release (&engine);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void hash_test_hmac_init_keyed_null (CuTest *test)
+{
+	struct hash_engine_mock engine;
+	int status;
+	uint8_t key[] = {0x31, 0x32, 0x33, 0x34};
+	struct hmac_keyed_context keyed;
+	struct hmac_engine hmac_engine;
+
+	TEST_START;
+
+	status = hash_mock_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_hmac_keyed_init (&keyed, &engine.base, HMAC_SHA256, key, sizeof (key));
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_hmac_init_keyed (NULL, &keyed);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	status = hash_hmac_init_keyed (&hmac_engine, NULL);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	hash_hmac_keyed_release (&keyed);
+
+	status = hash_hmac_init_keyed (&hmac_engine, &keyed);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	status = hash_mock_validate_and_release (&engine);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void hash_test_hmac_init_keyed_restore_error (CuTest *test)
+{
+	struct hash_engine_mock engine;
+	int status;
+	uint8_t key[] = {0x31, 0x32, 0x33, 0x34};
+	struct hmac_keyed_context keyed;
+	struct hmac_engine hmac_engine;
+
+	TEST_START;
+
+	status = hash_mock_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	hash_mock_enable_save_state (&engine);
+
+	status = mock_expect (&engine.mock, engine.base.start_sha256, &engine, 0);
+	status |= mock_expect (&engine.mock, engine.base.update, &engine, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (SHA256_BLOCK_SIZE));
+	status |= mock_expect (&engine.mock, engine.base.save_state, &engine, 0,
+		MOCK_ARG_PTR (&keyed.prepared.pad.inner));
+	status |= mock_expect (&engine.mock, engine.base.cancel, &engine, 0);
+
+	status |= mock_expect (&engine.mock, engine.base.start_sha256, &engine, 0);
+	status |= mock_expect (&engine.mock, engine.base.update, &engine, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (SHA256_BLOCK_SIZE));
+	status |= mock_expect (&engine.mock, engine.base.save_state, &engine, 0,
+		MOCK_ARG_PTR (&keyed.prepared.pad.outer));
+	status |= mock_expect (&engine.mock, engine.base.cancel, &engine, 0);
+
+	status |= mock_expect (&engine.mock, engine.base.restore_state, &engine,
+		HASH_ENGINE_HASH_IN_PROGRESS, MOCK_ARG_PTR (&keyed.prepared.pad.inner));
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_hmac_keyed_init (&keyed, &engine.base, HMAC_SHA256, key, sizeof (key));
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_hmac_init_keyed (&hmac_engine, &keyed);
+	CuAssertIntEquals (test, HASH_ENGINE_HASH_IN_PROGRESS, status);
+
+	hash_hmac_keyed_release (&keyed);
+
+	status = hash_mock_validate_and_release (&engine);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void hash_test_hmac_keyed_generate_restore_outer_error (CuTest *test)
+{
+	struct hash_engine_mock engine;
+	int status;
+	char *message = "Test";
+	uint8_t key[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t hmac[SHA256_HASH_LENGTH];
+	struct hmac_keyed_context keyed;
+
+	TEST_START;
+
+	status = hash_mock_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	hash_mock_enable_save_state (&engine);
+
+	status = mock_expect (&engine.mock, engine.base.start_sha256, &engine, 0);
+	status |= mock_expect (&engine.mock, engine.base.update, &engine, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (SHA256_BLOCK_SIZE));
+	status |= mock_expect (&engine.mock, engine.base.save_state, &engine, 0,
+		MOCK_ARG_PTR (&keyed.prepared.pad.inner));
+	status |= mock_expect (&engine.mock, engine.base.cancel, &engine, 0);
+
+	status |= mock_expect (&engine.mock, engine.base.start_sha256, &engine, 0);
+	status |= mock_expect (&engine.mock, engine.base.update, &engine, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (SHA256_BLOCK_SIZE));
+	status |= mock_expect (&engine.mock, engine.base.save_state, &engine, 0,
+		MOCK_ARG_PTR (&keyed.prepared.pad.outer));
+	status |= mock_expect (&engine.mock, engine.base.cancel, &engine, 0);
+
+	status |= mock_expect (&engine.mock, engine.base.restore_state, &engine, 0,
+		MOCK_ARG_PTR (&keyed.prepared.pad.inner));
+	status |= mock_expect (&engine.mock, engine.base.update, &engine, 0, MOCK_ARG_PTR (message),
+		MOCK_ARG (strlen (message)));
+	status |= mock_expect (&engine.mock, engine.base.finish, &engine, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (SHA512_HASH_LENGTH));
+	status |= mock_expect (&engine.mock, engine.base.restore_state, &engine,
+		HASH_ENGINE_NO_MEMORY, MOCK_ARG_PTR (&keyed.prepared.pad.outer));
+	status |= mock_expect (&engine.mock, engine.base.cancel, &engine, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_hmac_keyed_init (&keyed, &engine.base, HMAC_SHA256, key, sizeof (key));
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_hmac_keyed_generate (&keyed, (uint8_t*) message, strlen (message), hmac,
+		sizeof (hmac));
+	CuAssertIntEquals (test, HASH_ENGINE_NO_MEMORY, status);
+
+	hash_hmac_keyed_release (&keyed);
+
+	status = hash_mock_validate_and_release (&engine);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void hash_test_hmac_keyed_generate_update_error (CuTest *test)
+{
+	struct hash_engine_mock engine;
+	int status;
+	char *message = "Test";
+	uint8_t key[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t hmac[SHA256_HASH_LENGTH];
+	struct hmac_keyed_context keyed;
+
+	TEST_START;
+
+	status = hash_mock_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_hmac_keyed_init (&keyed, &engine.base, HMAC_SHA256, key, sizeof (key));
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_expect_hmac_init (&engine, key, sizeof (key), HASH_TYPE_SHA256);
+	status |= mock_expect (&engine.mock, engine.base.update, &engine, HASH_ENGINE_UPDATE_FAILED,
+		MOCK_ARG_PTR (message), MOCK_ARG (strlen (message)));
+	status |= mock_expect (&engine.mock, engine.base.cancel, &engine, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_hmac_keyed_generate (&keyed, (uint8_t*) message, strlen (message), hmac,
+		sizeof (hmac));
+	CuAssertIntEquals (test, HASH_ENGINE_UPDATE_FAILED, status);
+
+	hash_hmac_keyed_release (&keyed);
+
+	status = hash_mock_validate_and_release (&engine);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void hash_test_hmac_keyed_generate_null (CuTest *test)
+{
+	struct hash_engine_mock engine;
+	int status;
+	char *message = "Test";
+	uint8_t key[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t hmac[SHA256_HASH_LENGTH];
+	struct hmac_keyed_context keyed;
+
+	TEST_START;
+
+	status = hash_mock_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_hmac_keyed_init (&keyed, &engine.base, HMAC_SHA256, key, sizeof (key));
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_hmac_keyed_generate (NULL, (uint8_t*) message, strlen (message), hmac,
+		sizeof (hmac));
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	status = hash_hmac_keyed_generate (&keyed, (uint8_t*) message, strlen (message), NULL,
+		sizeof (hmac));
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	hash_hmac_keyed_release (&keyed);
+
+	status = hash_mock_validate_and_release (&engine);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void hash_test_hmac_keyed_generate_small_buffer (CuTest *test)
+{
+	struct hash_engine_mock engine;
+	int status;
+	char *message = "Test";
+	uint8_t key[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t hmac[SHA256_HASH_LENGTH];
+	struct hmac_keyed_context keyed;
+
+	TEST_START;
+
+	status = hash_mock_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_hmac_keyed_init (&keyed, &engine.base, HMAC_SHA256, key, sizeof (key));
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_hmac_keyed_generate (&keyed, (uint8_t*) message, strlen (message), hmac,
+		sizeof (hmac) - 1);
+	CuAssertIntEquals (test, HASH_ENGINE_HASH_BUFFER_TOO_SMALL, status);
+
+	hash_hmac_keyed_release (&keyed);
+
+	status = hash_mock_validate_and_release (&engine);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void hash_test_hmac_keyed_release_null (CuTest *test)
+{
+	TEST_START;
+
+	hash_hmac_keyed_release (NULL);
+}
+
 static void hash_test_start_new_hash_sha1 (CuTest *test)
 {
 	HASH_TESTING_ENGINE engine;
@@ -3173,6 +3987,204 @@ static void hash_test_is_alg_supported (CuTest *test)
 	CuAssertIntEquals (test, 0, status);
 }
 
+static void hash_test_is_save_state_supported (CuTest *test)
+{
+	struct hash_engine_mock mock;
+	int status;
+
+	TEST_START;
+
+	status = hash_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, false, hash_is_save_state_supported (&mock.base));
+
+	hash_mock_enable_save_state (&mock);
+	CuAssertIntEquals (test, true, hash_is_save_state_supported (&mock.base));
+
+	mock.base.restore_state = NULL;
+	CuAssertIntEquals (test, false, hash_is_save_state_supported (&mock.base));
+
+	status = hash_mock_validate_and_release (&mock);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void hash_test_is_save_state_supported_null (CuTest *test)
+{
+	TEST_START;
+
+	CuAssertIntEquals (test, false, hash_is_save_state_supported (NULL));
+}
+
+
+static void hash_test_calculate_sha256_multi (CuTest *test)
+{
+	HASH_TESTING_ENGINE engine;
+	struct hash_multi_buffer buffers[3];
+	char *message = "Test";
+	uint8_t hash[3][SHA256_HASH_LENGTH];
+	int status;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	buffers[0].data = (uint8_t*) message;
+	buffers[0].length = strlen (message);
+	buffers[0].hash = hash[0];
+	buffers[0].hash_length = sizeof (hash[0]);
+
+	buffers[1].data = NULL;
+	buffers[1].length = 0;
+	buffers[1].hash = hash[1];
+	buffers[1].hash_length = sizeof (hash[1]);
+
+	buffers[2].data = HASH_TESTING_FULL_BLOCK_512;
+	buffers[2].length = HASH_TESTING_FULL_BLOCK_512_LEN;
+	buffers[2].hash = hash[2];
+	buffers[2].hash_length = sizeof (hash[2]);
+
+	status = hash_calculate_sha256_multi (&engine.base, buffers, 3);
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA256_TEST_HASH, hash[0], sizeof (hash[0]));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA256_EMPTY_BUFFER_HASH, hash[1], sizeof (hash[1]));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA256_FULL_BLOCK_512_HASH, hash[2], sizeof (hash[2]));
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&engine);
+}
+
+static void hash_test_calculate_sha256_multi_engine_support (CuTest *test)
+{
+	struct hash_engine_mock mock;
+	struct hash_multi_buffer buffers[2];
+	int status;
+
+	TEST_START;
+
+	status = hash_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	hash_mock_enable_sha256_multi (&mock);
+
+	status = mock_expect (&mock.mock, mock.base.calculate_sha256_multi, &mock, 0,
+		MOCK_ARG_PTR (buffers), MOCK_ARG (2));
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_calculate_sha256_multi (&mock.base, buffers, 2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&mock);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void hash_test_calculate_sha256_multi_no_buffers (CuTest *test)
+{
+	struct hash_engine_mock mock;
+	int status;
+
+	TEST_START;
+
+	status = hash_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_calculate_sha256_multi (&mock.base, NULL, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&mock);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void hash_test_calculate_sha256_multi_null (CuTest *test)
+{
+	struct hash_engine_mock mock;
+	struct hash_multi_buffer buffers[2];
+	int status;
+
+	TEST_START;
+
+	status = hash_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_calculate_sha256_multi (NULL, buffers, 2);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	status = hash_calculate_sha256_multi (&mock.base, NULL, 2);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	status = hash_mock_validate_and_release (&mock);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void hash_test_calculate_sha256_multi_error (CuTest *test)
+{
+	struct hash_engine_mock mock;
+	struct hash_multi_buffer buffers[3];
+	char *message = "Test";
+	uint8_t hash[3][SHA256_HASH_LENGTH];
+	size_t i;
+	int status;
+
+	TEST_START;
+
+	for (i = 0; i < 3; i++) {
+		buffers[i].data = (uint8_t*) message;
+		buffers[i].length = strlen (message);
+		buffers[i].hash = hash[i];
+		buffers[i].hash_length = sizeof (hash[i]);
+	}
+
+	status = hash_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Without engine support, each buffer is hashed individually and processing stops on the first
+	 * failure. */
+	status = mock_expect (&mock.mock, mock.base.calculate_sha256, &mock, 0,
+		MOCK_ARG_PTR (message), MOCK_ARG (strlen (message)), MOCK_ARG_PTR (hash[0]),
+		MOCK_ARG (sizeof (hash[0])));
+	status |= mock_expect (&mock.mock, mock.base.calculate_sha256, &mock,
+		HASH_ENGINE_SHA256_FAILED, MOCK_ARG_PTR (message), MOCK_ARG (strlen (message)),
+		MOCK_ARG_PTR (hash[1]), MOCK_ARG (sizeof (hash[1])));
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_calculate_sha256_multi (&mock.base, buffers, 3);
+	CuAssertIntEquals (test, HASH_ENGINE_SHA256_FAILED, status);
+
+	status = hash_mock_validate_and_release (&mock);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void hash_test_is_sha256_multi_supported (CuTest *test)
+{
+	struct hash_engine_mock mock;
+	int status;
+
+	TEST_START;
+
+	status = hash_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, false, hash_is_sha256_multi_supported (&mock.base));
+
+	hash_mock_enable_sha256_multi (&mock);
+	CuAssertIntEquals (test, true, hash_is_sha256_multi_supported (&mock.base));
+
+	status = hash_mock_validate_and_release (&mock);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void hash_test_is_sha256_multi_supported_null (CuTest *test)
+{
+	TEST_START;
+
+	CuAssertIntEquals (test, false, hash_is_sha256_multi_supported (NULL));
+}
 
 TEST_SUITE_START (hash);
 
@@ -3256,6 +4268,35 @@ TEST (hash_test_hash_generate_hmac_sha384_small_buffer);
 #ifdef HASH_ENABLE_SHA512
 TEST (hash_test_hash_generate_hmac_sha512_small_buffer);
 #endif
+#ifdef HASH_ENABLE_SHA1
+TEST (hash_test_hmac_keyed_sha1);
+#endif
+TEST (hash_test_hmac_keyed_sha256);
+#ifdef HASH_ENABLE_SHA384
+TEST (hash_test_hmac_keyed_sha384);
+#endif
+#ifdef HASH_ENABLE_SHA512
+TEST (hash_test_hmac_keyed_sha512);
+#endif
+TEST (hash_test_hmac_keyed_sha256_large_key);
+TEST (hash_test_hmac_keyed_sha256_incremental);
+TEST (hash_test_hmac_keyed_sha256_no_saved_state);
+TEST (hash_test_hmac_keyed_saved_state);
+TEST (hash_test_hmac_keyed_no_saved_state_mock);
+TEST (hash_test_hmac_keyed_init_null);
+TEST (hash_test_hmac_keyed_init_unknown);
+TEST (hash_test_hmac_keyed_init_large_key_error);
+TEST (hash_test_hmac_keyed_init_start_error);
+TEST (hash_test_hmac_keyed_init_inner_key_error);
+TEST (hash_test_hmac_keyed_init_save_inner_error);
+TEST (hash_test_hmac_keyed_init_save_outer_error);
+TEST (hash_test_hmac_init_keyed_null);
+TEST (hash_test_hmac_init_keyed_restore_error);
+TEST (hash_test_hmac_keyed_generate_restore_outer_error);
+TEST (hash_test_hmac_keyed_generate_update_error);
+TEST (hash_test_hmac_keyed_generate_null);
+TEST (hash_test_hmac_keyed_generate_small_buffer);
+TEST (hash_test_hmac_keyed_release_null);
 TEST (hash_test_start_new_hash_sha1);
 TEST (hash_test_start_new_hash_sha256);
 TEST (hash_test_start_new_hash_sha384);
@@ -3293,5 +4334,14 @@ TEST (hash_test_get_hash_length_unsupported);
 TEST (hash_test_hmac_get_hmac_length);
 TEST (hash_test_hmac_get_hmac_length_unsupported);
 TEST (hash_test_is_alg_supported);
+TEST (hash_test_is_save_state_supported);
+TEST (hash_test_is_save_state_supported_null);
+TEST (hash_test_calculate_sha256_multi);
+TEST (hash_test_calculate_sha256_multi_engine_support);
+TEST (hash_test_calculate_sha256_multi_no_buffers);
+TEST (hash_test_calculate_sha256_multi_null);
+TEST (hash_test_calculate_sha256_multi_error);
+TEST (hash_test_is_sha256_multi_supported);
+TEST (hash_test_is_sha256_multi_supported_null);
 
 TEST_SUITE_END;
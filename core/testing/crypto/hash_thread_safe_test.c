@@ -42,6 +42,58 @@ static void hash_thread_safe_test_init (CuTest *test)
 	CuAssertPtrNotNull (test, engine.base.update);
 	CuAssertPtrNotNull (test, engine.base.finish);
 	CuAssertPtrNotNull (test, engine.base.cancel);
+	CuAssertPtrEquals (test, NULL, engine.base.save_state);
+	CuAssertPtrEquals (test, NULL, engine.base.restore_state);
+	CuAssertPtrEquals (test, NULL, engine.base.calculate_sha256_multi);
+
+	status = hash_mock_validate_and_release (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	hash_thread_safe_release (&engine);
+}
+
+static void hash_thread_safe_test_init_save_state (CuTest *test)
+{
+	struct hash_engine_thread_safe engine;
+	struct hash_engine_mock mock;
+	int status;
+
+	TEST_START;
+
+	status = hash_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	hash_mock_enable_save_state (&mock);
+
+	status = hash_thread_safe_init (&engine, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrNotNull (test, engine.base.save_state);
+	CuAssertPtrNotNull (test, engine.base.restore_state);
+
+	status = hash_mock_validate_and_release (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	hash_thread_safe_release (&engine);
+}
+
+static void hash_thread_safe_test_init_sha256_multi (CuTest *test)
+{
+	struct hash_engine_thread_safe engine;
+	struct hash_engine_mock mock;
+	int status;
+
+	TEST_START;
+
+	status = hash_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	hash_mock_enable_sha256_multi (&mock);
+
+	status = hash_thread_safe_init (&engine, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrNotNull (test, engine.base.calculate_sha256_multi);
 
 	status = hash_mock_validate_and_release (&mock);
 	CuAssertIntEquals (test, 0, status);
@@ -1092,10 +1144,327 @@ static void hash_thread_safe_test_cancel_null (CuTest *test)
 	hash_thread_safe_release (&engine);
 }
 
+static void hash_thread_safe_test_save_state (CuTest *test)
+{
+	struct hash_engine_thread_safe engine;
+	struct hash_engine_mock mock;
+	struct hash_saved_state state;
+	int status;
+
+	TEST_START;
+
+	status = hash_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	hash_mock_enable_save_state (&mock);
+
+	status = hash_thread_safe_init (&engine, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&mock.mock, mock.base.start_sha256, &mock, 0);
+	status |= mock_expect (&mock.mock, mock.base.save_state, &mock, 0, MOCK_ARG_PTR (&state));
+	status |= mock_expect (&mock.mock, mock.base.cancel, &mock, 0);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha256 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.save_state (&engine.base, &state);
+	CuAssertIntEquals (test, 0, status);
+
+	engine.base.cancel (&engine.base);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Check lock has been released. */
+	engine.base.start_sha256 (&engine.base);
+
+	hash_mock_release (&mock);
+	hash_thread_safe_release (&engine);
+}
+
+static void hash_thread_safe_test_save_state_error (CuTest *test)
+{
+	struct hash_engine_thread_safe engine;
+	struct hash_engine_mock mock;
+	struct hash_saved_state state;
+	int status;
+
+	TEST_START;
+
+	status = hash_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	hash_mock_enable_save_state (&mock);
+
+	status = hash_thread_safe_init (&engine, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&mock.mock, mock.base.start_sha256, &mock, 0);
+	status |= mock_expect (&mock.mock, mock.base.save_state, &mock, HASH_ENGINE_NO_MEMORY,
+		MOCK_ARG_PTR (&state));
+	status |= mock_expect (&mock.mock, mock.base.cancel, &mock, 0);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha256 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.save_state (&engine.base, &state);
+	CuAssertIntEquals (test, HASH_ENGINE_NO_MEMORY, status);
+
+	engine.base.cancel (&engine.base);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Check lock has been released. */
+	engine.base.start_sha256 (&engine.base);
+
+	hash_mock_release (&mock);
+	hash_thread_safe_release (&engine);
+}
+
+static void hash_thread_safe_test_save_state_null (CuTest *test)
+{
+	struct hash_engine_thread_safe engine;
+	struct hash_engine_mock mock;
+	struct hash_saved_state state;
+	int status;
+
+	TEST_START;
+
+	status = hash_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	hash_mock_enable_save_state (&mock);
+
+	status = hash_thread_safe_init (&engine, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.save_state (NULL, &state);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	hash_mock_release (&mock);
+	hash_thread_safe_release (&engine);
+}
+
+static void hash_thread_safe_test_restore_state (CuTest *test)
+{
+	struct hash_engine_thread_safe engine;
+	struct hash_engine_mock mock;
+	struct hash_saved_state state;
+	uint8_t hash[SHA256_HASH_LENGTH];
+	int status;
+
+	TEST_START;
+
+	status = hash_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	hash_mock_enable_save_state (&mock);
+
+	status = hash_thread_safe_init (&engine, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&mock.mock, mock.base.restore_state, &mock, 0, MOCK_ARG_PTR (&state));
+	status |= mock_expect (&mock.mock, mock.base.finish, &mock, 0, MOCK_ARG_PTR (hash),
+		MOCK_ARG (sizeof (hash)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.restore_state (&engine.base, &state);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Check lock has been released. */
+	engine.base.start_sha256 (&engine.base);
+
+	hash_mock_release (&mock);
+	hash_thread_safe_release (&engine);
+}
+
+static void hash_thread_safe_test_restore_state_error (CuTest *test)
+{
+	struct hash_engine_thread_safe engine;
+	struct hash_engine_mock mock;
+	struct hash_saved_state state;
+	int status;
+
+	TEST_START;
+
+	status = hash_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	hash_mock_enable_save_state (&mock);
+
+	status = hash_thread_safe_init (&engine, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&mock.mock, mock.base.restore_state, &mock,
+		HASH_ENGINE_UNSUPPORTED_HASH, MOCK_ARG_PTR (&state));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.restore_state (&engine.base, &state);
+	CuAssertIntEquals (test, HASH_ENGINE_UNSUPPORTED_HASH, status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Check lock has been released. */
+	engine.base.start_sha256 (&engine.base);
+
+	hash_mock_release (&mock);
+	hash_thread_safe_release (&engine);
+}
+
+static void hash_thread_safe_test_restore_state_null (CuTest *test)
+{
+	struct hash_engine_thread_safe engine;
+	struct hash_engine_mock mock;
+	struct hash_saved_state state;
+	int status;
+
+	TEST_START;
+
+	status = hash_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	hash_mock_enable_save_state (&mock);
+
+	status = hash_thread_safe_init (&engine, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.restore_state (NULL, &state);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Check lock has been released. */
+	engine.base.start_sha256 (&engine.base);
+
+	hash_mock_release (&mock);
+	hash_thread_safe_release (&engine);
+}
+
+
+static void hash_thread_safe_test_calculate_sha256_multi (CuTest *test)
+{
+	struct hash_engine_thread_safe engine;
+	struct hash_engine_mock mock;
+	struct hash_multi_buffer buffers[2];
+	int status;
+
+	TEST_START;
+
+	status = hash_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	hash_mock_enable_sha256_multi (&mock);
+
+	status = hash_thread_safe_init (&engine, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&mock.mock, mock.base.calculate_sha256_multi, &mock, 0,
+		MOCK_ARG_PTR (buffers), MOCK_ARG (2));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.calculate_sha256_multi (&engine.base, buffers, 2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Check lock has been released. */
+	engine.base.start_sha256 (&engine.base);
+
+	hash_mock_release (&mock);
+	hash_thread_safe_release (&engine);
+}
+
+static void hash_thread_safe_test_calculate_sha256_multi_error (CuTest *test)
+{
+	struct hash_engine_thread_safe engine;
+	struct hash_engine_mock mock;
+	struct hash_multi_buffer buffers[2];
+	int status;
+
+	TEST_START;
+
+	status = hash_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	hash_mock_enable_sha256_multi (&mock);
+
+	status = hash_thread_safe_init (&engine, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&mock.mock, mock.base.calculate_sha256_multi, &mock,
+		HASH_ENGINE_SHA256_FAILED, MOCK_ARG_PTR (buffers), MOCK_ARG (2));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.calculate_sha256_multi (&engine.base, buffers, 2);
+	CuAssertIntEquals (test, HASH_ENGINE_SHA256_FAILED, status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Check lock has been released. */
+	engine.base.start_sha256 (&engine.base);
+
+	hash_mock_release (&mock);
+	hash_thread_safe_release (&engine);
+}
+
+static void hash_thread_safe_test_calculate_sha256_multi_null (CuTest *test)
+{
+	struct hash_engine_thread_safe engine;
+	struct hash_engine_mock mock;
+	struct hash_multi_buffer buffers[2];
+	int status;
+
+	TEST_START;
+
+	status = hash_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	hash_mock_enable_sha256_multi (&mock);
+
+	status = hash_thread_safe_init (&engine, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.calculate_sha256_multi (NULL, buffers, 2);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Check lock has been released. */
+	engine.base.start_sha256 (&engine.base);
+
+	hash_mock_release (&mock);
+	hash_thread_safe_release (&engine);
+}
 
 TEST_SUITE_START (hash_thread_safe);
 
 TEST (hash_thread_safe_test_init);
+TEST (hash_thread_safe_test_init_save_state);
+TEST (hash_thread_safe_test_init_sha256_multi);
 TEST (hash_thread_safe_test_init_null);
 TEST (hash_thread_safe_test_release_null);
 TEST (hash_thread_safe_test_calculate_sha1);
@@ -1129,5 +1498,14 @@ TEST (hash_thread_safe_test_finish);
 TEST (hash_thread_safe_test_finish_error);
 TEST (hash_thread_safe_test_finish_null);
 TEST (hash_thread_safe_test_cancel_null);
+TEST (hash_thread_safe_test_save_state);
+TEST (hash_thread_safe_test_save_state_error);
+TEST (hash_thread_safe_test_save_state_null);
+TEST (hash_thread_safe_test_restore_state);
+TEST (hash_thread_safe_test_restore_state_error);
+TEST (hash_thread_safe_test_restore_state_null);
+TEST (hash_thread_safe_test_calculate_sha256_multi);
+TEST (hash_thread_safe_test_calculate_sha256_multi_error);
+TEST (hash_thread_safe_test_calculate_sha256_multi_null);
 
 TEST_SUITE_END;
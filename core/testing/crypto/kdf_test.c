@@ -273,6 +273,132 @@ static void kdf_test_nist800_108_counter_mode_key_larger_than_hash_not_exact_mul
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 }
 
+static void kdf_test_nist800_108_counter_mode_key_larger_than_hash_no_saved_state (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	uint8_t ki[] = {
+		0xf1,0x3b,0x43,0x16,0x2c,0xe4,0x02,0x34,0xd6,0x41,0x80,0xfa,0x1a,0x0e,0x0a,0x04,
+		0x0e,0x9a,0x37,0xff,0x3e,0xa0,0x05,0x75,0x73,0xc5,0x54,0x10,0xad,0xd5,0xc5,0xc6
+	};
+	uint8_t label[] = {
+		0x0e,0x9a,0x37,0xff,0x3e,0xa0,0x02,0x75,0x73,0xc5,0x54,0x10,0xad,0xd5,0xc5,0xc6,
+		0xf1,0x3b,0x43,0x16,0x2c,0xe4,0x05,0x34,0xd6,0x41,0x80,0xfa,0x1a,0x0e,0x0a,0x04
+	};
+	uint8_t context[] = {
+		0xf1,0x3b,0x43,0x16,0x2c,0x0e,0x9a,0x37,0xe4,0x05,0x75,0x73,0xc5,0x54,0x10,0xad,
+		0xff,0x3e,0xa0,0x02,0x34,0xd6,0x41,0x80,0xfa,0x1a,0x0e,0x0a,0x04,0xd5,0xc5,0xc6
+	};
+	uint8_t ko[SHA256_HASH_LENGTH * 2];
+	int status;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	hash.base.save_state = NULL;
+	hash.base.restore_state = NULL;
+
+	status = kdf_nist800_108_counter_mode (&hash.base, HMAC_SHA256, ki, sizeof (ki), label,
+		sizeof (label), context, sizeof (context), ko, sizeof (ko));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (kdo_sha256_64, ko, sizeof (kdo_sha256_64));
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void kdf_test_nist800_108_counter_mode_saved_state_init_fail (CuTest *test)
+{
+	struct hash_engine_mock hash;
+	uint8_t ki[] = {
+		0xf1,0x3b,0x43,0x16,0x2c,0xe4,0x02,0x34,0xd6,0x41,0x80,0xfa,0x1a,0x0e,0x0a,0x04,
+		0x0e,0x9a,0x37,0xff,0x3e,0xa0,0x05,0x75,0x73,0xc5,0x54,0x10,0xad,0xd5,0xc5,0xc6
+	};
+	uint8_t label[] = {
+		0x0e,0x9a,0x37,0xff,0x3e,0xa0,0x02,0x75,0x73,0xc5,0x54,0x10,0xad,0xd5,0xc5,0xc6,
+		0xf1,0x3b,0x43,0x16,0x2c,0xe4,0x05,0x34,0xd6,0x41,0x80,0xfa,0x1a,0x0e,0x0a,0x04
+	};
+	uint8_t context[] = {
+		0xf1,0x3b,0x43,0x16,0x2c,0x0e,0x9a,0x37,0xe4,0x05,0x75,0x73,0xc5,0x54,0x10,0xad,
+		0xff,0x3e,0xa0,0x02,0x34,0xd6,0x41,0x80,0xfa,0x1a,0x0e,0x0a,0x04,0xd5,0xc5,0xc6
+	};
+	uint8_t ko[SHA256_HASH_LENGTH];
+	int status;
+
+	TEST_START;
+
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	hash_mock_enable_save_state (&hash);
+
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (SHA256_BLOCK_SIZE));
+	status |= mock_expect (&hash.mock, hash.base.save_state, &hash, HASH_ENGINE_NO_MEMORY,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect (&hash.mock, hash.base.cancel, &hash, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = kdf_nist800_108_counter_mode (&hash.base, HMAC_SHA256, ki, sizeof (ki), label,
+		sizeof (label), context, sizeof (context), ko, sizeof (ko));
+	CuAssertIntEquals (test, HASH_ENGINE_NO_MEMORY, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void kdf_test_nist800_108_counter_mode_saved_state_round_fail (CuTest *test)
+{
+	struct hash_engine_mock hash;
+	uint8_t ki[] = {
+		0xf1,0x3b,0x43,0x16,0x2c,0xe4,0x02,0x34,0xd6,0x41,0x80,0xfa,0x1a,0x0e,0x0a,0x04,
+		0x0e,0x9a,0x37,0xff,0x3e,0xa0,0x05,0x75,0x73,0xc5,0x54,0x10,0xad,0xd5,0xc5,0xc6
+	};
+	uint8_t label[] = {
+		0x0e,0x9a,0x37,0xff,0x3e,0xa0,0x02,0x75,0x73,0xc5,0x54,0x10,0xad,0xd5,0xc5,0xc6,
+		0xf1,0x3b,0x43,0x16,0x2c,0xe4,0x05,0x34,0xd6,0x41,0x80,0xfa,0x1a,0x0e,0x0a,0x04
+	};
+	uint8_t context[] = {
+		0xf1,0x3b,0x43,0x16,0x2c,0x0e,0x9a,0x37,0xe4,0x05,0x75,0x73,0xc5,0x54,0x10,0xad,
+		0xff,0x3e,0xa0,0x02,0x34,0xd6,0x41,0x80,0xfa,0x1a,0x0e,0x0a,0x04,0xd5,0xc5,0xc6
+	};
+	uint8_t ko[SHA256_HASH_LENGTH];
+	int status;
+
+	TEST_START;
+
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	hash_mock_enable_save_state (&hash);
+
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (SHA256_BLOCK_SIZE));
+	status |= mock_expect (&hash.mock, hash.base.save_state, &hash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect (&hash.mock, hash.base.cancel, &hash, 0);
+
+	status |= mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (SHA256_BLOCK_SIZE));
+	status |= mock_expect (&hash.mock, hash.base.save_state, &hash, 0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect (&hash.mock, hash.base.cancel, &hash, 0);
+
+	status |= mock_expect (&hash.mock, hash.base.restore_state, &hash, HASH_ENGINE_NO_MEMORY,
+		MOCK_ARG_NOT_NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	status = kdf_nist800_108_counter_mode (&hash.base, HMAC_SHA256, ki, sizeof (ki), label,
+		sizeof (label), context, sizeof (context), ko, sizeof (ko));
+	CuAssertIntEquals (test, HASH_ENGINE_NO_MEMORY, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+}
+
 static void kdf_test_nist800_108_counter_mode_init_hmac_fail (CuTest *test)
 {
 	struct hash_engine_mock hash;
@@ -616,6 +742,100 @@ static void kdf_test_nist800_108_counter_mode_invalid_arg (CuTest *test)
 }
 
 
+static void kdf_test_nist800_108_counter_mode_keyed (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct hmac_keyed_context keyed;
+	uint8_t ki[] = {
+		0xf1,0x3b,0x43,0x16,0x2c,0xe4,0x02,0x34,0xd6,0x41,0x80,0xfa,0x1a,0x0e,0x0a,0x04,
+		0x0e,0x9a,0x37,0xff,0x3e,0xa0,0x05,0x75,0x73,0xc5,0x54,0x10,0xad,0xd5,0xc5,0xc6
+	};
+	uint8_t label[] = {
+		0x0e,0x9a,0x37,0xff,0x3e,0xa0,0x02,0x75,0x73,0xc5,0x54,0x10,0xad,0xd5,0xc5,0xc6,
+		0xf1,0x3b,0x43,0x16,0x2c,0xe4,0x05,0x34,0xd6,0x41,0x80,0xfa,0x1a,0x0e,0x0a,0x04
+	};
+	uint8_t context[] = {
+		0xf1,0x3b,0x43,0x16,0x2c,0x0e,0x9a,0x37,0xe4,0x05,0x75,0x73,0xc5,0x54,0x10,0xad,
+		0xff,0x3e,0xa0,0x02,0x34,0xd6,0x41,0x80,0xfa,0x1a,0x0e,0x0a,0x04,0xd5,0xc5,0xc6
+	};
+	uint8_t ko[SHA256_HASH_LENGTH * 2];
+	int status;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_hmac_keyed_init (&keyed, &hash.base, HMAC_SHA256, ki, sizeof (ki));
+	CuAssertIntEquals (test, 0, status);
+
+	status = kdf_nist800_108_counter_mode_keyed (&keyed, label, sizeof (label), context,
+		sizeof (context), ko, sizeof (ko));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (kdo_sha256_64, ko, sizeof (kdo_sha256_64));
+	CuAssertIntEquals (test, 0, status);
+
+	/* The prepared key can be used for multiple KDF operations. */
+	memset (ko, 0, sizeof (ko));
+
+	status = kdf_nist800_108_counter_mode_keyed (&keyed, label, sizeof (label), context,
+		sizeof (context), ko, sizeof (ko));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (kdo_sha256_64, ko, sizeof (kdo_sha256_64));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_hmac_keyed_release (&keyed);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void kdf_test_nist800_108_counter_mode_keyed_invalid_arg (CuTest *test)
+{
+	struct hash_engine_mock hash;
+	struct hmac_keyed_context keyed;
+	uint8_t ki[] = {
+		0xf1,0x3b,0x43,0x16,0x2c,0xe4,0x02,0x34,0xd6,0x41,0x80,0xfa,0x1a,0x0e,0x0a,0x04,
+		0x0e,0x9a,0x37,0xff,0x3e,0xa0,0x05,0x75,0x73,0xc5,0x54,0x10,0xad,0xd5,0xc5,0xc6
+	};
+	uint8_t label[] = {
+		0x0e,0x9a,0x37,0xff,0x3e,0xa0,0x02,0x75,0x73,0xc5,0x54,0x10,0xad,0xd5,0xc5,0xc6,
+		0xf1,0x3b,0x43,0x16,0x2c,0xe4,0x05,0x34,0xd6,0x41,0x80,0xfa,0x1a,0x0e,0x0a,0x04
+	};
+	uint8_t context[] = {
+		0xf1,0x3b,0x43,0x16,0x2c,0x0e,0x9a,0x37,0xe4,0x05,0x75,0x73,0xc5,0x54,0x10,0xad,
+		0xff,0x3e,0xa0,0x02,0x34,0xd6,0x41,0x80,0xfa,0x1a,0x0e,0x0a,0x04,0xd5,0xc5,0xc6
+	};
+	uint8_t ko[SHA256_HASH_LENGTH];
+	int status;
+
+	TEST_START;
+
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_hmac_keyed_init (&keyed, &hash.base, HMAC_SHA256, ki, sizeof (ki));
+	CuAssertIntEquals (test, 0, status);
+
+	status = kdf_nist800_108_counter_mode_keyed (NULL, label, sizeof (label), context,
+		sizeof (context), ko, sizeof (ko));
+	CuAssertIntEquals (test, KDF_INVALID_ARGUMENT, status);
+
+	status = kdf_nist800_108_counter_mode_keyed (&keyed, NULL, sizeof (label), context,
+		sizeof (context), ko, sizeof (ko));
+	CuAssertIntEquals (test, KDF_INVALID_ARGUMENT, status);
+
+	status = kdf_nist800_108_counter_mode_keyed (&keyed, label, sizeof (label), context,
+		sizeof (context), NULL, sizeof (ko));
+	CuAssertIntEquals (test, KDF_INVALID_ARGUMENT, status);
+
+	hash_hmac_keyed_release (&keyed);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+
 TEST_SUITE_START (kdf);
 
 TEST (kdf_test_nist800_108_counter_mode_sha1);
@@ -631,5 +851,10 @@ TEST (kdf_test_nist800_108_counter_mode_update_context_hmac_fail);
 TEST (kdf_test_nist800_108_counter_mode_update_ko_len_hmac_fail);
 TEST (kdf_test_nist800_108_counter_mode_finish_hmac_fail);
 TEST (kdf_test_nist800_108_counter_mode_invalid_arg);
+TEST (kdf_test_nist800_108_counter_mode_key_larger_than_hash_no_saved_state);
+TEST (kdf_test_nist800_108_counter_mode_saved_state_init_fail);
+TEST (kdf_test_nist800_108_counter_mode_saved_state_round_fail);
+TEST (kdf_test_nist800_108_counter_mode_keyed);
+TEST (kdf_test_nist800_108_counter_mode_keyed_invalid_arg);
 
 TEST_SUITE_END;
@@ -0,0 +1,504 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "testing.h"
+#include "crypto/key_cache.h"
+#include "crypto/key_cache_static.h"
+
+
+TEST_SUITE_LABEL ("key_cache");
+
+
+/**
+ * Number of entries in the cache used for testing.
+ */
+#define	KEY_CACHE_TESTING_ENTRIES		3
+
+
+/**
+ * Components for testing a key cache.
+ */
+struct key_cache_testing {
+	struct key_cache_state state;								/**< Variable context for the cache. */
+	struct key_cache_entry entries[KEY_CACHE_TESTING_ENTRIES];	/**< Storage for cache entries. */
+	struct key_cache test;										/**< Cache under test. */
+	uint8_t id[4][KEY_CACHE_ID_LENGTH];							/**< Key identifiers for testing. */
+};
+
+
+/**
+ * Initialize a key cache for testing.
+ *
+ * @param test The testing framework.
+ * @param cache Testing components to initialize.
+ */
+static void key_cache_testing_init (CuTest *test, struct key_cache_testing *cache)
+{
+	int status;
+	int i;
+
+	for (i = 0; i < 4; i++) {
+		memset (cache->id[i], i + 1, KEY_CACHE_ID_LENGTH);
+	}
+
+	status = key_cache_init (&cache->test, &cache->state, cache->entries,
+		KEY_CACHE_TESTING_ENTRIES);
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Release test components.
+ *
+ * @param test The testing framework.
+ * @param cache Testing components to release.
+ */
+static void key_cache_testing_release (CuTest *test, struct key_cache_testing *cache)
+{
+	key_cache_release (&cache->test);
+}
+
+/**
+ * Add a key to the cache and check the entry assignment.
+ *
+ * @param test The testing framework.
+ * @param cache Testing components.
+ * @param key Index of the test key identifier to add.
+ * @param expected The cache entry expected to be assigned.
+ * @param expect_evict Flag indicating if an eviction is expected.
+ */
+static void key_cache_testing_add (CuTest *test, struct key_cache_testing *cache, int key,
+	int expected, bool expect_evict)
+{
+	bool evicted;
+	int status;
+
+	status = key_cache_add (&cache->test, cache->id[key], &evicted);
+	CuAssertIntEquals (test, expected, status);
+	CuAssertIntEquals (test, expect_evict, evicted);
+}
+
+
+/*******************
+ * Test cases
+ *******************/
+
+static void key_cache_test_init (CuTest *test)
+{
+	struct key_cache_testing cache;
+	struct key_cache_stats stats;
+	int status;
+	int i;
+
+	TEST_START;
+
+	key_cache_testing_init (test, &cache);
+
+	for (i = 0; i < KEY_CACHE_TESTING_ENTRIES; i++) {
+		CuAssertIntEquals (test, false, key_cache_is_entry_valid (&cache.test, i));
+	}
+
+	status = key_cache_get_stats (&cache.test, &stats);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 0, stats.hits);
+	CuAssertIntEquals (test, 0, stats.misses);
+	CuAssertIntEquals (test, 0, stats.evictions);
+
+	key_cache_testing_release (test, &cache);
+}
+
+static void key_cache_test_init_null (CuTest *test)
+{
+	struct key_cache_testing cache;
+	int status;
+
+	TEST_START;
+
+	status = key_cache_init (NULL, &cache.state, cache.entries, KEY_CACHE_TESTING_ENTRIES);
+	CuAssertIntEquals (test, KEY_CACHE_INVALID_ARGUMENT, status);
+
+	status = key_cache_init (&cache.test, NULL, cache.entries, KEY_CACHE_TESTING_ENTRIES);
+	CuAssertIntEquals (test, KEY_CACHE_INVALID_ARGUMENT, status);
+
+	status = key_cache_init (&cache.test, &cache.state, NULL, KEY_CACHE_TESTING_ENTRIES);
+	CuAssertIntEquals (test, KEY_CACHE_INVALID_ARGUMENT, status);
+
+	status = key_cache_init (&cache.test, &cache.state, cache.entries, 0);
+	CuAssertIntEquals (test, KEY_CACHE_INVALID_ARGUMENT, status);
+}
+
+static void key_cache_test_static_init (CuTest *test)
+{
+	struct key_cache_testing cache;
+	struct key_cache test_static = key_cache_static_init (&cache.state, cache.entries,
+		KEY_CACHE_TESTING_ENTRIES);
+	bool evicted;
+	int status;
+
+	TEST_START;
+
+	memset (cache.id[0], 0x55, KEY_CACHE_ID_LENGTH);
+
+	status = key_cache_init_state (&test_static);
+	CuAssertIntEquals (test, 0, status);
+
+	status = key_cache_find (&test_static, cache.id[0]);
+	CuAssertIntEquals (test, KEY_CACHE_NOT_CACHED, status);
+
+	status = key_cache_add (&test_static, cache.id[0], &evicted);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, false, evicted);
+
+	status = key_cache_find (&test_static, cache.id[0]);
+	CuAssertIntEquals (test, 0, status);
+
+	key_cache_release (&test_static);
+}
+
+static void key_cache_test_static_init_null (CuTest *test)
+{
+	struct key_cache_testing cache;
+	struct key_cache null_state = key_cache_static_init (NULL, cache.entries,
+		KEY_CACHE_TESTING_ENTRIES);
+	struct key_cache null_entries = key_cache_static_init (&cache.state, NULL,
+		KEY_CACHE_TESTING_ENTRIES);
+	struct key_cache no_entries = key_cache_static_init (&cache.state, cache.entries, 0);
+	int status;
+
+	TEST_START;
+
+	status = key_cache_init_state (NULL);
+	CuAssertIntEquals (test, KEY_CACHE_INVALID_ARGUMENT, status);
+
+	status = key_cache_init_state (&null_state);
+	CuAssertIntEquals (test, KEY_CACHE_INVALID_ARGUMENT, status);
+
+	status = key_cache_init_state (&null_entries);
+	CuAssertIntEquals (test, KEY_CACHE_INVALID_ARGUMENT, status);
+
+	status = key_cache_init_state (&no_entries);
+	CuAssertIntEquals (test, KEY_CACHE_INVALID_ARGUMENT, status);
+}
+
+static void key_cache_test_release_null (CuTest *test)
+{
+	TEST_START;
+
+	key_cache_release (NULL);
+}
+
+static void key_cache_test_find_empty (CuTest *test)
+{
+	struct key_cache_testing cache;
+	struct key_cache_stats stats;
+	int status;
+
+	TEST_START;
+
+	key_cache_testing_init (test, &cache);
+
+	status = key_cache_find (&cache.test, cache.id[0]);
+	CuAssertIntEquals (test, KEY_CACHE_NOT_CACHED, status);
+
+	status = key_cache_get_stats (&cache.test, &stats);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 0, stats.hits);
+	CuAssertIntEquals (test, 1, stats.misses);
+	CuAssertIntEquals (test, 0, stats.evictions);
+
+	key_cache_testing_release (test, &cache);
+}
+
+static void key_cache_test_add_and_find (CuTest *test)
+{
+	struct key_cache_testing cache;
+	struct key_cache_stats stats;
+	int status;
+
+	TEST_START;
+
+	key_cache_testing_init (test, &cache);
+
+	key_cache_testing_add (test, &cache, 0, 0, false);
+	key_cache_testing_add (test, &cache, 1, 1, false);
+	key_cache_testing_add (test, &cache, 2, 2, false);
+
+	status = key_cache_find (&cache.test, cache.id[1]);
+	CuAssertIntEquals (test, 1, status);
+
+	status = key_cache_find (&cache.test, cache.id[0]);
+	CuAssertIntEquals (test, 0, status);
+
+	status = key_cache_find (&cache.test, cache.id[2]);
+	CuAssertIntEquals (test, 2, status);
+
+	status = key_cache_find (&cache.test, cache.id[3]);
+	CuAssertIntEquals (test, KEY_CACHE_NOT_CACHED, status);
+
+	CuAssertIntEquals (test, true, key_cache_is_entry_valid (&cache.test, 0));
+	CuAssertIntEquals (test, true, key_cache_is_entry_valid (&cache.test, 1));
+	CuAssertIntEquals (test, true, key_cache_is_entry_valid (&cache.test, 2));
+
+	status = key_cache_get_stats (&cache.test, &stats);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 3, stats.hits);
+	CuAssertIntEquals (test, 1, stats.misses);
+	CuAssertIntEquals (test, 0, stats.evictions);
+
+	key_cache_testing_release (test, &cache);
+}
+
+static void key_cache_test_add_evict_least_recently_added (CuTest *test)
+{
+	struct key_cache_testing cache;
+	struct key_cache_stats stats;
+	int status;
+
+	TEST_START;
+
+	key_cache_testing_init (test, &cache);
+
+	key_cache_testing_add (test, &cache, 0, 0, false);
+	key_cache_testing_add (test, &cache, 1, 1, false);
+	key_cache_testing_add (test, &cache, 2, 2, false);
+	key_cache_testing_add (test, &cache, 3, 0, true);
+
+	status = key_cache_find (&cache.test, cache.id[0]);
+	CuAssertIntEquals (test, KEY_CACHE_NOT_CACHED, status);
+
+	status = key_cache_find (&cache.test, cache.id[3]);
+	CuAssertIntEquals (test, 0, status);
+
+	status = key_cache_get_stats (&cache.test, &stats);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 1, stats.evictions);
+
+	key_cache_testing_release (test, &cache);
+}
+
+static void key_cache_test_add_evict_least_recently_used (CuTest *test)
+{
+	struct key_cache_testing cache;
+	int status;
+
+	TEST_START;
+
+	key_cache_testing_init (test, &cache);
+
+	key_cache_testing_add (test, &cache, 0, 0, false);
+	key_cache_testing_add (test, &cache, 1, 1, false);
+	key_cache_testing_add (test, &cache, 2, 2, false);
+
+	status = key_cache_find (&cache.test, cache.id[0]);
+	CuAssertIntEquals (test, 0, status);
+
+	status = key_cache_find (&cache.test, cache.id[2]);
+	CuAssertIntEquals (test, 2, status);
+
+	key_cache_testing_add (test, &cache, 3, 1, true);
+
+	status = key_cache_find (&cache.test, cache.id[1]);
+	CuAssertIntEquals (test, KEY_CACHE_NOT_CACHED, status);
+
+	/* The least recently used is now the first key. */
+	key_cache_testing_add (test, &cache, 1, 0, true);
+
+	status = key_cache_find (&cache.test, cache.id[2]);
+	CuAssertIntEquals (test, 2, status);
+
+	status = key_cache_find (&cache.test, cache.id[3]);
+	CuAssertIntEquals (test, 1, status);
+
+	key_cache_testing_release (test, &cache);
+}
+
+static void key_cache_test_add_access_count_wrap (CuTest *test)
+{
+	struct key_cache_testing cache;
+	int status;
+
+	TEST_START;
+
+	key_cache_testing_init (test, &cache);
+
+	cache.state.access_count = 0xfffffffe;
+
+	key_cache_testing_add (test, &cache, 0, 0, false);
+	key_cache_testing_add (test, &cache, 1, 1, false);
+	key_cache_testing_add (test, &cache, 2, 2, false);
+
+	CuAssertIntEquals (test, 1, cache.state.access_count);
+
+	status = key_cache_find (&cache.test, cache.id[0]);
+	CuAssertIntEquals (test, 0, status);
+
+	key_cache_testing_add (test, &cache, 3, 1, true);
+
+	key_cache_testing_release (test, &cache);
+}
+
+static void key_cache_test_add_already_cached (CuTest *test)
+{
+	struct key_cache_testing cache;
+	struct key_cache_stats stats;
+	bool evicted;
+	int status;
+
+	TEST_START;
+
+	key_cache_testing_init (test, &cache);
+
+	key_cache_testing_add (test, &cache, 0, 0, false);
+	key_cache_testing_add (test, &cache, 1, 1, false);
+
+	status = key_cache_add (&cache.test, cache.id[1], &evicted);
+	CuAssertIntEquals (test, KEY_CACHE_ALREADY_CACHED, status);
+
+	key_cache_testing_add (test, &cache, 2, 2, false);
+
+	status = key_cache_find (&cache.test, cache.id[1]);
+	CuAssertIntEquals (test, 1, status);
+
+	status = key_cache_get_stats (&cache.test, &stats);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 1, stats.hits);
+	CuAssertIntEquals (test, 0, stats.misses);
+	CuAssertIntEquals (test, 0, stats.evictions);
+
+	key_cache_testing_release (test, &cache);
+}
+
+static void key_cache_test_add_null (CuTest *test)
+{
+	struct key_cache_testing cache;
+	bool evicted;
+	int status;
+
+	TEST_START;
+
+	key_cache_testing_init (test, &cache);
+
+	status = key_cache_add (NULL, cache.id[0], &evicted);
+	CuAssertIntEquals (test, KEY_CACHE_INVALID_ARGUMENT, status);
+
+	status = key_cache_add (&cache.test, NULL, &evicted);
+	CuAssertIntEquals (test, KEY_CACHE_INVALID_ARGUMENT, status);
+
+	status = key_cache_add (&cache.test, cache.id[0], NULL);
+	CuAssertIntEquals (test, KEY_CACHE_INVALID_ARGUMENT, status);
+
+	key_cache_testing_release (test, &cache);
+}
+
+static void key_cache_test_find_null (CuTest *test)
+{
+	struct key_cache_testing cache;
+	int status;
+
+	TEST_START;
+
+	key_cache_testing_init (test, &cache);
+
+	status = key_cache_find (NULL, cache.id[0]);
+	CuAssertIntEquals (test, KEY_CACHE_INVALID_ARGUMENT, status);
+
+	status = key_cache_find (&cache.test, NULL);
+	CuAssertIntEquals (test, KEY_CACHE_INVALID_ARGUMENT, status);
+
+	key_cache_testing_release (test, &cache);
+}
+
+static void key_cache_test_remove (CuTest *test)
+{
+	struct key_cache_testing cache;
+	int status;
+
+	TEST_START;
+
+	key_cache_testing_init (test, &cache);
+
+	key_cache_testing_add (test, &cache, 0, 0, false);
+	key_cache_testing_add (test, &cache, 1, 1, false);
+	key_cache_testing_add (test, &cache, 2, 2, false);
+
+	key_cache_remove (&cache.test, 1);
+
+	CuAssertIntEquals (test, false, key_cache_is_entry_valid (&cache.test, 1));
+
+	status = key_cache_find (&cache.test, cache.id[1]);
+	CuAssertIntEquals (test, KEY_CACHE_NOT_CACHED, status);
+
+	/* The empty entry is used before evicting any keys. */
+	key_cache_testing_add (test, &cache, 3, 1, false);
+
+	key_cache_testing_release (test, &cache);
+}
+
+static void key_cache_test_remove_invalid_index (CuTest *test)
+{
+	struct key_cache_testing cache;
+
+	TEST_START;
+
+	key_cache_testing_init (test, &cache);
+
+	key_cache_testing_add (test, &cache, 0, 0, false);
+
+	key_cache_remove (NULL, 0);
+	key_cache_remove (&cache.test, KEY_CACHE_TESTING_ENTRIES);
+
+	CuAssertIntEquals (test, true, key_cache_is_entry_valid (&cache.test, 0));
+	CuAssertIntEquals (test, false, key_cache_is_entry_valid (NULL, 0));
+	CuAssertIntEquals (test, false,
+		key_cache_is_entry_valid (&cache.test, KEY_CACHE_TESTING_ENTRIES));
+
+	key_cache_testing_release (test, &cache);
+}
+
+static void key_cache_test_get_stats_null (CuTest *test)
+{
+	struct key_cache_testing cache;
+	struct key_cache_stats stats;
+	int status;
+
+	TEST_START;
+
+	key_cache_testing_init (test, &cache);
+
+	status = key_cache_get_stats (NULL, &stats);
+	CuAssertIntEquals (test, KEY_CACHE_INVALID_ARGUMENT, status);
+
+	status = key_cache_get_stats (&cache.test, NULL);
+	CuAssertIntEquals (test, KEY_CACHE_INVALID_ARGUMENT, status);
+
+	key_cache_testing_release (test, &cache);
+}
+
+
+TEST_SUITE_START (key_cache);
+
+TEST (key_cache_test_init);
+TEST (key_cache_test_init_null);
+TEST (key_cache_test_static_init);
+TEST (key_cache_test_static_init_null);
+TEST (key_cache_test_release_null);
+TEST (key_cache_test_find_empty);
+TEST (key_cache_test_add_and_find);
+TEST (key_cache_test_add_evict_least_recently_added);
+TEST (key_cache_test_add_evict_least_recently_used);
+TEST (key_cache_test_add_access_count_wrap);
+TEST (key_cache_test_add_already_cached);
+TEST (key_cache_test_add_null);
+TEST (key_cache_test_find_null);
+TEST (key_cache_test_remove);
+TEST (key_cache_test_remove_invalid_index);
+TEST (key_cache_test_get_stats_null);
+
+TEST_SUITE_END;
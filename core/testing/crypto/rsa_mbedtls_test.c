@@ -8,6 +8,7 @@
 #include "platform_api.h"
 #include "testing.h"
 #include "crypto/rsa_mbedtls.h"
+#include "crypto/key_cache_static.h"
 #include "mbedtls/pk.h"
 #include "mbedtls/sha256.h"
 #include "testing/crypto/rsa_testing.h"
@@ -337,6 +338,201 @@ static void rsa_mbedtls_test_sig_verify_bad_signature_wrong_hash (CuTest *test)
 	rsa_mbedtls_release (&engine);
 }
 
+static void rsa_mbedtls_test_init_with_key_cache (CuTest *test)
+{
+	struct rsa_engine_mbedtls engine;
+	struct key_cache_state cache_state;
+	struct key_cache_entry entries[2];
+	struct key_cache cache = key_cache_static_init (&cache_state, entries, 2);
+	mbedtls_rsa_context prepared[2];
+	int status;
+
+	TEST_START;
+
+	status = rsa_mbedtls_init_with_key_cache (&engine, &cache, prepared);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrNotNull (test, engine.base.generate_key);
+	CuAssertPtrNotNull (test, engine.base.init_private_key);
+	CuAssertPtrNotNull (test, engine.base.init_public_key);
+	CuAssertPtrNotNull (test, engine.base.release_key);
+	CuAssertPtrNotNull (test, engine.base.get_private_key_der);
+	CuAssertPtrNotNull (test, engine.base.get_public_key_der);
+	CuAssertPtrNotNull (test, engine.base.decrypt);
+	CuAssertPtrNotNull (test, engine.base.sig_verify);
+
+	rsa_mbedtls_release (&engine);
+}
+
+static void rsa_mbedtls_test_init_with_key_cache_null (CuTest *test)
+{
+	struct rsa_engine_mbedtls engine;
+	struct key_cache_state cache_state;
+	struct key_cache_entry entries[2];
+	struct key_cache cache = key_cache_static_init (&cache_state, entries, 2);
+	struct key_cache no_entries = key_cache_static_init (&cache_state, entries, 0);
+	mbedtls_rsa_context prepared[2];
+	int status;
+
+	TEST_START;
+
+	status = rsa_mbedtls_init_with_key_cache (NULL, &cache, prepared);
+	CuAssertIntEquals (test, RSA_ENGINE_INVALID_ARGUMENT, status);
+
+	status = rsa_mbedtls_init_with_key_cache (&engine, NULL, prepared);
+	CuAssertIntEquals (test, RSA_ENGINE_INVALID_ARGUMENT, status);
+
+	status = rsa_mbedtls_init_with_key_cache (&engine, &cache, NULL);
+	CuAssertIntEquals (test, RSA_ENGINE_INVALID_ARGUMENT, status);
+
+	status = rsa_mbedtls_init_with_key_cache (&engine, &no_entries, prepared);
+	CuAssertIntEquals (test, KEY_CACHE_INVALID_ARGUMENT, status);
+}
+
+static void rsa_mbedtls_test_sig_verify_key_cache (CuTest *test)
+{
+	struct rsa_engine_mbedtls engine;
+	struct key_cache_state cache_state;
+	struct key_cache_entry entries[2];
+	struct key_cache cache = key_cache_static_init (&cache_state, entries, 2);
+	mbedtls_rsa_context prepared[2];
+	struct key_cache_stats stats;
+	int status;
+
+	TEST_START;
+
+	status = rsa_mbedtls_init_with_key_cache (&engine, &cache, prepared);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY, RSA_SIGNATURE_TEST,
+		RSA_ENCRYPT_LEN, HASH_TYPE_SHA256, SIG_HASH_TEST, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY, RSA_SHA384_SIGNATURE_TEST,
+		RSA_ENCRYPT_LEN, HASH_TYPE_SHA384, SHA384_TEST_HASH, SHA384_HASH_LENGTH);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY, RSA_SIGNATURE_TEST,
+		RSA_ENCRYPT_LEN, HASH_TYPE_SHA256, SIG_HASH_TEST, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = key_cache_get_stats (&cache, &stats);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 2, stats.hits);
+	CuAssertIntEquals (test, 1, stats.misses);
+	CuAssertIntEquals (test, 0, stats.evictions);
+
+	rsa_mbedtls_release (&engine);
+}
+
+static void rsa_mbedtls_test_sig_verify_key_cache_multiple_keys (CuTest *test)
+{
+	struct rsa_engine_mbedtls engine;
+	struct key_cache_state cache_state;
+	struct key_cache_entry entries[2];
+	struct key_cache cache = key_cache_static_init (&cache_state, entries, 2);
+	mbedtls_rsa_context prepared[2];
+	struct key_cache_stats stats;
+	int status;
+
+	TEST_START;
+
+	status = rsa_mbedtls_init_with_key_cache (&engine, &cache, prepared);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY, RSA_SIGNATURE_TEST,
+		RSA_ENCRYPT_LEN, HASH_TYPE_SHA256, SIG_HASH_TEST, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY2, RSA_SIGNATURE2_TEST,
+		RSA_ENCRYPT_LEN, HASH_TYPE_SHA256, SIG_HASH_TEST, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	/* A signature from one key must not verify using the other cached key. */
+	status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY, RSA_SIGNATURE2_TEST,
+		RSA_ENCRYPT_LEN, HASH_TYPE_SHA256, SIG_HASH_TEST, SIG_HASH_LEN);
+	CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
+
+	status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY2, RSA_SIGNATURE2_TEST,
+		RSA_ENCRYPT_LEN, HASH_TYPE_SHA256, SIG_HASH_TEST, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = key_cache_get_stats (&cache, &stats);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 2, stats.hits);
+	CuAssertIntEquals (test, 2, stats.misses);
+	CuAssertIntEquals (test, 0, stats.evictions);
+
+	rsa_mbedtls_release (&engine);
+}
+
+static void rsa_mbedtls_test_sig_verify_key_cache_eviction (CuTest *test)
+{
+	struct rsa_engine_mbedtls engine;
+	struct key_cache_state cache_state;
+	struct key_cache_entry entries[1];
+	struct key_cache cache = key_cache_static_init (&cache_state, entries, 1);
+	mbedtls_rsa_context prepared[1];
+	struct key_cache_stats stats;
+	int status;
+
+	TEST_START;
+
+	status = rsa_mbedtls_init_with_key_cache (&engine, &cache, prepared);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY, RSA_SIGNATURE_TEST,
+		RSA_ENCRYPT_LEN, HASH_TYPE_SHA256, SIG_HASH_TEST, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY2, RSA_SIGNATURE2_TEST,
+		RSA_ENCRYPT_LEN, HASH_TYPE_SHA256, SIG_HASH_TEST, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY, RSA_SIGNATURE_TEST,
+		RSA_ENCRYPT_LEN, HASH_TYPE_SHA256, SIG_HASH_TEST, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = key_cache_get_stats (&cache, &stats);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 0, stats.hits);
+	CuAssertIntEquals (test, 3, stats.misses);
+	CuAssertIntEquals (test, 2, stats.evictions);
+
+	rsa_mbedtls_release (&engine);
+}
+
+static void rsa_mbedtls_test_sig_verify_key_cache_bad_signature (CuTest *test)
+{
+	struct rsa_engine_mbedtls engine;
+	struct key_cache_state cache_state;
+	struct key_cache_entry entries[2];
+	struct key_cache cache = key_cache_static_init (&cache_state, entries, 2);
+	mbedtls_rsa_context prepared[2];
+	int status;
+
+	TEST_START;
+
+	status = rsa_mbedtls_init_with_key_cache (&engine, &cache, prepared);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY, RSA_ENCRYPT_BAD,
+		RSA_ENCRYPT_LEN, HASH_TYPE_SHA256, SIG_HASH_TEST, SIG_HASH_LEN);
+	CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
+
+	/* The key stays in the cache for the next verification. */
+	status = engine.base.sig_verify (&engine.base, &RSA_PUBLIC_KEY, RSA_SIGNATURE_TEST,
+		RSA_ENCRYPT_LEN, HASH_TYPE_SHA256, SIG_HASH_TEST, SIG_HASH_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 1, cache_state.stats.hits);
+
+	rsa_mbedtls_release (&engine);
+}
+
 static void rsa_mbedtls_test_init_private_key (CuTest *test)
 {
 	struct rsa_engine_mbedtls engine;
@@ -1099,6 +1295,12 @@ TEST (rsa_mbedtls_test_sig_verify_no_match_sha512);
 TEST (rsa_mbedtls_test_sig_verify_wrong_length);
 TEST (rsa_mbedtls_test_sig_verify_bad_signature);
 TEST (rsa_mbedtls_test_sig_verify_bad_signature_wrong_hash);
+TEST (rsa_mbedtls_test_init_with_key_cache);
+TEST (rsa_mbedtls_test_init_with_key_cache_null);
+TEST (rsa_mbedtls_test_sig_verify_key_cache);
+TEST (rsa_mbedtls_test_sig_verify_key_cache_multiple_keys);
+TEST (rsa_mbedtls_test_sig_verify_key_cache_eviction);
+TEST (rsa_mbedtls_test_sig_verify_key_cache_bad_signature);
 TEST (rsa_mbedtls_test_init_private_key);
 TEST (rsa_mbedtls_test_init_private_key_null);
 TEST (rsa_mbedtls_test_init_private_key_with_public_key);
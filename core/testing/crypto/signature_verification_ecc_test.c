@@ -7,7 +7,9 @@
 #include "testing.h"
 #include "crypto/signature_verification_ecc.h"
 #include "crypto/signature_verification_ecc_static.h"
+#include "crypto/key_cache_static.h"
 #include "testing/mock/crypto/ecc_mock.h"
+#include "testing/mock/crypto/hash_mock.h"
 #include "testing/engines/ecc_testing_engine.h"
 #include "testing/crypto/ecc_testing.h"
 #include "testing/crypto/signature_testing.h"
@@ -1098,6 +1100,682 @@ static void signature_verification_ecc_test_is_key_valid_private_key_error (CuTe
 }
 
 
+static void signature_verification_ecc_test_init_with_key_cache (CuTest *test)
+{
+	struct ecc_engine_mock ecc;
+	struct hash_engine_mock hash;
+	struct key_cache_state cache_state;
+	struct key_cache_entry entries[2];
+	struct key_cache cache = key_cache_static_init (&cache_state, entries, 2);
+	struct ecc_public_key keys[2];
+	struct signature_verification_ecc_state state;
+	struct signature_verification_ecc verification;
+	int status;
+
+	TEST_START;
+
+	status = ecc_mock_init (&ecc);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_ecc_init_with_key_cache (&verification, &state, &ecc.base,
+		&cache, keys, &hash.base, NULL, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrNotNull (test, verification.base.verify_signature);
+	CuAssertPtrNotNull (test, verification.base.set_verification_key);
+	CuAssertPtrNotNull (test, verification.base.is_key_valid);
+
+	status = verification.base.verify_signature (&verification.base, SIG_HASH_TEST, SIG_HASH_LEN,
+		ECC_SIGNATURE_TEST, ECC_SIG_TEST_LEN);
+	CuAssertIntEquals (test, SIG_VERIFICATION_NO_KEY, status);
+
+	status = ecc_mock_validate_and_release (&ecc);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	signature_verification_ecc_release (&verification);
+}
+
+static void signature_verification_ecc_test_init_with_key_cache_null (CuTest *test)
+{
+	struct ecc_engine_mock ecc;
+	struct hash_engine_mock hash;
+	struct key_cache_state cache_state;
+	struct key_cache_entry entries[2];
+	struct key_cache cache = key_cache_static_init (&cache_state, entries, 2);
+	struct key_cache no_entries = key_cache_static_init (&cache_state, entries, 0);
+	struct ecc_public_key keys[2];
+	struct signature_verification_ecc_state state;
+	struct signature_verification_ecc verification;
+	int status;
+
+	TEST_START;
+
+	status = ecc_mock_init (&ecc);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_ecc_init_with_key_cache (NULL, &state, &ecc.base, &cache, keys,
+		&hash.base, NULL, 0);
+	CuAssertIntEquals (test, SIG_VERIFICATION_INVALID_ARGUMENT, status);
+
+	status = signature_verification_ecc_init_with_key_cache (&verification, NULL, &ecc.base,
+		&cache, keys, &hash.base, NULL, 0);
+	CuAssertIntEquals (test, SIG_VERIFICATION_INVALID_ARGUMENT, status);
+
+	status = signature_verification_ecc_init_with_key_cache (&verification, &state, NULL, &cache,
+		keys, &hash.base, NULL, 0);
+	CuAssertIntEquals (test, SIG_VERIFICATION_INVALID_ARGUMENT, status);
+
+	status = signature_verification_ecc_init_with_key_cache (&verification, &state, &ecc.base,
+		NULL, keys, &hash.base, NULL, 0);
+	CuAssertIntEquals (test, SIG_VERIFICATION_INVALID_ARGUMENT, status);
+
+	status = signature_verification_ecc_init_with_key_cache (&verification, &state, &ecc.base,
+		&cache, NULL, &hash.base, NULL, 0);
+	CuAssertIntEquals (test, SIG_VERIFICATION_INVALID_ARGUMENT, status);
+
+	status = signature_verification_ecc_init_with_key_cache (&verification, &state, &ecc.base,
+		&cache, keys, NULL, NULL, 0);
+	CuAssertIntEquals (test, SIG_VERIFICATION_INVALID_ARGUMENT, status);
+
+	status = signature_verification_ecc_init_with_key_cache (&verification, &state, &ecc.base,
+		&no_entries, keys, &hash.base, NULL, 0);
+	CuAssertIntEquals (test, KEY_CACHE_INVALID_ARGUMENT, status);
+
+	status = ecc_mock_validate_and_release (&ecc);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void signature_verification_ecc_test_static_init_with_key_cache (CuTest *test)
+{
+	struct ecc_engine_mock ecc;
+	struct hash_engine_mock hash;
+	struct key_cache_state cache_state;
+	struct key_cache_entry entries[2];
+	struct key_cache cache = key_cache_static_init (&cache_state, entries, 2);
+	struct ecc_public_key keys[2];
+	struct signature_verification_ecc_state state;
+	struct signature_verification_ecc verification =
+		signature_verification_ecc_static_init_with_key_cache (&state, &ecc.base, &cache, keys,
+		&hash.base);
+	struct ecc_public_key pub_key = {.context = (void*) 0x1234};
+	uint8_t id[KEY_CACHE_ID_LENGTH];
+	int status;
+
+	TEST_START;
+
+	memset (id, 0x11, sizeof (id));
+
+	status = ecc_mock_init (&ecc);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&hash.mock, hash.base.calculate_sha256, &hash, 0,
+		MOCK_ARG_PTR (ECC_PUBKEY_DER), MOCK_ARG (ECC_PUBKEY_DER_LEN), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (sizeof (id)));
+	status |= mock_expect_output (&hash.mock, 2, id, sizeof (id), 3);
+
+	status |= mock_expect (&ecc.mock, ecc.base.init_public_key, &ecc, 0,
+		MOCK_ARG_PTR (ECC_PUBKEY_DER), MOCK_ARG (ECC_PUBKEY_DER_LEN), MOCK_ARG_PTR (&keys[0]));
+	status |= mock_expect_output (&ecc.mock, 2, &pub_key, sizeof (pub_key), -1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_ecc_init_state (&verification, ECC_PUBKEY_DER,
+		ECC_PUBKEY_DER_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrEquals (test, pub_key.context, state.key.context);
+
+	status = mock_validate (&ecc.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&ecc.mock, ecc.base.release_key_pair, &ecc, 0, MOCK_ARG_PTR (NULL),
+		MOCK_ARG_PTR (&keys[0]));
+	CuAssertIntEquals (test, 0, status);
+
+	signature_verification_ecc_release (&verification);
+
+	status = ecc_mock_validate_and_release (&ecc);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void signature_verification_ecc_test_static_init_with_key_cache_null (CuTest *test)
+{
+	struct ecc_engine_mock ecc;
+	struct hash_engine_mock hash;
+	struct key_cache_state cache_state;
+	struct key_cache_entry entries[2];
+	struct key_cache cache = key_cache_static_init (&cache_state, entries, 2);
+	struct ecc_public_key keys[2];
+	struct signature_verification_ecc_state state;
+	struct signature_verification_ecc null_keys =
+		signature_verification_ecc_static_init_with_key_cache (&state, &ecc.base, &cache, NULL,
+		&hash.base);
+	struct signature_verification_ecc null_hash =
+		signature_verification_ecc_static_init_with_key_cache (&state, &ecc.base, &cache, keys,
+		NULL);
+	int status;
+
+	TEST_START;
+
+	status = ecc_mock_init (&ecc);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_ecc_init_state (&null_keys, NULL, 0);
+	CuAssertIntEquals (test, SIG_VERIFICATION_INVALID_ARGUMENT, status);
+
+	status = signature_verification_ecc_init_state (&null_hash, NULL, 0);
+	CuAssertIntEquals (test, SIG_VERIFICATION_INVALID_ARGUMENT, status);
+
+	status = ecc_mock_validate_and_release (&ecc);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void signature_verification_ecc_test_set_verification_key_key_cache (CuTest *test)
+{
+	struct ecc_engine_mock ecc;
+	struct hash_engine_mock hash;
+	struct key_cache_state cache_state;
+	struct key_cache_entry entries[2];
+	struct key_cache cache = key_cache_static_init (&cache_state, entries, 2);
+	struct ecc_public_key keys[2];
+	struct signature_verification_ecc_state state;
+	struct signature_verification_ecc verification;
+	struct ecc_public_key pub_key = {.context = (void*) 0x1234};
+	uint8_t id[KEY_CACHE_ID_LENGTH];
+	int status;
+
+	TEST_START;
+
+	memset (id, 0x11, sizeof (id));
+
+	status = ecc_mock_init (&ecc);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_ecc_init_with_key_cache (&verification, &state, &ecc.base,
+		&cache, keys, &hash.base, NULL, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	/* First use of the key loads it into the cache. */
+	status = mock_expect (&hash.mock, hash.base.calculate_sha256, &hash, 0,
+		MOCK_ARG_PTR (ECC_PUBKEY_DER), MOCK_ARG (ECC_PUBKEY_DER_LEN), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (sizeof (id)));
+	status |= mock_expect_output (&hash.mock, 2, id, sizeof (id), 3);
+
+	status |= mock_expect (&ecc.mock, ecc.base.init_public_key, &ecc, 0,
+		MOCK_ARG_PTR (ECC_PUBKEY_DER), MOCK_ARG (ECC_PUBKEY_DER_LEN), MOCK_ARG_PTR (&keys[0]));
+	status |= mock_expect_output (&ecc.mock, 2, &pub_key, sizeof (pub_key), -1);
+
+	status |= mock_expect (&ecc.mock, ecc.base.verify, &ecc, 0, MOCK_ARG_PTR (&state.key),
+		MOCK_ARG_PTR (SIG_HASH_TEST), MOCK_ARG (SIG_HASH_LEN), MOCK_ARG_PTR (ECC_SIGNATURE_TEST),
+		MOCK_ARG (ECC_SIG_TEST_LEN));
+
+	/* Setting the same key again only needs to identify the key. */
+	status |= mock_expect (&hash.mock, hash.base.calculate_sha256, &hash, 0,
+		MOCK_ARG_PTR (ECC_PUBKEY_DER), MOCK_ARG (ECC_PUBKEY_DER_LEN), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (sizeof (id)));
+	status |= mock_expect_output (&hash.mock, 2, id, sizeof (id), 3);
+
+	status |= mock_expect (&ecc.mock, ecc.base.verify, &ecc, 0, MOCK_ARG_PTR (&state.key),
+		MOCK_ARG_PTR (SIG_HASH_TEST), MOCK_ARG (SIG_HASH_LEN), MOCK_ARG_PTR (ECC_SIGNATURE_TEST),
+		MOCK_ARG (ECC_SIG_TEST_LEN));
+	CuAssertIntEquals (test, 0, status);
+
+	status = verification.base.set_verification_key (&verification.base, ECC_PUBKEY_DER,
+		ECC_PUBKEY_DER_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = verification.base.verify_signature (&verification.base, SIG_HASH_TEST, SIG_HASH_LEN,
+		ECC_SIGNATURE_TEST, ECC_SIG_TEST_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = verification.base.set_verification_key (&verification.base, ECC_PUBKEY_DER,
+		ECC_PUBKEY_DER_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrEquals (test, pub_key.context, state.key.context);
+
+	status = verification.base.verify_signature (&verification.base, SIG_HASH_TEST, SIG_HASH_LEN,
+		ECC_SIGNATURE_TEST, ECC_SIG_TEST_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 1, cache_state.stats.hits);
+	CuAssertIntEquals (test, 1, cache_state.stats.misses);
+
+	status = mock_validate (&ecc.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Clearing the key does not release the cached key. */
+	status = verification.base.set_verification_key (&verification.base, NULL, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&ecc.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&ecc.mock, ecc.base.release_key_pair, &ecc, 0, MOCK_ARG_PTR (NULL),
+		MOCK_ARG_PTR (&keys[0]));
+	CuAssertIntEquals (test, 0, status);
+
+	signature_verification_ecc_release (&verification);
+
+	status = ecc_mock_validate_and_release (&ecc);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void signature_verification_ecc_test_set_verification_key_key_cache_change_key (
+	CuTest *test)
+{
+	struct ecc_engine_mock ecc;
+	struct hash_engine_mock hash;
+	struct key_cache_state cache_state;
+	struct key_cache_entry entries[2];
+	struct key_cache cache = key_cache_static_init (&cache_state, entries, 2);
+	struct ecc_public_key keys[2];
+	struct signature_verification_ecc_state state;
+	struct signature_verification_ecc verification;
+	struct ecc_public_key pub_key1 = {.context = (void*) 0x1234};
+	struct ecc_public_key pub_key2 = {.context = (void*) 0x5678};
+	uint8_t id1[KEY_CACHE_ID_LENGTH];
+	uint8_t id2[KEY_CACHE_ID_LENGTH];
+	int status;
+
+	TEST_START;
+
+	memset (id1, 0x11, sizeof (id1));
+	memset (id2, 0x22, sizeof (id2));
+
+	status = ecc_mock_init (&ecc);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&hash.mock, hash.base.calculate_sha256, &hash, 0,
+		MOCK_ARG_PTR (ECC_PUBKEY_DER), MOCK_ARG (ECC_PUBKEY_DER_LEN), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (sizeof (id1)));
+	status |= mock_expect_output (&hash.mock, 2, id1, sizeof (id1), 3);
+
+	status |= mock_expect (&ecc.mock, ecc.base.init_public_key, &ecc, 0,
+		MOCK_ARG_PTR (ECC_PUBKEY_DER), MOCK_ARG (ECC_PUBKEY_DER_LEN), MOCK_ARG_PTR (&keys[0]));
+	status |= mock_expect_output (&ecc.mock, 2, &pub_key1, sizeof (pub_key1), -1);
+
+	status |= mock_expect (&hash.mock, hash.base.calculate_sha256, &hash, 0,
+		MOCK_ARG_PTR (ECC_PUBKEY2_DER), MOCK_ARG (ECC_PUBKEY2_DER_LEN), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (sizeof (id2)));
+	status |= mock_expect_output (&hash.mock, 2, id2, sizeof (id2), 3);
+
+	status |= mock_expect (&ecc.mock, ecc.base.init_public_key, &ecc, 0,
+		MOCK_ARG_PTR (ECC_PUBKEY2_DER), MOCK_ARG (ECC_PUBKEY2_DER_LEN), MOCK_ARG_PTR (&keys[1]));
+	status |= mock_expect_output (&ecc.mock, 2, &pub_key2, sizeof (pub_key2), -1);
+
+	status |= mock_expect (&hash.mock, hash.base.calculate_sha256, &hash, 0,
+		MOCK_ARG_PTR (ECC_PUBKEY_DER), MOCK_ARG (ECC_PUBKEY_DER_LEN), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (sizeof (id1)));
+	status |= mock_expect_output (&hash.mock, 2, id1, sizeof (id1), 3);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_ecc_init_with_key_cache (&verification, &state, &ecc.base,
+		&cache, keys, &hash.base, ECC_PUBKEY_DER, ECC_PUBKEY_DER_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrEquals (test, pub_key1.context, state.key.context);
+
+	status = verification.base.set_verification_key (&verification.base, ECC_PUBKEY2_DER,
+		ECC_PUBKEY2_DER_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrEquals (test, pub_key2.context, state.key.context);
+
+	status = verification.base.set_verification_key (&verification.base, ECC_PUBKEY_DER,
+		ECC_PUBKEY_DER_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrEquals (test, pub_key1.context, state.key.context);
+
+	status = mock_validate (&ecc.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&ecc.mock, ecc.base.release_key_pair, &ecc, 0, MOCK_ARG_PTR (NULL),
+		MOCK_ARG_PTR (&keys[0]));
+	status |= mock_expect (&ecc.mock, ecc.base.release_key_pair, &ecc, 0, MOCK_ARG_PTR (NULL),
+		MOCK_ARG_PTR (&keys[1]));
+	CuAssertIntEquals (test, 0, status);
+
+	signature_verification_ecc_release (&verification);
+
+	status = ecc_mock_validate_and_release (&ecc);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void signature_verification_ecc_test_set_verification_key_key_cache_eviction (
+	CuTest *test)
+{
+	struct ecc_engine_mock ecc;
+	struct hash_engine_mock hash;
+	struct key_cache_state cache_state;
+	struct key_cache_entry entries[1];
+	struct key_cache cache = key_cache_static_init (&cache_state, entries, 1);
+	struct ecc_public_key keys[1];
+	struct signature_verification_ecc_state state;
+	struct signature_verification_ecc verification;
+	struct ecc_public_key pub_key1 = {.context = (void*) 0x1234};
+	struct ecc_public_key pub_key2 = {.context = (void*) 0x5678};
+	uint8_t id1[KEY_CACHE_ID_LENGTH];
+	uint8_t id2[KEY_CACHE_ID_LENGTH];
+	int status;
+
+	TEST_START;
+
+	memset (id1, 0x11, sizeof (id1));
+	memset (id2, 0x22, sizeof (id2));
+
+	status = ecc_mock_init (&ecc);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&hash.mock, hash.base.calculate_sha256, &hash, 0,
+		MOCK_ARG_PTR (ECC_PUBKEY_DER), MOCK_ARG (ECC_PUBKEY_DER_LEN), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (sizeof (id1)));
+	status |= mock_expect_output (&hash.mock, 2, id1, sizeof (id1), 3);
+
+	status |= mock_expect (&ecc.mock, ecc.base.init_public_key, &ecc, 0,
+		MOCK_ARG_PTR (ECC_PUBKEY_DER), MOCK_ARG (ECC_PUBKEY_DER_LEN), MOCK_ARG_PTR (&keys[0]));
+	status |= mock_expect_output (&ecc.mock, 2, &pub_key1, sizeof (pub_key1), -1);
+
+	status |= mock_expect (&hash.mock, hash.base.calculate_sha256, &hash, 0,
+		MOCK_ARG_PTR (ECC_PUBKEY2_DER), MOCK_ARG (ECC_PUBKEY2_DER_LEN), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (sizeof (id2)));
+	status |= mock_expect_output (&hash.mock, 2, id2, sizeof (id2), 3);
+
+	status |= mock_expect (&ecc.mock, ecc.base.release_key_pair, &ecc, 0, MOCK_ARG_PTR (NULL),
+		MOCK_ARG_PTR (&keys[0]));
+
+	status |= mock_expect (&ecc.mock, ecc.base.init_public_key, &ecc, 0,
+		MOCK_ARG_PTR (ECC_PUBKEY2_DER), MOCK_ARG (ECC_PUBKEY2_DER_LEN), MOCK_ARG_PTR (&keys[0]));
+	status |= mock_expect_output (&ecc.mock, 2, &pub_key2, sizeof (pub_key2), -1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_ecc_init_with_key_cache (&verification, &state, &ecc.base,
+		&cache, keys, &hash.base, ECC_PUBKEY_DER, ECC_PUBKEY_DER_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = verification.base.set_verification_key (&verification.base, ECC_PUBKEY2_DER,
+		ECC_PUBKEY2_DER_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrEquals (test, pub_key2.context, state.key.context);
+	CuAssertIntEquals (test, 1, cache_state.stats.evictions);
+
+	status = mock_validate (&ecc.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&ecc.mock, ecc.base.release_key_pair, &ecc, 0, MOCK_ARG_PTR (NULL),
+		MOCK_ARG_PTR (&keys[0]));
+	CuAssertIntEquals (test, 0, status);
+
+	signature_verification_ecc_release (&verification);
+
+	status = ecc_mock_validate_and_release (&ecc);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void signature_verification_ecc_test_set_verification_key_key_cache_load_error (
+	CuTest *test)
+{
+	struct ecc_engine_mock ecc;
+	struct hash_engine_mock hash;
+	struct key_cache_state cache_state;
+	struct key_cache_entry entries[2];
+	struct key_cache cache = key_cache_static_init (&cache_state, entries, 2);
+	struct ecc_public_key keys[2];
+	struct signature_verification_ecc_state state;
+	struct signature_verification_ecc verification;
+	uint8_t id[KEY_CACHE_ID_LENGTH];
+	int status;
+
+	TEST_START;
+
+	memset (id, 0x11, sizeof (id));
+
+	status = ecc_mock_init (&ecc);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_ecc_init_with_key_cache (&verification, &state, &ecc.base,
+		&cache, keys, &hash.base, NULL, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&hash.mock, hash.base.calculate_sha256, &hash, 0,
+		MOCK_ARG_PTR (RSA_PUBKEY_DER), MOCK_ARG (RSA_PUBKEY_DER_LEN), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (sizeof (id)));
+	status |= mock_expect_output (&hash.mock, 2, id, sizeof (id), 3);
+
+	status |= mock_expect (&ecc.mock, ecc.base.init_public_key, &ecc, ECC_ENGINE_NOT_EC_KEY,
+		MOCK_ARG_PTR (RSA_PUBKEY_DER), MOCK_ARG (RSA_PUBKEY_DER_LEN), MOCK_ARG_PTR (&keys[0]));
+	CuAssertIntEquals (test, 0, status);
+
+	status = verification.base.set_verification_key (&verification.base, RSA_PUBKEY_DER,
+		RSA_PUBKEY_DER_LEN);
+	CuAssertIntEquals (test, SIG_VERIFICATION_INVALID_KEY, status);
+
+	CuAssertIntEquals (test, false, key_cache_is_entry_valid (&cache, 0));
+
+	status = verification.base.verify_signature (&verification.base, SIG_HASH_TEST, SIG_HASH_LEN,
+		ECC_SIGNATURE_TEST, ECC_SIG_TEST_LEN);
+	CuAssertIntEquals (test, SIG_VERIFICATION_NO_KEY, status);
+
+	signature_verification_ecc_release (&verification);
+
+	status = ecc_mock_validate_and_release (&ecc);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void signature_verification_ecc_test_set_verification_key_key_cache_hash_error (
+	CuTest *test)
+{
+	struct ecc_engine_mock ecc;
+	struct hash_engine_mock hash;
+	struct key_cache_state cache_state;
+	struct key_cache_entry entries[2];
+	struct key_cache cache = key_cache_static_init (&cache_state, entries, 2);
+	struct ecc_public_key keys[2];
+	struct signature_verification_ecc_state state;
+	struct signature_verification_ecc verification;
+	int status;
+
+	TEST_START;
+
+	status = ecc_mock_init (&ecc);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_ecc_init_with_key_cache (&verification, &state, &ecc.base,
+		&cache, keys, &hash.base, NULL, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&hash.mock, hash.base.calculate_sha256, &hash, HASH_ENGINE_SHA256_FAILED,
+		MOCK_ARG_PTR (ECC_PUBKEY_DER), MOCK_ARG (ECC_PUBKEY_DER_LEN), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (KEY_CACHE_ID_LENGTH));
+	CuAssertIntEquals (test, 0, status);
+
+	status = verification.base.set_verification_key (&verification.base, ECC_PUBKEY_DER,
+		ECC_PUBKEY_DER_LEN);
+	CuAssertIntEquals (test, HASH_ENGINE_SHA256_FAILED, status);
+
+	status = verification.base.verify_signature (&verification.base, SIG_HASH_TEST, SIG_HASH_LEN,
+		ECC_SIGNATURE_TEST, ECC_SIG_TEST_LEN);
+	CuAssertIntEquals (test, SIG_VERIFICATION_NO_KEY, status);
+
+	signature_verification_ecc_release (&verification);
+
+	status = ecc_mock_validate_and_release (&ecc);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void signature_verification_ecc_test_is_key_valid_key_cache (CuTest *test)
+{
+	struct ecc_engine_mock ecc;
+	struct hash_engine_mock hash;
+	struct key_cache_state cache_state;
+	struct key_cache_entry entries[2];
+	struct key_cache cache = key_cache_static_init (&cache_state, entries, 2);
+	struct ecc_public_key keys[2];
+	struct signature_verification_ecc_state state;
+	struct signature_verification_ecc verification;
+	struct ecc_public_key pub_key = {.context = (void*) 0x1234};
+	uint8_t id[KEY_CACHE_ID_LENGTH];
+	int status;
+
+	TEST_START;
+
+	memset (id, 0x11, sizeof (id));
+
+	status = ecc_mock_init (&ecc);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&hash.mock, hash.base.calculate_sha256, &hash, 0,
+		MOCK_ARG_PTR (ECC_PUBKEY_DER), MOCK_ARG (ECC_PUBKEY_DER_LEN), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (sizeof (id)));
+	status |= mock_expect_output (&hash.mock, 2, id, sizeof (id), 3);
+
+	status |= mock_expect (&ecc.mock, ecc.base.init_public_key, &ecc, 0,
+		MOCK_ARG_PTR (ECC_PUBKEY_DER), MOCK_ARG (ECC_PUBKEY_DER_LEN), MOCK_ARG_PTR (&keys[0]));
+	status |= mock_expect_output (&ecc.mock, 2, &pub_key, sizeof (pub_key), -1);
+
+	/* A cached key is known to be valid without loading it again. */
+	status |= mock_expect (&hash.mock, hash.base.calculate_sha256, &hash, 0,
+		MOCK_ARG_PTR (ECC_PUBKEY_DER), MOCK_ARG (ECC_PUBKEY_DER_LEN), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (sizeof (id)));
+	status |= mock_expect_output (&hash.mock, 2, id, sizeof (id), 3);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_ecc_init_with_key_cache (&verification, &state, &ecc.base,
+		&cache, keys, &hash.base, ECC_PUBKEY_DER, ECC_PUBKEY_DER_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = verification.base.is_key_valid (&verification.base, ECC_PUBKEY_DER,
+		ECC_PUBKEY_DER_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&ecc.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&ecc.mock, ecc.base.release_key_pair, &ecc, 0, MOCK_ARG_PTR (NULL),
+		MOCK_ARG_PTR (&keys[0]));
+	CuAssertIntEquals (test, 0, status);
+
+	signature_verification_ecc_release (&verification);
+
+	status = ecc_mock_validate_and_release (&ecc);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void signature_verification_ecc_test_is_key_valid_key_cache_not_cached (CuTest *test)
+{
+	struct ecc_engine_mock ecc;
+	struct hash_engine_mock hash;
+	struct key_cache_state cache_state;
+	struct key_cache_entry entries[2];
+	struct key_cache cache = key_cache_static_init (&cache_state, entries, 2);
+	struct ecc_public_key keys[2];
+	struct signature_verification_ecc_state state;
+	struct signature_verification_ecc verification;
+	uint8_t id[KEY_CACHE_ID_LENGTH];
+	int status;
+
+	TEST_START;
+
+	memset (id, 0x11, sizeof (id));
+
+	status = ecc_mock_init (&ecc);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = signature_verification_ecc_init_with_key_cache (&verification, &state, &ecc.base,
+		&cache, keys, &hash.base, NULL, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&hash.mock, hash.base.calculate_sha256, &hash, 0,
+		MOCK_ARG_PTR (ECC_PUBKEY_DER), MOCK_ARG (ECC_PUBKEY_DER_LEN), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (sizeof (id)));
+	status |= mock_expect_output (&hash.mock, 2, id, sizeof (id), 3);
+
+	status |= mock_expect (&ecc.mock, ecc.base.init_public_key, &ecc, 0,
+		MOCK_ARG_PTR (ECC_PUBKEY_DER), MOCK_ARG (ECC_PUBKEY_DER_LEN), MOCK_ARG_NOT_NULL);
+	status |= mock_expect (&ecc.mock, ecc.base.release_key_pair, &ecc, 0, MOCK_ARG_PTR (NULL),
+		MOCK_ARG_NOT_NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	status = verification.base.is_key_valid (&verification.base, ECC_PUBKEY_DER,
+		ECC_PUBKEY_DER_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Checking a key does not add it to the cache. */
+	CuAssertIntEquals (test, false, key_cache_is_entry_valid (&cache, 0));
+
+	signature_verification_ecc_release (&verification);
+
+	status = ecc_mock_validate_and_release (&ecc);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+}
+
 TEST_SUITE_START (signature_verification_ecc);
 
 TEST (signature_verification_ecc_test_init_api);
@@ -1137,5 +1815,16 @@ TEST (signature_verification_ecc_test_is_key_valid_static_init);
 TEST (signature_verification_ecc_test_is_key_valid_null);
 TEST (signature_verification_ecc_test_is_key_valid_not_ecc_key);
 TEST (signature_verification_ecc_test_is_key_valid_private_key_error);
+TEST (signature_verification_ecc_test_init_with_key_cache);
+TEST (signature_verification_ecc_test_init_with_key_cache_null);
+TEST (signature_verification_ecc_test_static_init_with_key_cache);
+TEST (signature_verification_ecc_test_static_init_with_key_cache_null);
+TEST (signature_verification_ecc_test_set_verification_key_key_cache);
+TEST (signature_verification_ecc_test_set_verification_key_key_cache_change_key);
+TEST (signature_verification_ecc_test_set_verification_key_key_cache_eviction);
+TEST (signature_verification_ecc_test_set_verification_key_key_cache_load_error);
+TEST (signature_verification_ecc_test_set_verification_key_key_cache_hash_error);
+TEST (signature_verification_ecc_test_is_key_valid_key_cache);
+TEST (signature_verification_ecc_test_is_key_valid_key_cache_not_cached);
 
 TEST_SUITE_END;
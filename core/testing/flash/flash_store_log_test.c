@@ -0,0 +1,1355 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "testing.h"
+#include "flash/flash_store_log.h"
+#include "flash/flash_store_log_static.h"
+#include "flash/flash_virtual_ram.h"
+#include "testing/engines/hash_testing_engine.h"
+
+
+TEST_SUITE_LABEL ("flash_store_log");
+
+
+/**
+ * Size of the virtual flash device used for testing.
+ */
+#define	FLASH_STORE_LOG_TESTING_FLASH_SIZE		(VIRTUAL_FLASH_BLOCK_SIZE * 8)
+
+/**
+ * Base address of the log on the virtual flash device.
+ */
+#define	FLASH_STORE_LOG_TESTING_BASE_ADDR		(VIRTUAL_FLASH_BLOCK_SIZE * 2)
+
+/**
+ * Number of sectors used for the log.
+ */
+#define	FLASH_STORE_LOG_TESTING_SECTORS			4
+
+/**
+ * Number of data blocks in the log.
+ */
+#define	FLASH_STORE_LOG_TESTING_BLOCKS			4
+
+/**
+ * Maximum length of each data block.
+ */
+#define	FLASH_STORE_LOG_TESTING_MAX_LENGTH		32
+
+
+/**
+ * Dependencies for testing log-structured flash storage.
+ */
+struct flash_store_log_testing {
+	uint8_t buffer[FLASH_STORE_LOG_TESTING_FLASH_SIZE];	/**< Memory for the virtual flash. */
+	struct flash_virtual_ram_state flash_state;			/**< Context for the virtual flash. */
+	struct flash_virtual_ram flash;						/**< The flash device. */
+	HASH_TESTING_ENGINE hash;							/**< Hash engine for integrity checking. */
+	struct flash_store_log_state state;					/**< Flash storage state. */
+	struct flash_store_log_index index[FLASH_STORE_LOG_TESTING_BLOCKS];		/**< Storage for the record index. */
+	struct flash_store_log_sector sectors[FLASH_STORE_LOG_TESTING_SECTORS];	/**< Storage for sector tracking. */
+	struct flash_store_log test;						/**< Flash storage under test. */
+};
+
+
+/**
+ * Helper to initialize all dependencies for testing.
+ *
+ * @param test The test framework.
+ * @param store Testing dependencies to initialize.
+ */
+static void flash_store_log_testing_init_dependencies (CuTest *test,
+	struct flash_store_log_testing *store)
+{
+	int status;
+
+	memset (store->buffer, 0xff, sizeof (store->buffer));
+
+	status = flash_virtual_ram_init (&store->flash, &store->flash_state, store->buffer,
+		sizeof (store->buffer));
+	CuAssertIntEquals (test, 0, status);
+
+	status = HASH_TESTING_ENGINE_INIT (&store->hash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Helper to release all testing dependencies.
+ *
+ * @param test The test framework.
+ * @param store Testing dependencies to release.
+ */
+static void flash_store_log_testing_release_dependencies (CuTest *test,
+	struct flash_store_log_testing *store)
+{
+	flash_virtual_ram_release (&store->flash);
+	HASH_TESTING_ENGINE_RELEASE (&store->hash);
+}
+
+/**
+ * Helper to initialize log storage for testing.
+ *
+ * @param test The test framework.
+ * @param store Testing components to initialize.
+ * @param use_hash Flag to enable integrity checking.
+ */
+static void flash_store_log_testing_init (CuTest *test, struct flash_store_log_testing *store,
+	bool use_hash)
+{
+	int status;
+
+	flash_store_log_testing_init_dependencies (test, store);
+
+	status = flash_store_log_init (&store->test, &store->state, store->index, store->sectors,
+		&store->flash.base, FLASH_STORE_LOG_TESTING_BASE_ADDR, FLASH_STORE_LOG_TESTING_SECTORS,
+		FLASH_STORE_LOG_TESTING_BLOCKS, FLASH_STORE_LOG_TESTING_MAX_LENGTH,
+		(use_hash) ? &store->hash.base : NULL);
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Helper to release log storage and testing dependencies.
+ *
+ * @param test The test framework.
+ * @param store Testing components to release.
+ */
+static void flash_store_log_testing_release (CuTest *test, struct flash_store_log_testing *store)
+{
+	flash_store_log_release (&store->test);
+	flash_store_log_testing_release_dependencies (test, store);
+}
+
+/**
+ * Helper to reload the log from flash, simulating a device reset.
+ *
+ * @param test The test framework.
+ * @param store Testing components to reload.
+ * @param use_hash Flag to enable integrity checking.
+ */
+static void flash_store_log_testing_remount (CuTest *test, struct flash_store_log_testing *store,
+	bool use_hash)
+{
+	int status;
+
+	flash_store_log_release (&store->test);
+
+	status = flash_store_log_init (&store->test, &store->state, store->index, store->sectors,
+		&store->flash.base, FLASH_STORE_LOG_TESTING_BASE_ADDR, FLASH_STORE_LOG_TESTING_SECTORS,
+		FLASH_STORE_LOG_TESTING_BLOCKS, FLASH_STORE_LOG_TESTING_MAX_LENGTH,
+		(use_hash) ? &store->hash.base : NULL);
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Helper to fill a buffer with a pattern unique to a write operation.
+ *
+ * @param data The buffer to fill.
+ * @param length Length of the buffer.
+ * @param seed Value to make the pattern unique.
+ */
+static void flash_store_log_testing_fill (uint8_t *data, size_t length, uint32_t seed)
+{
+	size_t i;
+
+	for (i = 0; i < length; i++) {
+		data[i] = (uint8_t) (seed + (i * 7));
+	}
+}
+
+/**
+ * Helper to read a block and check its contents.
+ *
+ * @param test The test framework.
+ * @param store The flash store to read from.
+ * @param id The block ID to read.
+ * @param expected The expected contents of the block.
+ * @param length Length of the expected data.
+ */
+static void flash_store_log_testing_check_data (CuTest *test, const struct flash_store *store,
+	int id, const uint8_t *expected, size_t length)
+{
+	uint8_t data[FLASH_STORE_LOG_TESTING_MAX_LENGTH];
+	int status;
+
+	status = store->read (store, id, data, sizeof (data));
+	CuAssertIntEquals (test, length, status);
+
+	status = testing_validate_array (expected, data, length);
+	CuAssertIntEquals (test, 0, status);
+}
+
+
+/*******************
+ * Test cases
+ *******************/
+
+static void flash_store_log_test_init (CuTest *test)
+{
+	struct flash_store_log_testing store;
+	struct flash_store_log_stats stats;
+	int status;
+
+	TEST_START;
+
+	flash_store_log_testing_init_dependencies (test, &store);
+
+	status = flash_store_log_init (&store.test, &store.state, store.index, store.sectors,
+		&store.flash.base, FLASH_STORE_LOG_TESTING_BASE_ADDR, FLASH_STORE_LOG_TESTING_SECTORS,
+		FLASH_STORE_LOG_TESTING_BLOCKS, FLASH_STORE_LOG_TESTING_MAX_LENGTH, NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrNotNull (test, store.test.base.write);
+	CuAssertPtrNotNull (test, store.test.base.read);
+	CuAssertPtrNotNull (test, store.test.base.erase);
+	CuAssertPtrNotNull (test, store.test.base.erase_all);
+	CuAssertPtrNotNull (test, store.test.base.get_data_length);
+	CuAssertPtrNotNull (test, store.test.base.has_data_stored);
+	CuAssertPtrNotNull (test, store.test.base.get_max_data_length);
+	CuAssertPtrNotNull (test, store.test.base.get_flash_size);
+	CuAssertPtrNotNull (test, store.test.base.get_num_blocks);
+
+	status = store.test.base.get_max_data_length (&store.test.base);
+	CuAssertIntEquals (test, FLASH_STORE_LOG_TESTING_MAX_LENGTH, status);
+
+	status = store.test.base.get_flash_size (&store.test.base);
+	CuAssertIntEquals (test, VIRTUAL_FLASH_BLOCK_SIZE * FLASH_STORE_LOG_TESTING_SECTORS, status);
+
+	status = store.test.base.get_num_blocks (&store.test.base);
+	CuAssertIntEquals (test, FLASH_STORE_LOG_TESTING_BLOCKS, status);
+
+	status = flash_store_log_get_stats (&store.test, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, FLASH_STORE_LOG_TESTING_SECTORS - 1, stats.free_sectors);
+	CuAssertIntEquals (test, 0, stats.sectors_collected);
+	CuAssertIntEquals (test, 0, stats.records_relocated);
+
+	/* The first sector of the log has been started. */
+	CuAssertIntEquals (test, FLASH_STORE_LOG_SECTOR_MAGIC,
+		*((uint32_t*) &store.buffer[FLASH_STORE_LOG_TESTING_BASE_ADDR + 4]));
+
+	flash_store_log_testing_release (test, &store);
+}
+
+static void flash_store_log_test_init_with_hash (CuTest *test)
+{
+	struct flash_store_log_testing store;
+	int status;
+
+	TEST_START;
+
+	flash_store_log_testing_init_dependencies (test, &store);
+
+	status = flash_store_log_init (&store.test, &store.state, store.index, store.sectors,
+		&store.flash.base, FLASH_STORE_LOG_TESTING_BASE_ADDR, FLASH_STORE_LOG_TESTING_SECTORS,
+		FLASH_STORE_LOG_TESTING_BLOCKS, FLASH_STORE_LOG_TESTING_MAX_LENGTH, &store.hash.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = store.test.base.get_max_data_length (&store.test.base);
+	CuAssertIntEquals (test, FLASH_STORE_LOG_TESTING_MAX_LENGTH, status);
+
+	status = store.test.base.get_num_blocks (&store.test.base);
+	CuAssertIntEquals (test, FLASH_STORE_LOG_TESTING_BLOCKS, status);
+
+	flash_store_log_testing_release (test, &store);
+}
+
+static void flash_store_log_test_init_null (CuTest *test)
+{
+	struct flash_store_log_testing store;
+	int status;
+
+	TEST_START;
+
+	flash_store_log_testing_init_dependencies (test, &store);
+
+	status = flash_store_log_init (NULL, &store.state, store.index, store.sectors,
+		&store.flash.base, FLASH_STORE_LOG_TESTING_BASE_ADDR, FLASH_STORE_LOG_TESTING_SECTORS,
+		FLASH_STORE_LOG_TESTING_BLOCKS, FLASH_STORE_LOG_TESTING_MAX_LENGTH, NULL);
+	CuAssertIntEquals (test, FLASH_STORE_INVALID_ARGUMENT, status);
+
+	status = flash_store_log_init (&store.test, NULL, store.index, store.sectors, &store.flash.base,
+		FLASH_STORE_LOG_TESTING_BASE_ADDR, FLASH_STORE_LOG_TESTING_SECTORS,
+		FLASH_STORE_LOG_TESTING_BLOCKS, FLASH_STORE_LOG_TESTING_MAX_LENGTH, NULL);
+	CuAssertIntEquals (test, FLASH_STORE_INVALID_ARGUMENT, status);
+
+	status = flash_store_log_init (&store.test, &store.state, NULL, store.sectors,
+		&store.flash.base, FLASH_STORE_LOG_TESTING_BASE_ADDR, FLASH_STORE_LOG_TESTING_SECTORS,
+		FLASH_STORE_LOG_TESTING_BLOCKS, FLASH_STORE_LOG_TESTING_MAX_LENGTH, NULL);
+	CuAssertIntEquals (test, FLASH_STORE_INVALID_ARGUMENT, status);
+
+	status = flash_store_log_init (&store.test, &store.state, store.index, NULL,
+		&store.flash.base, FLASH_STORE_LOG_TESTING_BASE_ADDR, FLASH_STORE_LOG_TESTING_SECTORS,
+		FLASH_STORE_LOG_TESTING_BLOCKS, FLASH_STORE_LOG_TESTING_MAX_LENGTH, NULL);
+	CuAssertIntEquals (test, FLASH_STORE_INVALID_ARGUMENT, status);
+
+	status = flash_store_log_init (&store.test, &store.state, store.index, store.sectors, NULL,
+		FLASH_STORE_LOG_TESTING_BASE_ADDR, FLASH_STORE_LOG_TESTING_SECTORS,
+		FLASH_STORE_LOG_TESTING_BLOCKS, FLASH_STORE_LOG_TESTING_MAX_LENGTH, NULL);
+	CuAssertIntEquals (test, FLASH_STORE_INVALID_ARGUMENT, status);
+
+	flash_store_log_testing_release_dependencies (test, &store);
+}
+
+static void flash_store_log_test_init_no_data (CuTest *test)
+{
+	struct flash_store_log_testing store;
+	int status;
+
+	TEST_START;
+
+	flash_store_log_testing_init_dependencies (test, &store);
+
+	status = flash_store_log_init (&store.test, &store.state, store.index, store.sectors,
+		&store.flash.base, FLASH_STORE_LOG_TESTING_BASE_ADDR, FLASH_STORE_LOG_TESTING_SECTORS, 0,
+		FLASH_STORE_LOG_TESTING_MAX_LENGTH, NULL);
+	CuAssertIntEquals (test, FLASH_STORE_NO_STORAGE, status);
+
+	status = flash_store_log_init (&store.test, &store.state, store.index, store.sectors,
+		&store.flash.base, FLASH_STORE_LOG_TESTING_BASE_ADDR, FLASH_STORE_LOG_TESTING_SECTORS,
+		FLASH_STORE_LOG_TESTING_BLOCKS, 0, NULL);
+	CuAssertIntEquals (test, FLASH_STORE_NO_STORAGE, status);
+
+	flash_store_log_testing_release_dependencies (test, &store);
+}
+
+static void flash_store_log_test_init_one_sector (CuTest *test)
+{
+	struct flash_store_log_testing store;
+	int status;
+
+	TEST_START;
+
+	flash_store_log_testing_init_dependencies (test, &store);
+
+	status = flash_store_log_init (&store.test, &store.state, store.index, store.sectors,
+		&store.flash.base, FLASH_STORE_LOG_TESTING_BASE_ADDR, 1, 1,
+		FLASH_STORE_LOG_TESTING_MAX_LENGTH, NULL);
+	CuAssertIntEquals (test, FLASH_STORE_INSUFFICIENT_STORAGE, status);
+
+	flash_store_log_testing_release_dependencies (test, &store);
+}
+
+static void flash_store_log_test_init_not_sector_aligned (CuTest *test)
+{
+	struct flash_store_log_testing store;
+	int status;
+
+	TEST_START;
+
+	flash_store_log_testing_init_dependencies (test, &store);
+
+	status = flash_store_log_init (&store.test, &store.state, store.index, store.sectors,
+		&store.flash.base, FLASH_STORE_LOG_TESTING_BASE_ADDR + 0x10,
+		FLASH_STORE_LOG_TESTING_SECTORS, FLASH_STORE_LOG_TESTING_BLOCKS,
+		FLASH_STORE_LOG_TESTING_MAX_LENGTH, NULL);
+	CuAssertIntEquals (test, FLASH_STORE_STORAGE_NOT_ALIGNED, status);
+
+	flash_store_log_testing_release_dependencies (test, &store);
+}
+
+static void flash_store_log_test_init_base_out_of_range (CuTest *test)
+{
+	struct flash_store_log_testing store;
+	int status;
+
+	TEST_START;
+
+	flash_store_log_testing_init_dependencies (test, &store);
+
+	status = flash_store_log_init (&store.test, &store.state, store.index, store.sectors,
+		&store.flash.base, FLASH_STORE_LOG_TESTING_FLASH_SIZE, FLASH_STORE_LOG_TESTING_SECTORS,
+		FLASH_STORE_LOG_TESTING_BLOCKS, FLASH_STORE_LOG_TESTING_MAX_LENGTH, NULL);
+	CuAssertIntEquals (test, FLASH_STORE_BAD_BASE_ADDRESS, status);
+
+	flash_store_log_testing_release_dependencies (test, &store);
+}
+
+static void flash_store_log_test_init_past_end_of_flash (CuTest *test)
+{
+	struct flash_store_log_testing store;
+	int status;
+
+	TEST_START;
+
+	flash_store_log_testing_init_dependencies (test, &store);
+
+	status = flash_store_log_init (&store.test, &store.state, store.index, store.sectors,
+		&store.flash.base, FLASH_STORE_LOG_TESTING_FLASH_SIZE - (VIRTUAL_FLASH_BLOCK_SIZE * 3),
+		FLASH_STORE_LOG_TESTING_SECTORS, FLASH_STORE_LOG_TESTING_BLOCKS,
+		FLASH_STORE_LOG_TESTING_MAX_LENGTH, NULL);
+	CuAssertIntEquals (test, FLASH_STORE_INSUFFICIENT_STORAGE, status);
+
+	flash_store_log_testing_release_dependencies (test, &store);
+}
+
+static void flash_store_log_test_init_block_too_large (CuTest *test)
+{
+	struct flash_store_log_testing store;
+	int status;
+
+	TEST_START;
+
+	flash_store_log_testing_init_dependencies (test, &store);
+
+	status = flash_store_log_init (&store.test, &store.state, store.index, store.sectors,
+		&store.flash.base, FLASH_STORE_LOG_TESTING_BASE_ADDR, FLASH_STORE_LOG_TESTING_SECTORS,
+		FLASH_STORE_LOG_TESTING_BLOCKS, VIRTUAL_FLASH_BLOCK_SIZE, NULL);
+	CuAssertIntEquals (test, FLASH_STORE_BLOCK_TOO_LARGE, status);
+
+	status = flash_store_log_init (&store.test, &store.state, store.index, store.sectors,
+		&store.flash.base, FLASH_STORE_LOG_TESTING_BASE_ADDR, FLASH_STORE_LOG_TESTING_SECTORS,
+		FLASH_STORE_LOG_TESTING_BLOCKS, 0x10000, NULL);
+	CuAssertIntEquals (test, FLASH_STORE_BLOCK_TOO_LARGE, status);
+
+	status = flash_store_log_init (&store.test, &store.state, store.index, store.sectors,
+		&store.flash.base, FLASH_STORE_LOG_TESTING_BASE_ADDR, FLASH_STORE_LOG_TESTING_SECTORS,
+		0x10000, FLASH_STORE_LOG_TESTING_MAX_LENGTH, NULL);
+	CuAssertIntEquals (test, FLASH_STORE_BLOCK_TOO_LARGE, status);
+
+	/* The digest doesn't leave enough space for the data. */
+	status = flash_store_log_init (&store.test, &store.state, store.index, store.sectors,
+		&store.flash.base, FLASH_STORE_LOG_TESTING_BASE_ADDR, FLASH_STORE_LOG_TESTING_SECTORS, 1,
+		VIRTUAL_FLASH_BLOCK_SIZE - 32, &store.hash.base);
+	CuAssertIntEquals (test, FLASH_STORE_BLOCK_TOO_LARGE, status);
+
+	flash_store_log_testing_release_dependencies (test, &store);
+}
+
+static void flash_store_log_test_init_not_enough_space (CuTest *test)
+{
+	struct flash_store_log_testing store;
+	int status;
+
+	TEST_START;
+
+	flash_store_log_testing_init_dependencies (test, &store);
+
+	status = flash_store_log_init (&store.test, &store.state, store.index, store.sectors,
+		&store.flash.base, FLASH_STORE_LOG_TESTING_BASE_ADDR, FLASH_STORE_LOG_TESTING_SECTORS, 32,
+		FLASH_STORE_LOG_TESTING_MAX_LENGTH, NULL);
+	CuAssertIntEquals (test, FLASH_STORE_INSUFFICIENT_STORAGE, status);
+
+	flash_store_log_testing_release_dependencies (test, &store);
+}
+
+static void flash_store_log_test_static_init (CuTest *test)
+{
+	struct flash_store_log_testing store;
+	struct flash_store_log test_static = flash_store_log_static_init (&store.state, store.index,
+		store.sectors, &store.flash.base, FLASH_STORE_LOG_TESTING_BASE_ADDR,
+		FLASH_STORE_LOG_TESTING_SECTORS, FLASH_STORE_LOG_TESTING_BLOCKS,
+		FLASH_STORE_LOG_TESTING_MAX_LENGTH, NULL);
+	uint8_t data[FLASH_STORE_LOG_TESTING_MAX_LENGTH];
+	int status;
+
+	TEST_START;
+
+	CuAssertPtrNotNull (test, test_static.base.write);
+	CuAssertPtrNotNull (test, test_static.base.read);
+	CuAssertPtrNotNull (test, test_static.base.erase);
+	CuAssertPtrNotNull (test, test_static.base.erase_all);
+	CuAssertPtrNotNull (test, test_static.base.get_data_length);
+	CuAssertPtrNotNull (test, test_static.base.has_data_stored);
+	CuAssertPtrNotNull (test, test_static.base.get_max_data_length);
+	CuAssertPtrNotNull (test, test_static.base.get_flash_size);
+	CuAssertPtrNotNull (test, test_static.base.get_num_blocks);
+
+	flash_store_log_testing_init_dependencies (test, &store);
+
+	status = flash_store_log_init_state (&test_static);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_store_log_testing_fill (data, sizeof (data), 1);
+
+	status = test_static.base.write (&test_static.base, 0, data, sizeof (data));
+	CuAssertIntEquals (test, 0, status);
+
+	flash_store_log_testing_check_data (test, &test_static.base, 0, data, sizeof (data));
+
+	flash_store_log_release (&test_static);
+	flash_store_log_testing_release_dependencies (test, &store);
+}
+
+static void flash_store_log_test_init_state_null (CuTest *test)
+{
+	struct flash_store_log_testing store;
+	struct flash_store_log null_state = flash_store_log_static_init (NULL, store.index,
+		store.sectors, &store.flash.base, FLASH_STORE_LOG_TESTING_BASE_ADDR,
+		FLASH_STORE_LOG_TESTING_SECTORS, FLASH_STORE_LOG_TESTING_BLOCKS,
+		FLASH_STORE_LOG_TESTING_MAX_LENGTH, NULL);
+	struct flash_store_log null_flash = flash_store_log_static_init (&store.state, store.index,
+		store.sectors, NULL, FLASH_STORE_LOG_TESTING_BASE_ADDR, FLASH_STORE_LOG_TESTING_SECTORS,
+		FLASH_STORE_LOG_TESTING_BLOCKS, FLASH_STORE_LOG_TESTING_MAX_LENGTH, NULL);
+	struct flash_store_log null_index = flash_store_log_static_init (&store.state, NULL,
+		store.sectors, &store.flash.base, FLASH_STORE_LOG_TESTING_BASE_ADDR,
+		FLASH_STORE_LOG_TESTING_SECTORS, FLASH_STORE_LOG_TESTING_BLOCKS,
+		FLASH_STORE_LOG_TESTING_MAX_LENGTH, NULL);
+	struct flash_store_log null_sectors = flash_store_log_static_init (&store.state, store.index,
+		NULL, &store.flash.base, FLASH_STORE_LOG_TESTING_BASE_ADDR,
+		FLASH_STORE_LOG_TESTING_SECTORS, FLASH_STORE_LOG_TESTING_BLOCKS,
+		FLASH_STORE_LOG_TESTING_MAX_LENGTH, NULL);
+	int status;
+
+	TEST_START;
+
+	status = flash_store_log_init_state (NULL);
+	CuAssertIntEquals (test, FLASH_STORE_INVALID_ARGUMENT, status);
+
+	status = flash_store_log_init_state (&null_state);
+	CuAssertIntEquals (test, FLASH_STORE_INVALID_ARGUMENT, status);
+
+	status = flash_store_log_init_state (&null_flash);
+	CuAssertIntEquals (test, FLASH_STORE_INVALID_ARGUMENT, status);
+
+	status = flash_store_log_init_state (&null_index);
+	CuAssertIntEquals (test, FLASH_STORE_INVALID_ARGUMENT, status);
+
+	status = flash_store_log_init_state (&null_sectors);
+	CuAssertIntEquals (test, FLASH_STORE_INVALID_ARGUMENT, status);
+}
+
+static void flash_store_log_test_release_null (CuTest *test)
+{
+	TEST_START;
+
+	flash_store_log_release (NULL);
+}
+
+static void flash_store_log_test_write_read (CuTest *test)
+{
+	struct flash_store_log_testing store;
+	uint8_t data[FLASH_STORE_LOG_TESTING_MAX_LENGTH];
+	int status;
+
+	TEST_START;
+
+	flash_store_log_testing_init (test, &store, false);
+
+	flash_store_log_testing_fill (data, sizeof (data), 0x10);
+
+	status = store.test.base.write (&store.test.base, 1, data, sizeof (data));
+	CuAssertIntEquals (test, 0, status);
+
+	flash_store_log_testing_check_data (test, &store.test.base, 1, data, sizeof (data));
+
+	status = store.test.base.get_data_length (&store.test.base, 1);
+	CuAssertIntEquals (test, sizeof (data), status);
+
+	status = store.test.base.has_data_stored (&store.test.base, 1);
+	CuAssertIntEquals (test, 1, status);
+
+	status = store.test.base.has_data_stored (&store.test.base, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_store_log_testing_release (test, &store);
+}
+
+static void flash_store_log_test_write_read_with_hash (CuTest *test)
+{
+	struct flash_store_log_testing store;
+	uint8_t data[FLASH_STORE_LOG_TESTING_MAX_LENGTH];
+	int status;
+
+	TEST_START;
+
+	flash_store_log_testing_init (test, &store, true);
+
+	flash_store_log_testing_fill (data, sizeof (data), 0x20);
+
+	status = store.test.base.write (&store.test.base, 2, data, 20);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_store_log_testing_check_data (test, &store.test.base, 2, data, 20);
+
+	status = store.test.base.get_data_length (&store.test.base, 2);
+	CuAssertIntEquals (test, 20, status);
+
+	flash_store_log_testing_release (test, &store);
+}
+
+static void flash_store_log_test_write_read_multiple_blocks (CuTest *test)
+{
+	struct flash_store_log_testing store;
+	uint8_t data[FLASH_STORE_LOG_TESTING_BLOCKS][FLASH_STORE_LOG_TESTING_MAX_LENGTH];
+	int status;
+	int i;
+
+	TEST_START;
+
+	flash_store_log_testing_init (test, &store, false);
+
+	for (i = 0; i < FLASH_STORE_LOG_TESTING_BLOCKS; i++) {
+		flash_store_log_testing_fill (data[i], sizeof (data[i]), i * 0x11);
+
+		status = store.test.base.write (&store.test.base, i, data[i], 10 + i);
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	for (i = 0; i < FLASH_STORE_LOG_TESTING_BLOCKS; i++) {
+		flash_store_log_testing_check_data (test, &store.test.base, i, data[i], 10 + i);
+	}
+
+	flash_store_log_testing_release (test, &store);
+}
+
+static void flash_store_log_test_write_overwrite (CuTest *test)
+{
+	struct flash_store_log_testing store;
+	uint8_t data1[FLASH_STORE_LOG_TESTING_MAX_LENGTH];
+	uint8_t data2[FLASH_STORE_LOG_TESTING_MAX_LENGTH];
+	int status;
+
+	TEST_START;
+
+	flash_store_log_testing_init (test, &store, false);
+
+	flash_store_log_testing_fill (data1, sizeof (data1), 0x30);
+	flash_store_log_testing_fill (data2, sizeof (data2), 0x40);
+
+	status = store.test.base.write (&store.test.base, 0, data1, sizeof (data1));
+	CuAssertIntEquals (test, 0, status);
+
+	status = store.test.base.write (&store.test.base, 0, data2, 16);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_store_log_testing_check_data (test, &store.test.base, 0, data2, 16);
+
+	/* The original data is still in flash, but no longer referenced. */
+	status = testing_validate_array (data1,
+		&store.buffer[FLASH_STORE_LOG_TESTING_BASE_ADDR +
+			sizeof (struct flash_store_log_sector_header) +
+			sizeof (struct flash_store_log_record_header)], sizeof (data1));
+	CuAssertIntEquals (test, 0, status);
+
+	flash_store_log_testing_release (test, &store);
+}
+
+static void flash_store_log_test_write_null (CuTest *test)
+{
+	struct flash_store_log_testing store;
+	uint8_t data[FLASH_STORE_LOG_TESTING_MAX_LENGTH] = {0};
+	int status;
+
+	TEST_START;
+
+	flash_store_log_testing_init (test, &store, false);
+
+	status = store.test.base.write (NULL, 0, data, sizeof (data));
+	CuAssertIntEquals (test, FLASH_STORE_INVALID_ARGUMENT, status);
+
+	status = store.test.base.write (&store.test.base, 0, NULL, sizeof (data));
+	CuAssertIntEquals (test, FLASH_STORE_INVALID_ARGUMENT, status);
+
+	status = store.test.base.write (&store.test.base, 0, data, 0);
+	CuAssertIntEquals (test, FLASH_STORE_INVALID_ARGUMENT, status);
+
+	flash_store_log_testing_release (test, &store);
+}
+
+static void flash_store_log_test_write_invalid_id (CuTest *test)
+{
+	struct flash_store_log_testing store;
+	uint8_t data[FLASH_STORE_LOG_TESTING_MAX_LENGTH] = {0};
+	int status;
+
+	TEST_START;
+
+	flash_store_log_testing_init (test, &store, false);
+
+	status = store.test.base.write (&store.test.base, -1, data, sizeof (data));
+	CuAssertIntEquals (test, FLASH_STORE_UNSUPPORTED_ID, status);
+
+	status = store.test.base.write (&store.test.base, FLASH_STORE_LOG_TESTING_BLOCKS, data,
+		sizeof (data));
+	CuAssertIntEquals (test, FLASH_STORE_UNSUPPORTED_ID, status);
+
+	flash_store_log_testing_release (test, &store);
+}
+
+static void flash_store_log_test_write_too_long (CuTest *test)
+{
+	struct flash_store_log_testing store;
+	uint8_t data[FLASH_STORE_LOG_TESTING_MAX_LENGTH + 1] = {0};
+	int status;
+
+	TEST_START;
+
+	flash_store_log_testing_init (test, &store, false);
+
+	status = store.test.base.write (&store.test.base, 0, data, sizeof (data));
+	CuAssertIntEquals (test, FLASH_STORE_BAD_DATA_LENGTH, status);
+
+	flash_store_log_testing_release (test, &store);
+}
+
+static void flash_store_log_test_read_null (CuTest *test)
+{
+	struct flash_store_log_testing store;
+	uint8_t data[FLASH_STORE_LOG_TESTING_MAX_LENGTH];
+	int status;
+
+	TEST_START;
+
+	flash_store_log_testing_init (test, &store, false);
+
+	status = store.test.base.read (NULL, 0, data, sizeof (data));
+	CuAssertIntEquals (test, FLASH_STORE_INVALID_ARGUMENT, status);
+
+	status = store.test.base.read (&store.test.base, 0, NULL, sizeof (data));
+	CuAssertIntEquals (test, FLASH_STORE_INVALID_ARGUMENT, status);
+
+	flash_store_log_testing_release (test, &store);
+}
+
+static void flash_store_log_test_read_invalid_id (CuTest *test)
+{
+	struct flash_store_log_testing store;
+	uint8_t data[FLASH_STORE_LOG_TESTING_MAX_LENGTH];
+	int status;
+
+	TEST_START;
+
+	flash_store_log_testing_init (test, &store, false);
+
+	status = store.test.base.read (&store.test.base, -1, data, sizeof (data));
+	CuAssertIntEquals (test, FLASH_STORE_UNSUPPORTED_ID, status);
+
+	status = store.test.base.read (&store.test.base, FLASH_STORE_LOG_TESTING_BLOCKS, data,
+		sizeof (data));
+	CuAssertIntEquals (test, FLASH_STORE_UNSUPPORTED_ID, status);
+
+	flash_store_log_testing_release (test, &store);
+}
+
+static void flash_store_log_test_read_no_data (CuTest *test)
+{
+	struct flash_store_log_testing store;
+	uint8_t data[FLASH_STORE_LOG_TESTING_MAX_LENGTH];
+	int status;
+
+	TEST_START;
+
+	flash_store_log_testing_init (test, &store, false);
+
+	status = store.test.base.read (&store.test.base, 0, data, sizeof (data));
+	CuAssertIntEquals (test, FLASH_STORE_NO_DATA, status);
+
+	status = store.test.base.get_data_length (&store.test.base, 0);
+	CuAssertIntEquals (test, FLASH_STORE_NO_DATA, status);
+
+	flash_store_log_testing_release (test, &store);
+}
+
+static void flash_store_log_test_read_buffer_too_small (CuTest *test)
+{
+	struct flash_store_log_testing store;
+	uint8_t data[FLASH_STORE_LOG_TESTING_MAX_LENGTH];
+	int status;
+
+	TEST_START;
+
+	flash_store_log_testing_init (test, &store, false);
+
+	flash_store_log_testing_fill (data, sizeof (data), 0x50);
+
+	status = store.test.base.write (&store.test.base, 0, data, 20);
+	CuAssertIntEquals (test, 0, status);
+
+	status = store.test.base.read (&store.test.base, 0, data, 19);
+	CuAssertIntEquals (test, FLASH_STORE_BUFFER_TOO_SMALL, status);
+
+	flash_store_log_testing_release (test, &store);
+}
+
+static void flash_store_log_test_read_corrupt_data (CuTest *test)
+{
+	struct flash_store_log_testing store;
+	uint8_t data[FLASH_STORE_LOG_TESTING_MAX_LENGTH];
+	int status;
+
+	TEST_START;
+
+	flash_store_log_testing_init (test, &store, true);
+
+	flash_store_log_testing_fill (data, sizeof (data), 0x60);
+
+	status = store.test.base.write (&store.test.base, 0, data, sizeof (data));
+	CuAssertIntEquals (test, 0, status);
+
+	store.buffer[FLASH_STORE_LOG_TESTING_BASE_ADDR + sizeof (struct flash_store_log_sector_header) +
+		sizeof (struct flash_store_log_record_header) + 5] ^= 0x01;
+
+	status = store.test.base.read (&store.test.base, 0, data, sizeof (data));
+	CuAssertIntEquals (test, FLASH_STORE_CORRUPT_DATA, status);
+
+	flash_store_log_testing_release (test, &store);
+}
+
+static void flash_store_log_test_erase (CuTest *test)
+{
+	struct flash_store_log_testing store;
+	uint8_t data[FLASH_STORE_LOG_TESTING_MAX_LENGTH];
+	int status;
+
+	TEST_START;
+
+	flash_store_log_testing_init (test, &store, false);
+
+	flash_store_log_testing_fill (data, sizeof (data), 0x70);
+
+	status = store.test.base.write (&store.test.base, 0, data, sizeof (data));
+	CuAssertIntEquals (test, 0, status);
+
+	status = store.test.base.write (&store.test.base, 1, data, sizeof (data));
+	CuAssertIntEquals (test, 0, status);
+
+	status = store.test.base.erase (&store.test.base, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = store.test.base.has_data_stored (&store.test.base, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = store.test.base.read (&store.test.base, 0, data, sizeof (data));
+	CuAssertIntEquals (test, FLASH_STORE_NO_DATA, status);
+
+	status = store.test.base.has_data_stored (&store.test.base, 1);
+	CuAssertIntEquals (test, 1, status);
+
+	flash_store_log_testing_release (test, &store);
+}
+
+static void flash_store_log_test_erase_no_data (CuTest *test)
+{
+	struct flash_store_log_testing store;
+	uint8_t expected[VIRTUAL_FLASH_BLOCK_SIZE];
+	int status;
+
+	TEST_START;
+
+	flash_store_log_testing_init (test, &store, false);
+
+	memcpy (expected, &store.buffer[FLASH_STORE_LOG_TESTING_BASE_ADDR], sizeof (expected));
+
+	status = store.test.base.erase (&store.test.base, 2);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Nothing is written to flash when there is no data to erase. */
+	status = testing_validate_array (expected, &store.buffer[FLASH_STORE_LOG_TESTING_BASE_ADDR],
+		sizeof (expected));
+	CuAssertIntEquals (test, 0, status);
+
+	flash_store_log_testing_release (test, &store);
+}
+
+static void flash_store_log_test_erase_null (CuTest *test)
+{
+	struct flash_store_log_testing store;
+	int status;
+
+	TEST_START;
+
+	flash_store_log_testing_init (test, &store, false);
+
+	status = store.test.base.erase (NULL, 0);
+	CuAssertIntEquals (test, FLASH_STORE_INVALID_ARGUMENT, status);
+
+	status = store.test.base.erase (&store.test.base, FLASH_STORE_LOG_TESTING_BLOCKS);
+	CuAssertIntEquals (test, FLASH_STORE_UNSUPPORTED_ID, status);
+
+	flash_store_log_testing_release (test, &store);
+}
+
+static void flash_store_log_test_erase_all (CuTest *test)
+{
+	struct flash_store_log_testing store;
+	uint8_t data[FLASH_STORE_LOG_TESTING_MAX_LENGTH];
+	struct flash_store_log_stats stats;
+	int status;
+	int i;
+
+	TEST_START;
+
+	flash_store_log_testing_init (test, &store, false);
+
+	flash_store_log_testing_fill (data, sizeof (data), 0x80);
+
+	for (i = 0; i < FLASH_STORE_LOG_TESTING_BLOCKS; i++) {
+		status = store.test.base.write (&store.test.base, i, data, sizeof (data));
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	status = store.test.base.erase_all (&store.test.base);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < FLASH_STORE_LOG_TESTING_BLOCKS; i++) {
+		status = store.test.base.has_data_stored (&store.test.base, i);
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	status = flash_store_log_get_stats (&store.test, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, FLASH_STORE_LOG_TESTING_SECTORS - 1, stats.free_sectors);
+
+	/* The log continues in the next sector instead of reusing the first one. */
+	CuAssertIntEquals (test, 0xff, store.buffer[FLASH_STORE_LOG_TESTING_BASE_ADDR + 4]);
+	CuAssertIntEquals (test, FLASH_STORE_LOG_SECTOR_MAGIC,
+		*((uint32_t*) &store.buffer[FLASH_STORE_LOG_TESTING_BASE_ADDR + VIRTUAL_FLASH_BLOCK_SIZE +
+			4]));
+
+	status = store.test.base.write (&store.test.base, 3, data, 8);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_store_log_testing_remount (test, &store, false);
+
+	flash_store_log_testing_check_data (test, &store.test.base, 3, data, 8);
+
+	status = store.test.base.has_data_stored (&store.test.base, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_store_log_testing_release (test, &store);
+}
+
+static void flash_store_log_test_erase_all_null (CuTest *test)
+{
+	struct flash_store_log_testing store;
+	int status;
+
+	TEST_START;
+
+	flash_store_log_testing_init (test, &store, false);
+
+	status = store.test.base.erase_all (NULL);
+	CuAssertIntEquals (test, FLASH_STORE_INVALID_ARGUMENT, status);
+
+	flash_store_log_testing_release (test, &store);
+}
+
+static void flash_store_log_test_query_null (CuTest *test)
+{
+	struct flash_store_log_testing store;
+	struct flash_store_log_stats stats;
+	int status;
+
+	TEST_START;
+
+	flash_store_log_testing_init (test, &store, false);
+
+	status = store.test.base.get_data_length (NULL, 0);
+	CuAssertIntEquals (test, FLASH_STORE_INVALID_ARGUMENT, status);
+
+	status = store.test.base.get_data_length (&store.test.base, FLASH_STORE_LOG_TESTING_BLOCKS);
+	CuAssertIntEquals (test, FLASH_STORE_UNSUPPORTED_ID, status);
+
+	status = store.test.base.has_data_stored (NULL, 0);
+	CuAssertIntEquals (test, FLASH_STORE_INVALID_ARGUMENT, status);
+
+	status = store.test.base.has_data_stored (&store.test.base, -1);
+	CuAssertIntEquals (test, FLASH_STORE_UNSUPPORTED_ID, status);
+
+	status = store.test.base.get_max_data_length (NULL);
+	CuAssertIntEquals (test, FLASH_STORE_INVALID_ARGUMENT, status);
+
+	status = store.test.base.get_flash_size (NULL);
+	CuAssertIntEquals (test, FLASH_STORE_INVALID_ARGUMENT, status);
+
+	status = store.test.base.get_num_blocks (NULL);
+	CuAssertIntEquals (test, FLASH_STORE_INVALID_ARGUMENT, status);
+
+	status = flash_store_log_get_stats (NULL, &stats);
+	CuAssertIntEquals (test, FLASH_STORE_INVALID_ARGUMENT, status);
+
+	status = flash_store_log_get_stats (&store.test, NULL);
+	CuAssertIntEquals (test, FLASH_STORE_INVALID_ARGUMENT, status);
+
+	status = flash_store_log_collect_garbage (NULL);
+	CuAssertIntEquals (test, FLASH_STORE_INVALID_ARGUMENT, status);
+
+	flash_store_log_testing_release (test, &store);
+}
+
+static void flash_store_log_test_remount (CuTest *test)
+{
+	struct flash_store_log_testing store;
+	uint8_t data1[FLASH_STORE_LOG_TESTING_MAX_LENGTH];
+	uint8_t data2[FLASH_STORE_LOG_TESTING_MAX_LENGTH];
+	int status;
+
+	TEST_START;
+
+	flash_store_log_testing_init (test, &store, true);
+
+	flash_store_log_testing_fill (data1, sizeof (data1), 0x90);
+	flash_store_log_testing_fill (data2, sizeof (data2), 0xa0);
+
+	status = store.test.base.write (&store.test.base, 0, data1, sizeof (data1));
+	CuAssertIntEquals (test, 0, status);
+
+	status = store.test.base.write (&store.test.base, 1, data1, 12);
+	CuAssertIntEquals (test, 0, status);
+
+	status = store.test.base.write (&store.test.base, 0, data2, 24);
+	CuAssertIntEquals (test, 0, status);
+
+	status = store.test.base.erase (&store.test.base, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_store_log_testing_remount (test, &store, true);
+
+	flash_store_log_testing_check_data (test, &store.test.base, 0, data2, 24);
+
+	status = store.test.base.has_data_stored (&store.test.base, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	/* New records are appended after the existing ones. */
+	status = store.test.base.write (&store.test.base, 2, data1, 4);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_store_log_testing_remount (test, &store, true);
+
+	flash_store_log_testing_check_data (test, &store.test.base, 0, data2, 24);
+	flash_store_log_testing_check_data (test, &store.test.base, 2, data1, 4);
+
+	flash_store_log_testing_release (test, &store);
+}
+
+static void flash_store_log_test_remount_uncommitted_record (CuTest *test)
+{
+	struct flash_store_log_testing store;
+	uint8_t data1[FLASH_STORE_LOG_TESTING_MAX_LENGTH];
+	uint8_t data2[FLASH_STORE_LOG_TESTING_MAX_LENGTH];
+	uint32_t second = FLASH_STORE_LOG_TESTING_BASE_ADDR +
+		sizeof (struct flash_store_log_sector_header) +
+		sizeof (struct flash_store_log_record_header) + 16;
+	int status;
+
+	TEST_START;
+
+	flash_store_log_testing_init (test, &store, false);
+
+	flash_store_log_testing_fill (data1, sizeof (data1), 0xb0);
+	flash_store_log_testing_fill (data2, sizeof (data2), 0xc0);
+
+	status = store.test.base.write (&store.test.base, 0, data1, 16);
+	CuAssertIntEquals (test, 0, status);
+
+	status = store.test.base.write (&store.test.base, 0, data2, 16);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Simulate a power loss before the second record was committed. */
+	store.buffer[second + offsetof (struct flash_store_log_record_header, commit)] = 0xff;
+
+	flash_store_log_testing_remount (test, &store, false);
+
+	flash_store_log_testing_check_data (test, &store.test.base, 0, data1, 16);
+
+	/* The space used by the partial record is not reused. */
+	status = store.test.base.write (&store.test.base, 0, data2, 8);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, FLASH_STORE_LOG_RECORD_MARKER,
+		store.buffer[second + sizeof (struct flash_store_log_record_header) + 16]);
+
+	flash_store_log_testing_remount (test, &store, false);
+
+	flash_store_log_testing_check_data (test, &store.test.base, 0, data2, 8);
+
+	flash_store_log_testing_release (test, &store);
+}
+
+static void flash_store_log_test_remount_partial_header (CuTest *test)
+{
+	struct flash_store_log_testing store;
+	uint8_t data[FLASH_STORE_LOG_TESTING_MAX_LENGTH];
+	uint32_t partial = FLASH_STORE_LOG_TESTING_BASE_ADDR +
+		sizeof (struct flash_store_log_sector_header) +
+		sizeof (struct flash_store_log_record_header) + 16;
+	struct flash_store_log_stats stats;
+	int status;
+
+	TEST_START;
+
+	flash_store_log_testing_init (test, &store, false);
+
+	flash_store_log_testing_fill (data, sizeof (data), 0xd0);
+
+	status = store.test.base.write (&store.test.base, 0, data, 16);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Simulate a power loss while the next record header was being written. */
+	store.buffer[partial] = FLASH_STORE_LOG_RECORD_MARKER;
+
+	flash_store_log_testing_remount (test, &store, false);
+
+	flash_store_log_testing_check_data (test, &store.test.base, 0, data, 16);
+
+	/* The rest of the sector is unusable, so the next write starts a new sector. */
+	status = store.test.base.write (&store.test.base, 1, data, 8);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_store_log_get_stats (&store.test, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, FLASH_STORE_LOG_TESTING_SECTORS - 2, stats.free_sectors);
+
+	flash_store_log_testing_remount (test, &store, false);
+
+	flash_store_log_testing_check_data (test, &store.test.base, 0, data, 16);
+	flash_store_log_testing_check_data (test, &store.test.base, 1, data, 8);
+
+	flash_store_log_testing_release (test, &store);
+}
+
+static void flash_store_log_test_wear_leveling (CuTest *test)
+{
+	struct flash_store_log_testing store;
+	uint8_t data[FLASH_STORE_LOG_TESTING_BLOCKS][FLASH_STORE_LOG_TESTING_MAX_LENGTH];
+	size_t length[FLASH_STORE_LOG_TESTING_BLOCKS];
+	uint32_t sequence[FLASH_STORE_LOG_TESTING_SECTORS];
+	struct flash_store_log_stats stats;
+	int status;
+	int id;
+	int i;
+	int j;
+
+	TEST_START;
+
+	flash_store_log_testing_init (test, &store, true);
+
+	for (i = 0; i < 200; i++) {
+		id = i % FLASH_STORE_LOG_TESTING_BLOCKS;
+		length[id] = FLASH_STORE_LOG_TESTING_MAX_LENGTH - (i % 8);
+
+		if ((i % 3) == 0) {
+			status = store.test.base.erase (&store.test.base, id);
+			CuAssertIntEquals (test, 0, status);
+		}
+
+		flash_store_log_testing_fill (data[id], length[id], i);
+
+		status = store.test.base.write (&store.test.base, id, data[id], length[id]);
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	status = flash_store_log_get_stats (&store.test, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertTrue (test, (stats.sectors_collected > (FLASH_STORE_LOG_TESTING_SECTORS * 2)));
+	CuAssertTrue (test, (stats.free_sectors >= 1));
+
+	/* Sectors have been used in rotation, with each active sector having a unique sequence. */
+	CuAssertTrue (test, (store.state.next_sequence > (FLASH_STORE_LOG_TESTING_SECTORS * 2)));
+	for (i = 0; i < FLASH_STORE_LOG_TESTING_SECTORS; i++) {
+		sequence[i] = *((uint32_t*) &store.buffer[FLASH_STORE_LOG_TESTING_BASE_ADDR +
+			(i * VIRTUAL_FLASH_BLOCK_SIZE)]);
+		for (j = 0; j < i; j++) {
+			if (sequence[i] != 0xffffffff) {
+				CuAssertTrue (test, (sequence[i] != sequence[j]));
+			}
+		}
+	}
+
+	for (id = 0; id < FLASH_STORE_LOG_TESTING_BLOCKS; id++) {
+		flash_store_log_testing_check_data (test, &store.test.base, id, data[id], length[id]);
+	}
+
+	flash_store_log_testing_remount (test, &store, true);
+
+	for (id = 0; id < FLASH_STORE_LOG_TESTING_BLOCKS; id++) {
+		flash_store_log_testing_check_data (test, &store.test.base, id, data[id], length[id]);
+	}
+
+	flash_store_log_testing_release (test, &store);
+}
+
+static void flash_store_log_test_garbage_collection_relocates_data (CuTest *test)
+{
+	struct flash_store_log_testing store;
+	uint8_t keep[FLASH_STORE_LOG_TESTING_MAX_LENGTH];
+	uint8_t data[FLASH_STORE_LOG_TESTING_MAX_LENGTH];
+	struct flash_store_log_stats stats;
+	int status;
+	int i;
+
+	TEST_START;
+
+	flash_store_log_testing_init (test, &store, false);
+
+	flash_store_log_testing_fill (keep, sizeof (keep), 0xe0);
+	flash_store_log_testing_fill (data, sizeof (data), 0xf0);
+
+	/* Block 0 is written once and never updated. */
+	status = store.test.base.write (&store.test.base, 0, keep, sizeof (keep));
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 40; i++) {
+		data[0] = i;
+
+		status = store.test.base.write (&store.test.base, 1, data, sizeof (data));
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	status = flash_store_log_get_stats (&store.test, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertTrue (test, (stats.sectors_collected > 0));
+	CuAssertTrue (test, (stats.records_relocated > 0));
+
+	/* The original sector containing block 0 has been reclaimed. */
+	CuAssertIntEquals (test, 0xff, store.buffer[FLASH_STORE_LOG_TESTING_BASE_ADDR]);
+
+	flash_store_log_testing_check_data (test, &store.test.base, 0, keep, sizeof (keep));
+	flash_store_log_testing_check_data (test, &store.test.base, 1, data, sizeof (data));
+
+	flash_store_log_testing_remount (test, &store, false);
+
+	flash_store_log_testing_check_data (test, &store.test.base, 0, keep, sizeof (keep));
+	flash_store_log_testing_check_data (test, &store.test.base, 1, data, sizeof (data));
+
+	flash_store_log_testing_release (test, &store);
+}
+
+static void flash_store_log_test_collect_garbage (CuTest *test)
+{
+	struct flash_store_log_testing store;
+	uint8_t data[FLASH_STORE_LOG_TESTING_MAX_LENGTH];
+	struct flash_store_log_stats stats;
+	int status;
+	int i;
+
+	TEST_START;
+
+	flash_store_log_testing_init (test, &store, false);
+
+	flash_store_log_testing_fill (data, sizeof (data), 0x15);
+
+	/* Only the head sector is in use, so there is nothing to collect. */
+	status = flash_store_log_collect_garbage (&store.test);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_store_log_get_stats (&store.test, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, stats.sectors_collected);
+
+	/* Fill the first two sectors and move into the third one. */
+	for (i = 0; i < 13; i++) {
+		status = store.test.base.write (&store.test.base, 0, data, sizeof (data));
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	status = flash_store_log_get_stats (&store.test, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, FLASH_STORE_LOG_TESTING_SECTORS - 3, stats.free_sectors);
+	CuAssertIntEquals (test, 0, stats.sectors_collected);
+
+	status = flash_store_log_collect_garbage (&store.test);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_store_log_get_stats (&store.test, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, FLASH_STORE_LOG_TESTING_SECTORS - 2, stats.free_sectors);
+	CuAssertIntEquals (test, 1, stats.sectors_collected);
+	CuAssertIntEquals (test, 0, stats.records_relocated);
+
+	CuAssertIntEquals (test, 0xff, store.buffer[FLASH_STORE_LOG_TESTING_BASE_ADDR]);
+
+	flash_store_log_testing_check_data (test, &store.test.base, 0, data, sizeof (data));
+
+	/* Enough sectors are free now, so there is nothing more to collect. */
+	status = flash_store_log_collect_garbage (&store.test);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_store_log_get_stats (&store.test, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, stats.sectors_collected);
+
+	flash_store_log_testing_release (test, &store);
+}
+
+static void flash_store_log_test_collect_garbage_no_stale_data (CuTest *test)
+{
+	struct flash_store_log_testing store;
+	uint8_t data[FLASH_STORE_LOG_TESTING_MAX_LENGTH];
+	struct flash_store_log_stats stats;
+	int status;
+	int i;
+
+	TEST_START;
+
+	flash_store_log_testing_init (test, &store, false);
+
+	flash_store_log_testing_fill (data, sizeof (data), 0x25);
+
+	/* Fill the first sector with current data for every block. */
+	for (i = 0; i < FLASH_STORE_LOG_TESTING_BLOCKS; i++) {
+		status = store.test.base.write (&store.test.base, i, data, sizeof (data));
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	for (i = 0; i < 9; i++) {
+		status = store.test.base.write (&store.test.base, 3, data, sizeof (data));
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	status = flash_store_log_get_stats (&store.test, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, FLASH_STORE_LOG_TESTING_SECTORS - 3, stats.free_sectors);
+
+	/* Blocks 0-2 are still current in the first sector, but block 3 is stale. */
+	status = flash_store_log_collect_garbage (&store.test);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_store_log_get_stats (&store.test, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, stats.sectors_collected);
+	CuAssertIntEquals (test, 3, stats.records_relocated);
+
+	for (i = 0; i < FLASH_STORE_LOG_TESTING_BLOCKS; i++) {
+		flash_store_log_testing_check_data (test, &store.test.base, i, data, sizeof (data));
+	}
+
+	flash_store_log_testing_release (test, &store);
+}
+
+
+TEST_SUITE_START (flash_store_log);
+
+TEST (flash_store_log_test_init);
+TEST (flash_store_log_test_init_with_hash);
+TEST (flash_store_log_test_init_null);
+TEST (flash_store_log_test_init_no_data);
+TEST (flash_store_log_test_init_one_sector);
+TEST (flash_store_log_test_init_not_sector_aligned);
+TEST (flash_store_log_test_init_base_out_of_range);
+TEST (flash_store_log_test_init_past_end_of_flash);
+TEST (flash_store_log_test_init_block_too_large);
+TEST (flash_store_log_test_init_not_enough_space);
+TEST (flash_store_log_test_static_init);
+TEST (flash_store_log_test_init_state_null);
+TEST (flash_store_log_test_release_null);
+TEST (flash_store_log_test_write_read);
+TEST (flash_store_log_test_write_read_with_hash);
+TEST (flash_store_log_test_write_read_multiple_blocks);
+TEST (flash_store_log_test_write_overwrite);
+TEST (flash_store_log_test_write_null);
+TEST (flash_store_log_test_write_invalid_id);
+TEST (flash_store_log_test_write_too_long);
+TEST (flash_store_log_test_read_null);
+TEST (flash_store_log_test_read_invalid_id);
+TEST (flash_store_log_test_read_no_data);
+TEST (flash_store_log_test_read_buffer_too_small);
+TEST (flash_store_log_test_read_corrupt_data);
+TEST (flash_store_log_test_erase);
+TEST (flash_store_log_test_erase_no_data);
+TEST (flash_store_log_test_erase_null);
+TEST (flash_store_log_test_erase_all);
+TEST (flash_store_log_test_erase_all_null);
+TEST (flash_store_log_test_query_null);
+TEST (flash_store_log_test_remount);
+TEST (flash_store_log_test_remount_uncommitted_record);
+TEST (flash_store_log_test_remount_partial_header);
+TEST (flash_store_log_test_wear_leveling);
+TEST (flash_store_log_test_garbage_collection_relocates_data);
+TEST (flash_store_log_test_collect_garbage);
+TEST (flash_store_log_test_collect_garbage_no_stale_data);
+
+TEST_SUITE_END;
@@ -15246,6 +15246,605 @@ static void flash_hash_noncontiguous_contents_at_offset_test_hash_finish_error (
 	CuAssertIntEquals (test, 0, status);
 }
 
+static void flash_hash_multiple_contents_test_sha256 (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	int status;
+	struct flash_region regions[2];
+	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t hash_expected[] = {
+		0x03,0xac,0x67,0x42,0x16,0xf3,0xe1,0x5c,0x76,0x1e,0xe1,0xa5,0xe2,0x55,0xf0,0x67,
+		0x95,0x36,0x23,0xc8,0xb3,0x88,0xb4,0x45,0x9e,0x13,0xf9,0x78,0xd7,0xc8,0x46,0xf4
+	};
+	uint8_t buffer[16];
+	uint8_t hash_actual[SHA256_HASH_LENGTH * 2];
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x3344),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, "Test", 4, 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	regions[0].start_addr = 0x1122;
+	regions[0].length = 4;
+
+	regions[1].start_addr = 0x3344;
+	regions[1].length = 4;
+
+	status = flash_hash_multiple_contents (&flash.base, regions, 2, &hash.base, HASH_TYPE_SHA256,
+		buffer, sizeof (buffer), hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (hash_expected, hash_actual, sizeof (hash_expected));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA256_TEST_HASH, &hash_actual[SHA256_HASH_LENGTH],
+		SHA256_HASH_LENGTH);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void flash_hash_multiple_contents_test_no_buffer (CuTest *test)
+{
+	struct hash_engine_mock hash;
+	struct flash_mock flash;
+	int status;
+	struct flash_region regions[2];
+	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t hash_actual[SHA256_HASH_LENGTH * 2];
+
+	TEST_START;
+
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	hash_mock_enable_sha256_multi (&hash);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0, MOCK_ARG_PTR (hash_actual),
+		MOCK_ARG (SHA256_HASH_LENGTH));
+
+	status |= mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x3344),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0,
+		MOCK_ARG_PTR (&hash_actual[SHA256_HASH_LENGTH]), MOCK_ARG (SHA256_HASH_LENGTH));
+
+	CuAssertIntEquals (test, 0, status);
+
+	regions[0].start_addr = 0x1122;
+	regions[0].length = 4;
+
+	regions[1].start_addr = 0x3344;
+	regions[1].length = 4;
+
+	status = flash_hash_multiple_contents (&flash.base, regions, 2, &hash.base, HASH_TYPE_SHA256,
+		NULL, 0, hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_hash_multiple_contents_test_sha384 (CuTest *test)
+{
+	struct hash_engine_mock hash;
+	struct flash_mock flash;
+	int status;
+	struct flash_region regions;
+	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t buffer[16];
+	uint8_t hash_actual[SHA384_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	hash_mock_enable_sha256_multi (&hash);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&hash.mock, hash.base.start_sha384, &hash, 0);
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0, MOCK_ARG_PTR (hash_actual),
+		MOCK_ARG (SHA384_HASH_LENGTH));
+
+	CuAssertIntEquals (test, 0, status);
+
+	regions.start_addr = 0x1122;
+	regions.length = 4;
+
+	status = flash_hash_multiple_contents (&flash.base, &regions, 1, &hash.base, HASH_TYPE_SHA384,
+		buffer, sizeof (buffer), hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_hash_multiple_contents_test_sha256_multi (CuTest *test)
+{
+	struct hash_engine_mock hash;
+	struct flash_mock flash;
+	int status;
+	struct flash_region regions[3];
+	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t buffer[16];
+	uint8_t hash_actual[SHA256_HASH_LENGTH * 3];
+
+	TEST_START;
+
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	hash_mock_enable_sha256_multi (&hash);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x3344),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (2));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x5566),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (10));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&hash.mock, hash.base.calculate_sha256_multi, &hash, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG (3));
+
+	CuAssertIntEquals (test, 0, status);
+
+	regions[0].start_addr = 0x1122;
+	regions[0].length = 4;
+
+	regions[1].start_addr = 0x3344;
+	regions[1].length = 2;
+
+	regions[2].start_addr = 0x5566;
+	regions[2].length = 10;
+
+	status = flash_hash_multiple_contents (&flash.base, regions, 3, &hash.base, HASH_TYPE_SHA256,
+		buffer, sizeof (buffer), hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_hash_multiple_contents_test_sha256_multi_max_batch (CuTest *test)
+{
+	struct hash_engine_mock hash;
+	struct flash_mock flash;
+	int status;
+	struct flash_region regions[FLASH_MULTI_HASH_BATCH + 2];
+	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t buffer[64];
+	uint8_t hash_actual[SHA256_HASH_LENGTH * (FLASH_MULTI_HASH_BATCH + 2)];
+	size_t i;
+
+	TEST_START;
+
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	hash_mock_enable_sha256_multi (&hash);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < FLASH_MULTI_HASH_BATCH + 2; i++) {
+		regions[i].start_addr = 0x10000 + (i * 0x100);
+		regions[i].length = 4;
+
+		status |= mock_expect (&flash.mock, flash.base.read, &flash, 0,
+			MOCK_ARG (regions[i].start_addr), MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+		status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+
+		if (i == (FLASH_MULTI_HASH_BATCH - 1)) {
+			status |= mock_expect (&hash.mock, hash.base.calculate_sha256_multi, &hash, 0,
+				MOCK_ARG_NOT_NULL, MOCK_ARG (FLASH_MULTI_HASH_BATCH));
+		}
+	}
+
+	status |= mock_expect (&hash.mock, hash.base.calculate_sha256_multi, &hash, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG (2));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_hash_multiple_contents (&flash.base, regions, FLASH_MULTI_HASH_BATCH + 2,
+		&hash.base, HASH_TYPE_SHA256, buffer, sizeof (buffer), hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_hash_multiple_contents_test_sha256_multi_buffer_full (CuTest *test)
+{
+	struct hash_engine_mock hash;
+	struct flash_mock flash;
+	int status;
+	struct flash_region regions[3];
+	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t buffer[10];
+	uint8_t hash_actual[SHA256_HASH_LENGTH * 3];
+
+	TEST_START;
+
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	hash_mock_enable_sha256_multi (&hash);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x3344),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&hash.mock, hash.base.calculate_sha256_multi, &hash, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG (2));
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x5566),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&hash.mock, hash.base.calculate_sha256_multi, &hash, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
+
+	CuAssertIntEquals (test, 0, status);
+
+	regions[0].start_addr = 0x1122;
+	regions[0].length = 4;
+
+	regions[1].start_addr = 0x3344;
+	regions[1].length = 4;
+
+	regions[2].start_addr = 0x5566;
+	regions[2].length = 4;
+
+	status = flash_hash_multiple_contents (&flash.base, regions, 3, &hash.base, HASH_TYPE_SHA256,
+		buffer, sizeof (buffer), hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_hash_multiple_contents_test_sha256_multi_region_larger_than_buffer (
+	CuTest *test)
+{
+	struct hash_engine_mock hash;
+	struct flash_mock flash;
+	int status;
+	struct flash_region regions[3];
+	uint8_t data[] = {0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30};
+	uint8_t buffer[8];
+	uint8_t hash_actual[SHA256_HASH_LENGTH * 3];
+
+	TEST_START;
+
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	hash_mock_enable_sha256_multi (&hash);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&hash.mock, hash.base.calculate_sha256_multi, &hash, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
+
+	status |= mock_expect (&hash.mock, hash.base.start_sha256, &hash, 0);
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x3344),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (10));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+	status |= mock_expect (&hash.mock, hash.base.update, &hash, 0, MOCK_ARG_NOT_NULL,
+		MOCK_ARG (10));
+	status |= mock_expect (&hash.mock, hash.base.finish, &hash, 0,
+		MOCK_ARG_PTR (&hash_actual[SHA256_HASH_LENGTH]), MOCK_ARG (SHA256_HASH_LENGTH));
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x5566),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&hash.mock, hash.base.calculate_sha256_multi, &hash, 0,
+		MOCK_ARG_NOT_NULL, MOCK_ARG (1));
+
+	CuAssertIntEquals (test, 0, status);
+
+	regions[0].start_addr = 0x1122;
+	regions[0].length = 4;
+
+	regions[1].start_addr = 0x3344;
+	regions[1].length = 10;
+
+	regions[2].start_addr = 0x5566;
+	regions[2].length = 4;
+
+	status = flash_hash_multiple_contents (&flash.base, regions, 3, &hash.base, HASH_TYPE_SHA256,
+		buffer, sizeof (buffer), hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_hash_multiple_contents_test_unknown (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	int status;
+	struct flash_region regions;
+	uint8_t buffer[16];
+	uint8_t hash_actual[HASH_MAX_HASH_LEN];
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	regions.start_addr = 0x1122;
+	regions.length = 4;
+
+	status = flash_hash_multiple_contents (&flash.base, &regions, 1, &hash.base,
+		(enum hash_type) 10, buffer, sizeof (buffer), hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, HASH_ENGINE_UNKNOWN_HASH, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void flash_hash_multiple_contents_test_null (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	int status;
+	struct flash_region regions[2];
+	uint8_t buffer[16];
+	uint8_t hash_actual[SHA256_HASH_LENGTH * 2];
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	regions[0].start_addr = 0x1122;
+	regions[0].length = 4;
+
+	regions[1].start_addr = 0x3344;
+	regions[1].length = 0;
+
+	status = flash_hash_multiple_contents (NULL, regions, 1, &hash.base, HASH_TYPE_SHA256, buffer,
+		sizeof (buffer), hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_hash_multiple_contents (&flash.base, NULL, 1, &hash.base, HASH_TYPE_SHA256,
+		buffer, sizeof (buffer), hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_hash_multiple_contents (&flash.base, regions, 0, &hash.base, HASH_TYPE_SHA256,
+		buffer, sizeof (buffer), hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_hash_multiple_contents (&flash.base, regions, 1, NULL, HASH_TYPE_SHA256,
+		buffer, sizeof (buffer), hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_hash_multiple_contents (&flash.base, regions, 1, &hash.base, HASH_TYPE_SHA256,
+		buffer, sizeof (buffer), NULL, sizeof (hash_actual));
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_hash_multiple_contents (&flash.base, regions, 2, &hash.base, HASH_TYPE_SHA256,
+		buffer, sizeof (buffer), hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, FLASH_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void flash_hash_multiple_contents_test_small_hash_buffer (CuTest *test)
+{
+	HASH_TESTING_ENGINE hash;
+	struct flash_mock flash;
+	int status;
+	struct flash_region regions[2];
+	uint8_t buffer[16];
+	uint8_t hash_actual[SHA256_HASH_LENGTH * 2];
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	regions[0].start_addr = 0x1122;
+	regions[0].length = 4;
+
+	regions[1].start_addr = 0x3344;
+	regions[1].length = 4;
+
+	status = flash_hash_multiple_contents (&flash.base, regions, 2, &hash.base, HASH_TYPE_SHA256,
+		buffer, sizeof (buffer), hash_actual, sizeof (hash_actual) - 1);
+	CuAssertIntEquals (test, FLASH_UTIL_HASH_BUFFER_TOO_SMALL, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void flash_hash_multiple_contents_test_sha256_multi_read_error (CuTest *test)
+{
+	struct hash_engine_mock hash;
+	struct flash_mock flash;
+	int status;
+	struct flash_region regions[2];
+	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t buffer[16];
+	uint8_t hash_actual[SHA256_HASH_LENGTH * 2];
+
+	TEST_START;
+
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	hash_mock_enable_sha256_multi (&hash);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, FLASH_READ_FAILED,
+		MOCK_ARG (0x3344), MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+
+	CuAssertIntEquals (test, 0, status);
+
+	regions[0].start_addr = 0x1122;
+	regions[0].length = 4;
+
+	regions[1].start_addr = 0x3344;
+	regions[1].length = 4;
+
+	status = flash_hash_multiple_contents (&flash.base, regions, 2, &hash.base, HASH_TYPE_SHA256,
+		buffer, sizeof (buffer), hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, FLASH_READ_FAILED, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void flash_hash_multiple_contents_test_sha256_multi_hash_error (CuTest *test)
+{
+	struct hash_engine_mock hash;
+	struct flash_mock flash;
+	int status;
+	struct flash_region regions[2];
+	uint8_t data[] = {0x31, 0x32, 0x33, 0x34};
+	uint8_t buffer[16];
+	uint8_t hash_actual[SHA256_HASH_LENGTH * 2];
+
+	TEST_START;
+
+	status = hash_mock_init (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	hash_mock_enable_sha256_multi (&hash);
+
+	status = flash_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x1122),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&flash.mock, flash.base.read, &flash, 0, MOCK_ARG (0x3344),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (4));
+	status |= mock_expect_output (&flash.mock, 1, data, sizeof (data), 2);
+
+	status |= mock_expect (&hash.mock, hash.base.calculate_sha256_multi, &hash,
+		HASH_ENGINE_SHA256_FAILED, MOCK_ARG_NOT_NULL, MOCK_ARG (2));
+
+	CuAssertIntEquals (test, 0, status);
+
+	regions[0].start_addr = 0x1122;
+	regions[0].length = 4;
+
+	regions[1].start_addr = 0x3344;
+	regions[1].length = 4;
+
+	status = flash_hash_multiple_contents (&flash.base, regions, 2, &hash.base, HASH_TYPE_SHA256,
+		buffer, sizeof (buffer), hash_actual, sizeof (hash_actual));
+	CuAssertIntEquals (test, HASH_ENGINE_SHA256_FAILED, status);
+
+	status = flash_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mock_validate_and_release (&hash);
+	CuAssertIntEquals (test, 0, status);
+}
+
 static void flash_verify_noncontiguous_contents_at_offset_test_sha256 (CuTest *test)
 {
 	HASH_TESTING_ENGINE hash;
@@ -18622,6 +19221,18 @@ TEST (flash_hash_noncontiguous_contents_at_offset_test_multiple_regions_read_err
 TEST (flash_hash_noncontiguous_contents_at_offset_test_hash_start_error);
 TEST (flash_hash_noncontiguous_contents_at_offset_test_hash_update_error);
 TEST (flash_hash_noncontiguous_contents_at_offset_test_hash_finish_error);
+TEST (flash_hash_multiple_contents_test_sha256);
+TEST (flash_hash_multiple_contents_test_no_buffer);
+TEST (flash_hash_multiple_contents_test_sha384);
+TEST (flash_hash_multiple_contents_test_sha256_multi);
+TEST (flash_hash_multiple_contents_test_sha256_multi_max_batch);
+TEST (flash_hash_multiple_contents_test_sha256_multi_buffer_full);
+TEST (flash_hash_multiple_contents_test_sha256_multi_region_larger_than_buffer);
+TEST (flash_hash_multiple_contents_test_unknown);
+TEST (flash_hash_multiple_contents_test_null);
+TEST (flash_hash_multiple_contents_test_small_hash_buffer);
+TEST (flash_hash_multiple_contents_test_sha256_multi_read_error);
+TEST (flash_hash_multiple_contents_test_sha256_multi_hash_error);
 TEST (flash_verify_noncontiguous_contents_at_offset_test_sha256);
 TEST (flash_verify_noncontiguous_contents_at_offset_test_sha256_with_hash_out);
 TEST (flash_verify_noncontiguous_contents_at_offset_test_sha256_no_match_signature);
@@ -10249,6 +10249,278 @@ static void spi_flash_sfdp_test_get_deep_powerdown_commands_null (CuTest *test)
 	spi_flash_sfdp_release (&sfdp);
 }
 
+static void spi_flash_sfdp_test_get_suspend_info_mx25l1606e (CuTest *test)
+{
+	struct flash_master_mock flash;
+	struct spi_flash_sfdp sfdp;
+	struct spi_flash_sfdp_basic_table table;
+	struct spi_flash_sfdp_suspend suspend;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_sfdp_testing_init_expectations (test, &flash, SFDP_HEADER_MX25L1606E,
+		FLASH_ID_MX25L1606E);
+
+	status = spi_flash_sfdp_init (&sfdp, &flash.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&flash, 0, (uint8_t*) SFDP_PARAMS_MX25L1606E,
+		SFDP_PARAMS_MX25L1606E_LEN,
+		FLASH_EXP_READ_CMD (0x5a, SFDP_PARAMS_ADDR_MX25L1606E, 1, -1, SFDP_PARAMS_MX25L1606E_LEN));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_sfdp_basic_table_init (&table, &sfdp);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_sfdp_get_suspend_info (&table, &suspend);
+	CuAssertIntEquals (test, SPI_FLASH_SFDP_SUSPEND_NOT_SUPPORTED, status);
+	CuAssertIntEquals (test, 0, suspend.erase_suspend);
+	CuAssertIntEquals (test, 0, suspend.erase_resume);
+	CuAssertIntEquals (test, 0, suspend.program_suspend);
+	CuAssertIntEquals (test, 0, suspend.program_resume);
+
+	status = flash_master_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_sfdp_basic_table_release (&table);
+	spi_flash_sfdp_release (&sfdp);
+}
+
+static void spi_flash_sfdp_test_get_suspend_info_mx25l25645g (CuTest *test)
+{
+	struct flash_master_mock flash;
+	struct spi_flash_sfdp sfdp;
+	struct spi_flash_sfdp_basic_table table;
+	struct spi_flash_sfdp_suspend suspend;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_sfdp_testing_init_expectations (test, &flash, SFDP_HEADER_MX25L25645G,
+		FLASH_ID_MX25L25645G);
+
+	status = spi_flash_sfdp_init (&sfdp, &flash.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&flash, 0, (uint8_t*) SFDP_PARAMS_MX25L25645G,
+		SFDP_PARAMS_MX25L25645G_LEN,
+		FLASH_EXP_READ_CMD (0x5a, SFDP_PARAMS_ADDR_MX25L25645G, 1, -1,
+			SFDP_PARAMS_MX25L25645G_LEN));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_sfdp_basic_table_init (&table, &sfdp);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_sfdp_get_suspend_info (&table, &suspend);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0xb0, suspend.erase_suspend);
+	CuAssertIntEquals (test, 0x30, suspend.erase_resume);
+	CuAssertIntEquals (test, 0xb0, suspend.program_suspend);
+	CuAssertIntEquals (test, 0x30, suspend.program_resume);
+	CuAssertIntEquals (test, 25, suspend.erase_suspend_us);
+	CuAssertIntEquals (test, 448, suspend.erase_resume_us);
+	CuAssertIntEquals (test, 25, suspend.program_suspend_us);
+	CuAssertIntEquals (test, 128, suspend.program_resume_us);
+
+	status = flash_master_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_sfdp_basic_table_release (&table);
+	spi_flash_sfdp_release (&sfdp);
+}
+
+static void spi_flash_sfdp_test_get_suspend_info_w25q256jv (CuTest *test)
+{
+	struct flash_master_mock flash;
+	struct spi_flash_sfdp sfdp;
+	struct spi_flash_sfdp_basic_table table;
+	struct spi_flash_sfdp_suspend suspend;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_sfdp_testing_init_expectations (test, &flash, SFDP_HEADER_W25Q256JV,
+		FLASH_ID_W25Q256JV);
+
+	status = spi_flash_sfdp_init (&sfdp, &flash.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&flash, 0, (uint8_t*) SFDP_PARAMS_W25Q256JV,
+		SFDP_PARAMS_W25Q256JV_LEN,
+		FLASH_EXP_READ_CMD (0x5a, SFDP_PARAMS_ADDR_W25Q256JV, 1, -1,
+			SFDP_PARAMS_W25Q256JV_LEN));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_sfdp_basic_table_init (&table, &sfdp);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_sfdp_get_suspend_info (&table, &suspend);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0x75, suspend.erase_suspend);
+	CuAssertIntEquals (test, 0x7a, suspend.erase_resume);
+	CuAssertIntEquals (test, 0x75, suspend.program_suspend);
+	CuAssertIntEquals (test, 0x7a, suspend.program_resume);
+	CuAssertIntEquals (test, 20, suspend.erase_suspend_us);
+	CuAssertIntEquals (test, 512, suspend.erase_resume_us);
+	CuAssertIntEquals (test, 20, suspend.program_suspend_us);
+	CuAssertIntEquals (test, 128, suspend.program_resume_us);
+
+	status = flash_master_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_sfdp_basic_table_release (&table);
+	spi_flash_sfdp_release (&sfdp);
+}
+
+static void spi_flash_sfdp_test_get_suspend_info_not_supported (CuTest *test)
+{
+	struct flash_master_mock flash;
+	struct spi_flash_sfdp sfdp;
+	struct spi_flash_sfdp_basic_table table;
+	struct spi_flash_sfdp_suspend suspend;
+	int status;
+	uint8_t id[] = {0x11, 0x22, 0x33};
+	uint32_t header[] = {
+		0x50444653,
+		0xff000106,
+		0x10010600,
+		0xff000010
+	};
+	uint32_t params[] = {
+		0xfffb20e5,
+		0x0fffffff,
+		0x6b08eb44,
+		0xbb423b08,
+		0xfffffffe,
+		0x0000ffff,
+		0xeb40ffff,
+		0x520f200c,
+		0x0000d810,
+		0x00a60236,
+		0xd314ea82,
+		0xb37663e9,
+		0x757a757a,
+		0x5cd5a2f7,
+		0xff4df719,
+		0xa5f968e9
+	};
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_sfdp_testing_init_expectations (test, &flash, header, id);
+
+	status = spi_flash_sfdp_init (&sfdp, &flash.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&flash, 0, (uint8_t*) params, sizeof (params),
+		FLASH_EXP_READ_CMD (0x5a, 0x000010, 1, -1, sizeof (params)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_sfdp_basic_table_init (&table, &sfdp);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_sfdp_get_suspend_info (&table, &suspend);
+	CuAssertIntEquals (test, SPI_FLASH_SFDP_SUSPEND_NOT_SUPPORTED, status);
+	CuAssertIntEquals (test, 0, suspend.erase_suspend);
+	CuAssertIntEquals (test, 0, suspend.erase_resume);
+	CuAssertIntEquals (test, 0, suspend.program_suspend);
+	CuAssertIntEquals (test, 0, suspend.program_resume);
+
+	status = flash_master_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_sfdp_basic_table_release (&table);
+	spi_flash_sfdp_release (&sfdp);
+}
+
+static void spi_flash_sfdp_test_get_suspend_info_null (CuTest *test)
+{
+	struct flash_master_mock flash;
+	struct spi_flash_sfdp sfdp;
+	struct spi_flash_sfdp_basic_table table;
+	struct spi_flash_sfdp_suspend suspend;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_sfdp_testing_init_expectations (test, &flash, SFDP_HEADER_W25Q256JV,
+		FLASH_ID_W25Q256JV);
+
+	status = spi_flash_sfdp_init (&sfdp, &flash.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&flash, 0, (uint8_t*) SFDP_PARAMS_W25Q256JV,
+		SFDP_PARAMS_W25Q256JV_LEN,
+		FLASH_EXP_READ_CMD (0x5a, SFDP_PARAMS_ADDR_W25Q256JV, 1, -1, SFDP_PARAMS_W25Q256JV_LEN));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_sfdp_basic_table_init (&table, &sfdp);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_sfdp_get_suspend_info (NULL, &suspend);
+	CuAssertIntEquals (test, SPI_FLASH_SFDP_INVALID_ARGUMENT, status);
+
+	status = spi_flash_sfdp_get_suspend_info (&table, NULL);
+	CuAssertIntEquals (test, SPI_FLASH_SFDP_INVALID_ARGUMENT, status);
+
+	status = flash_master_mock_validate_and_release (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_sfdp_basic_table_release (&table);
+	spi_flash_sfdp_release (&sfdp);
+}
+
 
 TEST_SUITE_START (spi_flash_sfdp);
 
@@ -10444,5 +10716,10 @@ TEST (spi_flash_sfdp_test_get_deep_powerdown_commands_non_standard);
 TEST (spi_flash_sfdp_test_get_deep_powerdown_commands_not_supported);
 TEST (spi_flash_sfdp_test_get_deep_powerdown_commands_old_table_version);
 TEST (spi_flash_sfdp_test_get_deep_powerdown_commands_null);
+TEST (spi_flash_sfdp_test_get_suspend_info_mx25l1606e);
+TEST (spi_flash_sfdp_test_get_suspend_info_mx25l25645g);
+TEST (spi_flash_sfdp_test_get_suspend_info_w25q256jv);
+TEST (spi_flash_sfdp_test_get_suspend_info_not_supported);
+TEST (spi_flash_sfdp_test_get_suspend_info_null);
 
 TEST_SUITE_END;
@@ -9,6 +9,7 @@
 #include "flash/spi_flash_static.h"
 #include "flash/spi_flash_sfdp.h"
 #include "flash/flash_common.h"
+#include "common/unused.h"
 #include "testing/mock/flash/flash_master_mock.h"
 #include "testing/flash/spi_flash_sfdp_testing.h"
 
@@ -154,6 +155,26 @@ void spi_flash_testing_discover_params_fast_read (CuTest *test, struct spi_flash
 		params_len, params_addr, capabilities, true);
 }
 
+/**
+ * Mock action to simulate a read in another context that was not able to resume the active write.
+ *
+ * @param expected The expectation for the status read.  The context is the flash state.
+ * @param called The actual status read call.
+ *
+ * @return 0 to process the status read normally.
+ */
+static int64_t spi_flash_testing_fail_resume (const struct mock_call *expected,
+	const struct mock_call *called)
+{
+	struct spi_flash_state *state = expected->context;
+
+	UNUSED (called);
+
+	state->resume_failed = true;
+
+	return 0;
+}
+
 /*******************
  * Test cases
  *******************/
@@ -13808,6 +13829,1132 @@ static void spi_flash_test_wait_for_write_error (CuTest *test)
 	spi_flash_release (&flash);
 }
 
+static void spi_flash_test_enable_wip_tracking_read_after_write (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	struct spi_flash_xfer_stats stats;
+	int status;
+	uint8_t cmd_expected[] = {0x01, 0x02, 0x03, 0x04};
+	uint8_t data_in[sizeof (cmd_expected)];
+	uint8_t read_status = 0;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_enable_wip_tracking (&flash, true);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
+	status |= flash_master_mock_expect_tx_xfer (&mock, 0,
+		FLASH_EXP_WRITE_CMD (0x02, 0x1234, 0, cmd_expected, sizeof (cmd_expected)));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, cmd_expected, sizeof (cmd_expected),
+		FLASH_EXP_READ_CMD (0x03, 0x1234, 0, data_in, sizeof (data_in)));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, cmd_expected, sizeof (cmd_expected),
+		FLASH_EXP_READ_CMD (0x03, 0x1234, 0, data_in, sizeof (data_in)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_write (&flash, 0x1234, cmd_expected, sizeof (cmd_expected));
+	CuAssertIntEquals (test, sizeof (cmd_expected), status);
+
+	status = spi_flash_read (&flash, 0x1234, data_in, sizeof (data_in));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (cmd_expected, data_in, sizeof (data_in));
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_read (&flash, 0x1234, data_in, sizeof (data_in));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_get_xfer_stats (&flash, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 6, stats.xfers);
+	CuAssertIntEquals (test, 2, stats.status_polls);
+	CuAssertIntEquals (test, 2, stats.status_polls_skipped);
+
+	flash_master_mock_release (&mock);
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_enable_wip_tracking_erase_after_read (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	struct spi_flash_xfer_stats stats;
+	int status;
+	uint8_t data[] = {1, 2, 3, 4};
+	uint8_t data_in[sizeof (data)];
+	uint8_t read_status = 0;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_enable_wip_tracking (&flash, true);
+	CuAssertIntEquals (test, 0, status);
+
+	/* The first operation must check the device status. */
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, data, sizeof (data),
+		FLASH_EXP_READ_CMD (0x03, 0x1234, 0, data_in, sizeof (data_in)));
+
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_CMD (0x20, 0x1000));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, data, sizeof (data),
+		FLASH_EXP_READ_CMD (0x03, 0x1234, 0, data_in, sizeof (data_in)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_read (&flash, 0x1234, data_in, sizeof (data_in));
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_sector_erase (&flash, 0x1234);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_read (&flash, 0x1234, data_in, sizeof (data_in));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_get_xfer_stats (&flash, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 6, stats.xfers);
+	CuAssertIntEquals (test, 2, stats.status_polls);
+	CuAssertIntEquals (test, 2, stats.status_polls_skipped);
+
+	flash_master_mock_release (&mock);
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_enable_wip_tracking_write_in_progress (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	int status;
+	uint8_t data[] = {1, 2, 3, 4};
+	uint8_t data_in[sizeof (data)];
+	uint8_t wip_status = FLASH_STATUS_WIP;
+	uint8_t read_status = 0;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_enable_wip_tracking (&flash, true);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &wip_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, data, sizeof (data),
+		FLASH_EXP_READ_CMD (0x03, 0x1234, 0, data_in, sizeof (data_in)));
+
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, data, sizeof (data),
+		FLASH_EXP_READ_CMD (0x03, 0x1234, 0, data_in, sizeof (data_in)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_read (&flash, 0x1234, data_in, sizeof (data_in));
+	CuAssertIntEquals (test, SPI_FLASH_WRITE_IN_PROGRESS, status);
+
+	status = spi_flash_read (&flash, 0x1234, data_in, sizeof (data_in));
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_read (&flash, 0x1234, data_in, sizeof (data_in));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_master_mock_release (&mock);
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_enable_wip_tracking_write_failed (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	int status;
+	uint8_t data[] = {1, 2, 3, 4};
+	uint8_t data_in[sizeof (data)];
+	uint8_t read_status = 0;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_enable_wip_tracking (&flash, true);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
+	status |= flash_master_mock_expect_tx_xfer (&mock, FLASH_MASTER_XFER_FAILED,
+		FLASH_EXP_WRITE_CMD (0x02, 0x1234, 0, data, sizeof (data)));
+
+	/* The state of the device is unknown after the failure, so the status must be checked. */
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, data, sizeof (data),
+		FLASH_EXP_READ_CMD (0x03, 0x1234, 0, data_in, sizeof (data_in)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_write (&flash, 0x1234, data, sizeof (data));
+	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+
+	status = spi_flash_read (&flash, 0x1234, data_in, sizeof (data_in));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_master_mock_release (&mock);
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_enable_wip_tracking_reset_device (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	int status;
+	uint8_t data[] = {1, 2, 3, 4};
+	uint8_t data_in[sizeof (data)];
+	uint8_t read_status = 0;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_enable_wip_tracking (&flash, true);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, data, sizeof (data),
+		FLASH_EXP_READ_CMD (0x03, 0x1234, 0, data_in, sizeof (data_in)));
+
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_OPCODE (0x66));
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_OPCODE (0x99));
+
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, data, sizeof (data),
+		FLASH_EXP_READ_CMD (0x03, 0x1234, 0, data_in, sizeof (data_in)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_read (&flash, 0x1234, data_in, sizeof (data_in));
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_force_reset_device (&flash, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_read (&flash, 0x1234, data_in, sizeof (data_in));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_master_mock_release (&mock);
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_enable_wip_tracking_disable (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	struct spi_flash_xfer_stats stats;
+	int status;
+	uint8_t data[] = {1, 2, 3, 4};
+	uint8_t data_in[sizeof (data)];
+	uint8_t read_status = 0;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_enable_wip_tracking (&flash, true);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, data, sizeof (data),
+		FLASH_EXP_READ_CMD (0x03, 0x1234, 0, data_in, sizeof (data_in)));
+
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, data, sizeof (data),
+		FLASH_EXP_READ_CMD (0x03, 0x1234, 0, data_in, sizeof (data_in)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_read (&flash, 0x1234, data_in, sizeof (data_in));
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_enable_wip_tracking (&flash, false);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_read (&flash, 0x1234, data_in, sizeof (data_in));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_get_xfer_stats (&flash, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 4, stats.xfers);
+	CuAssertIntEquals (test, 2, stats.status_polls);
+	CuAssertIntEquals (test, 0, stats.status_polls_skipped);
+
+	flash_master_mock_release (&mock);
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_enable_wip_tracking_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = spi_flash_enable_wip_tracking (NULL, true);
+	CuAssertIntEquals (test, SPI_FLASH_INVALID_ARGUMENT, status);
+}
+
+static void spi_flash_test_get_xfer_stats_no_tracking (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	struct spi_flash_xfer_stats stats;
+	int status;
+	uint8_t data[] = {1, 2, 3, 4};
+	uint8_t data_in[sizeof (data)];
+	uint8_t read_status = 0;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_get_xfer_stats (&flash, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, stats.xfers);
+	CuAssertIntEquals (test, 0, stats.status_polls);
+	CuAssertIntEquals (test, 0, stats.status_polls_skipped);
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, data, sizeof (data),
+		FLASH_EXP_READ_CMD (0x03, 0x1234, 0, data_in, sizeof (data_in)));
+
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, data, sizeof (data),
+		FLASH_EXP_READ_CMD (0x03, 0x1234, 0, data_in, sizeof (data_in)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_read (&flash, 0x1234, data_in, sizeof (data_in));
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_read (&flash, 0x1234, data_in, sizeof (data_in));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_get_xfer_stats (&flash, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 4, stats.xfers);
+	CuAssertIntEquals (test, 2, stats.status_polls);
+	CuAssertIntEquals (test, 0, stats.status_polls_skipped);
+
+	status = spi_flash_reset_xfer_stats (&flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_get_xfer_stats (&flash, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, stats.xfers);
+	CuAssertIntEquals (test, 0, stats.status_polls);
+	CuAssertIntEquals (test, 0, stats.status_polls_skipped);
+
+	flash_master_mock_release (&mock);
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_get_xfer_stats_null (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	struct spi_flash_xfer_stats stats;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_get_xfer_stats (NULL, &stats);
+	CuAssertIntEquals (test, SPI_FLASH_INVALID_ARGUMENT, status);
+
+	status = spi_flash_get_xfer_stats (&flash, NULL);
+	CuAssertIntEquals (test, SPI_FLASH_INVALID_ARGUMENT, status);
+
+	status = spi_flash_reset_xfer_stats (NULL);
+	CuAssertIntEquals (test, SPI_FLASH_INVALID_ARGUMENT, status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_master_mock_release (&mock);
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_enable_suspend (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	int status;
+
+	TEST_START;
+
+	spi_flash_testing_discover_params (test, &flash, &state, &mock, FLASH_ID_W25Q256JV,
+		SFDP_HEADER_W25Q256JV, SFDP_PARAMS_W25Q256JV, SFDP_PARAMS_W25Q256JV_LEN,
+		SFDP_PARAMS_ADDR_W25Q256JV, FULL_CAPABILITIES);
+
+	CuAssertIntEquals (test, 0x75, state.suspend.erase_suspend);
+	CuAssertIntEquals (test, 0x7a, state.suspend.erase_resume);
+	CuAssertIntEquals (test, 0x75, state.suspend.program_suspend);
+	CuAssertIntEquals (test, 0x7a, state.suspend.program_resume);
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, FLASH_ID_W25Q256JV, FLASH_ID_LEN,
+		FLASH_EXP_READ_REG (0x9f, FLASH_ID_LEN));
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_enable_suspend (&flash, SPI_FLASH_SUSPEND_ERASE | SPI_FLASH_SUSPEND_PROGRAM);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, SPI_FLASH_SUSPEND_ERASE | SPI_FLASH_SUSPEND_PROGRAM,
+		state.suspend_ops);
+
+	status = spi_flash_enable_suspend (&flash, 0);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, state.suspend_ops);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_master_mock_release (&mock);
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_enable_suspend_not_supported (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	state.device_id[0] = FLASH_ID_WINBOND;
+
+	status = spi_flash_enable_suspend (&flash, SPI_FLASH_SUSPEND_ERASE);
+	CuAssertIntEquals (test, SPI_FLASH_SUSPEND_NOT_SUPPORTED, status);
+
+	status = spi_flash_enable_suspend (&flash, SPI_FLASH_SUSPEND_PROGRAM);
+	CuAssertIntEquals (test, SPI_FLASH_SUSPEND_NOT_SUPPORTED, status);
+
+	state.suspend.erase_suspend = 0xb0;
+	state.suspend.erase_resume = 0x30;
+
+	status = spi_flash_enable_suspend (&flash, SPI_FLASH_SUSPEND_ERASE | SPI_FLASH_SUSPEND_PROGRAM);
+	CuAssertIntEquals (test, SPI_FLASH_SUSPEND_NOT_SUPPORTED, status);
+	CuAssertIntEquals (test, 0, state.suspend_ops);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_master_mock_release (&mock);
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_enable_suspend_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = spi_flash_enable_suspend (NULL, SPI_FLASH_SUSPEND_ERASE);
+	CuAssertIntEquals (test, SPI_FLASH_INVALID_ARGUMENT, status);
+}
+
+static void spi_flash_test_enable_suspend_sector_erase (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	int status;
+	uint8_t read_status = 0;
+	uint8_t busy_status = FLASH_STATUS_WIP;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	state.device_id[0] = FLASH_ID_WINBOND;
+
+	state.suspend.erase_suspend = 0x75;
+	state.suspend.erase_resume = 0x7a;
+
+	status = spi_flash_enable_suspend (&flash, SPI_FLASH_SUSPEND_ERASE);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_CMD (0x20, 0x10000));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &busy_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_sector_erase (&flash, 0x10100);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, state.active_op);
+	CuAssertIntEquals (test, 0x10000, state.active_addr);
+	CuAssertIntEquals (test, FLASH_SECTOR_SIZE, state.active_length);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_master_mock_release (&mock);
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_enable_suspend_write (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	int status;
+	uint8_t data[] = {1, 2, 3, 4};
+	uint8_t read_status = 0;
+	uint8_t busy_status = FLASH_STATUS_WIP;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	state.device_id[0] = FLASH_ID_WINBOND;
+
+	state.suspend.program_suspend = 0x75;
+	state.suspend.program_resume = 0x7a;
+
+	status = spi_flash_enable_suspend (&flash, SPI_FLASH_SUSPEND_PROGRAM);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
+	status |= flash_master_mock_expect_tx_xfer (&mock, 0,
+		FLASH_EXP_WRITE_CMD (0x02, 0x1234, 0, data, sizeof (data)));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &busy_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_write (&flash, 0x1234, data, sizeof (data));
+	CuAssertIntEquals (test, sizeof (data), status);
+	CuAssertIntEquals (test, 0, state.active_op);
+	CuAssertIntEquals (test, 0x1234, state.active_addr);
+	CuAssertIntEquals (test, sizeof (data), state.active_length);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_master_mock_release (&mock);
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_enable_suspend_read_during_erase (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	struct spi_flash_xfer_stats stats;
+	int status;
+	uint8_t data[] = {1, 2, 3, 4};
+	uint8_t data_in[sizeof (data)];
+	uint8_t read_status = 0;
+	uint8_t busy_status = FLASH_STATUS_WIP;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	state.device_id[0] = FLASH_ID_WINBOND;
+
+	state.suspend.erase_suspend = 0x75;
+	state.suspend.erase_resume = 0x7a;
+	state.suspend.erase_suspend_us = 20;
+	state.suspend.erase_resume_us = 512;
+
+	status = spi_flash_enable_suspend (&flash, SPI_FLASH_SUSPEND_ERASE);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Simulate a sector erase executing in another context. */
+	state.active_op = SPI_FLASH_SUSPEND_ERASE;
+	state.active_addr = 0x10000;
+	state.active_length = FLASH_SECTOR_SIZE;
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &busy_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_OPCODE (0x75));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, data, sizeof (data),
+		FLASH_EXP_READ_CMD (0x03, 0x1234, 0, data_in, sizeof (data_in)));
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_OPCODE (0x7a));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_REG (0x35, 1));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_read (&flash, 0x1234, data_in, sizeof (data_in));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (data, data_in, sizeof (data_in));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_get_xfer_stats (&flash, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, stats.suspends);
+
+	state.active_op = 0;
+
+	flash_master_mock_release (&mock);
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_enable_suspend_read_during_erase_same_sector (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	struct spi_flash_xfer_stats stats;
+	int status;
+	uint8_t data[] = {1, 2, 3, 4};
+	uint8_t data_in[sizeof (data)];
+	uint8_t read_status = 0;
+	uint8_t busy_status = FLASH_STATUS_WIP;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	state.device_id[0] = FLASH_ID_WINBOND;
+
+	state.suspend.erase_suspend = 0x75;
+	state.suspend.erase_resume = 0x7a;
+
+	status = spi_flash_enable_suspend (&flash, SPI_FLASH_SUSPEND_ERASE);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Simulate a sector erase executing in another context. */
+	state.active_op = SPI_FLASH_SUSPEND_ERASE;
+	state.active_addr = 0x10000;
+	state.active_length = FLASH_SECTOR_SIZE;
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &busy_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &busy_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, data, sizeof (data),
+		FLASH_EXP_READ_CMD (0x03, 0x10ffe, 0, data_in, sizeof (data_in)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_read (&flash, 0x10ffe, data_in, sizeof (data_in));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (data, data_in, sizeof (data_in));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_get_xfer_stats (&flash, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, stats.suspends);
+
+	state.active_op = 0;
+
+	flash_master_mock_release (&mock);
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_enable_suspend_read_suspend_error (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	int status;
+	uint8_t data_in[4];
+	uint8_t busy_status = FLASH_STATUS_WIP;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	state.device_id[0] = FLASH_ID_WINBOND;
+
+	state.suspend.erase_suspend = 0x75;
+	state.suspend.erase_resume = 0x7a;
+
+	status = spi_flash_enable_suspend (&flash, SPI_FLASH_SUSPEND_ERASE);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Simulate a sector erase executing in another context. */
+	state.active_op = SPI_FLASH_SUSPEND_ERASE;
+	state.active_addr = 0x10000;
+	state.active_length = FLASH_SECTOR_SIZE;
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &busy_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, FLASH_MASTER_XFER_FAILED,
+		FLASH_EXP_OPCODE (0x75));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_read (&flash, 0x1234, data_in, sizeof (data_in));
+	CuAssertIntEquals (test, FLASH_MASTER_XFER_FAILED, status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	state.active_op = 0;
+
+	flash_master_mock_release (&mock);
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_enable_suspend_unknown_vendor (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	int status;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	state.device_id[0] = FLASH_ID_SPANSION;
+	state.suspend.erase_suspend = 0x75;
+	state.suspend.erase_resume = 0x7a;
+	state.suspend.program_suspend = 0x75;
+	state.suspend.program_resume = 0x7a;
+
+	status = spi_flash_enable_suspend (&flash, SPI_FLASH_SUSPEND_ERASE);
+	CuAssertIntEquals (test, SPI_FLASH_SUSPEND_NOT_SUPPORTED, status);
+	CuAssertIntEquals (test, 0, state.suspend_ops);
+
+	status = spi_flash_enable_suspend (&flash, SPI_FLASH_SUSPEND_PROGRAM);
+	CuAssertIntEquals (test, SPI_FLASH_SUSPEND_NOT_SUPPORTED, status);
+	CuAssertIntEquals (test, 0, state.suspend_ops);
+
+	status = spi_flash_enable_suspend (&flash, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_master_mock_release (&mock);
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_enable_suspend_read_during_write_micron (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	int status;
+	uint8_t data[] = {1, 2, 3, 4};
+	uint8_t data_in[sizeof (data)];
+	uint8_t read_status = 0;
+	uint8_t busy_status = FLASH_STATUS_WIP;
+	uint8_t erase_suspended = 0x40;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	state.device_id[0] = FLASH_ID_MICRON;
+	state.suspend.program_suspend = 0x75;
+	state.suspend.program_resume = 0x7a;
+
+	status = spi_flash_enable_suspend (&flash, SPI_FLASH_SUSPEND_PROGRAM);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Simulate a page program executing in another context. */
+	state.active_op = SPI_FLASH_SUSPEND_PROGRAM;
+	state.active_addr = 0x10000;
+	state.active_length = 256;
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &busy_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_OPCODE (0x75));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, data, sizeof (data),
+		FLASH_EXP_READ_CMD (0x03, 0x1234, 0, data_in, sizeof (data_in)));
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_OPCODE (0x7a));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &erase_suspended, 1,
+		FLASH_EXP_READ_REG (0x70, 1));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_read (&flash, 0x1234, data_in, sizeof (data_in));
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, false, state.resume_failed);
+
+	status = testing_validate_array (data, data_in, sizeof (data_in));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	state.active_op = 0;
+
+	flash_master_mock_release (&mock);
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_enable_suspend_read_resume_retry (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	int status;
+	uint8_t data[] = {1, 2, 3, 4};
+	uint8_t data_in[sizeof (data)];
+	uint8_t read_status = 0;
+	uint8_t busy_status = FLASH_STATUS_WIP;
+	uint8_t suspended = 0x08;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	state.device_id[0] = FLASH_ID_MACRONIX;
+	state.suspend.erase_suspend = 0xb0;
+	state.suspend.erase_resume = 0x30;
+
+	status = spi_flash_enable_suspend (&flash, SPI_FLASH_SUSPEND_ERASE);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Simulate a sector erase executing in another context. */
+	state.active_op = SPI_FLASH_SUSPEND_ERASE;
+	state.active_addr = 0x10000;
+	state.active_length = FLASH_SECTOR_SIZE;
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &busy_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_OPCODE (0xb0));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, data, sizeof (data),
+		FLASH_EXP_READ_CMD (0x03, 0x1234, 0, data_in, sizeof (data_in)));
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_OPCODE (0x30));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &suspended, 1,
+		FLASH_EXP_READ_REG (0x2b, 1));
+	status |= flash_master_mock_expect_xfer (&mock, FLASH_MASTER_XFER_FAILED,
+		FLASH_EXP_OPCODE (0x30));
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_OPCODE (0x30));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_REG (0x2b, 1));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_read (&flash, 0x1234, data_in, sizeof (data_in));
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, false, state.resume_failed);
+
+	status = testing_validate_array (data, data_in, sizeof (data_in));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	state.active_op = 0;
+
+	flash_master_mock_release (&mock);
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_enable_suspend_read_resume_failed (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	int status;
+	uint8_t data[] = {1, 2, 3, 4};
+	uint8_t data_in[sizeof (data)];
+	uint8_t read_status = 0;
+	uint8_t busy_status = FLASH_STATUS_WIP;
+	uint8_t suspended = 0x80;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	state.device_id[0] = FLASH_ID_WINBOND;
+	state.suspend.erase_suspend = 0x75;
+	state.suspend.erase_resume = 0x7a;
+
+	status = spi_flash_enable_suspend (&flash, SPI_FLASH_SUSPEND_ERASE);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Simulate a sector erase executing in another context. */
+	state.active_op = SPI_FLASH_SUSPEND_ERASE;
+	state.active_addr = 0x10000;
+	state.active_length = FLASH_SECTOR_SIZE;
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &busy_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_OPCODE (0x75));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, data, sizeof (data),
+		FLASH_EXP_READ_CMD (0x03, 0x1234, 0, data_in, sizeof (data_in)));
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_OPCODE (0x7a));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &suspended, 1,
+		FLASH_EXP_READ_REG (0x35, 1));
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_OPCODE (0x7a));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &suspended, 1,
+		FLASH_EXP_READ_REG (0x35, 1));
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_OPCODE (0x7a));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &suspended, 1,
+		FLASH_EXP_READ_REG (0x35, 1));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_read (&flash, 0x1234, data_in, sizeof (data_in));
+	CuAssertIntEquals (test, SPI_FLASH_RESUME_FAILED, status);
+	CuAssertIntEquals (test, true, state.resume_failed);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	state.active_op = 0;
+
+	flash_master_mock_release (&mock);
+	spi_flash_release (&flash);
+}
+
+static void spi_flash_test_enable_suspend_sector_erase_resume_failed (CuTest *test)
+{
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct flash_master_mock mock;
+	int status;
+	uint8_t read_status = 0;
+	uint8_t busy_status = FLASH_STATUS_WIP;
+
+	TEST_START;
+
+	status = flash_master_mock_init (&mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	state.device_id[0] = FLASH_ID_WINBOND;
+	state.suspend.erase_suspend = 0x75;
+	state.suspend.erase_resume = 0x7a;
+
+	status = spi_flash_enable_suspend (&flash, SPI_FLASH_SUSPEND_ERASE);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_WRITE_ENABLE);
+	status |= flash_master_mock_expect_xfer (&mock, 0, FLASH_EXP_ERASE_CMD (0x20, 0x10000));
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &busy_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= mock_expect_external_action (&mock.mock, spi_flash_testing_fail_resume, &state);
+	status |= flash_master_mock_expect_rx_xfer (&mock, 0, &read_status, 1,
+		FLASH_EXP_READ_STATUS_REG);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_sector_erase (&flash, 0x10100);
+	CuAssertIntEquals (test, SPI_FLASH_RESUME_FAILED, status);
+	CuAssertIntEquals (test, 0, state.active_op);
+	CuAssertIntEquals (test, false, state.resume_failed);
+
+	status = mock_validate (&mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	flash_master_mock_release (&mock);
+	spi_flash_release (&flash);
+}
+
 static void spi_flash_test_enable_quad_spi_no_quad_enable (CuTest *test)
 {
 	struct spi_flash_state state;
@@ -27171,6 +28318,28 @@ TEST (spi_flash_test_wait_for_write_timeout);
 TEST (spi_flash_test_wait_for_write_immediate_timeout);
 TEST (spi_flash_test_wait_for_write_no_timeout);
 TEST (spi_flash_test_wait_for_write_error);
+TEST (spi_flash_test_enable_wip_tracking_read_after_write);
+TEST (spi_flash_test_enable_wip_tracking_erase_after_read);
+TEST (spi_flash_test_enable_wip_tracking_write_in_progress);
+TEST (spi_flash_test_enable_wip_tracking_write_failed);
+TEST (spi_flash_test_enable_wip_tracking_reset_device);
+TEST (spi_flash_test_enable_wip_tracking_disable);
+TEST (spi_flash_test_enable_wip_tracking_null);
+TEST (spi_flash_test_get_xfer_stats_no_tracking);
+TEST (spi_flash_test_get_xfer_stats_null);
+TEST (spi_flash_test_enable_suspend);
+TEST (spi_flash_test_enable_suspend_not_supported);
+TEST (spi_flash_test_enable_suspend_null);
+TEST (spi_flash_test_enable_suspend_sector_erase);
+TEST (spi_flash_test_enable_suspend_write);
+TEST (spi_flash_test_enable_suspend_read_during_erase);
+TEST (spi_flash_test_enable_suspend_read_during_erase_same_sector);
+TEST (spi_flash_test_enable_suspend_read_suspend_error);
+TEST (spi_flash_test_enable_suspend_unknown_vendor);
+TEST (spi_flash_test_enable_suspend_read_during_write_micron);
+TEST (spi_flash_test_enable_suspend_read_resume_retry);
+TEST (spi_flash_test_enable_suspend_read_resume_failed);
+TEST (spi_flash_test_enable_suspend_sector_erase_resume_failed);
 TEST (spi_flash_test_enable_quad_spi_no_quad_enable);
 TEST (spi_flash_test_enable_quad_spi_no_quad_enable_hold_disable_flag_status_register);
 TEST (spi_flash_test_enable_quad_spi_no_quad_enable_hold_disable_volatile_write_enable);
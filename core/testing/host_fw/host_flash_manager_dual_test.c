@@ -420,6 +420,7 @@ static void host_flash_manager_dual_test_init (CuTest *test)
 	CuAssertPtrNotNull (test, manager.test.base.set_flash_for_host_access);
 	CuAssertPtrNotNull (test, manager.test.base.host_has_flash_access);
 	CuAssertPtrNotNull (test, manager.test.base.reset_flash);
+	CuAssertPtrNotNull (test, manager.test.base.invalidate_verified_flash);
 
 	host_flash_manager_dual_testing_validate_and_release (test, &manager);
 }
@@ -546,6 +547,32 @@ static void host_flash_manager_dual_test_release_null (CuTest *test)
 	host_flash_manager_dual_release (NULL);
 }
 
+static void host_flash_manager_dual_test_set_verify_cache_null (CuTest *test)
+{
+	struct host_flash_verify_cache_entry entries[2];
+	struct host_flash_verify_cache cache;
+	struct spi_filter_interface_mock filter;
+	uint8_t bitmap[2];
+	int status;
+
+	TEST_START;
+
+	status = spi_filter_interface_mock_init (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_flash_verify_cache_init (&cache, &filter.base, entries, 2, bitmap,
+		sizeof (bitmap));
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_flash_manager_dual_set_verify_cache (NULL, &cache, &cache);
+	CuAssertIntEquals (test, HOST_FLASH_MGR_INVALID_ARGUMENT, status);
+
+	status = spi_filter_interface_mock_validate_and_release (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_verify_cache_release (&cache);
+}
+
 static void host_flash_manager_dual_test_get_read_only_flash_cs0 (CuTest *test)
 {
 	struct host_flash_manager_dual_testing manager;
@@ -6289,70 +6316,906 @@ static void host_flash_manager_dual_test_validate_read_write_flash_multiple_fw (
 	version_list[2].versions = &version[2];
 	version_list[2].count = 1;
 
-	img_region[0].start_addr = 0;
-	img_region[0].length = strlen (img_data1);
+	img_region[0].start_addr = 0;
+	img_region[0].length = strlen (img_data1);
+
+	sig[0].regions = &img_region[0];
+	sig[0].count = 1;
+	memcpy (&sig[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig[0].sig_length = RSA_ENCRYPT_LEN;
+	sig[0].always_validate = 1;
+
+	img_list[0].images_sig = &sig[0];
+	img_list[0].images_hash = NULL;
+	img_list[0].count = 1;
+
+	img_region[1].start_addr = 0x300;
+	img_region[1].length = strlen (img_data2);
+
+	sig[1].regions = &img_region[1];
+	sig[1].count = 1;
+	memcpy (&sig[1].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[1].signature, RSA_SIGNATURE_TEST2, RSA_ENCRYPT_LEN);
+	sig[1].sig_length = RSA_ENCRYPT_LEN;
+	sig[1].always_validate = 1;
+
+	img_list[1].images_sig = &sig[1];
+	img_list[1].images_hash = NULL;
+	img_list[1].count = 1;
+
+	img_region[2].start_addr = 0x600;
+	img_region[2].length = strlen (img_data3);
+
+	sig[2].regions = &img_region[2];
+	sig[2].count = 1;
+	memcpy (&sig[2].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[2].signature, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN);
+	sig[2].sig_length = RSA_ENCRYPT_LEN;
+	sig[2].always_validate = 1;
+
+	img_list[2].images_sig = &sig[2];
+	img_list[2].images_hash = NULL;
+	img_list[2].count = 1;
+
+	rw_region[0].start_addr = 0x200;
+	rw_region[0].length = 0x100;
+	rw_region[1].start_addr = 0x500;
+	rw_region[1].length = 0x100;
+	rw_region[2].start_addr = 0x800;
+	rw_region[2].length = 0x100;
+
+	rw_prop[0].on_failure = PFM_RW_DO_NOTHING;
+	rw_prop[1].on_failure = PFM_RW_DO_NOTHING;
+	rw_prop[2].on_failure = PFM_RW_DO_NOTHING;
+
+	rw_list[0].regions = &rw_region[0];
+	rw_list[0].properties = &rw_prop[0];
+	rw_list[0].count = 1;
+
+	rw_list[1].regions = &rw_region[1];
+	rw_list[1].properties = &rw_prop[1];
+	rw_list[1].count = 1;
+
+	rw_list[2].regions = &rw_region[2];
+	rw_list[2].properties = &rw_prop[2];
+	rw_list[2].count = 1;
+
+	status = spi_flash_set_device_size (&manager.flash0, 0x1000);
+	status |= spi_flash_set_device_size (&manager.flash1, 0x1000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&manager.pfm.mock, manager.pfm.base.get_firmware, &manager.pfm, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 0, &fw_list, sizeof (fw_list), -1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 0, 3);
+
+	/* FW 1 */
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.get_supported_versions, &manager.pfm,
+		0, MOCK_ARG_PTR_CONTAINS (fw_exp[0], strlen (fw_exp[0]) + 1), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 1, &version_list[0], sizeof (version_list[0]),
+		-1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 1, 0);
+
+	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock1, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock1, 0, (uint8_t*) version_exp1,
+		strlen (version_exp1), FLASH_EXP_READ_CMD (0x03, 0x123, 0, -1, strlen (version_exp1)));
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.get_firmware_images, &manager.pfm, 0,
+		MOCK_ARG_PTR_CONTAINS (fw_exp[0], strlen (fw_exp[0]) + 1),
+		MOCK_ARG_PTR_CONTAINS (version_exp1, strlen (version_exp1) + 1), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 2, &img_list[0], sizeof (img_list[0]), -1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 2, 1);
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.get_read_write_regions, &manager.pfm,
+		0, MOCK_ARG_PTR_CONTAINS (fw_exp[0], strlen (fw_exp[0]) + 1),
+		MOCK_ARG_PTR_CONTAINS (version_exp1, strlen (version_exp1) + 1), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 2, &rw_list[0], sizeof (rw_list[0]), -1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 2, 2);
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.free_fw_versions, &manager.pfm, 0,
+		MOCK_ARG_SAVED_ARG (0));
+
+	/* FW 2 */
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.get_supported_versions, &manager.pfm,
+		0, MOCK_ARG_PTR_CONTAINS (fw_exp[1], strlen (fw_exp[1]) + 1), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 1, &version_list[1], sizeof (version_list[1]),
+		-1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 1, 4);
+
+	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock1, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock1, 0, (uint8_t*) version_exp2,
+		strlen (version_exp2), FLASH_EXP_READ_CMD (0x03, 0x456, 0, -1, strlen (version_exp2)));
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.get_firmware_images, &manager.pfm, 0,
+		MOCK_ARG_PTR_CONTAINS (fw_exp[1], strlen (fw_exp[1]) + 1),
+		MOCK_ARG_PTR_CONTAINS (version_exp2, strlen (version_exp2) + 1), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 2, &img_list[1], sizeof (img_list[1]), -1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 2, 5);
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.get_read_write_regions, &manager.pfm,
+		0, MOCK_ARG_PTR_CONTAINS (fw_exp[1], strlen (fw_exp[1]) + 1),
+		MOCK_ARG_PTR_CONTAINS (version_exp2, strlen (version_exp2) + 1), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 2, &rw_list[1], sizeof (rw_list[1]), -1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 2, 6);
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.free_fw_versions, &manager.pfm, 0,
+		MOCK_ARG_SAVED_ARG (4));
+
+	/* FW 3 */
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.get_supported_versions, &manager.pfm,
+		0, MOCK_ARG_PTR_CONTAINS (fw_exp[2], strlen (fw_exp[2]) + 1), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 1, &version_list[2], sizeof (version_list[2]),
+		-1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 1, 7);
+
+	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock1, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock1, 0, (uint8_t*) version_exp3,
+		strlen (version_exp3), FLASH_EXP_READ_CMD (0x03, 0x789, 0, -1, strlen (version_exp3)));
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.get_firmware_images, &manager.pfm, 0,
+		MOCK_ARG_PTR_CONTAINS (fw_exp[2], strlen (fw_exp[2]) + 1),
+		MOCK_ARG_PTR_CONTAINS (version_exp3, strlen (version_exp3) + 1), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 2, &img_list[2], sizeof (img_list[2]), -1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 2, 8);
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.get_read_write_regions, &manager.pfm,
+		0, MOCK_ARG_PTR_CONTAINS (fw_exp[2], strlen (fw_exp[2]) + 1),
+		MOCK_ARG_PTR_CONTAINS (version_exp3, strlen (version_exp3) + 1), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 2, &rw_list[2], sizeof (rw_list[2]), -1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 2, 9);
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.free_fw_versions, &manager.pfm, 0,
+		MOCK_ARG_SAVED_ARG (7));
+
+	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock1, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock1, 0, (uint8_t*) img_data1,
+		strlen (img_data1), FLASH_EXP_READ_CMD (0x03, 0x000, 0, -1, strlen (img_data1)));
+
+	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock1, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock1, 0, (uint8_t*) img_data2,
+		strlen (img_data2), FLASH_EXP_READ_CMD (0x03, 0x300, 0, -1, strlen (img_data2)));
+
+	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock1, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock1, 0, (uint8_t*) img_data3,
+		strlen (img_data3), FLASH_EXP_READ_CMD (0x03, 0x600, 0, -1, strlen (img_data3)));
+
+	status |= flash_master_mock_expect_blank_check (&manager.flash_mock1,
+		0x000 + strlen (img_data1), 0x200 - strlen (img_data1));
+	status |= flash_master_mock_expect_blank_check (&manager.flash_mock1,
+		0x300 + strlen (img_data2), 0x200 - strlen (img_data2));
+	status |= flash_master_mock_expect_blank_check (&manager.flash_mock1,
+		0x600 + strlen (img_data3), 0x200 - strlen (img_data3));
+	status |= flash_master_mock_expect_blank_check (&manager.flash_mock1, 0x900, 0x1000 - 0x900);
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.free_firmware_images, &manager.pfm,
+		0, MOCK_ARG_SAVED_ARG (1));
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.free_firmware_images, &manager.pfm,
+		0, MOCK_ARG_SAVED_ARG (5));
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.free_firmware_images, &manager.pfm,
+		0, MOCK_ARG_SAVED_ARG (8));
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.free_firmware, &manager.pfm, 0,
+		MOCK_ARG_SAVED_ARG (3));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = manager.test.base.validate_read_write_flash (&manager.test.base, &manager.pfm.base,
+		&manager.hash.base, &manager.rsa.base, &rw_output);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 3, rw_output.count);
+	CuAssertPtrNotNull (test, rw_output.writable);
+	CuAssertPtrEquals (test, &manager.pfm, rw_output.pfm);
+
+	CuAssertIntEquals (test, 1, rw_output.writable[0].count);
+	CuAssertPtrEquals (test, &rw_region[0], (void*) rw_output.writable[0].regions);
+	CuAssertPtrEquals (test, &rw_prop[0], (void*) rw_output.writable[0].properties);
+
+	CuAssertIntEquals (test, 1, rw_output.writable[1].count);
+	CuAssertPtrEquals (test, &rw_region[1], (void*) rw_output.writable[1].regions);
+	CuAssertPtrEquals (test, &rw_prop[1], (void*) rw_output.writable[1].properties);
+
+	CuAssertIntEquals (test, 1, rw_output.writable[2].count);
+	CuAssertPtrEquals (test, &rw_region[2], (void*) rw_output.writable[2].regions);
+	CuAssertPtrEquals (test, &rw_prop[2], (void*) rw_output.writable[2].properties);
+
+	status = mock_validate (&manager.flash_mock1.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&manager.pfm.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&manager.pfm.mock, manager.pfm.base.free_read_write_regions, &manager.pfm,
+		0, MOCK_ARG_SAVED_ARG (2));
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.free_read_write_regions,
+		&manager.pfm, 0, MOCK_ARG_SAVED_ARG (6));
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.free_read_write_regions,
+		&manager.pfm, 0, MOCK_ARG_SAVED_ARG (9));
+
+	CuAssertIntEquals (test, 0, status);
+
+	manager.test.base.free_read_write_regions (&manager.test.base, &rw_output);
+
+	host_flash_manager_dual_testing_validate_and_release (test, &manager);
+}
+
+static void host_flash_manager_dual_test_validate_read_write_flash_with_cache (CuTest *test)
+{
+	struct host_flash_manager_dual_testing manager;
+	struct pfm_firmware fw_list;
+	const char *fw_exp = NULL;
+	struct pfm_firmware_version version;
+	struct pfm_firmware_versions version_list;
+	const char *version_exp = "1234";
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	char *img_data = "Test";
+	struct flash_region rw_region;
+	struct pfm_read_write rw_prop;
+	struct pfm_read_write_regions rw_list;
+	struct host_flash_manager_rw_regions rw_output;
+	struct host_flash_verify_cache_entry entries[2];
+	struct host_flash_verify_cache cache;
+	uint8_t bitmap[2];
+	uint8_t clean[2] = {0};
+	uint32_t block_size = 0x100;
+	int status;
+
+	TEST_START;
+
+	host_flash_manager_dual_testing_init (test, &manager, false);
+
+	spi_filter_interface_mock_enable_dirty_block_tracking (&manager.filter);
+
+	status = host_flash_verify_cache_init (&cache, &manager.filter.base, entries, 2, bitmap,
+		sizeof (bitmap));
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_flash_manager_dual_set_verify_cache (&manager.test, &cache, &cache);
+	CuAssertIntEquals (test, 0, status);
+
+	fw_list.ids = &fw_exp;
+	fw_list.count = 1;
+
+	version.fw_version_id = version_exp;
+	version.version_addr = 0x123;
+	version.blank_byte = 0xff;
+
+	version_list.versions = &version;
+	version_list.count = 1;
+
+	img_region.start_addr = 0;
+	img_region.length = strlen (img_data);
+
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
+
+	img_list.images_sig = &sig;
+	img_list.images_hash = NULL;
+	img_list.count = 1;
+
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
+
+	rw_prop.on_failure = PFM_RW_DO_NOTHING;
+
+	rw_list.regions = &rw_region;
+	rw_list.properties = &rw_prop;
+	rw_list.count = 1;
+
+	status = spi_flash_set_device_size (&manager.flash0, 0x1000);
+	status |= spi_flash_set_device_size (&manager.flash1, 0x1000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&manager.pfm.mock, manager.pfm.base.get_firmware, &manager.pfm, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 0, &fw_list, sizeof (fw_list), -1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 0, 3);
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.get_supported_versions, &manager.pfm,
+		0, MOCK_ARG_PTR (NULL), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 1, &version_list, sizeof (version_list), -1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 1, 0);
+
+	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock1, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock1, 0, (uint8_t*) version_exp,
+		strlen (version_exp), FLASH_EXP_READ_CMD (0x03, 0x123, 0, -1, strlen (version_exp)));
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.get_firmware_images, &manager.pfm, 0,
+		MOCK_ARG_PTR (NULL), MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1),
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 2, &img_list, sizeof (img_list), -1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 2, 1);
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.get_read_write_regions, &manager.pfm,
+		0, MOCK_ARG_PTR (NULL), MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1),
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 2, &rw_list, sizeof (rw_list), -1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 2, 2);
+
+	status |= mock_expect (&manager.filter.mock, manager.filter.base.get_dirty_block_bitmap,
+		&manager.filter, 0, MOCK_ARG (SPI_FILTER_CS_1), MOCK_ARG (true), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (sizeof (bitmap)), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output_tmp (&manager.filter.mock, 2, clean, sizeof (clean), 3);
+	status |= mock_expect_output_tmp (&manager.filter.mock, 4, &block_size, sizeof (block_size),
+		-1);
+
+	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock1, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock1, 0, (uint8_t*) img_data,
+		strlen (img_data), FLASH_EXP_READ_CMD (0x03, 0, 0, -1, strlen (img_data)));
+
+	status |= flash_master_mock_expect_blank_check (&manager.flash_mock1, 0 + strlen (img_data),
+		0x200 - strlen (img_data));
+	status |= flash_master_mock_expect_blank_check (&manager.flash_mock1, 0x300, 0x1000 - 0x300);
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.free_fw_versions, &manager.pfm, 0,
+		MOCK_ARG_SAVED_ARG (0));
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.free_firmware_images, &manager.pfm,
+		0, MOCK_ARG_SAVED_ARG (1));
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.free_firmware, &manager.pfm, 0,
+		MOCK_ARG_SAVED_ARG (3));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = manager.test.base.validate_read_write_flash (&manager.test.base, &manager.pfm.base,
+		&manager.hash.base, &manager.rsa.base, &rw_output);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 1, rw_output.count);
+	CuAssertPtrNotNull (test, rw_output.writable);
+	CuAssertPtrEquals (test, &manager.pfm, rw_output.pfm);
+
+	status = mock_validate (&manager.flash_mock1.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&manager.pfm.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&manager.pfm.mock, manager.pfm.base.free_read_write_regions, &manager.pfm,
+		0, MOCK_ARG_SAVED_ARG (2));
+	CuAssertIntEquals (test, 0, status);
+
+	manager.test.base.free_read_write_regions (&manager.test.base, &rw_output);
+
+	/* The flash has not been written by the host, so only the version needs to be read. */
+	status = mock_expect (&manager.pfm.mock, manager.pfm.base.get_firmware, &manager.pfm, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 0, &fw_list, sizeof (fw_list), -1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 0, 7);
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.get_supported_versions, &manager.pfm,
+		0, MOCK_ARG_PTR (NULL), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 1, &version_list, sizeof (version_list), -1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 1, 4);
+
+	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock1, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock1, 0, (uint8_t*) version_exp,
+		strlen (version_exp), FLASH_EXP_READ_CMD (0x03, 0x123, 0, -1, strlen (version_exp)));
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.get_firmware_images, &manager.pfm, 0,
+		MOCK_ARG_PTR (NULL), MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1),
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 2, &img_list, sizeof (img_list), -1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 2, 5);
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.get_read_write_regions, &manager.pfm,
+		0, MOCK_ARG_PTR (NULL), MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1),
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 2, &rw_list, sizeof (rw_list), -1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 2, 6);
+
+	status |= mock_expect (&manager.filter.mock, manager.filter.base.get_dirty_block_bitmap,
+		&manager.filter, 0, MOCK_ARG (SPI_FILTER_CS_1), MOCK_ARG (true), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (sizeof (bitmap)), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output_tmp (&manager.filter.mock, 2, clean, sizeof (clean), 3);
+	status |= mock_expect_output_tmp (&manager.filter.mock, 4, &block_size, sizeof (block_size),
+		-1);
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.free_fw_versions, &manager.pfm, 0,
+		MOCK_ARG_SAVED_ARG (4));
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.free_firmware_images, &manager.pfm,
+		0, MOCK_ARG_SAVED_ARG (5));
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.free_firmware, &manager.pfm, 0,
+		MOCK_ARG_SAVED_ARG (7));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = manager.test.base.validate_read_write_flash (&manager.test.base, &manager.pfm.base,
+		&manager.hash.base, &manager.rsa.base, &rw_output);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 1, rw_output.count);
+	CuAssertPtrNotNull (test, rw_output.writable);
+	CuAssertPtrEquals (test, &manager.pfm, rw_output.pfm);
+
+	status = mock_validate (&manager.flash_mock1.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&manager.pfm.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&manager.pfm.mock, manager.pfm.base.free_read_write_regions, &manager.pfm,
+		0, MOCK_ARG_SAVED_ARG (6));
+	CuAssertIntEquals (test, 0, status);
+
+	manager.test.base.free_read_write_regions (&manager.test.base, &rw_output);
+
+	host_flash_manager_dual_testing_validate_and_release (test, &manager);
+	host_flash_verify_cache_release (&cache);
+}
+
+static void host_flash_manager_dual_test_validate_read_write_flash_with_cache_invalidated (
+	CuTest *test)
+{
+	struct host_flash_manager_dual_testing manager;
+	struct pfm_firmware fw_list;
+	const char *fw_exp = NULL;
+	struct pfm_firmware_version version;
+	struct pfm_firmware_versions version_list;
+	const char *version_exp = "1234";
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	char *img_data = "Test";
+	struct flash_region rw_region;
+	struct pfm_read_write rw_prop;
+	struct pfm_read_write_regions rw_list;
+	struct host_flash_manager_rw_regions rw_output;
+	struct host_flash_verify_cache_entry entries[2];
+	struct host_flash_verify_cache cache;
+	uint8_t bitmap[2];
+	uint8_t clean[2] = {0};
+	uint32_t block_size = 0x100;
+	int status;
+
+	TEST_START;
+
+	host_flash_manager_dual_testing_init (test, &manager, false);
+
+	spi_filter_interface_mock_enable_dirty_block_tracking (&manager.filter);
+
+	status = host_flash_verify_cache_init (&cache, &manager.filter.base, entries, 2, bitmap,
+		sizeof (bitmap));
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_flash_manager_dual_set_verify_cache (&manager.test, &cache, &cache);
+	CuAssertIntEquals (test, 0, status);
+
+	fw_list.ids = &fw_exp;
+	fw_list.count = 1;
+
+	version.fw_version_id = version_exp;
+	version.version_addr = 0x123;
+	version.blank_byte = 0xff;
+
+	version_list.versions = &version;
+	version_list.count = 1;
+
+	img_region.start_addr = 0;
+	img_region.length = strlen (img_data);
+
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
+
+	img_list.images_sig = &sig;
+	img_list.images_hash = NULL;
+	img_list.count = 1;
+
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
+
+	rw_prop.on_failure = PFM_RW_DO_NOTHING;
+
+	rw_list.regions = &rw_region;
+	rw_list.properties = &rw_prop;
+	rw_list.count = 1;
+
+	status = spi_flash_set_device_size (&manager.flash0, 0x1000);
+	status |= spi_flash_set_device_size (&manager.flash1, 0x1000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&manager.pfm.mock, manager.pfm.base.get_firmware, &manager.pfm, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 0, &fw_list, sizeof (fw_list), -1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 0, 3);
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.get_supported_versions, &manager.pfm,
+		0, MOCK_ARG_PTR (NULL), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 1, &version_list, sizeof (version_list), -1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 1, 0);
+
+	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock1, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock1, 0, (uint8_t*) version_exp,
+		strlen (version_exp), FLASH_EXP_READ_CMD (0x03, 0x123, 0, -1, strlen (version_exp)));
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.get_firmware_images, &manager.pfm, 0,
+		MOCK_ARG_PTR (NULL), MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1),
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 2, &img_list, sizeof (img_list), -1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 2, 1);
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.get_read_write_regions, &manager.pfm,
+		0, MOCK_ARG_PTR (NULL), MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1),
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 2, &rw_list, sizeof (rw_list), -1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 2, 2);
+
+	status |= mock_expect (&manager.filter.mock, manager.filter.base.get_dirty_block_bitmap,
+		&manager.filter, 0, MOCK_ARG (SPI_FILTER_CS_1), MOCK_ARG (true), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (sizeof (bitmap)), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output_tmp (&manager.filter.mock, 2, clean, sizeof (clean), 3);
+	status |= mock_expect_output_tmp (&manager.filter.mock, 4, &block_size, sizeof (block_size),
+		-1);
+
+	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock1, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock1, 0, (uint8_t*) img_data,
+		strlen (img_data), FLASH_EXP_READ_CMD (0x03, 0, 0, -1, strlen (img_data)));
+
+	status |= flash_master_mock_expect_blank_check (&manager.flash_mock1, 0 + strlen (img_data),
+		0x200 - strlen (img_data));
+	status |= flash_master_mock_expect_blank_check (&manager.flash_mock1, 0x300, 0x1000 - 0x300);
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.free_fw_versions, &manager.pfm, 0,
+		MOCK_ARG_SAVED_ARG (0));
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.free_firmware_images, &manager.pfm,
+		0, MOCK_ARG_SAVED_ARG (1));
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.free_firmware, &manager.pfm, 0,
+		MOCK_ARG_SAVED_ARG (3));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = manager.test.base.validate_read_write_flash (&manager.test.base, &manager.pfm.base,
+		&manager.hash.base, &manager.rsa.base, &rw_output);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 1, rw_output.count);
+	CuAssertPtrNotNull (test, rw_output.writable);
+	CuAssertPtrEquals (test, &manager.pfm, rw_output.pfm);
+
+	status = mock_validate (&manager.flash_mock1.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&manager.pfm.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&manager.pfm.mock, manager.pfm.base.free_read_write_regions, &manager.pfm,
+		0, MOCK_ARG_SAVED_ARG (2));
+	CuAssertIntEquals (test, 0, status);
+
+	manager.test.base.free_read_write_regions (&manager.test.base, &rw_output);
+
+	/* The RoT modified the flash, so everything needs to be checked again. */
+	manager.test.base.invalidate_verified_flash (&manager.test.base);
+
+	status = mock_expect (&manager.pfm.mock, manager.pfm.base.get_firmware, &manager.pfm, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 0, &fw_list, sizeof (fw_list), -1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 0, 7);
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.get_supported_versions, &manager.pfm,
+		0, MOCK_ARG_PTR (NULL), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 1, &version_list, sizeof (version_list), -1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 1, 4);
+
+	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock1, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock1, 0, (uint8_t*) version_exp,
+		strlen (version_exp), FLASH_EXP_READ_CMD (0x03, 0x123, 0, -1, strlen (version_exp)));
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.get_firmware_images, &manager.pfm, 0,
+		MOCK_ARG_PTR (NULL), MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1),
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 2, &img_list, sizeof (img_list), -1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 2, 5);
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.get_read_write_regions, &manager.pfm,
+		0, MOCK_ARG_PTR (NULL), MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1),
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 2, &rw_list, sizeof (rw_list), -1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 2, 6);
+
+	status |= mock_expect (&manager.filter.mock, manager.filter.base.get_dirty_block_bitmap,
+		&manager.filter, 0, MOCK_ARG (SPI_FILTER_CS_1), MOCK_ARG (true), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (sizeof (bitmap)), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output_tmp (&manager.filter.mock, 2, clean, sizeof (clean), 3);
+	status |= mock_expect_output_tmp (&manager.filter.mock, 4, &block_size, sizeof (block_size),
+		-1);
+
+	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock1, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock1, 0, (uint8_t*) img_data,
+		strlen (img_data), FLASH_EXP_READ_CMD (0x03, 0, 0, -1, strlen (img_data)));
+
+	status |= flash_master_mock_expect_blank_check (&manager.flash_mock1, 0 + strlen (img_data),
+		0x200 - strlen (img_data));
+	status |= flash_master_mock_expect_blank_check (&manager.flash_mock1, 0x300, 0x1000 - 0x300);
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.free_fw_versions, &manager.pfm, 0,
+		MOCK_ARG_SAVED_ARG (4));
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.free_firmware_images, &manager.pfm,
+		0, MOCK_ARG_SAVED_ARG (5));
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.free_firmware, &manager.pfm, 0,
+		MOCK_ARG_SAVED_ARG (7));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = manager.test.base.validate_read_write_flash (&manager.test.base, &manager.pfm.base,
+		&manager.hash.base, &manager.rsa.base, &rw_output);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 1, rw_output.count);
+	CuAssertPtrNotNull (test, rw_output.writable);
+	CuAssertPtrEquals (test, &manager.pfm, rw_output.pfm);
+
+	status = mock_validate (&manager.flash_mock1.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&manager.pfm.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&manager.pfm.mock, manager.pfm.base.free_read_write_regions, &manager.pfm,
+		0, MOCK_ARG_SAVED_ARG (6));
+	CuAssertIntEquals (test, 0, status);
+
+	manager.test.base.free_read_write_regions (&manager.test.base, &rw_output);
+
+	host_flash_manager_dual_testing_validate_and_release (test, &manager);
+	host_flash_verify_cache_release (&cache);
+}
+
+static void host_flash_manager_dual_test_validate_read_write_flash_with_cache_claimed (
+	CuTest *test)
+{
+	struct host_flash_manager_dual_testing manager;
+	struct pfm_firmware fw_list;
+	const char *fw_exp = NULL;
+	struct pfm_firmware_version version;
+	struct pfm_firmware_versions version_list;
+	const char *version_exp = "1234";
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	char *img_data = "Test";
+	struct flash_region rw_region;
+	struct pfm_read_write rw_prop;
+	struct pfm_read_write_regions rw_list;
+	struct host_flash_manager_rw_regions rw_output;
+	struct host_flash_verify_cache_entry entries[2];
+	struct host_flash_verify_cache cache;
+	uint8_t bitmap[2];
+	bool claimed;
+	int status;
+
+	TEST_START;
+
+	host_flash_manager_dual_testing_init (test, &manager, false);
+
+	spi_filter_interface_mock_enable_dirty_block_tracking (&manager.filter);
+
+	status = host_flash_verify_cache_init (&cache, &manager.filter.base, entries, 2, bitmap,
+		sizeof (bitmap));
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_flash_manager_dual_set_verify_cache (&manager.test, &cache, &cache);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Simulate validation of the other flash device in progress. */
+	claimed = host_flash_verify_cache_claim (&cache);
+	CuAssertIntEquals (test, true, claimed);
+
+	fw_list.ids = &fw_exp;
+	fw_list.count = 1;
+
+	version.fw_version_id = version_exp;
+	version.version_addr = 0x123;
+	version.blank_byte = 0xff;
+
+	version_list.versions = &version;
+	version_list.count = 1;
+
+	img_region.start_addr = 0;
+	img_region.length = strlen (img_data);
+
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
+
+	img_list.images_sig = &sig;
+	img_list.images_hash = NULL;
+	img_list.count = 1;
+
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
+
+	rw_prop.on_failure = PFM_RW_DO_NOTHING;
+
+	rw_list.regions = &rw_region;
+	rw_list.properties = &rw_prop;
+	rw_list.count = 1;
+
+	status = spi_flash_set_device_size (&manager.flash0, 0x1000);
+	status |= spi_flash_set_device_size (&manager.flash1, 0x1000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&manager.pfm.mock, manager.pfm.base.get_firmware, &manager.pfm, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 0, &fw_list, sizeof (fw_list), -1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 0, 3);
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.get_supported_versions, &manager.pfm,
+		0, MOCK_ARG_PTR (NULL), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 1, &version_list, sizeof (version_list), -1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 1, 0);
+
+	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock1, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock1, 0, (uint8_t*) version_exp,
+		strlen (version_exp), FLASH_EXP_READ_CMD (0x03, 0x123, 0, -1, strlen (version_exp)));
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.get_firmware_images, &manager.pfm, 0,
+		MOCK_ARG_PTR (NULL), MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1),
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 2, &img_list, sizeof (img_list), -1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 2, 1);
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.get_read_write_regions, &manager.pfm,
+		0, MOCK_ARG_PTR (NULL), MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1),
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 2, &rw_list, sizeof (rw_list), -1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 2, 2);
+
+	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock1, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock1, 0, (uint8_t*) img_data,
+		strlen (img_data), FLASH_EXP_READ_CMD (0x03, 0, 0, -1, strlen (img_data)));
+
+	status |= flash_master_mock_expect_blank_check (&manager.flash_mock1, 0 + strlen (img_data),
+		0x200 - strlen (img_data));
+	status |= flash_master_mock_expect_blank_check (&manager.flash_mock1, 0x300, 0x1000 - 0x300);
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.free_fw_versions, &manager.pfm, 0,
+		MOCK_ARG_SAVED_ARG (0));
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.free_firmware_images, &manager.pfm,
+		0, MOCK_ARG_SAVED_ARG (1));
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.free_firmware, &manager.pfm, 0,
+		MOCK_ARG_SAVED_ARG (3));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = manager.test.base.validate_read_write_flash (&manager.test.base, &manager.pfm.base,
+		&manager.hash.base, &manager.rsa.base, &rw_output);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 1, rw_output.count);
+	CuAssertPtrNotNull (test, rw_output.writable);
+	CuAssertPtrEquals (test, &manager.pfm, rw_output.pfm);
+
+	status = mock_validate (&manager.flash_mock1.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&manager.pfm.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&manager.pfm.mock, manager.pfm.base.free_read_write_regions, &manager.pfm,
+		0, MOCK_ARG_SAVED_ARG (2));
+	CuAssertIntEquals (test, 0, status);
+
+	manager.test.base.free_read_write_regions (&manager.test.base, &rw_output);
+
+	/* The cache must still be owned by the other validation. */
+	claimed = host_flash_verify_cache_claim (&cache);
+	CuAssertIntEquals (test, false, claimed);
+
+	host_flash_verify_cache_unclaim (&cache);
+
+	host_flash_manager_dual_testing_validate_and_release (test, &manager);
+	host_flash_verify_cache_release (&cache);
+}
+
+static void host_flash_manager_dual_test_validate_read_write_flash_with_cache_per_device (
+	CuTest *test)
+{
+	struct host_flash_manager_dual_testing manager;
+	struct pfm_firmware fw_list;
+	const char *fw_exp = NULL;
+	struct pfm_firmware_version version;
+	struct pfm_firmware_versions version_list;
+	const char *version_exp = "1234";
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	char *img_data = "Test";
+	struct flash_region rw_region;
+	struct pfm_read_write rw_prop;
+	struct pfm_read_write_regions rw_list;
+	struct host_flash_manager_rw_regions rw_output;
+	struct host_flash_verify_cache_entry entries[2];
+	struct host_flash_verify_cache cache;
+	uint8_t bitmap[2];
+	struct host_flash_verify_cache_entry ro_entries[2];
+	struct host_flash_verify_cache ro_cache;
+	uint8_t ro_bitmap[2];
+	bool claimed;
+	uint8_t clean[2] = {0};
+	uint32_t block_size = 0x100;
+	int status;
+
+	TEST_START;
 
-	sig[0].regions = &img_region[0];
-	sig[0].count = 1;
-	memcpy (&sig[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig[0].sig_length = RSA_ENCRYPT_LEN;
-	sig[0].always_validate = 1;
+	host_flash_manager_dual_testing_init (test, &manager, false);
 
-	img_list[0].images_sig = &sig[0];
-	img_list[0].images_hash = NULL;
-	img_list[0].count = 1;
+	spi_filter_interface_mock_enable_dirty_block_tracking (&manager.filter);
 
-	img_region[1].start_addr = 0x300;
-	img_region[1].length = strlen (img_data2);
+	status = host_flash_verify_cache_init (&cache, &manager.filter.base, entries, 2, bitmap,
+		sizeof (bitmap));
+	CuAssertIntEquals (test, 0, status);
 
-	sig[1].regions = &img_region[1];
-	sig[1].count = 1;
-	memcpy (&sig[1].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig[1].signature, RSA_SIGNATURE_TEST2, RSA_ENCRYPT_LEN);
-	sig[1].sig_length = RSA_ENCRYPT_LEN;
-	sig[1].always_validate = 1;
+	status = host_flash_verify_cache_init (&ro_cache, &manager.filter.base, ro_entries, 2,
+		ro_bitmap, sizeof (ro_bitmap));
+	CuAssertIntEquals (test, 0, status);
 
-	img_list[1].images_sig = &sig[1];
-	img_list[1].images_hash = NULL;
-	img_list[1].count = 1;
+	status = host_flash_manager_dual_set_verify_cache (&manager.test, &ro_cache, &cache);
+	CuAssertIntEquals (test, 0, status);
 
-	img_region[2].start_addr = 0x600;
-	img_region[2].length = strlen (img_data3);
+	/* Simulate validation of the read-only flash in progress. */
+	claimed = host_flash_verify_cache_claim (&ro_cache);
+	CuAssertIntEquals (test, true, claimed);
 
-	sig[2].regions = &img_region[2];
-	sig[2].count = 1;
-	memcpy (&sig[2].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig[2].signature, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN);
-	sig[2].sig_length = RSA_ENCRYPT_LEN;
-	sig[2].always_validate = 1;
+	fw_list.ids = &fw_exp;
+	fw_list.count = 1;
 
-	img_list[2].images_sig = &sig[2];
-	img_list[2].images_hash = NULL;
-	img_list[2].count = 1;
+	version.fw_version_id = version_exp;
+	version.version_addr = 0x123;
+	version.blank_byte = 0xff;
 
-	rw_region[0].start_addr = 0x200;
-	rw_region[0].length = 0x100;
-	rw_region[1].start_addr = 0x500;
-	rw_region[1].length = 0x100;
-	rw_region[2].start_addr = 0x800;
-	rw_region[2].length = 0x100;
+	version_list.versions = &version;
+	version_list.count = 1;
 
-	rw_prop[0].on_failure = PFM_RW_DO_NOTHING;
-	rw_prop[1].on_failure = PFM_RW_DO_NOTHING;
-	rw_prop[2].on_failure = PFM_RW_DO_NOTHING;
+	img_region.start_addr = 0;
+	img_region.length = strlen (img_data);
 
-	rw_list[0].regions = &rw_region[0];
-	rw_list[0].properties = &rw_prop[0];
-	rw_list[0].count = 1;
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
 
-	rw_list[1].regions = &rw_region[1];
-	rw_list[1].properties = &rw_prop[1];
-	rw_list[1].count = 1;
+	img_list.images_sig = &sig;
+	img_list.images_hash = NULL;
+	img_list.count = 1;
 
-	rw_list[2].regions = &rw_region[2];
-	rw_list[2].properties = &rw_prop[2];
-	rw_list[2].count = 1;
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
+
+	rw_prop.on_failure = PFM_RW_DO_NOTHING;
+
+	rw_list.regions = &rw_region;
+	rw_list.properties = &rw_prop;
+	rw_list.count = 1;
 
 	status = spi_flash_set_device_size (&manager.flash0, 0x1000);
 	status |= spi_flash_set_device_size (&manager.flash1, 0x1000);
@@ -6363,118 +7226,114 @@ static void host_flash_manager_dual_test_validate_read_write_flash_multiple_fw (
 	status |= mock_expect_output (&manager.pfm.mock, 0, &fw_list, sizeof (fw_list), -1);
 	status |= mock_expect_save_arg (&manager.pfm.mock, 0, 3);
 
-	/* FW 1 */
 	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.get_supported_versions, &manager.pfm,
-		0, MOCK_ARG_PTR_CONTAINS (fw_exp[0], strlen (fw_exp[0]) + 1), MOCK_ARG_NOT_NULL);
-	status |= mock_expect_output (&manager.pfm.mock, 1, &version_list[0], sizeof (version_list[0]),
-		-1);
+		0, MOCK_ARG_PTR (NULL), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 1, &version_list, sizeof (version_list), -1);
 	status |= mock_expect_save_arg (&manager.pfm.mock, 1, 0);
 
 	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock1, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock1, 0, (uint8_t*) version_exp1,
-		strlen (version_exp1), FLASH_EXP_READ_CMD (0x03, 0x123, 0, -1, strlen (version_exp1)));
+	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock1, 0, (uint8_t*) version_exp,
+		strlen (version_exp), FLASH_EXP_READ_CMD (0x03, 0x123, 0, -1, strlen (version_exp)));
 
 	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.get_firmware_images, &manager.pfm, 0,
-		MOCK_ARG_PTR_CONTAINS (fw_exp[0], strlen (fw_exp[0]) + 1),
-		MOCK_ARG_PTR_CONTAINS (version_exp1, strlen (version_exp1) + 1), MOCK_ARG_NOT_NULL);
-	status |= mock_expect_output (&manager.pfm.mock, 2, &img_list[0], sizeof (img_list[0]), -1);
+		MOCK_ARG_PTR (NULL), MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1),
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 2, &img_list, sizeof (img_list), -1);
 	status |= mock_expect_save_arg (&manager.pfm.mock, 2, 1);
 
 	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.get_read_write_regions, &manager.pfm,
-		0, MOCK_ARG_PTR_CONTAINS (fw_exp[0], strlen (fw_exp[0]) + 1),
-		MOCK_ARG_PTR_CONTAINS (version_exp1, strlen (version_exp1) + 1), MOCK_ARG_NOT_NULL);
-	status |= mock_expect_output (&manager.pfm.mock, 2, &rw_list[0], sizeof (rw_list[0]), -1);
+		0, MOCK_ARG_PTR (NULL), MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1),
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 2, &rw_list, sizeof (rw_list), -1);
 	status |= mock_expect_save_arg (&manager.pfm.mock, 2, 2);
 
-	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.free_fw_versions, &manager.pfm, 0,
-		MOCK_ARG_SAVED_ARG (0));
-
-	/* FW 2 */
-	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.get_supported_versions, &manager.pfm,
-		0, MOCK_ARG_PTR_CONTAINS (fw_exp[1], strlen (fw_exp[1]) + 1), MOCK_ARG_NOT_NULL);
-	status |= mock_expect_output (&manager.pfm.mock, 1, &version_list[1], sizeof (version_list[1]),
+	status |= mock_expect (&manager.filter.mock, manager.filter.base.get_dirty_block_bitmap,
+		&manager.filter, 0, MOCK_ARG (SPI_FILTER_CS_1), MOCK_ARG (true), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (sizeof (bitmap)), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output_tmp (&manager.filter.mock, 2, clean, sizeof (clean), 3);
+	status |= mock_expect_output_tmp (&manager.filter.mock, 4, &block_size, sizeof (block_size),
 		-1);
-	status |= mock_expect_save_arg (&manager.pfm.mock, 1, 4);
 
 	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock1, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock1, 0, (uint8_t*) version_exp2,
-		strlen (version_exp2), FLASH_EXP_READ_CMD (0x03, 0x456, 0, -1, strlen (version_exp2)));
-
-	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.get_firmware_images, &manager.pfm, 0,
-		MOCK_ARG_PTR_CONTAINS (fw_exp[1], strlen (fw_exp[1]) + 1),
-		MOCK_ARG_PTR_CONTAINS (version_exp2, strlen (version_exp2) + 1), MOCK_ARG_NOT_NULL);
-	status |= mock_expect_output (&manager.pfm.mock, 2, &img_list[1], sizeof (img_list[1]), -1);
-	status |= mock_expect_save_arg (&manager.pfm.mock, 2, 5);
+	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock1, 0, (uint8_t*) img_data,
+		strlen (img_data), FLASH_EXP_READ_CMD (0x03, 0, 0, -1, strlen (img_data)));
 
-	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.get_read_write_regions, &manager.pfm,
-		0, MOCK_ARG_PTR_CONTAINS (fw_exp[1], strlen (fw_exp[1]) + 1),
-		MOCK_ARG_PTR_CONTAINS (version_exp2, strlen (version_exp2) + 1), MOCK_ARG_NOT_NULL);
-	status |= mock_expect_output (&manager.pfm.mock, 2, &rw_list[1], sizeof (rw_list[1]), -1);
-	status |= mock_expect_save_arg (&manager.pfm.mock, 2, 6);
+	status |= flash_master_mock_expect_blank_check (&manager.flash_mock1, 0 + strlen (img_data),
+		0x200 - strlen (img_data));
+	status |= flash_master_mock_expect_blank_check (&manager.flash_mock1, 0x300, 0x1000 - 0x300);
 
 	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.free_fw_versions, &manager.pfm, 0,
-		MOCK_ARG_SAVED_ARG (4));
+		MOCK_ARG_SAVED_ARG (0));
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.free_firmware_images, &manager.pfm,
+		0, MOCK_ARG_SAVED_ARG (1));
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.free_firmware, &manager.pfm, 0,
+		MOCK_ARG_SAVED_ARG (3));
 
-	/* FW 3 */
-	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.get_supported_versions, &manager.pfm,
-		0, MOCK_ARG_PTR_CONTAINS (fw_exp[2], strlen (fw_exp[2]) + 1), MOCK_ARG_NOT_NULL);
-	status |= mock_expect_output (&manager.pfm.mock, 1, &version_list[2], sizeof (version_list[2]),
-		-1);
-	status |= mock_expect_save_arg (&manager.pfm.mock, 1, 7);
+	CuAssertIntEquals (test, 0, status);
 
-	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock1, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock1, 0, (uint8_t*) version_exp3,
-		strlen (version_exp3), FLASH_EXP_READ_CMD (0x03, 0x789, 0, -1, strlen (version_exp3)));
+	status = manager.test.base.validate_read_write_flash (&manager.test.base, &manager.pfm.base,
+		&manager.hash.base, &manager.rsa.base, &rw_output);
+	CuAssertIntEquals (test, 0, status);
 
-	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.get_firmware_images, &manager.pfm, 0,
-		MOCK_ARG_PTR_CONTAINS (fw_exp[2], strlen (fw_exp[2]) + 1),
-		MOCK_ARG_PTR_CONTAINS (version_exp3, strlen (version_exp3) + 1), MOCK_ARG_NOT_NULL);
-	status |= mock_expect_output (&manager.pfm.mock, 2, &img_list[2], sizeof (img_list[2]), -1);
-	status |= mock_expect_save_arg (&manager.pfm.mock, 2, 8);
+	CuAssertIntEquals (test, 1, rw_output.count);
+	CuAssertPtrNotNull (test, rw_output.writable);
+	CuAssertPtrEquals (test, &manager.pfm, rw_output.pfm);
 
-	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.get_read_write_regions, &manager.pfm,
-		0, MOCK_ARG_PTR_CONTAINS (fw_exp[2], strlen (fw_exp[2]) + 1),
-		MOCK_ARG_PTR_CONTAINS (version_exp3, strlen (version_exp3) + 1), MOCK_ARG_NOT_NULL);
-	status |= mock_expect_output (&manager.pfm.mock, 2, &rw_list[2], sizeof (rw_list[2]), -1);
-	status |= mock_expect_save_arg (&manager.pfm.mock, 2, 9);
+	status = mock_validate (&manager.flash_mock1.mock);
+	CuAssertIntEquals (test, 0, status);
 
-	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.free_fw_versions, &manager.pfm, 0,
-		MOCK_ARG_SAVED_ARG (7));
+	status = mock_validate (&manager.pfm.mock);
+	CuAssertIntEquals (test, 0, status);
 
-	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock1, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock1, 0, (uint8_t*) img_data1,
-		strlen (img_data1), FLASH_EXP_READ_CMD (0x03, 0x000, 0, -1, strlen (img_data1)));
+	status = mock_expect (&manager.pfm.mock, manager.pfm.base.free_read_write_regions, &manager.pfm,
+		0, MOCK_ARG_SAVED_ARG (2));
+	CuAssertIntEquals (test, 0, status);
 
-	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock1, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock1, 0, (uint8_t*) img_data2,
-		strlen (img_data2), FLASH_EXP_READ_CMD (0x03, 0x300, 0, -1, strlen (img_data2)));
+	manager.test.base.free_read_write_regions (&manager.test.base, &rw_output);
+
+	/* The flash has not been written by the host, so only the version needs to be read. */
+	status = mock_expect (&manager.pfm.mock, manager.pfm.base.get_firmware, &manager.pfm, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 0, &fw_list, sizeof (fw_list), -1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 0, 7);
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.get_supported_versions, &manager.pfm,
+		0, MOCK_ARG_PTR (NULL), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 1, &version_list, sizeof (version_list), -1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 1, 4);
 
 	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock1, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock1, 0, (uint8_t*) img_data3,
-		strlen (img_data3), FLASH_EXP_READ_CMD (0x03, 0x600, 0, -1, strlen (img_data3)));
+	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock1, 0, (uint8_t*) version_exp,
+		strlen (version_exp), FLASH_EXP_READ_CMD (0x03, 0x123, 0, -1, strlen (version_exp)));
 
-	status |= flash_master_mock_expect_blank_check (&manager.flash_mock1,
-		0x000 + strlen (img_data1), 0x200 - strlen (img_data1));
-	status |= flash_master_mock_expect_blank_check (&manager.flash_mock1,
-		0x300 + strlen (img_data2), 0x200 - strlen (img_data2));
-	status |= flash_master_mock_expect_blank_check (&manager.flash_mock1,
-		0x600 + strlen (img_data3), 0x200 - strlen (img_data3));
-	status |= flash_master_mock_expect_blank_check (&manager.flash_mock1, 0x900, 0x1000 - 0x900);
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.get_firmware_images, &manager.pfm, 0,
+		MOCK_ARG_PTR (NULL), MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1),
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 2, &img_list, sizeof (img_list), -1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 2, 5);
 
-	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.free_firmware_images, &manager.pfm,
-		0, MOCK_ARG_SAVED_ARG (1));
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.get_read_write_regions, &manager.pfm,
+		0, MOCK_ARG_PTR (NULL), MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1),
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 2, &rw_list, sizeof (rw_list), -1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 2, 6);
+
+	status |= mock_expect (&manager.filter.mock, manager.filter.base.get_dirty_block_bitmap,
+		&manager.filter, 0, MOCK_ARG (SPI_FILTER_CS_1), MOCK_ARG (true), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (sizeof (bitmap)), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output_tmp (&manager.filter.mock, 2, clean, sizeof (clean), 3);
+	status |= mock_expect_output_tmp (&manager.filter.mock, 4, &block_size, sizeof (block_size),
+		-1);
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.free_fw_versions, &manager.pfm, 0,
+		MOCK_ARG_SAVED_ARG (4));
 	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.free_firmware_images, &manager.pfm,
 		0, MOCK_ARG_SAVED_ARG (5));
-	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.free_firmware_images, &manager.pfm,
-		0, MOCK_ARG_SAVED_ARG (8));
 	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.free_firmware, &manager.pfm, 0,
-		MOCK_ARG_SAVED_ARG (3));
+		MOCK_ARG_SAVED_ARG (7));
 
 	CuAssertIntEquals (test, 0, status);
 
@@ -6482,22 +7341,10 @@ static void host_flash_manager_dual_test_validate_read_write_flash_multiple_fw (
 		&manager.hash.base, &manager.rsa.base, &rw_output);
 	CuAssertIntEquals (test, 0, status);
 
-	CuAssertIntEquals (test, 3, rw_output.count);
+	CuAssertIntEquals (test, 1, rw_output.count);
 	CuAssertPtrNotNull (test, rw_output.writable);
 	CuAssertPtrEquals (test, &manager.pfm, rw_output.pfm);
 
-	CuAssertIntEquals (test, 1, rw_output.writable[0].count);
-	CuAssertPtrEquals (test, &rw_region[0], (void*) rw_output.writable[0].regions);
-	CuAssertPtrEquals (test, &rw_prop[0], (void*) rw_output.writable[0].properties);
-
-	CuAssertIntEquals (test, 1, rw_output.writable[1].count);
-	CuAssertPtrEquals (test, &rw_region[1], (void*) rw_output.writable[1].regions);
-	CuAssertPtrEquals (test, &rw_prop[1], (void*) rw_output.writable[1].properties);
-
-	CuAssertIntEquals (test, 1, rw_output.writable[2].count);
-	CuAssertPtrEquals (test, &rw_region[2], (void*) rw_output.writable[2].regions);
-	CuAssertPtrEquals (test, &rw_prop[2], (void*) rw_output.writable[2].properties);
-
 	status = mock_validate (&manager.flash_mock1.mock);
 	CuAssertIntEquals (test, 0, status);
 
@@ -6505,17 +7352,21 @@ static void host_flash_manager_dual_test_validate_read_write_flash_multiple_fw (
 	CuAssertIntEquals (test, 0, status);
 
 	status = mock_expect (&manager.pfm.mock, manager.pfm.base.free_read_write_regions, &manager.pfm,
-		0, MOCK_ARG_SAVED_ARG (2));
-	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.free_read_write_regions,
-		&manager.pfm, 0, MOCK_ARG_SAVED_ARG (6));
-	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.free_read_write_regions,
-		&manager.pfm, 0, MOCK_ARG_SAVED_ARG (9));
-
+		0, MOCK_ARG_SAVED_ARG (6));
 	CuAssertIntEquals (test, 0, status);
 
 	manager.test.base.free_read_write_regions (&manager.test.base, &rw_output);
 
+	/* The read/write flash cache must have been released. */
+	claimed = host_flash_verify_cache_claim (&cache);
+	CuAssertIntEquals (test, true, claimed);
+
+	host_flash_verify_cache_unclaim (&cache);
+	host_flash_verify_cache_unclaim (&ro_cache);
+
 	host_flash_manager_dual_testing_validate_and_release (test, &manager);
+	host_flash_verify_cache_release (&cache);
+	host_flash_verify_cache_release (&ro_cache);
 }
 
 static void host_flash_manager_dual_test_validate_read_write_flash_null (CuTest *test)
@@ -12754,6 +13605,19 @@ static void host_flash_manager_dual_test_reset_flash_cs1_error (CuTest *test)
 	host_flash_manager_dual_testing_validate_and_release (test, &manager);
 }
 
+static void host_flash_manager_dual_test_invalidate_verified_flash_null (CuTest *test)
+{
+	struct host_flash_manager_dual_testing manager;
+
+	TEST_START;
+
+	host_flash_manager_dual_testing_init (test, &manager, false);
+
+	manager.test.base.invalidate_verified_flash (NULL);
+
+	host_flash_manager_dual_testing_validate_and_release (test, &manager);
+}
+
 
 TEST_SUITE_START (host_flash_manager_dual);
 
@@ -12762,6 +13626,7 @@ TEST (host_flash_manager_dual_test_init_null);
 TEST (host_flash_manager_dual_test_init_with_managed_flash_initialization);
 TEST (host_flash_manager_dual_test_init_with_managed_flash_initialization_null);
 TEST (host_flash_manager_dual_test_release_null);
+TEST (host_flash_manager_dual_test_set_verify_cache_null);
 TEST (host_flash_manager_dual_test_get_read_only_flash_cs0);
 TEST (host_flash_manager_dual_test_get_read_only_flash_cs1);
 TEST (host_flash_manager_dual_test_get_read_only_flash_null);
@@ -12823,6 +13688,10 @@ TEST (host_flash_manager_dual_test_validate_read_write_flash_cs0);
 TEST (host_flash_manager_dual_test_validate_read_write_flash_not_blank_byte);
 TEST (host_flash_manager_dual_test_validate_read_write_flash_single_fw);
 TEST (host_flash_manager_dual_test_validate_read_write_flash_multiple_fw);
+TEST (host_flash_manager_dual_test_validate_read_write_flash_with_cache);
+TEST (host_flash_manager_dual_test_validate_read_write_flash_with_cache_invalidated);
+TEST (host_flash_manager_dual_test_validate_read_write_flash_with_cache_claimed);
+TEST (host_flash_manager_dual_test_validate_read_write_flash_with_cache_per_device);
 TEST (host_flash_manager_dual_test_validate_read_write_flash_null);
 TEST (host_flash_manager_dual_test_validate_read_write_flash_pfm_firmware_error);
 TEST (host_flash_manager_dual_test_validate_read_write_flash_pfm_version_error);
@@ -12937,5 +13806,6 @@ TEST (host_flash_manager_dual_test_reset_flash);
 TEST (host_flash_manager_dual_test_reset_flash_null);
 TEST (host_flash_manager_dual_test_reset_flash_cs0_error);
 TEST (host_flash_manager_dual_test_reset_flash_cs1_error);
+TEST (host_flash_manager_dual_test_invalidate_verified_flash_null);
 
 TEST_SUITE_END;
@@ -396,6 +396,7 @@ static void host_flash_manager_single_test_init (CuTest *test)
 	CuAssertPtrNotNull (test, manager.test.base.set_flash_for_host_access);
 	CuAssertPtrNotNull (test, manager.test.base.host_has_flash_access);
 	CuAssertPtrNotNull (test, manager.test.base.reset_flash);
+	CuAssertPtrNotNull (test, manager.test.base.invalidate_verified_flash);
 
 	host_flash_manager_single_testing_validate_and_release (test, &manager);
 }
@@ -514,6 +515,32 @@ static void host_flash_manager_single_test_release_null (CuTest *test)
 	host_flash_manager_single_release (NULL);
 }
 
+static void host_flash_manager_single_test_set_verify_cache_null (CuTest *test)
+{
+	struct host_flash_verify_cache_entry entries[2];
+	struct host_flash_verify_cache cache;
+	struct spi_filter_interface_mock filter;
+	uint8_t bitmap[2];
+	int status;
+
+	TEST_START;
+
+	status = spi_filter_interface_mock_init (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_flash_verify_cache_init (&cache, &filter.base, entries, 2, bitmap,
+		sizeof (bitmap));
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_flash_manager_single_set_verify_cache (NULL, &cache);
+	CuAssertIntEquals (test, HOST_FLASH_MGR_INVALID_ARGUMENT, status);
+
+	status = spi_filter_interface_mock_validate_and_release (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_verify_cache_release (&cache);
+}
+
 static void host_flash_manager_single_test_get_read_only_flash (CuTest *test)
 {
 	struct host_flash_manager_single_testing manager;
@@ -5486,6 +5513,442 @@ static void host_flash_manager_single_test_validate_read_write_flash_multiple_fw
 	host_flash_manager_single_testing_validate_and_release (test, &manager);
 }
 
+static void host_flash_manager_single_test_validate_read_write_flash_with_cache (CuTest *test)
+{
+	struct host_flash_manager_single_testing manager;
+	struct pfm_firmware fw_list;
+	const char *fw_exp = NULL;
+	struct pfm_firmware_version version;
+	struct pfm_firmware_versions version_list;
+	const char *version_exp = "1234";
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	char *img_data = "Test";
+	struct flash_region rw_region;
+	struct pfm_read_write rw_prop;
+	struct pfm_read_write_regions rw_list;
+	struct host_flash_manager_rw_regions rw_output;
+	struct host_flash_verify_cache_entry entries[2];
+	struct host_flash_verify_cache cache;
+	uint8_t bitmap[2];
+	uint8_t clean[2] = {0};
+	uint32_t block_size = 0x100;
+	int status;
+
+	TEST_START;
+
+	host_flash_manager_single_testing_init (test, &manager);
+
+	spi_filter_interface_mock_enable_dirty_block_tracking (&manager.filter);
+
+	status = host_flash_verify_cache_init (&cache, &manager.filter.base, entries, 2, bitmap,
+		sizeof (bitmap));
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_flash_manager_single_set_verify_cache (&manager.test, &cache);
+	CuAssertIntEquals (test, 0, status);
+
+	fw_list.ids = &fw_exp;
+	fw_list.count = 1;
+
+	version.fw_version_id = version_exp;
+	version.version_addr = 0x123;
+	version.blank_byte = 0xff;
+
+	version_list.versions = &version;
+	version_list.count = 1;
+
+	img_region.start_addr = 0;
+	img_region.length = strlen (img_data);
+
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
+
+	img_list.images_sig = &sig;
+	img_list.images_hash = NULL;
+	img_list.count = 1;
+
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
+
+	rw_prop.on_failure = PFM_RW_DO_NOTHING;
+
+	rw_list.regions = &rw_region;
+	rw_list.properties = &rw_prop;
+	rw_list.count = 1;
+
+	status = spi_flash_set_device_size (&manager.flash0, 0x1000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&manager.pfm.mock, manager.pfm.base.get_firmware, &manager.pfm, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 0, &fw_list, sizeof (fw_list), -1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 0, 3);
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.get_supported_versions, &manager.pfm,
+		0, MOCK_ARG_PTR (NULL), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 1, &version_list, sizeof (version_list), -1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 1, 0);
+
+	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock0, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock0, 0, (uint8_t*) version_exp,
+		strlen (version_exp), FLASH_EXP_READ_CMD (0x03, 0x123, 0, -1, strlen (version_exp)));
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.get_firmware_images, &manager.pfm, 0,
+		MOCK_ARG_PTR (NULL), MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1),
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 2, &img_list, sizeof (img_list), -1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 2, 1);
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.get_read_write_regions, &manager.pfm,
+		0, MOCK_ARG_PTR (NULL), MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1),
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 2, &rw_list, sizeof (rw_list), -1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 2, 2);
+
+	status |= mock_expect (&manager.filter.mock, manager.filter.base.get_dirty_block_bitmap,
+		&manager.filter, 0, MOCK_ARG (SPI_FILTER_CS_0), MOCK_ARG (true), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (sizeof (bitmap)), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output_tmp (&manager.filter.mock, 2, clean, sizeof (clean), 3);
+	status |= mock_expect_output_tmp (&manager.filter.mock, 4, &block_size, sizeof (block_size),
+		-1);
+
+	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock0, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock0, 0, (uint8_t*) img_data,
+		strlen (img_data), FLASH_EXP_READ_CMD (0x03, 0, 0, -1, strlen (img_data)));
+
+	status |= flash_master_mock_expect_blank_check (&manager.flash_mock0, 0 + strlen (img_data),
+		0x200 - strlen (img_data));
+	status |= flash_master_mock_expect_blank_check (&manager.flash_mock0, 0x300, 0x1000 - 0x300);
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.free_fw_versions, &manager.pfm, 0,
+		MOCK_ARG_SAVED_ARG (0));
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.free_firmware_images, &manager.pfm,
+		0, MOCK_ARG_SAVED_ARG (1));
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.free_firmware, &manager.pfm, 0,
+		MOCK_ARG_SAVED_ARG (3));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = manager.test.base.validate_read_write_flash (&manager.test.base, &manager.pfm.base,
+		&manager.hash.base, &manager.rsa.base, &rw_output);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 1, rw_output.count);
+	CuAssertPtrNotNull (test, rw_output.writable);
+	CuAssertPtrEquals (test, &manager.pfm, rw_output.pfm);
+
+	status = mock_validate (&manager.flash_mock0.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&manager.pfm.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&manager.pfm.mock, manager.pfm.base.free_read_write_regions, &manager.pfm,
+		0, MOCK_ARG_SAVED_ARG (2));
+	CuAssertIntEquals (test, 0, status);
+
+	manager.test.base.free_read_write_regions (&manager.test.base, &rw_output);
+
+	/* The flash has not been written by the host, so only the version needs to be read. */
+	status = mock_expect (&manager.pfm.mock, manager.pfm.base.get_firmware, &manager.pfm, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 0, &fw_list, sizeof (fw_list), -1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 0, 7);
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.get_supported_versions, &manager.pfm,
+		0, MOCK_ARG_PTR (NULL), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 1, &version_list, sizeof (version_list), -1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 1, 4);
+
+	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock0, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock0, 0, (uint8_t*) version_exp,
+		strlen (version_exp), FLASH_EXP_READ_CMD (0x03, 0x123, 0, -1, strlen (version_exp)));
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.get_firmware_images, &manager.pfm, 0,
+		MOCK_ARG_PTR (NULL), MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1),
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 2, &img_list, sizeof (img_list), -1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 2, 5);
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.get_read_write_regions, &manager.pfm,
+		0, MOCK_ARG_PTR (NULL), MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1),
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 2, &rw_list, sizeof (rw_list), -1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 2, 6);
+
+	status |= mock_expect (&manager.filter.mock, manager.filter.base.get_dirty_block_bitmap,
+		&manager.filter, 0, MOCK_ARG (SPI_FILTER_CS_0), MOCK_ARG (true), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (sizeof (bitmap)), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output_tmp (&manager.filter.mock, 2, clean, sizeof (clean), 3);
+	status |= mock_expect_output_tmp (&manager.filter.mock, 4, &block_size, sizeof (block_size),
+		-1);
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.free_fw_versions, &manager.pfm, 0,
+		MOCK_ARG_SAVED_ARG (4));
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.free_firmware_images, &manager.pfm,
+		0, MOCK_ARG_SAVED_ARG (5));
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.free_firmware, &manager.pfm, 0,
+		MOCK_ARG_SAVED_ARG (7));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = manager.test.base.validate_read_write_flash (&manager.test.base, &manager.pfm.base,
+		&manager.hash.base, &manager.rsa.base, &rw_output);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 1, rw_output.count);
+	CuAssertPtrNotNull (test, rw_output.writable);
+	CuAssertPtrEquals (test, &manager.pfm, rw_output.pfm);
+
+	status = mock_validate (&manager.flash_mock0.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&manager.pfm.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&manager.pfm.mock, manager.pfm.base.free_read_write_regions, &manager.pfm,
+		0, MOCK_ARG_SAVED_ARG (6));
+	CuAssertIntEquals (test, 0, status);
+
+	manager.test.base.free_read_write_regions (&manager.test.base, &rw_output);
+
+	host_flash_manager_single_testing_validate_and_release (test, &manager);
+	host_flash_verify_cache_release (&cache);
+}
+
+static void host_flash_manager_single_test_validate_read_write_flash_with_cache_invalidated (
+	CuTest *test)
+{
+	struct host_flash_manager_single_testing manager;
+	struct pfm_firmware fw_list;
+	const char *fw_exp = NULL;
+	struct pfm_firmware_version version;
+	struct pfm_firmware_versions version_list;
+	const char *version_exp = "1234";
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	char *img_data = "Test";
+	struct flash_region rw_region;
+	struct pfm_read_write rw_prop;
+	struct pfm_read_write_regions rw_list;
+	struct host_flash_manager_rw_regions rw_output;
+	struct host_flash_verify_cache_entry entries[2];
+	struct host_flash_verify_cache cache;
+	uint8_t bitmap[2];
+	uint8_t clean[2] = {0};
+	uint32_t block_size = 0x100;
+	int status;
+
+	TEST_START;
+
+	host_flash_manager_single_testing_init (test, &manager);
+
+	spi_filter_interface_mock_enable_dirty_block_tracking (&manager.filter);
+
+	status = host_flash_verify_cache_init (&cache, &manager.filter.base, entries, 2, bitmap,
+		sizeof (bitmap));
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_flash_manager_single_set_verify_cache (&manager.test, &cache);
+	CuAssertIntEquals (test, 0, status);
+
+	fw_list.ids = &fw_exp;
+	fw_list.count = 1;
+
+	version.fw_version_id = version_exp;
+	version.version_addr = 0x123;
+	version.blank_byte = 0xff;
+
+	version_list.versions = &version;
+	version_list.count = 1;
+
+	img_region.start_addr = 0;
+	img_region.length = strlen (img_data);
+
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
+
+	img_list.images_sig = &sig;
+	img_list.images_hash = NULL;
+	img_list.count = 1;
+
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
+
+	rw_prop.on_failure = PFM_RW_DO_NOTHING;
+
+	rw_list.regions = &rw_region;
+	rw_list.properties = &rw_prop;
+	rw_list.count = 1;
+
+	status = spi_flash_set_device_size (&manager.flash0, 0x1000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&manager.pfm.mock, manager.pfm.base.get_firmware, &manager.pfm, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 0, &fw_list, sizeof (fw_list), -1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 0, 3);
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.get_supported_versions, &manager.pfm,
+		0, MOCK_ARG_PTR (NULL), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 1, &version_list, sizeof (version_list), -1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 1, 0);
+
+	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock0, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock0, 0, (uint8_t*) version_exp,
+		strlen (version_exp), FLASH_EXP_READ_CMD (0x03, 0x123, 0, -1, strlen (version_exp)));
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.get_firmware_images, &manager.pfm, 0,
+		MOCK_ARG_PTR (NULL), MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1),
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 2, &img_list, sizeof (img_list), -1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 2, 1);
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.get_read_write_regions, &manager.pfm,
+		0, MOCK_ARG_PTR (NULL), MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1),
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 2, &rw_list, sizeof (rw_list), -1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 2, 2);
+
+	status |= mock_expect (&manager.filter.mock, manager.filter.base.get_dirty_block_bitmap,
+		&manager.filter, 0, MOCK_ARG (SPI_FILTER_CS_0), MOCK_ARG (true), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (sizeof (bitmap)), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output_tmp (&manager.filter.mock, 2, clean, sizeof (clean), 3);
+	status |= mock_expect_output_tmp (&manager.filter.mock, 4, &block_size, sizeof (block_size),
+		-1);
+
+	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock0, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock0, 0, (uint8_t*) img_data,
+		strlen (img_data), FLASH_EXP_READ_CMD (0x03, 0, 0, -1, strlen (img_data)));
+
+	status |= flash_master_mock_expect_blank_check (&manager.flash_mock0, 0 + strlen (img_data),
+		0x200 - strlen (img_data));
+	status |= flash_master_mock_expect_blank_check (&manager.flash_mock0, 0x300, 0x1000 - 0x300);
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.free_fw_versions, &manager.pfm, 0,
+		MOCK_ARG_SAVED_ARG (0));
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.free_firmware_images, &manager.pfm,
+		0, MOCK_ARG_SAVED_ARG (1));
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.free_firmware, &manager.pfm, 0,
+		MOCK_ARG_SAVED_ARG (3));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = manager.test.base.validate_read_write_flash (&manager.test.base, &manager.pfm.base,
+		&manager.hash.base, &manager.rsa.base, &rw_output);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 1, rw_output.count);
+	CuAssertPtrNotNull (test, rw_output.writable);
+	CuAssertPtrEquals (test, &manager.pfm, rw_output.pfm);
+
+	status = mock_validate (&manager.flash_mock0.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&manager.pfm.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&manager.pfm.mock, manager.pfm.base.free_read_write_regions, &manager.pfm,
+		0, MOCK_ARG_SAVED_ARG (2));
+	CuAssertIntEquals (test, 0, status);
+
+	manager.test.base.free_read_write_regions (&manager.test.base, &rw_output);
+
+	/* The RoT modified the flash, so everything needs to be checked again. */
+	manager.test.base.invalidate_verified_flash (&manager.test.base);
+
+	status = mock_expect (&manager.pfm.mock, manager.pfm.base.get_firmware, &manager.pfm, 0,
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 0, &fw_list, sizeof (fw_list), -1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 0, 7);
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.get_supported_versions, &manager.pfm,
+		0, MOCK_ARG_PTR (NULL), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 1, &version_list, sizeof (version_list), -1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 1, 4);
+
+	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock0, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock0, 0, (uint8_t*) version_exp,
+		strlen (version_exp), FLASH_EXP_READ_CMD (0x03, 0x123, 0, -1, strlen (version_exp)));
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.get_firmware_images, &manager.pfm, 0,
+		MOCK_ARG_PTR (NULL), MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1),
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 2, &img_list, sizeof (img_list), -1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 2, 5);
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.get_read_write_regions, &manager.pfm,
+		0, MOCK_ARG_PTR (NULL), MOCK_ARG_PTR_CONTAINS (version_exp, strlen (version_exp) + 1),
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&manager.pfm.mock, 2, &rw_list, sizeof (rw_list), -1);
+	status |= mock_expect_save_arg (&manager.pfm.mock, 2, 6);
+
+	status |= mock_expect (&manager.filter.mock, manager.filter.base.get_dirty_block_bitmap,
+		&manager.filter, 0, MOCK_ARG (SPI_FILTER_CS_0), MOCK_ARG (true), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (sizeof (bitmap)), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output_tmp (&manager.filter.mock, 2, clean, sizeof (clean), 3);
+	status |= mock_expect_output_tmp (&manager.filter.mock, 4, &block_size, sizeof (block_size),
+		-1);
+
+	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock0, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&manager.flash_mock0, 0, (uint8_t*) img_data,
+		strlen (img_data), FLASH_EXP_READ_CMD (0x03, 0, 0, -1, strlen (img_data)));
+
+	status |= flash_master_mock_expect_blank_check (&manager.flash_mock0, 0 + strlen (img_data),
+		0x200 - strlen (img_data));
+	status |= flash_master_mock_expect_blank_check (&manager.flash_mock0, 0x300, 0x1000 - 0x300);
+
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.free_fw_versions, &manager.pfm, 0,
+		MOCK_ARG_SAVED_ARG (4));
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.free_firmware_images, &manager.pfm,
+		0, MOCK_ARG_SAVED_ARG (5));
+	status |= mock_expect (&manager.pfm.mock, manager.pfm.base.free_firmware, &manager.pfm, 0,
+		MOCK_ARG_SAVED_ARG (7));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = manager.test.base.validate_read_write_flash (&manager.test.base, &manager.pfm.base,
+		&manager.hash.base, &manager.rsa.base, &rw_output);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 1, rw_output.count);
+	CuAssertPtrNotNull (test, rw_output.writable);
+	CuAssertPtrEquals (test, &manager.pfm, rw_output.pfm);
+
+	status = mock_validate (&manager.flash_mock0.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&manager.pfm.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&manager.pfm.mock, manager.pfm.base.free_read_write_regions, &manager.pfm,
+		0, MOCK_ARG_SAVED_ARG (6));
+	CuAssertIntEquals (test, 0, status);
+
+	manager.test.base.free_read_write_regions (&manager.test.base, &rw_output);
+
+	host_flash_manager_single_testing_validate_and_release (test, &manager);
+	host_flash_verify_cache_release (&cache);
+}
+
 static void host_flash_manager_single_test_validate_read_write_flash_null (CuTest *test)
 {
 	struct host_flash_manager_single_testing manager;
@@ -9966,6 +10429,19 @@ static void host_flash_manager_single_test_reset_flash_error (CuTest *test)
 	host_flash_manager_single_testing_validate_and_release (test, &manager);
 }
 
+static void host_flash_manager_single_test_invalidate_verified_flash_null (CuTest *test)
+{
+	struct host_flash_manager_single_testing manager;
+
+	TEST_START;
+
+	host_flash_manager_single_testing_init (test, &manager);
+
+	manager.test.base.invalidate_verified_flash (NULL);
+
+	host_flash_manager_single_testing_validate_and_release (test, &manager);
+}
+
 
 TEST_SUITE_START (host_flash_manager_single);
 
@@ -9974,6 +10450,7 @@ TEST (host_flash_manager_single_test_init_null);
 TEST (host_flash_manager_single_test_init_with_managed_flash_initialization);
 TEST (host_flash_manager_single_test_init_with_managed_flash_initialization_null);
 TEST (host_flash_manager_single_test_release_null);
+TEST (host_flash_manager_single_test_set_verify_cache_null);
 TEST (host_flash_manager_single_test_get_read_only_flash);
 TEST (host_flash_manager_single_test_get_read_only_flash_null);
 TEST (host_flash_manager_single_test_get_read_write_flash);
@@ -10024,6 +10501,8 @@ TEST (host_flash_manager_single_test_validate_read_write_flash);
 TEST (host_flash_manager_single_test_validate_read_write_flash_not_blank_byte);
 TEST (host_flash_manager_single_test_validate_read_write_flash_single_fw);
 TEST (host_flash_manager_single_test_validate_read_write_flash_multiple_fw);
+TEST (host_flash_manager_single_test_validate_read_write_flash_with_cache);
+TEST (host_flash_manager_single_test_validate_read_write_flash_with_cache_invalidated);
 TEST (host_flash_manager_single_test_validate_read_write_flash_null);
 TEST (host_flash_manager_single_test_validate_read_write_flash_pfm_firmware_error);
 TEST (host_flash_manager_single_test_validate_read_write_flash_pfm_version_error);
@@ -10111,5 +10590,6 @@ TEST (host_flash_manager_single_test_restore_flash_read_write_regions_null);
 TEST (host_flash_manager_single_test_reset_flash);
 TEST (host_flash_manager_single_test_reset_flash_null);
 TEST (host_flash_manager_single_test_reset_flash_error);
+TEST (host_flash_manager_single_test_invalidate_verified_flash_null);
 
 TEST_SUITE_END;
@@ -0,0 +1,1127 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "testing.h"
+#include "host_fw/host_flash_verify_cache.h"
+#include "testing/mock/spi_filter/spi_filter_interface_mock.h"
+#include "testing/crypto/hash_testing.h"
+
+
+TEST_SUITE_LABEL ("host_flash_verify_cache");
+
+
+/**
+ * Number of cache entries to use for testing.
+ */
+#define	HOST_FLASH_VERIFY_CACHE_TESTING_ENTRIES		2
+
+/**
+ * Block size reported by the SPI filter for testing.
+ */
+#define	HOST_FLASH_VERIFY_CACHE_TESTING_BLOCK		0x10000
+
+
+/**
+ * Dependencies for testing the host flash verification cache.
+ */
+struct host_flash_verify_cache_testing {
+	struct spi_filter_interface_mock filter;			/**< Mock for the SPI filter. */
+	struct host_flash_verify_cache_entry entries[HOST_FLASH_VERIFY_CACHE_TESTING_ENTRIES];	/**< Cache entries. */
+	uint8_t bitmap[4];									/**< Buffer for dirty block bitmaps. */
+	struct host_flash_verify_cache test;				/**< Cache under test. */
+};
+
+
+/**
+ * Initialize all dependencies for testing.
+ *
+ * @param test The testing framework.
+ * @param cache Testing dependencies to initialize.
+ */
+static void host_flash_verify_cache_testing_init_dependencies (CuTest *test,
+	struct host_flash_verify_cache_testing *cache)
+{
+	int status;
+
+	status = spi_filter_interface_mock_init (&cache->filter);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_filter_interface_mock_enable_dirty_block_tracking (&cache->filter);
+}
+
+/**
+ * Initialize a cache for testing.
+ *
+ * @param test The testing framework.
+ * @param cache Testing components to initialize.
+ */
+static void host_flash_verify_cache_testing_init (CuTest *test,
+	struct host_flash_verify_cache_testing *cache)
+{
+	int status;
+
+	host_flash_verify_cache_testing_init_dependencies (test, cache);
+
+	status = host_flash_verify_cache_init (&cache->test, &cache->filter.base, cache->entries,
+		HOST_FLASH_VERIFY_CACHE_TESTING_ENTRIES, cache->bitmap, sizeof (cache->bitmap));
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Release test components and validate all mocks.
+ *
+ * @param test The testing framework.
+ * @param cache Testing components to release.
+ */
+static void host_flash_verify_cache_testing_release (CuTest *test,
+	struct host_flash_verify_cache_testing *cache)
+{
+	int status;
+
+	status = spi_filter_interface_mock_validate_and_release (&cache->filter);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_verify_cache_release (&cache->test);
+}
+
+/**
+ * Start verification of a flash device with the specified dirty blocks.
+ *
+ * @param test The testing framework.
+ * @param cache Testing components to use.
+ * @param cs The flash device being verified.
+ * @param dirty The dirty block bitmap to report from the filter.
+ */
+static void host_flash_verify_cache_testing_start (CuTest *test,
+	struct host_flash_verify_cache_testing *cache, spi_filter_cs cs, const uint8_t *dirty)
+{
+	uint32_t block_size = HOST_FLASH_VERIFY_CACHE_TESTING_BLOCK;
+	int status;
+
+	status = mock_expect (&cache->filter.mock, cache->filter.base.get_dirty_block_bitmap,
+		&cache->filter, 0, MOCK_ARG (cs), MOCK_ARG (true), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (sizeof (cache->bitmap)), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&cache->filter.mock, 2, dirty, sizeof (cache->bitmap), 3);
+	status |= mock_expect_output (&cache->filter.mock, 4, &block_size, sizeof (block_size), -1);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_flash_verify_cache_start_verification (&cache->test, cs);
+	CuAssertIntEquals (test, 0, status);
+}
+
+/*******************
+ * Test cases
+ *******************/
+
+static void host_flash_verify_cache_test_init (CuTest *test)
+{
+	struct host_flash_verify_cache_testing cache;
+	int status;
+
+	TEST_START;
+
+	host_flash_verify_cache_testing_init_dependencies (test, &cache);
+
+	status = host_flash_verify_cache_init (&cache.test, &cache.filter.base, cache.entries,
+		HOST_FLASH_VERIFY_CACHE_TESTING_ENTRIES, cache.bitmap, sizeof (cache.bitmap));
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_verify_cache_testing_release (test, &cache);
+}
+
+static void host_flash_verify_cache_test_init_null (CuTest *test)
+{
+	struct host_flash_verify_cache_testing cache;
+	int status;
+
+	TEST_START;
+
+	host_flash_verify_cache_testing_init_dependencies (test, &cache);
+
+	status = host_flash_verify_cache_init (NULL, &cache.filter.base, cache.entries,
+		HOST_FLASH_VERIFY_CACHE_TESTING_ENTRIES, cache.bitmap, sizeof (cache.bitmap));
+	CuAssertIntEquals (test, HOST_FLASH_VERIFY_CACHE_INVALID_ARGUMENT, status);
+
+	status = host_flash_verify_cache_init (&cache.test, NULL, cache.entries,
+		HOST_FLASH_VERIFY_CACHE_TESTING_ENTRIES, cache.bitmap, sizeof (cache.bitmap));
+	CuAssertIntEquals (test, HOST_FLASH_VERIFY_CACHE_INVALID_ARGUMENT, status);
+
+	status = host_flash_verify_cache_init (&cache.test, &cache.filter.base, NULL,
+		HOST_FLASH_VERIFY_CACHE_TESTING_ENTRIES, cache.bitmap, sizeof (cache.bitmap));
+	CuAssertIntEquals (test, HOST_FLASH_VERIFY_CACHE_INVALID_ARGUMENT, status);
+
+	status = host_flash_verify_cache_init (&cache.test, &cache.filter.base, cache.entries, 0,
+		cache.bitmap, sizeof (cache.bitmap));
+	CuAssertIntEquals (test, HOST_FLASH_VERIFY_CACHE_INVALID_ARGUMENT, status);
+
+	status = host_flash_verify_cache_init (&cache.test, &cache.filter.base, cache.entries,
+		HOST_FLASH_VERIFY_CACHE_TESTING_ENTRIES, NULL, sizeof (cache.bitmap));
+	CuAssertIntEquals (test, HOST_FLASH_VERIFY_CACHE_INVALID_ARGUMENT, status);
+
+	status = host_flash_verify_cache_init (&cache.test, &cache.filter.base, cache.entries,
+		HOST_FLASH_VERIFY_CACHE_TESTING_ENTRIES, cache.bitmap, 0);
+	CuAssertIntEquals (test, HOST_FLASH_VERIFY_CACHE_INVALID_ARGUMENT, status);
+
+	status = spi_filter_interface_mock_validate_and_release (&cache.filter);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void host_flash_verify_cache_test_release_null (CuTest *test)
+{
+	TEST_START;
+
+	host_flash_verify_cache_release (NULL);
+}
+
+static void host_flash_verify_cache_test_claim (CuTest *test)
+{
+	struct host_flash_verify_cache_testing cache;
+	bool claimed;
+
+	TEST_START;
+
+	host_flash_verify_cache_testing_init (test, &cache);
+
+	claimed = host_flash_verify_cache_claim (&cache.test);
+	CuAssertIntEquals (test, true, claimed);
+
+	claimed = host_flash_verify_cache_claim (&cache.test);
+	CuAssertIntEquals (test, false, claimed);
+
+	host_flash_verify_cache_unclaim (&cache.test);
+
+	claimed = host_flash_verify_cache_claim (&cache.test);
+	CuAssertIntEquals (test, true, claimed);
+
+	host_flash_verify_cache_unclaim (&cache.test);
+
+	host_flash_verify_cache_testing_release (test, &cache);
+}
+
+static void host_flash_verify_cache_test_claim_null (CuTest *test)
+{
+	bool claimed;
+
+	TEST_START;
+
+	claimed = host_flash_verify_cache_claim (NULL);
+	CuAssertIntEquals (test, false, claimed);
+
+	host_flash_verify_cache_unclaim (NULL);
+}
+
+static void host_flash_verify_cache_test_get_digest (CuTest *test)
+{
+	struct host_flash_verify_cache_testing cache;
+	struct flash_region regions[] = {{0, 0x10000}, {0x30000, 0x1000}};
+	uint8_t clean[4] = {0};
+	uint8_t digest[SHA256_HASH_LENGTH];
+	bool found;
+	int status;
+
+	TEST_START;
+
+	host_flash_verify_cache_testing_init (test, &cache);
+
+	host_flash_verify_cache_testing_start (test, &cache, SPI_FILTER_CS_0, clean);
+
+	found = host_flash_verify_cache_get_digest (&cache.test, regions, 2, HASH_TYPE_SHA256, digest,
+		sizeof (digest));
+	CuAssertIntEquals (test, false, found);
+
+	host_flash_verify_cache_update_digest (&cache.test, regions, 2, HASH_TYPE_SHA256,
+		SHA256_TEST_HASH, SHA256_HASH_LENGTH);
+
+	/* Verify again with no host writes. */
+	host_flash_verify_cache_testing_start (test, &cache, SPI_FILTER_CS_0, clean);
+
+	found = host_flash_verify_cache_get_digest (&cache.test, regions, 2, HASH_TYPE_SHA256, digest,
+		sizeof (digest));
+	CuAssertIntEquals (test, true, found);
+
+	status = testing_validate_array (SHA256_TEST_HASH, digest, sizeof (digest));
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_verify_cache_testing_release (test, &cache);
+}
+
+static void host_flash_verify_cache_test_get_digest_different_image (CuTest *test)
+{
+	struct host_flash_verify_cache_testing cache;
+	struct flash_region regions[] = {{0, 0x10000}, {0x30000, 0x1000}};
+	struct flash_region other[] = {{0, 0x10000}, {0x30000, 0x2000}};
+	uint8_t clean[4] = {0};
+	uint8_t digest[SHA512_HASH_LENGTH];
+	bool found;
+
+	TEST_START;
+
+	host_flash_verify_cache_testing_init (test, &cache);
+
+	host_flash_verify_cache_testing_start (test, &cache, SPI_FILTER_CS_0, clean);
+
+	host_flash_verify_cache_update_digest (&cache.test, regions, 2, HASH_TYPE_SHA256,
+		SHA256_TEST_HASH, SHA256_HASH_LENGTH);
+
+	found = host_flash_verify_cache_get_digest (&cache.test, other, 2, HASH_TYPE_SHA256, digest,
+		sizeof (digest));
+	CuAssertIntEquals (test, false, found);
+
+	found = host_flash_verify_cache_get_digest (&cache.test, regions, 1, HASH_TYPE_SHA256, digest,
+		sizeof (digest));
+	CuAssertIntEquals (test, false, found);
+
+	found = host_flash_verify_cache_get_digest (&cache.test, regions, 2, HASH_TYPE_SHA384, digest,
+		sizeof (digest));
+	CuAssertIntEquals (test, false, found);
+
+	found = host_flash_verify_cache_get_digest (&cache.test, regions, 2, HASH_TYPE_SHA256, digest,
+		SHA256_HASH_LENGTH - 1);
+	CuAssertIntEquals (test, false, found);
+
+	host_flash_verify_cache_testing_release (test, &cache);
+}
+
+static void host_flash_verify_cache_test_get_digest_different_device (CuTest *test)
+{
+	struct host_flash_verify_cache_testing cache;
+	struct flash_region regions[] = {{0, 0x10000}};
+	uint8_t clean[4] = {0};
+	uint8_t digest[SHA256_HASH_LENGTH];
+	bool found;
+
+	TEST_START;
+
+	host_flash_verify_cache_testing_init (test, &cache);
+
+	host_flash_verify_cache_testing_start (test, &cache, SPI_FILTER_CS_0, clean);
+
+	host_flash_verify_cache_update_digest (&cache.test, regions, 1, HASH_TYPE_SHA256,
+		SHA256_TEST_HASH, SHA256_HASH_LENGTH);
+
+	host_flash_verify_cache_testing_start (test, &cache, SPI_FILTER_CS_1, clean);
+
+	found = host_flash_verify_cache_get_digest (&cache.test, regions, 1, HASH_TYPE_SHA256, digest,
+		sizeof (digest));
+	CuAssertIntEquals (test, false, found);
+
+	host_flash_verify_cache_testing_start (test, &cache, SPI_FILTER_CS_0, clean);
+
+	found = host_flash_verify_cache_get_digest (&cache.test, regions, 1, HASH_TYPE_SHA256, digest,
+		sizeof (digest));
+	CuAssertIntEquals (test, true, found);
+
+	host_flash_verify_cache_testing_release (test, &cache);
+}
+
+static void host_flash_verify_cache_test_get_digest_not_started (CuTest *test)
+{
+	struct host_flash_verify_cache_testing cache;
+	struct flash_region regions[] = {{0, 0x10000}};
+	uint8_t digest[SHA256_HASH_LENGTH];
+	bool found;
+
+	TEST_START;
+
+	host_flash_verify_cache_testing_init (test, &cache);
+
+	/* Digests can't be saved without write tracking. */
+	host_flash_verify_cache_update_digest (&cache.test, regions, 1, HASH_TYPE_SHA256,
+		SHA256_TEST_HASH, SHA256_HASH_LENGTH);
+
+	found = host_flash_verify_cache_get_digest (&cache.test, regions, 1, HASH_TYPE_SHA256, digest,
+		sizeof (digest));
+	CuAssertIntEquals (test, false, found);
+
+	host_flash_verify_cache_testing_release (test, &cache);
+}
+
+static void host_flash_verify_cache_test_get_digest_null (CuTest *test)
+{
+	struct host_flash_verify_cache_testing cache;
+	struct flash_region regions[] = {{0, 0x10000}};
+	uint8_t clean[4] = {0};
+	uint8_t digest[SHA256_HASH_LENGTH];
+	bool found;
+
+	TEST_START;
+
+	host_flash_verify_cache_testing_init (test, &cache);
+
+	host_flash_verify_cache_testing_start (test, &cache, SPI_FILTER_CS_0, clean);
+
+	host_flash_verify_cache_update_digest (&cache.test, regions, 1, HASH_TYPE_SHA256,
+		SHA256_TEST_HASH, SHA256_HASH_LENGTH);
+
+	found = host_flash_verify_cache_get_digest (NULL, regions, 1, HASH_TYPE_SHA256, digest,
+		sizeof (digest));
+	CuAssertIntEquals (test, false, found);
+
+	found = host_flash_verify_cache_get_digest (&cache.test, NULL, 1, HASH_TYPE_SHA256, digest,
+		sizeof (digest));
+	CuAssertIntEquals (test, false, found);
+
+	found = host_flash_verify_cache_get_digest (&cache.test, regions, 0, HASH_TYPE_SHA256, digest,
+		sizeof (digest));
+	CuAssertIntEquals (test, false, found);
+
+	found = host_flash_verify_cache_get_digest (&cache.test, regions, 1, HASH_TYPE_SHA256, NULL,
+		sizeof (digest));
+	CuAssertIntEquals (test, false, found);
+
+	host_flash_verify_cache_testing_release (test, &cache);
+}
+
+static void host_flash_verify_cache_test_update_digest_replace_existing (CuTest *test)
+{
+	struct host_flash_verify_cache_testing cache;
+	struct flash_region regions[] = {{0, 0x10000}};
+	struct flash_region other[] = {{0x20000, 0x10000}};
+	uint8_t clean[4] = {0};
+	uint8_t digest[SHA256_HASH_LENGTH];
+	bool found;
+	int status;
+
+	TEST_START;
+
+	host_flash_verify_cache_testing_init (test, &cache);
+
+	host_flash_verify_cache_testing_start (test, &cache, SPI_FILTER_CS_0, clean);
+
+	host_flash_verify_cache_update_digest (&cache.test, regions, 1, HASH_TYPE_SHA256,
+		SHA256_TEST_HASH, SHA256_HASH_LENGTH);
+	host_flash_verify_cache_update_digest (&cache.test, other, 1, HASH_TYPE_SHA256,
+		SHA256_TEST_HASH, SHA256_HASH_LENGTH);
+	host_flash_verify_cache_update_digest (&cache.test, regions, 1, HASH_TYPE_SHA256,
+		SHA256_TEST2_HASH, SHA256_HASH_LENGTH);
+
+	found = host_flash_verify_cache_get_digest (&cache.test, regions, 1, HASH_TYPE_SHA256, digest,
+		sizeof (digest));
+	CuAssertIntEquals (test, true, found);
+
+	status = testing_validate_array (SHA256_TEST2_HASH, digest, sizeof (digest));
+	CuAssertIntEquals (test, 0, status);
+
+	found = host_flash_verify_cache_get_digest (&cache.test, other, 1, HASH_TYPE_SHA256, digest,
+		sizeof (digest));
+	CuAssertIntEquals (test, true, found);
+
+	status = testing_validate_array (SHA256_TEST_HASH, digest, sizeof (digest));
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_verify_cache_testing_release (test, &cache);
+}
+
+static void host_flash_verify_cache_test_update_digest_cache_full (CuTest *test)
+{
+	struct host_flash_verify_cache_testing cache;
+	struct flash_region region1[] = {{0, 0x10000}};
+	struct flash_region region2[] = {{0x20000, 0x10000}};
+	struct flash_region region3[] = {{0x40000, 0x10000}};
+	struct flash_region region4[] = {{0x60000, 0x10000}};
+	uint8_t clean[4] = {0};
+	uint8_t digest[SHA256_HASH_LENGTH];
+	bool found;
+
+	TEST_START;
+
+	host_flash_verify_cache_testing_init (test, &cache);
+
+	host_flash_verify_cache_testing_start (test, &cache, SPI_FILTER_CS_0, clean);
+
+	host_flash_verify_cache_update_digest (&cache.test, region1, 1, HASH_TYPE_SHA256,
+		SHA256_TEST_HASH, SHA256_HASH_LENGTH);
+	host_flash_verify_cache_update_digest (&cache.test, region2, 1, HASH_TYPE_SHA256,
+		SHA256_TEST_HASH, SHA256_HASH_LENGTH);
+	host_flash_verify_cache_update_digest (&cache.test, region3, 1, HASH_TYPE_SHA256,
+		SHA256_TEST_HASH, SHA256_HASH_LENGTH);
+
+	found = host_flash_verify_cache_get_digest (&cache.test, region1, 1, HASH_TYPE_SHA256, digest,
+		sizeof (digest));
+	CuAssertIntEquals (test, false, found);
+
+	found = host_flash_verify_cache_get_digest (&cache.test, region2, 1, HASH_TYPE_SHA256, digest,
+		sizeof (digest));
+	CuAssertIntEquals (test, true, found);
+
+	found = host_flash_verify_cache_get_digest (&cache.test, region3, 1, HASH_TYPE_SHA256, digest,
+		sizeof (digest));
+	CuAssertIntEquals (test, true, found);
+
+	host_flash_verify_cache_update_digest (&cache.test, region4, 1, HASH_TYPE_SHA256,
+		SHA256_TEST_HASH, SHA256_HASH_LENGTH);
+
+	found = host_flash_verify_cache_get_digest (&cache.test, region2, 1, HASH_TYPE_SHA256, digest,
+		sizeof (digest));
+	CuAssertIntEquals (test, false, found);
+
+	found = host_flash_verify_cache_get_digest (&cache.test, region3, 1, HASH_TYPE_SHA256, digest,
+		sizeof (digest));
+	CuAssertIntEquals (test, true, found);
+
+	found = host_flash_verify_cache_get_digest (&cache.test, region4, 1, HASH_TYPE_SHA256, digest,
+		sizeof (digest));
+	CuAssertIntEquals (test, true, found);
+
+	host_flash_verify_cache_testing_release (test, &cache);
+}
+
+static void host_flash_verify_cache_test_update_digest_too_many_regions (CuTest *test)
+{
+	struct host_flash_verify_cache_testing cache;
+	struct flash_region regions[HOST_FLASH_VERIFY_CACHE_MAX_REGIONS + 1];
+	uint8_t clean[4] = {0};
+	uint8_t digest[SHA256_HASH_LENGTH];
+	bool found;
+	int i;
+
+	TEST_START;
+
+	for (i = 0; i < HOST_FLASH_VERIFY_CACHE_MAX_REGIONS + 1; i++) {
+		regions[i].start_addr = i * 0x1000;
+		regions[i].length = 0x100;
+	}
+
+	host_flash_verify_cache_testing_init (test, &cache);
+
+	host_flash_verify_cache_testing_start (test, &cache, SPI_FILTER_CS_0, clean);
+
+	host_flash_verify_cache_update_digest (&cache.test, regions,
+		HOST_FLASH_VERIFY_CACHE_MAX_REGIONS + 1, HASH_TYPE_SHA256, SHA256_TEST_HASH,
+		SHA256_HASH_LENGTH);
+
+	found = host_flash_verify_cache_get_digest (&cache.test, regions,
+		HOST_FLASH_VERIFY_CACHE_MAX_REGIONS + 1, HASH_TYPE_SHA256, digest, sizeof (digest));
+	CuAssertIntEquals (test, false, found);
+
+	host_flash_verify_cache_testing_release (test, &cache);
+}
+
+static void host_flash_verify_cache_test_update_digest_wrong_length (CuTest *test)
+{
+	struct host_flash_verify_cache_testing cache;
+	struct flash_region regions[] = {{0, 0x10000}};
+	uint8_t clean[4] = {0};
+	uint8_t digest[SHA256_HASH_LENGTH];
+	bool found;
+
+	TEST_START;
+
+	host_flash_verify_cache_testing_init (test, &cache);
+
+	host_flash_verify_cache_testing_start (test, &cache, SPI_FILTER_CS_0, clean);
+
+	host_flash_verify_cache_update_digest (&cache.test, regions, 1, HASH_TYPE_SHA256,
+		SHA256_TEST_HASH, SHA256_HASH_LENGTH - 1);
+
+	found = host_flash_verify_cache_get_digest (&cache.test, regions, 1, HASH_TYPE_SHA256, digest,
+		sizeof (digest));
+	CuAssertIntEquals (test, false, found);
+
+	host_flash_verify_cache_testing_release (test, &cache);
+}
+
+static void host_flash_verify_cache_test_start_verification_dirty_block (CuTest *test)
+{
+	struct host_flash_verify_cache_testing cache;
+	struct flash_region image1[] = {{0, 0x10000}, {0x200000, 0x1000}};
+	struct flash_region image2[] = {{0x30000, 0x20000}};
+	uint8_t clean[4] = {0};
+	uint8_t dirty[4] = {0x02, 0x00, 0x00, 0x00};
+	uint8_t digest[SHA256_HASH_LENGTH];
+	bool found;
+
+	TEST_START;
+
+	host_flash_verify_cache_testing_init (test, &cache);
+
+	host_flash_verify_cache_testing_start (test, &cache, SPI_FILTER_CS_0, clean);
+
+	host_flash_verify_cache_update_digest (&cache.test, image1, 2, HASH_TYPE_SHA256,
+		SHA256_TEST_HASH, SHA256_HASH_LENGTH);
+	host_flash_verify_cache_update_digest (&cache.test, image2, 1, HASH_TYPE_SHA256,
+		SHA256_TEST_HASH, SHA256_HASH_LENGTH);
+
+	/* Image 1 has a region beyond the end of the bitmap, so it can't be cached. */
+	host_flash_verify_cache_testing_start (test, &cache, SPI_FILTER_CS_0, clean);
+
+	found = host_flash_verify_cache_get_digest (&cache.test, image1, 2, HASH_TYPE_SHA256, digest,
+		sizeof (digest));
+	CuAssertIntEquals (test, false, found);
+
+	found = host_flash_verify_cache_get_digest (&cache.test, image2, 1, HASH_TYPE_SHA256, digest,
+		sizeof (digest));
+	CuAssertIntEquals (test, true, found);
+
+	/* Writing to a block not used by the image doesn't invalidate it. */
+	host_flash_verify_cache_testing_start (test, &cache, SPI_FILTER_CS_0, dirty);
+
+	found = host_flash_verify_cache_get_digest (&cache.test, image2, 1, HASH_TYPE_SHA256, digest,
+		sizeof (digest));
+	CuAssertIntEquals (test, true, found);
+
+	dirty[0] = 0x10;
+	host_flash_verify_cache_testing_start (test, &cache, SPI_FILTER_CS_0, dirty);
+
+	found = host_flash_verify_cache_get_digest (&cache.test, image2, 1, HASH_TYPE_SHA256, digest,
+		sizeof (digest));
+	CuAssertIntEquals (test, false, found);
+
+	host_flash_verify_cache_testing_release (test, &cache);
+}
+
+static void host_flash_verify_cache_test_start_verification_dirty_other_device (CuTest *test)
+{
+	struct host_flash_verify_cache_testing cache;
+	struct flash_region regions[] = {{0, 0x10000}};
+	uint8_t clean[4] = {0};
+	uint8_t dirty[4] = {0xff, 0xff, 0xff, 0xff};
+	uint8_t digest[SHA256_HASH_LENGTH];
+	bool found;
+
+	TEST_START;
+
+	host_flash_verify_cache_testing_init (test, &cache);
+
+	host_flash_verify_cache_testing_start (test, &cache, SPI_FILTER_CS_1, clean);
+
+	host_flash_verify_cache_update_digest (&cache.test, regions, 1, HASH_TYPE_SHA256,
+		SHA256_TEST_HASH, SHA256_HASH_LENGTH);
+
+	host_flash_verify_cache_testing_start (test, &cache, SPI_FILTER_CS_0, dirty);
+	host_flash_verify_cache_testing_start (test, &cache, SPI_FILTER_CS_1, clean);
+
+	found = host_flash_verify_cache_get_digest (&cache.test, regions, 1, HASH_TYPE_SHA256, digest,
+		sizeof (digest));
+	CuAssertIntEquals (test, true, found);
+
+	host_flash_verify_cache_testing_release (test, &cache);
+}
+
+static void host_flash_verify_cache_test_start_verification_unsupported (CuTest *test)
+{
+	struct host_flash_verify_cache_testing cache;
+	struct flash_region regions[] = {{0, 0x10000}};
+	uint8_t digest[SHA256_HASH_LENGTH];
+	bool found;
+	int status;
+
+	TEST_START;
+
+	status = spi_filter_interface_mock_init (&cache.filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_flash_verify_cache_init (&cache.test, &cache.filter.base, cache.entries,
+		HOST_FLASH_VERIFY_CACHE_TESTING_ENTRIES, cache.bitmap, sizeof (cache.bitmap));
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_flash_verify_cache_start_verification (&cache.test, SPI_FILTER_CS_0);
+	CuAssertIntEquals (test, SPI_FILTER_UNSUPPORTED_OPERATION, status);
+
+	host_flash_verify_cache_update_digest (&cache.test, regions, 1, HASH_TYPE_SHA256,
+		SHA256_TEST_HASH, SHA256_HASH_LENGTH);
+
+	found = host_flash_verify_cache_get_digest (&cache.test, regions, 1, HASH_TYPE_SHA256, digest,
+		sizeof (digest));
+	CuAssertIntEquals (test, false, found);
+
+	host_flash_verify_cache_testing_release (test, &cache);
+}
+
+static void host_flash_verify_cache_test_start_verification_filter_error (CuTest *test)
+{
+	struct host_flash_verify_cache_testing cache;
+	struct flash_region regions[] = {{0, 0x10000}};
+	uint8_t clean[4] = {0};
+	uint8_t digest[SHA256_HASH_LENGTH];
+	bool found;
+	int status;
+
+	TEST_START;
+
+	host_flash_verify_cache_testing_init (test, &cache);
+
+	host_flash_verify_cache_testing_start (test, &cache, SPI_FILTER_CS_0, clean);
+
+	host_flash_verify_cache_update_digest (&cache.test, regions, 1, HASH_TYPE_SHA256,
+		SHA256_TEST_HASH, SHA256_HASH_LENGTH);
+
+	status = mock_expect (&cache.filter.mock, cache.filter.base.get_dirty_block_bitmap,
+		&cache.filter, SPI_FILTER_GET_DIRTY_BLOCKS_FAILED, MOCK_ARG (SPI_FILTER_CS_0),
+		MOCK_ARG (true), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (cache.bitmap)), MOCK_ARG_NOT_NULL);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_flash_verify_cache_start_verification (&cache.test, SPI_FILTER_CS_0);
+	CuAssertIntEquals (test, SPI_FILTER_GET_DIRTY_BLOCKS_FAILED, status);
+
+	found = host_flash_verify_cache_get_digest (&cache.test, regions, 1, HASH_TYPE_SHA256, digest,
+		sizeof (digest));
+	CuAssertIntEquals (test, false, found);
+
+	/* The entry was discarded and can't be used even if tracking is available again. */
+	host_flash_verify_cache_testing_start (test, &cache, SPI_FILTER_CS_0, clean);
+
+	found = host_flash_verify_cache_get_digest (&cache.test, regions, 1, HASH_TYPE_SHA256, digest,
+		sizeof (digest));
+	CuAssertIntEquals (test, false, found);
+
+	host_flash_verify_cache_testing_release (test, &cache);
+}
+
+static void host_flash_verify_cache_test_start_verification_bad_block_size (CuTest *test)
+{
+	struct host_flash_verify_cache_testing cache;
+	uint32_t block_size = 0x18000;
+	uint32_t zero_size = 0;
+	int status;
+
+	TEST_START;
+
+	host_flash_verify_cache_testing_init (test, &cache);
+
+	status = mock_expect (&cache.filter.mock, cache.filter.base.get_dirty_block_bitmap,
+		&cache.filter, 0, MOCK_ARG (SPI_FILTER_CS_0), MOCK_ARG (true), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (sizeof (cache.bitmap)), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&cache.filter.mock, 4, &block_size, sizeof (block_size), -1);
+
+	status |= mock_expect (&cache.filter.mock, cache.filter.base.get_dirty_block_bitmap,
+		&cache.filter, 0, MOCK_ARG (SPI_FILTER_CS_0), MOCK_ARG (true), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (sizeof (cache.bitmap)), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&cache.filter.mock, 4, &zero_size, sizeof (zero_size), -1);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_flash_verify_cache_start_verification (&cache.test, SPI_FILTER_CS_0);
+	CuAssertIntEquals (test, HOST_FLASH_VERIFY_CACHE_BAD_BLOCK_SIZE, status);
+
+	status = host_flash_verify_cache_start_verification (&cache.test, SPI_FILTER_CS_0);
+	CuAssertIntEquals (test, HOST_FLASH_VERIFY_CACHE_BAD_BLOCK_SIZE, status);
+
+	host_flash_verify_cache_testing_release (test, &cache);
+}
+
+static void host_flash_verify_cache_test_start_verification_null (CuTest *test)
+{
+	struct host_flash_verify_cache_testing cache;
+	int status;
+
+	TEST_START;
+
+	host_flash_verify_cache_testing_init (test, &cache);
+
+	status = host_flash_verify_cache_start_verification (NULL, SPI_FILTER_CS_0);
+	CuAssertIntEquals (test, HOST_FLASH_VERIFY_CACHE_INVALID_ARGUMENT, status);
+
+	status = host_flash_verify_cache_start_verification (&cache.test,
+		(spi_filter_cs) HOST_FLASH_VERIFY_CACHE_MAX_DEVICES);
+	CuAssertIntEquals (test, HOST_FLASH_VERIFY_CACHE_INVALID_ARGUMENT, status);
+
+	host_flash_verify_cache_testing_release (test, &cache);
+}
+
+static void host_flash_verify_cache_test_invalidate (CuTest *test)
+{
+	struct host_flash_verify_cache_testing cache;
+	struct flash_region regions[] = {{0, 0x10000}};
+	uint8_t clean[4] = {0};
+	uint8_t layout[SHA256_HASH_LENGTH];
+	uint8_t digest[SHA256_HASH_LENGTH];
+	bool found;
+
+	TEST_START;
+
+	memcpy (layout, SHA256_TEST_HASH, sizeof (layout));
+
+	host_flash_verify_cache_testing_init (test, &cache);
+
+	host_flash_verify_cache_testing_start (test, &cache, SPI_FILTER_CS_0, clean);
+
+	host_flash_verify_cache_update_digest (&cache.test, regions, 1, HASH_TYPE_SHA256,
+		SHA256_TEST_HASH, SHA256_HASH_LENGTH);
+	host_flash_verify_cache_set_layout_checked (&cache.test, layout);
+
+	host_flash_verify_cache_invalidate (&cache.test);
+
+	found = host_flash_verify_cache_get_digest (&cache.test, regions, 1, HASH_TYPE_SHA256, digest,
+		sizeof (digest));
+	CuAssertIntEquals (test, false, found);
+
+	host_flash_verify_cache_testing_start (test, &cache, SPI_FILTER_CS_0, clean);
+
+	found = host_flash_verify_cache_get_digest (&cache.test, regions, 1, HASH_TYPE_SHA256, digest,
+		sizeof (digest));
+	CuAssertIntEquals (test, false, found);
+
+	found = host_flash_verify_cache_is_layout_checked (&cache.test, layout);
+	CuAssertIntEquals (test, false, found);
+
+	host_flash_verify_cache_testing_release (test, &cache);
+}
+
+static void host_flash_verify_cache_test_invalidate_null (CuTest *test)
+{
+	TEST_START;
+
+	host_flash_verify_cache_invalidate (NULL);
+}
+
+static void host_flash_verify_cache_test_invalidate_region (CuTest *test)
+{
+	struct host_flash_verify_cache_testing cache;
+	struct flash_region image1[] = {{0, 0x10000}};
+	struct flash_region image2[] = {{0x10000, 0x10000}};
+	uint8_t clean[4] = {0};
+	uint8_t layout[SHA256_HASH_LENGTH];
+	uint8_t digest[SHA256_HASH_LENGTH];
+	bool found;
+
+	TEST_START;
+
+	memcpy (layout, SHA256_TEST_HASH, sizeof (layout));
+
+	host_flash_verify_cache_testing_init (test, &cache);
+
+	host_flash_verify_cache_testing_start (test, &cache, SPI_FILTER_CS_0, clean);
+
+	host_flash_verify_cache_update_digest (&cache.test, image1, 1, HASH_TYPE_SHA256,
+		SHA256_TEST_HASH, SHA256_HASH_LENGTH);
+	host_flash_verify_cache_update_digest (&cache.test, image2, 1, HASH_TYPE_SHA256,
+		SHA256_TEST_HASH, SHA256_HASH_LENGTH);
+	host_flash_verify_cache_set_layout_checked (&cache.test, layout);
+
+	host_flash_verify_cache_invalidate_region (&cache.test, SPI_FILTER_CS_1, 0, 0x20000);
+	host_flash_verify_cache_invalidate_region (&cache.test, SPI_FILTER_CS_0, 0x10000, 0x100);
+
+	host_flash_verify_cache_testing_start (test, &cache, SPI_FILTER_CS_0, clean);
+
+	found = host_flash_verify_cache_get_digest (&cache.test, image1, 1, HASH_TYPE_SHA256, digest,
+		sizeof (digest));
+	CuAssertIntEquals (test, true, found);
+
+	found = host_flash_verify_cache_get_digest (&cache.test, image2, 1, HASH_TYPE_SHA256, digest,
+		sizeof (digest));
+	CuAssertIntEquals (test, false, found);
+
+	found = host_flash_verify_cache_is_layout_checked (&cache.test, layout);
+	CuAssertIntEquals (test, false, found);
+
+	host_flash_verify_cache_testing_release (test, &cache);
+}
+
+static void host_flash_verify_cache_test_invalidate_read_write_regions (CuTest *test)
+{
+	struct host_flash_verify_cache_testing cache;
+	struct flash_region image1[] = {{0, 0x10000}};
+	struct flash_region image2[] = {{0x30000, 0x10000}};
+	struct flash_region rw1[] = {{0x20000, 0x10000}};
+	struct flash_region rw2[] = {{0x50000, 0x10000}, {0x38000, 0x1000}};
+	struct pfm_read_write_regions writable[] = {
+		{.regions = rw1, .properties = NULL, .count = 1},
+		{.regions = rw2, .properties = NULL, .count = 2}
+	};
+	uint8_t clean[4] = {0};
+	uint8_t digest[SHA256_HASH_LENGTH];
+	bool found;
+
+	TEST_START;
+
+	host_flash_verify_cache_testing_init (test, &cache);
+
+	host_flash_verify_cache_testing_start (test, &cache, SPI_FILTER_CS_0, clean);
+
+	host_flash_verify_cache_update_digest (&cache.test, image1, 1, HASH_TYPE_SHA256,
+		SHA256_TEST_HASH, SHA256_HASH_LENGTH);
+	host_flash_verify_cache_update_digest (&cache.test, image2, 1, HASH_TYPE_SHA256,
+		SHA256_TEST_HASH, SHA256_HASH_LENGTH);
+
+	host_flash_verify_cache_invalidate_read_write_regions (&cache.test, SPI_FILTER_CS_0, writable,
+		2);
+
+	host_flash_verify_cache_testing_start (test, &cache, SPI_FILTER_CS_0, clean);
+
+	found = host_flash_verify_cache_get_digest (&cache.test, image1, 1, HASH_TYPE_SHA256, digest,
+		sizeof (digest));
+	CuAssertIntEquals (test, true, found);
+
+	found = host_flash_verify_cache_get_digest (&cache.test, image2, 1, HASH_TYPE_SHA256, digest,
+		sizeof (digest));
+	CuAssertIntEquals (test, false, found);
+
+	host_flash_verify_cache_testing_release (test, &cache);
+}
+
+static void host_flash_verify_cache_test_layout_checked (CuTest *test)
+{
+	struct host_flash_verify_cache_testing cache;
+	uint8_t clean[4] = {0};
+	uint8_t dirty[4] = {0x01, 0x00, 0x00, 0x00};
+	uint8_t layout[SHA256_HASH_LENGTH];
+	uint8_t other[SHA256_HASH_LENGTH];
+	bool checked;
+
+	TEST_START;
+
+	memcpy (layout, SHA256_TEST_HASH, sizeof (layout));
+	memcpy (other, SHA256_TEST2_HASH, sizeof (other));
+
+	host_flash_verify_cache_testing_init (test, &cache);
+
+	host_flash_verify_cache_testing_start (test, &cache, SPI_FILTER_CS_0, clean);
+
+	checked = host_flash_verify_cache_is_layout_checked (&cache.test, layout);
+	CuAssertIntEquals (test, false, checked);
+
+	host_flash_verify_cache_set_layout_checked (&cache.test, layout);
+
+	/* Host writes don't invalidate the layout, since only the dirty blocks need to be checked. */
+	host_flash_verify_cache_testing_start (test, &cache, SPI_FILTER_CS_0, dirty);
+
+	checked = host_flash_verify_cache_is_layout_checked (&cache.test, layout);
+	CuAssertIntEquals (test, true, checked);
+
+	checked = host_flash_verify_cache_is_layout_checked (&cache.test, other);
+	CuAssertIntEquals (test, false, checked);
+
+	host_flash_verify_cache_testing_start (test, &cache, SPI_FILTER_CS_1, clean);
+
+	checked = host_flash_verify_cache_is_layout_checked (&cache.test, layout);
+	CuAssertIntEquals (test, false, checked);
+
+	host_flash_verify_cache_testing_release (test, &cache);
+}
+
+static void host_flash_verify_cache_test_layout_checked_not_confirmed (CuTest *test)
+{
+	struct host_flash_verify_cache_testing cache;
+	uint8_t clean[4] = {0};
+	uint8_t layout[SHA256_HASH_LENGTH];
+	bool checked;
+
+	TEST_START;
+
+	memcpy (layout, SHA256_TEST_HASH, sizeof (layout));
+
+	host_flash_verify_cache_testing_init (test, &cache);
+
+	host_flash_verify_cache_testing_start (test, &cache, SPI_FILTER_CS_0, clean);
+	host_flash_verify_cache_set_layout_checked (&cache.test, layout);
+
+	host_flash_verify_cache_testing_start (test, &cache, SPI_FILTER_CS_0, clean);
+
+	checked = host_flash_verify_cache_is_layout_checked (&cache.test, layout);
+	CuAssertIntEquals (test, true, checked);
+
+	/* The previous verification didn't confirm the unused regions were still good. */
+	host_flash_verify_cache_testing_start (test, &cache, SPI_FILTER_CS_0, clean);
+
+	checked = host_flash_verify_cache_is_layout_checked (&cache.test, layout);
+	CuAssertIntEquals (test, false, checked);
+
+	host_flash_verify_cache_testing_release (test, &cache);
+}
+
+static void host_flash_verify_cache_test_layout_checked_null (CuTest *test)
+{
+	struct host_flash_verify_cache_testing cache;
+	uint8_t clean[4] = {0};
+	uint8_t layout[SHA256_HASH_LENGTH];
+	bool checked;
+
+	TEST_START;
+
+	memcpy (layout, SHA256_TEST_HASH, sizeof (layout));
+
+	host_flash_verify_cache_testing_init (test, &cache);
+
+	host_flash_verify_cache_testing_start (test, &cache, SPI_FILTER_CS_0, clean);
+	host_flash_verify_cache_set_layout_checked (NULL, layout);
+	host_flash_verify_cache_set_layout_checked (&cache.test, NULL);
+
+	host_flash_verify_cache_testing_start (test, &cache, SPI_FILTER_CS_0, clean);
+
+	checked = host_flash_verify_cache_is_layout_checked (&cache.test, layout);
+	CuAssertIntEquals (test, false, checked);
+
+	checked = host_flash_verify_cache_is_layout_checked (NULL, layout);
+	CuAssertIntEquals (test, false, checked);
+
+	checked = host_flash_verify_cache_is_layout_checked (&cache.test, NULL);
+	CuAssertIntEquals (test, false, checked);
+
+	host_flash_verify_cache_testing_release (test, &cache);
+}
+
+static void host_flash_verify_cache_test_find_dirty_range (CuTest *test)
+{
+	struct host_flash_verify_cache_testing cache;
+	uint8_t dirty[4] = {0x06, 0x80, 0x01, 0x00};
+	uint32_t addr;
+	uint32_t length;
+	bool found;
+
+	TEST_START;
+
+	host_flash_verify_cache_testing_init (test, &cache);
+
+	host_flash_verify_cache_testing_start (test, &cache, SPI_FILTER_CS_0, dirty);
+
+	addr = 0x8000;
+	length = 0x1f8000;
+	found = host_flash_verify_cache_find_dirty_range (&cache.test, &addr, &length);
+	CuAssertIntEquals (test, true, found);
+	CuAssertIntEquals (test, 0x10000, addr);
+	CuAssertIntEquals (test, 0x20000, length);
+
+	addr = 0x30000;
+	length = 0x1d0000;
+	found = host_flash_verify_cache_find_dirty_range (&cache.test, &addr, &length);
+	CuAssertIntEquals (test, true, found);
+	CuAssertIntEquals (test, 0xf0000, addr);
+	CuAssertIntEquals (test, 0x20000, length);
+
+	addr = 0x110000;
+	length = 0xf0000;
+	found = host_flash_verify_cache_find_dirty_range (&cache.test, &addr, &length);
+	CuAssertIntEquals (test, false, found);
+
+	host_flash_verify_cache_testing_release (test, &cache);
+}
+
+static void host_flash_verify_cache_test_find_dirty_range_partial_block (CuTest *test)
+{
+	struct host_flash_verify_cache_testing cache;
+	uint8_t dirty[4] = {0x02, 0x00, 0x00, 0x00};
+	uint32_t addr;
+	uint32_t length;
+	bool found;
+
+	TEST_START;
+
+	host_flash_verify_cache_testing_init (test, &cache);
+
+	host_flash_verify_cache_testing_start (test, &cache, SPI_FILTER_CS_0, dirty);
+
+	addr = 0x18000;
+	length = 0x100;
+	found = host_flash_verify_cache_find_dirty_range (&cache.test, &addr, &length);
+	CuAssertIntEquals (test, true, found);
+	CuAssertIntEquals (test, 0x18000, addr);
+	CuAssertIntEquals (test, 0x100, length);
+
+	host_flash_verify_cache_testing_release (test, &cache);
+}
+
+static void host_flash_verify_cache_test_find_dirty_range_beyond_bitmap (CuTest *test)
+{
+	struct host_flash_verify_cache_testing cache;
+	uint8_t clean[4] = {0};
+	uint32_t addr;
+	uint32_t length;
+	bool found;
+
+	TEST_START;
+
+	host_flash_verify_cache_testing_init (test, &cache);
+
+	host_flash_verify_cache_testing_start (test, &cache, SPI_FILTER_CS_0, clean);
+
+	addr = 0x1f0000;
+	length = 0x20000;
+	found = host_flash_verify_cache_find_dirty_range (&cache.test, &addr, &length);
+	CuAssertIntEquals (test, true, found);
+	CuAssertIntEquals (test, 0x200000, addr);
+	CuAssertIntEquals (test, 0x10000, length);
+
+	host_flash_verify_cache_testing_release (test, &cache);
+}
+
+static void host_flash_verify_cache_test_find_dirty_range_not_tracking (CuTest *test)
+{
+	struct host_flash_verify_cache_testing cache;
+	uint32_t addr;
+	uint32_t length;
+	bool found;
+
+	TEST_START;
+
+	host_flash_verify_cache_testing_init (test, &cache);
+
+	addr = 0x8000;
+	length = 0x1000;
+	found = host_flash_verify_cache_find_dirty_range (&cache.test, &addr, &length);
+	CuAssertIntEquals (test, true, found);
+	CuAssertIntEquals (test, 0x8000, addr);
+	CuAssertIntEquals (test, 0x1000, length);
+
+	host_flash_verify_cache_testing_release (test, &cache);
+}
+
+static void host_flash_verify_cache_test_find_dirty_range_null (CuTest *test)
+{
+	struct host_flash_verify_cache_testing cache;
+	uint32_t addr = 0;
+	uint32_t length = 0x1000;
+	bool found;
+
+	TEST_START;
+
+	host_flash_verify_cache_testing_init (test, &cache);
+
+	found = host_flash_verify_cache_find_dirty_range (NULL, &addr, &length);
+	CuAssertIntEquals (test, false, found);
+
+	found = host_flash_verify_cache_find_dirty_range (&cache.test, NULL, &length);
+	CuAssertIntEquals (test, false, found);
+
+	found = host_flash_verify_cache_find_dirty_range (&cache.test, &addr, NULL);
+	CuAssertIntEquals (test, false, found);
+
+	length = 0;
+	found = host_flash_verify_cache_find_dirty_range (&cache.test, &addr, &length);
+	CuAssertIntEquals (test, false, found);
+
+	host_flash_verify_cache_testing_release (test, &cache);
+}
+
+
+TEST_SUITE_START (host_flash_verify_cache);
+
+TEST (host_flash_verify_cache_test_init);
+TEST (host_flash_verify_cache_test_init_null);
+TEST (host_flash_verify_cache_test_release_null);
+TEST (host_flash_verify_cache_test_claim);
+TEST (host_flash_verify_cache_test_claim_null);
+TEST (host_flash_verify_cache_test_get_digest);
+TEST (host_flash_verify_cache_test_get_digest_different_image);
+TEST (host_flash_verify_cache_test_get_digest_different_device);
+TEST (host_flash_verify_cache_test_get_digest_not_started);
+TEST (host_flash_verify_cache_test_get_digest_null);
+TEST (host_flash_verify_cache_test_update_digest_replace_existing);
+TEST (host_flash_verify_cache_test_update_digest_cache_full);
+TEST (host_flash_verify_cache_test_update_digest_too_many_regions);
+TEST (host_flash_verify_cache_test_update_digest_wrong_length);
+TEST (host_flash_verify_cache_test_start_verification_dirty_block);
+TEST (host_flash_verify_cache_test_start_verification_dirty_other_device);
+TEST (host_flash_verify_cache_test_start_verification_unsupported);
+TEST (host_flash_verify_cache_test_start_verification_filter_error);
+TEST (host_flash_verify_cache_test_start_verification_bad_block_size);
+TEST (host_flash_verify_cache_test_start_verification_null);
+TEST (host_flash_verify_cache_test_invalidate);
+TEST (host_flash_verify_cache_test_invalidate_null);
+TEST (host_flash_verify_cache_test_invalidate_region);
+TEST (host_flash_verify_cache_test_invalidate_read_write_regions);
+TEST (host_flash_verify_cache_test_layout_checked);
+TEST (host_flash_verify_cache_test_layout_checked_not_confirmed);
+TEST (host_flash_verify_cache_test_layout_checked_null);
+TEST (host_flash_verify_cache_test_find_dirty_range);
+TEST (host_flash_verify_cache_test_find_dirty_range_partial_block);
+TEST (host_flash_verify_cache_test_find_dirty_range_beyond_bitmap);
+TEST (host_flash_verify_cache_test_find_dirty_range_not_tracking);
+TEST (host_flash_verify_cache_test_find_dirty_range_null);
+
+TEST_SUITE_END;
@@ -0,0 +1,652 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "testing.h"
+#include "host_fw/host_flash_verify_worker.h"
+#include "testing/mock/host_fw/host_flash_manager_mock.h"
+#include "testing/mock/manifest/pfm_mock.h"
+#include "testing/mock/system/event_task_mock.h"
+#include "testing/engines/hash_testing_engine.h"
+#include "testing/engines/rsa_testing_engine.h"
+
+
+TEST_SUITE_LABEL ("host_flash_verify_worker");
+
+
+/**
+ * Dependencies for testing the host flash verification worker.
+ */
+struct host_flash_verify_worker_testing {
+	HASH_TESTING_ENGINE hash;						/**< Hash engine for the worker. */
+	RSA_TESTING_ENGINE rsa;							/**< RSA engine for the worker. */
+	struct host_flash_manager_mock flash;			/**< Mock for the host flash manager. */
+	struct pfm_mock pfm;							/**< Mock for the PFM to validate against. */
+	struct pfm_mock good_pfm;						/**< Mock for a previously validated PFM. */
+	struct event_task_mock task;					/**< Mock for the worker task. */
+	struct event_task_context context;				/**< Event context for event processing. */
+	struct event_task_context *context_ptr;			/**< Pointer to the event context. */
+	struct host_flash_verify_worker_state state;	/**< Context for the worker. */
+	struct host_flash_verify_worker test;			/**< Worker under test. */
+};
+
+
+/**
+ * Initialize all dependencies for testing.
+ *
+ * @param test The testing framework.
+ * @param worker Testing dependencies to initialize.
+ */
+static void host_flash_verify_worker_testing_init_dependencies (CuTest *test,
+	struct host_flash_verify_worker_testing *worker)
+{
+	int status;
+
+	status = HASH_TESTING_ENGINE_INIT (&worker->hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&worker->rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_flash_manager_mock_init (&worker->flash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_mock_init (&worker->pfm);
+	CuAssertIntEquals (test, 0, status);
+
+	status = pfm_mock_init (&worker->good_pfm);
+	CuAssertIntEquals (test, 0, status);
+
+	status = event_task_mock_init (&worker->task);
+	CuAssertIntEquals (test, 0, status);
+
+	memset (&worker->context, 0, sizeof (worker->context));
+	worker->context_ptr = &worker->context;
+}
+
+/**
+ * Initialize a verification worker for testing.
+ *
+ * @param test The testing framework.
+ * @param worker Testing components to initialize.
+ */
+static void host_flash_verify_worker_testing_init (CuTest *test,
+	struct host_flash_verify_worker_testing *worker)
+{
+	int status;
+
+	host_flash_verify_worker_testing_init_dependencies (test, worker);
+
+	status = host_flash_verify_worker_init (&worker->test, &worker->state, &worker->hash.base,
+		&worker->rsa.base, &worker->task.base);
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Release all testing dependencies and validate all mocks.
+ *
+ * @param test The testing framework.
+ * @param worker Testing dependencies to release.
+ */
+static void host_flash_verify_worker_testing_release_dependencies (CuTest *test,
+	struct host_flash_verify_worker_testing *worker)
+{
+	int status;
+
+	status = host_flash_manager_mock_validate_and_release (&worker->flash);
+	status |= pfm_mock_validate_and_release (&worker->pfm);
+	status |= pfm_mock_validate_and_release (&worker->good_pfm);
+	status |= event_task_mock_validate_and_release (&worker->task);
+
+	CuAssertIntEquals (test, 0, status);
+
+	HASH_TESTING_ENGINE_RELEASE (&worker->hash);
+	RSA_TESTING_ENGINE_RELEASE (&worker->rsa);
+}
+
+/**
+ * Release test components and validate all mocks.
+ *
+ * @param test The testing framework.
+ * @param worker Testing components to release.
+ */
+static void host_flash_verify_worker_testing_release (CuTest *test,
+	struct host_flash_verify_worker_testing *worker)
+{
+	host_flash_verify_worker_testing_release_dependencies (test, worker);
+	host_flash_verify_worker_release (&worker->test);
+}
+
+/**
+ * Submit a read-only validation request to the worker task.
+ *
+ * @param test The testing framework.
+ * @param worker Testing components to use.
+ * @param good_pfm The previously validated PFM to provide in the request.
+ * @param full_validation The full validation flag to provide in the request.
+ */
+static void host_flash_verify_worker_testing_start (CuTest *test,
+	struct host_flash_verify_worker_testing *worker, struct pfm *good_pfm, bool full_validation)
+{
+	int status;
+
+	status = mock_expect (&worker->task.mock, worker->task.base.get_event_context, &worker->task,
+		0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&worker->task.mock, 0, &worker->context_ptr,
+		sizeof (worker->context_ptr), -1);
+
+	status |= mock_expect (&worker->task.mock, worker->task.base.notify, &worker->task, 0,
+		MOCK_ARG_PTR (&worker->test.base));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_flash_verify_worker_start_read_only_validation (&worker->test,
+		&worker->flash.base, &worker->pfm.base, good_pfm, full_validation);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, HOST_FLASH_VERIFY_WORKER_ACTION_VALIDATE_RO, worker->context.action);
+}
+
+/*******************
+ * Test cases
+ *******************/
+
+static void host_flash_verify_worker_test_init (CuTest *test)
+{
+	struct host_flash_verify_worker_testing worker;
+	int status;
+
+	TEST_START;
+
+	host_flash_verify_worker_testing_init_dependencies (test, &worker);
+
+	status = host_flash_verify_worker_init (&worker.test, &worker.state, &worker.hash.base,
+		&worker.rsa.base, &worker.task.base);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrEquals (test, NULL, worker.test.base.prepare);
+	CuAssertPtrNotNull (test, worker.test.base.execute);
+
+	host_flash_verify_worker_testing_release (test, &worker);
+}
+
+static void host_flash_verify_worker_test_init_null (CuTest *test)
+{
+	struct host_flash_verify_worker_testing worker;
+	int status;
+
+	TEST_START;
+
+	host_flash_verify_worker_testing_init_dependencies (test, &worker);
+
+	status = host_flash_verify_worker_init (NULL, &worker.state, &worker.hash.base,
+		&worker.rsa.base, &worker.task.base);
+	CuAssertIntEquals (test, HOST_FLASH_VERIFY_WORKER_INVALID_ARGUMENT, status);
+
+	status = host_flash_verify_worker_init (&worker.test, NULL, &worker.hash.base,
+		&worker.rsa.base, &worker.task.base);
+	CuAssertIntEquals (test, HOST_FLASH_VERIFY_WORKER_INVALID_ARGUMENT, status);
+
+	status = host_flash_verify_worker_init (&worker.test, &worker.state, NULL,
+		&worker.rsa.base, &worker.task.base);
+	CuAssertIntEquals (test, HOST_FLASH_VERIFY_WORKER_INVALID_ARGUMENT, status);
+
+	status = host_flash_verify_worker_init (&worker.test, &worker.state, &worker.hash.base,
+		NULL, &worker.task.base);
+	CuAssertIntEquals (test, HOST_FLASH_VERIFY_WORKER_INVALID_ARGUMENT, status);
+
+	status = host_flash_verify_worker_init (&worker.test, &worker.state, &worker.hash.base,
+		&worker.rsa.base, NULL);
+	CuAssertIntEquals (test, HOST_FLASH_VERIFY_WORKER_INVALID_ARGUMENT, status);
+
+	host_flash_verify_worker_testing_release_dependencies (test, &worker);
+}
+
+static void host_flash_verify_worker_test_init_state_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = host_flash_verify_worker_init_state (NULL);
+	CuAssertIntEquals (test, HOST_FLASH_VERIFY_WORKER_INVALID_ARGUMENT, status);
+}
+
+static void host_flash_verify_worker_test_release_null (CuTest *test)
+{
+	TEST_START;
+
+	host_flash_verify_worker_release (NULL);
+}
+
+static void host_flash_verify_worker_test_validate_read_only (CuTest *test)
+{
+	struct host_flash_verify_worker_testing worker;
+	struct flash_region rw_region;
+	struct pfm_read_write rw_prop;
+	struct pfm_read_write_regions rw_list;
+	struct host_flash_manager_rw_regions rw_host;
+	struct host_flash_manager_rw_regions result;
+	bool reset = false;
+	int status;
+
+	TEST_START;
+
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
+
+	rw_prop.on_failure = PFM_RW_DO_NOTHING;
+
+	rw_list.regions = &rw_region;
+	rw_list.properties = &rw_prop;
+	rw_list.count = 1;
+
+	rw_host.pfm = &worker.pfm.base;
+	rw_host.writable = &rw_list;
+	rw_host.count = 1;
+
+	host_flash_verify_worker_testing_init (test, &worker);
+
+	host_flash_verify_worker_testing_start (test, &worker, NULL, false);
+
+	status = mock_expect (&worker.flash.mock, worker.flash.base.validate_read_only_flash,
+		&worker.flash, 0, MOCK_ARG_PTR (&worker.pfm), MOCK_ARG_PTR (NULL),
+		MOCK_ARG_PTR (&worker.hash), MOCK_ARG_PTR (&worker.rsa), MOCK_ARG (false),
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&worker.flash.mock, 5, &rw_host, sizeof (rw_host), -1);
+
+	CuAssertIntEquals (test, 0, status);
+
+	worker.test.base.execute (&worker.test.base, worker.context_ptr, &reset);
+	CuAssertIntEquals (test, false, reset);
+
+	memset (&result, 0, sizeof (result));
+
+	status = host_flash_verify_worker_get_read_only_result (&worker.test, &result);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, &worker.pfm, (void*) result.pfm);
+	CuAssertPtrEquals (test, &rw_list, result.writable);
+	CuAssertIntEquals (test, 1, result.count);
+
+	host_flash_verify_worker_testing_release (test, &worker);
+}
+
+static void host_flash_verify_worker_test_validate_read_only_good_pfm (CuTest *test)
+{
+	struct host_flash_verify_worker_testing worker;
+	struct flash_region rw_region;
+	struct pfm_read_write rw_prop;
+	struct pfm_read_write_regions rw_list;
+	struct host_flash_manager_rw_regions rw_host;
+	struct host_flash_manager_rw_regions result;
+	bool reset = false;
+	int status;
+
+	TEST_START;
+
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
+
+	rw_prop.on_failure = PFM_RW_DO_NOTHING;
+
+	rw_list.regions = &rw_region;
+	rw_list.properties = &rw_prop;
+	rw_list.count = 1;
+
+	rw_host.pfm = &worker.pfm.base;
+	rw_host.writable = &rw_list;
+	rw_host.count = 1;
+
+	host_flash_verify_worker_testing_init (test, &worker);
+
+	host_flash_verify_worker_testing_start (test, &worker, &worker.good_pfm.base, false);
+
+	status = mock_expect (&worker.flash.mock, worker.flash.base.validate_read_only_flash,
+		&worker.flash, 0, MOCK_ARG_PTR (&worker.pfm), MOCK_ARG_PTR (&worker.good_pfm),
+		MOCK_ARG_PTR (&worker.hash), MOCK_ARG_PTR (&worker.rsa), MOCK_ARG (false),
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&worker.flash.mock, 5, &rw_host, sizeof (rw_host), -1);
+
+	CuAssertIntEquals (test, 0, status);
+
+	worker.test.base.execute (&worker.test.base, worker.context_ptr, &reset);
+	CuAssertIntEquals (test, false, reset);
+
+	status = host_flash_verify_worker_get_read_only_result (&worker.test, &result);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, &rw_list, result.writable);
+
+	host_flash_verify_worker_testing_release (test, &worker);
+}
+
+static void host_flash_verify_worker_test_validate_read_only_full_validation (CuTest *test)
+{
+	struct host_flash_verify_worker_testing worker;
+	struct flash_region rw_region;
+	struct pfm_read_write rw_prop;
+	struct pfm_read_write_regions rw_list;
+	struct host_flash_manager_rw_regions rw_host;
+	struct host_flash_manager_rw_regions result;
+	bool reset = false;
+	int status;
+
+	TEST_START;
+
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
+
+	rw_prop.on_failure = PFM_RW_DO_NOTHING;
+
+	rw_list.regions = &rw_region;
+	rw_list.properties = &rw_prop;
+	rw_list.count = 1;
+
+	rw_host.pfm = &worker.pfm.base;
+	rw_host.writable = &rw_list;
+	rw_host.count = 1;
+
+	host_flash_verify_worker_testing_init (test, &worker);
+
+	host_flash_verify_worker_testing_start (test, &worker, NULL, true);
+
+	status = mock_expect (&worker.flash.mock, worker.flash.base.validate_read_only_flash,
+		&worker.flash, 0, MOCK_ARG_PTR (&worker.pfm), MOCK_ARG_PTR (NULL),
+		MOCK_ARG_PTR (&worker.hash), MOCK_ARG_PTR (&worker.rsa), MOCK_ARG (true),
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&worker.flash.mock, 5, &rw_host, sizeof (rw_host), -1);
+
+	CuAssertIntEquals (test, 0, status);
+
+	worker.test.base.execute (&worker.test.base, worker.context_ptr, &reset);
+	CuAssertIntEquals (test, false, reset);
+
+	status = host_flash_verify_worker_get_read_only_result (&worker.test, &result);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, &rw_list, result.writable);
+
+	host_flash_verify_worker_testing_release (test, &worker);
+}
+
+static void host_flash_verify_worker_test_validate_read_only_validation_fail (CuTest *test)
+{
+	struct host_flash_verify_worker_testing worker;
+	struct host_flash_manager_rw_regions result;
+	bool reset = false;
+	int status;
+
+	TEST_START;
+
+	host_flash_verify_worker_testing_init (test, &worker);
+
+	host_flash_verify_worker_testing_start (test, &worker, NULL, false);
+
+	status = mock_expect (&worker.flash.mock, worker.flash.base.validate_read_only_flash,
+		&worker.flash, RSA_ENGINE_BAD_SIGNATURE, MOCK_ARG_PTR (&worker.pfm), MOCK_ARG_PTR (NULL),
+		MOCK_ARG_PTR (&worker.hash), MOCK_ARG_PTR (&worker.rsa), MOCK_ARG (false),
+		MOCK_ARG_NOT_NULL);
+
+	CuAssertIntEquals (test, 0, status);
+
+	worker.test.base.execute (&worker.test.base, worker.context_ptr, &reset);
+	CuAssertIntEquals (test, false, reset);
+
+	memset (&result, 0, sizeof (result));
+
+	status = host_flash_verify_worker_get_read_only_result (&worker.test, &result);
+	CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
+	CuAssertPtrEquals (test, NULL, result.writable);
+
+	host_flash_verify_worker_testing_release (test, &worker);
+}
+
+static void host_flash_verify_worker_test_validate_read_only_multiple (CuTest *test)
+{
+	struct host_flash_verify_worker_testing worker;
+	struct flash_region rw_region;
+	struct pfm_read_write rw_prop;
+	struct pfm_read_write_regions rw_list;
+	struct host_flash_manager_rw_regions rw_host;
+	struct host_flash_manager_rw_regions result;
+	bool reset = false;
+	int status;
+
+	TEST_START;
+
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
+
+	rw_prop.on_failure = PFM_RW_DO_NOTHING;
+
+	rw_list.regions = &rw_region;
+	rw_list.properties = &rw_prop;
+	rw_list.count = 1;
+
+	rw_host.pfm = &worker.pfm.base;
+	rw_host.writable = &rw_list;
+	rw_host.count = 1;
+
+	host_flash_verify_worker_testing_init (test, &worker);
+
+	/* First validation fails. */
+	host_flash_verify_worker_testing_start (test, &worker, NULL, false);
+
+	status = mock_expect (&worker.flash.mock, worker.flash.base.validate_read_only_flash,
+		&worker.flash, RSA_ENGINE_BAD_SIGNATURE, MOCK_ARG_PTR (&worker.pfm), MOCK_ARG_PTR (NULL),
+		MOCK_ARG_PTR (&worker.hash), MOCK_ARG_PTR (&worker.rsa), MOCK_ARG (false),
+		MOCK_ARG_NOT_NULL);
+
+	CuAssertIntEquals (test, 0, status);
+
+	worker.test.base.execute (&worker.test.base, worker.context_ptr, &reset);
+
+	status = host_flash_verify_worker_get_read_only_result (&worker.test, &result);
+	CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
+
+	/* Second validation is successful. */
+	host_flash_verify_worker_testing_start (test, &worker, NULL, false);
+
+	status = mock_expect (&worker.flash.mock, worker.flash.base.validate_read_only_flash,
+		&worker.flash, 0, MOCK_ARG_PTR (&worker.pfm), MOCK_ARG_PTR (NULL),
+		MOCK_ARG_PTR (&worker.hash), MOCK_ARG_PTR (&worker.rsa), MOCK_ARG (false),
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&worker.flash.mock, 5, &rw_host, sizeof (rw_host), -1);
+
+	CuAssertIntEquals (test, 0, status);
+
+	worker.test.base.execute (&worker.test.base, worker.context_ptr, &reset);
+
+	status = host_flash_verify_worker_get_read_only_result (&worker.test, &result);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, &rw_list, result.writable);
+
+	host_flash_verify_worker_testing_release (test, &worker);
+}
+
+static void host_flash_verify_worker_test_execute_unknown_action (CuTest *test)
+{
+	struct host_flash_verify_worker_testing worker;
+	struct host_flash_manager_rw_regions result;
+	bool reset = false;
+	int status;
+
+	TEST_START;
+
+	host_flash_verify_worker_testing_init (test, &worker);
+
+	host_flash_verify_worker_testing_start (test, &worker, NULL, false);
+	worker.context.action = HOST_FLASH_VERIFY_WORKER_ACTION_VALIDATE_RO + 1;
+
+	worker.test.base.execute (&worker.test.base, worker.context_ptr, &reset);
+	CuAssertIntEquals (test, false, reset);
+
+	status = host_flash_verify_worker_get_read_only_result (&worker.test, &result);
+	CuAssertIntEquals (test, HOST_FLASH_VERIFY_WORKER_UNKNOWN_ACTION, status);
+
+	host_flash_verify_worker_testing_release (test, &worker);
+}
+
+static void host_flash_verify_worker_test_execute_bad_request_length (CuTest *test)
+{
+	struct host_flash_verify_worker_testing worker;
+	struct host_flash_manager_rw_regions result;
+	bool reset = false;
+	int status;
+
+	TEST_START;
+
+	host_flash_verify_worker_testing_init (test, &worker);
+
+	host_flash_verify_worker_testing_start (test, &worker, NULL, false);
+	worker.context.buffer_length--;
+
+	worker.test.base.execute (&worker.test.base, worker.context_ptr, &reset);
+	CuAssertIntEquals (test, false, reset);
+
+	status = host_flash_verify_worker_get_read_only_result (&worker.test, &result);
+	CuAssertIntEquals (test, HOST_FLASH_VERIFY_WORKER_UNKNOWN_ACTION, status);
+
+	host_flash_verify_worker_testing_release (test, &worker);
+}
+
+static void host_flash_verify_worker_test_start_read_only_validation_null (CuTest *test)
+{
+	struct host_flash_verify_worker_testing worker;
+	int status;
+
+	TEST_START;
+
+	host_flash_verify_worker_testing_init (test, &worker);
+
+	status = host_flash_verify_worker_start_read_only_validation (NULL, &worker.flash.base,
+		&worker.pfm.base, NULL, false);
+	CuAssertIntEquals (test, HOST_FLASH_VERIFY_WORKER_INVALID_ARGUMENT, status);
+
+	status = host_flash_verify_worker_start_read_only_validation (&worker.test, NULL,
+		&worker.pfm.base, NULL, false);
+	CuAssertIntEquals (test, HOST_FLASH_VERIFY_WORKER_INVALID_ARGUMENT, status);
+
+	status = host_flash_verify_worker_start_read_only_validation (&worker.test,
+		&worker.flash.base, NULL, NULL, false);
+	CuAssertIntEquals (test, HOST_FLASH_VERIFY_WORKER_INVALID_ARGUMENT, status);
+
+	host_flash_verify_worker_testing_release (test, &worker);
+}
+
+static void host_flash_verify_worker_test_start_read_only_validation_no_task (CuTest *test)
+{
+	struct host_flash_verify_worker_testing worker;
+	int status;
+
+	TEST_START;
+
+	host_flash_verify_worker_testing_init (test, &worker);
+
+	worker.context_ptr = NULL;
+
+	status = mock_expect (&worker.task.mock, worker.task.base.get_event_context, &worker.task,
+		EVENT_TASK_NO_TASK, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&worker.task.mock, 0, &worker.context_ptr,
+		sizeof (worker.context_ptr), -1);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_flash_verify_worker_start_read_only_validation (&worker.test,
+		&worker.flash.base, &worker.pfm.base, NULL, false);
+	CuAssertIntEquals (test, EVENT_TASK_NO_TASK, status);
+
+	host_flash_verify_worker_testing_release (test, &worker);
+}
+
+static void host_flash_verify_worker_test_start_read_only_validation_task_busy (CuTest *test)
+{
+	struct host_flash_verify_worker_testing worker;
+	int status;
+
+	TEST_START;
+
+	host_flash_verify_worker_testing_init (test, &worker);
+
+	worker.context_ptr = NULL;
+
+	status = mock_expect (&worker.task.mock, worker.task.base.get_event_context, &worker.task,
+		EVENT_TASK_BUSY, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&worker.task.mock, 0, &worker.context_ptr,
+		sizeof (worker.context_ptr), -1);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_flash_verify_worker_start_read_only_validation (&worker.test,
+		&worker.flash.base, &worker.pfm.base, NULL, false);
+	CuAssertIntEquals (test, EVENT_TASK_BUSY, status);
+
+	host_flash_verify_worker_testing_release (test, &worker);
+}
+
+static void host_flash_verify_worker_test_start_read_only_validation_notify_error (
+	CuTest *test)
+{
+	struct host_flash_verify_worker_testing worker;
+	int status;
+
+	TEST_START;
+
+	host_flash_verify_worker_testing_init (test, &worker);
+
+	status = mock_expect (&worker.task.mock, worker.task.base.get_event_context, &worker.task,
+		0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&worker.task.mock, 0, &worker.context_ptr,
+		sizeof (worker.context_ptr), -1);
+
+	status |= mock_expect (&worker.task.mock, worker.task.base.notify, &worker.task,
+		EVENT_TASK_NOTIFY_FAILED, MOCK_ARG_PTR (&worker.test.base));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_flash_verify_worker_start_read_only_validation (&worker.test,
+		&worker.flash.base, &worker.pfm.base, NULL, false);
+	CuAssertIntEquals (test, EVENT_TASK_NOTIFY_FAILED, status);
+
+	host_flash_verify_worker_testing_release (test, &worker);
+}
+
+static void host_flash_verify_worker_test_get_read_only_result_null (CuTest *test)
+{
+	struct host_flash_verify_worker_testing worker;
+	struct host_flash_manager_rw_regions result;
+	int status;
+
+	TEST_START;
+
+	host_flash_verify_worker_testing_init (test, &worker);
+
+	status = host_flash_verify_worker_get_read_only_result (NULL, &result);
+	CuAssertIntEquals (test, HOST_FLASH_VERIFY_WORKER_INVALID_ARGUMENT, status);
+
+	status = host_flash_verify_worker_get_read_only_result (&worker.test, NULL);
+	CuAssertIntEquals (test, HOST_FLASH_VERIFY_WORKER_INVALID_ARGUMENT, status);
+
+	host_flash_verify_worker_testing_release (test, &worker);
+}
+
+
+TEST_SUITE_START (host_flash_verify_worker);
+
+TEST (host_flash_verify_worker_test_init);
+TEST (host_flash_verify_worker_test_init_null);
+TEST (host_flash_verify_worker_test_init_state_null);
+TEST (host_flash_verify_worker_test_release_null);
+TEST (host_flash_verify_worker_test_validate_read_only);
+TEST (host_flash_verify_worker_test_validate_read_only_good_pfm);
+TEST (host_flash_verify_worker_test_validate_read_only_full_validation);
+TEST (host_flash_verify_worker_test_validate_read_only_validation_fail);
+TEST (host_flash_verify_worker_test_validate_read_only_multiple);
+TEST (host_flash_verify_worker_test_execute_unknown_action);
+TEST (host_flash_verify_worker_test_execute_bad_request_length);
+TEST (host_flash_verify_worker_test_start_read_only_validation_null);
+TEST (host_flash_verify_worker_test_start_read_only_validation_no_task);
+TEST (host_flash_verify_worker_test_start_read_only_validation_task_busy);
+TEST (host_flash_verify_worker_test_start_read_only_validation_notify_error);
+TEST (host_flash_verify_worker_test_get_read_only_result_null);
+
+TEST_SUITE_END;
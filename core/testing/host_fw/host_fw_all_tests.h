@@ -45,6 +45,18 @@ static void add_all_host_fw_tests (CuSuite *suite)
 	!defined TESTING_SKIP_HOST_FLASH_MANAGER_SINGLE_SUITE
 	TESTING_RUN_SUITE (host_flash_manager_single);
 #endif
+#if (defined TESTING_RUN_HOST_FLASH_VERIFY_CACHE_SUITE || \
+		defined TESTING_RUN_ALL_TESTS || defined TESTING_RUN_ALL_CORE_TESTS || \
+		(!defined TESTING_SKIP_ALL_TESTS && !defined TESTING_SKIP_ALL_CORE_TESTS)) && \
+	!defined TESTING_SKIP_HOST_FLASH_VERIFY_CACHE_SUITE
+	TESTING_RUN_SUITE (host_flash_verify_cache);
+#endif
+#if (defined TESTING_RUN_HOST_FLASH_VERIFY_WORKER_SUITE || \
+		defined TESTING_RUN_ALL_TESTS || defined TESTING_RUN_ALL_CORE_TESTS || \
+		(!defined TESTING_SKIP_ALL_TESTS && !defined TESTING_SKIP_ALL_CORE_TESTS)) && \
+	!defined TESTING_SKIP_HOST_FLASH_VERIFY_WORKER_SUITE
+	TESTING_RUN_SUITE (host_flash_verify_worker);
+#endif
 #if (defined TESTING_RUN_HOST_FW_UTIL_SUITE || \
 		defined TESTING_RUN_ALL_TESTS || defined TESTING_RUN_ALL_CORE_TESTS || \
 		(!defined TESTING_SKIP_ALL_TESTS && !defined TESTING_SKIP_ALL_CORE_TESTS)) && \
@@ -6,12 +6,15 @@
 #include <string.h>
 #include "testing.h"
 #include "host_fw/host_fw_util.h"
+#include "host_fw/host_logging.h"
 #include "testing/mock/flash/flash_master_mock.h"
 #include "testing/mock/spi_filter/spi_filter_interface_mock.h"
+#include "testing/mock/logging/logging_mock.h"
 #include "testing/engines/hash_testing_engine.h"
 #include "testing/engines/rsa_testing_engine.h"
 #include "testing/crypto/rsa_testing.h"
 #include "testing/crypto/hash_testing.h"
+#include "testing/logging/debug_log_testing.h"
 
 
 TEST_SUITE_LABEL ("host_fw_util");
@@ -13376,6 +13379,544 @@ static void host_fw_verify_offset_images_multiple_fw_test_null (CuTest *test)
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
+/**
+ * Set up the expectation for the SPI filter to report host writes to a flash device when
+ * verification with a cache is started.
+ *
+ * @param filter The mock SPI filter to update.
+ * @param cs The flash device being verified.
+ * @param dirty The dirty block bitmap to report.
+ * @param length Length of the dirty block bitmap.
+ * @param block_size The block size to report.
+ *
+ * @return 0 if the expectation was added successfully or non-zero if not.
+ */
+static int host_fw_util_testing_expect_dirty_blocks (struct spi_filter_interface_mock *filter,
+	spi_filter_cs cs, const uint8_t *dirty, size_t length, uint32_t block_size)
+{
+	int status;
+
+	status = mock_expect (&filter->mock, filter->base.get_dirty_block_bitmap, filter, 0,
+		MOCK_ARG (cs), MOCK_ARG (true), MOCK_ARG_NOT_NULL, MOCK_ARG (length), MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output_tmp (&filter->mock, 2, dirty, length, 3);
+	status |= mock_expect_output_tmp (&filter->mock, 4, &block_size, sizeof (block_size), -1);
+
+	return status;
+}
+
+static void host_fw_verify_images_multiple_fw_with_cache_test (CuTest *test)
+{
+	struct flash_region region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct spi_filter_interface_mock filter;
+	struct host_flash_verify_cache_entry entries[2];
+	struct host_flash_verify_cache cache;
+	uint8_t bitmap[4];
+	uint8_t clean[4] = {0};
+	uint8_t dirty[4] = {0x02, 0x00, 0x00, 0x00};
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	int status;
+	char *data = "Test";
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_init (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_filter_interface_mock_enable_dirty_block_tracking (&filter);
+
+	status = host_flash_verify_cache_init (&cache, &filter.base, entries, 2, bitmap,
+		sizeof (bitmap));
+	CuAssertIntEquals (test, 0, status);
+
+	region.start_addr = 0x10000;
+	region.length = strlen (data);
+
+	sig.regions = &region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
+
+	list.images_sig = &sig;
+	list.images_hash = NULL;
+	list.count = 1;
+
+	/* First verification needs to read the image. */
+	status = host_fw_util_testing_expect_dirty_blocks (&filter, SPI_FILTER_CS_1, clean,
+		sizeof (clean), 0x10000);
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
+		FLASH_EXP_READ_CMD (0x03, 0x10000, 0, -1, strlen (data)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_verify_images_multiple_fw_with_cache (&flash, &list, 1, &hash.base,
+		&rsa.base, &cache, SPI_FILTER_CS_1);
+	CuAssertIntEquals (test, 0, status);
+
+	/* No host writes, so the image doesn't need to be read. */
+	status = host_fw_util_testing_expect_dirty_blocks (&filter, SPI_FILTER_CS_1, clean,
+		sizeof (clean), 0x10000);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_verify_images_multiple_fw_with_cache (&flash, &list, 1, &hash.base,
+		&rsa.base, &cache, SPI_FILTER_CS_1);
+	CuAssertIntEquals (test, 0, status);
+
+	/* The host wrote to the image. */
+	status = host_fw_util_testing_expect_dirty_blocks (&filter, SPI_FILTER_CS_1, dirty,
+		sizeof (dirty), 0x10000);
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
+		FLASH_EXP_READ_CMD (0x03, 0x10000, 0, -1, strlen (data)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_verify_images_multiple_fw_with_cache (&flash, &list, 1, &hash.base,
+		&rsa.base, &cache, SPI_FILTER_CS_1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_validate_and_release (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_verify_cache_release (&cache);
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void host_fw_verify_images_multiple_fw_with_cache_test_invalid (CuTest *test)
+{
+	struct flash_region region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct spi_filter_interface_mock filter;
+	struct host_flash_verify_cache_entry entries[2];
+	struct host_flash_verify_cache cache;
+	uint8_t bitmap[4];
+	uint8_t clean[4] = {0};
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	int status;
+	char *data = "Test";
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_init (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_filter_interface_mock_enable_dirty_block_tracking (&filter);
+
+	status = host_flash_verify_cache_init (&cache, &filter.base, entries, 2, bitmap,
+		sizeof (bitmap));
+	CuAssertIntEquals (test, 0, status);
+
+	region.start_addr = 0x10000;
+	region.length = strlen (data);
+
+	sig.regions = &region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
+
+	list.images_sig = &sig;
+	list.images_hash = NULL;
+	list.count = 1;
+
+	status = host_fw_util_testing_expect_dirty_blocks (&filter, SPI_FILTER_CS_0, clean,
+		sizeof (clean), 0x10000);
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
+		FLASH_EXP_READ_CMD (0x03, 0x10000, 0, -1, strlen (data)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_verify_images_multiple_fw_with_cache (&flash, &list, 1, &hash.base,
+		&rsa.base, &cache, SPI_FILTER_CS_0);
+	CuAssertIntEquals (test, 0, status);
+
+	/* The signature is still checked against the cached digest. */
+	memcpy (&sig.signature, RSA_SIGNATURE_BAD, RSA_ENCRYPT_LEN);
+
+	status = host_fw_util_testing_expect_dirty_blocks (&filter, SPI_FILTER_CS_0, clean,
+		sizeof (clean), 0x10000);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_verify_images_multiple_fw_with_cache (&flash, &list, 1, &hash.base,
+		&rsa.base, &cache, SPI_FILTER_CS_0);
+	CuAssertIntEquals (test, RSA_ENGINE_BAD_SIGNATURE, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_validate_and_release (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_verify_cache_release (&cache);
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void host_fw_verify_images_multiple_fw_with_cache_test_hashes (CuTest *test)
+{
+	struct flash_region region;
+	struct pfm_image_hash img_hash;
+	struct pfm_image_list list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct spi_filter_interface_mock filter;
+	struct host_flash_verify_cache_entry entries[2];
+	struct host_flash_verify_cache cache;
+	uint8_t bitmap[4];
+	uint8_t clean[4] = {0};
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	int status;
+	char *data = "Test";
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_init (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_filter_interface_mock_enable_dirty_block_tracking (&filter);
+
+	status = host_flash_verify_cache_init (&cache, &filter.base, entries, 2, bitmap,
+		sizeof (bitmap));
+	CuAssertIntEquals (test, 0, status);
+
+	region.start_addr = 0x10000;
+	region.length = strlen (data);
+
+	img_hash.regions = &region;
+	img_hash.count = 1;
+	memcpy (img_hash.hash, SHA256_TEST_HASH, SHA256_HASH_LENGTH);
+	img_hash.hash_length = SHA256_HASH_LENGTH;
+	img_hash.hash_type = HASH_TYPE_SHA256;
+	img_hash.always_validate = 1;
+
+	list.images_hash = &img_hash;
+	list.images_sig = NULL;
+	list.count = 1;
+
+	status = host_fw_util_testing_expect_dirty_blocks (&filter, SPI_FILTER_CS_0, clean,
+		sizeof (clean), 0x10000);
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
+		FLASH_EXP_READ_CMD (0x03, 0x10000, 0, -1, strlen (data)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_verify_images_multiple_fw_with_cache (&flash, &list, 1, &hash.base,
+		&rsa.base, &cache, SPI_FILTER_CS_0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_util_testing_expect_dirty_blocks (&filter, SPI_FILTER_CS_0, clean,
+		sizeof (clean), 0x10000);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_verify_images_multiple_fw_with_cache (&flash, &list, 1, &hash.base,
+		&rsa.base, &cache, SPI_FILTER_CS_0);
+	CuAssertIntEquals (test, 0, status);
+
+	/* The expected hash is still compared against the cached digest. */
+	memcpy (img_hash.hash, SHA256_TEST2_HASH, SHA256_HASH_LENGTH);
+
+	status = host_fw_util_testing_expect_dirty_blocks (&filter, SPI_FILTER_CS_0, clean,
+		sizeof (clean), 0x10000);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_verify_images_multiple_fw_with_cache (&flash, &list, 1, &hash.base,
+		&rsa.base, &cache, SPI_FILTER_CS_0);
+	CuAssertIntEquals (test, HOST_FW_UTIL_BAD_IMAGE_HASH, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_validate_and_release (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_verify_cache_release (&cache);
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void host_fw_verify_images_multiple_fw_with_cache_test_no_write_tracking (CuTest *test)
+{
+	struct flash_region region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct spi_filter_interface_mock filter;
+	struct host_flash_verify_cache_entry entries[2];
+	struct host_flash_verify_cache cache;
+	uint8_t bitmap[4];
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	struct logging_mock logger;
+	struct debug_log_entry_info entry = {
+		.format = DEBUG_LOG_ENTRY_FORMAT,
+		.severity = DEBUG_LOG_SEVERITY_WARNING,
+		.component = DEBUG_LOG_COMPONENT_HOST_FW,
+		.msg_index = HOST_LOGGING_VERIFY_CACHE_UNAVAILABLE,
+		.arg1 = SPI_FILTER_UNSUPPORTED_OPERATION,
+		.arg2 = SPI_FILTER_CS_0
+	};
+	int status;
+	char *data = "Test";
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_init (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_mock_init (&logger);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_flash_verify_cache_init (&cache, &filter.base, entries, 2, bitmap,
+		sizeof (bitmap));
+	CuAssertIntEquals (test, 0, status);
+
+	region.start_addr = 0x10000;
+	region.length = strlen (data);
+
+	sig.regions = &region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
+
+	list.images_sig = &sig;
+	list.images_hash = NULL;
+	list.count = 1;
+
+	/* Without write tracking, the image is read every time. */
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
+		FLASH_EXP_READ_CMD (0x03, 0x10000, 0, -1, strlen (data)));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
+		FLASH_EXP_READ_CMD (0x03, 0x10000, 0, -1, strlen (data)));
+
+	/* Each verification reports that the cache could not be used. */
+	status |= mock_expect (&logger.mock, logger.base.create_entry, &logger, 0,
+		MOCK_ARG_PTR_CONTAINS ((uint8_t*) &entry, LOG_ENTRY_SIZE_TIME_FIELD_NOT_INCLUDED),
+		MOCK_ARG (sizeof (entry)));
+	status |= mock_expect (&logger.mock, logger.base.create_entry, &logger, 0,
+		MOCK_ARG_PTR_CONTAINS ((uint8_t*) &entry, LOG_ENTRY_SIZE_TIME_FIELD_NOT_INCLUDED),
+		MOCK_ARG (sizeof (entry)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	debug_log = &logger.base;
+
+	status = host_fw_verify_images_multiple_fw_with_cache (&flash, &list, 1, &hash.base,
+		&rsa.base, &cache, SPI_FILTER_CS_0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_verify_images_multiple_fw_with_cache (&flash, &list, 1, &hash.base,
+		&rsa.base, &cache, SPI_FILTER_CS_0);
+	CuAssertIntEquals (test, 0, status);
+
+	debug_log = NULL;
+
+	status = logging_mock_validate_and_release (&logger);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_validate_and_release (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_verify_cache_release (&cache);
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void host_fw_verify_images_multiple_fw_with_cache_test_null (CuTest *test)
+{
+	struct flash_region region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct spi_filter_interface_mock filter;
+	struct host_flash_verify_cache_entry entries[2];
+	struct host_flash_verify_cache cache;
+	uint8_t bitmap[4];
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	int status;
+	char *data = "Test";
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_init (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_filter_interface_mock_enable_dirty_block_tracking (&filter);
+
+	status = host_flash_verify_cache_init (&cache, &filter.base, entries, 2, bitmap,
+		sizeof (bitmap));
+	CuAssertIntEquals (test, 0, status);
+
+	region.start_addr = 0x10000;
+	region.length = strlen (data);
+
+	sig.regions = &region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
+
+	list.images_sig = &sig;
+	list.images_hash = NULL;
+	list.count = 1;
+
+	status = host_fw_verify_images_multiple_fw_with_cache (NULL, &list, 1, &hash.base, &rsa.base,
+		&cache, SPI_FILTER_CS_0);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+
+	status = host_fw_verify_images_multiple_fw_with_cache (&flash, NULL, 1, &hash.base, &rsa.base,
+		&cache, SPI_FILTER_CS_0);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+
+	status = host_fw_verify_images_multiple_fw_with_cache (&flash, &list, 1, NULL, &rsa.base,
+		&cache, SPI_FILTER_CS_0);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+
+	status = host_fw_verify_images_multiple_fw_with_cache (&flash, &list, 1, &hash.base, NULL,
+		&cache, SPI_FILTER_CS_0);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+
+	status = host_fw_verify_images_multiple_fw_with_cache (&flash, &list, 1, &hash.base,
+		&rsa.base, NULL, SPI_FILTER_CS_0);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_validate_and_release (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_verify_cache_release (&cache);
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
 static void host_fw_full_flash_verification_multiple_fw_test (CuTest *test)
 {
 	struct flash_region img_region;
@@ -13406,17 +13947,439 @@ static void host_fw_full_flash_verification_multiple_fw_test (CuTest *test)
 	status = spi_flash_init (&flash, &state, &flash_mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
-		FLASH_EXP_READ_CMD (0x03, 0, 0, -1, strlen (data)));
-
-	status |= flash_master_mock_expect_blank_check (&flash_mock, 0 + strlen (data),
-		0x200 - strlen (data));
-	status |= flash_master_mock_expect_blank_check (&flash_mock, 0x300, 0x1000 - 0x300);
-
-	CuAssertIntEquals (test, 0, status);
-
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
+		FLASH_EXP_READ_CMD (0x03, 0, 0, -1, strlen (data)));
+
+	status |= flash_master_mock_expect_blank_check (&flash_mock, 0 + strlen (data),
+		0x200 - strlen (data));
+	status |= flash_master_mock_expect_blank_check (&flash_mock, 0x300, 0x1000 - 0x300);
+
+	CuAssertIntEquals (test, 0, status);
+
+	img_region.start_addr = 0;
+	img_region.length = strlen (data);
+
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
+
+	img_list.images_sig = &sig;
+	img_list.images_hash = NULL;
+	img_list.count = 1;
+
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
+
+	rw_prop.on_failure = PFM_RW_DO_NOTHING;
+
+	rw_list.regions = &rw_region;
+	rw_list.properties = &rw_prop;
+	rw_list.count = 1;
+
+	status = spi_flash_set_device_size (&flash, 0x1000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_full_flash_verification_multiple_fw (&flash, &img_list, &rw_list, 1, 0xff,
+		&hash.base, &rsa.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void host_fw_full_flash_verification_multiple_fw_test_multiple (CuTest *test)
+{
+	struct flash_region img_region[3];
+	struct pfm_image_signature sig[3];
+	struct pfm_image_list img_list[3];
+	struct flash_region rw_region[4];
+	struct pfm_read_write rw_prop[4];
+	struct pfm_read_write_regions rw_list[3];
+	struct flash_master_mock flash_mock;
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	int status;
+	char *data1 = "Test";
+	char *data2 = "Test2";
+	char *data3 = "Nope";
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data1, strlen (data1),
+		FLASH_EXP_READ_CMD (0x03, 0x100, 0, -1, strlen (data1)));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data2, strlen (data2),
+		FLASH_EXP_READ_CMD (0x03, 0xa00, 0, -1, strlen (data2)));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data3, strlen (data3),
+		FLASH_EXP_READ_CMD (0x03, 0x900, 0, -1, strlen (data3)));
+
+	status |= flash_master_mock_expect_blank_check (&flash_mock, 0x100 + strlen (data1),
+		0x300 - strlen (data1));
+	status |= flash_master_mock_expect_blank_check (&flash_mock, 0x500, 0x100);
+	status |= flash_master_mock_expect_blank_check (&flash_mock, 0x700, 0x200);
+	status |= flash_master_mock_expect_blank_check (&flash_mock, 0x900 + strlen (data3),
+		0x100 - strlen (data3));
+	status |= flash_master_mock_expect_blank_check (&flash_mock, 0xa00 + strlen (data2),
+		0x500 - strlen (data2));
+
+	CuAssertIntEquals (test, 0, status);
+
+	img_region[0].start_addr = 0x100;
+	img_region[0].length = strlen (data1);
+	img_region[1].start_addr = 0xa00;
+	img_region[1].length = strlen (data2);
+	img_region[2].start_addr = 0x900;
+	img_region[2].length = strlen (data3);
+
+	sig[0].regions = &img_region[0];
+	sig[0].count = 1;
+	memcpy (&sig[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig[0].sig_length = RSA_ENCRYPT_LEN;
+	sig[0].always_validate = 1;
+
+	sig[1].regions = &img_region[1];
+	sig[1].count = 1;
+	memcpy (&sig[1].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[1].signature, RSA_SIGNATURE_TEST2, RSA_ENCRYPT_LEN);
+	sig[1].sig_length = RSA_ENCRYPT_LEN;
+	sig[1].always_validate = 1;
+
+	sig[2].regions = &img_region[2];
+	sig[2].count = 1;
+	memcpy (&sig[2].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig[2].signature, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN);
+	sig[2].sig_length = RSA_ENCRYPT_LEN;
+	sig[2].always_validate = 1;
+
+	img_list[0].images_sig = &sig[0];
+	img_list[0].images_hash = NULL;
+	img_list[0].count = 1;
+
+	img_list[1].images_sig = &sig[1];
+	img_list[1].images_hash = NULL;
+	img_list[1].count = 1;
+
+	img_list[2].images_sig = &sig[2];
+	img_list[2].images_hash = NULL;
+	img_list[2].count = 1;
+
+	rw_region[0].start_addr = 0;
+	rw_region[0].length = 0x100;
+	rw_region[1].start_addr = 0x600;
+	rw_region[1].length = 0x100;
+	rw_region[2].start_addr = 0x400;
+	rw_region[2].length = 0x100;
+	rw_region[3].start_addr = 0xf00;
+	rw_region[3].length = 0x100;
+
+	rw_prop[0].on_failure = PFM_RW_DO_NOTHING;
+	rw_prop[1].on_failure = PFM_RW_DO_NOTHING;
+	rw_prop[2].on_failure = PFM_RW_DO_NOTHING;
+	rw_prop[3].on_failure = PFM_RW_DO_NOTHING;
+
+	rw_list[0].regions = &rw_region[0];
+	rw_list[0].properties = &rw_prop[0];
+	rw_list[0].count = 1;
+
+	rw_list[1].regions = &rw_region[1];
+	rw_list[1].properties = &rw_prop[1];
+	rw_list[1].count = 1;
+
+	rw_list[2].regions = &rw_region[2];
+	rw_list[2].properties = &rw_prop[2];
+	rw_list[2].count = 2;
+
+	status = spi_flash_set_device_size (&flash, 0x1000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_full_flash_verification_multiple_fw (&flash, img_list, rw_list, 3, 0xff,
+		&hash.base, &rsa.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void host_fw_full_flash_verification_multiple_fw_test_hashes (CuTest *test)
+{
+	struct flash_region img_region;
+	struct pfm_image_hash img_hash;
+	struct pfm_image_list img_list;
+	struct flash_region rw_region;
+	struct pfm_read_write rw_prop;
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	int status;
+	char *data = "Test";
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
+		FLASH_EXP_READ_CMD (0x03, 0, 0, -1, strlen (data)));
+
+	status |= flash_master_mock_expect_blank_check (&flash_mock, 0 + strlen (data),
+		0x200 - strlen (data));
+	status |= flash_master_mock_expect_blank_check (&flash_mock, 0x300, 0x1000 - 0x300);
+
+	CuAssertIntEquals (test, 0, status);
+
+	img_region.start_addr = 0;
+	img_region.length = strlen (data);
+
+	img_hash.regions = &img_region;
+	img_hash.count = 1;
+	memcpy (img_hash.hash, SHA256_TEST_HASH, SHA256_HASH_LENGTH);
+	img_hash.hash_length = SHA256_HASH_LENGTH;
+	img_hash.hash_type = HASH_TYPE_SHA256;
+	img_hash.always_validate = 1;
+
+	img_list.images_hash = &img_hash;
+	img_list.images_sig = NULL;
+	img_list.count = 1;
+
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
+
+	rw_prop.on_failure = PFM_RW_DO_NOTHING;
+
+	rw_list.regions = &rw_region;
+	rw_list.properties = &rw_prop;
+	rw_list.count = 1;
+
+	status = spi_flash_set_device_size (&flash, 0x1000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_full_flash_verification_multiple_fw (&flash, &img_list, &rw_list, 1, 0xff,
+		&hash.base, &rsa.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void host_fw_full_flash_verification_multiple_fw_test_hashes_multiple (CuTest *test)
+{
+	struct flash_region img_region[3];
+	struct pfm_image_hash img_hash[3];
+	struct pfm_image_list img_list[3];
+	struct flash_region rw_region[3];
+	struct pfm_read_write rw_prop[3];
+	struct pfm_read_write_regions rw_list[3];
+	struct flash_master_mock flash_mock;
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	int status;
+	char *data1 = "Test";
+	char *data2 = "Test2";
+	char *data3 = "Nope";
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data1, strlen (data1),
+		FLASH_EXP_READ_CMD (0x03, 0x100, 0, -1, strlen (data1)));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data2, strlen (data2),
+		FLASH_EXP_READ_CMD (0x03, 0xa00, 0, -1, strlen (data2)));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data3, strlen (data3),
+		FLASH_EXP_READ_CMD (0x03, 0x900, 0, -1, strlen (data3)));
+
+	status |= flash_master_mock_expect_blank_check (&flash_mock, 0x100 + strlen (data1),
+		0x300 - strlen (data1));
+	status |= flash_master_mock_expect_blank_check (&flash_mock, 0x500, 0x100);
+	status |= flash_master_mock_expect_blank_check (&flash_mock, 0x700, 0x200);
+	status |= flash_master_mock_expect_blank_check (&flash_mock, 0x900 + strlen (data3),
+		0x100 - strlen (data3));
+	status |= flash_master_mock_expect_blank_check (&flash_mock, 0xa00 + strlen (data2),
+		0x600 - strlen (data2));
+
+	CuAssertIntEquals (test, 0, status);
+
+	img_region[0].start_addr = 0x100;
+	img_region[0].length = strlen (data1);
+	img_region[1].start_addr = 0xa00;
+	img_region[1].length = strlen (data2);
+	img_region[2].start_addr = 0x900;
+	img_region[2].length = strlen (data3);
+
+	img_hash[0].regions = &img_region[0];
+	img_hash[0].count = 1;
+	memcpy (img_hash[0].hash, SHA256_TEST_HASH, SHA256_HASH_LENGTH);
+	img_hash[0].hash_length = SHA256_HASH_LENGTH;
+	img_hash[0].hash_type = HASH_TYPE_SHA256;
+	img_hash[0].always_validate = 1;
+
+	img_hash[1].regions = &img_region[1];
+	img_hash[1].count = 1;
+	memcpy (img_hash[1].hash, SHA384_TEST2_HASH, SHA384_HASH_LENGTH);
+	img_hash[1].hash_length = SHA384_HASH_LENGTH;
+	img_hash[1].hash_type = HASH_TYPE_SHA384;
+	img_hash[1].always_validate = 1;
+
+	img_hash[2].regions = &img_region[2];
+	img_hash[2].count = 1;
+	memcpy (img_hash[2].hash, SHA512_NOPE_HASH, SHA512_HASH_LENGTH);
+	img_hash[2].hash_length = SHA512_HASH_LENGTH;
+	img_hash[2].hash_type = HASH_TYPE_SHA512;
+	img_hash[2].always_validate = 1;
+
+	img_list[0].images_hash = &img_hash[0];
+	img_list[0].images_sig = NULL;
+	img_list[0].count = 1;
+
+	img_list[1].images_hash = &img_hash[1];
+	img_list[1].images_sig = NULL;
+	img_list[1].count = 1;
+
+	img_list[2].images_hash = &img_hash[2];
+	img_list[2].images_sig = NULL;
+	img_list[2].count = 1;
+
+	rw_region[0].start_addr = 0;
+	rw_region[0].length = 0x100;
+	rw_region[1].start_addr = 0x600;
+	rw_region[1].length = 0x100;
+	rw_region[2].start_addr = 0x400;
+	rw_region[2].length = 0x100;
+
+	rw_prop[0].on_failure = PFM_RW_DO_NOTHING;
+	rw_prop[1].on_failure = PFM_RW_DO_NOTHING;
+	rw_prop[2].on_failure = PFM_RW_DO_NOTHING;
+
+	rw_list[0].regions = &rw_region[0];
+	rw_list[0].properties = &rw_prop[0];
+	rw_list[0].count = 1;
+
+	rw_list[1].regions = &rw_region[1];
+	rw_list[1].properties = &rw_prop[1];
+	rw_list[1].count = 1;
+
+	rw_list[2].regions = &rw_region[2];
+	rw_list[2].properties = &rw_prop[2];
+	rw_list[2].count = 1;
+
+	status = spi_flash_set_device_size (&flash, 0x1000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_full_flash_verification_multiple_fw (&flash, img_list, rw_list, 3, 0xff,
+		&hash.base, &rsa.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
+
+static void host_fw_full_flash_verification_multiple_fw_test_null (CuTest *test)
+{
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	struct flash_region rw_region;
+	struct pfm_read_write rw_prop;
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	int status;
+	char *data = "Test";
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
 	img_region.start_addr = 0;
 	img_region.length = strlen (data);
 
@@ -13443,9 +14406,25 @@ static void host_fw_full_flash_verification_multiple_fw_test (CuTest *test)
 	status = spi_flash_set_device_size (&flash, 0x1000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = host_fw_full_flash_verification_multiple_fw (&flash, &img_list, &rw_list, 1, 0xff,
+	status = host_fw_full_flash_verification_multiple_fw (NULL, &img_list, &rw_list, 1, 0xff,
 		&hash.base, &rsa.base);
-	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+
+	status = host_fw_full_flash_verification_multiple_fw (&flash, NULL, &rw_list, 1, 0xff,
+		&hash.base, &rsa.base);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+
+	status = host_fw_full_flash_verification_multiple_fw (&flash, &img_list, NULL, 1, 0xff,
+		&hash.base, &rsa.base);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+
+	status = host_fw_full_flash_verification_multiple_fw (&flash, &img_list, &rw_list, 1, 0xff,
+		NULL, &rsa.base);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+
+	status = host_fw_full_flash_verification_multiple_fw (&flash, &img_list, &rw_list, 1, 0xff,
+		&hash.base, NULL);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
 
 	status = flash_master_mock_validate_and_release (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
@@ -13455,23 +14434,27 @@ static void host_fw_full_flash_verification_multiple_fw_test (CuTest *test)
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_full_flash_verification_multiple_fw_test_multiple (CuTest *test)
+static void host_fw_full_flash_verification_multiple_fw_with_cache_test (CuTest *test)
 {
-	struct flash_region img_region[3];
-	struct pfm_image_signature sig[3];
-	struct pfm_image_list img_list[3];
-	struct flash_region rw_region[4];
-	struct pfm_read_write rw_prop[4];
-	struct pfm_read_write_regions rw_list[3];
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	struct flash_region rw_region;
+	struct pfm_read_write rw_prop;
+	struct pfm_read_write_regions rw_list;
 	struct flash_master_mock flash_mock;
 	struct spi_flash_state state;
 	struct spi_flash flash;
+	struct spi_filter_interface_mock filter;
+	struct host_flash_verify_cache_entry entries[2];
+	struct host_flash_verify_cache cache;
+	uint8_t bitmap[2];
+	uint8_t clean[2] = {0};
+	uint8_t dirty[2] = {0x11, 0x00};
 	HASH_TESTING_ENGINE hash;
 	RSA_TESTING_ENGINE rsa;
 	int status;
-	char *data1 = "Test";
-	char *data2 = "Test2";
-	char *data3 = "Nope";
+	char *data = "Test";
 
 	TEST_START;
 
@@ -13487,117 +14470,222 @@ static void host_fw_full_flash_verification_multiple_fw_test_multiple (CuTest *t
 	status = spi_flash_init (&flash, &state, &flash_mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data1, strlen (data1),
-		FLASH_EXP_READ_CMD (0x03, 0x100, 0, -1, strlen (data1)));
+	status = spi_filter_interface_mock_init (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_filter_interface_mock_enable_dirty_block_tracking (&filter);
+
+	status = host_flash_verify_cache_init (&cache, &filter.base, entries, 2, bitmap,
+		sizeof (bitmap));
+	CuAssertIntEquals (test, 0, status);
+
+	img_region.start_addr = 0;
+	img_region.length = strlen (data);
+
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
+
+	img_list.images_sig = &sig;
+	img_list.images_hash = NULL;
+	img_list.count = 1;
+
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
+
+	rw_prop.on_failure = PFM_RW_DO_NOTHING;
+
+	rw_list.regions = &rw_region;
+	rw_list.properties = &rw_prop;
+	rw_list.count = 1;
+
+	status = spi_flash_set_device_size (&flash, 0x1000);
+	CuAssertIntEquals (test, 0, status);
+
+	/* First verification needs to check the entire flash. */
+	status = host_fw_util_testing_expect_dirty_blocks (&filter, SPI_FILTER_CS_0, clean,
+		sizeof (clean), 0x100);
 
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data2, strlen (data2),
-		FLASH_EXP_READ_CMD (0x03, 0xa00, 0, -1, strlen (data2)));
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
+		FLASH_EXP_READ_CMD (0x03, 0, 0, -1, strlen (data)));
+
+	status |= flash_master_mock_expect_blank_check (&flash_mock, 0 + strlen (data),
+		0x200 - strlen (data));
+	status |= flash_master_mock_expect_blank_check (&flash_mock, 0x300, 0x1000 - 0x300);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_full_flash_verification_multiple_fw_with_cache (&flash, &img_list, &rw_list,
+		1, 0xff, &hash.base, &rsa.base, &cache, SPI_FILTER_CS_0);
+	CuAssertIntEquals (test, 0, status);
+
+	/* No host writes, so nothing needs to be read from flash. */
+	status = host_fw_util_testing_expect_dirty_blocks (&filter, SPI_FILTER_CS_0, clean,
+		sizeof (clean), 0x100);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_full_flash_verification_multiple_fw_with_cache (&flash, &img_list, &rw_list,
+		1, 0xff, &hash.base, &rsa.base, &cache, SPI_FILTER_CS_0);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Only the blocks written by the host need to be read. */
+	status = host_fw_util_testing_expect_dirty_blocks (&filter, SPI_FILTER_CS_0, dirty,
+		sizeof (dirty), 0x100);
 
 	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
 		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data3, strlen (data3),
-		FLASH_EXP_READ_CMD (0x03, 0x900, 0, -1, strlen (data3)));
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
+		FLASH_EXP_READ_CMD (0x03, 0, 0, -1, strlen (data)));
 
-	status |= flash_master_mock_expect_blank_check (&flash_mock, 0x100 + strlen (data1),
-		0x300 - strlen (data1));
-	status |= flash_master_mock_expect_blank_check (&flash_mock, 0x500, 0x100);
-	status |= flash_master_mock_expect_blank_check (&flash_mock, 0x700, 0x200);
-	status |= flash_master_mock_expect_blank_check (&flash_mock, 0x900 + strlen (data3),
-		0x100 - strlen (data3));
-	status |= flash_master_mock_expect_blank_check (&flash_mock, 0xa00 + strlen (data2),
-		0x500 - strlen (data2));
+	status |= flash_master_mock_expect_blank_check (&flash_mock, 0 + strlen (data),
+		0x100 - strlen (data));
+	status |= flash_master_mock_expect_blank_check (&flash_mock, 0x400, 0x100);
 
 	CuAssertIntEquals (test, 0, status);
 
-	img_region[0].start_addr = 0x100;
-	img_region[0].length = strlen (data1);
-	img_region[1].start_addr = 0xa00;
-	img_region[1].length = strlen (data2);
-	img_region[2].start_addr = 0x900;
-	img_region[2].length = strlen (data3);
+	status = host_fw_full_flash_verification_multiple_fw_with_cache (&flash, &img_list, &rw_list,
+		1, 0xff, &hash.base, &rsa.base, &cache, SPI_FILTER_CS_0);
+	CuAssertIntEquals (test, 0, status);
 
-	sig[0].regions = &img_region[0];
-	sig[0].count = 1;
-	memcpy (&sig[0].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig[0].signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
-	sig[0].sig_length = RSA_ENCRYPT_LEN;
-	sig[0].always_validate = 1;
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
 
-	sig[1].regions = &img_region[1];
-	sig[1].count = 1;
-	memcpy (&sig[1].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig[1].signature, RSA_SIGNATURE_TEST2, RSA_ENCRYPT_LEN);
-	sig[1].sig_length = RSA_ENCRYPT_LEN;
-	sig[1].always_validate = 1;
+	status = spi_filter_interface_mock_validate_and_release (&filter);
+	CuAssertIntEquals (test, 0, status);
 
-	sig[2].regions = &img_region[2];
-	sig[2].count = 1;
-	memcpy (&sig[2].key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
-	memcpy (&sig[2].signature, RSA_SIGNATURE_NOPE, RSA_ENCRYPT_LEN);
-	sig[2].sig_length = RSA_ENCRYPT_LEN;
-	sig[2].always_validate = 1;
+	host_flash_verify_cache_release (&cache);
+	spi_flash_release (&flash);
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+	RSA_TESTING_ENGINE_RELEASE (&rsa);
+}
 
-	img_list[0].images_sig = &sig[0];
-	img_list[0].images_hash = NULL;
-	img_list[0].count = 1;
+static void host_fw_full_flash_verification_multiple_fw_with_cache_test_layout_changed (
+	CuTest *test)
+{
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	struct flash_region rw_region;
+	struct pfm_read_write rw_prop;
+	struct pfm_read_write_regions rw_list;
+	struct flash_master_mock flash_mock;
+	struct spi_flash_state state;
+	struct spi_flash flash;
+	struct spi_filter_interface_mock filter;
+	struct host_flash_verify_cache_entry entries[2];
+	struct host_flash_verify_cache cache;
+	uint8_t bitmap[2];
+	uint8_t clean[2] = {0};
+	HASH_TESTING_ENGINE hash;
+	RSA_TESTING_ENGINE rsa;
+	int status;
+	char *data = "Test";
 
-	img_list[1].images_sig = &sig[1];
-	img_list[1].images_hash = NULL;
-	img_list[1].count = 1;
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &state, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_interface_mock_init (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_filter_interface_mock_enable_dirty_block_tracking (&filter);
+
+	status = host_flash_verify_cache_init (&cache, &filter.base, entries, 2, bitmap,
+		sizeof (bitmap));
+	CuAssertIntEquals (test, 0, status);
+
+	img_region.start_addr = 0;
+	img_region.length = strlen (data);
+
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
+
+	img_list.images_sig = &sig;
+	img_list.images_hash = NULL;
+	img_list.count = 1;
+
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
+
+	rw_prop.on_failure = PFM_RW_DO_NOTHING;
+
+	rw_list.regions = &rw_region;
+	rw_list.properties = &rw_prop;
+	rw_list.count = 1;
+
+	status = spi_flash_set_device_size (&flash, 0x1000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_util_testing_expect_dirty_blocks (&filter, SPI_FILTER_CS_0, clean,
+		sizeof (clean), 0x100);
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
+		FLASH_EXP_READ_CMD (0x03, 0, 0, -1, strlen (data)));
 
-	img_list[2].images_sig = &sig[2];
-	img_list[2].images_hash = NULL;
-	img_list[2].count = 1;
+	status |= flash_master_mock_expect_blank_check (&flash_mock, 0 + strlen (data),
+		0x200 - strlen (data));
+	status |= flash_master_mock_expect_blank_check (&flash_mock, 0x300, 0x1000 - 0x300);
 
-	rw_region[0].start_addr = 0;
-	rw_region[0].length = 0x100;
-	rw_region[1].start_addr = 0x600;
-	rw_region[1].length = 0x100;
-	rw_region[2].start_addr = 0x400;
-	rw_region[2].length = 0x100;
-	rw_region[3].start_addr = 0xf00;
-	rw_region[3].length = 0x100;
+	CuAssertIntEquals (test, 0, status);
 
-	rw_prop[0].on_failure = PFM_RW_DO_NOTHING;
-	rw_prop[1].on_failure = PFM_RW_DO_NOTHING;
-	rw_prop[2].on_failure = PFM_RW_DO_NOTHING;
-	rw_prop[3].on_failure = PFM_RW_DO_NOTHING;
+	status = host_fw_full_flash_verification_multiple_fw_with_cache (&flash, &img_list, &rw_list,
+		1, 0xff, &hash.base, &rsa.base, &cache, SPI_FILTER_CS_0);
+	CuAssertIntEquals (test, 0, status);
 
-	rw_list[0].regions = &rw_region[0];
-	rw_list[0].properties = &rw_prop[0];
-	rw_list[0].count = 1;
+	/* A different flash layout requires all unused regions to be checked. */
+	rw_region.length = 0x200;
 
-	rw_list[1].regions = &rw_region[1];
-	rw_list[1].properties = &rw_prop[1];
-	rw_list[1].count = 1;
+	status = host_fw_util_testing_expect_dirty_blocks (&filter, SPI_FILTER_CS_0, clean,
+		sizeof (clean), 0x100);
 
-	rw_list[2].regions = &rw_region[2];
-	rw_list[2].properties = &rw_prop[2];
-	rw_list[2].count = 2;
+	status |= flash_master_mock_expect_blank_check (&flash_mock, 0 + strlen (data),
+		0x200 - strlen (data));
+	status |= flash_master_mock_expect_blank_check (&flash_mock, 0x400, 0x1000 - 0x400);
 
-	status = spi_flash_set_device_size (&flash, 0x1000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = host_fw_full_flash_verification_multiple_fw (&flash, img_list, rw_list, 3, 0xff,
-		&hash.base, &rsa.base);
+	status = host_fw_full_flash_verification_multiple_fw_with_cache (&flash, &img_list, &rw_list,
+		1, 0xff, &hash.base, &rsa.base, &cache, SPI_FILTER_CS_0);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_master_mock_validate_and_release (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
+	status = spi_filter_interface_mock_validate_and_release (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_verify_cache_release (&cache);
 	spi_flash_release (&flash);
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_full_flash_verification_multiple_fw_test_hashes (CuTest *test)
+static void host_fw_full_flash_verification_multiple_fw_with_cache_test_not_blank (CuTest *test)
 {
 	struct flash_region img_region;
-	struct pfm_image_hash img_hash;
+	struct pfm_image_signature sig;
 	struct pfm_image_list img_list;
 	struct flash_region rw_region;
 	struct pfm_read_write rw_prop;
@@ -13605,6 +14693,11 @@ static void host_fw_full_flash_verification_multiple_fw_test_hashes (CuTest *tes
 	struct flash_master_mock flash_mock;
 	struct spi_flash_state state;
 	struct spi_flash flash;
+	struct spi_filter_interface_mock filter;
+	struct host_flash_verify_cache_entry entries[2];
+	struct host_flash_verify_cache cache;
+	uint8_t bitmap[2];
+	uint8_t clean[2] = {0};
 	HASH_TESTING_ENGINE hash;
 	RSA_TESTING_ENGINE rsa;
 	int status;
@@ -13624,29 +14717,27 @@ static void host_fw_full_flash_verification_multiple_fw_test_hashes (CuTest *tes
 	status = spi_flash_init (&flash, &state, &flash_mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
-		FLASH_EXP_READ_CMD (0x03, 0, 0, -1, strlen (data)));
+	status = spi_filter_interface_mock_init (&filter);
+	CuAssertIntEquals (test, 0, status);
 
-	status |= flash_master_mock_expect_blank_check (&flash_mock, 0 + strlen (data),
-		0x200 - strlen (data));
-	status |= flash_master_mock_expect_blank_check (&flash_mock, 0x300, 0x1000 - 0x300);
+	spi_filter_interface_mock_enable_dirty_block_tracking (&filter);
 
+	status = host_flash_verify_cache_init (&cache, &filter.base, entries, 2, bitmap,
+		sizeof (bitmap));
 	CuAssertIntEquals (test, 0, status);
 
 	img_region.start_addr = 0;
 	img_region.length = strlen (data);
 
-	img_hash.regions = &img_region;
-	img_hash.count = 1;
-	memcpy (img_hash.hash, SHA256_TEST_HASH, SHA256_HASH_LENGTH);
-	img_hash.hash_length = SHA256_HASH_LENGTH;
-	img_hash.hash_type = HASH_TYPE_SHA256;
-	img_hash.always_validate = 1;
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
 
-	img_list.images_hash = &img_hash;
-	img_list.images_sig = NULL;
+	img_list.images_sig = &sig;
+	img_list.images_hash = NULL;
 	img_list.count = 1;
 
 	rw_region.start_addr = 0x200;
@@ -13661,35 +14752,80 @@ static void host_fw_full_flash_verification_multiple_fw_test_hashes (CuTest *tes
 	status = spi_flash_set_device_size (&flash, 0x1000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = host_fw_full_flash_verification_multiple_fw (&flash, &img_list, &rw_list, 1, 0xff,
-		&hash.base, &rsa.base);
+	status = host_fw_util_testing_expect_dirty_blocks (&filter, SPI_FILTER_CS_0, clean,
+		sizeof (clean), 0x100);
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
+		FLASH_EXP_READ_CMD (0x03, 0, 0, -1, strlen (data)));
+
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, RSA_SIGNATURE_BAD, RSA_ENCRYPT_LEN,
+		FLASH_EXP_READ_CMD (0x03, 0 + strlen (data), 0, -1, FLASH_VERIFICATION_BLOCK));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_full_flash_verification_multiple_fw_with_cache (&flash, &img_list, &rw_list,
+		1, 0xff, &hash.base, &rsa.base, &cache, SPI_FILTER_CS_0);
+	CuAssertIntEquals (test, FLASH_UTIL_UNEXPECTED_VALUE, status);
+
+	/* Unused regions were not confirmed to be blank, so they all need to be checked again. */
+	status = host_fw_util_testing_expect_dirty_blocks (&filter, SPI_FILTER_CS_0, clean,
+		sizeof (clean), 0x100);
+
+	status |= flash_master_mock_expect_blank_check (&flash_mock, 0 + strlen (data),
+		0x200 - strlen (data));
+	status |= flash_master_mock_expect_blank_check (&flash_mock, 0x300, 0x1000 - 0x300);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_fw_full_flash_verification_multiple_fw_with_cache (&flash, &img_list, &rw_list,
+		1, 0xff, &hash.base, &rsa.base, &cache, SPI_FILTER_CS_0);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_master_mock_validate_and_release (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
+	status = spi_filter_interface_mock_validate_and_release (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_verify_cache_release (&cache);
 	spi_flash_release (&flash);
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_full_flash_verification_multiple_fw_test_hashes_multiple (CuTest *test)
+static void host_fw_full_flash_verification_multiple_fw_with_cache_test_no_write_tracking (
+	CuTest *test)
 {
-	struct flash_region img_region[3];
-	struct pfm_image_hash img_hash[3];
-	struct pfm_image_list img_list[3];
-	struct flash_region rw_region[3];
-	struct pfm_read_write rw_prop[3];
-	struct pfm_read_write_regions rw_list[3];
+	struct flash_region img_region;
+	struct pfm_image_signature sig;
+	struct pfm_image_list img_list;
+	struct flash_region rw_region;
+	struct pfm_read_write rw_prop;
+	struct pfm_read_write_regions rw_list;
 	struct flash_master_mock flash_mock;
 	struct spi_flash_state state;
 	struct spi_flash flash;
+	struct spi_filter_interface_mock filter;
+	struct host_flash_verify_cache_entry entries[2];
+	struct host_flash_verify_cache cache;
+	uint8_t bitmap[2];
 	HASH_TESTING_ENGINE hash;
 	RSA_TESTING_ENGINE rsa;
+	struct logging_mock logger;
+	struct debug_log_entry_info entry = {
+		.format = DEBUG_LOG_ENTRY_FORMAT,
+		.severity = DEBUG_LOG_SEVERITY_WARNING,
+		.component = DEBUG_LOG_COMPONENT_HOST_FW,
+		.msg_index = HOST_LOGGING_VERIFY_CACHE_UNAVAILABLE,
+		.arg1 = SPI_FILTER_UNSUPPORTED_OPERATION,
+		.arg2 = SPI_FILTER_CS_0
+	};
 	int status;
-	char *data1 = "Test";
-	char *data2 = "Test2";
-	char *data3 = "Nope";
+	char *data = "Test";
 
 	TEST_START;
 
@@ -13705,111 +14841,99 @@ static void host_fw_full_flash_verification_multiple_fw_test_hashes_multiple (Cu
 	status = spi_flash_init (&flash, &state, &flash_mock.base);
 	CuAssertIntEquals (test, 0, status);
 
-	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data1, strlen (data1),
-		FLASH_EXP_READ_CMD (0x03, 0x100, 0, -1, strlen (data1)));
+	status = spi_filter_interface_mock_init (&filter);
+	CuAssertIntEquals (test, 0, status);
 
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data2, strlen (data2),
-		FLASH_EXP_READ_CMD (0x03, 0xa00, 0, -1, strlen (data2)));
+	status = logging_mock_init (&logger);
+	CuAssertIntEquals (test, 0, status);
 
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
-		FLASH_EXP_READ_STATUS_REG);
-	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data3, strlen (data3),
-		FLASH_EXP_READ_CMD (0x03, 0x900, 0, -1, strlen (data3)));
+	status = host_flash_verify_cache_init (&cache, &filter.base, entries, 2, bitmap,
+		sizeof (bitmap));
+	CuAssertIntEquals (test, 0, status);
 
-	status |= flash_master_mock_expect_blank_check (&flash_mock, 0x100 + strlen (data1),
-		0x300 - strlen (data1));
-	status |= flash_master_mock_expect_blank_check (&flash_mock, 0x500, 0x100);
-	status |= flash_master_mock_expect_blank_check (&flash_mock, 0x700, 0x200);
-	status |= flash_master_mock_expect_blank_check (&flash_mock, 0x900 + strlen (data3),
-		0x100 - strlen (data3));
-	status |= flash_master_mock_expect_blank_check (&flash_mock, 0xa00 + strlen (data2),
-		0x600 - strlen (data2));
+	img_region.start_addr = 0;
+	img_region.length = strlen (data);
 
-	CuAssertIntEquals (test, 0, status);
+	sig.regions = &img_region;
+	sig.count = 1;
+	memcpy (&sig.key, &RSA_PUBLIC_KEY, sizeof (RSA_PUBLIC_KEY));
+	memcpy (&sig.signature, RSA_SIGNATURE_TEST, RSA_ENCRYPT_LEN);
+	sig.sig_length = RSA_ENCRYPT_LEN;
+	sig.always_validate = 1;
 
-	img_region[0].start_addr = 0x100;
-	img_region[0].length = strlen (data1);
-	img_region[1].start_addr = 0xa00;
-	img_region[1].length = strlen (data2);
-	img_region[2].start_addr = 0x900;
-	img_region[2].length = strlen (data3);
+	img_list.images_sig = &sig;
+	img_list.images_hash = NULL;
+	img_list.count = 1;
 
-	img_hash[0].regions = &img_region[0];
-	img_hash[0].count = 1;
-	memcpy (img_hash[0].hash, SHA256_TEST_HASH, SHA256_HASH_LENGTH);
-	img_hash[0].hash_length = SHA256_HASH_LENGTH;
-	img_hash[0].hash_type = HASH_TYPE_SHA256;
-	img_hash[0].always_validate = 1;
+	rw_region.start_addr = 0x200;
+	rw_region.length = 0x100;
 
-	img_hash[1].regions = &img_region[1];
-	img_hash[1].count = 1;
-	memcpy (img_hash[1].hash, SHA384_TEST2_HASH, SHA384_HASH_LENGTH);
-	img_hash[1].hash_length = SHA384_HASH_LENGTH;
-	img_hash[1].hash_type = HASH_TYPE_SHA384;
-	img_hash[1].always_validate = 1;
+	rw_prop.on_failure = PFM_RW_DO_NOTHING;
 
-	img_hash[2].regions = &img_region[2];
-	img_hash[2].count = 1;
-	memcpy (img_hash[2].hash, SHA512_NOPE_HASH, SHA512_HASH_LENGTH);
-	img_hash[2].hash_length = SHA512_HASH_LENGTH;
-	img_hash[2].hash_type = HASH_TYPE_SHA512;
-	img_hash[2].always_validate = 1;
+	rw_list.regions = &rw_region;
+	rw_list.properties = &rw_prop;
+	rw_list.count = 1;
 
-	img_list[0].images_hash = &img_hash[0];
-	img_list[0].images_sig = NULL;
-	img_list[0].count = 1;
+	status = spi_flash_set_device_size (&flash, 0x1000);
+	CuAssertIntEquals (test, 0, status);
 
-	img_list[1].images_hash = &img_hash[1];
-	img_list[1].images_sig = NULL;
-	img_list[1].count = 1;
+	/* Without write tracking, the entire flash is checked every time. */
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
+		FLASH_EXP_READ_CMD (0x03, 0, 0, -1, strlen (data)));
 
-	img_list[2].images_hash = &img_hash[2];
-	img_list[2].images_sig = NULL;
-	img_list[2].count = 1;
+	status |= flash_master_mock_expect_blank_check (&flash_mock, 0 + strlen (data),
+		0x200 - strlen (data));
+	status |= flash_master_mock_expect_blank_check (&flash_mock, 0x300, 0x1000 - 0x300);
 
-	rw_region[0].start_addr = 0;
-	rw_region[0].length = 0x100;
-	rw_region[1].start_addr = 0x600;
-	rw_region[1].length = 0x100;
-	rw_region[2].start_addr = 0x400;
-	rw_region[2].length = 0x100;
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, (uint8_t*) data, strlen (data),
+		FLASH_EXP_READ_CMD (0x03, 0, 0, -1, strlen (data)));
 
-	rw_prop[0].on_failure = PFM_RW_DO_NOTHING;
-	rw_prop[1].on_failure = PFM_RW_DO_NOTHING;
-	rw_prop[2].on_failure = PFM_RW_DO_NOTHING;
+	status |= flash_master_mock_expect_blank_check (&flash_mock, 0 + strlen (data),
+		0x200 - strlen (data));
+	status |= flash_master_mock_expect_blank_check (&flash_mock, 0x300, 0x1000 - 0x300);
 
-	rw_list[0].regions = &rw_region[0];
-	rw_list[0].properties = &rw_prop[0];
-	rw_list[0].count = 1;
+	/* Each verification reports that the cache could not be used. */
+	status |= mock_expect (&logger.mock, logger.base.create_entry, &logger, 0,
+		MOCK_ARG_PTR_CONTAINS ((uint8_t*) &entry, LOG_ENTRY_SIZE_TIME_FIELD_NOT_INCLUDED),
+		MOCK_ARG (sizeof (entry)));
+	status |= mock_expect (&logger.mock, logger.base.create_entry, &logger, 0,
+		MOCK_ARG_PTR_CONTAINS ((uint8_t*) &entry, LOG_ENTRY_SIZE_TIME_FIELD_NOT_INCLUDED),
+		MOCK_ARG (sizeof (entry)));
 
-	rw_list[1].regions = &rw_region[1];
-	rw_list[1].properties = &rw_prop[1];
-	rw_list[1].count = 1;
+	CuAssertIntEquals (test, 0, status);
 
-	rw_list[2].regions = &rw_region[2];
-	rw_list[2].properties = &rw_prop[2];
-	rw_list[2].count = 1;
+	debug_log = &logger.base;
 
-	status = spi_flash_set_device_size (&flash, 0x1000);
+	status = host_fw_full_flash_verification_multiple_fw_with_cache (&flash, &img_list, &rw_list,
+		1, 0xff, &hash.base, &rsa.base, &cache, SPI_FILTER_CS_0);
 	CuAssertIntEquals (test, 0, status);
 
-	status = host_fw_full_flash_verification_multiple_fw (&flash, img_list, rw_list, 3, 0xff,
-		&hash.base, &rsa.base);
+	status = host_fw_full_flash_verification_multiple_fw_with_cache (&flash, &img_list, &rw_list,
+		1, 0xff, &hash.base, &rsa.base, &cache, SPI_FILTER_CS_0);
+	CuAssertIntEquals (test, 0, status);
+
+	debug_log = NULL;
+
+	status = logging_mock_validate_and_release (&logger);
 	CuAssertIntEquals (test, 0, status);
 
 	status = flash_master_mock_validate_and_release (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
+	status = spi_filter_interface_mock_validate_and_release (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_verify_cache_release (&cache);
 	spi_flash_release (&flash);
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
 }
 
-static void host_fw_full_flash_verification_multiple_fw_test_null (CuTest *test)
+static void host_fw_full_flash_verification_multiple_fw_with_cache_test_null (CuTest *test)
 {
 	struct flash_region img_region;
 	struct pfm_image_signature sig;
@@ -13820,6 +14944,10 @@ static void host_fw_full_flash_verification_multiple_fw_test_null (CuTest *test)
 	struct flash_master_mock flash_mock;
 	struct spi_flash_state state;
 	struct spi_flash flash;
+	struct spi_filter_interface_mock filter;
+	struct host_flash_verify_cache_entry entries[2];
+	struct host_flash_verify_cache cache;
+	uint8_t bitmap[2];
 	HASH_TESTING_ENGINE hash;
 	RSA_TESTING_ENGINE rsa;
 	int status;
@@ -13839,6 +14967,15 @@ static void host_fw_full_flash_verification_multiple_fw_test_null (CuTest *test)
 	status = spi_flash_init (&flash, &state, &flash_mock.base);
 	CuAssertIntEquals (test, 0, status);
 
+	status = spi_filter_interface_mock_init (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_filter_interface_mock_enable_dirty_block_tracking (&filter);
+
+	status = host_flash_verify_cache_init (&cache, &filter.base, entries, 2, bitmap,
+		sizeof (bitmap));
+	CuAssertIntEquals (test, 0, status);
+
 	img_region.start_addr = 0;
 	img_region.length = strlen (data);
 
@@ -13865,29 +15002,37 @@ static void host_fw_full_flash_verification_multiple_fw_test_null (CuTest *test)
 	status = spi_flash_set_device_size (&flash, 0x1000);
 	CuAssertIntEquals (test, 0, status);
 
-	status = host_fw_full_flash_verification_multiple_fw (NULL, &img_list, &rw_list, 1, 0xff,
-		&hash.base, &rsa.base);
+	status = host_fw_full_flash_verification_multiple_fw_with_cache (NULL, &img_list, &rw_list,
+		1, 0xff, &hash.base, &rsa.base, &cache, SPI_FILTER_CS_0);
 	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
 
-	status = host_fw_full_flash_verification_multiple_fw (&flash, NULL, &rw_list, 1, 0xff,
-		&hash.base, &rsa.base);
+	status = host_fw_full_flash_verification_multiple_fw_with_cache (&flash, NULL, &rw_list,
+		1, 0xff, &hash.base, &rsa.base, &cache, SPI_FILTER_CS_0);
 	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
 
-	status = host_fw_full_flash_verification_multiple_fw (&flash, &img_list, NULL, 1, 0xff,
-		&hash.base, &rsa.base);
+	status = host_fw_full_flash_verification_multiple_fw_with_cache (&flash, &img_list, NULL,
+		1, 0xff, &hash.base, &rsa.base, &cache, SPI_FILTER_CS_0);
 	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
 
-	status = host_fw_full_flash_verification_multiple_fw (&flash, &img_list, &rw_list, 1, 0xff,
-		NULL, &rsa.base);
+	status = host_fw_full_flash_verification_multiple_fw_with_cache (&flash, &img_list, &rw_list,
+		1, 0xff, NULL, &rsa.base, &cache, SPI_FILTER_CS_0);
 	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
 
-	status = host_fw_full_flash_verification_multiple_fw (&flash, &img_list, &rw_list, 1, 0xff,
-		&hash.base, NULL);
+	status = host_fw_full_flash_verification_multiple_fw_with_cache (&flash, &img_list, &rw_list,
+		1, 0xff, &hash.base, NULL, &cache, SPI_FILTER_CS_0);
+	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
+
+	status = host_fw_full_flash_verification_multiple_fw_with_cache (&flash, &img_list, &rw_list,
+		1, 0xff, &hash.base, &rsa.base, NULL, SPI_FILTER_CS_0);
 	CuAssertIntEquals (test, HOST_FW_UTIL_INVALID_ARGUMENT, status);
 
 	status = flash_master_mock_validate_and_release (&flash_mock);
 	CuAssertIntEquals (test, 0, status);
 
+	status = spi_filter_interface_mock_validate_and_release (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_verify_cache_release (&cache);
 	spi_flash_release (&flash);
 	HASH_TESTING_ENGINE_RELEASE (&hash);
 	RSA_TESTING_ENGINE_RELEASE (&rsa);
@@ -15559,11 +16704,21 @@ TEST (host_fw_verify_offset_images_multiple_fw_test_hashes_no_offset);
 TEST (host_fw_verify_offset_images_multiple_fw_test_hashes_invalid);
 TEST (host_fw_verify_offset_images_multiple_fw_test_hashes_multiple);
 TEST (host_fw_verify_offset_images_multiple_fw_test_null);
+TEST (host_fw_verify_images_multiple_fw_with_cache_test);
+TEST (host_fw_verify_images_multiple_fw_with_cache_test_invalid);
+TEST (host_fw_verify_images_multiple_fw_with_cache_test_hashes);
+TEST (host_fw_verify_images_multiple_fw_with_cache_test_no_write_tracking);
+TEST (host_fw_verify_images_multiple_fw_with_cache_test_null);
 TEST (host_fw_full_flash_verification_multiple_fw_test);
 TEST (host_fw_full_flash_verification_multiple_fw_test_multiple);
 TEST (host_fw_full_flash_verification_multiple_fw_test_hashes);
 TEST (host_fw_full_flash_verification_multiple_fw_test_hashes_multiple);
 TEST (host_fw_full_flash_verification_multiple_fw_test_null);
+TEST (host_fw_full_flash_verification_multiple_fw_with_cache_test);
+TEST (host_fw_full_flash_verification_multiple_fw_with_cache_test_layout_changed);
+TEST (host_fw_full_flash_verification_multiple_fw_with_cache_test_not_blank);
+TEST (host_fw_full_flash_verification_multiple_fw_with_cache_test_no_write_tracking);
+TEST (host_fw_full_flash_verification_multiple_fw_with_cache_test_null);
 TEST (host_fw_restore_read_write_data_multiple_fw_test);
 TEST (host_fw_restore_read_write_data_multiple_fw_test_no_source_device);
 TEST (host_fw_restore_read_write_data_multiple_fw_test_multiple);
@@ -6,6 +6,7 @@
 #include <string.h>
 #include "testing.h"
 #include "host_processor_dual_testing.h"
+#include "common/unused.h"
 
 
 TEST_SUITE_LABEL ("host_processor_dual");
@@ -244,6 +245,126 @@ void host_processor_dual_testing_validate_and_release (CuTest *test,
 	RSA_TESTING_ENGINE_RELEASE (&host->rsa);
 }
 
+/**
+ * Initialize a worker for parallel flash validation and assign it to the host instance.
+ *
+ * @param test The testing framework.
+ * @param host The testing components for the host.
+ * @param worker The worker components to initialize.
+ */
+void host_processor_dual_testing_init_verify_worker (CuTest *test,
+	struct host_processor_dual_testing *host, struct host_processor_dual_testing_worker *worker)
+{
+	int status;
+
+	status = HASH_TESTING_ENGINE_INIT (&worker->hash);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RSA_TESTING_ENGINE_INIT (&worker->rsa);
+	CuAssertIntEquals (test, 0, status);
+
+	status = event_task_mock_init (&worker->task);
+	CuAssertIntEquals (test, 0, status);
+
+	memset (&worker->context, 0, sizeof (worker->context));
+	worker->context_ptr = &worker->context;
+
+	status = host_flash_verify_worker_init (&worker->test, &worker->state, &worker->hash.base,
+		&worker->rsa.base, &worker->task.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&worker->spi_cs0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_init (&worker->spi_cs1);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Parallel validation requires each flash device to be on a separate SPI master. */
+	memset (&worker->flash_cs0, 0, sizeof (worker->flash_cs0));
+	worker->flash_cs0.spi = &worker->spi_cs0.base;
+	host->flash_mgr.base.flash_cs0 = &worker->flash_cs0;
+
+	memset (&worker->flash_cs1, 0, sizeof (worker->flash_cs1));
+	worker->flash_cs1.spi = &worker->spi_cs1.base;
+	host->flash_mgr.base.flash_cs1 = &worker->flash_cs1;
+
+	status = host_processor_dual_set_verify_worker (&host->test, &worker->test);
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Release a worker for parallel flash validation and validate the task mock.
+ *
+ * @param test The testing framework.
+ * @param worker The worker components to release.
+ */
+void host_processor_dual_testing_release_verify_worker (CuTest *test,
+	struct host_processor_dual_testing_worker *worker)
+{
+	int status;
+
+	status = event_task_mock_validate_and_release (&worker->task);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&worker->spi_cs0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&worker->spi_cs1);
+	CuAssertIntEquals (test, 0, status);
+
+	host_flash_verify_worker_release (&worker->test);
+
+	HASH_TESTING_ENGINE_RELEASE (&worker->hash);
+	RSA_TESTING_ENGINE_RELEASE (&worker->rsa);
+}
+
+/**
+ * Mock action to run a validation request in the worker when the task is notified.
+ *
+ * @param expected The expectation that is being used to validate the current call on the mock.
+ * @param called The context for the actual call on the mock.
+ *
+ * @return 0 to continue normal mock processing.
+ */
+static int64_t host_processor_dual_testing_run_verify_worker (const struct mock_call *expected,
+	const struct mock_call *called)
+{
+	struct host_processor_dual_testing_worker *worker = expected->context;
+	bool reset = false;
+
+	UNUSED (called);
+
+	worker->test.base.execute (&worker->test.base, worker->context_ptr, &reset);
+
+	return 0;
+}
+
+/**
+ * Set up expectations for a validation request being sent to the worker task.  The request will be
+ * executed when the task is notified, so expectations for the worker validation must follow.
+ *
+ * @param worker The worker components that will receive the request.
+ *
+ * @return 0 if the expectations were added successfully or non-zero if not.
+ */
+int host_processor_dual_testing_expect_verify_worker (
+	struct host_processor_dual_testing_worker *worker)
+{
+	int status;
+
+	status = mock_expect (&worker->task.mock, worker->task.base.get_event_context, &worker->task,
+		0, MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&worker->task.mock, 0, &worker->context_ptr,
+		sizeof (worker->context_ptr), -1);
+
+	status |= mock_expect (&worker->task.mock, worker->task.base.notify, &worker->task, 0,
+		MOCK_ARG_PTR (&worker->test.base));
+	status |= mock_expect_external_action (&worker->task.mock,
+		host_processor_dual_testing_run_verify_worker, worker);
+
+	return status;
+}
+
 /**
  * Initialize the host state manager for testing.
  *
@@ -634,6 +755,102 @@ static void host_processor_dual_test_release_null (CuTest *test)
 	host_processor_dual_release (NULL);
 }
 
+static void host_processor_dual_test_set_verify_worker (CuTest *test)
+{
+	struct host_processor_dual_testing host;
+	struct host_processor_dual_testing_worker worker;
+	int status;
+
+	TEST_START;
+
+	host_processor_dual_testing_init (test, &host);
+	host_processor_dual_testing_init_verify_worker (test, &host, &worker);
+
+	CuAssertPtrEquals (test, &worker.test, (void*) host.test.verify_worker);
+
+	status = host_processor_dual_set_verify_worker (&host.test, NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrEquals (test, NULL, (void*) host.test.verify_worker);
+
+	host_processor_dual_testing_release_verify_worker (test, &worker);
+	host_processor_dual_testing_validate_and_release (test, &host);
+}
+
+static void host_processor_dual_test_set_verify_worker_null (CuTest *test)
+{
+	struct host_processor_dual_testing host;
+	struct host_processor_dual_testing_worker worker;
+	int status;
+
+	TEST_START;
+
+	host_processor_dual_testing_init (test, &host);
+	host_processor_dual_testing_init_verify_worker (test, &host, &worker);
+
+	status = host_processor_dual_set_verify_worker (NULL, &worker.test);
+	CuAssertIntEquals (test, HOST_PROCESSOR_INVALID_ARGUMENT, status);
+
+	host_processor_dual_testing_release_verify_worker (test, &worker);
+	host_processor_dual_testing_validate_and_release (test, &host);
+}
+
+static void host_processor_dual_test_set_verify_worker_shared_flash_master (CuTest *test)
+{
+	struct host_processor_dual_testing host;
+	struct host_processor_dual_testing_worker worker;
+	int status;
+
+	TEST_START;
+
+	host_processor_dual_testing_init (test, &host);
+	host_processor_dual_testing_init_verify_worker (test, &host, &worker);
+
+	status = host_processor_dual_set_verify_worker (&host.test, NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	worker.flash_cs1.spi = &worker.spi_cs0.base;
+
+	status = host_processor_dual_set_verify_worker (&host.test, &worker.test);
+	CuAssertIntEquals (test, HOST_PROCESSOR_SHARED_FLASH_MASTER, status);
+
+	CuAssertPtrEquals (test, NULL, (void*) host.test.verify_worker);
+
+	host_processor_dual_testing_release_verify_worker (test, &worker);
+	host_processor_dual_testing_validate_and_release (test, &host);
+}
+
+static void host_processor_dual_test_set_verify_worker_no_flash_device (CuTest *test)
+{
+	struct host_processor_dual_testing host;
+	struct host_processor_dual_testing_worker worker;
+	int status;
+
+	TEST_START;
+
+	host_processor_dual_testing_init (test, &host);
+	host_processor_dual_testing_init_verify_worker (test, &host, &worker);
+
+	status = host_processor_dual_set_verify_worker (&host.test, NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	host.flash_mgr.base.flash_cs0 = NULL;
+
+	status = host_processor_dual_set_verify_worker (&host.test, &worker.test);
+	CuAssertIntEquals (test, HOST_PROCESSOR_SHARED_FLASH_MASTER, status);
+
+	host.flash_mgr.base.flash_cs0 = &worker.flash_cs0;
+	host.flash_mgr.base.flash_cs1 = NULL;
+
+	status = host_processor_dual_set_verify_worker (&host.test, &worker.test);
+	CuAssertIntEquals (test, HOST_PROCESSOR_SHARED_FLASH_MASTER, status);
+
+	CuAssertPtrEquals (test, NULL, (void*) host.test.verify_worker);
+
+	host_processor_dual_testing_release_verify_worker (test, &worker);
+	host_processor_dual_testing_validate_and_release (test, &host);
+}
+
 static void host_processor_dual_test_needs_config_recovery (CuTest *test)
 {
 	struct host_processor_dual_testing host;
@@ -2256,6 +2473,10 @@ TEST (host_processor_dual_test_init_pulse_reset);
 TEST (host_processor_dual_test_init_pulse_reset_null);
 TEST (host_processor_dual_test_init_pulse_reset_invalid_pulse_width);
 TEST (host_processor_dual_test_release_null);
+TEST (host_processor_dual_test_set_verify_worker);
+TEST (host_processor_dual_test_set_verify_worker_null);
+TEST (host_processor_dual_test_set_verify_worker_shared_flash_master);
+TEST (host_processor_dual_test_set_verify_worker_no_flash_device);
 TEST (host_processor_dual_test_needs_config_recovery);
 TEST (host_processor_dual_test_needs_config_recovery_no_host_access);
 TEST (host_processor_dual_test_needs_config_recovery_null);
@@ -42,6 +42,71 @@ static void host_processor_dual_test_apply_recovery_image (CuTest *test)
 
 	status |= mock_expect (&host.observer.mock, host.observer.base.on_recovery, &host.observer, 0);
 
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.invalidate_verified_flash,
+		&host.flash_mgr, 0);
+
+	status |= flash_master_mock_expect_chip_erase (&host.flash_mock_state);
+
+	status |= mock_expect (&host.image.mock, host.image.base.apply_to_flash, &host.image, 0,
+		MOCK_ARG_NOT_NULL);
+
+	status |= mock_expect (&host.filter.mock, host.filter.base.clear_filter_rw_regions,
+		&host.filter, 0);
+
+	status |= mock_expect (&host.flash_mgr.mock,
+		host.flash_mgr.base.base.config_spi_filter_flash_devices, &host.flash_mgr, 0);
+
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.set_flash_for_host_access,
+		&host.flash_mgr, 0, MOCK_ARG_PTR (&host.control));
+
+	status |= mock_expect (&host.control.mock, host.control.base.hold_processor_in_reset,
+		&host.control, 0, MOCK_ARG (false));
+
+	status |= mock_expect (&host.recovery_manager.mock,
+		host.recovery_manager.base.free_recovery_image, &host.recovery_manager, 0,
+		MOCK_ARG_PTR (&host.image));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = host.test.base.apply_recovery_image (&host.test.base, false);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_state_manager_is_bypass_mode (&host.host_state);
+	CuAssertIntEquals (test, false, status);
+
+	host_processor_dual_testing_validate_and_release (test, &host);
+}
+
+static void host_processor_dual_test_apply_recovery_image_no_invalidate_verified_flash (
+	CuTest *test)
+{
+	struct host_processor_dual_testing host;
+	int status;
+
+	TEST_START;
+
+	host_processor_dual_testing_init (test, &host);
+
+	/* The flash manager does not keep any information about verified flash. */
+	host.flash_mgr.base.base.invalidate_verified_flash = NULL;
+
+	status = mock_expect (&host.recovery_manager.mock,
+		host.recovery_manager.base.get_active_recovery_image, &host.recovery_manager,
+		MOCK_RETURN_PTR (&host.image.base));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&host.control.mock, host.control.base.hold_processor_in_reset,
+		&host.control, 0, MOCK_ARG (true));
+
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.set_flash_for_rot_access,
+		&host.flash_mgr, 0, MOCK_ARG_PTR (&host.control));
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.get_read_only_flash,
+		&host.flash_mgr, MOCK_RETURN_PTR (&host.flash_state));
+
+	status |= mock_expect (&host.observer.mock, host.observer.base.on_recovery, &host.observer, 0);
+
 	status |= flash_master_mock_expect_chip_erase (&host.flash_mock_state);
 
 	status |= mock_expect (&host.image.mock, host.image.base.apply_to_flash, &host.image, 0,
@@ -97,6 +162,9 @@ static void host_processor_dual_test_apply_recovery_image_pulse_reset (CuTest *t
 
 	status |= mock_expect (&host.observer.mock, host.observer.base.on_recovery, &host.observer, 0);
 
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.invalidate_verified_flash,
+		&host.flash_mgr, 0);
+
 	status |= flash_master_mock_expect_chip_erase (&host.flash_mock_state);
 
 	status |= mock_expect (&host.image.mock, host.image.base.apply_to_flash, &host.image, 0,
@@ -158,6 +226,9 @@ static void host_processor_dual_test_apply_recovery_image_no_observer (CuTest *t
 	status = mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.get_read_only_flash,
 		&host.flash_mgr, MOCK_RETURN_PTR (&host.flash_state));
 
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.invalidate_verified_flash,
+		&host.flash_mgr, 0);
+
 	status |= flash_master_mock_expect_chip_erase (&host.flash_mock_state);
 
 	status |= mock_expect (&host.image.mock, host.image.base.apply_to_flash, &host.image, 0,
@@ -218,6 +289,9 @@ static void host_processor_dual_test_apply_recovery_image_bypass (CuTest *test)
 
 	status |= mock_expect (&host.observer.mock, host.observer.base.on_recovery, &host.observer, 0);
 
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.invalidate_verified_flash,
+		&host.flash_mgr, 0);
+
 	status |= flash_master_mock_expect_chip_erase (&host.flash_mock_state);
 
 	status |= mock_expect (&host.image.mock, host.image.base.apply_to_flash, &host.image, 0,
@@ -267,6 +341,9 @@ static void host_processor_dual_test_apply_recovery_image_no_reset (CuTest *test
 
 	status |= mock_expect (&host.observer.mock, host.observer.base.on_recovery, &host.observer, 0);
 
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.invalidate_verified_flash,
+		&host.flash_mgr, 0);
+
 	status |= flash_master_mock_expect_chip_erase (&host.flash_mock_state);
 
 	status |= mock_expect (&host.image.mock, host.image.base.apply_to_flash, &host.image, 0,
@@ -319,6 +396,9 @@ static void host_processor_dual_test_apply_recovery_image_no_reset_pulse_reset (
 
 	status |= mock_expect (&host.observer.mock, host.observer.base.on_recovery, &host.observer, 0);
 
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.invalidate_verified_flash,
+		&host.flash_mgr, 0);
+
 	status |= flash_master_mock_expect_chip_erase (&host.flash_mock_state);
 
 	status |= mock_expect (&host.image.mock, host.image.base.apply_to_flash, &host.image, 0,
@@ -480,6 +560,9 @@ static void host_processor_dual_test_apply_recovery_image_bypass_unsupported_fla
 
 	status |= mock_expect (&host.observer.mock, host.observer.base.on_recovery, &host.observer, 0);
 
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.invalidate_verified_flash,
+		&host.flash_mgr, 0);
+
 	status |= flash_master_mock_expect_chip_erase (&host.flash_mock_state);
 
 	status |= mock_expect (&host.image.mock, host.image.base.apply_to_flash, &host.image, 0,
@@ -681,6 +764,9 @@ static void host_processor_dual_test_apply_recovery_image_chip_erase_error (
 
 	status |= mock_expect (&host.observer.mock, host.observer.base.on_recovery, &host.observer, 0);
 
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.invalidate_verified_flash,
+		&host.flash_mgr, 0);
+
 	status |= flash_master_mock_expect_rx_xfer (&host.flash_mock_state, 0, &WIP_STATUS, 1,
 	FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_xfer (&host.flash_mock_state, 0, FLASH_EXP_WRITE_ENABLE);
@@ -732,6 +818,9 @@ static void host_processor_dual_test_apply_recovery_image_chip_erase_error_pulse
 
 	status |= mock_expect (&host.observer.mock, host.observer.base.on_recovery, &host.observer, 0);
 
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.invalidate_verified_flash,
+		&host.flash_mgr, 0);
+
 	status |= flash_master_mock_expect_rx_xfer (&host.flash_mock_state, 0, &WIP_STATUS, 1,
 	FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_xfer (&host.flash_mock_state, 0, FLASH_EXP_WRITE_ENABLE);
@@ -787,6 +876,9 @@ static void host_processor_dual_test_apply_recovery_image_bad_image (CuTest *tes
 
 	status |= mock_expect (&host.observer.mock, host.observer.base.on_recovery, &host.observer, 0);
 
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.invalidate_verified_flash,
+		&host.flash_mgr, 0);
+
 	status |= flash_master_mock_expect_chip_erase (&host.flash_mock_state);
 
 	status |= mock_expect (&host.image.mock, host.image.base.apply_to_flash, &host.image,
@@ -836,6 +928,9 @@ static void host_processor_dual_test_apply_recovery_image_bad_image_pulse_reset
 
 	status |= mock_expect (&host.observer.mock, host.observer.base.on_recovery, &host.observer, 0);
 
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.invalidate_verified_flash,
+		&host.flash_mgr, 0);
+
 	status |= flash_master_mock_expect_chip_erase (&host.flash_mock_state);
 
 	status |= mock_expect (&host.image.mock, host.image.base.apply_to_flash, &host.image,
@@ -890,6 +985,9 @@ static void host_processor_dual_test_apply_recovery_image_clear_rw_region_error
 
 	status |= mock_expect (&host.observer.mock, host.observer.base.on_recovery, &host.observer, 0);
 
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.invalidate_verified_flash,
+		&host.flash_mgr, 0);
+
 	status |= flash_master_mock_expect_chip_erase (&host.flash_mock_state);
 
 	status |= mock_expect (&host.image.mock, host.image.base.apply_to_flash, &host.image, 0,
@@ -954,6 +1052,9 @@ static void host_processor_dual_test_apply_recovery_image_clear_rw_region_error_
 
 	status |= mock_expect (&host.observer.mock, host.observer.base.on_recovery, &host.observer, 0);
 
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.invalidate_verified_flash,
+		&host.flash_mgr, 0);
+
 	status |= flash_master_mock_expect_chip_erase (&host.flash_mock_state);
 
 	status |= mock_expect (&host.image.mock, host.image.base.apply_to_flash, &host.image, 0,
@@ -1022,6 +1123,9 @@ static void host_processor_dual_test_apply_recovery_image_spi_filter_config_erro
 
 	status |= mock_expect (&host.observer.mock, host.observer.base.on_recovery, &host.observer, 0);
 
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.invalidate_verified_flash,
+		&host.flash_mgr, 0);
+
 	status |= flash_master_mock_expect_chip_erase (&host.flash_mock_state);
 
 	status |= mock_expect (&host.image.mock, host.image.base.apply_to_flash, &host.image, 0,
@@ -1090,6 +1194,9 @@ static void host_processor_dual_test_apply_recovery_image_spi_filter_config_erro
 
 	status |= mock_expect (&host.observer.mock, host.observer.base.on_recovery, &host.observer, 0);
 
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.invalidate_verified_flash,
+		&host.flash_mgr, 0);
+
 	status |= flash_master_mock_expect_chip_erase (&host.flash_mock_state);
 
 	status |= mock_expect (&host.image.mock, host.image.base.apply_to_flash, &host.image, 0,
@@ -1163,6 +1270,9 @@ static void host_processor_dual_test_apply_recovery_image_set_flash_for_host_acc
 
 	status |= mock_expect (&host.observer.mock, host.observer.base.on_recovery, &host.observer, 0);
 
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.invalidate_verified_flash,
+		&host.flash_mgr, 0);
+
 	status |= flash_master_mock_expect_chip_erase (&host.flash_mock_state);
 
 	status |= mock_expect (&host.image.mock, host.image.base.apply_to_flash, &host.image, 0,
@@ -1227,6 +1337,9 @@ static void host_processor_dual_test_apply_recovery_image_set_flash_for_host_acc
 
 	status |= mock_expect (&host.observer.mock, host.observer.base.on_recovery, &host.observer, 0);
 
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.invalidate_verified_flash,
+		&host.flash_mgr, 0);
+
 	status |= flash_master_mock_expect_chip_erase (&host.flash_mock_state);
 
 	status |= mock_expect (&host.image.mock, host.image.base.apply_to_flash, &host.image, 0,
@@ -1273,6 +1386,7 @@ static void host_processor_dual_test_apply_recovery_image_set_flash_for_host_acc
 TEST_SUITE_START (host_processor_dual_apply_recovery_image);
 
 TEST (host_processor_dual_test_apply_recovery_image);
+TEST (host_processor_dual_test_apply_recovery_image_no_invalidate_verified_flash);
 TEST (host_processor_dual_test_apply_recovery_image_pulse_reset);
 TEST (host_processor_dual_test_apply_recovery_image_no_observer);
 TEST (host_processor_dual_test_apply_recovery_image_bypass);
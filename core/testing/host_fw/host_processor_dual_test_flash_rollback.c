@@ -57,6 +57,101 @@ static void host_processor_dual_test_flash_rollback_no_pfm (CuTest *test)
 	status |= spi_flash_set_device_size (&flash2_host, flash_size);
 	CuAssertIntEquals (test, 0, status);
 
+	status = mock_expect (&host.pfm_mgr.mock, host.pfm_mgr.base.get_active_pfm, &host.pfm_mgr,
+		MOCK_RETURN_PTR (NULL));
+
+	status |= mock_expect (&host.control.mock, host.control.base.hold_processor_in_reset,
+		&host.control, 0, MOCK_ARG (true));
+
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.set_flash_for_rot_access,
+		&host.flash_mgr, 0, MOCK_ARG_PTR (&host.control));
+
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.get_read_only_flash,
+		&host.flash_mgr, MOCK_RETURN_PTR (&flash1_host));
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.get_read_write_flash,
+		&host.flash_mgr, MOCK_RETURN_PTR (&flash2_host));
+
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.invalidate_verified_flash,
+		&host.flash_mgr, 0);
+
+	status |= flash_master_mock_expect_chip_erase (&flash1_mock_host);
+	status |= flash_master_mock_expect_copy_flash_verify (&flash1_mock_host, &flash2_mock_host, 0,
+		0, data, flash_size);
+
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.set_flash_for_host_access,
+		&host.flash_mgr, 0, MOCK_ARG_PTR (&host.control));
+	status |= mock_expect (&host.control.mock, host.control.base.hold_processor_in_reset,
+		&host.control, 0, MOCK_ARG (false));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = host.test.base.flash_rollback (&host.test.base, &host.hash.base, &host.rsa.base,
+		false, false);
+	CuAssertIntEquals (test, 0, status);
+
+	status = host_state_manager_is_pfm_dirty (&host.host_state);
+	CuAssertIntEquals (test, true, status);
+
+	status = host_state_manager_is_bypass_mode (&host.host_state);
+	CuAssertIntEquals (test, false, status);
+
+	status = flash_master_mock_validate_and_release (&flash1_mock_host);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash2_mock_host);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_flash_release (&flash1_host);
+	spi_flash_release (&flash2_host);
+
+	host_processor_dual_testing_validate_and_release (test, &host);
+}
+
+static void host_processor_dual_test_flash_rollback_no_pfm_no_invalidate_verified_flash (
+	CuTest *test)
+{
+	struct host_processor_dual_testing host;
+	struct flash_master_mock flash1_mock_host;
+	struct flash_master_mock flash2_mock_host;
+	struct spi_flash_state state1_host;
+	struct spi_flash flash1_host;
+	struct spi_flash_state state2_host;
+	struct spi_flash flash2_host;
+	int status;
+	const int flash_size = 0x300;
+	uint8_t data[flash_size];
+	int i;
+
+	TEST_START;
+
+	for (i = 0; i < flash_size; i++) {
+		data[i] = RSA_PRIVKEY_DER[i % RSA_PRIVKEY_DER_LEN];
+	}
+
+	host_processor_dual_testing_init (test, &host);
+
+	/* The flash manager does not keep any information about verified flash. */
+	host.flash_mgr.base.base.invalidate_verified_flash = NULL;
+	host.flash_mock_state.mock.name = "flash_state";
+
+	status = flash_master_mock_init (&flash1_mock_host);
+	CuAssertIntEquals (test, 0, status);
+	flash1_mock_host.mock.name = "flash1_mock_host";
+
+	status = flash_master_mock_init (&flash2_mock_host);
+	CuAssertIntEquals (test, 0, status);
+	flash2_mock_host.mock.name = "flash2_mock_host";
+
+	status = spi_flash_init (&flash1_host, &state1_host, &flash1_mock_host.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash2_host, &state2_host, &flash2_mock_host.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash1_host, flash_size);
+	status |= spi_flash_set_device_size (&flash2_host, flash_size);
+	CuAssertIntEquals (test, 0, status);
+
 	status = mock_expect (&host.pfm_mgr.mock, host.pfm_mgr.base.get_active_pfm, &host.pfm_mgr,
 		MOCK_RETURN_PTR (NULL));
 
@@ -161,6 +256,9 @@ static void host_processor_dual_test_flash_rollback_no_pfm_bypass (CuTest *test)
 	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.get_read_write_flash,
 		&host.flash_mgr, MOCK_RETURN_PTR (&flash2_host));
 
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.invalidate_verified_flash,
+		&host.flash_mgr, 0);
+
 	status |= flash_master_mock_expect_chip_erase (&flash1_mock_host);
 	status |= flash_master_mock_expect_copy_flash_verify (&flash1_mock_host, &flash2_mock_host, 0,
 		0, data, flash_size);
@@ -251,6 +349,9 @@ static void host_processor_dual_test_flash_rollback_no_pfm_checked (CuTest *test
 	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.get_read_write_flash,
 		&host.flash_mgr, MOCK_RETURN_PTR (&flash2_host));
 
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.invalidate_verified_flash,
+		&host.flash_mgr, 0);
+
 	status |= flash_master_mock_expect_chip_erase (&flash1_mock_host);
 	status |= flash_master_mock_expect_copy_flash_verify (&flash1_mock_host, &flash2_mock_host, 0,
 		0, data, flash_size);
@@ -342,6 +443,9 @@ static void host_processor_dual_test_flash_rollback_no_pfm_checked_bypass (CuTes
 	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.get_read_write_flash,
 		&host.flash_mgr, MOCK_RETURN_PTR (&flash2_host));
 
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.invalidate_verified_flash,
+		&host.flash_mgr, 0);
+
 	status |= flash_master_mock_expect_chip_erase (&flash1_mock_host);
 	status |= flash_master_mock_expect_copy_flash_verify (&flash1_mock_host, &flash2_mock_host, 0,
 		0, data, flash_size);
@@ -433,6 +537,9 @@ static void host_processor_dual_test_flash_rollback_no_pfm_dirty (CuTest *test)
 	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.get_read_write_flash,
 		&host.flash_mgr, MOCK_RETURN_PTR (&flash2_host));
 
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.invalidate_verified_flash,
+		&host.flash_mgr, 0);
+
 	status |= flash_master_mock_expect_chip_erase (&flash1_mock_host);
 	status |= flash_master_mock_expect_copy_flash_verify (&flash1_mock_host, &flash2_mock_host, 0,
 		0, data, flash_size);
@@ -529,6 +636,9 @@ static void host_processor_dual_test_flash_rollback_no_pfm_dirty_bypass (CuTest
 	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.get_read_write_flash,
 		&host.flash_mgr, MOCK_RETURN_PTR (&flash2_host));
 
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.invalidate_verified_flash,
+		&host.flash_mgr, 0);
+
 	status |= flash_master_mock_expect_chip_erase (&flash1_mock_host);
 	status |= flash_master_mock_expect_copy_flash_verify (&flash1_mock_host, &flash2_mock_host, 0,
 		0, data, flash_size);
@@ -625,6 +735,9 @@ static void host_processor_dual_test_flash_rollback_no_pfm_dirty_checked (CuTest
 	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.get_read_write_flash,
 		&host.flash_mgr, MOCK_RETURN_PTR (&flash2_host));
 
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.invalidate_verified_flash,
+		&host.flash_mgr, 0);
+
 	status |= flash_master_mock_expect_chip_erase (&flash1_mock_host);
 	status |= flash_master_mock_expect_copy_flash_verify (&flash1_mock_host, &flash2_mock_host, 0,
 		0, data, flash_size);
@@ -722,6 +835,9 @@ static void host_processor_dual_test_flash_rollback_no_pfm_dirty_checked_bypass
 	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.get_read_write_flash,
 		&host.flash_mgr, MOCK_RETURN_PTR (&flash2_host));
 
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.invalidate_verified_flash,
+		&host.flash_mgr, 0);
+
 	status |= flash_master_mock_expect_chip_erase (&flash1_mock_host);
 	status |= flash_master_mock_expect_copy_flash_verify (&flash1_mock_host, &flash2_mock_host, 0,
 		0, data, flash_size);
@@ -810,6 +926,9 @@ static void host_processor_dual_test_flash_rollback_no_pfm_pulse_reset (CuTest *
 	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.get_read_write_flash,
 		&host.flash_mgr, MOCK_RETURN_PTR (&flash2_host));
 
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.invalidate_verified_flash,
+		&host.flash_mgr, 0);
+
 	status |= flash_master_mock_expect_chip_erase (&flash1_mock_host);
 	status |= flash_master_mock_expect_copy_flash_verify (&flash1_mock_host, &flash2_mock_host, 0,
 		0, data, flash_size);
@@ -955,6 +1074,9 @@ static void host_processor_dual_test_flash_rollback_no_pfm_no_reset (CuTest *tes
 	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.get_read_write_flash,
 		&host.flash_mgr, MOCK_RETURN_PTR (&flash2_host));
 
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.invalidate_verified_flash,
+		&host.flash_mgr, 0);
+
 	status |= flash_master_mock_expect_chip_erase (&flash1_mock_host);
 	status |= flash_master_mock_expect_copy_flash_verify (&flash1_mock_host, &flash2_mock_host, 0,
 		0, data, flash_size);
@@ -1038,6 +1160,9 @@ static void host_processor_dual_test_flash_rollback_no_pfm_no_reset_pulse_reset
 	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.get_read_write_flash,
 		&host.flash_mgr, MOCK_RETURN_PTR (&flash2_host));
 
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.invalidate_verified_flash,
+		&host.flash_mgr, 0);
+
 	status |= flash_master_mock_expect_chip_erase (&flash1_mock_host);
 	status |= flash_master_mock_expect_copy_flash_verify (&flash1_mock_host, &flash2_mock_host, 0,
 		0, data, flash_size);
@@ -1126,6 +1251,9 @@ static void host_processor_dual_test_flash_rollback_no_pfm_unsupported_flash (Cu
 	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.get_read_write_flash,
 		&host.flash_mgr, MOCK_RETURN_PTR (&flash2_host));
 
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.invalidate_verified_flash,
+		&host.flash_mgr, 0);
+
 	status |= flash_master_mock_expect_chip_erase (&flash1_mock_host);
 	status |= flash_master_mock_expect_copy_flash_verify (&flash1_mock_host, &flash2_mock_host, 0,
 		0, data, flash_size);
@@ -2998,6 +3126,9 @@ static void host_processor_dual_test_flash_rollback_no_pfm_erase_error (CuTest *
 	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.get_read_write_flash,
 		&host.flash_mgr, MOCK_RETURN_PTR (&flash2_host));
 
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.invalidate_verified_flash,
+		&host.flash_mgr, 0);
+
 	status |= flash_master_mock_expect_xfer (&flash1_mock_host, FLASH_MASTER_XFER_FAILED,
 		FLASH_EXP_READ_STATUS_REG);
 
@@ -3076,6 +3207,9 @@ static void host_processor_dual_test_flash_rollback_no_pfm_erase_error_pulse_res
 	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.get_read_write_flash,
 		&host.flash_mgr, MOCK_RETURN_PTR (&flash2_host));
 
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.invalidate_verified_flash,
+		&host.flash_mgr, 0);
+
 	status |= flash_master_mock_expect_xfer (&flash1_mock_host, FLASH_MASTER_XFER_FAILED,
 		FLASH_EXP_READ_STATUS_REG);
 
@@ -3160,6 +3294,9 @@ static void host_processor_dual_test_flash_rollback_no_pfm_copy_error (CuTest *t
 	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.get_read_write_flash,
 		&host.flash_mgr, MOCK_RETURN_PTR (&flash2_host));
 
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.invalidate_verified_flash,
+		&host.flash_mgr, 0);
+
 	status |= flash_master_mock_expect_chip_erase (&flash1_mock_host);
 	status |= flash_master_mock_expect_xfer (&flash2_mock_host, FLASH_MASTER_XFER_FAILED,
 		FLASH_EXP_READ_STATUS_REG);
@@ -3239,6 +3376,9 @@ static void host_processor_dual_test_flash_rollback_no_pfm_copy_error_pulse_rese
 	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.get_read_write_flash,
 		&host.flash_mgr, MOCK_RETURN_PTR (&flash2_host));
 
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.invalidate_verified_flash,
+		&host.flash_mgr, 0);
+
 	status |= flash_master_mock_expect_chip_erase (&flash1_mock_host);
 	status |= flash_master_mock_expect_xfer (&flash2_mock_host, FLASH_MASTER_XFER_FAILED,
 		FLASH_EXP_READ_STATUS_REG);
@@ -3330,6 +3470,9 @@ static void host_processor_dual_test_flash_rollback_no_pfm_host_access_error (Cu
 	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.get_read_write_flash,
 		&host.flash_mgr, MOCK_RETURN_PTR (&flash2_host));
 
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.invalidate_verified_flash,
+		&host.flash_mgr, 0);
+
 	status |= flash_master_mock_expect_chip_erase (&flash1_mock_host);
 	status |= flash_master_mock_expect_copy_flash_verify (&flash1_mock_host, &flash2_mock_host, 0,
 		0, data, flash_size);
@@ -3425,6 +3568,9 @@ static void host_processor_dual_test_flash_rollback_no_pfm_host_access_error_pul
 	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.get_read_write_flash,
 		&host.flash_mgr, MOCK_RETURN_PTR (&flash2_host));
 
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.invalidate_verified_flash,
+		&host.flash_mgr, 0);
+
 	status |= flash_master_mock_expect_chip_erase (&flash1_mock_host);
 	status |= flash_master_mock_expect_copy_flash_verify (&flash1_mock_host, &flash2_mock_host, 0,
 		0, data, flash_size);
@@ -4477,6 +4623,7 @@ static void host_processor_dual_test_flash_rollback_active_pfm_not_dirty_bypass_
 TEST_SUITE_START (host_processor_dual_flash_rollback);
 
 TEST (host_processor_dual_test_flash_rollback_no_pfm);
+TEST (host_processor_dual_test_flash_rollback_no_pfm_no_invalidate_verified_flash);
 TEST (host_processor_dual_test_flash_rollback_no_pfm_bypass);
 TEST (host_processor_dual_test_flash_rollback_no_pfm_checked);
 TEST (host_processor_dual_test_flash_rollback_no_pfm_checked_bypass);
@@ -18,6 +18,7 @@
 #include "testing/mock/recovery/recovery_image_manager_mock.h"
 #include "testing/mock/recovery/recovery_image_mock.h"
 #include "testing/mock/spi_filter/spi_filter_interface_mock.h"
+#include "testing/mock/system/event_task_mock.h"
 #include "testing/engines/hash_testing_engine.h"
 #include "testing/engines/rsa_testing_engine.h"
 
@@ -45,6 +46,23 @@ struct host_processor_dual_testing {
 	struct logging_mock logger;								/**< Mock for debug logging. */
 };
 
+/**
+ * Dependencies for testing parallel flash validation.
+ */
+struct host_processor_dual_testing_worker {
+	HASH_TESTING_ENGINE hash;								/**< Hash engine for the worker. */
+	RSA_TESTING_ENGINE rsa;									/**< RSA engine for the worker. */
+	struct event_task_mock task;							/**< Mock for the worker task. */
+	struct event_task_context context;						/**< Event context for the worker. */
+	struct event_task_context *context_ptr;					/**< Pointer to the event context. */
+	struct host_flash_verify_worker_state state;			/**< Context for the worker. */
+	struct host_flash_verify_worker test;					/**< Worker for parallel validation. */
+	struct flash_master_mock spi_cs0;						/**< SPI master for the CS0 flash device. */
+	struct flash_master_mock spi_cs1;						/**< SPI master for the CS1 flash device. */
+	struct spi_flash flash_cs0;								/**< The flash device on CS0. */
+	struct spi_flash flash_cs1;								/**< The flash device on CS1. */
+};
+
 
 void host_processor_dual_testing_init_dependencies (CuTest *test,
 	struct host_processor_dual_testing *host);
@@ -64,6 +82,13 @@ void host_processor_dual_testing_init_no_recovery_pulse_reset (CuTest *test,
 void host_processor_dual_testing_validate_and_release (CuTest *test,
 	struct host_processor_dual_testing *host);
 
+void host_processor_dual_testing_init_verify_worker (CuTest *test,
+	struct host_processor_dual_testing *host, struct host_processor_dual_testing_worker *worker);
+void host_processor_dual_testing_release_verify_worker (CuTest *test,
+	struct host_processor_dual_testing_worker *worker);
+int host_processor_dual_testing_expect_verify_worker (
+	struct host_processor_dual_testing_worker *worker);
+
 void host_processor_dual_testing_init_host_state (CuTest *test, struct host_state_manager *state,
 	struct flash_master_mock *flash_mock, struct spi_flash *flash,
 	struct spi_flash_state *flash_state);
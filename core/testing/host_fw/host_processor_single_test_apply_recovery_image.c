@@ -42,6 +42,9 @@ static void host_processor_single_test_apply_recovery_image (CuTest *test)
 
 	status |= mock_expect (&host.observer.mock, host.observer.base.on_recovery, &host.observer, 0);
 
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.invalidate_verified_flash,
+		&host.flash_mgr, 0);
+
 	status |= flash_master_mock_expect_chip_erase (&host.flash_mock_state);
 
 	status |= mock_expect (&host.image.mock, host.image.base.apply_to_flash, &host.image, 0,
@@ -97,6 +100,9 @@ static void host_processor_single_test_apply_recovery_image_pulse_reset (CuTest
 
 	status |= mock_expect (&host.observer.mock, host.observer.base.on_recovery, &host.observer, 0);
 
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.invalidate_verified_flash,
+		&host.flash_mgr, 0);
+
 	status |= flash_master_mock_expect_chip_erase (&host.flash_mock_state);
 
 	status |= mock_expect (&host.image.mock, host.image.base.apply_to_flash, &host.image, 0,
@@ -158,6 +164,9 @@ static void host_processor_single_test_apply_recovery_image_no_observer (CuTest
 	status = mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.get_read_only_flash,
 		&host.flash_mgr, MOCK_RETURN_PTR (&host.flash_state));
 
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.invalidate_verified_flash,
+		&host.flash_mgr, 0);
+
 	status |= flash_master_mock_expect_chip_erase (&host.flash_mock_state);
 
 	status |= mock_expect (&host.image.mock, host.image.base.apply_to_flash, &host.image, 0,
@@ -218,6 +227,9 @@ static void host_processor_single_test_apply_recovery_image_bypass (CuTest *test
 
 	status |= mock_expect (&host.observer.mock, host.observer.base.on_recovery, &host.observer, 0);
 
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.invalidate_verified_flash,
+		&host.flash_mgr, 0);
+
 	status |= flash_master_mock_expect_chip_erase (&host.flash_mock_state);
 
 	status |= mock_expect (&host.image.mock, host.image.base.apply_to_flash, &host.image, 0,
@@ -267,6 +279,9 @@ static void host_processor_single_test_apply_recovery_image_no_reset (CuTest *te
 
 	status |= mock_expect (&host.observer.mock, host.observer.base.on_recovery, &host.observer, 0);
 
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.invalidate_verified_flash,
+		&host.flash_mgr, 0);
+
 	status |= flash_master_mock_expect_chip_erase (&host.flash_mock_state);
 
 	status |= mock_expect (&host.image.mock, host.image.base.apply_to_flash, &host.image, 0,
@@ -319,6 +334,9 @@ static void host_processor_single_test_apply_recovery_image_no_reset_pulse_reset
 
 	status |= mock_expect (&host.observer.mock, host.observer.base.on_recovery, &host.observer, 0);
 
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.invalidate_verified_flash,
+		&host.flash_mgr, 0);
+
 	status |= flash_master_mock_expect_chip_erase (&host.flash_mock_state);
 
 	status |= mock_expect (&host.image.mock, host.image.base.apply_to_flash, &host.image, 0,
@@ -481,6 +499,9 @@ static void host_processor_single_test_apply_recovery_image_bypass_unsupported_f
 
 	status |= mock_expect (&host.observer.mock, host.observer.base.on_recovery, &host.observer, 0);
 
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.invalidate_verified_flash,
+		&host.flash_mgr, 0);
+
 	status |= flash_master_mock_expect_chip_erase (&host.flash_mock_state);
 
 	status |= mock_expect (&host.image.mock, host.image.base.apply_to_flash, &host.image, 0,
@@ -682,6 +703,9 @@ static void host_processor_single_test_apply_recovery_image_chip_erase_error (
 
 	status |= mock_expect (&host.observer.mock, host.observer.base.on_recovery, &host.observer, 0);
 
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.invalidate_verified_flash,
+		&host.flash_mgr, 0);
+
 	status |= flash_master_mock_expect_rx_xfer (&host.flash_mock_state, 0, &WIP_STATUS, 1,
 	FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_xfer (&host.flash_mock_state, 0, FLASH_EXP_WRITE_ENABLE);
@@ -733,6 +757,9 @@ static void host_processor_single_test_apply_recovery_image_chip_erase_error_pul
 
 	status |= mock_expect (&host.observer.mock, host.observer.base.on_recovery, &host.observer, 0);
 
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.invalidate_verified_flash,
+		&host.flash_mgr, 0);
+
 	status |= flash_master_mock_expect_rx_xfer (&host.flash_mock_state, 0, &WIP_STATUS, 1,
 	FLASH_EXP_READ_STATUS_REG);
 	status |= flash_master_mock_expect_xfer (&host.flash_mock_state, 0, FLASH_EXP_WRITE_ENABLE);
@@ -788,6 +815,9 @@ static void host_processor_single_test_apply_recovery_image_bad_image (CuTest *t
 
 	status |= mock_expect (&host.observer.mock, host.observer.base.on_recovery, &host.observer, 0);
 
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.invalidate_verified_flash,
+		&host.flash_mgr, 0);
+
 	status |= flash_master_mock_expect_chip_erase (&host.flash_mock_state);
 
 	status |= mock_expect (&host.image.mock, host.image.base.apply_to_flash, &host.image,
@@ -837,6 +867,9 @@ static void host_processor_single_test_apply_recovery_image_bad_image_pulse_rese
 
 	status |= mock_expect (&host.observer.mock, host.observer.base.on_recovery, &host.observer, 0);
 
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.invalidate_verified_flash,
+		&host.flash_mgr, 0);
+
 	status |= flash_master_mock_expect_chip_erase (&host.flash_mock_state);
 
 	status |= mock_expect (&host.image.mock, host.image.base.apply_to_flash, &host.image,
@@ -891,6 +924,9 @@ static void host_processor_single_test_apply_recovery_image_clear_rw_region_erro
 
 	status |= mock_expect (&host.observer.mock, host.observer.base.on_recovery, &host.observer, 0);
 
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.invalidate_verified_flash,
+		&host.flash_mgr, 0);
+
 	status |= flash_master_mock_expect_chip_erase (&host.flash_mock_state);
 
 	status |= mock_expect (&host.image.mock, host.image.base.apply_to_flash, &host.image, 0,
@@ -955,6 +991,9 @@ static void host_processor_single_test_apply_recovery_image_clear_rw_region_erro
 
 	status |= mock_expect (&host.observer.mock, host.observer.base.on_recovery, &host.observer, 0);
 
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.invalidate_verified_flash,
+		&host.flash_mgr, 0);
+
 	status |= flash_master_mock_expect_chip_erase (&host.flash_mock_state);
 
 	status |= mock_expect (&host.image.mock, host.image.base.apply_to_flash, &host.image, 0,
@@ -1023,6 +1062,9 @@ static void host_processor_single_test_apply_recovery_image_spi_filter_config_er
 
 	status |= mock_expect (&host.observer.mock, host.observer.base.on_recovery, &host.observer, 0);
 
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.invalidate_verified_flash,
+		&host.flash_mgr, 0);
+
 	status |= flash_master_mock_expect_chip_erase (&host.flash_mock_state);
 
 	status |= mock_expect (&host.image.mock, host.image.base.apply_to_flash, &host.image, 0,
@@ -1091,6 +1133,9 @@ static void host_processor_single_test_apply_recovery_image_spi_filter_config_er
 
 	status |= mock_expect (&host.observer.mock, host.observer.base.on_recovery, &host.observer, 0);
 
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.invalidate_verified_flash,
+		&host.flash_mgr, 0);
+
 	status |= flash_master_mock_expect_chip_erase (&host.flash_mock_state);
 
 	status |= mock_expect (&host.image.mock, host.image.base.apply_to_flash, &host.image, 0,
@@ -1164,6 +1209,9 @@ static void host_processor_single_test_apply_recovery_image_set_flash_for_host_a
 
 	status |= mock_expect (&host.observer.mock, host.observer.base.on_recovery, &host.observer, 0);
 
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.invalidate_verified_flash,
+		&host.flash_mgr, 0);
+
 	status |= flash_master_mock_expect_chip_erase (&host.flash_mock_state);
 
 	status |= mock_expect (&host.image.mock, host.image.base.apply_to_flash, &host.image, 0,
@@ -1228,6 +1276,9 @@ static void host_processor_single_test_apply_recovery_image_set_flash_for_host_a
 
 	status |= mock_expect (&host.observer.mock, host.observer.base.on_recovery, &host.observer, 0);
 
+	status |= mock_expect (&host.flash_mgr.mock, host.flash_mgr.base.base.invalidate_verified_flash,
+		&host.flash_mgr, 0);
+
 	status |= flash_master_mock_expect_chip_erase (&host.flash_mock_state);
 
 	status |= mock_expect (&host.image.mock, host.image.base.apply_to_flash, &host.image, 0,
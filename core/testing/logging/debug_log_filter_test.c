@@ -0,0 +1,767 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "platform_api.h"
+#include "testing.h"
+#include "logging/debug_log_filter.h"
+#include "logging/debug_log_filter_static.h"
+
+
+TEST_SUITE_LABEL ("debug_log_filter");
+
+
+/*******************
+ * Test cases
+ *******************/
+
+static void debug_log_filter_test_init (CuTest *test)
+{
+	struct debug_log_filter filter;
+	struct debug_log_filter_state state;
+	struct debug_log_filter_bucket buckets[8];
+	struct debug_log_filter_stats stats;
+	int status;
+	int i;
+
+	TEST_START;
+
+	status = debug_log_filter_init (&filter, &state, buckets, 8, 4, 100);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < DEBUG_LOG_FILTER_NUM_COMPONENTS; i++) {
+		status = debug_log_filter_get_threshold (&filter, i);
+		CuAssertIntEquals (test, DEBUG_LOG_FILTER_LOG_ALL, status);
+	}
+
+	status = debug_log_filter_get_stats (&filter, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, stats.filtered);
+	CuAssertIntEquals (test, 0, stats.suppressed);
+
+	debug_log_filter_release (&filter);
+}
+
+static void debug_log_filter_test_init_no_rate_limit (CuTest *test)
+{
+	struct debug_log_filter filter;
+	struct debug_log_filter_state state;
+	int status;
+
+	TEST_START;
+
+	status = debug_log_filter_init (&filter, &state, NULL, 0, 0, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	debug_log_filter_release (&filter);
+}
+
+static void debug_log_filter_test_init_null (CuTest *test)
+{
+	struct debug_log_filter filter;
+	struct debug_log_filter_state state;
+	struct debug_log_filter_bucket buckets[8];
+	int status;
+
+	TEST_START;
+
+	status = debug_log_filter_init (NULL, &state, buckets, 8, 4, 100);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = debug_log_filter_init (&filter, NULL, buckets, 8, 4, 100);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = debug_log_filter_init (&filter, &state, NULL, 8, 4, 100);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = debug_log_filter_init (&filter, &state, buckets, 0, 4, 100);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = debug_log_filter_init (&filter, &state, buckets, 8, 4, 0);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+}
+
+static void debug_log_filter_test_static_init (CuTest *test)
+{
+	struct debug_log_filter_state state;
+	struct debug_log_filter_bucket buckets[8];
+	struct debug_log_filter filter = debug_log_filter_static_init (&state, buckets, 8, 4, 100);
+	int status;
+
+	TEST_START;
+
+	status = debug_log_filter_init_state (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = debug_log_filter_get_threshold (&filter, DEBUG_LOG_COMPONENT_MCTP);
+	CuAssertIntEquals (test, DEBUG_LOG_FILTER_LOG_ALL, status);
+
+	debug_log_filter_release (&filter);
+}
+
+static void debug_log_filter_test_static_init_null (CuTest *test)
+{
+	struct debug_log_filter_state state;
+	struct debug_log_filter_bucket buckets[8];
+	struct debug_log_filter null_state = debug_log_filter_static_init (NULL, buckets, 8, 4, 100);
+	struct debug_log_filter null_buckets = debug_log_filter_static_init (&state, NULL, 8, 4, 100);
+	struct debug_log_filter zero_buckets = debug_log_filter_static_init (&state, buckets, 0, 4,
+		100);
+	struct debug_log_filter zero_refill = debug_log_filter_static_init (&state, buckets, 8, 4, 0);
+	int status;
+
+	TEST_START;
+
+	status = debug_log_filter_init_state (NULL);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = debug_log_filter_init_state (&null_state);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = debug_log_filter_init_state (&null_buckets);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = debug_log_filter_init_state (&zero_buckets);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = debug_log_filter_init_state (&zero_refill);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+}
+
+static void debug_log_filter_test_release_null (CuTest *test)
+{
+	TEST_START;
+
+	debug_log_filter_release (NULL);
+}
+
+static void debug_log_filter_test_set_threshold (CuTest *test)
+{
+	struct debug_log_filter filter;
+	struct debug_log_filter_state state;
+	int status;
+
+	TEST_START;
+
+	status = debug_log_filter_init (&filter, &state, NULL, 0, 0, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = debug_log_filter_set_threshold (&filter, DEBUG_LOG_COMPONENT_MCTP,
+		DEBUG_LOG_SEVERITY_INFO);
+	CuAssertIntEquals (test, 0, status);
+
+	status = debug_log_filter_set_threshold (&filter, 0xff, DEBUG_LOG_FILTER_LOG_NONE);
+	CuAssertIntEquals (test, 0, status);
+
+	status = debug_log_filter_get_threshold (&filter, DEBUG_LOG_COMPONENT_MCTP);
+	CuAssertIntEquals (test, DEBUG_LOG_SEVERITY_INFO, status);
+
+	status = debug_log_filter_get_threshold (&filter, 0xff);
+	CuAssertIntEquals (test, DEBUG_LOG_FILTER_LOG_NONE, status);
+
+	status = debug_log_filter_get_threshold (&filter, DEBUG_LOG_COMPONENT_TPM);
+	CuAssertIntEquals (test, DEBUG_LOG_FILTER_LOG_ALL, status);
+
+	debug_log_filter_release (&filter);
+}
+
+static void debug_log_filter_test_set_threshold_null (CuTest *test)
+{
+	struct debug_log_filter filter;
+	struct debug_log_filter_state state;
+	int status;
+
+	TEST_START;
+
+	status = debug_log_filter_init (&filter, &state, NULL, 0, 0, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = debug_log_filter_set_threshold (NULL, DEBUG_LOG_COMPONENT_MCTP,
+		DEBUG_LOG_SEVERITY_INFO);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = debug_log_filter_set_threshold (&filter, DEBUG_LOG_COMPONENT_MCTP,
+		DEBUG_LOG_FILTER_LOG_ALL + 1);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = debug_log_filter_get_threshold (&filter, DEBUG_LOG_COMPONENT_MCTP);
+	CuAssertIntEquals (test, DEBUG_LOG_FILTER_LOG_ALL, status);
+
+	debug_log_filter_release (&filter);
+}
+
+static void debug_log_filter_test_set_all_thresholds (CuTest *test)
+{
+	struct debug_log_filter filter;
+	struct debug_log_filter_state state;
+	int status;
+	int i;
+
+	TEST_START;
+
+	status = debug_log_filter_init (&filter, &state, NULL, 0, 0, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = debug_log_filter_set_all_thresholds (&filter, DEBUG_LOG_SEVERITY_WARNING);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < DEBUG_LOG_FILTER_NUM_COMPONENTS; i++) {
+		status = debug_log_filter_get_threshold (&filter, i);
+		CuAssertIntEquals (test, DEBUG_LOG_SEVERITY_WARNING, status);
+	}
+
+	debug_log_filter_release (&filter);
+}
+
+static void debug_log_filter_test_set_all_thresholds_null (CuTest *test)
+{
+	struct debug_log_filter filter;
+	struct debug_log_filter_state state;
+	int status;
+
+	TEST_START;
+
+	status = debug_log_filter_init (&filter, &state, NULL, 0, 0, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = debug_log_filter_set_all_thresholds (NULL, DEBUG_LOG_SEVERITY_WARNING);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = debug_log_filter_set_all_thresholds (&filter, DEBUG_LOG_FILTER_LOG_ALL + 1);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	debug_log_filter_release (&filter);
+}
+
+static void debug_log_filter_test_get_threshold_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = debug_log_filter_get_threshold (NULL, DEBUG_LOG_COMPONENT_MCTP);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+}
+
+static void debug_log_filter_test_allow_entry_threshold (CuTest *test)
+{
+	struct debug_log_filter filter;
+	struct debug_log_filter_state state;
+	struct debug_log_filter_summary summary;
+	struct debug_log_filter_stats stats;
+	int status;
+	bool allow;
+
+	TEST_START;
+
+	status = debug_log_filter_init (&filter, &state, NULL, 0, 0, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = debug_log_filter_set_threshold (&filter, DEBUG_LOG_COMPONENT_MCTP,
+		DEBUG_LOG_SEVERITY_INFO);
+	CuAssertIntEquals (test, 0, status);
+
+	allow = debug_log_filter_allow_entry (&filter, DEBUG_LOG_SEVERITY_ERROR,
+		DEBUG_LOG_COMPONENT_MCTP, 1, 0, &summary);
+	CuAssertIntEquals (test, true, allow);
+	CuAssertIntEquals (test, 0, summary.count);
+
+	allow = debug_log_filter_allow_entry (&filter, DEBUG_LOG_SEVERITY_WARNING,
+		DEBUG_LOG_COMPONENT_MCTP, 1, 0, &summary);
+	CuAssertIntEquals (test, true, allow);
+	CuAssertIntEquals (test, 0, summary.count);
+
+	allow = debug_log_filter_allow_entry (&filter, DEBUG_LOG_SEVERITY_INFO,
+		DEBUG_LOG_COMPONENT_MCTP, 1, 0, &summary);
+	CuAssertIntEquals (test, false, allow);
+	CuAssertIntEquals (test, 0, summary.count);
+
+	allow = debug_log_filter_allow_entry (&filter, DEBUG_LOG_SEVERITY_INFO,
+		DEBUG_LOG_COMPONENT_TPM, 1, 0, &summary);
+	CuAssertIntEquals (test, true, allow);
+	CuAssertIntEquals (test, 0, summary.count);
+
+	status = debug_log_filter_get_stats (&filter, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, stats.filtered);
+	CuAssertIntEquals (test, 0, stats.suppressed);
+
+	debug_log_filter_release (&filter);
+}
+
+static void debug_log_filter_test_allow_entry_threshold_none (CuTest *test)
+{
+	struct debug_log_filter filter;
+	struct debug_log_filter_state state;
+	struct debug_log_filter_summary summary;
+	struct debug_log_filter_stats stats;
+	int status;
+	bool allow;
+
+	TEST_START;
+
+	status = debug_log_filter_init (&filter, &state, NULL, 0, 0, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = debug_log_filter_set_threshold (&filter, DEBUG_LOG_COMPONENT_DEVICE_SPECIFIC,
+		DEBUG_LOG_FILTER_LOG_NONE);
+	CuAssertIntEquals (test, 0, status);
+
+	allow = debug_log_filter_allow_entry (&filter, DEBUG_LOG_SEVERITY_ERROR,
+		DEBUG_LOG_COMPONENT_DEVICE_SPECIFIC, 1, 0, &summary);
+	CuAssertIntEquals (test, false, allow);
+
+	allow = debug_log_filter_allow_entry (&filter, DEBUG_LOG_SEVERITY_WARNING,
+		DEBUG_LOG_COMPONENT_DEVICE_SPECIFIC, 1, 0, &summary);
+	CuAssertIntEquals (test, false, allow);
+
+	allow = debug_log_filter_allow_entry (&filter, DEBUG_LOG_SEVERITY_INFO,
+		DEBUG_LOG_COMPONENT_DEVICE_SPECIFIC, 1, 0, &summary);
+	CuAssertIntEquals (test, false, allow);
+
+	status = debug_log_filter_get_stats (&filter, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 3, stats.filtered);
+	CuAssertIntEquals (test, 0, stats.suppressed);
+
+	debug_log_filter_release (&filter);
+}
+
+static void debug_log_filter_test_allow_entry_rate_limit (CuTest *test)
+{
+	struct debug_log_filter filter;
+	struct debug_log_filter_state state;
+	struct debug_log_filter_bucket buckets[8];
+	struct debug_log_filter_summary summary;
+	struct debug_log_filter_stats stats;
+	int status;
+	bool allow;
+	int i;
+
+	TEST_START;
+
+	status = debug_log_filter_init (&filter, &state, buckets, 8, 3, 100);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 3; i++) {
+		allow = debug_log_filter_allow_entry (&filter, DEBUG_LOG_SEVERITY_WARNING,
+			DEBUG_LOG_COMPONENT_MCTP, 5, 1000, &summary);
+		CuAssertIntEquals (test, true, allow);
+		CuAssertIntEquals (test, 0, summary.count);
+	}
+
+	for (i = 0; i < 10; i++) {
+		allow = debug_log_filter_allow_entry (&filter, DEBUG_LOG_SEVERITY_WARNING,
+			DEBUG_LOG_COMPONENT_MCTP, 5, 1050, &summary);
+		CuAssertIntEquals (test, false, allow);
+		CuAssertIntEquals (test, 0, summary.count);
+	}
+
+	/* A different message from the same component is tracked separately. */
+	allow = debug_log_filter_allow_entry (&filter, DEBUG_LOG_SEVERITY_WARNING,
+		DEBUG_LOG_COMPONENT_MCTP, 6, 1050, &summary);
+	CuAssertIntEquals (test, true, allow);
+	CuAssertIntEquals (test, 0, summary.count);
+
+	status = debug_log_filter_get_stats (&filter, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, stats.filtered);
+	CuAssertIntEquals (test, 10, stats.suppressed);
+
+	debug_log_filter_release (&filter);
+}
+
+static void debug_log_filter_test_allow_entry_rate_limit_refill (CuTest *test)
+{
+	struct debug_log_filter filter;
+	struct debug_log_filter_state state;
+	struct debug_log_filter_bucket buckets[8];
+	struct debug_log_filter_summary summary;
+	int status;
+	bool allow;
+	int i;
+
+	TEST_START;
+
+	status = debug_log_filter_init (&filter, &state, buckets, 8, 2, 100);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 2; i++) {
+		allow = debug_log_filter_allow_entry (&filter, DEBUG_LOG_SEVERITY_ERROR,
+			DEBUG_LOG_COMPONENT_MCTP, 5, 1000, &summary);
+		CuAssertIntEquals (test, true, allow);
+	}
+
+	for (i = 0; i < 4; i++) {
+		allow = debug_log_filter_allow_entry (&filter, DEBUG_LOG_SEVERITY_INFO,
+			DEBUG_LOG_COMPONENT_MCTP, 5, 1099, &summary);
+		CuAssertIntEquals (test, false, allow);
+	}
+
+	/* One token is added after the refill time, with a summary of the suppressed entries. */
+	allow = debug_log_filter_allow_entry (&filter, DEBUG_LOG_SEVERITY_ERROR,
+		DEBUG_LOG_COMPONENT_MCTP, 5, 1150, &summary);
+	CuAssertIntEquals (test, true, allow);
+	CuAssertIntEquals (test, 4, summary.count);
+	CuAssertIntEquals (test, DEBUG_LOG_SEVERITY_INFO, summary.severity);
+	CuAssertIntEquals (test, DEBUG_LOG_COMPONENT_MCTP, summary.component);
+	CuAssertIntEquals (test, 5, summary.msg_index);
+
+	allow = debug_log_filter_allow_entry (&filter, DEBUG_LOG_SEVERITY_ERROR,
+		DEBUG_LOG_COMPONENT_MCTP, 5, 1199, &summary);
+	CuAssertIntEquals (test, false, allow);
+
+	/* The partial refill period is not lost. */
+	allow = debug_log_filter_allow_entry (&filter, DEBUG_LOG_SEVERITY_ERROR,
+		DEBUG_LOG_COMPONENT_MCTP, 5, 1200, &summary);
+	CuAssertIntEquals (test, true, allow);
+	CuAssertIntEquals (test, 1, summary.count);
+	CuAssertIntEquals (test, DEBUG_LOG_SEVERITY_ERROR, summary.severity);
+
+	/* A long idle time only refills up to the burst size. */
+	for (i = 0; i < 2; i++) {
+		allow = debug_log_filter_allow_entry (&filter, DEBUG_LOG_SEVERITY_ERROR,
+			DEBUG_LOG_COMPONENT_MCTP, 5, 100000, &summary);
+		CuAssertIntEquals (test, true, allow);
+		CuAssertIntEquals (test, 0, summary.count);
+	}
+
+	allow = debug_log_filter_allow_entry (&filter, DEBUG_LOG_SEVERITY_ERROR,
+		DEBUG_LOG_COMPONENT_MCTP, 5, 100000, &summary);
+	CuAssertIntEquals (test, false, allow);
+
+	debug_log_filter_release (&filter);
+}
+
+static void debug_log_filter_test_allow_entry_rate_limit_most_severe (CuTest *test)
+{
+	struct debug_log_filter filter;
+	struct debug_log_filter_state state;
+	struct debug_log_filter_bucket buckets[8];
+	struct debug_log_filter_summary summary;
+	int status;
+	bool allow;
+
+	TEST_START;
+
+	status = debug_log_filter_init (&filter, &state, buckets, 8, 1, 100);
+	CuAssertIntEquals (test, 0, status);
+
+	allow = debug_log_filter_allow_entry (&filter, DEBUG_LOG_SEVERITY_INFO,
+		DEBUG_LOG_COMPONENT_CRYPTO, 2, 0, &summary);
+	CuAssertIntEquals (test, true, allow);
+
+	allow = debug_log_filter_allow_entry (&filter, DEBUG_LOG_SEVERITY_WARNING,
+		DEBUG_LOG_COMPONENT_CRYPTO, 2, 10, &summary);
+	CuAssertIntEquals (test, false, allow);
+
+	allow = debug_log_filter_allow_entry (&filter, DEBUG_LOG_SEVERITY_ERROR,
+		DEBUG_LOG_COMPONENT_CRYPTO, 2, 20, &summary);
+	CuAssertIntEquals (test, false, allow);
+
+	allow = debug_log_filter_allow_entry (&filter, DEBUG_LOG_SEVERITY_INFO,
+		DEBUG_LOG_COMPONENT_CRYPTO, 2, 30, &summary);
+	CuAssertIntEquals (test, false, allow);
+
+	allow = debug_log_filter_allow_entry (&filter, DEBUG_LOG_SEVERITY_INFO,
+		DEBUG_LOG_COMPONENT_CRYPTO, 2, 100, &summary);
+	CuAssertIntEquals (test, true, allow);
+	CuAssertIntEquals (test, 3, summary.count);
+	CuAssertIntEquals (test, DEBUG_LOG_SEVERITY_ERROR, summary.severity);
+
+	debug_log_filter_release (&filter);
+}
+
+static void debug_log_filter_test_allow_entry_rate_limit_filtered_not_counted (CuTest *test)
+{
+	struct debug_log_filter filter;
+	struct debug_log_filter_state state;
+	struct debug_log_filter_bucket buckets[8];
+	struct debug_log_filter_summary summary;
+	struct debug_log_filter_stats stats;
+	int status;
+	bool allow;
+	int i;
+
+	TEST_START;
+
+	status = debug_log_filter_init (&filter, &state, buckets, 8, 1, 100);
+	CuAssertIntEquals (test, 0, status);
+
+	status = debug_log_filter_set_threshold (&filter, DEBUG_LOG_COMPONENT_MCTP,
+		DEBUG_LOG_SEVERITY_INFO);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Entries dropped by the threshold don't use any rate limiting tokens. */
+	for (i = 0; i < 5; i++) {
+		allow = debug_log_filter_allow_entry (&filter, DEBUG_LOG_SEVERITY_INFO,
+			DEBUG_LOG_COMPONENT_MCTP, 5, 0, &summary);
+		CuAssertIntEquals (test, false, allow);
+	}
+
+	allow = debug_log_filter_allow_entry (&filter, DEBUG_LOG_SEVERITY_WARNING,
+		DEBUG_LOG_COMPONENT_MCTP, 5, 0, &summary);
+	CuAssertIntEquals (test, true, allow);
+	CuAssertIntEquals (test, 0, summary.count);
+
+	status = debug_log_filter_get_stats (&filter, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 5, stats.filtered);
+	CuAssertIntEquals (test, 0, stats.suppressed);
+
+	debug_log_filter_release (&filter);
+}
+
+static void debug_log_filter_test_allow_entry_bucket_eviction (CuTest *test)
+{
+	struct debug_log_filter filter;
+	struct debug_log_filter_state state;
+	struct debug_log_filter_bucket buckets[1];
+	struct debug_log_filter_summary summary;
+	int status;
+	bool allow;
+	int i;
+
+	TEST_START;
+
+	status = debug_log_filter_init (&filter, &state, buckets, 1, 1, 1000);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 3; i++) {
+		allow = debug_log_filter_allow_entry (&filter, DEBUG_LOG_SEVERITY_WARNING,
+			DEBUG_LOG_COMPONENT_SPI_FILTER, 7, 0, &summary);
+		CuAssertIntEquals (test, (i == 0), allow);
+	}
+
+	/* A new entry type takes over the bucket and reports the previous entry type. */
+	allow = debug_log_filter_allow_entry (&filter, DEBUG_LOG_SEVERITY_ERROR,
+		DEBUG_LOG_COMPONENT_FLASH, 1, 10, &summary);
+	CuAssertIntEquals (test, true, allow);
+	CuAssertIntEquals (test, 2, summary.count);
+	CuAssertIntEquals (test, DEBUG_LOG_SEVERITY_WARNING, summary.severity);
+	CuAssertIntEquals (test, DEBUG_LOG_COMPONENT_SPI_FILTER, summary.component);
+	CuAssertIntEquals (test, 7, summary.msg_index);
+
+	/* The evicted entry type starts over with a full bucket. */
+	allow = debug_log_filter_allow_entry (&filter, DEBUG_LOG_SEVERITY_WARNING,
+		DEBUG_LOG_COMPONENT_SPI_FILTER, 7, 20, &summary);
+	CuAssertIntEquals (test, true, allow);
+	CuAssertIntEquals (test, 0, summary.count);
+
+	debug_log_filter_release (&filter);
+}
+
+static void debug_log_filter_test_allow_entry_no_rate_limit (CuTest *test)
+{
+	struct debug_log_filter filter;
+	struct debug_log_filter_state state;
+	struct debug_log_filter_summary summary;
+	int status;
+	bool allow;
+	int i;
+
+	TEST_START;
+
+	status = debug_log_filter_init (&filter, &state, NULL, 0, 0, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 100; i++) {
+		allow = debug_log_filter_allow_entry (&filter, DEBUG_LOG_SEVERITY_ERROR,
+			DEBUG_LOG_COMPONENT_MCTP, 5, 0, &summary);
+		CuAssertIntEquals (test, true, allow);
+		CuAssertIntEquals (test, 0, summary.count);
+	}
+
+	debug_log_filter_release (&filter);
+}
+
+static void debug_log_filter_test_allow_entry_null (CuTest *test)
+{
+	struct debug_log_filter filter;
+	struct debug_log_filter_state state;
+	struct debug_log_filter_summary summary;
+	int status;
+	bool allow;
+
+	TEST_START;
+
+	status = debug_log_filter_init (&filter, &state, NULL, 0, 0, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = debug_log_filter_set_all_thresholds (&filter, DEBUG_LOG_FILTER_LOG_NONE);
+	CuAssertIntEquals (test, 0, status);
+
+	allow = debug_log_filter_allow_entry (NULL, DEBUG_LOG_SEVERITY_ERROR,
+		DEBUG_LOG_COMPONENT_MCTP, 5, 0, &summary);
+	CuAssertIntEquals (test, true, allow);
+
+	allow = debug_log_filter_allow_entry (&filter, DEBUG_LOG_SEVERITY_ERROR,
+		DEBUG_LOG_COMPONENT_MCTP, 5, 0, NULL);
+	CuAssertIntEquals (test, true, allow);
+
+	debug_log_filter_release (&filter);
+}
+
+static void debug_log_filter_test_get_suppressed (CuTest *test)
+{
+	struct debug_log_filter filter;
+	struct debug_log_filter_state state;
+	struct debug_log_filter_bucket buckets[16];
+	struct debug_log_filter_summary summary;
+	bool found_mctp = false;
+	bool found_tpm = false;
+	int status;
+	bool allow;
+	int i;
+
+	TEST_START;
+
+	status = debug_log_filter_init (&filter, &state, buckets, 16, 1, 1000);
+	CuAssertIntEquals (test, 0, status);
+
+	allow = debug_log_filter_get_suppressed (&filter, &summary);
+	CuAssertIntEquals (test, false, allow);
+
+	for (i = 0; i < 4; i++) {
+		debug_log_filter_allow_entry (&filter, DEBUG_LOG_SEVERITY_WARNING,
+			DEBUG_LOG_COMPONENT_MCTP, 5, 0, &summary);
+	}
+
+	for (i = 0; i < 3; i++) {
+		debug_log_filter_allow_entry (&filter, DEBUG_LOG_SEVERITY_ERROR, DEBUG_LOG_COMPONENT_TPM,
+			2, 0, &summary);
+	}
+
+	/* No suppressed entries for this type. */
+	debug_log_filter_allow_entry (&filter, DEBUG_LOG_SEVERITY_ERROR, DEBUG_LOG_COMPONENT_CRYPTO, 2,
+		0, &summary);
+
+	for (i = 0; i < 2; i++) {
+		allow = debug_log_filter_get_suppressed (&filter, &summary);
+		CuAssertIntEquals (test, true, allow);
+
+		if (summary.component == DEBUG_LOG_COMPONENT_MCTP) {
+			CuAssertIntEquals (test, 5, summary.msg_index);
+			CuAssertIntEquals (test, 3, summary.count);
+			CuAssertIntEquals (test, DEBUG_LOG_SEVERITY_WARNING, summary.severity);
+			found_mctp = true;
+		}
+		else {
+			CuAssertIntEquals (test, DEBUG_LOG_COMPONENT_TPM, summary.component);
+			CuAssertIntEquals (test, 2, summary.msg_index);
+			CuAssertIntEquals (test, 2, summary.count);
+			CuAssertIntEquals (test, DEBUG_LOG_SEVERITY_ERROR, summary.severity);
+			found_tpm = true;
+		}
+	}
+
+	CuAssertIntEquals (test, true, found_mctp);
+	CuAssertIntEquals (test, true, found_tpm);
+
+	allow = debug_log_filter_get_suppressed (&filter, &summary);
+	CuAssertIntEquals (test, false, allow);
+
+	/* Entries that have been reported are not reported again when the type is allowed. */
+	allow = debug_log_filter_allow_entry (&filter, DEBUG_LOG_SEVERITY_WARNING,
+		DEBUG_LOG_COMPONENT_MCTP, 5, 1000, &summary);
+	CuAssertIntEquals (test, true, allow);
+	CuAssertIntEquals (test, 0, summary.count);
+
+	debug_log_filter_release (&filter);
+}
+
+static void debug_log_filter_test_get_suppressed_no_rate_limit (CuTest *test)
+{
+	struct debug_log_filter filter;
+	struct debug_log_filter_state state;
+	struct debug_log_filter_summary summary;
+	int status;
+	bool found;
+
+	TEST_START;
+
+	status = debug_log_filter_init (&filter, &state, NULL, 0, 0, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	found = debug_log_filter_get_suppressed (&filter, &summary);
+	CuAssertIntEquals (test, false, found);
+
+	debug_log_filter_release (&filter);
+}
+
+static void debug_log_filter_test_get_suppressed_null (CuTest *test)
+{
+	struct debug_log_filter filter;
+	struct debug_log_filter_state state;
+	struct debug_log_filter_bucket buckets[8];
+	struct debug_log_filter_summary summary;
+	int status;
+	bool found;
+
+	TEST_START;
+
+	status = debug_log_filter_init (&filter, &state, buckets, 8, 1, 100);
+	CuAssertIntEquals (test, 0, status);
+
+	found = debug_log_filter_get_suppressed (NULL, &summary);
+	CuAssertIntEquals (test, false, found);
+
+	found = debug_log_filter_get_suppressed (&filter, NULL);
+	CuAssertIntEquals (test, false, found);
+
+	debug_log_filter_release (&filter);
+}
+
+static void debug_log_filter_test_get_stats_null (CuTest *test)
+{
+	struct debug_log_filter filter;
+	struct debug_log_filter_state state;
+	struct debug_log_filter_stats stats;
+	int status;
+
+	TEST_START;
+
+	status = debug_log_filter_init (&filter, &state, NULL, 0, 0, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = debug_log_filter_get_stats (NULL, &stats);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = debug_log_filter_get_stats (&filter, NULL);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	debug_log_filter_release (&filter);
+}
+
+
+TEST_SUITE_START (debug_log_filter);
+
+TEST (debug_log_filter_test_init);
+TEST (debug_log_filter_test_init_no_rate_limit);
+TEST (debug_log_filter_test_init_null);
+TEST (debug_log_filter_test_static_init);
+TEST (debug_log_filter_test_static_init_null);
+TEST (debug_log_filter_test_release_null);
+TEST (debug_log_filter_test_set_threshold);
+TEST (debug_log_filter_test_set_threshold_null);
+TEST (debug_log_filter_test_set_all_thresholds);
+TEST (debug_log_filter_test_set_all_thresholds_null);
+TEST (debug_log_filter_test_get_threshold_null);
+TEST (debug_log_filter_test_allow_entry_threshold);
+TEST (debug_log_filter_test_allow_entry_threshold_none);
+TEST (debug_log_filter_test_allow_entry_rate_limit);
+TEST (debug_log_filter_test_allow_entry_rate_limit_refill);
+TEST (debug_log_filter_test_allow_entry_rate_limit_most_severe);
+TEST (debug_log_filter_test_allow_entry_rate_limit_filtered_not_counted);
+TEST (debug_log_filter_test_allow_entry_bucket_eviction);
+TEST (debug_log_filter_test_allow_entry_no_rate_limit);
+TEST (debug_log_filter_test_allow_entry_null);
+TEST (debug_log_filter_test_get_suppressed);
+TEST (debug_log_filter_test_get_suppressed_no_rate_limit);
+TEST (debug_log_filter_test_get_suppressed_null);
+TEST (debug_log_filter_test_get_stats_null);
+
+TEST_SUITE_END;
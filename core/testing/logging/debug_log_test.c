@@ -8,6 +8,8 @@
 #include "platform_api.h"
 #include "testing.h"
 #include "logging/debug_log.h"
+#include "logging/debug_log_filter.h"
+#include "system/system_logging.h"
 #include "testing/mock/logging/logging_mock.h"
 #include "testing/logging/debug_log_testing.h"
 
@@ -55,6 +57,9 @@ static void complete_debug_log_mock_test (CuTest *test, struct logging_mock *log
 static void debug_log_testing_suite_tear_down (CuTest *test)
 {
 	debug_log = NULL;
+#ifdef LOGGING_SUPPORT_DEBUG_LOG_FILTER
+	debug_log_filter = NULL;
+#endif
 }
 
 /*******************
@@ -116,6 +121,117 @@ static void debug_log_test_create_entry_invalid_severity (CuTest *test)
 	complete_debug_log_mock_test (test, &logger);
 }
 
+#ifdef LOGGING_SUPPORT_DEBUG_LOG_FILTER
+static void debug_log_test_create_entry_filter_threshold (CuTest *test)
+{
+	struct logging_mock logger;
+	struct debug_log_filter filter;
+	struct debug_log_filter_state state;
+	struct debug_log_entry_info entry = {
+		.format = 1,
+		.severity = DEBUG_LOG_SEVERITY_WARNING,
+		.component = DEBUG_LOG_COMPONENT_MCTP,
+		.msg_index = 3,
+		.arg1 = 4,
+		.arg2 = 5
+	};
+	int status;
+
+	TEST_START;
+
+	setup_debug_log_mock_test (test, &logger);
+
+	status = debug_log_filter_init (&filter, &state, NULL, 0, 0, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = debug_log_filter_set_threshold (&filter, DEBUG_LOG_COMPONENT_MCTP,
+		DEBUG_LOG_SEVERITY_INFO);
+	CuAssertIntEquals (test, 0, status);
+
+	debug_log_filter = &filter;
+
+	status = mock_expect (&logger.mock, logger.base.create_entry, &logger, 0,
+		MOCK_ARG_PTR_CONTAINS (&entry, LOG_ENTRY_SIZE_TIME_FIELD_NOT_INCLUDED),
+		MOCK_ARG (sizeof (entry)));
+	CuAssertIntEquals (test, 0, status);
+
+	status = debug_log_create_entry (DEBUG_LOG_SEVERITY_WARNING, DEBUG_LOG_COMPONENT_MCTP, 3, 4,
+		5);
+	CuAssertIntEquals (test, 0, status);
+
+	status = debug_log_create_entry (DEBUG_LOG_SEVERITY_INFO, DEBUG_LOG_COMPONENT_MCTP, 3, 4, 5);
+	CuAssertIntEquals (test, 0, status);
+
+	debug_log_filter = NULL;
+	debug_log_filter_release (&filter);
+
+	complete_debug_log_mock_test (test, &logger);
+}
+
+static void debug_log_test_create_entry_filter_rate_limit (CuTest *test)
+{
+	struct logging_mock logger;
+	struct debug_log_filter filter;
+	struct debug_log_filter_state state;
+	struct debug_log_filter_bucket buckets[4];
+	struct debug_log_entry_info entry = {
+		.format = 1,
+		.severity = DEBUG_LOG_SEVERITY_ERROR,
+		.component = DEBUG_LOG_COMPONENT_MCTP,
+		.msg_index = 3,
+		.arg1 = 4,
+		.arg2 = 5
+	};
+	struct debug_log_entry_info repeated = {
+		.format = 1,
+		.severity = DEBUG_LOG_SEVERITY_ERROR,
+		.component = DEBUG_LOG_COMPONENT_SYSTEM,
+		.msg_index = SYSTEM_LOGGING_ENTRIES_SUPPRESSED,
+		.arg1 = (DEBUG_LOG_COMPONENT_MCTP << 8) | 3,
+		.arg2 = 8
+	};
+	int status;
+	int i;
+
+	TEST_START;
+
+	setup_debug_log_mock_test (test, &logger);
+
+	status = debug_log_filter_init (&filter, &state, buckets, 4, 2, 1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	debug_log_filter = &filter;
+
+	status = mock_expect (&logger.mock, logger.base.create_entry, &logger, 0,
+		MOCK_ARG_PTR_CONTAINS (&entry, LOG_ENTRY_SIZE_TIME_FIELD_NOT_INCLUDED),
+		MOCK_ARG (sizeof (entry)));
+	status |= mock_expect (&logger.mock, logger.base.create_entry, &logger, 0,
+		MOCK_ARG_PTR_CONTAINS (&entry, LOG_ENTRY_SIZE_TIME_FIELD_NOT_INCLUDED),
+		MOCK_ARG (sizeof (entry)));
+
+	/* The suppressed entries are reported as a single entry when the log is flushed. */
+	status |= mock_expect (&logger.mock, logger.base.create_entry, &logger, 0,
+		MOCK_ARG_PTR_CONTAINS (&repeated, LOG_ENTRY_SIZE_TIME_FIELD_NOT_INCLUDED),
+		MOCK_ARG (sizeof (repeated)));
+	status |= mock_expect (&logger.mock, logger.base.flush, &logger, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 10; i++) {
+		status = debug_log_create_entry (DEBUG_LOG_SEVERITY_ERROR, DEBUG_LOG_COMPONENT_MCTP, 3, 4,
+			5);
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	status = debug_log_flush ();
+	CuAssertIntEquals (test, 0, status);
+
+	debug_log_filter = NULL;
+	debug_log_filter_release (&filter);
+
+	complete_debug_log_mock_test (test, &logger);
+}
+#endif
+
 static void debug_log_test_flush (CuTest *test)
 {
 	struct logging_mock logger;
@@ -245,6 +361,10 @@ TEST_SUITE_START (debug_log);
 TEST (debug_log_test_create_entry);
 TEST (debug_log_test_create_entry_no_log);
 TEST (debug_log_test_create_entry_invalid_severity);
+#ifdef LOGGING_SUPPORT_DEBUG_LOG_FILTER
+TEST (debug_log_test_create_entry_filter_threshold);
+TEST (debug_log_test_create_entry_filter_rate_limit);
+#endif
 TEST (debug_log_test_flush);
 TEST (debug_log_test_flush_no_log);
 TEST (debug_log_test_clear);
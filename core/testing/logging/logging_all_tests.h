@@ -27,6 +27,12 @@ static void add_all_logging_tests (CuSuite *suite)
 	!defined TESTING_SKIP_DEBUG_LOG_SUITE
 	TESTING_RUN_SUITE (debug_log);
 #endif
+#if (defined TESTING_RUN_DEBUG_LOG_FILTER_SUITE || \
+		defined TESTING_RUN_ALL_TESTS || defined TESTING_RUN_ALL_CORE_TESTS || \
+		(!defined TESTING_SKIP_ALL_TESTS && !defined TESTING_SKIP_ALL_CORE_TESTS)) && \
+	!defined TESTING_SKIP_DEBUG_LOG_FILTER_SUITE
+	TESTING_RUN_SUITE (debug_log_filter);
+#endif
 #if (defined TESTING_RUN_LOG_FLUSH_HANDLER_SUITE || \
 		defined TESTING_RUN_ALL_TESTS || defined TESTING_RUN_ALL_CORE_TESTS || \
 		(!defined TESTING_SKIP_ALL_TESTS && !defined TESTING_SKIP_ALL_CORE_TESTS)) && \
@@ -45,6 +51,12 @@ static void add_all_logging_tests (CuSuite *suite)
 	!defined TESTING_SKIP_LOGGING_MEMORY_SUITE
 	TESTING_RUN_SUITE (logging_memory);
 #endif
+#if (defined TESTING_RUN_LOGGING_MEMORY_LOCKFREE_SUITE || \
+		defined TESTING_RUN_ALL_TESTS || defined TESTING_RUN_ALL_CORE_TESTS || \
+		(!defined TESTING_SKIP_ALL_TESTS && !defined TESTING_SKIP_ALL_CORE_TESTS)) && \
+	!defined TESTING_SKIP_LOGGING_MEMORY_LOCKFREE_SUITE
+	TESTING_RUN_SUITE (logging_memory_lockfree);
+#endif
 }
 
 
@@ -18311,6 +18311,271 @@ static void logging_flash_test_read_contents_full_buffer_flush_after_incomplete_
 	spi_flash_release (&flash);
 }
 
+static void logging_flash_test_read_contents_sequential_reads (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct spi_flash_state flash_state;
+	struct spi_flash flash;
+	struct logging_flash_state state;
+	struct logging_flash logging;
+	int status;
+	uint8_t log_full[LOGGING_FLASH_SECTORS][FLASH_SECTOR_SIZE];
+	const int entry_size = 16 - sizeof (struct logging_entry_header);
+	const int entry_len = entry_size + sizeof (struct logging_entry_header);
+	const int entry_count = FLASH_SECTOR_SIZE / entry_len;
+	const int entry_full = entry_len * entry_count;
+	const int entry_empty = FLASH_SECTOR_SIZE - entry_full;
+	const int full_size = entry_full * LOGGING_FLASH_SECTORS;
+	const int chunk = 1000;
+	struct logging_entry_header *entry;
+	int i;
+	int j;
+	int offset;
+	int read_len;
+	int sector;
+	int sector_offset;
+	int piece;
+	uint8_t expected[LOGGING_FLASH_SECTORS * FLASH_SECTOR_SIZE];
+	uint8_t output[LOGGING_FLASH_SECTORS * FLASH_SECTOR_SIZE];
+
+	TEST_START;
+
+	CuAssertIntEquals (test, 0, entry_empty);
+
+	memset (log_full, 0xff, sizeof (log_full));
+
+	for (j = 0; j < 8; ++j) {
+		for (i = 0; i < entry_count; ++i) {
+			entry = (struct logging_entry_header*) &log_full[j][i * entry_len];
+			entry->log_magic = 0xCB;
+			entry->length = entry_len;
+			entry->entry_id = (LOGGING_FLASH_SECTORS * entry_count) + i +
+				(j * entry_count);
+		}
+	}
+
+	for (j = 8; j < LOGGING_FLASH_SECTORS; ++j) {
+		for (i = 0; i < entry_count; ++i) {
+			entry = (struct logging_entry_header*) &log_full[j][i * entry_len];
+			entry->log_magic = 0xCB;
+			entry->length = entry_len;
+			entry->entry_id = i + (j * entry_count);
+		}
+	}
+
+	for (j = 0, i = 8; i < LOGGING_FLASH_SECTORS; ++j, ++i) {
+		memcpy (&expected[entry_full * j], log_full[i], entry_full);
+	}
+	for (i = 0; i < 8; ++j, ++i) {
+		memcpy (&expected[entry_full * j], log_full[i], entry_full);
+	}
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_state, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 16; ++i) {
+		status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+			FLASH_EXP_READ_STATUS_REG);
+		status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, log_full[i], FLASH_SECTOR_SIZE,
+			FLASH_EXP_READ_CMD (0x03, 0x10000 + (i * FLASH_SECTOR_SIZE), 0, -1, FLASH_SECTOR_SIZE));
+	}
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_flash_init (&logging, &state, &flash, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, full_size, status);
+
+	status = mock_validate (&flash_mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	for (offset = 0; offset < full_size; offset += chunk) {
+		read_len = ((full_size - offset) < chunk) ? (full_size - offset) : chunk;
+
+		status = 0;
+		for (i = 0; i < read_len; i += piece) {
+			sector = (((offset + i) / entry_full) + 8) % LOGGING_FLASH_SECTORS;
+			sector_offset = (offset + i) % entry_full;
+			piece = entry_full - sector_offset;
+			if (piece > (read_len - i)) {
+				piece = read_len - i;
+			}
+
+			status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+				FLASH_EXP_READ_STATUS_REG);
+			status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0,
+				&log_full[sector][sector_offset], piece,
+				FLASH_EXP_READ_CMD (0x03, 0x10000 + (sector * FLASH_SECTOR_SIZE) + sector_offset,
+				0, -1, piece));
+		}
+
+		CuAssertIntEquals (test, 0, status);
+
+		status = logging.base.read_contents (&logging.base, offset, &output[offset], chunk);
+		CuAssertIntEquals (test, read_len, status);
+
+		status = mock_validate (&flash_mock.mock);
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	status = testing_validate_array (expected, output, full_size);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.read_contents (&logging.base, full_size, output, chunk);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_release (&logging);
+
+	spi_flash_release (&flash);
+}
+
+static void logging_flash_test_read_contents_non_sequential_reads (CuTest *test)
+{
+	struct flash_master_mock flash_mock;
+	struct spi_flash_state flash_state;
+	struct spi_flash flash;
+	struct logging_flash_state state;
+	struct logging_flash logging;
+	int status;
+	uint8_t log_full[LOGGING_FLASH_SECTORS][FLASH_SECTOR_SIZE];
+	const int entry_size = 16 - sizeof (struct logging_entry_header);
+	const int entry_len = entry_size + sizeof (struct logging_entry_header);
+	const int entry_count = FLASH_SECTOR_SIZE / entry_len;
+	const int entry_full = entry_len * entry_count;
+	const int entry_empty = FLASH_SECTOR_SIZE - entry_full;
+	const int full_size = entry_full * LOGGING_FLASH_SECTORS;
+	struct logging_entry_header *entry;
+	int i;
+	int j;
+	uint8_t output[entry_len * 2];
+
+	TEST_START;
+
+	CuAssertIntEquals (test, 0, entry_empty);
+
+	memset (log_full, 0xff, sizeof (log_full));
+
+	for (j = 0; j < 8; ++j) {
+		for (i = 0; i < entry_count; ++i) {
+			entry = (struct logging_entry_header*) &log_full[j][i * entry_len];
+			entry->log_magic = 0xCB;
+			entry->length = entry_len;
+			entry->entry_id = (LOGGING_FLASH_SECTORS * entry_count) + i +
+				(j * entry_count);
+		}
+	}
+
+	for (j = 8; j < LOGGING_FLASH_SECTORS; ++j) {
+		for (i = 0; i < entry_count; ++i) {
+			entry = (struct logging_entry_header*) &log_full[j][i * entry_len];
+			entry->log_magic = 0xCB;
+			entry->length = entry_len;
+			entry->entry_id = i + (j * entry_count);
+		}
+	}
+
+	status = flash_master_mock_init (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_init (&flash, &flash_state, &flash_mock.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_flash_set_device_size (&flash, 0x1000000);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 16; ++i) {
+		status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+			FLASH_EXP_READ_STATUS_REG);
+		status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, log_full[i], FLASH_SECTOR_SIZE,
+			FLASH_EXP_READ_CMD (0x03, 0x10000 + (i * FLASH_SECTOR_SIZE), 0, -1, FLASH_SECTOR_SIZE));
+	}
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging_flash_init (&logging, &state, &flash, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, full_size, status);
+
+	status = mock_validate (&flash_mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Read from the last sector in the log. */
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &log_full[7][entry_len],
+		sizeof (output), FLASH_EXP_READ_CMD (0x03, 0x17000 + entry_len, 0, -1, sizeof (output)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.read_contents (&logging.base, (entry_full * 15) + entry_len, output,
+		sizeof (output));
+	CuAssertIntEquals (test, sizeof (output), status);
+
+	status = testing_validate_array (&log_full[7][entry_len], output, status);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash_mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Read from the first sector in the log. */
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &log_full[8][entry_len],
+		sizeof (output), FLASH_EXP_READ_CMD (0x03, 0x18000 + entry_len, 0, -1, sizeof (output)));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.read_contents (&logging.base, entry_len, output, sizeof (output));
+	CuAssertIntEquals (test, sizeof (output), status);
+
+	status = testing_validate_array (&log_full[8][entry_len], output, status);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_validate (&flash_mock.mock);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Read from a sector in the middle of the log that wraps to the beginning of flash. */
+	status = flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0,
+		&log_full[15][entry_full - entry_len], entry_len,
+		FLASH_EXP_READ_CMD (0x03, 0x1f000 + entry_full - entry_len, 0, -1, entry_len));
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, &WIP_STATUS, 1,
+		FLASH_EXP_READ_STATUS_REG);
+	status |= flash_master_mock_expect_rx_xfer (&flash_mock, 0, log_full[0], entry_len,
+		FLASH_EXP_READ_CMD (0x03, 0x10000, 0, -1, entry_len));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.read_contents (&logging.base, (entry_full * 8) - entry_len, output,
+		sizeof (output));
+	CuAssertIntEquals (test, sizeof (output), status);
+
+	status = testing_validate_array (&log_full[15][entry_full - entry_len], output, entry_len);
+	status |= testing_validate_array (log_full[0], &output[entry_len], entry_len);
+	CuAssertIntEquals (test, 0, status);
+
+	status = flash_master_mock_validate_and_release (&flash_mock);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_flash_release (&logging);
+
+	spi_flash_release (&flash);
+}
+
 static void logging_flash_test_read_contents_static_init (CuTest *test)
 {
 	struct flash_master_mock flash_mock;
@@ -21761,6 +22026,8 @@ TEST (logging_flash_test_read_contents_full_buffer_flush_after_incomplete_flush)
 TEST (logging_flash_test_read_contents_full_buffer_flush_after_incomplete_flush_unused_bytes);
 TEST (logging_flash_test_read_contents_full_buffer_flush_after_incomplete_flush_unused_bytes_terminator);
 TEST (logging_flash_test_read_contents_full_buffer_flush_after_incomplete_flush_unused_bytes_terminator_large);
+TEST (logging_flash_test_read_contents_sequential_reads);
+TEST (logging_flash_test_read_contents_non_sequential_reads);
 TEST (logging_flash_test_read_contents_static_init);
 TEST (logging_flash_test_read_contents_null);
 TEST (logging_flash_test_read_contents_read_error);
@@ -0,0 +1,1157 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "platform_api.h"
+#include "testing.h"
+#include "logging/logging_memory_lockfree.h"
+#include "logging/logging_memory_lockfree_static.h"
+
+
+TEST_SUITE_LABEL ("logging_memory_lockfree");
+
+
+/**
+ * Generate the expected log contents for a range of entries.  Each entry will be filled with the
+ * lower byte of the entry ID.
+ *
+ * @param entry_data Output for the log contents.
+ * @param first ID of the first entry.
+ * @param count The number of entries to generate.
+ * @param entry_size Length of the entry data, not including the header.
+ */
+static void logging_memory_lockfree_testing_build_entries (uint8_t *entry_data, int first,
+	int count, int entry_size)
+{
+	struct logging_entry_header *header;
+	uint8_t *pos = entry_data;
+	int i;
+
+	for (i = first; i < (first + count); i++) {
+		header = (struct logging_entry_header*) pos;
+		header->log_magic = 0xCB;
+		header->length = entry_size + sizeof (struct logging_entry_header);
+		header->entry_id = i;
+		pos += sizeof (struct logging_entry_header);
+
+		memset (pos, i, entry_size);
+		pos += entry_size;
+	}
+}
+
+/**
+ * Add entries to a log.  Each entry will be filled with the lower byte of the entry number.
+ *
+ * @param test The testing framework.
+ * @param logging The log to update.
+ * @param first Number of the first entry to add.
+ * @param count The number of entries to add.
+ * @param entry_size Length of the entry data.
+ */
+static void logging_memory_lockfree_testing_add_entries (CuTest *test,
+	const struct logging *logging, int first, int count, int entry_size)
+{
+	uint8_t entry[entry_size];
+	int status;
+	int i;
+
+	for (i = first; i < (first + count); i++) {
+		memset (entry, i, entry_size);
+
+		status = logging->create_entry (logging, entry, entry_size);
+		CuAssertIntEquals (test, 0, status);
+	}
+}
+
+
+/*******************
+ * Test cases
+ *******************/
+
+static void logging_memory_lockfree_test_init (CuTest *test)
+{
+	struct logging_memory_lockfree logging;
+	struct logging_memory_lockfree_state state;
+	int status;
+
+	TEST_START;
+
+	status = logging_memory_lockfree_init (&logging, &state, 32, 11);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrNotNull (test, logging.base.create_entry);
+#ifndef LOGGING_DISABLE_FLUSH
+	CuAssertPtrNotNull (test, logging.base.flush);
+#endif
+	CuAssertPtrNotNull (test, logging.base.clear);
+	CuAssertPtrNotNull (test, logging.base.get_size);
+	CuAssertPtrNotNull (test, logging.base.read_contents);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 0, logging_memory_lockfree_get_dropped_count (&logging));
+
+	logging_memory_lockfree_release (&logging);
+}
+
+static void logging_memory_lockfree_test_init_null (CuTest *test)
+{
+	struct logging_memory_lockfree logging;
+	struct logging_memory_lockfree_state state;
+	int status;
+
+	TEST_START;
+
+	status = logging_memory_lockfree_init (NULL, &state, 32, 11);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = logging_memory_lockfree_init (&logging, NULL, 32, 11);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = logging_memory_lockfree_init (&logging, &state, 0, 11);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = logging_memory_lockfree_init (&logging, &state, 32, 0);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+}
+
+static void logging_memory_lockfree_test_init_from_buffer (CuTest *test)
+{
+	struct logging_memory_lockfree logging;
+	struct logging_memory_lockfree_state state;
+	int status;
+	const int entry_size = 11;
+	const int entry_len = entry_size + sizeof (struct logging_entry_header);
+	const int entry_count = 32;
+	const int entry_full = entry_len * entry_count;
+	uint8_t buffer[entry_full];
+	volatile uint32_t sequence[entry_count];
+
+	TEST_START;
+
+	status = logging_memory_lockfree_init_from_buffer (&logging, &state, buffer, sizeof (buffer),
+		sequence, entry_size);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrNotNull (test, logging.base.create_entry);
+#ifndef LOGGING_DISABLE_FLUSH
+	CuAssertPtrNotNull (test, logging.base.flush);
+#endif
+	CuAssertPtrNotNull (test, logging.base.clear);
+	CuAssertPtrNotNull (test, logging.base.get_size);
+	CuAssertPtrNotNull (test, logging.base.read_contents);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_lockfree_release (&logging);
+}
+
+static void logging_memory_lockfree_test_init_from_buffer_null (CuTest *test)
+{
+	struct logging_memory_lockfree logging;
+	struct logging_memory_lockfree_state state;
+	int status;
+	const int entry_size = 11;
+	const int entry_len = entry_size + sizeof (struct logging_entry_header);
+	const int entry_count = 32;
+	const int entry_full = entry_len * entry_count;
+	uint8_t buffer[entry_full];
+	volatile uint32_t sequence[entry_count];
+
+	TEST_START;
+
+	status = logging_memory_lockfree_init_from_buffer (NULL, &state, buffer, sizeof (buffer),
+		sequence, entry_size);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = logging_memory_lockfree_init_from_buffer (&logging, NULL, buffer, sizeof (buffer),
+		sequence, entry_size);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = logging_memory_lockfree_init_from_buffer (&logging, &state, NULL, sizeof (buffer),
+		sequence, entry_size);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = logging_memory_lockfree_init_from_buffer (&logging, &state, buffer, sizeof (buffer),
+		NULL, entry_size);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = logging_memory_lockfree_init_from_buffer (&logging, &state, buffer, sizeof (buffer),
+		sequence, 0);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+}
+
+static void logging_memory_lockfree_test_init_from_buffer_too_small (CuTest *test)
+{
+	struct logging_memory_lockfree logging;
+	struct logging_memory_lockfree_state state;
+	int status;
+	const int entry_size = 11;
+	const int entry_len = entry_size + sizeof (struct logging_entry_header);
+	uint8_t buffer[entry_len - 1];
+	volatile uint32_t sequence[1];
+
+	TEST_START;
+
+	status = logging_memory_lockfree_init_from_buffer (&logging, &state, buffer, sizeof (buffer),
+		sequence, entry_size);
+	CuAssertIntEquals (test, LOGGING_INSUFFICIENT_STORAGE, status);
+}
+
+static void logging_memory_lockfree_test_static_init (CuTest *test)
+{
+	struct logging_memory_lockfree_state state;
+	const int entry_size = 11;
+	const int entry_len = entry_size + sizeof (struct logging_entry_header);
+	const int entry_count = 32;
+	uint8_t buffer[entry_len * entry_count];
+	volatile uint32_t sequence[entry_count];
+	struct logging_memory_lockfree logging = logging_memory_lockfree_static_init (&state, buffer,
+		sizeof (buffer), sequence, entry_size);
+	int status;
+
+	TEST_START;
+
+	CuAssertPtrNotNull (test, logging.base.create_entry);
+#ifndef LOGGING_DISABLE_FLUSH
+	CuAssertPtrNotNull (test, logging.base.flush);
+#endif
+	CuAssertPtrNotNull (test, logging.base.clear);
+	CuAssertPtrNotNull (test, logging.base.get_size);
+	CuAssertPtrNotNull (test, logging.base.read_contents);
+
+	status = logging_memory_lockfree_init_state (&logging);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_lockfree_release (&logging);
+}
+
+static void logging_memory_lockfree_test_static_init_null (CuTest *test)
+{
+	struct logging_memory_lockfree_state state;
+	const int entry_size = 11;
+	const int entry_len = entry_size + sizeof (struct logging_entry_header);
+	const int entry_count = 32;
+	uint8_t buffer[entry_len * entry_count];
+	volatile uint32_t sequence[entry_count];
+	struct logging_memory_lockfree null_state = logging_memory_lockfree_static_init (NULL, buffer,
+		sizeof (buffer), sequence, entry_size);
+	struct logging_memory_lockfree null_buffer = logging_memory_lockfree_static_init (&state, NULL,
+		sizeof (buffer), sequence, entry_size);
+	struct logging_memory_lockfree null_sequence = logging_memory_lockfree_static_init (&state,
+		buffer, sizeof (buffer), NULL, entry_size);
+	int status;
+
+	TEST_START;
+
+	status = logging_memory_lockfree_init_state (NULL);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = logging_memory_lockfree_init_state (&null_state);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = logging_memory_lockfree_init_state (&null_buffer);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = logging_memory_lockfree_init_state (&null_sequence);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+}
+
+static void logging_memory_lockfree_test_release_null (CuTest *test)
+{
+	TEST_START;
+
+	logging_memory_lockfree_release (NULL);
+}
+
+static void logging_memory_lockfree_test_get_size_null (CuTest *test)
+{
+	struct logging_memory_lockfree logging;
+	struct logging_memory_lockfree_state state;
+	int status;
+
+	TEST_START;
+
+	status = logging_memory_lockfree_init (&logging, &state, 32, 11);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.get_size (NULL);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	logging_memory_lockfree_release (&logging);
+}
+
+static void logging_memory_lockfree_test_create_entry (CuTest *test)
+{
+	struct logging_memory_lockfree logging;
+	struct logging_memory_lockfree_state state;
+	int status;
+	const int entry_size = 11;
+	const int entry_len = entry_size + sizeof (struct logging_entry_header);
+	uint8_t entry_data[entry_len];
+	uint8_t output[entry_len];
+
+	TEST_START;
+
+	logging_memory_lockfree_testing_build_entries (entry_data, 0, 1, entry_size);
+
+	status = logging_memory_lockfree_init (&logging, &state, 32, entry_size);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_lockfree_testing_add_entries (test, &logging.base, 0, 1, entry_size);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = logging.base.read_contents (&logging.base, 0, output, sizeof (output));
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = testing_validate_array (entry_data, output, status);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_lockfree_release (&logging);
+}
+
+static void logging_memory_lockfree_test_create_entry_multiple (CuTest *test)
+{
+	struct logging_memory_lockfree logging;
+	struct logging_memory_lockfree_state state;
+	int status;
+	const int entry_size = 11;
+	const int entry_len = entry_size + sizeof (struct logging_entry_header);
+	const int entry_count = 10;
+	uint8_t entry_data[entry_len * entry_count];
+	uint8_t output[entry_len * 32];
+
+	TEST_START;
+
+	logging_memory_lockfree_testing_build_entries (entry_data, 0, entry_count, entry_size);
+
+	status = logging_memory_lockfree_init (&logging, &state, 32, entry_size);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_lockfree_testing_add_entries (test, &logging.base, 0, entry_count, entry_size);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = logging.base.read_contents (&logging.base, 0, output, sizeof (output));
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = testing_validate_array (entry_data, output, status);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_lockfree_release (&logging);
+}
+
+static void logging_memory_lockfree_test_create_entry_full_log (CuTest *test)
+{
+	struct logging_memory_lockfree logging;
+	struct logging_memory_lockfree_state state;
+	int status;
+	const int entry_size = 11;
+	const int entry_len = entry_size + sizeof (struct logging_entry_header);
+	const int entry_count = 32;
+	uint8_t entry_data[entry_len * entry_count];
+	uint8_t output[entry_len * entry_count];
+
+	TEST_START;
+
+	logging_memory_lockfree_testing_build_entries (entry_data, 0, entry_count, entry_size);
+
+	status = logging_memory_lockfree_init (&logging, &state, entry_count, entry_size);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_lockfree_testing_add_entries (test, &logging.base, 0, entry_count, entry_size);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = logging.base.read_contents (&logging.base, 0, output, sizeof (output));
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = testing_validate_array (entry_data, output, status);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_lockfree_release (&logging);
+}
+
+static void logging_memory_lockfree_test_create_entry_log_wrap (CuTest *test)
+{
+	struct logging_memory_lockfree logging;
+	struct logging_memory_lockfree_state state;
+	int status;
+	const int entry_size = 11;
+	const int entry_len = entry_size + sizeof (struct logging_entry_header);
+	const int entry_count = 32;
+	uint8_t entry_data[entry_len * entry_count];
+	uint8_t output[entry_len * entry_count];
+
+	TEST_START;
+
+	logging_memory_lockfree_testing_build_entries (entry_data, 1, entry_count, entry_size);
+
+	status = logging_memory_lockfree_init (&logging, &state, entry_count, entry_size);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_lockfree_testing_add_entries (test, &logging.base, 0, entry_count + 1,
+		entry_size);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = logging.base.read_contents (&logging.base, 0, output, sizeof (output));
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = testing_validate_array (entry_data, output, status);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 0, logging_memory_lockfree_get_dropped_count (&logging));
+
+	logging_memory_lockfree_release (&logging);
+}
+
+static void logging_memory_lockfree_test_create_entry_log_wrap_twice (CuTest *test)
+{
+	struct logging_memory_lockfree logging;
+	struct logging_memory_lockfree_state state;
+	int status;
+	const int entry_size = 11;
+	const int entry_len = entry_size + sizeof (struct logging_entry_header);
+	const int entry_count = 32;
+	uint8_t entry_data[entry_len * entry_count];
+	uint8_t output[entry_len * entry_count];
+
+	TEST_START;
+
+	logging_memory_lockfree_testing_build_entries (entry_data, (entry_count * 2) + 5, entry_count,
+		entry_size);
+
+	status = logging_memory_lockfree_init (&logging, &state, entry_count, entry_size);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_lockfree_testing_add_entries (test, &logging.base, 0, (entry_count * 3) + 5,
+		entry_size);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = logging.base.read_contents (&logging.base, 0, output, sizeof (output));
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = testing_validate_array (entry_data, output, status);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_lockfree_release (&logging);
+}
+
+static void logging_memory_lockfree_test_create_entry_from_buffer_not_entry_aligned (CuTest *test)
+{
+	struct logging_memory_lockfree logging;
+	struct logging_memory_lockfree_state state;
+	int status;
+	const int entry_size = 11;
+	const int entry_len = entry_size + sizeof (struct logging_entry_header);
+	const int entry_count = 4;
+	uint8_t buffer[(entry_len * entry_count) + 5];
+	volatile uint32_t sequence[entry_count];
+	uint8_t entry_data[entry_len * entry_count];
+	uint8_t output[sizeof (buffer)];
+
+	TEST_START;
+
+	logging_memory_lockfree_testing_build_entries (entry_data, 2, entry_count, entry_size);
+
+	status = logging_memory_lockfree_init_from_buffer (&logging, &state, buffer, sizeof (buffer),
+		sequence, entry_size);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_lockfree_testing_add_entries (test, &logging.base, 0, entry_count + 2,
+		entry_size);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = logging.base.read_contents (&logging.base, 0, output, sizeof (output));
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = testing_validate_array (entry_data, output, status);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_lockfree_release (&logging);
+}
+
+static void logging_memory_lockfree_test_create_entry_static_init (CuTest *test)
+{
+	struct logging_memory_lockfree_state state;
+	const int entry_size = 11;
+	const int entry_len = entry_size + sizeof (struct logging_entry_header);
+	const int entry_count = 8;
+	uint8_t buffer[entry_len * entry_count];
+	volatile uint32_t sequence[entry_count];
+	struct logging_memory_lockfree logging = logging_memory_lockfree_static_init (&state, buffer,
+		sizeof (buffer), sequence, entry_size);
+	uint8_t entry_data[entry_len * 3];
+	uint8_t output[sizeof (buffer)];
+	int status;
+
+	TEST_START;
+
+	logging_memory_lockfree_testing_build_entries (entry_data, 0, 3, entry_size);
+
+	status = logging_memory_lockfree_init_state (&logging);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_lockfree_testing_add_entries (test, &logging.base, 0, 3, entry_size);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = logging.base.read_contents (&logging.base, 0, output, sizeof (output));
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = testing_validate_array (entry_data, output, status);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_lockfree_release (&logging);
+}
+
+static void logging_memory_lockfree_test_create_entry_slot_busy (CuTest *test)
+{
+	struct logging_memory_lockfree_state state;
+	const int entry_size = 11;
+	const int entry_len = entry_size + sizeof (struct logging_entry_header);
+	const int entry_count = 4;
+	uint8_t buffer[entry_len * entry_count];
+	volatile uint32_t sequence[entry_count];
+	struct logging_memory_lockfree logging = logging_memory_lockfree_static_init (&state, buffer,
+		sizeof (buffer), sequence, entry_size);
+	uint8_t entry_data[entry_len * entry_count];
+	uint8_t output[sizeof (buffer)];
+	int status;
+
+	TEST_START;
+
+	logging_memory_lockfree_testing_build_entries (entry_data, 1, entry_count, entry_size);
+
+	status = logging_memory_lockfree_init_state (&logging);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_lockfree_testing_add_entries (test, &logging.base, 0, entry_count, entry_size);
+
+	/* Simulate a writer that is still adding entry 0 when the log wraps around. */
+	sequence[0] |= 1;
+
+	logging_memory_lockfree_testing_add_entries (test, &logging.base, entry_count, 1, entry_size);
+	CuAssertIntEquals (test, 1, logging_memory_lockfree_get_dropped_count (&logging));
+
+	/* Neither entry 0 nor entry 4 is available. */
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, entry_len * (entry_count - 1), status);
+
+	status = logging.base.read_contents (&logging.base, 0, output, sizeof (output));
+	CuAssertIntEquals (test, entry_len * (entry_count - 1), status);
+
+	status = testing_validate_array (entry_data, output, status);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_lockfree_release (&logging);
+}
+
+static void logging_memory_lockfree_test_create_entry_slot_busy_newer_entries (CuTest *test)
+{
+	struct logging_memory_lockfree_state state;
+	const int entry_size = 11;
+	const int entry_len = entry_size + sizeof (struct logging_entry_header);
+	const int entry_count = 4;
+	uint8_t buffer[entry_len * entry_count];
+	volatile uint32_t sequence[entry_count];
+	struct logging_memory_lockfree logging = logging_memory_lockfree_static_init (&state, buffer,
+		sizeof (buffer), sequence, entry_size);
+	uint8_t entry_data[entry_len * entry_count];
+	uint8_t output[sizeof (buffer)];
+	int status;
+
+	TEST_START;
+
+	logging_memory_lockfree_testing_build_entries (entry_data, 5, entry_count, entry_size);
+
+	status = logging_memory_lockfree_init_state (&logging);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_lockfree_testing_add_entries (test, &logging.base, 0, entry_count, entry_size);
+
+	/* Simulate a writer that is still adding entry 0 when the log wraps around. */
+	sequence[0] |= 1;
+
+	logging_memory_lockfree_testing_add_entries (test, &logging.base, entry_count, entry_count,
+		entry_size);
+	CuAssertIntEquals (test, 1, logging_memory_lockfree_get_dropped_count (&logging));
+
+	/* Entry 4 was dropped, but the newer entries are still available. */
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, entry_len * (entry_count - 1), status);
+
+	status = logging.base.read_contents (&logging.base, 0, output, sizeof (output));
+	CuAssertIntEquals (test, entry_len * (entry_count - 1), status);
+
+	status = testing_validate_array (entry_data, output, status);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.read_contents (&logging.base, entry_len, output, sizeof (output));
+	CuAssertIntEquals (test, entry_len * (entry_count - 2), status);
+
+	status = testing_validate_array (&entry_data[entry_len], output, status);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Complete entry 0 and add another entry to the same slot. */
+	sequence[0] &= ~1;
+
+	logging_memory_lockfree_testing_add_entries (test, &logging.base, entry_count * 2, 1,
+		entry_size);
+	CuAssertIntEquals (test, 1, logging_memory_lockfree_get_dropped_count (&logging));
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, entry_len * entry_count, status);
+
+	status = logging.base.read_contents (&logging.base, 0, output, sizeof (output));
+	CuAssertIntEquals (test, entry_len * entry_count, status);
+
+	status = testing_validate_array (entry_data, output, status);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_lockfree_release (&logging);
+}
+
+static void logging_memory_lockfree_test_create_entry_slot_busy_multiple_wraps (CuTest *test)
+{
+	struct logging_memory_lockfree_state state;
+	const int entry_size = 11;
+	const int entry_len = entry_size + sizeof (struct logging_entry_header);
+	const int entry_count = 4;
+	uint8_t buffer[entry_len * entry_count];
+	volatile uint32_t sequence[entry_count];
+	struct logging_memory_lockfree logging = logging_memory_lockfree_static_init (&state, buffer,
+		sizeof (buffer), sequence, entry_size);
+	uint8_t entry_data[entry_len * entry_count];
+	uint8_t output[sizeof (buffer)];
+	int status;
+
+	TEST_START;
+
+	logging_memory_lockfree_testing_build_entries (entry_data, 9, entry_count - 1, entry_size);
+
+	status = logging_memory_lockfree_init_state (&logging);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_lockfree_testing_add_entries (test, &logging.base, 0, entry_count, entry_size);
+
+	/* Simulate a writer that is still adding entry 0 while the log wraps around twice. */
+	sequence[0] |= 1;
+
+	logging_memory_lockfree_testing_add_entries (test, &logging.base, entry_count,
+		entry_count * 2, entry_size);
+	CuAssertIntEquals (test, 2, logging_memory_lockfree_get_dropped_count (&logging));
+
+	/* Entries 4 and 8 were dropped.  Only the newest entries remain. */
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, entry_len * (entry_count - 1), status);
+
+	status = logging.base.read_contents (&logging.base, 0, output, sizeof (output));
+	CuAssertIntEquals (test, entry_len * (entry_count - 1), status);
+
+	status = testing_validate_array (entry_data, output, status);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Completing entry 0 doesn't change the log contents. */
+	sequence[0] &= ~1;
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, entry_len * (entry_count - 1), status);
+
+	status = logging.base.read_contents (&logging.base, 0, output, sizeof (output));
+	CuAssertIntEquals (test, entry_len * (entry_count - 1), status);
+
+	status = testing_validate_array (entry_data, output, status);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_lockfree_release (&logging);
+}
+
+static void logging_memory_lockfree_test_create_entry_null (CuTest *test)
+{
+	struct logging_memory_lockfree logging;
+	struct logging_memory_lockfree_state state;
+	int status;
+	uint8_t entry[11];
+
+	TEST_START;
+
+	status = logging_memory_lockfree_init (&logging, &state, 32, sizeof (entry));
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.create_entry (NULL, entry, sizeof (entry));
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = logging.base.create_entry (&logging.base, NULL, sizeof (entry));
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_lockfree_release (&logging);
+}
+
+static void logging_memory_lockfree_test_create_entry_bad_length (CuTest *test)
+{
+	struct logging_memory_lockfree logging;
+	struct logging_memory_lockfree_state state;
+	int status;
+	uint8_t entry[11];
+
+	TEST_START;
+
+	status = logging_memory_lockfree_init (&logging, &state, 32, sizeof (entry));
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.create_entry (&logging.base, entry, sizeof (entry) - 1);
+	CuAssertIntEquals (test, LOGGING_BAD_ENTRY_LENGTH, status);
+
+	status = logging.base.create_entry (&logging.base, entry, sizeof (entry) + 1);
+	CuAssertIntEquals (test, LOGGING_BAD_ENTRY_LENGTH, status);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_lockfree_release (&logging);
+}
+
+#ifndef LOGGING_DISABLE_FLUSH
+static void logging_memory_lockfree_test_flush (CuTest *test)
+{
+	struct logging_memory_lockfree logging;
+	struct logging_memory_lockfree_state state;
+	int status;
+	const int entry_size = 11;
+	const int entry_len = entry_size + sizeof (struct logging_entry_header);
+	uint8_t entry_data[entry_len * 2];
+	uint8_t output[entry_len * 2];
+
+	TEST_START;
+
+	logging_memory_lockfree_testing_build_entries (entry_data, 0, 2, entry_size);
+
+	status = logging_memory_lockfree_init (&logging, &state, 32, entry_size);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_lockfree_testing_add_entries (test, &logging.base, 0, 2, entry_size);
+
+	status = logging.base.flush (&logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.read_contents (&logging.base, 0, output, sizeof (output));
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = testing_validate_array (entry_data, output, status);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_lockfree_release (&logging);
+}
+#endif
+
+static void logging_memory_lockfree_test_read_contents_partial_read (CuTest *test)
+{
+	struct logging_memory_lockfree logging;
+	struct logging_memory_lockfree_state state;
+	int status;
+	const int entry_size = 11;
+	const int entry_len = entry_size + sizeof (struct logging_entry_header);
+	uint8_t entry_data[entry_len * 3];
+	uint8_t output[entry_len * 3];
+
+	TEST_START;
+
+	logging_memory_lockfree_testing_build_entries (entry_data, 0, 3, entry_size);
+
+	status = logging_memory_lockfree_init (&logging, &state, 32, entry_size);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_lockfree_testing_add_entries (test, &logging.base, 0, 3, entry_size);
+
+	status = logging.base.read_contents (&logging.base, 0, output, entry_len + 5);
+	CuAssertIntEquals (test, entry_len + 5, status);
+
+	status = testing_validate_array (entry_data, output, status);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_lockfree_release (&logging);
+}
+
+static void logging_memory_lockfree_test_read_contents_offset_read_with_wrap (CuTest *test)
+{
+	struct logging_memory_lockfree logging;
+	struct logging_memory_lockfree_state state;
+	int status;
+	const int entry_size = 11;
+	const int entry_len = entry_size + sizeof (struct logging_entry_header);
+	const int entry_count = 4;
+	const int offset = entry_len + 3;
+	uint8_t entry_data[entry_len * entry_count];
+	uint8_t output[entry_len * entry_count];
+
+	TEST_START;
+
+	logging_memory_lockfree_testing_build_entries (entry_data, 3, entry_count, entry_size);
+
+	status = logging_memory_lockfree_init (&logging, &state, entry_count, entry_size);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_lockfree_testing_add_entries (test, &logging.base, 0, entry_count + 3,
+		entry_size);
+
+	status = logging.base.read_contents (&logging.base, offset, output, sizeof (output));
+	CuAssertIntEquals (test, sizeof (entry_data) - offset, status);
+
+	status = testing_validate_array (&entry_data[offset], output, status);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_lockfree_release (&logging);
+}
+
+static void logging_memory_lockfree_test_read_contents_partial_read_with_offset (CuTest *test)
+{
+	struct logging_memory_lockfree logging;
+	struct logging_memory_lockfree_state state;
+	int status;
+	const int entry_size = 11;
+	const int entry_len = entry_size + sizeof (struct logging_entry_header);
+	const int offset = 7;
+	uint8_t entry_data[entry_len * 3];
+	uint8_t output[entry_len * 3];
+
+	TEST_START;
+
+	logging_memory_lockfree_testing_build_entries (entry_data, 0, 3, entry_size);
+
+	status = logging_memory_lockfree_init (&logging, &state, 32, entry_size);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_lockfree_testing_add_entries (test, &logging.base, 0, 3, entry_size);
+
+	status = logging.base.read_contents (&logging.base, offset, output, entry_len);
+	CuAssertIntEquals (test, entry_len, status);
+
+	status = testing_validate_array (&entry_data[offset], output, status);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_lockfree_release (&logging);
+}
+
+static void logging_memory_lockfree_test_read_contents_offset_past_end (CuTest *test)
+{
+	struct logging_memory_lockfree logging;
+	struct logging_memory_lockfree_state state;
+	int status;
+	const int entry_size = 11;
+	const int entry_len = entry_size + sizeof (struct logging_entry_header);
+	uint8_t output[entry_len * 3];
+
+	TEST_START;
+
+	status = logging_memory_lockfree_init (&logging, &state, 32, entry_size);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_lockfree_testing_add_entries (test, &logging.base, 0, 3, entry_size);
+
+	status = logging.base.read_contents (&logging.base, entry_len * 3, output, sizeof (output));
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_lockfree_release (&logging);
+}
+
+static void logging_memory_lockfree_test_read_contents_entry_in_progress (CuTest *test)
+{
+	struct logging_memory_lockfree_state state;
+	const int entry_size = 11;
+	const int entry_len = entry_size + sizeof (struct logging_entry_header);
+	const int entry_count = 8;
+	uint8_t buffer[entry_len * entry_count];
+	volatile uint32_t sequence[entry_count];
+	struct logging_memory_lockfree logging = logging_memory_lockfree_static_init (&state, buffer,
+		sizeof (buffer), sequence, entry_size);
+	uint8_t entry_data[entry_len * 3];
+	uint8_t output[sizeof (buffer)];
+	int status;
+
+	TEST_START;
+
+	logging_memory_lockfree_testing_build_entries (entry_data, 0, 3, entry_size);
+
+	status = logging_memory_lockfree_init_state (&logging);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_lockfree_testing_add_entries (test, &logging.base, 0, 3, entry_size);
+
+	/* Simulate entry 1 still being written.  Newer entries are not readable until it completes. */
+	sequence[1] |= 1;
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, entry_len, status);
+
+	status = logging.base.read_contents (&logging.base, 0, output, sizeof (output));
+	CuAssertIntEquals (test, entry_len, status);
+
+	status = testing_validate_array (entry_data, output, status);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Once the entry is complete, it will be read. */
+	sequence[1] &= ~1;
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = logging.base.read_contents (&logging.base, 0, output, sizeof (output));
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = testing_validate_array (entry_data, output, status);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_lockfree_release (&logging);
+}
+
+static void logging_memory_lockfree_test_read_contents_paged_read_entry_in_progress (CuTest *test)
+{
+	struct logging_memory_lockfree_state state;
+	const int entry_size = 11;
+	const int entry_len = entry_size + sizeof (struct logging_entry_header);
+	const int entry_count = 8;
+	uint8_t buffer[entry_len * entry_count];
+	volatile uint32_t sequence[entry_count];
+	struct logging_memory_lockfree logging = logging_memory_lockfree_static_init (&state, buffer,
+		sizeof (buffer), sequence, entry_size);
+	uint8_t entry_data[entry_len * 3];
+	uint8_t output[sizeof (entry_data)];
+	const int page = entry_len + 5;
+	int status;
+
+	TEST_START;
+
+	logging_memory_lockfree_testing_build_entries (entry_data, 0, 3, entry_size);
+
+	status = logging_memory_lockfree_init_state (&logging);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_lockfree_testing_add_entries (test, &logging.base, 0, 3, entry_size);
+
+	/* Entry 1 is still being written when the first page is read. */
+	sequence[1] |= 1;
+
+	status = logging.base.read_contents (&logging.base, 0, output, page);
+	CuAssertIntEquals (test, entry_len, status);
+
+	/* The entry completes before the next page is read.  No data is skipped or duplicated. */
+	sequence[1] &= ~1;
+
+	status = logging.base.read_contents (&logging.base, entry_len, &output[entry_len], page);
+	CuAssertIntEquals (test, page, status);
+
+	status = logging.base.read_contents (&logging.base, entry_len + page,
+		&output[entry_len + page], page);
+	CuAssertIntEquals (test, sizeof (entry_data) - entry_len - page, status);
+
+	status = testing_validate_array (entry_data, output, sizeof (entry_data));
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_lockfree_release (&logging);
+}
+
+static void logging_memory_lockfree_test_read_contents_log_keeps_wrapping (CuTest *test)
+{
+	struct logging_memory_lockfree_state state;
+	const int entry_size = 11;
+	const int entry_len = entry_size + sizeof (struct logging_entry_header);
+	const int entry_count = 4;
+	uint8_t buffer[entry_len * entry_count];
+	volatile uint32_t sequence[entry_count];
+	struct logging_memory_lockfree logging = logging_memory_lockfree_static_init (&state, buffer,
+		sizeof (buffer), sequence, entry_size);
+	uint8_t output[sizeof (buffer)];
+	int status;
+
+	TEST_START;
+
+	status = logging_memory_lockfree_init_state (&logging);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_lockfree_testing_add_entries (test, &logging.base, 0, entry_count, entry_size);
+
+	/* Simulate the oldest entry always being overwritten by a newer one before it can be read. */
+	sequence[0] = (entry_count + 1) << 2;
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, LOGGING_GET_SIZE_FAILED, status);
+
+	status = logging.base.read_contents (&logging.base, 0, output, sizeof (output));
+	CuAssertIntEquals (test, LOGGING_READ_CONTENTS_FAILED, status);
+
+	logging_memory_lockfree_release (&logging);
+}
+
+static void logging_memory_lockfree_test_read_contents_null (CuTest *test)
+{
+	struct logging_memory_lockfree logging;
+	struct logging_memory_lockfree_state state;
+	int status;
+	uint8_t output[32];
+
+	TEST_START;
+
+	status = logging_memory_lockfree_init (&logging, &state, 32, 11);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.read_contents (NULL, 0, output, sizeof (output));
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	status = logging.base.read_contents (&logging.base, 0, NULL, sizeof (output));
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	logging_memory_lockfree_release (&logging);
+}
+
+static void logging_memory_lockfree_test_clear (CuTest *test)
+{
+	struct logging_memory_lockfree logging;
+	struct logging_memory_lockfree_state state;
+	int status;
+	const int entry_size = 11;
+	const int entry_len = entry_size + sizeof (struct logging_entry_header);
+	uint8_t output[entry_len * 3];
+
+	TEST_START;
+
+	status = logging_memory_lockfree_init (&logging, &state, 32, entry_size);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_lockfree_testing_add_entries (test, &logging.base, 0, 3, entry_size);
+
+	status = logging.base.clear (&logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.read_contents (&logging.base, 0, output, sizeof (output));
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_lockfree_release (&logging);
+}
+
+static void logging_memory_lockfree_test_clear_add_after_clear (CuTest *test)
+{
+	struct logging_memory_lockfree logging;
+	struct logging_memory_lockfree_state state;
+	int status;
+	const int entry_size = 11;
+	const int entry_len = entry_size + sizeof (struct logging_entry_header);
+	const int entry_count = 4;
+	uint8_t entry_data[entry_len * 2];
+	uint8_t output[entry_len * entry_count];
+
+	TEST_START;
+
+	logging_memory_lockfree_testing_build_entries (entry_data, 6, 2, entry_size);
+
+	status = logging_memory_lockfree_init (&logging, &state, entry_count, entry_size);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_lockfree_testing_add_entries (test, &logging.base, 0, 6, entry_size);
+
+	status = logging.base.clear (&logging.base);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_lockfree_testing_add_entries (test, &logging.base, 6, 2, entry_size);
+
+	status = logging.base.get_size (&logging.base);
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = logging.base.read_contents (&logging.base, 0, output, sizeof (output));
+	CuAssertIntEquals (test, sizeof (entry_data), status);
+
+	status = testing_validate_array (entry_data, output, status);
+	CuAssertIntEquals (test, 0, status);
+
+	logging_memory_lockfree_release (&logging);
+}
+
+static void logging_memory_lockfree_test_clear_null (CuTest *test)
+{
+	struct logging_memory_lockfree logging;
+	struct logging_memory_lockfree_state state;
+	int status;
+
+	TEST_START;
+
+	status = logging_memory_lockfree_init (&logging, &state, 32, 11);
+	CuAssertIntEquals (test, 0, status);
+
+	status = logging.base.clear (NULL);
+	CuAssertIntEquals (test, LOGGING_INVALID_ARGUMENT, status);
+
+	logging_memory_lockfree_release (&logging);
+}
+
+static void logging_memory_lockfree_test_get_dropped_count_null (CuTest *test)
+{
+	TEST_START;
+
+	CuAssertIntEquals (test, 0, logging_memory_lockfree_get_dropped_count (NULL));
+}
+
+
+TEST_SUITE_START (logging_memory_lockfree);
+
+TEST (logging_memory_lockfree_test_init);
+TEST (logging_memory_lockfree_test_init_null);
+TEST (logging_memory_lockfree_test_init_from_buffer);
+TEST (logging_memory_lockfree_test_init_from_buffer_null);
+TEST (logging_memory_lockfree_test_init_from_buffer_too_small);
+TEST (logging_memory_lockfree_test_static_init);
+TEST (logging_memory_lockfree_test_static_init_null);
+TEST (logging_memory_lockfree_test_release_null);
+TEST (logging_memory_lockfree_test_get_size_null);
+TEST (logging_memory_lockfree_test_create_entry);
+TEST (logging_memory_lockfree_test_create_entry_multiple);
+TEST (logging_memory_lockfree_test_create_entry_full_log);
+TEST (logging_memory_lockfree_test_create_entry_log_wrap);
+TEST (logging_memory_lockfree_test_create_entry_log_wrap_twice);
+TEST (logging_memory_lockfree_test_create_entry_from_buffer_not_entry_aligned);
+TEST (logging_memory_lockfree_test_create_entry_static_init);
+TEST (logging_memory_lockfree_test_create_entry_slot_busy);
+TEST (logging_memory_lockfree_test_create_entry_slot_busy_newer_entries);
+TEST (logging_memory_lockfree_test_create_entry_slot_busy_multiple_wraps);
+TEST (logging_memory_lockfree_test_create_entry_null);
+TEST (logging_memory_lockfree_test_create_entry_bad_length);
+#ifndef LOGGING_DISABLE_FLUSH
+TEST (logging_memory_lockfree_test_flush);
+#endif
+TEST (logging_memory_lockfree_test_read_contents_partial_read);
+TEST (logging_memory_lockfree_test_read_contents_offset_read_with_wrap);
+TEST (logging_memory_lockfree_test_read_contents_partial_read_with_offset);
+TEST (logging_memory_lockfree_test_read_contents_offset_past_end);
+TEST (logging_memory_lockfree_test_read_contents_entry_in_progress);
+TEST (logging_memory_lockfree_test_read_contents_paged_read_entry_in_progress);
+TEST (logging_memory_lockfree_test_read_contents_log_keeps_wrapping);
+TEST (logging_memory_lockfree_test_read_contents_null);
+TEST (logging_memory_lockfree_test_clear);
+TEST (logging_memory_lockfree_test_clear_add_after_clear);
+TEST (logging_memory_lockfree_test_clear_null);
+TEST (logging_memory_lockfree_test_get_dropped_count_null);
+
+TEST_SUITE_END;
@@ -2011,6 +2011,49 @@ static void cfm_flash_test_release_null (CuTest *test)
 	cfm_flash_release (NULL);
 }
 
+static void cfm_flash_test_set_digests_pool (CuTest *test)
+{
+	struct cfm_flash_testing cfm;
+	uint64_t digest_slots[OBJECT_POOL_STORAGE_LEN (SHA256_HASH_LENGTH * 2, 2)];
+	volatile uint32_t digest_links[2];
+	struct object_pool_state digests_pool_state;
+	struct object_pool digests_pool;
+	int status;
+
+	TEST_START;
+
+	status = object_pool_init (&digests_pool, &digests_pool_state, digest_slots, digest_links,
+		SHA256_HASH_LENGTH * 2, 2);
+	CuAssertIntEquals (test, 0, status);
+
+	cfm_flash_testing_init (test, &cfm, 0x10000);
+
+	CuAssertPtrEquals (test, NULL, (void*) cfm.test.digests_pool);
+
+	status = cfm_flash_set_digests_pool (&cfm.test, &digests_pool);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, &digests_pool, (void*) cfm.test.digests_pool);
+
+	status = cfm_flash_set_digests_pool (&cfm.test, NULL);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrEquals (test, NULL, (void*) cfm.test.digests_pool);
+
+	cfm_flash_testing_validate_and_release (test, &cfm);
+
+	object_pool_release (&digests_pool);
+}
+
+static void cfm_flash_test_set_digests_pool_null (CuTest *test)
+{
+	struct object_pool digests_pool;
+	int status;
+
+	TEST_START;
+
+	status = cfm_flash_set_digests_pool (NULL, &digests_pool);
+	CuAssertIntEquals (test, CFM_INVALID_ARGUMENT, status);
+}
+
 static void cfm_flash_test_verify (CuTest *test)
 {
 	struct cfm_flash_testing cfm;
@@ -2964,6 +3007,74 @@ static void cfm_flash_test_get_component_pmr_digest (CuTest *test)
 	cfm_flash_testing_validate_and_release (test, &cfm);
 }
 
+static void cfm_flash_test_get_component_pmr_digest_digests_pool (CuTest *test)
+{
+	struct cfm_pmr_digest pmr_digest;
+	struct cfm_flash_testing cfm;
+	uint64_t digest_slots[OBJECT_POOL_STORAGE_LEN (SHA256_HASH_LENGTH * 2, 2)];
+	volatile uint32_t digest_links[2];
+	struct object_pool_state digests_pool_state;
+	struct object_pool digests_pool;
+	struct object_pool_stats stats;
+	int status;
+
+	TEST_START;
+
+	status = object_pool_init (&digests_pool, &digests_pool_state, digest_slots, digest_links,
+		SHA256_HASH_LENGTH * 2, 2);
+	CuAssertIntEquals (test, 0, status);
+
+	cfm_flash_testing_init_and_verify (test, &cfm, 0x10000, &CFM_TESTING, 0, false, 0);
+
+	status = cfm_flash_set_digests_pool (&cfm.test, &digests_pool);
+	CuAssertIntEquals (test, 0, status);
+
+	manifest_flash_v2_testing_read_element (test, &cfm.manifest, &CFM_TESTING.manifest,
+		CFM_TESTING.component_device1_entry, 0, CFM_TESTING.component_device1_hash,
+		CFM_TESTING.component_device1_offset, CFM_TESTING.component_device1_len,
+		CFM_TESTING.component_device1_len, 0);
+
+	manifest_flash_v2_testing_iterate_manifest_toc (test, &cfm.manifest, &CFM_TESTING.manifest, 2,
+		26);
+
+	manifest_flash_v2_testing_read_element (test, &cfm.manifest, &CFM_TESTING.manifest, 5, 2, 5,
+		0x6e4, 0x44, sizeof (struct cfm_pmr_digest_element), 0);
+	manifest_flash_v2_testing_read_element (test, &cfm.manifest, &CFM_TESTING.manifest, 5, 5, 5,
+		0x6e4, 0x44, 0x44 - sizeof (struct cfm_pmr_digest_element),
+		sizeof (struct cfm_pmr_digest_element));
+
+	status = cfm.test.base.get_component_pmr_digest (&cfm.test.base, 3, 0, &pmr_digest);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, pmr_digest.pmr_id);
+	CuAssertIntEquals (test, HASH_TYPE_SHA256, pmr_digest.digests.hash_type);
+	CuAssertIntEquals (test, 2, pmr_digest.digests.digest_count);
+	CuAssertPtrEquals (test, digest_slots, (void*) pmr_digest.digests.digests);
+
+	status = testing_validate_array (PMR_DIGEST_0_DEVICE_1_1, pmr_digest.digests.digests,
+		sizeof (PMR_DIGEST_0_DEVICE_1_1));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (PMR_DIGEST_0_DEVICE_1_2, pmr_digest.digests.digests +
+		sizeof (PMR_DIGEST_0_DEVICE_1_1), sizeof (PMR_DIGEST_0_DEVICE_1_2));
+	CuAssertIntEquals (test, 0, status);
+
+	status = object_pool_get_stats (&digests_pool, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, stats.in_use);
+
+	cfm.test.base.free_component_pmr_digest (&cfm.test.base, &pmr_digest);
+
+	status = object_pool_get_stats (&digests_pool, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, stats.in_use);
+	CuAssertIntEquals (test, 1, stats.high_water);
+	CuAssertIntEquals (test, 0, stats.failures);
+
+	cfm_flash_testing_validate_and_release (test, &cfm);
+
+	object_pool_release (&digests_pool);
+}
+
 static void cfm_flash_test_get_component_pmr_digest_second_component (CuTest *test)
 {
 	struct cfm_pmr_digest pmr_digest;
@@ -10961,6 +11072,8 @@ TEST (cfm_flash_test_init);
 TEST (cfm_flash_test_init_null);
 TEST (cfm_flash_test_init_manifest_flash_init_fail);
 TEST (cfm_flash_test_release_null);
+TEST (cfm_flash_test_set_digests_pool);
+TEST (cfm_flash_test_set_digests_pool_null);
 TEST (cfm_flash_test_verify);
 TEST (cfm_flash_test_verify_only_pmr_digest);
 TEST (cfm_flash_test_verify_only_measurement);
@@ -11001,6 +11114,7 @@ TEST (cfm_flash_test_get_component_pmr_get_num_pmr_fail);
 TEST (cfm_flash_test_get_component_pmr_pmr_read_fail);
 TEST (cfm_flash_test_get_component_pmr_pmr_not_found);
 TEST (cfm_flash_test_get_component_pmr_digest);
+TEST (cfm_flash_test_get_component_pmr_digest_digests_pool);
 TEST (cfm_flash_test_get_component_pmr_digest_second_component);
 TEST (cfm_flash_test_get_component_pmr_digest_second_digest);
 TEST (cfm_flash_test_get_component_pmr_digest_null);
@@ -5,6 +5,7 @@
 #include <stdint.h>
 #include <string.h>
 #include "testing.h"
+#include "common/unused.h"
 #include "manifest/manifest_flash.h"
 #include "manifest/manifest_format.h"
 #include "manifest/manifest.h"
@@ -418,25 +419,28 @@ static void manifest_flash_v2_testing_init_and_verify (CuTest *test,
 }
 
 /**
- * Set expectations on mocks for reading an element from a v2 manifest.
+ * Set expectations on mocks for reading an element from a v2 manifest when the TOC hash is resumed
+ * from a saved hash state.
  *
  * @param test The testing framework.
  * @param manifest The components for the test.
  * @param data Manifest data for the test.
  * @param entry The entry index to read.
  * @param start The entry index to start reading.
+ * @param resume The entry index where the saved TOC hash state ends.
  * @param hash_id The hash index to read.
  * @param offset Address offset of the element to read.
  * @param length Length of the element data.
  * @param read_len Maximum length of the element data to read.
  * @param read_offset Offset to starting reading the element data.
  */
-void manifest_flash_v2_testing_read_element (CuTest *test,
+static void manifest_flash_v2_testing_read_element_resume (CuTest *test,
 	struct manifest_flash_v2_testing *manifest, const struct manifest_v2_testing_data *data,
-	int entry, int start, int hash_id, uint32_t offset, size_t length, size_t read_len,
-	uint32_t read_offset)
+	int entry, int start, int resume, int hash_id, uint32_t offset, size_t length,
+	size_t read_len, uint32_t read_offset)
 {
 	uint32_t toc_entry_offset = MANIFEST_V2_TOC_ENTRY_OFFSET;
+	uint32_t resume_entry = toc_entry_offset + (MANIFEST_V2_TOC_ENTRY_SIZE * resume);
 	uint32_t first_entry = toc_entry_offset + (MANIFEST_V2_TOC_ENTRY_SIZE * start);
 	uint32_t last_entry = toc_entry_offset + (MANIFEST_V2_TOC_ENTRY_SIZE * (entry + 1));
 	uint32_t hash_offset;
@@ -454,8 +458,8 @@ void manifest_flash_v2_testing_read_element (CuTest *test,
 	}
 
 	/* Start hashing the table of contents data. */
-	status = flash_mock_expect_verify_flash (&manifest->flash, manifest->addr + toc_entry_offset,
-		data->raw + toc_entry_offset, first_entry - toc_entry_offset);
+	status = flash_mock_expect_verify_flash (&manifest->flash, manifest->addr + resume_entry,
+		data->raw + resume_entry, first_entry - resume_entry);
 
 	/* Find the desired TOC entry. */
 	entry_read = (entry >= start) ? entry : data->toc_entries - 1;
@@ -526,6 +530,29 @@ done:
 	CuAssertIntEquals (test, 0, status);
 }
 
+/**
+ * Set expectations on mocks for reading an element from a v2 manifest.
+ *
+ * @param test The testing framework.
+ * @param manifest The components for the test.
+ * @param data Manifest data for the test.
+ * @param entry The entry index to read.
+ * @param start The entry index to start reading.
+ * @param hash_id The hash index to read.
+ * @param offset Address offset of the element to read.
+ * @param length Length of the element data.
+ * @param read_len Maximum length of the element data to read.
+ * @param read_offset Offset to starting reading the element data.
+ */
+void manifest_flash_v2_testing_read_element (CuTest *test,
+	struct manifest_flash_v2_testing *manifest, const struct manifest_v2_testing_data *data,
+	int entry, int start, int hash_id, uint32_t offset, size_t length, size_t read_len,
+	uint32_t read_offset)
+{
+	manifest_flash_v2_testing_read_element_resume (test, manifest, data, entry, start, 0, hash_id,
+		offset, length, read_len, read_offset);
+}
+
 /**
  * Set expectations on mocks for reading an element from a v2 manifest.  The mocked hashing engine
  * will be used.
@@ -940,27 +967,29 @@ cancel:
 }
 
 /**
- * Set expectations on mocks for iterating through manifest TOC in a v2 manifest.
+ * Set expectations on mocks for iterating through manifest TOC in a v2 manifest when the TOC hash is
+ * resumed from a saved hash state.
  *
  * @param test The testing framework.
  * @param manifest The components for the test.
  * @param data Manifest data for the test.
  * @param entry The table of contents index to start searching at.
+ * @param resume The table of contents index where the saved TOC hash state ends.
  * @param last_entry The last entry index to check.
  */
-void manifest_flash_v2_testing_iterate_manifest_toc (CuTest *test,
+static void manifest_flash_v2_testing_iterate_manifest_toc_resume (CuTest *test,
 	struct manifest_flash_v2_testing *manifest, const struct manifest_v2_testing_data *data,
-	int entry, int last_entry)
+	int entry, int resume, int last_entry)
 {
-	uint32_t offset = MANIFEST_V2_TOC_ENTRY_OFFSET;
+	uint32_t offset = MANIFEST_V2_TOC_ENTRY_OFFSET + (MANIFEST_V2_TOC_ENTRY_SIZE * resume);
 	int status;
 
 	/* Start hashing the table of contents data. */
 	status = flash_mock_expect_verify_flash (&manifest->flash, manifest->addr + offset,
-		data->raw + offset, MANIFEST_V2_TOC_ENTRY_SIZE * entry);
+		data->raw + offset, MANIFEST_V2_TOC_ENTRY_SIZE * (entry - resume));
 	CuAssertIntEquals (test, 0, status);
 
-	offset += (MANIFEST_V2_TOC_ENTRY_SIZE * entry);
+	offset += (MANIFEST_V2_TOC_ENTRY_SIZE * (entry - resume));
 
 	for (int i = entry; i <= last_entry; ++i) {
 		status |= mock_expect (&manifest->flash.mock, manifest->flash.base.read, &manifest->flash,
@@ -979,6 +1008,23 @@ void manifest_flash_v2_testing_iterate_manifest_toc (CuTest *test,
 	CuAssertIntEquals (test, 0, status);
 }
 
+/**
+ * Set expectations on mocks for iterating through manifest TOC in a v2 manifest.
+ *
+ * @param test The testing framework.
+ * @param manifest The components for the test.
+ * @param data Manifest data for the test.
+ * @param entry The table of contents index to start searching at.
+ * @param last_entry The last entry index to check.
+ */
+void manifest_flash_v2_testing_iterate_manifest_toc (CuTest *test,
+	struct manifest_flash_v2_testing *manifest, const struct manifest_v2_testing_data *data,
+	int entry, int last_entry)
+{
+	manifest_flash_v2_testing_iterate_manifest_toc_resume (test, manifest, data, entry, 0,
+		last_entry);
+}
+
 /**
  * Set expectations on mocks for iterating through manifest TOC in a v2 manifest but do not verify
  * TOC after iteration.
@@ -1098,6 +1144,23 @@ void manifest_flash_v2_testing_iterate_manifest_toc_mocked_hash (CuTest *test,
 	CuAssertIntEquals (test, 0, status);
 }
 
+/**
+ * Hash engine handler that always fails to restore a saved hash state.
+ *
+ * @param engine Unused.
+ * @param state Unused.
+ *
+ * @return HASH_ENGINE_NO_MEMORY
+ */
+static int manifest_flash_v2_testing_restore_state_failed (struct hash_engine *engine,
+	const struct hash_saved_state *state)
+{
+	UNUSED (engine);
+	UNUSED (state);
+
+	return HASH_ENGINE_NO_MEMORY;
+}
+
 /*******************
  * Test cases
  *******************/
@@ -7958,6 +8021,427 @@ static void manifest_flash_v2_test_compare_platform_id_both_null (CuTest *test)
 	CuAssertIntEquals (test, MANIFEST_INVALID_ARGUMENT, status);
 }
 
+static void manifest_flash_v2_test_enable_toc_hash_state_null (CuTest *test)
+{
+	struct manifest_flash_v2_testing manifest;
+	struct hash_saved_state toc_state;
+	int status;
+
+	TEST_START;
+
+	manifest_flash_v2_testing_init (test, &manifest, 0x10000, PFM_MAGIC_NUM, PFM_V2_MAGIC_NUM);
+
+	status = manifest_flash_enable_toc_hash_state (NULL, &toc_state);
+	CuAssertIntEquals (test, MANIFEST_INVALID_ARGUMENT, status);
+
+	status = manifest_flash_enable_toc_hash_state (&manifest.test, NULL);
+	CuAssertIntEquals (test, MANIFEST_INVALID_ARGUMENT, status);
+
+	manifest_flash_v2_testing_validate_and_release (test, &manifest);
+}
+
+static void manifest_flash_v2_test_read_element_data_toc_hash_state (CuTest *test)
+{
+	struct manifest_flash_v2_testing manifest;
+	struct hash_saved_state toc_state;
+	int status;
+	uint8_t buffer[PFM_V2.manifest.plat_id_len];
+	uint8_t *element = buffer;
+	uint8_t found = 0xff;
+
+	TEST_START;
+
+	manifest_flash_v2_testing_init_and_verify (test, &manifest, 0x10000, PFM_MAGIC_NUM,
+		PFM_V2_MAGIC_NUM, &PFM_V2.manifest, 0, false, 0);
+
+	status = manifest_flash_enable_toc_hash_state (&manifest.test, &toc_state);
+	CuAssertIntEquals (test, 0, status);
+
+	manifest_flash_v2_testing_read_element_resume (test, &manifest, &PFM_V2.manifest,
+		PFM_V2.manifest.plat_id_entry, PFM_V2.manifest.plat_id_entry, 0, PFM_V2.manifest.plat_id_hash,
+		PFM_V2.manifest.plat_id_offset, PFM_V2.manifest.plat_id_len, sizeof (buffer), 0);
+
+	status = manifest_flash_read_element_data (&manifest.test, &manifest.hash.base,
+		MANIFEST_PLATFORM_ID, PFM_V2.manifest.plat_id_entry, MANIFEST_NO_PARENT, 0, &found, NULL, NULL, &element,
+		sizeof (buffer));
+	CuAssertIntEquals (test, PFM_V2.manifest.plat_id_len, status);
+	CuAssertIntEquals (test, PFM_V2.manifest.plat_id_entry, found);
+
+	status = testing_validate_array (PFM_V2.manifest.plat_id, buffer, status);
+	CuAssertIntEquals (test, 0, status);
+
+	manifest_flash_v2_testing_read_element_resume (test, &manifest, &PFM_V2.manifest,
+		PFM_V2.manifest.plat_id_entry, PFM_V2.manifest.plat_id_entry, PFM_V2.manifest.plat_id_entry, PFM_V2.manifest.plat_id_hash,
+		PFM_V2.manifest.plat_id_offset, PFM_V2.manifest.plat_id_len, sizeof (buffer), 0);
+
+	status = manifest_flash_read_element_data (&manifest.test, &manifest.hash.base,
+		MANIFEST_PLATFORM_ID, PFM_V2.manifest.plat_id_entry, MANIFEST_NO_PARENT, 0, &found, NULL, NULL, &element,
+		sizeof (buffer));
+	CuAssertIntEquals (test, PFM_V2.manifest.plat_id_len, status);
+	CuAssertIntEquals (test, PFM_V2.manifest.plat_id_entry, found);
+
+	status = testing_validate_array (PFM_V2.manifest.plat_id, buffer, status);
+	CuAssertIntEquals (test, 0, status);
+
+	manifest_flash_v2_testing_validate_and_release (test, &manifest);
+}
+
+static void manifest_flash_v2_test_read_element_data_toc_hash_state_later_entry (CuTest *test)
+{
+	struct manifest_flash_v2_testing manifest;
+	struct hash_saved_state toc_state;
+	int status;
+	uint8_t buffer[PFM_V2.manifest.plat_id_len];
+	uint8_t *element = buffer;
+	uint8_t found = 0xff;
+
+	TEST_START;
+
+	manifest_flash_v2_testing_init_and_verify (test, &manifest, 0x10000, PFM_MAGIC_NUM,
+		PFM_V2_MAGIC_NUM, &PFM_V2.manifest, 0, false, 0);
+
+	status = manifest_flash_enable_toc_hash_state (&manifest.test, &toc_state);
+	CuAssertIntEquals (test, 0, status);
+
+	manifest_flash_v2_testing_read_element_resume (test, &manifest, &PFM_V2.manifest,
+		PFM_V2.manifest.plat_id_entry, 0, 0, PFM_V2.manifest.plat_id_hash,
+		PFM_V2.manifest.plat_id_offset, PFM_V2.manifest.plat_id_len, sizeof (buffer), 0);
+
+	status = manifest_flash_read_element_data (&manifest.test, &manifest.hash.base,
+		MANIFEST_PLATFORM_ID, 0, MANIFEST_NO_PARENT, 0, &found, NULL, NULL, &element,
+		sizeof (buffer));
+	CuAssertIntEquals (test, PFM_V2.manifest.plat_id_len, status);
+	CuAssertIntEquals (test, PFM_V2.manifest.plat_id_entry, found);
+
+	status = testing_validate_array (PFM_V2.manifest.plat_id, buffer, status);
+	CuAssertIntEquals (test, 0, status);
+
+	manifest_flash_v2_testing_read_element_resume (test, &manifest, &PFM_V2.manifest,
+		PFM_V2.manifest.plat_id_entry, PFM_V2.manifest.plat_id_entry, 0, PFM_V2.manifest.plat_id_hash,
+		PFM_V2.manifest.plat_id_offset, PFM_V2.manifest.plat_id_len, sizeof (buffer), 0);
+
+	status = manifest_flash_read_element_data (&manifest.test, &manifest.hash.base,
+		MANIFEST_PLATFORM_ID, PFM_V2.manifest.plat_id_entry, MANIFEST_NO_PARENT, 0, &found, NULL, NULL, &element,
+		sizeof (buffer));
+	CuAssertIntEquals (test, PFM_V2.manifest.plat_id_len, status);
+	CuAssertIntEquals (test, PFM_V2.manifest.plat_id_entry, found);
+
+	status = testing_validate_array (PFM_V2.manifest.plat_id, buffer, status);
+	CuAssertIntEquals (test, 0, status);
+
+	manifest_flash_v2_testing_read_element_resume (test, &manifest, &PFM_V2.manifest,
+		PFM_V2.manifest.plat_id_entry, PFM_V2.manifest.plat_id_entry, PFM_V2.manifest.plat_id_entry, PFM_V2.manifest.plat_id_hash,
+		PFM_V2.manifest.plat_id_offset, PFM_V2.manifest.plat_id_len, sizeof (buffer), 0);
+
+	status = manifest_flash_read_element_data (&manifest.test, &manifest.hash.base,
+		MANIFEST_PLATFORM_ID, PFM_V2.manifest.plat_id_entry, MANIFEST_NO_PARENT, 0, &found, NULL, NULL, &element,
+		sizeof (buffer));
+	CuAssertIntEquals (test, PFM_V2.manifest.plat_id_len, status);
+	CuAssertIntEquals (test, PFM_V2.manifest.plat_id_entry, found);
+
+	status = testing_validate_array (PFM_V2.manifest.plat_id, buffer, status);
+	CuAssertIntEquals (test, 0, status);
+
+	manifest_flash_v2_testing_validate_and_release (test, &manifest);
+}
+
+static void manifest_flash_v2_test_read_element_data_toc_hash_state_earlier_entry (CuTest *test)
+{
+	struct manifest_flash_v2_testing manifest;
+	struct hash_saved_state toc_state;
+	int status;
+	uint8_t buffer[PFM_V2.manifest.plat_id_len];
+	uint8_t *element = buffer;
+	uint8_t found = 0xff;
+
+	TEST_START;
+
+	manifest_flash_v2_testing_init_and_verify (test, &manifest, 0x10000, PFM_MAGIC_NUM,
+		PFM_V2_MAGIC_NUM, &PFM_V2.manifest, 0, false, 0);
+
+	status = manifest_flash_enable_toc_hash_state (&manifest.test, &toc_state);
+	CuAssertIntEquals (test, 0, status);
+
+	manifest_flash_v2_testing_read_element_resume (test, &manifest, &PFM_V2.manifest,
+		PFM_V2.manifest.plat_id_entry, PFM_V2.manifest.plat_id_entry, 0, PFM_V2.manifest.plat_id_hash,
+		PFM_V2.manifest.plat_id_offset, PFM_V2.manifest.plat_id_len, sizeof (buffer), 0);
+
+	status = manifest_flash_read_element_data (&manifest.test, &manifest.hash.base,
+		MANIFEST_PLATFORM_ID, PFM_V2.manifest.plat_id_entry, MANIFEST_NO_PARENT, 0, &found, NULL, NULL, &element,
+		sizeof (buffer));
+	CuAssertIntEquals (test, PFM_V2.manifest.plat_id_len, status);
+	CuAssertIntEquals (test, PFM_V2.manifest.plat_id_entry, found);
+
+	status = testing_validate_array (PFM_V2.manifest.plat_id, buffer, status);
+	CuAssertIntEquals (test, 0, status);
+
+	manifest_flash_v2_testing_read_element_resume (test, &manifest, &PFM_V2.manifest,
+		PFM_V2.manifest.plat_id_entry, 0, 0, PFM_V2.manifest.plat_id_hash,
+		PFM_V2.manifest.plat_id_offset, PFM_V2.manifest.plat_id_len, sizeof (buffer), 0);
+
+	status = manifest_flash_read_element_data (&manifest.test, &manifest.hash.base,
+		MANIFEST_PLATFORM_ID, 0, MANIFEST_NO_PARENT, 0, &found, NULL, NULL, &element,
+		sizeof (buffer));
+	CuAssertIntEquals (test, PFM_V2.manifest.plat_id_len, status);
+	CuAssertIntEquals (test, PFM_V2.manifest.plat_id_entry, found);
+
+	status = testing_validate_array (PFM_V2.manifest.plat_id, buffer, status);
+	CuAssertIntEquals (test, 0, status);
+
+	manifest_flash_v2_testing_read_element_resume (test, &manifest, &PFM_V2.manifest,
+		PFM_V2.manifest.plat_id_entry, PFM_V2.manifest.plat_id_entry, 0, PFM_V2.manifest.plat_id_hash,
+		PFM_V2.manifest.plat_id_offset, PFM_V2.manifest.plat_id_len, sizeof (buffer), 0);
+
+	status = manifest_flash_read_element_data (&manifest.test, &manifest.hash.base,
+		MANIFEST_PLATFORM_ID, PFM_V2.manifest.plat_id_entry, MANIFEST_NO_PARENT, 0, &found, NULL, NULL, &element,
+		sizeof (buffer));
+	CuAssertIntEquals (test, PFM_V2.manifest.plat_id_len, status);
+	CuAssertIntEquals (test, PFM_V2.manifest.plat_id_entry, found);
+
+	status = testing_validate_array (PFM_V2.manifest.plat_id, buffer, status);
+	CuAssertIntEquals (test, 0, status);
+
+	manifest_flash_v2_testing_validate_and_release (test, &manifest);
+}
+
+static void manifest_flash_v2_test_read_element_data_toc_hash_state_verify_manifest (CuTest *test)
+{
+	struct manifest_flash_v2_testing manifest;
+	struct hash_saved_state toc_state;
+	int status;
+	uint8_t buffer[PFM_V2.manifest.plat_id_len];
+	uint8_t *element = buffer;
+	uint8_t found = 0xff;
+
+	TEST_START;
+
+	manifest_flash_v2_testing_init_and_verify (test, &manifest, 0x10000, PFM_MAGIC_NUM,
+		PFM_V2_MAGIC_NUM, &PFM_V2.manifest, 0, false, 0);
+
+	status = manifest_flash_enable_toc_hash_state (&manifest.test, &toc_state);
+	CuAssertIntEquals (test, 0, status);
+
+	manifest_flash_v2_testing_read_element_resume (test, &manifest, &PFM_V2.manifest,
+		PFM_V2.manifest.plat_id_entry, PFM_V2.manifest.plat_id_entry, 0, PFM_V2.manifest.plat_id_hash,
+		PFM_V2.manifest.plat_id_offset, PFM_V2.manifest.plat_id_len, sizeof (buffer), 0);
+
+	status = manifest_flash_read_element_data (&manifest.test, &manifest.hash.base,
+		MANIFEST_PLATFORM_ID, PFM_V2.manifest.plat_id_entry, MANIFEST_NO_PARENT, 0, &found, NULL, NULL, &element,
+		sizeof (buffer));
+	CuAssertIntEquals (test, PFM_V2.manifest.plat_id_len, status);
+	CuAssertIntEquals (test, PFM_V2.manifest.plat_id_entry, found);
+
+	status = testing_validate_array (PFM_V2.manifest.plat_id, buffer, status);
+	CuAssertIntEquals (test, 0, status);
+
+	manifest_flash_v2_testing_verify_manifest (test, &manifest, &PFM_V2.manifest, 0);
+
+	status = manifest_flash_verify (&manifest.test, &manifest.hash.base,
+		&manifest.verification.base, NULL, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	manifest_flash_v2_testing_read_element_resume (test, &manifest, &PFM_V2.manifest,
+		PFM_V2.manifest.plat_id_entry, PFM_V2.manifest.plat_id_entry, 0, PFM_V2.manifest.plat_id_hash,
+		PFM_V2.manifest.plat_id_offset, PFM_V2.manifest.plat_id_len, sizeof (buffer), 0);
+
+	status = manifest_flash_read_element_data (&manifest.test, &manifest.hash.base,
+		MANIFEST_PLATFORM_ID, PFM_V2.manifest.plat_id_entry, MANIFEST_NO_PARENT, 0, &found, NULL, NULL, &element,
+		sizeof (buffer));
+	CuAssertIntEquals (test, PFM_V2.manifest.plat_id_len, status);
+	CuAssertIntEquals (test, PFM_V2.manifest.plat_id_entry, found);
+
+	status = testing_validate_array (PFM_V2.manifest.plat_id, buffer, status);
+	CuAssertIntEquals (test, 0, status);
+
+	manifest_flash_v2_testing_validate_and_release (test, &manifest);
+}
+
+static void manifest_flash_v2_test_read_element_data_toc_hash_state_other_hash (CuTest *test)
+{
+	struct manifest_flash_v2_testing manifest;
+	struct hash_saved_state toc_state;
+	HASH_TESTING_ENGINE hash;
+	int status;
+	uint8_t buffer[PFM_V2.manifest.plat_id_len];
+	uint8_t *element = buffer;
+	uint8_t found = 0xff;
+
+	TEST_START;
+
+	status = HASH_TESTING_ENGINE_INIT (&hash);
+	CuAssertIntEquals (test, 0, status);
+
+	manifest_flash_v2_testing_init_and_verify (test, &manifest, 0x10000, PFM_MAGIC_NUM,
+		PFM_V2_MAGIC_NUM, &PFM_V2.manifest, 0, false, 0);
+
+	status = manifest_flash_enable_toc_hash_state (&manifest.test, &toc_state);
+	CuAssertIntEquals (test, 0, status);
+
+	manifest_flash_v2_testing_read_element_resume (test, &manifest, &PFM_V2.manifest,
+		PFM_V2.manifest.plat_id_entry, PFM_V2.manifest.plat_id_entry, 0, PFM_V2.manifest.plat_id_hash,
+		PFM_V2.manifest.plat_id_offset, PFM_V2.manifest.plat_id_len, sizeof (buffer), 0);
+
+	status = manifest_flash_read_element_data (&manifest.test, &manifest.hash.base,
+		MANIFEST_PLATFORM_ID, PFM_V2.manifest.plat_id_entry, MANIFEST_NO_PARENT, 0, &found, NULL, NULL, &element,
+		sizeof (buffer));
+	CuAssertIntEquals (test, PFM_V2.manifest.plat_id_len, status);
+	CuAssertIntEquals (test, PFM_V2.manifest.plat_id_entry, found);
+
+	status = testing_validate_array (PFM_V2.manifest.plat_id, buffer, status);
+	CuAssertIntEquals (test, 0, status);
+
+	/* A different hash engine will not use the saved state. */
+	manifest_flash_v2_testing_read_element_resume (test, &manifest, &PFM_V2.manifest,
+		PFM_V2.manifest.plat_id_entry, PFM_V2.manifest.plat_id_entry, 0, PFM_V2.manifest.plat_id_hash,
+		PFM_V2.manifest.plat_id_offset, PFM_V2.manifest.plat_id_len, sizeof (buffer), 0);
+
+	status = manifest_flash_read_element_data (&manifest.test, &hash.base,
+		MANIFEST_PLATFORM_ID, PFM_V2.manifest.plat_id_entry, MANIFEST_NO_PARENT, 0, &found, NULL,
+		NULL, &element, sizeof (buffer));
+	CuAssertIntEquals (test, PFM_V2.manifest.plat_id_len, status);
+	CuAssertIntEquals (test, PFM_V2.manifest.plat_id_entry, found);
+
+	status = testing_validate_array (PFM_V2.manifest.plat_id, buffer, status);
+	CuAssertIntEquals (test, 0, status);
+
+	manifest_flash_v2_testing_validate_and_release (test, &manifest);
+
+	HASH_TESTING_ENGINE_RELEASE (&hash);
+}
+
+static void manifest_flash_v2_test_read_element_data_toc_hash_state_not_supported (CuTest *test)
+{
+	struct manifest_flash_v2_testing manifest;
+	struct hash_saved_state toc_state;
+	int status;
+	uint8_t buffer[PFM_V2.manifest.plat_id_len];
+	uint8_t *element = buffer;
+	uint8_t found = 0xff;
+
+	TEST_START;
+
+	manifest_flash_v2_testing_init_and_verify (test, &manifest, 0x10000, PFM_MAGIC_NUM,
+		PFM_V2_MAGIC_NUM, &PFM_V2.manifest, 0, false, 0);
+
+	manifest.hash.base.save_state = NULL;
+	manifest.hash.base.restore_state = NULL;
+
+	status = manifest_flash_enable_toc_hash_state (&manifest.test, &toc_state);
+	CuAssertIntEquals (test, 0, status);
+
+	manifest_flash_v2_testing_read_element_resume (test, &manifest, &PFM_V2.manifest,
+		PFM_V2.manifest.plat_id_entry, PFM_V2.manifest.plat_id_entry, 0, PFM_V2.manifest.plat_id_hash,
+		PFM_V2.manifest.plat_id_offset, PFM_V2.manifest.plat_id_len, sizeof (buffer), 0);
+
+	status = manifest_flash_read_element_data (&manifest.test, &manifest.hash.base,
+		MANIFEST_PLATFORM_ID, PFM_V2.manifest.plat_id_entry, MANIFEST_NO_PARENT, 0, &found, NULL, NULL, &element,
+		sizeof (buffer));
+	CuAssertIntEquals (test, PFM_V2.manifest.plat_id_len, status);
+	CuAssertIntEquals (test, PFM_V2.manifest.plat_id_entry, found);
+
+	status = testing_validate_array (PFM_V2.manifest.plat_id, buffer, status);
+	CuAssertIntEquals (test, 0, status);
+
+	manifest_flash_v2_testing_read_element_resume (test, &manifest, &PFM_V2.manifest,
+		PFM_V2.manifest.plat_id_entry, PFM_V2.manifest.plat_id_entry, 0, PFM_V2.manifest.plat_id_hash,
+		PFM_V2.manifest.plat_id_offset, PFM_V2.manifest.plat_id_len, sizeof (buffer), 0);
+
+	status = manifest_flash_read_element_data (&manifest.test, &manifest.hash.base,
+		MANIFEST_PLATFORM_ID, PFM_V2.manifest.plat_id_entry, MANIFEST_NO_PARENT, 0, &found, NULL, NULL, &element,
+		sizeof (buffer));
+	CuAssertIntEquals (test, PFM_V2.manifest.plat_id_len, status);
+	CuAssertIntEquals (test, PFM_V2.manifest.plat_id_entry, found);
+
+	status = testing_validate_array (PFM_V2.manifest.plat_id, buffer, status);
+	CuAssertIntEquals (test, 0, status);
+
+	manifest_flash_v2_testing_validate_and_release (test, &manifest);
+}
+
+static void manifest_flash_v2_test_read_element_data_toc_hash_state_restore_failed (CuTest *test)
+{
+	struct manifest_flash_v2_testing manifest;
+	struct hash_saved_state toc_state;
+	int status;
+	uint8_t buffer[PFM_V2.manifest.plat_id_len];
+	uint8_t *element = buffer;
+	uint8_t found = 0xff;
+
+	TEST_START;
+
+	manifest_flash_v2_testing_init_and_verify (test, &manifest, 0x10000, PFM_MAGIC_NUM,
+		PFM_V2_MAGIC_NUM, &PFM_V2.manifest, 0, false, 0);
+
+	status = manifest_flash_enable_toc_hash_state (&manifest.test, &toc_state);
+	CuAssertIntEquals (test, 0, status);
+
+	manifest_flash_v2_testing_read_element_resume (test, &manifest, &PFM_V2.manifest,
+		PFM_V2.manifest.plat_id_entry, PFM_V2.manifest.plat_id_entry, 0,
+		PFM_V2.manifest.plat_id_hash, PFM_V2.manifest.plat_id_offset, PFM_V2.manifest.plat_id_len,
+		sizeof (buffer), 0);
+
+	status = manifest_flash_read_element_data (&manifest.test, &manifest.hash.base,
+		MANIFEST_PLATFORM_ID, PFM_V2.manifest.plat_id_entry, MANIFEST_NO_PARENT, 0, &found, NULL,
+		NULL, &element, sizeof (buffer));
+	CuAssertIntEquals (test, PFM_V2.manifest.plat_id_len, status);
+	CuAssertIntEquals (test, PFM_V2.manifest.plat_id_entry, found);
+
+	status = testing_validate_array (PFM_V2.manifest.plat_id, buffer, status);
+	CuAssertIntEquals (test, 0, status);
+
+	/* The saved state can't be restored, so the TOC is hashed from the beginning. */
+	manifest.hash.base.restore_state = manifest_flash_v2_testing_restore_state_failed;
+
+	manifest_flash_v2_testing_read_element_resume (test, &manifest, &PFM_V2.manifest,
+		PFM_V2.manifest.plat_id_entry, PFM_V2.manifest.plat_id_entry, 0,
+		PFM_V2.manifest.plat_id_hash, PFM_V2.manifest.plat_id_offset, PFM_V2.manifest.plat_id_len,
+		sizeof (buffer), 0);
+
+	status = manifest_flash_read_element_data (&manifest.test, &manifest.hash.base,
+		MANIFEST_PLATFORM_ID, PFM_V2.manifest.plat_id_entry, MANIFEST_NO_PARENT, 0, &found, NULL,
+		NULL, &element, sizeof (buffer));
+	CuAssertIntEquals (test, PFM_V2.manifest.plat_id_len, status);
+	CuAssertIntEquals (test, PFM_V2.manifest.plat_id_entry, found);
+
+	status = testing_validate_array (PFM_V2.manifest.plat_id, buffer, status);
+	CuAssertIntEquals (test, 0, status);
+
+	manifest_flash_v2_testing_validate_and_release (test, &manifest);
+}
+
+static void manifest_flash_v2_test_get_child_elements_info_toc_hash_state (CuTest *test)
+{
+	struct manifest_flash_v2_testing manifest;
+	struct hash_saved_state toc_state;
+	int num_child;
+	int status;
+
+	TEST_START;
+
+	manifest_flash_v2_testing_init_and_verify (test, &manifest, 0x10000, CFM_MAGIC_NUM,
+		CFM_V2_MAGIC_NUM, &CFM_TESTING.manifest, 0, false, 0);
+
+	status = manifest_flash_enable_toc_hash_state (&manifest.test, &toc_state);
+	CuAssertIntEquals (test, 0, status);
+
+	manifest_flash_v2_testing_iterate_manifest_toc (test, &manifest, &CFM_TESTING.manifest, 2, 26);
+
+	status = manifest_flash_get_child_elements_info (&manifest.test, &manifest.hash.base, 2,
+		CFM_COMPONENT_DEVICE, MANIFEST_NO_PARENT, CFM_ROOT_CA, NULL, &num_child, NULL);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, num_child);
+
+	manifest_flash_v2_testing_iterate_manifest_toc_resume (test, &manifest, &CFM_TESTING.manifest,
+		2, 2, 26);
+
+	status = manifest_flash_get_child_elements_info (&manifest.test, &manifest.hash.base, 2,
+		CFM_COMPONENT_DEVICE, MANIFEST_NO_PARENT, CFM_ROOT_CA, NULL, &num_child, NULL);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, num_child);
+
+	manifest_flash_v2_testing_validate_and_release (test, &manifest);
+}
+
 static void manifest_flash_v2_test_get_child_elements_info_no_num_child (CuTest *test)
 {
 	struct manifest_flash_v2_testing manifest;
@@ -8914,6 +9398,15 @@ TEST (manifest_flash_v2_test_compare_platform_id_no_manifests);
 TEST (manifest_flash_v2_test_compare_platform_id_null_manifest1);
 TEST (manifest_flash_v2_test_compare_platform_id_null_manifest2);
 TEST (manifest_flash_v2_test_compare_platform_id_both_null);
+TEST (manifest_flash_v2_test_enable_toc_hash_state_null);
+TEST (manifest_flash_v2_test_read_element_data_toc_hash_state);
+TEST (manifest_flash_v2_test_read_element_data_toc_hash_state_later_entry);
+TEST (manifest_flash_v2_test_read_element_data_toc_hash_state_earlier_entry);
+TEST (manifest_flash_v2_test_read_element_data_toc_hash_state_verify_manifest);
+TEST (manifest_flash_v2_test_read_element_data_toc_hash_state_other_hash);
+TEST (manifest_flash_v2_test_read_element_data_toc_hash_state_not_supported);
+TEST (manifest_flash_v2_test_read_element_data_toc_hash_state_restore_failed);
+TEST (manifest_flash_v2_test_get_child_elements_info_toc_hash_state);
 TEST (manifest_flash_v2_test_get_child_elements_info_no_num_child);
 TEST (manifest_flash_v2_test_get_child_elements_info_only_num_child);
 TEST (manifest_flash_v2_test_get_child_elements_info_no_child_len);
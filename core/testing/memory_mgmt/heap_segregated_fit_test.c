@@ -0,0 +1,1301 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "testing.h"
+#include "memory_mgmt/heap_segregated_fit.h"
+
+
+TEST_SUITE_LABEL ("heap_segregated_fit");
+
+
+static size_t heap[1024];
+static struct heap_segregated_fit_stats stats;
+
+/**
+ * Usable size of the single free block in an empty heap.
+ */
+#define	HEAP_SEGREGATED_FIT_TESTING_EMPTY_SIZE	\
+	(sizeof (heap) - (2 * HEAP_SEGREGATED_FIT_BLOCK_HEADER_LEN))
+
+/**
+ * Operations in a recorded allocation trace.
+ */
+enum heap_segregated_fit_testing_trace_op {
+	TRACE_ALLOC,		/**< Allocate a block into a slot. */
+	TRACE_CALLOC,		/**< Allocate a zeroized block into a slot. */
+	TRACE_REALLOC,		/**< Resize the block in a slot. */
+	TRACE_FREE,			/**< Free the block in a slot. */
+};
+
+/**
+ * A single entry in a recorded allocation trace.
+ */
+struct heap_segregated_fit_testing_trace {
+	enum heap_segregated_fit_testing_trace_op op;	/**< The heap operation. */
+	int slot;										/**< The slot holding the block. */
+	size_t size;									/**< Requested size of the block. */
+};
+
+/**
+ * Allocation sequence recorded from the attestation requester fetching and authenticating a
+ * certificate chain, then collecting measurements, for two devices in parallel.
+ */
+static const struct heap_segregated_fit_testing_trace HEAP_SEGREGATED_FIT_TESTING_ATTESTATION[] = {
+	{TRACE_ALLOC, 0, 1024},			/* Device 1 cert buffer. */
+	{TRACE_ALLOC, 1, 1024},			/* Device 2 cert buffer. */
+	{TRACE_REALLOC, 0, 1536},
+	{TRACE_CALLOC, 2, 48},			/* Device 1 digests list. */
+	{TRACE_REALLOC, 1, 1300},
+	{TRACE_CALLOC, 3, 48},			/* Device 2 digests list. */
+	{TRACE_ALLOC, 4, 320},			/* x509 CA store. */
+	{TRACE_ALLOC, 5, 96},			/* TOC element buffer. */
+	{TRACE_FREE, 5, 0},
+	{TRACE_ALLOC, 6, 72},
+	{TRACE_FREE, 0, 0},
+	{TRACE_ALLOC, 0, 512},
+	{TRACE_FREE, 4, 0},
+	{TRACE_ALLOC, 4, 320},
+	{TRACE_ALLOC, 5, 12},
+	{TRACE_FREE, 2, 0},
+	{TRACE_REALLOC, 0, 900},
+	{TRACE_FREE, 6, 0},
+	{TRACE_ALLOC, 6, 200},
+	{TRACE_FREE, 1, 0},
+	{TRACE_FREE, 5, 0},
+	{TRACE_ALLOC, 1, 1024},
+	{TRACE_CALLOC, 2, 48},
+	{TRACE_REALLOC, 1, 64},
+	{TRACE_FREE, 3, 0},
+	{TRACE_FREE, 4, 0},
+	{TRACE_ALLOC, 3, 2000},
+	{TRACE_FREE, 0, 0},
+	{TRACE_FREE, 6, 0},
+	{TRACE_FREE, 2, 0},
+	{TRACE_FREE, 1, 0},
+	{TRACE_FREE, 3, 0},
+};
+
+#define	HEAP_SEGREGATED_FIT_TESTING_ATTESTATION_LEN		\
+	(sizeof (HEAP_SEGREGATED_FIT_TESTING_ATTESTATION) / sizeof (HEAP_SEGREGATED_FIT_TESTING_ATTESTATION[0]))
+
+
+/**
+ * Helper function to verify heap allocator stats after all allocations have been freed
+ *
+ * @param test The test framework
+ */
+static void heap_segregated_fit_testing_check_stats_empty (CuTest *test)
+{
+	int status;
+
+	status = heap_segregated_fit_get_stats (&stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, stats.num_allocated_blocks);
+	CuAssertIntEquals (test, 0, stats.total_allocated_size);
+	CuAssertIntEquals (test, 0, stats.total_allocated_size_w_overhead);
+	CuAssertIntEquals (test, 1, stats.num_free_blocks);
+	CuAssertIntEquals (test, HEAP_SEGREGATED_FIT_TESTING_EMPTY_SIZE, stats.total_free_size);
+	CuAssertIntEquals (test, sizeof (heap) - HEAP_SEGREGATED_FIT_BLOCK_HEADER_LEN,
+		stats.total_free_size_w_overhead);
+	CuAssertIntEquals (test, HEAP_SEGREGATED_FIT_TESTING_EMPTY_SIZE, stats.largest_free_block);
+}
+
+/**
+ * Helper function to verify heap allocator stats after n constant size allocations with no freed
+ * blocks.
+ *
+ * @param test The test framework
+ * @param num_allocation Number of constant size allocations
+ * @param allocation_size Constant allocation size
+ */
+static void heap_segregated_fit_testing_check_stats_constant_size_alloc (CuTest *test,
+	int num_allocation, size_t allocation_size)
+{
+	int status;
+
+	status = heap_segregated_fit_get_stats (&stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, num_allocation, stats.num_allocated_blocks);
+	CuAssertIntEquals (test, num_allocation * allocation_size, stats.total_allocated_size);
+	CuAssertIntEquals (test,
+		stats.total_allocated_size + num_allocation * HEAP_SEGREGATED_FIT_BLOCK_HEADER_LEN,
+		stats.total_allocated_size_w_overhead);
+	CuAssertIntEquals (test, 1, stats.num_free_blocks);
+	CuAssertIntEquals (test,
+		HEAP_SEGREGATED_FIT_TESTING_EMPTY_SIZE - stats.total_allocated_size_w_overhead,
+		stats.total_free_size);
+	CuAssertIntEquals (test,
+		sizeof (heap) - HEAP_SEGREGATED_FIT_BLOCK_HEADER_LEN -
+			stats.total_allocated_size_w_overhead,
+		stats.total_free_size_w_overhead);
+	CuAssertIntEquals (test, stats.total_free_size, stats.largest_free_block);
+}
+
+/**
+ * Helper function to verify memory block contents
+ *
+ * @param test The test framework
+ * @param value Value memory block contents should all be at
+ * @param block Pointer to beginning of block
+ * @param size Size of memory block
+ */
+static void heap_segregated_fit_testing_check_value (CuTest *test, uint8_t value, uint8_t *block,
+	size_t size)
+{
+	for (size_t i = 0; i < size; ++i) {
+		CuAssertIntEquals (test, value, block[i]);
+	}
+}
+
+/**
+ * Helper function to replay a recorded allocation trace against the heap.  Each block is filled
+ * with a pattern unique to its slot, which is checked before the block is resized or freed.
+ *
+ * @param test The test framework
+ * @param trace The trace to replay
+ * @param length Number of entries in the trace
+ * @param blocks Output for the blocks held in each slot
+ * @param sizes Output for the requested size of each slot
+ */
+static void heap_segregated_fit_testing_replay_trace (CuTest *test,
+	const struct heap_segregated_fit_testing_trace *trace, size_t length, uint8_t **blocks,
+	size_t *sizes)
+{
+	size_t i;
+	int slot;
+
+	for (i = 0; i < length; i++) {
+		slot = trace[i].slot;
+
+		switch (trace[i].op) {
+			case TRACE_ALLOC:
+				blocks[slot] = heap_segregated_fit_allocate (trace[i].size);
+				CuAssertPtrNotNull (test, blocks[slot]);
+				break;
+
+			case TRACE_CALLOC:
+				blocks[slot] = heap_segregated_fit_allocate_zeroize (1, trace[i].size);
+				CuAssertPtrNotNull (test, blocks[slot]);
+				heap_segregated_fit_testing_check_value (test, 0, blocks[slot], trace[i].size);
+				break;
+
+			case TRACE_REALLOC:
+				heap_segregated_fit_testing_check_value (test, slot, blocks[slot], sizes[slot]);
+				blocks[slot] = heap_segregated_fit_reallocate (blocks[slot], trace[i].size);
+				CuAssertPtrNotNull (test, blocks[slot]);
+				heap_segregated_fit_testing_check_value (test, slot, blocks[slot],
+					(sizes[slot] < trace[i].size) ? sizes[slot] : trace[i].size);
+				break;
+
+			case TRACE_FREE:
+				heap_segregated_fit_testing_check_value (test, slot, blocks[slot], sizes[slot]);
+				heap_segregated_fit_free (blocks[slot]);
+				blocks[slot] = NULL;
+				break;
+		}
+
+		if (blocks[slot] != NULL) {
+			CuAssertIntEquals (test, 0,
+				((uintptr_t) blocks[slot]) & (HEAP_SEGREGATED_FIT_ALIGNMENT - 1));
+
+			sizes[slot] = trace[i].size;
+			memset (blocks[slot], slot, sizes[slot]);
+		}
+	}
+}
+
+
+/*******************
+ * Test cases
+ *******************/
+
+static void heap_segregated_fit_test_macros (CuTest *test)
+{
+	struct heap_segregated_fit_block block;
+
+	TEST_START;
+
+	CuAssertIntEquals (test, 2 * sizeof (void*), HEAP_SEGREGATED_FIT_BLOCK_HEADER_LEN);
+	CuAssertIntEquals (test, 2 * sizeof (void*), HEAP_SEGREGATED_FIT_MIN_BLOCK_SIZE);
+	CuAssertPtrEquals (test, &block,
+		heap_segregated_fit_get_block_header (((uint8_t*) &block) +
+			HEAP_SEGREGATED_FIT_BLOCK_HEADER_LEN));
+}
+
+static void heap_segregated_fit_test_init (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = heap_segregated_fit_init (heap, sizeof (heap));
+	CuAssertIntEquals (test, 0, status);
+
+	heap_segregated_fit_testing_check_stats_empty (test);
+
+	heap_segregated_fit_release ();
+}
+
+static void heap_segregated_fit_test_init_unaligned_heap (CuTest *test)
+{
+	uint8_t *unaligned = ((uint8_t*) heap) + 1;
+	int status;
+
+	TEST_START;
+
+	status = heap_segregated_fit_init (unaligned, sizeof (heap) - 1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = heap_segregated_fit_get_stats (&stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, stats.num_allocated_blocks);
+	CuAssertIntEquals (test, 1, stats.num_free_blocks);
+	CuAssertIntEquals (test,
+		sizeof (heap) - HEAP_SEGREGATED_FIT_ALIGNMENT - (2 * HEAP_SEGREGATED_FIT_BLOCK_HEADER_LEN),
+		stats.total_free_size);
+
+	heap_segregated_fit_release ();
+}
+
+static void heap_segregated_fit_test_init_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = heap_segregated_fit_init (NULL, sizeof (heap));
+	CuAssertIntEquals (test, HEAP_SEGREGATED_FIT_INVALID_ARGUMENT, status);
+
+	status = heap_segregated_fit_init (heap, 2 * HEAP_SEGREGATED_FIT_BLOCK_HEADER_LEN);
+	CuAssertIntEquals (test, HEAP_SEGREGATED_FIT_INVALID_ARGUMENT, status);
+
+	status = heap_segregated_fit_init (heap,
+		(2 * HEAP_SEGREGATED_FIT_BLOCK_HEADER_LEN) + HEAP_SEGREGATED_FIT_MIN_BLOCK_SIZE);
+	CuAssertIntEquals (test, HEAP_SEGREGATED_FIT_INVALID_ARGUMENT, status);
+}
+
+static void heap_segregated_fit_test_init_heap_too_large (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = heap_segregated_fit_init (heap,
+		(((size_t) 1) << HEAP_SEGREGATED_FIT_MAX_BLOCK_SIZE_LOG2) +
+			(2 * HEAP_SEGREGATED_FIT_BLOCK_HEADER_LEN));
+	CuAssertIntEquals (test, HEAP_SEGREGATED_FIT_HEAP_TOO_LARGE, status);
+}
+
+static void heap_segregated_fit_test_init_thread_safe (CuTest *test)
+{
+	uint8_t *block;
+	int status;
+
+	TEST_START;
+
+	status = heap_segregated_fit_init_thread_safe (heap, sizeof (heap));
+	CuAssertIntEquals (test, 0, status);
+
+	heap_segregated_fit_testing_check_stats_empty (test);
+
+	block = heap_segregated_fit_allocate (100);
+	CuAssertPtrNotNull (test, block);
+
+	block = heap_segregated_fit_reallocate (block, 200);
+	CuAssertPtrNotNull (test, block);
+
+	heap_segregated_fit_testing_check_stats_constant_size_alloc (test, 1, 200);
+
+	heap_segregated_fit_free (block);
+
+	heap_segregated_fit_testing_check_stats_empty (test);
+
+	heap_segregated_fit_release ();
+}
+
+static void heap_segregated_fit_test_init_thread_safe_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = heap_segregated_fit_init_thread_safe (NULL, sizeof (heap));
+	CuAssertIntEquals (test, HEAP_SEGREGATED_FIT_INVALID_ARGUMENT, status);
+}
+
+static void heap_segregated_fit_test_release_twice (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = heap_segregated_fit_init_thread_safe (heap, sizeof (heap));
+	CuAssertIntEquals (test, 0, status);
+
+	heap_segregated_fit_release ();
+	heap_segregated_fit_release ();
+}
+
+static void heap_segregated_fit_test_allocate (CuTest *test)
+{
+	void *block;
+	int status;
+
+	TEST_START;
+
+	status = heap_segregated_fit_init (heap, sizeof (heap));
+	CuAssertIntEquals (test, 0, status);
+
+	block = heap_segregated_fit_allocate (32);
+	CuAssertPtrNotNull (test, block);
+
+	heap_segregated_fit_testing_check_stats_constant_size_alloc (test, 1, 32);
+
+	heap_segregated_fit_free (block);
+
+	heap_segregated_fit_testing_check_stats_empty (test);
+
+	heap_segregated_fit_release ();
+}
+
+static void heap_segregated_fit_test_allocate_unaligned_size (CuTest *test)
+{
+	void *block;
+	int status;
+
+	TEST_START;
+
+	status = heap_segregated_fit_init (heap, sizeof (heap));
+	CuAssertIntEquals (test, 0, status);
+
+	block = heap_segregated_fit_allocate (HEAP_SEGREGATED_FIT_MIN_BLOCK_SIZE + 1);
+	CuAssertPtrNotNull (test, block);
+
+	heap_segregated_fit_testing_check_stats_constant_size_alloc (test, 1,
+		HEAP_SEGREGATED_FIT_MIN_BLOCK_SIZE + HEAP_SEGREGATED_FIT_ALIGNMENT);
+
+	heap_segregated_fit_release ();
+}
+
+static void heap_segregated_fit_test_allocate_small_size (CuTest *test)
+{
+	void *block;
+	int status;
+
+	TEST_START;
+
+	status = heap_segregated_fit_init (heap, sizeof (heap));
+	CuAssertIntEquals (test, 0, status);
+
+	block = heap_segregated_fit_allocate (1);
+	CuAssertPtrNotNull (test, block);
+
+	heap_segregated_fit_testing_check_stats_constant_size_alloc (test, 1,
+		HEAP_SEGREGATED_FIT_MIN_BLOCK_SIZE);
+
+	heap_segregated_fit_release ();
+}
+
+static void heap_segregated_fit_test_allocate_zero (CuTest *test)
+{
+	void *block;
+	int status;
+
+	TEST_START;
+
+	status = heap_segregated_fit_init (heap, sizeof (heap));
+	CuAssertIntEquals (test, 0, status);
+
+	block = heap_segregated_fit_allocate (0);
+	CuAssertPtrNotNull (test, block);
+
+	heap_segregated_fit_testing_check_stats_constant_size_alloc (test, 1,
+		HEAP_SEGREGATED_FIT_MIN_BLOCK_SIZE);
+
+	heap_segregated_fit_release ();
+}
+
+static void heap_segregated_fit_test_allocate_entire_heap (CuTest *test)
+{
+	void *block;
+	int status;
+
+	TEST_START;
+
+	status = heap_segregated_fit_init (heap, sizeof (heap));
+	CuAssertIntEquals (test, 0, status);
+
+	block = heap_segregated_fit_allocate (HEAP_SEGREGATED_FIT_TESTING_EMPTY_SIZE);
+	CuAssertPtrNotNull (test, block);
+
+	CuAssertPtrEquals (test, NULL, heap_segregated_fit_allocate (1));
+
+	status = heap_segregated_fit_get_stats (&stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, stats.num_allocated_blocks);
+	CuAssertIntEquals (test, HEAP_SEGREGATED_FIT_TESTING_EMPTY_SIZE, stats.total_allocated_size);
+	CuAssertIntEquals (test, 0, stats.num_free_blocks);
+	CuAssertIntEquals (test, 0, stats.total_free_size);
+	CuAssertIntEquals (test, 0, stats.largest_free_block);
+
+	heap_segregated_fit_free (block);
+
+	heap_segregated_fit_testing_check_stats_empty (test);
+
+	heap_segregated_fit_release ();
+}
+
+static void heap_segregated_fit_test_allocate_remainder_too_small_to_split (CuTest *test)
+{
+	size_t size = HEAP_SEGREGATED_FIT_TESTING_EMPTY_SIZE - HEAP_SEGREGATED_FIT_BLOCK_HEADER_LEN;
+	void *block;
+	int status;
+
+	TEST_START;
+
+	status = heap_segregated_fit_init (heap, sizeof (heap));
+	CuAssertIntEquals (test, 0, status);
+
+	/* The remaining space can hold a header, but not the minimum block size. */
+	block = heap_segregated_fit_allocate (size);
+	CuAssertPtrNotNull (test, block);
+
+	status = heap_segregated_fit_get_stats (&stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, stats.num_allocated_blocks);
+	CuAssertIntEquals (test, HEAP_SEGREGATED_FIT_TESTING_EMPTY_SIZE, stats.total_allocated_size);
+	CuAssertIntEquals (test, 0, stats.num_free_blocks);
+
+	heap_segregated_fit_free (block);
+
+	heap_segregated_fit_testing_check_stats_empty (test);
+
+	heap_segregated_fit_release ();
+}
+
+static void heap_segregated_fit_test_allocate_multiple_blocks (CuTest *test)
+{
+	uint8_t *block[4];
+	int status;
+	int i;
+
+	TEST_START;
+
+	status = heap_segregated_fit_init (heap, sizeof (heap));
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 4; i++) {
+		block[i] = heap_segregated_fit_allocate (256);
+		CuAssertPtrNotNull (test, block[i]);
+
+		memset (block[i], i + 1, 256);
+	}
+
+	heap_segregated_fit_testing_check_stats_constant_size_alloc (test, 4, 256);
+
+	/* Blocks are carved from the front of the heap. */
+	for (i = 1; i < 4; i++) {
+		CuAssertPtrEquals (test, block[i - 1] + 256 + HEAP_SEGREGATED_FIT_BLOCK_HEADER_LEN,
+			block[i]);
+	}
+
+	for (i = 0; i < 4; i++) {
+		heap_segregated_fit_testing_check_value (test, i + 1, block[i], 256);
+	}
+
+	heap_segregated_fit_free (block[0]);
+	heap_segregated_fit_free (block[1]);
+	heap_segregated_fit_free (block[2]);
+	heap_segregated_fit_free (block[3]);
+
+	heap_segregated_fit_testing_check_stats_empty (test);
+
+	heap_segregated_fit_release ();
+}
+
+static void heap_segregated_fit_test_allocate_reuse_freed_block (CuTest *test)
+{
+	uint8_t *block1;
+	uint8_t *block2;
+	uint8_t *block3;
+	uint8_t *reuse;
+	int status;
+
+	TEST_START;
+
+	status = heap_segregated_fit_init (heap, sizeof (heap));
+	CuAssertIntEquals (test, 0, status);
+
+	block1 = heap_segregated_fit_allocate (128);
+	CuAssertPtrNotNull (test, block1);
+
+	block2 = heap_segregated_fit_allocate (128);
+	CuAssertPtrNotNull (test, block2);
+
+	block3 = heap_segregated_fit_allocate (128);
+	CuAssertPtrNotNull (test, block3);
+
+	heap_segregated_fit_free (block2);
+
+	status = heap_segregated_fit_get_stats (&stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 2, stats.num_allocated_blocks);
+	CuAssertIntEquals (test, 2, stats.num_free_blocks);
+
+	/* The freed block is an exact fit and must be used instead of the larger block. */
+	reuse = heap_segregated_fit_allocate (128);
+	CuAssertPtrEquals (test, block2, reuse);
+
+	heap_segregated_fit_testing_check_stats_constant_size_alloc (test, 3, 128);
+
+	heap_segregated_fit_free (block1);
+	heap_segregated_fit_free (block3);
+	heap_segregated_fit_free (reuse);
+
+	heap_segregated_fit_testing_check_stats_empty (test);
+
+	heap_segregated_fit_release ();
+}
+
+static void heap_segregated_fit_test_allocate_split_freed_block (CuTest *test)
+{
+	uint8_t *block1;
+	uint8_t *block2;
+	uint8_t *block3;
+	uint8_t *reuse;
+	int status;
+
+	TEST_START;
+
+	status = heap_segregated_fit_init (heap, sizeof (heap));
+	CuAssertIntEquals (test, 0, status);
+
+	block1 = heap_segregated_fit_allocate (1024);
+	CuAssertPtrNotNull (test, block1);
+
+	block2 = heap_segregated_fit_allocate (64);
+	CuAssertPtrNotNull (test, block2);
+
+	heap_segregated_fit_free (block1);
+
+	reuse = heap_segregated_fit_allocate (256);
+	CuAssertPtrEquals (test, block1, reuse);
+
+	block3 = heap_segregated_fit_allocate (256);
+	CuAssertPtrEquals (test, block1 + 256 + HEAP_SEGREGATED_FIT_BLOCK_HEADER_LEN, block3);
+
+	status = heap_segregated_fit_get_stats (&stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 3, stats.num_allocated_blocks);
+	CuAssertIntEquals (test, 2, stats.num_free_blocks);
+	CuAssertIntEquals (test, 1024 - 512 - (2 * HEAP_SEGREGATED_FIT_BLOCK_HEADER_LEN) +
+		HEAP_SEGREGATED_FIT_TESTING_EMPTY_SIZE - 1024 - 64 -
+		(2 * HEAP_SEGREGATED_FIT_BLOCK_HEADER_LEN), stats.total_free_size);
+
+	heap_segregated_fit_free (reuse);
+	heap_segregated_fit_free (block2);
+	heap_segregated_fit_free (block3);
+
+	heap_segregated_fit_testing_check_stats_empty (test);
+
+	heap_segregated_fit_release ();
+}
+
+static void heap_segregated_fit_test_allocate_merge_free_neighbors (CuTest *test)
+{
+	uint8_t *block[5];
+	int status;
+	int i;
+
+	TEST_START;
+
+	status = heap_segregated_fit_init (heap, sizeof (heap));
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 5; i++) {
+		block[i] = heap_segregated_fit_allocate (100);
+		CuAssertPtrNotNull (test, block[i]);
+	}
+
+	heap_segregated_fit_free (block[1]);
+	heap_segregated_fit_free (block[3]);
+
+	status = heap_segregated_fit_get_stats (&stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 3, stats.num_allocated_blocks);
+	CuAssertIntEquals (test, 3, stats.num_free_blocks);
+
+	/* Freeing the middle block merges with the free blocks on both sides. */
+	heap_segregated_fit_free (block[2]);
+
+	status = heap_segregated_fit_get_stats (&stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 2, stats.num_allocated_blocks);
+	CuAssertIntEquals (test, 2, stats.num_free_blocks);
+
+	block[1] = heap_segregated_fit_allocate (300 + (2 * HEAP_SEGREGATED_FIT_BLOCK_HEADER_LEN));
+	CuAssertPtrNotNull (test, block[1]);
+
+	status = heap_segregated_fit_get_stats (&stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 3, stats.num_allocated_blocks);
+	CuAssertIntEquals (test, 1, stats.num_free_blocks);
+
+	heap_segregated_fit_free (block[4]);
+	heap_segregated_fit_free (block[0]);
+	heap_segregated_fit_free (block[1]);
+
+	heap_segregated_fit_testing_check_stats_empty (test);
+
+	heap_segregated_fit_release ();
+}
+
+static void heap_segregated_fit_test_allocate_free_in_reverse_order (CuTest *test)
+{
+	uint8_t *block[16];
+	int status;
+	int i;
+
+	TEST_START;
+
+	status = heap_segregated_fit_init (heap, sizeof (heap));
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 16; i++) {
+		block[i] = heap_segregated_fit_allocate (20 * (i + 1));
+		CuAssertPtrNotNull (test, block[i]);
+
+		memset (block[i], i, 20 * (i + 1));
+	}
+
+	for (i = 15; i >= 0; i--) {
+		heap_segregated_fit_testing_check_value (test, i, block[i], 20 * (i + 1));
+		heap_segregated_fit_free (block[i]);
+	}
+
+	heap_segregated_fit_testing_check_stats_empty (test);
+
+	heap_segregated_fit_release ();
+}
+
+static void heap_segregated_fit_test_allocate_no_memory (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = heap_segregated_fit_init (heap, sizeof (heap));
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrEquals (test, NULL,
+		heap_segregated_fit_allocate (HEAP_SEGREGATED_FIT_TESTING_EMPTY_SIZE + 1));
+
+	heap_segregated_fit_testing_check_stats_empty (test);
+
+	heap_segregated_fit_release ();
+}
+
+static void heap_segregated_fit_test_allocate_no_memory_fragmented (CuTest *test)
+{
+	uint8_t *block[8];
+	int status;
+	int i;
+
+	TEST_START;
+
+	status = heap_segregated_fit_init (heap, sizeof (heap));
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 8; i++) {
+		block[i] = heap_segregated_fit_allocate ((sizeof (heap) / 8) -
+			(2 * HEAP_SEGREGATED_FIT_BLOCK_HEADER_LEN));
+		CuAssertPtrNotNull (test, block[i]);
+	}
+
+	for (i = 0; i < 8; i += 2) {
+		heap_segregated_fit_free (block[i]);
+	}
+
+	status = heap_segregated_fit_get_stats (&stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 4, stats.num_allocated_blocks);
+	CuAssertIntEquals (test, 5, stats.num_free_blocks);
+
+	CuAssertPtrEquals (test, NULL, heap_segregated_fit_allocate (stats.largest_free_block + 1));
+
+	for (i = 1; i < 8; i += 2) {
+		heap_segregated_fit_free (block[i]);
+	}
+
+	heap_segregated_fit_testing_check_stats_empty (test);
+
+	heap_segregated_fit_release ();
+}
+
+static void heap_segregated_fit_test_allocate_too_large (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = heap_segregated_fit_init (heap, sizeof (heap));
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrEquals (test, NULL, heap_segregated_fit_allocate (SIZE_MAX));
+
+	heap_segregated_fit_testing_check_stats_empty (test);
+
+	heap_segregated_fit_release ();
+}
+
+static void heap_segregated_fit_test_allocate_not_initialized (CuTest *test)
+{
+	TEST_START;
+
+	CuAssertPtrEquals (test, NULL, heap_segregated_fit_allocate (4));
+}
+
+static void heap_segregated_fit_test_allocate_zeroize (CuTest *test)
+{
+	uint8_t *block;
+	int status;
+
+	TEST_START;
+
+	status = heap_segregated_fit_init (heap, sizeof (heap));
+	CuAssertIntEquals (test, 0, status);
+
+	block = heap_segregated_fit_allocate (1000);
+	CuAssertPtrNotNull (test, block);
+
+	memset (block, 0xAA, 1000);
+	heap_segregated_fit_free (block);
+
+	block = heap_segregated_fit_allocate_zeroize (10, 100);
+	CuAssertPtrNotNull (test, block);
+
+	heap_segregated_fit_testing_check_value (test, 0, block, 1000);
+	heap_segregated_fit_testing_check_stats_constant_size_alloc (test, 1, 1000);
+
+	heap_segregated_fit_free (block);
+
+	heap_segregated_fit_testing_check_stats_empty (test);
+
+	heap_segregated_fit_release ();
+}
+
+static void heap_segregated_fit_test_allocate_zeroize_zero (CuTest *test)
+{
+	void *block;
+	int status;
+
+	TEST_START;
+
+	status = heap_segregated_fit_init (heap, sizeof (heap));
+	CuAssertIntEquals (test, 0, status);
+
+	block = heap_segregated_fit_allocate_zeroize (0, 4);
+	CuAssertPtrNotNull (test, block);
+
+	heap_segregated_fit_testing_check_stats_constant_size_alloc (test, 1,
+		HEAP_SEGREGATED_FIT_MIN_BLOCK_SIZE);
+
+	heap_segregated_fit_release ();
+}
+
+static void heap_segregated_fit_test_allocate_zeroize_overflow (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = heap_segregated_fit_init (heap, sizeof (heap));
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrEquals (test, NULL, heap_segregated_fit_allocate_zeroize ((SIZE_MAX / 2) + 2, 2));
+
+	heap_segregated_fit_testing_check_stats_empty (test);
+
+	heap_segregated_fit_release ();
+}
+
+static void heap_segregated_fit_test_allocate_zeroize_no_memory (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = heap_segregated_fit_init (heap, sizeof (heap));
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrEquals (test, NULL,
+		heap_segregated_fit_allocate_zeroize (1, HEAP_SEGREGATED_FIT_TESTING_EMPTY_SIZE + 1));
+
+	heap_segregated_fit_testing_check_stats_empty (test);
+
+	heap_segregated_fit_release ();
+}
+
+static void heap_segregated_fit_test_reallocate_null_ptr (CuTest *test)
+{
+	void *block;
+	int status;
+
+	TEST_START;
+
+	status = heap_segregated_fit_init (heap, sizeof (heap));
+	CuAssertIntEquals (test, 0, status);
+
+	block = heap_segregated_fit_reallocate (NULL, 64);
+	CuAssertPtrNotNull (test, block);
+
+	heap_segregated_fit_testing_check_stats_constant_size_alloc (test, 1, 64);
+
+	heap_segregated_fit_free (block);
+
+	heap_segregated_fit_testing_check_stats_empty (test);
+
+	heap_segregated_fit_release ();
+}
+
+static void heap_segregated_fit_test_reallocate_new_size_same (CuTest *test)
+{
+	uint8_t *block;
+	uint8_t *resized;
+	int status;
+
+	TEST_START;
+
+	status = heap_segregated_fit_init (heap, sizeof (heap));
+	CuAssertIntEquals (test, 0, status);
+
+	block = heap_segregated_fit_allocate (1000);
+	CuAssertPtrNotNull (test, block);
+
+	memset (block, 0xAA, 1000);
+
+	resized = heap_segregated_fit_reallocate (block, 1000 - HEAP_SEGREGATED_FIT_ALIGNMENT + 1);
+	CuAssertPtrEquals (test, block, resized);
+
+	heap_segregated_fit_testing_check_stats_constant_size_alloc (test, 1, 1000);
+	heap_segregated_fit_testing_check_value (test, 0xAA, block, 1000);
+
+	heap_segregated_fit_free (block);
+
+	heap_segregated_fit_testing_check_stats_empty (test);
+
+	heap_segregated_fit_release ();
+}
+
+static void heap_segregated_fit_test_reallocate_new_size_smaller (CuTest *test)
+{
+	uint8_t *block;
+	uint8_t *resized;
+	int status;
+
+	TEST_START;
+
+	status = heap_segregated_fit_init (heap, sizeof (heap));
+	CuAssertIntEquals (test, 0, status);
+
+	block = heap_segregated_fit_allocate (1000);
+	CuAssertPtrNotNull (test, block);
+
+	memset (block, 0xAA, 1000);
+
+	/* The block is trimmed in place and the excess merged back into the free space after it. */
+	resized = heap_segregated_fit_reallocate (block, 496);
+	CuAssertPtrEquals (test, block, resized);
+
+	heap_segregated_fit_testing_check_stats_constant_size_alloc (test, 1, 496);
+	heap_segregated_fit_testing_check_value (test, 0xAA, block, 496);
+
+	heap_segregated_fit_free (block);
+
+	heap_segregated_fit_testing_check_stats_empty (test);
+
+	heap_segregated_fit_release ();
+}
+
+static void heap_segregated_fit_test_reallocate_new_size_smaller_next_used (CuTest *test)
+{
+	uint8_t *block1;
+	uint8_t *block2;
+	uint8_t *resized;
+	int status;
+
+	TEST_START;
+
+	status = heap_segregated_fit_init (heap, sizeof (heap));
+	CuAssertIntEquals (test, 0, status);
+
+	block1 = heap_segregated_fit_allocate (1000);
+	CuAssertPtrNotNull (test, block1);
+
+	block2 = heap_segregated_fit_allocate (1000);
+	CuAssertPtrNotNull (test, block2);
+
+	memset (block1, 0xAA, 1000);
+
+	resized = heap_segregated_fit_reallocate (block1, 496);
+	CuAssertPtrEquals (test, block1, resized);
+
+	status = heap_segregated_fit_get_stats (&stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 2, stats.num_allocated_blocks);
+	CuAssertIntEquals (test, 1496, stats.total_allocated_size);
+	CuAssertIntEquals (test, 2, stats.num_free_blocks);
+
+	heap_segregated_fit_testing_check_value (test, 0xAA, block1, 496);
+
+	heap_segregated_fit_free (block1);
+	heap_segregated_fit_free (block2);
+
+	heap_segregated_fit_testing_check_stats_empty (test);
+
+	heap_segregated_fit_release ();
+}
+
+static void heap_segregated_fit_test_reallocate_grow_in_place (CuTest *test)
+{
+	uint8_t *block;
+	uint8_t *resized;
+	int status;
+
+	TEST_START;
+
+	status = heap_segregated_fit_init (heap, sizeof (heap));
+	CuAssertIntEquals (test, 0, status);
+
+	block = heap_segregated_fit_allocate (500);
+	CuAssertPtrNotNull (test, block);
+
+	memset (block, 0xAA, 500);
+
+	resized = heap_segregated_fit_reallocate (block, 2000);
+	CuAssertPtrEquals (test, block, resized);
+
+	heap_segregated_fit_testing_check_stats_constant_size_alloc (test, 1, 2000);
+	heap_segregated_fit_testing_check_value (test, 0xAA, block, 500);
+
+	heap_segregated_fit_free (block);
+
+	heap_segregated_fit_testing_check_stats_empty (test);
+
+	heap_segregated_fit_release ();
+}
+
+static void heap_segregated_fit_test_reallocate_grow_move (CuTest *test)
+{
+	uint8_t *block1;
+	uint8_t *block2;
+	uint8_t *resized;
+	int status;
+
+	TEST_START;
+
+	status = heap_segregated_fit_init (heap, sizeof (heap));
+	CuAssertIntEquals (test, 0, status);
+
+	block1 = heap_segregated_fit_allocate (512);
+	CuAssertPtrNotNull (test, block1);
+
+	block2 = heap_segregated_fit_allocate (512);
+	CuAssertPtrNotNull (test, block2);
+
+	memset (block1, 0xAA, 512);
+	memset (block2, 0xBB, 512);
+
+	resized = heap_segregated_fit_reallocate (block1, 1000);
+	CuAssertPtrNotNull (test, resized);
+	CuAssertTrue (test, (resized != block1));
+
+	status = heap_segregated_fit_get_stats (&stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 2, stats.num_allocated_blocks);
+	CuAssertIntEquals (test, 1512, stats.total_allocated_size);
+	CuAssertIntEquals (test, 2, stats.num_free_blocks);
+
+	heap_segregated_fit_testing_check_value (test, 0xAA, resized, 512);
+	heap_segregated_fit_testing_check_value (test, 0xBB, block2, 512);
+
+	heap_segregated_fit_free (block2);
+	heap_segregated_fit_free (resized);
+
+	heap_segregated_fit_testing_check_stats_empty (test);
+
+	heap_segregated_fit_release ();
+}
+
+static void heap_segregated_fit_test_reallocate_zero_new_size (CuTest *test)
+{
+	uint8_t *block;
+	uint8_t *resized;
+	int status;
+
+	TEST_START;
+
+	status = heap_segregated_fit_init (heap, sizeof (heap));
+	CuAssertIntEquals (test, 0, status);
+
+	block = heap_segregated_fit_allocate (1000);
+	CuAssertPtrNotNull (test, block);
+
+	resized = heap_segregated_fit_reallocate (block, 0);
+	CuAssertPtrEquals (test, block, resized);
+
+	heap_segregated_fit_testing_check_stats_constant_size_alloc (test, 1,
+		HEAP_SEGREGATED_FIT_MIN_BLOCK_SIZE);
+
+	heap_segregated_fit_free (block);
+
+	heap_segregated_fit_testing_check_stats_empty (test);
+
+	heap_segregated_fit_release ();
+}
+
+static void heap_segregated_fit_test_reallocate_new_size_too_large (CuTest *test)
+{
+	uint8_t *block;
+	int status;
+
+	TEST_START;
+
+	status = heap_segregated_fit_init (heap, sizeof (heap));
+	CuAssertIntEquals (test, 0, status);
+
+	block = heap_segregated_fit_allocate (1000);
+	CuAssertPtrNotNull (test, block);
+
+	memset (block, 0xAA, 1000);
+
+	CuAssertPtrEquals (test, NULL,
+		heap_segregated_fit_reallocate (block, HEAP_SEGREGATED_FIT_TESTING_EMPTY_SIZE + 1));
+	CuAssertPtrEquals (test, NULL, heap_segregated_fit_reallocate (block, SIZE_MAX));
+
+	heap_segregated_fit_testing_check_stats_constant_size_alloc (test, 1, 1000);
+	heap_segregated_fit_testing_check_value (test, 0xAA, block, 1000);
+
+	heap_segregated_fit_free (block);
+
+	heap_segregated_fit_testing_check_stats_empty (test);
+
+	heap_segregated_fit_release ();
+}
+
+static void heap_segregated_fit_test_reallocate_invalid_block (CuTest *test)
+{
+	uint8_t *block;
+	int status;
+
+	TEST_START;
+
+	status = heap_segregated_fit_init (heap, sizeof (heap));
+	CuAssertIntEquals (test, 0, status);
+
+	block = heap_segregated_fit_allocate (1000);
+	CuAssertPtrNotNull (test, block);
+
+	heap_segregated_fit_free (block);
+
+	CuAssertPtrEquals (test, NULL, heap_segregated_fit_reallocate (block, 100));
+	CuAssertPtrEquals (test, NULL, heap_segregated_fit_reallocate (&status, 100));
+
+	heap_segregated_fit_testing_check_stats_empty (test);
+
+	heap_segregated_fit_release ();
+}
+
+static void heap_segregated_fit_test_free_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = heap_segregated_fit_init (heap, sizeof (heap));
+	CuAssertIntEquals (test, 0, status);
+
+	heap_segregated_fit_free (NULL);
+
+	heap_segregated_fit_testing_check_stats_empty (test);
+
+	heap_segregated_fit_release ();
+}
+
+static void heap_segregated_fit_test_free_twice (CuTest *test)
+{
+	uint8_t *block1;
+	uint8_t *block2;
+	int status;
+
+	TEST_START;
+
+	status = heap_segregated_fit_init (heap, sizeof (heap));
+	CuAssertIntEquals (test, 0, status);
+
+	block1 = heap_segregated_fit_allocate (100);
+	CuAssertPtrNotNull (test, block1);
+
+	block2 = heap_segregated_fit_allocate (100);
+	CuAssertPtrNotNull (test, block2);
+
+	heap_segregated_fit_free (block1);
+	heap_segregated_fit_free (block1);
+
+	status = heap_segregated_fit_get_stats (&stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, stats.num_allocated_blocks);
+	CuAssertIntEquals (test, 2, stats.num_free_blocks);
+
+	heap_segregated_fit_free (block2);
+
+	heap_segregated_fit_testing_check_stats_empty (test);
+
+	heap_segregated_fit_release ();
+}
+
+static void heap_segregated_fit_test_free_outside_heap (CuTest *test)
+{
+	uint8_t other[64];
+	int status;
+
+	TEST_START;
+
+	status = heap_segregated_fit_init (heap, sizeof (heap));
+	CuAssertIntEquals (test, 0, status);
+
+	heap_segregated_fit_free (&other[32]);
+	heap_segregated_fit_free (heap);
+
+	heap_segregated_fit_testing_check_stats_empty (test);
+
+	heap_segregated_fit_release ();
+}
+
+static void heap_segregated_fit_test_get_stats_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = heap_segregated_fit_init (heap, sizeof (heap));
+	CuAssertIntEquals (test, 0, status);
+
+	status = heap_segregated_fit_get_stats (NULL);
+	CuAssertIntEquals (test, HEAP_SEGREGATED_FIT_INVALID_ARGUMENT, status);
+
+	heap_segregated_fit_release ();
+}
+
+static void heap_segregated_fit_test_get_stats_not_initialized (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = heap_segregated_fit_get_stats (&stats);
+	CuAssertIntEquals (test, HEAP_SEGREGATED_FIT_NOT_INITIALIZED, status);
+}
+
+static void heap_segregated_fit_test_replay_attestation_trace (CuTest *test)
+{
+	uint8_t *blocks[8] = {0};
+	size_t sizes[8] = {0};
+	int status;
+
+	TEST_START;
+
+	status = heap_segregated_fit_init (heap, sizeof (heap));
+	CuAssertIntEquals (test, 0, status);
+
+	heap_segregated_fit_testing_replay_trace (test, HEAP_SEGREGATED_FIT_TESTING_ATTESTATION,
+		HEAP_SEGREGATED_FIT_TESTING_ATTESTATION_LEN, blocks, sizes);
+
+	heap_segregated_fit_testing_check_stats_empty (test);
+
+	heap_segregated_fit_release ();
+}
+
+static void heap_segregated_fit_test_replay_attestation_trace_repeated (CuTest *test)
+{
+	uint8_t *blocks[8] = {0};
+	size_t sizes[8] = {0};
+	uint8_t *first;
+	int status;
+	int i;
+
+	TEST_START;
+
+	status = heap_segregated_fit_init (heap, sizeof (heap));
+	CuAssertIntEquals (test, 0, status);
+
+	/* Hold a long-lived allocation to keep the trace from always starting with an empty heap. */
+	first = heap_segregated_fit_allocate (320);
+	CuAssertPtrNotNull (test, first);
+
+	/* Steady-state replay must not leak or fragment the heap. */
+	for (i = 0; i < 50; i++) {
+		heap_segregated_fit_testing_replay_trace (test, HEAP_SEGREGATED_FIT_TESTING_ATTESTATION,
+			HEAP_SEGREGATED_FIT_TESTING_ATTESTATION_LEN, blocks, sizes);
+
+		heap_segregated_fit_testing_check_stats_constant_size_alloc (test, 1, 320);
+	}
+
+	heap_segregated_fit_free (first);
+
+	heap_segregated_fit_testing_check_stats_empty (test);
+
+	heap_segregated_fit_release ();
+}
+
+
+TEST_SUITE_START (heap_segregated_fit);
+
+TEST (heap_segregated_fit_test_macros);
+TEST (heap_segregated_fit_test_init);
+TEST (heap_segregated_fit_test_init_unaligned_heap);
+TEST (heap_segregated_fit_test_init_null);
+TEST (heap_segregated_fit_test_init_heap_too_large);
+TEST (heap_segregated_fit_test_init_thread_safe);
+TEST (heap_segregated_fit_test_init_thread_safe_null);
+TEST (heap_segregated_fit_test_release_twice);
+TEST (heap_segregated_fit_test_allocate);
+TEST (heap_segregated_fit_test_allocate_unaligned_size);
+TEST (heap_segregated_fit_test_allocate_small_size);
+TEST (heap_segregated_fit_test_allocate_zero);
+TEST (heap_segregated_fit_test_allocate_entire_heap);
+TEST (heap_segregated_fit_test_allocate_remainder_too_small_to_split);
+TEST (heap_segregated_fit_test_allocate_multiple_blocks);
+TEST (heap_segregated_fit_test_allocate_reuse_freed_block);
+TEST (heap_segregated_fit_test_allocate_split_freed_block);
+TEST (heap_segregated_fit_test_allocate_merge_free_neighbors);
+TEST (heap_segregated_fit_test_allocate_free_in_reverse_order);
+TEST (heap_segregated_fit_test_allocate_no_memory);
+TEST (heap_segregated_fit_test_allocate_no_memory_fragmented);
+TEST (heap_segregated_fit_test_allocate_too_large);
+TEST (heap_segregated_fit_test_allocate_not_initialized);
+TEST (heap_segregated_fit_test_allocate_zeroize);
+TEST (heap_segregated_fit_test_allocate_zeroize_zero);
+TEST (heap_segregated_fit_test_allocate_zeroize_overflow);
+TEST (heap_segregated_fit_test_allocate_zeroize_no_memory);
+TEST (heap_segregated_fit_test_reallocate_null_ptr);
+TEST (heap_segregated_fit_test_reallocate_new_size_same);
+TEST (heap_segregated_fit_test_reallocate_new_size_smaller);
+TEST (heap_segregated_fit_test_reallocate_new_size_smaller_next_used);
+TEST (heap_segregated_fit_test_reallocate_grow_in_place);
+TEST (heap_segregated_fit_test_reallocate_grow_move);
+TEST (heap_segregated_fit_test_reallocate_zero_new_size);
+TEST (heap_segregated_fit_test_reallocate_new_size_too_large);
+TEST (heap_segregated_fit_test_reallocate_invalid_block);
+TEST (heap_segregated_fit_test_free_null);
+TEST (heap_segregated_fit_test_free_twice);
+TEST (heap_segregated_fit_test_free_outside_heap);
+TEST (heap_segregated_fit_test_get_stats_null);
+TEST (heap_segregated_fit_test_get_stats_not_initialized);
+TEST (heap_segregated_fit_test_replay_attestation_trace);
+TEST (heap_segregated_fit_test_replay_attestation_trace_repeated);
+
+TEST_SUITE_END;
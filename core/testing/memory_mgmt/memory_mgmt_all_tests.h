@@ -27,6 +27,18 @@ static void add_all_memory_mgmt_tests (CuSuite *suite)
 	!defined TESTING_SKIP_HEAP_WITH_DEFRAG_SUITE
 	TESTING_RUN_SUITE (heap_with_defrag);
 #endif
+#if (defined TESTING_RUN_HEAP_SEGREGATED_FIT_SUITE || \
+		defined TESTING_RUN_ALL_TESTS || defined TESTING_RUN_ALL_CORE_TESTS || \
+		(!defined TESTING_SKIP_ALL_TESTS && !defined TESTING_SKIP_ALL_CORE_TESTS)) && \
+	!defined TESTING_SKIP_HEAP_SEGREGATED_FIT_SUITE
+	TESTING_RUN_SUITE (heap_segregated_fit);
+#endif
+#if (defined TESTING_RUN_OBJECT_POOL_SUITE || \
+		defined TESTING_RUN_ALL_TESTS || defined TESTING_RUN_ALL_CORE_TESTS || \
+		(!defined TESTING_SKIP_ALL_TESTS && !defined TESTING_SKIP_ALL_CORE_TESTS)) && \
+	!defined TESTING_SKIP_OBJECT_POOL_SUITE
+	TESTING_RUN_SUITE (object_pool);
+#endif
 }
 
 
@@ -0,0 +1,642 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "testing.h"
+#include "platform_api.h"
+#include "memory_mgmt/object_pool.h"
+#include "memory_mgmt/object_pool_static.h"
+
+
+TEST_SUITE_LABEL ("object_pool");
+
+
+/**
+ * Size of objects used for testing.
+ */
+#define	OBJECT_POOL_TESTING_OBJ_SIZE		36
+
+/**
+ * Number of objects in the test pool.
+ */
+#define	OBJECT_POOL_TESTING_OBJ_COUNT		4
+
+
+/**
+ * Dependencies for testing object pools.
+ */
+struct object_pool_testing {
+	uint64_t slots[OBJECT_POOL_STORAGE_LEN (OBJECT_POOL_TESTING_OBJ_SIZE,
+		OBJECT_POOL_TESTING_OBJ_COUNT)];								/**< Storage for pool objects. */
+	volatile uint32_t links[OBJECT_POOL_TESTING_OBJ_COUNT];				/**< Storage for the free list. */
+	struct object_pool_state state;										/**< Context for the pool. */
+	struct object_pool test;											/**< Pool under test. */
+};
+
+
+/**
+ * Initialize an object pool for testing.
+ *
+ * @param test The test framework.
+ * @param pool Testing components to initialize.
+ */
+static void object_pool_testing_init (CuTest *test, struct object_pool_testing *pool)
+{
+	int status;
+
+	status = object_pool_init (&pool->test, &pool->state, pool->slots, pool->links,
+		OBJECT_POOL_TESTING_OBJ_SIZE, OBJECT_POOL_TESTING_OBJ_COUNT);
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Check the usage statistics for an object pool.
+ *
+ * @param test The test framework.
+ * @param pool The pool to check.
+ * @param in_use Expected number of objects in use.
+ * @param high_water Expected high-water mark.
+ * @param failures Expected number of failed requests.
+ */
+static void object_pool_testing_check_stats (CuTest *test, const struct object_pool *pool,
+	uint32_t in_use, uint32_t high_water, uint32_t failures)
+{
+	struct object_pool_stats stats;
+	int status;
+
+	status = object_pool_get_stats (pool, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, OBJECT_POOL_SLOT_SIZE (OBJECT_POOL_TESTING_OBJ_SIZE),
+		stats.slot_size);
+	CuAssertIntEquals (test, OBJECT_POOL_TESTING_OBJ_COUNT, stats.slot_count);
+	CuAssertIntEquals (test, in_use, stats.in_use);
+	CuAssertIntEquals (test, high_water, stats.high_water);
+	CuAssertIntEquals (test, failures, stats.failures);
+}
+
+
+/*******************
+ * Test cases
+ *******************/
+
+static void object_pool_test_slot_size (CuTest *test)
+{
+	TEST_START;
+
+	CuAssertIntEquals (test, 8, OBJECT_POOL_SLOT_SIZE (1));
+	CuAssertIntEquals (test, 8, OBJECT_POOL_SLOT_SIZE (8));
+	CuAssertIntEquals (test, 40, OBJECT_POOL_SLOT_SIZE (36));
+	CuAssertIntEquals (test, 5, OBJECT_POOL_STORAGE_LEN (36, 1));
+	CuAssertIntEquals (test, 20, OBJECT_POOL_STORAGE_LEN (36, 4));
+}
+
+static void object_pool_test_init (CuTest *test)
+{
+	struct object_pool_testing pool;
+
+	TEST_START;
+
+	object_pool_testing_init (test, &pool);
+
+	object_pool_testing_check_stats (test, &pool.test, 0, 0, 0);
+
+	object_pool_release (&pool.test);
+}
+
+static void object_pool_test_init_null (CuTest *test)
+{
+	struct object_pool_testing pool;
+	int status;
+
+	TEST_START;
+
+	status = object_pool_init (NULL, &pool.state, pool.slots, pool.links,
+		OBJECT_POOL_TESTING_OBJ_SIZE, OBJECT_POOL_TESTING_OBJ_COUNT);
+	CuAssertIntEquals (test, OBJECT_POOL_INVALID_ARGUMENT, status);
+
+	status = object_pool_init (&pool.test, NULL, pool.slots, pool.links,
+		OBJECT_POOL_TESTING_OBJ_SIZE, OBJECT_POOL_TESTING_OBJ_COUNT);
+	CuAssertIntEquals (test, OBJECT_POOL_INVALID_ARGUMENT, status);
+
+	status = object_pool_init (&pool.test, &pool.state, NULL, pool.links,
+		OBJECT_POOL_TESTING_OBJ_SIZE, OBJECT_POOL_TESTING_OBJ_COUNT);
+	CuAssertIntEquals (test, OBJECT_POOL_INVALID_ARGUMENT, status);
+
+	status = object_pool_init (&pool.test, &pool.state, pool.slots, NULL,
+		OBJECT_POOL_TESTING_OBJ_SIZE, OBJECT_POOL_TESTING_OBJ_COUNT);
+	CuAssertIntEquals (test, OBJECT_POOL_INVALID_ARGUMENT, status);
+
+	status = object_pool_init (&pool.test, &pool.state, pool.slots, pool.links, 0,
+		OBJECT_POOL_TESTING_OBJ_COUNT);
+	CuAssertIntEquals (test, OBJECT_POOL_INVALID_ARGUMENT, status);
+
+	status = object_pool_init (&pool.test, &pool.state, pool.slots, pool.links,
+		OBJECT_POOL_TESTING_OBJ_SIZE, 0);
+	CuAssertIntEquals (test, OBJECT_POOL_INVALID_ARGUMENT, status);
+}
+
+static void object_pool_test_init_too_many_slots (CuTest *test)
+{
+	struct object_pool_testing pool;
+	int status;
+
+	TEST_START;
+
+	status = object_pool_init (&pool.test, &pool.state, pool.slots, pool.links,
+		OBJECT_POOL_TESTING_OBJ_SIZE, OBJECT_POOL_MAX_SLOTS + 1);
+	CuAssertIntEquals (test, OBJECT_POOL_TOO_MANY_SLOTS, status);
+}
+
+static void object_pool_test_static_init (CuTest *test)
+{
+	struct object_pool_testing pool;
+	struct object_pool test_static = object_pool_static_init (&pool.state, pool.slots, pool.links,
+		OBJECT_POOL_TESTING_OBJ_SIZE, OBJECT_POOL_TESTING_OBJ_COUNT);
+	uint8_t *obj;
+	int status;
+
+	TEST_START;
+
+	status = object_pool_init_state (&test_static);
+	CuAssertIntEquals (test, 0, status);
+
+	object_pool_testing_check_stats (test, &test_static, 0, 0, 0);
+
+	obj = object_pool_acquire_object (&test_static);
+	CuAssertPtrEquals (test, pool.slots, obj);
+
+	object_pool_testing_check_stats (test, &test_static, 1, 1, 0);
+
+	status = object_pool_release_object (&test_static, obj);
+	CuAssertIntEquals (test, 0, status);
+
+	object_pool_testing_check_stats (test, &test_static, 0, 1, 0);
+
+	object_pool_release (&test_static);
+}
+
+static void object_pool_test_static_init_null (CuTest *test)
+{
+	struct object_pool_testing pool;
+	struct object_pool test_static = object_pool_static_init (&pool.state, pool.slots, pool.links,
+		OBJECT_POOL_TESTING_OBJ_SIZE, OBJECT_POOL_TESTING_OBJ_COUNT);
+	struct object_pool null_state = object_pool_static_init (NULL, pool.slots, pool.links,
+		OBJECT_POOL_TESTING_OBJ_SIZE, OBJECT_POOL_TESTING_OBJ_COUNT);
+	struct object_pool null_slots = object_pool_static_init (&pool.state, NULL, pool.links,
+		OBJECT_POOL_TESTING_OBJ_SIZE, OBJECT_POOL_TESTING_OBJ_COUNT);
+	struct object_pool null_links = object_pool_static_init (&pool.state, pool.slots, NULL,
+		OBJECT_POOL_TESTING_OBJ_SIZE, OBJECT_POOL_TESTING_OBJ_COUNT);
+	struct object_pool no_slots = object_pool_static_init (&pool.state, pool.slots, pool.links,
+		OBJECT_POOL_TESTING_OBJ_SIZE, 0);
+	int status;
+
+	TEST_START;
+
+	status = object_pool_init_state (NULL);
+	CuAssertIntEquals (test, OBJECT_POOL_INVALID_ARGUMENT, status);
+
+	status = object_pool_init_state (&null_state);
+	CuAssertIntEquals (test, OBJECT_POOL_INVALID_ARGUMENT, status);
+
+	status = object_pool_init_state (&null_slots);
+	CuAssertIntEquals (test, OBJECT_POOL_INVALID_ARGUMENT, status);
+
+	status = object_pool_init_state (&null_links);
+	CuAssertIntEquals (test, OBJECT_POOL_INVALID_ARGUMENT, status);
+
+	status = object_pool_init_state (&no_slots);
+	CuAssertIntEquals (test, OBJECT_POOL_INVALID_ARGUMENT, status);
+
+	test_static.slot_size = 0;
+	status = object_pool_init_state (&test_static);
+	CuAssertIntEquals (test, OBJECT_POOL_INVALID_ARGUMENT, status);
+}
+
+static void object_pool_test_release_null (CuTest *test)
+{
+	TEST_START;
+
+	object_pool_release (NULL);
+}
+
+static void object_pool_test_acquire_object (CuTest *test)
+{
+	struct object_pool_testing pool;
+	uint8_t *obj;
+
+	TEST_START;
+
+	object_pool_testing_init (test, &pool);
+
+	obj = object_pool_acquire_object (&pool.test);
+	CuAssertPtrEquals (test, pool.slots, obj);
+
+	memset (obj, 0x55, OBJECT_POOL_TESTING_OBJ_SIZE);
+
+	object_pool_testing_check_stats (test, &pool.test, 1, 1, 0);
+
+	object_pool_release (&pool.test);
+}
+
+static void object_pool_test_acquire_object_all_slots (CuTest *test)
+{
+	struct object_pool_testing pool;
+	uint8_t *obj[OBJECT_POOL_TESTING_OBJ_COUNT];
+	size_t slot_size = OBJECT_POOL_SLOT_SIZE (OBJECT_POOL_TESTING_OBJ_SIZE);
+	int i;
+	int j;
+
+	TEST_START;
+
+	object_pool_testing_init (test, &pool);
+
+	for (i = 0; i < OBJECT_POOL_TESTING_OBJ_COUNT; i++) {
+		obj[i] = object_pool_acquire_object (&pool.test);
+		CuAssertPtrEquals (test, ((uint8_t*) pool.slots) + (slot_size * i), obj[i]);
+		CuAssertIntEquals (test, 0, ((uintptr_t) obj[i]) & (sizeof (uint64_t) - 1));
+
+		memset (obj[i], i, OBJECT_POOL_TESTING_OBJ_SIZE);
+
+		object_pool_testing_check_stats (test, &pool.test, i + 1, i + 1, 0);
+	}
+
+	for (i = 0; i < OBJECT_POOL_TESTING_OBJ_COUNT; i++) {
+		for (j = 0; j < OBJECT_POOL_TESTING_OBJ_SIZE; j++) {
+			CuAssertIntEquals (test, i, obj[i][j]);
+		}
+	}
+
+	object_pool_release (&pool.test);
+}
+
+static void object_pool_test_acquire_object_pool_empty (CuTest *test)
+{
+	struct object_pool_testing pool;
+	uint8_t *obj;
+	int i;
+
+	TEST_START;
+
+	object_pool_testing_init (test, &pool);
+
+	for (i = 0; i < OBJECT_POOL_TESTING_OBJ_COUNT; i++) {
+		obj = object_pool_acquire_object (&pool.test);
+		CuAssertPtrNotNull (test, obj);
+	}
+
+	obj = object_pool_acquire_object (&pool.test);
+	CuAssertPtrEquals (test, NULL, obj);
+
+	obj = object_pool_acquire_object (&pool.test);
+	CuAssertPtrEquals (test, NULL, obj);
+
+	object_pool_testing_check_stats (test, &pool.test, OBJECT_POOL_TESTING_OBJ_COUNT,
+		OBJECT_POOL_TESTING_OBJ_COUNT, 2);
+
+	object_pool_release (&pool.test);
+}
+
+static void object_pool_test_acquire_object_null (CuTest *test)
+{
+	TEST_START;
+
+	CuAssertPtrEquals (test, NULL, object_pool_acquire_object (NULL));
+}
+
+static void object_pool_test_release_object (CuTest *test)
+{
+	struct object_pool_testing pool;
+	uint8_t *obj1;
+	uint8_t *obj2;
+	uint8_t *reuse;
+	int status;
+
+	TEST_START;
+
+	object_pool_testing_init (test, &pool);
+
+	obj1 = object_pool_acquire_object (&pool.test);
+	CuAssertPtrNotNull (test, obj1);
+
+	obj2 = object_pool_acquire_object (&pool.test);
+	CuAssertPtrNotNull (test, obj2);
+
+	status = object_pool_release_object (&pool.test, obj1);
+	CuAssertIntEquals (test, 0, status);
+
+	object_pool_testing_check_stats (test, &pool.test, 1, 2, 0);
+
+	/* The most recently released object is reused first. */
+	reuse = object_pool_acquire_object (&pool.test);
+	CuAssertPtrEquals (test, obj1, reuse);
+
+	object_pool_testing_check_stats (test, &pool.test, 2, 2, 0);
+
+	status = object_pool_release_object (&pool.test, obj2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = object_pool_release_object (&pool.test, reuse);
+	CuAssertIntEquals (test, 0, status);
+
+	object_pool_testing_check_stats (test, &pool.test, 0, 2, 0);
+
+	object_pool_release (&pool.test);
+}
+
+static void object_pool_test_release_object_after_empty (CuTest *test)
+{
+	struct object_pool_testing pool;
+	uint8_t *obj[OBJECT_POOL_TESTING_OBJ_COUNT];
+	uint8_t *reuse;
+	int status;
+	int i;
+
+	TEST_START;
+
+	object_pool_testing_init (test, &pool);
+
+	for (i = 0; i < OBJECT_POOL_TESTING_OBJ_COUNT; i++) {
+		obj[i] = object_pool_acquire_object (&pool.test);
+		CuAssertPtrNotNull (test, obj[i]);
+	}
+
+	CuAssertPtrEquals (test, NULL, object_pool_acquire_object (&pool.test));
+
+	status = object_pool_release_object (&pool.test, obj[2]);
+	CuAssertIntEquals (test, 0, status);
+
+	reuse = object_pool_acquire_object (&pool.test);
+	CuAssertPtrEquals (test, obj[2], reuse);
+
+	CuAssertPtrEquals (test, NULL, object_pool_acquire_object (&pool.test));
+
+	for (i = 0; i < OBJECT_POOL_TESTING_OBJ_COUNT; i++) {
+		status = object_pool_release_object (&pool.test, obj[i]);
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	object_pool_testing_check_stats (test, &pool.test, 0, OBJECT_POOL_TESTING_OBJ_COUNT, 2);
+
+	/* Every slot is available again. */
+	for (i = 0; i < OBJECT_POOL_TESTING_OBJ_COUNT; i++) {
+		CuAssertPtrNotNull (test, object_pool_acquire_object (&pool.test));
+	}
+
+	object_pool_release (&pool.test);
+}
+
+static void object_pool_test_release_object_null (CuTest *test)
+{
+	struct object_pool_testing pool;
+	uint8_t *obj;
+	int status;
+
+	TEST_START;
+
+	object_pool_testing_init (test, &pool);
+
+	obj = object_pool_acquire_object (&pool.test);
+	CuAssertPtrNotNull (test, obj);
+
+	status = object_pool_release_object (NULL, obj);
+	CuAssertIntEquals (test, OBJECT_POOL_INVALID_ARGUMENT, status);
+
+	status = object_pool_release_object (&pool.test, NULL);
+	CuAssertIntEquals (test, OBJECT_POOL_INVALID_ARGUMENT, status);
+
+	object_pool_testing_check_stats (test, &pool.test, 1, 1, 0);
+
+	object_pool_release (&pool.test);
+}
+
+static void object_pool_test_release_object_not_from_pool (CuTest *test)
+{
+	struct object_pool_testing pool;
+	uint8_t *obj;
+	uint64_t other;
+	int status;
+
+	TEST_START;
+
+	object_pool_testing_init (test, &pool);
+
+	obj = object_pool_acquire_object (&pool.test);
+	CuAssertPtrNotNull (test, obj);
+
+	status = object_pool_release_object (&pool.test, &other);
+	CuAssertIntEquals (test, OBJECT_POOL_NOT_POOL_OBJECT, status);
+
+	status = object_pool_release_object (&pool.test, obj + 1);
+	CuAssertIntEquals (test, OBJECT_POOL_NOT_POOL_OBJECT, status);
+
+	status = object_pool_release_object (&pool.test,
+		((uint8_t*) pool.slots) + sizeof (pool.slots));
+	CuAssertIntEquals (test, OBJECT_POOL_NOT_POOL_OBJECT, status);
+
+	object_pool_testing_check_stats (test, &pool.test, 1, 1, 0);
+
+	object_pool_release (&pool.test);
+}
+
+static void object_pool_test_release_object_already_free (CuTest *test)
+{
+	struct object_pool_testing pool;
+	uint8_t *obj;
+	int status;
+
+	TEST_START;
+
+	object_pool_testing_init (test, &pool);
+
+	obj = object_pool_acquire_object (&pool.test);
+	CuAssertPtrNotNull (test, obj);
+
+	status = object_pool_release_object (&pool.test, obj);
+	CuAssertIntEquals (test, 0, status);
+
+	status = object_pool_release_object (&pool.test, obj);
+	CuAssertIntEquals (test, OBJECT_POOL_ALREADY_FREE, status);
+
+	status = object_pool_release_object (&pool.test,
+		((uint8_t*) pool.slots) + OBJECT_POOL_SLOT_SIZE (OBJECT_POOL_TESTING_OBJ_SIZE));
+	CuAssertIntEquals (test, OBJECT_POOL_ALREADY_FREE, status);
+
+	object_pool_testing_check_stats (test, &pool.test, 0, 1, 0);
+
+	object_pool_release (&pool.test);
+}
+
+static void object_pool_test_contains (CuTest *test)
+{
+	struct object_pool_testing pool;
+	uint8_t *obj;
+	uint64_t other;
+
+	TEST_START;
+
+	object_pool_testing_init (test, &pool);
+
+	obj = object_pool_acquire_object (&pool.test);
+	CuAssertPtrNotNull (test, obj);
+
+	CuAssertIntEquals (test, true, object_pool_contains (&pool.test, obj));
+	CuAssertIntEquals (test, false, object_pool_contains (&pool.test, obj + 4));
+	CuAssertIntEquals (test, false, object_pool_contains (&pool.test, &other));
+	CuAssertIntEquals (test, false, object_pool_contains (&pool.test, NULL));
+	CuAssertIntEquals (test, false, object_pool_contains (NULL, obj));
+
+	object_pool_release (&pool.test);
+}
+
+static void object_pool_test_get_stats_null (CuTest *test)
+{
+	struct object_pool_testing pool;
+	struct object_pool_stats stats;
+	int status;
+
+	TEST_START;
+
+	object_pool_testing_init (test, &pool);
+
+	status = object_pool_get_stats (NULL, &stats);
+	CuAssertIntEquals (test, OBJECT_POOL_INVALID_ARGUMENT, status);
+
+	status = object_pool_get_stats (&pool.test, NULL);
+	CuAssertIntEquals (test, OBJECT_POOL_INVALID_ARGUMENT, status);
+
+	object_pool_release (&pool.test);
+}
+
+static void object_pool_test_acquire_or_allocate (CuTest *test)
+{
+	struct object_pool_testing pool;
+	uint8_t *obj;
+
+	TEST_START;
+
+	object_pool_testing_init (test, &pool);
+
+	obj = object_pool_acquire_or_allocate (&pool.test, OBJECT_POOL_TESTING_OBJ_SIZE);
+	CuAssertPtrEquals (test, pool.slots, obj);
+
+	object_pool_testing_check_stats (test, &pool.test, 1, 1, 0);
+
+	object_pool_release_or_free (&pool.test, obj);
+
+	object_pool_testing_check_stats (test, &pool.test, 0, 1, 0);
+
+	object_pool_release (&pool.test);
+}
+
+static void object_pool_test_acquire_or_allocate_too_large (CuTest *test)
+{
+	struct object_pool_testing pool;
+	uint8_t *obj;
+
+	TEST_START;
+
+	object_pool_testing_init (test, &pool);
+
+	obj = object_pool_acquire_or_allocate (&pool.test,
+		OBJECT_POOL_SLOT_SIZE (OBJECT_POOL_TESTING_OBJ_SIZE) + 1);
+	CuAssertPtrNotNull (test, obj);
+	CuAssertIntEquals (test, false, object_pool_contains (&pool.test, obj));
+
+	object_pool_testing_check_stats (test, &pool.test, 0, 0, 0);
+
+	object_pool_release_or_free (&pool.test, obj);
+
+	object_pool_release (&pool.test);
+}
+
+static void object_pool_test_acquire_or_allocate_pool_empty (CuTest *test)
+{
+	struct object_pool_testing pool;
+	uint8_t *obj[OBJECT_POOL_TESTING_OBJ_COUNT];
+	uint8_t *extra;
+	int i;
+
+	TEST_START;
+
+	object_pool_testing_init (test, &pool);
+
+	for (i = 0; i < OBJECT_POOL_TESTING_OBJ_COUNT; i++) {
+		obj[i] = object_pool_acquire_or_allocate (&pool.test, OBJECT_POOL_TESTING_OBJ_SIZE);
+		CuAssertIntEquals (test, true, object_pool_contains (&pool.test, obj[i]));
+	}
+
+	extra = object_pool_acquire_or_allocate (&pool.test, OBJECT_POOL_TESTING_OBJ_SIZE);
+	CuAssertPtrNotNull (test, extra);
+	CuAssertIntEquals (test, false, object_pool_contains (&pool.test, extra));
+
+	object_pool_testing_check_stats (test, &pool.test, OBJECT_POOL_TESTING_OBJ_COUNT,
+		OBJECT_POOL_TESTING_OBJ_COUNT, 1);
+
+	object_pool_release_or_free (&pool.test, extra);
+	for (i = 0; i < OBJECT_POOL_TESTING_OBJ_COUNT; i++) {
+		object_pool_release_or_free (&pool.test, obj[i]);
+	}
+
+	object_pool_testing_check_stats (test, &pool.test, 0, OBJECT_POOL_TESTING_OBJ_COUNT, 1);
+
+	object_pool_release (&pool.test);
+}
+
+static void object_pool_test_acquire_or_allocate_null_pool (CuTest *test)
+{
+	uint8_t *obj;
+
+	TEST_START;
+
+	obj = object_pool_acquire_or_allocate (NULL, 32);
+	CuAssertPtrNotNull (test, obj);
+
+	object_pool_release_or_free (NULL, obj);
+}
+
+static void object_pool_test_release_or_free_null (CuTest *test)
+{
+	struct object_pool_testing pool;
+
+	TEST_START;
+
+	object_pool_testing_init (test, &pool);
+
+	object_pool_release_or_free (&pool.test, NULL);
+	object_pool_release_or_free (NULL, NULL);
+
+	object_pool_testing_check_stats (test, &pool.test, 0, 0, 0);
+
+	object_pool_release (&pool.test);
+}
+
+
+TEST_SUITE_START (object_pool);
+
+TEST (object_pool_test_slot_size);
+TEST (object_pool_test_init);
+TEST (object_pool_test_init_null);
+TEST (object_pool_test_init_too_many_slots);
+TEST (object_pool_test_static_init);
+TEST (object_pool_test_static_init_null);
+TEST (object_pool_test_release_null);
+TEST (object_pool_test_acquire_object);
+TEST (object_pool_test_acquire_object_all_slots);
+TEST (object_pool_test_acquire_object_pool_empty);
+TEST (object_pool_test_acquire_object_null);
+TEST (object_pool_test_release_object);
+TEST (object_pool_test_release_object_after_empty);
+TEST (object_pool_test_release_object_null);
+TEST (object_pool_test_release_object_not_from_pool);
+TEST (object_pool_test_release_object_already_free);
+TEST (object_pool_test_contains);
+TEST (object_pool_test_get_stats_null);
+TEST (object_pool_test_acquire_or_allocate);
+TEST (object_pool_test_acquire_or_allocate_too_large);
+TEST (object_pool_test_acquire_or_allocate_pool_empty);
+TEST (object_pool_test_acquire_or_allocate_null_pool);
+TEST (object_pool_test_release_or_free_null);
+
+TEST_SUITE_END;
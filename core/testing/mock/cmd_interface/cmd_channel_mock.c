@@ -33,12 +33,24 @@ static int cmd_channel_mock_send_packet (struct cmd_channel *channel, struct cmd
 	MOCK_RETURN (&mock->mock, cmd_channel_mock_send_packet, channel, MOCK_ARG_PTR_CALL (packet));
 }
 
+static int cmd_channel_mock_send_packets (struct cmd_channel *channel,
+	const struct cmd_message *message)
+{
+	struct cmd_channel_mock *mock = (struct cmd_channel_mock*) channel;
+
+	if (mock == NULL) {
+		return MOCK_INVALID_ARGUMENT;
+	}
+
+	MOCK_RETURN (&mock->mock, cmd_channel_mock_send_packets, channel, MOCK_ARG_PTR_CALL (message));
+}
+
 static int cmd_channel_mock_func_arg_count (void *func)
 {
 	if (func == cmd_channel_mock_receive_packet) {
 		return 2;
 	}
-	if (func == cmd_channel_mock_send_packet) {
+	if ((func == cmd_channel_mock_send_packet) || (func == cmd_channel_mock_send_packets)) {
 		return 1;
 	}
 	else {
@@ -54,6 +66,9 @@ static const char* cmd_channel_mock_func_name_map (void *func)
 	else if (func == cmd_channel_mock_send_packet) {
 		return "send_packet";
 	}
+	else if (func == cmd_channel_mock_send_packets) {
+		return "send_packets";
+	}
 	else {
 		return "unknown";
 	}
@@ -75,6 +90,12 @@ static const char* cmd_channel_mock_arg_name_map (void *func, int arg)
 				return "packet";
 		}
 	}
+	else if (func == cmd_channel_mock_send_packets) {
+		switch (arg) {
+			case 0:
+				return "message";
+		}
+	}
 
 	return "unknown";
 }
@@ -120,6 +141,29 @@ int cmd_channel_mock_init (struct cmd_channel_mock *mock, int id)
 	return 0;
 }
 
+/**
+ * Initialize a mock for a command channel that supports sending all packets for a message in a
+ * single call.
+ *
+ * @param mock The mock to initialize.
+ * @param id An ID for the command channel.
+ *
+ * @return 0 if the mock was successfully initialized or an error code.
+ */
+int cmd_channel_mock_init_with_send_packets (struct cmd_channel_mock *mock, int id)
+{
+	int status;
+
+	status = cmd_channel_mock_init (mock, id);
+	if (status != 0) {
+		return status;
+	}
+
+	mock->base.send_packets = cmd_channel_mock_send_packets;
+
+	return 0;
+}
+
 /**
  * Release the resources used by a command channel mock.
  *
@@ -195,3 +239,43 @@ int cmd_channel_mock_validate_packet (const char *arg_info, void *expected, void
 
 	return fail;
 }
+
+/**
+ * Custom validation routine for validating cmd_message arguments.
+ *
+ * @param arg_info Argument information from the mock for error messages.
+ * @param expected The expected message contents.
+ * @param actual The actual message contents.
+ *
+ * @return 0 if the message contained the expected information or 1 if not.
+ */
+int cmd_channel_mock_validate_message (const char *arg_info, void *expected, void *actual)
+{
+	struct cmd_message *msg_expected = (struct cmd_message*) expected;
+	struct cmd_message *msg_actual = (struct cmd_message*) actual;
+	int fail = 0;
+
+	if (msg_expected->dest_addr != msg_actual->dest_addr) {
+		platform_printf ("%sUnexpected destination address: expected=0x%x, actual=0x%x" NEWLINE,
+			arg_info, msg_expected->dest_addr, msg_actual->dest_addr);
+		fail |= 1;
+	}
+
+	if (msg_expected->pkt_size != msg_actual->pkt_size) {
+		platform_printf ("%sUnexpected packet length: expected=0x%lx, actual=0x%lx" NEWLINE, arg_info,
+			msg_expected->pkt_size, msg_actual->pkt_size);
+		fail |= 1;
+	}
+
+	if (msg_expected->msg_size != msg_actual->msg_size) {
+		platform_printf ("%sUnexpected message length: expected=0x%lx, actual=0x%lx" NEWLINE,
+			arg_info, msg_expected->msg_size, msg_actual->msg_size);
+		fail |= 1;
+	}
+	else {
+		fail |= testing_validate_array_prefix (msg_expected->data, msg_actual->data,
+			msg_expected->msg_size, arg_info);
+	}
+
+	return fail;
+}
@@ -140,6 +140,19 @@ static int ecc_mock_verify (struct ecc_engine *engine, struct ecc_public_key *ke
 		MOCK_ARG_CALL (sig_length));
 }
 
+int ecc_mock_verify_batch (struct ecc_engine *engine, struct ecc_verify_batch_entry *entries,
+	size_t count)
+{
+	struct ecc_engine_mock *mock = (struct ecc_engine_mock*) engine;
+
+	if (mock == NULL) {
+		return MOCK_INVALID_ARGUMENT;
+	}
+
+	MOCK_RETURN (&mock->mock, ecc_mock_verify_batch, engine, MOCK_ARG_PTR_CALL (entries),
+		MOCK_ARG_CALL (count));
+}
+
 static int ecc_mock_get_shared_secret_max_length (struct ecc_engine *engine,
 	struct ecc_private_key *key)
 {
@@ -180,7 +193,7 @@ static int ecc_mock_func_arg_count (void *func)
 		(func == ecc_mock_get_private_key_der) || (func == ecc_mock_get_public_key_der)) {
 		return 3;
 	}
-	else if (func == ecc_mock_release_key_pair) {
+	else if ((func == ecc_mock_release_key_pair) || (func == ecc_mock_verify_batch)) {
 		return 2;
 	}
 	else if ((func == ecc_mock_get_signature_max_length) ||
@@ -224,6 +237,9 @@ static const char* ecc_mock_func_name_map (void *func)
 	else if (func == ecc_mock_verify) {
 		return "verify";
 	}
+	else if (func == ecc_mock_verify_batch) {
+		return "verify_batch";
+	}
 	else if (func == ecc_mock_get_shared_secret_max_length) {
 		return "get_shared_secret_max_length";
 	}
@@ -366,6 +382,15 @@ static const char* ecc_mock_arg_name_map (void *func, int arg)
 				return "sig_length";
 		}
 	}
+	else if (func == ecc_mock_verify_batch) {
+		switch (arg) {
+			case 0:
+				return "entries";
+
+			case 1:
+				return "count";
+		}
+	}
 	else if (func == ecc_mock_get_shared_secret_max_length) {
 		switch (arg) {
 			case 0:
@@ -435,6 +460,19 @@ int ecc_mock_init (struct ecc_engine_mock *mock)
 	return 0;
 }
 
+/**
+ * Enable the optional API for batch signature verification.  This is not enabled by default so
+ * that the mock matches ECC engines that do not support batch verification.
+ *
+ * @param mock The mock to update.
+ */
+void ecc_mock_enable_verify_batch (struct ecc_engine_mock *mock)
+{
+	if (mock) {
+		mock->base.verify_batch = ecc_mock_verify_batch;
+	}
+}
+
 /**
  * Release a mock ECC API instance.
  *
@@ -22,6 +22,10 @@ void ecc_mock_release (struct ecc_engine_mock *mock);
 
 int ecc_mock_validate_and_release (struct ecc_engine_mock *mock);
 
+int ecc_mock_verify_batch (struct ecc_engine *engine, struct ecc_verify_batch_entry *entries,
+	size_t count);
+void ecc_mock_enable_verify_batch (struct ecc_engine_mock *mock);
+
 int ecc_mock_validate_point_public_key (const char *arg_info, void *expected, void *actual);
 int ecc_mock_validate_ecdsa_signature (const char *arg_info, void *expected, void *actual);
 
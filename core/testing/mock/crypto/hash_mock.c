@@ -138,15 +138,55 @@ static void hash_mock_cancel (struct hash_engine *engine)
 	MOCK_VOID_RETURN_NO_ARGS (&mock->mock, hash_mock_cancel, engine);
 }
 
+static int hash_mock_save_state (struct hash_engine *engine, struct hash_saved_state *state)
+{
+	struct hash_engine_mock *mock = (struct hash_engine_mock*) engine;
+
+	if (mock == NULL) {
+		return MOCK_INVALID_ARGUMENT;
+	}
+
+	MOCK_RETURN (&mock->mock, hash_mock_save_state, engine, MOCK_ARG_PTR_CALL (state));
+}
+
+static int hash_mock_restore_state (struct hash_engine *engine,
+	const struct hash_saved_state *state)
+{
+	struct hash_engine_mock *mock = (struct hash_engine_mock*) engine;
+
+	if (mock == NULL) {
+		return MOCK_INVALID_ARGUMENT;
+	}
+
+	MOCK_RETURN (&mock->mock, hash_mock_restore_state, engine, MOCK_ARG_PTR_CALL (state));
+}
+
+static int hash_mock_calculate_sha256_multi (struct hash_engine *engine,
+	const struct hash_multi_buffer *buffers, size_t count)
+{
+	struct hash_engine_mock *mock = (struct hash_engine_mock*) engine;
+
+	if (mock == NULL) {
+		return MOCK_INVALID_ARGUMENT;
+	}
+
+	MOCK_RETURN (&mock->mock, hash_mock_calculate_sha256_multi, engine,
+		MOCK_ARG_PTR_CALL (buffers), MOCK_ARG_CALL (count));
+}
+
 static int hash_mock_func_arg_count (void *func)
 {
 	if ((func == hash_mock_calculate_sha1) || (func == hash_mock_calculate_sha256) ||
 		(func == hash_mock_calculate_sha384) || (func == hash_mock_calculate_sha512)) {
 		return 4;
 	}
-	else if ((func == hash_mock_update) || (func == hash_mock_finish)) {
+	else if ((func == hash_mock_update) || (func == hash_mock_finish) ||
+		(func == hash_mock_calculate_sha256_multi)) {
 		return 2;
 	}
+	else if ((func == hash_mock_save_state) || (func == hash_mock_restore_state)) {
+		return 1;
+	}
 	else {
 		return 0;
 	}
@@ -187,6 +227,15 @@ static const char* hash_mock_func_name_map (void *func)
 	else if (func == hash_mock_cancel) {
 		return "cancel";
 	}
+	else if (func == hash_mock_save_state) {
+		return "save_state";
+	}
+	else if (func == hash_mock_restore_state) {
+		return "restore_state";
+	}
+	else if (func == hash_mock_calculate_sha256_multi) {
+		return "calculate_sha256_multi";
+	}
 	else {
 		return "unknown";
 	}
@@ -272,6 +321,21 @@ static const char* hash_mock_arg_name_map (void *func, int arg)
 				return "hash_length";
 		}
 	}
+	else if ((func == hash_mock_save_state) || (func == hash_mock_restore_state)) {
+		switch (arg) {
+			case 0:
+				return "state";
+		}
+	}
+	else if (func == hash_mock_calculate_sha256_multi) {
+		switch (arg) {
+			case 0:
+				return "buffers";
+
+			case 1:
+				return "count";
+		}
+	}
 
 	return "unknown";
 }
@@ -325,6 +389,33 @@ int hash_mock_init (struct hash_engine_mock *mock)
 	return 0;
 }
 
+/**
+ * Enable the optional APIs for saving and restoring hash state.  These are not enabled by default
+ * so that the mock matches hash engines that do not support saving hash state.
+ *
+ * @param mock The mock to update.
+ */
+void hash_mock_enable_save_state (struct hash_engine_mock *mock)
+{
+	if (mock) {
+		mock->base.save_state = hash_mock_save_state;
+		mock->base.restore_state = hash_mock_restore_state;
+	}
+}
+
+/**
+ * Enable the optional API for multi-buffer SHA-256 hashing.  This is not enabled by default so that
+ * the mock matches hash engines that do not support multi-buffer hashing.
+ *
+ * @param mock The mock to update.
+ */
+void hash_mock_enable_sha256_multi (struct hash_engine_mock *mock)
+{
+	if (mock) {
+		mock->base.calculate_sha256_multi = hash_mock_calculate_sha256_multi;
+	}
+}
+
 /**
  * Release a mock hash API instance.
  *
@@ -22,6 +22,10 @@ void hash_mock_release (struct hash_engine_mock *mock);
 
 int hash_mock_validate_and_release (struct hash_engine_mock *mock);
 
+void hash_mock_enable_save_state (struct hash_engine_mock *mock);
+
+void hash_mock_enable_sha256_multi (struct hash_engine_mock *mock);
+
 int hash_mock_expect_hmac_init (struct hash_engine_mock *mock, const uint8_t *key,
 	size_t key_length, enum hash_type hmac_algo);
 int hash_mock_expect_hmac_finish (struct hash_engine_mock *mock, const uint8_t *key,
@@ -207,6 +207,19 @@ static int host_flash_manager_dual_mock_reset_flash (
 	MOCK_RETURN_NO_ARGS (&mock->mock, host_flash_manager_dual_mock_reset_flash, manager);
 }
 
+static void host_flash_manager_dual_mock_invalidate_verified_flash (
+	struct host_flash_manager *manager)
+{
+	struct host_flash_manager_dual_mock *mock = (struct host_flash_manager_dual_mock*) manager;
+
+	if (mock == NULL) {
+		return;
+	}
+
+	MOCK_VOID_RETURN_NO_ARGS (&mock->mock, host_flash_manager_dual_mock_invalidate_verified_flash,
+		manager);
+}
+
 static int host_flash_manager_dual_mock_func_arg_count (void *func)
 {
 	if (func == host_flash_manager_dual_mock_validate_read_only_flash) {
@@ -281,6 +294,9 @@ static const char* host_flash_manager_dual_mock_func_name_map (void *func)
 	else if (func == host_flash_manager_dual_mock_reset_flash) {
 		return "reset_flash";
 	}
+	else if (func == host_flash_manager_dual_mock_invalidate_verified_flash) {
+		return "invalidate_verified_flash";
+	}
 	else {
 		return "unknown";
 	}
@@ -433,6 +449,8 @@ int host_flash_manager_dual_mock_init (struct host_flash_manager_dual_mock *mock
 		host_flash_manager_dual_mock_set_flash_for_host_access;
 	mock->base.base.host_has_flash_access = host_flash_manager_dual_mock_host_has_flash_access;
 	mock->base.base.reset_flash = host_flash_manager_dual_mock_reset_flash;
+	mock->base.base.invalidate_verified_flash =
+		host_flash_manager_dual_mock_invalidate_verified_flash;
 
 	mock->mock.func_arg_count = host_flash_manager_dual_mock_func_arg_count;
 	mock->mock.func_name_map = host_flash_manager_dual_mock_func_name_map;
@@ -354,9 +354,26 @@ static int spi_filter_interface_mock_clear_filter_rw_regions (
 	MOCK_RETURN_NO_ARGS (&mock->mock, spi_filter_interface_mock_clear_filter_rw_regions, filter);
 }
 
+int spi_filter_interface_mock_get_dirty_block_bitmap (const struct spi_filter_interface *filter,
+	spi_filter_cs cs, bool clear, uint8_t *bitmap, size_t length, uint32_t *block_size)
+{
+	struct spi_filter_interface_mock *mock = (struct spi_filter_interface_mock*) filter;
+
+	if (mock == NULL) {
+		return MOCK_INVALID_ARGUMENT;
+	}
+
+	MOCK_RETURN (&mock->mock, spi_filter_interface_mock_get_dirty_block_bitmap, filter,
+		MOCK_ARG_CALL (cs), MOCK_ARG_CALL (clear), MOCK_ARG_PTR_CALL (bitmap),
+		MOCK_ARG_CALL (length), MOCK_ARG_PTR_CALL (block_size));
+}
+
 static int spi_filter_interface_mock_func_arg_count (void *func)
 {
-	if ((func == spi_filter_interface_mock_get_filter_rw_region) ||
+	if (func == spi_filter_interface_mock_get_dirty_block_bitmap) {
+		return 5;
+	}
+	else if ((func == spi_filter_interface_mock_get_filter_rw_region) ||
 		(func == spi_filter_interface_mock_set_filter_rw_region)) {
 		return 3;
 	}
@@ -472,6 +489,9 @@ static const char* spi_filter_interface_mock_func_name_map (void *func)
 	else if (func == spi_filter_interface_mock_clear_filter_rw_regions) {
 		return "clear_filter_rw_regions";
 	}
+	else if (func == spi_filter_interface_mock_get_dirty_block_bitmap) {
+		return "get_dirty_block_bitmap";
+	}
 	else {
 		return "unknown";
 	}
@@ -635,6 +655,24 @@ static const char* spi_filter_interface_mock_arg_name_map (void *func, int arg)
 				return "end_addr";
 		}
 	}
+	else if (func == spi_filter_interface_mock_get_dirty_block_bitmap) {
+		switch (arg) {
+			case 0:
+				return "cs";
+
+			case 1:
+				return "clear";
+
+			case 2:
+				return "bitmap";
+
+			case 3:
+				return "length";
+
+			case 4:
+				return "block_size";
+		}
+	}
 
 	return "unknown";
 }
@@ -702,6 +740,19 @@ int spi_filter_interface_mock_init (struct spi_filter_interface_mock *mock)
 	return 0;
 }
 
+/**
+ * Enable the optional API for reporting host writes at block granularity.  This is not enabled by
+ * default so that the mock matches SPI filters that only report the flash dirty state.
+ *
+ * @param mock The mock to update.
+ */
+void spi_filter_interface_mock_enable_dirty_block_tracking (struct spi_filter_interface_mock *mock)
+{
+	if (mock) {
+		mock->base.get_dirty_block_bitmap = spi_filter_interface_mock_get_dirty_block_bitmap;
+	}
+}
+
 /**
  * Release the resource used by a SPI filter mock instance.
  *
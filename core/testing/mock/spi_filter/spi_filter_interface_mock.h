@@ -22,5 +22,9 @@ void spi_filter_interface_mock_release (struct spi_filter_interface_mock *mock);
 
 int spi_filter_interface_mock_validate_and_release (struct spi_filter_interface_mock *mock);
 
+int spi_filter_interface_mock_get_dirty_block_bitmap (const struct spi_filter_interface *filter,
+	spi_filter_cs cs, bool clear, uint8_t *bitmap, size_t length, uint32_t *block_size);
+void spi_filter_interface_mock_enable_dirty_block_tracking (struct spi_filter_interface_mock *mock);
+
 
 #endif /* SPI_FILTER_INTERFACE_MOCK_H_ */
@@ -0,0 +1,92 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "testing.h"
+#include "platform_api.h"
+
+
+TEST_SUITE_LABEL ("platform_atomic");
+
+
+/*******************
+ * Test cases
+ *******************/
+
+static void platform_atomic_test_load_store (CuTest *test)
+{
+	volatile uint32_t value = 0;
+
+	TEST_START;
+
+	CuAssertIntEquals (test, 0, platform_atomic_load (&value));
+
+	platform_atomic_store (&value, 0x12345678);
+	CuAssertIntEquals (test, 0x12345678, platform_atomic_load (&value));
+	CuAssertIntEquals (test, 0x12345678, value);
+}
+
+static void platform_atomic_test_fetch_add (CuTest *test)
+{
+	volatile uint32_t value = 10;
+	uint32_t prev;
+
+	TEST_START;
+
+	prev = platform_atomic_fetch_add (&value, 5);
+	CuAssertIntEquals (test, 10, prev);
+	CuAssertIntEquals (test, 15, platform_atomic_load (&value));
+
+	prev = platform_atomic_fetch_add (&value, -1);
+	CuAssertIntEquals (test, 15, prev);
+	CuAssertIntEquals (test, 14, platform_atomic_load (&value));
+}
+
+static void platform_atomic_test_fetch_add_wrap (CuTest *test)
+{
+	volatile uint32_t value = 0xffffffff;
+	uint32_t prev;
+
+	TEST_START;
+
+	prev = platform_atomic_fetch_add (&value, 2);
+	CuAssertIntEquals (test, 0xffffffff, prev);
+	CuAssertIntEquals (test, 1, platform_atomic_load (&value));
+}
+
+static void platform_atomic_test_compare_exchange (CuTest *test)
+{
+	volatile uint32_t value = 100;
+	bool exchanged;
+
+	TEST_START;
+
+	exchanged = platform_atomic_compare_exchange (&value, 100, 200);
+	CuAssertIntEquals (test, true, exchanged);
+	CuAssertIntEquals (test, 200, platform_atomic_load (&value));
+}
+
+static void platform_atomic_test_compare_exchange_mismatch (CuTest *test)
+{
+	volatile uint32_t value = 100;
+	bool exchanged;
+
+	TEST_START;
+
+	exchanged = platform_atomic_compare_exchange (&value, 101, 200);
+	CuAssertIntEquals (test, false, exchanged);
+	CuAssertIntEquals (test, 100, platform_atomic_load (&value));
+}
+
+
+TEST_SUITE_START (platform_atomic);
+
+TEST (platform_atomic_test_load_store);
+TEST (platform_atomic_test_fetch_add);
+TEST (platform_atomic_test_fetch_add_wrap);
+TEST (platform_atomic_test_compare_exchange);
+TEST (platform_atomic_test_compare_exchange_mismatch);
+
+TEST_SUITE_END;
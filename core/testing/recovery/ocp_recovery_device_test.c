@@ -26,6 +26,9 @@ TEST_SUITE_LABEL ("ocp_recovery_device");
 #define	OCP_RECOVERY_DEVICE_TESTING_CMS_5_LEN			16
 #define	OCP_RECOVERY_DEVICE_TESTING_CMS_6_LEN			4
 
+/* Length of the read-ahead buffer for the log region. */
+#define	OCP_RECOVERY_DEVICE_TESTING_LOG_CACHE_LEN		1024
+
 /* The number of 32-bit words make up each recovery memory region. */
 #define	OCP_RECOVERY_DEVICE_TESTING_CMS_0_WORDS			(OCP_RECOVERY_DEVICE_TESTING_CMS_0_LEN / 4)
 #define	OCP_RECOVERY_DEVICE_TESTING_CMS_1_WORDS			(OCP_RECOVERY_DEVICE_TESTING_CMS_1_LEN / 4)
@@ -45,6 +48,7 @@ struct ocp_recovery_device_testing {
 	uint8_t cms_5[OCP_RECOVERY_DEVICE_TESTING_CMS_5_LEN];		/**< Buffer for CMS vendor R/W region (type 5). */
 	uint8_t cms_6[OCP_RECOVERY_DEVICE_TESTING_CMS_6_LEN];		/**< Buffer for CMS vendor RO region (type 6). */
 	struct ocp_recovery_device_cms cms[OCP_RECOVERY_DEVICE_TESTING_MAX_CMS];	/**< List of CMS regions. */
+	uint8_t log_buffer[OCP_RECOVERY_DEVICE_TESTING_LOG_CACHE_LEN];	/**< Read-ahead buffer for variable CMS. */
 };
 
 
@@ -4614,6 +4618,547 @@ static void ocp_recovery_device_test_indirect_data_read_from_log_data_error (CuT
 	ocp_recovery_device_testing_release (test, &recovery);
 }
 
+static void ocp_recovery_device_test_set_cms_read_buffer_too_small (CuTest *test)
+{
+	struct ocp_recovery_device_testing recovery;
+	int status;
+
+	TEST_START;
+
+	ocp_recovery_device_testing_init (test, &recovery, recovery.cms,
+		OCP_RECOVERY_DEVICE_TESTING_MAX_CMS);
+
+	status = ocp_recovery_device_set_cms_read_buffer (&recovery.test, recovery.log_buffer, 251);
+	CuAssertIntEquals (test, OCP_RECOVERY_DEVICE_CMS_CACHE_TOO_SMALL, status);
+
+	ocp_recovery_device_testing_release (test, &recovery);
+}
+
+static void ocp_recovery_device_test_set_cms_read_buffer_null (CuTest *test)
+{
+	struct ocp_recovery_device_testing recovery;
+	int status;
+
+	TEST_START;
+
+	ocp_recovery_device_testing_init (test, &recovery, recovery.cms,
+		OCP_RECOVERY_DEVICE_TESTING_MAX_CMS);
+
+	status = ocp_recovery_device_set_cms_read_buffer (NULL, recovery.log_buffer,
+		sizeof (recovery.log_buffer));
+	CuAssertIntEquals (test, OCP_RECOVERY_DEVICE_INVALID_ARGUMENT, status);
+
+	ocp_recovery_device_testing_release (test, &recovery);
+}
+
+static void ocp_recovery_device_test_indirect_data_read_from_log_cached (CuTest *test)
+{
+	struct ocp_recovery_device_testing recovery;
+	int status;
+	union ocp_recovery_device_cmd_buffer output;
+	uint8_t log_data[2048];
+	size_t offset;
+	size_t read_len;
+	size_t fill_len;
+	int i;
+
+	TEST_START;
+
+	for (i = 0; i < (int) sizeof (log_data); i++) {
+		log_data[i] = i * 7;
+	}
+
+	ocp_recovery_device_testing_init_dependencies (test, &recovery);
+
+	status = ocp_recovery_device_init (&recovery.test, &recovery.state, &recovery.hw.base,
+		recovery.cms, OCP_RECOVERY_DEVICE_TESTING_MAX_CMS);
+	CuAssertIntEquals (test, 0, status);
+
+	status = ocp_recovery_device_set_cms_read_buffer (&recovery.test, recovery.log_buffer,
+		sizeof (recovery.log_buffer));
+	CuAssertIntEquals (test, 0, status);
+
+	ocp_recovery_device_testing_set_indirect_ctrl (test, &recovery, 2, 0);
+
+	for (offset = 0; offset < sizeof (log_data); offset += read_len) {
+		read_len = sizeof (log_data) - offset;
+		if (read_len > 252) {
+			read_len = 252;
+		}
+
+		status = ocp_recovery_device_start_new_command (&recovery.test,
+			OCP_RECOVERY_CMD_INDIRECT_DATA);
+		CuAssertIntEquals (test, 0, status);
+
+		status = mock_expect (&recovery.log.mock, recovery.log.base.get_size, &recovery.log,
+			sizeof (log_data));
+
+		/* The log only needs to be read when the data is not in the read-ahead buffer. */
+		if ((offset == 0) || (offset == 1008) || (offset == 2016)) {
+			fill_len = sizeof (log_data) - offset;
+			if (fill_len > OCP_RECOVERY_DEVICE_TESTING_LOG_CACHE_LEN) {
+				fill_len = OCP_RECOVERY_DEVICE_TESTING_LOG_CACHE_LEN;
+			}
+
+			status |= mock_expect (&recovery.log.mock, recovery.log.base.get_data, &recovery.log,
+				fill_len, MOCK_ARG (offset), MOCK_ARG_NOT_NULL,
+				MOCK_ARG (OCP_RECOVERY_DEVICE_TESTING_LOG_CACHE_LEN));
+			status |= mock_expect_output (&recovery.log.mock, 1, &log_data[offset], fill_len,
+				2);
+		}
+
+		CuAssertIntEquals (test, 0, status);
+
+		status = ocp_recovery_device_read_request (&recovery.test, &output);
+		CuAssertIntEquals (test, read_len, status);
+
+		status = testing_validate_array (&log_data[offset], output.bytes, read_len);
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	ocp_recovery_device_testing_check_indirect_ctrl (test, &recovery, 2, sizeof (log_data));
+
+	ocp_recovery_device_testing_release (test, &recovery);
+}
+
+static void ocp_recovery_device_test_indirect_data_read_from_log_cached_at_offset (CuTest *test)
+{
+	struct ocp_recovery_device_testing recovery;
+	int status;
+	union ocp_recovery_device_cmd_buffer output;
+	uint8_t log_data[2048];
+	uint32_t offset = 0x40;
+	int i;
+
+	TEST_START;
+
+	for (i = 0; i < (int) sizeof (log_data); i++) {
+		log_data[i] = i * 7;
+	}
+
+	ocp_recovery_device_testing_init_dependencies (test, &recovery);
+
+	status = ocp_recovery_device_init (&recovery.test, &recovery.state, &recovery.hw.base,
+		recovery.cms, OCP_RECOVERY_DEVICE_TESTING_MAX_CMS);
+	CuAssertIntEquals (test, 0, status);
+
+	status = ocp_recovery_device_set_cms_read_buffer (&recovery.test, recovery.log_buffer,
+		sizeof (recovery.log_buffer));
+	CuAssertIntEquals (test, 0, status);
+
+	/* Fill the buffer from the beginning of the log. */
+	ocp_recovery_device_testing_set_indirect_ctrl (test, &recovery, 2, 0);
+
+	status = ocp_recovery_device_start_new_command (&recovery.test, OCP_RECOVERY_CMD_INDIRECT_DATA);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&recovery.log.mock, recovery.log.base.get_size, &recovery.log,
+		sizeof (log_data));
+
+	status |= mock_expect (&recovery.log.mock, recovery.log.base.get_data, &recovery.log,
+		OCP_RECOVERY_DEVICE_TESTING_LOG_CACHE_LEN, MOCK_ARG (0), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (OCP_RECOVERY_DEVICE_TESTING_LOG_CACHE_LEN));
+	status |= mock_expect_output (&recovery.log.mock, 1, log_data,
+		OCP_RECOVERY_DEVICE_TESTING_LOG_CACHE_LEN, 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = ocp_recovery_device_read_request (&recovery.test, &output);
+	CuAssertIntEquals (test, 252, status);
+
+	status = testing_validate_array (log_data, output.bytes, status);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Selecting a new offset discards the buffered data. */
+	ocp_recovery_device_testing_set_indirect_ctrl (test, &recovery, 2, offset);
+
+	status = ocp_recovery_device_start_new_command (&recovery.test, OCP_RECOVERY_CMD_INDIRECT_DATA);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&recovery.log.mock, recovery.log.base.get_size, &recovery.log,
+		sizeof (log_data));
+
+	status |= mock_expect (&recovery.log.mock, recovery.log.base.get_data, &recovery.log,
+		OCP_RECOVERY_DEVICE_TESTING_LOG_CACHE_LEN, MOCK_ARG (offset), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (OCP_RECOVERY_DEVICE_TESTING_LOG_CACHE_LEN));
+	status |= mock_expect_output (&recovery.log.mock, 1, &log_data[offset],
+		OCP_RECOVERY_DEVICE_TESTING_LOG_CACHE_LEN, 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = ocp_recovery_device_read_request (&recovery.test, &output);
+	CuAssertIntEquals (test, 252, status);
+
+	status = testing_validate_array (&log_data[offset], output.bytes, status);
+	CuAssertIntEquals (test, 0, status);
+
+	ocp_recovery_device_testing_check_indirect_ctrl (test, &recovery, 2, offset + 252);
+
+	ocp_recovery_device_testing_release (test, &recovery);
+}
+
+static void ocp_recovery_device_test_indirect_data_read_from_log_cached_same_offset (CuTest *test)
+{
+	struct ocp_recovery_device_testing recovery;
+	int status;
+	union ocp_recovery_device_cmd_buffer output;
+	uint8_t log_data[2048];
+	uint8_t new_data[sizeof (log_data)];
+	int i;
+
+	TEST_START;
+
+	for (i = 0; i < (int) sizeof (log_data); i++) {
+		log_data[i] = i * 7;
+		new_data[i] = ~log_data[i];
+	}
+
+	ocp_recovery_device_testing_init_dependencies (test, &recovery);
+
+	status = ocp_recovery_device_init (&recovery.test, &recovery.state, &recovery.hw.base,
+		recovery.cms, OCP_RECOVERY_DEVICE_TESTING_MAX_CMS);
+	CuAssertIntEquals (test, 0, status);
+
+	status = ocp_recovery_device_set_cms_read_buffer (&recovery.test, recovery.log_buffer,
+		sizeof (recovery.log_buffer));
+	CuAssertIntEquals (test, 0, status);
+
+	ocp_recovery_device_testing_set_indirect_ctrl (test, &recovery, 2, 0);
+
+	status = ocp_recovery_device_start_new_command (&recovery.test, OCP_RECOVERY_CMD_INDIRECT_DATA);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&recovery.log.mock, recovery.log.base.get_size, &recovery.log,
+		sizeof (log_data));
+
+	status |= mock_expect (&recovery.log.mock, recovery.log.base.get_data, &recovery.log,
+		OCP_RECOVERY_DEVICE_TESTING_LOG_CACHE_LEN, MOCK_ARG (0), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (OCP_RECOVERY_DEVICE_TESTING_LOG_CACHE_LEN));
+	status |= mock_expect_output (&recovery.log.mock, 1, log_data,
+		OCP_RECOVERY_DEVICE_TESTING_LOG_CACHE_LEN, 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = ocp_recovery_device_read_request (&recovery.test, &output);
+	CuAssertIntEquals (test, 252, status);
+
+	status = testing_validate_array (log_data, output.bytes, status);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Writing INDIRECT_CTRL, even with the same CMS and offset, reads the log again. */
+	ocp_recovery_device_testing_set_indirect_ctrl (test, &recovery, 2, 0);
+
+	status = ocp_recovery_device_start_new_command (&recovery.test, OCP_RECOVERY_CMD_INDIRECT_DATA);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&recovery.log.mock, recovery.log.base.get_size, &recovery.log,
+		sizeof (log_data));
+
+	status |= mock_expect (&recovery.log.mock, recovery.log.base.get_data, &recovery.log,
+		OCP_RECOVERY_DEVICE_TESTING_LOG_CACHE_LEN, MOCK_ARG (0), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (OCP_RECOVERY_DEVICE_TESTING_LOG_CACHE_LEN));
+	status |= mock_expect_output (&recovery.log.mock, 1, new_data,
+		OCP_RECOVERY_DEVICE_TESTING_LOG_CACHE_LEN, 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = ocp_recovery_device_read_request (&recovery.test, &output);
+	CuAssertIntEquals (test, 252, status);
+
+	status = testing_validate_array (new_data, output.bytes, status);
+	CuAssertIntEquals (test, 0, status);
+
+	ocp_recovery_device_testing_release (test, &recovery);
+}
+
+static void ocp_recovery_device_test_indirect_data_read_from_log_cached_log_growth (CuTest *test)
+{
+	struct ocp_recovery_device_testing recovery;
+	int status;
+	union ocp_recovery_device_cmd_buffer output;
+	uint8_t log_data[2048];
+	int i;
+
+	TEST_START;
+
+	for (i = 0; i < (int) sizeof (log_data); i++) {
+		log_data[i] = i * 7;
+	}
+
+	ocp_recovery_device_testing_init_dependencies (test, &recovery);
+
+	status = ocp_recovery_device_init (&recovery.test, &recovery.state, &recovery.hw.base,
+		recovery.cms, OCP_RECOVERY_DEVICE_TESTING_MAX_CMS);
+	CuAssertIntEquals (test, 0, status);
+
+	status = ocp_recovery_device_set_cms_read_buffer (&recovery.test, recovery.log_buffer,
+		sizeof (recovery.log_buffer));
+	CuAssertIntEquals (test, 0, status);
+
+	ocp_recovery_device_testing_set_indirect_ctrl (test, &recovery, 2, 0);
+
+	/* Read the beginning of a short log.  All the log data is buffered. */
+	status = ocp_recovery_device_start_new_command (&recovery.test, OCP_RECOVERY_CMD_INDIRECT_DATA);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&recovery.log.mock, recovery.log.base.get_size, &recovery.log, 300);
+
+	status |= mock_expect (&recovery.log.mock, recovery.log.base.get_data, &recovery.log,
+		300, MOCK_ARG (0), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (OCP_RECOVERY_DEVICE_TESTING_LOG_CACHE_LEN));
+	status |= mock_expect_output (&recovery.log.mock, 1, log_data, 300, 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = ocp_recovery_device_read_request (&recovery.test, &output);
+	CuAssertIntEquals (test, 252, status);
+
+	status = testing_validate_array (log_data, output.bytes, status);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Read the rest of the log from the buffer. */
+	status = ocp_recovery_device_start_new_command (&recovery.test, OCP_RECOVERY_CMD_INDIRECT_DATA);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&recovery.log.mock, recovery.log.base.get_size, &recovery.log, 300);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = ocp_recovery_device_read_request (&recovery.test, &output);
+	CuAssertIntEquals (test, 48, status);
+
+	status = testing_validate_array (&log_data[252], output.bytes, status);
+	CuAssertIntEquals (test, 0, status);
+
+	/* New entries have been added to the log, which are not in the buffer. */
+	status = ocp_recovery_device_start_new_command (&recovery.test, OCP_RECOVERY_CMD_INDIRECT_DATA);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&recovery.log.mock, recovery.log.base.get_size, &recovery.log, 600);
+
+	status |= mock_expect (&recovery.log.mock, recovery.log.base.get_data, &recovery.log,
+		300, MOCK_ARG (300), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (OCP_RECOVERY_DEVICE_TESTING_LOG_CACHE_LEN));
+	status |= mock_expect_output (&recovery.log.mock, 1, &log_data[300], 300,
+		2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = ocp_recovery_device_read_request (&recovery.test, &output);
+	CuAssertIntEquals (test, 252, status);
+
+	status = testing_validate_array (&log_data[300], output.bytes, status);
+	CuAssertIntEquals (test, 0, status);
+
+	ocp_recovery_device_testing_check_indirect_ctrl (test, &recovery, 2, 552);
+
+	ocp_recovery_device_testing_release (test, &recovery);
+}
+
+static void ocp_recovery_device_test_indirect_data_read_from_log_cached_with_wrap (CuTest *test)
+{
+	struct ocp_recovery_device_testing recovery;
+	int status;
+	union ocp_recovery_device_cmd_buffer output;
+	uint8_t log_data[2048];
+	uint8_t new_data[sizeof (log_data)];
+	int i;
+
+	TEST_START;
+
+	for (i = 0; i < (int) sizeof (log_data); i++) {
+		log_data[i] = i * 7;
+		new_data[i] = ~log_data[i];
+	}
+
+	ocp_recovery_device_testing_init_dependencies (test, &recovery);
+
+	status = ocp_recovery_device_init (&recovery.test, &recovery.state, &recovery.hw.base,
+		recovery.cms, OCP_RECOVERY_DEVICE_TESTING_MAX_CMS);
+	CuAssertIntEquals (test, 0, status);
+
+	status = ocp_recovery_device_set_cms_read_buffer (&recovery.test, recovery.log_buffer,
+		sizeof (recovery.log_buffer));
+	CuAssertIntEquals (test, 0, status);
+
+	ocp_recovery_device_testing_set_indirect_ctrl (test, &recovery, 2, 0);
+
+	/* Read the entire log. */
+	status = ocp_recovery_device_start_new_command (&recovery.test, OCP_RECOVERY_CMD_INDIRECT_DATA);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&recovery.log.mock, recovery.log.base.get_size, &recovery.log, 256);
+
+	status |= mock_expect (&recovery.log.mock, recovery.log.base.get_data, &recovery.log,
+		256, MOCK_ARG (0), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (OCP_RECOVERY_DEVICE_TESTING_LOG_CACHE_LEN));
+	status |= mock_expect_output (&recovery.log.mock, 1, log_data, 256, 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = ocp_recovery_device_read_request (&recovery.test, &output);
+	CuAssertIntEquals (test, 252, status);
+
+	status = testing_validate_array (log_data, output.bytes, status);
+	CuAssertIntEquals (test, 0, status);
+
+	status = ocp_recovery_device_start_new_command (&recovery.test, OCP_RECOVERY_CMD_INDIRECT_DATA);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&recovery.log.mock, recovery.log.base.get_size, &recovery.log, 256);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = ocp_recovery_device_read_request (&recovery.test, &output);
+	CuAssertIntEquals (test, 4, status);
+
+	status = testing_validate_array (&log_data[252], output.bytes, status);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Wrap around to the beginning.  The log is read again. */
+	status = ocp_recovery_device_start_new_command (&recovery.test, OCP_RECOVERY_CMD_INDIRECT_DATA);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&recovery.log.mock, recovery.log.base.get_size, &recovery.log, 256);
+
+	status |= mock_expect (&recovery.log.mock, recovery.log.base.get_data, &recovery.log,
+		256, MOCK_ARG (0), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (OCP_RECOVERY_DEVICE_TESTING_LOG_CACHE_LEN));
+	status |= mock_expect_output (&recovery.log.mock, 1, new_data, 256, 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = ocp_recovery_device_read_request (&recovery.test, &output);
+	CuAssertIntEquals (test, 252, status);
+
+	status = testing_validate_array (new_data, output.bytes, status);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&recovery.log.mock, recovery.log.base.get_size, &recovery.log, 256);
+
+	ocp_recovery_device_testing_check_protocol_status (test, &recovery, 0);
+	ocp_recovery_device_testing_check_indirect_status (test, &recovery, 0x01, 1, 256 / 4);
+	ocp_recovery_device_testing_check_indirect_ctrl (test, &recovery, 2, 252);
+
+	ocp_recovery_device_testing_release (test, &recovery);
+}
+
+static void ocp_recovery_device_test_indirect_data_read_from_log_cached_data_error (CuTest *test)
+{
+	struct ocp_recovery_device_testing recovery;
+	int status;
+	union ocp_recovery_device_cmd_buffer output;
+	uint8_t log_data[2048];
+	int i;
+
+	TEST_START;
+
+	for (i = 0; i < (int) sizeof (log_data); i++) {
+		log_data[i] = i * 7;
+	}
+
+	ocp_recovery_device_testing_init_dependencies (test, &recovery);
+
+	status = ocp_recovery_device_init (&recovery.test, &recovery.state, &recovery.hw.base,
+		recovery.cms, OCP_RECOVERY_DEVICE_TESTING_MAX_CMS);
+	CuAssertIntEquals (test, 0, status);
+
+	status = ocp_recovery_device_set_cms_read_buffer (&recovery.test, recovery.log_buffer,
+		sizeof (recovery.log_buffer));
+	CuAssertIntEquals (test, 0, status);
+
+	ocp_recovery_device_testing_set_indirect_ctrl (test, &recovery, 2, 0);
+
+	status = ocp_recovery_device_start_new_command (&recovery.test, OCP_RECOVERY_CMD_INDIRECT_DATA);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&recovery.log.mock, recovery.log.base.get_size, &recovery.log,
+		sizeof (log_data));
+
+	status |= mock_expect (&recovery.log.mock, recovery.log.base.get_data, &recovery.log,
+		OCP_RECOVERY_DEVICE_CMS_DATA_FAILED, MOCK_ARG (0), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (OCP_RECOVERY_DEVICE_TESTING_LOG_CACHE_LEN));
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = ocp_recovery_device_read_request (&recovery.test, &output);
+	CuAssertIntEquals (test, OCP_RECOVERY_DEVICE_CMS_DATA_FAILED, status);
+
+	/* The next read must go to the log again. */
+	status = ocp_recovery_device_start_new_command (&recovery.test, OCP_RECOVERY_CMD_INDIRECT_DATA);
+	CuAssertIntEquals (test, 0, status);
+
+	status = mock_expect (&recovery.log.mock, recovery.log.base.get_size, &recovery.log,
+		sizeof (log_data));
+
+	status |= mock_expect (&recovery.log.mock, recovery.log.base.get_data, &recovery.log,
+		OCP_RECOVERY_DEVICE_TESTING_LOG_CACHE_LEN, MOCK_ARG (0), MOCK_ARG_NOT_NULL,
+		MOCK_ARG (OCP_RECOVERY_DEVICE_TESTING_LOG_CACHE_LEN));
+	status |= mock_expect_output (&recovery.log.mock, 1, log_data,
+		OCP_RECOVERY_DEVICE_TESTING_LOG_CACHE_LEN, 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = ocp_recovery_device_read_request (&recovery.test, &output);
+	CuAssertIntEquals (test, 252, status);
+
+	status = testing_validate_array (log_data, output.bytes, status);
+	CuAssertIntEquals (test, 0, status);
+
+	ocp_recovery_device_testing_release (test, &recovery);
+}
+
+static void ocp_recovery_device_test_indirect_data_read_from_log_cached_buffer_removed (
+	CuTest *test)
+{
+	struct ocp_recovery_device_testing recovery;
+	int status;
+	union ocp_recovery_device_cmd_buffer output;
+	uint8_t log_data[2048];
+	int i;
+
+	TEST_START;
+
+	for (i = 0; i < (int) sizeof (log_data); i++) {
+		log_data[i] = i * 7;
+	}
+
+	ocp_recovery_device_testing_init (test, &recovery, recovery.cms,
+		OCP_RECOVERY_DEVICE_TESTING_MAX_CMS);
+
+	status = ocp_recovery_device_set_cms_read_buffer (&recovery.test, recovery.log_buffer,
+		sizeof (recovery.log_buffer));
+	CuAssertIntEquals (test, 0, status);
+
+	status = ocp_recovery_device_set_cms_read_buffer (&recovery.test, NULL, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	ocp_recovery_device_testing_set_indirect_ctrl (test, &recovery, 2, 0);
+
+	status = ocp_recovery_device_start_new_command (&recovery.test, OCP_RECOVERY_CMD_INDIRECT_DATA);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Without a read-ahead buffer, the log is only read for the requested data. */
+	status = mock_expect (&recovery.log.mock, recovery.log.base.get_size, &recovery.log,
+		sizeof (log_data));
+
+	status |= mock_expect (&recovery.log.mock, recovery.log.base.get_data, &recovery.log, 252,
+		MOCK_ARG (0), MOCK_ARG_NOT_NULL, MOCK_ARG (252));
+	status |= mock_expect_output (&recovery.log.mock, 1, log_data, 252, 2);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = ocp_recovery_device_read_request (&recovery.test, &output);
+	CuAssertIntEquals (test, 252, status);
+
+	status = testing_validate_array (log_data, output.bytes, 252);
+	CuAssertIntEquals (test, 0, status);
+
+	ocp_recovery_device_testing_check_indirect_ctrl (test, &recovery, 2, 252);
+
+	ocp_recovery_device_testing_release (test, &recovery);
+}
+
 static void ocp_recovery_device_test_indirect_data_read_min_region (CuTest *test)
 {
 	struct ocp_recovery_device_testing recovery;
@@ -6588,6 +7133,15 @@ TEST (ocp_recovery_device_test_indirect_data_read_from_log_at_offset_out_of_rang
 TEST (ocp_recovery_device_test_indirect_data_read_from_log_unaligned_log_data);
 TEST (ocp_recovery_device_test_indirect_data_read_from_log_size_error);
 TEST (ocp_recovery_device_test_indirect_data_read_from_log_data_error);
+TEST (ocp_recovery_device_test_set_cms_read_buffer_too_small);
+TEST (ocp_recovery_device_test_set_cms_read_buffer_null);
+TEST (ocp_recovery_device_test_indirect_data_read_from_log_cached);
+TEST (ocp_recovery_device_test_indirect_data_read_from_log_cached_at_offset);
+TEST (ocp_recovery_device_test_indirect_data_read_from_log_cached_same_offset);
+TEST (ocp_recovery_device_test_indirect_data_read_from_log_cached_log_growth);
+TEST (ocp_recovery_device_test_indirect_data_read_from_log_cached_with_wrap);
+TEST (ocp_recovery_device_test_indirect_data_read_from_log_cached_data_error);
+TEST (ocp_recovery_device_test_indirect_data_read_from_log_cached_buffer_removed);
 TEST (ocp_recovery_device_test_indirect_data_read_min_region);
 TEST (ocp_recovery_device_test_indirect_data_read_min_region_multiple);
 TEST (ocp_recovery_device_test_indirect_data_read_out_of_range_cms);
@@ -7,6 +7,7 @@
 #include "platform_api.h"
 #include "testing.h"
 #include "riot/ecc_riot.h"
+#include "riot/reference/include/RiotEcc.h"
 #include "testing/engines/rng_testing_engine.h"
 #include "testing/crypto/ecc_testing.h"
 #include "testing/crypto/rsa_testing.h"
@@ -1363,6 +1364,151 @@ static void ecc_riot_test_get_public_key_der_private_key (CuTest *test)
 	ecc_riot_release (&engine);
 }
 
+/**
+ * Check that the fixed-base multiplication of the base point generates the same point as the
+ * generic point multiplication.
+ *
+ * @param test The testing framework.
+ * @param scalar The big endian scalar multiplier.
+ */
+static void ecc_riot_testing_check_base_point_multiply (CuTest *test, const uint8_t *scalar)
+{
+	bigval_t k;
+	ecc_publickey fixed;
+	ecc_publickey generic;
+	int status;
+
+	BigIntToBigVal (&k, scalar, RIOT_ECC_PRIVATE_BYTES);
+
+	RIOT_BasePointMultiply (&fixed, &k, true);
+	RIOT_BasePointMultiply (&generic, &k, false);
+
+	CuAssertIntEquals (test, generic.infinity, fixed.infinity);
+
+	status = testing_validate_array ((uint8_t*) &generic.x, (uint8_t*) &fixed.x,
+		sizeof (generic.x));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array ((uint8_t*) &generic.y, (uint8_t*) &fixed.y,
+		sizeof (generic.y));
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void ecc_riot_test_base_point_multiply (CuTest *test)
+{
+	bigval_t k;
+	ecc_publickey pub;
+	uint8_t coord[RIOT_ECC_COORD_BYTES];
+	int status;
+
+	TEST_START;
+
+	BigIntToBigVal (&k, ECC_PRIVKEY, ECC_PRIVKEY_LEN);
+
+	RIOT_BasePointMultiply (&pub, &k, true);
+	CuAssertIntEquals (test, false, pub.infinity);
+
+	BigValToBigInt (coord, &pub.x);
+	status = testing_validate_array (ECC_PUBKEY_POINT.x, coord, sizeof (coord));
+	CuAssertIntEquals (test, 0, status);
+
+	BigValToBigInt (coord, &pub.y);
+	status = testing_validate_array (ECC_PUBKEY_POINT.y, coord, sizeof (coord));
+	CuAssertIntEquals (test, 0, status);
+
+	RIOT_BasePointMultiply (&pub, &k, false);
+	CuAssertIntEquals (test, false, pub.infinity);
+
+	BigValToBigInt (coord, &pub.x);
+	status = testing_validate_array (ECC_PUBKEY_POINT.x, coord, sizeof (coord));
+	CuAssertIntEquals (test, 0, status);
+
+	BigValToBigInt (coord, &pub.y);
+	status = testing_validate_array (ECC_PUBKEY_POINT.y, coord, sizeof (coord));
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void ecc_riot_test_base_point_multiply_fixed_base_edge_cases (CuTest *test)
+{
+	uint8_t scalar[RIOT_ECC_PRIVATE_BYTES];
+	/* The order of the curve, minus one. */
+	const uint8_t order_minus_one[] = {
+		0xff,0xff,0xff,0xff,0x00,0x00,0x00,0x00,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,
+		0xbc,0xe6,0xfa,0xad,0xa7,0x17,0x9e,0x84,0xf3,0xb9,0xca,0xc2,0xfc,0x63,0x25,0x50
+	};
+	int i;
+
+	TEST_START;
+
+	/* Small multipliers only use the lowest comb column. */
+	for (i = 1; i < 64; i++) {
+		memset (scalar, 0, sizeof (scalar));
+		scalar[sizeof (scalar) - 1] = i;
+
+		ecc_riot_testing_check_base_point_multiply (test, scalar);
+	}
+
+	/* Single bits select individual table entries. */
+	for (i = 0; i < 256; i++) {
+		memset (scalar, 0, sizeof (scalar));
+		scalar[sizeof (scalar) - 1 - (i / 8)] = 1 << (i % 8);
+
+		ecc_riot_testing_check_base_point_multiply (test, scalar);
+	}
+
+	/* Every bit set in the top row and every column. */
+	memset (scalar, 0xff, sizeof (scalar));
+	scalar[0] = 0x7f;
+	ecc_riot_testing_check_base_point_multiply (test, scalar);
+
+	ecc_riot_testing_check_base_point_multiply (test, order_minus_one);
+
+	memcpy (scalar, order_minus_one, sizeof (scalar));
+	scalar[sizeof (scalar) - 1] = 0x4f;
+	ecc_riot_testing_check_base_point_multiply (test, scalar);
+}
+
+static void ecc_riot_test_base_point_multiply_fixed_base_random (CuTest *test)
+{
+	uint8_t scalar[RIOT_ECC_PRIVATE_BYTES];
+	int status;
+	int i;
+	RNG_TESTING_ENGINE rng;
+
+	TEST_START;
+
+	status = RNG_TESTING_ENGINE_INIT (&rng);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 64; i++) {
+		status = rng.base.generate_random_buffer (&rng.base, sizeof (scalar), scalar);
+		CuAssertIntEquals (test, 0, status);
+
+		/* Keep the multiplier less than the order of the curve. */
+		scalar[0] &= 0x7f;
+
+		ecc_riot_testing_check_base_point_multiply (test, scalar);
+	}
+
+	RNG_TESTING_ENGINE_RELEASE (&rng);
+}
+
+static void ecc_riot_test_base_point_multiply_zero (CuTest *test)
+{
+	bigval_t k;
+	ecc_publickey pub;
+
+	TEST_START;
+
+	memset (&k, 0, sizeof (k));
+
+	RIOT_BasePointMultiply (&pub, &k, true);
+	CuAssertIntEquals (test, true, pub.infinity);
+
+	RIOT_BasePointMultiply (&pub, &k, false);
+	CuAssertIntEquals (test, true, pub.infinity);
+}
+
 
 TEST_SUITE_START (ecc_riot);
 
@@ -1419,5 +1565,9 @@ TEST (ecc_riot_test_get_private_key_der_derived_public_key_from_private);
 TEST (ecc_riot_test_get_public_key_der_derived_key_pair);
 TEST (ecc_riot_test_get_public_key_der_null);
 TEST (ecc_riot_test_get_public_key_der_private_key);
+TEST (ecc_riot_test_base_point_multiply);
+TEST (ecc_riot_test_base_point_multiply_fixed_base_edge_cases);
+TEST (ecc_riot_test_base_point_multiply_fixed_base_random);
+TEST (ecc_riot_test_base_point_multiply_zero);
 
 TEST_SUITE_END;
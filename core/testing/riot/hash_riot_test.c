@@ -44,6 +44,8 @@ static void hash_riot_test_init (CuTest *test)
 	CuAssertPtrNotNull (test, engine.base.update);
 	CuAssertPtrNotNull (test, engine.base.finish);
 	CuAssertPtrNotNull (test, engine.base.cancel);
+	CuAssertPtrNotNull (test, engine.base.save_state);
+	CuAssertPtrNotNull (test, engine.base.restore_state);
 
 	hash_riot_release (&engine);
 }
@@ -1820,6 +1822,282 @@ static void hash_riot_test_calculate_sha512 (CuTest *test)
 }
 #endif
 
+#ifdef HASH_ENABLE_SHA1
+static void hash_riot_test_save_state_sha1 (CuTest *test)
+{
+	struct hash_engine_riot engine;
+	struct hash_saved_state state;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA1_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_riot_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha1 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.save_state (&engine.base, &state);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA1_TEST_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.restore_state (&engine.base, &state);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA1_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.restore_state (&engine.base, &state);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA1_TEST_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_riot_release (&engine);
+}
+#endif
+
+static void hash_riot_test_save_state_sha256 (CuTest *test)
+{
+	struct hash_engine_riot engine;
+	struct hash_saved_state state;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_riot_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha256 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.save_state (&engine.base, &state);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA256_TEST_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.restore_state (&engine.base, &state);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA256_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.restore_state (&engine.base, &state);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA256_TEST_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_riot_release (&engine);
+}
+
+static void hash_riot_test_save_state_cancel (CuTest *test)
+{
+	struct hash_engine_riot engine;
+	struct hash_saved_state state;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_riot_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha256 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.save_state (&engine.base, &state);
+	CuAssertIntEquals (test, 0, status);
+
+	engine.base.cancel (&engine.base);
+
+	status = engine.base.restore_state (&engine.base, &state);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA256_TEST_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_riot_release (&engine);
+}
+
+static void hash_riot_test_save_state_null (CuTest *test)
+{
+	struct hash_engine_riot engine;
+	struct hash_saved_state state;
+	int status;
+
+	TEST_START;
+
+	status = hash_riot_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha256 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.save_state (NULL, &state);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	status = engine.base.save_state (&engine.base, NULL);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	hash_riot_release (&engine);
+}
+
+static void hash_riot_test_save_state_no_active_hash (CuTest *test)
+{
+	struct hash_engine_riot engine;
+	struct hash_saved_state state;
+	int status;
+
+	TEST_START;
+
+	status = hash_riot_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.save_state (&engine.base, &state);
+	CuAssertIntEquals (test, HASH_ENGINE_NO_ACTIVE_HASH, status);
+
+	hash_riot_release (&engine);
+}
+
+static void hash_riot_test_restore_state_null (CuTest *test)
+{
+	struct hash_engine_riot engine;
+	struct hash_saved_state state;
+	int status;
+
+	TEST_START;
+
+	status = hash_riot_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha256 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.save_state (&engine.base, &state);
+	CuAssertIntEquals (test, 0, status);
+
+	engine.base.cancel (&engine.base);
+
+	status = engine.base.restore_state (NULL, &state);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	status = engine.base.restore_state (&engine.base, NULL);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	hash_riot_release (&engine);
+}
+
+static void hash_riot_test_restore_state_hash_in_progress (CuTest *test)
+{
+	struct hash_engine_riot engine;
+	struct hash_saved_state state;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_riot_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha256 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.save_state (&engine.base, &state);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.restore_state (&engine.base, &state);
+	CuAssertIntEquals (test, HASH_ENGINE_HASH_IN_PROGRESS, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA256_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_riot_release (&engine);
+}
+
+static void hash_riot_test_restore_state_unknown (CuTest *test)
+{
+	struct hash_engine_riot engine;
+	struct hash_saved_state state;
+	int status;
+
+	TEST_START;
+
+	status = hash_riot_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	memset (&state, 0, sizeof (state));
+	state.active = HASH_ACTIVE_NONE;
+
+	status = engine.base.restore_state (&engine.base, &state);
+	CuAssertIntEquals (test, HASH_ENGINE_UNSUPPORTED_HASH, status);
+
+	status = engine.base.start_sha256 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	hash_riot_release (&engine);
+}
+
 
 TEST_SUITE_START (hash_riot);
 
@@ -1904,5 +2182,15 @@ TEST (hash_riot_test_calculate_sha384);
 #ifdef HASH_ENABLE_SHA512
 TEST (hash_riot_test_calculate_sha512);
 #endif
+#ifdef HASH_ENABLE_SHA1
+TEST (hash_riot_test_save_state_sha1);
+#endif
+TEST (hash_riot_test_save_state_sha256);
+TEST (hash_riot_test_save_state_cancel);
+TEST (hash_riot_test_save_state_null);
+TEST (hash_riot_test_save_state_no_active_hash);
+TEST (hash_riot_test_restore_state_null);
+TEST (hash_riot_test_restore_state_hash_in_progress);
+TEST (hash_riot_test_restore_state_unknown);
 
 TEST_SUITE_END;
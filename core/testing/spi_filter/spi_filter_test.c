@@ -2198,6 +2198,141 @@ static void spi_filter_test_log_filter_config_single_flash_cs1 (CuTest *test)
 	CuAssertIntEquals (test, 0, status);
 }
 
+static void spi_filter_test_get_dirty_block_bitmap (CuTest *test)
+{
+	struct spi_filter_interface_mock filter;
+	int status;
+	uint8_t bitmap[4];
+	uint32_t block_size;
+	uint8_t expected[] = {0x01, 0x80, 0x00, 0x10};
+	uint32_t expected_size = 0x10000;
+
+	TEST_START;
+
+	status = spi_filter_interface_mock_init (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_filter_interface_mock_enable_dirty_block_tracking (&filter);
+
+	status = mock_expect (&filter.mock, filter.base.get_dirty_block_bitmap, &filter, 0,
+		MOCK_ARG (SPI_FILTER_CS_1), MOCK_ARG (true), MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (bitmap)),
+		MOCK_ARG_NOT_NULL);
+	status |= mock_expect_output (&filter.mock, 2, expected, sizeof (expected), 3);
+	status |= mock_expect_output (&filter.mock, 4, &expected_size, sizeof (expected_size), -1);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_get_dirty_block_bitmap (&filter.base, SPI_FILTER_CS_1, true, bitmap,
+		sizeof (bitmap), &block_size);
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (expected, bitmap, sizeof (expected));
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, expected_size, block_size);
+
+	status = spi_filter_interface_mock_validate_and_release (&filter);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void spi_filter_test_get_dirty_block_bitmap_null (CuTest *test)
+{
+	struct spi_filter_interface_mock filter;
+	int status;
+	uint8_t bitmap[4];
+	uint32_t block_size;
+
+	TEST_START;
+
+	status = spi_filter_interface_mock_init (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_filter_interface_mock_enable_dirty_block_tracking (&filter);
+
+	status = spi_filter_get_dirty_block_bitmap (NULL, SPI_FILTER_CS_0, false, bitmap,
+		sizeof (bitmap), &block_size);
+	CuAssertIntEquals (test, SPI_FILTER_INVALID_ARGUMENT, status);
+
+	status = spi_filter_get_dirty_block_bitmap (&filter.base, SPI_FILTER_CS_0, false, NULL,
+		sizeof (bitmap), &block_size);
+	CuAssertIntEquals (test, SPI_FILTER_INVALID_ARGUMENT, status);
+
+	status = spi_filter_get_dirty_block_bitmap (&filter.base, SPI_FILTER_CS_0, false, bitmap,
+		sizeof (bitmap), NULL);
+	CuAssertIntEquals (test, SPI_FILTER_INVALID_ARGUMENT, status);
+
+	status = spi_filter_interface_mock_validate_and_release (&filter);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void spi_filter_test_get_dirty_block_bitmap_unsupported (CuTest *test)
+{
+	struct spi_filter_interface_mock filter;
+	int status;
+	uint8_t bitmap[4];
+	uint32_t block_size;
+
+	TEST_START;
+
+	status = spi_filter_interface_mock_init (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_get_dirty_block_bitmap (&filter.base, SPI_FILTER_CS_0, false, bitmap,
+		sizeof (bitmap), &block_size);
+	CuAssertIntEquals (test, SPI_FILTER_UNSUPPORTED_OPERATION, status);
+
+	status = spi_filter_interface_mock_validate_and_release (&filter);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void spi_filter_test_get_dirty_block_bitmap_error (CuTest *test)
+{
+	struct spi_filter_interface_mock filter;
+	int status;
+	uint8_t bitmap[4];
+	uint32_t block_size;
+
+	TEST_START;
+
+	status = spi_filter_interface_mock_init (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	spi_filter_interface_mock_enable_dirty_block_tracking (&filter);
+
+	status = mock_expect (&filter.mock, filter.base.get_dirty_block_bitmap, &filter,
+		SPI_FILTER_GET_DIRTY_BLOCKS_FAILED, MOCK_ARG (SPI_FILTER_CS_0), MOCK_ARG (false),
+		MOCK_ARG_NOT_NULL, MOCK_ARG (sizeof (bitmap)), MOCK_ARG_NOT_NULL);
+
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_get_dirty_block_bitmap (&filter.base, SPI_FILTER_CS_0, false, bitmap,
+		sizeof (bitmap), &block_size);
+	CuAssertIntEquals (test, SPI_FILTER_GET_DIRTY_BLOCKS_FAILED, status);
+
+	status = spi_filter_interface_mock_validate_and_release (&filter);
+	CuAssertIntEquals (test, 0, status);
+}
+
+static void spi_filter_test_is_dirty_block_tracking_supported (CuTest *test)
+{
+	struct spi_filter_interface_mock filter;
+	int status;
+
+	TEST_START;
+
+	status = spi_filter_interface_mock_init (&filter);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, false, spi_filter_is_dirty_block_tracking_supported (&filter.base));
+
+	spi_filter_interface_mock_enable_dirty_block_tracking (&filter);
+	CuAssertIntEquals (test, true, spi_filter_is_dirty_block_tracking_supported (&filter.base));
+
+	CuAssertIntEquals (test, false, spi_filter_is_dirty_block_tracking_supported (NULL));
+
+	status = spi_filter_interface_mock_validate_and_release (&filter);
+	CuAssertIntEquals (test, 0, status);
+}
+
 
 TEST_SUITE_START (spi_filter);
 
@@ -2216,6 +2351,11 @@ TEST (spi_filter_test_log_filter_config_full_fw);
 TEST (spi_filter_test_log_filter_config_two_regions);
 TEST (spi_filter_test_log_filter_config_single_flash);
 TEST (spi_filter_test_log_filter_config_single_flash_cs1);
+TEST (spi_filter_test_get_dirty_block_bitmap);
+TEST (spi_filter_test_get_dirty_block_bitmap_null);
+TEST (spi_filter_test_get_dirty_block_bitmap_unsupported);
+TEST (spi_filter_test_get_dirty_block_bitmap_error);
+TEST (spi_filter_test_is_dirty_block_tracking_supported);
 
 /* Tear down after the tests in this suite have run. */
 TEST (spi_filter_testing_suite_tear_down);
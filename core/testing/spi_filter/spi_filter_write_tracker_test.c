@@ -0,0 +1,517 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "testing.h"
+#include "spi_filter/spi_filter_write_tracker.h"
+#include "spi_filter/spi_filter_interface.h"
+
+
+TEST_SUITE_LABEL ("spi_filter_write_tracker");
+
+
+/*******************
+ * Test cases
+ *******************/
+
+static void spi_filter_write_tracker_test_init (CuTest *test)
+{
+	struct spi_filter_write_tracker tracker;
+	uint8_t bitmap[4];
+	uint8_t out[4];
+	uint8_t expected[4] = {0};
+	uint32_t block_size;
+	int status;
+
+	TEST_START;
+
+	memset (bitmap, 0xff, sizeof (bitmap));
+
+	status = spi_filter_write_tracker_init (&tracker, bitmap, sizeof (bitmap), 0x10000, 0x200000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_write_tracker_get_dirty_block_bitmap (&tracker, false, out, sizeof (out),
+		&block_size);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0x10000, block_size);
+
+	status = testing_validate_array (expected, out, sizeof (expected));
+	CuAssertIntEquals (test, 0, status);
+
+	spi_filter_write_tracker_release (&tracker);
+}
+
+static void spi_filter_write_tracker_test_init_partial_block (CuTest *test)
+{
+	struct spi_filter_write_tracker tracker;
+	uint8_t bitmap[1];
+	uint8_t out[1];
+	uint8_t expected[] = {0x80};
+	uint32_t block_size;
+	int status;
+
+	TEST_START;
+
+	status = spi_filter_write_tracker_init (&tracker, bitmap, sizeof (bitmap), 0x1000, 0x7800);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_write_tracker_record_write (&tracker, 0x7400, 0x100);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_write_tracker_get_dirty_block_bitmap (&tracker, false, out, sizeof (out),
+		&block_size);
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (expected, out, sizeof (expected));
+	CuAssertIntEquals (test, 0, status);
+
+	spi_filter_write_tracker_release (&tracker);
+}
+
+static void spi_filter_write_tracker_test_init_null (CuTest *test)
+{
+	struct spi_filter_write_tracker tracker;
+	uint8_t bitmap[4];
+	int status;
+
+	TEST_START;
+
+	status = spi_filter_write_tracker_init (NULL, bitmap, sizeof (bitmap), 0x10000, 0x200000);
+	CuAssertIntEquals (test, SPI_FILTER_INVALID_ARGUMENT, status);
+
+	status = spi_filter_write_tracker_init (&tracker, NULL, sizeof (bitmap), 0x10000, 0x200000);
+	CuAssertIntEquals (test, SPI_FILTER_INVALID_ARGUMENT, status);
+
+	status = spi_filter_write_tracker_init (&tracker, bitmap, sizeof (bitmap), 0x10000, 0);
+	CuAssertIntEquals (test, SPI_FILTER_INVALID_ARGUMENT, status);
+}
+
+static void spi_filter_write_tracker_test_init_bad_block_size (CuTest *test)
+{
+	struct spi_filter_write_tracker tracker;
+	uint8_t bitmap[4];
+	int status;
+
+	TEST_START;
+
+	status = spi_filter_write_tracker_init (&tracker, bitmap, sizeof (bitmap), 0, 0x200000);
+	CuAssertIntEquals (test, SPI_FILTER_INVALID_BLOCK_SIZE, status);
+
+	status = spi_filter_write_tracker_init (&tracker, bitmap, sizeof (bitmap), 0x18000, 0x200000);
+	CuAssertIntEquals (test, SPI_FILTER_INVALID_BLOCK_SIZE, status);
+}
+
+static void spi_filter_write_tracker_test_init_bitmap_too_small (CuTest *test)
+{
+	struct spi_filter_write_tracker tracker;
+	uint8_t bitmap[4];
+	int status;
+
+	TEST_START;
+
+	status = spi_filter_write_tracker_init (&tracker, bitmap, sizeof (bitmap), 0x10000, 0x2010000);
+	CuAssertIntEquals (test, SPI_FILTER_DIRTY_BITMAP_TOO_SMALL, status);
+}
+
+static void spi_filter_write_tracker_test_release_null (CuTest *test)
+{
+	TEST_START;
+
+	spi_filter_write_tracker_release (NULL);
+}
+
+static void spi_filter_write_tracker_test_record_write (CuTest *test)
+{
+	struct spi_filter_write_tracker tracker;
+	uint8_t bitmap[4];
+	uint8_t out[4];
+	uint8_t expected[] = {0x00, 0x04, 0x00, 0x00};
+	uint32_t block_size;
+	int status;
+
+	TEST_START;
+
+	status = spi_filter_write_tracker_init (&tracker, bitmap, sizeof (bitmap), 0x10000, 0x200000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_write_tracker_record_write (&tracker, 0xa1234, 0x100);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_write_tracker_get_dirty_block_bitmap (&tracker, false, out, sizeof (out),
+		&block_size);
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (expected, out, sizeof (expected));
+	CuAssertIntEquals (test, 0, status);
+
+	spi_filter_write_tracker_release (&tracker);
+}
+
+static void spi_filter_write_tracker_test_record_write_multiple_blocks (CuTest *test)
+{
+	struct spi_filter_write_tracker tracker;
+	uint8_t bitmap[4];
+	uint8_t out[4];
+	uint8_t expected[] = {0x80, 0x03, 0x00, 0x00};
+	uint32_t block_size;
+	int status;
+
+	TEST_START;
+
+	status = spi_filter_write_tracker_init (&tracker, bitmap, sizeof (bitmap), 0x10000, 0x200000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_write_tracker_record_write (&tracker, 0x7ff00, 0x10200);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_write_tracker_get_dirty_block_bitmap (&tracker, false, out, sizeof (out),
+		&block_size);
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (expected, out, sizeof (expected));
+	CuAssertIntEquals (test, 0, status);
+
+	spi_filter_write_tracker_release (&tracker);
+}
+
+static void spi_filter_write_tracker_test_record_write_full_bytes (CuTest *test)
+{
+	struct spi_filter_write_tracker tracker;
+	uint8_t bitmap[4];
+	uint8_t out[4];
+	uint8_t expected[] = {0xfc, 0xff, 0x07, 0x00};
+	uint32_t block_size;
+	int status;
+
+	TEST_START;
+
+	status = spi_filter_write_tracker_init (&tracker, bitmap, sizeof (bitmap), 0x10000, 0x200000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_write_tracker_record_write (&tracker, 0x20000, 0x110000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_write_tracker_get_dirty_block_bitmap (&tracker, false, out, sizeof (out),
+		&block_size);
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (expected, out, sizeof (expected));
+	CuAssertIntEquals (test, 0, status);
+
+	spi_filter_write_tracker_release (&tracker);
+}
+
+static void spi_filter_write_tracker_test_record_write_multiple_writes (CuTest *test)
+{
+	struct spi_filter_write_tracker tracker;
+	uint8_t bitmap[4];
+	uint8_t out[4];
+	uint8_t expected[] = {0x01, 0x00, 0x00, 0x80};
+	uint32_t block_size;
+	int status;
+
+	TEST_START;
+
+	status = spi_filter_write_tracker_init (&tracker, bitmap, sizeof (bitmap), 0x10000, 0x200000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_write_tracker_record_write (&tracker, 0, 0x1000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_write_tracker_record_write (&tracker, 0x1ff000, 0x1000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_write_tracker_record_write (&tracker, 0x4000, 0x100);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_write_tracker_get_dirty_block_bitmap (&tracker, false, out, sizeof (out),
+		&block_size);
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (expected, out, sizeof (expected));
+	CuAssertIntEquals (test, 0, status);
+
+	spi_filter_write_tracker_release (&tracker);
+}
+
+static void spi_filter_write_tracker_test_record_write_past_end (CuTest *test)
+{
+	struct spi_filter_write_tracker tracker;
+	uint8_t bitmap[4];
+	uint8_t out[4];
+	uint8_t expected[] = {0xff, 0xff, 0xff, 0xff};
+	uint32_t block_size;
+	int status;
+
+	TEST_START;
+
+	status = spi_filter_write_tracker_init (&tracker, bitmap, sizeof (bitmap), 0x10000, 0x200000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_write_tracker_record_write (&tracker, 0x1ff000, 0x2000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_write_tracker_get_dirty_block_bitmap (&tracker, false, out, sizeof (out),
+		&block_size);
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (expected, out, sizeof (expected));
+	CuAssertIntEquals (test, 0, status);
+
+	spi_filter_write_tracker_release (&tracker);
+}
+
+static void spi_filter_write_tracker_test_record_write_address_overflow (CuTest *test)
+{
+	struct spi_filter_write_tracker tracker;
+	uint8_t bitmap[4];
+	uint8_t out[4];
+	uint8_t expected[] = {0xff, 0xff, 0xff, 0xff};
+	uint32_t block_size;
+	int status;
+
+	TEST_START;
+
+	status = spi_filter_write_tracker_init (&tracker, bitmap, sizeof (bitmap), 0x10000, 0x200000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_write_tracker_record_write (&tracker, 0xfffff000, 0x2000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_write_tracker_get_dirty_block_bitmap (&tracker, false, out, sizeof (out),
+		&block_size);
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (expected, out, sizeof (expected));
+	CuAssertIntEquals (test, 0, status);
+
+	spi_filter_write_tracker_release (&tracker);
+}
+
+static void spi_filter_write_tracker_test_record_write_zero_length (CuTest *test)
+{
+	struct spi_filter_write_tracker tracker;
+	uint8_t bitmap[4];
+	uint8_t out[4];
+	uint8_t expected[4] = {0};
+	uint32_t block_size;
+	int status;
+
+	TEST_START;
+
+	status = spi_filter_write_tracker_init (&tracker, bitmap, sizeof (bitmap), 0x10000, 0x200000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_write_tracker_record_write (&tracker, 0x10000, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_write_tracker_get_dirty_block_bitmap (&tracker, false, out, sizeof (out),
+		&block_size);
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (expected, out, sizeof (expected));
+	CuAssertIntEquals (test, 0, status);
+
+	spi_filter_write_tracker_release (&tracker);
+}
+
+static void spi_filter_write_tracker_test_record_write_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = spi_filter_write_tracker_record_write (NULL, 0x10000, 0x100);
+	CuAssertIntEquals (test, SPI_FILTER_INVALID_ARGUMENT, status);
+}
+
+static void spi_filter_write_tracker_test_mark_all_dirty (CuTest *test)
+{
+	struct spi_filter_write_tracker tracker;
+	uint8_t bitmap[4];
+	uint8_t out[4];
+	uint8_t expected[] = {0xff, 0xff, 0x0f, 0x00};
+	uint32_t block_size;
+	int status;
+
+	TEST_START;
+
+	status = spi_filter_write_tracker_init (&tracker, bitmap, sizeof (bitmap), 0x10000, 0x140000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_write_tracker_mark_all_dirty (&tracker);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_write_tracker_get_dirty_block_bitmap (&tracker, false, out, sizeof (out),
+		&block_size);
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (expected, out, sizeof (expected));
+	CuAssertIntEquals (test, 0, status);
+
+	spi_filter_write_tracker_release (&tracker);
+}
+
+static void spi_filter_write_tracker_test_mark_all_dirty_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = spi_filter_write_tracker_mark_all_dirty (NULL);
+	CuAssertIntEquals (test, SPI_FILTER_INVALID_ARGUMENT, status);
+}
+
+static void spi_filter_write_tracker_test_get_dirty_block_bitmap_clear (CuTest *test)
+{
+	struct spi_filter_write_tracker tracker;
+	uint8_t bitmap[4];
+	uint8_t out[4];
+	uint8_t expected[] = {0x00, 0x04, 0x00, 0x00};
+	uint8_t cleared[4] = {0};
+	uint32_t block_size;
+	int status;
+
+	TEST_START;
+
+	status = spi_filter_write_tracker_init (&tracker, bitmap, sizeof (bitmap), 0x10000, 0x200000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_write_tracker_record_write (&tracker, 0xa1234, 0x100);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_write_tracker_get_dirty_block_bitmap (&tracker, true, out, sizeof (out),
+		&block_size);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0x10000, block_size);
+
+	status = testing_validate_array (expected, out, sizeof (expected));
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_write_tracker_get_dirty_block_bitmap (&tracker, false, out, sizeof (out),
+		&block_size);
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (cleared, out, sizeof (cleared));
+	CuAssertIntEquals (test, 0, status);
+
+	spi_filter_write_tracker_release (&tracker);
+}
+
+static void spi_filter_write_tracker_test_get_dirty_block_bitmap_larger_buffer (CuTest *test)
+{
+	struct spi_filter_write_tracker tracker;
+	uint8_t bitmap[2];
+	uint8_t out[4];
+	uint8_t expected[] = {0x00, 0x80, 0x00, 0x00};
+	uint32_t block_size;
+	int status;
+
+	TEST_START;
+
+	status = spi_filter_write_tracker_init (&tracker, bitmap, sizeof (bitmap), 0x1000, 0x10000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_write_tracker_record_write (&tracker, 0xf000, 0x1000);
+	CuAssertIntEquals (test, 0, status);
+
+	memset (out, 0x55, sizeof (out));
+
+	status = spi_filter_write_tracker_get_dirty_block_bitmap (&tracker, false, out, sizeof (out),
+		&block_size);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0x1000, block_size);
+
+	status = testing_validate_array (expected, out, sizeof (expected));
+	CuAssertIntEquals (test, 0, status);
+
+	spi_filter_write_tracker_release (&tracker);
+}
+
+static void spi_filter_write_tracker_test_get_dirty_block_bitmap_buffer_too_small (CuTest *test)
+{
+	struct spi_filter_write_tracker tracker;
+	uint8_t bitmap[4];
+	uint8_t out[4];
+	uint8_t expected[] = {0x00, 0x00, 0x00, 0x80};
+	uint32_t block_size;
+	int status;
+
+	TEST_START;
+
+	status = spi_filter_write_tracker_init (&tracker, bitmap, sizeof (bitmap), 0x10000, 0x200000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_write_tracker_record_write (&tracker, 0x1f0000, 0x100);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_write_tracker_get_dirty_block_bitmap (&tracker, true, out,
+		sizeof (out) - 1, &block_size);
+	CuAssertIntEquals (test, SPI_FILTER_DIRTY_BITMAP_TOO_SMALL, status);
+
+	/* Tracking must not be cleared on failure. */
+	status = spi_filter_write_tracker_get_dirty_block_bitmap (&tracker, false, out, sizeof (out),
+		&block_size);
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (expected, out, sizeof (expected));
+	CuAssertIntEquals (test, 0, status);
+
+	spi_filter_write_tracker_release (&tracker);
+}
+
+static void spi_filter_write_tracker_test_get_dirty_block_bitmap_null (CuTest *test)
+{
+	struct spi_filter_write_tracker tracker;
+	uint8_t bitmap[4];
+	uint8_t out[4];
+	uint32_t block_size;
+	int status;
+
+	TEST_START;
+
+	status = spi_filter_write_tracker_init (&tracker, bitmap, sizeof (bitmap), 0x10000, 0x200000);
+	CuAssertIntEquals (test, 0, status);
+
+	status = spi_filter_write_tracker_get_dirty_block_bitmap (NULL, false, out, sizeof (out),
+		&block_size);
+	CuAssertIntEquals (test, SPI_FILTER_INVALID_ARGUMENT, status);
+
+	status = spi_filter_write_tracker_get_dirty_block_bitmap (&tracker, false, NULL, sizeof (out),
+		&block_size);
+	CuAssertIntEquals (test, SPI_FILTER_INVALID_ARGUMENT, status);
+
+	status = spi_filter_write_tracker_get_dirty_block_bitmap (&tracker, false, out, sizeof (out),
+		NULL);
+	CuAssertIntEquals (test, SPI_FILTER_INVALID_ARGUMENT, status);
+
+	spi_filter_write_tracker_release (&tracker);
+}
+
+
+TEST_SUITE_START (spi_filter_write_tracker);
+
+TEST (spi_filter_write_tracker_test_init);
+TEST (spi_filter_write_tracker_test_init_partial_block);
+TEST (spi_filter_write_tracker_test_init_null);
+TEST (spi_filter_write_tracker_test_init_bad_block_size);
+TEST (spi_filter_write_tracker_test_init_bitmap_too_small);
+TEST (spi_filter_write_tracker_test_release_null);
+TEST (spi_filter_write_tracker_test_record_write);
+TEST (spi_filter_write_tracker_test_record_write_multiple_blocks);
+TEST (spi_filter_write_tracker_test_record_write_full_bytes);
+TEST (spi_filter_write_tracker_test_record_write_multiple_writes);
+TEST (spi_filter_write_tracker_test_record_write_past_end);
+TEST (spi_filter_write_tracker_test_record_write_address_overflow);
+TEST (spi_filter_write_tracker_test_record_write_zero_length);
+TEST (spi_filter_write_tracker_test_record_write_null);
+TEST (spi_filter_write_tracker_test_mark_all_dirty);
+TEST (spi_filter_write_tracker_test_mark_all_dirty_null);
+TEST (spi_filter_write_tracker_test_get_dirty_block_bitmap_clear);
+TEST (spi_filter_write_tracker_test_get_dirty_block_bitmap_larger_buffer);
+TEST (spi_filter_write_tracker_test_get_dirty_block_bitmap_buffer_too_small);
+TEST (spi_filter_write_tracker_test_get_dirty_block_bitmap_null);
+
+TEST_SUITE_END;
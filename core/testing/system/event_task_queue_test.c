@@ -0,0 +1,668 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "testing.h"
+#include "system/event_task_queue.h"
+#include "system/event_task_queue_static.h"
+
+
+TEST_SUITE_LABEL ("event_task_queue");
+
+
+/**
+ * Number of event slots to use for testing.
+ */
+#define	EVENT_TASK_QUEUE_TESTING_SLOTS		3
+
+
+/**
+ * Add an event to the queue.
+ *
+ * @param test The testing framework.
+ * @param queue The queue to update.
+ * @param handler The handler index for the event.
+ * @param priority The priority of the event.
+ * @param action The action identifier to assign to the event.
+ */
+static void event_task_queue_testing_add_event (CuTest *test, const struct event_task_queue *queue,
+	int handler, uint8_t priority, uint32_t action)
+{
+	struct event_task_context *context;
+	int status;
+
+	status = event_task_queue_reserve (queue, &context);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertPtrNotNull (test, context);
+
+	context->action = action;
+
+	status = event_task_queue_push (queue, handler, priority);
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Remove the next event from the queue and check that it is the expected event.
+ *
+ * @param test The testing framework.
+ * @param queue The queue to update.
+ * @param handler The expected handler index for the event.
+ * @param action The expected action identifier for the event.
+ */
+static void event_task_queue_testing_process_event (CuTest *test,
+	const struct event_task_queue *queue, int handler, uint32_t action)
+{
+	struct event_task_context *context;
+	int status;
+
+	status = event_task_queue_pop (queue, &context);
+	CuAssertIntEquals (test, handler, status);
+	CuAssertPtrNotNull (test, context);
+	CuAssertIntEquals (test, action, context->action);
+
+	status = event_task_queue_complete (queue);
+	CuAssertIntEquals (test, 0, status);
+}
+
+
+/*******************
+ * Test cases
+ *******************/
+
+static void event_task_queue_test_init (CuTest *test)
+{
+	struct event_task_queue_slot slots[EVENT_TASK_QUEUE_TESTING_SLOTS];
+	struct event_task_queue_state state;
+	struct event_task_queue queue;
+	struct event_task_queue_stats stats;
+	int status;
+
+	TEST_START;
+
+	status = event_task_queue_init (&queue, &state, slots, EVENT_TASK_QUEUE_TESTING_SLOTS);
+	CuAssertIntEquals (test, 0, status);
+
+	status = event_task_queue_get_stats (&queue, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, stats.depth);
+	CuAssertIntEquals (test, 0, stats.max_depth);
+	CuAssertIntEquals (test, 0, stats.queued);
+	CuAssertIntEquals (test, 0, stats.rejected_full);
+	CuAssertIntEquals (test, 0, stats.rejected_reserved);
+	CuAssertIntEquals (test, 0, stats.dispatched);
+
+	event_task_queue_release (&queue);
+}
+
+static void event_task_queue_test_init_null (CuTest *test)
+{
+	struct event_task_queue_slot slots[EVENT_TASK_QUEUE_TESTING_SLOTS];
+	struct event_task_queue_state state;
+	struct event_task_queue queue;
+	int status;
+
+	TEST_START;
+
+	status = event_task_queue_init (NULL, &state, slots, EVENT_TASK_QUEUE_TESTING_SLOTS);
+	CuAssertIntEquals (test, EVENT_TASK_INVALID_ARGUMENT, status);
+
+	status = event_task_queue_init (&queue, NULL, slots, EVENT_TASK_QUEUE_TESTING_SLOTS);
+	CuAssertIntEquals (test, EVENT_TASK_INVALID_ARGUMENT, status);
+
+	status = event_task_queue_init (&queue, &state, NULL, EVENT_TASK_QUEUE_TESTING_SLOTS);
+	CuAssertIntEquals (test, EVENT_TASK_INVALID_ARGUMENT, status);
+
+	status = event_task_queue_init (&queue, &state, slots, 0);
+	CuAssertIntEquals (test, EVENT_TASK_INVALID_ARGUMENT, status);
+}
+
+static void event_task_queue_test_static_init (CuTest *test)
+{
+	struct event_task_queue_slot slots[EVENT_TASK_QUEUE_TESTING_SLOTS];
+	struct event_task_queue_state state;
+	struct event_task_queue queue = event_task_queue_static_init (&state, slots,
+		EVENT_TASK_QUEUE_TESTING_SLOTS);
+	int status;
+
+	TEST_START;
+
+	status = event_task_queue_init_state (&queue);
+	CuAssertIntEquals (test, 0, status);
+
+	event_task_queue_testing_add_event (test, &queue, 1, EVENT_TASK_QUEUE_PRIORITY_NORMAL, 10);
+	event_task_queue_testing_process_event (test, &queue, 1, 10);
+
+	event_task_queue_release (&queue);
+}
+
+static void event_task_queue_test_static_init_null (CuTest *test)
+{
+	struct event_task_queue_slot slots[EVENT_TASK_QUEUE_TESTING_SLOTS];
+	struct event_task_queue_state state;
+	struct event_task_queue null_state = event_task_queue_static_init (NULL, slots,
+		EVENT_TASK_QUEUE_TESTING_SLOTS);
+	struct event_task_queue null_slots = event_task_queue_static_init (&state, NULL,
+		EVENT_TASK_QUEUE_TESTING_SLOTS);
+	struct event_task_queue no_slots = event_task_queue_static_init (&state, slots, 0);
+	int status;
+
+	TEST_START;
+
+	status = event_task_queue_init_state (NULL);
+	CuAssertIntEquals (test, EVENT_TASK_INVALID_ARGUMENT, status);
+
+	status = event_task_queue_init_state (&null_state);
+	CuAssertIntEquals (test, EVENT_TASK_INVALID_ARGUMENT, status);
+
+	status = event_task_queue_init_state (&null_slots);
+	CuAssertIntEquals (test, EVENT_TASK_INVALID_ARGUMENT, status);
+
+	status = event_task_queue_init_state (&no_slots);
+	CuAssertIntEquals (test, EVENT_TASK_INVALID_ARGUMENT, status);
+}
+
+static void event_task_queue_test_release_null (CuTest *test)
+{
+	TEST_START;
+
+	event_task_queue_release (NULL);
+}
+
+static void event_task_queue_test_fifo_order (CuTest *test)
+{
+	struct event_task_queue_slot slots[EVENT_TASK_QUEUE_TESTING_SLOTS];
+	struct event_task_queue_state state;
+	struct event_task_queue queue;
+	struct event_task_queue_stats stats;
+	int status;
+
+	TEST_START;
+
+	status = event_task_queue_init (&queue, &state, slots, EVENT_TASK_QUEUE_TESTING_SLOTS);
+	CuAssertIntEquals (test, 0, status);
+
+	event_task_queue_testing_add_event (test, &queue, 2, EVENT_TASK_QUEUE_PRIORITY_NORMAL, 10);
+	event_task_queue_testing_add_event (test, &queue, 0, EVENT_TASK_QUEUE_PRIORITY_NORMAL, 11);
+	event_task_queue_testing_add_event (test, &queue, 1, EVENT_TASK_QUEUE_PRIORITY_NORMAL, 12);
+
+	status = event_task_queue_get_stats (&queue, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 3, stats.depth);
+	CuAssertIntEquals (test, 3, stats.max_depth);
+	CuAssertIntEquals (test, 3, stats.queued);
+
+	event_task_queue_testing_process_event (test, &queue, 2, 10);
+	event_task_queue_testing_process_event (test, &queue, 0, 11);
+	event_task_queue_testing_process_event (test, &queue, 1, 12);
+
+	status = event_task_queue_get_stats (&queue, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, stats.depth);
+	CuAssertIntEquals (test, 3, stats.max_depth);
+	CuAssertIntEquals (test, 3, stats.queued);
+	CuAssertIntEquals (test, 0, stats.rejected_full);
+	CuAssertIntEquals (test, 0, stats.rejected_reserved);
+	CuAssertIntEquals (test, 3, stats.dispatched);
+
+	event_task_queue_release (&queue);
+}
+
+static void event_task_queue_test_priority_order (CuTest *test)
+{
+	struct event_task_queue_slot slots[5];
+	struct event_task_queue_state state;
+	struct event_task_queue queue;
+	int status;
+
+	TEST_START;
+
+	status = event_task_queue_init (&queue, &state, slots, 5);
+	CuAssertIntEquals (test, 0, status);
+
+	event_task_queue_testing_add_event (test, &queue, 0, EVENT_TASK_QUEUE_PRIORITY_NORMAL, 10);
+	event_task_queue_testing_add_event (test, &queue, 1, EVENT_TASK_QUEUE_PRIORITY_HIGHEST, 11);
+	event_task_queue_testing_add_event (test, &queue, 2, EVENT_TASK_QUEUE_PRIORITY_NORMAL + 1, 12);
+	event_task_queue_testing_add_event (test, &queue, 3, EVENT_TASK_QUEUE_PRIORITY_HIGHEST, 13);
+	event_task_queue_testing_add_event (test, &queue, 4, EVENT_TASK_QUEUE_PRIORITY_NORMAL, 14);
+
+	event_task_queue_testing_process_event (test, &queue, 1, 11);
+	event_task_queue_testing_process_event (test, &queue, 3, 13);
+	event_task_queue_testing_process_event (test, &queue, 2, 12);
+	event_task_queue_testing_process_event (test, &queue, 0, 10);
+	event_task_queue_testing_process_event (test, &queue, 4, 14);
+
+	event_task_queue_release (&queue);
+}
+
+static void event_task_queue_test_queue_while_running (CuTest *test)
+{
+	struct event_task_queue_slot slots[EVENT_TASK_QUEUE_TESTING_SLOTS];
+	struct event_task_queue_state state;
+	struct event_task_queue queue;
+	struct event_task_context *context;
+	int status;
+
+	TEST_START;
+
+	status = event_task_queue_init (&queue, &state, slots, EVENT_TASK_QUEUE_TESTING_SLOTS);
+	CuAssertIntEquals (test, 0, status);
+
+	event_task_queue_testing_add_event (test, &queue, 0, EVENT_TASK_QUEUE_PRIORITY_NORMAL, 10);
+
+	status = event_task_queue_pop (&queue, &context);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 10, context->action);
+
+	event_task_queue_testing_add_event (test, &queue, 1, EVENT_TASK_QUEUE_PRIORITY_NORMAL, 11);
+	event_task_queue_testing_add_event (test, &queue, 2, EVENT_TASK_QUEUE_PRIORITY_NORMAL, 12);
+
+	/* The event being processed must not be modified by new events. */
+	CuAssertIntEquals (test, 10, context->action);
+
+	status = event_task_queue_complete (&queue);
+	CuAssertIntEquals (test, 0, status);
+
+	event_task_queue_testing_process_event (test, &queue, 1, 11);
+	event_task_queue_testing_process_event (test, &queue, 2, 12);
+
+	event_task_queue_release (&queue);
+}
+
+static void event_task_queue_test_reserve_full (CuTest *test)
+{
+	struct event_task_queue_slot slots[EVENT_TASK_QUEUE_TESTING_SLOTS];
+	struct event_task_queue_state state;
+	struct event_task_queue queue;
+	struct event_task_queue_stats stats;
+	struct event_task_context *context;
+	int status;
+
+	TEST_START;
+
+	status = event_task_queue_init (&queue, &state, slots, EVENT_TASK_QUEUE_TESTING_SLOTS);
+	CuAssertIntEquals (test, 0, status);
+
+	event_task_queue_testing_add_event (test, &queue, 0, EVENT_TASK_QUEUE_PRIORITY_NORMAL, 10);
+	event_task_queue_testing_add_event (test, &queue, 1, EVENT_TASK_QUEUE_PRIORITY_NORMAL, 11);
+	event_task_queue_testing_add_event (test, &queue, 2, EVENT_TASK_QUEUE_PRIORITY_NORMAL, 12);
+
+	status = event_task_queue_reserve (&queue, &context);
+	CuAssertIntEquals (test, EVENT_TASK_BUSY, status);
+	CuAssertPtrEquals (test, NULL, context);
+
+	status = event_task_queue_get_stats (&queue, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, stats.rejected_full);
+	CuAssertIntEquals (test, 0, stats.rejected_reserved);
+
+	/* A slot is not available until the event has been completely processed. */
+	status = event_task_queue_pop (&queue, &context);
+	CuAssertIntEquals (test, 0, status);
+
+	status = event_task_queue_reserve (&queue, &context);
+	CuAssertIntEquals (test, EVENT_TASK_BUSY, status);
+
+	status = event_task_queue_complete (&queue);
+	CuAssertIntEquals (test, 0, status);
+
+	event_task_queue_testing_add_event (test, &queue, 0, EVENT_TASK_QUEUE_PRIORITY_NORMAL, 13);
+
+	event_task_queue_testing_process_event (test, &queue, 1, 11);
+	event_task_queue_testing_process_event (test, &queue, 2, 12);
+	event_task_queue_testing_process_event (test, &queue, 0, 13);
+
+	status = event_task_queue_get_stats (&queue, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 2, stats.rejected_full);
+	CuAssertIntEquals (test, 0, stats.rejected_reserved);
+	CuAssertIntEquals (test, 4, stats.queued);
+	CuAssertIntEquals (test, 4, stats.dispatched);
+
+	event_task_queue_release (&queue);
+}
+
+static void event_task_queue_test_reserve_already_reserved (CuTest *test)
+{
+	struct event_task_queue_slot slots[EVENT_TASK_QUEUE_TESTING_SLOTS];
+	struct event_task_queue_state state;
+	struct event_task_queue queue;
+	struct event_task_queue_stats stats;
+	struct event_task_context *context;
+	int status;
+
+	TEST_START;
+
+	status = event_task_queue_init (&queue, &state, slots, EVENT_TASK_QUEUE_TESTING_SLOTS);
+	CuAssertIntEquals (test, 0, status);
+
+	status = event_task_queue_reserve (&queue, &context);
+	CuAssertIntEquals (test, 0, status);
+
+	status = event_task_queue_reserve (&queue, &context);
+	CuAssertIntEquals (test, EVENT_TASK_BUSY, status);
+	CuAssertPtrEquals (test, NULL, context);
+
+	status = event_task_queue_get_stats (&queue, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, stats.rejected_full);
+	CuAssertIntEquals (test, 1, stats.rejected_reserved);
+
+	event_task_queue_release (&queue);
+}
+
+static void event_task_queue_test_reserve_null (CuTest *test)
+{
+	struct event_task_queue_slot slots[EVENT_TASK_QUEUE_TESTING_SLOTS];
+	struct event_task_queue_state state;
+	struct event_task_queue queue;
+	struct event_task_context *context;
+	int status;
+
+	TEST_START;
+
+	status = event_task_queue_init (&queue, &state, slots, EVENT_TASK_QUEUE_TESTING_SLOTS);
+	CuAssertIntEquals (test, 0, status);
+
+	status = event_task_queue_reserve (NULL, &context);
+	CuAssertIntEquals (test, EVENT_TASK_INVALID_ARGUMENT, status);
+
+	status = event_task_queue_reserve (&queue, NULL);
+	CuAssertIntEquals (test, EVENT_TASK_INVALID_ARGUMENT, status);
+
+	event_task_queue_release (&queue);
+}
+
+static void event_task_queue_test_cancel (CuTest *test)
+{
+	struct event_task_queue_slot slots[1];
+	struct event_task_queue_state state;
+	struct event_task_queue queue;
+	struct event_task_queue_stats stats;
+	struct event_task_context *context;
+	int status;
+
+	TEST_START;
+
+	status = event_task_queue_init (&queue, &state, slots, 1);
+	CuAssertIntEquals (test, 0, status);
+
+	status = event_task_queue_reserve (&queue, &context);
+	CuAssertIntEquals (test, 0, status);
+
+	status = event_task_queue_cancel (&queue);
+	CuAssertIntEquals (test, 0, status);
+
+	status = event_task_queue_pop (&queue, &context);
+	CuAssertIntEquals (test, EVENT_TASK_QUEUE_EMPTY, status);
+
+	event_task_queue_testing_add_event (test, &queue, 0, EVENT_TASK_QUEUE_PRIORITY_NORMAL, 10);
+	event_task_queue_testing_process_event (test, &queue, 0, 10);
+
+	status = event_task_queue_get_stats (&queue, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, stats.queued);
+	CuAssertIntEquals (test, 1, stats.dispatched);
+
+	event_task_queue_release (&queue);
+}
+
+static void event_task_queue_test_cancel_not_reserved (CuTest *test)
+{
+	struct event_task_queue_slot slots[EVENT_TASK_QUEUE_TESTING_SLOTS];
+	struct event_task_queue_state state;
+	struct event_task_queue queue;
+	int status;
+
+	TEST_START;
+
+	status = event_task_queue_init (&queue, &state, slots, EVENT_TASK_QUEUE_TESTING_SLOTS);
+	CuAssertIntEquals (test, 0, status);
+
+	status = event_task_queue_cancel (&queue);
+	CuAssertIntEquals (test, EVENT_TASK_NOT_READY, status);
+
+	event_task_queue_release (&queue);
+}
+
+static void event_task_queue_test_cancel_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = event_task_queue_cancel (NULL);
+	CuAssertIntEquals (test, EVENT_TASK_INVALID_ARGUMENT, status);
+}
+
+static void event_task_queue_test_push_not_reserved (CuTest *test)
+{
+	struct event_task_queue_slot slots[EVENT_TASK_QUEUE_TESTING_SLOTS];
+	struct event_task_queue_state state;
+	struct event_task_queue queue;
+	int status;
+
+	TEST_START;
+
+	status = event_task_queue_init (&queue, &state, slots, EVENT_TASK_QUEUE_TESTING_SLOTS);
+	CuAssertIntEquals (test, 0, status);
+
+	status = event_task_queue_push (&queue, 0, EVENT_TASK_QUEUE_PRIORITY_NORMAL);
+	CuAssertIntEquals (test, EVENT_TASK_NOT_READY, status);
+
+	event_task_queue_release (&queue);
+}
+
+static void event_task_queue_test_push_invalid_arguments (CuTest *test)
+{
+	struct event_task_queue_slot slots[EVENT_TASK_QUEUE_TESTING_SLOTS];
+	struct event_task_queue_state state;
+	struct event_task_queue queue;
+	struct event_task_context *context;
+	int status;
+
+	TEST_START;
+
+	status = event_task_queue_init (&queue, &state, slots, EVENT_TASK_QUEUE_TESTING_SLOTS);
+	CuAssertIntEquals (test, 0, status);
+
+	status = event_task_queue_reserve (&queue, &context);
+	CuAssertIntEquals (test, 0, status);
+
+	status = event_task_queue_push (NULL, 0, EVENT_TASK_QUEUE_PRIORITY_NORMAL);
+	CuAssertIntEquals (test, EVENT_TASK_INVALID_ARGUMENT, status);
+
+	status = event_task_queue_push (&queue, -1, EVENT_TASK_QUEUE_PRIORITY_NORMAL);
+	CuAssertIntEquals (test, EVENT_TASK_INVALID_ARGUMENT, status);
+
+	status = event_task_queue_push (&queue, 0, EVENT_TASK_QUEUE_PRIORITY_LEVELS);
+	CuAssertIntEquals (test, EVENT_TASK_INVALID_ARGUMENT, status);
+
+	/* The reserved slot should still be usable. */
+	status = event_task_queue_push (&queue, 0, EVENT_TASK_QUEUE_PRIORITY_NORMAL);
+	CuAssertIntEquals (test, 0, status);
+
+	event_task_queue_release (&queue);
+}
+
+static void event_task_queue_test_pop_empty (CuTest *test)
+{
+	struct event_task_queue_slot slots[EVENT_TASK_QUEUE_TESTING_SLOTS];
+	struct event_task_queue_state state;
+	struct event_task_queue queue;
+	struct event_task_context *context;
+	int status;
+
+	TEST_START;
+
+	status = event_task_queue_init (&queue, &state, slots, EVENT_TASK_QUEUE_TESTING_SLOTS);
+	CuAssertIntEquals (test, 0, status);
+
+	status = event_task_queue_pop (&queue, &context);
+	CuAssertIntEquals (test, EVENT_TASK_QUEUE_EMPTY, status);
+	CuAssertPtrEquals (test, NULL, context);
+
+	/* A reserved event is not ready for processing. */
+	status = event_task_queue_reserve (&queue, &context);
+	CuAssertIntEquals (test, 0, status);
+
+	status = event_task_queue_pop (&queue, &context);
+	CuAssertIntEquals (test, EVENT_TASK_QUEUE_EMPTY, status);
+
+	event_task_queue_release (&queue);
+}
+
+static void event_task_queue_test_pop_while_running (CuTest *test)
+{
+	struct event_task_queue_slot slots[EVENT_TASK_QUEUE_TESTING_SLOTS];
+	struct event_task_queue_state state;
+	struct event_task_queue queue;
+	struct event_task_context *context;
+	int status;
+
+	TEST_START;
+
+	status = event_task_queue_init (&queue, &state, slots, EVENT_TASK_QUEUE_TESTING_SLOTS);
+	CuAssertIntEquals (test, 0, status);
+
+	event_task_queue_testing_add_event (test, &queue, 0, EVENT_TASK_QUEUE_PRIORITY_NORMAL, 10);
+	event_task_queue_testing_add_event (test, &queue, 1, EVENT_TASK_QUEUE_PRIORITY_NORMAL, 11);
+
+	status = event_task_queue_pop (&queue, &context);
+	CuAssertIntEquals (test, 0, status);
+
+	status = event_task_queue_pop (&queue, &context);
+	CuAssertIntEquals (test, EVENT_TASK_BUSY, status);
+	CuAssertPtrEquals (test, NULL, context);
+
+	status = event_task_queue_complete (&queue);
+	CuAssertIntEquals (test, 0, status);
+
+	event_task_queue_testing_process_event (test, &queue, 1, 11);
+
+	event_task_queue_release (&queue);
+}
+
+static void event_task_queue_test_pop_null (CuTest *test)
+{
+	struct event_task_queue_slot slots[EVENT_TASK_QUEUE_TESTING_SLOTS];
+	struct event_task_queue_state state;
+	struct event_task_queue queue;
+	struct event_task_context *context;
+	int status;
+
+	TEST_START;
+
+	status = event_task_queue_init (&queue, &state, slots, EVENT_TASK_QUEUE_TESTING_SLOTS);
+	CuAssertIntEquals (test, 0, status);
+
+	status = event_task_queue_pop (NULL, &context);
+	CuAssertIntEquals (test, EVENT_TASK_INVALID_ARGUMENT, status);
+
+	status = event_task_queue_pop (&queue, NULL);
+	CuAssertIntEquals (test, EVENT_TASK_INVALID_ARGUMENT, status);
+
+	event_task_queue_release (&queue);
+}
+
+static void event_task_queue_test_complete_not_running (CuTest *test)
+{
+	struct event_task_queue_slot slots[EVENT_TASK_QUEUE_TESTING_SLOTS];
+	struct event_task_queue_state state;
+	struct event_task_queue queue;
+	int status;
+
+	TEST_START;
+
+	status = event_task_queue_init (&queue, &state, slots, EVENT_TASK_QUEUE_TESTING_SLOTS);
+	CuAssertIntEquals (test, 0, status);
+
+	status = event_task_queue_complete (&queue);
+	CuAssertIntEquals (test, EVENT_TASK_NOT_READY, status);
+
+	status = event_task_queue_complete (NULL);
+	CuAssertIntEquals (test, EVENT_TASK_INVALID_ARGUMENT, status);
+
+	event_task_queue_release (&queue);
+}
+
+static void event_task_queue_test_dispatch_latency (CuTest *test)
+{
+	struct event_task_queue_slot slots[EVENT_TASK_QUEUE_TESTING_SLOTS];
+	struct event_task_queue_state state;
+	struct event_task_queue queue;
+	struct event_task_queue_stats stats;
+	int status;
+
+	TEST_START;
+
+	status = event_task_queue_init (&queue, &state, slots, EVENT_TASK_QUEUE_TESTING_SLOTS);
+	CuAssertIntEquals (test, 0, status);
+
+	event_task_queue_testing_add_event (test, &queue, 0, EVENT_TASK_QUEUE_PRIORITY_NORMAL, 10);
+	event_task_queue_testing_add_event (test, &queue, 1, EVENT_TASK_QUEUE_PRIORITY_NORMAL, 11);
+
+	platform_msleep (20);
+
+	event_task_queue_testing_process_event (test, &queue, 0, 10);
+	event_task_queue_testing_process_event (test, &queue, 1, 11);
+
+	status = event_task_queue_get_stats (&queue, &stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertTrue (test, (stats.max_latency_ms >= 20));
+	CuAssertTrue (test, (stats.total_latency_ms >= 40));
+	CuAssertTrue (test, (stats.total_latency_ms <= (stats.max_latency_ms * 2)));
+
+	event_task_queue_release (&queue);
+}
+
+static void event_task_queue_test_get_stats_null (CuTest *test)
+{
+	struct event_task_queue_slot slots[EVENT_TASK_QUEUE_TESTING_SLOTS];
+	struct event_task_queue_state state;
+	struct event_task_queue queue;
+	struct event_task_queue_stats stats;
+	int status;
+
+	TEST_START;
+
+	status = event_task_queue_init (&queue, &state, slots, EVENT_TASK_QUEUE_TESTING_SLOTS);
+	CuAssertIntEquals (test, 0, status);
+
+	status = event_task_queue_get_stats (NULL, &stats);
+	CuAssertIntEquals (test, EVENT_TASK_INVALID_ARGUMENT, status);
+
+	status = event_task_queue_get_stats (&queue, NULL);
+	CuAssertIntEquals (test, EVENT_TASK_INVALID_ARGUMENT, status);
+
+	event_task_queue_release (&queue);
+}
+
+
+TEST_SUITE_START (event_task_queue);
+
+TEST (event_task_queue_test_init);
+TEST (event_task_queue_test_init_null);
+TEST (event_task_queue_test_static_init);
+TEST (event_task_queue_test_static_init_null);
+TEST (event_task_queue_test_release_null);
+TEST (event_task_queue_test_fifo_order);
+TEST (event_task_queue_test_priority_order);
+TEST (event_task_queue_test_queue_while_running);
+TEST (event_task_queue_test_reserve_full);
+TEST (event_task_queue_test_reserve_already_reserved);
+TEST (event_task_queue_test_reserve_null);
+TEST (event_task_queue_test_cancel);
+TEST (event_task_queue_test_cancel_not_reserved);
+TEST (event_task_queue_test_cancel_null);
+TEST (event_task_queue_test_push_not_reserved);
+TEST (event_task_queue_test_push_invalid_arguments);
+TEST (event_task_queue_test_pop_empty);
+TEST (event_task_queue_test_pop_while_running);
+TEST (event_task_queue_test_pop_null);
+TEST (event_task_queue_test_complete_not_running);
+TEST (event_task_queue_test_dispatch_latency);
+TEST (event_task_queue_test_get_stats_null);
+
+TEST_SUITE_END;
@@ -6,6 +6,8 @@
 #include <string.h>
 #include "testing.h"
 #include "system/periodic_task.h"
+#include "system/periodic_task_static.h"
+#include "common/unused.h"
 #include "testing/mock/system/periodic_task_handler_mock.h"
 
 
@@ -103,6 +105,48 @@ static void periodic_task_testing_validate_and_release_dependencies (CuTest *tes
 }
 
 
+/**
+ * Initialize a scheduler for testing.
+ *
+ * @param test The testing framework.
+ * @param scheduler The scheduler to initialize.
+ * @param state Variable context for the scheduler.
+ * @param list The list of handlers to execute.
+ * @param count The number of handlers in the list.
+ * @param schedule Storage for the handler schedule.
+ * @param stats Storage for handler statistics.
+ */
+static void periodic_task_testing_init_scheduler (CuTest *test,
+	struct periodic_task_scheduler *scheduler, struct periodic_task_scheduler_state *state,
+	const struct periodic_task_handler **list, size_t count,
+	struct periodic_task_schedule_entry *schedule, struct periodic_task_handler_stats *stats)
+{
+	int status;
+
+	status = periodic_task_scheduler_init (scheduler, state, list, count, schedule, stats);
+	CuAssertIntEquals (test, 0, status);
+}
+
+/**
+ * Mock action to simulate a handler that takes time to execute.
+ *
+ * @param expected The expectation for the handler call.
+ * @param called The actual handler call.
+ *
+ * @return 0 always.
+ */
+static int64_t periodic_task_testing_slow_execute (const struct mock_call *expected,
+	const struct mock_call *called)
+{
+	UNUSED (expected);
+	UNUSED (called);
+
+	platform_msleep (20);
+
+	return 0;
+}
+
+
 /*******************
  * Test cases
  *******************/
@@ -588,6 +632,814 @@ static void periodic_task_test_execute_next_handler_multiple_with_null_handler (
 	periodic_task_testing_validate_and_release_dependencies (test, &periodic);
 }
 
+static void periodic_task_test_scheduler_init (CuTest *test)
+{
+	struct periodic_task_testing periodic;
+	const struct periodic_task_handler *list[] = {
+		&periodic.handler1.base, &periodic.handler2.base
+	};
+	const size_t count = sizeof (list) / sizeof (list[0]);
+	struct periodic_task_schedule_entry schedule[sizeof (list) / sizeof (list[0])];
+	struct periodic_task_handler_stats stats[sizeof (list) / sizeof (list[0])];
+	struct periodic_task_scheduler_state state;
+	struct periodic_task_scheduler scheduler;
+	int status;
+
+	TEST_START;
+
+	periodic_task_testing_init_dependencies (test, &periodic);
+
+	status = periodic_task_scheduler_init (&scheduler, &state, list, count, schedule, stats);
+	CuAssertIntEquals (test, 0, status);
+
+	periodic_task_testing_validate_and_release_dependencies (test, &periodic);
+
+	periodic_task_scheduler_release (&scheduler);
+}
+
+static void periodic_task_test_scheduler_init_null (CuTest *test)
+{
+	struct periodic_task_testing periodic;
+	const struct periodic_task_handler *list[] = {
+		&periodic.handler1.base, &periodic.handler2.base
+	};
+	const size_t count = sizeof (list) / sizeof (list[0]);
+	struct periodic_task_schedule_entry schedule[sizeof (list) / sizeof (list[0])];
+	struct periodic_task_handler_stats stats[sizeof (list) / sizeof (list[0])];
+	struct periodic_task_scheduler_state state;
+	struct periodic_task_scheduler scheduler;
+	int status;
+
+	TEST_START;
+
+	periodic_task_testing_init_dependencies (test, &periodic);
+
+	status = periodic_task_scheduler_init (NULL, &state, list, count, schedule, stats);
+	CuAssertIntEquals (test, PERIODIC_TASK_INVALID_ARGUMENT, status);
+
+	status = periodic_task_scheduler_init (&scheduler, NULL, list, count, schedule, stats);
+	CuAssertIntEquals (test, PERIODIC_TASK_INVALID_ARGUMENT, status);
+
+	status = periodic_task_scheduler_init (&scheduler, &state, NULL, count, schedule, stats);
+	CuAssertIntEquals (test, PERIODIC_TASK_INVALID_ARGUMENT, status);
+
+	status = periodic_task_scheduler_init (&scheduler, &state, list, 0, schedule, stats);
+	CuAssertIntEquals (test, PERIODIC_TASK_INVALID_ARGUMENT, status);
+
+	status = periodic_task_scheduler_init (&scheduler, &state, list, count, NULL, stats);
+	CuAssertIntEquals (test, PERIODIC_TASK_INVALID_ARGUMENT, status);
+
+	periodic_task_testing_validate_and_release_dependencies (test, &periodic);
+}
+
+static void periodic_task_test_scheduler_static_init (CuTest *test)
+{
+	struct periodic_task_testing periodic;
+	const struct periodic_task_handler *list[] = {
+		&periodic.handler1.base, &periodic.handler2.base
+	};
+	struct periodic_task_schedule_entry schedule[2];
+	struct periodic_task_scheduler_state state;
+	struct periodic_task_scheduler scheduler = periodic_task_scheduler_static_init (&state, list,
+		2, schedule, NULL);
+	int status;
+
+	TEST_START;
+
+	periodic_task_testing_init_dependencies (test, &periodic);
+
+	status = periodic_task_scheduler_init_state (&scheduler);
+	CuAssertIntEquals (test, 0, status);
+
+	periodic_task_testing_validate_and_release_dependencies (test, &periodic);
+
+	periodic_task_scheduler_release (&scheduler);
+}
+
+static void periodic_task_test_scheduler_static_init_null (CuTest *test)
+{
+	struct periodic_task_testing periodic;
+	const struct periodic_task_handler *list[] = {
+		&periodic.handler1.base, &periodic.handler2.base
+	};
+	struct periodic_task_schedule_entry schedule[2];
+	struct periodic_task_scheduler_state state;
+	struct periodic_task_scheduler null_state = periodic_task_scheduler_static_init (NULL, list,
+		2, schedule, NULL);
+	struct periodic_task_scheduler null_list = periodic_task_scheduler_static_init (&state, NULL,
+		2, schedule, NULL);
+	struct periodic_task_scheduler zero_count = periodic_task_scheduler_static_init (&state, list,
+		0, schedule, NULL);
+	struct periodic_task_scheduler null_schedule = periodic_task_scheduler_static_init (&state,
+		list, 2, NULL, NULL);
+	int status;
+
+	TEST_START;
+
+	periodic_task_testing_init_dependencies (test, &periodic);
+
+	status = periodic_task_scheduler_init_state (NULL);
+	CuAssertIntEquals (test, PERIODIC_TASK_INVALID_ARGUMENT, status);
+
+	status = periodic_task_scheduler_init_state (&null_state);
+	CuAssertIntEquals (test, PERIODIC_TASK_INVALID_ARGUMENT, status);
+
+	status = periodic_task_scheduler_init_state (&null_list);
+	CuAssertIntEquals (test, PERIODIC_TASK_INVALID_ARGUMENT, status);
+
+	status = periodic_task_scheduler_init_state (&zero_count);
+	CuAssertIntEquals (test, PERIODIC_TASK_INVALID_ARGUMENT, status);
+
+	status = periodic_task_scheduler_init_state (&null_schedule);
+	CuAssertIntEquals (test, PERIODIC_TASK_INVALID_ARGUMENT, status);
+
+	periodic_task_testing_validate_and_release_dependencies (test, &periodic);
+}
+
+static void periodic_task_test_scheduler_release_null (CuTest *test)
+{
+	TEST_START;
+
+	periodic_task_scheduler_release (NULL);
+}
+
+static void periodic_task_test_scheduler_execute_next (CuTest *test)
+{
+	struct periodic_task_testing periodic;
+	const struct periodic_task_handler *list[] = {
+		&periodic.handler1.base
+	};
+	const size_t count = sizeof (list) / sizeof (list[0]);
+	struct periodic_task_schedule_entry schedule[sizeof (list) / sizeof (list[0])];
+	struct periodic_task_scheduler_state state;
+	struct periodic_task_scheduler scheduler;
+	int status;
+	platform_clock end;
+
+	TEST_START;
+
+	periodic_task_testing_init_dependencies (test, &periodic);
+	periodic_task_testing_init_scheduler (test, &scheduler, &state, list, count, schedule, NULL);
+
+	status = mock_expect (&periodic.handler1.mock, periodic.handler1.base.get_next_execution,
+		&periodic.handler1.base, MOCK_RETURN_PTR (&periodic.time_500ms));
+
+	status |= mock_expect (&periodic.handler1.mock, periodic.handler1.base.execute,
+		&periodic.handler1.base, 0);
+
+	status |= mock_expect (&periodic.handler1.mock, periodic.handler1.base.get_next_execution,
+		&periodic.handler1.base, MOCK_RETURN_PTR (&periodic.time_1000ms));
+
+	CuAssertIntEquals (test, 0, status);
+
+	periodic_task_testing_init_times (test, &periodic);
+
+	status = periodic_task_scheduler_execute_next (&scheduler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = platform_init_current_tick (&end);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertTrue (test, (platform_get_duration (&periodic.start, &end) >= 500));
+	CuAssertTrue (test, (platform_get_duration (&periodic.start, &end) < 1000));
+
+	periodic_task_testing_validate_and_release_dependencies (test, &periodic);
+
+	periodic_task_scheduler_release (&scheduler);
+}
+
+static void periodic_task_test_scheduler_execute_next_multiple (CuTest *test)
+{
+	struct periodic_task_testing periodic;
+	const struct periodic_task_handler *list[] = {
+		&periodic.handler1.base, &periodic.handler2.base, &periodic.handler3.base,
+		&periodic.handler4.base
+	};
+	const size_t count = sizeof (list) / sizeof (list[0]);
+	struct periodic_task_schedule_entry schedule[sizeof (list) / sizeof (list[0])];
+	struct periodic_task_scheduler_state state;
+	struct periodic_task_scheduler scheduler;
+	int status;
+	platform_clock end;
+
+	TEST_START;
+
+	periodic_task_testing_init_dependencies (test, &periodic);
+	periodic_task_testing_init_scheduler (test, &scheduler, &state, list, count, schedule, NULL);
+
+	status = mock_expect (&periodic.handler1.mock, periodic.handler1.base.get_next_execution,
+		&periodic.handler1.base, MOCK_RETURN_PTR (&periodic.time_1000ms));
+	status |= mock_expect (&periodic.handler2.mock, periodic.handler2.base.get_next_execution,
+		&periodic.handler2.base, MOCK_RETURN_PTR (&periodic.time_1500ms));
+	status |= mock_expect (&periodic.handler3.mock, periodic.handler3.base.get_next_execution,
+		&periodic.handler3.base, MOCK_RETURN_PTR (&periodic.time_500ms));
+	status |= mock_expect (&periodic.handler4.mock, periodic.handler4.base.get_next_execution,
+		&periodic.handler4.base, MOCK_RETURN_PTR (&periodic.time_2000ms));
+
+	status |= mock_expect (&periodic.handler3.mock, periodic.handler3.base.execute,
+		&periodic.handler3.base, 0);
+	status |= mock_expect (&periodic.handler3.mock, periodic.handler3.base.get_next_execution,
+		&periodic.handler3.base, MOCK_RETURN_PTR (&periodic.time_2000ms));
+
+	/* Only the executed handler should be queried again. */
+	status |= mock_expect (&periodic.handler1.mock, periodic.handler1.base.execute,
+		&periodic.handler1.base, 0);
+	status |= mock_expect (&periodic.handler1.mock, periodic.handler1.base.get_next_execution,
+		&periodic.handler1.base, MOCK_RETURN_PTR (&periodic.time_2000ms));
+
+	CuAssertIntEquals (test, 0, status);
+
+	periodic_task_testing_init_times (test, &periodic);
+
+	status = periodic_task_scheduler_execute_next (&scheduler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = platform_init_current_tick (&end);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertTrue (test, (platform_get_duration (&periodic.start, &end) >= 500));
+	CuAssertTrue (test, (platform_get_duration (&periodic.start, &end) < 1000));
+
+	status = periodic_task_scheduler_execute_next (&scheduler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = platform_init_current_tick (&end);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertTrue (test, (platform_get_duration (&periodic.start, &end) >= 1000));
+	CuAssertTrue (test, (platform_get_duration (&periodic.start, &end) < 1500));
+
+	periodic_task_testing_validate_and_release_dependencies (test, &periodic);
+
+	periodic_task_scheduler_release (&scheduler);
+}
+
+static void periodic_task_test_scheduler_execute_next_multiple_null_execution_time (CuTest *test)
+{
+	struct periodic_task_testing periodic;
+	const struct periodic_task_handler *list[] = {
+		&periodic.handler1.base, &periodic.handler2.base, &periodic.handler3.base
+	};
+	const size_t count = sizeof (list) / sizeof (list[0]);
+	struct periodic_task_schedule_entry schedule[sizeof (list) / sizeof (list[0])];
+	struct periodic_task_scheduler_state state;
+	struct periodic_task_scheduler scheduler;
+	int status;
+	platform_clock end;
+
+	TEST_START;
+
+	periodic_task_testing_init_dependencies (test, &periodic);
+	periodic_task_testing_init_scheduler (test, &scheduler, &state, list, count, schedule, NULL);
+
+	status = mock_expect (&periodic.handler1.mock, periodic.handler1.base.get_next_execution,
+		&periodic.handler1.base, MOCK_RETURN_PTR (NULL));
+	status |= mock_expect (&periodic.handler2.mock, periodic.handler2.base.get_next_execution,
+		&periodic.handler2.base, MOCK_RETURN_PTR (&periodic.time_1000ms));
+	status |= mock_expect (&periodic.handler3.mock, periodic.handler3.base.get_next_execution,
+		&periodic.handler3.base, MOCK_RETURN_PTR (NULL));
+
+	/* Handlers that are always ready take turns executing. */
+	status |= mock_expect (&periodic.handler1.mock, periodic.handler1.base.execute,
+		&periodic.handler1.base, 0);
+	status |= mock_expect (&periodic.handler1.mock, periodic.handler1.base.get_next_execution,
+		&periodic.handler1.base, MOCK_RETURN_PTR (NULL));
+
+	status |= mock_expect (&periodic.handler3.mock, periodic.handler3.base.execute,
+		&periodic.handler3.base, 0);
+	status |= mock_expect (&periodic.handler3.mock, periodic.handler3.base.get_next_execution,
+		&periodic.handler3.base, MOCK_RETURN_PTR (NULL));
+
+	status |= mock_expect (&periodic.handler1.mock, periodic.handler1.base.execute,
+		&periodic.handler1.base, 0);
+	status |= mock_expect (&periodic.handler1.mock, periodic.handler1.base.get_next_execution,
+		&periodic.handler1.base, MOCK_RETURN_PTR (&periodic.time_1500ms));
+
+	CuAssertIntEquals (test, 0, status);
+
+	periodic_task_testing_init_times (test, &periodic);
+
+	status = periodic_task_scheduler_execute_next (&scheduler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = periodic_task_scheduler_execute_next (&scheduler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = periodic_task_scheduler_execute_next (&scheduler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = platform_init_current_tick (&end);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertTrue (test, (platform_get_duration (&periodic.start, &end) < 500));
+
+	periodic_task_testing_validate_and_release_dependencies (test, &periodic);
+
+	periodic_task_scheduler_release (&scheduler);
+}
+
+static void periodic_task_test_scheduler_execute_next_with_null_handler (CuTest *test)
+{
+	struct periodic_task_testing periodic;
+	const struct periodic_task_handler *list[] = {
+		&periodic.handler1.base, NULL, &periodic.handler3.base
+	};
+	const size_t count = sizeof (list) / sizeof (list[0]);
+	struct periodic_task_schedule_entry schedule[sizeof (list) / sizeof (list[0])];
+	struct periodic_task_scheduler_state state;
+	struct periodic_task_scheduler scheduler;
+	int status;
+
+	TEST_START;
+
+	periodic_task_testing_init_dependencies (test, &periodic);
+	periodic_task_testing_init_scheduler (test, &scheduler, &state, list, count, schedule, NULL);
+
+	status = mock_expect (&periodic.handler1.mock, periodic.handler1.base.get_next_execution,
+		&periodic.handler1.base, MOCK_RETURN_PTR (&periodic.time_1000ms));
+	status |= mock_expect (&periodic.handler3.mock, periodic.handler3.base.get_next_execution,
+		&periodic.handler3.base, MOCK_RETURN_PTR (NULL));
+
+	status |= mock_expect (&periodic.handler3.mock, periodic.handler3.base.execute,
+		&periodic.handler3.base, 0);
+	status |= mock_expect (&periodic.handler3.mock, periodic.handler3.base.get_next_execution,
+		&periodic.handler3.base, MOCK_RETURN_PTR (&periodic.time_1500ms));
+
+	CuAssertIntEquals (test, 0, status);
+
+	periodic_task_testing_init_times (test, &periodic);
+
+	status = periodic_task_scheduler_execute_next (&scheduler);
+	CuAssertIntEquals (test, 0, status);
+
+	periodic_task_testing_validate_and_release_dependencies (test, &periodic);
+
+	periodic_task_scheduler_release (&scheduler);
+}
+
+static void periodic_task_test_scheduler_execute_next_wake (CuTest *test)
+{
+	struct periodic_task_testing periodic;
+	const struct periodic_task_handler *list[] = {
+		&periodic.handler1.base, &periodic.handler2.base
+	};
+	const size_t count = sizeof (list) / sizeof (list[0]);
+	struct periodic_task_schedule_entry schedule[sizeof (list) / sizeof (list[0])];
+	struct periodic_task_scheduler_state state;
+	struct periodic_task_scheduler scheduler;
+	int status;
+	platform_clock end;
+
+	TEST_START;
+
+	periodic_task_testing_init_dependencies (test, &periodic);
+	periodic_task_testing_init_scheduler (test, &scheduler, &state, list, count, schedule, NULL);
+
+	status = mock_expect (&periodic.handler1.mock, periodic.handler1.base.get_next_execution,
+		&periodic.handler1.base, MOCK_RETURN_PTR (NULL));
+	status |= mock_expect (&periodic.handler2.mock, periodic.handler2.base.get_next_execution,
+		&periodic.handler2.base, MOCK_RETURN_PTR (&periodic.time_2000ms));
+
+	status |= mock_expect (&periodic.handler1.mock, periodic.handler1.base.execute,
+		&periodic.handler1.base, 0);
+	status |= mock_expect (&periodic.handler1.mock, periodic.handler1.base.get_next_execution,
+		&periodic.handler1.base, MOCK_RETURN_PTR (&periodic.time_1500ms));
+
+	/* Waking the scheduler queries all handlers again. */
+	status |= mock_expect (&periodic.handler1.mock, periodic.handler1.base.get_next_execution,
+		&periodic.handler1.base, MOCK_RETURN_PTR (&periodic.time_1500ms));
+	status |= mock_expect (&periodic.handler2.mock, periodic.handler2.base.get_next_execution,
+		&periodic.handler2.base, MOCK_RETURN_PTR (NULL));
+
+	status |= mock_expect (&periodic.handler2.mock, periodic.handler2.base.execute,
+		&periodic.handler2.base, 0);
+	status |= mock_expect (&periodic.handler2.mock, periodic.handler2.base.get_next_execution,
+		&periodic.handler2.base, MOCK_RETURN_PTR (&periodic.time_2000ms));
+
+	CuAssertIntEquals (test, 0, status);
+
+	periodic_task_testing_init_times (test, &periodic);
+
+	status = periodic_task_scheduler_execute_next (&scheduler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = periodic_task_wake (&scheduler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = periodic_task_scheduler_execute_next (&scheduler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = platform_init_current_tick (&end);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertTrue (test, (platform_get_duration (&periodic.start, &end) < 500));
+
+	periodic_task_testing_validate_and_release_dependencies (test, &periodic);
+
+	periodic_task_scheduler_release (&scheduler);
+}
+
+static void periodic_task_test_scheduler_execute_next_wake_from_isr (CuTest *test)
+{
+	struct periodic_task_testing periodic;
+	const struct periodic_task_handler *list[] = {
+		&periodic.handler1.base
+	};
+	const size_t count = sizeof (list) / sizeof (list[0]);
+	struct periodic_task_schedule_entry schedule[sizeof (list) / sizeof (list[0])];
+	struct periodic_task_scheduler_state state;
+	struct periodic_task_scheduler scheduler;
+	int status;
+	platform_clock end;
+
+	TEST_START;
+
+	periodic_task_testing_init_dependencies (test, &periodic);
+	periodic_task_testing_init_scheduler (test, &scheduler, &state, list, count, schedule, NULL);
+
+	status = mock_expect (&periodic.handler1.mock, periodic.handler1.base.get_next_execution,
+		&periodic.handler1.base, MOCK_RETURN_PTR (NULL));
+
+	status |= mock_expect (&periodic.handler1.mock, periodic.handler1.base.execute,
+		&periodic.handler1.base, 0);
+	status |= mock_expect (&periodic.handler1.mock, periodic.handler1.base.get_next_execution,
+		&periodic.handler1.base, MOCK_RETURN_PTR (&periodic.time_2000ms));
+
+	status |= mock_expect (&periodic.handler1.mock, periodic.handler1.base.get_next_execution,
+		&periodic.handler1.base, MOCK_RETURN_PTR (NULL));
+
+	status |= mock_expect (&periodic.handler1.mock, periodic.handler1.base.execute,
+		&periodic.handler1.base, 0);
+	status |= mock_expect (&periodic.handler1.mock, periodic.handler1.base.get_next_execution,
+		&periodic.handler1.base, MOCK_RETURN_PTR (&periodic.time_2000ms));
+
+	CuAssertIntEquals (test, 0, status);
+
+	periodic_task_testing_init_times (test, &periodic);
+
+	status = periodic_task_scheduler_execute_next (&scheduler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = periodic_task_wake_from_isr (&scheduler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = periodic_task_scheduler_execute_next (&scheduler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = platform_init_current_tick (&end);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertTrue (test, (platform_get_duration (&periodic.start, &end) < 500));
+
+	periodic_task_testing_validate_and_release_dependencies (test, &periodic);
+
+	periodic_task_scheduler_release (&scheduler);
+}
+
+static void periodic_task_test_scheduler_execute_next_resync (CuTest *test)
+{
+	struct periodic_task_testing periodic;
+	const struct periodic_task_handler *list[] = {
+		&periodic.handler1.base
+	};
+	const size_t count = sizeof (list) / sizeof (list[0]);
+	struct periodic_task_schedule_entry schedule[sizeof (list) / sizeof (list[0])];
+	struct periodic_task_scheduler_state state;
+	struct periodic_task_scheduler scheduler;
+	int status;
+	platform_clock end;
+
+	TEST_START;
+
+	periodic_task_testing_init_dependencies (test, &periodic);
+	periodic_task_testing_init_scheduler (test, &scheduler, &state, list, count, schedule, NULL);
+
+	status = mock_expect (&periodic.handler1.mock, periodic.handler1.base.get_next_execution,
+		&periodic.handler1.base, MOCK_RETURN_PTR (&periodic.time_2000ms));
+
+	/* The handler is queried again after the resync interval. */
+	status |= mock_expect (&periodic.handler1.mock, periodic.handler1.base.get_next_execution,
+		&periodic.handler1.base, MOCK_RETURN_PTR (&periodic.time_1500ms));
+
+	status |= mock_expect (&periodic.handler1.mock, periodic.handler1.base.execute,
+		&periodic.handler1.base, 0);
+	status |= mock_expect (&periodic.handler1.mock, periodic.handler1.base.get_next_execution,
+		&periodic.handler1.base, MOCK_RETURN_PTR (&periodic.time_2000ms));
+
+	CuAssertIntEquals (test, 0, status);
+
+	periodic_task_testing_init_times (test, &periodic);
+
+	status = periodic_task_scheduler_execute_next (&scheduler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = platform_init_current_tick (&end);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertTrue (test, (platform_get_duration (&periodic.start, &end) >= 1500));
+	CuAssertTrue (test, (platform_get_duration (&periodic.start, &end) < 2000));
+
+	periodic_task_testing_validate_and_release_dependencies (test, &periodic);
+
+	periodic_task_scheduler_release (&scheduler);
+}
+
+static void periodic_task_test_scheduler_execute_next_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = periodic_task_scheduler_execute_next (NULL);
+	CuAssertIntEquals (test, PERIODIC_TASK_INVALID_ARGUMENT, status);
+}
+
+static void periodic_task_test_scheduler_execute_next_null_handler (CuTest *test)
+{
+	struct periodic_task_testing periodic;
+	const struct periodic_task_handler *list[] = {
+		NULL
+	};
+	const size_t count = sizeof (list) / sizeof (list[0]);
+	struct periodic_task_schedule_entry schedule[sizeof (list) / sizeof (list[0])];
+	struct periodic_task_scheduler_state state;
+	struct periodic_task_scheduler scheduler;
+	int status;
+
+	TEST_START;
+
+	periodic_task_testing_init_dependencies (test, &periodic);
+	periodic_task_testing_init_scheduler (test, &scheduler, &state, list, count, schedule, NULL);
+
+	status = periodic_task_scheduler_execute_next (&scheduler);
+	CuAssertIntEquals (test, PERIODIC_TASK_NO_HANDLERS, status);
+
+	periodic_task_testing_validate_and_release_dependencies (test, &periodic);
+
+	periodic_task_scheduler_release (&scheduler);
+}
+
+static void periodic_task_test_wake_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = periodic_task_wake (NULL);
+	CuAssertIntEquals (test, PERIODIC_TASK_INVALID_ARGUMENT, status);
+
+	status = periodic_task_wake_from_isr (NULL);
+	CuAssertIntEquals (test, PERIODIC_TASK_INVALID_ARGUMENT, status);
+}
+
+static void periodic_task_test_scheduler_get_stats (CuTest *test)
+{
+	struct periodic_task_testing periodic;
+	const struct periodic_task_handler *list[] = {
+		&periodic.handler1.base, &periodic.handler2.base
+	};
+	const size_t count = sizeof (list) / sizeof (list[0]);
+	struct periodic_task_schedule_entry schedule[sizeof (list) / sizeof (list[0])];
+	struct periodic_task_handler_stats stats[sizeof (list) / sizeof (list[0])];
+	struct periodic_task_scheduler_state state;
+	struct periodic_task_scheduler scheduler;
+	struct periodic_task_handler_stats handler_stats;
+	int status;
+	int i;
+
+	TEST_START;
+
+	periodic_task_testing_init_dependencies (test, &periodic);
+	periodic_task_testing_init_scheduler (test, &scheduler, &state, list, count, schedule, stats);
+
+	status = mock_expect (&periodic.handler1.mock, periodic.handler1.base.get_next_execution,
+		&periodic.handler1.base, MOCK_RETURN_PTR (NULL));
+	status |= mock_expect (&periodic.handler2.mock, periodic.handler2.base.get_next_execution,
+		&periodic.handler2.base, MOCK_RETURN_PTR (&periodic.time_2000ms));
+
+	status |= mock_expect (&periodic.handler1.mock, periodic.handler1.base.execute,
+		&periodic.handler1.base, 0);
+	status |= mock_expect_external_action (&periodic.handler1.mock,
+		periodic_task_testing_slow_execute, NULL);
+	status |= mock_expect (&periodic.handler1.mock, periodic.handler1.base.get_next_execution,
+		&periodic.handler1.base, MOCK_RETURN_PTR (NULL));
+
+	status |= mock_expect (&periodic.handler1.mock, periodic.handler1.base.execute,
+		&periodic.handler1.base, 0);
+	status |= mock_expect (&periodic.handler1.mock, periodic.handler1.base.get_next_execution,
+		&periodic.handler1.base, MOCK_RETURN_PTR (&periodic.time_2000ms));
+
+	CuAssertIntEquals (test, 0, status);
+
+	periodic_task_testing_init_times (test, &periodic);
+
+	status = periodic_task_scheduler_execute_next (&scheduler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = periodic_task_scheduler_execute_next (&scheduler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = periodic_task_scheduler_get_stats (&scheduler, 0, &handler_stats);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 2, handler_stats.executions);
+	CuAssertTrue (test, (handler_stats.max_execution_ms >= 20));
+	CuAssertTrue (test, (handler_stats.max_execution_ms < 32));
+	CuAssertIntEquals (test, 1, handler_stats.execution_ms[0]);
+	CuAssertIntEquals (test, 1, handler_stats.execution_ms[5]);
+	CuAssertIntEquals (test, 2, handler_stats.lateness_ms[0]);
+	CuAssertIntEquals (test, 0, handler_stats.max_lateness_ms);
+	for (i = 1; i < PERIODIC_TASK_HISTOGRAM_BUCKETS; i++) {
+		CuAssertIntEquals (test, 0, handler_stats.lateness_ms[i]);
+	}
+
+	status = periodic_task_scheduler_get_stats (&scheduler, 1, &handler_stats);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 0, handler_stats.executions);
+	CuAssertIntEquals (test, 0, handler_stats.max_execution_ms);
+	CuAssertIntEquals (test, 0, handler_stats.max_lateness_ms);
+	for (i = 0; i < PERIODIC_TASK_HISTOGRAM_BUCKETS; i++) {
+		CuAssertIntEquals (test, 0, handler_stats.execution_ms[i]);
+		CuAssertIntEquals (test, 0, handler_stats.lateness_ms[i]);
+	}
+
+	periodic_task_testing_validate_and_release_dependencies (test, &periodic);
+
+	periodic_task_scheduler_release (&scheduler);
+}
+
+static void periodic_task_test_scheduler_get_stats_late_handler (CuTest *test)
+{
+	struct periodic_task_testing periodic;
+	const struct periodic_task_handler *list[] = {
+		&periodic.handler1.base, &periodic.handler2.base
+	};
+	const size_t count = sizeof (list) / sizeof (list[0]);
+	struct periodic_task_schedule_entry schedule[sizeof (list) / sizeof (list[0])];
+	struct periodic_task_handler_stats stats[sizeof (list) / sizeof (list[0])];
+	struct periodic_task_scheduler_state state;
+	struct periodic_task_scheduler scheduler;
+	struct periodic_task_handler_stats handler_stats;
+	int status;
+
+	TEST_START;
+
+	periodic_task_testing_init_dependencies (test, &periodic);
+	periodic_task_testing_init_scheduler (test, &scheduler, &state, list, count, schedule, stats);
+
+	status = mock_expect (&periodic.handler1.mock, periodic.handler1.base.get_next_execution,
+		&periodic.handler1.base, MOCK_RETURN_PTR (NULL));
+	status |= mock_expect (&periodic.handler2.mock, periodic.handler2.base.get_next_execution,
+		&periodic.handler2.base, MOCK_RETURN_PTR (NULL));
+
+	/* The first handler delays execution of the second. */
+	status |= mock_expect (&periodic.handler1.mock, periodic.handler1.base.execute,
+		&periodic.handler1.base, 0);
+	status |= mock_expect_external_action (&periodic.handler1.mock,
+		periodic_task_testing_slow_execute, NULL);
+	status |= mock_expect (&periodic.handler1.mock, periodic.handler1.base.get_next_execution,
+		&periodic.handler1.base, MOCK_RETURN_PTR (&periodic.time_2000ms));
+
+	status |= mock_expect (&periodic.handler2.mock, periodic.handler2.base.execute,
+		&periodic.handler2.base, 0);
+	status |= mock_expect (&periodic.handler2.mock, periodic.handler2.base.get_next_execution,
+		&periodic.handler2.base, MOCK_RETURN_PTR (&periodic.time_2000ms));
+
+	CuAssertIntEquals (test, 0, status);
+
+	periodic_task_testing_init_times (test, &periodic);
+
+	status = periodic_task_scheduler_execute_next (&scheduler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = periodic_task_scheduler_execute_next (&scheduler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = periodic_task_scheduler_get_stats (&scheduler, 1, &handler_stats);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, 1, handler_stats.executions);
+	CuAssertTrue (test, (handler_stats.max_lateness_ms >= 20));
+	CuAssertTrue (test, (handler_stats.max_lateness_ms < 32));
+	CuAssertIntEquals (test, 0, handler_stats.lateness_ms[0]);
+	CuAssertIntEquals (test, 1, handler_stats.lateness_ms[5]);
+
+	periodic_task_testing_validate_and_release_dependencies (test, &periodic);
+
+	periodic_task_scheduler_release (&scheduler);
+}
+
+static void periodic_task_test_scheduler_get_stats_no_stats (CuTest *test)
+{
+	struct periodic_task_testing periodic;
+	const struct periodic_task_handler *list[] = {
+		&periodic.handler1.base
+	};
+	const size_t count = sizeof (list) / sizeof (list[0]);
+	struct periodic_task_schedule_entry schedule[sizeof (list) / sizeof (list[0])];
+	struct periodic_task_scheduler_state state;
+	struct periodic_task_scheduler scheduler;
+	struct periodic_task_handler_stats handler_stats;
+	int status;
+
+	TEST_START;
+
+	periodic_task_testing_init_dependencies (test, &periodic);
+	periodic_task_testing_init_scheduler (test, &scheduler, &state, list, count, schedule, NULL);
+
+	status = periodic_task_scheduler_get_stats (&scheduler, 0, &handler_stats);
+	CuAssertIntEquals (test, PERIODIC_TASK_NO_STATS, status);
+
+	status = periodic_task_scheduler_reset_stats (&scheduler);
+	CuAssertIntEquals (test, PERIODIC_TASK_NO_STATS, status);
+
+	periodic_task_testing_validate_and_release_dependencies (test, &periodic);
+
+	periodic_task_scheduler_release (&scheduler);
+}
+
+static void periodic_task_test_scheduler_get_stats_null (CuTest *test)
+{
+	struct periodic_task_testing periodic;
+	const struct periodic_task_handler *list[] = {
+		&periodic.handler1.base
+	};
+	const size_t count = sizeof (list) / sizeof (list[0]);
+	struct periodic_task_schedule_entry schedule[sizeof (list) / sizeof (list[0])];
+	struct periodic_task_handler_stats stats[sizeof (list) / sizeof (list[0])];
+	struct periodic_task_scheduler_state state;
+	struct periodic_task_scheduler scheduler;
+	struct periodic_task_handler_stats handler_stats;
+	int status;
+
+	TEST_START;
+
+	periodic_task_testing_init_dependencies (test, &periodic);
+	periodic_task_testing_init_scheduler (test, &scheduler, &state, list, count, schedule, stats);
+
+	status = periodic_task_scheduler_get_stats (NULL, 0, &handler_stats);
+	CuAssertIntEquals (test, PERIODIC_TASK_INVALID_ARGUMENT, status);
+
+	status = periodic_task_scheduler_get_stats (&scheduler, 1, &handler_stats);
+	CuAssertIntEquals (test, PERIODIC_TASK_INVALID_ARGUMENT, status);
+
+	status = periodic_task_scheduler_get_stats (&scheduler, 0, NULL);
+	CuAssertIntEquals (test, PERIODIC_TASK_INVALID_ARGUMENT, status);
+
+	periodic_task_testing_validate_and_release_dependencies (test, &periodic);
+
+	periodic_task_scheduler_release (&scheduler);
+}
+
+static void periodic_task_test_scheduler_reset_stats (CuTest *test)
+{
+	struct periodic_task_testing periodic;
+	const struct periodic_task_handler *list[] = {
+		&periodic.handler1.base
+	};
+	const size_t count = sizeof (list) / sizeof (list[0]);
+	struct periodic_task_schedule_entry schedule[sizeof (list) / sizeof (list[0])];
+	struct periodic_task_handler_stats stats[sizeof (list) / sizeof (list[0])];
+	struct periodic_task_scheduler_state state;
+	struct periodic_task_scheduler scheduler;
+	struct periodic_task_handler_stats handler_stats;
+	int status;
+
+	TEST_START;
+
+	periodic_task_testing_init_dependencies (test, &periodic);
+	periodic_task_testing_init_scheduler (test, &scheduler, &state, list, count, schedule, stats);
+
+	status = mock_expect (&periodic.handler1.mock, periodic.handler1.base.get_next_execution,
+		&periodic.handler1.base, MOCK_RETURN_PTR (NULL));
+
+	status |= mock_expect (&periodic.handler1.mock, periodic.handler1.base.execute,
+		&periodic.handler1.base, 0);
+	status |= mock_expect (&periodic.handler1.mock, periodic.handler1.base.get_next_execution,
+		&periodic.handler1.base, MOCK_RETURN_PTR (&periodic.time_2000ms));
+
+	CuAssertIntEquals (test, 0, status);
+
+	periodic_task_testing_init_times (test, &periodic);
+
+	status = periodic_task_scheduler_execute_next (&scheduler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = periodic_task_scheduler_get_stats (&scheduler, 0, &handler_stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 1, handler_stats.executions);
+
+	status = periodic_task_scheduler_reset_stats (&scheduler);
+	CuAssertIntEquals (test, 0, status);
+
+	status = periodic_task_scheduler_get_stats (&scheduler, 0, &handler_stats);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, handler_stats.executions);
+	CuAssertIntEquals (test, 0, handler_stats.execution_ms[0]);
+	CuAssertIntEquals (test, 0, handler_stats.lateness_ms[0]);
+
+	status = periodic_task_scheduler_reset_stats (NULL);
+	CuAssertIntEquals (test, PERIODIC_TASK_INVALID_ARGUMENT, status);
+
+	periodic_task_testing_validate_and_release_dependencies (test, &periodic);
+
+	periodic_task_scheduler_release (&scheduler);
+}
+
 
 TEST_SUITE_START (periodic_task);
 
@@ -607,5 +1459,25 @@ TEST (periodic_task_test_execute_next_handler_expired_timeout);
 TEST (periodic_task_test_execute_next_handler_null);
 TEST (periodic_task_test_execute_next_handler_null_handler);
 TEST (periodic_task_test_execute_next_handler_multiple_with_null_handler);
+TEST (periodic_task_test_scheduler_init);
+TEST (periodic_task_test_scheduler_init_null);
+TEST (periodic_task_test_scheduler_static_init);
+TEST (periodic_task_test_scheduler_static_init_null);
+TEST (periodic_task_test_scheduler_release_null);
+TEST (periodic_task_test_scheduler_execute_next);
+TEST (periodic_task_test_scheduler_execute_next_multiple);
+TEST (periodic_task_test_scheduler_execute_next_multiple_null_execution_time);
+TEST (periodic_task_test_scheduler_execute_next_with_null_handler);
+TEST (periodic_task_test_scheduler_execute_next_wake);
+TEST (periodic_task_test_scheduler_execute_next_wake_from_isr);
+TEST (periodic_task_test_scheduler_execute_next_resync);
+TEST (periodic_task_test_scheduler_execute_next_null);
+TEST (periodic_task_test_scheduler_execute_next_null_handler);
+TEST (periodic_task_test_wake_null);
+TEST (periodic_task_test_scheduler_get_stats);
+TEST (periodic_task_test_scheduler_get_stats_late_handler);
+TEST (periodic_task_test_scheduler_get_stats_no_stats);
+TEST (periodic_task_test_scheduler_get_stats_null);
+TEST (periodic_task_test_scheduler_reset_stats);
 
 TEST_SUITE_END;
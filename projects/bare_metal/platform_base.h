@@ -6,6 +6,7 @@
 
 #include <stdlib.h>
 #include <stdint.h>
+#include <stdbool.h>
 #include "common/common_math.h"
 #include "common/unused.h"
 
@@ -71,6 +72,32 @@ typedef volatile int platform_semaphore;
 #define	platform_semaphore_post_from_isr	platform_semaphore_post
 
 
+/* Atomic operations.  Use the compiler builtins, which are safe to use from interrupt context.
+ * Cores without exclusive access instructions will need the compiler to provide the atomic library
+ * functions. */
+static inline uint32_t platform_atomic_load (volatile uint32_t *value)
+{
+	return __atomic_load_n (value, __ATOMIC_ACQUIRE);
+}
+
+static inline void platform_atomic_store (volatile uint32_t *value, uint32_t new_value)
+{
+	__atomic_store_n (value, new_value, __ATOMIC_RELEASE);
+}
+
+static inline uint32_t platform_atomic_fetch_add (volatile uint32_t *value, uint32_t add)
+{
+	return __atomic_fetch_add (value, add, __ATOMIC_SEQ_CST);
+}
+
+static inline bool platform_atomic_compare_exchange (volatile uint32_t *value, uint32_t expected,
+	uint32_t desired)
+{
+	return __atomic_compare_exchange_n (value, &expected, desired, false, __ATOMIC_SEQ_CST,
+		__ATOMIC_SEQ_CST);
+}
+
+
 /* Tasks.  Single-threaded environment with no OS running. */
 static inline int platform_os_suspend_scheduler (void)
 {
@@ -0,0 +1,314 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include "event_task_freertos_queued.h"
+
+
+int event_task_freertos_queued_lock (const struct event_task *task)
+{
+	const struct event_task_freertos_queued *freertos =
+		(const struct event_task_freertos_queued*) task;
+
+	if (freertos == NULL) {
+		return EVENT_TASK_INVALID_ARGUMENT;
+	}
+
+	return platform_mutex_lock (&freertos->state->lock);
+}
+
+int event_task_freertos_queued_unlock (const struct event_task *task)
+{
+	const struct event_task_freertos_queued *freertos =
+		(const struct event_task_freertos_queued*) task;
+
+	if (freertos == NULL) {
+		return EVENT_TASK_INVALID_ARGUMENT;
+	}
+
+	return platform_mutex_unlock (&freertos->state->lock);
+}
+
+int event_task_freertos_queued_get_event_context (const struct event_task *task,
+	struct event_task_context **context)
+{
+	const struct event_task_freertos_queued *freertos =
+		(const struct event_task_freertos_queued*) task;
+	int status;
+
+	if ((freertos == NULL) || (context == NULL)) {
+		return EVENT_TASK_INVALID_ARGUMENT;
+	}
+
+	if (freertos->state->task) {
+		platform_mutex_lock (&freertos->state->lock);
+
+		status = event_task_queue_reserve (&freertos->queue, context);
+		if (status != 0) {
+			platform_mutex_unlock (&freertos->state->lock);
+		}
+	}
+	else {
+		status = EVENT_TASK_NO_TASK;
+	}
+
+	return status;
+}
+
+int event_task_freertos_queued_notify (const struct event_task *task,
+	const struct event_task_handler *handler)
+{
+	const struct event_task_freertos_queued *freertos =
+		(const struct event_task_freertos_queued*) task;
+	uint8_t priority = EVENT_TASK_QUEUE_PRIORITY_NORMAL;
+	int index;
+	int status;
+
+	if (task == NULL) {
+		return EVENT_TASK_INVALID_ARGUMENT;
+	}
+
+	if (freertos->state->task) {
+		if (freertos->state->queue.reserved >= 0) {
+			/* Make sure the requested handler is registered with the task. */
+			index = event_task_find_handler (handler, freertos->handlers, freertos->num_handlers);
+			if (!ROT_IS_ERROR (index)) {
+				if (freertos->priorities) {
+					priority = freertos->priorities[index];
+				}
+
+				status = event_task_queue_push (&freertos->queue, index, priority);
+			}
+			else {
+				status = index;
+			}
+
+			if (status != 0) {
+				event_task_queue_cancel (&freertos->queue);
+			}
+
+			platform_mutex_unlock (&freertos->state->lock);
+			if (status == 0) {
+				/* If the handler is valid, notify the task to process the event. */
+				xTaskNotifyGive (freertos->state->task);
+			}
+		}
+		else {
+			status = EVENT_TASK_NOT_READY;
+		}
+	}
+	else {
+		status = EVENT_TASK_NO_TASK;
+	}
+
+	return status;
+}
+
+/**
+ * Initialize an event handler task that queues received events.  The actual FreeRTOS task will not
+ * be allocated until a call to {@link event_task_freertos_queued_start}.
+ *
+ * @param task The event handler task to initialize.
+ * @param state Variable context for the task.  This must be uninitialized.
+ * @param slots Storage for events waiting to be processed.
+ * @param slot_count The number of events that can be queued.  This includes the event currently
+ * being processed.
+ * @param system The manager for system operations.
+ * @param handlers The list of event handlers that can be used with this task instance.
+ * @param priorities Optional list of queue priorities to use for events sent to each handler.  This
+ * must contain an entry for every handler.  Set to null to process all events in the order they are
+ * received.
+ * @param num_handlers The number of event handlers in the list.
+ *
+ * @return 0 if the task was initialized or an error code
+ */
+int event_task_freertos_queued_init (struct event_task_freertos_queued *task,
+	struct event_task_freertos_queued_state *state, struct event_task_queue_slot *slots,
+	size_t slot_count, struct system *system, const struct event_task_handler **handlers,
+	const uint8_t *priorities, size_t num_handlers)
+{
+	if ((task == NULL) || (state == NULL)) {
+		return EVENT_TASK_INVALID_ARGUMENT;
+	}
+
+	memset (task, 0, sizeof (struct event_task_freertos_queued));
+
+	task->base.lock = event_task_freertos_queued_lock;
+	task->base.unlock = event_task_freertos_queued_unlock;
+	task->base.get_event_context = event_task_freertos_queued_get_event_context;
+	task->base.notify = event_task_freertos_queued_notify;
+
+	task->state = state;
+	task->queue.state = &state->queue;
+	task->queue.slots = slots;
+	task->queue.slot_count = slot_count;
+	task->system = system;
+	task->handlers = handlers;
+	task->priorities = priorities;
+	task->num_handlers = num_handlers;
+
+	return event_task_freertos_queued_init_state (task);
+}
+
+/**
+ * Initialize only the variable state for an event handler task that queues received events.  The
+ * rest of the task instance is assumed to have already been initialized.  The actual FreeRTOS task
+ * will not be allocated until a call to {@link event_task_freertos_queued_start}.
+ *
+ * This would generally be used with a statically initialized instance.
+ *
+ * @param task The task instance that contains the state to initialize.
+ *
+ * @return 0 if the state was successfully initialized or an error code.
+ */
+int event_task_freertos_queued_init_state (const struct event_task_freertos_queued *task)
+{
+	size_t i;
+	int status;
+
+	if ((task == NULL) || (task->state == NULL) || (task->system == NULL) ||
+		(task->handlers == NULL) || (task->num_handlers == 0)) {
+		return EVENT_TASK_INVALID_ARGUMENT;
+	}
+
+	if (task->priorities) {
+		for (i = 0; i < task->num_handlers; i++) {
+			if (task->priorities[i] >= EVENT_TASK_QUEUE_PRIORITY_LEVELS) {
+				return EVENT_TASK_INVALID_ARGUMENT;
+			}
+		}
+	}
+
+	memset (task->state, 0, sizeof (struct event_task_freertos_queued_state));
+
+	status = event_task_queue_init_state (&task->queue);
+	if (status != 0) {
+		return status;
+	}
+
+	return platform_mutex_init (&task->state->lock);
+}
+
+/**
+ * Stop the event task and release all resources used by the task.  No handlers will be released.
+ *
+ * There is no synchronization done to ensure a task is only stopped when nothing is running.  A
+ * released task will be stopped immediately.  Any events still in the queue will be discarded.
+ *
+ * @param task The task to release.
+ */
+void event_task_freertos_queued_release (const struct event_task_freertos_queued *task)
+{
+	if (task) {
+		vTaskDelete (task->state->task);
+		platform_mutex_free (&task->state->lock);
+		event_task_queue_release (&task->queue);
+	}
+}
+
+/**
+ * Task routine to handle notifications for registered handlers.  Every event in the queue will be
+ * processed before waiting for another notification.
+ *
+ * @param task The task to process event notifications.
+ */
+static void event_task_freertos_queued_process_notification (
+	const struct event_task_freertos_queued *task)
+{
+	struct event_task_context *context;
+	bool reset = false;
+	int handler;
+
+	event_task_prepare_handlers (task->handlers, task->num_handlers);
+
+	while (1) {
+		/* Wait for notification that an event should be processed. */
+		ulTaskNotifyTake (pdTRUE, portMAX_DELAY);
+
+		platform_mutex_lock (&task->state->lock);
+		handler = event_task_queue_pop (&task->queue, &context);
+
+		while (!ROT_IS_ERROR (handler)) {
+			platform_mutex_unlock (&task->state->lock);
+
+			/* Sanity check the handler index before using it. */
+			if ((size_t) handler < task->num_handlers) {
+				/* Execute the selected handler for the event. */
+				task->handlers[handler]->execute (task->handlers[handler], context, &reset);
+			}
+
+			if (reset) {
+				/* If the event requires it, reset the system.  We need to wait a bit before
+				 * triggering the reset to allow time for any execution status to be reported. */
+				platform_msleep (5000);
+				system_reset (task->system);
+				reset = false;	/* We should never get here, but clear the flag if the reset fails. */
+			}
+
+			/* Release the event context and check for more queued events. */
+			platform_mutex_lock (&task->state->lock);
+			event_task_queue_complete (&task->queue);
+			handler = event_task_queue_pop (&task->queue, &context);
+		}
+
+		platform_mutex_unlock (&task->state->lock);
+	}
+}
+
+/**
+ * Allocate and start running the event handler task.  No events can be queued until the task has
+ * been started.
+ *
+ * @param task The event task to start.
+ * @param stack_words The size of the task stack.  The stack size is measured in words.
+ * @param task_name An identifying name to assign to the task.  The maximum length is determined by
+ * the FreeRTOS configuration for the platform.
+ * @param priority The priority to assign to this task.
+ *
+ * @return 0 if the task was started or an error code.
+ */
+int event_task_freertos_queued_start (const struct event_task_freertos_queued *task,
+	uint16_t stack_words, const char *task_name, int priority)
+{
+	int status;
+
+	if (task == NULL) {
+		return EVENT_TASK_INVALID_ARGUMENT;
+	}
+
+	status = xTaskCreate ((TaskFunction_t) event_task_freertos_queued_process_notification,
+		task_name, stack_words, (void*) task, priority, &task->state->task);
+	if (status != pdPASS) {
+		task->state->task = NULL;
+		return EVENT_TASK_NO_MEMORY;
+	}
+
+	return 0;
+}
+
+/**
+ * Get the counters for event queue activity.  This can be used to tune the number of queue slots
+ * required by the system.
+ *
+ * @param task The event task to query.
+ * @param stats Output for the queue counters.
+ *
+ * @return 0 if the counters were retrieved or an error code.
+ */
+int event_task_freertos_queued_get_stats (const struct event_task_freertos_queued *task,
+	struct event_task_queue_stats *stats)
+{
+	int status;
+
+	if (task == NULL) {
+		return EVENT_TASK_INVALID_ARGUMENT;
+	}
+
+	platform_mutex_lock (&task->state->lock);
+	status = event_task_queue_get_stats (&task->queue, stats);
+	platform_mutex_unlock (&task->state->lock);
+
+	return status;
+}
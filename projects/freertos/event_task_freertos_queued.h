@@ -0,0 +1,56 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef EVENT_TASK_FREERTOS_QUEUED_H_
+#define EVENT_TASK_FREERTOS_QUEUED_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "platform_api.h"
+#include "system/event_task.h"
+#include "system/event_task_queue.h"
+#include "system/system.h"
+
+
+/**
+ * Variable context for the task.
+ */
+struct event_task_freertos_queued_state {
+	struct event_task_queue_state queue;		/**< Variable context for the event queue. */
+	TaskHandle_t task;							/**< The task that will execute event handlers. */
+	platform_mutex lock;						/**< Synchronization with the execution task. */
+};
+
+/**
+ * FreeRTOS implementation for a task to handle event processing.  Events are queued when they are
+ * received, so new events can be accepted while a handler is executing.  Events are only rejected
+ * when the queue is full.
+ */
+struct event_task_freertos_queued {
+	struct event_task base;						/**< Base interface to the task. */
+	struct event_task_freertos_queued_state *state;	/**< Variable context for the task. */
+	struct event_task_queue queue;				/**< Queue of events waiting for processing. */
+	struct system *system;						/**< The system manager. */
+	const struct event_task_handler **handlers;	/**< List of registered event handlers. */
+	const uint8_t *priorities;					/**< Queue priority for events sent to each handler. */
+	size_t num_handlers;						/**< Number of registered handlers in the list. */
+};
+
+
+int event_task_freertos_queued_init (struct event_task_freertos_queued *task,
+	struct event_task_freertos_queued_state *state, struct event_task_queue_slot *slots,
+	size_t slot_count, struct system *system, const struct event_task_handler **handlers,
+	const uint8_t *priorities, size_t num_handlers);
+int event_task_freertos_queued_init_state (const struct event_task_freertos_queued *task);
+void event_task_freertos_queued_release (const struct event_task_freertos_queued *task);
+
+int event_task_freertos_queued_start (const struct event_task_freertos_queued *task,
+	uint16_t stack_words, const char *task_name, int priority);
+
+int event_task_freertos_queued_get_stats (const struct event_task_freertos_queued *task,
+	struct event_task_queue_stats *stats);
+
+
+#endif /* EVENT_TASK_FREERTOS_QUEUED_H_ */
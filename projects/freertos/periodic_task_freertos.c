@@ -38,6 +38,36 @@ int periodic_task_freertos_init (struct periodic_task_freertos *task,
 	return periodic_task_freertos_init_state (task);
 }
 
+/**
+ * Initialize a periodic handler task that uses a scheduler to execute the handlers.  The scheduler
+ * allows the task to be woken early to check for handlers that became ready.  The actual FreeRTOS
+ * task will not be allocated until a call to {@link periodic_task_freertos_start}.
+ *
+ * @param task The periodic handler task to initialize.
+ * @param state Variable context for the task.  This must be uninitialized.
+ * @param scheduler The scheduler that will execute the handlers.  The scheduler must already be
+ * initialized.
+ * @param log_id Identifier for this task in log messages.
+ *
+ * @return 0 if the task was initialized or an error code
+ */
+int periodic_task_freertos_init_with_scheduler (struct periodic_task_freertos *task,
+	struct periodic_task_freertos_state *state, const struct periodic_task_scheduler *scheduler,
+	int log_id)
+{
+	if (task == NULL) {
+		return PERIODIC_TASK_INVALID_ARGUMENT;
+	}
+
+	memset (task, 0, sizeof (struct periodic_task_freertos));
+
+	task->state = state;
+	task->scheduler = scheduler;
+	task->id = log_id;
+
+	return periodic_task_freertos_init_state (task);
+}
+
 /**
  * Initialize only the variable state for a periodic handler task.  The rest of the task instance is
  * assumed to have already been initialized.  The actual FreeRTOS task will not be allocated until a
@@ -51,8 +81,11 @@ int periodic_task_freertos_init (struct periodic_task_freertos *task,
  */
 int periodic_task_freertos_init_state (const struct periodic_task_freertos *task)
 {
-	if ((task == NULL) || (task->state == NULL) || (task->handlers == NULL) ||
-		(task->num_handlers == 0)) {
+	if ((task == NULL) || (task->state == NULL)) {
+		return PERIODIC_TASK_INVALID_ARGUMENT;
+	}
+
+	if ((task->scheduler == NULL) && ((task->handlers == NULL) || (task->num_handlers == 0))) {
 		return PERIODIC_TASK_INVALID_ARGUMENT;
 	}
 
@@ -86,10 +119,21 @@ static void periodic_task_freertos_loop (struct periodic_task_freertos *task)
 	int status;
 	int last_error = 0;
 
-	periodic_task_prepare_handlers (task->handlers, task->num_handlers);
+	if (task->scheduler) {
+		periodic_task_prepare_handlers (task->scheduler->handlers, task->scheduler->num_handlers);
+	}
+	else {
+		periodic_task_prepare_handlers (task->handlers, task->num_handlers);
+	}
 
 	while (1) {
-		status = periodic_task_execute_next_handler (task->handlers, task->num_handlers);
+		if (task->scheduler) {
+			status = periodic_task_scheduler_execute_next (task->scheduler);
+		}
+		else {
+			status = periodic_task_execute_next_handler (task->handlers, task->num_handlers);
+		}
+
 		if ((status != 0) && (status != last_error)) {
 			debug_log_create_entry (DEBUG_LOG_SEVERITY_ERROR, DEBUG_LOG_COMPONENT_SYSTEM,
 				SYSTEM_LOGGING_PERIODIC_FAILED, task->id, status);
@@ -23,6 +23,7 @@ struct periodic_task_freertos {
 	struct periodic_task_freertos_state *state;		/**< Variable context for the task. */
 	const struct periodic_task_handler **handlers;	/**< List of registered handlers. */
 	size_t num_handlers;							/**< Number of registered handlers in the list. */
+	const struct periodic_task_scheduler *scheduler;	/**< Optional scheduler for handler execution. */
 	int id;											/**< Logging identifier. */
 };
 
@@ -30,6 +31,9 @@ struct periodic_task_freertos {
 int periodic_task_freertos_init (struct periodic_task_freertos *task,
 	struct periodic_task_freertos_state *state, const struct periodic_task_handler **handlers,
 	size_t num_handlers, int log_id);
+int periodic_task_freertos_init_with_scheduler (struct periodic_task_freertos *task,
+	struct periodic_task_freertos_state *state, const struct periodic_task_scheduler *scheduler,
+	int log_id);
 int periodic_task_freertos_init_state (const struct periodic_task_freertos *task);
 void periodic_task_freertos_release (const struct periodic_task_freertos *task);
 
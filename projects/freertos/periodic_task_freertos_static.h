@@ -23,6 +23,26 @@
 		.state = state_ptr, \
 		.handlers = handlers_list, \
 		.num_handlers = count, \
+		.scheduler = NULL, \
+		.id = log_id \
+	}
+
+/**
+ * Initialize a static instance of a FreeRTOS periodic handler task that uses a scheduler to execute
+ * the handlers.  The FreeRTOS task itself will still be dynamically allocated.  This does not
+ * initialize the task state.  This can be a constant instance.
+ *
+ * There is no validation done on the arguments.
+ *
+ * @param state_ptr Variable context for the task.
+ * @param scheduler_ptr The scheduler that will execute the handlers.
+ * @param log_id Identifier for this task in log messages.
+ */
+#define	periodic_task_freertos_static_init_with_scheduler(state_ptr, scheduler_ptr, log_id)	{ \
+		.state = state_ptr, \
+		.handlers = NULL, \
+		.num_handlers = 0, \
+		.scheduler = scheduler_ptr, \
 		.id = log_id \
 	}
 
@@ -315,3 +315,56 @@ int platform_os_resume_scheduler ()
 	xTaskResumeAll ();
 	return 0;
 }
+
+/* Atomic operations are implemented with critical sections so they can be used on any core
+ * supported by FreeRTOS.  The interrupt-safe critical sections are used so these can be called from
+ * both task and interrupt context. */
+uint32_t platform_atomic_load (volatile uint32_t *value)
+{
+	UBaseType_t saved;
+	uint32_t current;
+
+	saved = taskENTER_CRITICAL_FROM_ISR ();
+	current = *value;
+	taskEXIT_CRITICAL_FROM_ISR (saved);
+
+	return current;
+}
+
+void platform_atomic_store (volatile uint32_t *value, uint32_t new_value)
+{
+	UBaseType_t saved;
+
+	saved = taskENTER_CRITICAL_FROM_ISR ();
+	*value = new_value;
+	taskEXIT_CRITICAL_FROM_ISR (saved);
+}
+
+uint32_t platform_atomic_fetch_add (volatile uint32_t *value, uint32_t add)
+{
+	UBaseType_t saved;
+	uint32_t current;
+
+	saved = taskENTER_CRITICAL_FROM_ISR ();
+	current = *value;
+	*value = current + add;
+	taskEXIT_CRITICAL_FROM_ISR (saved);
+
+	return current;
+}
+
+bool platform_atomic_compare_exchange (volatile uint32_t *value, uint32_t expected,
+	uint32_t desired)
+{
+	UBaseType_t saved;
+	bool match;
+
+	saved = taskENTER_CRITICAL_FROM_ISR ();
+	match = (*value == expected);
+	if (match) {
+		*value = desired;
+	}
+	taskEXIT_CRITICAL_FROM_ISR (saved);
+
+	return match;
+}
@@ -9,6 +9,7 @@
 #include <openssl/pem.h>
 #include <openssl/ec.h>
 #include <openssl/ecdsa.h>
+#include <openssl/bn.h>
 #include <openssl/obj_mac.h>
 #include <openssl/err.h>
 #include "asn1/ecc_der_util.h"
@@ -462,6 +463,362 @@ static int ecc_openssl_verify (struct ecc_engine *engine, struct ecc_public_key
 	return (status == 1) ? 0 : ECC_ENGINE_BAD_SIGNATURE;
 }
 
+/**
+ * The maximum number of signatures that will be verified together.  Larger batches are split into
+ * groups of this size.
+ */
+#define	ECC_OPENSSL_VERIFY_BATCH_MAX		16
+
+/**
+ * Context for a single signature that is being verified as part of a batch.
+ */
+struct ecc_openssl_batch_item {
+	struct ecc_verify_batch_entry *entry;	/**< The batch entry being verified. */
+	const EC_POINT *pub;					/**< The public key point for the signature. */
+	BIGNUM *r;								/**< The r value from the signature. */
+	BIGNUM *s;								/**< The s value from the signature. */
+	BIGNUM *e;								/**< The digest converted to an integer. */
+};
+
+/**
+ * Parse a signature in a batch and prepare it for verification.  This applies the same checks as
+ * ECDSA_verify, so the signature encoding and digest are handled identically to single signature
+ * verification.
+ *
+ * @param group The curve for the public key.
+ * @param item The batch item to prepare.  The entry and number fields must already be assigned.
+ *
+ * @return 0 if the signature is ready for verification or an error code.
+ */
+static int ecc_openssl_batch_prepare (const EC_GROUP *group, struct ecc_openssl_batch_item *item)
+{
+	struct ecc_verify_batch_entry *entry = item->entry;
+	const BIGNUM *order = EC_GROUP_get0_order (group);
+	const uint8_t *pos = entry->signature;
+	ECDSA_SIG *sig;
+	const BIGNUM *sig_r;
+	const BIGNUM *sig_s;
+	uint8_t *der = NULL;
+	size_t der_length;
+	size_t length;
+	int enc_length;
+	int bits;
+	int status = ECC_ENGINE_BAD_SIGNATURE;
+
+	item->pub = EC_KEY_get0_public_key ((EC_KEY*) entry->key->context);
+	if (item->pub == NULL) {
+		return ECC_ENGINE_BAD_SIGNATURE;
+	}
+
+	der_length = ecc_der_get_ecdsa_signature_length (entry->signature, entry->sig_length);
+	sig = d2i_ECDSA_SIG (NULL, &pos, der_length);
+	if (sig == NULL) {
+		return ECC_ENGINE_BAD_SIGNATURE;
+	}
+
+	/* Only the canonical encoding of the signature is accepted. */
+	enc_length = i2d_ECDSA_SIG (sig, &der);
+	if ((enc_length != (int) der_length) || (memcmp (entry->signature, der, der_length) != 0)) {
+		goto exit;
+	}
+
+	ECDSA_SIG_get0 (sig, &sig_r, &sig_s);
+	if (BN_is_zero (sig_r) || BN_is_negative (sig_r) || (BN_ucmp (sig_r, order) >= 0) ||
+		BN_is_zero (sig_s) || BN_is_negative (sig_s) || (BN_ucmp (sig_s, order) >= 0)) {
+		goto exit;
+	}
+
+	status = ECC_ENGINE_NO_MEMORY;
+	if (!BN_copy (item->r, sig_r) || !BN_copy (item->s, sig_s)) {
+		goto exit;
+	}
+
+	/* Use only the left-most bits of the digest that fit in the curve order. */
+	bits = BN_num_bits (order);
+	length = entry->length;
+	if (length > (size_t) ((bits + 7) / 8)) {
+		length = (bits + 7) / 8;
+	}
+
+	if (!BN_bin2bn (entry->digest, length, item->e)) {
+		goto exit;
+	}
+
+	if (((8 * length) > (size_t) bits) && !BN_rshift (item->e, item->e, 8 - (bits & 0x7))) {
+		goto exit;
+	}
+
+	status = 0;
+
+exit:
+	OPENSSL_free (der);
+	ECDSA_SIG_free (sig);
+	return status;
+}
+
+/**
+ * Finish verification of a single signature in a batch.
+ *
+ * Rather than converting the computed point to affine coordinates, which would require a field
+ * inversion for each signature, r is projected into the Jacobian coordinates of the point.
+ *
+ * @param group The curve for the signature.
+ * @param p The prime for the curve field.
+ * @param item The signature to verify.
+ * @param w The inverse of s for the signature.
+ * @param point Temporary point to use for the calculation.
+ * @param ctx Context for the calculation.
+ *
+ * @return 0 if the signature is valid or an error code.
+ */
+static int ecc_openssl_batch_check (const EC_GROUP *group, const BIGNUM *p,
+	struct ecc_openssl_batch_item *item, const BIGNUM *w, EC_POINT *point, BN_CTX *ctx)
+{
+	const BIGNUM *order = EC_GROUP_get0_order (group);
+	BIGNUM *x;
+	BIGNUM *y;
+	BIGNUM *z;
+	BIGNUM *check;
+	int status = ECC_ENGINE_VERIFY_FAILED;
+
+	BN_CTX_start (ctx);
+	x = BN_CTX_get (ctx);
+	y = BN_CTX_get (ctx);
+	z = BN_CTX_get (ctx);
+	check = BN_CTX_get (ctx);
+	if (check == NULL) {
+		status = ECC_ENGINE_NO_MEMORY;
+		goto exit;
+	}
+
+	/* u1 = e * w is stored in e and u2 = r * w is stored in s. */
+	if (!BN_mod_mul (item->e, item->e, w, order, ctx) ||
+		!BN_mod_mul (item->s, item->r, w, order, ctx)) {
+		goto exit;
+	}
+
+	if (!EC_POINT_mul (group, point, item->e, item->pub, item->s, ctx)) {
+		goto exit;
+	}
+
+	if (EC_POINT_is_at_infinity (group, point)) {
+		status = ECC_ENGINE_BAD_SIGNATURE;
+		goto exit;
+	}
+
+	if (!EC_POINT_get_Jprojective_coordinates_GFp (group, point, x, y, z, ctx) ||
+		!BN_nnmod (x, x, p, ctx) || !BN_mod_sqr (z, z, p, ctx)) {
+		goto exit;
+	}
+
+	/* The x coordinate can be either r or r + n, if r + n is still a valid field element. */
+	if (!BN_mod_mul (check, item->r, z, p, ctx)) {
+		goto exit;
+	}
+
+	if (BN_cmp (check, x) == 0) {
+		status = 0;
+		goto exit;
+	}
+
+	if (!BN_add (check, item->r, order)) {
+		goto exit;
+	}
+
+	status = ECC_ENGINE_BAD_SIGNATURE;
+	if (BN_cmp (check, p) < 0) {
+		if (!BN_mod_mul (check, check, z, p, ctx)) {
+			status = ECC_ENGINE_VERIFY_FAILED;
+		}
+		else if (BN_cmp (check, x) == 0) {
+			status = 0;
+		}
+	}
+
+exit:
+	BN_CTX_end (ctx);
+	return status;
+}
+
+/**
+ * Verify a group of signatures that all use the same curve.  A single modular inversion is shared
+ * by all signatures in the group.
+ *
+ * @param group The curve for the signatures.
+ * @param items The signatures to verify.  The result for each signature will be stored in the
+ * batch entry.
+ * @param count The number of signatures in the group.
+ * @param ctx Context for the calculations.
+ */
+static void ecc_openssl_batch_verify_group (const EC_GROUP *group,
+	struct ecc_openssl_batch_item *items, size_t count, BN_CTX *ctx)
+{
+	const BIGNUM *order = EC_GROUP_get0_order (group);
+	BIGNUM *acc[ECC_OPENSSL_VERIFY_BATCH_MAX];
+	BIGNUM *inv;
+	BIGNUM *p;
+	EC_POINT *point = NULL;
+	size_t i;
+	int status = ECC_ENGINE_NO_MEMORY;
+
+	BN_CTX_start (ctx);
+	for (i = 0; i < count; i++) {
+		acc[i] = BN_CTX_get (ctx);
+	}
+	inv = BN_CTX_get (ctx);
+	p = BN_CTX_get (ctx);
+	if (p == NULL) {
+		goto exit;
+	}
+
+	point = EC_POINT_new (group);
+	if (point == NULL) {
+		goto exit;
+	}
+
+	status = ECC_ENGINE_VERIFY_FAILED;
+	if (!EC_GROUP_get_curve (group, p, NULL, NULL, ctx)) {
+		goto exit;
+	}
+
+	/* Accumulate the products of the s values so only one inversion is needed. */
+	if (!BN_copy (acc[0], items[0].s)) {
+		goto exit;
+	}
+
+	for (i = 1; i < count; i++) {
+		if (!BN_mod_mul (acc[i], acc[i - 1], items[i].s, order, ctx)) {
+			goto exit;
+		}
+	}
+
+	if (!BN_mod_inverse (inv, acc[count - 1], order, ctx)) {
+		goto exit;
+	}
+
+	/* Unwind the products to get the inverse of each s value. */
+	for (i = count - 1; i > 0; i--) {
+		if (!BN_mod_mul (acc[i], inv, acc[i - 1], order, ctx) ||
+			!BN_mod_mul (inv, inv, items[i].s, order, ctx)) {
+			goto exit;
+		}
+	}
+
+	if (!BN_copy (acc[0], inv)) {
+		goto exit;
+	}
+
+	for (i = 0; i < count; i++) {
+		items[i].entry->status = ecc_openssl_batch_check (group, p, &items[i], acc[i], point, ctx);
+	}
+
+	status = 0;
+
+exit:
+	if (status != 0) {
+		for (i = 0; i < count; i++) {
+			items[i].entry->status = status;
+		}
+	}
+
+	EC_POINT_free (point);
+	BN_CTX_end (ctx);
+}
+
+static int ecc_openssl_verify_batch (struct ecc_engine *engine,
+	struct ecc_verify_batch_entry *entries, size_t count)
+{
+	struct ecc_openssl_batch_item items[ECC_OPENSSL_VERIFY_BATCH_MAX];
+	const EC_GROUP *group;
+	const EC_GROUP *entry_group;
+	struct ecc_verify_batch_entry *entry;
+	BN_CTX *ctx;
+	size_t pending;
+	size_t i;
+	size_t j;
+	int status = 0;
+
+	if ((engine == NULL) || ((entries == NULL) && (count != 0))) {
+		return ECC_ENGINE_INVALID_ARGUMENT;
+	}
+
+	if (count == 0) {
+		return 0;
+	}
+
+	ctx = BN_CTX_new ();
+	if (ctx == NULL) {
+		return ECC_ENGINE_NO_MEMORY;
+	}
+
+	BN_CTX_start (ctx);
+	for (j = 0; j < ECC_OPENSSL_VERIFY_BATCH_MAX; j++) {
+		items[j].r = BN_CTX_get (ctx);
+		items[j].s = BN_CTX_get (ctx);
+		items[j].e = BN_CTX_get (ctx);
+	}
+
+	if (items[ECC_OPENSSL_VERIFY_BATCH_MAX - 1].e == NULL) {
+		status = ECC_ENGINE_NO_MEMORY;
+		goto exit;
+	}
+
+	i = 0;
+	while (i < count) {
+		/* Collect consecutive signatures on the same curve.  Any signature that can't be processed
+		 * is failed immediately. */
+		group = NULL;
+		pending = 0;
+		while ((i < count) && (pending < ECC_OPENSSL_VERIFY_BATCH_MAX)) {
+			entry = &entries[i];
+			if ((entry->key == NULL) || (entry->digest == NULL) || (entry->signature == NULL) ||
+				(entry->length == 0) || (entry->sig_length == 0)) {
+				entry->status = ECC_ENGINE_INVALID_ARGUMENT;
+				i++;
+				continue;
+			}
+
+			entry_group = EC_KEY_get0_group ((EC_KEY*) entry->key->context);
+			if (entry_group == NULL) {
+				entry->status = ECC_ENGINE_BAD_SIGNATURE;
+				i++;
+				continue;
+			}
+
+			if (group == NULL) {
+				group = entry_group;
+			}
+			else if (EC_GROUP_cmp (group, entry_group, ctx) != 0) {
+				break;
+			}
+
+			items[pending].entry = entry;
+			entry->status = ecc_openssl_batch_prepare (group, &items[pending]);
+			if (entry->status == 0) {
+				pending++;
+			}
+
+			i++;
+		}
+
+		if (pending != 0) {
+			ecc_openssl_batch_verify_group (group, items, pending, ctx);
+		}
+	}
+
+	for (j = 0; j < count; j++) {
+		if ((entries[j].status != 0) && ((status == 0) || (status == ECC_ENGINE_BAD_SIGNATURE))) {
+			status = entries[j].status;
+		}
+	}
+
+exit:
+	BN_CTX_end (ctx);
+	BN_CTX_free (ctx);
+
+	return status;
+}
+
 #ifdef ECC_ENABLE_ECDH
 static int ecc_openssl_get_shared_secret_max_length (struct ecc_engine *engine,
 	struct ecc_private_key *key)
@@ -528,6 +885,7 @@ int ecc_openssl_init (struct ecc_engine_openssl *engine)
 #endif
 	engine->base.sign = ecc_openssl_sign;
 	engine->base.verify = ecc_openssl_verify;
+	engine->base.verify_batch = ecc_openssl_verify_batch;
 #ifdef ECC_ENABLE_ECDH
 	engine->base.get_shared_secret_max_length = ecc_openssl_get_shared_secret_max_length;
 	engine->base.compute_shared_secret = ecc_openssl_compute_shared_secret;
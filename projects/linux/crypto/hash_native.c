@@ -0,0 +1,1088 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "hash_native.h"
+#include "hash_native_x86.h"
+
+
+/**
+ * Rotate a 32-bit value to the left.
+ */
+#define	HASH_NATIVE_ROTL32(x, n)		(((x) << (n)) | ((x) >> (32 - (n))))
+
+/**
+ * Rotate a 32-bit value to the right.
+ */
+#define	HASH_NATIVE_ROTR32(x, n)		(((x) >> (n)) | ((x) << (32 - (n))))
+
+/**
+ * Rotate a 64-bit value to the right.
+ */
+#define	HASH_NATIVE_ROTR64(x, n)		(((x) >> (n)) | ((x) << (64 - (n))))
+
+
+/**
+ * SHA-256 round constants.
+ */
+const uint32_t hash_native_sha256_k[64] = {
+	0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+	0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+	0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+	0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+	0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+	0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+	0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+	0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+#if defined HASH_ENABLE_SHA384 || defined HASH_ENABLE_SHA512
+/**
+ * SHA-512 round constants.
+ */
+const uint64_t hash_native_sha512_k[80] = {
+	0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL, 0xe9b5dba58189dbbcULL,
+	0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL, 0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL,
+	0xd807aa98a3030242ULL, 0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+	0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL, 0xc19bf174cf692694ULL,
+	0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL, 0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL,
+	0x2de92c6f592b0275ULL, 0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+	0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL, 0xbf597fc7beef0ee4ULL,
+	0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL, 0x06ca6351e003826fULL, 0x142929670a0e6e70ULL,
+	0x27b70a8546d22ffcULL, 0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+	0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL, 0x92722c851482353bULL,
+	0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL, 0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL,
+	0xd192e819d6ef5218ULL, 0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+	0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL, 0x34b0bcb5e19b48a8ULL,
+	0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL, 0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL,
+	0x748f82ee5defb2fcULL, 0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+	0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL, 0xc67178f2e372532bULL,
+	0xca273eceea26619cULL, 0xd186b8c721c0c207ULL, 0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL,
+	0x06f067aa72176fbaULL, 0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+	0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL, 0x431d67c49c100d4cULL,
+	0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL, 0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL
+};
+#endif
+
+#ifdef HASH_ENABLE_SHA1
+/**
+ * Initial hash value for SHA-1.
+ */
+static const uint32_t hash_native_sha1_init[5] = {
+	0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0
+};
+#endif
+
+/**
+ * Initial hash value for SHA-256.
+ */
+static const uint32_t hash_native_sha256_init[8] = {
+	0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+#ifdef HASH_ENABLE_SHA384
+/**
+ * Initial hash value for SHA-384.
+ */
+static const uint64_t hash_native_sha384_init[8] = {
+	0xcbbb9d5dc1059ed8ULL, 0x629a292a367cd507ULL, 0x9159015a3070dd17ULL, 0x152fecd8f70e5939ULL,
+	0x67332667ffc00b31ULL, 0x8eb44a8768581511ULL, 0xdb0c2e0d64f98fa7ULL, 0x47b5481dbefa4fa4ULL
+};
+#endif
+
+#ifdef HASH_ENABLE_SHA512
+/**
+ * Initial hash value for SHA-512.
+ */
+static const uint64_t hash_native_sha512_init[8] = {
+	0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+	0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL, 0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL
+};
+#endif
+
+
+/**
+ * Load a big endian 32-bit value.
+ *
+ * @param data The data to load.
+ *
+ * @return The loaded value.
+ */
+static uint32_t hash_native_load_be32 (const uint8_t *data)
+{
+	return ((uint32_t) data[0] << 24) | ((uint32_t) data[1] << 16) | ((uint32_t) data[2] << 8) |
+		(uint32_t) data[3];
+}
+
+/**
+ * Store a 32-bit value in big endian format.
+ *
+ * @param data Output for the value.
+ * @param value The value to store.
+ */
+static void hash_native_store_be32 (uint8_t *data, uint32_t value)
+{
+	data[0] = value >> 24;
+	data[1] = value >> 16;
+	data[2] = value >> 8;
+	data[3] = value;
+}
+
+#if defined HASH_ENABLE_SHA384 || defined HASH_ENABLE_SHA512
+/**
+ * Load a big endian 64-bit value.
+ *
+ * @param data The data to load.
+ *
+ * @return The loaded value.
+ */
+static uint64_t hash_native_load_be64 (const uint8_t *data)
+{
+	return ((uint64_t) hash_native_load_be32 (data) << 32) | hash_native_load_be32 (&data[4]);
+}
+
+/**
+ * Store a 64-bit value in big endian format.
+ *
+ * @param data Output for the value.
+ * @param value The value to store.
+ */
+static void hash_native_store_be64 (uint8_t *data, uint64_t value)
+{
+	hash_native_store_be32 (data, value >> 32);
+	hash_native_store_be32 (&data[4], value);
+}
+#endif
+
+#ifdef HASH_ENABLE_SHA1
+/**
+ * Run the SHA-1 compression function using portable C code.
+ *
+ * @param state The intermediate hash value to update.
+ * @param data The blocks of data to process.
+ * @param blocks The number of blocks to process.
+ */
+static void hash_native_sha1_portable (uint32_t *state, const uint8_t *data, size_t blocks)
+{
+	uint32_t w[16];
+	uint32_t a, b, c, d, e;
+	uint32_t f;
+	uint32_t k;
+	uint32_t tmp;
+	int i;
+
+	while (blocks--) {
+		for (i = 0; i < 16; i++) {
+			w[i] = hash_native_load_be32 (&data[i * 4]);
+		}
+
+		a = state[0];
+		b = state[1];
+		c = state[2];
+		d = state[3];
+		e = state[4];
+
+		for (i = 0; i < 80; i++) {
+			if (i >= 16) {
+				tmp = w[(i - 3) & 15] ^ w[(i - 8) & 15] ^ w[(i - 14) & 15] ^ w[i & 15];
+				w[i & 15] = HASH_NATIVE_ROTL32 (tmp, 1);
+			}
+
+			if (i < 20) {
+				f = (b & c) | (~b & d);
+				k = 0x5a827999;
+			}
+			else if (i < 40) {
+				f = b ^ c ^ d;
+				k = 0x6ed9eba1;
+			}
+			else if (i < 60) {
+				f = (b & c) | (b & d) | (c & d);
+				k = 0x8f1bbcdc;
+			}
+			else {
+				f = b ^ c ^ d;
+				k = 0xca62c1d6;
+			}
+
+			tmp = HASH_NATIVE_ROTL32 (a, 5) + f + e + k + w[i & 15];
+			e = d;
+			d = c;
+			c = HASH_NATIVE_ROTL32 (b, 30);
+			b = a;
+			a = tmp;
+		}
+
+		state[0] += a;
+		state[1] += b;
+		state[2] += c;
+		state[3] += d;
+		state[4] += e;
+
+		data += SHA1_BLOCK_SIZE;
+	}
+}
+#endif
+
+/**
+ * Run the SHA-256 compression function using portable C code.
+ *
+ * @param state The intermediate hash value to update.
+ * @param data The blocks of data to process.
+ * @param blocks The number of blocks to process.
+ */
+static void hash_native_sha256_portable (uint32_t *state, const uint8_t *data, size_t blocks)
+{
+	uint32_t w[64];
+	uint32_t a, b, c, d, e, f, g, h;
+	uint32_t t1;
+	uint32_t t2;
+	int i;
+
+	while (blocks--) {
+		for (i = 0; i < 16; i++) {
+			w[i] = hash_native_load_be32 (&data[i * 4]);
+		}
+
+		for (; i < 64; i++) {
+			t1 = HASH_NATIVE_ROTR32 (w[i - 2], 17) ^ HASH_NATIVE_ROTR32 (w[i - 2], 19) ^
+				(w[i - 2] >> 10);
+			t2 = HASH_NATIVE_ROTR32 (w[i - 15], 7) ^ HASH_NATIVE_ROTR32 (w[i - 15], 18) ^
+				(w[i - 15] >> 3);
+			w[i] = t1 + w[i - 7] + t2 + w[i - 16];
+		}
+
+		a = state[0];
+		b = state[1];
+		c = state[2];
+		d = state[3];
+		e = state[4];
+		f = state[5];
+		g = state[6];
+		h = state[7];
+
+		for (i = 0; i < 64; i++) {
+			t1 = h + (HASH_NATIVE_ROTR32 (e, 6) ^ HASH_NATIVE_ROTR32 (e, 11) ^
+				HASH_NATIVE_ROTR32 (e, 25)) + ((e & f) ^ (~e & g)) + hash_native_sha256_k[i] + w[i];
+			t2 = (HASH_NATIVE_ROTR32 (a, 2) ^ HASH_NATIVE_ROTR32 (a, 13) ^
+				HASH_NATIVE_ROTR32 (a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+
+			h = g;
+			g = f;
+			f = e;
+			e = d + t1;
+			d = c;
+			c = b;
+			b = a;
+			a = t1 + t2;
+		}
+
+		state[0] += a;
+		state[1] += b;
+		state[2] += c;
+		state[3] += d;
+		state[4] += e;
+		state[5] += f;
+		state[6] += g;
+		state[7] += h;
+
+		data += SHA256_BLOCK_SIZE;
+	}
+}
+
+#if defined HASH_ENABLE_SHA384 || defined HASH_ENABLE_SHA512
+/**
+ * Run the SHA-512 compression function using portable C code.
+ *
+ * @param state The intermediate hash value to update.
+ * @param data The blocks of data to process.
+ * @param blocks The number of blocks to process.
+ */
+static void hash_native_sha512_portable (uint64_t *state, const uint8_t *data, size_t blocks)
+{
+	uint64_t w[80];
+	uint64_t a, b, c, d, e, f, g, h;
+	uint64_t t1;
+	uint64_t t2;
+	int i;
+
+	while (blocks--) {
+		for (i = 0; i < 16; i++) {
+			w[i] = hash_native_load_be64 (&data[i * 8]);
+		}
+
+		for (; i < 80; i++) {
+			t1 = HASH_NATIVE_ROTR64 (w[i - 2], 19) ^ HASH_NATIVE_ROTR64 (w[i - 2], 61) ^
+				(w[i - 2] >> 6);
+			t2 = HASH_NATIVE_ROTR64 (w[i - 15], 1) ^ HASH_NATIVE_ROTR64 (w[i - 15], 8) ^
+				(w[i - 15] >> 7);
+			w[i] = t1 + w[i - 7] + t2 + w[i - 16];
+		}
+
+		a = state[0];
+		b = state[1];
+		c = state[2];
+		d = state[3];
+		e = state[4];
+		f = state[5];
+		g = state[6];
+		h = state[7];
+
+		for (i = 0; i < 80; i++) {
+			t1 = h + (HASH_NATIVE_ROTR64 (e, 14) ^ HASH_NATIVE_ROTR64 (e, 18) ^
+				HASH_NATIVE_ROTR64 (e, 41)) + ((e & f) ^ (~e & g)) + hash_native_sha512_k[i] + w[i];
+			t2 = (HASH_NATIVE_ROTR64 (a, 28) ^ HASH_NATIVE_ROTR64 (a, 34) ^
+				HASH_NATIVE_ROTR64 (a, 39)) + ((a & b) ^ (a & c) ^ (b & c));
+
+			h = g;
+			g = f;
+			f = e;
+			e = d + t1;
+			d = c;
+			c = b;
+			b = a;
+			a = t1 + t2;
+		}
+
+		state[0] += a;
+		state[1] += b;
+		state[2] += c;
+		state[3] += d;
+		state[4] += e;
+		state[5] += f;
+		state[6] += g;
+		state[7] += h;
+
+		data += SHA512_BLOCK_SIZE;
+	}
+}
+#endif
+
+/**
+ * Get the block size for the active hash.
+ *
+ * @param native The hash engine to query.
+ *
+ * @return The block size of the active hash.
+ */
+static size_t hash_native_get_block_size (const struct hash_engine_native *native)
+{
+	if ((native->active == HASH_ACTIVE_SHA384) || (native->active == HASH_ACTIVE_SHA512)) {
+		return SHA512_BLOCK_SIZE;
+	}
+	else {
+		return SHA256_BLOCK_SIZE;
+	}
+}
+
+/**
+ * Run the compression function for the active hash.
+ *
+ * @param native The hash engine to update.
+ * @param data The blocks of data to process.
+ * @param blocks The number of blocks to process.
+ */
+static void hash_native_compress (struct hash_engine_native *native, const uint8_t *data,
+	size_t blocks)
+{
+	switch (native->active) {
+#ifdef HASH_ENABLE_SHA1
+		case HASH_ACTIVE_SHA1:
+			native->sha1 (native->context.state.h32, data, blocks);
+			break;
+#endif
+
+#if defined HASH_ENABLE_SHA384 || defined HASH_ENABLE_SHA512
+		case HASH_ACTIVE_SHA384:
+		case HASH_ACTIVE_SHA512:
+			native->sha512 (native->context.state.h64, data, blocks);
+			break;
+#endif
+
+		default:
+			native->sha256 (native->context.state.h32, data, blocks);
+			break;
+	}
+}
+
+/**
+ * Start a new hash calculation.
+ *
+ * @param native The hash engine to use.
+ * @param type The type of hash to start.
+ *
+ * @return 0 if the hash was started successfully or an error code.
+ */
+static int hash_native_start (struct hash_engine_native *native, enum hash_type type)
+{
+	if (native == NULL) {
+		return HASH_ENGINE_INVALID_ARGUMENT;
+	}
+
+	if (native->active != HASH_ACTIVE_NONE) {
+		return HASH_ENGINE_HASH_IN_PROGRESS;
+	}
+
+	switch (type) {
+#ifdef HASH_ENABLE_SHA1
+		case HASH_TYPE_SHA1:
+			memcpy (native->context.state.h32, hash_native_sha1_init,
+				sizeof (hash_native_sha1_init));
+			break;
+#endif
+
+		case HASH_TYPE_SHA256:
+			memcpy (native->context.state.h32, hash_native_sha256_init,
+				sizeof (hash_native_sha256_init));
+			break;
+
+#ifdef HASH_ENABLE_SHA384
+		case HASH_TYPE_SHA384:
+			memcpy (native->context.state.h64, hash_native_sha384_init,
+				sizeof (hash_native_sha384_init));
+			break;
+#endif
+
+#ifdef HASH_ENABLE_SHA512
+		case HASH_TYPE_SHA512:
+			memcpy (native->context.state.h64, hash_native_sha512_init,
+				sizeof (hash_native_sha512_init));
+			break;
+#endif
+
+		default:
+			return HASH_ENGINE_UNSUPPORTED_HASH;
+	}
+
+	native->context.length = 0;
+	native->active = (uint8_t) type;
+
+	return 0;
+}
+
+static int hash_native_update (struct hash_engine *engine, const uint8_t *data, size_t length)
+{
+	struct hash_engine_native *native = (struct hash_engine_native*) engine;
+	size_t block_size;
+	size_t used;
+	size_t fill;
+	size_t blocks;
+
+	if ((native == NULL) || ((data == NULL) && (length != 0))) {
+		return HASH_ENGINE_INVALID_ARGUMENT;
+	}
+
+	if (native->active == HASH_ACTIVE_NONE) {
+		return HASH_ENGINE_NO_ACTIVE_HASH;
+	}
+
+	block_size = hash_native_get_block_size (native);
+	used = native->context.length % block_size;
+	native->context.length += length;
+
+	if (used != 0) {
+		fill = block_size - used;
+		if (length < fill) {
+			memcpy (&native->context.block[used], data, length);
+			return 0;
+		}
+
+		memcpy (&native->context.block[used], data, fill);
+		hash_native_compress (native, native->context.block, 1);
+
+		data += fill;
+		length -= fill;
+	}
+
+	/* Process complete blocks directly from the input buffer so accelerated implementations can
+	 * run across many blocks in a single call. */
+	blocks = length / block_size;
+	if (blocks != 0) {
+		hash_native_compress (native, data, blocks);
+
+		data += blocks * block_size;
+		length -= blocks * block_size;
+	}
+
+	if (length != 0) {
+		memcpy (native->context.block, data, length);
+	}
+
+	return 0;
+}
+
+static int hash_native_finish (struct hash_engine *engine, uint8_t *hash, size_t hash_length)
+{
+	struct hash_engine_native *native = (struct hash_engine_native*) engine;
+	size_t block_size;
+	size_t length_size;
+	size_t digest_length;
+	size_t used;
+	size_t i;
+
+	if ((native == NULL) || (hash == NULL)) {
+		return HASH_ENGINE_INVALID_ARGUMENT;
+	}
+
+	switch (native->active) {
+#ifdef HASH_ENABLE_SHA1
+		case HASH_ACTIVE_SHA1:
+			digest_length = SHA1_HASH_LENGTH;
+			break;
+#endif
+
+		case HASH_ACTIVE_SHA256:
+			digest_length = SHA256_HASH_LENGTH;
+			break;
+
+#ifdef HASH_ENABLE_SHA384
+		case HASH_ACTIVE_SHA384:
+			digest_length = SHA384_HASH_LENGTH;
+			break;
+#endif
+
+#ifdef HASH_ENABLE_SHA512
+		case HASH_ACTIVE_SHA512:
+			digest_length = SHA512_HASH_LENGTH;
+			break;
+#endif
+
+		default:
+			return HASH_ENGINE_NO_ACTIVE_HASH;
+	}
+
+	if (hash_length < digest_length) {
+		return HASH_ENGINE_HASH_BUFFER_TOO_SMALL;
+	}
+
+	/* SHA-384 and SHA-512 use a 128-bit length field.  Others use a 64-bit length. */
+	block_size = hash_native_get_block_size (native);
+	length_size = (block_size == SHA512_BLOCK_SIZE) ? 16 : 8;
+
+	used = native->context.length % block_size;
+	native->context.block[used++] = 0x80;
+
+	if (used > (block_size - length_size)) {
+		memset (&native->context.block[used], 0, block_size - used);
+		hash_native_compress (native, native->context.block, 1);
+		used = 0;
+	}
+
+	memset (&native->context.block[used], 0, block_size - used);
+
+	/* The data length is tracked in bytes, so the upper bits of a 128-bit length will be
+	 * determined only by the top bits of the byte count. */
+	if (length_size == 16) {
+		native->context.block[block_size - 9] = native->context.length >> 61;
+	}
+
+	hash_native_store_be32 (&native->context.block[block_size - 8],
+		native->context.length >> 29);
+	hash_native_store_be32 (&native->context.block[block_size - 4],
+		native->context.length << 3);
+
+	hash_native_compress (native, native->context.block, 1);
+
+#if defined HASH_ENABLE_SHA384 || defined HASH_ENABLE_SHA512
+	if (block_size == SHA512_BLOCK_SIZE) {
+		for (i = 0; i < (digest_length / 8); i++) {
+			hash_native_store_be64 (&hash[i * 8], native->context.state.h64[i]);
+		}
+	}
+	else
+#endif
+	{
+		for (i = 0; i < (digest_length / 4); i++) {
+			hash_native_store_be32 (&hash[i * 4], native->context.state.h32[i]);
+		}
+	}
+
+	native->active = HASH_ACTIVE_NONE;
+
+	return 0;
+}
+
+static void hash_native_cancel (struct hash_engine *engine)
+{
+	struct hash_engine_native *native = (struct hash_engine_native*) engine;
+
+	if (native) {
+		native->active = HASH_ACTIVE_NONE;
+	}
+}
+
+/**
+ * Calculate a hash on a complete set of data.
+ *
+ * @param native The hash engine to use.
+ * @param type The type of hash to calculate.
+ * @param data The data to hash.
+ * @param length The length of the data.
+ * @param hash Output buffer for the hash.
+ * @param hash_length The length of the output buffer.
+ * @param digest_length The length of the calculated digest.
+ *
+ * @return 0 if the hash was calculated successfully or an error code.
+ */
+static int hash_native_calculate (struct hash_engine_native *native, enum hash_type type,
+	const uint8_t *data, size_t length, uint8_t *hash, size_t hash_length, size_t digest_length)
+{
+	int status;
+
+	if ((native == NULL) || ((data == NULL) && (length != 0)) || (hash == NULL)) {
+		return HASH_ENGINE_INVALID_ARGUMENT;
+	}
+
+	if (native->active != HASH_ACTIVE_NONE) {
+		return HASH_ENGINE_HASH_IN_PROGRESS;
+	}
+
+	if (hash_length < digest_length) {
+		return HASH_ENGINE_HASH_BUFFER_TOO_SMALL;
+	}
+
+	status = hash_native_start (native, type);
+	if (status != 0) {
+		return status;
+	}
+
+	status = hash_native_update (&native->base, data, length);
+	if (status == 0) {
+		status = hash_native_finish (&native->base, hash, hash_length);
+	}
+
+	if (status != 0) {
+		hash_native_cancel (&native->base);
+	}
+
+	return status;
+}
+
+#ifdef HASH_ENABLE_SHA1
+static int hash_native_calculate_sha1 (struct hash_engine *engine, const uint8_t *data,
+	size_t length, uint8_t *hash, size_t hash_length)
+{
+	return hash_native_calculate ((struct hash_engine_native*) engine, HASH_TYPE_SHA1, data, length,
+		hash, hash_length, SHA1_HASH_LENGTH);
+}
+
+static int hash_native_start_sha1 (struct hash_engine *engine)
+{
+	return hash_native_start ((struct hash_engine_native*) engine, HASH_TYPE_SHA1);
+}
+#endif
+
+static int hash_native_calculate_sha256 (struct hash_engine *engine, const uint8_t *data,
+	size_t length, uint8_t *hash, size_t hash_length)
+{
+	return hash_native_calculate ((struct hash_engine_native*) engine, HASH_TYPE_SHA256, data,
+		length, hash, hash_length, SHA256_HASH_LENGTH);
+}
+
+static int hash_native_start_sha256 (struct hash_engine *engine)
+{
+	return hash_native_start ((struct hash_engine_native*) engine, HASH_TYPE_SHA256);
+}
+
+#ifdef HASH_ENABLE_SHA384
+static int hash_native_calculate_sha384 (struct hash_engine *engine, const uint8_t *data,
+	size_t length, uint8_t *hash, size_t hash_length)
+{
+	return hash_native_calculate ((struct hash_engine_native*) engine, HASH_TYPE_SHA384, data,
+		length, hash, hash_length, SHA384_HASH_LENGTH);
+}
+
+static int hash_native_start_sha384 (struct hash_engine *engine)
+{
+	return hash_native_start ((struct hash_engine_native*) engine, HASH_TYPE_SHA384);
+}
+#endif
+
+#ifdef HASH_ENABLE_SHA512
+static int hash_native_calculate_sha512 (struct hash_engine *engine, const uint8_t *data,
+	size_t length, uint8_t *hash, size_t hash_length)
+{
+	return hash_native_calculate ((struct hash_engine_native*) engine, HASH_TYPE_SHA512, data,
+		length, hash, hash_length, SHA512_HASH_LENGTH);
+}
+
+static int hash_native_start_sha512 (struct hash_engine *engine)
+{
+	return hash_native_start ((struct hash_engine_native*) engine, HASH_TYPE_SHA512);
+}
+#endif
+
+static int hash_native_save_state (struct hash_engine *engine, struct hash_saved_state *state)
+{
+	struct hash_engine_native *native = (struct hash_engine_native*) engine;
+
+	if ((native == NULL) || (state == NULL)) {
+		return HASH_ENGINE_INVALID_ARGUMENT;
+	}
+
+	if (native->active == HASH_ACTIVE_NONE) {
+		return HASH_ENGINE_NO_ACTIVE_HASH;
+	}
+
+	if (sizeof (native->context) > sizeof (state->context)) {
+		return HASH_ENGINE_NO_MEMORY;
+	}
+
+	/* The context is the same for every compression function, so state can be restored to an
+	 * engine using a different set of CPU features. */
+	memcpy (state->context, &native->context, sizeof (native->context));
+	state->active = native->active;
+
+	return 0;
+}
+
+static int hash_native_restore_state (struct hash_engine *engine,
+	const struct hash_saved_state *state)
+{
+	struct hash_engine_native *native = (struct hash_engine_native*) engine;
+
+	if ((native == NULL) || (state == NULL)) {
+		return HASH_ENGINE_INVALID_ARGUMENT;
+	}
+
+	if (native->active != HASH_ACTIVE_NONE) {
+		return HASH_ENGINE_HASH_IN_PROGRESS;
+	}
+
+	switch (state->active) {
+#ifdef HASH_ENABLE_SHA1
+		case HASH_ACTIVE_SHA1:
+#endif
+		case HASH_ACTIVE_SHA256:
+#ifdef HASH_ENABLE_SHA384
+		case HASH_ACTIVE_SHA384:
+#endif
+#ifdef HASH_ENABLE_SHA512
+		case HASH_ACTIVE_SHA512:
+#endif
+			break;
+
+		default:
+			return HASH_ENGINE_UNSUPPORTED_HASH;
+	}
+
+	memcpy (&native->context, state->context, sizeof (native->context));
+	native->active = state->active;
+
+	return 0;
+}
+
+#ifdef HASH_NATIVE_X86_SUPPORTED
+/**
+ * Context for one lane of a multi-buffer SHA-256 calculation.
+ */
+struct hash_native_multi_lane {
+	const struct hash_multi_buffer *buffer;			/**< The buffer being hashed in the lane. */
+	const uint8_t *data;							/**< The next block of data to process. */
+	size_t blocks;									/**< Number of complete data blocks remaining. */
+	const uint8_t *tail_next;						/**< The next block of padded data to process. */
+	size_t tail_blocks;								/**< Number of padded blocks remaining. */
+	uint8_t tail[SHA256_BLOCK_SIZE * 2];			/**< The final data with hash padding. */
+};
+
+/**
+ * Assign a new buffer to a lane of a multi-buffer SHA-256 calculation.  The data after the last
+ * complete block is copied into a separate buffer with the hash padding, so the lane can always be
+ * processed as a sequence of complete blocks.
+ *
+ * @param lane The lane to assign.
+ * @param state The intermediate hash values for all lanes.
+ * @param index Index of the lane being assigned.
+ * @param buffer The buffer that will be hashed in the lane.
+ */
+static void hash_native_multi_lane_assign (struct hash_native_multi_lane *lane, uint32_t *state,
+	size_t index, const struct hash_multi_buffer *buffer)
+{
+	size_t remain;
+	int i;
+
+	lane->buffer = buffer;
+	lane->data = buffer->data;
+	lane->blocks = buffer->length / SHA256_BLOCK_SIZE;
+
+	remain = buffer->length % SHA256_BLOCK_SIZE;
+	lane->tail_blocks = (remain < (SHA256_BLOCK_SIZE - 8)) ? 1 : 2;
+
+	memset (lane->tail, 0, sizeof (lane->tail));
+	if (remain != 0) {
+		memcpy (lane->tail, &buffer->data[lane->blocks * SHA256_BLOCK_SIZE], remain);
+	}
+
+	lane->tail[remain] = 0x80;
+	hash_native_store_be32 (&lane->tail[(lane->tail_blocks * SHA256_BLOCK_SIZE) - 8],
+		(uint64_t) buffer->length >> 29);
+	hash_native_store_be32 (&lane->tail[(lane->tail_blocks * SHA256_BLOCK_SIZE) - 4],
+		buffer->length << 3);
+
+	lane->tail_next = lane->tail;
+
+	for (i = 0; i < 8; i++) {
+		state[(i * HASH_NATIVE_X86_SHA256_LANES) + index] = hash_native_sha256_init[i];
+	}
+}
+
+/**
+ * Get the next block to process for a lane of a multi-buffer SHA-256 calculation.
+ *
+ * @param lane The lane to query.
+ *
+ * @return The next block of data for the lane.
+ */
+static const uint8_t* hash_native_multi_lane_next_block (struct hash_native_multi_lane *lane)
+{
+	const uint8_t *block;
+
+	if (lane->blocks != 0) {
+		block = lane->data;
+		lane->data += SHA256_BLOCK_SIZE;
+		lane->blocks--;
+	}
+	else {
+		block = lane->tail_next;
+		lane->tail_next += SHA256_BLOCK_SIZE;
+		lane->tail_blocks--;
+	}
+
+	return block;
+}
+
+/**
+ * Finish the hash for the last remaining lane of a multi-buffer SHA-256 calculation.  There is no
+ * benefit to processing a single buffer using all the lanes, so the remaining data is processed
+ * using the single-buffer compression function.
+ *
+ * @param native The hash engine being used.
+ * @param lane The lane to finish.
+ * @param state The intermediate hash values for all lanes.
+ * @param index Index of the lane being finished.
+ */
+static void hash_native_multi_lane_finish (struct hash_engine_native *native,
+	struct hash_native_multi_lane *lane, const uint32_t *state, size_t index)
+{
+	uint32_t h[8];
+	int i;
+
+	for (i = 0; i < 8; i++) {
+		h[i] = state[(i * HASH_NATIVE_X86_SHA256_LANES) + index];
+	}
+
+	if (lane->blocks != 0) {
+		native->sha256 (h, lane->data, lane->blocks);
+	}
+
+	native->sha256 (h, lane->tail_next, lane->tail_blocks);
+
+	for (i = 0; i < 8; i++) {
+		hash_native_store_be32 (&lane->buffer->hash[i * 4], h[i]);
+	}
+}
+
+static int hash_native_calculate_sha256_multi (struct hash_engine *engine,
+	const struct hash_multi_buffer *buffers, size_t count)
+{
+	struct hash_engine_native *native = (struct hash_engine_native*) engine;
+	struct hash_native_multi_lane lanes[HASH_NATIVE_X86_SHA256_LANES];
+	uint32_t state[8 * HASH_NATIVE_X86_SHA256_LANES];
+	const uint8_t *blocks[HASH_NATIVE_X86_SHA256_LANES];
+	uint8_t idle[SHA256_BLOCK_SIZE];
+	size_t next = 0;
+	size_t active = 0;
+	size_t last = 0;
+	size_t i;
+	int j;
+
+	if ((native == NULL) || ((buffers == NULL) && (count != 0))) {
+		return HASH_ENGINE_INVALID_ARGUMENT;
+	}
+
+	if (native->active != HASH_ACTIVE_NONE) {
+		return HASH_ENGINE_HASH_IN_PROGRESS;
+	}
+
+	for (i = 0; i < count; i++) {
+		if (((buffers[i].data == NULL) && (buffers[i].length != 0)) || (buffers[i].hash == NULL)) {
+			return HASH_ENGINE_INVALID_ARGUMENT;
+		}
+
+		if (buffers[i].hash_length < SHA256_HASH_LENGTH) {
+			return HASH_ENGINE_HASH_BUFFER_TOO_SMALL;
+		}
+	}
+
+	/* Lanes without any buffer to hash process a block of zeros and the result is discarded. */
+	memset (idle, 0, sizeof (idle));
+
+	for (i = 0; i < HASH_NATIVE_X86_SHA256_LANES; i++) {
+		if (next < count) {
+			hash_native_multi_lane_assign (&lanes[i], state, i, &buffers[next++]);
+			active++;
+		}
+		else {
+			lanes[i].buffer = NULL;
+		}
+	}
+
+	while (active > 1) {
+		for (i = 0; i < HASH_NATIVE_X86_SHA256_LANES; i++) {
+			if (lanes[i].buffer != NULL) {
+				blocks[i] = hash_native_multi_lane_next_block (&lanes[i]);
+			}
+			else {
+				blocks[i] = idle;
+			}
+		}
+
+		hash_native_x86_sha256_x8_avx2 (state, blocks);
+
+		/* As soon as a lane has completed its hash, start the next buffer in that lane. */
+		for (i = 0; i < HASH_NATIVE_X86_SHA256_LANES; i++) {
+			if ((lanes[i].buffer != NULL) && (lanes[i].blocks == 0) &&
+				(lanes[i].tail_blocks == 0)) {
+				for (j = 0; j < 8; j++) {
+					hash_native_store_be32 (&lanes[i].buffer->hash[j * 4],
+						state[(j * HASH_NATIVE_X86_SHA256_LANES) + i]);
+				}
+
+				if (next < count) {
+					hash_native_multi_lane_assign (&lanes[i], state, i, &buffers[next++]);
+				}
+				else {
+					lanes[i].buffer = NULL;
+					active--;
+				}
+			}
+		}
+	}
+
+	if (active == 1) {
+		while (lanes[last].buffer == NULL) {
+			last++;
+		}
+
+		hash_native_multi_lane_finish (native, &lanes[last], state, last);
+	}
+
+	return 0;
+}
+#endif
+
+/**
+ * Determine which CPU features that can be used for accelerating hash calculations are available
+ * on the current processor.
+ *
+ * @return A bitmask of hash_native_feature values indicating the available features.
+ */
+uint32_t hash_native_get_cpu_features (void)
+{
+#ifdef HASH_NATIVE_X86_SUPPORTED
+	return hash_native_x86_get_features ();
+#else
+	return 0;
+#endif
+}
+
+/**
+ * Initialize a native engine for calculating hashes.  The fastest implementation available on the
+ * current processor will be used for each hash algorithm.
+ *
+ * @param engine The hash engine to initialize.
+ *
+ * @return 0 if the hash engine was initialize successfully or an error code.
+ */
+int hash_native_init (struct hash_engine_native *engine)
+{
+	return hash_native_init_with_features (engine, hash_native_get_cpu_features ());
+}
+
+/**
+ * Initialize a native engine for calculating hashes, restricting the CPU features that will be
+ * used by the engine.  Any requested features that are not available on the current processor
+ * will be ignored.
+ *
+ * @param engine The hash engine to initialize.
+ * @param features A bitmask of hash_native_feature values the engine is allowed to use.  Set this
+ * to 0 to only use the portable implementations.
+ *
+ * @return 0 if the hash engine was initialize successfully or an error code.
+ */
+int hash_native_init_with_features (struct hash_engine_native *engine, uint32_t features)
+{
+	if (engine == NULL) {
+		return HASH_ENGINE_INVALID_ARGUMENT;
+	}
+
+	memset (engine, 0, sizeof (struct hash_engine_native));
+
+#ifdef HASH_ENABLE_SHA1
+	engine->base.calculate_sha1 = hash_native_calculate_sha1;
+	engine->base.start_sha1 = hash_native_start_sha1;
+#endif
+	engine->base.calculate_sha256 = hash_native_calculate_sha256;
+	engine->base.start_sha256 = hash_native_start_sha256;
+#ifdef HASH_ENABLE_SHA384
+	engine->base.calculate_sha384 = hash_native_calculate_sha384;
+	engine->base.start_sha384 = hash_native_start_sha384;
+#endif
+#ifdef HASH_ENABLE_SHA512
+	engine->base.calculate_sha512 = hash_native_calculate_sha512;
+	engine->base.start_sha512 = hash_native_start_sha512;
+#endif
+	engine->base.update = hash_native_update;
+	engine->base.finish = hash_native_finish;
+	engine->base.cancel = hash_native_cancel;
+	engine->base.save_state = hash_native_save_state;
+	engine->base.restore_state = hash_native_restore_state;
+
+	engine->features = features & hash_native_get_cpu_features ();
+
+#ifdef HASH_ENABLE_SHA1
+	engine->sha1 = hash_native_sha1_portable;
+#endif
+	engine->sha256 = hash_native_sha256_portable;
+#if defined HASH_ENABLE_SHA384 || defined HASH_ENABLE_SHA512
+	engine->sha512 = hash_native_sha512_portable;
+#endif
+
+#ifdef HASH_NATIVE_X86_SUPPORTED
+	if (engine->features & HASH_NATIVE_FEATURE_SHA_NI) {
+#ifdef HASH_ENABLE_SHA1
+		engine->sha1 = hash_native_x86_sha1_shani;
+#endif
+		engine->sha256 = hash_native_x86_sha256_shani;
+	}
+
+#if defined HASH_ENABLE_SHA384 || defined HASH_ENABLE_SHA512
+	if (engine->features & HASH_NATIVE_FEATURE_AVX2) {
+		engine->sha512 = hash_native_x86_sha512_avx2;
+	}
+#endif
+
+	/* The SHA extensions are faster than running SHA-256 across the AVX2 lanes, so multi-buffer
+	 * hashing is only used when the SHA extensions are not available. */
+	if ((engine->features & (HASH_NATIVE_FEATURE_AVX2 | HASH_NATIVE_FEATURE_SHA_NI)) ==
+		HASH_NATIVE_FEATURE_AVX2) {
+		engine->base.calculate_sha256_multi = hash_native_calculate_sha256_multi;
+	}
+#endif
+
+	engine->active = HASH_ACTIVE_NONE;
+
+	return 0;
+}
+
+/**
+ * Release the resources used by a native hash engine.
+ *
+ * @param engine The hash engine to release.
+ */
+void hash_native_release (struct hash_engine_native *engine)
+{
+
+}
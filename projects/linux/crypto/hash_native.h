@@ -0,0 +1,80 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef HASH_NATIVE_H_
+#define HASH_NATIVE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include "crypto/hash.h"
+
+
+/**
+ * CPU features that can be used to accelerate hash calculations.
+ */
+enum hash_native_feature {
+	HASH_NATIVE_FEATURE_SHA_NI = 0x01,	/**< x86 SHA extensions for SHA-1 and SHA-256. */
+	HASH_NATIVE_FEATURE_AVX2 = 0x02,	/**< x86 AVX2 and BMI2 for SHA-384/512 and multi-buffer SHA-256. */
+};
+
+/**
+ * Function to run the hash compression function on one or more complete blocks of data.
+ *
+ * @param state The intermediate hash value to update.
+ * @param data The blocks of data to process.
+ * @param blocks The number of blocks to process.
+ */
+typedef void (*hash_native_compress_32) (uint32_t *state, const uint8_t *data, size_t blocks);
+
+/**
+ * Function to run the hash compression function on one or more complete blocks of data using
+ * 64-bit words.
+ *
+ * @param state The intermediate hash value to update.
+ * @param data The blocks of data to process.
+ * @param blocks The number of blocks to process.
+ */
+typedef void (*hash_native_compress_64) (uint64_t *state, const uint8_t *data, size_t blocks);
+
+/**
+ * Context for an in-progress hash calculation.  The context contains no pointers, so a copy of the
+ * context is a complete clone of the hash state.
+ */
+struct hash_native_context {
+	union {
+		uint32_t h32[8];					/**< Intermediate hash value for SHA-1 and SHA-256. */
+		uint64_t h64[8];					/**< Intermediate hash value for SHA-384 and SHA-512. */
+	} state;
+	uint64_t length;						/**< Total number of bytes added to the hash. */
+	uint8_t block[SHA512_BLOCK_SIZE];		/**< Buffer for a partial block of data. */
+};
+
+/**
+ * A hash engine that calculates hashes natively, without depending on an external crypto library.
+ * Compression functions that use CPU instructions for SHA acceleration are selected at run time
+ * based on the features available on the processor, falling back to portable implementations
+ * when no acceleration is available.
+ */
+struct hash_engine_native {
+	struct hash_engine base;				/**< The base hash engine. */
+	struct hash_native_context context;		/**< Context for the active hash. */
+#ifdef HASH_ENABLE_SHA1
+	hash_native_compress_32 sha1;			/**< Compression function for SHA-1. */
+#endif
+	hash_native_compress_32 sha256;			/**< Compression function for SHA-256. */
+#if defined HASH_ENABLE_SHA384 || defined HASH_ENABLE_SHA512
+	hash_native_compress_64 sha512;			/**< Compression function for SHA-384 and SHA-512. */
+#endif
+	uint32_t features;						/**< CPU features used by the engine. */
+	uint8_t active;							/**< The type of hash being calculated. */
+};
+
+
+int hash_native_init (struct hash_engine_native *engine);
+int hash_native_init_with_features (struct hash_engine_native *engine, uint32_t features);
+void hash_native_release (struct hash_engine_native *engine);
+
+uint32_t hash_native_get_cpu_features (void);
+
+
+#endif /* HASH_NATIVE_H_ */
@@ -0,0 +1,509 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdint.h>
+#include <stddef.h>
+#include "hash_native.h"
+#include "hash_native_x86.h"
+
+#ifdef HASH_NATIVE_X86_SUPPORTED
+#include <cpuid.h>
+#include <immintrin.h>
+
+
+/* The accelerated functions are compiled for specific instruction set extensions using function
+ * attributes so the rest of the build does not depend on those extensions being available.  The
+ * caller must check that the CPU supports the extensions before calling any of these functions. */
+#define	HASH_NATIVE_X86_TARGET_SHA		__attribute__ ((target ("sha,sse4.1,ssse3")))
+#define	HASH_NATIVE_X86_TARGET_AVX2		__attribute__ ((target ("avx2,bmi2")))
+
+/**
+ * Bit in XCR0 indicating the OS saves SSE register state.
+ */
+#define	HASH_NATIVE_X86_XCR0_SSE		(1U << 1)
+
+/**
+ * Bit in XCR0 indicating the OS saves AVX register state.
+ */
+#define	HASH_NATIVE_X86_XCR0_AVX		(1U << 2)
+
+
+/**
+ * Read an extended control register.
+ *
+ * @param index The register to read.
+ *
+ * @return The lower 32 bits of the register.
+ */
+static uint32_t hash_native_x86_xgetbv (uint32_t index)
+{
+	uint32_t eax;
+	uint32_t edx;
+
+	__asm__ volatile ("xgetbv" : "=a" (eax), "=d" (edx) : "c" (index));
+
+	return eax;
+}
+
+/**
+ * Determine which CPU features that can be used for accelerating hash calculations are available.
+ *
+ * @return A bitmask of hash_native_feature values indicating the available features.
+ */
+uint32_t hash_native_x86_get_features (void)
+{
+	unsigned int eax;
+	unsigned int ebx;
+	unsigned int ecx;
+	unsigned int edx;
+	unsigned int ecx1;
+	uint32_t features = 0;
+
+	if (!__get_cpuid (1, &eax, &ebx, &ecx1, &edx)) {
+		return 0;
+	}
+
+	if (!__get_cpuid_count (7, 0, &eax, &ebx, &ecx, &edx)) {
+		return 0;
+	}
+
+	if ((ebx & bit_SHA) && (ecx1 & bit_SSE4_1) && (ecx1 & bit_SSSE3)) {
+		features |= HASH_NATIVE_FEATURE_SHA_NI;
+	}
+
+	/* AVX2 also requires the OS to save the extended register state on context switches. */
+	if ((ebx & bit_AVX2) && (ebx & bit_BMI2) && (ecx1 & bit_AVX) && (ecx1 & bit_OSXSAVE)) {
+		if ((hash_native_x86_xgetbv (0) &
+			(HASH_NATIVE_X86_XCR0_SSE | HASH_NATIVE_X86_XCR0_AVX)) ==
+			(HASH_NATIVE_X86_XCR0_SSE | HASH_NATIVE_X86_XCR0_AVX)) {
+			features |= HASH_NATIVE_FEATURE_AVX2;
+		}
+	}
+
+	return features;
+}
+
+#ifdef HASH_ENABLE_SHA1
+/**
+ * Run four SHA-1 rounds using the SHA extensions.  The next four words of the message schedule are
+ * calculated first, if necessary.
+ *
+ * @param group Index of the four round group being executed.
+ * @param func The SHA-1 round function to use.  This must be a constant.
+ */
+#define	HASH_NATIVE_X86_SHA1_ROUNDS(group, func)	{ \
+		if ((group) >= 4) { \
+			msg[(group) & 3] = _mm_sha1msg2_epu32 (_mm_xor_si128 ( \
+				_mm_sha1msg1_epu32 (msg[(group) & 3], msg[((group) + 1) & 3]), \
+				msg[((group) + 2) & 3]), msg[((group) + 3) & 3]); \
+		} \
+		\
+		e = _mm_sha1nexte_epu32 (abcd_prev, msg[(group) & 3]); \
+		abcd_prev = abcd; \
+		abcd = _mm_sha1rnds4_epu32 (abcd, e, func); \
+	}
+
+/**
+ * Run the SHA-1 compression function using the SHA extensions.
+ *
+ * @param state The intermediate hash value to update.
+ * @param data The blocks of data to process.
+ * @param blocks The number of blocks to process.
+ */
+HASH_NATIVE_X86_TARGET_SHA
+void hash_native_x86_sha1_shani (uint32_t *state, const uint8_t *data, size_t blocks)
+{
+	const __m128i mask = _mm_set_epi64x (0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+	__m128i abcd;
+	__m128i abcd_save;
+	__m128i abcd_prev;
+	__m128i e;
+	__m128i e_save;
+	__m128i msg[4];
+	int group;
+	int i;
+
+	abcd = _mm_shuffle_epi32 (_mm_loadu_si128 ((const __m128i*) state), 0x1b);
+	e_save = _mm_set_epi32 (state[4], 0, 0, 0);
+
+	while (blocks--) {
+		abcd_save = abcd;
+
+		for (i = 0; i < 4; i++) {
+			msg[i] = _mm_shuffle_epi8 (_mm_loadu_si128 ((const __m128i*) &data[i * 16]), mask);
+		}
+
+		/* Rounds 0-3 add E directly instead of deriving it from the previous rounds. */
+		e = _mm_add_epi32 (e_save, msg[0]);
+		abcd_prev = abcd;
+		abcd = _mm_sha1rnds4_epu32 (abcd, e, 0);
+
+		for (group = 1; group < 5; group++) {
+			HASH_NATIVE_X86_SHA1_ROUNDS (group, 0);
+		}
+		for (; group < 10; group++) {
+			HASH_NATIVE_X86_SHA1_ROUNDS (group, 1);
+		}
+		for (; group < 15; group++) {
+			HASH_NATIVE_X86_SHA1_ROUNDS (group, 2);
+		}
+		for (; group < 20; group++) {
+			HASH_NATIVE_X86_SHA1_ROUNDS (group, 3);
+		}
+
+		e_save = _mm_sha1nexte_epu32 (abcd_prev, e_save);
+		abcd = _mm_add_epi32 (abcd, abcd_save);
+
+		data += SHA1_BLOCK_SIZE;
+	}
+
+	_mm_storeu_si128 ((__m128i*) state, _mm_shuffle_epi32 (abcd, 0x1b));
+	state[4] = _mm_extract_epi32 (e_save, 3);
+}
+#endif
+
+/**
+ * Run the SHA-256 compression function using the SHA extensions.
+ *
+ * @param state The intermediate hash value to update.
+ * @param data The blocks of data to process.
+ * @param blocks The number of blocks to process.
+ */
+HASH_NATIVE_X86_TARGET_SHA
+void hash_native_x86_sha256_shani (uint32_t *state, const uint8_t *data, size_t blocks)
+{
+	const __m128i mask = _mm_set_epi64x (0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+	__m128i state0;
+	__m128i state1;
+	__m128i abef_save;
+	__m128i cdgh_save;
+	__m128i msg[4];
+	__m128i wk;
+	__m128i tmp;
+	int i;
+
+	/* The SHA extensions operate on the state arranged as ABEF and CDGH. */
+	tmp = _mm_shuffle_epi32 (_mm_loadu_si128 ((const __m128i*) &state[0]), 0xb1);
+	state1 = _mm_shuffle_epi32 (_mm_loadu_si128 ((const __m128i*) &state[4]), 0x1b);
+	state0 = _mm_alignr_epi8 (tmp, state1, 8);
+	state1 = _mm_blend_epi16 (state1, tmp, 0xf0);
+
+	while (blocks--) {
+		abef_save = state0;
+		cdgh_save = state1;
+
+		for (i = 0; i < 16; i++) {
+			if (i < 4) {
+				msg[i] = _mm_shuffle_epi8 (_mm_loadu_si128 ((const __m128i*) &data[i * 16]), mask);
+			}
+			else {
+				tmp = _mm_sha256msg1_epu32 (msg[i & 3], msg[(i + 1) & 3]);
+				tmp = _mm_add_epi32 (tmp, _mm_alignr_epi8 (msg[(i + 3) & 3], msg[(i + 2) & 3], 4));
+				msg[i & 3] = _mm_sha256msg2_epu32 (tmp, msg[(i + 3) & 3]);
+			}
+
+			wk = _mm_add_epi32 (msg[i & 3],
+				_mm_loadu_si128 ((const __m128i*) &hash_native_sha256_k[i * 4]));
+			state1 = _mm_sha256rnds2_epu32 (state1, state0, wk);
+			state0 = _mm_sha256rnds2_epu32 (state0, state1, _mm_shuffle_epi32 (wk, 0x0e));
+		}
+
+		state0 = _mm_add_epi32 (state0, abef_save);
+		state1 = _mm_add_epi32 (state1, cdgh_save);
+
+		data += SHA256_BLOCK_SIZE;
+	}
+
+	tmp = _mm_shuffle_epi32 (state0, 0x1b);
+	state1 = _mm_shuffle_epi32 (state1, 0xb1);
+	_mm_storeu_si128 ((__m128i*) &state[0], _mm_blend_epi16 (tmp, state1, 0xf0));
+	_mm_storeu_si128 ((__m128i*) &state[4], _mm_alignr_epi8 (state1, tmp, 8));
+}
+
+#if defined HASH_ENABLE_SHA384 || defined HASH_ENABLE_SHA512
+/**
+ * Rotate a 64-bit value to the right.  With BMI2 enabled, this will compile to RORX.
+ */
+#define	HASH_NATIVE_X86_ROTR64(x, n)	(((x) >> (n)) | ((x) << (64 - (n))))
+
+/**
+ * Get four consecutive words of the SHA-512 message schedule that start one word after the
+ * beginning of a vector.
+ *
+ * @param first Vector containing the first three words in the upper positions.
+ * @param next Vector containing the last word in the lowest position.
+ */
+#define	HASH_NATIVE_X86_SHA512_SHIFT_WORD(first, next)	\
+	_mm256_permute4x64_epi64 (_mm256_blend_epi32 (first, next, 0x03), 0x39)
+
+/**
+ * Calculate the next four words of the SHA-512 message schedule.  The message schedule is stored
+ * in four vectors, with the oldest four words being replaced by the new ones.  The sigma1 term
+ * depends on words two positions back, so the upper two words are calculated after the lower two.
+ *
+ * @param w0 Vector containing the oldest four words of the schedule.
+ * @param w1 Vector containing the next four words of the schedule.
+ * @param w2 Vector containing the next four words of the schedule.
+ * @param w3 Vector containing the newest four words of the schedule.
+ * @param t Index in the schedule for the first word being calculated.
+ */
+#define	HASH_NATIVE_X86_SHA512_SCHEDULE(w0, w1, w2, w3, t)	{ \
+		tmp = _mm256_add_epi64 (w0, \
+			hash_native_x86_sha512_sigma0 (HASH_NATIVE_X86_SHA512_SHIFT_WORD (w0, w1))); \
+		tmp = _mm256_add_epi64 (tmp, HASH_NATIVE_X86_SHA512_SHIFT_WORD (w2, w3)); \
+		\
+		lo = _mm_add_epi64 (_mm256_castsi256_si128 (tmp), \
+			hash_native_x86_sha512_sigma1 (_mm256_extracti128_si256 (w3, 1))); \
+		hi = _mm_add_epi64 (_mm256_extracti128_si256 (tmp, 1), \
+			hash_native_x86_sha512_sigma1 (lo)); \
+		\
+		w0 = _mm256_inserti128_si256 (_mm256_castsi128_si256 (lo), hi, 1); \
+		_mm256_storeu_si256 ((__m256i*) &wk[t], \
+			_mm256_add_epi64 (w0, _mm256_loadu_si256 ((const __m256i*) &hash_native_sha512_k[t]))); \
+	}
+
+/**
+ * Calculate the SHA-512 sigma0 function on each 64-bit word of a vector.
+ *
+ * @param x The vector to process.
+ *
+ * @return The sigma0 result for each word.
+ */
+HASH_NATIVE_X86_TARGET_AVX2
+static __m256i hash_native_x86_sha512_sigma0 (__m256i x)
+{
+	return _mm256_xor_si256 (
+		_mm256_xor_si256 (_mm256_srli_epi64 (x, 1), _mm256_slli_epi64 (x, 63)),
+		_mm256_xor_si256 (
+			_mm256_xor_si256 (_mm256_srli_epi64 (x, 8), _mm256_slli_epi64 (x, 56)),
+			_mm256_srli_epi64 (x, 7)));
+}
+
+/**
+ * Calculate the SHA-512 sigma1 function on each 64-bit word of a vector.
+ *
+ * @param x The vector to process.
+ *
+ * @return The sigma1 result for each word.
+ */
+HASH_NATIVE_X86_TARGET_AVX2
+static __m128i hash_native_x86_sha512_sigma1 (__m128i x)
+{
+	return _mm_xor_si128 (
+		_mm_xor_si128 (_mm_srli_epi64 (x, 19), _mm_slli_epi64 (x, 45)),
+		_mm_xor_si128 (
+			_mm_xor_si128 (_mm_srli_epi64 (x, 61), _mm_slli_epi64 (x, 3)),
+			_mm_srli_epi64 (x, 6)));
+}
+
+/**
+ * Run the SHA-512 compression function using AVX2 to calculate the message schedule and BMI2 for
+ * the round functions.
+ *
+ * @param state The intermediate hash value to update.
+ * @param data The blocks of data to process.
+ * @param blocks The number of blocks to process.
+ */
+HASH_NATIVE_X86_TARGET_AVX2
+void hash_native_x86_sha512_avx2 (uint64_t *state, const uint8_t *data, size_t blocks)
+{
+	const __m256i mask = _mm256_setr_epi8 (7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+		7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+	uint64_t wk[80];
+	uint64_t a, b, c, d, e, f, g, h;
+	uint64_t t1;
+	uint64_t t2;
+	__m256i w[4];
+	__m256i tmp;
+	__m128i lo;
+	__m128i hi;
+	int i;
+
+	while (blocks--) {
+		/* The schedule is kept in registers.  Only the sum of each word and its round constant is
+		 * stored for use by the round functions. */
+		for (i = 0; i < 4; i++) {
+			w[i] = _mm256_shuffle_epi8 (_mm256_loadu_si256 ((const __m256i*) &data[i * 32]), mask);
+			_mm256_storeu_si256 ((__m256i*) &wk[i * 4], _mm256_add_epi64 (w[i],
+				_mm256_loadu_si256 ((const __m256i*) &hash_native_sha512_k[i * 4])));
+		}
+
+		for (i = 16; i < 80; i += 16) {
+			HASH_NATIVE_X86_SHA512_SCHEDULE (w[0], w[1], w[2], w[3], i);
+			HASH_NATIVE_X86_SHA512_SCHEDULE (w[1], w[2], w[3], w[0], i + 4);
+			HASH_NATIVE_X86_SHA512_SCHEDULE (w[2], w[3], w[0], w[1], i + 8);
+			HASH_NATIVE_X86_SHA512_SCHEDULE (w[3], w[0], w[1], w[2], i + 12);
+		}
+
+		a = state[0];
+		b = state[1];
+		c = state[2];
+		d = state[3];
+		e = state[4];
+		f = state[5];
+		g = state[6];
+		h = state[7];
+
+		for (i = 0; i < 80; i++) {
+			t1 = h + (HASH_NATIVE_X86_ROTR64 (e, 14) ^ HASH_NATIVE_X86_ROTR64 (e, 18) ^
+				HASH_NATIVE_X86_ROTR64 (e, 41)) + ((e & f) ^ (~e & g)) + wk[i];
+			t2 = (HASH_NATIVE_X86_ROTR64 (a, 28) ^ HASH_NATIVE_X86_ROTR64 (a, 34) ^
+				HASH_NATIVE_X86_ROTR64 (a, 39)) + ((a & b) ^ (a & c) ^ (b & c));
+
+			h = g;
+			g = f;
+			f = e;
+			e = d + t1;
+			d = c;
+			c = b;
+			b = a;
+			a = t1 + t2;
+		}
+
+		state[0] += a;
+		state[1] += b;
+		state[2] += c;
+		state[3] += d;
+		state[4] += e;
+		state[5] += f;
+		state[6] += g;
+		state[7] += h;
+
+		data += SHA512_BLOCK_SIZE;
+	}
+}
+#endif
+
+/**
+ * Rotate each 32-bit word of a vector to the right.
+ */
+#define	HASH_NATIVE_X86_ROTR32X8(x, n)	\
+	_mm256_or_si256 (_mm256_srli_epi32 (x, n), _mm256_slli_epi32 (x, 32 - (n)))
+
+/**
+ * Load eight consecutive 32-bit words from each of eight blocks and transpose them so each vector
+ * holds the same word from every block.
+ *
+ * @param data The list of blocks to load from.
+ * @param offset Offset in each block of the first word to load.
+ * @param w Output for the eight transposed words.
+ */
+HASH_NATIVE_X86_TARGET_AVX2
+static void hash_native_x86_sha256_x8_load (const uint8_t *const *data, size_t offset, __m256i *w)
+{
+	const __m256i mask = _mm256_setr_epi8 (3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+		3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+	__m256i r[8];
+	__m256i t[8];
+	int i;
+
+	for (i = 0; i < 8; i++) {
+		r[i] = _mm256_shuffle_epi8 (_mm256_loadu_si256 ((const __m256i*) &data[i][offset]), mask);
+	}
+
+	for (i = 0; i < 8; i += 2) {
+		t[i] = _mm256_unpacklo_epi32 (r[i], r[i + 1]);
+		t[i + 1] = _mm256_unpackhi_epi32 (r[i], r[i + 1]);
+	}
+
+	r[0] = _mm256_unpacklo_epi64 (t[0], t[2]);
+	r[1] = _mm256_unpackhi_epi64 (t[0], t[2]);
+	r[2] = _mm256_unpacklo_epi64 (t[1], t[3]);
+	r[3] = _mm256_unpackhi_epi64 (t[1], t[3]);
+	r[4] = _mm256_unpacklo_epi64 (t[4], t[6]);
+	r[5] = _mm256_unpackhi_epi64 (t[4], t[6]);
+	r[6] = _mm256_unpacklo_epi64 (t[5], t[7]);
+	r[7] = _mm256_unpackhi_epi64 (t[5], t[7]);
+
+	for (i = 0; i < 4; i++) {
+		w[i] = _mm256_permute2x128_si256 (r[i], r[i + 4], 0x20);
+		w[i + 4] = _mm256_permute2x128_si256 (r[i], r[i + 4], 0x31);
+	}
+}
+
+/**
+ * Run the SHA-256 compression function on one block for each of eight independent hashes using
+ * AVX2.  Each 32-bit lane of the vectors holds the values for a different hash.
+ *
+ * @param state The intermediate hash values to update.  Word i of the hash in lane n is stored at
+ * state[(i * HASH_NATIVE_X86_SHA256_LANES) + n].
+ * @param data The block of data to process for each lane.
+ */
+HASH_NATIVE_X86_TARGET_AVX2
+void hash_native_x86_sha256_x8_avx2 (uint32_t *state, const uint8_t *const *data)
+{
+	__m256i w[16];
+	__m256i a, b, c, d, e, f, g, h;
+	__m256i out[8];
+	__m256i s0;
+	__m256i s1;
+	__m256i t1;
+	__m256i t2;
+	int i;
+
+	hash_native_x86_sha256_x8_load (data, 0, &w[0]);
+	hash_native_x86_sha256_x8_load (data, 32, &w[8]);
+
+	a = _mm256_loadu_si256 ((const __m256i*) &state[0 * HASH_NATIVE_X86_SHA256_LANES]);
+	b = _mm256_loadu_si256 ((const __m256i*) &state[1 * HASH_NATIVE_X86_SHA256_LANES]);
+	c = _mm256_loadu_si256 ((const __m256i*) &state[2 * HASH_NATIVE_X86_SHA256_LANES]);
+	d = _mm256_loadu_si256 ((const __m256i*) &state[3 * HASH_NATIVE_X86_SHA256_LANES]);
+	e = _mm256_loadu_si256 ((const __m256i*) &state[4 * HASH_NATIVE_X86_SHA256_LANES]);
+	f = _mm256_loadu_si256 ((const __m256i*) &state[5 * HASH_NATIVE_X86_SHA256_LANES]);
+	g = _mm256_loadu_si256 ((const __m256i*) &state[6 * HASH_NATIVE_X86_SHA256_LANES]);
+	h = _mm256_loadu_si256 ((const __m256i*) &state[7 * HASH_NATIVE_X86_SHA256_LANES]);
+
+	for (i = 0; i < 64; i++) {
+		if (i >= 16) {
+			s0 = w[(i - 15) & 15];
+			s0 = _mm256_xor_si256 (_mm256_xor_si256 (HASH_NATIVE_X86_ROTR32X8 (s0, 7),
+				HASH_NATIVE_X86_ROTR32X8 (s0, 18)), _mm256_srli_epi32 (s0, 3));
+
+			s1 = w[(i - 2) & 15];
+			s1 = _mm256_xor_si256 (_mm256_xor_si256 (HASH_NATIVE_X86_ROTR32X8 (s1, 17),
+				HASH_NATIVE_X86_ROTR32X8 (s1, 19)), _mm256_srli_epi32 (s1, 10));
+
+			w[i & 15] = _mm256_add_epi32 (_mm256_add_epi32 (w[i & 15], s0),
+				_mm256_add_epi32 (w[(i - 7) & 15], s1));
+		}
+
+		s1 = _mm256_xor_si256 (
+			_mm256_xor_si256 (HASH_NATIVE_X86_ROTR32X8 (e, 6), HASH_NATIVE_X86_ROTR32X8 (e, 11)),
+			HASH_NATIVE_X86_ROTR32X8 (e, 25));
+		t1 = _mm256_xor_si256 (_mm256_and_si256 (e, f), _mm256_andnot_si256 (e, g));
+		t1 = _mm256_add_epi32 (_mm256_add_epi32 (h, s1), _mm256_add_epi32 (t1, w[i & 15]));
+		t1 = _mm256_add_epi32 (t1, _mm256_set1_epi32 (hash_native_sha256_k[i]));
+
+		s0 = _mm256_xor_si256 (
+			_mm256_xor_si256 (HASH_NATIVE_X86_ROTR32X8 (a, 2), HASH_NATIVE_X86_ROTR32X8 (a, 13)),
+			HASH_NATIVE_X86_ROTR32X8 (a, 22));
+		t2 = _mm256_and_si256 (c, _mm256_or_si256 (a, b));
+		t2 = _mm256_add_epi32 (s0, _mm256_or_si256 (_mm256_and_si256 (a, b), t2));
+
+		h = g;
+		g = f;
+		f = e;
+		e = _mm256_add_epi32 (d, t1);
+		d = c;
+		c = b;
+		b = a;
+		a = _mm256_add_epi32 (t1, t2);
+	}
+
+	out[0] = a;
+	out[1] = b;
+	out[2] = c;
+	out[3] = d;
+	out[4] = e;
+	out[5] = f;
+	out[6] = g;
+	out[7] = h;
+
+	for (i = 0; i < 8; i++) {
+		_mm256_storeu_si256 ((__m256i*) &state[i * HASH_NATIVE_X86_SHA256_LANES],
+			_mm256_add_epi32 (out[i],
+				_mm256_loadu_si256 ((const __m256i*) &state[i * HASH_NATIVE_X86_SHA256_LANES])));
+	}
+}
+
+#endif
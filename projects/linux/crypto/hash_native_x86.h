@@ -0,0 +1,37 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef HASH_NATIVE_X86_H_
+#define HASH_NATIVE_X86_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+
+/* Hash compression functions that use x86 instruction set extensions.  These must only be called
+ * when hash_native_x86_get_features reports that the required CPU features are available. */
+
+#if defined __x86_64__ || defined __i386__
+#define	HASH_NATIVE_X86_SUPPORTED
+
+/**
+ * The number of independent SHA-256 hashes that can be calculated in parallel.
+ */
+#define	HASH_NATIVE_X86_SHA256_LANES	8
+
+
+extern const uint32_t hash_native_sha256_k[64];
+#if defined HASH_ENABLE_SHA384 || defined HASH_ENABLE_SHA512
+extern const uint64_t hash_native_sha512_k[80];
+#endif
+
+uint32_t hash_native_x86_get_features (void);
+
+void hash_native_x86_sha1_shani (uint32_t *state, const uint8_t *data, size_t blocks);
+void hash_native_x86_sha256_shani (uint32_t *state, const uint8_t *data, size_t blocks);
+void hash_native_x86_sha512_avx2 (uint64_t *state, const uint8_t *data, size_t blocks);
+void hash_native_x86_sha256_x8_avx2 (uint32_t *state, const uint8_t *const *data);
+#endif
+
+
+#endif /* HASH_NATIVE_X86_H_ */
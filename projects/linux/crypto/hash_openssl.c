@@ -306,6 +306,95 @@ static void hash_openssl_cancel (struct hash_engine *engine)
 	}
 }
 
+static int hash_openssl_save_state (struct hash_engine *engine, struct hash_saved_state *state)
+{
+	struct hash_engine_openssl *openssl = (struct hash_engine_openssl*) engine;
+
+	if ((openssl == NULL) || (state == NULL)) {
+		return HASH_ENGINE_INVALID_ARGUMENT;
+	}
+
+	/* OpenSSL contexts don't contain any pointers, so a copy of the context is a complete clone of
+	 * the hash state. */
+	switch (openssl->active) {
+#ifdef HASH_ENABLE_SHA1
+		case HASH_ACTIVE_SHA1:
+			if (sizeof (openssl->sha1) > sizeof (state->context)) {
+				return HASH_ENGINE_NO_MEMORY;
+			}
+
+			memcpy (state->context, &openssl->sha1, sizeof (openssl->sha1));
+			break;
+#endif
+
+		case HASH_ACTIVE_SHA256:
+			if (sizeof (openssl->sha256) > sizeof (state->context)) {
+				return HASH_ENGINE_NO_MEMORY;
+			}
+
+			memcpy (state->context, &openssl->sha256, sizeof (openssl->sha256));
+			break;
+
+#if defined HASH_ENABLE_SHA384 || defined HASH_ENABLE_SHA512
+		case HASH_ACTIVE_SHA384:
+		case HASH_ACTIVE_SHA512:
+			if (sizeof (openssl->sha512) > sizeof (state->context)) {
+				return HASH_ENGINE_NO_MEMORY;
+			}
+
+			memcpy (state->context, &openssl->sha512, sizeof (openssl->sha512));
+			break;
+#endif
+
+		default:
+			return HASH_ENGINE_NO_ACTIVE_HASH;
+	}
+
+	state->active = openssl->active;
+
+	return 0;
+}
+
+static int hash_openssl_restore_state (struct hash_engine *engine,
+	const struct hash_saved_state *state)
+{
+	struct hash_engine_openssl *openssl = (struct hash_engine_openssl*) engine;
+
+	if ((openssl == NULL) || (state == NULL)) {
+		return HASH_ENGINE_INVALID_ARGUMENT;
+	}
+
+	if (openssl->active != HASH_ACTIVE_NONE) {
+		return HASH_ENGINE_HASH_IN_PROGRESS;
+	}
+
+	switch (state->active) {
+#ifdef HASH_ENABLE_SHA1
+		case HASH_ACTIVE_SHA1:
+			memcpy (&openssl->sha1, state->context, sizeof (openssl->sha1));
+			break;
+#endif
+
+		case HASH_ACTIVE_SHA256:
+			memcpy (&openssl->sha256, state->context, sizeof (openssl->sha256));
+			break;
+
+#if defined HASH_ENABLE_SHA384 || defined HASH_ENABLE_SHA512
+		case HASH_ACTIVE_SHA384:
+		case HASH_ACTIVE_SHA512:
+			memcpy (&openssl->sha512, state->context, sizeof (openssl->sha512));
+			break;
+#endif
+
+		default:
+			return HASH_ENGINE_UNSUPPORTED_HASH;
+	}
+
+	openssl->active = state->active;
+
+	return 0;
+}
+
 /**
  * Initialize an OpenSSL engine for calculating hashes.
  *
@@ -338,6 +427,8 @@ int hash_openssl_init (struct hash_engine_openssl *engine)
 	engine->base.update = hash_openssl_update;
 	engine->base.finish = hash_openssl_finish;
 	engine->base.cancel = hash_openssl_cancel;
+	engine->base.save_state = hash_openssl_save_state;
+	engine->base.restore_state = hash_openssl_restore_state;
 
 	engine->active = HASH_ACTIVE_NONE;
 
@@ -485,3 +485,26 @@ int platform_os_resume_scheduler ()
 {
 	return PLATFORM_OS_ERROR (ENOSYS);
 }
+
+/* Use the GCC atomic builtins, which are supported on all Linux toolchains. */
+uint32_t platform_atomic_load (volatile uint32_t *value)
+{
+	return __atomic_load_n (value, __ATOMIC_ACQUIRE);
+}
+
+void platform_atomic_store (volatile uint32_t *value, uint32_t new_value)
+{
+	__atomic_store_n (value, new_value, __ATOMIC_RELEASE);
+}
+
+uint32_t platform_atomic_fetch_add (volatile uint32_t *value, uint32_t add)
+{
+	return __atomic_fetch_add (value, add, __ATOMIC_SEQ_CST);
+}
+
+bool platform_atomic_compare_exchange (volatile uint32_t *value, uint32_t expected,
+	uint32_t desired)
+{
+	return __atomic_compare_exchange_n (value, &expected, desired, false, __ATOMIC_SEQ_CST,
+		__ATOMIC_SEQ_CST);
+}
@@ -0,0 +1,261 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "platform_api.h"
+#include "testing.h"
+#include "crypto/ecc.h"
+#include "crypto/ecc_mbedtls.h"
+#include "crypto/ecc_openssl.h"
+#include "testing/crypto/ecc_testing.h"
+#include "testing/crypto/signature_testing.h"
+
+
+TEST_SUITE_LABEL ("ecc_benchmark");
+
+
+/**
+ * The number of signatures verified for each measurement.
+ */
+#define	ECC_BENCHMARK_COUNT				64
+
+/**
+ * The number of times the set of signatures is verified for each measurement.
+ */
+#define	ECC_BENCHMARK_ITERATIONS		4
+
+/**
+ * Buffer space for each signature.  This is large enough for any supported curve.
+ */
+#define	ECC_BENCHMARK_SIG_MAX_LENGTH	ECC_TESTING_ECC521_DSA_MAX_LENGTH
+
+
+/**
+ * Signatures and digests used for verification measurements.
+ */
+struct ecc_benchmark_signatures {
+	uint8_t digest[ECC_BENCHMARK_COUNT][SHA512_HASH_LENGTH];				/**< Signed digests. */
+	uint8_t signature[ECC_BENCHMARK_COUNT][ECC_BENCHMARK_SIG_MAX_LENGTH];	/**< Signatures. */
+	size_t sig_length[ECC_BENCHMARK_COUNT];									/**< DER lengths. */
+	size_t length;															/**< Digest length. */
+};
+
+
+/**
+ * Report the rate at which signatures were verified.
+ *
+ * @param name Name of the operation being measured.
+ * @param start_time The time the operations started.
+ * @param end_time The time the operations completed.
+ */
+static void ecc_benchmark_report (const char *name, const platform_clock *start_time,
+	const platform_clock *end_time)
+{
+	uint32_t duration;
+
+	duration = platform_get_duration (start_time, end_time);
+	if (duration == 0) {
+		duration = 1;
+	}
+
+	printf ("%s: %d signatures in %u ms, %llu signatures/sec\n", name,
+		ECC_BENCHMARK_COUNT * ECC_BENCHMARK_ITERATIONS, duration,
+		((unsigned long long) ECC_BENCHMARK_COUNT * ECC_BENCHMARK_ITERATIONS * 1000) /
+			duration);
+}
+
+/**
+ * Generate a set of signatures to verify.
+ *
+ * @param test The testing framework.
+ * @param priv_der The private key to sign with.
+ * @param priv_length Length of the private key.
+ * @param digest_length Length of the digest to sign.
+ * @param sigs Output for the generated signatures.
+ */
+static void ecc_benchmark_generate_signatures (CuTest *test, const uint8_t *priv_der,
+	size_t priv_length, size_t digest_length, struct ecc_benchmark_signatures *sigs)
+{
+	struct ecc_engine_openssl engine;
+	struct ecc_private_key priv_key;
+	int status;
+	int i;
+
+	status = ecc_openssl_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.init_key_pair (&engine.base, priv_der, priv_length, &priv_key, NULL);
+	CuAssertIntEquals (test, 0, status);
+
+	sigs->length = digest_length;
+	for (i = 0; i < ECC_BENCHMARK_COUNT; i++) {
+		memset (sigs->digest[i], i, digest_length);
+		sigs->digest[i][0] = ~i;
+
+		status = engine.base.sign (&engine.base, &priv_key, sigs->digest[i], digest_length,
+			sigs->signature[i], sizeof (sigs->signature[i]));
+		CuAssertTrue (test, !ROT_IS_ERROR (status));
+
+		sigs->sig_length[i] = status;
+	}
+
+	engine.base.release_key_pair (&engine.base, &priv_key, NULL);
+	ecc_openssl_release (&engine);
+}
+
+/**
+ * Measure the rate of signature verification for an ECC engine, both one signature at a time and
+ * as a batch.
+ *
+ * @param test The testing framework.
+ * @param ecc The ECC engine to measure.
+ * @param name Name of the ECC engine to report with the results.
+ * @param pub_der The public key to verify the signatures with.
+ * @param pub_length Length of the public key.
+ * @param sigs The signatures to verify.
+ */
+static void ecc_benchmark_run_verify (CuTest *test, struct ecc_engine *ecc, const char *name,
+	const uint8_t *pub_der, size_t pub_length, const struct ecc_benchmark_signatures *sigs)
+{
+	struct ecc_public_key pub_key;
+	struct ecc_verify_batch_entry entries[ECC_BENCHMARK_COUNT];
+	platform_clock start_time;
+	platform_clock end_time;
+	char label[64];
+	int status;
+	int i;
+	int j;
+
+	status = ecc->init_public_key (ecc, pub_der, pub_length, &pub_key);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < ECC_BENCHMARK_COUNT; i++) {
+		entries[i].key = &pub_key;
+		entries[i].digest = sigs->digest[i];
+		entries[i].length = sigs->length;
+		entries[i].signature = sigs->signature[i];
+		entries[i].sig_length = sigs->sig_length[i];
+		entries[i].status = -1;
+	}
+
+	platform_init_current_tick (&start_time);
+
+	for (j = 0; (j < ECC_BENCHMARK_ITERATIONS) && (status == 0); j++) {
+		for (i = 0; (i < ECC_BENCHMARK_COUNT) && (status == 0); i++) {
+			status = ecc->verify (ecc, &pub_key, sigs->digest[i], sigs->length,
+				sigs->signature[i], sigs->sig_length[i]);
+		}
+	}
+
+	platform_init_current_tick (&end_time);
+	CuAssertIntEquals (test, 0, status);
+
+	snprintf (label, sizeof (label), "%s verify", name);
+	ecc_benchmark_report (label, &start_time, &end_time);
+
+	platform_init_current_tick (&start_time);
+
+	for (j = 0; (j < ECC_BENCHMARK_ITERATIONS) && (status == 0); j++) {
+		status = ecc_verify_batch (ecc, entries, ECC_BENCHMARK_COUNT);
+	}
+
+	platform_init_current_tick (&end_time);
+	CuAssertIntEquals (test, 0, status);
+
+	snprintf (label, sizeof (label), "%s verify_batch", name);
+	ecc_benchmark_report (label, &start_time, &end_time);
+
+	for (i = 0; i < ECC_BENCHMARK_COUNT; i++) {
+		CuAssertIntEquals (test, 0, entries[i].status);
+	}
+
+	ecc->release_key_pair (ecc, NULL, &pub_key);
+}
+
+/**
+ * Measure signature verification for each ECC engine available on the Linux platform.
+ *
+ * @param test The testing framework.
+ * @param curve Name of the curve being measured.
+ * @param priv_der The private key to sign with.
+ * @param priv_length Length of the private key.
+ * @param pub_der The public key to verify the signatures with.
+ * @param pub_length Length of the public key.
+ * @param digest_length Length of the digest to sign.
+ */
+static void ecc_benchmark_compare_engines (CuTest *test, const char *curve,
+	const uint8_t *priv_der, size_t priv_length, const uint8_t *pub_der, size_t pub_length,
+	size_t digest_length)
+{
+	struct ecc_engine_openssl openssl;
+	struct ecc_engine_mbedtls mbedtls;
+	struct ecc_benchmark_signatures sigs;
+	char name[32];
+	int status;
+
+	ecc_benchmark_generate_signatures (test, priv_der, priv_length, digest_length, &sigs);
+
+	status = ecc_openssl_init (&openssl);
+	CuAssertIntEquals (test, 0, status);
+
+	status = ecc_mbedtls_init (&mbedtls);
+	CuAssertIntEquals (test, 0, status);
+
+	snprintf (name, sizeof (name), "ecc_openssl %s", curve);
+	ecc_benchmark_run_verify (test, &openssl.base, name, pub_der, pub_length, &sigs);
+
+	snprintf (name, sizeof (name), "ecc_mbedtls %s", curve);
+	ecc_benchmark_run_verify (test, &mbedtls.base, name, pub_der, pub_length, &sigs);
+
+	ecc_openssl_release (&openssl);
+	ecc_mbedtls_release (&mbedtls);
+}
+
+
+/*******************
+ * Test cases
+ *******************/
+
+static void ecc_benchmark_test_verify_p256 (CuTest *test)
+{
+	TEST_START;
+
+	ecc_benchmark_compare_engines (test, "P-256", ECC_PRIVKEY_DER, ECC_PRIVKEY_DER_LEN,
+		ECC_PUBKEY_DER, ECC_PUBKEY_DER_LEN, SHA256_HASH_LENGTH);
+}
+
+#if ECC_MAX_KEY_LENGTH >= ECC_KEY_LENGTH_384
+static void ecc_benchmark_test_verify_p384 (CuTest *test)
+{
+	TEST_START;
+
+	ecc_benchmark_compare_engines (test, "P-384", ECC384_PRIVKEY_DER, ECC384_PRIVKEY_DER_LEN,
+		ECC384_PUBKEY_DER, ECC384_PUBKEY_DER_LEN, SHA384_HASH_LENGTH);
+}
+#endif
+
+#if ECC_MAX_KEY_LENGTH >= ECC_KEY_LENGTH_521
+static void ecc_benchmark_test_verify_p521 (CuTest *test)
+{
+	TEST_START;
+
+	ecc_benchmark_compare_engines (test, "P-521", ECC521_PRIVKEY_DER, ECC521_PRIVKEY_DER_LEN,
+		ECC521_PUBKEY_DER, ECC521_PUBKEY_DER_LEN, SHA512_HASH_LENGTH);
+}
+#endif
+
+
+TEST_SUITE_START (ecc_benchmark);
+
+TEST (ecc_benchmark_test_verify_p256);
+#if ECC_MAX_KEY_LENGTH >= ECC_KEY_LENGTH_384
+TEST (ecc_benchmark_test_verify_p384);
+#endif
+#if ECC_MAX_KEY_LENGTH >= ECC_KEY_LENGTH_521
+TEST (ecc_benchmark_test_verify_p521);
+#endif
+
+TEST_SUITE_END;
@@ -39,6 +39,7 @@ static void ecc_openssl_test_init (CuTest *test)
 	CuAssertPtrNotNull (test, engine.base.get_public_key_der);
 	CuAssertPtrNotNull (test, engine.base.sign);
 	CuAssertPtrNotNull (test, engine.base.verify);
+	CuAssertPtrNotNull (test, engine.base.verify_batch);
 	CuAssertPtrNotNull (test, engine.base.get_shared_secret_max_length);
 	CuAssertPtrNotNull (test, engine.base.compute_shared_secret);
 
@@ -1918,6 +1919,386 @@ static void ecc_openssl_test_verify_corrupt_signature (CuTest *test)
 	ecc_openssl_release (&engine);
 }
 
+static void ecc_openssl_test_verify_batch (CuTest *test)
+{
+	struct ecc_engine_openssl engine;
+	struct ecc_public_key pub_key;
+	struct ecc_verify_batch_entry entries[3];
+	uint8_t extra_sig[ECC_SIG_TEST_LEN + 16];
+	int status;
+
+	TEST_START;
+
+	memcpy (extra_sig, ECC_SIGNATURE_TEST, ECC_SIG_TEST_LEN);
+	memset (&extra_sig[ECC_SIG_TEST_LEN], 0x55, sizeof (extra_sig) - ECC_SIG_TEST_LEN);
+
+	status = ecc_openssl_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.init_public_key (&engine.base, ECC_PUBKEY_DER, ECC_PUBKEY_DER_LEN,
+		&pub_key);
+	CuAssertIntEquals (test, 0, status);
+
+	entries[0].key = &pub_key;
+	entries[0].digest = SIG_HASH_TEST;
+	entries[0].length = SIG_HASH_LEN;
+	entries[0].signature = ECC_SIGNATURE_TEST;
+	entries[0].sig_length = ECC_SIG_TEST_LEN;
+	entries[0].status = -1;
+
+	entries[1].key = &pub_key;
+	entries[1].digest = SIG_HASH_TEST;
+	entries[1].length = SIG_HASH_LEN;
+	entries[1].signature = extra_sig;
+	entries[1].sig_length = sizeof (extra_sig);
+	entries[1].status = -1;
+
+	entries[2].key = &pub_key;
+	entries[2].digest = SIG_HASH_TEST;
+	entries[2].length = SIG_HASH_LEN;
+	entries[2].signature = ECC_SIGNATURE_TEST;
+	entries[2].sig_length = ECC_SIG_TEST_LEN;
+	entries[2].status = -1;
+
+	status = engine.base.verify_batch (&engine.base, entries, 3);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, entries[0].status);
+	CuAssertIntEquals (test, 0, entries[1].status);
+	CuAssertIntEquals (test, 0, entries[2].status);
+
+	engine.base.release_key_pair (&engine.base, NULL, &pub_key);
+
+	ecc_openssl_release (&engine);
+}
+
+static void ecc_openssl_test_verify_batch_mixed_curves (CuTest *test)
+{
+	struct ecc_engine_openssl engine;
+	struct ecc_public_key pub_key;
+	struct ecc_public_key pub_key384;
+	struct ecc_public_key pub_key521;
+	struct ecc_verify_batch_entry entries[4];
+	int status;
+
+	TEST_START;
+
+	status = ecc_openssl_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.init_public_key (&engine.base, ECC_PUBKEY_DER, ECC_PUBKEY_DER_LEN,
+		&pub_key);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.init_public_key (&engine.base, ECC384_PUBKEY_DER, ECC384_PUBKEY_DER_LEN,
+		&pub_key384);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.init_public_key (&engine.base, ECC521_PUBKEY_DER, ECC521_PUBKEY_DER_LEN,
+		&pub_key521);
+	CuAssertIntEquals (test, 0, status);
+
+	entries[0].key = &pub_key;
+	entries[0].digest = SIG_HASH_TEST;
+	entries[0].length = SIG_HASH_LEN;
+	entries[0].signature = ECC_SIGNATURE_TEST;
+	entries[0].sig_length = ECC_SIG_TEST_LEN;
+	entries[0].status = -1;
+
+	entries[1].key = &pub_key384;
+	entries[1].digest = SHA384_TEST_HASH;
+	entries[1].length = SHA384_HASH_LENGTH;
+	entries[1].signature = ECC384_SIGNATURE_TEST;
+	entries[1].sig_length = ECC384_SIG_TEST_LEN;
+	entries[1].status = -1;
+
+	entries[2].key = &pub_key521;
+	entries[2].digest = SHA512_TEST_HASH;
+	entries[2].length = SHA512_HASH_LENGTH;
+	entries[2].signature = ECC521_SIGNATURE_TEST;
+	entries[2].sig_length = ECC521_SIG_TEST_LEN;
+	entries[2].status = -1;
+
+	entries[3].key = &pub_key;
+	entries[3].digest = SIG_HASH_TEST;
+	entries[3].length = SIG_HASH_LEN;
+	entries[3].signature = ECC_SIGNATURE_TEST;
+	entries[3].sig_length = ECC_SIG_TEST_LEN;
+	entries[3].status = -1;
+
+	status = engine.base.verify_batch (&engine.base, entries, 4);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, 0, entries[0].status);
+	CuAssertIntEquals (test, 0, entries[1].status);
+	CuAssertIntEquals (test, 0, entries[2].status);
+	CuAssertIntEquals (test, 0, entries[3].status);
+
+	engine.base.release_key_pair (&engine.base, NULL, &pub_key);
+	engine.base.release_key_pair (&engine.base, NULL, &pub_key384);
+	engine.base.release_key_pair (&engine.base, NULL, &pub_key521);
+
+	ecc_openssl_release (&engine);
+}
+
+static void ecc_openssl_test_verify_batch_large_batch (CuTest *test)
+{
+	struct ecc_engine_openssl engine;
+	struct ecc_private_key priv_key;
+	struct ecc_public_key pub_key;
+	struct ecc_verify_batch_entry entries[40];
+	uint8_t digests[40][SHA256_HASH_LENGTH];
+	uint8_t signatures[40][ECC_TESTING_ECC256_DSA_MAX_LENGTH];
+	size_t i;
+	int status;
+
+	TEST_START;
+
+	status = ecc_openssl_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.init_key_pair (&engine.base, ECC_PRIVKEY_DER, ECC_PRIVKEY_DER_LEN,
+		&priv_key, &pub_key);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 40; i++) {
+		memcpy (digests[i], SIG_HASH_TEST, SHA256_HASH_LENGTH);
+		digests[i][0] = i;
+
+		status = engine.base.sign (&engine.base, &priv_key, digests[i], SHA256_HASH_LENGTH,
+			signatures[i], sizeof (signatures[i]));
+		CuAssertTrue (test, !ROT_IS_ERROR (status));
+
+		entries[i].key = &pub_key;
+		entries[i].digest = digests[i];
+		entries[i].length = SHA256_HASH_LENGTH;
+		entries[i].signature = signatures[i];
+		entries[i].sig_length = status;
+		entries[i].status = -1;
+	}
+
+	status = engine.base.verify_batch (&engine.base, entries, 40);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 40; i++) {
+		CuAssertIntEquals (test, 0, entries[i].status);
+	}
+
+	/* Break a few signatures spread across multiple groups. */
+	digests[3][5] ^= 0x55;
+	digests[17][5] ^= 0x55;
+	digests[39][5] ^= 0x55;
+
+	status = engine.base.verify_batch (&engine.base, entries, 40);
+	CuAssertIntEquals (test, ECC_ENGINE_BAD_SIGNATURE, status);
+
+	for (i = 0; i < 40; i++) {
+		status = engine.base.verify (&engine.base, &pub_key, digests[i], SHA256_HASH_LENGTH,
+			signatures[i], entries[i].sig_length);
+		CuAssertIntEquals (test, status, entries[i].status);
+
+		if ((i == 3) || (i == 17) || (i == 39)) {
+			CuAssertIntEquals (test, ECC_ENGINE_BAD_SIGNATURE, entries[i].status);
+		}
+		else {
+			CuAssertIntEquals (test, 0, entries[i].status);
+		}
+	}
+
+	engine.base.release_key_pair (&engine.base, &priv_key, &pub_key);
+
+	ecc_openssl_release (&engine);
+}
+
+static void ecc_openssl_test_verify_batch_bad_signature (CuTest *test)
+{
+	struct ecc_engine_openssl engine;
+	struct ecc_public_key pub_key;
+	struct ecc_verify_batch_entry entries[4];
+	uint8_t bad_sig[ECC_SIG_TEST_LEN];
+	int status;
+
+	TEST_START;
+
+	memcpy (bad_sig, ECC_SIGNATURE_TEST, ECC_SIG_TEST_LEN);
+	bad_sig[0] ^= 0x55;
+
+	status = ecc_openssl_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.init_public_key (&engine.base, ECC_PUBKEY_DER, ECC_PUBKEY_DER_LEN,
+		&pub_key);
+	CuAssertIntEquals (test, 0, status);
+
+	entries[0].key = &pub_key;
+	entries[0].digest = SIG_HASH_TEST;
+	entries[0].length = SIG_HASH_LEN;
+	entries[0].signature = ECC_SIGNATURE_BAD;
+	entries[0].sig_length = ECC_SIG_BAD_LEN;
+	entries[0].status = -1;
+
+	entries[1].key = &pub_key;
+	entries[1].digest = SIG_HASH_TEST;
+	entries[1].length = SIG_HASH_LEN;
+	entries[1].signature = ECC_SIGNATURE_TEST;
+	entries[1].sig_length = ECC_SIG_TEST_LEN;
+	entries[1].status = -1;
+
+	entries[2].key = &pub_key;
+	entries[2].digest = SIG_HASH_TEST2;
+	entries[2].length = SIG_HASH_LEN;
+	entries[2].signature = ECC_SIGNATURE_TEST;
+	entries[2].sig_length = ECC_SIG_TEST_LEN;
+	entries[2].status = -1;
+
+	entries[3].key = &pub_key;
+	entries[3].digest = SIG_HASH_TEST;
+	entries[3].length = SIG_HASH_LEN;
+	entries[3].signature = bad_sig;
+	entries[3].sig_length = sizeof (bad_sig);
+	entries[3].status = -1;
+
+	status = engine.base.verify_batch (&engine.base, entries, 4);
+	CuAssertIntEquals (test, ECC_ENGINE_BAD_SIGNATURE, status);
+	CuAssertIntEquals (test, ECC_ENGINE_BAD_SIGNATURE, entries[0].status);
+	CuAssertIntEquals (test, 0, entries[1].status);
+	CuAssertIntEquals (test, ECC_ENGINE_BAD_SIGNATURE, entries[2].status);
+	CuAssertIntEquals (test, ECC_ENGINE_BAD_SIGNATURE, entries[3].status);
+
+	engine.base.release_key_pair (&engine.base, NULL, &pub_key);
+
+	ecc_openssl_release (&engine);
+}
+
+static void ecc_openssl_test_verify_batch_signature_out_of_range (CuTest *test)
+{
+	struct ecc_engine_openssl engine;
+	struct ecc_public_key pub_key;
+	struct ecc_verify_batch_entry entries[3];
+	/* r = 0, s = 1 */
+	const uint8_t zero_r[] = {
+		0x30,0x06,0x02,0x01,0x00,0x02,0x01,0x01
+	};
+	/* r = 1, s = n */
+	const uint8_t order_s[] = {
+		0x30,0x26,0x02,0x01,0x01,0x02,0x21,0x00,
+		0xff,0xff,0xff,0xff,0x00,0x00,0x00,0x00,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,
+		0xbc,0xe6,0xfa,0xad,0xa7,0x17,0x9e,0x84,0xf3,0xb9,0xca,0xc2,0xfc,0x63,0x25,0x51
+	};
+	int status;
+
+	TEST_START;
+
+	status = ecc_openssl_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.init_public_key (&engine.base, ECC_PUBKEY_DER, ECC_PUBKEY_DER_LEN,
+		&pub_key);
+	CuAssertIntEquals (test, 0, status);
+
+	entries[0].key = &pub_key;
+	entries[0].digest = SIG_HASH_TEST;
+	entries[0].length = SIG_HASH_LEN;
+	entries[0].signature = zero_r;
+	entries[0].sig_length = sizeof (zero_r);
+	entries[0].status = -1;
+
+	entries[1].key = &pub_key;
+	entries[1].digest = SIG_HASH_TEST;
+	entries[1].length = SIG_HASH_LEN;
+	entries[1].signature = order_s;
+	entries[1].sig_length = sizeof (order_s);
+	entries[1].status = -1;
+
+	entries[2].key = &pub_key;
+	entries[2].digest = SIG_HASH_TEST;
+	entries[2].length = SIG_HASH_LEN;
+	entries[2].signature = ECC_SIGNATURE_TEST;
+	entries[2].sig_length = ECC_SIG_TEST_LEN;
+	entries[2].status = -1;
+
+	status = engine.base.verify_batch (&engine.base, entries, 3);
+	CuAssertIntEquals (test, ECC_ENGINE_BAD_SIGNATURE, status);
+	CuAssertIntEquals (test, ECC_ENGINE_BAD_SIGNATURE, entries[0].status);
+	CuAssertIntEquals (test, ECC_ENGINE_BAD_SIGNATURE, entries[1].status);
+	CuAssertIntEquals (test, 0, entries[2].status);
+
+	engine.base.release_key_pair (&engine.base, NULL, &pub_key);
+
+	ecc_openssl_release (&engine);
+}
+
+static void ecc_openssl_test_verify_batch_no_entries (CuTest *test)
+{
+	struct ecc_engine_openssl engine;
+	struct ecc_verify_batch_entry entries[1];
+	int status;
+
+	TEST_START;
+
+	status = ecc_openssl_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.verify_batch (&engine.base, entries, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.verify_batch (&engine.base, NULL, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	ecc_openssl_release (&engine);
+}
+
+static void ecc_openssl_test_verify_batch_null (CuTest *test)
+{
+	struct ecc_engine_openssl engine;
+	struct ecc_public_key pub_key;
+	struct ecc_verify_batch_entry entries[7];
+	size_t i;
+	int status;
+
+	TEST_START;
+
+	status = ecc_openssl_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.init_public_key (&engine.base, ECC_PUBKEY_DER, ECC_PUBKEY_DER_LEN,
+		&pub_key);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 7; i++) {
+		entries[i].key = &pub_key;
+		entries[i].digest = SIG_HASH_TEST;
+		entries[i].length = SIG_HASH_LEN;
+		entries[i].signature = ECC_SIGNATURE_TEST;
+		entries[i].sig_length = ECC_SIG_TEST_LEN;
+		entries[i].status = -1;
+	}
+
+	status = engine.base.verify_batch (NULL, entries, 7);
+	CuAssertIntEquals (test, ECC_ENGINE_INVALID_ARGUMENT, status);
+
+	status = engine.base.verify_batch (&engine.base, NULL, 7);
+	CuAssertIntEquals (test, ECC_ENGINE_INVALID_ARGUMENT, status);
+
+	entries[0].key = NULL;
+	entries[1].digest = NULL;
+	entries[2].length = 0;
+	entries[4].signature = NULL;
+	entries[5].sig_length = 0;
+
+	status = engine.base.verify_batch (&engine.base, entries, 7);
+	CuAssertIntEquals (test, ECC_ENGINE_INVALID_ARGUMENT, status);
+	CuAssertIntEquals (test, ECC_ENGINE_INVALID_ARGUMENT, entries[0].status);
+	CuAssertIntEquals (test, ECC_ENGINE_INVALID_ARGUMENT, entries[1].status);
+	CuAssertIntEquals (test, ECC_ENGINE_INVALID_ARGUMENT, entries[2].status);
+	CuAssertIntEquals (test, 0, entries[3].status);
+	CuAssertIntEquals (test, ECC_ENGINE_INVALID_ARGUMENT, entries[4].status);
+	CuAssertIntEquals (test, ECC_ENGINE_INVALID_ARGUMENT, entries[5].status);
+	CuAssertIntEquals (test, 0, entries[6].status);
+
+	engine.base.release_key_pair (&engine.base, NULL, &pub_key);
+
+	ecc_openssl_release (&engine);
+}
+
 static void ecc_openssl_test_get_signature_max_length (CuTest *test)
 {
 	struct ecc_engine_openssl engine;
@@ -3047,6 +3428,13 @@ TEST (ecc_openssl_test_sign_small_buffer);
 TEST (ecc_openssl_test_sign_unknown_hash);
 TEST (ecc_openssl_test_verify_null);
 TEST (ecc_openssl_test_verify_corrupt_signature);
+TEST (ecc_openssl_test_verify_batch);
+TEST (ecc_openssl_test_verify_batch_mixed_curves);
+TEST (ecc_openssl_test_verify_batch_large_batch);
+TEST (ecc_openssl_test_verify_batch_bad_signature);
+TEST (ecc_openssl_test_verify_batch_signature_out_of_range);
+TEST (ecc_openssl_test_verify_batch_no_entries);
+TEST (ecc_openssl_test_verify_batch_null);
 TEST (ecc_openssl_test_get_signature_max_length);
 #if ECC_MAX_KEY_LENGTH >= ECC_KEY_LENGTH_384
 TEST (ecc_openssl_test_get_signature_max_length_p384);
@@ -0,0 +1,298 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "platform_api.h"
+#include "testing.h"
+#include "crypto/hash.h"
+#include "crypto/hash_mbedtls.h"
+#include "crypto/hash_native.h"
+#include "crypto/hash_openssl.h"
+
+
+TEST_SUITE_LABEL ("hash_benchmark");
+
+
+/**
+ * The amount of data hashed for each operation.  This is sized to be similar to a flash region
+ * being measured.
+ */
+#define	HASH_BENCHMARK_DATA_LENGTH		(64 * 1024)
+
+/**
+ * The number of hash operations executed for each measurement.
+ */
+#define	HASH_BENCHMARK_ITERATIONS		256
+
+/**
+ * The number of independent buffers hashed for each multi-buffer operation.
+ */
+#define	HASH_BENCHMARK_MULTI_BUFFERS	16
+
+
+/**
+ * Hash a buffer repeatedly and report the throughput.
+ *
+ * @param test The testing framework.
+ * @param hash The hash engine to measure.
+ * @param type The hash algorithm to use.
+ * @param name Name of the hash engine to report with the results.
+ * @param data The data to hash.
+ * @param digest Output for the calculated digest.
+ */
+static void hash_benchmark_run (CuTest *test, struct hash_engine *hash, enum hash_type type,
+	const char *name, const uint8_t *data, uint8_t *digest)
+{
+	platform_clock start_time;
+	platform_clock end_time;
+	uint32_t duration;
+	int status = 0;
+	int i;
+
+	platform_init_current_tick (&start_time);
+
+	for (i = 0; (i < HASH_BENCHMARK_ITERATIONS) && !ROT_IS_ERROR (status); i++) {
+		status = hash_calculate (hash, type, data, HASH_BENCHMARK_DATA_LENGTH, digest,
+			HASH_MAX_HASH_LEN);
+	}
+
+	platform_init_current_tick (&end_time);
+	CuAssertIntEquals (test, hash_get_hash_length (type), status);
+
+	duration = platform_get_duration (&start_time, &end_time);
+	if (duration == 0) {
+		duration = 1;
+	}
+
+	printf ("%s SHA-%d: %d bytes in %u ms, %llu KB/sec\n", name,
+		(type == HASH_TYPE_SHA1) ? 1 : (hash_get_hash_length (type) * 8),
+		HASH_BENCHMARK_DATA_LENGTH * HASH_BENCHMARK_ITERATIONS, duration,
+		((unsigned long long) HASH_BENCHMARK_DATA_LENGTH * HASH_BENCHMARK_ITERATIONS) / duration);
+}
+
+/**
+ * Measure the throughput of each hash engine available on the Linux platform for a single hash
+ * algorithm.  All engines must generate the same digest.
+ *
+ * @param test The testing framework.
+ * @param type The hash algorithm to measure.
+ */
+static void hash_benchmark_compare_engines (CuTest *test, enum hash_type type)
+{
+	struct hash_engine_openssl openssl;
+	struct hash_engine_mbedtls mbedtls;
+	struct hash_engine_native portable;
+	struct hash_engine_native native;
+	uint8_t *data;
+	uint8_t expected[HASH_MAX_HASH_LEN];
+	uint8_t digest[HASH_MAX_HASH_LEN];
+	size_t i;
+	int status;
+
+	data = malloc (HASH_BENCHMARK_DATA_LENGTH);
+	CuAssertPtrNotNull (test, data);
+
+	for (i = 0; i < HASH_BENCHMARK_DATA_LENGTH; i++) {
+		data[i] = i;
+	}
+
+	status = hash_openssl_init (&openssl);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mbedtls_init (&mbedtls);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_native_init_with_features (&portable, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_native_init (&native);
+	CuAssertIntEquals (test, 0, status);
+
+	hash_benchmark_run (test, &openssl.base, type, "hash_openssl", data, expected);
+
+	hash_benchmark_run (test, &mbedtls.base, type, "hash_mbedtls", data, digest);
+	status = testing_validate_array (expected, digest, hash_get_hash_length (type));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_benchmark_run (test, &portable.base, type, "hash_native (portable)", data, digest);
+	status = testing_validate_array (expected, digest, hash_get_hash_length (type));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_benchmark_run (test, &native.base, type, "hash_native", data, digest);
+	status = testing_validate_array (expected, digest, hash_get_hash_length (type));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_openssl_release (&openssl);
+	hash_mbedtls_release (&mbedtls);
+	hash_native_release (&portable);
+	hash_native_release (&native);
+	free (data);
+}
+
+
+/**
+ * Hash a set of independent buffers repeatedly using multi-buffer SHA-256 and report the
+ * throughput.  Engines that do not support multi-buffer hashing will hash each buffer in turn.
+ *
+ * @param test The testing framework.
+ * @param hash The hash engine to measure.
+ * @param name Name of the hash engine to report with the results.
+ * @param buffers The buffers to hash.  The data is split evenly between the buffers.
+ */
+static void hash_benchmark_run_multi (CuTest *test, struct hash_engine *hash, const char *name,
+	const struct hash_multi_buffer *buffers)
+{
+	platform_clock start_time;
+	platform_clock end_time;
+	uint32_t duration;
+	int status = 0;
+	int i;
+
+	platform_init_current_tick (&start_time);
+
+	for (i = 0; (i < HASH_BENCHMARK_ITERATIONS) && (status == 0); i++) {
+		status = hash_calculate_sha256_multi (hash, buffers, HASH_BENCHMARK_MULTI_BUFFERS);
+	}
+
+	platform_init_current_tick (&end_time);
+	CuAssertIntEquals (test, 0, status);
+
+	duration = platform_get_duration (&start_time, &end_time);
+	if (duration == 0) {
+		duration = 1;
+	}
+
+	printf ("%s SHA-256 x%d: %d bytes in %u ms, %llu KB/sec\n", name,
+		HASH_BENCHMARK_MULTI_BUFFERS, HASH_BENCHMARK_DATA_LENGTH * HASH_BENCHMARK_ITERATIONS,
+		duration,
+		((unsigned long long) HASH_BENCHMARK_DATA_LENGTH * HASH_BENCHMARK_ITERATIONS) / duration);
+}
+
+/*******************
+ * Test cases
+ *******************/
+
+#ifdef HASH_ENABLE_SHA1
+static void hash_benchmark_test_sha1 (CuTest *test)
+{
+	TEST_START;
+
+	hash_benchmark_compare_engines (test, HASH_TYPE_SHA1);
+}
+#endif
+
+static void hash_benchmark_test_sha256 (CuTest *test)
+{
+	TEST_START;
+
+	hash_benchmark_compare_engines (test, HASH_TYPE_SHA256);
+}
+
+static void hash_benchmark_test_sha256_multi (CuTest *test)
+{
+	struct hash_engine_openssl openssl;
+	struct hash_engine_native portable;
+	struct hash_engine_native avx2;
+	struct hash_engine_native native;
+	struct hash_multi_buffer buffers[HASH_BENCHMARK_MULTI_BUFFERS];
+	uint8_t *data;
+	uint8_t expected[HASH_BENCHMARK_MULTI_BUFFERS][SHA256_HASH_LENGTH];
+	uint8_t digest[HASH_BENCHMARK_MULTI_BUFFERS][SHA256_HASH_LENGTH];
+	size_t length = HASH_BENCHMARK_DATA_LENGTH / HASH_BENCHMARK_MULTI_BUFFERS;
+	size_t i;
+	int status;
+
+	TEST_START;
+
+	data = malloc (HASH_BENCHMARK_DATA_LENGTH);
+	CuAssertPtrNotNull (test, data);
+
+	for (i = 0; i < HASH_BENCHMARK_DATA_LENGTH; i++) {
+		data[i] = i;
+	}
+
+	for (i = 0; i < HASH_BENCHMARK_MULTI_BUFFERS; i++) {
+		buffers[i].data = &data[i * length];
+		buffers[i].length = length;
+		buffers[i].hash = expected[i];
+		buffers[i].hash_length = sizeof (expected[i]);
+	}
+
+	status = hash_openssl_init (&openssl);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_native_init_with_features (&portable, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_native_init_with_features (&avx2, HASH_NATIVE_FEATURE_AVX2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_native_init (&native);
+	CuAssertIntEquals (test, 0, status);
+
+	hash_benchmark_run_multi (test, &openssl.base, "hash_openssl", buffers);
+
+	for (i = 0; i < HASH_BENCHMARK_MULTI_BUFFERS; i++) {
+		buffers[i].hash = digest[i];
+	}
+
+	hash_benchmark_run_multi (test, &portable.base, "hash_native (portable)", buffers);
+	status = testing_validate_array ((uint8_t*) expected, (uint8_t*) digest,
+		sizeof (expected));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_benchmark_run_multi (test, &avx2.base, "hash_native (AVX2)", buffers);
+	status = testing_validate_array ((uint8_t*) expected, (uint8_t*) digest,
+		sizeof (expected));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_benchmark_run_multi (test, &native.base, "hash_native", buffers);
+	status = testing_validate_array ((uint8_t*) expected, (uint8_t*) digest,
+		sizeof (expected));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_openssl_release (&openssl);
+	hash_native_release (&portable);
+	hash_native_release (&avx2);
+	hash_native_release (&native);
+	free (data);
+}
+
+#ifdef HASH_ENABLE_SHA384
+static void hash_benchmark_test_sha384 (CuTest *test)
+{
+	TEST_START;
+
+	hash_benchmark_compare_engines (test, HASH_TYPE_SHA384);
+}
+#endif
+
+#ifdef HASH_ENABLE_SHA512
+static void hash_benchmark_test_sha512 (CuTest *test)
+{
+	TEST_START;
+
+	hash_benchmark_compare_engines (test, HASH_TYPE_SHA512);
+}
+#endif
+
+
+TEST_SUITE_START (hash_benchmark);
+
+#ifdef HASH_ENABLE_SHA1
+TEST (hash_benchmark_test_sha1);
+#endif
+TEST (hash_benchmark_test_sha256);
+TEST (hash_benchmark_test_sha256_multi);
+#ifdef HASH_ENABLE_SHA384
+TEST (hash_benchmark_test_sha384);
+#endif
+#ifdef HASH_ENABLE_SHA512
+TEST (hash_benchmark_test_sha512);
+#endif
+
+TEST_SUITE_END;
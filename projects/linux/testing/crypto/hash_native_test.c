@@ -0,0 +1,4495 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "testing.h"
+#include "common/array_size.h"
+#include "crypto/hash_native.h"
+#include "crypto/hash_openssl.h"
+#include "crypto/hash_thread_safe.h"
+#include "testing/crypto/hash_testing.h"
+
+
+TEST_SUITE_LABEL ("hash_native");
+
+
+/**
+ * Length of the data used to compare hash results against OpenSSL.  This covers multiple blocks for
+ * every hash algorithm.
+ */
+#define	HASH_NATIVE_TESTING_DATA_LENGTH		((SHA512_BLOCK_SIZE * 3) + 1)
+
+
+/**
+ * Fill a buffer with data to hash.
+ *
+ * @param data The buffer to fill.
+ * @param length The length of the buffer.
+ */
+static void hash_native_testing_fill_data (uint8_t *data, size_t length)
+{
+	size_t i;
+
+	for (i = 0; i < length; i++) {
+		data[i] = (i * 7) + 3;
+	}
+}
+
+/**
+ * Check that a native hash engine restricted to a set of CPU features generates the same results
+ * as OpenSSL for all supported hash algorithms.  Hashes are checked for every data length up to
+ * multiple blocks, both as a single calculation and with incremental updates of varying size.
+ *
+ * @param test The testing framework.
+ * @param features The CPU features the native engine is allowed to use.
+ */
+static void hash_native_testing_check_against_openssl (CuTest *test, uint32_t features)
+{
+	struct hash_engine_native engine;
+	struct hash_engine_openssl openssl;
+	const size_t updates[] = {1, 7, 63, 64, 65, 127, 128, 129};
+	enum hash_type type;
+	uint8_t data[HASH_NATIVE_TESTING_DATA_LENGTH];
+	uint8_t expected[HASH_MAX_HASH_LEN];
+	uint8_t actual[HASH_MAX_HASH_LEN];
+	size_t length;
+	size_t offset;
+	size_t chunk;
+	size_t i;
+	int hash_length;
+	int status;
+
+	hash_native_testing_fill_data (data, sizeof (data));
+
+	status = hash_native_init_with_features (&engine, features);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_openssl_init (&openssl);
+	CuAssertIntEquals (test, 0, status);
+
+	for (type = HASH_TYPE_SHA1; type <= HASH_TYPE_SHA512; type++) {
+		if (!hash_is_alg_supported (type)) {
+			continue;
+		}
+
+		hash_length = hash_get_hash_length (type);
+
+		for (length = 0; length <= sizeof (data); length++) {
+			status = hash_calculate (&openssl.base, type, data, length, expected,
+				sizeof (expected));
+			CuAssertIntEquals (test, hash_length, status);
+
+			status = hash_calculate (&engine.base, type, data, length, actual, sizeof (actual));
+			CuAssertIntEquals (test, hash_length, status);
+
+			status = testing_validate_array (expected, actual, hash_length);
+			CuAssertIntEquals (test, 0, status);
+		}
+
+		for (i = 0; i < ARRAY_SIZE (updates); i++) {
+			status = hash_start_new_hash (&engine.base, type);
+			CuAssertIntEquals (test, 0, status);
+
+			for (offset = 0; offset < sizeof (data); offset += chunk) {
+				chunk = updates[i];
+				if ((offset + chunk) > sizeof (data)) {
+					chunk = sizeof (data) - offset;
+				}
+
+				status = engine.base.update (&engine.base, &data[offset], chunk);
+				CuAssertIntEquals (test, 0, status);
+			}
+
+			status = engine.base.finish (&engine.base, actual, sizeof (actual));
+			CuAssertIntEquals (test, 0, status);
+
+			status = testing_validate_array (expected, actual, hash_length);
+			CuAssertIntEquals (test, 0, status);
+		}
+	}
+
+	hash_native_release (&engine);
+	hash_openssl_release (&openssl);
+}
+
+
+/**
+ * Check that multi-buffer SHA-256 hashing using a native hash engine generates the same results as
+ * OpenSSL.  Every number of buffers up to more than two sets of lanes is checked, with buffer
+ * lengths chosen so that the lanes complete at different times and require different padding.
+ *
+ * @param test The testing framework.
+ * @param features The CPU features the native engine is allowed to use.
+ */
+static void hash_native_testing_check_multi_against_openssl (CuTest *test, uint32_t features)
+{
+	struct hash_engine_native engine;
+	struct hash_engine_openssl openssl;
+	const size_t lengths[] = {
+		0, 55, 56, 63, 64, 65, 1, 384, 119, 120, 128, 200, 3, 250, 320, 17, 300, 129, 64, 56
+	};
+	struct hash_multi_buffer buffers[ARRAY_SIZE (lengths)];
+	uint8_t data[HASH_NATIVE_TESTING_DATA_LENGTH];
+	uint8_t expected[ARRAY_SIZE (lengths)][SHA256_HASH_LENGTH];
+	uint8_t actual[ARRAY_SIZE (lengths)][SHA256_HASH_LENGTH];
+	size_t count;
+	size_t i;
+	int status;
+
+	hash_native_testing_fill_data (data, sizeof (data));
+
+	status = hash_native_init_with_features (&engine, features);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_openssl_init (&openssl);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < ARRAY_SIZE (lengths); i++) {
+		buffers[i].data = &data[i];
+		buffers[i].length = lengths[i];
+		buffers[i].hash = actual[i];
+		buffers[i].hash_length = sizeof (actual[i]);
+
+		status = openssl.base.calculate_sha256 (&openssl.base, buffers[i].data, buffers[i].length,
+			expected[i], sizeof (expected[i]));
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	for (count = 0; count <= ARRAY_SIZE (lengths); count++) {
+		memset (actual, 0, sizeof (actual));
+
+		status = hash_calculate_sha256_multi (&engine.base, buffers, count);
+		CuAssertIntEquals (test, 0, status);
+
+		for (i = 0; i < count; i++) {
+			status = testing_validate_array (expected[i], actual[i], SHA256_HASH_LENGTH);
+			CuAssertIntEquals (test, 0, status);
+		}
+	}
+
+	hash_native_release (&engine);
+	hash_openssl_release (&openssl);
+}
+
+
+/*******************
+ * Test cases
+ *******************/
+
+static void hash_native_test_init (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+#ifdef HASH_ENABLE_SHA1
+	CuAssertPtrNotNull (test, engine.base.calculate_sha1);
+	CuAssertPtrNotNull (test, engine.base.start_sha1);
+#endif
+	CuAssertPtrNotNull (test, engine.base.calculate_sha256);
+	CuAssertPtrNotNull (test, engine.base.start_sha256);
+#ifdef HASH_ENABLE_SHA384
+	CuAssertPtrNotNull (test, engine.base.calculate_sha384);
+	CuAssertPtrNotNull (test, engine.base.start_sha384);
+#endif
+#ifdef HASH_ENABLE_SHA512
+	CuAssertPtrNotNull (test, engine.base.calculate_sha512);
+	CuAssertPtrNotNull (test, engine.base.start_sha512);
+#endif
+	CuAssertPtrNotNull (test, engine.base.update);
+	CuAssertPtrNotNull (test, engine.base.finish);
+	CuAssertPtrNotNull (test, engine.base.cancel);
+	CuAssertPtrNotNull (test, engine.base.save_state);
+	CuAssertPtrNotNull (test, engine.base.restore_state);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_init_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = hash_native_init (NULL);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+}
+
+static void hash_native_test_release_null (CuTest *test)
+{
+	TEST_START;
+
+	hash_native_release (NULL);
+}
+
+#ifdef HASH_ENABLE_SHA1
+static void hash_native_test_sha1_incremental (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA1_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha1 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA1_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha1_incremental_multi (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA1_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha1 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA1_TEST_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha1_incremental_full_hash_block (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA1_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha1 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, HASH_TESTING_FULL_BLOCK_512,
+		HASH_TESTING_FULL_BLOCK_512_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA1_FULL_BLOCK_512_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha1_incremental_update_to_full_hash_block (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA1_HASH_LENGTH];
+	int i;
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha1 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 4; i++) {
+		status = engine.base.update (&engine.base,
+			&HASH_TESTING_FULL_BLOCK_512[i * (HASH_TESTING_FULL_BLOCK_512_LEN / 4)],
+			HASH_TESTING_FULL_BLOCK_512_LEN / 4);
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA1_FULL_BLOCK_512_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha1_incremental_update_to_full_hash_block_after_full_block (
+	CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA1_HASH_LENGTH];
+	int i;
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha1 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, HASH_TESTING_FULL_BLOCK_1024, SHA1_BLOCK_SIZE);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 4; i++) {
+		status = engine.base.update (&engine.base,
+			&HASH_TESTING_FULL_BLOCK_1024[SHA1_BLOCK_SIZE + (i * (SHA1_BLOCK_SIZE / 4))],
+			SHA1_BLOCK_SIZE / 4);
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA1_FULL_BLOCK_1024_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha1_incremental_multiple_hash_blocks_single_update (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA1_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha1 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, HASH_TESTING_FULL_BLOCK_2048,
+		HASH_TESTING_FULL_BLOCK_2048_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA1_FULL_BLOCK_2048_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha1_incremental_multiple_hash_blocks_partial_update (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA1_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha1 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, HASH_TESTING_FULL_BLOCK_2048, 8);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, &HASH_TESTING_FULL_BLOCK_2048[8],
+		HASH_TESTING_FULL_BLOCK_2048_LEN - 8);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA1_FULL_BLOCK_2048_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha1_incremental_multiple_hash_blocks_not_aligned (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA1_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha1 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, HASH_TESTING_MULTI_BLOCK_NOT_ALIGNED,
+		HASH_TESTING_MULTI_BLOCK_NOT_ALIGNED_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA1_MULTI_BLOCK_NOT_ALIGNED_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha1_incremental_multiple_hash_blocks_not_aligned_partial_update (
+	CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA1_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha1 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, HASH_TESTING_MULTI_BLOCK_NOT_ALIGNED, 8);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, &HASH_TESTING_MULTI_BLOCK_NOT_ALIGNED[8],
+		HASH_TESTING_MULTI_BLOCK_NOT_ALIGNED_LEN - 8);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA1_MULTI_BLOCK_NOT_ALIGNED_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha1_incremental_partial_block_480_bits (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA1_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha1 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, HASH_TESTING_PARTIAL_BLOCK_480,
+		HASH_TESTING_PARTIAL_BLOCK_480_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA1_PARTIAL_BLOCK_480_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha1_incremental_partial_block_448_bits (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA1_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha1 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, HASH_TESTING_PARTIAL_BLOCK_448,
+		HASH_TESTING_PARTIAL_BLOCK_448_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA1_PARTIAL_BLOCK_448_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha1_incremental_partial_block_440_bits (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA1_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha1 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, HASH_TESTING_PARTIAL_BLOCK_440,
+		HASH_TESTING_PARTIAL_BLOCK_440_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA1_PARTIAL_BLOCK_440_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha1_incremental_empty_hash_buffer (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA1_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha1 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, NULL, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA1_EMPTY_BUFFER_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha1_incremental_after_finish (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA1_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha1 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA1_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha1 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA1_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha1_incremental_cancel (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA1_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha1 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	engine.base.cancel (&engine.base);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, HASH_ENGINE_NO_ACTIVE_HASH, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, HASH_ENGINE_NO_ACTIVE_HASH, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha1_incremental_after_cancel (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA1_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha1 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, HASH_TESTING_MULTI_BLOCK_NOT_ALIGNED,
+		HASH_TESTING_MULTI_BLOCK_NOT_ALIGNED_LEN);
+
+	engine.base.cancel (&engine.base);
+
+	/* Run a new hash to see that it is calculated correctly. */
+	status = engine.base.start_sha1 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, HASH_TESTING_MULTI_BLOCK_NOT_ALIGNED, 8);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, &HASH_TESTING_MULTI_BLOCK_NOT_ALIGNED[8],
+		HASH_TESTING_MULTI_BLOCK_NOT_ALIGNED_LEN - 8);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA1_MULTI_BLOCK_NOT_ALIGNED_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha1_start_incremental_null (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha1 (NULL);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha1_start_without_finish (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA1_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha1 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha1 (&engine.base);
+	CuAssertIntEquals (test, HASH_ENGINE_HASH_IN_PROGRESS, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA1_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha1_update_after_finish (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA1_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha1 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA1_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, HASH_ENGINE_NO_ACTIVE_HASH, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha1_finish_after_finish (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA1_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha1 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA1_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, HASH_ENGINE_NO_ACTIVE_HASH, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha1_finish_small_hash_buffer (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA1_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha1 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash) - 1);
+	CuAssertIntEquals (test, HASH_ENGINE_HASH_BUFFER_TOO_SMALL, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA1_TEST_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+#endif
+
+static void hash_native_test_sha256_incremental (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha256 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA256_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha256_incremental_multi (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha256 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA256_TEST_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha256_incremental_full_hash_block (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha256 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, HASH_TESTING_FULL_BLOCK_512,
+		HASH_TESTING_FULL_BLOCK_512_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA256_FULL_BLOCK_512_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha256_incremental_update_to_full_hash_block (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA256_HASH_LENGTH];
+	int i;
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha256 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 4; i++) {
+		status = engine.base.update (&engine.base,
+			&HASH_TESTING_FULL_BLOCK_512[i * (HASH_TESTING_FULL_BLOCK_512_LEN / 4)],
+			HASH_TESTING_FULL_BLOCK_512_LEN / 4);
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA256_FULL_BLOCK_512_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha256_incremental_update_to_full_hash_block_after_full_block (
+	CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA256_HASH_LENGTH];
+	int i;
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha256 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, HASH_TESTING_FULL_BLOCK_1024, SHA256_BLOCK_SIZE);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 4; i++) {
+		status = engine.base.update (&engine.base,
+			&HASH_TESTING_FULL_BLOCK_1024[SHA256_BLOCK_SIZE + (i * (SHA256_BLOCK_SIZE / 4))],
+			SHA256_BLOCK_SIZE / 4);
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA256_FULL_BLOCK_1024_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha256_incremental_multiple_hash_blocks_single_update (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha256 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, HASH_TESTING_FULL_BLOCK_2048,
+		HASH_TESTING_FULL_BLOCK_2048_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA256_FULL_BLOCK_2048_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha256_incremental_multiple_hash_blocks_partial_update (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha256 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, HASH_TESTING_FULL_BLOCK_2048, 8);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, &HASH_TESTING_FULL_BLOCK_2048[8],
+		HASH_TESTING_FULL_BLOCK_2048_LEN - 8);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA256_FULL_BLOCK_2048_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha256_incremental_multiple_hash_blocks_not_aligned (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha256 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, HASH_TESTING_MULTI_BLOCK_NOT_ALIGNED,
+		HASH_TESTING_MULTI_BLOCK_NOT_ALIGNED_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA256_MULTI_BLOCK_NOT_ALIGNED_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha256_incremental_multiple_hash_blocks_not_aligned_partial_update (
+	CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha256 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, HASH_TESTING_MULTI_BLOCK_NOT_ALIGNED, 8);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, &HASH_TESTING_MULTI_BLOCK_NOT_ALIGNED[8],
+		HASH_TESTING_MULTI_BLOCK_NOT_ALIGNED_LEN - 8);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA256_MULTI_BLOCK_NOT_ALIGNED_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha256_incremental_partial_block_480_bits (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha256 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, HASH_TESTING_PARTIAL_BLOCK_480,
+		HASH_TESTING_PARTIAL_BLOCK_480_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA256_PARTIAL_BLOCK_480_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha256_incremental_partial_block_448_bits (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha256 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, HASH_TESTING_PARTIAL_BLOCK_448,
+		HASH_TESTING_PARTIAL_BLOCK_448_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA256_PARTIAL_BLOCK_448_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha256_incremental_partial_block_440_bits (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha256 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, HASH_TESTING_PARTIAL_BLOCK_440,
+		HASH_TESTING_PARTIAL_BLOCK_440_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA256_PARTIAL_BLOCK_440_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha256_incremental_empty_hash_buffer (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha256 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, NULL, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA256_EMPTY_BUFFER_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha256_incremental_after_finish (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha256 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA256_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha256 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA256_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha256_incremental_cancel (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha256 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	engine.base.cancel (&engine.base);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, HASH_ENGINE_NO_ACTIVE_HASH, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, HASH_ENGINE_NO_ACTIVE_HASH, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha256_incremental_after_cancel (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha256 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, HASH_TESTING_MULTI_BLOCK_NOT_ALIGNED,
+		HASH_TESTING_MULTI_BLOCK_NOT_ALIGNED_LEN);
+
+	engine.base.cancel (&engine.base);
+
+	/* Run a new hash to see that it is calculated correctly. */
+	status = engine.base.start_sha256 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, HASH_TESTING_MULTI_BLOCK_NOT_ALIGNED, 8);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, &HASH_TESTING_MULTI_BLOCK_NOT_ALIGNED[8],
+		HASH_TESTING_MULTI_BLOCK_NOT_ALIGNED_LEN - 8);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA256_MULTI_BLOCK_NOT_ALIGNED_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha256_start_incremental_null (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha256 (NULL);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha256_start_without_finish (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha256 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha256 (&engine.base);
+	CuAssertIntEquals (test, HASH_ENGINE_HASH_IN_PROGRESS, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA256_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha256_update_after_finish (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha256 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA256_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, HASH_ENGINE_NO_ACTIVE_HASH, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha256_finish_after_finish (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha256 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA256_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, HASH_ENGINE_NO_ACTIVE_HASH, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha256_finish_small_hash_buffer (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha256 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash) - 1);
+	CuAssertIntEquals (test, HASH_ENGINE_HASH_BUFFER_TOO_SMALL, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA256_TEST_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+#ifdef HASH_ENABLE_SHA384
+static void hash_native_test_sha384_incremental (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA384_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha384 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA384_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha384_incremental_multi (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA384_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha384 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA384_TEST_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha384_incremental_full_hash_block (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA384_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha384 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, HASH_TESTING_FULL_BLOCK_1024,
+		HASH_TESTING_FULL_BLOCK_1024_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA384_FULL_BLOCK_1024_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha384_incremental_update_to_full_hash_block (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA384_HASH_LENGTH];
+	int i;
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha384 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 4; i++) {
+		status = engine.base.update (&engine.base,
+			&HASH_TESTING_FULL_BLOCK_1024[i * (HASH_TESTING_FULL_BLOCK_1024_LEN / 4)],
+			HASH_TESTING_FULL_BLOCK_1024_LEN / 4);
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA384_FULL_BLOCK_1024_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha384_incremental_update_to_full_hash_block_after_full_block (
+	CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA384_HASH_LENGTH];
+	int i;
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha384 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, HASH_TESTING_FULL_BLOCK_2048, SHA384_BLOCK_SIZE);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 4; i++) {
+		status = engine.base.update (&engine.base,
+			&HASH_TESTING_FULL_BLOCK_2048[SHA384_BLOCK_SIZE + (i * (SHA384_BLOCK_SIZE / 4))],
+			SHA384_BLOCK_SIZE / 4);
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA384_FULL_BLOCK_2048_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha384_incremental_multiple_hash_blocks_single_update (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA384_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha384 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, HASH_TESTING_FULL_BLOCK_4096,
+		HASH_TESTING_FULL_BLOCK_4096_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA384_FULL_BLOCK_4096_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha384_incremental_multiple_hash_blocks_partial_update (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA384_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha384 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, HASH_TESTING_FULL_BLOCK_4096, 16);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, &HASH_TESTING_FULL_BLOCK_4096[16],
+		HASH_TESTING_FULL_BLOCK_4096_LEN - 16);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA384_FULL_BLOCK_4096_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha384_incremental_multiple_hash_blocks_not_aligned (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA384_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha384 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, HASH_TESTING_MULTI_BLOCK_NOT_ALIGNED,
+		HASH_TESTING_MULTI_BLOCK_NOT_ALIGNED_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA384_MULTI_BLOCK_NOT_ALIGNED_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha384_incremental_multiple_hash_blocks_not_aligned_partial_update (
+	CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA384_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha384 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, HASH_TESTING_MULTI_BLOCK_NOT_ALIGNED, 16);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, &HASH_TESTING_MULTI_BLOCK_NOT_ALIGNED[16],
+		HASH_TESTING_MULTI_BLOCK_NOT_ALIGNED_LEN - 16);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA384_MULTI_BLOCK_NOT_ALIGNED_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha384_incremental_partial_block_992_bits (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA384_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha384 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, HASH_TESTING_PARTIAL_BLOCK_992,
+		HASH_TESTING_PARTIAL_BLOCK_992_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA384_PARTIAL_BLOCK_992_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha384_incremental_partial_block_960_bits (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA384_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha384 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, HASH_TESTING_PARTIAL_BLOCK_960,
+		HASH_TESTING_PARTIAL_BLOCK_960_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA384_PARTIAL_BLOCK_960_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha384_incremental_partial_block_952_bits (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA384_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha384 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, HASH_TESTING_PARTIAL_BLOCK_952,
+		HASH_TESTING_PARTIAL_BLOCK_952_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA384_PARTIAL_BLOCK_952_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha384_incremental_empty_hash_buffer (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA384_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha384 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, NULL, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA384_EMPTY_BUFFER_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha384_incremental_after_finish (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA384_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha384 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA384_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha384 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA384_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha384_incremental_cancel (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA384_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha384 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	engine.base.cancel (&engine.base);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, HASH_ENGINE_NO_ACTIVE_HASH, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, HASH_ENGINE_NO_ACTIVE_HASH, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha384_incremental_after_cancel (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA384_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha384 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, HASH_TESTING_MULTI_BLOCK_NOT_ALIGNED,
+		HASH_TESTING_MULTI_BLOCK_NOT_ALIGNED_LEN);
+
+	engine.base.cancel (&engine.base);
+
+	/* Run a new hash to see that it is calculated correctly. */
+	status = engine.base.start_sha384 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, HASH_TESTING_MULTI_BLOCK_NOT_ALIGNED, 8);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, &HASH_TESTING_MULTI_BLOCK_NOT_ALIGNED[8],
+		HASH_TESTING_MULTI_BLOCK_NOT_ALIGNED_LEN - 8);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA384_MULTI_BLOCK_NOT_ALIGNED_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha384_start_incremental_null (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha384 (NULL);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha384_start_without_finish (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA384_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha384 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha384 (&engine.base);
+	CuAssertIntEquals (test, HASH_ENGINE_HASH_IN_PROGRESS, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA384_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha384_update_after_finish (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA384_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha384 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA384_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, HASH_ENGINE_NO_ACTIVE_HASH, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha384_finish_after_finish (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA384_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha384 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA384_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, HASH_ENGINE_NO_ACTIVE_HASH, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha384_finish_small_hash_buffer (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA384_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha384 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash) - 1);
+	CuAssertIntEquals (test, HASH_ENGINE_HASH_BUFFER_TOO_SMALL, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA384_TEST_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+#endif
+
+#ifdef HASH_ENABLE_SHA512
+static void hash_native_test_sha512_incremental (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA512_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha512 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA512_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha512_incremental_multi (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA512_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha512 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA512_TEST_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha512_incremental_full_hash_block (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA512_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha512 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, HASH_TESTING_FULL_BLOCK_1024,
+		HASH_TESTING_FULL_BLOCK_1024_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA512_FULL_BLOCK_1024_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha512_incremental_update_to_full_hash_block (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA512_HASH_LENGTH];
+	int i;
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha512 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 4; i++) {
+		status = engine.base.update (&engine.base,
+			&HASH_TESTING_FULL_BLOCK_1024[i * (HASH_TESTING_FULL_BLOCK_1024_LEN / 4)],
+			HASH_TESTING_FULL_BLOCK_1024_LEN / 4);
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA512_FULL_BLOCK_1024_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha512_incremental_update_to_full_hash_block_after_full_block (
+	CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA512_HASH_LENGTH];
+	int i;
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha512 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, HASH_TESTING_FULL_BLOCK_2048, SHA512_BLOCK_SIZE);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < 4; i++) {
+		status = engine.base.update (&engine.base,
+			&HASH_TESTING_FULL_BLOCK_2048[SHA512_BLOCK_SIZE + (i * (SHA512_BLOCK_SIZE / 4))],
+			SHA512_BLOCK_SIZE / 4);
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA512_FULL_BLOCK_2048_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha512_incremental_multiple_hash_blocks_single_update (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA512_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha512 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, HASH_TESTING_FULL_BLOCK_4096,
+		HASH_TESTING_FULL_BLOCK_4096_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA512_FULL_BLOCK_4096_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha512_incremental_multiple_hash_blocks_partial_update (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA512_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha512 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, HASH_TESTING_FULL_BLOCK_4096, 16);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, &HASH_TESTING_FULL_BLOCK_4096[16],
+		HASH_TESTING_FULL_BLOCK_4096_LEN - 16);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA512_FULL_BLOCK_4096_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha512_incremental_multiple_hash_blocks_not_aligned (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA512_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha512 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, HASH_TESTING_MULTI_BLOCK_NOT_ALIGNED,
+		HASH_TESTING_MULTI_BLOCK_NOT_ALIGNED_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA512_MULTI_BLOCK_NOT_ALIGNED_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha512_incremental_multiple_hash_blocks_not_aligned_partial_update (
+	CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA512_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha512 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, HASH_TESTING_MULTI_BLOCK_NOT_ALIGNED, 16);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, &HASH_TESTING_MULTI_BLOCK_NOT_ALIGNED[16],
+		HASH_TESTING_MULTI_BLOCK_NOT_ALIGNED_LEN - 16);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA512_MULTI_BLOCK_NOT_ALIGNED_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha512_incremental_partial_block_992_bits (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA512_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha512 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, HASH_TESTING_PARTIAL_BLOCK_992,
+		HASH_TESTING_PARTIAL_BLOCK_992_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA512_PARTIAL_BLOCK_992_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha512_incremental_partial_block_960_bits (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA512_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha512 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, HASH_TESTING_PARTIAL_BLOCK_960,
+		HASH_TESTING_PARTIAL_BLOCK_960_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA512_PARTIAL_BLOCK_960_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha512_incremental_partial_block_952_bits (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA512_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha512 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, HASH_TESTING_PARTIAL_BLOCK_952,
+		HASH_TESTING_PARTIAL_BLOCK_952_LEN);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA512_PARTIAL_BLOCK_952_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha512_incremental_empty_hash_buffer (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA512_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha512 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, NULL, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA512_EMPTY_BUFFER_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha512_incremental_after_finish (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA512_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha512 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA512_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha512 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA512_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha512_incremental_cancel (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA512_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha512 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	engine.base.cancel (&engine.base);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, HASH_ENGINE_NO_ACTIVE_HASH, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, HASH_ENGINE_NO_ACTIVE_HASH, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha512_incremental_after_cancel (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA512_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha512 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, HASH_TESTING_MULTI_BLOCK_NOT_ALIGNED,
+		HASH_TESTING_MULTI_BLOCK_NOT_ALIGNED_LEN);
+
+	engine.base.cancel (&engine.base);
+
+	/* Run a new hash to see that it is calculated correctly. */
+	status = engine.base.start_sha512 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, HASH_TESTING_MULTI_BLOCK_NOT_ALIGNED, 8);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, &HASH_TESTING_MULTI_BLOCK_NOT_ALIGNED[8],
+		HASH_TESTING_MULTI_BLOCK_NOT_ALIGNED_LEN - 8);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA512_MULTI_BLOCK_NOT_ALIGNED_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha512_start_incremental_null (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha512 (NULL);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha512_start_without_finish (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA512_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha512 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha512 (&engine.base);
+	CuAssertIntEquals (test, HASH_ENGINE_HASH_IN_PROGRESS, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA512_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha512_update_after_finish (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA512_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha512 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA512_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, HASH_ENGINE_NO_ACTIVE_HASH, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha512_finish_after_finish (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA512_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha512 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA512_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, HASH_ENGINE_NO_ACTIVE_HASH, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_sha512_finish_small_hash_buffer (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA512_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha512 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash) - 1);
+	CuAssertIntEquals (test, HASH_ENGINE_HASH_BUFFER_TOO_SMALL, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA512_TEST_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+#endif
+
+static void hash_native_test_incremental_update_null (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	char *message = "Test";
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha256 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (NULL, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	status = engine.base.update (&engine.base, NULL, strlen (message));
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_incremental_update_no_start (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	char *message = "Test";
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, HASH_ENGINE_NO_ACTIVE_HASH, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_incremental_finish_null (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha256 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (NULL, hash, sizeof (hash));
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	status = engine.base.finish (&engine.base, NULL, sizeof (hash));
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_incremental_finish_no_start (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, HASH_ENGINE_NO_ACTIVE_HASH, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_incremental_cancel_null (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	engine.base.cancel (NULL);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_incremental_cancel_no_start (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	engine.base.cancel (&engine.base);
+
+	hash_native_release (&engine);
+}
+
+#ifdef HASH_ENABLE_SHA1
+static void hash_native_test_calculate_sha1 (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA1_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.calculate_sha1 (&engine.base, (uint8_t*) message, strlen (message), hash,
+		sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA1_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_calculate_sha1_full_hash_block (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA1_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.calculate_sha1 (&engine.base, HASH_TESTING_FULL_BLOCK_512,
+		HASH_TESTING_FULL_BLOCK_512_LEN, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA1_FULL_BLOCK_512_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_calculate_sha1_multiple_hash_blocks_not_aligned (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA1_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.calculate_sha1 (&engine.base, HASH_TESTING_MULTI_BLOCK_NOT_ALIGNED,
+		HASH_TESTING_MULTI_BLOCK_NOT_ALIGNED_LEN, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA1_MULTI_BLOCK_NOT_ALIGNED_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_calculate_sha1_empty_hash_buffer (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA1_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.calculate_sha1 (&engine.base, NULL, 0, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA1_EMPTY_BUFFER_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_calculate_sha1_null (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA1_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.calculate_sha1 (NULL, (uint8_t*) message, strlen (message), hash,
+		sizeof (hash));
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	status = engine.base.calculate_sha1 (&engine.base, NULL, strlen (message), hash,
+		sizeof (hash));
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	status = engine.base.calculate_sha1 (&engine.base, (uint8_t*) message, strlen (message), NULL,
+		sizeof (hash));
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_calculate_sha1_without_finish (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA1_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha1 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+
+	status = engine.base.calculate_sha1 (&engine.base, HASH_TESTING_FULL_BLOCK_2048,
+		HASH_TESTING_FULL_BLOCK_2048_LEN, hash, sizeof (hash));
+	CuAssertIntEquals (test, HASH_ENGINE_HASH_IN_PROGRESS, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA1_TEST_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_calculate_sha1_small_hash_buffer (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA1_HASH_LENGTH - 1];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.calculate_sha1 (&engine.base, (uint8_t*) message, strlen (message), hash,
+		sizeof (hash));
+	CuAssertIntEquals (test, HASH_ENGINE_HASH_BUFFER_TOO_SMALL, status);
+
+	hash_native_release (&engine);
+}
+#endif
+
+static void hash_native_test_calculate_sha256 (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.calculate_sha256 (&engine.base, (uint8_t*) message, strlen (message), hash,
+		sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA256_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_calculate_sha256_full_hash_block (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.calculate_sha256 (&engine.base, HASH_TESTING_FULL_BLOCK_512,
+		HASH_TESTING_FULL_BLOCK_512_LEN, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA256_FULL_BLOCK_512_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_calculate_sha256_multiple_hash_blocks_not_aligned (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.calculate_sha256 (&engine.base, HASH_TESTING_MULTI_BLOCK_NOT_ALIGNED,
+		HASH_TESTING_MULTI_BLOCK_NOT_ALIGNED_LEN, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA256_MULTI_BLOCK_NOT_ALIGNED_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_calculate_sha256_empty_hash_buffer (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.calculate_sha256 (&engine.base, NULL, 0, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA256_EMPTY_BUFFER_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_calculate_sha256_null (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.calculate_sha256 (NULL, (uint8_t*) message, strlen (message), hash,
+		sizeof (hash));
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	status = engine.base.calculate_sha256 (&engine.base, NULL, strlen (message), hash,
+		sizeof (hash));
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	status = engine.base.calculate_sha256 (&engine.base, (uint8_t*) message, strlen (message), NULL,
+		sizeof (hash));
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_calculate_sha256_without_finish (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha256 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+
+	status = engine.base.calculate_sha256 (&engine.base, HASH_TESTING_FULL_BLOCK_2048,
+		HASH_TESTING_FULL_BLOCK_2048_LEN, hash, sizeof (hash));
+	CuAssertIntEquals (test, HASH_ENGINE_HASH_IN_PROGRESS, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA256_TEST_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_calculate_sha256_small_hash_buffer (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA256_HASH_LENGTH - 1];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.calculate_sha256 (&engine.base, (uint8_t*) message, strlen (message), hash,
+		sizeof (hash));
+	CuAssertIntEquals (test, HASH_ENGINE_HASH_BUFFER_TOO_SMALL, status);
+
+	hash_native_release (&engine);
+}
+
+#ifdef HASH_ENABLE_SHA384
+static void hash_native_test_calculate_sha384 (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA384_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.calculate_sha384 (&engine.base, (uint8_t*) message, strlen (message), hash,
+		sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA384_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_calculate_sha384_full_hash_block (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA384_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.calculate_sha384 (&engine.base, HASH_TESTING_FULL_BLOCK_1024,
+		HASH_TESTING_FULL_BLOCK_1024_LEN, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA384_FULL_BLOCK_1024_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_calculate_sha384_multiple_hash_blocks_not_aligned (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA384_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.calculate_sha384 (&engine.base, HASH_TESTING_MULTI_BLOCK_NOT_ALIGNED,
+		HASH_TESTING_MULTI_BLOCK_NOT_ALIGNED_LEN, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA384_MULTI_BLOCK_NOT_ALIGNED_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_calculate_sha384_empty_hash_buffer (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA384_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.calculate_sha384 (&engine.base, NULL, 0, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA384_EMPTY_BUFFER_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_calculate_sha384_null (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA384_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.calculate_sha384 (NULL, (uint8_t*) message, strlen (message), hash,
+		sizeof (hash));
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	status = engine.base.calculate_sha384 (&engine.base, NULL, strlen (message), hash,
+		sizeof (hash));
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	status = engine.base.calculate_sha384 (&engine.base, (uint8_t*) message, strlen (message), NULL,
+		sizeof (hash));
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_calculate_sha384_without_finish (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA384_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha384 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+
+	status = engine.base.calculate_sha384 (&engine.base, HASH_TESTING_FULL_BLOCK_2048,
+		HASH_TESTING_FULL_BLOCK_2048_LEN, hash, sizeof (hash));
+	CuAssertIntEquals (test, HASH_ENGINE_HASH_IN_PROGRESS, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA384_TEST_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_calculate_sha384_small_hash_buffer (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA384_HASH_LENGTH - 1];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.calculate_sha384 (&engine.base, (uint8_t*) message, strlen (message), hash,
+		sizeof (hash));
+	CuAssertIntEquals (test, HASH_ENGINE_HASH_BUFFER_TOO_SMALL, status);
+
+	hash_native_release (&engine);
+}
+#endif
+
+#ifdef HASH_ENABLE_SHA512
+static void hash_native_test_calculate_sha512 (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA512_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.calculate_sha512 (&engine.base, (uint8_t*) message, strlen (message), hash,
+		sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA512_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_calculate_sha512_full_hash_block (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA512_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.calculate_sha512 (&engine.base, HASH_TESTING_FULL_BLOCK_1024,
+		HASH_TESTING_FULL_BLOCK_1024_LEN, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA512_FULL_BLOCK_1024_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_calculate_sha512_multiple_hash_blocks_not_aligned (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA512_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.calculate_sha512 (&engine.base, HASH_TESTING_MULTI_BLOCK_NOT_ALIGNED,
+		HASH_TESTING_MULTI_BLOCK_NOT_ALIGNED_LEN, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA512_MULTI_BLOCK_NOT_ALIGNED_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_calculate_sha512_empty_hash_buffer (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	uint8_t hash[SHA512_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.calculate_sha512 (&engine.base, NULL, 0, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA512_EMPTY_BUFFER_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_calculate_sha512_null (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA512_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.calculate_sha512 (NULL, (uint8_t*) message, strlen (message), hash,
+		sizeof (hash));
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	status = engine.base.calculate_sha512 (&engine.base, NULL, strlen (message), hash,
+		sizeof (hash));
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	status = engine.base.calculate_sha512 (&engine.base, (uint8_t*) message, strlen (message), NULL,
+		sizeof (hash));
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_calculate_sha512_without_finish (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA512_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha512 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+
+	status = engine.base.calculate_sha512 (&engine.base, HASH_TESTING_FULL_BLOCK_2048,
+		HASH_TESTING_FULL_BLOCK_2048_LEN, hash, sizeof (hash));
+	CuAssertIntEquals (test, HASH_ENGINE_HASH_IN_PROGRESS, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA512_TEST_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_calculate_sha512_small_hash_buffer (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA512_HASH_LENGTH - 1];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.calculate_sha512 (&engine.base, (uint8_t*) message, strlen (message), hash,
+		sizeof (hash));
+	CuAssertIntEquals (test, HASH_ENGINE_HASH_BUFFER_TOO_SMALL, status);
+
+	hash_native_release (&engine);
+}
+#endif
+
+#ifdef HASH_ENABLE_SHA1
+static void hash_native_test_save_state_sha1 (CuTest *test)
+{
+	struct hash_engine_native engine;
+	struct hash_saved_state state;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA1_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha1 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.save_state (&engine.base, &state);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA1_TEST_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.restore_state (&engine.base, &state);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA1_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.restore_state (&engine.base, &state);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA1_TEST_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+#endif
+
+static void hash_native_test_save_state_sha256 (CuTest *test)
+{
+	struct hash_engine_native engine;
+	struct hash_saved_state state;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha256 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.save_state (&engine.base, &state);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA256_TEST_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.restore_state (&engine.base, &state);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA256_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.restore_state (&engine.base, &state);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA256_TEST_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+#ifdef HASH_ENABLE_SHA384
+static void hash_native_test_save_state_sha384 (CuTest *test)
+{
+	struct hash_engine_native engine;
+	struct hash_saved_state state;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA384_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha384 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.save_state (&engine.base, &state);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA384_TEST_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.restore_state (&engine.base, &state);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA384_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.restore_state (&engine.base, &state);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA384_TEST_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+#endif
+
+#ifdef HASH_ENABLE_SHA512
+static void hash_native_test_save_state_sha512 (CuTest *test)
+{
+	struct hash_engine_native engine;
+	struct hash_saved_state state;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA512_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha512 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.save_state (&engine.base, &state);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA512_TEST_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.restore_state (&engine.base, &state);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA512_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.restore_state (&engine.base, &state);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA512_TEST_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+#endif
+
+static void hash_native_test_save_state_cancel (CuTest *test)
+{
+	struct hash_engine_native engine;
+	struct hash_saved_state state;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha256 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.save_state (&engine.base, &state);
+	CuAssertIntEquals (test, 0, status);
+
+	engine.base.cancel (&engine.base);
+
+	status = engine.base.restore_state (&engine.base, &state);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA256_TEST_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_save_state_null (CuTest *test)
+{
+	struct hash_engine_native engine;
+	struct hash_saved_state state;
+	int status;
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha256 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.save_state (NULL, &state);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	status = engine.base.save_state (&engine.base, NULL);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_save_state_no_active_hash (CuTest *test)
+{
+	struct hash_engine_native engine;
+	struct hash_saved_state state;
+	int status;
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.save_state (&engine.base, &state);
+	CuAssertIntEquals (test, HASH_ENGINE_NO_ACTIVE_HASH, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_restore_state_null (CuTest *test)
+{
+	struct hash_engine_native engine;
+	struct hash_saved_state state;
+	int status;
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha256 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.save_state (&engine.base, &state);
+	CuAssertIntEquals (test, 0, status);
+
+	engine.base.cancel (&engine.base);
+
+	status = engine.base.restore_state (NULL, &state);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	status = engine.base.restore_state (&engine.base, NULL);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_restore_state_hash_in_progress (CuTest *test)
+{
+	struct hash_engine_native engine;
+	struct hash_saved_state state;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.start_sha256 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.save_state (&engine.base, &state);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.restore_state (&engine.base, &state);
+	CuAssertIntEquals (test, HASH_ENGINE_HASH_IN_PROGRESS, status);
+
+	status = engine.base.update (&engine.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.finish (&engine.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA256_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_restore_state_unknown (CuTest *test)
+{
+	struct hash_engine_native engine;
+	struct hash_saved_state state;
+	int status;
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	memset (&state, 0, sizeof (state));
+	state.active = HASH_ACTIVE_NONE;
+
+	status = engine.base.restore_state (&engine.base, &state);
+	CuAssertIntEquals (test, HASH_ENGINE_UNSUPPORTED_HASH, status);
+
+	status = engine.base.start_sha256 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_init_with_features (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+
+	TEST_START;
+
+	status = hash_native_init_with_features (&engine, 0);
+	CuAssertIntEquals (test, 0, status);
+
+#ifdef HASH_ENABLE_SHA1
+	CuAssertPtrNotNull (test, engine.base.calculate_sha1);
+	CuAssertPtrNotNull (test, engine.base.start_sha1);
+#endif
+	CuAssertPtrNotNull (test, engine.base.calculate_sha256);
+	CuAssertPtrNotNull (test, engine.base.start_sha256);
+#ifdef HASH_ENABLE_SHA384
+	CuAssertPtrNotNull (test, engine.base.calculate_sha384);
+	CuAssertPtrNotNull (test, engine.base.start_sha384);
+#endif
+#ifdef HASH_ENABLE_SHA512
+	CuAssertPtrNotNull (test, engine.base.calculate_sha512);
+	CuAssertPtrNotNull (test, engine.base.start_sha512);
+#endif
+	CuAssertPtrNotNull (test, engine.base.update);
+	CuAssertPtrNotNull (test, engine.base.finish);
+	CuAssertPtrNotNull (test, engine.base.cancel);
+	CuAssertPtrNotNull (test, engine.base.save_state);
+	CuAssertPtrNotNull (test, engine.base.restore_state);
+
+	CuAssertIntEquals (test, 0, engine.features);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_init_with_features_unavailable (CuTest *test)
+{
+	struct hash_engine_native engine;
+	uint32_t available;
+	int status;
+
+	TEST_START;
+
+	available = hash_native_get_cpu_features ();
+
+	/* Features that are not available on the processor are ignored. */
+	status = hash_native_init_with_features (&engine, 0xffffffff);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, available, engine.features);
+
+	hash_native_release (&engine);
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, available, engine.features);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_init_with_features_null (CuTest *test)
+{
+	int status;
+
+	TEST_START;
+
+	status = hash_native_init_with_features (NULL, 0);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+}
+
+static void hash_native_test_compare_openssl_portable (CuTest *test)
+{
+	TEST_START;
+
+	hash_native_testing_check_against_openssl (test, 0);
+}
+
+static void hash_native_test_compare_openssl_sha_ni (CuTest *test)
+{
+	TEST_START;
+
+	/* If the feature is not available, this will check the portable implementation. */
+	hash_native_testing_check_against_openssl (test, HASH_NATIVE_FEATURE_SHA_NI);
+}
+
+static void hash_native_test_compare_openssl_avx2 (CuTest *test)
+{
+	TEST_START;
+
+	/* If the feature is not available, this will check the portable implementation. */
+	hash_native_testing_check_against_openssl (test, HASH_NATIVE_FEATURE_AVX2);
+}
+
+static void hash_native_test_compare_openssl_all_features (CuTest *test)
+{
+	TEST_START;
+
+	hash_native_testing_check_against_openssl (test, hash_native_get_cpu_features ());
+}
+
+static void hash_native_test_restore_state_different_features (CuTest *test)
+{
+	struct hash_engine_native accel;
+	struct hash_engine_native portable;
+	struct hash_saved_state state;
+	uint8_t data[HASH_NATIVE_TESTING_DATA_LENGTH];
+	uint8_t expected[SHA256_HASH_LENGTH];
+	uint8_t hash[SHA256_HASH_LENGTH];
+	int status;
+
+	TEST_START;
+
+	hash_native_testing_fill_data (data, sizeof (data));
+
+	status = hash_native_init (&accel);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_native_init_with_features (&portable, 0);
+	CuAssertIntEquals (test, 0, status);
+
+	status = accel.base.calculate_sha256 (&accel.base, data, sizeof (data), expected,
+		sizeof (expected));
+	CuAssertIntEquals (test, 0, status);
+
+	status = accel.base.start_sha256 (&accel.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = accel.base.update (&accel.base, data, SHA256_BLOCK_SIZE + 5);
+	CuAssertIntEquals (test, 0, status);
+
+	status = accel.base.save_state (&accel.base, &state);
+	CuAssertIntEquals (test, 0, status);
+
+	accel.base.cancel (&accel.base);
+
+	status = portable.base.restore_state (&portable.base, &state);
+	CuAssertIntEquals (test, 0, status);
+
+	status = portable.base.update (&portable.base, &data[SHA256_BLOCK_SIZE + 5],
+		sizeof (data) - (SHA256_BLOCK_SIZE + 5));
+	CuAssertIntEquals (test, 0, status);
+
+	status = portable.base.finish (&portable.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (expected, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&accel);
+	hash_native_release (&portable);
+}
+
+static void hash_native_test_thread_safe (CuTest *test)
+{
+	struct hash_engine_native engine;
+	struct hash_engine_thread_safe thread_safe;
+	struct hash_saved_state state;
+	int status;
+	char *message = "Test";
+	uint8_t hash[SHA256_HASH_LENGTH];
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_thread_safe_init (&thread_safe, &engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertPtrNotNull (test, thread_safe.base.save_state);
+	CuAssertPtrNotNull (test, thread_safe.base.restore_state);
+
+	status = thread_safe.base.calculate_sha256 (&thread_safe.base, (uint8_t*) message,
+		strlen (message), hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA256_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = thread_safe.base.start_sha256 (&thread_safe.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = thread_safe.base.update (&thread_safe.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = thread_safe.base.save_state (&thread_safe.base, &state);
+	CuAssertIntEquals (test, 0, status);
+
+	status = thread_safe.base.update (&thread_safe.base, (uint8_t*) message, strlen (message));
+	CuAssertIntEquals (test, 0, status);
+
+	status = thread_safe.base.finish (&thread_safe.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA256_TEST_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = thread_safe.base.restore_state (&thread_safe.base, &state);
+	CuAssertIntEquals (test, 0, status);
+
+	status = thread_safe.base.finish (&thread_safe.base, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA256_TEST_HASH, hash, sizeof (hash));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_thread_safe_release (&thread_safe);
+	hash_native_release (&engine);
+}
+
+
+static void hash_native_test_calculate_sha256_multi (CuTest *test)
+{
+	struct hash_engine_native engine;
+	struct hash_multi_buffer buffers[2];
+	char *message = "Test";
+	uint8_t hash[2][SHA256_HASH_LENGTH];
+	int status;
+
+	TEST_START;
+
+	status = hash_native_init_with_features (&engine, HASH_NATIVE_FEATURE_AVX2);
+	CuAssertIntEquals (test, 0, status);
+
+	if (engine.features & HASH_NATIVE_FEATURE_AVX2) {
+		CuAssertPtrNotNull (test, engine.base.calculate_sha256_multi);
+		CuAssertIntEquals (test, true, hash_is_sha256_multi_supported (&engine.base));
+	}
+	else {
+		CuAssertPtrEquals (test, NULL, engine.base.calculate_sha256_multi);
+	}
+
+	buffers[0].data = (uint8_t*) message;
+	buffers[0].length = strlen (message);
+	buffers[0].hash = hash[0];
+	buffers[0].hash_length = sizeof (hash[0]);
+
+	buffers[1].data = NULL;
+	buffers[1].length = 0;
+	buffers[1].hash = hash[1];
+	buffers[1].hash_length = sizeof (hash[1]);
+
+	status = hash_calculate_sha256_multi (&engine.base, buffers, 2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA256_TEST_HASH, hash[0], sizeof (hash[0]));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA256_EMPTY_BUFFER_HASH, hash[1], sizeof (hash[1]));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_calculate_sha256_multi_sha_ni (CuTest *test)
+{
+	struct hash_engine_native engine;
+	int status;
+
+	TEST_START;
+
+	status = hash_native_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Multi-buffer hashing is only provided when it is faster than the single-buffer hash. */
+	if (engine.features & HASH_NATIVE_FEATURE_SHA_NI) {
+		CuAssertPtrEquals (test, NULL, engine.base.calculate_sha256_multi);
+	}
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_calculate_sha256_multi_compare_openssl_portable (CuTest *test)
+{
+	TEST_START;
+
+	hash_native_testing_check_multi_against_openssl (test, 0);
+}
+
+static void hash_native_test_calculate_sha256_multi_compare_openssl_avx2 (CuTest *test)
+{
+	TEST_START;
+
+	/* If the feature is not available, this will check the portable implementation. */
+	hash_native_testing_check_multi_against_openssl (test, HASH_NATIVE_FEATURE_AVX2);
+}
+
+static void hash_native_test_calculate_sha256_multi_compare_openssl_all_features (CuTest *test)
+{
+	TEST_START;
+
+	hash_native_testing_check_multi_against_openssl (test, hash_native_get_cpu_features ());
+}
+
+static void hash_native_test_calculate_sha256_multi_null (CuTest *test)
+{
+	struct hash_engine_native engine;
+	struct hash_multi_buffer buffers[2];
+	char *message = "Test";
+	uint8_t hash[2][SHA256_HASH_LENGTH];
+	int status;
+
+	TEST_START;
+
+	status = hash_native_init_with_features (&engine, HASH_NATIVE_FEATURE_AVX2);
+	CuAssertIntEquals (test, 0, status);
+
+	if (engine.base.calculate_sha256_multi == NULL) {
+		/* The CPU does not support multi-buffer hashing. */
+		hash_native_release (&engine);
+		return;
+	}
+
+	buffers[0].data = (uint8_t*) message;
+	buffers[0].length = strlen (message);
+	buffers[0].hash = hash[0];
+	buffers[0].hash_length = sizeof (hash[0]);
+
+	buffers[1].data = (uint8_t*) message;
+	buffers[1].length = strlen (message);
+	buffers[1].hash = hash[1];
+	buffers[1].hash_length = sizeof (hash[1]);
+
+	status = engine.base.calculate_sha256_multi (NULL, buffers, 2);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	status = engine.base.calculate_sha256_multi (&engine.base, NULL, 2);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	buffers[1].data = NULL;
+	status = engine.base.calculate_sha256_multi (&engine.base, buffers, 2);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	buffers[1].data = (uint8_t*) message;
+	buffers[1].hash = NULL;
+	status = engine.base.calculate_sha256_multi (&engine.base, buffers, 2);
+	CuAssertIntEquals (test, HASH_ENGINE_INVALID_ARGUMENT, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_calculate_sha256_multi_small_hash_buffer (CuTest *test)
+{
+	struct hash_engine_native engine;
+	struct hash_multi_buffer buffers[2];
+	char *message = "Test";
+	uint8_t hash[2][SHA256_HASH_LENGTH];
+	int status;
+
+	TEST_START;
+
+	status = hash_native_init_with_features (&engine, HASH_NATIVE_FEATURE_AVX2);
+	CuAssertIntEquals (test, 0, status);
+
+	if (engine.base.calculate_sha256_multi == NULL) {
+		/* The CPU does not support multi-buffer hashing. */
+		hash_native_release (&engine);
+		return;
+	}
+
+	buffers[0].data = (uint8_t*) message;
+	buffers[0].length = strlen (message);
+	buffers[0].hash = hash[0];
+	buffers[0].hash_length = sizeof (hash[0]);
+
+	buffers[1].data = (uint8_t*) message;
+	buffers[1].length = strlen (message);
+	buffers[1].hash = hash[1];
+	buffers[1].hash_length = sizeof (hash[1]) - 1;
+
+	status = engine.base.calculate_sha256_multi (&engine.base, buffers, 2);
+	CuAssertIntEquals (test, HASH_ENGINE_HASH_BUFFER_TOO_SMALL, status);
+
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_calculate_sha256_multi_hash_in_progress (CuTest *test)
+{
+	struct hash_engine_native engine;
+	struct hash_multi_buffer buffers[2];
+	char *message = "Test";
+	uint8_t hash[2][SHA256_HASH_LENGTH];
+	int status;
+
+	TEST_START;
+
+	status = hash_native_init_with_features (&engine, HASH_NATIVE_FEATURE_AVX2);
+	CuAssertIntEquals (test, 0, status);
+
+	if (engine.base.calculate_sha256_multi == NULL) {
+		/* The CPU does not support multi-buffer hashing. */
+		hash_native_release (&engine);
+		return;
+	}
+
+	buffers[0].data = (uint8_t*) message;
+	buffers[0].length = strlen (message);
+	buffers[0].hash = hash[0];
+	buffers[0].hash_length = sizeof (hash[0]);
+
+	buffers[1].data = (uint8_t*) message;
+	buffers[1].length = strlen (message);
+	buffers[1].hash = hash[1];
+	buffers[1].hash_length = sizeof (hash[1]);
+
+	status = engine.base.start_sha256 (&engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	status = engine.base.calculate_sha256_multi (&engine.base, buffers, 2);
+	CuAssertIntEquals (test, HASH_ENGINE_HASH_IN_PROGRESS, status);
+
+	engine.base.cancel (&engine.base);
+	hash_native_release (&engine);
+}
+
+static void hash_native_test_thread_safe_sha256_multi (CuTest *test)
+{
+	struct hash_engine_native engine;
+	struct hash_engine_thread_safe thread_safe;
+	struct hash_multi_buffer buffers[2];
+	char *message = "Test";
+	uint8_t hash[2][SHA256_HASH_LENGTH];
+	int status;
+
+	TEST_START;
+
+	status = hash_native_init_with_features (&engine, HASH_NATIVE_FEATURE_AVX2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_thread_safe_init (&thread_safe, &engine.base);
+	CuAssertIntEquals (test, 0, status);
+
+	CuAssertIntEquals (test, hash_is_sha256_multi_supported (&engine.base),
+		hash_is_sha256_multi_supported (&thread_safe.base));
+
+	buffers[0].data = (uint8_t*) message;
+	buffers[0].length = strlen (message);
+	buffers[0].hash = hash[0];
+	buffers[0].hash_length = sizeof (hash[0]);
+
+	buffers[1].data = (uint8_t*) message;
+	buffers[1].length = strlen (message);
+	buffers[1].hash = hash[1];
+	buffers[1].hash_length = sizeof (hash[1]);
+
+	status = hash_calculate_sha256_multi (&thread_safe.base, buffers, 2);
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA256_TEST_HASH, hash[0], sizeof (hash[0]));
+	CuAssertIntEquals (test, 0, status);
+
+	status = testing_validate_array (SHA256_TEST_HASH, hash[1], sizeof (hash[1]));
+	CuAssertIntEquals (test, 0, status);
+
+	/* The lock must have been released. */
+	status = thread_safe.base.calculate_sha256 (&thread_safe.base, (uint8_t*) message,
+		strlen (message), hash[0], sizeof (hash[0]));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_thread_safe_release (&thread_safe);
+	hash_native_release (&engine);
+}
+
+TEST_SUITE_START (hash_native);
+
+TEST (hash_native_test_init);
+TEST (hash_native_test_init_null);
+TEST (hash_native_test_init_with_features);
+TEST (hash_native_test_init_with_features_unavailable);
+TEST (hash_native_test_init_with_features_null);
+TEST (hash_native_test_release_null);
+#ifdef HASH_ENABLE_SHA1
+TEST (hash_native_test_sha1_incremental);
+TEST (hash_native_test_sha1_incremental_multi);
+TEST (hash_native_test_sha1_incremental_full_hash_block);
+TEST (hash_native_test_sha1_incremental_update_to_full_hash_block);
+TEST (hash_native_test_sha1_incremental_update_to_full_hash_block_after_full_block);
+TEST (hash_native_test_sha1_incremental_multiple_hash_blocks_single_update);
+TEST (hash_native_test_sha1_incremental_multiple_hash_blocks_partial_update);
+TEST (hash_native_test_sha1_incremental_multiple_hash_blocks_not_aligned);
+TEST (hash_native_test_sha1_incremental_multiple_hash_blocks_not_aligned_partial_update);
+TEST (hash_native_test_sha1_incremental_partial_block_480_bits);
+TEST (hash_native_test_sha1_incremental_partial_block_448_bits);
+TEST (hash_native_test_sha1_incremental_partial_block_440_bits);
+TEST (hash_native_test_sha1_incremental_empty_hash_buffer);
+TEST (hash_native_test_sha1_incremental_after_finish);
+TEST (hash_native_test_sha1_incremental_cancel);
+TEST (hash_native_test_sha1_incremental_after_cancel);
+TEST (hash_native_test_sha1_start_incremental_null);
+TEST (hash_native_test_sha1_start_without_finish);
+TEST (hash_native_test_sha1_update_after_finish);
+TEST (hash_native_test_sha1_finish_after_finish);
+TEST (hash_native_test_sha1_finish_small_hash_buffer);
+#endif
+TEST (hash_native_test_sha256_incremental);
+TEST (hash_native_test_sha256_incremental_multi);
+TEST (hash_native_test_sha256_incremental_full_hash_block);
+TEST (hash_native_test_sha256_incremental_update_to_full_hash_block);
+TEST (hash_native_test_sha256_incremental_update_to_full_hash_block_after_full_block);
+TEST (hash_native_test_sha256_incremental_multiple_hash_blocks_single_update);
+TEST (hash_native_test_sha256_incremental_multiple_hash_blocks_partial_update);
+TEST (hash_native_test_sha256_incremental_multiple_hash_blocks_not_aligned);
+TEST (hash_native_test_sha256_incremental_multiple_hash_blocks_not_aligned_partial_update);
+TEST (hash_native_test_sha256_incremental_partial_block_480_bits);
+TEST (hash_native_test_sha256_incremental_partial_block_448_bits);
+TEST (hash_native_test_sha256_incremental_partial_block_440_bits);
+TEST (hash_native_test_sha256_incremental_empty_hash_buffer);
+TEST (hash_native_test_sha256_incremental_after_finish);
+TEST (hash_native_test_sha256_incremental_cancel);
+TEST (hash_native_test_sha256_incremental_after_cancel);
+TEST (hash_native_test_sha256_start_incremental_null);
+TEST (hash_native_test_sha256_start_without_finish);
+TEST (hash_native_test_sha256_update_after_finish);
+TEST (hash_native_test_sha256_finish_after_finish);
+TEST (hash_native_test_sha256_finish_small_hash_buffer);
+#ifdef HASH_ENABLE_SHA384
+TEST (hash_native_test_sha384_incremental);
+TEST (hash_native_test_sha384_incremental_multi);
+TEST (hash_native_test_sha384_incremental_full_hash_block);
+TEST (hash_native_test_sha384_incremental_update_to_full_hash_block);
+TEST (hash_native_test_sha384_incremental_update_to_full_hash_block_after_full_block);
+TEST (hash_native_test_sha384_incremental_multiple_hash_blocks_single_update);
+TEST (hash_native_test_sha384_incremental_multiple_hash_blocks_partial_update);
+TEST (hash_native_test_sha384_incremental_multiple_hash_blocks_not_aligned);
+TEST (hash_native_test_sha384_incremental_multiple_hash_blocks_not_aligned_partial_update);
+TEST (hash_native_test_sha384_incremental_partial_block_992_bits);
+TEST (hash_native_test_sha384_incremental_partial_block_960_bits);
+TEST (hash_native_test_sha384_incremental_partial_block_952_bits);
+TEST (hash_native_test_sha384_incremental_empty_hash_buffer);
+TEST (hash_native_test_sha384_incremental_after_finish);
+TEST (hash_native_test_sha384_incremental_cancel);
+TEST (hash_native_test_sha384_incremental_after_cancel);
+TEST (hash_native_test_sha384_start_incremental_null);
+TEST (hash_native_test_sha384_start_without_finish);
+TEST (hash_native_test_sha384_update_after_finish);
+TEST (hash_native_test_sha384_finish_after_finish);
+TEST (hash_native_test_sha384_finish_small_hash_buffer);
+#endif
+#ifdef HASH_ENABLE_SHA512
+TEST (hash_native_test_sha512_incremental);
+TEST (hash_native_test_sha512_incremental_multi);
+TEST (hash_native_test_sha512_incremental_full_hash_block);
+TEST (hash_native_test_sha512_incremental_update_to_full_hash_block);
+TEST (hash_native_test_sha512_incremental_update_to_full_hash_block_after_full_block);
+TEST (hash_native_test_sha512_incremental_multiple_hash_blocks_single_update);
+TEST (hash_native_test_sha512_incremental_multiple_hash_blocks_partial_update);
+TEST (hash_native_test_sha512_incremental_multiple_hash_blocks_not_aligned);
+TEST (hash_native_test_sha512_incremental_multiple_hash_blocks_not_aligned_partial_update);
+TEST (hash_native_test_sha512_incremental_partial_block_992_bits);
+TEST (hash_native_test_sha512_incremental_partial_block_960_bits);
+TEST (hash_native_test_sha512_incremental_partial_block_952_bits);
+TEST (hash_native_test_sha512_incremental_empty_hash_buffer);
+TEST (hash_native_test_sha512_incremental_after_finish);
+TEST (hash_native_test_sha512_incremental_cancel);
+TEST (hash_native_test_sha512_incremental_after_cancel);
+TEST (hash_native_test_sha512_start_incremental_null);
+TEST (hash_native_test_sha512_start_without_finish);
+TEST (hash_native_test_sha512_update_after_finish);
+TEST (hash_native_test_sha512_finish_after_finish);
+TEST (hash_native_test_sha512_finish_small_hash_buffer);
+#endif
+TEST (hash_native_test_incremental_update_null);
+TEST (hash_native_test_incremental_update_no_start);
+TEST (hash_native_test_incremental_finish_null);
+TEST (hash_native_test_incremental_finish_no_start);
+TEST (hash_native_test_incremental_cancel_null);
+TEST (hash_native_test_incremental_cancel_no_start);
+#ifdef HASH_ENABLE_SHA1
+TEST (hash_native_test_calculate_sha1);
+TEST (hash_native_test_calculate_sha1_full_hash_block);
+TEST (hash_native_test_calculate_sha1_multiple_hash_blocks_not_aligned);
+TEST (hash_native_test_calculate_sha1_empty_hash_buffer);
+TEST (hash_native_test_calculate_sha1_null);
+TEST (hash_native_test_calculate_sha1_without_finish);
+TEST (hash_native_test_calculate_sha1_small_hash_buffer);
+#endif
+TEST (hash_native_test_calculate_sha256);
+TEST (hash_native_test_calculate_sha256_full_hash_block);
+TEST (hash_native_test_calculate_sha256_multiple_hash_blocks_not_aligned);
+TEST (hash_native_test_calculate_sha256_empty_hash_buffer);
+TEST (hash_native_test_calculate_sha256_null);
+TEST (hash_native_test_calculate_sha256_without_finish);
+TEST (hash_native_test_calculate_sha256_small_hash_buffer);
+#ifdef HASH_ENABLE_SHA384
+TEST (hash_native_test_calculate_sha384);
+TEST (hash_native_test_calculate_sha384_full_hash_block);
+TEST (hash_native_test_calculate_sha384_multiple_hash_blocks_not_aligned);
+TEST (hash_native_test_calculate_sha384_empty_hash_buffer);
+TEST (hash_native_test_calculate_sha384_null);
+TEST (hash_native_test_calculate_sha384_without_finish);
+TEST (hash_native_test_calculate_sha384_small_hash_buffer);
+#endif
+#ifdef HASH_ENABLE_SHA512
+TEST (hash_native_test_calculate_sha512);
+TEST (hash_native_test_calculate_sha512_full_hash_block);
+TEST (hash_native_test_calculate_sha512_multiple_hash_blocks_not_aligned);
+TEST (hash_native_test_calculate_sha512_empty_hash_buffer);
+TEST (hash_native_test_calculate_sha512_null);
+TEST (hash_native_test_calculate_sha512_without_finish);
+TEST (hash_native_test_calculate_sha512_small_hash_buffer);
+#endif
+#ifdef HASH_ENABLE_SHA1
+TEST (hash_native_test_save_state_sha1);
+#endif
+TEST (hash_native_test_save_state_sha256);
+#ifdef HASH_ENABLE_SHA384
+TEST (hash_native_test_save_state_sha384);
+#endif
+#ifdef HASH_ENABLE_SHA512
+TEST (hash_native_test_save_state_sha512);
+#endif
+TEST (hash_native_test_save_state_cancel);
+TEST (hash_native_test_save_state_null);
+TEST (hash_native_test_save_state_no_active_hash);
+TEST (hash_native_test_restore_state_null);
+TEST (hash_native_test_restore_state_hash_in_progress);
+TEST (hash_native_test_restore_state_unknown);
+TEST (hash_native_test_compare_openssl_portable);
+TEST (hash_native_test_compare_openssl_sha_ni);
+TEST (hash_native_test_compare_openssl_avx2);
+TEST (hash_native_test_compare_openssl_all_features);
+TEST (hash_native_test_restore_state_different_features);
+TEST (hash_native_test_thread_safe);
+TEST (hash_native_test_calculate_sha256_multi);
+TEST (hash_native_test_calculate_sha256_multi_sha_ni);
+TEST (hash_native_test_calculate_sha256_multi_compare_openssl_portable);
+TEST (hash_native_test_calculate_sha256_multi_compare_openssl_avx2);
+TEST (hash_native_test_calculate_sha256_multi_compare_openssl_all_features);
+TEST (hash_native_test_calculate_sha256_multi_null);
+TEST (hash_native_test_calculate_sha256_multi_small_hash_buffer);
+TEST (hash_native_test_calculate_sha256_multi_hash_in_progress);
+TEST (hash_native_test_thread_safe_sha256_multi);
+
+TEST_SUITE_END;
@@ -0,0 +1,194 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "platform_api.h"
+#include "testing.h"
+#include "crypto/hash.h"
+#include "crypto/hash_mbedtls.h"
+#include "crypto/kdf.h"
+
+
+TEST_SUITE_LABEL ("hmac_kdf_benchmark");
+
+
+/**
+ * The number of HMAC or KDF operations executed for each measurement.
+ */
+#define	HMAC_KDF_BENCHMARK_ITERATIONS		20000
+
+/**
+ * The amount of key material derived for each KDF operation.  This is sized to match the keys
+ * generated during session establishment.
+ */
+#define	HMAC_KDF_BENCHMARK_KEY_LENGTH		(SHA256_HASH_LENGTH * 2)
+
+
+/**
+ * Key used for all benchmark operations.
+ */
+static const uint8_t HMAC_KDF_BENCHMARK_KEY[] = {
+	0xf1,0x3b,0x43,0x16,0x2c,0xe4,0x02,0x34,0xd6,0x41,0x80,0xfa,0x1a,0x0e,0x0a,0x04,
+	0x0e,0x9a,0x37,0xff,0x3e,0xa0,0x05,0x75,0x73,0xc5,0x54,0x10,0xad,0xd5,0xc5,0xc6
+};
+
+/**
+ * Message data used for all benchmark operations.
+ */
+static const uint8_t HMAC_KDF_BENCHMARK_DATA[] = {
+	0x0e,0x9a,0x37,0xff,0x3e,0xa0,0x02,0x75,0x73,0xc5,0x54,0x10,0xad,0xd5,0xc5,0xc6,
+	0xf1,0x3b,0x43,0x16,0x2c,0xe4,0x05,0x34,0xd6,0x41,0x80,0xfa,0x1a,0x0e,0x0a,0x04
+};
+
+
+/**
+ * Report the rate at which operations were executed.
+ *
+ * @param name Name of the operation being measured.
+ * @param start_time The time the operations started.
+ * @param end_time The time the operations completed.
+ */
+static void hmac_kdf_benchmark_report (const char *name, const platform_clock *start_time,
+	const platform_clock *end_time)
+{
+	uint32_t duration;
+
+	duration = platform_get_duration (start_time, end_time);
+	if (duration == 0) {
+		duration = 1;
+	}
+
+	printf ("%s: %d operations in %u ms, %llu operations/sec\n", name,
+		HMAC_KDF_BENCHMARK_ITERATIONS, duration,
+		((unsigned long long) HMAC_KDF_BENCHMARK_ITERATIONS * 1000) / duration);
+}
+
+/**
+ * Run the SP800-108 KDF repeatedly and report the rate at which keys were derived.
+ *
+ * @param test The testing framework.
+ * @param hash The hash engine to use for the KDF.
+ * @param name Name of the configuration to report with the results.
+ * @param key Output for the derived key material.
+ */
+static void hmac_kdf_benchmark_run_kdf (CuTest *test, struct hash_engine *hash, const char *name,
+	uint8_t *key)
+{
+	platform_clock start_time;
+	platform_clock end_time;
+	int status = 0;
+	int i;
+
+	platform_init_current_tick (&start_time);
+
+	for (i = 0; (i < HMAC_KDF_BENCHMARK_ITERATIONS) && (status == 0); i++) {
+		status = kdf_nist800_108_counter_mode (hash, HMAC_SHA256, HMAC_KDF_BENCHMARK_KEY,
+			sizeof (HMAC_KDF_BENCHMARK_KEY), HMAC_KDF_BENCHMARK_DATA,
+			sizeof (HMAC_KDF_BENCHMARK_DATA), NULL, 0, key, HMAC_KDF_BENCHMARK_KEY_LENGTH);
+	}
+
+	platform_init_current_tick (&end_time);
+	CuAssertIntEquals (test, 0, status);
+
+	hmac_kdf_benchmark_report (name, &start_time, &end_time);
+}
+
+
+/*******************
+ * Test cases
+ *******************/
+
+static void hmac_kdf_benchmark_test_hmac_sha256 (CuTest *test)
+{
+	struct hash_engine_mbedtls engine;
+	struct hmac_keyed_context keyed;
+	platform_clock start_time;
+	platform_clock end_time;
+	uint8_t expected[SHA256_HASH_LENGTH];
+	uint8_t hmac[SHA256_HASH_LENGTH];
+	int status = 0;
+	int i;
+
+	TEST_START;
+
+	status = hash_mbedtls_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	platform_init_current_tick (&start_time);
+
+	for (i = 0; (i < HMAC_KDF_BENCHMARK_ITERATIONS) && (status == 0); i++) {
+		status = hash_generate_hmac (&engine.base, HMAC_KDF_BENCHMARK_KEY,
+			sizeof (HMAC_KDF_BENCHMARK_KEY), HMAC_KDF_BENCHMARK_DATA,
+			sizeof (HMAC_KDF_BENCHMARK_DATA), HMAC_SHA256, expected, sizeof (expected));
+	}
+
+	platform_init_current_tick (&end_time);
+	CuAssertIntEquals (test, 0, status);
+
+	hmac_kdf_benchmark_report ("hash_generate_hmac", &start_time, &end_time);
+
+	status = hash_hmac_keyed_init (&keyed, &engine.base, HMAC_SHA256, HMAC_KDF_BENCHMARK_KEY,
+		sizeof (HMAC_KDF_BENCHMARK_KEY));
+	CuAssertIntEquals (test, 0, status);
+	CuAssertIntEquals (test, true, keyed.has_state);
+
+	platform_init_current_tick (&start_time);
+
+	for (i = 0; (i < HMAC_KDF_BENCHMARK_ITERATIONS) && (status == 0); i++) {
+		status = hash_hmac_keyed_generate (&keyed, HMAC_KDF_BENCHMARK_DATA,
+			sizeof (HMAC_KDF_BENCHMARK_DATA), hmac, sizeof (hmac));
+	}
+
+	platform_init_current_tick (&end_time);
+	CuAssertIntEquals (test, 0, status);
+
+	hmac_kdf_benchmark_report ("hash_hmac_keyed_generate", &start_time, &end_time);
+
+	status = testing_validate_array (expected, hmac, sizeof (hmac));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_hmac_keyed_release (&keyed);
+	hash_mbedtls_release (&engine);
+}
+
+static void hmac_kdf_benchmark_test_kdf_nist800_108_counter_mode (CuTest *test)
+{
+	struct hash_engine_mbedtls engine;
+	struct hash_engine_mbedtls no_state;
+	uint8_t expected[HMAC_KDF_BENCHMARK_KEY_LENGTH];
+	uint8_t key[HMAC_KDF_BENCHMARK_KEY_LENGTH];
+	int status;
+
+	TEST_START;
+
+	status = hash_mbedtls_init (&engine);
+	CuAssertIntEquals (test, 0, status);
+
+	status = hash_mbedtls_init (&no_state);
+	CuAssertIntEquals (test, 0, status);
+
+	/* Disable saved hash states to measure the KDF without prepared HMAC keys. */
+	no_state.base.save_state = NULL;
+	no_state.base.restore_state = NULL;
+
+	hmac_kdf_benchmark_run_kdf (test, &no_state.base, "kdf_nist800_108_counter_mode (no state)",
+		expected);
+	hmac_kdf_benchmark_run_kdf (test, &engine.base, "kdf_nist800_108_counter_mode", key);
+
+	status = testing_validate_array (expected, key, sizeof (key));
+	CuAssertIntEquals (test, 0, status);
+
+	hash_mbedtls_release (&engine);
+	hash_mbedtls_release (&no_state);
+}
+
+
+TEST_SUITE_START (hmac_kdf_benchmark);
+
+TEST (hmac_kdf_benchmark_test_hmac_sha256);
+TEST (hmac_kdf_benchmark_test_kdf_nist800_108_counter_mode);
+
+TEST_SUITE_END;
@@ -14,6 +14,9 @@
  *
  * Be sure to keep the test suites in alphabetical order for easier management.
  *
+ * Benchmarks take a long time and print their results, so they only run when TESTING_RUN_BENCHMARKS
+ * is defined or the benchmark suite is explicitly requested.
+ *
  * @param suite Suite to add the tests to.
  */
 static void add_all_linux_crypto_tests (CuSuite *suite)
@@ -27,18 +30,40 @@ static void add_all_linux_crypto_tests (CuSuite *suite)
 	!defined TESTING_SKIP_AES_OPENSSL_SUITE
 	TESTING_RUN_SUITE (aes_openssl);
 #endif
+#if (defined TESTING_RUN_HASH_BENCHMARK_SUITE || defined TESTING_RUN_BENCHMARKS) && \
+	!defined TESTING_SKIP_HASH_BENCHMARK_SUITE
+	TESTING_RUN_SUITE (hash_benchmark);
+#endif
+#if (defined TESTING_RUN_HASH_NATIVE_SUITE || \
+		defined TESTING_RUN_ALL_TESTS || defined TESTING_RUN_ALL_LINUX_TESTS || \
+		(!defined TESTING_SKIP_ALL_TESTS && !defined TESTING_SKIP_ALL_LINUX_TESTS)) && \
+	!defined TESTING_SKIP_HASH_NATIVE_SUITE
+	TESTING_RUN_SUITE (hash_native);
+#endif
 #if (defined TESTING_RUN_HASH_OPENSSL_SUITE || \
 		defined TESTING_RUN_ALL_TESTS || defined TESTING_RUN_ALL_LINUX_TESTS || \
 		(!defined TESTING_SKIP_ALL_TESTS && !defined TESTING_SKIP_ALL_LINUX_TESTS)) && \
 	!defined TESTING_SKIP_HASH_OPENSSL_SUITE
 	TESTING_RUN_SUITE (hash_openssl);
 #endif
+#if (defined TESTING_RUN_ECC_BENCHMARK_SUITE || defined TESTING_RUN_BENCHMARKS) && \
+	!defined TESTING_SKIP_ECC_BENCHMARK_SUITE
+	TESTING_RUN_SUITE (ecc_benchmark);
+#endif
 #if (defined TESTING_RUN_ECC_OPENSSL_SUITE || \
 		defined TESTING_RUN_ALL_TESTS || defined TESTING_RUN_ALL_LINUX_TESTS || \
 		(!defined TESTING_SKIP_ALL_TESTS && !defined TESTING_SKIP_ALL_LINUX_TESTS)) && \
 	!defined TESTING_SKIP_ECC_OPENSSL_SUITE
 	TESTING_RUN_SUITE (ecc_openssl);
 #endif
+#if (defined TESTING_RUN_HMAC_KDF_BENCHMARK_SUITE || defined TESTING_RUN_BENCHMARKS) && \
+	!defined TESTING_SKIP_HMAC_KDF_BENCHMARK_SUITE
+	TESTING_RUN_SUITE (hmac_kdf_benchmark);
+#endif
+#if (defined TESTING_RUN_RIOT_DICE_BENCHMARK_SUITE || defined TESTING_RUN_BENCHMARKS) && \
+	!defined TESTING_SKIP_RIOT_DICE_BENCHMARK_SUITE
+	TESTING_RUN_SUITE (riot_dice_benchmark);
+#endif
 #if (defined TESTING_RUN_RNG_OPENSSL_SUITE || \
 		defined TESTING_RUN_ALL_TESTS || defined TESTING_RUN_ALL_LINUX_TESTS || \
 		(!defined TESTING_SKIP_ALL_TESTS && !defined TESTING_SKIP_ALL_LINUX_TESTS)) && \
@@ -0,0 +1,191 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "platform_api.h"
+#include "testing.h"
+#include "crypto/rng_openssl.h"
+#include "riot/reference/include/RiotEcc.h"
+
+
+TEST_SUITE_LABEL ("riot_dice_benchmark");
+
+
+/**
+ * The number of ECC operations executed for each measurement.
+ */
+#define	RIOT_DICE_BENCHMARK_ITERATIONS		200
+
+
+/**
+ * Seed used to derive the keys for all benchmark operations.  Each iteration modifies the last
+ * byte to generate a different key, similar to deriving the DeviceID and Alias keys from different
+ * CDI values.
+ */
+static const uint8_t RIOT_DICE_BENCHMARK_SEED[] = {
+	0x0e,0x9a,0x37,0xff,0x3e,0xa0,0x02,0x75,0x73,0xc5,0x54,0x10,0xad,0xd5,0xc5,0xc6,
+	0xf1,0x3b,0x43,0x16,0x2c,0xe4,0x05,0x34,0xd6,0x41,0x80,0xfa,0x1a,0x0e,0x0a,0x04
+};
+
+/**
+ * Digest signed for the signing benchmark.
+ */
+static const uint8_t RIOT_DICE_BENCHMARK_DIGEST[] = {
+	0xf1,0x3b,0x43,0x16,0x2c,0xe4,0x02,0x34,0xd6,0x41,0x80,0xfa,0x1a,0x0e,0x0a,0x04,
+	0x0e,0x9a,0x37,0xff,0x3e,0xa0,0x05,0x75,0x73,0xc5,0x54,0x10,0xad,0xd5,0xc5,0xc6
+};
+
+
+/**
+ * Report the rate at which operations were executed.
+ *
+ * @param name Name of the operation being measured.
+ * @param start_time The time the operations started.
+ * @param end_time The time the operations completed.
+ */
+static void riot_dice_benchmark_report (const char *name, const platform_clock *start_time,
+	const platform_clock *end_time)
+{
+	uint32_t duration;
+
+	duration = platform_get_duration (start_time, end_time);
+	if (duration == 0) {
+		duration = 1;
+	}
+
+	printf ("%s: %d operations in %u ms, %llu operations/sec\n", name,
+		RIOT_DICE_BENCHMARK_ITERATIONS, duration,
+		((unsigned long long) RIOT_DICE_BENCHMARK_ITERATIONS * 1000) / duration);
+}
+
+/**
+ * Generate the public key for a set of derived private keys and report the rate at which keys were
+ * generated.
+ *
+ * @param name Name of the multiplication method to report with the results.
+ * @param keys The private keys to use.
+ * @param pub Output for the generated public keys.
+ * @param fixed_base Flag to use the fixed-base multiplication.
+ */
+static void riot_dice_benchmark_run_key_generation (const char *name, const ecc_privatekey *keys,
+	ecc_publickey *pub, bool fixed_base)
+{
+	platform_clock start_time;
+	platform_clock end_time;
+	int i;
+
+	platform_init_current_tick (&start_time);
+
+	for (i = 0; i < RIOT_DICE_BENCHMARK_ITERATIONS; i++) {
+		RIOT_BasePointMultiply (&pub[i], &keys[i], fixed_base);
+	}
+
+	platform_init_current_tick (&end_time);
+
+	riot_dice_benchmark_report (name, &start_time, &end_time);
+}
+
+
+/*******************
+ * Test cases
+ *******************/
+
+static void riot_dice_benchmark_test_derive_key_pair (CuTest *test)
+{
+	ecc_privatekey keys[RIOT_DICE_BENCHMARK_ITERATIONS];
+	ecc_publickey generic[RIOT_DICE_BENCHMARK_ITERATIONS];
+	ecc_publickey fixed[RIOT_DICE_BENCHMARK_ITERATIONS];
+	ecc_publickey pub;
+	uint8_t seed[sizeof (RIOT_DICE_BENCHMARK_SEED)];
+	platform_clock start_time;
+	platform_clock end_time;
+	int status = RIOT_SUCCESS;
+	int i;
+
+	TEST_START;
+
+	memcpy (seed, RIOT_DICE_BENCHMARK_SEED, sizeof (seed));
+
+	for (i = 0; i < RIOT_DICE_BENCHMARK_ITERATIONS; i++) {
+		seed[sizeof (seed) - 1] = i;
+		BigIntToBigVal (&keys[i], seed, sizeof (seed));
+	}
+
+	riot_dice_benchmark_run_key_generation ("RIOT_BasePointMultiply (generic)", keys, generic,
+		false);
+	riot_dice_benchmark_run_key_generation ("RIOT_BasePointMultiply (fixed-base)", keys, fixed,
+		true);
+
+	for (i = 0; i < RIOT_DICE_BENCHMARK_ITERATIONS; i++) {
+		status = testing_validate_array ((uint8_t*) &generic[i], (uint8_t*) &fixed[i],
+			sizeof (ecc_publickey));
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	platform_init_current_tick (&start_time);
+
+	for (i = 0; (i < RIOT_DICE_BENCHMARK_ITERATIONS) && (status == RIOT_SUCCESS); i++) {
+		seed[sizeof (seed) - 1] = i;
+		status = RIOT_DeriveDsaKeyPair (&pub, &keys[i], seed, sizeof (seed));
+	}
+
+	platform_init_current_tick (&end_time);
+	CuAssertIntEquals (test, RIOT_SUCCESS, status);
+
+	riot_dice_benchmark_report ("RIOT_DeriveDsaKeyPair", &start_time, &end_time);
+}
+
+static void riot_dice_benchmark_test_sign (CuTest *test)
+{
+	struct rng_engine_openssl rng;
+	ecc_privatekey key;
+	ecc_publickey pub;
+	ecc_signature sig;
+	uint8_t der[RIOT_ECC_PRIVATE_BYTES * 4];
+	platform_clock start_time;
+	platform_clock end_time;
+	int out_len;
+	int status;
+	int i;
+
+	TEST_START;
+
+	status = rng_openssl_init (&rng);
+	CuAssertIntEquals (test, 0, status);
+
+	status = RIOT_DeriveDsaKeyPair (&pub, &key, RIOT_DICE_BENCHMARK_SEED,
+		sizeof (RIOT_DICE_BENCHMARK_SEED));
+	CuAssertIntEquals (test, RIOT_SUCCESS, status);
+
+	platform_init_current_tick (&start_time);
+
+	for (i = 0; (i < RIOT_DICE_BENCHMARK_ITERATIONS) && (status == RIOT_SUCCESS); i++) {
+		status = RIOT_DSASignDigest (RIOT_DICE_BENCHMARK_DIGEST,
+			sizeof (RIOT_DICE_BENCHMARK_DIGEST), &key, der, sizeof (der), &rng.base, &out_len);
+	}
+
+	platform_init_current_tick (&end_time);
+	CuAssertIntEquals (test, RIOT_SUCCESS, status);
+
+	riot_dice_benchmark_report ("RIOT_DSASignDigest", &start_time, &end_time);
+
+	status = RIOT_DSA_decode_signature (&sig, der, out_len);
+	CuAssertIntEquals (test, RIOT_SUCCESS, status);
+
+	status = RIOT_DSAVerifyDigest (RIOT_DICE_BENCHMARK_DIGEST, sizeof (RIOT_DICE_BENCHMARK_DIGEST),
+		&sig, &pub);
+	CuAssertIntEquals (test, RIOT_SUCCESS, status);
+
+	rng_openssl_release (&rng);
+}
+
+
+TEST_SUITE_START (riot_dice_benchmark);
+
+TEST (riot_dice_benchmark_test_derive_key_pair);
+TEST (riot_dice_benchmark_test_sign);
+
+TEST_SUITE_END;
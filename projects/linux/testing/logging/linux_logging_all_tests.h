@@ -0,0 +1,35 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef LINUX_LOGGING_ALL_TESTS_H_
+#define LINUX_LOGGING_ALL_TESTS_H_
+
+#include "testing.h"
+#include "platform_all_tests.h"
+#include "common/unused.h"
+
+
+/**
+ * Add all tests for components in the 'logging' directory.
+ *
+ * Be sure to keep the test suites in alphabetical order for easier management.
+ *
+ * Benchmarks take a long time and print their results, so they only run when TESTING_RUN_BENCHMARKS
+ * is defined or the benchmark suite is explicitly requested.
+ *
+ * @param suite Suite to add the tests to.
+ */
+static void add_all_linux_logging_tests (CuSuite *suite)
+{
+	/* This is unused when no tests will be executed. */
+	UNUSED (suite);
+
+#if (defined TESTING_RUN_LOGGING_MEMORY_LOCKFREE_BENCHMARK_SUITE || \
+		defined TESTING_RUN_BENCHMARKS) && \
+	!defined TESTING_SKIP_LOGGING_MEMORY_LOCKFREE_BENCHMARK_SUITE
+	TESTING_RUN_SUITE (logging_memory_lockfree_benchmark);
+#endif
+}
+
+
+#endif /* LINUX_LOGGING_ALL_TESTS_H_ */
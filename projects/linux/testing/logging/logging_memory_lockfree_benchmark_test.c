@@ -0,0 +1,273 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include "platform_api.h"
+#include "testing.h"
+#include "logging/logging_memory.h"
+#include "logging/logging_memory_lockfree.h"
+
+
+TEST_SUITE_LABEL ("logging_memory_lockfree_benchmark");
+
+
+/**
+ * The number of tasks adding entries to the log at the same time.
+ */
+#define	LOGGING_BENCHMARK_PRODUCERS			4
+
+/**
+ * The number of entries added by each producer.
+ */
+#define	LOGGING_BENCHMARK_ENTRIES			50000
+
+/**
+ * The total number of entries added to the log.
+ */
+#define	LOGGING_BENCHMARK_TOTAL				(LOGGING_BENCHMARK_PRODUCERS * LOGGING_BENCHMARK_ENTRIES)
+
+
+/**
+ * Log entry data generated by each producer.
+ */
+struct logging_benchmark_entry {
+	uint32_t producer;							/**< Identifier for the producer that added the entry. */
+	uint32_t count;								/**< Entry number for the producer. */
+	uint8_t data[8];							/**< Additional entry data. */
+};
+
+/**
+ * Context for a single producer.
+ */
+struct logging_benchmark_producer {
+	const struct logging *log;					/**< The log to add entries to. */
+	pthread_barrier_t *start;					/**< Synchronization to start all producers together. */
+	uint32_t id;								/**< Identifier for the producer. */
+	int status;									/**< Result of the last entry that was added. */
+};
+
+
+/**
+ * Add entries to a log as fast as possible.
+ *
+ * @param arg The producer context.
+ *
+ * @return Always null.
+ */
+static void* logging_benchmark_producer_run (void *arg)
+{
+	struct logging_benchmark_producer *producer = arg;
+	struct logging_benchmark_entry entry;
+	uint32_t i;
+
+	memset (&entry, 0, sizeof (entry));
+	entry.producer = producer->id;
+
+	pthread_barrier_wait (producer->start);
+
+	for (i = 0; (i < LOGGING_BENCHMARK_ENTRIES) && (producer->status == 0); i++) {
+		entry.count = i;
+		producer->status = producer->log->create_entry (producer->log, (uint8_t*) &entry,
+			sizeof (entry));
+	}
+
+	return NULL;
+}
+
+/**
+ * Add entries to a log from multiple producers at the same time and report the rate at which
+ * entries were added.
+ *
+ * @param test The testing framework.
+ * @param log The log to add entries to.
+ * @param name Name of the log to report with the results.
+ */
+static void logging_benchmark_run_producers (CuTest *test, const struct logging *log,
+	const char *name)
+{
+	struct logging_benchmark_producer producer[LOGGING_BENCHMARK_PRODUCERS];
+	pthread_t thread[LOGGING_BENCHMARK_PRODUCERS];
+	pthread_barrier_t start;
+	platform_clock start_time;
+	platform_clock end_time;
+	uint32_t duration;
+	int status;
+	int i;
+
+	status = pthread_barrier_init (&start, NULL, LOGGING_BENCHMARK_PRODUCERS + 1);
+	CuAssertIntEquals (test, 0, status);
+
+	for (i = 0; i < LOGGING_BENCHMARK_PRODUCERS; i++) {
+		producer[i].log = log;
+		producer[i].start = &start;
+		producer[i].id = i;
+		producer[i].status = 0;
+
+		status = pthread_create (&thread[i], NULL, logging_benchmark_producer_run, &producer[i]);
+		CuAssertIntEquals (test, 0, status);
+	}
+
+	pthread_barrier_wait (&start);
+	platform_init_current_tick (&start_time);
+
+	for (i = 0; i < LOGGING_BENCHMARK_PRODUCERS; i++) {
+		pthread_join (thread[i], NULL);
+	}
+
+	platform_init_current_tick (&end_time);
+	pthread_barrier_destroy (&start);
+
+	for (i = 0; i < LOGGING_BENCHMARK_PRODUCERS; i++) {
+		CuAssertIntEquals (test, 0, producer[i].status);
+	}
+
+	duration = platform_get_duration (&start_time, &end_time);
+	if (duration == 0) {
+		duration = 1;
+	}
+
+	printf ("%s: %d producers, %d entries in %u ms, %llu entries/sec\n", name,
+		LOGGING_BENCHMARK_PRODUCERS, LOGGING_BENCHMARK_TOTAL, duration,
+		((unsigned long long) LOGGING_BENCHMARK_TOTAL * 1000) / duration);
+}
+
+/**
+ * Check that the log contains every entry added by each producer, in order for that producer.
+ *
+ * @param test The testing framework.
+ * @param log The log to check.
+ */
+static void logging_benchmark_validate_entries (CuTest *test, const struct logging *log)
+{
+	const size_t entry_len = sizeof (struct logging_entry_header) +
+		sizeof (struct logging_benchmark_entry);
+	uint32_t next_count[LOGGING_BENCHMARK_PRODUCERS] = {0};
+	struct logging_entry_header *header;
+	struct logging_benchmark_entry *entry;
+	uint8_t *contents;
+	uint8_t *pos;
+	int status;
+	int i;
+
+	contents = platform_malloc (entry_len * LOGGING_BENCHMARK_TOTAL);
+	CuAssertPtrNotNull (test, contents);
+
+	status = log->read_contents (log, 0, contents, entry_len * LOGGING_BENCHMARK_TOTAL);
+	CuAssertIntEquals (test, entry_len * LOGGING_BENCHMARK_TOTAL, status);
+
+	pos = contents;
+	for (i = 0; i < LOGGING_BENCHMARK_TOTAL; i++) {
+		header = (struct logging_entry_header*) pos;
+		entry = (struct logging_benchmark_entry*) &pos[sizeof (struct logging_entry_header)];
+
+		CuAssertIntEquals (test, LOGGING_MAGIC_START, header->log_magic);
+		CuAssertIntEquals (test, entry_len, header->length);
+		CuAssertIntEquals (test, i, header->entry_id);
+
+		CuAssertTrue (test, (entry->producer < LOGGING_BENCHMARK_PRODUCERS));
+		CuAssertIntEquals (test, next_count[entry->producer], entry->count);
+		next_count[entry->producer]++;
+
+		pos += entry_len;
+	}
+
+	platform_free (contents);
+}
+
+
+/*******************
+ * Test cases
+ *******************/
+
+static void logging_memory_lockfree_benchmark_test_concurrent_producers (CuTest *test)
+{
+	struct logging_memory_lockfree logging;
+	struct logging_memory_lockfree_state state;
+	int status;
+
+	TEST_START;
+
+	status = logging_memory_lockfree_init (&logging, &state, LOGGING_BENCHMARK_TOTAL,
+		sizeof (struct logging_benchmark_entry));
+	CuAssertIntEquals (test, 0, status);
+
+	logging_benchmark_run_producers (test, &logging.base, "logging_memory_lockfree");
+
+	CuAssertIntEquals (test, 0, logging_memory_lockfree_get_dropped_count (&logging));
+	logging_benchmark_validate_entries (test, &logging.base);
+
+	logging_memory_lockfree_release (&logging);
+}
+
+static void logging_memory_lockfree_benchmark_test_concurrent_producers_log_wrap (CuTest *test)
+{
+	struct logging_memory_lockfree logging;
+	struct logging_memory_lockfree_state state;
+	const size_t entry_len = sizeof (struct logging_entry_header) +
+		sizeof (struct logging_benchmark_entry);
+	struct logging_entry_header *header;
+	uint8_t contents[entry_len * 256];
+	uint32_t last_id = 0;
+	int status;
+	int i;
+
+	TEST_START;
+
+	status = logging_memory_lockfree_init (&logging, &state, 256,
+		sizeof (struct logging_benchmark_entry));
+	CuAssertIntEquals (test, 0, status);
+
+	logging_benchmark_run_producers (test, &logging.base, "logging_memory_lockfree (wrap)");
+
+	status = logging.base.read_contents (&logging.base, 0, contents, sizeof (contents));
+	CuAssertTrue (test, (status > 0));
+	CuAssertIntEquals (test, 0, status % entry_len);
+	CuAssertIntEquals (test, logging.base.get_size (&logging.base), status);
+
+	/* Entries may have been dropped, but the ones in the log must be complete and in order. */
+	for (i = 0; i < (int) (status / entry_len); i++) {
+		header = (struct logging_entry_header*) &contents[i * entry_len];
+
+		CuAssertIntEquals (test, LOGGING_MAGIC_START, header->log_magic);
+		CuAssertIntEquals (test, entry_len, header->length);
+		CuAssertTrue (test, (header->entry_id >= (LOGGING_BENCHMARK_TOTAL - 256)));
+		CuAssertTrue (test, (header->entry_id < LOGGING_BENCHMARK_TOTAL));
+		CuAssertTrue (test, ((i == 0) || (header->entry_id > last_id)));
+
+		last_id = header->entry_id;
+	}
+
+	logging_memory_lockfree_release (&logging);
+}
+
+static void logging_memory_lockfree_benchmark_test_concurrent_producers_locked_log (CuTest *test)
+{
+	struct logging_memory logging;
+	struct logging_memory_state state;
+	int status;
+
+	TEST_START;
+
+	status = logging_memory_init (&logging, &state, LOGGING_BENCHMARK_TOTAL,
+		sizeof (struct logging_benchmark_entry));
+	CuAssertIntEquals (test, 0, status);
+
+	logging_benchmark_run_producers (test, &logging.base, "logging_memory");
+
+	logging_benchmark_validate_entries (test, &logging.base);
+
+	logging_memory_release (&logging);
+}
+
+
+TEST_SUITE_START (logging_memory_lockfree_benchmark);
+
+TEST (logging_memory_lockfree_benchmark_test_concurrent_producers);
+TEST (logging_memory_lockfree_benchmark_test_concurrent_producers_log_wrap);
+TEST (logging_memory_lockfree_benchmark_test_concurrent_producers_locked_log);
+
+TEST_SUITE_END;
@@ -0,0 +1,506 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "testing.h"
+#include "common/array_size.h"
+#include "memory_mgmt/heap_segregated_fit.h"
+#include "memory_mgmt/heap_with_defrag.h"
+
+
+TEST_SUITE_LABEL ("heap_benchmark");
+
+
+/**
+ * Size of the heap used for each measurement.
+ */
+#define	HEAP_BENCHMARK_HEAP_SIZE			(128 * 1024)
+
+/**
+ * The number of attestation sequences that are replayed at the same time, interleaving operations
+ * from each sequence.
+ */
+#define	HEAP_BENCHMARK_DEVICES				8
+
+/**
+ * The number of slots used by a single attestation sequence.
+ */
+#define	HEAP_BENCHMARK_TRACE_SLOTS			8
+
+/**
+ * The number of times the interleaved attestation sequences are replayed.
+ */
+#define	HEAP_BENCHMARK_ROUNDS				500
+
+/**
+ * The number of operations in the randomized trace.
+ */
+#define	HEAP_BENCHMARK_RANDOM_OPS			200000
+
+/**
+ * The number of blocks that can be allocated at once by the randomized trace.
+ */
+#define	HEAP_BENCHMARK_RANDOM_SLOTS			32
+
+/**
+ * The total number of slots needed to hold every live block.
+ */
+#define	HEAP_BENCHMARK_SLOTS				(HEAP_BENCHMARK_DEVICES * HEAP_BENCHMARK_TRACE_SLOTS)
+
+/**
+ * The largest number of operations run for a single measurement.
+ */
+#define	HEAP_BENCHMARK_MAX_OPS				HEAP_BENCHMARK_RANDOM_OPS
+
+
+/**
+ * Operations in a recorded allocation trace.
+ */
+enum heap_benchmark_trace_op {
+	TRACE_ALLOC,		/**< Allocate a block into a slot. */
+	TRACE_CALLOC,		/**< Allocate a zeroized block into a slot. */
+	TRACE_REALLOC,		/**< Resize the block in a slot. */
+	TRACE_FREE,			/**< Free the block in a slot. */
+};
+
+/**
+ * A single entry in a recorded allocation trace.
+ */
+struct heap_benchmark_trace {
+	enum heap_benchmark_trace_op op;	/**< The heap operation. */
+	int slot;							/**< The slot holding the block. */
+	size_t size;						/**< Requested size of the block. */
+};
+
+/**
+ * Allocation sequence recorded from the attestation requester fetching and authenticating a
+ * certificate chain, then collecting measurements, for two devices in parallel.  This is the same
+ * sequence used by the heap_segregated_fit unit tests.
+ */
+static const struct heap_benchmark_trace HEAP_BENCHMARK_ATTESTATION[] = {
+	{TRACE_ALLOC, 0, 1024},
+	{TRACE_ALLOC, 1, 1024},
+	{TRACE_REALLOC, 0, 1536},
+	{TRACE_CALLOC, 2, 48},
+	{TRACE_REALLOC, 1, 1300},
+	{TRACE_CALLOC, 3, 48},
+	{TRACE_ALLOC, 4, 320},
+	{TRACE_ALLOC, 5, 96},
+	{TRACE_FREE, 5, 0},
+	{TRACE_ALLOC, 6, 72},
+	{TRACE_FREE, 0, 0},
+	{TRACE_ALLOC, 0, 512},
+	{TRACE_FREE, 4, 0},
+	{TRACE_ALLOC, 4, 320},
+	{TRACE_ALLOC, 5, 12},
+	{TRACE_FREE, 2, 0},
+	{TRACE_REALLOC, 0, 900},
+	{TRACE_FREE, 6, 0},
+	{TRACE_ALLOC, 6, 200},
+	{TRACE_FREE, 1, 0},
+	{TRACE_FREE, 5, 0},
+	{TRACE_ALLOC, 1, 1024},
+	{TRACE_CALLOC, 2, 48},
+	{TRACE_REALLOC, 1, 64},
+	{TRACE_FREE, 3, 0},
+	{TRACE_FREE, 4, 0},
+	{TRACE_ALLOC, 3, 2000},
+	{TRACE_FREE, 0, 0},
+	{TRACE_FREE, 6, 0},
+	{TRACE_FREE, 2, 0},
+	{TRACE_FREE, 1, 0},
+	{TRACE_FREE, 3, 0},
+};
+
+/**
+ * Allocation sizes seen in the recorded trace, used to generate the randomized trace.
+ */
+static const size_t HEAP_BENCHMARK_SIZES[] = {
+	12, 48, 64, 72, 96, 200, 320, 512, 900, 1024, 1300, 1536, 2000
+};
+
+
+/**
+ * Heap allocator being measured.
+ */
+struct heap_benchmark_allocator {
+	const char *name;											/**< Name to report with the results. */
+	int (*init) (const void *heap_addr, size_t heap_len);		/**< Initialize the heap. */
+	void (*release) (void);										/**< Release the heap. */
+	void* (*allocate) (size_t size);							/**< Allocate a block. */
+	void* (*allocate_zeroize) (size_t num_items, size_t size);	/**< Allocate a zeroized block. */
+	void* (*reallocate) (void *addr, size_t size);				/**< Resize a block. */
+	void (*free) (void *addr);									/**< Free a block. */
+	void (*get_free) (int *blocks, size_t *total, size_t *largest);	/**< Get free memory stats. */
+};
+
+/**
+ * Results of a single measurement.
+ */
+struct heap_benchmark_result {
+	uint64_t *samples;				/**< Latency of each heap operation, in ns. */
+	size_t count;					/**< The number of heap operations. */
+	size_t failed;					/**< The number of allocations that failed. */
+	size_t fragmented;				/**< Failed allocations with enough total free memory. */
+	int max_free_blocks;			/**< The largest number of free blocks seen. */
+	size_t min_largest_free;		/**< The smallest largest free block seen. */
+};
+
+
+/**
+ * Get free memory stats for heap_with_defrag.  The allocator does not report the largest free
+ * block, so it is reported as 0.
+ *
+ * @param blocks Output for the number of free blocks.
+ * @param total Output for the total free memory.
+ * @param largest Output for the largest free block.
+ */
+static void heap_benchmark_defrag_get_free (int *blocks, size_t *total, size_t *largest)
+{
+	struct heap_with_defrag_stats stats;
+
+	heap_with_defrag_get_stats (&stats);
+
+	*blocks = stats.num_free_blocks;
+	*total = stats.total_free_size;
+	*largest = 0;
+}
+
+/**
+ * The heap_with_defrag allocator has no release function.
+ */
+static void heap_benchmark_defrag_release (void)
+{
+}
+
+/**
+ * Get free memory stats for heap_segregated_fit.
+ *
+ * @param blocks Output for the number of free blocks.
+ * @param total Output for the total free memory.
+ * @param largest Output for the largest free block.
+ */
+static void heap_benchmark_segregated_fit_get_free (int *blocks, size_t *total, size_t *largest)
+{
+	struct heap_segregated_fit_stats stats;
+
+	heap_segregated_fit_get_stats (&stats);
+
+	*blocks = stats.num_free_blocks;
+	*total = stats.total_free_size;
+	*largest = stats.largest_free_block;
+}
+
+/**
+ * All heap allocators to measure.
+ */
+static const struct heap_benchmark_allocator HEAP_BENCHMARK_ALLOCATORS[] = {
+	{
+		"heap_with_defrag", heap_with_defrag_init, heap_benchmark_defrag_release,
+		heap_with_defrag_allocate, heap_with_defrag_allocate_zeroize, heap_with_defrag_reallocate,
+		heap_with_defrag_free, heap_benchmark_defrag_get_free
+	},
+	{
+		"heap_segregated_fit", heap_segregated_fit_init, heap_segregated_fit_release,
+		heap_segregated_fit_allocate, heap_segregated_fit_allocate_zeroize,
+		heap_segregated_fit_reallocate, heap_segregated_fit_free,
+		heap_benchmark_segregated_fit_get_free
+	},
+	{
+		"heap_segregated_fit (locked)", heap_segregated_fit_init_thread_safe,
+		heap_segregated_fit_release, heap_segregated_fit_allocate,
+		heap_segregated_fit_allocate_zeroize, heap_segregated_fit_reallocate,
+		heap_segregated_fit_free, heap_benchmark_segregated_fit_get_free
+	},
+};
+
+
+/**
+ * Get the current time from a monotonic clock.
+ *
+ * @return The current time, in nanoseconds.
+ */
+static uint64_t heap_benchmark_get_time (void)
+{
+	struct timespec now;
+
+	clock_gettime (CLOCK_MONOTONIC, &now);
+	return ((uint64_t) now.tv_sec * 1000000000ULL) + now.tv_nsec;
+}
+
+/**
+ * Compare two latency samples for sorting.
+ *
+ * @param a The first sample.
+ * @param b The second sample.
+ *
+ * @return Sort order of the samples.
+ */
+static int heap_benchmark_compare_samples (const void *a, const void *b)
+{
+	uint64_t sample_a = *((const uint64_t*) a);
+	uint64_t sample_b = *((const uint64_t*) b);
+
+	return (sample_a > sample_b) - (sample_a < sample_b);
+}
+
+/**
+ * Run a single heap operation and record its latency.  Allocations that fail are counted, along
+ * with whether there was enough total free memory to satisfy the request.
+ *
+ * @param heap The allocator being measured.
+ * @param result The measurement results to update.
+ * @param blocks The blocks allocated in each slot.
+ * @param op The heap operation to run.
+ * @param slot The slot to use for the operation.
+ * @param size The requested size for the operation.
+ */
+static void heap_benchmark_run_op (const struct heap_benchmark_allocator *heap,
+	struct heap_benchmark_result *result, uint8_t **blocks, enum heap_benchmark_trace_op op,
+	int slot, size_t size)
+{
+	uint64_t start;
+	uint8_t *block = NULL;
+	int free_blocks;
+	size_t free_total;
+	size_t largest;
+
+	start = heap_benchmark_get_time ();
+
+	switch (op) {
+		case TRACE_ALLOC:
+			block = heap->allocate (size);
+			break;
+
+		case TRACE_CALLOC:
+			block = heap->allocate_zeroize (1, size);
+			break;
+
+		case TRACE_REALLOC:
+			block = heap->reallocate (blocks[slot], size);
+			break;
+
+		case TRACE_FREE:
+			heap->free (blocks[slot]);
+			break;
+	}
+
+	result->samples[result->count++] = heap_benchmark_get_time () - start;
+
+	heap->get_free (&free_blocks, &free_total, &largest);
+	if (free_blocks > result->max_free_blocks) {
+		result->max_free_blocks = free_blocks;
+	}
+	if (largest < result->min_largest_free) {
+		result->min_largest_free = largest;
+	}
+
+	if (op == TRACE_FREE) {
+		blocks[slot] = NULL;
+	}
+	else if (block != NULL) {
+		blocks[slot] = block;
+	}
+	else {
+		/* A failed reallocation leaves the original block in place. */
+		result->failed++;
+		if (free_total >= size) {
+			result->fragmented++;
+		}
+	}
+}
+
+/**
+ * Replay the recorded attestation sequence for multiple devices, interleaving the operations for
+ * each device.
+ *
+ * @param heap The allocator being measured.
+ * @param result The measurement results to update.
+ * @param blocks The blocks allocated in each slot.
+ */
+static void heap_benchmark_replay_attestation (const struct heap_benchmark_allocator *heap,
+	struct heap_benchmark_result *result, uint8_t **blocks)
+{
+	const struct heap_benchmark_trace *trace;
+	int round;
+	size_t i;
+	int device;
+	int slot;
+
+	for (round = 0; round < HEAP_BENCHMARK_ROUNDS; round++) {
+		for (i = 0; i < ARRAY_SIZE (HEAP_BENCHMARK_ATTESTATION); i++) {
+			trace = &HEAP_BENCHMARK_ATTESTATION[i];
+
+			for (device = 0; device < HEAP_BENCHMARK_DEVICES; device++) {
+				slot = (device * HEAP_BENCHMARK_TRACE_SLOTS) + trace->slot;
+
+				/* Skip operations on blocks that could not be allocated. */
+				if ((trace->op != TRACE_ALLOC) && (trace->op != TRACE_CALLOC) &&
+					(blocks[slot] == NULL)) {
+					continue;
+				}
+
+				if (result->count < HEAP_BENCHMARK_MAX_OPS) {
+					heap_benchmark_run_op (heap, result, blocks, trace->op, slot, trace->size);
+				}
+			}
+		}
+	}
+}
+
+/**
+ * Run a randomized trace of operations with sizes taken from the recorded attestation sequence.
+ * The same seed is used for every allocator so each one sees the same trace.
+ *
+ * @param heap The allocator being measured.
+ * @param result The measurement results to update.
+ * @param blocks The blocks allocated in each slot.
+ */
+static void heap_benchmark_replay_random (const struct heap_benchmark_allocator *heap,
+	struct heap_benchmark_result *result, uint8_t **blocks)
+{
+	uint32_t seed = 0x12345678;
+	enum heap_benchmark_trace_op op;
+	size_t size;
+	int slot;
+	int i;
+
+	for (i = 0; i < HEAP_BENCHMARK_RANDOM_OPS; i++) {
+		seed = (seed * 1103515245) + 12345;
+		slot = (seed >> 16) % HEAP_BENCHMARK_RANDOM_SLOTS;
+
+		seed = (seed * 1103515245) + 12345;
+		size = HEAP_BENCHMARK_SIZES[(seed >> 16) % ARRAY_SIZE (HEAP_BENCHMARK_SIZES)];
+
+		if (blocks[slot] == NULL) {
+			op = (seed & 0x100) ? TRACE_CALLOC : TRACE_ALLOC;
+		}
+		else {
+			op = (seed & 0x100) ? TRACE_REALLOC : TRACE_FREE;
+		}
+
+		heap_benchmark_run_op (heap, result, blocks, op, slot, size);
+	}
+}
+
+/**
+ * Report the results of a measurement.
+ *
+ * @param heap The allocator that was measured.
+ * @param trace Name of the trace that was replayed.
+ * @param result The measurement results.
+ */
+static void heap_benchmark_report (const struct heap_benchmark_allocator *heap, const char *trace,
+	struct heap_benchmark_result *result)
+{
+	uint64_t total = 0;
+	size_t i;
+
+	for (i = 0; i < result->count; i++) {
+		total += result->samples[i];
+	}
+
+	qsort (result->samples, result->count, sizeof (result->samples[0]),
+		heap_benchmark_compare_samples);
+
+	printf ("%s: %s: %zu ops, avg %llu ns, p50 %llu ns, p99 %llu ns, max %llu ns, "
+		"%zu failed (%zu fragmented), max %d free blocks", heap->name, trace, result->count,
+		(unsigned long long) (total / result->count),
+		(unsigned long long) result->samples[result->count / 2],
+		(unsigned long long) result->samples[(result->count * 99) / 100],
+		(unsigned long long) result->samples[result->count - 1], result->failed,
+		result->fragmented, result->max_free_blocks);
+
+	if (result->min_largest_free != 0) {
+		printf (", min largest free %zu", result->min_largest_free);
+	}
+
+	printf ("\n");
+}
+
+/**
+ * Replay a trace against every allocator and report the results.
+ *
+ * @param test The testing framework.
+ * @param trace Name of the trace being replayed.
+ * @param replay Function to replay the trace.
+ */
+static void heap_benchmark_run (CuTest *test, const char *trace,
+	void (*replay) (const struct heap_benchmark_allocator*, struct heap_benchmark_result*,
+		uint8_t**))
+{
+	static size_t heap_mem[HEAP_BENCHMARK_HEAP_SIZE / sizeof (size_t)];
+	const struct heap_benchmark_allocator *heap;
+	struct heap_benchmark_result result;
+	uint8_t *blocks[HEAP_BENCHMARK_SLOTS];
+	size_t i;
+	int slot;
+	int status;
+
+	result.samples = malloc (HEAP_BENCHMARK_MAX_OPS * sizeof (result.samples[0]));
+	CuAssertPtrNotNull (test, result.samples);
+
+	for (i = 0; i < ARRAY_SIZE (HEAP_BENCHMARK_ALLOCATORS); i++) {
+		heap = &HEAP_BENCHMARK_ALLOCATORS[i];
+
+		status = heap->init (heap_mem, sizeof (heap_mem));
+		CuAssertIntEquals (test, 0, status);
+
+		memset (blocks, 0, sizeof (blocks));
+		result.count = 0;
+		result.failed = 0;
+		result.fragmented = 0;
+		result.max_free_blocks = 0;
+		result.min_largest_free = SIZE_MAX;
+
+		replay (heap, &result, blocks);
+
+		for (slot = 0; slot < HEAP_BENCHMARK_SLOTS; slot++) {
+			heap->free (blocks[slot]);
+		}
+
+		if (result.min_largest_free == SIZE_MAX) {
+			result.min_largest_free = 0;
+		}
+
+		CuAssertTrue (test, (result.count != 0));
+		heap_benchmark_report (heap, trace, &result);
+
+		heap->release ();
+	}
+
+	free (result.samples);
+}
+
+
+/*******************
+ * Test cases
+ *******************/
+
+static void heap_benchmark_test_attestation_trace (CuTest *test)
+{
+	TEST_START;
+
+	heap_benchmark_run (test, "attestation", heap_benchmark_replay_attestation);
+}
+
+static void heap_benchmark_test_random_trace (CuTest *test)
+{
+	TEST_START;
+
+	heap_benchmark_run (test, "random", heap_benchmark_replay_random);
+}
+
+
+TEST_SUITE_START (heap_benchmark);
+
+TEST (heap_benchmark_test_attestation_trace);
+TEST (heap_benchmark_test_random_trace);
+
+TEST_SUITE_END;
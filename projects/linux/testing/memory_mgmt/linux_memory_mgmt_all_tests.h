@@ -0,0 +1,34 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef LINUX_MEMORY_MGMT_ALL_TESTS_H_
+#define LINUX_MEMORY_MGMT_ALL_TESTS_H_
+
+#include "testing.h"
+#include "platform_all_tests.h"
+#include "common/unused.h"
+
+
+/**
+ * Add all tests for components in the 'memory_mgmt' directory.
+ *
+ * Be sure to keep the test suites in alphabetical order for easier management.
+ *
+ * Benchmarks take a long time and print their results, so they only run when TESTING_RUN_BENCHMARKS
+ * is defined or the benchmark suite is explicitly requested.
+ *
+ * @param suite Suite to add the tests to.
+ */
+static void add_all_linux_memory_mgmt_tests (CuSuite *suite)
+{
+	/* This is unused when no tests will be executed. */
+	UNUSED (suite);
+
+#if (defined TESTING_RUN_HEAP_BENCHMARK_SUITE || defined TESTING_RUN_BENCHMARKS) && \
+	!defined TESTING_SKIP_HEAP_BENCHMARK_SUITE
+	TESTING_RUN_SUITE (heap_benchmark);
+#endif
+}
+
+
+#endif /* LINUX_MEMORY_MGMT_ALL_TESTS_H_ */
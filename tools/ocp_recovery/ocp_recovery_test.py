@@ -182,6 +182,39 @@ def fill_and_verify_cms (args, cms_info, timeout):
 
         run_cmd_sequence (args, [load_args, verify_args], timeout = timeout)
 
+def measure_cms_read (args, cms_info, timeout):
+    """
+    Read the entire contents of a CMS and report the throughput of the transfer.  If a minimum
+    throughput is specified and not achieved, the test will exit.
+
+    :param args:  The user-defined arguments.
+    :param cms_info:  Dictionary defining the CMS and parameters to use.
+    :param timeout:  Timeout to apply to the commands.
+    """
+
+    cms = cms_info["cms"]
+    read_args = ["-c", str (cms)]
+
+    if ("read" in cms_info):
+        read_args.extend (["-R", str (cms_info.get ("read"))])
+
+    cms_size = get_cms_size (args, cms)
+
+    with tempfile.NamedTemporaryFile (delete = True) as cms_file:
+        read_args.extend (["read_data", cms_file.name])
+
+        start = time.monotonic ()
+        run_cmd (args, read_args, timeout = timeout)
+        elapsed = time.monotonic () - start
+
+    rate = cms_size / elapsed
+    log_output ("Read {0} bytes from CMS {1} in {2:.3f} s: {3:.0f} bytes/s\n\n".format (cms_size,
+        cms, elapsed, rate), args.log)
+
+    if (("min_rate" in cms_info) and (rate < cms_info.get ("min_rate"))):
+        fail ("Read throughput below minimum of {0} bytes/s".format (cms_info.get ("min_rate")),
+            args.log)
+
 def extract_byte_array (result, tag, length, check_len = None, check_offset = 0):
     """
     Extract a byte array from command results for verification against expected values.
@@ -306,6 +339,8 @@ def run_test_suite (args, suite_path):
                         verify_expected_values (args, result, validation)
                 elif ("fill_cms" in step):
                     fill_and_verify_cms (args, step.get ("fill_cms"), cmd_timeout)
+                elif ("read_cms" in step):
+                    measure_cms_read (args, step.get ("read_cms"), cmd_timeout)
                 else:
                     fail ("Invalid test step", args.log)
 
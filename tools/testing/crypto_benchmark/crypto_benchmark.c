@@ -0,0 +1,437 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "crypto_benchmark.h"
+#include "common/array_size.h"
+#include "status/rot_status.h"
+
+#if defined __x86_64__ || defined __i386__
+#include <x86intrin.h>
+#define	CRYPTO_BENCHMARK_HAS_CYCLE_COUNTER
+#endif
+
+
+/**
+ * Default minimum time to spend on each measurement, in milliseconds.
+ */
+#define	CRYPTO_BENCHMARK_DEFAULT_MIN_TIME_MS	250
+
+/**
+ * Default maximum number of samples to collect for each measurement.
+ */
+#define	CRYPTO_BENCHMARK_DEFAULT_MAX_ITERATIONS	100000
+
+/**
+ * Minimum number of samples to collect for each measurement, regardless of the time spent.
+ */
+#define	CRYPTO_BENCHMARK_MIN_ITERATIONS			10
+
+
+/**
+ * A set of measurements for a single type of crypto engine.
+ */
+struct crypto_benchmark_suite {
+	const char *name;								/**< Name of the engine type. */
+	int (*run) (struct crypto_benchmark *bench);	/**< Function to run the measurements. */
+	bool enabled;									/**< Flag indicating the suite should run. */
+};
+
+/**
+ * All measurement suites that can be run.
+ */
+static struct crypto_benchmark_suite suites[] = {
+	{"hash", crypto_benchmark_hash, true},
+	{"hash_pool", crypto_benchmark_hash_pool, true},
+	{"ecc", crypto_benchmark_ecc, true},
+	{"rsa", crypto_benchmark_rsa, true},
+	{"aes", crypto_benchmark_aes, true},
+	{"rng", crypto_benchmark_rng, true},
+	{"x509", crypto_benchmark_x509, true},
+};
+
+
+/**
+ * Get the current value of the CPU cycle counter.  On x86 processors, this is the time stamp
+ * counter, which runs at a constant reference rate that may not match the core clock if frequency
+ * scaling is active.
+ *
+ * @return The cycle counter or 0 if there is no counter available.
+ */
+static inline uint64_t crypto_benchmark_get_cycles (void)
+{
+#ifdef CRYPTO_BENCHMARK_HAS_CYCLE_COUNTER
+	return __rdtsc ();
+#else
+	return 0;
+#endif
+}
+
+/**
+ * Get the current time from a monotonic clock.
+ *
+ * @return The current time, in nanoseconds.
+ */
+static inline uint64_t crypto_benchmark_get_time (void)
+{
+	struct timespec now;
+
+	clock_gettime (CLOCK_MONOTONIC, &now);
+	return ((uint64_t) now.tv_sec * 1000000000ULL) + now.tv_nsec;
+}
+
+/**
+ * Compare two latency samples for sorting.
+ *
+ * @param a The first sample.
+ * @param b The second sample.
+ *
+ * @return Sort order of the samples.
+ */
+static int crypto_benchmark_compare_samples (const void *a, const void *b)
+{
+	uint64_t sample_a = *((const uint64_t*) a);
+	uint64_t sample_b = *((const uint64_t*) b);
+
+	return (sample_a > sample_b) - (sample_a < sample_b);
+}
+
+/**
+ * Get a latency percentile from a sorted list of samples, using the nearest-rank method.
+ *
+ * @param samples The sorted samples.
+ * @param count The number of samples.
+ * @param percent The percentile to get.
+ *
+ * @return The sample at the requested percentile.
+ */
+static uint64_t crypto_benchmark_get_percentile (const uint64_t *samples, size_t count,
+	size_t percent)
+{
+	size_t rank = ((count * percent) + 99) / 100;
+
+	if (rank == 0) {
+		rank = 1;
+	}
+
+	return samples[rank - 1];
+}
+
+/**
+ * Start the output of measurement results.
+ *
+ * @param bench The measurement context.
+ */
+static void crypto_benchmark_start_report (struct crypto_benchmark *bench)
+{
+	if (bench->format == CRYPTO_BENCHMARK_FORMAT_JSON) {
+		printf ("[");
+	}
+	else {
+		printf ("engine,backend,operation,size,iterations,ops_per_sec,mbytes_per_sec,"
+			"cycles_per_op,cycles_per_byte,p50_ns,p90_ns,p99_ns,max_ns\n");
+	}
+}
+
+/**
+ * Complete the output of measurement results.
+ *
+ * @param bench The measurement context.
+ */
+static void crypto_benchmark_end_report (struct crypto_benchmark *bench)
+{
+	if (bench->format == CRYPTO_BENCHMARK_FORMAT_JSON) {
+		printf ("%s]\n", (bench->reported != 0) ? "\n" : "");
+	}
+
+	fflush (stdout);
+}
+
+/**
+ * Report the result of a single measurement.
+ *
+ * @param bench The measurement context.
+ * @param engine The type of crypto engine that was measured.
+ * @param backend The implementation of the crypto engine.
+ * @param operation The operation that was measured.
+ * @param size The number of bytes processed by each operation.
+ * @param count The number of samples collected.
+ * @param total_time Total time spent executing the operation, in ns.
+ * @param total_cycles Total number of cycles spent executing the operation.
+ */
+static void crypto_benchmark_report (struct crypto_benchmark *bench, const char *engine,
+	const char *backend, const char *operation, size_t size, size_t count, uint64_t total_time,
+	uint64_t total_cycles)
+{
+	double ops_per_sec;
+	double mbytes_per_sec;
+	double cycles_per_op;
+	double cycles_per_byte;
+	uint64_t p50;
+	uint64_t p90;
+	uint64_t p99;
+	uint64_t max;
+	char cycles_op_str[32] = "";
+	char cycles_byte_str[32] = "";
+
+	if (total_time == 0) {
+		total_time = 1;
+	}
+
+	ops_per_sec = ((double) count * 1000000000.0) / total_time;
+	mbytes_per_sec = (ops_per_sec * size) / 1000000.0;
+
+	p50 = crypto_benchmark_get_percentile (bench->samples, count, 50);
+	p90 = crypto_benchmark_get_percentile (bench->samples, count, 90);
+	p99 = crypto_benchmark_get_percentile (bench->samples, count, 99);
+	max = bench->samples[count - 1];
+
+#ifdef CRYPTO_BENCHMARK_HAS_CYCLE_COUNTER
+	cycles_per_op = (double) total_cycles / count;
+	cycles_per_byte = (size != 0) ? (cycles_per_op / size) : 0;
+
+	snprintf (cycles_op_str, sizeof (cycles_op_str), "%.1f", cycles_per_op);
+	snprintf (cycles_byte_str, sizeof (cycles_byte_str), "%.2f", cycles_per_byte);
+#else
+	(void) total_cycles;
+	(void) cycles_per_op;
+	(void) cycles_per_byte;
+
+	if (bench->format == CRYPTO_BENCHMARK_FORMAT_JSON) {
+		strcpy (cycles_op_str, "null");
+		strcpy (cycles_byte_str, "null");
+	}
+#endif
+
+	if (bench->format == CRYPTO_BENCHMARK_FORMAT_JSON) {
+		printf ("%s\n  {\"engine\": \"%s\", \"backend\": \"%s\", \"operation\": \"%s\", "
+			"\"size\": %zu, \"iterations\": %zu, \"ops_per_sec\": %.1f, \"mbytes_per_sec\": %.2f, "
+			"\"cycles_per_op\": %s, \"cycles_per_byte\": %s, \"p50_ns\": %llu, \"p90_ns\": %llu, "
+			"\"p99_ns\": %llu, \"max_ns\": %llu}", (bench->reported != 0) ? "," : "", engine,
+			backend, operation, size, count, ops_per_sec, mbytes_per_sec, cycles_op_str,
+			cycles_byte_str, (unsigned long long) p50, (unsigned long long) p90,
+			(unsigned long long) p99, (unsigned long long) max);
+	}
+	else {
+		printf ("%s,%s,%s,%zu,%zu,%.1f,%.2f,%s,%s,%llu,%llu,%llu,%llu\n", engine, backend,
+			operation, size, count, ops_per_sec, mbytes_per_sec, cycles_op_str, cycles_byte_str,
+			(unsigned long long) p50, (unsigned long long) p90, (unsigned long long) p99,
+			(unsigned long long) max);
+	}
+
+	fflush (stdout);
+	bench->reported++;
+}
+
+/**
+ * Measure the performance of a single crypto operation.  The operation is executed repeatedly until
+ * both the minimum number of samples and minimum measurement time have been reached, or until the
+ * maximum number of samples have been collected.  The latency of each execution is recorded
+ * individually to determine the latency distribution.
+ *
+ * The operation is executed once before measurement starts to check that it works and to warm up
+ * any caches.  Failures are reported to stderr and do not generate a result.
+ *
+ * @param bench The measurement context.
+ * @param engine The type of crypto engine being measured.
+ * @param backend The implementation of the crypto engine.
+ * @param operation The operation being measured.
+ * @param size The number of bytes processed by each operation.  For operations that don't process
+ * variable amounts of data, this is the size of the primary input.
+ * @param execute The function to execute the operation.  Any return value that is not an error is
+ * considered successful.
+ * @param context Context to pass to the operation.
+ *
+ * @return 0 if the operation was measured successfully or the error returned by the operation.
+ */
+int crypto_benchmark_run (struct crypto_benchmark *bench, const char *engine, const char *backend,
+	const char *operation, size_t size, crypto_benchmark_operation execute, void *context)
+{
+	uint64_t total_time = 0;
+	uint64_t total_cycles = 0;
+	uint64_t start_time;
+	uint64_t start_cycles;
+	uint64_t end_cycles;
+	size_t count = 0;
+	int status;
+
+	status = execute (context);
+	if (ROT_IS_ERROR (status)) {
+		fprintf (stderr, "%s,%s,%s,%zu: Failed to execute: 0x%x\n", engine, backend, operation,
+			size, status);
+		bench->failures++;
+		return status;
+	}
+
+	while ((count < bench->max_iterations) &&
+		((count < bench->min_iterations) || (total_time < bench->min_time))) {
+		start_time = crypto_benchmark_get_time ();
+		start_cycles = crypto_benchmark_get_cycles ();
+
+		status = execute (context);
+
+		end_cycles = crypto_benchmark_get_cycles ();
+		bench->samples[count] = crypto_benchmark_get_time () - start_time;
+
+		if (ROT_IS_ERROR (status)) {
+			fprintf (stderr, "%s,%s,%s,%zu: Failed on iteration %zu: 0x%x\n", engine, backend,
+				operation, size, count, status);
+			bench->failures++;
+			return status;
+		}
+
+		total_time += bench->samples[count];
+		total_cycles += end_cycles - start_cycles;
+		count++;
+	}
+
+	qsort (bench->samples, count, sizeof (bench->samples[0]), crypto_benchmark_compare_samples);
+	crypto_benchmark_report (bench, engine, backend, operation, size, count, total_time,
+		total_cycles);
+
+	return 0;
+}
+
+/**
+ * Select the measurement suites that should be run.
+ *
+ * @param list Comma separated list of engine types to run.
+ *
+ * @return 0 if the list was valid or -1 if an unknown engine type was specified.
+ */
+static int crypto_benchmark_select_suites (char *list)
+{
+	char *name;
+	size_t i;
+
+	for (i = 0; i < ARRAY_SIZE (suites); i++) {
+		suites[i].enabled = false;
+	}
+
+	for (name = strtok (list, ","); name != NULL; name = strtok (NULL, ",")) {
+		for (i = 0; i < ARRAY_SIZE (suites); i++) {
+			if (strcmp (name, suites[i].name) == 0) {
+				suites[i].enabled = true;
+				break;
+			}
+		}
+
+		if (i == ARRAY_SIZE (suites)) {
+			fprintf (stderr, "Unknown engine type: %s\n", name);
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * Display the command usage.
+ *
+ * @param name Name of the executable.
+ */
+static void crypto_benchmark_usage (const char *name)
+{
+	printf ("Usage: %s [-f csv|json] [-e <engines>] [-t <ms>] [-n <count>]\n", name);
+	printf ("  -f  Output format for the results.  Default is csv.\n");
+	printf ("  -e  Comma separated list of engine types to measure:\n");
+	printf ("        hash,hash_pool,ecc,rsa,aes,rng,x509 (default: all)\n");
+	printf ("  -t  Minimum time to spend on each measurement, in ms.  Default is %d.\n",
+		CRYPTO_BENCHMARK_DEFAULT_MIN_TIME_MS);
+	printf ("  -n  Maximum number of samples for each measurement.  Default is %d.\n",
+		CRYPTO_BENCHMARK_DEFAULT_MAX_ITERATIONS);
+}
+
+int main (int argc, char *argv[])
+{
+	struct crypto_benchmark bench;
+	long value;
+	size_t i;
+	int opt;
+	int status;
+
+	memset (&bench, 0, sizeof (bench));
+	bench.format = CRYPTO_BENCHMARK_FORMAT_CSV;
+	bench.min_time = CRYPTO_BENCHMARK_DEFAULT_MIN_TIME_MS * 1000000ULL;
+	bench.min_iterations = CRYPTO_BENCHMARK_MIN_ITERATIONS;
+	bench.max_iterations = CRYPTO_BENCHMARK_DEFAULT_MAX_ITERATIONS;
+
+	while ((opt = getopt (argc, argv, "f:e:t:n:h")) != -1) {
+		switch (opt) {
+			case 'f':
+				if (strcmp (optarg, "csv") == 0) {
+					bench.format = CRYPTO_BENCHMARK_FORMAT_CSV;
+				}
+				else if (strcmp (optarg, "json") == 0) {
+					bench.format = CRYPTO_BENCHMARK_FORMAT_JSON;
+				}
+				else {
+					fprintf (stderr, "Unknown output format: %s\n", optarg);
+					return 1;
+				}
+				break;
+
+			case 'e':
+				if (crypto_benchmark_select_suites (optarg) != 0) {
+					return 1;
+				}
+				break;
+
+			case 't':
+				value = strtol (optarg, NULL, 0);
+				if (value < 0) {
+					fprintf (stderr, "Invalid measurement time: %s\n", optarg);
+					return 1;
+				}
+
+				bench.min_time = value * 1000000ULL;
+				break;
+
+			case 'n':
+				value = strtol (optarg, NULL, 0);
+				if (value < CRYPTO_BENCHMARK_MIN_ITERATIONS) {
+					fprintf (stderr, "Sample count must be at least %d: %s\n",
+						CRYPTO_BENCHMARK_MIN_ITERATIONS, optarg);
+					return 1;
+				}
+
+				bench.max_iterations = value;
+				break;
+
+			case 'h':
+				crypto_benchmark_usage (argv[0]);
+				return 0;
+
+			default:
+				crypto_benchmark_usage (argv[0]);
+				return 1;
+		}
+	}
+
+	bench.samples = malloc (bench.max_iterations * sizeof (bench.samples[0]));
+	if (bench.samples == NULL) {
+		fprintf (stderr, "Failed to allocate sample storage\n");
+		return 1;
+	}
+
+	crypto_benchmark_start_report (&bench);
+
+	for (i = 0; i < ARRAY_SIZE (suites); i++) {
+		if (suites[i].enabled) {
+			status = suites[i].run (&bench);
+			if (status != 0) {
+				fprintf (stderr, "%s: Failed to run measurements: 0x%x\n", suites[i].name, status);
+				bench.failures++;
+			}
+		}
+	}
+
+	crypto_benchmark_end_report (&bench);
+
+	free (bench.samples);
+	return (bench.failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,66 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#ifndef CRYPTO_BENCHMARK_H_
+#define CRYPTO_BENCHMARK_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+
+/**
+ * Data sizes used for measurements of operations that process arbitrary amounts of data.
+ */
+#define	CRYPTO_BENCHMARK_DATA_SIZES		16, 64, 256, 1024, 8192, 16384
+
+/**
+ * The largest data size used for measurements.
+ */
+#define	CRYPTO_BENCHMARK_MAX_DATA_SIZE	16384
+
+
+/**
+ * Formats supported for reporting results.
+ */
+enum crypto_benchmark_format {
+	CRYPTO_BENCHMARK_FORMAT_CSV,		/**< One line of comma separated values per measurement. */
+	CRYPTO_BENCHMARK_FORMAT_JSON,		/**< A JSON array with one object per measurement. */
+};
+
+/**
+ * Function that executes a single instance of the operation being measured.
+ *
+ * @param context Context for the operation.
+ *
+ * @return 0 if the operation completed successfully or an error code.
+ */
+typedef int (*crypto_benchmark_operation) (void *context);
+
+/**
+ * Configuration and state for running measurements.
+ */
+struct crypto_benchmark {
+	enum crypto_benchmark_format format;	/**< Format to use for reporting results. */
+	uint64_t min_time;						/**< Minimum time for each measurement, in ns. */
+	size_t min_iterations;					/**< Minimum samples for each measurement. */
+	size_t max_iterations;					/**< Maximum samples for each measurement. */
+	uint64_t *samples;						/**< Storage for latency samples. */
+	size_t reported;						/**< The number of measurements reported. */
+	int failures;							/**< The number of measurements that failed. */
+};
+
+
+int crypto_benchmark_run (struct crypto_benchmark *bench, const char *engine, const char *backend,
+	const char *operation, size_t size, crypto_benchmark_operation execute, void *context);
+
+int crypto_benchmark_hash (struct crypto_benchmark *bench);
+int crypto_benchmark_hash_pool (struct crypto_benchmark *bench);
+int crypto_benchmark_ecc (struct crypto_benchmark *bench);
+int crypto_benchmark_rsa (struct crypto_benchmark *bench);
+int crypto_benchmark_aes (struct crypto_benchmark *bench);
+int crypto_benchmark_rng (struct crypto_benchmark *bench);
+int crypto_benchmark_x509 (struct crypto_benchmark *bench);
+
+
+#endif /* CRYPTO_BENCHMARK_H_ */
@@ -0,0 +1,149 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdio.h>
+#include <string.h>
+#include "crypto_benchmark.h"
+#include "common/array_size.h"
+#include "crypto/aes.h"
+#include "crypto/aes_mbedtls.h"
+#include "crypto/aes_openssl.h"
+
+
+/**
+ * Length of the IV used for measurements.
+ */
+#define	CRYPTO_BENCHMARK_AES_IV_LENGTH		12
+
+/**
+ * Length of the GCM tag.
+ */
+#define	CRYPTO_BENCHMARK_AES_TAG_LENGTH		16
+
+
+/**
+ * Context for an AES measurement.
+ */
+struct crypto_benchmark_aes_context {
+	struct aes_engine *engine;								/**< The AES engine being measured. */
+	const uint8_t *plaintext;								/**< The data to encrypt. */
+	uint8_t *ciphertext;									/**< Buffer for encrypted data. */
+	uint8_t *output;										/**< Buffer for decrypted data. */
+	size_t length;											/**< Length of the data. */
+	uint8_t iv[CRYPTO_BENCHMARK_AES_IV_LENGTH];				/**< IV for the operation. */
+	uint8_t tag[CRYPTO_BENCHMARK_AES_TAG_LENGTH];			/**< GCM tag for the ciphertext. */
+};
+
+
+/**
+ * Encrypt data with AES-GCM.
+ *
+ * @param context The AES measurement context.
+ *
+ * @return 0 if the data was encrypted or an error code.
+ */
+static int crypto_benchmark_aes_encrypt (void *context)
+{
+	struct crypto_benchmark_aes_context *aes = context;
+
+	return aes->engine->encrypt_data (aes->engine, aes->plaintext, aes->length, aes->iv,
+		sizeof (aes->iv), aes->ciphertext, aes->length, aes->tag, sizeof (aes->tag));
+}
+
+/**
+ * Decrypt and authenticate data with AES-GCM.
+ *
+ * @param context The AES measurement context.
+ *
+ * @return 0 if the data was decrypted or an error code.
+ */
+static int crypto_benchmark_aes_decrypt (void *context)
+{
+	struct crypto_benchmark_aes_context *aes = context;
+
+	return aes->engine->decrypt_data (aes->engine, aes->ciphertext, aes->length, aes->tag,
+		aes->iv, sizeof (aes->iv), aes->output, aes->length);
+}
+
+/**
+ * Measure AES-GCM encryption and decryption for a single AES engine.
+ *
+ * @param bench The measurement context.
+ * @param engine The AES engine to measure.
+ * @param backend Name of the AES engine implementation.
+ * @param context Buffers to use for the measurements.
+ */
+static void crypto_benchmark_aes_engine (struct crypto_benchmark *bench, struct aes_engine *engine,
+	const char *backend, struct crypto_benchmark_aes_context *context)
+{
+	static const size_t sizes[] = {CRYPTO_BENCHMARK_DATA_SIZES};
+	uint8_t key[AES256_KEY_LENGTH];
+	size_t i;
+	int status;
+
+	memset (key, 0x96, sizeof (key));
+
+	status = engine->set_key (engine, key, sizeof (key));
+	if (status != 0) {
+		fprintf (stderr, "aes,%s: Failed to set key: 0x%x\n", backend, status);
+		bench->failures++;
+		return;
+	}
+
+	context->engine = engine;
+
+	for (i = 0; i < ARRAY_SIZE (sizes); i++) {
+		context->length = sizes[i];
+
+		/* Encryption is always run first, so decryption will have valid ciphertext. */
+		status = crypto_benchmark_run (bench, "aes", backend, "gcm256_encrypt", sizes[i],
+			crypto_benchmark_aes_encrypt, context);
+		if (status == 0) {
+			crypto_benchmark_run (bench, "aes", backend, "gcm256_decrypt", sizes[i],
+				crypto_benchmark_aes_decrypt, context);
+		}
+	}
+}
+
+/**
+ * Measure each AES engine available on the Linux platform.
+ *
+ * @param bench The measurement context.
+ *
+ * @return 0 if the measurements were run or an error code.
+ */
+int crypto_benchmark_aes (struct crypto_benchmark *bench)
+{
+	static uint8_t plaintext[CRYPTO_BENCHMARK_MAX_DATA_SIZE];
+	static uint8_t ciphertext[CRYPTO_BENCHMARK_MAX_DATA_SIZE];
+	static uint8_t output[CRYPTO_BENCHMARK_MAX_DATA_SIZE];
+	struct aes_engine_openssl openssl;
+	struct aes_engine_mbedtls mbedtls;
+	struct crypto_benchmark_aes_context context;
+	int status;
+
+	memset (&context, 0, sizeof (context));
+	memset (plaintext, 0x5a, sizeof (plaintext));
+	memset (context.iv, 0x69, sizeof (context.iv));
+	context.plaintext = plaintext;
+	context.ciphertext = ciphertext;
+	context.output = output;
+
+	status = aes_openssl_init (&openssl);
+	if (status != 0) {
+		return status;
+	}
+
+	crypto_benchmark_aes_engine (bench, &openssl.base, "openssl", &context);
+	aes_openssl_release (&openssl);
+
+	status = aes_mbedtls_init (&mbedtls);
+	if (status != 0) {
+		return status;
+	}
+
+	crypto_benchmark_aes_engine (bench, &mbedtls.base, "mbedtls", &context);
+	aes_mbedtls_release (&mbedtls);
+
+	return 0;
+}
@@ -0,0 +1,328 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdio.h>
+#include <string.h>
+#include "crypto_benchmark.h"
+#include "platform_api.h"
+#include "asn1/ecc_der_util.h"
+#include "common/array_size.h"
+#include "crypto/ecc.h"
+#include "crypto/ecc_mbedtls.h"
+#include "crypto/ecc_openssl.h"
+#include "crypto/hash.h"
+#include "crypto/rng_openssl.h"
+#include "riot/ecc_riot.h"
+
+
+/**
+ * Context for an ECC measurement.
+ */
+struct crypto_benchmark_ecc_context {
+	struct ecc_engine *engine;						/**< The ECC engine being measured. */
+	struct ecc_private_key priv_key;				/**< The key pair used for measurements. */
+	struct ecc_public_key pub_key;					/**< Public key for the key pair. */
+	struct ecc_public_key peer_key;					/**< Public key of the ECDH peer. */
+	uint8_t digest[SHA512_HASH_LENGTH];				/**< The digest to sign. */
+	size_t length;									/**< Length of the digest. */
+	uint8_t signature[ECC_DER_ECDSA_MAX_LENGTH];	/**< The signature to verify. */
+	size_t sig_length;								/**< Length of the signature. */
+	uint8_t output[ECC_DER_ECDSA_MAX_LENGTH];		/**< Output for generated values. */
+};
+
+/**
+ * A set of key pairs for measuring a single curve.  The keys are shared by every ECC engine.
+ */
+struct crypto_benchmark_ecc_keys {
+	const char *curve;								/**< Name of the curve. */
+	uint8_t *priv_der;								/**< DER encoded key pair for measurements. */
+	size_t priv_length;								/**< Length of the key pair. */
+	uint8_t *peer_der;								/**< DER encoded key pair for an ECDH peer. */
+	size_t peer_length;								/**< Length of the ECDH peer key pair. */
+	uint8_t digest[SHA512_HASH_LENGTH];				/**< The digest to sign. */
+	size_t length;									/**< Length of the digest. */
+	uint8_t signature[ECC_DER_ECDSA_MAX_LENGTH];	/**< Reference signature of the digest. */
+	size_t sig_length;								/**< Length of the reference signature. */
+};
+
+/**
+ * Curves to measure.
+ */
+static const struct {
+	const char *name;								/**< Name of the curve. */
+	size_t key_length;								/**< Length of the private key. */
+	size_t digest_length;							/**< Length of the digest to sign. */
+} crypto_benchmark_ecc_curves[] = {
+	{"p256", ECC_KEY_LENGTH_256, SHA256_HASH_LENGTH},
+#if ECC_MAX_KEY_LENGTH >= ECC_KEY_LENGTH_384
+	{"p384", ECC_KEY_LENGTH_384, SHA384_HASH_LENGTH},
+#endif
+#if ECC_MAX_KEY_LENGTH >= ECC_KEY_LENGTH_521
+	{"p521", ECC_KEY_LENGTH_521, SHA512_HASH_LENGTH},
+#endif
+};
+
+
+/**
+ * Generate an ECDSA signature.
+ *
+ * @param context The ECC measurement context.
+ *
+ * @return The signature length or an error code.
+ */
+static int crypto_benchmark_ecc_sign (void *context)
+{
+	struct crypto_benchmark_ecc_context *ecc = context;
+
+	return ecc->engine->sign (ecc->engine, &ecc->priv_key, ecc->digest, ecc->length, ecc->output,
+		sizeof (ecc->output));
+}
+
+/**
+ * Verify an ECDSA signature.
+ *
+ * @param context The ECC measurement context.
+ *
+ * @return 0 if the signature is valid or an error code.
+ */
+static int crypto_benchmark_ecc_verify (void *context)
+{
+	struct crypto_benchmark_ecc_context *ecc = context;
+
+	return ecc->engine->verify (ecc->engine, &ecc->pub_key, ecc->digest, ecc->length,
+		ecc->signature, ecc->sig_length);
+}
+
+#ifdef ECC_ENABLE_ECDH
+/**
+ * Generate an ECDH shared secret.
+ *
+ * @param context The ECC measurement context.
+ *
+ * @return The length of the secret or an error code.
+ */
+static int crypto_benchmark_ecc_ecdh (void *context)
+{
+	struct crypto_benchmark_ecc_context *ecc = context;
+
+	return ecc->engine->compute_shared_secret (ecc->engine, &ecc->priv_key, &ecc->peer_key,
+		ecc->output, sizeof (ecc->output));
+}
+#endif
+
+/**
+ * Generate a random key pair in DER format.
+ *
+ * @param ecc The ECC engine to use for key generation.
+ * @param key_length Length of the key to generate.
+ * @param der Output for the DER encoded key pair.  This must be freed by the caller.
+ * @param length Output for the length of the key pair.
+ *
+ * @return 0 if the key was generated successfully or an error code.
+ */
+static int crypto_benchmark_ecc_generate_key (struct ecc_engine *ecc, size_t key_length,
+	uint8_t **der, size_t *length)
+{
+	struct ecc_private_key priv_key;
+	int status;
+
+	status = ecc->generate_key_pair (ecc, key_length, &priv_key, NULL);
+	if (status != 0) {
+		return status;
+	}
+
+	status = ecc->get_private_key_der (ecc, &priv_key, der, length);
+	ecc->release_key_pair (ecc, &priv_key, NULL);
+
+	return status;
+}
+
+/**
+ * Generate the keys and reference signature used to measure a curve.
+ *
+ * @param ecc The ECC engine to use for key and signature generation.
+ * @param curve Index of the curve to generate keys for.
+ * @param keys Output for the generated keys.
+ *
+ * @return 0 if the keys were generated successfully or an error code.
+ */
+static int crypto_benchmark_ecc_generate_keys (struct ecc_engine *ecc, size_t curve,
+	struct crypto_benchmark_ecc_keys *keys)
+{
+	struct ecc_private_key priv_key;
+	int status;
+
+	memset (keys, 0, sizeof (*keys));
+	keys->curve = crypto_benchmark_ecc_curves[curve].name;
+	keys->length = crypto_benchmark_ecc_curves[curve].digest_length;
+	memset (keys->digest, 0xa5, keys->length);
+
+	status = crypto_benchmark_ecc_generate_key (ecc, crypto_benchmark_ecc_curves[curve].key_length,
+		&keys->priv_der, &keys->priv_length);
+	if (status != 0) {
+		return status;
+	}
+
+	status = crypto_benchmark_ecc_generate_key (ecc, crypto_benchmark_ecc_curves[curve].key_length,
+		&keys->peer_der, &keys->peer_length);
+	if (status != 0) {
+		return status;
+	}
+
+	status = ecc->init_key_pair (ecc, keys->priv_der, keys->priv_length, &priv_key, NULL);
+	if (status != 0) {
+		return status;
+	}
+
+	status = ecc->sign (ecc, &priv_key, keys->digest, keys->length, keys->signature,
+		sizeof (keys->signature));
+	ecc->release_key_pair (ecc, &priv_key, NULL);
+
+	if (ROT_IS_ERROR (status)) {
+		return status;
+	}
+
+	keys->sig_length = status;
+	return 0;
+}
+
+/**
+ * Release the keys used to measure a curve.
+ *
+ * @param keys The keys to release.
+ */
+static void crypto_benchmark_ecc_release_keys (struct crypto_benchmark_ecc_keys *keys)
+{
+	platform_free (keys->priv_der);
+	platform_free (keys->peer_der);
+}
+
+/**
+ * Measure the ECC operations for a single curve on a single ECC engine.  Operations not supported
+ * by the engine are skipped.
+ *
+ * @param bench The measurement context.
+ * @param engine The ECC engine to measure.
+ * @param backend Name of the ECC engine implementation.
+ * @param keys The keys to use for the measurements.
+ */
+static void crypto_benchmark_ecc_engine (struct crypto_benchmark *bench, struct ecc_engine *engine,
+	const char *backend, const struct crypto_benchmark_ecc_keys *keys)
+{
+	struct crypto_benchmark_ecc_context context;
+	char operation[32];
+	int status;
+
+	memset (&context, 0, sizeof (context));
+	context.engine = engine;
+	memcpy (context.digest, keys->digest, keys->length);
+	context.length = keys->length;
+	memcpy (context.signature, keys->signature, keys->sig_length);
+	context.sig_length = keys->sig_length;
+
+	status = engine->init_key_pair (engine, keys->priv_der, keys->priv_length, &context.priv_key,
+		&context.pub_key);
+	if (status != 0) {
+		fprintf (stderr, "ecc,%s,%s: Failed to load key pair: 0x%x\n", backend, keys->curve,
+			status);
+		bench->failures++;
+		return;
+	}
+
+	snprintf (operation, sizeof (operation), "ecdsa_sign_%s", keys->curve);
+	crypto_benchmark_run (bench, "ecc", backend, operation, keys->length,
+		crypto_benchmark_ecc_sign, &context);
+
+	snprintf (operation, sizeof (operation), "ecdsa_verify_%s", keys->curve);
+	crypto_benchmark_run (bench, "ecc", backend, operation, keys->length,
+		crypto_benchmark_ecc_verify, &context);
+
+#ifdef ECC_ENABLE_ECDH
+	if (engine->compute_shared_secret != NULL) {
+		status = engine->init_key_pair (engine, keys->peer_der, keys->peer_length, NULL,
+			&context.peer_key);
+		if (status == 0) {
+			snprintf (operation, sizeof (operation), "ecdh_%s", keys->curve);
+			crypto_benchmark_run (bench, "ecc", backend, operation, keys->length,
+				crypto_benchmark_ecc_ecdh, &context);
+
+			engine->release_key_pair (engine, NULL, &context.peer_key);
+		}
+		else {
+			fprintf (stderr, "ecc,%s,%s: Failed to load ECDH peer key: 0x%x\n", backend,
+				keys->curve, status);
+			bench->failures++;
+		}
+	}
+#endif
+
+	engine->release_key_pair (engine, &context.priv_key, &context.pub_key);
+}
+
+/**
+ * Measure each ECC engine available on the Linux platform.  The RIoT engine is only measured for
+ * P-256, since that is the only curve it supports.  There is no ECC hardware available on Linux,
+ * so the ECC-HW engine is not measured.
+ *
+ * @param bench The measurement context.
+ *
+ * @return 0 if the measurements were run or an error code.
+ */
+int crypto_benchmark_ecc (struct crypto_benchmark *bench)
+{
+	struct ecc_engine_openssl openssl;
+	struct ecc_engine_mbedtls mbedtls;
+	struct ecc_engine_riot riot;
+	struct rng_engine_openssl rng;
+	struct crypto_benchmark_ecc_keys keys;
+	size_t i;
+	int status;
+
+	status = ecc_openssl_init (&openssl);
+	if (status != 0) {
+		return status;
+	}
+
+	status = ecc_mbedtls_init (&mbedtls);
+	if (status != 0) {
+		goto release_openssl;
+	}
+
+	status = rng_openssl_init (&rng);
+	if (status != 0) {
+		goto release_mbedtls;
+	}
+
+	status = ecc_riot_init (&riot, &rng.base);
+	if (status != 0) {
+		goto release_rng;
+	}
+
+	for (i = 0; i < ARRAY_SIZE (crypto_benchmark_ecc_curves); i++) {
+		status = crypto_benchmark_ecc_generate_keys (&openssl.base, i, &keys);
+		if (status != 0) {
+			crypto_benchmark_ecc_release_keys (&keys);
+			goto release_riot;
+		}
+
+		crypto_benchmark_ecc_engine (bench, &openssl.base, "openssl", &keys);
+		crypto_benchmark_ecc_engine (bench, &mbedtls.base, "mbedtls", &keys);
+
+		if (crypto_benchmark_ecc_curves[i].key_length == ECC_KEY_LENGTH_256) {
+			crypto_benchmark_ecc_engine (bench, &riot.base, "riot", &keys);
+		}
+
+		crypto_benchmark_ecc_release_keys (&keys);
+	}
+
+release_riot:
+	ecc_riot_release (&riot);
+release_rng:
+	rng_openssl_release (&rng);
+release_mbedtls:
+	ecc_mbedtls_release (&mbedtls);
+release_openssl:
+	ecc_openssl_release (&openssl);
+
+	return status;
+}
@@ -0,0 +1,174 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdio.h>
+#include <string.h>
+#include "crypto_benchmark.h"
+#include "common/array_size.h"
+#include "crypto/hash.h"
+#include "crypto/hash_mbedtls.h"
+#include "crypto/hash_native.h"
+#include "crypto/hash_openssl.h"
+#include "riot/hash_riot.h"
+
+
+/**
+ * Context for a hash measurement.
+ */
+struct crypto_benchmark_hash_context {
+	struct hash_engine *engine;					/**< The hash engine being measured. */
+	enum hash_type type;						/**< The type of hash to calculate. */
+	const uint8_t *data;						/**< The data to hash. */
+	size_t length;								/**< Length of the data. */
+	uint8_t digest[SHA512_HASH_LENGTH];			/**< Output for the calculated digest. */
+};
+
+/**
+ * Hash algorithms to measure.
+ */
+static const struct {
+	const char *name;							/**< Name of the algorithm. */
+	enum hash_type type;						/**< The hash type identifier. */
+} crypto_benchmark_hash_algorithms[] = {
+#ifdef HASH_ENABLE_SHA1
+	{"sha1", HASH_TYPE_SHA1},
+#endif
+	{"sha256", HASH_TYPE_SHA256},
+#ifdef HASH_ENABLE_SHA384
+	{"sha384", HASH_TYPE_SHA384},
+#endif
+#ifdef HASH_ENABLE_SHA512
+	{"sha512", HASH_TYPE_SHA512},
+#endif
+};
+
+
+/**
+ * Calculate a single digest.
+ *
+ * @param context The hash measurement context.
+ *
+ * @return The digest length or an error code.
+ */
+static int crypto_benchmark_hash_calculate (void *context)
+{
+	struct crypto_benchmark_hash_context *hash = context;
+
+	return hash_calculate (hash->engine, hash->type, hash->data, hash->length, hash->digest,
+		sizeof (hash->digest));
+}
+
+/**
+ * Determine if a hash engine implements an algorithm.  Not every engine provides every algorithm.
+ *
+ * @param engine The hash engine to query.
+ * @param type The hash algorithm to check.
+ * @param data Data buffer to use for hashing.
+ *
+ * @return true if the algorithm is implemented by the engine.
+ */
+static bool crypto_benchmark_hash_is_supported (struct hash_engine *engine, enum hash_type type,
+	const uint8_t *data)
+{
+	uint8_t digest[SHA512_HASH_LENGTH];
+
+	return (hash_calculate (engine, type, data, 1, digest, sizeof (digest)) !=
+		HASH_ENGINE_UNSUPPORTED_HASH);
+}
+
+/**
+ * Measure every supported hash algorithm for a single hash engine.
+ *
+ * @param bench The measurement context.
+ * @param engine The hash engine to measure.
+ * @param backend Name of the hash engine implementation.
+ * @param data Data buffer to use for hashing.
+ */
+static void crypto_benchmark_hash_engine (struct crypto_benchmark *bench,
+	struct hash_engine *engine, const char *backend, const uint8_t *data)
+{
+	static const size_t sizes[] = {CRYPTO_BENCHMARK_DATA_SIZES};
+	struct crypto_benchmark_hash_context context;
+	size_t i;
+	size_t j;
+
+	context.engine = engine;
+	context.data = data;
+
+	for (i = 0; i < ARRAY_SIZE (crypto_benchmark_hash_algorithms); i++) {
+		context.type = crypto_benchmark_hash_algorithms[i].type;
+
+		if (!crypto_benchmark_hash_is_supported (engine, context.type, data)) {
+			continue;
+		}
+
+		for (j = 0; j < ARRAY_SIZE (sizes); j++) {
+			context.length = sizes[j];
+
+			crypto_benchmark_run (bench, "hash", backend, crypto_benchmark_hash_algorithms[i].name,
+				sizes[j], crypto_benchmark_hash_calculate, &context);
+		}
+	}
+}
+
+/**
+ * Measure each hash engine available on the Linux platform.  The native engine is measured both
+ * with any available CPU acceleration and with the portable implementation.
+ *
+ * @param bench The measurement context.
+ *
+ * @return 0 if the measurements were run or an error code.
+ */
+int crypto_benchmark_hash (struct crypto_benchmark *bench)
+{
+	static uint8_t data[CRYPTO_BENCHMARK_MAX_DATA_SIZE];
+	struct hash_engine_openssl openssl;
+	struct hash_engine_mbedtls mbedtls;
+	struct hash_engine_riot riot;
+	struct hash_engine_native native;
+	int status;
+
+	memset (data, 0x5a, sizeof (data));
+
+	status = hash_openssl_init (&openssl);
+	if (status != 0) {
+		return status;
+	}
+
+	crypto_benchmark_hash_engine (bench, &openssl.base, "openssl", data);
+	hash_openssl_release (&openssl);
+
+	status = hash_mbedtls_init (&mbedtls);
+	if (status != 0) {
+		return status;
+	}
+
+	crypto_benchmark_hash_engine (bench, &mbedtls.base, "mbedtls", data);
+	hash_mbedtls_release (&mbedtls);
+
+	status = hash_riot_init (&riot);
+	if (status != 0) {
+		return status;
+	}
+
+	crypto_benchmark_hash_engine (bench, &riot.base, "riot", data);
+	hash_riot_release (&riot);
+
+	status = hash_native_init (&native);
+	if (status != 0) {
+		return status;
+	}
+
+	crypto_benchmark_hash_engine (bench, &native.base, "native", data);
+	hash_native_release (&native);
+
+	status = hash_native_init_with_features (&native, 0);
+	if (status != 0) {
+		return status;
+	}
+
+	crypto_benchmark_hash_engine (bench, &native.base, "native_portable", data);
+	hash_native_release (&native);
+
+	return 0;
+}
@@ -0,0 +1,217 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include "crypto_benchmark.h"
+#include "common/array_size.h"
+#include "crypto/hash.h"
+#include "crypto/hash_openssl.h"
+#include "crypto/hash_pool.h"
+#include "crypto/hash_thread_safe.h"
+#include "status/rot_status.h"
+
+
+/**
+ * The maximum number of tasks that will hash at the same time.
+ */
+#define	CRYPTO_BENCHMARK_HASH_POOL_MAX_THREADS		8
+
+/**
+ * The number of hashes each task calculates for a single measurement sample.
+ */
+#define	CRYPTO_BENCHMARK_HASH_POOL_BATCH			16
+
+/**
+ * The amount of data hashed by each calculation.
+ */
+#define	CRYPTO_BENCHMARK_HASH_POOL_DATA_SIZE		8192
+
+
+/**
+ * Context for a single task hashing data.
+ */
+struct crypto_benchmark_hash_pool_thread {
+	pthread_t thread;							/**< The thread executing the hashes. */
+	struct hash_engine *engine;					/**< The hash engine used by the task. */
+	const uint8_t *data;						/**< The data to hash. */
+	uint8_t digest[SHA256_HASH_LENGTH];			/**< Output for the calculated digest. */
+	int status;									/**< Result of the hash calculations. */
+};
+
+/**
+ * Context for a measurement of concurrent hashing.
+ */
+struct crypto_benchmark_hash_pool_context {
+	struct crypto_benchmark_hash_pool_thread threads[CRYPTO_BENCHMARK_HASH_POOL_MAX_THREADS];	/**< Context for each hashing task. */
+	size_t count;								/**< The number of tasks hashing at the same time. */
+};
+
+
+/**
+ * Calculate a batch of SHA-256 digests from a single task.
+ *
+ * @param arg The task context.
+ *
+ * @return Unused.
+ */
+static void* crypto_benchmark_hash_pool_thread (void *arg)
+{
+	struct crypto_benchmark_hash_pool_thread *task = arg;
+	int i;
+
+	task->status = 0;
+	for (i = 0; (i < CRYPTO_BENCHMARK_HASH_POOL_BATCH) && !ROT_IS_ERROR (task->status); i++) {
+		task->status = hash_calculate (task->engine, HASH_TYPE_SHA256, task->data,
+			CRYPTO_BENCHMARK_HASH_POOL_DATA_SIZE, task->digest, sizeof (task->digest));
+	}
+
+	return NULL;
+}
+
+/**
+ * Run a batch of hashes from multiple tasks at the same time.
+ *
+ * @param context The concurrent hashing context.
+ *
+ * @return 0 if all hashes were calculated successfully or an error code.
+ */
+static int crypto_benchmark_hash_pool_run_batch (void *context)
+{
+	struct crypto_benchmark_hash_pool_context *batch = context;
+	size_t started;
+	size_t i;
+	int status = 0;
+
+	for (started = 0; started < batch->count; started++) {
+		if (pthread_create (&batch->threads[started].thread, NULL,
+			crypto_benchmark_hash_pool_thread, &batch->threads[started]) != 0) {
+			status = HASH_ENGINE_NO_MEMORY;
+			break;
+		}
+	}
+
+	for (i = 0; i < started; i++) {
+		pthread_join (batch->threads[i].thread, NULL);
+		if ((status == 0) && ROT_IS_ERROR (batch->threads[i].status)) {
+			status = batch->threads[i].status;
+		}
+	}
+
+	return status;
+}
+
+/**
+ * Measure concurrent hashing from multiple tasks.
+ *
+ * @param bench The measurement context.
+ * @param backend Name of the engine configuration being measured.
+ * @param engines The hash engine to use for each task.
+ * @param count The number of tasks hashing at the same time.
+ * @param data Data buffer to use for hashing.
+ */
+static void crypto_benchmark_hash_pool_measure (struct crypto_benchmark *bench, const char *backend,
+	struct hash_engine **engines, size_t count, const uint8_t *data)
+{
+	struct crypto_benchmark_hash_pool_context context;
+	char operation[32];
+	size_t i;
+
+	memset (&context, 0, sizeof (context));
+	for (i = 0; i < count; i++) {
+		context.threads[i].engine = engines[i];
+		context.threads[i].data = data;
+	}
+	context.count = count;
+
+	snprintf (operation, sizeof (operation), "sha256_%zu_tasks", count);
+
+	crypto_benchmark_run (bench, "hash_pool", backend, operation,
+		CRYPTO_BENCHMARK_HASH_POOL_DATA_SIZE * CRYPTO_BENCHMARK_HASH_POOL_BATCH * count,
+		crypto_benchmark_hash_pool_run_batch, &context);
+}
+
+/**
+ * Compare concurrent hashing through a single engine protected by a mutex against hashing through
+ * a pool of engines.  Each measurement sample has every task calculate a fixed number of SHA-256
+ * digests, so the reported size is the total data hashed by all tasks.
+ *
+ * @param bench The measurement context.
+ *
+ * @return 0 if the measurements were run or an error code.
+ */
+int crypto_benchmark_hash_pool (struct crypto_benchmark *bench)
+{
+	static const size_t task_counts[] = {1, 2, 4, CRYPTO_BENCHMARK_HASH_POOL_MAX_THREADS};
+	static uint8_t data[CRYPTO_BENCHMARK_HASH_POOL_DATA_SIZE];
+	struct hash_engine_openssl openssl[CRYPTO_BENCHMARK_HASH_POOL_MAX_THREADS];
+	struct hash_engine *backends[CRYPTO_BENCHMARK_HASH_POOL_MAX_THREADS];
+	struct hash_engine_thread_safe thread_safe;
+	struct hash_pool_state pool_state;
+	struct hash_pool pool;
+	struct hash_engine_pooled pooled[CRYPTO_BENCHMARK_HASH_POOL_MAX_THREADS];
+	struct hash_engine *engines[CRYPTO_BENCHMARK_HASH_POOL_MAX_THREADS];
+	struct hash_pool_stats stats;
+	size_t initialized = 0;
+	size_t i;
+	size_t j;
+	int status;
+
+	memset (data, 0x5a, sizeof (data));
+
+	for (initialized = 0; initialized < ARRAY_SIZE (openssl); initialized++) {
+		status = hash_openssl_init (&openssl[initialized]);
+		if (status != 0) {
+			goto release_backends;
+		}
+
+		backends[initialized] = &openssl[initialized].base;
+	}
+
+	status = hash_thread_safe_init (&thread_safe, backends[0]);
+	if (status != 0) {
+		goto release_backends;
+	}
+
+	for (i = 0; i < ARRAY_SIZE (task_counts); i++) {
+		for (j = 0; j < task_counts[i]; j++) {
+			engines[j] = &thread_safe.base;
+		}
+
+		crypto_benchmark_hash_pool_measure (bench, "thread_safe", engines, task_counts[i], data);
+	}
+
+	hash_thread_safe_release (&thread_safe);
+
+	for (i = 0; i < ARRAY_SIZE (task_counts); i++) {
+		status = hash_pool_init (&pool, &pool_state, backends, task_counts[i]);
+		if (status != 0) {
+			goto release_backends;
+		}
+
+		for (j = 0; j < task_counts[i]; j++) {
+			hash_pool_engine_init (&pooled[j], &pool);
+			engines[j] = &pooled[j].base;
+		}
+
+		crypto_benchmark_hash_pool_measure (bench, "pool", engines, task_counts[i], data);
+
+		hash_pool_get_stats (&pool, &stats);
+		fprintf (stderr, "hash_pool,pool,sha256_%zu_tasks: acquired=%u, contended=%u, "
+			"max_wait_ms=%u, max_in_use=%u\n", task_counts[i], stats.acquired, stats.contended,
+			stats.max_wait_ms, stats.max_in_use);
+
+		for (j = 0; j < task_counts[i]; j++) {
+			hash_pool_engine_release (&pooled[j]);
+		}
+		hash_pool_release (&pool);
+	}
+
+release_backends:
+	for (i = 0; i < initialized; i++) {
+		hash_openssl_release (&openssl[i]);
+	}
+
+	return status;
+}
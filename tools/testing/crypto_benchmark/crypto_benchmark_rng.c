@@ -0,0 +1,101 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdio.h>
+#include <string.h>
+#include "crypto_benchmark.h"
+#include "common/array_size.h"
+#include "crypto/rng.h"
+#include "crypto/rng_mbedtls.h"
+#include "crypto/rng_openssl.h"
+
+
+/**
+ * Largest request measured for random data generation.  mbedTLS limits a single DRBG request to
+ * 1024 bytes, so the larger standard data sizes are not used.
+ */
+#define	CRYPTO_BENCHMARK_RNG_MAX_SIZE	1024
+
+
+/**
+ * Context for an RNG measurement.
+ */
+struct crypto_benchmark_rng_context {
+	struct rng_engine *engine;		/**< The RNG engine being measured. */
+	uint8_t *buffer;				/**< Output for the random data. */
+	size_t length;					/**< Amount of random data to generate. */
+};
+
+
+/**
+ * Generate a buffer of random data.
+ *
+ * @param context The RNG measurement context.
+ *
+ * @return 0 if the random data was generated or an error code.
+ */
+static int crypto_benchmark_rng_generate (void *context)
+{
+	struct crypto_benchmark_rng_context *rng = context;
+
+	return rng->engine->generate_random_buffer (rng->engine, rng->length, rng->buffer);
+}
+
+/**
+ * Measure random data generation for a single RNG engine.
+ *
+ * @param bench The measurement context.
+ * @param engine The RNG engine to measure.
+ * @param backend Name of the RNG engine implementation.
+ * @param buffer Output buffer for the random data.
+ */
+static void crypto_benchmark_rng_engine (struct crypto_benchmark *bench, struct rng_engine *engine,
+	const char *backend, uint8_t *buffer)
+{
+	static const size_t sizes[] = {16, 64, 256, CRYPTO_BENCHMARK_RNG_MAX_SIZE};
+	struct crypto_benchmark_rng_context context;
+	size_t i;
+
+	context.engine = engine;
+	context.buffer = buffer;
+
+	for (i = 0; i < ARRAY_SIZE (sizes); i++) {
+		context.length = sizes[i];
+
+		crypto_benchmark_run (bench, "rng", backend, "generate", sizes[i],
+			crypto_benchmark_rng_generate, &context);
+	}
+}
+
+/**
+ * Measure each RNG engine available on the Linux platform.
+ *
+ * @param bench The measurement context.
+ *
+ * @return 0 if the measurements were run or an error code.
+ */
+int crypto_benchmark_rng (struct crypto_benchmark *bench)
+{
+	static uint8_t buffer[CRYPTO_BENCHMARK_RNG_MAX_SIZE];
+	struct rng_engine_openssl openssl;
+	struct rng_engine_mbedtls mbedtls;
+	int status;
+
+	status = rng_openssl_init (&openssl);
+	if (status != 0) {
+		return status;
+	}
+
+	crypto_benchmark_rng_engine (bench, &openssl.base, "openssl", buffer);
+	rng_openssl_release (&openssl);
+
+	status = rng_mbedtls_init (&mbedtls);
+	if (status != 0) {
+		return status;
+	}
+
+	crypto_benchmark_rng_engine (bench, &mbedtls.base, "mbedtls", buffer);
+	rng_mbedtls_release (&mbedtls);
+
+	return 0;
+}
@@ -0,0 +1,300 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdio.h>
+#include <string.h>
+#include <openssl/evp.h>
+#include <openssl/rsa.h>
+#include <openssl/x509.h>
+#include "crypto_benchmark.h"
+#include "platform_api.h"
+#include "common/array_size.h"
+#include "crypto/hash.h"
+#include "crypto/rsa.h"
+#include "crypto/rsa_mbedtls.h"
+#include "crypto/rsa_openssl.h"
+
+
+/**
+ * Context for an RSA measurement.
+ */
+struct crypto_benchmark_rsa_context {
+	struct rsa_engine *engine;					/**< The RSA engine being measured. */
+	struct rsa_private_key priv_key;			/**< The private key used for decryption. */
+	struct rsa_public_key pub_key;				/**< The public key used for verification. */
+	const uint8_t *digest;						/**< The signed digest. */
+	const uint8_t *signature;					/**< The signature to verify. */
+	size_t sig_length;							/**< Length of the signature. */
+	const uint8_t *ciphertext;					/**< The data to decrypt. */
+	size_t cipher_length;						/**< Length of the encrypted data. */
+	uint8_t output[RSA_MAX_KEY_LENGTH];			/**< Output for decrypted data. */
+};
+
+/**
+ * The keys and reference data used to measure a single key length.  These are shared by every
+ * RSA engine.
+ */
+struct crypto_benchmark_rsa_keys {
+	const char *name;							/**< Name of the key length. */
+	size_t key_length;							/**< Length of the key, in bytes. */
+	uint8_t *priv_der;							/**< DER encoded private key. */
+	size_t priv_length;							/**< Length of the private key. */
+	uint8_t *pub_der;							/**< DER encoded public key. */
+	size_t pub_length;							/**< Length of the public key. */
+	uint8_t digest[SHA256_HASH_LENGTH];			/**< The signed digest. */
+	uint8_t signature[RSA_MAX_KEY_LENGTH];		/**< PKCS#1 v1.5 signature of the digest. */
+	size_t sig_length;							/**< Length of the signature. */
+	uint8_t plaintext[SHA256_HASH_LENGTH];		/**< The encrypted data. */
+	uint8_t ciphertext[RSA_MAX_KEY_LENGTH];		/**< OAEP encrypted data. */
+	size_t cipher_length;						/**< Length of the encrypted data. */
+};
+
+/**
+ * Key lengths to measure.
+ */
+static const struct {
+	const char *name;							/**< Name of the key length. */
+	int bits;									/**< Length of the key, in bits. */
+} crypto_benchmark_rsa_key_lengths[] = {
+	{"2048", 2048},
+#if RSA_MAX_KEY_LENGTH >= RSA_KEY_LENGTH_3K
+	{"3072", 3072},
+#endif
+#if RSA_MAX_KEY_LENGTH >= RSA_KEY_LENGTH_4K
+	{"4096", 4096},
+#endif
+};
+
+
+/**
+ * Verify an RSA signature.
+ *
+ * @param context The RSA measurement context.
+ *
+ * @return 0 if the signature is valid or an error code.
+ */
+static int crypto_benchmark_rsa_verify (void *context)
+{
+	struct crypto_benchmark_rsa_context *rsa = context;
+
+	return rsa->engine->sig_verify (rsa->engine, &rsa->pub_key, rsa->signature, rsa->sig_length,
+		HASH_TYPE_SHA256, rsa->digest, SHA256_HASH_LENGTH);
+}
+
+/**
+ * Decrypt data with an RSA private key.
+ *
+ * @param context The RSA measurement context.
+ *
+ * @return The length of the decrypted data or an error code.
+ */
+static int crypto_benchmark_rsa_decrypt (void *context)
+{
+	struct crypto_benchmark_rsa_context *rsa = context;
+
+	return rsa->engine->decrypt (rsa->engine, &rsa->priv_key, rsa->ciphertext, rsa->cipher_length,
+		NULL, 0, HASH_TYPE_SHA256, rsa->output, sizeof (rsa->output));
+}
+
+/**
+ * Generate the signature and ciphertext used for measurements.  The RSA engine API only supports
+ * verification and decryption, so OpenSSL is used directly to generate this data.
+ *
+ * @param keys The keys to use.  The signature and ciphertext will be updated.
+ *
+ * @return 0 if the data was generated successfully or -1 if there was an error.
+ */
+static int crypto_benchmark_rsa_generate_reference (struct crypto_benchmark_rsa_keys *keys)
+{
+	const uint8_t *der = keys->priv_der;
+	EVP_PKEY *key;
+	EVP_PKEY_CTX *ctx;
+	int status = -1;
+
+	key = d2i_AutoPrivateKey (NULL, &der, keys->priv_length);
+	if (key == NULL) {
+		return -1;
+	}
+
+	ctx = EVP_PKEY_CTX_new (key, NULL);
+	if (ctx == NULL) {
+		goto free_key;
+	}
+
+	keys->sig_length = sizeof (keys->signature);
+	if ((EVP_PKEY_sign_init (ctx) <= 0) ||
+		(EVP_PKEY_CTX_set_rsa_padding (ctx, RSA_PKCS1_PADDING) <= 0) ||
+		(EVP_PKEY_CTX_set_signature_md (ctx, EVP_sha256 ()) <= 0) ||
+		(EVP_PKEY_sign (ctx, keys->signature, &keys->sig_length, keys->digest,
+			sizeof (keys->digest)) <= 0)) {
+		goto free_ctx;
+	}
+
+	keys->cipher_length = sizeof (keys->ciphertext);
+	if ((EVP_PKEY_encrypt_init (ctx) <= 0) ||
+		(EVP_PKEY_CTX_set_rsa_padding (ctx, RSA_PKCS1_OAEP_PADDING) <= 0) ||
+		(EVP_PKEY_CTX_set_rsa_oaep_md (ctx, EVP_sha256 ()) <= 0) ||
+		(EVP_PKEY_CTX_set_rsa_mgf1_md (ctx, EVP_sha256 ()) <= 0) ||
+		(EVP_PKEY_encrypt (ctx, keys->ciphertext, &keys->cipher_length, keys->plaintext,
+			sizeof (keys->plaintext)) <= 0)) {
+		goto free_ctx;
+	}
+
+	status = 0;
+
+free_ctx:
+	EVP_PKEY_CTX_free (ctx);
+free_key:
+	EVP_PKEY_free (key);
+	return status;
+}
+
+/**
+ * Generate the keys and reference data used to measure a key length.
+ *
+ * @param rsa The RSA engine to use for key generation.
+ * @param index Index of the key length to generate keys for.
+ * @param keys Output for the generated keys.
+ *
+ * @return 0 if the keys were generated successfully or an error code.
+ */
+static int crypto_benchmark_rsa_generate_keys (struct rsa_engine *rsa, size_t index,
+	struct crypto_benchmark_rsa_keys *keys)
+{
+	struct rsa_private_key priv_key;
+	int status;
+
+	memset (keys, 0, sizeof (*keys));
+	keys->name = crypto_benchmark_rsa_key_lengths[index].name;
+	keys->key_length = crypto_benchmark_rsa_key_lengths[index].bits / 8;
+	memset (keys->digest, 0xa5, sizeof (keys->digest));
+	memset (keys->plaintext, 0x3c, sizeof (keys->plaintext));
+
+	status = rsa->generate_key (rsa, &priv_key, crypto_benchmark_rsa_key_lengths[index].bits);
+	if (status != 0) {
+		return status;
+	}
+
+	status = rsa->get_private_key_der (rsa, &priv_key, &keys->priv_der, &keys->priv_length);
+	if (status != 0) {
+		goto release;
+	}
+
+	status = rsa->get_public_key_der (rsa, &priv_key, &keys->pub_der, &keys->pub_length);
+	if (status != 0) {
+		goto release;
+	}
+
+	status = crypto_benchmark_rsa_generate_reference (keys);
+
+release:
+	rsa->release_key (rsa, &priv_key);
+	return status;
+}
+
+/**
+ * Release the keys used to measure a key length.
+ *
+ * @param keys The keys to release.
+ */
+static void crypto_benchmark_rsa_release_keys (struct crypto_benchmark_rsa_keys *keys)
+{
+	platform_free (keys->priv_der);
+	platform_free (keys->pub_der);
+}
+
+/**
+ * Measure the RSA operations for a single key length on a single RSA engine.
+ *
+ * @param bench The measurement context.
+ * @param engine The RSA engine to measure.
+ * @param backend Name of the RSA engine implementation.
+ * @param keys The keys to use for the measurements.
+ */
+static void crypto_benchmark_rsa_engine (struct crypto_benchmark *bench, struct rsa_engine *engine,
+	const char *backend, const struct crypto_benchmark_rsa_keys *keys)
+{
+	struct crypto_benchmark_rsa_context context;
+	char operation[32];
+	int status;
+
+	memset (&context, 0, sizeof (context));
+	context.engine = engine;
+	context.digest = keys->digest;
+	context.signature = keys->signature;
+	context.sig_length = keys->sig_length;
+	context.ciphertext = keys->ciphertext;
+	context.cipher_length = keys->cipher_length;
+
+	status = engine->init_public_key (engine, &context.pub_key, keys->pub_der, keys->pub_length);
+	if (status != 0) {
+		fprintf (stderr, "rsa,%s,%s: Failed to load public key: 0x%x\n", backend, keys->name,
+			status);
+		bench->failures++;
+		return;
+	}
+
+	snprintf (operation, sizeof (operation), "pkcs1_verify_%s", keys->name);
+	crypto_benchmark_run (bench, "rsa", backend, operation, keys->key_length,
+		crypto_benchmark_rsa_verify, &context);
+
+	status = engine->init_private_key (engine, &context.priv_key, keys->priv_der,
+		keys->priv_length);
+	if (status != 0) {
+		fprintf (stderr, "rsa,%s,%s: Failed to load private key: 0x%x\n", backend, keys->name,
+			status);
+		bench->failures++;
+		return;
+	}
+
+	snprintf (operation, sizeof (operation), "oaep_decrypt_%s", keys->name);
+	crypto_benchmark_run (bench, "rsa", backend, operation, keys->key_length,
+		crypto_benchmark_rsa_decrypt, &context);
+
+	engine->release_key (engine, &context.priv_key);
+}
+
+/**
+ * Measure each RSA engine available on the Linux platform.
+ *
+ * @param bench The measurement context.
+ *
+ * @return 0 if the measurements were run or an error code.
+ */
+int crypto_benchmark_rsa (struct crypto_benchmark *bench)
+{
+	struct rsa_engine_openssl openssl;
+	struct rsa_engine_mbedtls mbedtls;
+	struct crypto_benchmark_rsa_keys keys;
+	size_t i;
+	int status;
+
+	status = rsa_openssl_init (&openssl);
+	if (status != 0) {
+		return status;
+	}
+
+	status = rsa_mbedtls_init (&mbedtls);
+	if (status != 0) {
+		goto release_openssl;
+	}
+
+	for (i = 0; i < ARRAY_SIZE (crypto_benchmark_rsa_key_lengths); i++) {
+		status = crypto_benchmark_rsa_generate_keys (&openssl.base, i, &keys);
+		if (status != 0) {
+			crypto_benchmark_rsa_release_keys (&keys);
+			break;
+		}
+
+		crypto_benchmark_rsa_engine (bench, &openssl.base, "openssl", &keys);
+		crypto_benchmark_rsa_engine (bench, &mbedtls.base, "mbedtls", &keys);
+
+		crypto_benchmark_rsa_release_keys (&keys);
+	}
+
+	rsa_mbedtls_release (&mbedtls);
+release_openssl:
+	rsa_openssl_release (&openssl);
+
+	return status;
+}
@@ -0,0 +1,306 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdio.h>
+#include <string.h>
+#include "crypto_benchmark.h"
+#include "platform_api.h"
+#include "asn1/x509.h"
+#include "asn1/x509_mbedtls.h"
+#include "asn1/x509_openssl.h"
+#include "crypto/ecc.h"
+#include "crypto/ecc_openssl.h"
+#include "crypto/hash.h"
+
+
+/**
+ * Context for an X.509 measurement.
+ */
+struct crypto_benchmark_x509_context {
+	struct x509_engine *engine;		/**< The X.509 engine being measured. */
+	struct x509_certificate cert;	/**< The loaded end entity certificate. */
+	struct x509_ca_certs store;		/**< Certificate store with the root and intermediate CAs. */
+	const uint8_t *der;				/**< The DER encoded end entity certificate. */
+	size_t length;					/**< Length of the end entity certificate. */
+};
+
+/**
+ * A three level certificate chain used for measurements.  The chain is shared by every X.509
+ * engine.
+ */
+struct crypto_benchmark_x509_chain {
+	uint8_t *root_der;				/**< DER encoded root CA certificate. */
+	size_t root_length;				/**< Length of the root CA certificate. */
+	uint8_t *intr_der;				/**< DER encoded intermediate CA certificate. */
+	size_t intr_length;				/**< Length of the intermediate CA certificate. */
+	uint8_t *leaf_der;				/**< DER encoded end entity certificate. */
+	size_t leaf_length;				/**< Length of the end entity certificate. */
+};
+
+
+/**
+ * Parse a DER encoded certificate and release it.
+ *
+ * @param context The X.509 measurement context.
+ *
+ * @return 0 if the certificate was parsed successfully or an error code.
+ */
+static int crypto_benchmark_x509_load (void *context)
+{
+	struct crypto_benchmark_x509_context *x509 = context;
+	struct x509_certificate cert;
+	int status;
+
+	status = x509->engine->load_certificate (x509->engine, &cert, x509->der, x509->length);
+	if (status == 0) {
+		x509->engine->release_certificate (x509->engine, &cert);
+	}
+
+	return status;
+}
+
+/**
+ * Authenticate a certificate against a certificate store.
+ *
+ * @param context The X.509 measurement context.
+ *
+ * @return 0 if the certificate is trusted or an error code.
+ */
+static int crypto_benchmark_x509_authenticate (void *context)
+{
+	struct crypto_benchmark_x509_context *x509 = context;
+
+	return x509->engine->authenticate (x509->engine, &x509->cert, &x509->store);
+}
+
+/**
+ * Generate a random ECC key pair in DER format.
+ *
+ * @param ecc The ECC engine to use for key generation.
+ * @param der Output for the DER encoded key pair.  This must be freed by the caller.
+ * @param length Output for the length of the key pair.
+ *
+ * @return 0 if the key was generated successfully or an error code.
+ */
+static int crypto_benchmark_x509_generate_key (struct ecc_engine *ecc, uint8_t **der,
+	size_t *length)
+{
+	struct ecc_private_key priv_key;
+	int status;
+
+	status = ecc->generate_key_pair (ecc, ECC_KEY_LENGTH_256, &priv_key, NULL);
+	if (status != 0) {
+		return status;
+	}
+
+	status = ecc->get_private_key_der (ecc, &priv_key, der, length);
+	ecc->release_key_pair (ecc, &priv_key, NULL);
+
+	return status;
+}
+
+/**
+ * Generate a root CA, intermediate CA, and end entity certificate chain using ECC P-256 keys.
+ *
+ * @param x509 The X.509 engine to use for certificate generation.
+ * @param chain Output for the generated certificate chain.
+ *
+ * @return 0 if the chain was generated successfully or an error code.
+ */
+static int crypto_benchmark_x509_generate_chain (struct x509_engine *x509,
+	struct crypto_benchmark_x509_chain *chain)
+{
+	static const uint8_t root_serial[] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08};
+	static const uint8_t intr_serial[] = {0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18};
+	static const uint8_t leaf_serial[] = {0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28};
+	struct ecc_engine_openssl ecc;
+	struct x509_certificate root;
+	struct x509_certificate intr;
+	struct x509_certificate leaf;
+	uint8_t *root_key = NULL;
+	size_t root_key_length;
+	uint8_t *intr_key = NULL;
+	size_t intr_key_length;
+	uint8_t *leaf_key = NULL;
+	size_t leaf_key_length;
+	int status;
+
+	memset (chain, 0, sizeof (*chain));
+
+	status = ecc_openssl_init (&ecc);
+	if (status != 0) {
+		return status;
+	}
+
+	status = crypto_benchmark_x509_generate_key (&ecc.base, &root_key, &root_key_length);
+	if (status != 0) {
+		goto exit;
+	}
+
+	status = crypto_benchmark_x509_generate_key (&ecc.base, &intr_key, &intr_key_length);
+	if (status != 0) {
+		goto exit;
+	}
+
+	status = crypto_benchmark_x509_generate_key (&ecc.base, &leaf_key, &leaf_key_length);
+	if (status != 0) {
+		goto exit;
+	}
+
+	status = x509->create_self_signed_certificate (x509, &root, root_key, root_key_length,
+		HASH_TYPE_SHA256, root_serial, sizeof (root_serial), "Benchmark Root",
+		X509_CERT_CA_NO_PATHLEN, NULL, 0);
+	if (status != 0) {
+		goto exit;
+	}
+
+	status = x509->create_ca_signed_certificate (x509, &intr, intr_key, intr_key_length,
+		intr_serial, sizeof (intr_serial), "Benchmark Intermediate", X509_CERT_CA, root_key,
+		root_key_length, HASH_TYPE_SHA256, &root, NULL, 0);
+	if (status != 0) {
+		goto release_root;
+	}
+
+	status = x509->create_ca_signed_certificate (x509, &leaf, leaf_key, leaf_key_length,
+		leaf_serial, sizeof (leaf_serial), "Benchmark Leaf", X509_CERT_END_ENTITY, intr_key,
+		intr_key_length, HASH_TYPE_SHA256, &intr, NULL, 0);
+	if (status != 0) {
+		goto release_intr;
+	}
+
+	status = x509->get_certificate_der (x509, &root, &chain->root_der, &chain->root_length);
+	if (status != 0) {
+		goto release_leaf;
+	}
+
+	status = x509->get_certificate_der (x509, &intr, &chain->intr_der, &chain->intr_length);
+	if (status != 0) {
+		goto release_leaf;
+	}
+
+	status = x509->get_certificate_der (x509, &leaf, &chain->leaf_der, &chain->leaf_length);
+
+release_leaf:
+	x509->release_certificate (x509, &leaf);
+release_intr:
+	x509->release_certificate (x509, &intr);
+release_root:
+	x509->release_certificate (x509, &root);
+exit:
+	platform_free (root_key);
+	platform_free (intr_key);
+	platform_free (leaf_key);
+	ecc_openssl_release (&ecc);
+
+	return status;
+}
+
+/**
+ * Release a generated certificate chain.
+ *
+ * @param chain The certificate chain to release.
+ */
+static void crypto_benchmark_x509_release_chain (struct crypto_benchmark_x509_chain *chain)
+{
+	platform_free (chain->root_der);
+	platform_free (chain->intr_der);
+	platform_free (chain->leaf_der);
+}
+
+/**
+ * Measure certificate parsing and chain authentication for a single X.509 engine.
+ *
+ * @param bench The measurement context.
+ * @param engine The X.509 engine to measure.
+ * @param backend Name of the X.509 engine implementation.
+ * @param chain The certificate chain to use for the measurements.
+ */
+static void crypto_benchmark_x509_engine (struct crypto_benchmark *bench,
+	struct x509_engine *engine, const char *backend,
+	const struct crypto_benchmark_x509_chain *chain)
+{
+	struct crypto_benchmark_x509_context context;
+	int status;
+
+	context.engine = engine;
+	context.der = chain->leaf_der;
+	context.length = chain->leaf_length;
+
+	crypto_benchmark_run (bench, "x509", backend, "load_certificate", chain->leaf_length,
+		crypto_benchmark_x509_load, &context);
+
+	status = engine->init_ca_cert_store (engine, &context.store);
+	if (status != 0) {
+		goto error;
+	}
+
+	status = engine->add_root_ca (engine, &context.store, chain->root_der, chain->root_length);
+	if (status != 0) {
+		goto release_store;
+	}
+
+	status = engine->add_intermediate_ca (engine, &context.store, chain->intr_der,
+		chain->intr_length);
+	if (status != 0) {
+		goto release_store;
+	}
+
+	status = engine->load_certificate (engine, &context.cert, chain->leaf_der, chain->leaf_length);
+	if (status != 0) {
+		goto release_store;
+	}
+
+	crypto_benchmark_run (bench, "x509", backend, "authenticate_chain", chain->leaf_length,
+		crypto_benchmark_x509_authenticate, &context);
+
+	engine->release_certificate (engine, &context.cert);
+	engine->release_ca_cert_store (engine, &context.store);
+	return;
+
+release_store:
+	engine->release_ca_cert_store (engine, &context.store);
+error:
+	fprintf (stderr, "x509,%s: Failed to set up certificate chain: 0x%x\n", backend, status);
+	bench->failures++;
+}
+
+/**
+ * Measure each X.509 engine available on the Linux platform.
+ *
+ * @param bench The measurement context.
+ *
+ * @return 0 if the measurements were run or an error code.
+ */
+int crypto_benchmark_x509 (struct crypto_benchmark *bench)
+{
+	struct x509_engine_openssl openssl;
+	struct x509_engine_mbedtls mbedtls;
+	struct crypto_benchmark_x509_chain chain;
+	int status;
+
+	status = x509_openssl_init (&openssl);
+	if (status != 0) {
+		return status;
+	}
+
+	status = crypto_benchmark_x509_generate_chain (&openssl.base, &chain);
+	if (status != 0) {
+		goto release_chain;
+	}
+
+	crypto_benchmark_x509_engine (bench, &openssl.base, "openssl", &chain);
+
+	status = x509_mbedtls_init (&mbedtls);
+	if (status != 0) {
+		goto release_chain;
+	}
+
+	crypto_benchmark_x509_engine (bench, &mbedtls.base, "mbedtls", &chain);
+	x509_mbedtls_release (&mbedtls);
+
+release_chain:
+	crypto_benchmark_x509_release_chain (&chain);
+	x509_openssl_release (&openssl);
+
+	return status;
+}